@@ -112,6 +112,7 @@ public class CesiumEditor : ModuleRules
                 "MeshDescription",
                 "StaticMeshDescription",
                 "HTTP",
+                "Json",
                 "MikkTSpace",
                 "Chaos",
                 "Projects",
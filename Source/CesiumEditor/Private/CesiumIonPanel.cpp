@@ -180,6 +180,7 @@ void CesiumIonPanel::OnSortChange(
 
 void CesiumIonPanel::OnSearchTextChange(const FText& SearchText) {
   _searchString = SearchText.ToString().TrimStartAndEnd();
+  FCesiumEditorModule::ion().setAssetSearch(_searchString);
   Refresh();
 }
 
@@ -402,13 +403,25 @@ void CesiumIonPanel::ApplySorting() {
 }
 
 void CesiumIonPanel::Refresh() {
-  const Assets& assets = FCesiumEditorModule::ion().getAssets();
-
-  this->_assets.SetNum(assets.items.size());
-
-  for (size_t i = 0; i < assets.items.size(); ++i) {
-    this->_assets[i] = MakeShared<Asset>(assets.items[i]);
+  CesiumIonSession& ion = FCesiumEditorModule::ion();
+  const Assets& assets = ion.getAssets();
+
+  // Pages of the asset list are added to the end of it as they arrive, so
+  // only the new assets need to be copied, unless the list was replaced.
+  if (this->_assetListGeneration != ion.getAssetListGeneration() ||
+      size_t(this->_allAssets.Num()) > assets.items.size()) {
+    this->_allAssets.Reset();
+    this->_assetListGeneration = ion.getAssetListGeneration();
   }
+  this->_allAssets.Reserve(int32(assets.items.size()));
+  for (size_t i = size_t(this->_allAssets.Num()); i < assets.items.size();
+       ++i) {
+    this->_allAssets.Add(MakeShared<Asset>(assets.items[i]));
+  }
+
+  // The search string is also filtered here, so that the assets that are
+  // already listed are narrowed down while Cesium ion searches for it.
+  this->_assets = this->_allAssets;
   ApplyFilter();
   ApplySorting();
   this->_pListView->RequestListRefresh();
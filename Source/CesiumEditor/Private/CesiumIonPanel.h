@@ -69,7 +69,8 @@ private:
 
   /**
    * Will be called whenever the contents of the _SearchBox changes,
-   * store the corresponding _searchString, and refresh the view.
+   * store the corresponding _searchString, search Cesium ion for it,
+   * and refresh the view.
    */
   void OnSearchTextChange(const FText& SearchText);
 
@@ -77,6 +78,14 @@ private:
   FDelegateHandle _assetsUpdatedDelegateHandle;
   TSharedPtr<SListView<TSharedPtr<CesiumIonClient::Asset>>> _pListView;
   TArray<TSharedPtr<CesiumIonClient::Asset>> _assets;
+
+  /**
+   * Every asset in the session's asset list, before filtering and sorting.
+   * Pages of the list are appended as they arrive, until the session's
+   * _assetListGeneration changes.
+   */
+  TArray<TSharedPtr<CesiumIonClient::Asset>> _allAssets;
+  int64 _assetListGeneration = -1;
   TSharedPtr<CesiumIonClient::Asset> _pSelection;
 
   /**
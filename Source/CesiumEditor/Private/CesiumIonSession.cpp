@@ -1,11 +1,22 @@
 // Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "CesiumIonSession.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
 #include "CesiumEditorSettings.h"
 #include "CesiumRuntimeSettings.h"
 #include "CesiumSourceControl.h"
+#include "CesiumUtility/Uri.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformProcess.h"
+#include "Hash/CityHash.h"
 #include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
 
 using namespace CesiumAsync;
 using namespace CesiumIonClient;
@@ -18,6 +29,9 @@ CesiumIonSession::CesiumIonSession(
       _connection(std::nullopt),
       _profile(std::nullopt),
       _assets(std::nullopt),
+      _assetRequest(0),
+      _assetListGeneration(0),
+      _assetSearch(),
       _tokens(std::nullopt),
       _isConnecting(false),
       _isResuming(false),
@@ -113,9 +127,18 @@ void CesiumIonSession::resume() {
 }
 
 void CesiumIonSession::disconnect() {
+  // The saved asset list belongs to the account that is signing out.
+  const FString assetCacheFilename = this->getAssetCacheFilename();
+  if (!assetCacheFilename.IsEmpty()) {
+    IFileManager::Get().Delete(*assetCacheFilename, false, false, true);
+  }
+
   this->_connection.reset();
   this->_profile.reset();
   this->_assets.reset();
+  ++this->_assetRequest;
+  ++this->_assetListGeneration;
+  this->_isLoadingAssets = false;
   this->_tokens.reset();
 
   UCesiumEditorSettings* pSettings = GetMutableDefault<UCesiumEditorSettings>();
@@ -160,24 +183,240 @@ void CesiumIonSession::refreshAssets() {
     return;
   }
 
-  this->_isLoadingAssets = true;
   this->_loadAssetsQueued = false;
 
-  this->_connection->assets()
-      .thenInMainThread([this](Response<Assets>&& assets) {
-        this->_isLoadingAssets = false;
-        this->_assets = std::move(assets.value);
+  // Show the assets saved by an earlier session until the first page of the
+  // current list arrives.
+  if (!this->_assets && this->_assetSearch.IsEmpty()) {
+    this->loadCachedAssets();
+  }
+
+  this->loadAssetPage(this->_assetRequest, 1);
+}
+
+void CesiumIonSession::setAssetSearch(const FString& search) {
+  if (this->_assetSearch == search) {
+    return;
+  }
+
+  this->_assetSearch = search;
+  ++this->_assetRequest;
+  this->_isLoadingAssets = false;
+  this->refreshAssets();
+}
+
+namespace {
+
+std::string getStringField(const FJsonObject& object, const TCHAR* name) {
+  FString value;
+  object.TryGetStringField(name, value);
+  return TCHAR_TO_UTF8(*value);
+}
+
+// Reads the assets in the "items" of a page of the Cesium ion asset list, or
+// of a list saved by saveCachedAssets, which has the same form.
+bool parseAssets(const FString& json, std::vector<Asset>& assets) {
+  TSharedRef<TJsonReader<>> pReader = TJsonReaderFactory<>::Create(json);
+  TSharedPtr<FJsonObject> pObject;
+  if (!FJsonSerializer::Deserialize(pReader, pObject) || !pObject) {
+    return false;
+  }
+
+  const TArray<TSharedPtr<FJsonValue>>* pItems = nullptr;
+  if (!pObject->TryGetArrayField(TEXT("items"), pItems)) {
+    return false;
+  }
+
+  assets.reserve(assets.size() + size_t(pItems->Num()));
+  for (const TSharedPtr<FJsonValue>& pItem : *pItems) {
+    const TSharedPtr<FJsonObject>* ppAsset = nullptr;
+    if (!pItem || !pItem->TryGetObject(ppAsset)) {
+      continue;
+    }
+
+    const FJsonObject& jsonAsset = **ppAsset;
+    Asset& asset = assets.emplace_back();
+    int64 id = 0;
+    jsonAsset.TryGetNumberField(TEXT("id"), id);
+    asset.id = id;
+    asset.name = getStringField(jsonAsset, TEXT("name"));
+    asset.description = getStringField(jsonAsset, TEXT("description"));
+    asset.attribution = getStringField(jsonAsset, TEXT("attribution"));
+    asset.type = getStringField(jsonAsset, TEXT("type"));
+    int64 bytes = 0;
+    jsonAsset.TryGetNumberField(TEXT("bytes"), bytes);
+    asset.bytes = bytes;
+    asset.dateAdded = getStringField(jsonAsset, TEXT("dateAdded"));
+    asset.status = getStringField(jsonAsset, TEXT("status"));
+    int32 percentComplete = 0;
+    jsonAsset.TryGetNumberField(TEXT("percentComplete"), percentComplete);
+    asset.percentComplete = int8_t(percentComplete);
+  }
+
+  return true;
+}
+
+} // namespace
+
+void CesiumIonSession::loadAssetPage(int64_t request, int32_t page) {
+  this->_isLoadingAssets = true;
+
+  std::string url = CesiumUtility::Uri::resolve(
+      this->_connection->getApiUrl(),
+      "v1/assets");
+  url = CesiumUtility::Uri::addQuery(
+      url,
+      "limit",
+      std::to_string(AssetPageSize));
+  url = CesiumUtility::Uri::addQuery(url, "page", std::to_string(page));
+  if (!this->_assetSearch.IsEmpty()) {
+    url = CesiumUtility::Uri::addQuery(
+        url,
+        "search",
+        TCHAR_TO_UTF8(*this->_assetSearch));
+  }
+
+  this->_pAssetAccessor
+      ->get(
+          this->_asyncSystem,
+          url,
+          {{"Accept", "application/json"},
+           {"Authorization",
+            "Bearer " + this->_connection->getAccessToken()}})
+      .thenInMainThread([this, request, page](
+                            std::shared_ptr<IAssetRequest>&& pRequest) {
+        if (request != this->_assetRequest) {
+          return;
+        }
+
+        const IAssetResponse* pResponse = pRequest->response();
+        std::vector<Asset> items;
+        bool succeeded = pResponse && pResponse->statusCode() >= 200 &&
+                         pResponse->statusCode() < 300;
+        if (succeeded) {
+          const gsl::span<const std::byte> data = pResponse->data();
+          FUTF8ToTCHAR json(
+              reinterpret_cast<const ANSICHAR*>(data.data()),
+              int32(data.size()));
+          succeeded = parseAssets(FString(json.Length(), json.Get()), items);
+        }
+
+        if (!succeeded) {
+          // A list saved by an earlier session is kept if it's all there is.
+          this->_isLoadingAssets = false;
+          this->AssetsUpdated.Broadcast();
+          return;
+        }
+
+        // The first page replaces the list, including any saved list, and
+        // each later page is added to it.
+        if (page == 1) {
+          this->_assets = Assets();
+          ++this->_assetListGeneration;
+        }
+        const bool isLastPage = items.size() < size_t(AssetPageSize);
+        this->_assets->items.insert(
+            this->_assets->items.end(),
+            std::make_move_iterator(items.begin()),
+            std::make_move_iterator(items.end()));
+
+        if (isLastPage) {
+          this->_isLoadingAssets = false;
+          if (this->_assetSearch.IsEmpty()) {
+            this->saveCachedAssets();
+          }
+        } else {
+          this->loadAssetPage(request, page + 1);
+        }
+
         this->AssetsUpdated.Broadcast();
-        this->refreshAssetsIfNeeded();
       })
-      .catchInMainThread([this](std::exception&& e) {
+      .catchInMainThread([this, request](std::exception&& e) {
+        if (request != this->_assetRequest) {
+          return;
+        }
         this->_isLoadingAssets = false;
-        this->_assets = std::nullopt;
         this->AssetsUpdated.Broadcast();
-        this->refreshAssetsIfNeeded();
       });
 }
 
+FString CesiumIonSession::getAssetCacheFilename() const {
+  if (!this->_connection) {
+    return FString();
+  }
+
+  // Each account's list is saved separately, by a hash of the server and the
+  // token it was listed with, so that nobody else's list is shown.
+  const std::string key =
+      this->_connection->getApiUrl() + " " +
+      this->_connection->getAccessToken();
+  return FPaths::Combine(
+      FPaths::ProjectSavedDir(),
+      TEXT("Cesium"),
+      TEXT("IonAssetLists"),
+      FString::Printf(
+          TEXT("%016llx.json"),
+          CityHash64(key.data(), uint32(key.size()))));
+}
+
+void CesiumIonSession::loadCachedAssets() {
+  const FString filename = this->getAssetCacheFilename();
+  FString json;
+  if (filename.IsEmpty() || !FFileHelper::LoadFileToString(json, *filename)) {
+    return;
+  }
+
+  Assets assets;
+  if (parseAssets(json, assets.items)) {
+    this->_assets = std::move(assets);
+    ++this->_assetListGeneration;
+    this->AssetsUpdated.Broadcast();
+  }
+}
+
+void CesiumIonSession::saveCachedAssets() const {
+  const FString filename = this->getAssetCacheFilename();
+  if (filename.IsEmpty() || !this->_assets) {
+    return;
+  }
+
+  TArray<TSharedPtr<FJsonValue>> items;
+  items.Reserve(int32(this->_assets->items.size()));
+  for (const Asset& asset : this->_assets->items) {
+    TSharedRef<FJsonObject> pAsset = MakeShared<FJsonObject>();
+    pAsset->SetNumberField(TEXT("id"), double(asset.id));
+    pAsset->SetStringField(TEXT("name"), UTF8_TO_TCHAR(asset.name.c_str()));
+    pAsset->SetStringField(
+        TEXT("description"),
+        UTF8_TO_TCHAR(asset.description.c_str()));
+    pAsset->SetStringField(
+        TEXT("attribution"),
+        UTF8_TO_TCHAR(asset.attribution.c_str()));
+    pAsset->SetStringField(TEXT("type"), UTF8_TO_TCHAR(asset.type.c_str()));
+    pAsset->SetNumberField(TEXT("bytes"), double(asset.bytes));
+    pAsset->SetStringField(
+        TEXT("dateAdded"),
+        UTF8_TO_TCHAR(asset.dateAdded.c_str()));
+    pAsset->SetStringField(TEXT("status"), UTF8_TO_TCHAR(asset.status.c_str()));
+    pAsset->SetNumberField(
+        TEXT("percentComplete"),
+        double(asset.percentComplete));
+    items.Add(MakeShared<FJsonValueObject>(pAsset));
+  }
+
+  TSharedRef<FJsonObject> pRoot = MakeShared<FJsonObject>();
+  pRoot->SetArrayField(TEXT("items"), items);
+
+  FString json;
+  if (FJsonSerializer::Serialize(pRoot, TJsonWriterFactory<>::Create(&json))) {
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(filename), true);
+    FFileHelper::SaveStringToFile(
+        json,
+        *filename,
+        FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+  }
+}
+
 void CesiumIonSession::refreshTokens() {
   if (!this->_connection || this->_isLoadingTokens) {
     return;
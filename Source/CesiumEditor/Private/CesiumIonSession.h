@@ -6,13 +6,21 @@
 #include "CesiumAsync/IAssetAccessor.h"
 #include "CesiumAsync/SharedFuture.h"
 #include "CesiumIonClient/Connection.h"
+#include "Containers/UnrealString.h"
 #include "Delegates/Delegate.h"
+#include <cstdint>
 #include <memory>
 
 DECLARE_MULTICAST_DELEGATE(FIonUpdated);
 
 class CesiumIonSession {
 public:
+  /**
+   * The number of assets that are requested from Cesium ion at a time. Each
+   * page is added to the asset list as soon as it arrives.
+   */
+  static constexpr int32_t AssetPageSize = 100;
+
   CesiumIonSession(
       CesiumAsync::AsyncSystem& asyncSystem,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor);
@@ -54,6 +62,26 @@ public:
   const std::optional<CesiumIonClient::Connection>& getConnection() const;
   const CesiumIonClient::Profile& getProfile();
   const CesiumIonClient::Assets& getAssets();
+
+  /**
+   * Gets a number that changes each time the asset list is replaced, rather
+   * than having another page of assets added to the end of it.
+   */
+  int64_t getAssetListGeneration() const {
+    return this->_assetListGeneration;
+  }
+
+  /**
+   * Gets the text that Cesium ion is searching assets for, or an empty string
+   * if every asset is listed.
+   */
+  const FString& getAssetSearch() const { return this->_assetSearch; }
+
+  /**
+   * Lists only the assets that Cesium ion finds for the given text, or every
+   * asset if it's empty, and reloads the asset list if the text has changed.
+   */
+  void setAssetSearch(const FString& search);
   const std::vector<CesiumIonClient::Token>& getTokens();
 
   const std::string& getAuthorizeUrl() const { return this->_authorizeUrl; }
@@ -93,12 +121,22 @@ public:
   void invalidateProjectDefaultTokenDetails();
 
 private:
+  void loadAssetPage(int64_t request, int32_t page);
+  FString getAssetCacheFilename() const;
+  void loadCachedAssets();
+  void saveCachedAssets() const;
+
   CesiumAsync::AsyncSystem _asyncSystem;
   std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
 
   std::optional<CesiumIonClient::Connection> _connection;
   std::optional<CesiumIonClient::Profile> _profile;
   std::optional<CesiumIonClient::Assets> _assets;
+  // Identifies the latest asset list request, so that the pages of a list
+  // that was superseded, by a search or disconnecting, are ignored.
+  int64_t _assetRequest;
+  int64_t _assetListGeneration;
+  FString _assetSearch;
   std::optional<std::vector<CesiumIonClient::Token>> _tokens;
 
   std::optional<CesiumAsync::SharedFuture<CesiumIonClient::Token>>
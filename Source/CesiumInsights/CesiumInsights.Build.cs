@@ -0,0 +1,30 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+using UnrealBuildTool;
+
+// Analyzes the `Cesium` trace channel sent by CesiumRuntime and shows its
+// tile events as tracks in the Timing Insights view. This doesn't depend on
+// CesiumRuntime or cesium-native, so it can also be built into the Unreal
+// Insights program.
+public class CesiumInsights : ModuleRules
+{
+    public CesiumInsights(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "ApplicationCore",
+                "Slate",
+                "SlateCore",
+                "TraceAnalysis",
+                "TraceServices",
+                "TraceInsights"
+            }
+        );
+
+        CppStandard = CppStandardVersion.Cpp17;
+    }
+}
@@ -0,0 +1,35 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileTimingTrack.h"
+#include "CesiumTileTraceAnalysis.h"
+#include "Features/IModularFeatures.h"
+#include "Modules/ModuleManager.h"
+
+class FCesiumInsightsModule : public IModuleInterface {
+public:
+  virtual void StartupModule() override {
+    IModularFeatures& features = IModularFeatures::Get();
+    features.RegisterModularFeature(
+        TraceServices::ModuleFeatureName,
+        &this->_traceServicesModule);
+    features.RegisterModularFeature(
+        Insights::TimingViewExtenderFeatureName,
+        &this->_timingViewExtender);
+  }
+
+  virtual void ShutdownModule() override {
+    IModularFeatures& features = IModularFeatures::Get();
+    features.UnregisterModularFeature(
+        Insights::TimingViewExtenderFeatureName,
+        &this->_timingViewExtender);
+    features.UnregisterModularFeature(
+        TraceServices::ModuleFeatureName,
+        &this->_traceServicesModule);
+  }
+
+private:
+  CesiumTraceServicesModule _traceServicesModule;
+  CesiumTimingViewExtender _timingViewExtender;
+};
+
+IMPLEMENT_MODULE(FCesiumInsightsModule, CesiumInsights)
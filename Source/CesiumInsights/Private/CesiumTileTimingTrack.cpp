@@ -0,0 +1,233 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileTimingTrack.h"
+#include "CesiumTileTraceAnalysis.h"
+#include "Insights/Common/TimeUtils.h"
+#include "Insights/ITimingViewSession.h"
+#include "Insights/ViewModels/ITimingViewDrawHelper.h"
+#include "Insights/ViewModels/TimingEvent.h"
+#include "Insights/ViewModels/TimingEventSearch.h"
+#include "Insights/ViewModels/TimingTrackViewport.h"
+#include "Insights/ViewModels/TooltipDrawState.h"
+
+INSIGHTS_IMPLEMENT_RTTI(CesiumTileTimingTrack)
+
+namespace {
+
+uint32 getStageColor(ECesiumTileTraceStage stage) {
+  switch (stage) {
+  case ECesiumTileTraceStage::Request:
+    return 0xFF4A90D9;
+  case ECesiumTileTraceStage::Load:
+    return 0xFFE0A030;
+  case ECesiumTileTraceStage::Upload:
+    return 0xFFD05050;
+  case ECesiumTileTraceStage::Show:
+    return 0xFF50C050;
+  case ECesiumTileTraceStage::Hide:
+    return 0xFF808080;
+  default:
+    return 0xFF303030;
+  }
+}
+
+FString getEventName(const CesiumTileTraceEvent& event) {
+  return FString::Printf(
+      TEXT("%s %s (depth %u, %.1f KB)"),
+      getCesiumTileTraceStageName(event.stage),
+      event.tileId,
+      event.depth,
+      double(event.bytes) / 1024.0);
+}
+
+} // namespace
+
+CesiumTileTimingTrack::CesiumTileTimingTrack(
+    const TraceServices::IAnalysisSession& session,
+    uint64 tileset,
+    const TCHAR* tilesetName)
+    : FTimingEventsTrack(
+          FString::Printf(TEXT("Cesium Tiles - %s"), tilesetName)),
+      _session(session),
+      _tileset(tileset) {}
+
+/*static*/ uint32
+CesiumTileTimingTrack::getLane(const CesiumTileTraceEvent& event) {
+  switch (event.stage) {
+  case ECesiumTileTraceStage::Request:
+    return 0;
+  case ECesiumTileTraceStage::Load:
+    return 1;
+  case ECesiumTileTraceStage::Upload:
+    return 2;
+  default:
+    return 3;
+  }
+}
+
+template <typename Callback>
+void CesiumTileTimingTrack::forEachEvent(
+    double startTime,
+    double endTime,
+    Callback&& callback) const {
+  TraceServices::FAnalysisSessionReadScope readScope(this->_session);
+  const CesiumTileTraceProvider* pProvider =
+      this->_session.ReadProvider<CesiumTileTraceProvider>(
+          CesiumTileTraceProvider::ProviderName);
+  if (!pProvider) {
+    return;
+  }
+
+  const TArray<CesiumTileTraceEvent>& events = pProvider->getEvents();
+  for (int32 i = 0; i < events.Num(); ++i) {
+    const CesiumTileTraceEvent& event = events[i];
+    if (event.tileset == this->_tileset && event.endTime >= startTime &&
+        event.startTime <= endTime) {
+      if (!callback(i, getLane(event), event)) {
+        return;
+      }
+    }
+  }
+}
+
+void CesiumTileTimingTrack::BuildDrawState(
+    ITimingEventsTrackDrawStateBuilder& builder,
+    const ITimingTrackUpdateContext& context) {
+  const FTimingTrackViewport& viewport = context.GetViewport();
+  this->forEachEvent(
+      viewport.GetStartTime(),
+      viewport.GetEndTime(),
+      [&builder](
+          int32 index,
+          uint32 lane,
+          const CesiumTileTraceEvent& event) {
+        const FString name = getEventName(event);
+        builder.AddEvent(
+            event.startTime,
+            event.endTime,
+            lane,
+            *name,
+            uint64(index),
+            getStageColor(event.stage));
+        return true;
+      });
+}
+
+void CesiumTileTimingTrack::InitTooltip(
+    FTooltipDrawState& tooltip,
+    const ITimingEvent& hoveredTimingEvent) const {
+  if (!hoveredTimingEvent.CheckTrack(this) ||
+      !hoveredTimingEvent.Is<FTimingEvent>()) {
+    return;
+  }
+
+  const FTimingEvent& timingEvent = hoveredTimingEvent.As<FTimingEvent>();
+  const int32 index = int32(timingEvent.GetType());
+
+  TraceServices::FAnalysisSessionReadScope readScope(this->_session);
+  const CesiumTileTraceProvider* pProvider =
+      this->_session.ReadProvider<CesiumTileTraceProvider>(
+          CesiumTileTraceProvider::ProviderName);
+  if (!pProvider || !pProvider->getEvents().IsValidIndex(index)) {
+    return;
+  }
+
+  const CesiumTileTraceEvent& event = pProvider->getEvents()[index];
+
+  tooltip.ResetContent();
+  tooltip.AddTitle(FString::Printf(
+      TEXT("%s %s"),
+      getCesiumTileTraceStageName(event.stage),
+      event.tileId));
+  tooltip.AddNameValueTextLine(TEXT("Tileset:"), event.tilesetName);
+  tooltip.AddNameValueTextLine(
+      TEXT("Duration:"),
+      TimeUtils::FormatTimeAuto(event.endTime - event.startTime));
+  tooltip.AddNameValueTextLine(
+      TEXT("Size:"),
+      FString::Printf(TEXT("%.1f KB"), double(event.bytes) / 1024.0));
+  tooltip.AddNameValueTextLine(
+      TEXT("Depth:"),
+      FString::Printf(TEXT("%u"), event.depth));
+  tooltip.AddNameValueTextLine(
+      TEXT("Geometric Error:"),
+      FString::Printf(TEXT("%g"), event.geometricError));
+  tooltip.UpdateLayout();
+}
+
+const TSharedPtr<const ITimingEvent> CesiumTileTimingTrack::SearchEvent(
+    const FTimingEventSearchParameters& searchParameters) const {
+  TSharedPtr<const ITimingEvent> pFound;
+  this->forEachEvent(
+      searchParameters.StartTime,
+      searchParameters.EndTime,
+      [this, &searchParameters, &pFound](
+          int32 index,
+          uint32 lane,
+          const CesiumTileTraceEvent& event) {
+        if (searchParameters.EventFilter &&
+            !searchParameters.EventFilter(
+                event.startTime,
+                event.endTime,
+                lane)) {
+          return true;
+        }
+        pFound = MakeShared<FTimingEvent>(
+            SharedThis(this),
+            event.startTime,
+            event.endTime,
+            lane,
+            uint64(index));
+        return false;
+      });
+  return pFound;
+}
+
+void CesiumTimingViewExtender::OnBeginSession(
+    Insights::ITimingViewSession& session) {
+  this->_tracks.Reset();
+  this->_eventCount = 0;
+}
+
+void CesiumTimingViewExtender::OnEndSession(
+    Insights::ITimingViewSession& session) {
+  this->_tracks.Reset();
+  this->_eventCount = 0;
+}
+
+void CesiumTimingViewExtender::Tick(
+    Insights::ITimingViewSession& session,
+    const TraceServices::IAnalysisSession& analysisSession) {
+  TraceServices::FAnalysisSessionReadScope readScope(analysisSession);
+  const CesiumTileTraceProvider* pProvider =
+      analysisSession.ReadProvider<CesiumTileTraceProvider>(
+          CesiumTileTraceProvider::ProviderName);
+  if (!pProvider) {
+    return;
+  }
+
+  for (const TPair<uint64, const TCHAR*>& tileset :
+       pProvider->getTilesets()) {
+    if (this->_tracks.Contains(tileset.Key)) {
+      continue;
+    }
+
+    TSharedPtr<CesiumTileTimingTrack> pTrack =
+        MakeShared<CesiumTileTimingTrack>(
+            analysisSession,
+            tileset.Key,
+            tileset.Value);
+    session.AddScrollableTrack(pTrack);
+    this->_tracks.Add(tileset.Key, pTrack);
+  }
+
+  // Events keep arriving while a live trace is analyzed.
+  const int32 eventCount = pProvider->getEvents().Num();
+  if (eventCount != this->_eventCount) {
+    this->_eventCount = eventCount;
+    for (TPair<uint64, TSharedPtr<CesiumTileTimingTrack>>& track :
+         this->_tracks) {
+      track.Value->SetDirtyFlag();
+    }
+  }
+}
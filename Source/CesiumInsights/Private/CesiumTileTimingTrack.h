@@ -0,0 +1,67 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Insights/ITimingViewExtender.h"
+#include "Insights/ViewModels/TimingEventsTrack.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+class CesiumTileTraceProvider;
+struct CesiumTileTraceEvent;
+
+/**
+ * A Timing Insights track with the tile events of one tileset. Requests,
+ * worker-thread loads, and game-thread uploads each have their own lane, with
+ * the instants at which tiles are shown, hidden, and freed in a fourth.
+ */
+class CesiumTileTimingTrack : public FTimingEventsTrack {
+  INSIGHTS_DECLARE_RTTI(CesiumTileTimingTrack, FTimingEventsTrack)
+
+public:
+  CesiumTileTimingTrack(
+      const TraceServices::IAnalysisSession& session,
+      uint64 tileset,
+      const TCHAR* tilesetName);
+
+  virtual void BuildDrawState(
+      ITimingEventsTrackDrawStateBuilder& builder,
+      const ITimingTrackUpdateContext& context) override;
+
+  virtual void InitTooltip(
+      FTooltipDrawState& tooltip,
+      const ITimingEvent& hoveredTimingEvent) const override;
+
+  virtual const TSharedPtr<const ITimingEvent>
+  SearchEvent(const FTimingEventSearchParameters& searchParameters) const
+      override;
+
+private:
+  // Calls the callback with the index and lane of each of this track's
+  // events that overlap the given time range.
+  template <typename Callback>
+  void forEachEvent(double startTime, double endTime, Callback&& callback)
+      const;
+
+  static uint32 getLane(const CesiumTileTraceEvent& event);
+
+  const TraceServices::IAnalysisSession& _session;
+  uint64 _tileset;
+};
+
+/**
+ * Adds a CesiumTileTimingTrack to the Timing Insights view for each tileset
+ * that appears in the trace.
+ */
+class CesiumTimingViewExtender : public Insights::ITimingViewExtender {
+public:
+  virtual void OnBeginSession(Insights::ITimingViewSession& session) override;
+  virtual void OnEndSession(Insights::ITimingViewSession& session) override;
+  virtual void Tick(
+      Insights::ITimingViewSession& session,
+      const TraceServices::IAnalysisSession& analysisSession) override;
+
+private:
+  TMap<uint64, TSharedPtr<CesiumTileTimingTrack>> _tracks;
+  int32 _eventCount = 0;
+};
@@ -0,0 +1,100 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileTraceAnalysis.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+/*static*/ const FName CesiumTileTraceProvider::ProviderName("CesiumTiles");
+
+const TCHAR* getCesiumTileTraceStageName(ECesiumTileTraceStage stage) {
+  switch (stage) {
+  case ECesiumTileTraceStage::Request:
+    return TEXT("Request");
+  case ECesiumTileTraceStage::Load:
+    return TEXT("Load");
+  case ECesiumTileTraceStage::Upload:
+    return TEXT("Upload");
+  case ECesiumTileTraceStage::Show:
+    return TEXT("Show");
+  case ECesiumTileTraceStage::Hide:
+    return TEXT("Hide");
+  case ECesiumTileTraceStage::Free:
+    return TEXT("Free");
+  default:
+    return TEXT("Unknown");
+  }
+}
+
+void CesiumTileTraceProvider::addEvent(const CesiumTileTraceEvent& event) {
+  bool alreadySeen = false;
+  this->_tilesetIds.Add(event.tileset, &alreadySeen);
+  if (!alreadySeen) {
+    this->_tilesets.Emplace(event.tileset, event.tilesetName);
+  }
+  this->_events.Add(event);
+}
+
+CesiumTileTraceAnalyzer::CesiumTileTraceAnalyzer(
+    TraceServices::IAnalysisSession& session,
+    CesiumTileTraceProvider& provider)
+    : _session(session), _provider(provider) {}
+
+void CesiumTileTraceAnalyzer::OnAnalysisBegin(
+    const FOnAnalysisContext& context) {
+  context.InterfaceBuilder.RouteEvent(RouteId_TileEvent, "Cesium", "TileEvent");
+}
+
+bool CesiumTileTraceAnalyzer::OnEvent(
+    uint16 routeId,
+    EStyle style,
+    const FOnEventContext& context) {
+  if (routeId != RouteId_TileEvent) {
+    return true;
+  }
+
+  TraceServices::FAnalysisSessionEditScope editScope(this->_session);
+
+  const FEventData& eventData = context.EventData;
+
+  FString tilesetName;
+  eventData.GetString("TilesetName", tilesetName);
+  FString tileId;
+  eventData.GetString("TileId", tileId);
+
+  CesiumTileTraceEvent event;
+  event.startTime =
+      context.EventTime.AsSeconds(eventData.GetValue<uint64>("StartCycle"));
+  event.endTime =
+      context.EventTime.AsSeconds(eventData.GetValue<uint64>("EndCycle"));
+  event.tileset = eventData.GetValue<uint64>("Tileset");
+  event.tile = eventData.GetValue<uint64>("Tile");
+  event.bytes = eventData.GetValue<int64>("Bytes");
+  event.geometricError = eventData.GetValue<double>("GeometricError");
+  event.depth = eventData.GetValue<uint32>("Depth");
+  event.stage = ECesiumTileTraceStage(FMath::Min(
+      eventData.GetValue<uint8>("Stage"),
+      uint8(ECesiumTileTraceStage::Count)));
+  event.tilesetName = this->_session.StoreString(*tilesetName);
+  event.tileId = this->_session.StoreString(*tileId);
+
+  this->_session.UpdateDurationSeconds(event.endTime);
+  this->_provider.addEvent(event);
+
+  return true;
+}
+
+void CesiumTraceServicesModule::GetModuleInfo(
+    TraceServices::FModuleInfo& outModuleInfo) {
+  outModuleInfo.Name = "CesiumTrace";
+  outModuleInfo.DisplayName = TEXT("Cesium");
+}
+
+void CesiumTraceServicesModule::OnAnalysisBegin(
+    TraceServices::IAnalysisSession& session) {
+  CesiumTileTraceProvider* pProvider = new CesiumTileTraceProvider();
+  session.AddProvider(CesiumTileTraceProvider::ProviderName, pProvider);
+  session.AddAnalyzer(new CesiumTileTraceAnalyzer(session, *pProvider));
+}
+
+void CesiumTraceServicesModule::GetLoggers(TArray<const TCHAR*>& outLoggers) {
+  outLoggers.Add(TEXT("Cesium"));
+}
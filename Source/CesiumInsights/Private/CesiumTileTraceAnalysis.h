@@ -0,0 +1,109 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Analyzer.h"
+#include "TraceServices/Model/AnalysisSession.h"
+#include "TraceServices/ModuleService.h"
+
+/**
+ * The stages of a tile's life, as sent by CesiumRuntime's
+ * ECesiumTileTraceStage.
+ */
+enum class ECesiumTileTraceStage : uint8 {
+  Request = 0,
+  Load = 1,
+  Upload = 2,
+  Show = 3,
+  Hide = 4,
+  Free = 5,
+  Count
+};
+
+const TCHAR* getCesiumTileTraceStageName(ECesiumTileTraceStage stage);
+
+/**
+ * A `Cesium.TileEvent` event from a trace, with its times in seconds since
+ * the start of the trace.
+ */
+struct CesiumTileTraceEvent {
+  double startTime = 0.0;
+  double endTime = 0.0;
+  uint64 tileset = 0;
+  uint64 tile = 0;
+  int64 bytes = 0;
+  double geometricError = 0.0;
+  uint32 depth = 0;
+  ECesiumTileTraceStage stage = ECesiumTileTraceStage::Request;
+
+  // Stored by the analysis session, so they live as long as it does.
+  const TCHAR* tilesetName = TEXT("");
+  const TCHAR* tileId = TEXT("");
+};
+
+/**
+ * The tile events of a trace, in the order they were sent. Must only be used
+ * within a read scope of the analysis session.
+ */
+class CesiumTileTraceProvider : public TraceServices::IProvider {
+public:
+  static const FName ProviderName;
+
+  void addEvent(const CesiumTileTraceEvent& event);
+
+  const TArray<CesiumTileTraceEvent>& getEvents() const {
+    return this->_events;
+  }
+
+  /**
+   * Gets the IDs and names of the tilesets of the events, in the order they
+   * were first seen.
+   */
+  const TArray<TPair<uint64, const TCHAR*>>& getTilesets() const {
+    return this->_tilesets;
+  }
+
+private:
+  TArray<CesiumTileTraceEvent> _events;
+  TArray<TPair<uint64, const TCHAR*>> _tilesets;
+  TSet<uint64> _tilesetIds;
+};
+
+/**
+ * Reads the `Cesium` trace channel into a CesiumTileTraceProvider.
+ */
+class CesiumTileTraceAnalyzer : public UE::Trace::IAnalyzer {
+public:
+  CesiumTileTraceAnalyzer(
+      TraceServices::IAnalysisSession& session,
+      CesiumTileTraceProvider& provider);
+
+  virtual void OnAnalysisBegin(const FOnAnalysisContext& context) override;
+  virtual bool OnEvent(
+      uint16 routeId,
+      EStyle style,
+      const FOnEventContext& context) override;
+
+private:
+  enum : uint16 { RouteId_TileEvent };
+
+  TraceServices::IAnalysisSession& _session;
+  CesiumTileTraceProvider& _provider;
+};
+
+/**
+ * Adds the Cesium analyzer and provider to every analysis session.
+ */
+class CesiumTraceServicesModule : public TraceServices::IModule {
+public:
+  virtual void
+  GetModuleInfo(TraceServices::FModuleInfo& outModuleInfo) override;
+  virtual void
+  OnAnalysisBegin(TraceServices::IAnalysisSession& session) override;
+  virtual void GetLoggers(TArray<const TCHAR*>& outLoggers) override;
+  virtual void GenerateReports(
+      const TraceServices::IAnalysisSession& session,
+      const TCHAR* cmdLine,
+      const TCHAR* outputDirectory) override {}
+};
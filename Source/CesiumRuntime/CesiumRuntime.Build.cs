@@ -185,6 +185,11 @@ public class CesiumRuntime : ModuleRules
         );
 
         PrivateDependencyModuleNames.Add("Chaos");
+        PrivateDependencyModuleNames.Add("ImageWrapper");
+        PrivateDependencyModuleNames.Add("EyeTracker");
+        PrivateDependencyModuleNames.Add("MovieScene");
+        PrivateDependencyModuleNames.Add("MovieSceneTracks");
+        PrivateDependencyModuleNames.Add("Sockets");
 
         if (Target.bBuildEditor == true)
         {
@@ -198,6 +203,17 @@ public class CesiumRuntime : ModuleRules
                     "MaterialEditor"
                 }
             );
+
+            // Nanite meshes can only be built in the editor.
+            PrivateDependencyModuleNames.AddRange(
+                new string[] {
+                    "DerivedDataCache",
+                    "NaniteBuilder"
+                }
+            );
+
+            // The load tests write their reports as JSON.
+            PrivateDependencyModuleNames.Add("Json");
         }
 
         DynamicallyLoadedModuleNames.AddRange(
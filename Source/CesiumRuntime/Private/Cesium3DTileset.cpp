@@ -2,36 +2,84 @@
 
 #include "Cesium3DTileset.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "CalcBounds.h"
 #include "Camera/CameraTypes.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Cesium3DTilesSelection/IPrepareRendererResources.h"
+#include "Cesium3DTilesSelection/RasterMappedTo3DTile.h"
 #include "Cesium3DTilesSelection/Tile.h"
 #include "Cesium3DTilesSelection/TilesetLoadFailureDetails.h"
 #include "Cesium3DTilesSelection/TilesetOptions.h"
 #include "Cesium3DTilesetLoadFailureDetails.h"
 #include "Cesium3DTilesetRoot.h"
 #include "CesiumActors.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumBandwidthLimiter.h"
 #include "CesiumBoundingVolumeComponent.h"
+#include "CesiumCachePrewarming.h"
 #include "CesiumCamera.h"
 #include "CesiumCameraManager.h"
+#include "CesiumCoalescingAssetAccessor.h"
+#include "CesiumCartographicPolygon.h"
 #include "CesiumCommon.h"
 #include "CesiumCustomVersion.h"
+#include "CesiumDepthPicking.h"
+#include "CesiumDetailGovernor.h"
+#include "CesiumFeatureSelectionTexture.h"
+#include "CesiumFeatureStyleTexture.h"
+#include "CesiumFrameBudget.h"
 #include "CesiumGeospatial/GlobeTransforms.h"
 #include "CesiumGltf/ImageCesium.h"
 #include "CesiumGltf/Ktx2TranscodeTargets.h"
 #include "CesiumGltfComponent.h"
 #include "CesiumGltfPointsSceneProxyUpdater.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumHedgedAssetAccessor.h"
+#include "CesiumHorizonCullingExcluder.h"
+#include "CesiumHzbOcclusionPool.h"
+#include "CesiumIonEndpointAssetAccessor.h"
 #include "CesiumLifetime.h"
+#include "CesiumMainThreadDispatcher.h"
+#include "CesiumMemoryAccounting.h"
+#include "CesiumMemoryPressure.h"
+#include "CesiumMeshDistanceField.h"
+#include "CesiumMetadataIndex.h"
+#include "CesiumMobileThrottling.h"
+#include "CesiumMovieLookAhead.h"
+#include "CesiumPhysicsMeshUtility.h"
+#include "CesiumPointBudget.h"
+#include "CesiumPrimitiveComponentPool.h"
 #include "CesiumRasterOverlay.h"
+#include "CesiumRasterPreviews.h"
+#include "CesiumRayTracingGeometry.h"
+#include "CesiumRenderDataBatch.h"
+#include "CesiumRequestCancellation.h"
 #include "CesiumRuntime.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumScalability.h"
+#include "CesiumSceneCaptureDetailComponent.h"
+#include "CesiumTexturePool.h"
+#include "CesiumTextureStreaming.h"
 #include "CesiumTextureUtility.h"
 #include "CesiumTileExcluder.h"
+#include "CesiumTileTrace.h"
+#include "CesiumTilesetBaking.h"
+#include "CesiumTilesetReaper.h"
+#include "CesiumTilePipelineTimings.h"
+#include "CesiumTilesetUpdateScheduler.h"
+#include "CesiumTriangleBvh.h"
 #include "CesiumViewExtension.h"
+#include "CesiumWarmStartAssetAccessor.h"
+#include "CesiumWgs84Ellipsoid.h"
+#include "CesiumWorldLoadBudget.h"
 #include "Components/SceneCaptureComponent2D.h"
+#include "Components/StaticMeshComponent.h"
 #include "CreateGltfOptions.h"
+#include "DistanceFieldAtlas.h"
 #include "Engine/Engine.h"
+#include "Engine/LatentActionManager.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/SceneCapture2D.h"
 #include "Engine/Texture.h"
@@ -39,17 +87,34 @@
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
+#include "EyeTrackerFunctionLibrary.h"
 #include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
 #include "Kismet/GameplayStatics.h"
+#include "LatentActions.h"
 #include "LevelSequenceActor.h"
 #include "LevelSequencePlayer.h"
 #include "Math/UnrealMathUtility.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
 #include "PixelFormat.h"
+#include "RHI.h"
+#include "RenderCore.h"
 #include "StereoRendering.h"
+#include "Tasks/Task.h"
+#include "UnrealTaskProcessor.h"
 #include "VecMath.h"
+#include <algorithm>
+#include <cmath>
 #include <glm/gtc/matrix_inverse.hpp>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <shared_mutex>
 #include <spdlog/spdlog.h>
+#include <unordered_set>
 
 FCesium3DTilesetLoadFailure OnCesium3DTilesetLoadFailure{};
 
@@ -80,14 +145,22 @@ ACesium3DTileset::ACesium3DTileset()
       _lastTilesOccluded(0),
       _lastTilesWaitingForOcclusionResults(0),
       _lastMaxDepthVisited(0),
+      _mainThreadLoadingTimeThisFrame(0.0),
+      _scalabilityMaximumTextureSize(0),
+      _pLastViewUpdateResult(nullptr),
+      _lastViewIsStatic(false),
 
       _captureMovieMode{false},
       _beforeMoviePreloadAncestors{PreloadAncestors},
       _beforeMoviePreloadSiblings{PreloadSiblings},
       _beforeMovieLoadingDescendantLimit{LoadingDescendantLimit},
       _beforeMovieUseLodTransitions{true},
+      _keepMeshDataForBaking(false),
+      _movieLookAheadFirstFrame(0),
+      _movieLookAheadEndFrame(0),
 
-      _tilesetsBeingDestroyed(0) {
+      _requestGroup(0),
+      _bandwidthStream(0) {
 
   PrimaryActorTick.bCanEverTick = true;
   PrimaryActorTick.TickGroup = ETickingGroup::TG_PostUpdateWork;
@@ -231,6 +304,378 @@ void ACesium3DTileset::InvalidateResolvedCameraManager() {
 
 void ACesium3DTileset::RefreshTileset() { this->DestroyTileset(); }
 
+namespace {
+template <typename T> bool isSameDescription(const T& lhs, const T& rhs) {
+  return T::StaticStruct()->CompareScriptStruct(&lhs, &rhs, PPF_None);
+}
+} // namespace
+
+void ACesium3DTileset::UpdateFeaturesMetadata() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateFeaturesMetadata)
+
+  if (!this->_pTileset) {
+    // The description is read from the component when the tileset is loaded.
+    return;
+  }
+
+  const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
+      this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
+  // The loaded tiles may not have the data to encode other properties.
+  if (!pFeaturesMetadataComponent || !this->_featuresMetadataDescription ||
+      this->_featuresMetadataDescription->DiscardUnencodedPropertyTableData ||
+      pFeaturesMetadataComponent->DiscardUnencodedPropertyTableData) {
+    this->RefreshTileset();
+    return;
+  }
+
+  const FCesiumFeaturesMetadataDescription& loadedDescription =
+      *this->_featuresMetadataDescription;
+  FCesiumPrimitiveFeaturesDescription features{
+      pFeaturesMetadataComponent->FeatureIdSets};
+  FCesiumPrimitiveMetadataDescription primitiveMetadata{
+      pFeaturesMetadataComponent->PropertyTextureNames};
+  FCesiumModelMetadataDescription modelMetadata{
+      loadedDescription.ModelMetadata.PropertyTables,
+      pFeaturesMetadataComponent->PropertyTextures};
+  if (!isSameDescription(features, loadedDescription.Features) ||
+      !isSameDescription(
+          primitiveMetadata,
+          loadedDescription.PrimitiveMetadata) ||
+      !isSameDescription(modelMetadata, loadedDescription.ModelMetadata)) {
+    this->RefreshTileset();
+    return;
+  }
+
+  modelMetadata.PropertyTables = pFeaturesMetadataComponent->PropertyTables;
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->UpdatePropertyTables(modelMetadata);
+  }
+
+  this->_updatedModelMetadataDescription = MoveTemp(modelMetadata);
+
+  // The index of the styled property may have changed.
+  this->updateFeatureStyleTexture();
+}
+
+void ACesium3DTileset::InvalidateView() {
+  this->_pLastViewUpdateResult = nullptr;
+  this->_lastViewIsStatic = false;
+}
+
+void ACesium3DTileset::FreezeSelection(bool TrimCachedTiles) {
+  if (TrimCachedTiles && this->_pTileset && this->_pLastViewUpdateResult) {
+    this->_freezePending = true;
+  } else {
+    this->completeFreeze();
+  }
+}
+
+void ACesium3DTileset::UnfreezeSelection() {
+  this->_selectionFrozen = false;
+  this->_freezePending = false;
+  this->_lastViewIsStatic = false;
+}
+
+namespace {
+
+// The number of views passed to each updateViewOffline call while prewarming.
+// Batching keeps the progress dialog responsive and limits how many tiles must
+// be held in memory at once.
+constexpr size_t PrewarmViewsPerBatch = 16;
+
+FAutoConsoleCommandWithWorldAndArgs PrewarmCacheCommand(
+    TEXT("Cesium.PrewarmCache"),
+    TEXT(
+        "Loads the Prewarm Region of Cesium 3D Tilesets into the request "
+        "cache. Takes an optional list of tileset names; by default, every "
+        "tileset with a Prewarm Region is prewarmed. To prewarm from the "
+        "command line, pass -ExecCmds=\"Cesium.PrewarmCache\"."),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args, UWorld* pWorld) {
+          if (!pWorld) {
+            return;
+          }
+
+          for (TActorIterator<ACesium3DTileset> it(pWorld); it; ++it) {
+            ACesium3DTileset* pTileset = *it;
+            if (pTileset->PrewarmRegion.IsNull()) {
+              continue;
+            }
+            if (Args.Num() > 0 && !Args.Contains(pTileset->GetName()) &&
+                !Args.Contains(pTileset->GetActorNameOrLabel())) {
+              continue;
+            }
+            pTileset->PrewarmCache();
+          }
+        }));
+
+} // namespace
+
+void ACesium3DTileset::PrewarmCache() {
+  ACesiumCartographicPolygon* pRegion = this->PrewarmRegion.Get();
+  if (!pRegion) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot prewarm the cache for tileset %s without a Prewarm "
+             "Region."),
+        *this->GetName());
+    return;
+  }
+
+  this->PrewarmCacheForRegion(
+      pRegion,
+      this->PrewarmViewHeight,
+      this->PrewarmMaximumScreenSpaceError);
+}
+
+int32 ACesium3DTileset::PrewarmCacheForRegion(
+    ACesiumCartographicPolygon* Region,
+    double ViewHeight,
+    double PrewarmScreenSpaceError) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::PrewarmCache)
+
+  if (!Region) {
+    return 0;
+  }
+
+  this->LoadTileset();
+  if (!this->_pTileset) {
+    return 0;
+  }
+
+  CesiumGeospatial::CartographicPolygon polygon =
+      Region->CreateCartographicPolygon(this->GetActorTransform().Inverse());
+  std::vector<Cesium3DTilesSelection::ViewState> views =
+      CesiumCachePrewarming::createNadirViews(
+          polygon,
+          FMath::Max(ViewHeight, 1.0));
+  if (views.empty()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot prewarm the cache for tileset %s because the region %s "
+             "is empty."),
+        *this->GetName(),
+        *Region->GetName());
+    return 0;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("Prewarming the cache for tileset %s from %d views of region %s."),
+      *this->GetName(),
+      int32(views.size()),
+      *Region->GetName());
+
+  this->updateTilesetOptionsFromProperties();
+  this->_pTileset->getOptions().maximumScreenSpaceError =
+      FMath::Max(PrewarmScreenSpaceError, 0.0);
+
+  const size_t batchCount =
+      (views.size() + PrewarmViewsPerBatch - 1) / PrewarmViewsPerBatch;
+  FScopedSlowTask slowTask(
+      float(batchCount),
+      FText::FromString(
+          FString::Printf(TEXT("Prewarming cache for %s"), *this->GetName())));
+  slowTask.MakeDialog(true);
+
+  std::vector<Cesium3DTilesSelection::ViewState> batch;
+  batch.reserve(PrewarmViewsPerBatch);
+
+  // Nothing that is prewarmed is needed for the current view, so let the
+  // loads for the views of any other tilesets go first.
+  UnrealTaskProcessor::SpeculativeScope speculativeScope;
+
+  int32 viewsLoaded = 0;
+  for (size_t i = 0; i < views.size(); i += PrewarmViewsPerBatch) {
+    if (slowTask.ShouldCancel()) {
+      UE_LOG(
+          LogCesium,
+          Display,
+          TEXT("Prewarming the cache for tileset %s was cancelled."),
+          *this->GetName());
+      break;
+    }
+    slowTask.EnterProgressFrame();
+
+    const size_t end = std::min(i + PrewarmViewsPerBatch, views.size());
+    batch.assign(views.begin() + i, views.begin() + end);
+    this->_pTileset->updateViewOffline(batch);
+    this->InvalidateView();
+    this->applyPendingRasterTiles();
+    viewsLoaded += int32(batch.size());
+  }
+
+  // Restore the selection options for normal rendering.
+  this->updateTilesetOptionsFromProperties();
+
+  return viewsLoaded;
+}
+
+void ACesium3DTileset::BakeTilesetRegion() {
+  ACesiumCartographicPolygon* pRegion = this->BakeRegion.Get();
+  if (!pRegion) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot bake tileset %s without a Bake Region."),
+        *this->GetName());
+    return;
+  }
+
+  this->BakeRegionToStaticMeshes(
+      pRegion,
+      this->BakeViewHeight,
+      this->BakeMaximumScreenSpaceError,
+      this->BakeOutputPath,
+      this->BakeHLODLayer,
+      this->BakeNaniteMeshes);
+}
+
+int32 ACesium3DTileset::BakeRegionToStaticMeshes(
+    ACesiumCartographicPolygon* Region,
+    double ViewHeight,
+    double BakeScreenSpaceError,
+    const FString& OutputPath,
+    UHLODLayer* HLODLayer,
+    bool BuildNanite) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BakeRegion)
+
+  UWorld* pWorld = this->GetWorld();
+  if (!Region || !pWorld) {
+    return 0;
+  }
+
+  if (!CesiumTilesetBaking::isSupported()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot bake tileset %s outside of the editor."),
+        *this->GetName());
+    return 0;
+  }
+
+  // Reload the tileset so that its primitives keep their triangles.
+  this->DestroyTileset();
+  this->_keepMeshDataForBaking = true;
+  this->LoadTileset();
+  if (!this->_pTileset) {
+    this->_keepMeshDataForBaking = false;
+    return 0;
+  }
+
+  CesiumGeospatial::CartographicPolygon polygon =
+      Region->CreateCartographicPolygon(this->GetActorTransform().Inverse());
+  std::vector<Cesium3DTilesSelection::ViewState> views =
+      CesiumCachePrewarming::createNadirViews(
+          polygon,
+          FMath::Max(ViewHeight, 1.0));
+  if (views.empty()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot bake tileset %s because the region %s is empty."),
+        *this->GetName(),
+        *Region->GetName());
+    this->_keepMeshDataForBaking = false;
+    this->DestroyTileset();
+    return 0;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("Baking tileset %s from %d views of region %s."),
+      *this->GetName(),
+      int32(views.size()),
+      *Region->GetName());
+
+  this->updateTilesetOptionsFromProperties();
+  this->_pTileset->getOptions().maximumScreenSpaceError =
+      FMath::Max(BakeScreenSpaceError, 0.0);
+
+  FScopedSlowTask slowTask(
+      2.0f,
+      FText::FromString(
+          FString::Printf(TEXT("Baking %s"), *this->GetName())));
+  slowTask.MakeDialog();
+
+  // Unlike prewarming, the tiles for every view are selected at once, so that
+  // the baked tiles don't overlap where neighboring views would select
+  // different levels of detail.
+  slowTask.EnterProgressFrame(1.0f);
+  const Cesium3DTilesSelection::ViewUpdateResult& result =
+      this->_pTileset->updateViewOffline(views);
+  this->InvalidateView();
+  this->applyPendingRasterTiles();
+
+  slowTask.EnterProgressFrame(1.0f);
+  const FName folderPath(*FString::Printf(
+      TEXT("Cesium/Baked/%s"),
+      *this->GetActorNameOrLabel()));
+  int32 actorCount = 0;
+  for (Cesium3DTilesSelection::Tile* pTile : result.tilesToRenderThisFrame) {
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    const UCesiumGltfComponent* pGltf =
+        pRenderContent ? static_cast<const UCesiumGltfComponent*>(
+                             pRenderContent->getRenderResources())
+                       : nullptr;
+    if (!pGltf) {
+      continue;
+    }
+
+    int32 primitiveIndex = 0;
+    for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+      const UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive || !pPrimitive->BakingGeometry) {
+        continue;
+      }
+
+      // Tile IDs aren't valid asset names, so name the assets by a hash of
+      // them instead.
+      const std::string tileID =
+          Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+              pTile->getTileID());
+      const FString assetName = FString::Printf(
+          TEXT("SM_%s_%016llx_%d"),
+          *this->GetName(),
+          CityHash64(tileID.data(), uint32(tileID.size())),
+          primitiveIndex++);
+      if (CesiumTilesetBaking::bakePrimitive(
+              *pWorld,
+              *pPrimitive,
+              OutputPath,
+              assetName,
+              folderPath,
+              HLODLayer,
+              BuildNanite)) {
+        ++actorCount;
+      }
+    }
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("Baked %d static meshes from tileset %s into %s."),
+      actorCount,
+      *this->GetName(),
+      *OutputPath);
+
+  // Reload the tileset without keeping the triangles.
+  this->_keepMeshDataForBaking = false;
+  this->DestroyTileset();
+
+  return actorCount;
+}
+
 void ACesium3DTileset::TroubleshootToken() {
   OnCesium3DTilesetIonTroubleshooting.Broadcast(this);
 }
@@ -330,9 +775,10 @@ void ACesium3DTileset::SetMaximumScreenSpaceError(
 }
 
 bool ACesium3DTileset::GetEnableOcclusionCulling() const {
+  // Each node of a cluster would cull against its own view.
   return GetDefault<UCesiumRuntimeSettings>()
              ->EnableExperimentalOcclusionCullingFeature &&
-         EnableOcclusionCulling;
+         EnableOcclusionCulling && !UseClusterSelection;
 }
 
 void ACesium3DTileset::SetEnableOcclusionCulling(bool bEnableOcclusionCulling) {
@@ -364,1579 +810,4878 @@ void ACesium3DTileset::SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes) {
   }
 }
 
-void ACesium3DTileset::SetCreateNavCollision(bool bCreateNavCollision) {
-  if (this->CreateNavCollision != bCreateNavCollision) {
-    this->CreateNavCollision = bCreateNavCollision;
+void ACesium3DTileset::SetCookPhysicsMeshesOnDemand(
+    bool bCookPhysicsMeshesOnDemand) {
+  if (this->CookPhysicsMeshesOnDemand != bCookPhysicsMeshesOnDemand) {
+    this->CookPhysicsMeshesOnDemand = bCookPhysicsMeshesOnDemand;
     this->DestroyTileset();
   }
 }
 
-void ACesium3DTileset::SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents) {
-  if (this->AlwaysIncludeTangents != bAlwaysIncludeTangents) {
-    this->AlwaysIncludeTangents = bAlwaysIncludeTangents;
+void ACesium3DTileset::SetCollisionOnly(bool bCollisionOnly) {
+  if (this->CollisionOnly != bCollisionOnly) {
+    this->CollisionOnly = bCollisionOnly;
     this->DestroyTileset();
   }
 }
 
-void ACesium3DTileset::SetGenerateSmoothNormals(bool bGenerateSmoothNormals) {
-  if (this->GenerateSmoothNormals != bGenerateSmoothNormals) {
-    this->GenerateSmoothNormals = bGenerateSmoothNormals;
-    this->DestroyTileset();
-  }
+void ACesium3DTileset::SetPhysicsInterestRadius(
+    double InPhysicsInterestRadius) {
+  this->PhysicsInterestRadius = FMath::Max(InPhysicsInterestRadius, 0.0);
 }
 
-void ACesium3DTileset::SetEnableWaterMask(bool bEnableMask) {
-  if (this->EnableWaterMask != bEnableMask) {
-    this->EnableWaterMask = bEnableMask;
-    this->DestroyTileset();
-  }
+void ACesium3DTileset::SetPhysicsInterestActors(
+    const TArray<TSoftObjectPtr<AActor>>& InPhysicsInterestActors) {
+  this->PhysicsInterestActors = InPhysicsInterestActors;
 }
 
-void ACesium3DTileset::SetIgnoreKhrMaterialsUnlit(
-    bool bIgnoreKhrMaterialsUnlit) {
-  if (this->IgnoreKhrMaterialsUnlit != bIgnoreKhrMaterialsUnlit) {
-    this->IgnoreKhrMaterialsUnlit = bIgnoreKhrMaterialsUnlit;
-    this->DestroyTileset();
+void ACesium3DTileset::AddPhysicsInterestActor(AActor* Actor) {
+  if (Actor) {
+    this->PhysicsInterestActors.AddUnique(Actor);
   }
 }
 
-void ACesium3DTileset::SetMaterial(UMaterialInterface* InMaterial) {
-  if (this->Material != InMaterial) {
-    this->Material = InMaterial;
-    this->DestroyTileset();
+void ACesium3DTileset::RemovePhysicsInterestActor(AActor* Actor) {
+  if (Actor) {
+    this->PhysicsInterestActors.Remove(Actor);
   }
 }
 
-void ACesium3DTileset::SetTranslucentMaterial(UMaterialInterface* InMaterial) {
-  if (this->TranslucentMaterial != InMaterial) {
-    this->TranslucentMaterial = InMaterial;
+void ACesium3DTileset::SetCreateNavCollision(bool bCreateNavCollision) {
+  if (this->CreateNavCollision != bCreateNavCollision) {
+    this->CreateNavCollision = bCreateNavCollision;
     this->DestroyTileset();
   }
 }
 
-void ACesium3DTileset::SetWaterMaterial(UMaterialInterface* InMaterial) {
-  if (this->WaterMaterial != InMaterial) {
-    this->WaterMaterial = InMaterial;
+void ACesium3DTileset::SetEnableHeightQueries(bool bEnableHeightQueries) {
+  if (this->EnableHeightQueries != bEnableHeightQueries) {
+    this->EnableHeightQueries = bEnableHeightQueries;
     this->DestroyTileset();
   }
 }
 
-void ACesium3DTileset::SetCustomDepthParameters(
-    FCustomDepthParameters InCustomDepthParameters) {
-  if (this->CustomDepthParameters != InCustomDepthParameters) {
-    this->CustomDepthParameters = InCustomDepthParameters;
-    this->DestroyTileset();
+namespace {
+// The heights between which SampleHeightsOfLoadedTiles looks for the surface,
+// in meters, which cover the highest mountains and deepest ocean trenches.
+constexpr double MaximumSampledHeight = 10000.0;
+constexpr double MinimumSampledHeight = -12000.0;
+
+// The lines per batch of a parallel height query or line trace.
+constexpr int32 LinesPerParallelBatch = 64;
+
+// The most positions that SampleHeightMostDetailed refines the tileset at
+// at once, each of which adds a camera to the tileset's updates.
+constexpr int32 MaximumHeightSampleCameras = 256;
+
+// The distance from a position, in multiples of a tile's geometric error,
+// within which SampleHeightMostDetailed refines the tile. Heights sampled from
+// a tile are within about its geometric error of the surface, so this is
+// large enough to refine its children even when the position's height isn't
+// known precisely yet.
+constexpr double HeightSampleRefinementDistance = 4.0;
+
+// How much a sampled height may change between updates, in meters, and still
+// be considered stable.
+constexpr double HeightSampleTolerance = 0.001;
+
+struct RayQueryPrimitive {
+  TWeakObjectPtr<UCesiumGltfPrimitiveComponent> pComponent;
+  FTransform transform;
+  FBox bounds;
+  TSharedPtr<const CesiumTriangleBvh, ESPMode::ThreadSafe> pBvh;
+  double geometricError;
+};
+
+// Gets the primitives of the tiles that are shown, which have hierarchies to
+// intersect lines with.
+TArray<RayQueryPrimitive> gatherRayQueryPrimitives(ACesium3DTileset& tileset) {
+  TArray<RayQueryPrimitive> primitives;
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  tileset.GetComponents(gltfComponents);
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    if (!pGltf->IsVisible()) {
+      continue;
+    }
+    for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive || !pPrimitive->HeightQueryBvh ||
+          pPrimitive->HeightQueryBvh->isEmpty()) {
+        continue;
+      }
+      const FTransform& transform = pPrimitive->GetComponentTransform();
+      primitives.Add(RayQueryPrimitive{
+          pPrimitive,
+          transform,
+          pPrimitive->HeightQueryBvh->getBounds().TransformBy(transform),
+          pPrimitive->HeightQueryBvh,
+          pGltf->GeometricError});
+    }
   }
+  return primitives;
 }
 
-void ACesium3DTileset::SetPointCloudShading(
-    FCesiumPointCloudShading InPointCloudShading) {
-  if (PointCloudShading != InPointCloudShading) {
-    PointCloudShading = InPointCloudShading;
-    FCesiumGltfPointsSceneProxyUpdater::UpdateSettingsInProxies(this);
+struct LineHit {
+  // The fraction of the way from the start to the end of the line.
+  double fraction;
+  int32 primitive;
+  int32 triangle;
+};
+
+// Finds the first point where a line, in world coordinates, hits one of the
+// primitives. Transforming the line into each primitive's space doesn't
+// change the fraction of the way along it of a hit. May be called from any
+// thread.
+std::optional<LineHit> intersectLine(
+    const TArray<RayQueryPrimitive>& primitives,
+    const FVector& start,
+    const FVector& end) {
+  const FVector startToEnd = end - start;
+  std::optional<LineHit> result;
+  double closest = 1.0;
+  for (int32 i = 0; i < primitives.Num(); ++i) {
+    const RayQueryPrimitive& primitive = primitives[i];
+    if (!FMath::LineBoxIntersection(primitive.bounds, start, end, startToEnd)) {
+      continue;
+    }
+    const FVector localStart =
+        primitive.transform.InverseTransformPosition(start);
+    const FVector localEnd = primitive.transform.InverseTransformPosition(end);
+    double fraction;
+    int32 triangle;
+    if (primitive.pBvh->intersectRay(
+            localStart,
+            localEnd - localStart,
+            closest,
+            fraction,
+            &triangle)) {
+      closest = fraction;
+      result = LineHit{fraction, i, triangle};
+    }
   }
+  return result;
 }
 
-void ACesium3DTileset::PlayMovieSequencer() {
-  this->_beforeMoviePreloadAncestors = this->PreloadAncestors;
-  this->_beforeMoviePreloadSiblings = this->PreloadSiblings;
-  this->_beforeMovieLoadingDescendantLimit = this->LoadingDescendantLimit;
-  this->_beforeMovieUseLodTransitions = this->UseLodTransitions;
+void traceLine(
+    const TArray<RayQueryPrimitive>& primitives,
+    const FVector& start,
+    const FVector& end,
+    FHitResult& hitResult) {
+  hitResult = FHitResult(start, end);
 
-  this->_captureMovieMode = true;
-  this->PreloadAncestors = false;
-  this->PreloadSiblings = false;
-  this->LoadingDescendantLimit = 10000;
-  this->UseLodTransitions = false;
+  std::optional<LineHit> maybeHit = intersectLine(primitives, start, end);
+  if (!maybeHit) {
+    return;
+  }
+
+  const RayQueryPrimitive& primitive = primitives[maybeHit->primitive];
+  FVector v0, v1, v2;
+  primitive.pBvh->getTriangle(maybeHit->triangle, v0, v1, v2);
+  v0 = primitive.transform.TransformPosition(v0);
+  v1 = primitive.transform.TransformPosition(v1);
+  v2 = primitive.transform.TransformPosition(v2);
+
+  // Triangles are hit from either side, so the normal faces the start.
+  FVector normal = FVector::CrossProduct(v1 - v0, v2 - v0).GetSafeNormal();
+  if (FVector::DotProduct(normal, end - start) > 0.0) {
+    normal = -normal;
+  }
+
+  const FVector location = FMath::Lerp(start, end, maybeHit->fraction);
+  hitResult.bBlockingHit = true;
+  hitResult.Time = float(maybeHit->fraction);
+  hitResult.Distance = float(FVector::Dist(start, location));
+  hitResult.Location = location;
+  hitResult.ImpactPoint = location;
+  hitResult.Normal = normal;
+  hitResult.ImpactNormal = normal;
+  hitResult.Component = primitive.pComponent;
+  hitResult.FaceIndex = maybeHit->triangle;
 }
+// Samples the heights of positions from the primitives, replacing the
+// heights of the positions that are sampled.
+void sampleHeights(
+    const TArray<RayQueryPrimitive>& primitives,
+    const ACesiumGeoreference& georeference,
+    TArrayView<FVector> longitudeLatitudeHeights,
+    TArrayView<bool> outSampleSuccess,
+    TArrayView<double> outGeometricErrors) {
+  const int32 count = longitudeLatitudeHeights.Num();
+  if (primitives.IsEmpty() || count == 0) {
+    return;
+  }
 
-void ACesium3DTileset::StopMovieSequencer() {
-  this->_captureMovieMode = false;
-  this->PreloadAncestors = this->_beforeMoviePreloadAncestors;
-  this->PreloadSiblings = this->_beforeMoviePreloadSiblings;
-  this->LoadingDescendantLimit = this->_beforeMovieLoadingDescendantLimit;
-  this->UseLodTransitions = this->_beforeMovieUseLodTransitions;
+  // Each position is sampled along the line between these heights above and
+  // below it, from the top.
+  TArray<FVector> ecefEndpoints;
+  ecefEndpoints.SetNumUninitialized(2 * count);
+  for (int32 i = 0; i < count; ++i) {
+    const FVector& position = longitudeLatitudeHeights[i];
+    ecefEndpoints[2 * i] =
+        UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightToEarthCenteredEarthFixed(
+            FVector(position.X, position.Y, MaximumSampledHeight));
+    ecefEndpoints[2 * i + 1] =
+        UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightToEarthCenteredEarthFixed(
+            FVector(position.X, position.Y, MinimumSampledHeight));
+  }
+
+  TArray<FVector> endpoints =
+      georeference.TransformEarthCenteredEarthFixedPositionsToUnreal(
+          ecefEndpoints);
+  const FTransform& georeferenceTransform = georeference.GetActorTransform();
+  for (FVector& endpoint : endpoints) {
+    endpoint = georeferenceTransform.TransformPosition(endpoint);
+  }
+
+  const int32 batchCount =
+      (count + LinesPerParallelBatch - 1) / LinesPerParallelBatch;
+  ParallelFor(
+      batchCount,
+      [&](int32 batch) {
+        const int32 begin = batch * LinesPerParallelBatch;
+        const int32 end = std::min(begin + LinesPerParallelBatch, count);
+        for (int32 i = begin; i < end; ++i) {
+          std::optional<LineHit> maybeHit =
+              intersectLine(primitives, endpoints[2 * i], endpoints[2 * i + 1]);
+          if (maybeHit) {
+            longitudeLatitudeHeights[i].Z =
+                MaximumSampledHeight -
+                maybeHit->fraction *
+                    (MaximumSampledHeight - MinimumSampledHeight);
+            outSampleSuccess[i] = true;
+            outGeometricErrors[i] =
+                primitives[maybeHit->primitive].geometricError;
+          }
+        }
+      },
+      batchCount > 1 ? EParallelForFlags::None
+                     : EParallelForFlags::ForceSingleThread);
 }
+} // namespace
 
-void ACesium3DTileset::PauseMovieSequencer() { this->StopMovieSequencer(); }
+void ACesium3DTileset::SampleHeightsOfLoadedTiles(
+    const TArray<FVector>& LongitudeLatitudeHeights,
+    TArray<FVector>& OutLongitudeLatitudeHeights,
+    TArray<bool>& OutSampleSuccess,
+    TArray<double>& OutGeometricErrors) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SampleHeightsOfLoadedTiles)
 
-#if WITH_EDITOR
-void ACesium3DTileset::OnFocusEditorViewportOnThis() {
+  OutLongitudeLatitudeHeights = LongitudeLatitudeHeights;
+  OutSampleSuccess.Init(false, LongitudeLatitudeHeights.Num());
+  OutGeometricErrors.Init(-1.0, LongitudeLatitudeHeights.Num());
 
-  UE_LOG(
-      LogCesium,
-      Verbose,
-      TEXT("Called OnFocusEditorViewportOnThis on actor %s"),
-      *this->GetName());
+  if (!this->EnableHeightQueries) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot sample heights of tileset %s without Enable Height "
+             "Queries."),
+        *this->GetName());
+    return;
+  }
 
-  struct CalculateECEFCameraPosition {
-    glm::dvec3 operator()(const CesiumGeometry::BoundingSphere& sphere) {
-      const glm::dvec3& center = sphere.getCenter();
-      glm::dmat4 ENU =
-          CesiumGeospatial::GlobeTransforms::eastNorthUpToFixedFrame(center);
-      glm::dvec3 offset =
-          sphere.getRadius() *
-          glm::normalize(
-              glm::dvec3(ENU[0]) + glm::dvec3(ENU[1]) + glm::dvec3(ENU[2]));
-      glm::dvec3 position = center + offset;
-      return position;
-    }
+  ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
+  if (!pGeoreference || LongitudeLatitudeHeights.IsEmpty()) {
+    return;
+  }
 
-    glm::dvec3
-    operator()(const CesiumGeometry::OrientedBoundingBox& orientedBoundingBox) {
-      const glm::dvec3& center = orientedBoundingBox.getCenter();
-      glm::dmat4 ENU =
-          CesiumGeospatial::GlobeTransforms::eastNorthUpToFixedFrame(center);
-      const glm::dmat3& halfAxes = orientedBoundingBox.getHalfAxes();
-      glm::dvec3 offset =
-          glm::length(halfAxes[0] + halfAxes[1] + halfAxes[2]) *
-          glm::normalize(
-              glm::dvec3(ENU[0]) + glm::dvec3(ENU[1]) + glm::dvec3(ENU[2]));
-      glm::dvec3 position = center + offset;
-      return position;
-    }
+  sampleHeights(
+      gatherRayQueryPrimitives(*this),
+      *pGeoreference,
+      OutLongitudeLatitudeHeights,
+      OutSampleSuccess,
+      OutGeometricErrors);
+}
 
-    glm::dvec3
-    operator()(const CesiumGeospatial::BoundingRegion& boundingRegion) {
-      return (*this)(boundingRegion.getBoundingBox());
-    }
+bool ACesium3DTileset::LineTraceLoadedTiles(
+    const FVector& Start,
+    const FVector& End,
+    FHitResult& OutHit) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LineTraceLoadedTiles)
 
-    glm::dvec3
-    operator()(const CesiumGeospatial::BoundingRegionWithLooseFittingHeights&
-                   boundingRegionWithLooseFittingHeights) {
-      return (*this)(boundingRegionWithLooseFittingHeights.getBoundingRegion()
-                         .getBoundingBox());
-    }
+  if (!this->EnableHeightQueries) {
+    OutHit = FHitResult(Start, End);
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot trace lines against tileset %s without Enable Height "
+             "Queries."),
+        *this->GetName());
+    return false;
+  }
 
-    glm::dvec3 operator()(const CesiumGeospatial::S2CellBoundingVolume& s2) {
-      return (*this)(s2.computeBoundingRegion());
-    }
-  };
+  traceLine(gatherRayQueryPrimitives(*this), Start, End, OutHit);
+  return OutHit.bBlockingHit;
+}
 
-  const Cesium3DTilesSelection::Tile* pRootTile =
-      this->_pTileset->getRootTile();
-  if (!pRootTile) {
+void ACesium3DTileset::LineTraceLoadedTilesBatch(
+    const TArray<FVector>& Starts,
+    const TArray<FVector>& Ends,
+    TArray<FHitResult>& OutHits) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LineTraceLoadedTilesBatch)
+
+  const int32 count = std::min(Starts.Num(), Ends.Num());
+  OutHits.SetNum(count);
+
+  if (!this->EnableHeightQueries) {
+    for (int32 i = 0; i < count; ++i) {
+      OutHits[i] = FHitResult(Starts[i], Ends[i]);
+    }
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot trace lines against tileset %s without Enable Height "
+             "Queries."),
+        *this->GetName());
     return;
   }
 
-  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
-      pRootTile->getBoundingVolume();
-
-  ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
+  const TArray<RayQueryPrimitive> primitives = gatherRayQueryPrimitives(*this);
+  const int32 batchCount =
+      (count + LinesPerParallelBatch - 1) / LinesPerParallelBatch;
+  ParallelFor(
+      batchCount,
+      [&](int32 batch) {
+        const int32 begin = batch * LinesPerParallelBatch;
+        const int32 end = std::min(begin + LinesPerParallelBatch, count);
+        for (int32 i = begin; i < end; ++i) {
+          traceLine(primitives, Starts[i], Ends[i], OutHits[i]);
+        }
+      },
+      batchCount > 1 ? EParallelForFlags::None
+                     : EParallelForFlags::ForceSingleThread);
+}
 
-  // calculate unreal camera position
-  glm::dvec3 ecefCameraPosition =
-      std::visit(CalculateECEFCameraPosition{}, boundingVolume);
-  FVector unrealCameraPosition =
-      pGeoreference->TransformEarthCenteredEarthFixedPositionToUnreal(
-          VecMath::createVector(ecefCameraPosition));
+void ACesium3DTileset::SampleHeightMostDetailed(
+    const TArray<FVector>& LongitudeLatitudeHeights,
+    const FCesiumSampleHeightMostDetailedCallback& OnHeightsSampled) {
+  HeightSampleQuery query;
+  query.positions = LongitudeLatitudeHeights;
+  query.sampleSuccess.Init(false, LongitudeLatitudeHeights.Num());
+  query.geometricErrors.Init(-1.0, LongitudeLatitudeHeights.Num());
+  query.callback = OnHeightsSampled;
 
-  // calculate unreal camera orientation
-  glm::dvec3 ecefCenter =
-      Cesium3DTilesSelection::getBoundingVolumeCenter(boundingVolume);
-  FVector unrealCenter =
-      pGeoreference->TransformEarthCenteredEarthFixedPositionToUnreal(
-          VecMath::createVector(ecefCenter));
-  FVector unrealCameraFront =
-      (unrealCenter - unrealCameraPosition).GetSafeNormal();
-  FVector unrealCameraRight =
-      FVector::CrossProduct(FVector::ZAxisVector, unrealCameraFront)
-          .GetSafeNormal();
-  FVector unrealCameraUp =
-      FVector::CrossProduct(unrealCameraFront, unrealCameraRight)
-          .GetSafeNormal();
-  FRotator cameraRotator = FMatrix(
-                               unrealCameraFront,
-                               unrealCameraRight,
-                               unrealCameraUp,
-                               FVector::ZeroVector)
-                               .Rotator();
+  if (!this->EnableHeightQueries) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Cannot sample heights of tileset %s without Enable Height "
+             "Queries."),
+        *this->GetName());
+  }
 
-  // Update all viewports.
-  for (FLevelEditorViewportClient* LinkedViewportClient :
-       GEditor->GetLevelViewportClients()) {
-    // Dont move camera attach to an actor
-    if (!LinkedViewportClient->IsAnyActorLocked()) {
-      FViewportCameraTransform& ViewTransform =
-          LinkedViewportClient->GetViewTransform();
-      LinkedViewportClient->SetViewRotation(cameraRotator);
-      LinkedViewportClient->SetViewLocation(unrealCameraPosition);
-      LinkedViewportClient->Invalidate();
-    }
+  if (!this->EnableHeightQueries || LongitudeLatitudeHeights.IsEmpty()) {
+    query.callback.ExecuteIfBound(
+        query.positions,
+        query.sampleSuccess,
+        query.geometricErrors);
+    return;
   }
+
+  this->_heightSampleQueries.Add(MoveTemp(query));
 }
-#endif
 
-const glm::dmat4&
-ACesium3DTileset::GetCesiumTilesetToUnrealRelativeWorldTransform() const {
-  return Cast<UCesium3DTilesetRoot>(this->RootComponent)
-      ->GetCesiumTilesetToUnrealRelativeWorldTransform();
+void ACesium3DTileset::addHeightSampleCameras(
+    std::vector<FCesiumCamera>& cameras) {
+  if (this->_heightSampleQueries.IsEmpty()) {
+    return;
+  }
+
+  ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
+  if (!pGeoreference) {
+    return;
+  }
+
+  const HeightSampleQuery& query = this->_heightSampleQueries[0];
+  const int32 batchCount = std::min(
+      MaximumHeightSampleCameras,
+      query.positions.Num() - query.batchStart);
+
+  // Each camera is at the height sampled for its position so far, and
+  // refines the tiles that contain it, or are within
+  // HeightSampleRefinementDistance times their geometric error of it, since
+  // a tile's screen-space error in a 90 degree view is its geometric error
+  // times half the viewport size over its distance.
+  const double size =
+      2.0 * HeightSampleRefinementDistance * this->MaximumScreenSpaceError;
+  const TArray<FVector> locations =
+      pGeoreference->TransformLongitudeLatitudeHeightPositionsToUnreal(
+          TArray<FVector>(
+              query.positions.GetData() + query.batchStart,
+              batchCount));
+  const FTransform& georeferenceTransform =
+      pGeoreference->GetActorTransform();
+
+  cameras.reserve(cameras.size() + size_t(locations.Num()));
+  for (const FVector& location : locations) {
+    cameras.emplace_back(
+        FVector2D(size, size),
+        georeferenceTransform.TransformPosition(location),
+        FRotator(-90.0, 0.0, 0.0),
+        90.0);
+  }
 }
 
-void ACesium3DTileset::UpdateTransformFromCesium() {
+void ACesium3DTileset::updateHeightSampleQueries() {
+  if (this->_heightSampleQueries.IsEmpty()) {
+    return;
+  }
 
-  const glm::dmat4& CesiumToUnreal =
-      this->GetCesiumTilesetToUnrealRelativeWorldTransform();
-  TArray<UCesiumGltfComponent*> gltfComponents;
-  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+  ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
+  if (!pGeoreference) {
+    return;
+  }
 
-  for (UCesiumGltfComponent* pGltf : gltfComponents) {
-    pGltf->UpdateTransformFromCesium(CesiumToUnreal);
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateHeightSampleQueries)
+
+  HeightSampleQuery& query = this->_heightSampleQueries[0];
+  const int32 batchCount = std::min(
+      MaximumHeightSampleCameras,
+      query.positions.Num() - query.batchStart);
+
+  TArray<FVector> positions(
+      query.positions.GetData() + query.batchStart,
+      batchCount);
+  TArray<bool> sampleSuccess;
+  sampleSuccess.Init(false, batchCount);
+  TArray<double> geometricErrors;
+  geometricErrors.Init(-1.0, batchCount);
+  sampleHeights(
+      gatherRayQueryPrimitives(*this),
+      *pGeoreference,
+      positions,
+      sampleSuccess,
+      geometricErrors);
+
+  bool stable = true;
+  for (int32 i = 0; i < batchCount; ++i) {
+    const int32 index = query.batchStart + i;
+    if (sampleSuccess[i] != query.sampleSuccess[index] ||
+        geometricErrors[i] != query.geometricErrors[index] ||
+        FMath::Abs(positions[i].Z - query.positions[index].Z) >
+            HeightSampleTolerance) {
+      stable = false;
+    }
+    query.positions[index] = positions[i];
+    query.sampleSuccess[index] = sampleSuccess[i];
+    query.geometricErrors[index] = geometricErrors[i];
   }
 
-  if (this->BoundingVolumePoolComponent) {
-    this->BoundingVolumePoolComponent->UpdateTransformFromCesium(
-        CesiumToUnreal);
+  // The cameras are placed at the heights sampled by the last update, so the
+  // batch is only done once its heights haven't moved them, and every tile
+  // that they need is loaded.
+  ++query.batchUpdates;
+  if (!stable || query.batchUpdates < 2 || this->LoadProgress < 100.0f) {
+    return;
   }
-}
 
-// Called when the game starts or when spawned
-void ACesium3DTileset::BeginPlay() {
-  Super::BeginPlay();
+  query.batchStart += batchCount;
+  query.batchUpdates = 0;
+  if (query.batchStart < query.positions.Num()) {
+    return;
+  }
 
-  this->ResolveGeoreference();
-  this->ResolveCameraManager();
-  this->ResolveCreditSystem();
+  // The callback may make another query.
+  HeightSampleQuery answered = MoveTemp(query);
+  this->_heightSampleQueries.RemoveAt(0);
+  answered.callback.ExecuteIfBound(
+      answered.positions,
+      answered.sampleSuccess,
+      answered.geometricErrors);
+}
 
-  this->LoadTileset();
+void ACesium3DTileset::cancelHeightSampleQueries() {
+  TArray<HeightSampleQuery> queries = MoveTemp(this->_heightSampleQueries);
+  this->_heightSampleQueries.Reset();
+  for (HeightSampleQuery& query : queries) {
+    query.positions.Reset();
+    query.sampleSuccess.Reset();
+    query.geometricErrors.Reset();
+    query.callback.ExecuteIfBound(
+        query.positions,
+        query.sampleSuccess,
+        query.geometricErrors);
+  }
+}
 
-  // Search for level sequence.
-  for (auto sequenceActorIt = TActorIterator<ALevelSequenceActor>(GetWorld());
-       sequenceActorIt;
-       ++sequenceActorIt) {
-    ALevelSequenceActor* sequenceActor = *sequenceActorIt;
+void ACesium3DTileset::SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents) {
+  if (this->AlwaysIncludeTangents != bAlwaysIncludeTangents) {
+    this->AlwaysIncludeTangents = bAlwaysIncludeTangents;
+    this->DestroyTileset();
+  }
+}
 
-    if (!IsValid(sequenceActor->GetSequencePlayer())) {
-      continue;
-    }
+void ACesium3DTileset::SetUseFastTangentGeneration(
+    bool bUseFastTangentGeneration) {
+  if (this->UseFastTangentGeneration != bUseFastTangentGeneration) {
+    this->UseFastTangentGeneration = bUseFastTangentGeneration;
+    this->DestroyTileset();
+  }
+}
 
-    FScriptDelegate playMovieSequencerDelegate;
-    playMovieSequencerDelegate.BindUFunction(this, FName("PlayMovieSequencer"));
-    sequenceActor->GetSequencePlayer()->OnPlay.Add(playMovieSequencerDelegate);
+void ACesium3DTileset::SetGenerateSmoothNormals(bool bGenerateSmoothNormals) {
+  if (this->GenerateSmoothNormals != bGenerateSmoothNormals) {
+    this->GenerateSmoothNormals = bGenerateSmoothNormals;
+    this->DestroyTileset();
+  }
+}
 
-    FScriptDelegate stopMovieSequencerDelegate;
-    stopMovieSequencerDelegate.BindUFunction(this, FName("StopMovieSequencer"));
-    sequenceActor->GetSequencePlayer()->OnStop.Add(stopMovieSequencerDelegate);
+void ACesium3DTileset::SetWeldVerticesForSmoothNormals(
+    bool bWeldVerticesForSmoothNormals) {
+  if (this->WeldVerticesForSmoothNormals != bWeldVerticesForSmoothNormals) {
+    this->WeldVerticesForSmoothNormals = bWeldVerticesForSmoothNormals;
+    this->DestroyTileset();
+  }
+}
 
-    FScriptDelegate pauseMovieSequencerDelegate;
-    pauseMovieSequencerDelegate.BindUFunction(
-        this,
-        FName("PauseMovieSequencer"));
-    sequenceActor->GetSequencePlayer()->OnPause.Add(
-        pauseMovieSequencerDelegate);
+void ACesium3DTileset::SetCompressTextures(bool bCompressTextures) {
+  if (this->CompressTextures != bCompressTextures) {
+    this->CompressTextures = bCompressTextures;
+    this->DestroyTileset();
   }
 }
 
-void ACesium3DTileset::OnConstruction(const FTransform& Transform) {
-  this->ResolveGeoreference();
-  this->ResolveCameraManager();
-  this->ResolveCreditSystem();
+void ACesium3DTileset::SetShareIdenticalTextures(
+    bool bShareIdenticalTextures) {
+  if (this->ShareIdenticalTextures != bShareIdenticalTextures) {
+    this->ShareIdenticalTextures = bShareIdenticalTextures;
+    this->DestroyTileset();
+  }
+}
 
-  this->LoadTileset();
+void ACesium3DTileset::SetSkipUnneededTextureMips(
+    bool bSkipUnneededTextureMips) {
+  if (this->SkipUnneededTextureMips != bSkipUnneededTextureMips) {
+    this->SkipUnneededTextureMips = bSkipUnneededTextureMips;
+    this->DestroyTileset();
+  }
+}
 
-  // Hide all existing tiles. The still-visible ones will be shown next time we
-  // tick. But if update is suspended, leave the components in their current
-  // state.
-  if (!this->SuspendUpdate) {
-    TArray<UCesiumGltfComponent*> gltfComponents;
-    this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+void ACesium3DTileset::SetBuildNaniteMeshes(bool bBuildNaniteMeshes) {
+  if (this->BuildNaniteMeshes != bBuildNaniteMeshes) {
+    this->BuildNaniteMeshes = bBuildNaniteMeshes;
+    this->DestroyTileset();
+  }
+}
 
-    for (UCesiumGltfComponent* pGltf : gltfComponents) {
-      if (pGltf && IsValid(pGltf) && pGltf->IsVisible()) {
-        pGltf->SetVisibility(false, true);
-        pGltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-      }
-    }
+void ACesium3DTileset::SetUseVertexPulling(bool bUseVertexPulling) {
+  if (this->UseVertexPulling != bUseVertexPulling) {
+    this->UseVertexPulling = bUseVertexPulling;
+    this->DestroyTileset();
   }
 }
 
-void ACesium3DTileset::NotifyHit(
-    UPrimitiveComponent* MyComp,
-    AActor* Other,
-    UPrimitiveComponent* OtherComp,
-    bool bSelfMoved,
-    FVector HitLocation,
-    FVector HitNormal,
-    FVector NormalImpulse,
-    const FHitResult& Hit) {
-  // std::cout << "Hit face index: " << Hit.FaceIndex << std::endl;
+void ACesium3DTileset::SetPackVertexAttributes(bool bPackVertexAttributes) {
+  if (this->PackVertexAttributes != bPackVertexAttributes) {
+    this->PackVertexAttributes = bPackVertexAttributes;
+    this->DestroyTileset();
+  }
+}
 
-  // FHitResult detailedHit;
-  // FCollisionQueryParams params;
-  // params.bReturnFaceIndex = true;
-  // params.bTraceComplex = true;
-  // MyComp->LineTraceComponent(detailedHit, Hit.TraceStart, Hit.TraceEnd,
-  // params);
+void ACesium3DTileset::SetUseLightweightPrimitives(
+    bool bUseLightweightPrimitives) {
+  if (this->UseLightweightPrimitives != bUseLightweightPrimitives) {
+    this->UseLightweightPrimitives = bUseLightweightPrimitives;
+    this->DestroyTileset();
+  }
+}
 
-  // std::cout << "Hit face index 2: " << detailedHit.FaceIndex << std::endl;
+void ACesium3DTileset::SetGltfDataRetention(
+    ECesiumGltfDataRetention InGltfDataRetention) {
+  if (this->GltfDataRetention != InGltfDataRetention) {
+    this->GltfDataRetention = InGltfDataRetention;
+    this->DestroyTileset();
+  }
 }
 
-class UnrealResourcePreparer
-    : public Cesium3DTilesSelection::IPrepareRendererResources {
-public:
-  UnrealResourcePreparer(ACesium3DTileset* pActor) : _pActor(pActor) {}
+void ACesium3DTileset::SetMergePrimitives(bool bMergePrimitives) {
+  if (this->MergePrimitives != bMergePrimitives) {
+    this->MergePrimitives = bMergePrimitives;
+    this->DestroyTileset();
+  }
+}
 
-  virtual CesiumAsync::Future<
-      Cesium3DTilesSelection::TileLoadResultAndRenderResources>
-  prepareInLoadThread(
-      const CesiumAsync::AsyncSystem& asyncSystem,
-      Cesium3DTilesSelection::TileLoadResult&& tileLoadResult,
-      const glm::dmat4& transform,
-      const std::any& rendererOptions) override {
-    CesiumGltf::Model* pModel =
-        std::get_if<CesiumGltf::Model>(&tileLoadResult.contentKind);
-    if (!pModel)
-      return asyncSystem.createResolvedFuture(
-          Cesium3DTilesSelection::TileLoadResultAndRenderResources{
-              std::move(tileLoadResult),
-              nullptr});
+void ACesium3DTileset::SetGenerateMeshDistanceFields(
+    bool bGenerateMeshDistanceFields) {
+  if (this->GenerateMeshDistanceFields != bGenerateMeshDistanceFields) {
+    this->GenerateMeshDistanceFields = bGenerateMeshDistanceFields;
+    this->DestroyTileset();
+  }
+}
 
-    CreateGltfOptions::CreateModelOptions options;
-    options.pModel = pModel;
-    options.alwaysIncludeTangents = this->_pActor->GetAlwaysIncludeTangents();
-    options.createPhysicsMeshes = this->_pActor->GetCreatePhysicsMeshes();
+void ACesium3DTileset::SetLimitRayTracingGeometryBuilds(
+    bool bLimitRayTracingGeometryBuilds) {
+  if (this->LimitRayTracingGeometryBuilds != bLimitRayTracingGeometryBuilds) {
+    this->LimitRayTracingGeometryBuilds = bLimitRayTracingGeometryBuilds;
+    this->DestroyTileset();
+  }
+}
 
-    options.ignoreKhrMaterialsUnlit =
-        this->_pActor->GetIgnoreKhrMaterialsUnlit();
+void ACesium3DTileset::SetTileShadowCacheInvalidationBehavior(
+    EShadowCacheInvalidationBehavior InBehavior) {
+  if (this->TileShadowCacheInvalidationBehavior != InBehavior) {
+    this->TileShadowCacheInvalidationBehavior = InBehavior;
+    this->DestroyTileset();
+  }
+}
 
-    if (this->_pActor->_featuresMetadataDescription) {
-      options.pFeaturesMetadataDescription =
-          &(*this->_pActor->_featuresMetadataDescription);
-    } else if (this->_pActor->_metadataDescription_DEPRECATED) {
-      options.pEncodedMetadataDescription_DEPRECATED =
-          &(*this->_pActor->_metadataDescription_DEPRECATED);
-    }
+void ACesium3DTileset::SetComputeFlatNormalsInMaterial(
+    bool bComputeFlatNormalsInMaterial) {
+  if (this->ComputeFlatNormalsInMaterial != bComputeFlatNormalsInMaterial) {
+    this->ComputeFlatNormalsInMaterial = bComputeFlatNormalsInMaterial;
+    this->DestroyTileset();
+  }
+}
 
-    TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf =
-        UCesiumGltfComponent::CreateOffGameThread(transform, options);
-    return asyncSystem.createResolvedFuture(
-        Cesium3DTilesSelection::TileLoadResultAndRenderResources{
-            std::move(tileLoadResult),
-            pHalf.Release()});
+void ACesium3DTileset::SetOrderPointsProgressively(
+    bool bOrderPointsProgressively) {
+  if (this->OrderPointsProgressively != bOrderPointsProgressively) {
+    this->OrderPointsProgressively = bOrderPointsProgressively;
+    this->DestroyTileset();
   }
+}
 
-  virtual void* prepareInMainThread(
-      Cesium3DTilesSelection::Tile& tile,
-      void* pLoadThreadResult) override {
-    const Cesium3DTilesSelection::TileContent& content = tile.getContent();
-    if (content.isRenderContent()) {
-      TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf(
-          reinterpret_cast<UCesiumGltfComponent::HalfConstructed*>(
-              pLoadThreadResult));
-      const Cesium3DTilesSelection::TileRenderContent& renderContent =
-          *content.getRenderContent();
-      return UCesiumGltfComponent::CreateOnGameThread(
-          renderContent.getModel(),
-          this->_pActor,
-          std::move(pHalf),
-          _pActor->GetCesiumTilesetToUnrealRelativeWorldTransform(),
-          this->_pActor->GetMaterial(),
-          this->_pActor->GetTranslucentMaterial(),
-          this->_pActor->GetWaterMaterial(),
-          this->_pActor->GetCustomDepthParameters(),
-          tile,
-          this->_pActor->GetCreateNavCollision());
-    }
-    // UE_LOG(LogCesium, VeryVerbose, TEXT("No content for tile"));
-    return nullptr;
+void ACesium3DTileset::SetComputeOverlayTextureCoordinatesInMaterial(
+    bool bComputeOverlayTextureCoordinatesInMaterial) {
+  if (this->ComputeOverlayTextureCoordinatesInMaterial !=
+      bComputeOverlayTextureCoordinatesInMaterial) {
+    this->ComputeOverlayTextureCoordinatesInMaterial =
+        bComputeOverlayTextureCoordinatesInMaterial;
+    this->DestroyTileset();
   }
+}
 
-  virtual void free(
-      Cesium3DTilesSelection::Tile& tile,
-      void* pLoadThreadResult,
-      void* pMainThreadResult) noexcept override {
-    if (pLoadThreadResult) {
-      UCesiumGltfComponent::HalfConstructed* pHalf =
-          reinterpret_cast<UCesiumGltfComponent::HalfConstructed*>(
-              pLoadThreadResult);
-      delete pHalf;
-    } else if (pMainThreadResult) {
-      UCesiumGltfComponent* pGltf =
-          reinterpret_cast<UCesiumGltfComponent*>(pMainThreadResult);
-      CesiumLifetime::destroyComponentRecursively(pGltf);
-    }
+void ACesium3DTileset::SetEnableWaterMask(bool bEnableMask) {
+  if (this->EnableWaterMask != bEnableMask) {
+    this->EnableWaterMask = bEnableMask;
+    this->DestroyTileset();
   }
+}
 
-  virtual void* prepareRasterInLoadThread(
-      CesiumGltf::ImageCesium& image,
-      const std::any& rendererOptions) override {
-    auto ppOptions =
-        std::any_cast<FRasterOverlayRendererOptions*>(&rendererOptions);
-    check(ppOptions != nullptr && *ppOptions != nullptr);
-    if (ppOptions == nullptr || *ppOptions == nullptr) {
-      return nullptr;
-    }
-
-    auto pOptions = *ppOptions;
-
-    auto texture = CesiumTextureUtility::loadTextureAnyThreadPart(
-        CesiumTextureUtility::GltfImagePtr{&image},
-        TextureAddress::TA_Clamp,
-        TextureAddress::TA_Clamp,
-        pOptions->filter,
-        pOptions->group,
-        pOptions->useMipmaps,
-        true); // TODO: sRGB should probably be configurable on the raster
-               // overlay
-    return texture.Release();
+void ACesium3DTileset::SetIgnoreKhrMaterialsUnlit(
+    bool bIgnoreKhrMaterialsUnlit) {
+  if (this->IgnoreKhrMaterialsUnlit != bIgnoreKhrMaterialsUnlit) {
+    this->IgnoreKhrMaterialsUnlit = bIgnoreKhrMaterialsUnlit;
+    this->DestroyTileset();
   }
+}
 
-  virtual void* prepareRasterInMainThread(
-      CesiumRasterOverlays::RasterOverlayTile& rasterTile,
-      void* pLoadThreadResult) override {
+void ACesium3DTileset::SetMaterial(UMaterialInterface* InMaterial) {
+  if (this->Material != InMaterial) {
+    this->Material = InMaterial;
+    this->updateTileMaterials();
+  }
+}
 
-    TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pLoadedTexture{
-        static_cast<CesiumTextureUtility::LoadedTextureResult*>(
-            pLoadThreadResult)};
+void ACesium3DTileset::SetTranslucentMaterial(UMaterialInterface* InMaterial) {
+  if (this->TranslucentMaterial != InMaterial) {
+    this->TranslucentMaterial = InMaterial;
+    this->updateTileMaterials();
+  }
+}
 
-    if (!pLoadedTexture) {
-      return nullptr;
-    }
+void ACesium3DTileset::SetWaterMaterial(UMaterialInterface* InMaterial) {
+  if (this->WaterMaterial != InMaterial) {
+    this->WaterMaterial = InMaterial;
+    this->updateTileMaterials();
+  }
+}
 
-    // The image source pointer during loading may have been invalidated,
-    // so replace it.
-    CesiumTextureUtility::GltfImagePtr* pImageSource =
-        std::get_if<CesiumTextureUtility::GltfImagePtr>(
-            &pLoadedTexture->textureSource);
-    if (pImageSource) {
-      pImageSource->pImage = &rasterTile.getImage();
-    }
+void ACesium3DTileset::SetCustomDepthParameters(
+    FCustomDepthParameters InCustomDepthParameters) {
+  if (this->CustomDepthParameters != InCustomDepthParameters) {
+    this->CustomDepthParameters = InCustomDepthParameters;
+    this->updateTileCustomDepthParameters();
+  }
+}
 
-    UTexture2D* pTexture =
-        CesiumTextureUtility::loadTextureGameThreadPart(pLoadedTexture.Get());
-    if (!pTexture) {
-      return nullptr;
-    }
+void ACesium3DTileset::updateTileMaterials() {
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
 
-    pTexture->AddToRoot();
-    return pTexture;
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->UpdateBaseMaterials(
+        this->Material,
+        this->TranslucentMaterial,
+        this->WaterMaterial);
   }
+}
 
-  virtual void freeRaster(
-      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
-      void* pLoadThreadResult,
-      void* pMainThreadResult) noexcept override {
-    if (pLoadThreadResult) {
-      CesiumTextureUtility::LoadedTextureResult* pLoadedTexture =
-          static_cast<CesiumTextureUtility::LoadedTextureResult*>(
-              pLoadThreadResult);
-      CesiumTextureUtility::destroyHalfLoadedTexture(*pLoadedTexture);
-      delete pLoadedTexture;
-    }
+void ACesium3DTileset::updateTileCustomDepthParameters() {
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
 
-    if (pMainThreadResult) {
-      UTexture* pTexture = static_cast<UTexture*>(pMainThreadResult);
-      pTexture->RemoveFromRoot();
-      CesiumTextureUtility::destroyTexture(pTexture);
-    }
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->UpdateCustomDepthParameters(
+        this->CustomDepthParameters,
+        this->GetPointCustomDepthParameters());
   }
+}
 
-  virtual void attachRasterInMainThread(
-      const Cesium3DTilesSelection::Tile& tile,
-      int32_t overlayTextureCoordinateID,
-      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
-      void* pMainThreadRendererResources,
-      const glm::dvec2& translation,
-      const glm::dvec2& scale) override {
-    const Cesium3DTilesSelection::TileContent& content = tile.getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (pRenderContent) {
-      UCesiumGltfComponent* pGltfContent =
-          reinterpret_cast<UCesiumGltfComponent*>(
-              pRenderContent->getRenderResources());
-      if (pGltfContent) {
-        pGltfContent->AttachRasterTile(
-            tile,
-            rasterTile,
-            static_cast<UTexture2D*>(pMainThreadRendererResources),
-            translation,
-            scale,
-            overlayTextureCoordinateID);
-      }
-    }
+FCustomDepthParameters ACesium3DTileset::GetPointCustomDepthParameters() const {
+  if (!this->PointCloudShading.EyeDomeLighting) {
+    return this->CustomDepthParameters;
   }
 
-  virtual void detachRasterInMainThread(
-      const Cesium3DTilesSelection::Tile& tile,
-      int32_t overlayTextureCoordinateID,
-      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
-      void* pMainThreadRendererResources) noexcept override {
-    const Cesium3DTilesSelection::TileContent& content = tile.getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (pRenderContent) {
-      UCesiumGltfComponent* pGltfContent =
-          reinterpret_cast<UCesiumGltfComponent*>(
-              pRenderContent->getRenderResources());
-      if (pGltfContent) {
-        pGltfContent->DetachRasterTile(
-            tile,
-            rasterTile,
-            static_cast<UTexture2D*>(pMainThreadRendererResources));
-      }
-    }
-  }
+  FCustomDepthParameters parameters;
+  parameters.RenderCustomDepth = true;
+  parameters.CustomDepthStencilWriteMask = ERendererStencilMask::ERSM_Default;
+  parameters.CustomDepthStencilValue =
+      this->PointCloudShading.EyeDomeLightingStencilValue;
+  return parameters;
+}
 
-private:
-  ACesium3DTileset* _pActor;
-};
+void ACesium3DTileset::updateEyeDomeLighting() {
+  if (!this->_cesiumViewExtension) {
+    return;
+  }
 
-void ACesium3DTileset::UpdateLoadStatus() {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateLoadStatus)
+  CesiumEyeDomeLighting& eyeDomeLighting =
+      this->_cesiumViewExtension->GetEyeDomeLighting();
+  if (!this->PointCloudShading.EyeDomeLighting) {
+    eyeDomeLighting.setSettings(this, nullptr);
+    return;
+  }
 
-  float nativeLoadProgress = this->_pTileset->computeLoadProgress();
+  CesiumEyeDomeLighting::Settings settings;
+  settings.strength = this->PointCloudShading.EyeDomeLightingStrength;
+  settings.radius = this->PointCloudShading.EyeDomeLightingRadius;
+  settings.stencilValue = uint32(FMath::Clamp(
+      this->PointCloudShading.EyeDomeLightingStencilValue,
+      1,
+      255));
+  eyeDomeLighting.setSettings(this, &settings);
+}
 
-  // If native tileset still loading, just copy its progress
-  if (nativeLoadProgress < 100) {
-    this->LoadProgress = nativeLoadProgress;
-    return;
+void ACesium3DTileset::SetRuntimeVirtualTextures(
+    const TArray<URuntimeVirtualTexture*>& InRuntimeVirtualTextures) {
+  if (this->RuntimeVirtualTextures != InRuntimeVirtualTextures) {
+    this->RuntimeVirtualTextures = InRuntimeVirtualTextures;
+    this->DestroyTileset();
   }
+}
 
-  // Native tileset is 100% loaded, but there might be a few frames where
-  // nothing needs to be loaded as we are waiting for occlusion results to come
-  // back, which means we are not done with loading all the tiles in the tileset
-  // yet. Interpret this as 99% (almost) done
-  if (this->_lastTilesWaitingForOcclusionResults > 0) {
-    this->LoadProgress = 99;
-    return;
+void ACesium3DTileset::SetVirtualTextureRenderPassType(
+    ERuntimeVirtualTextureMainPassType InVirtualTextureRenderPassType) {
+  if (this->VirtualTextureRenderPassType != InVirtualTextureRenderPassType) {
+    this->VirtualTextureRenderPassType = InVirtualTextureRenderPassType;
+    this->DestroyTileset();
   }
+}
 
-  // If we have tiles to hide next frame, we haven't completely finished loading
-  // yet. We need to tick once more. We're really close to done.
-  if (!this->_tilesToHideNextFrame.empty()) {
-    this->LoadProgress = glm::min(this->LoadProgress, 99.9999f);
-    return;
+void ACesium3DTileset::SetPointCloudShading(
+    FCesiumPointCloudShading InPointCloudShading) {
+  if (PointCloudShading != InPointCloudShading) {
+    const bool eyeDomeLightingChanged =
+        PointCloudShading.EyeDomeLighting !=
+            InPointCloudShading.EyeDomeLighting ||
+        PointCloudShading.EyeDomeLightingStencilValue !=
+            InPointCloudShading.EyeDomeLightingStencilValue;
+    PointCloudShading = InPointCloudShading;
+    FCesiumGltfPointsSceneProxyUpdater::UpdateSettingsInProxies(this);
+    this->updateEyeDomeLighting();
+    if (eyeDomeLightingChanged) {
+      this->updateTileCustomDepthParameters();
+    }
   }
+}
 
-  // We can now report 100 percent loaded
-  float lastLoadProgress = this->LoadProgress;
-  this->LoadProgress = 100;
+void ACesium3DTileset::SetFeatureStyle(
+    const FCesiumFeatureStyle& InFeatureStyle) {
+  this->FeatureStyle = InFeatureStyle;
+  this->updateFeatureStyleTexture();
+}
 
-  // Only broadcast the update when we first hit 100%, not everytime
-  if (lastLoadProgress != LoadProgress) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BroadcastOnTilesetLoaded)
+void ACesium3DTileset::SetFeatureColor(
+    const FString& PropertyTableName,
+    const TArray<int64>& FeatureIDs,
+    const FLinearColor& Color) {
+  const FColor color = Color.ToFColor(false);
+  this->editFeatureSelection(
+      PropertyTableName,
+      FeatureIDs,
+      [color](FColor& texel) {
+        texel.R = color.R;
+        texel.G = color.G;
+        texel.B = color.B;
+      });
+}
 
-    // Tileset just finished loading, we broadcast the update
-    UE_LOG(LogCesium, Verbose, TEXT("Broadcasting OnTileLoaded"));
-    OnTilesetLoaded.Broadcast();
+void ACesium3DTileset::SetFeatureVisibility(
+    const FString& PropertyTableName,
+    const TArray<int64>& FeatureIDs,
+    bool bShow) {
+  const uint8 alpha = bShow ? 255 : 0;
+  this->editFeatureSelection(
+      PropertyTableName,
+      FeatureIDs,
+      [alpha](FColor& texel) { texel.A = alpha; });
+}
+
+void ACesium3DTileset::ResetFeatureSelection(const FString& PropertyTableName) {
+  FeatureSelection* pSelection =
+      this->_featureSelections.Find(PropertyTableName);
+  if (!pSelection) {
+    return;
+  }
+
+  // The texture is kept, so that tiles don't need to be updated if features
+  // of the table are selected again.
+  for (FColor& texel : pSelection->texels) {
+    texel = CesiumFeatureSelectionTexture::DefaultTexel;
   }
+  pSelection->isDirty = true;
 }
 
-namespace {
+TArray<FCesiumFeatureHandle> ACesium3DTileset::FindFeaturesInRange(
+    const FString& PropertyTableName,
+    const FString& PropertyName,
+    double Minimum,
+    double Maximum) {
+  return this->getMetadataIndex()
+      .findInRange(PropertyTableName, PropertyName, Minimum, Maximum);
+}
 
-const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
-getCesiumViewExtension() {
-  static TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>
-      cesiumViewExtension =
-          GEngine->ViewExtensions->NewExtension<CesiumViewExtension>();
-  return cesiumViewExtension;
+TArray<FCesiumFeatureHandle> ACesium3DTileset::FindFeaturesWithValue(
+    const FString& PropertyTableName,
+    const FString& PropertyName,
+    const FString& Value) {
+  return this->getMetadataIndex()
+      .findEqual(PropertyTableName, PropertyName, Value);
 }
 
-} // namespace
+CesiumMetadataIndex& ACesium3DTileset::getMetadataIndex() {
+  if (!this->_pMetadataIndex) {
+    this->_pMetadataIndex = MakeUnique<CesiumMetadataIndex>();
 
-void ACesium3DTileset::LoadTileset() {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTileset)
+    TArray<UCesiumGltfComponent*> gltfComponents;
+    this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+    for (UCesiumGltfComponent* pGltf : gltfComponents) {
+      if (IsValid(pGltf)) {
+        this->_pMetadataIndex->addTile(*pGltf);
+      }
+    }
+  }
+  return *this->_pMetadataIndex;
+}
 
-  if (this->_pTileset) {
-    // Tileset already loaded, do nothing.
-    return;
+void ACesium3DTileset::editFeatureSelection(
+    const FString& propertyTableName,
+    const TArray<int64>& featureIDs,
+    TFunctionRef<void(FColor&)> edit) {
+  int64 featureCount = 0;
+  for (int64 featureID : featureIDs) {
+    if (featureID >= 0 &&
+        featureID < CesiumFeatureSelectionTexture::MaximumFeatureCount) {
+      featureCount = FMath::Max(featureCount, featureID + 1);
+    }
   }
 
-  UWorld* pWorld = this->GetWorld();
-  if (!pWorld) {
+  if (featureCount == 0) {
     return;
   }
 
-  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
-  if (pWorldSettings && pWorldSettings->bEnableWorldBoundsChecks) {
-    UE_LOG(
-        LogCesium,
-        Warning,
-        TEXT(
-            "\"Enable World Bounds Checks\" in the world settings is currently enabled. Please consider disabling it to avoid potential issues."),
-        *this->Url);
+  FeatureSelection& selection =
+      this->_featureSelections.FindOrAdd(propertyTableName);
+  if (featureCount > selection.texels.Num()) {
+    // Texels are in feature ID order, so growing the selection only adds
+    // texels to the end.
+    selection.size = CesiumFeatureSelectionTexture::getSize(featureCount);
+    const int32 previousCount = selection.texels.Num();
+    const int32 count = selection.size.X * selection.size.Y;
+    selection.texels.SetNumUninitialized(count);
+    for (int32 i = previousCount; i < count; ++i) {
+      selection.texels[i] = CesiumFeatureSelectionTexture::DefaultTexel;
+    }
   }
 
-  const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
-      cesiumViewExtension = getCesiumViewExtension();
-  const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor =
-      getAssetAccessor();
-  const CesiumAsync::AsyncSystem& asyncSystem = getAsyncSystem();
+  for (int64 featureID : featureIDs) {
+    if (featureID >= 0 && featureID < featureCount) {
+      edit(selection.texels[int32(featureID)]);
+    }
+  }
 
-  // Both the feature flag and the CesiumViewExtension are global, not owned by
-  // the Tileset. We're just applying one to the other here out of convenience.
-  cesiumViewExtension->SetEnabled(
-      GetDefault<UCesiumRuntimeSettings>()
-          ->EnableExperimentalOcclusionCullingFeature);
-
-  TArray<UCesiumRasterOverlay*> rasterOverlays;
-  this->GetComponents<UCesiumRasterOverlay>(rasterOverlays);
-
-  TArray<UCesiumTileExcluder*> tileExcluders;
-  this->GetComponents<UCesiumTileExcluder>(tileExcluders);
-
-  const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
-      this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
-
-  // Check if this component exists for backwards compatibility.
-  PRAGMA_DISABLE_DEPRECATION_WARNINGS
-
-  const UDEPRECATED_CesiumEncodedMetadataComponent* pEncodedMetadataComponent =
-      this->FindComponentByClass<UDEPRECATED_CesiumEncodedMetadataComponent>();
+  selection.isDirty = true;
+}
 
-  this->_featuresMetadataDescription = std::nullopt;
-  this->_metadataDescription_DEPRECATED = std::nullopt;
+void ACesium3DTileset::updateFeatureSelectionTextures() {
+  for (TPair<FString, FeatureSelection>& pair : this->_featureSelections) {
+    FeatureSelection& selection = pair.Value;
+    if (!selection.isDirty) {
+      continue;
+    }
 
-  if (pFeaturesMetadataComponent) {
-    FCesiumFeaturesMetadataDescription& description =
-        this->_featuresMetadataDescription.emplace();
-    description.Features = {pFeaturesMetadataComponent->FeatureIdSets};
-    description.PrimitiveMetadata = {
-        pFeaturesMetadataComponent->PropertyTextureNames};
-    description.ModelMetadata = {
-        pFeaturesMetadataComponent->PropertyTables,
-        pFeaturesMetadataComponent->PropertyTextures};
-  } else if (pEncodedMetadataComponent) {
-    UE_LOG(
-        LogCesium,
-        Warning,
-        TEXT(
-            "CesiumEncodedMetadataComponent is deprecated. Use CesiumFeaturesMetadataComponent instead."));
-    this->_metadataDescription_DEPRECATED = {
-        pEncodedMetadataComponent->FeatureTables,
-        pEncodedMetadataComponent->FeatureTextures};
-  }
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateFeatureSelectionTexture)
 
-  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+    selection.isDirty = false;
 
-  this->_cesiumViewExtension = cesiumViewExtension;
+    UTexture2D*& pTexture = this->_featureSelectionTextures.FindOrAdd(pair.Key);
+    if (pTexture && pTexture->GetSizeX() == selection.size.X &&
+        pTexture->GetSizeY() == selection.size.Y) {
+      CesiumFeatureSelectionTexture::update(pTexture, selection.texels);
+      continue;
+    }
 
-  if (GetDefault<UCesiumRuntimeSettings>()
-          ->EnableExperimentalOcclusionCullingFeature &&
-      this->EnableOcclusionCulling && !this->BoundingVolumePoolComponent) {
-    const glm::dmat4& cesiumToUnreal =
-        GetCesiumTilesetToUnrealRelativeWorldTransform();
-    this->BoundingVolumePoolComponent =
-        NewObject<UCesiumBoundingVolumePoolComponent>(this);
-    this->BoundingVolumePoolComponent->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-    this->BoundingVolumePoolComponent->RegisterComponent();
-    this->BoundingVolumePoolComponent->UpdateTransformFromCesium(
-        cesiumToUnreal);
-  }
+    pTexture =
+        CesiumFeatureSelectionTexture::create(selection.texels, selection.size);
 
-  if (this->BoundingVolumePoolComponent) {
-    this->BoundingVolumePoolComponent->initPool(this->OcclusionPoolSize);
+    TArray<UCesiumGltfComponent*> gltfComponents;
+    this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+    for (UCesiumGltfComponent* pGltf : gltfComponents) {
+      pGltf->UpdateFeatureSelection(pair.Key, pTexture);
+    }
   }
+}
 
-  ACesiumCreditSystem* pCreditSystem = this->ResolvedCreditSystem;
+void ACesium3DTileset::PlayMovieSequencer() {
+  this->_beforeMoviePreloadAncestors = this->PreloadAncestors;
+  this->_beforeMoviePreloadSiblings = this->PreloadSiblings;
+  this->_beforeMovieLoadingDescendantLimit = this->LoadingDescendantLimit;
+  this->_beforeMovieUseLodTransitions = this->UseLodTransitions;
 
-  Cesium3DTilesSelection::TilesetExternals externals{
-      pAssetAccessor,
-      std::make_shared<UnrealResourcePreparer>(this),
-      asyncSystem,
-      pCreditSystem ? pCreditSystem->GetExternalCreditSystem() : nullptr,
-      spdlog::default_logger(),
-      (GetDefault<UCesiumRuntimeSettings>()
-           ->EnableExperimentalOcclusionCullingFeature &&
-       this->EnableOcclusionCulling && this->BoundingVolumePoolComponent)
-          ? this->BoundingVolumePoolComponent->getPool()
-          : nullptr};
+  this->_captureMovieMode = true;
+  this->PreloadAncestors = false;
+  this->PreloadSiblings = false;
+  this->LoadingDescendantLimit = 10000;
+  this->UseLodTransitions = false;
 
-  this->_startTime = std::chrono::high_resolution_clock::now();
+  this->_movieSequenceActor = nullptr;
+  this->_movieLookAheadFirstFrame = 0;
+  this->_movieLookAheadEndFrame = 0;
+  this->_movieLookAheadCameras.clear();
+}
 
-  this->LoadProgress = 0;
+void ACesium3DTileset::StopMovieSequencer() {
+  this->_captureMovieMode = false;
+  this->PreloadAncestors = this->_beforeMoviePreloadAncestors;
+  this->PreloadSiblings = this->_beforeMoviePreloadSiblings;
+  this->LoadingDescendantLimit = this->_beforeMovieLoadingDescendantLimit;
+  this->UseLodTransitions = this->_beforeMovieUseLodTransitions;
+  this->_movieLookAheadCameras.clear();
+}
 
-  Cesium3DTilesSelection::TilesetOptions options;
+void ACesium3DTileset::PauseMovieSequencer() { this->StopMovieSequencer(); }
 
-  options.enableOcclusionCulling =
-      GetDefault<UCesiumRuntimeSettings>()
-          ->EnableExperimentalOcclusionCullingFeature &&
-      this->EnableOcclusionCulling;
-  options.delayRefinementForOcclusion = this->DelayRefinementForOcclusion;
+bool ACesium3DTileset::IsMovieFrameReady() const {
+  if (!this->_captureMovieMode) {
+    return true;
+  }
+  return this->_pTileset && this->_pLastViewUpdateResult &&
+         this->_movieLookAheadCameras.empty() &&
+         this->_pTileset->computeLoadProgress() >= 100.0f;
+}
 
-  options.showCreditsOnScreen = ShowCreditsOnScreen;
+bool ACesium3DTileset::AreTilesetsReadyForMovieFrame(
+    const UObject* WorldContextObject) {
+  const UWorld* pWorld =
+      GEngine ? GEngine->GetWorldFromContextObject(
+                    WorldContextObject,
+                    EGetWorldErrorMode::LogAndReturnNull)
+              : nullptr;
+  if (!pWorld) {
+    return true;
+  }
 
-  options.loadErrorCallback =
-      [this](const Cesium3DTilesSelection::TilesetLoadFailureDetails& details) {
-        static_assert(
-            uint8_t(ECesium3DTilesetLoadType::CesiumIon) ==
-            uint8_t(Cesium3DTilesSelection::TilesetLoadType::CesiumIon));
-        static_assert(
-            uint8_t(ECesium3DTilesetLoadType::TilesetJson) ==
-            uint8_t(Cesium3DTilesSelection::TilesetLoadType::TilesetJson));
-        static_assert(
-            uint8_t(ECesium3DTilesetLoadType::Unknown) ==
-            uint8_t(Cesium3DTilesSelection::TilesetLoadType::Unknown));
+  for (TActorIterator<ACesium3DTileset> it(pWorld); it; ++it) {
+    if (!it->IsMovieFrameReady()) {
+      return false;
+    }
+  }
+  return true;
+}
 
-        uint8_t typeValue = uint8_t(details.type);
-        assert(
-            uint8_t(details.type) <=
-            uint8_t(Cesium3DTilesSelection::TilesetLoadType::TilesetJson));
-        assert(this->_pTileset == details.pTileset);
+void ACesium3DTileset::addMovieLookAheadCameras(
+    std::vector<FCesiumCamera>& cameras) {
+  if (!this->_captureMovieMode || this->MovieLookAheadFrames <= 0 ||
+      cameras.empty()) {
+    return;
+  }
 
-        FCesium3DTilesetLoadFailureDetails ueDetails{};
-        ueDetails.Tileset = this;
-        ueDetails.Type = ECesium3DTilesetLoadType(typeValue);
-        ueDetails.HttpStatusCode = details.statusCode;
-        ueDetails.Message = UTF8_TO_TCHAR(details.message.c_str());
+  ALevelSequenceActor* pSequenceActor = this->_movieSequenceActor.Get();
+  std::optional<int32> maybeFrame =
+      pSequenceActor ? CesiumMovieLookAhead::getCurrentFrame(*pSequenceActor)
+                     : std::nullopt;
+  if (!maybeFrame) {
+    pSequenceActor =
+        CesiumMovieLookAhead::findPlayingSequence(this->GetWorld());
+    this->_movieSequenceActor = pSequenceActor;
+    if (!pSequenceActor) {
+      return;
+    }
+    maybeFrame = CesiumMovieLookAhead::getCurrentFrame(*pSequenceActor);
+  }
 
-        // Broadcast the event from the game thread.
-        // Even if we're already in the game thread, let the stack unwind.
-        // Otherwise actions that destroy the Tileset will cause a deadlock.
-        AsyncTask(
-            ENamedThreads::GameThread,
-            [ueDetails = std::move(ueDetails)]() {
-              OnCesium3DTilesetLoadFailure.Broadcast(ueDetails);
-            });
-      };
+  // Start the next batch once the sequence reaches the end of the last one,
+  // or seeks outside of it.
+  const int32 frame = *maybeFrame;
+  if (frame < this->_movieLookAheadFirstFrame ||
+      frame >= this->_movieLookAheadEndFrame) {
+    this->_movieLookAheadFirstFrame = frame;
+    this->_movieLookAheadEndFrame = frame + 1 + this->MovieLookAheadFrames;
+    this->_movieLookAheadCameras.clear();
+    CesiumMovieLookAhead::addSequenceCameras(
+        *pSequenceActor,
+        frame + 1,
+        this->MovieLookAheadFrames,
+        cameras[0].ViewportSize,
+        cameras[0].OverrideAspectRatio,
+        this->_movieLookAheadCameras);
+  }
 
-  // Generous per-frame time limits for loading / unloading on main thread.
-  options.mainThreadLoadingTimeLimit = 5.0;
-  options.tileCacheUnloadTimeLimit = 5.0;
+  // The batch's views are selected along with the current ones until they're
+  // all loaded, after which the frames in it only need their own views.
+  cameras.insert(
+      cameras.end(),
+      this->_movieLookAheadCameras.begin(),
+      this->_movieLookAheadCameras.end());
+}
 
-  options.contentOptions.generateMissingNormalsSmooth =
-      this->GenerateSmoothNormals;
+#if WITH_EDITOR
+void ACesium3DTileset::OnFocusEditorViewportOnThis() {
 
-  // TODO: figure out why water material crashes mac
-#if PLATFORM_MAC
-#else
-  options.contentOptions.enableWaterMask = this->EnableWaterMask;
-#endif
+  UE_LOG(
+      LogCesium,
+      Verbose,
+      TEXT("Called OnFocusEditorViewportOnThis on actor %s"),
+      *this->GetName());
 
-  CesiumGltf::SupportedGpuCompressedPixelFormats supportedFormats;
-  supportedFormats.ETC1_RGB = GPixelFormats[EPixelFormat::PF_ETC1].Supported;
-  supportedFormats.ETC2_RGBA =
-      GPixelFormats[EPixelFormat::PF_ETC2_RGBA].Supported;
-  supportedFormats.BC1_RGB = GPixelFormats[EPixelFormat::PF_DXT1].Supported;
-  supportedFormats.BC3_RGBA = GPixelFormats[EPixelFormat::PF_DXT5].Supported;
-  supportedFormats.BC4_R = GPixelFormats[EPixelFormat::PF_BC4].Supported;
-  supportedFormats.BC5_RG = GPixelFormats[EPixelFormat::PF_BC5].Supported;
-  supportedFormats.BC7_RGBA = GPixelFormats[EPixelFormat::PF_BC7].Supported;
-  supportedFormats.ASTC_4x4_RGBA =
-      GPixelFormats[EPixelFormat::PF_ASTC_4x4].Supported;
-  supportedFormats.PVRTC2_4_RGBA =
-      GPixelFormats[EPixelFormat::PF_PVRTC2].Supported;
-  supportedFormats.ETC2_EAC_R11 =
-      GPixelFormats[EPixelFormat::PF_ETC2_R11_EAC].Supported;
-  supportedFormats.ETC2_EAC_RG11 =
-      GPixelFormats[EPixelFormat::PF_ETC2_RG11_EAC].Supported;
+  struct CalculateECEFCameraPosition {
+    glm::dvec3 operator()(const CesiumGeometry::BoundingSphere& sphere) {
+      const glm::dvec3& center = sphere.getCenter();
+      glm::dmat4 ENU =
+          CesiumGeospatial::GlobeTransforms::eastNorthUpToFixedFrame(center);
+      glm::dvec3 offset =
+          sphere.getRadius() *
+          glm::normalize(
+              glm::dvec3(ENU[0]) + glm::dvec3(ENU[1]) + glm::dvec3(ENU[2]));
+      glm::dvec3 position = center + offset;
+      return position;
+    }
 
-  options.contentOptions.ktx2TranscodeTargets =
-      CesiumGltf::Ktx2TranscodeTargets(supportedFormats, false);
+    glm::dvec3
+    operator()(const CesiumGeometry::OrientedBoundingBox& orientedBoundingBox) {
+      const glm::dvec3& center = orientedBoundingBox.getCenter();
+      glm::dmat4 ENU =
+          CesiumGeospatial::GlobeTransforms::eastNorthUpToFixedFrame(center);
+      const glm::dmat3& halfAxes = orientedBoundingBox.getHalfAxes();
+      glm::dvec3 offset =
+          glm::length(halfAxes[0] + halfAxes[1] + halfAxes[2]) *
+          glm::normalize(
+              glm::dvec3(ENU[0]) + glm::dvec3(ENU[1]) + glm::dvec3(ENU[2]));
+      glm::dvec3 position = center + offset;
+      return position;
+    }
 
-  switch (this->TilesetSource) {
-  case ETilesetSource::FromUrl:
-    UE_LOG(LogCesium, Log, TEXT("Loading tileset from URL %s"), *this->Url);
-    this->_pTileset = MakeUnique<Cesium3DTilesSelection::Tileset>(
-        externals,
-        TCHAR_TO_UTF8(*this->Url),
-        options);
-    break;
-  case ETilesetSource::FromCesiumIon:
-    UE_LOG(
-        LogCesium,
-        Log,
-        TEXT("Loading tileset for asset ID %d"),
-        this->IonAssetID);
-    FString token =
-        this->IonAccessToken.IsEmpty()
-            ? GetDefault<UCesiumRuntimeSettings>()->DefaultIonAccessToken
-            : this->IonAccessToken;
-    if (!IonAssetEndpointUrl.IsEmpty()) {
-      this->_pTileset = MakeUnique<Cesium3DTilesSelection::Tileset>(
-          externals,
-          static_cast<uint32_t>(this->IonAssetID),
-          TCHAR_TO_UTF8(*token),
-          options,
-          TCHAR_TO_UTF8(*IonAssetEndpointUrl));
-    } else {
-      this->_pTileset = MakeUnique<Cesium3DTilesSelection::Tileset>(
-          externals,
-          static_cast<uint32_t>(this->IonAssetID),
-          TCHAR_TO_UTF8(*token),
-          options);
+    glm::dvec3
+    operator()(const CesiumGeospatial::BoundingRegion& boundingRegion) {
+      return (*this)(boundingRegion.getBoundingBox());
     }
-    break;
-  }
 
-  for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
-    if (pOverlay->IsActive()) {
-      pOverlay->AddToTileset();
+    glm::dvec3
+    operator()(const CesiumGeospatial::BoundingRegionWithLooseFittingHeights&
+                   boundingRegionWithLooseFittingHeights) {
+      return (*this)(boundingRegionWithLooseFittingHeights.getBoundingRegion()
+                         .getBoundingBox());
     }
-  }
 
-  for (UCesiumTileExcluder* pTileExcluder : tileExcluders) {
-    if (pTileExcluder->IsActive()) {
-      pTileExcluder->AddToTileset();
+    glm::dvec3 operator()(const CesiumGeospatial::S2CellBoundingVolume& s2) {
+      return (*this)(s2.computeBoundingRegion());
     }
+  };
+
+  const Cesium3DTilesSelection::Tile* pRootTile =
+      this->_pTileset->getRootTile();
+  if (!pRootTile) {
+    return;
   }
 
-  switch (this->TilesetSource) {
-  case ETilesetSource::FromUrl:
-    UE_LOG(
-        LogCesium,
-        Log,
-        TEXT("Loading tileset from URL %s done"),
-        *this->Url);
+  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
+      pRootTile->getBoundingVolume();
+
+  ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
+
+  // calculate unreal camera position
+  glm::dvec3 ecefCameraPosition =
+      std::visit(CalculateECEFCameraPosition{}, boundingVolume);
+  FVector unrealCameraPosition =
+      pGeoreference->TransformEarthCenteredEarthFixedPositionToUnreal(
+          VecMath::createVector(ecefCameraPosition));
+
+  // calculate unreal camera orientation
+  glm::dvec3 ecefCenter =
+      Cesium3DTilesSelection::getBoundingVolumeCenter(boundingVolume);
+  FVector unrealCenter =
+      pGeoreference->TransformEarthCenteredEarthFixedPositionToUnreal(
+          VecMath::createVector(ecefCenter));
+  FVector unrealCameraFront =
+      (unrealCenter - unrealCameraPosition).GetSafeNormal();
+  FVector unrealCameraRight =
+      FVector::CrossProduct(FVector::ZAxisVector, unrealCameraFront)
+          .GetSafeNormal();
+  FVector unrealCameraUp =
+      FVector::CrossProduct(unrealCameraFront, unrealCameraRight)
+          .GetSafeNormal();
+  FRotator cameraRotator = FMatrix(
+                               unrealCameraFront,
+                               unrealCameraRight,
+                               unrealCameraUp,
+                               FVector::ZeroVector)
+                               .Rotator();
+
+  // Update all viewports.
+  for (FLevelEditorViewportClient* LinkedViewportClient :
+       GEditor->GetLevelViewportClients()) {
+    // Dont move camera attach to an actor
+    if (!LinkedViewportClient->IsAnyActorLocked()) {
+      FViewportCameraTransform& ViewTransform =
+          LinkedViewportClient->GetViewTransform();
+      LinkedViewportClient->SetViewRotation(cameraRotator);
+      LinkedViewportClient->SetViewLocation(unrealCameraPosition);
+      LinkedViewportClient->Invalidate();
+    }
+  }
+}
+#endif
+
+const glm::dmat4&
+ACesium3DTileset::GetCesiumTilesetToUnrealRelativeWorldTransform() const {
+  return Cast<UCesium3DTilesetRoot>(this->RootComponent)
+      ->GetCesiumTilesetToUnrealRelativeWorldTransform();
+}
+
+CesiumTilePipelineHistograms& ACesium3DTileset::GetTilePipelineHistograms() {
+  if (!this->_pTilePipelineHistograms) {
+    this->_pTilePipelineHistograms = MakeUnique<CesiumTilePipelineHistograms>();
+  }
+  return *this->_pTilePipelineHistograms;
+}
+
+FCesiumTilePipelineStatistics
+ACesium3DTileset::GetTilePipelineStatistics() const {
+  return this->_pTilePipelineHistograms
+             ? this->_pTilePipelineHistograms->getStatistics()
+             : FCesiumTilePipelineStatistics();
+}
+
+void ACesium3DTileset::ResetTilePipelineStatistics() {
+  if (this->_pTilePipelineHistograms) {
+    this->_pTilePipelineHistograms->reset();
+  }
+}
+
+bool ACesium3DTileset::WriteTilePipelineStatisticsToCsv(
+    const FString& Filename) {
+  return this->GetTilePipelineHistograms().writeCsv(Filename);
+}
+
+FCesiumTilesetMemoryUsage ACesium3DTileset::GetMemoryUsage() const {
+  return this->_memoryUsage;
+}
+
+CesiumPrimitiveComponentPool& ACesium3DTileset::GetPrimitiveComponentPool() {
+  if (!this->_pPrimitiveComponentPool) {
+    this->_pPrimitiveComponentPool =
+        MakeUnique<CesiumPrimitiveComponentPool>(this);
+  }
+  return *this->_pPrimitiveComponentPool;
+}
+
+CesiumRenderDataBatch& ACesium3DTileset::GetRenderDataBatch() {
+  if (!this->_pRenderDataBatch) {
+    this->_pRenderDataBatch = MakeUnique<CesiumRenderDataBatch>();
+  }
+  return *this->_pRenderDataBatch;
+}
+
+UTexture2D* ACesium3DTileset::GetFeatureStyleTexture() {
+  if (!this->_pFeatureStyleTexture) {
+    this->_pFeatureStyleTexture = CesiumFeatureStyleTexture::create(
+        CesiumFeatureStyleTexture::encode(this->FeatureStyle, -1));
+    this->updateFeatureStyleTexture();
+  }
+  return this->_pFeatureStyleTexture;
+}
+
+void ACesium3DTileset::updateFeatureStyleTexture() {
+  if (!this->_pFeatureStyleTexture) {
+    return;
+  }
+
+  // The index of the styled property depends on which properties are
+  // encoded, so it's found again each time, in case they've changed.
+  const UCesiumFeaturesMetadataComponent* pFeaturesMetadata =
+      this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
+  const int32 propertyIndex =
+      pFeaturesMetadata ? CesiumFeatureStyleTexture::getPropertyIndex(
+                              pFeaturesMetadata->PropertyTables,
+                              this->FeatureStyle.PropertyTableName,
+                              this->FeatureStyle.PropertyName)
+                        : -1;
+
+  // Every tile material shares the texture, so updating it in place restyles
+  // every tile at once.
+  CesiumFeatureStyleTexture::update(
+      this->_pFeatureStyleTexture,
+      CesiumFeatureStyleTexture::encode(this->FeatureStyle, propertyIndex));
+}
+
+void ACesium3DTileset::UpdateTransformFromCesium() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTransformFromCesium)
+
+  const glm::dmat4& CesiumToUnreal =
+      this->GetCesiumTilesetToUnrealRelativeWorldTransform();
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+
+  // Hidden tiles are only moved once they're shown again, so that changing
+  // the georeference costs the same regardless of how many tiles are cached.
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->UpdateTransformFromCesiumWhenNeeded(CesiumToUnreal);
+  }
+
+  if (this->BoundingVolumePoolComponent) {
+    this->BoundingVolumePoolComponent->UpdateTransformFromCesium(
+        CesiumToUnreal);
+  }
+
+  if (this->_pHzbOcclusionPool) {
+    this->_pHzbOcclusionPool->UpdateTransformFromCesium(CesiumToUnreal);
+  }
+}
+
+// Called when the game starts or when spawned
+void ACesium3DTileset::BeginPlay() {
+  Super::BeginPlay();
+
+  this->ResolveGeoreference();
+  this->ResolveCameraManager();
+  this->ResolveCreditSystem();
+
+  this->LoadTileset();
+
+  // Search for level sequence.
+  for (auto sequenceActorIt = TActorIterator<ALevelSequenceActor>(GetWorld());
+       sequenceActorIt;
+       ++sequenceActorIt) {
+    ALevelSequenceActor* sequenceActor = *sequenceActorIt;
+
+    if (!IsValid(sequenceActor->GetSequencePlayer())) {
+      continue;
+    }
+
+    FScriptDelegate playMovieSequencerDelegate;
+    playMovieSequencerDelegate.BindUFunction(this, FName("PlayMovieSequencer"));
+    sequenceActor->GetSequencePlayer()->OnPlay.Add(playMovieSequencerDelegate);
+
+    FScriptDelegate stopMovieSequencerDelegate;
+    stopMovieSequencerDelegate.BindUFunction(this, FName("StopMovieSequencer"));
+    sequenceActor->GetSequencePlayer()->OnStop.Add(stopMovieSequencerDelegate);
+
+    FScriptDelegate pauseMovieSequencerDelegate;
+    pauseMovieSequencerDelegate.BindUFunction(
+        this,
+        FName("PauseMovieSequencer"));
+    sequenceActor->GetSequencePlayer()->OnPause.Add(
+        pauseMovieSequencerDelegate);
+  }
+}
+
+void ACesium3DTileset::OnConstruction(const FTransform& Transform) {
+  this->ResolveGeoreference();
+  this->ResolveCameraManager();
+  this->ResolveCreditSystem();
+
+  this->LoadTileset();
+
+  // Hide all existing tiles. The still-visible ones will be shown next time we
+  // tick. But if update is suspended, leave the components in their current
+  // state.
+  if (!this->SuspendUpdate) {
+    TArray<UCesiumGltfComponent*> gltfComponents;
+    this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+
+    for (UCesiumGltfComponent* pGltf : gltfComponents) {
+      if (pGltf && IsValid(pGltf) && pGltf->IsVisible()) {
+        pGltf->SetVisibility(false, true);
+        pGltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+      }
+    }
+  }
+}
+
+void ACesium3DTileset::NotifyHit(
+    UPrimitiveComponent* MyComp,
+    AActor* Other,
+    UPrimitiveComponent* OtherComp,
+    bool bSelfMoved,
+    FVector HitLocation,
+    FVector HitNormal,
+    FVector NormalImpulse,
+    const FHitResult& Hit) {
+  // std::cout << "Hit face index: " << Hit.FaceIndex << std::endl;
+
+  // FHitResult detailedHit;
+  // FCollisionQueryParams params;
+  // params.bReturnFaceIndex = true;
+  // params.bTraceComplex = true;
+  // MyComp->LineTraceComponent(detailedHit, Hit.TraceStart, Hit.TraceEnd,
+  // params);
+
+  // std::cout << "Hit face index 2: " << detailedHit.FaceIndex << std::endl;
+}
+
+class UnrealResourcePreparer
+    : public Cesium3DTilesSelection::IPrepareRendererResources {
+public:
+  UnrealResourcePreparer(
+      ACesium3DTileset* pActor,
+      const std::shared_ptr<CesiumRequestTimingAssetAccessor>& pRequestTimings)
+      : _pActor(pActor), _pRequestTimings(pRequestTimings) {}
+
+  /**
+   * Stops using the actor, so that it can be destroyed before the tiles that
+   * are still loading are done. Those tiles are discarded as they finish. This
+   * waits for any load thread that is converting a model with the actor's
+   * options.
+   */
+  void detach() {
+    std::unique_lock lock(this->_actorMutex);
+    this->_pActor = nullptr;
+  }
+
+  virtual CesiumAsync::Future<
+      Cesium3DTilesSelection::TileLoadResultAndRenderResources>
+  prepareInLoadThread(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      Cesium3DTilesSelection::TileLoadResult&& tileLoadResult,
+      const glm::dmat4& transform,
+      const std::any& rendererOptions) override {
+    // The model is converted with the actor's options, so the actor can't be
+    // detached until the conversion is done.
+    std::shared_lock lock(this->_actorMutex);
+
+    CesiumGltf::Model* pModel =
+        std::get_if<CesiumGltf::Model>(&tileLoadResult.contentKind);
+    if (!pModel || !this->_pActor)
+      return asyncSystem.createResolvedFuture(
+          Cesium3DTilesSelection::TileLoadResultAndRenderResources{
+              std::move(tileLoadResult),
+              nullptr});
+
+    CesiumTileTimings timings;
+    timings.loadThreadStart = FPlatformTime::Seconds();
+    if (tileLoadResult.pCompletedRequest) {
+      this->_pRequestTimings->takeRequestTimes(
+          tileLoadResult.pCompletedRequest->url(),
+          timings);
+      const CesiumAsync::IAssetResponse* pResponse =
+          tileLoadResult.pCompletedRequest->response();
+      if (pResponse) {
+        timings.responseBytes = int64(pResponse->data().size());
+      }
+    }
+
+    CreateGltfOptions::CreateModelOptions options;
+    options.pModel = pModel;
+    options.alwaysIncludeTangents = this->_pActor->GetAlwaysIncludeTangents();
+    options.useFastTangentGeneration =
+        this->_pActor->GetUseFastTangentGeneration();
+    options.weldSmoothNormals =
+        this->_pActor->GetGenerateSmoothNormals() &&
+        this->_pActor->GetWeldVerticesForSmoothNormals();
+    options.computeFlatNormalsInMaterial =
+        this->_pActor->GetComputeFlatNormalsInMaterial();
+    options.orderPointsProgressively =
+        this->_pActor->GetOrderPointsProgressively();
+    options.computeOverlayTextureCoordinatesInMaterial =
+        this->_pActor->GetComputeOverlayTextureCoordinatesInMaterial();
+    options.compressTextures = this->_pActor->GetCompressTextures();
+    options.shareTexturesAcrossTiles =
+        this->_pActor->GetShareIdenticalTextures();
+    options.skipUnneededTextureMips =
+        this->_pActor->GetSkipUnneededTextureMips();
+    options.buildNaniteMeshes = this->_pActor->GetBuildNaniteMeshes();
+    options.useVertexPulling = this->_pActor->GetUseVertexPulling();
+    options.mergePrimitives = this->_pActor->GetMergePrimitives();
+    options.packVertexAttributes = this->_pActor->GetPackVertexAttributes();
+    // Physics meshes cooked on demand are created later, by the tileset, only
+    // for the tiles that need them.
+    options.createPhysicsMeshes =
+        this->_pActor->GetCreatePhysicsMeshes() &&
+        !this->_pActor->GetCookPhysicsMeshesOnDemand();
+    options.createNavCollision = this->_pActor->GetCreateNavCollision();
+    options.enableHeightQueries = this->_pActor->GetEnableHeightQueries();
+    options.keepMeshDataForBaking = this->_pActor->_keepMeshDataForBaking;
+    // Baked meshes need the vertex attributes that collision doesn't load.
+    options.collisionOnly =
+        this->_pActor->IsCollisionOnly() && !options.keepMeshDataForBaking;
+
+    options.ignoreKhrMaterialsUnlit =
+        this->_pActor->GetIgnoreKhrMaterialsUnlit();
+
+    if (this->_pActor->_featuresMetadataDescription) {
+      options.pFeaturesMetadataDescription =
+          &(*this->_pActor->_featuresMetadataDescription);
+    } else if (this->_pActor->_metadataDescription_DEPRECATED) {
+      options.pEncodedMetadataDescription_DEPRECATED =
+          &(*this->_pActor->_metadataDescription_DEPRECATED);
+    }
+
+    TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf =
+        UCesiumGltfComponent::CreateOffGameThread(transform, options);
+    pHalf->timings = timings;
+
+    // The glTF data is released before the tile gets to the main thread,
+    // where Cesium Native counts its bytes toward the cache. Tiles that raster
+    // overlays are draped on keep it, since their children may be upsampled
+    // from it.
+    const ECesiumGltfDataRetention retention =
+        this->_pActor->GetGltfDataRetention();
+    const bool releaseGltfData =
+        retention != ECesiumGltfDataRetention::KeepAll &&
+        !tileLoadResult.rasterOverlayDetails;
+    const bool keepMetadataAndPickingData =
+        retention == ECesiumGltfDataRetention::KeepMetadataAndPicking;
+    const bool keepPositionsAndIndices =
+        (this->_pActor->CreatePhysicsMeshes &&
+         this->_pActor->CookPhysicsMeshesOnDemand) ||
+        this->_pActor->GenerateMeshDistanceFields;
+
+    // Don't let the tile continue to the main thread until its textures are
+    // ready, but don't block this thread waiting for them, either.
+    FGraphEventArray textureEvents = pHalf->getTextureCreationEvents();
+    if (textureEvents.IsEmpty()) {
+      if (releaseGltfData) {
+        pHalf->releaseGltfData(
+            *pModel,
+            keepMetadataAndPickingData,
+            keepPositionsAndIndices);
+      }
+      pHalf->timings.loadThreadEnd = FPlatformTime::Seconds();
+      return asyncSystem.createResolvedFuture(
+          Cesium3DTilesSelection::TileLoadResultAndRenderResources{
+              std::move(tileLoadResult),
+              pHalf.Release()});
+    }
+
+    return CesiumTextureUtility::waitForTextureCreation(
+               asyncSystem,
+               std::move(textureEvents))
+        .thenImmediately([tileLoadResult = std::move(tileLoadResult),
+                          pHalf = pHalf.Release(),
+                          releaseGltfData,
+                          keepMetadataAndPickingData,
+                          keepPositionsAndIndices]() mutable {
+          CesiumGltf::Model* pModel =
+              std::get_if<CesiumGltf::Model>(&tileLoadResult.contentKind);
+          if (releaseGltfData && pModel) {
+            pHalf->releaseGltfData(
+                *pModel,
+                keepMetadataAndPickingData,
+                keepPositionsAndIndices);
+          }
+          pHalf->timings.loadThreadEnd = FPlatformTime::Seconds();
+          return Cesium3DTilesSelection::TileLoadResultAndRenderResources{
+              std::move(tileLoadResult),
+              pHalf};
+        });
+  }
+
+  virtual void* prepareInMainThread(
+      Cesium3DTilesSelection::Tile& tile,
+      void* pLoadThreadResult) override {
+    const Cesium3DTilesSelection::TileContent& content = tile.getContent();
+    if (content.isRenderContent()) {
+      TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf(
+          reinterpret_cast<UCesiumGltfComponent::HalfConstructed*>(
+              pLoadThreadResult));
+      if (!this->_pActor) {
+        return nullptr;
+      }
+
+      const Cesium3DTilesSelection::TileRenderContent& renderContent =
+          *content.getRenderContent();
+
+      const double startSeconds = FPlatformTime::Seconds();
+      CesiumTileTimings timings = pHalf->timings;
+      timings.mainThreadStart = startSeconds;
+
+      UCesiumGltfComponent* pGltf = UCesiumGltfComponent::CreateOnGameThread(
+          renderContent.getModel(),
+          this->_pActor,
+          std::move(pHalf),
+          _pActor->GetCesiumTilesetToUnrealRelativeWorldTransform(),
+          this->_pActor->GetMaterial(),
+          this->_pActor->GetTranslucentMaterial(),
+          this->_pActor->GetWaterMaterial(),
+          this->_pActor->GetCustomDepthParameters(),
+          tile,
+          this->_pActor->GetCreateNavCollision());
+
+      timings.mainThreadEnd = FPlatformTime::Seconds();
+      const double milliseconds =
+          (timings.mainThreadEnd - startSeconds) * 1000.0;
+      this->_pActor->_mainThreadLoadingTimeThisFrame += milliseconds;
+      CesiumFrameBudget::recordMainThreadLoadingTime(
+          this->_pActor->GetWorld(),
+          milliseconds);
+
+      if (pGltf) {
+        if (this->_pActor->_updatedModelMetadataDescription) {
+          pGltf->UpdatePropertyTables(
+              *this->_pActor->_updatedModelMetadataDescription);
+        }
+
+        if (this->_pActor->_pMetadataIndex) {
+          this->_pActor->_pMetadataIndex->addTile(*pGltf);
+        }
+        pGltf->PendingTileTimings = timings;
+        pGltf->GeometricError = tile.getGeometricError();
+        const double loadStart = timings.requestStart > 0.0
+                                     ? timings.requestStart
+                                     : timings.loadThreadStart > 0.0
+                                           ? timings.loadThreadStart
+                                           : startSeconds;
+        pGltf->LoadMilliseconds = (timings.mainThreadEnd - loadStart) * 1000.0;
+        pGltf->MemoryUsage = CesiumMemoryAccounting::measureModel(*pGltf);
+        CesiumMemoryAccounting::add(
+            this->_pActor->_memoryUsage,
+            pGltf->MemoryUsage);
+        traceLoadingStages(tile, timings, pGltf->MemoryUsage);
+
+        if (this->_pActor->OnTileLoaded.IsBound()) {
+          this->_pActor->_pendingTileLoadEvents.Add(
+              {this->_pActor->getTileWorldBounds(tile),
+               float(tile.getGeometricError()),
+               true});
+        }
+      }
+
+      return pGltf;
+    }
+    // UE_LOG(LogCesium, VeryVerbose, TEXT("No content for tile"));
+    return nullptr;
+  }
+
+  virtual void free(
+      Cesium3DTilesSelection::Tile& tile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept override {
+    if (pLoadThreadResult) {
+      UCesiumGltfComponent::HalfConstructed* pHalf =
+          reinterpret_cast<UCesiumGltfComponent::HalfConstructed*>(
+              pLoadThreadResult);
+      delete pHalf;
+    } else if (pMainThreadResult && this->_pActor) {
+      // Once detached, the glTF components are destroyed with the actor.
+      UCesiumGltfComponent* pGltf =
+          reinterpret_cast<UCesiumGltfComponent*>(pMainThreadResult);
+      const double now = FPlatformTime::Seconds();
+      CesiumTileTrace::traceStage(
+          *this->_pActor,
+          tile,
+          ECesiumTileTraceStage::Free,
+          now,
+          now,
+          pGltf->MemoryUsage.TotalCpuBytes + pGltf->MemoryUsage.TotalGpuBytes);
+      CesiumMemoryAccounting::subtract(
+          this->_pActor->_memoryUsage,
+          pGltf->MemoryUsage);
+
+      if (this->_pActor->_pMetadataIndex) {
+        this->_pActor->_pMetadataIndex->removeTile(*pGltf);
+      }
+
+      if (this->_pActor->OnTileUnloaded.IsBound() &&
+          IsValid(this->_pActor) &&
+          !this->_pActor->HasAnyFlags(RF_BeginDestroyed)) {
+        this->_pActor->_pendingTileLoadEvents.Add(
+            {this->_pActor->getTileWorldBounds(tile),
+             float(tile.getGeometricError()),
+             false});
+      }
+
+      // Keep the primitive components for tiles loaded later, unless the
+      // tileset itself is going away. Components can't be renamed while
+      // they're being garbage collected.
+      CesiumPrimitiveComponentPool* pPool =
+          this->_pActor->_pPrimitiveComponentPool.Get();
+      if (pPool && IsValid(this->_pActor) &&
+          !this->_pActor->HasAnyFlags(RF_BeginDestroyed)) {
+        pPool->releaseChildren(pGltf);
+      }
+
+      CesiumLifetime::destroyComponentRecursively(pGltf);
+    }
+  }
+
+  virtual void* prepareRasterInLoadThread(
+      CesiumGltf::ImageCesium& image,
+      const std::any& rendererOptions) override {
+    auto ppOptions =
+        std::any_cast<FRasterOverlayRendererOptions*>(&rendererOptions);
+    check(ppOptions != nullptr && *ppOptions != nullptr);
+    if (ppOptions == nullptr || *ppOptions == nullptr) {
+      return nullptr;
+    }
+
+    auto pOptions = *ppOptions;
+
+    if (pOptions->progressiveLoading) {
+      std::optional<CesiumGltf::ImageCesium> maybePreview =
+          CesiumRasterPreviews::createPreview(image);
+      if (maybePreview) {
+        // The preview is shown while the full image is prepared later, on
+        // the game thread's request, so it isn't worth compressing.
+        auto pPreview = CesiumTextureUtility::loadTextureAnyThreadPart(
+            CesiumTextureUtility::EmbeddedImageSource{std::move(*maybePreview)},
+            TextureAddress::TA_Clamp,
+            TextureAddress::TA_Clamp,
+            pOptions->filter,
+            pOptions->group,
+            pOptions->useMipmaps,
+            true,
+            false);
+        if (pPreview) {
+          CesiumRasterPreviews::deferFullImage(
+              pPreview.Get(),
+              std::move(image),
+              *pOptions);
+          return pPreview.Release();
+        }
+      }
+    }
+
+    // Without asynchronous RHI texture creation, the texture needs its own
+    // copy of the image for the render thread. The raster tile doesn't need
+    // its image once it's been prepared, so move it instead of copying it.
+    CesiumTextureUtility::CesiumTextureSource textureSource =
+        CesiumTextureUtility::GltfImagePtr{&image};
+    if (!GRHISupportsAsyncTextureCreation) {
+      textureSource =
+          CesiumTextureUtility::EmbeddedImageSource{std::move(image)};
+    }
+
+    auto texture = CesiumTextureUtility::loadTextureAnyThreadPart(
+        std::move(textureSource),
+        TextureAddress::TA_Clamp,
+        TextureAddress::TA_Clamp,
+        pOptions->filter,
+        pOptions->group,
+        pOptions->useMipmaps,
+        true, // TODO: sRGB should probably be configurable on the raster
+              // overlay
+        pOptions->compressTextures);
+    return texture.Release();
+  }
+
+  virtual void* prepareRasterInMainThread(
+      CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult) override {
+    const double startSeconds = FPlatformTime::Seconds();
+    void* pResult = this->prepareRaster(rasterTile, pLoadThreadResult);
+
+    // cesium-native prepares raster overlay tiles while the tileset updates,
+    // before it finalizes tiles, so the time is taken from the limit that it
+    // finalizes tiles within, as well as from the budget shared by the world.
+    if (this->_pActor) {
+      const double milliseconds =
+          (FPlatformTime::Seconds() - startSeconds) * 1000.0;
+      this->_pActor->_mainThreadLoadingTimeThisFrame += milliseconds;
+      CesiumFrameBudget::recordMainThreadLoadingTime(
+          this->_pActor->GetWorld(),
+          milliseconds);
+      if (this->_pActor->_pTileset) {
+        Cesium3DTilesSelection::TilesetOptions& options =
+            this->_pActor->_pTileset->getOptions();
+        options.mainThreadLoadingTimeLimit =
+            CesiumFrameBudget::reduceMainThreadLoadingTimeLimit(
+                options.mainThreadLoadingTimeLimit,
+                milliseconds);
+      }
+    }
+
+    return pResult;
+  }
+
+  virtual void freeRaster(
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept override {
+    if (pLoadThreadResult) {
+      CesiumTextureUtility::LoadedTextureResult* pLoadedTexture =
+          static_cast<CesiumTextureUtility::LoadedTextureResult*>(
+              pLoadThreadResult);
+      CesiumRasterPreviews::cancel(pLoadedTexture, nullptr);
+      CesiumTextureUtility::destroyHalfLoadedTexture(*pLoadedTexture);
+      delete pLoadedTexture;
+    }
+
+    if (pMainThreadResult) {
+      UTexture2D* pTexture = static_cast<UTexture2D*>(pMainThreadResult);
+
+      if (this->_pActor) {
+        FCesiumTilesetMemoryUsage usage;
+        usage.RasterOverlayTextureGpuBytes =
+            CesiumMemoryAccounting::measureTexture(*pTexture);
+        CesiumMemoryAccounting::subtract(this->_pActor->_memoryUsage, usage);
+      }
+
+      CesiumRasterPreviews::cancel(nullptr, pTexture);
+      CesiumTexturePool::get().release(pTexture);
+    }
+  }
+
+  virtual void attachRasterInMainThread(
+      const Cesium3DTilesSelection::Tile& tile,
+      int32_t overlayTextureCoordinateID,
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pMainThreadRendererResources,
+      const glm::dvec2& translation,
+      const glm::dvec2& scale) override {
+    if (!this->_pActor) {
+      return;
+    }
+
+    const Cesium3DTilesSelection::TileContent& content = tile.getContent();
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        content.getRenderContent();
+    if (pRenderContent) {
+      UCesiumGltfComponent* pGltfContent =
+          reinterpret_cast<UCesiumGltfComponent*>(
+              pRenderContent->getRenderResources());
+      if (pGltfContent) {
+        if (pGltfContent->AttachRasterTile(
+                tile,
+                rasterTile,
+                static_cast<UTexture2D*>(pMainThreadRendererResources),
+                translation,
+                scale,
+                overlayTextureCoordinateID)) {
+          this->_pActor->_gltfComponentsWithPendingRasterTiles.Add(
+              pGltfContent);
+        }
+      }
+    }
+  }
+
+  virtual void detachRasterInMainThread(
+      const Cesium3DTilesSelection::Tile& tile,
+      int32_t overlayTextureCoordinateID,
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pMainThreadRendererResources) noexcept override {
+    if (!this->_pActor) {
+      return;
+    }
+
+    const Cesium3DTilesSelection::TileContent& content = tile.getContent();
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        content.getRenderContent();
+    if (pRenderContent) {
+      UCesiumGltfComponent* pGltfContent =
+          reinterpret_cast<UCesiumGltfComponent*>(
+              pRenderContent->getRenderResources());
+      if (pGltfContent) {
+        if (pGltfContent->DetachRasterTile(
+                tile,
+                rasterTile,
+                static_cast<UTexture2D*>(pMainThreadRendererResources))) {
+          this->_pActor->_gltfComponentsWithPendingRasterTiles.Add(
+              pGltfContent);
+        }
+      }
+    }
+  }
+
+private:
+  void* prepareRaster(
+      CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult) {
+    TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pLoadedTexture{
+        static_cast<CesiumTextureUtility::LoadedTextureResult*>(
+            pLoadThreadResult)};
+
+    if (!pLoadedTexture) {
+      return nullptr;
+    }
+
+    // The image source pointer during loading may have been invalidated,
+    // so replace it.
+    CesiumTextureUtility::GltfImagePtr* pImageSource =
+        std::get_if<CesiumTextureUtility::GltfImagePtr>(
+            &pLoadedTexture->textureSource);
+    if (pImageSource) {
+      pImageSource->pImage = &rasterTile.getImage();
+    }
+
+    CesiumTexturePool& pool = CesiumTexturePool::get();
+    UTexture2D* pTextureToReuse = pool.acquire();
+    UTexture2D* pTexture = CesiumTextureUtility::loadTextureGameThreadPart(
+        pLoadedTexture.Get(),
+        pTextureToReuse);
+    if (!pTexture) {
+      pool.release(pTextureToReuse);
+      return nullptr;
+    }
+
+    // A texture that was already created for this result is returned instead
+    // of the acquired one, which then goes back to the pool.
+    if (pTexture != pTextureToReuse) {
+      pool.release(pTextureToReuse);
+      pool.track(pTexture);
+    }
+
+    FCesiumTilesetMemoryUsage usage;
+    usage.RasterOverlayTextureGpuBytes =
+        CesiumMemoryAccounting::measureTexture(*pTexture);
+    if (this->_pActor) {
+      CesiumMemoryAccounting::add(this->_pActor->_memoryUsage, usage);
+    }
+
+    // If this is a preview, the full image replaces it in the same texture,
+    // which then uses more memory.
+    CesiumRasterPreviews::loadFullImage(
+        pLoadedTexture.Get(),
+        pTexture,
+        [pActor = TWeakObjectPtr<ACesium3DTileset>(this->_pActor),
+         previewBytes = usage.RasterOverlayTextureGpuBytes](
+            UTexture2D* pFullTexture) {
+          ACesium3DTileset* pTileset = pActor.Get();
+          if (!pTileset) {
+            return;
+          }
+          FCesiumTilesetMemoryUsage difference;
+          difference.RasterOverlayTextureGpuBytes =
+              CesiumMemoryAccounting::measureTexture(*pFullTexture) -
+              previewBytes;
+          CesiumMemoryAccounting::add(pTileset->_memoryUsage, difference);
+        });
+
+    return pTexture;
+  }
+
+  void traceLoadingStages(
+      const Cesium3DTilesSelection::Tile& tile,
+      const CesiumTileTimings& timings,
+      const FCesiumTilesetMemoryUsage& memoryUsage) const {
+    if (!CesiumTileTrace::isEnabled()) {
+      return;
+    }
+
+    const int64 bytes = memoryUsage.TotalCpuBytes + memoryUsage.TotalGpuBytes;
+    if (timings.requestStart > 0.0) {
+      CesiumTileTrace::traceStage(
+          *this->_pActor,
+          tile,
+          ECesiumTileTraceStage::Request,
+          timings.requestStart,
+          timings.response,
+          timings.responseBytes);
+    }
+    CesiumTileTrace::traceStage(
+        *this->_pActor,
+        tile,
+        ECesiumTileTraceStage::Load,
+        timings.loadThreadStart,
+        timings.loadThreadEnd,
+        bytes);
+    CesiumTileTrace::traceStage(
+        *this->_pActor,
+        tile,
+        ECesiumTileTraceStage::Upload,
+        timings.mainThreadStart,
+        timings.mainThreadEnd,
+        bytes);
+  }
+
+  // Guards _pActor against being detached while a load thread uses it. The
+  // game thread is the only one that detaches it, so it reads _pActor without
+  // the lock.
+  std::shared_mutex _actorMutex;
+  ACesium3DTileset* _pActor;
+  std::shared_ptr<CesiumRequestTimingAssetAccessor> _pRequestTimings;
+};
+
+void ACesium3DTileset::applyPendingRasterTiles() {
+  if (this->_gltfComponentsWithPendingRasterTiles.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyPendingRasterTiles)
+
+  for (const TWeakObjectPtr<UCesiumGltfComponent>& pGltf :
+       this->_gltfComponentsWithPendingRasterTiles) {
+    if (pGltf.IsValid()) {
+      pGltf->ApplyPendingRasterTiles();
+    }
+  }
+
+  this->_gltfComponentsWithPendingRasterTiles.Reset();
+}
+
+void ACesium3DTileset::UpdateLoadStatus() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateLoadStatus)
+
+  float nativeLoadProgress = this->_pTileset->computeLoadProgress();
+
+  // If native tileset still loading, just copy its progress
+  if (nativeLoadProgress < 100) {
+    this->LoadProgress = nativeLoadProgress;
+    return;
+  }
+
+  // Native tileset is 100% loaded, but there might be a few frames where
+  // nothing needs to be loaded as we are waiting for occlusion results to come
+  // back, which means we are not done with loading all the tiles in the tileset
+  // yet. Interpret this as 99% (almost) done
+  if (this->_lastTilesWaitingForOcclusionResults > 0) {
+    this->LoadProgress = 99;
+    return;
+  }
+
+  // If we have tiles to hide next frame, we haven't completely finished loading
+  // yet. We need to tick once more. We're really close to done.
+  if (!this->_tilesToHideNextFrame.empty()) {
+    this->LoadProgress = glm::min(this->LoadProgress, 99.9999f);
+    return;
+  }
+
+  // We can now report 100 percent loaded
+  float lastLoadProgress = this->LoadProgress;
+  this->LoadProgress = 100;
+
+  // Only broadcast the update when we first hit 100%, not everytime
+  if (lastLoadProgress != LoadProgress) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BroadcastOnTilesetLoaded)
+
+    if (this->_pWarmStartAssetAccessor &&
+        this->_pWarmStartAssetAccessor->isRecording()) {
+      this->SaveWarmStartUrls();
+    }
+
+    // Tileset just finished loading, we broadcast the update
+    UE_LOG(LogCesium, Verbose, TEXT("Broadcasting OnTileLoaded"));
+    OnTilesetLoaded.Broadcast();
+  }
+}
+
+FString ACesium3DTileset::GetWarmStartFilename() const {
+  const FString source =
+      this->TilesetSource == ETilesetSource::FromUrl
+          ? this->Url
+          : FString::Printf(
+                TEXT("%s/%lld"),
+                *this->IonAssetEndpointUrl,
+                this->IonAssetID);
+  const FTCHARToUTF8 utf8(*source);
+  return FPaths::Combine(
+      FPaths::ProjectSavedDir(),
+      TEXT("Cesium"),
+      TEXT("WarmStart"),
+      FString::Printf(
+          TEXT("%016llx.txt"),
+          CityHash64(utf8.Get(), uint32(utf8.Length()))));
+}
+
+void ACesium3DTileset::SaveWarmStartUrls() {
+  std::vector<std::string> urls =
+      this->_pWarmStartAssetAccessor->finishRecording();
+  const FString filename = this->GetWarmStartFilename();
+  if (urls.empty()) {
+    return;
+  }
+
+  if (!CesiumWarmStartAssetAccessor::saveUrls(filename, urls)) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Could not save the warm start requests of tileset %s to %s"),
+        *this->GetName(),
+        *filename);
+    return;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Verbose,
+      TEXT("Saved %d warm start requests of tileset %s, %lld of which were "
+           "prefetched."),
+      int32(urls.size()),
+      *this->GetName(),
+      this->_pWarmStartAssetAccessor->getPrefetchedRequestCount());
+}
+
+namespace {
+
+const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
+getCesiumViewExtension() {
+  static TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>
+      cesiumViewExtension =
+          GEngine->ViewExtensions->NewExtension<CesiumViewExtension>();
+  return cesiumViewExtension;
+}
+
+// The maximum number of tiles per tileset that can be tested against the HZB
+// at once. HZB occlusion proxies aren't scene primitives, so this is much
+// larger than the pool of bounding volume components would ever need to be.
+constexpr int32 MaximumHzbOcclusionProxies = 65536;
+
+} // namespace
+
+void ACesium3DTileset::PickFromScreenPosition(
+    APlayerController* PlayerController,
+    const FVector2D& ScreenPosition,
+    const FCesiumPickCallback& OnPicked) {
+  if (!IsValid(PlayerController) || !this->_cesiumViewExtension) {
+    OnPicked.ExecuteIfBound(false, FHitResult());
+    return;
+  }
+
+  const uint64 pickId =
+      this->_cesiumViewExtension->GetDepthPicking().requestPick(
+          PlayerController->GetViewTarget(),
+          ScreenPosition);
+  this->_pendingPicks.Add(pickId, OnPicked);
+}
+
+void ACesium3DTileset::resolvePendingPicks() {
+  if (this->_pendingPicks.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ResolvePendingPicks)
+
+  if (!this->_cesiumViewExtension) {
+    // The tileset was destroyed or refreshed, so the picks will never be
+    // read back.
+    TMap<uint64, FCesiumPickCallback> pendingPicks =
+        MoveTemp(this->_pendingPicks);
+    this->_pendingPicks.Reset();
+    for (const auto& pick : pendingPicks) {
+      pick.Value.ExecuteIfBound(false, FHitResult());
+    }
+    return;
+  }
+
+  // Callbacks may request more picks, so they're called once every result
+  // has been taken.
+  CesiumDepthPicking& depthPicking =
+      this->_cesiumViewExtension->GetDepthPicking();
+  TArray<TPair<FCesiumPickCallback, CesiumDepthPicking::Result>> picked;
+  for (auto it = this->_pendingPicks.CreateIterator(); it; ++it) {
+    CesiumDepthPicking::Result result;
+    if (depthPicking.takeResult(it->Key, result)) {
+      picked.Emplace(MoveTemp(it->Value), result);
+      it.RemoveCurrent();
+    }
+  }
+
+  for (const auto& pick : picked) {
+    FHitResult hit;
+    const bool isHit = findTilesetHit(*this, pick.Value, hit);
+    pick.Key.ExecuteIfBound(isHit, hit);
+  }
+}
+
+void ACesium3DTileset::LoadTileset() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTileset)
+
+  if (this->_pTileset) {
+    // Tileset already loaded, do nothing.
+    return;
+  }
+
+  UWorld* pWorld = this->GetWorld();
+  if (!pWorld) {
+    return;
+  }
+
+  // Pick up any change to the encoded properties since the style was last
+  // encoded.
+  this->updateFeatureStyleTexture();
+
+  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
+  if (pWorldSettings && pWorldSettings->bEnableWorldBoundsChecks) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "\"Enable World Bounds Checks\" in the world settings is currently enabled. Please consider disabling it to avoid potential issues."),
+        *this->Url);
+  }
+
+  const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
+      cesiumViewExtension = getCesiumViewExtension();
+  // Every request made for this tileset is put in its own request group, so
+  // that any still in flight can be cancelled when it's destroyed.
+  this->_requestGroup = CesiumRequestCancellation::createGroup();
+  // Endpoint requests are shared with every other tileset and overlay, so
+  // they're made outside of the request group. Content requests are shared
+  // with any other tileset that requests the same content at the same time.
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pTilesetAssetAccessor =
+      std::make_shared<CesiumIonEndpointAssetAccessor>(
+          CesiumCoalescingAssetAccessor::getSharedByAllTilesets(),
+          CesiumIonEndpointAssetAccessor::getDefaultDiskCacheDirectory());
+  if (this->EnableHedgedRequests || this->RequestTimeout > 0.0f ||
+      this->MaximumRequestRetries > 0) {
+    CesiumHedgedAssetAccessor::Options hedgeOptions;
+    hedgeOptions.hedge = this->EnableHedgedRequests;
+    hedgeOptions.hedgePercentile = this->HedgedRequestPercentile;
+    hedgeOptions.minimumHedgeDelay = this->MinimumHedgedRequestDelay;
+    for (const FString& host : this->HedgedRequestHosts) {
+      if (!host.IsEmpty()) {
+        hedgeOptions.hedgeOrigins.emplace_back(TCHAR_TO_UTF8(*host));
+      }
+    }
+    hedgeOptions.timeout = this->RequestTimeout;
+    hedgeOptions.maximumRetries = this->MaximumRequestRetries;
+    hedgeOptions.retryDelay = this->RequestRetryDelay;
+
+    // Hedged requests bypass the requests shared between tilesets, which
+    // would otherwise give a hedged request the result of the slow one.
+    pTilesetAssetAccessor = std::make_shared<CesiumHedgedAssetAccessor>(
+        pTilesetAssetAccessor,
+        getAssetAccessor(),
+        hedgeOptions);
+  }
+  // Its requests also share the bandwidth with other tilesets and overlays by
+  // its RequestPriority and BandwidthShare. Hedged requests and retries are
+  // made in the same stream.
+  this->_bandwidthStream = CesiumBandwidthLimiter::get().createStream(
+      this->RequestPriority,
+      this->BandwidthShare);
+  pTilesetAssetAccessor = std::make_shared<CesiumBandwidthStreamAssetAccessor>(
+      pTilesetAssetAccessor,
+      this->_bandwidthStream);
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pGroupAssetAccessor =
+      std::make_shared<CesiumRequestGroupAssetAccessor>(
+          pTilesetAssetAccessor,
+          this->_requestGroup);
+  this->_pWarmStartAssetAccessor = nullptr;
+  if (this->EnableWarmStart) {
+    this->_pWarmStartAssetAccessor =
+        std::make_shared<CesiumWarmStartAssetAccessor>(
+            pGroupAssetAccessor,
+            CesiumWarmStartAssetAccessor::loadUrls(
+                this->GetWarmStartFilename()));
+    pGroupAssetAccessor = this->_pWarmStartAssetAccessor;
+  }
+  std::shared_ptr<CesiumRequestTimingAssetAccessor> pAssetAccessor =
+      std::make_shared<CesiumRequestTimingAssetAccessor>(pGroupAssetAccessor);
+  const CesiumAsync::AsyncSystem& asyncSystem = getAsyncSystem();
+
+  // Both the feature flag and the CesiumViewExtension are global, not owned by
+  // the Tileset. We're just applying one to the other here out of convenience.
+  const bool occlusionCullingFeatureEnabled =
+      GetDefault<UCesiumRuntimeSettings>()
+          ->EnableExperimentalOcclusionCullingFeature;
+  const bool useHzbOcclusion =
+      GetDefault<UCesiumRuntimeSettings>()->OcclusionCullingMethod ==
+      ECesiumOcclusionCullingMethod::HierarchicalZBuffer;
+  cesiumViewExtension->SetEnabled(
+      occlusionCullingFeatureEnabled && !useHzbOcclusion);
+  cesiumViewExtension->SetHzbOcclusionEnabled(
+      occlusionCullingFeatureEnabled && useHzbOcclusion);
+
+  TArray<UCesiumRasterOverlay*> rasterOverlays;
+  this->GetComponents<UCesiumRasterOverlay>(rasterOverlays);
+
+  TArray<UCesiumTileExcluder*> tileExcluders;
+  this->GetComponents<UCesiumTileExcluder>(tileExcluders);
+
+  const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
+      this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
+
+  // Check if this component exists for backwards compatibility.
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+
+  const UDEPRECATED_CesiumEncodedMetadataComponent* pEncodedMetadataComponent =
+      this->FindComponentByClass<UDEPRECATED_CesiumEncodedMetadataComponent>();
+
+  this->_featuresMetadataDescription = std::nullopt;
+  this->_updatedModelMetadataDescription = std::nullopt;
+  this->_metadataDescription_DEPRECATED = std::nullopt;
+
+  if (pFeaturesMetadataComponent) {
+    FCesiumFeaturesMetadataDescription& description =
+        this->_featuresMetadataDescription.emplace();
+    description.Features = {pFeaturesMetadataComponent->FeatureIdSets};
+    description.PrimitiveMetadata = {
+        pFeaturesMetadataComponent->PropertyTextureNames};
+    description.ModelMetadata = {
+        pFeaturesMetadataComponent->PropertyTables,
+        pFeaturesMetadataComponent->PropertyTextures};
+    description.DiscardUnencodedPropertyTableData =
+        pFeaturesMetadataComponent->DiscardUnencodedPropertyTableData;
+  } else if (pEncodedMetadataComponent) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "CesiumEncodedMetadataComponent is deprecated. Use CesiumFeaturesMetadataComponent instead."));
+    this->_metadataDescription_DEPRECATED = {
+        pEncodedMetadataComponent->FeatureTables,
+        pEncodedMetadataComponent->FeatureTextures};
+  }
+
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  this->_cesiumViewExtension = cesiumViewExtension;
+  this->updateEyeDomeLighting();
+
+  const bool enableOcclusionCulling = occlusionCullingFeatureEnabled &&
+                                      this->EnableOcclusionCulling &&
+                                      !this->UseClusterSelection;
+
+  this->_pHzbOcclusionPool = nullptr;
+  if (enableOcclusionCulling && useHzbOcclusion) {
+    this->_pHzbOcclusionPool = std::make_shared<CesiumHzbOcclusionPool>(
+        cesiumViewExtension,
+        MaximumHzbOcclusionProxies);
+    this->_pHzbOcclusionPool->UpdateTransformFromCesium(
+        GetCesiumTilesetToUnrealRelativeWorldTransform());
+  } else if (enableOcclusionCulling && !this->BoundingVolumePoolComponent) {
+    const glm::dmat4& cesiumToUnreal =
+        GetCesiumTilesetToUnrealRelativeWorldTransform();
+    this->BoundingVolumePoolComponent =
+        NewObject<UCesiumBoundingVolumePoolComponent>(this);
+    this->BoundingVolumePoolComponent->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    this->BoundingVolumePoolComponent->RegisterComponent();
+    this->BoundingVolumePoolComponent->UpdateTransformFromCesium(
+        cesiumToUnreal);
+  }
+
+  std::shared_ptr<Cesium3DTilesSelection::TileOcclusionRendererProxyPool>
+      pOcclusionPool = nullptr;
+  if (this->_pHzbOcclusionPool) {
+    pOcclusionPool = this->_pHzbOcclusionPool;
+  } else if (enableOcclusionCulling && this->BoundingVolumePoolComponent) {
+    this->BoundingVolumePoolComponent->initPool(
+        this->OcclusionPoolSize,
+        cesiumViewExtension);
+    pOcclusionPool = this->BoundingVolumePoolComponent->getPool();
+  }
+
+  ACesiumCreditSystem* pCreditSystem = this->ResolvedCreditSystem;
+
+  this->_pResourcePreparer =
+      std::make_shared<UnrealResourcePreparer>(this, pAssetAccessor);
+
+  Cesium3DTilesSelection::TilesetExternals externals{
+      pAssetAccessor,
+      this->_pResourcePreparer,
+      asyncSystem,
+      pCreditSystem ? pCreditSystem->GetExternalCreditSystem() : nullptr,
+      spdlog::default_logger(),
+      pOcclusionPool};
+
+  this->_startTime = std::chrono::high_resolution_clock::now();
+
+  this->LoadProgress = 0;
+
+  Cesium3DTilesSelection::TilesetOptions options;
+
+  options.enableOcclusionCulling = this->GetEnableOcclusionCulling();
+  options.delayRefinementForOcclusion = this->DelayRefinementForOcclusion;
+
+  options.showCreditsOnScreen = ShowCreditsOnScreen;
+
+  options.loadErrorCallback =
+      [pActor = TWeakObjectPtr<ACesium3DTileset>(this)](
+          const Cesium3DTilesSelection::TilesetLoadFailureDetails& details) {
+        static_assert(
+            uint8_t(ECesium3DTilesetLoadType::CesiumIon) ==
+            uint8_t(Cesium3DTilesSelection::TilesetLoadType::CesiumIon));
+        static_assert(
+            uint8_t(ECesium3DTilesetLoadType::TilesetJson) ==
+            uint8_t(Cesium3DTilesSelection::TilesetLoadType::TilesetJson));
+        static_assert(
+            uint8_t(ECesium3DTilesetLoadType::Unknown) ==
+            uint8_t(Cesium3DTilesSelection::TilesetLoadType::Unknown));
+
+        // The actor may have been destroyed, or have replaced this tileset,
+        // while the tileset was loading.
+        ACesium3DTileset* pTileset = pActor.Get();
+        if (!pTileset || pTileset->_pTileset.Get() != details.pTileset) {
+          return;
+        }
+
+        uint8_t typeValue = uint8_t(details.type);
+        assert(
+            uint8_t(details.type) <=
+            uint8_t(Cesium3DTilesSelection::TilesetLoadType::TilesetJson));
+
+        FCesium3DTilesetLoadFailureDetails ueDetails{};
+        ueDetails.Tileset = pTileset;
+        ueDetails.Type = ECesium3DTilesetLoadType(typeValue);
+        ueDetails.HttpStatusCode = details.statusCode;
+        ueDetails.Message = UTF8_TO_TCHAR(details.message.c_str());
+
+        // Broadcast the event from the game thread.
+        // Even if we're already in the game thread, let the stack unwind.
+        // Otherwise actions that destroy the Tileset will cause a deadlock.
+        AsyncTask(
+            ENamedThreads::GameThread,
+            [ueDetails = std::move(ueDetails)]() {
+              OnCesium3DTilesetLoadFailure.Broadcast(ueDetails);
+            });
+      };
+
+  // The main-thread loading time limit is shared by all tilesets in the world
+  // and is updated every frame in updateTilesetOptionsFromProperties. Use a
+  // generous per-frame time limit for unloading on main thread.
+  options.mainThreadLoadingTimeLimit =
+      CesiumFrameBudget::getMainThreadLoadingTimeLimit(this->GetWorld());
+  options.tileCacheUnloadTimeLimit = 5.0;
+
+  // Welded smooth normals are computed as each primitive is loaded instead.
+  options.contentOptions.generateMissingNormalsSmooth =
+      this->GenerateSmoothNormals && !this->WeldVerticesForSmoothNormals;
+
+  // TODO: figure out why water material crashes mac
+#if PLATFORM_MAC
+#else
+  options.contentOptions.enableWaterMask = this->EnableWaterMask;
+#endif
+
+  CesiumGltf::SupportedGpuCompressedPixelFormats supportedFormats;
+  supportedFormats.ETC1_RGB = GPixelFormats[EPixelFormat::PF_ETC1].Supported;
+  supportedFormats.ETC2_RGBA =
+      GPixelFormats[EPixelFormat::PF_ETC2_RGBA].Supported;
+  supportedFormats.BC1_RGB = GPixelFormats[EPixelFormat::PF_DXT1].Supported;
+  supportedFormats.BC3_RGBA = GPixelFormats[EPixelFormat::PF_DXT5].Supported;
+  supportedFormats.BC4_R = GPixelFormats[EPixelFormat::PF_BC4].Supported;
+  supportedFormats.BC5_RG = GPixelFormats[EPixelFormat::PF_BC5].Supported;
+  supportedFormats.BC7_RGBA = GPixelFormats[EPixelFormat::PF_BC7].Supported;
+  supportedFormats.ASTC_4x4_RGBA =
+      GPixelFormats[EPixelFormat::PF_ASTC_4x4].Supported;
+  supportedFormats.PVRTC2_4_RGBA =
+      GPixelFormats[EPixelFormat::PF_PVRTC2].Supported;
+  supportedFormats.ETC2_EAC_R11 =
+      GPixelFormats[EPixelFormat::PF_ETC2_R11_EAC].Supported;
+  supportedFormats.ETC2_EAC_RG11 =
+      GPixelFormats[EPixelFormat::PF_ETC2_RG11_EAC].Supported;
+
+  options.contentOptions.ktx2TranscodeTargets =
+      CesiumGltf::Ktx2TranscodeTargets(
+          supportedFormats,
+          GetDefault<UCesiumRuntimeSettings>()
+              ->PreserveHighQualityKtx2Transcoding);
+
+  switch (this->TilesetSource) {
+  case ETilesetSource::FromUrl:
+    UE_LOG(LogCesium, Log, TEXT("Loading tileset from URL %s"), *this->Url);
+    this->_pTileset = MakeUnique<Cesium3DTilesSelection::Tileset>(
+        externals,
+        TCHAR_TO_UTF8(*this->Url),
+        options);
+    break;
+  case ETilesetSource::FromCesiumIon:
+    UE_LOG(
+        LogCesium,
+        Log,
+        TEXT("Loading tileset for asset ID %d"),
+        this->IonAssetID);
+    FString token =
+        this->IonAccessToken.IsEmpty()
+            ? GetDefault<UCesiumRuntimeSettings>()->DefaultIonAccessToken
+            : this->IonAccessToken;
+    if (!IonAssetEndpointUrl.IsEmpty()) {
+      this->_pTileset = MakeUnique<Cesium3DTilesSelection::Tileset>(
+          externals,
+          static_cast<uint32_t>(this->IonAssetID),
+          TCHAR_TO_UTF8(*token),
+          options,
+          TCHAR_TO_UTF8(*IonAssetEndpointUrl));
+    } else {
+      this->_pTileset = MakeUnique<Cesium3DTilesSelection::Tileset>(
+          externals,
+          static_cast<uint32_t>(this->IonAssetID),
+          TCHAR_TO_UTF8(*token),
+          options);
+    }
+    break;
+  }
+
+  for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
+    if (pOverlay->IsActive()) {
+      pOverlay->AddToTileset();
+    }
+  }
+
+  for (UCesiumTileExcluder* pTileExcluder : tileExcluders) {
+    if (pTileExcluder->IsActive()) {
+      pTileExcluder->AddToTileset();
+    }
+  }
+
+  switch (this->TilesetSource) {
+  case ETilesetSource::FromUrl:
+    UE_LOG(
+        LogCesium,
+        Log,
+        TEXT("Loading tileset from URL %s done"),
+        *this->Url);
+    break;
+  case ETilesetSource::FromCesiumIon:
+    UE_LOG(
+        LogCesium,
+        Log,
+        TEXT("Loading tileset for asset ID %d done"),
+        this->IonAssetID);
+    break;
+  }
+
+  switch (ApplyDpiScaling) {
+  case (EApplyDpiScaling::UseProjectDefault):
+    _scaleUsingDPI =
+        GetDefault<UCesiumRuntimeSettings>()->ScaleLevelOfDetailByDPI;
+    break;
+  case (EApplyDpiScaling::Yes):
+    _scaleUsingDPI = true;
+    break;
+  case (EApplyDpiScaling::No):
+    _scaleUsingDPI = false;
+    break;
+  default:
+    _scaleUsingDPI = true;
+  }
+}
+
+void ACesium3DTileset::DestroyTileset(bool actorIsGoingAway) {
+  this->InvalidateView();
+  this->UnfreezeSelection();
+  this->endImpostor();
+
+  // The tiles are unloaded with the tileset, so there's nothing to query
+  // until the next one loads tiles.
+  this->_pMetadataIndex.Reset();
+  this->_pendingTileLoadEvents.Empty();
+
+  if (actorIsGoingAway) {
+    this->cancelHeightSampleQueries();
+  }
+
+  if (this->_cesiumViewExtension) {
+    this->_cesiumViewExtension->GetEyeDomeLighting().setSettings(this, nullptr);
+    this->_cesiumViewExtension = nullptr;
+  }
+
+  switch (this->TilesetSource) {
+  case ETilesetSource::FromUrl:
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Destroying tileset from URL %s"),
+        *this->Url);
+    break;
+  case ETilesetSource::FromCesiumIon:
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Destroying tileset for asset ID %d"),
+        this->IonAssetID);
+    break;
+  }
+
+  // The way CesiumRasterOverlay::add is currently implemented, destroying the
+  // tileset without removing overlays will make it impossible to add it again
+  // once a new tileset is created (e.g. when switching between terrain
+  // assets)
+  TArray<UCesiumRasterOverlay*> rasterOverlays;
+  this->GetComponents<UCesiumRasterOverlay>(rasterOverlays);
+  for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
+    if (pOverlay->IsActive()) {
+      pOverlay->RemoveFromTileset();
+    }
+  }
+
+  TArray<UCesiumTileExcluder*> tileExcluders;
+  this->GetComponents<UCesiumTileExcluder>(tileExcluders);
+  for (UCesiumTileExcluder* pTileExcluder : tileExcluders) {
+    if (pTileExcluder->IsActive()) {
+      pTileExcluder->RemoveFromTileset();
+    }
+  }
+
+  if (!this->_pTileset) {
+    return;
+  }
+
+  // The glTF components of an actor that is going away are destroyed with
+  // it, so the tiles don't need to destroy them one at a time. Otherwise, the
+  // tiles are unloaded while the Tileset is destroyed, and only the tiles
+  // that are still loading are discarded without the actor.
+  if (actorIsGoingAway) {
+    this->_pResourcePreparer->detach();
+  }
+
+  // None of the tiles that are still loading will ever be used, so don't wait
+  // for their downloads to finish, and free up the bandwidth for other tiles.
+  const int64_t bytesAvoidedBefore =
+      CesiumRequestCancellation::getBytesAvoided();
+  const int32_t cancelledRequests =
+      CesiumRequestCancellation::cancelGroup(this->_requestGroup);
+  if (cancelledRequests > 0) {
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT(
+            "Cancelled %d in-flight requests for tileset %s, avoiding at least %lld bytes of downloads"),
+        cancelledRequests,
+        *this->GetName(),
+        CesiumRequestCancellation::getBytesAvoided() - bytesAvoidedBefore);
+  }
+  CesiumBandwidthLimiter::get().releaseStream(this->_bandwidthStream);
+  this->_bandwidthStream = 0;
+
+  // Any request the Tileset makes until its asynchronous destruction is
+  // complete must still be rejected, but after that the group is never used
+  // again, so forget it rather than keep one group for every reload.
+  const uint64 requestGroup = this->_requestGroup;
+  this->_pTileset->getAsyncDestructionCompleteEvent().thenInMainThread(
+      [requestGroup]() {
+        CesiumRequestCancellation::releaseGroup(requestGroup);
+      });
+
+  // The actor doesn't need to wait for the Tileset's asynchronous
+  // destruction, since the Tileset no longer uses it.
+  CesiumTilesetReaper::get().reap(std::move(this->_pTileset));
+  this->_pResourcePreparer->detach();
+  this->_pResourcePreparer = nullptr;
+  this->_pWarmStartAssetAccessor = nullptr;
+  this->_pHzbOcclusionPool = nullptr;
+
+  switch (this->TilesetSource) {
+  case ETilesetSource::FromUrl:
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Destroying tileset from URL %s done"),
+        *this->Url);
     break;
   case ETilesetSource::FromCesiumIon:
     UE_LOG(
         LogCesium,
-        Log,
-        TEXT("Loading tileset for asset ID %d done"),
+        Verbose,
+        TEXT("Destroying tileset for asset ID %d done"),
         this->IonAssetID);
     break;
   }
+}
+
+std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
+  std::vector<FCesiumCamera> cameras;
+
+  // The nodes of a cluster only share the Camera Manager's views.
+  if (!this->UseClusterSelection) {
+    cameras = this->GetPlayerCameras();
+
+    std::vector<FCesiumCamera> remotePlayers = this->GetRemotePlayerCameras();
+    cameras.insert(
+        cameras.end(),
+        std::make_move_iterator(remotePlayers.begin()),
+        std::make_move_iterator(remotePlayers.end()));
+
+    std::vector<FCesiumCamera> sceneCaptures = this->GetSceneCaptures();
+    cameras.insert(
+        cameras.end(),
+        std::make_move_iterator(sceneCaptures.begin()),
+        std::make_move_iterator(sceneCaptures.end()));
+
+#if WITH_EDITOR
+    std::vector<FCesiumCamera> editorCameras = this->GetEditorCameras();
+    cameras.insert(
+        cameras.end(),
+        std::make_move_iterator(editorCameras.begin()),
+        std::make_move_iterator(editorCameras.end()));
+#endif
+  }
+
+  ACesiumCameraManager* pCameraManager = this->ResolvedCameraManager;
+  if (pCameraManager) {
+    const TMap<int32, FCesiumCamera>& extraCameras =
+        pCameraManager->GetCameras();
+    cameras.reserve(cameras.size() + extraCameras.Num());
+    for (auto cameraIt : extraCameras) {
+      cameras.push_back(cameraIt.Value);
+    }
+  }
+
+  return cameras;
+}
+
+void ACesium3DTileset::addPredictedCameras(
+    std::vector<FCesiumCamera>& cameras,
+    float deltaTime) {
+  // Camera velocities are estimated from where each camera was last frame,
+  // matching cameras up by their order. When the cameras change, such as when
+  // one is added, there's nothing to estimate from until the next frame.
+  const size_t cameraCount = cameras.size();
+  const bool canPredict = this->PrefetchAlongCameraPath &&
+                          !this->_captureMovieMode && deltaTime > 0.0f &&
+                          this->PrefetchTime > 0.0f &&
+                          this->_lastCameraLocations.size() == cameraCount;
+
+  if (canPredict) {
+    const double scale = double(this->PrefetchTime) / double(deltaTime);
+    cameras.reserve(cameraCount * 2);
+    for (size_t i = 0; i < cameraCount; ++i) {
+      const FVector offset =
+          (cameras[i].Location - this->_lastCameraLocations[i]) * scale;
+
+      // Don't predict for cameras that are standing still, so that they
+      // don't affect the tile selection at all.
+      if (offset.SizeSquared() < 1.0) {
+        continue;
+      }
+
+      const FCesiumCamera& camera = cameras[i];
+      cameras.emplace_back(
+          camera.ViewportSize * double(this->PrefetchDetailFactor),
+          camera.Location + offset,
+          camera.Rotation,
+          camera.FieldOfViewDegrees,
+          camera.OverrideAspectRatio);
+    }
+  }
+
+  this->_lastCameraLocations.resize(cameraCount);
+  for (size_t i = 0; i < cameraCount; ++i) {
+    this->_lastCameraLocations[i] = cameras[i].Location;
+  }
+}
+
+void ACesium3DTileset::SetGazeDirection(const FVector& Direction) {
+  this->_gazeDirection = Direction.GetSafeNormal();
+}
+
+namespace {
+
+// How long it takes the cameras with lower PriorityWeights to fill in to
+// their full level of detail once there are load slots to spare, or to fall
+// back once there aren't, in seconds.
+constexpr float LowPriorityCameraFillTime = 1.0f;
+
+} // namespace
+
+void ACesium3DTileset::applyCameraPriorities(
+    std::vector<FCesiumCamera>& cameras,
+    float deltaTime) {
+  float maximumWeight = 0.0f;
+  float minimumWeight = TNumericLimits<float>::Max();
+  for (const FCesiumCamera& camera : cameras) {
+    maximumWeight = FMath::Max(maximumWeight, camera.PriorityWeight);
+    minimumWeight = FMath::Min(minimumWeight, camera.PriorityWeight);
+  }
+
+  // The cameras with lower weights are only held back while tiles are waiting
+  // for a load slot, and fill in gradually so that they don't flicker between
+  // levels of detail as loads start and finish.
+  if (minimumWeight < maximumWeight && this->_pTileset &&
+      this->_pLastViewUpdateResult) {
+    const bool saturated =
+        this->_pLastViewUpdateResult->workerThreadTileLoadQueueLength >=
+        this->_pTileset->getOptions().maximumSimultaneousTileLoads;
+    const float step = deltaTime / LowPriorityCameraFillTime;
+    this->_lowPriorityCameraDetail = FMath::Clamp(
+        this->_lowPriorityCameraDetail + (saturated ? -step : step),
+        0.0f,
+        1.0f);
+  } else {
+    this->_lowPriorityCameraDetail = 0.0f;
+  }
+
+  for (FCesiumCamera& camera : cameras) {
+    // A tile's screen-space error is proportional to the viewport size.
+    double detail =
+        1.0 / FMath::Max(camera.MaximumScreenSpaceErrorMultiplier, 0.01);
+    if (camera.PriorityWeight < maximumWeight) {
+      detail *= FMath::Lerp(
+          double(FMath::Max(camera.PriorityWeight, 0.0f) / maximumWeight),
+          1.0,
+          double(this->_lowPriorityCameraDetail));
+    }
+    camera.ViewportSize =
+        FVector2D::Max(camera.ViewportSize * detail, FVector2D(1.0, 1.0));
+  }
+}
+
+int32 ACesium3DTileset::AddInterestPoint(
+    const FCesiumInterestPoint& InterestPoint) {
+  const int32 interestPointId = this->_nextInterestPointId++;
+  this->_interestPoints.Emplace(interestPointId, InterestPoint);
+  return interestPointId;
+}
+
+bool ACesium3DTileset::UpdateInterestPoint(
+    int32 InterestPointId,
+    const FCesiumInterestPoint& InterestPoint) {
+  FCesiumInterestPoint* pInterestPoint =
+      this->_interestPoints.Find(InterestPointId);
+  if (pInterestPoint) {
+    *pInterestPoint = InterestPoint;
+    return true;
+  }
+
+  return false;
+}
+
+bool ACesium3DTileset::RemoveInterestPoint(int32 InterestPointId) {
+  return this->_interestPoints.Remove(InterestPointId) > 0;
+}
+
+void ACesium3DTileset::ClearInterestPoints() { this->_interestPoints.Empty(); }
+
+const TMap<int32, FCesiumInterestPoint>&
+ACesium3DTileset::GetInterestPoints() const {
+  return this->_interestPoints;
+}
+
+int32 ACesium3DTileset::WatchRegion(
+    const FBox& Region,
+    float MaximumScreenSpaceError) {
+  const int32 regionId = this->_nextWatchedRegionId++;
+  this->_watchedRegions.Emplace(
+      regionId,
+      WatchedRegion{Region, MaximumScreenSpaceError});
+
+  // The tiles shown by the last update may already be enough. Its views are
+  // only kept while regions are watched, or while it's reused because the
+  // views don't change.
+  if (this->_watchedRegionViews.empty() && this->_lastViewIsStatic) {
+    this->_watchedRegionViews = this->_lastViews;
+  }
+  if (this->_pLastViewUpdateResult) {
+    this->updateWatchedRegions(*this->_pLastViewUpdateResult);
+  }
+
+  return regionId;
+}
+
+bool ACesium3DTileset::UnwatchRegion(int32 RegionID) {
+  const bool removed = this->_watchedRegions.Remove(RegionID) > 0;
+  if (this->_watchedRegions.IsEmpty()) {
+    this->_watchedRegionViews.clear();
+  }
+  return removed;
+}
+
+bool ACesium3DTileset::IsWatchingRegion(int32 RegionID) const {
+  return this->_watchedRegions.Contains(RegionID);
+}
+
+namespace {
+
+// Completes once a region watched by a tileset is loaded, or the tileset is
+// destroyed.
+class FCesiumWaitUntilRegionLoadedAction : public FPendingLatentAction {
+public:
+  FCesiumWaitUntilRegionLoadedAction(
+      ACesium3DTileset* pTileset,
+      int32 regionId,
+      const FLatentActionInfo& latentInfo)
+      : _pTileset(pTileset),
+        _regionId(regionId),
+        _executionFunction(latentInfo.ExecutionFunction),
+        _outputLink(latentInfo.Linkage),
+        _callbackTarget(latentInfo.CallbackTarget) {}
+
+  virtual void UpdateOperation(FLatentResponse& Response) override {
+    Response.FinishAndTriggerIf(
+        !this->_pTileset.IsValid() ||
+            !this->_pTileset->IsWatchingRegion(this->_regionId),
+        this->_executionFunction,
+        this->_outputLink,
+        this->_callbackTarget);
+  }
+
+  virtual void NotifyObjectDestroyed() override { this->unwatch(); }
+
+  virtual void NotifyActionAborted() override { this->unwatch(); }
+
+private:
+  void unwatch() {
+    if (this->_pTileset.IsValid()) {
+      this->_pTileset->UnwatchRegion(this->_regionId);
+    }
+  }
+
+  TWeakObjectPtr<ACesium3DTileset> _pTileset;
+  int32 _regionId;
+  FName _executionFunction;
+  int32 _outputLink;
+  FWeakObjectPtr _callbackTarget;
+};
+
+} // namespace
+
+void ACesium3DTileset::WaitUntilRegionLoaded(
+    const FBox& Region,
+    float MaximumScreenSpaceError,
+    FLatentActionInfo LatentInfo) {
+  UWorld* pWorld = this->GetWorld();
+  if (!pWorld) {
+    return;
+  }
+
+  FLatentActionManager& latentActionManager = pWorld->GetLatentActionManager();
+  if (latentActionManager.FindExistingAction<FCesiumWaitUntilRegionLoadedAction>(
+          LatentInfo.CallbackTarget,
+          LatentInfo.UUID)) {
+    return;
+  }
+
+  latentActionManager.AddNewAction(
+      LatentInfo.CallbackTarget,
+      LatentInfo.UUID,
+      new FCesiumWaitUntilRegionLoadedAction(
+          this,
+          this->WatchRegion(Region, MaximumScreenSpaceError),
+          LatentInfo));
+}
+
+FBox ACesium3DTileset::getTileWorldBounds(
+    const Cesium3DTilesSelection::Tile& tile) const {
+  // Bounding volumes are already in tileset coordinates, so they don't need
+  // the tile's transform.
+  const glm::dmat4 tilesetToWorld =
+      VecMath::createMatrix4D(this->GetActorTransform().ToMatrixWithScale()) *
+      this->GetCesiumTilesetToUnrealRelativeWorldTransform();
+  const glm::dmat4 identity(1.0);
+  return std::visit(
+             CalcBoundsOperation{
+                 FTransform(VecMath::createMatrix(tilesetToWorld)),
+                 identity},
+             tile.getBoundingVolume())
+      .GetBox();
+}
+
+void ACesium3DTileset::broadcastTileLoadEvents() {
+  if (this->_pendingTileLoadEvents.IsEmpty()) {
+    return;
+  }
+
+  // Handlers may load or unload tiles themselves, e.g. by refreshing the
+  // tileset, so they're given the events of this update only.
+  TArray<TileLoadEvent> events = MoveTemp(this->_pendingTileLoadEvents);
+  this->_pendingTileLoadEvents.Reset();
+
+  for (const TileLoadEvent& event : events) {
+    if (event.loaded) {
+      this->OnTileLoaded.Broadcast(event.bounds, event.geometricError);
+    } else {
+      this->OnTileUnloaded.Broadcast(event.bounds, event.geometricError);
+    }
+  }
+}
+
+void ACesium3DTileset::updateWatchedRegions(
+    const Cesium3DTilesSelection::ViewUpdateResult& result) {
+  if (this->_watchedRegions.IsEmpty() || this->_watchedRegionViews.empty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateWatchedRegions)
+
+  // Once the whole tileset is loaded, the tiles shown are as detailed as
+  // they'll get for these views, whatever their screen-space error.
+  const bool tilesetLoaded = this->LoadProgress >= 100.0f;
+
+  struct ShownTile {
+    FBox bounds;
+    double screenSpaceError;
+    bool isLeaf;
+  };
+
+  TArray<ShownTile> shownTiles;
+  shownTiles.Reserve(int32(result.tilesToRenderThisFrame.size()));
+  for (const Cesium3DTilesSelection::Tile* pTile :
+       result.tilesToRenderThisFrame) {
+    // The tile is only as detailed as the nearest view needs it to be.
+    double screenSpaceError = 0.0;
+    for (const Cesium3DTilesSelection::ViewState& view :
+         this->_watchedRegionViews) {
+      const double distance = std::sqrt(std::max(
+          view.computeDistanceSquaredToBoundingVolume(
+              pTile->getBoundingVolume()),
+          0.0));
+      screenSpaceError = std::max(
+          screenSpaceError,
+          view.computeScreenSpaceError(pTile->getGeometricError(), distance));
+    }
+
+    shownTiles.Add(
+        {this->getTileWorldBounds(*pTile),
+         screenSpaceError,
+         pTile->getChildren().empty()});
+  }
+
+  TArray<int32> loadedRegions;
+  for (const TPair<int32, WatchedRegion>& pair : this->_watchedRegions) {
+    const WatchedRegion& region = pair.Value;
+    const double maximumScreenSpaceError =
+        region.maximumScreenSpaceError > 0.0f
+            ? region.maximumScreenSpaceError
+            : this->MaximumScreenSpaceError;
+
+    bool intersects = false;
+    bool detailed = true;
+    for (const ShownTile& tile : shownTiles) {
+      if (!tile.bounds.Intersect(region.bounds)) {
+        continue;
+      }
+
+      intersects = true;
+      if (!tile.isLeaf && tile.screenSpaceError > maximumScreenSpaceError) {
+        detailed = false;
+        break;
+      }
+    }
+
+    if (intersects && (detailed || tilesetLoaded)) {
+      loadedRegions.Add(pair.Key);
+    }
+  }
+
+  // Remove the regions before broadcasting, so that handlers can watch new
+  // ones.
+  for (int32 regionId : loadedRegions) {
+    this->_watchedRegions.Remove(regionId);
+  }
+  if (this->_watchedRegions.IsEmpty()) {
+    this->_watchedRegionViews.clear();
+  }
+
+  for (int32 regionId : loadedRegions) {
+    this->OnRegionLoaded.Broadcast(regionId);
+  }
+}
+
+namespace {
+
+// The rotations of cameras that together see in every direction, each with a
+// 90 degree field of view.
+const FRotator CubeFaceRotations[] = {
+    FRotator(0.0, 0.0, 0.0),
+    FRotator(0.0, 90.0, 0.0),
+    FRotator(0.0, 180.0, 0.0),
+    FRotator(0.0, 270.0, 0.0),
+    FRotator(90.0, 0.0, 0.0),
+    FRotator(-90.0, 0.0, 0.0)};
+
+// Keeps a tiny MaximumGeometricError from refining everything in sight.
+constexpr double MaximumInterestPointViewportSize = 1048576.0;
+
+} // namespace
+
+void ACesium3DTileset::addInterestPointCameras(
+    std::vector<FCesiumCamera>& cameras,
+    size_t viewCameraCount,
+    const glm::dmat4& unrealWorldToCesiumTileset) const {
+  if (this->_interestPoints.IsEmpty()) {
+    return;
+  }
+
+  // The viewport size that a 90 degree camera needs for the same number of
+  // pixels per radian as the most detailed view.
+  double referenceSize = 0.0;
+  for (size_t i = 0; i < viewCameraCount; ++i) {
+    const FCesiumCamera& camera = cameras[i];
+    const double halfFieldOfView = FMath::DegreesToRadians(
+        FMath::Clamp(camera.FieldOfViewDegrees, 1.0, 179.0) * 0.5);
+    referenceSize = FMath::Max(
+        referenceSize,
+        camera.ViewportSize.X / FMath::Tan(halfFieldOfView));
+  }
+
+  // Interest point radii are in Unreal units, and geometric errors are in
+  // tileset units.
+  const double unrealToTilesetScale =
+      glm::length(glm::dvec3(unrealWorldToCesiumTileset[0]));
+
+  cameras.reserve(
+      cameras.size() +
+      size_t(this->_interestPoints.Num()) * UE_ARRAY_COUNT(CubeFaceRotations));
+  for (const auto& interestPointIt : this->_interestPoints) {
+    const FCesiumInterestPoint& interestPoint = interestPointIt.Value;
+
+    FVector location = interestPoint.Location;
+    if (!interestPoint.Actor.IsExplicitlyNull()) {
+      const AActor* pActor = interestPoint.Actor.Get();
+      if (!pActor) {
+        continue;
+      }
+      location += pActor->GetActorLocation();
+    }
+
+    double size = referenceSize * double(interestPoint.Weight);
+    if (interestPoint.MaximumGeometricError > 0.0) {
+      // A tile's screen-space error in a 90 degree view is its geometric error
+      // times half the viewport size over its distance. This is the size at
+      // which a tile at the edge of the radius is refined if its geometric
+      // error is larger than the maximum, and closer tiles are too.
+      const double radius = interestPoint.Radius * unrealToTilesetScale;
+      size = FMath::Max(
+          size,
+          2.0 * radius * this->MaximumScreenSpaceError /
+              interestPoint.MaximumGeometricError);
+    }
+    size = FMath::Min(size, MaximumInterestPointViewportSize);
+    if (size < 1.0) {
+      continue;
+    }
+
+    for (const FRotator& rotation : CubeFaceRotations) {
+      cameras.emplace_back(FVector2D(size, size), location, rotation, 90.0);
+    }
+  }
+}
+
+void ACesium3DTileset::addFoveatedCameras(
+    std::vector<FCesiumCamera>& cameras,
+    size_t cameraCount) {
+  if (!this->UseFoveatedScreenSpaceError) {
+    return;
+  }
+
+  FVector gazeDirection = this->_gazeDirection;
+  if (this->UseEyeTracking && !this->UseClusterSelection &&
+      UEyeTrackerFunctionLibrary::IsEyeTrackerConnected()) {
+    const UWorld* pWorld = this->GetWorld();
+    APlayerController* pController =
+        pWorld ? pWorld->GetFirstPlayerController() : nullptr;
+    FEyeTrackerGazeData gazeData;
+    if (pController &&
+        UEyeTrackerFunctionLibrary::GetGazeData(gazeData, pController) &&
+        gazeData.ConfidenceValue > 0.0f) {
+      gazeDirection = gazeData.GazeDirection.GetSafeNormal();
+    }
+  }
+
+  const double peripheralDetailFactor =
+      FMath::Clamp(double(this->PeripheralDetailFactor), 0.01, 1.0);
+  const double halfFovealAngle =
+      FMath::DegreesToRadians(FMath::Clamp(this->FovealAngle, 1.0f, 179.0f)) *
+      0.5;
+
+  cameras.reserve(cameras.size() + cameraCount);
+  for (size_t i = 0; i < cameraCount; ++i) {
+    FCesiumCamera& camera = cameras[i];
+    const double halfFieldOfView =
+        FMath::DegreesToRadians(camera.FieldOfViewDegrees) * 0.5;
+    if (halfFovealAngle >= halfFieldOfView) {
+      continue;
+    }
+
+    // The gaze is only used for the views that it falls within, such as both
+    // eyes of a stereo view, and not for scene captures looking elsewhere.
+    const FVector forward = camera.Rotation.Vector();
+    const FVector up = camera.Rotation.RotateVector(FVector::UpVector);
+    FRotator fovealRotation = camera.Rotation;
+    if (!gazeDirection.IsZero() &&
+        FVector::DotProduct(forward, gazeDirection) >
+            FMath::Cos(halfFieldOfView)) {
+      fovealRotation = FRotationMatrix::MakeFromXZ(gazeDirection, up).Rotator();
+    }
+
+    // Give the foveal camera a square viewport with the same number of pixels
+    // per radian at its center as the full view, so that tiles in it are
+    // refined as they would be in the full view.
+    double width = camera.ViewportSize.X;
+    if (camera.OverrideAspectRatio != 0.0) {
+      width =
+          FMath::Min(width, camera.OverrideAspectRatio * camera.ViewportSize.Y);
+    }
+    const double fovealSize =
+        width * FMath::Tan(halfFovealAngle) / FMath::Tan(halfFieldOfView);
+
+    const FCesiumCamera fovealCamera(
+        FVector2D(fovealSize, fovealSize),
+        camera.Location,
+        fovealRotation,
+        FMath::RadiansToDegrees(halfFovealAngle * 2.0));
+
+    camera.ViewportSize *= peripheralDetailFactor;
+    cameras.push_back(fovealCamera);
+  }
+}
+
+std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
+  UWorld* pWorld = this->GetWorld();
+  if (!pWorld) {
+    return {};
+  }
+
+  double worldToMeters = 100.0;
+  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
+  if (pWorldSettings) {
+    worldToMeters = pWorldSettings->WorldToMeters;
+  }
+
+  TSharedPtr<IStereoRendering, ESPMode::ThreadSafe> pStereoRendering = nullptr;
+  if (GEngine) {
+    pStereoRendering = GEngine->StereoRenderingDevice;
+  }
+
+  bool useStereoRendering = false;
+  if (pStereoRendering && pStereoRendering->IsStereoEnabled()) {
+    useStereoRendering = true;
+  }
+
+  std::vector<FCesiumCamera> cameras;
+  cameras.reserve(pWorld->GetNumPlayerControllers());
+
+  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
+       playerControllerIt;
+       playerControllerIt++) {
+
+    const TWeakObjectPtr<APlayerController> pPlayerController =
+        *playerControllerIt;
+    if (pPlayerController == nullptr) {
+      continue;
+    }
+
+    const APlayerCameraManager* pPlayerCameraManager =
+        pPlayerController->PlayerCameraManager;
+
+    if (!pPlayerCameraManager) {
+      continue;
+    }
+
+    double fov = pPlayerCameraManager->GetFOVAngle();
+
+    FVector location;
+    FRotator rotation;
+    pPlayerController->GetPlayerViewPoint(location, rotation);
+
+    int32 sizeX, sizeY;
+    pPlayerController->GetViewportSize(sizeX, sizeY);
+    if (sizeX < 1 || sizeY < 1) {
+      continue;
+    }
+
+    float dpiScalingFactor = 1.0f;
+    if (this->_scaleUsingDPI) {
+      ULocalPlayer* LocPlayer = Cast<ULocalPlayer>(pPlayerController->Player);
+      if (LocPlayer && LocPlayer->ViewportClient) {
+        dpiScalingFactor = LocPlayer->ViewportClient->GetDPIScale();
+      }
+    }
+
+    if (useStereoRendering) {
+      const auto leftEye = EStereoscopicEye::eSSE_LEFT_EYE;
+      const auto rightEye = EStereoscopicEye::eSSE_RIGHT_EYE;
+
+      uint32 stereoLeftSizeX = static_cast<uint32>(sizeX);
+      uint32 stereoLeftSizeY = static_cast<uint32>(sizeY);
+      uint32 stereoRightSizeX = static_cast<uint32>(sizeX);
+      uint32 stereoRightSizeY = static_cast<uint32>(sizeY);
+      if (useStereoRendering) {
+        int32 _x;
+        int32 _y;
+
+        pStereoRendering
+            ->AdjustViewRect(leftEye, _x, _y, stereoLeftSizeX, stereoLeftSizeY);
+
+        pStereoRendering->AdjustViewRect(
+            rightEye,
+            _x,
+            _y,
+            stereoRightSizeX,
+            stereoRightSizeY);
+      }
+
+      FVector2D stereoLeftSize(stereoLeftSizeX, stereoLeftSizeY);
+      FVector2D stereoRightSize(stereoRightSizeX, stereoRightSizeY);
+
+      if (stereoLeftSize.X >= 1.0 && stereoLeftSize.Y >= 1.0) {
+        FVector leftEyeLocation = location;
+        FRotator leftEyeRotation = rotation;
+        pStereoRendering->CalculateStereoViewOffset(
+            leftEye,
+            leftEyeRotation,
+            worldToMeters,
+            leftEyeLocation);
+
+        FMatrix projection =
+            pStereoRendering->GetStereoProjectionMatrix(leftEye);
+
+        // TODO: consider assymetric frustums using 4 fovs
+        double one_over_tan_half_hfov = projection.M[0][0];
+
+        double hfov =
+            glm::degrees(2.0 * glm::atan(1.0 / one_over_tan_half_hfov));
+
+        cameras.emplace_back(
+            stereoLeftSize,
+            leftEyeLocation,
+            leftEyeRotation,
+            hfov);
+      }
+
+      if (stereoRightSize.X >= 1.0 && stereoRightSize.Y >= 1.0) {
+        FVector rightEyeLocation = location;
+        FRotator rightEyeRotation = rotation;
+        pStereoRendering->CalculateStereoViewOffset(
+            rightEye,
+            rightEyeRotation,
+            worldToMeters,
+            rightEyeLocation);
+
+        FMatrix projection =
+            pStereoRendering->GetStereoProjectionMatrix(rightEye);
+
+        double one_over_tan_half_hfov = projection.M[0][0];
+
+        double hfov =
+            glm::degrees(2.0f * glm::atan(1.0f / one_over_tan_half_hfov));
+
+        cameras.emplace_back(
+            stereoRightSize,
+            rightEyeLocation,
+            rightEyeRotation,
+            hfov);
+      }
+    } else {
+      cameras.emplace_back(
+          FVector2D(sizeX / dpiScalingFactor, sizeY / dpiScalingFactor),
+          location,
+          rotation,
+          fov);
+    }
+  }
 
-  switch (ApplyDpiScaling) {
-  case (EApplyDpiScaling::UseProjectDefault):
-    _scaleUsingDPI =
-        GetDefault<UCesiumRuntimeSettings>()->ScaleLevelOfDetailByDPI;
-    break;
-  case (EApplyDpiScaling::Yes):
-    _scaleUsingDPI = true;
-    break;
-  case (EApplyDpiScaling::No):
-    _scaleUsingDPI = false;
-    break;
-  default:
-    _scaleUsingDPI = true;
+  return cameras;
+}
+
+std::vector<FCesiumCamera> ACesium3DTileset::GetRemotePlayerCameras() const {
+  std::vector<FCesiumCamera> cameras;
+  const UWorld* pWorld = this->GetWorld();
+  if (!this->IncludeRemotePlayerViews || !pWorld) {
+    return cameras;
+  }
+
+  // The faces of a cube, each covered by a square 90 degree view.
+  static const FRotator cubeFaces[] = {
+      FRotator(0.0, 0.0, 0.0),
+      FRotator(0.0, 90.0, 0.0),
+      FRotator(0.0, 180.0, 0.0),
+      FRotator(0.0, 270.0, 0.0),
+      FRotator(90.0, 0.0, 0.0),
+      FRotator(-90.0, 0.0, 0.0)};
+
+  const double viewSize = double(FMath::Max(this->RemotePlayerViewSize, 1));
+
+  // Only a server has the player controllers of remote players.
+  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
+       playerControllerIt;
+       playerControllerIt++) {
+    const APlayerController* pPlayerController = playerControllerIt->Get();
+    if (!pPlayerController || pPlayerController->IsLocalController()) {
+      continue;
+    }
+
+    FVector location;
+    FRotator rotation;
+    pPlayerController->GetPlayerViewPoint(location, rotation);
+
+    for (const FRotator& face : cubeFaces) {
+      cameras.emplace_back(FVector2D(viewSize, viewSize), location, face, 90.0);
+    }
   }
+
+  return cameras;
 }
 
-void ACesium3DTileset::DestroyTileset() {
-  if (this->_cesiumViewExtension) {
-    this->_cesiumViewExtension = nullptr;
+std::vector<FCesiumCamera> ACesium3DTileset::GetSceneCaptures() const {
+  // TODO: really USceneCaptureComponent2D can be attached to any actor, is it
+  // worth searching every actor? Might it be better to provide an interface
+  // where users can volunteer cameras to be used with the tile selection as
+  // needed?
+  TArray<AActor*> sceneCaptures;
+  static TSubclassOf<ASceneCapture2D> SceneCapture2D =
+      ASceneCapture2D::StaticClass();
+  UGameplayStatics::GetAllActorsOfClass(this, SceneCapture2D, sceneCaptures);
+
+  std::vector<FCesiumCamera> cameras;
+  cameras.reserve(sceneCaptures.Num());
+
+  for (AActor* pActor : sceneCaptures) {
+    ASceneCapture2D* pSceneCapture = static_cast<ASceneCapture2D*>(pActor);
+    if (!pSceneCapture) {
+      continue;
+    }
+
+    USceneCaptureComponent2D* pSceneCaptureComponent =
+        pSceneCapture->GetCaptureComponent2D();
+    if (!pSceneCaptureComponent) {
+      continue;
+    }
+
+    const UCesiumSceneCaptureDetailComponent* pDetail =
+        pSceneCapture
+            ->FindComponentByClass<UCesiumSceneCaptureDetailComponent>();
+    if (pDetail && !pDetail->UseForTileSelection) {
+      continue;
+    }
+
+    if (pSceneCaptureComponent->ProjectionType !=
+        ECameraProjectionMode::Type::Perspective) {
+      continue;
+    }
+
+    UTextureRenderTarget2D* pRenderTarget =
+        pSceneCaptureComponent->TextureTarget;
+    if (!pRenderTarget) {
+      continue;
+    }
+
+    FVector2D renderTargetSize(pRenderTarget->SizeX, pRenderTarget->SizeY);
+    if (renderTargetSize.X < 1.0 || renderTargetSize.Y < 1.0) {
+      continue;
+    }
+
+    if (pDetail) {
+      renderTargetSize =
+          pDetail->GetTileSelectionViewportSize(renderTargetSize);
+    }
+
+    FVector captureLocation = pSceneCaptureComponent->GetComponentLocation();
+    FRotator captureRotation = pSceneCaptureComponent->GetComponentRotation();
+    double captureFov = pSceneCaptureComponent->FOVAngle;
+
+    cameras.emplace_back(
+        renderTargetSize,
+        captureLocation,
+        captureRotation,
+        captureFov);
   }
 
-  switch (this->TilesetSource) {
-  case ETilesetSource::FromUrl:
-    UE_LOG(
-        LogCesium,
-        Verbose,
-        TEXT("Destroying tileset from URL %s"),
-        *this->Url);
-    break;
-  case ETilesetSource::FromCesiumIon:
-    UE_LOG(
-        LogCesium,
-        Verbose,
-        TEXT("Destroying tileset for asset ID %d"),
-        this->IonAssetID);
-    break;
+  return cameras;
+}
+
+/*static*/ Cesium3DTilesSelection::ViewState
+ACesium3DTileset::CreateViewStateFromViewParameters(
+    const FCesiumCamera& camera,
+    const glm::dmat4& unrealWorldToTileset) {
+
+  double horizontalFieldOfView =
+      FMath::DegreesToRadians(camera.FieldOfViewDegrees);
+
+  double actualAspectRatio;
+  glm::dvec2 size(camera.ViewportSize.X, camera.ViewportSize.Y);
+
+  if (camera.OverrideAspectRatio != 0.0f) {
+    // Use aspect ratio and recompute effective viewport size after black bars
+    // are added.
+    actualAspectRatio = camera.OverrideAspectRatio;
+    double computedX = actualAspectRatio * camera.ViewportSize.Y;
+    double computedY = camera.ViewportSize.Y / actualAspectRatio;
+
+    double barWidth = camera.ViewportSize.X - computedX;
+    double barHeight = camera.ViewportSize.Y - computedY;
+
+    if (barWidth > 0.0 && barWidth > barHeight) {
+      // Black bars on the sides
+      size.x = computedX;
+    } else if (barHeight > 0.0 && barHeight > barWidth) {
+      // Black bars on the top and bottom
+      size.y = computedY;
+    }
+  } else {
+    actualAspectRatio = camera.ViewportSize.X / camera.ViewportSize.Y;
+  }
+
+  double verticalFieldOfView =
+      atan(tan(horizontalFieldOfView * 0.5) / actualAspectRatio) * 2.0;
+
+  FVector direction = camera.Rotation.RotateVector(FVector(1.0f, 0.0f, 0.0f));
+  FVector up = camera.Rotation.RotateVector(FVector(0.0f, 0.0f, 1.0f));
+
+  glm::dvec3 tilesetCameraLocation = glm::dvec3(
+      unrealWorldToTileset *
+      glm::dvec4(camera.Location.X, camera.Location.Y, camera.Location.Z, 1.0));
+  glm::dvec3 tilesetCameraFront = glm::normalize(glm::dvec3(
+      unrealWorldToTileset *
+      glm::dvec4(direction.X, direction.Y, direction.Z, 0.0)));
+  glm::dvec3 tilesetCameraUp = glm::normalize(
+      glm::dvec3(unrealWorldToTileset * glm::dvec4(up.X, up.Y, up.Z, 0.0)));
+
+  return Cesium3DTilesSelection::ViewState::create(
+      tilesetCameraLocation,
+      tilesetCameraFront,
+      tilesetCameraUp,
+      size,
+      horizontalFieldOfView,
+      verticalFieldOfView);
+}
+
+#if WITH_EDITOR
+std::vector<FCesiumCamera> ACesium3DTileset::GetEditorCameras() const {
+  if (!GEditor) {
+    return {};
+  }
+
+  UWorld* pWorld = this->GetWorld();
+  if (!IsValid(pWorld)) {
+    return {};
+  }
+
+  // Do not include editor cameras when running in a game world (which includes
+  // Play-in-Editor)
+  if (pWorld->IsGameWorld()) {
+    return {};
   }
 
-  // The way CesiumRasterOverlay::add is currently implemented, destroying the
-  // tileset without removing overlays will make it impossible to add it again
-  // once a new tileset is created (e.g. when switching between terrain
-  // assets)
-  TArray<UCesiumRasterOverlay*> rasterOverlays;
-  this->GetComponents<UCesiumRasterOverlay>(rasterOverlays);
-  for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
-    if (pOverlay->IsActive()) {
-      pOverlay->RemoveFromTileset();
+  const TArray<FEditorViewportClient*>& viewportClients =
+      GEditor->GetAllViewportClients();
+
+  // Until a level viewport has been used, every viewport is included.
+  const bool onlyActiveViewport =
+      GetDefault<UCesiumRuntimeSettings>()->OnlyUseActiveEditorViewport &&
+      GCurrentLevelEditingViewportClient != nullptr;
+
+  std::vector<FCesiumCamera> cameras;
+  cameras.reserve(viewportClients.Num());
+
+  for (FEditorViewportClient* pEditorViewportClient : viewportClients) {
+    if (!pEditorViewportClient) {
+      continue;
     }
-  }
 
-  TArray<UCesiumTileExcluder*> tileExcluders;
-  this->GetComponents<UCesiumTileExcluder>(tileExcluders);
-  for (UCesiumTileExcluder* pTileExcluder : tileExcluders) {
-    if (pTileExcluder->IsActive()) {
-      pTileExcluder->RemoveFromTileset();
+    if (!pEditorViewportClient->IsVisible() ||
+        !pEditorViewportClient->IsRealtime() ||
+        !pEditorViewportClient->IsPerspective()) {
+      continue;
     }
-  }
 
-  if (!this->_pTileset) {
-    return;
-  }
+    if (onlyActiveViewport &&
+        pEditorViewportClient != GCurrentLevelEditingViewportClient) {
+      continue;
+    }
 
-  // Don't allow this Cesium3DTileset to be fully destroyed until
-  // any cesium-native Tilesets it created have wrapped up any async
-  // operations in progress and have been fully destroyed.
-  // See IsReadyForFinishDestroy.
-  ++this->_tilesetsBeingDestroyed;
-  this->_pTileset->getAsyncDestructionCompleteEvent().thenInMainThread(
-      [this]() { --this->_tilesetsBeingDestroyed; });
-  this->_pTileset.Reset();
+    FRotator rotation;
+    if (pEditorViewportClient->bUsingOrbitCamera) {
+      rotation = (pEditorViewportClient->GetLookAtLocation() -
+                  pEditorViewportClient->GetViewLocation())
+                     .Rotation();
+    } else {
+      rotation = pEditorViewportClient->GetViewRotation();
+    }
 
-  switch (this->TilesetSource) {
-  case ETilesetSource::FromUrl:
-    UE_LOG(
-        LogCesium,
-        Verbose,
-        TEXT("Destroying tileset from URL %s done"),
-        *this->Url);
-    break;
-  case ETilesetSource::FromCesiumIon:
-    UE_LOG(
-        LogCesium,
-        Verbose,
-        TEXT("Destroying tileset for asset ID %d done"),
-        this->IonAssetID);
-    break;
+    const FVector& location = pEditorViewportClient->GetViewLocation();
+    double fov = pEditorViewportClient->ViewFOV;
+    FIntPoint offset;
+    FIntPoint size;
+    pEditorViewportClient->GetViewportDimensions(offset, size);
+
+    if (size.X < 1 || size.Y < 1) {
+      continue;
+    }
+
+    if (this->_scaleUsingDPI) {
+      float dpiScalingFactor = pEditorViewportClient->GetDPIScale();
+      size.X = static_cast<float>(size.X) / dpiScalingFactor;
+      size.Y = static_cast<float>(size.Y) / dpiScalingFactor;
+    }
+
+    if (pEditorViewportClient->IsAspectRatioConstrained()) {
+      cameras.emplace_back(
+          size,
+          location,
+          rotation,
+          fov,
+          pEditorViewportClient->AspectRatio);
+    } else {
+      cameras.emplace_back(size, location, rotation, fov);
+    }
   }
+
+  return cameras;
 }
+#endif
 
-std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
-  std::vector<FCesiumCamera> cameras = this->GetPlayerCameras();
+bool ACesium3DTileset::ShouldTickIfViewportsOnly() const {
+  return this->UpdateInEditor;
+}
 
-  std::vector<FCesiumCamera> sceneCaptures = this->GetSceneCaptures();
-  cameras.insert(
-      cameras.end(),
-      std::make_move_iterator(sceneCaptures.begin()),
-      std::make_move_iterator(sceneCaptures.end()));
+namespace {
 
+// Whether this is a tileset in the editor, rather than in a game or
+// Play-in-Editor, while the editor isn't the focused application.
+bool isInBackgroundEditor(const UWorld* pWorld) {
 #if WITH_EDITOR
-  std::vector<FCesiumCamera> editorCameras = this->GetEditorCameras();
-  cameras.insert(
-      cameras.end(),
-      std::make_move_iterator(editorCameras.begin()),
-      std::make_move_iterator(editorCameras.end()));
+  return GEditor && IsValid(pWorld) && !pWorld->IsGameWorld() &&
+         !FApp::HasFocus();
+#else
+  return false;
 #endif
+}
 
-  ACesiumCameraManager* pCameraManager = this->ResolvedCameraManager;
-  if (pCameraManager) {
-    const TMap<int32, FCesiumCamera>& extraCameras =
-        pCameraManager->GetCameras();
-    cameras.reserve(cameras.size() + extraCameras.Num());
-    for (auto cameraIt : extraCameras) {
-      cameras.push_back(cameraIt.Value);
-    }
+} // namespace
+
+namespace {
+
+void removeVisibleTilesFromList(
+    std::vector<Cesium3DTilesSelection::Tile*>& list,
+    const std::vector<Cesium3DTilesSelection::Tile*>& visibleTiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RemoveVisibleTilesFromList)
+
+  if (list.empty() || visibleTiles.empty()) {
+    return;
   }
 
-  return cameras;
+  const std::unordered_set<Cesium3DTilesSelection::Tile*> visible(
+      visibleTiles.begin(),
+      visibleTiles.end());
+  list.erase(
+      std::remove_if(
+          list.begin(),
+          list.end(),
+          [&visible](Cesium3DTilesSelection::Tile* pTile) {
+            return visible.find(pTile) != visible.end();
+          }),
+      list.end());
 }
 
-std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
-  UWorld* pWorld = this->GetWorld();
-  if (!pWorld) {
-    return {};
+/**
+ * @brief Gets the `UCesiumGltfComponent` of a tile, or nullptr if the tile is
+ * not done loading or has no renderable content.
+ *
+ * This only reads the tile, so it may be called from any thread while the
+ * tileset is not being updated.
+ */
+UCesiumGltfComponent*
+getGltfComponent(const Cesium3DTilesSelection::Tile* pTile) {
+  if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+    return nullptr;
   }
 
-  double worldToMeters = 100.0;
-  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
-  if (pWorldSettings) {
-    worldToMeters = pWorldSettings->WorldToMeters;
+  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      pTile->getContent().getRenderContent();
+  if (!pRenderContent) {
+    return nullptr;
   }
 
-  TSharedPtr<IStereoRendering, ESPMode::ThreadSafe> pStereoRendering = nullptr;
-  if (GEngine) {
-    pStereoRendering = GEngine->StereoRenderingDevice;
-  }
+  return static_cast<UCesiumGltfComponent*>(
+      pRenderContent->getRenderResources());
+}
 
-  bool useStereoRendering = false;
-  if (pStereoRendering && pStereoRendering->IsStereoEnabled()) {
-    useStereoRendering = true;
+/**
+ * @brief Gets the `UCesiumGltfComponent` of each of the given tiles, so that
+ * the passes over the tiles to render don't each look them up again. The
+ * result has one entry for each tile, which is nullptr for tiles without
+ * loaded render resources.
+ */
+std::vector<UCesiumGltfComponent*>
+getGltfComponents(const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GetGltfComponents)
+
+  std::vector<UCesiumGltfComponent*> result;
+  result.reserve(tiles.size());
+  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
+    result.push_back(getGltfComponent(pTile));
   }
+  return result;
+}
 
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(pWorld->GetNumPlayerControllers());
+/**
+ * @brief Hides the visual representations of the given tiles.
+ *
+ * The visual representations (i.e. the `getRendererResources` of the
+ * tiles) are assumed to be `UCesiumGltfComponent` instances that
+ * are made invisible by this call.
+ *
+ * @param tileset The tileset the tiles belong to
+ * @param tiles The tiles to hide
+ */
+void hideTiles(
+    const ACesium3DTileset& tileset,
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HideTiles)
+  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
+    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done ||
+        !pTile->getContent().getRenderContent()) {
+      continue;
+    }
 
-  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
-       playerControllerIt;
-       playerControllerIt++) {
+    UCesiumGltfComponent* Gltf = getGltfComponent(pTile);
+    if (Gltf && Gltf->IsVisible()) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityFalse)
+      Gltf->SetTileVisibility(false, tileset.GetKeepHiddenTilesInScene());
+
+      const double now = FPlatformTime::Seconds();
+      CesiumTileTrace::traceStage(
+          tileset,
+          *pTile,
+          ECesiumTileTraceStage::Hide,
+          now,
+          now,
+          Gltf->MemoryUsage.TotalCpuBytes + Gltf->MemoryUsage.TotalGpuBytes);
+    } else {
+      // TODO: why is this happening?
+      UE_LOG(
+          LogCesium,
+          Verbose,
+          TEXT("Tile to no longer render does not have a visible Gltf"));
+    }
+  }
+}
 
-    const TWeakObjectPtr<APlayerController> pPlayerController =
-        *playerControllerIt;
-    if (pPlayerController == nullptr) {
+/**
+ * @brief Removes collision for tiles that have been removed from the render
+ * list. This includes tiles that are fading out.
+ */
+void removeCollisionForTiles(
+    const std::unordered_set<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RemoveCollisionForTiles)
+  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
+    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
       continue;
     }
 
-    const APlayerCameraManager* pPlayerCameraManager =
-        pPlayerController->PlayerCameraManager;
-
-    if (!pPlayerCameraManager) {
+    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        content.getRenderContent();
+    if (!pRenderContent) {
       continue;
     }
 
-    double fov = pPlayerCameraManager->GetFOVAngle();
+    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
+        pRenderContent->getRenderResources());
+    if (Gltf) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionDisabled)
+      Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+  }
+}
 
-    FVector location;
-    FRotator rotation;
-    pPlayerController->GetPlayerViewPoint(location, rotation);
+/**
+ * @brief Applies the actor collision settings for a newly created glTF
+ * component
+ *
+ * TODO Add details here what that means
+ * @param BodyInstance ...
+ * @param Gltf ...
+ */
+void applyActorCollisionSettings(
+    const FBodyInstance& BodyInstance,
+    UCesiumGltfComponent* Gltf) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyActorCollisionSettings)
 
-    int32 sizeX, sizeY;
-    pPlayerController->GetViewportSize(sizeX, sizeY);
-    if (sizeX < 1 || sizeY < 1) {
-      continue;
-    }
+  const TArray<USceneComponent*>& ChildrenComponents =
+      Gltf->GetAttachChildren();
 
-    float dpiScalingFactor = 1.0f;
-    if (this->_scaleUsingDPI) {
-      ULocalPlayer* LocPlayer = Cast<ULocalPlayer>(pPlayerController->Player);
-      if (LocPlayer && LocPlayer->ViewportClient) {
-        dpiScalingFactor = LocPlayer->ViewportClient->GetDPIScale();
+  for (USceneComponent* ChildComponent : ChildrenComponents) {
+    UCesiumGltfPrimitiveComponent* PrimitiveComponent =
+        Cast<UCesiumGltfPrimitiveComponent>(ChildComponent);
+    if (PrimitiveComponent != nullptr) {
+      if (PrimitiveComponent->GetCollisionObjectType() !=
+          BodyInstance.GetObjectType()) {
+        PrimitiveComponent->SetCollisionObjectType(
+            BodyInstance.GetObjectType());
+      }
+      const UEnum* ChannelEnum = StaticEnum<ECollisionChannel>();
+      if (ChannelEnum) {
+        FCollisionResponseContainer responseContainer =
+            BodyInstance.GetResponseToChannels();
+        PrimitiveComponent->SetCollisionResponseToChannels(responseContainer);
       }
     }
+  }
+}
+} // namespace
+
+bool ACesium3DTileset::shouldUseLodTransitions() const {
+  return this->UseLodTransitions &&
+         CesiumScalability::getViewDistanceTier().EnableLodTransitions;
+}
+
+void ACesium3DTileset::updateScalabilityTextureSize() {
+  const int32 maximumTextureSize =
+      CesiumScalability::getTextureTier().MaximumTextureSize;
+  if (maximumTextureSize == this->_scalabilityMaximumTextureSize) {
+    return;
+  }
+  this->_scalabilityMaximumTextureSize = maximumTextureSize;
 
-    if (useStereoRendering) {
-      const auto leftEye = EStereoscopicEye::eSSE_LEFT_EYE;
-      const auto rightEye = EStereoscopicEye::eSSE_RIGHT_EYE;
+  // Overlays that haven't been added yet will use the new size when they are.
+  if (!this->_pTileset) {
+    return;
+  }
 
-      uint32 stereoLeftSizeX = static_cast<uint32>(sizeX);
-      uint32 stereoLeftSizeY = static_cast<uint32>(sizeY);
-      uint32 stereoRightSizeX = static_cast<uint32>(sizeX);
-      uint32 stereoRightSizeY = static_cast<uint32>(sizeY);
-      if (useStereoRendering) {
-        int32 _x;
-        int32 _y;
+  TArray<UCesiumRasterOverlay*> rasterOverlays;
+  this->GetComponents<UCesiumRasterOverlay>(rasterOverlays);
+  for (UCesiumRasterOverlay* pOverlay : rasterOverlays) {
+    if (pOverlay->IsActive()) {
+      pOverlay->Refresh();
+    }
+  }
+}
 
-        pStereoRendering
-            ->AdjustViewRect(leftEye, _x, _y, stereoLeftSizeX, stereoLeftSizeY);
+double ACesium3DTileset::GetGovernorScreenSpaceErrorScale() const {
+  // The governor follows the frame time and memory of the local node.
+  return this->EnableDetailGovernor && !this->UseClusterSelection &&
+                 this->_pDetailGovernor
+             ? this->_pDetailGovernor->getScreenSpaceErrorScale()
+             : 1.0;
+}
 
-        pStereoRendering->AdjustViewRect(
-            rightEye,
-            _x,
-            _y,
-            stereoRightSizeX,
-            stereoRightSizeY);
-      }
+void ACesium3DTileset::updateDetailGovernor(float deltaTime) {
+  if (!this->EnableDetailGovernor) {
+    if (this->_pDetailGovernor) {
+      this->_pDetailGovernor->reset();
+    }
+    return;
+  }
 
-      FVector2D stereoLeftSize(stereoLeftSizeX, stereoLeftSizeY);
-      FVector2D stereoRightSize(stereoRightSizeX, stereoRightSizeY);
+  if (!this->_pDetailGovernor) {
+    this->_pDetailGovernor = MakeUnique<CesiumDetailGovernor>();
+  }
 
-      if (stereoLeftSize.X >= 1.0 && stereoLeftSize.Y >= 1.0) {
-        FVector leftEyeLocation = location;
-        FRotator leftEyeRotation = rotation;
-        pStereoRendering->CalculateStereoViewOffset(
-            leftEye,
-            leftEyeRotation,
-            worldToMeters,
-            leftEyeLocation);
+  // Use the slowest of the threads and the GPU, so that time spent waiting
+  // for vertical sync or a frame rate limit doesn't count.
+  const double frameTime = FPlatformTime::ToSeconds(FMath::Max3(
+      GGameThreadTime,
+      GRenderThreadTime,
+      RHIGetGPUFrameCycles()));
+  const int64 memoryBytes = this->_memoryUsage.TotalCpuBytes +
+                            this->_memoryUsage.TotalGpuBytes +
+                            this->_pTileset->getTotalDataBytes();
+
+  const CesiumDetailGovernor::Targets targets{
+      double(this->GovernorTargetFrameTime) / 1000.0,
+      this->GovernorMemoryLimit,
+      double(this->GovernorMaximumScreenSpaceErrorScale)};
+  if (!this->_pDetailGovernor->update(
+          targets,
+          frameTime,
+          memoryBytes,
+          double(deltaTime))) {
+    return;
+  }
 
-        FMatrix projection =
-            pStereoRendering->GetStereoProjectionMatrix(leftEye);
+  UE_LOG(
+      LogCesium,
+      Log,
+      TEXT(
+          "Tileset %s: detail governor set the screen-space error scale to %.2f (frame time %.1f ms, target %.1f ms; memory %lld bytes, limit %lld bytes)"),
+      *this->GetName(),
+      this->_pDetailGovernor->getScreenSpaceErrorScale(),
+      this->_pDetailGovernor->getAverageFrameTime() * 1000.0,
+      this->GovernorTargetFrameTime,
+      memoryBytes,
+      this->GovernorMemoryLimit);
+}
 
-        // TODO: consider assymetric frustums using 4 fovs
-        double one_over_tan_half_hfov = projection.M[0][0];
+void ACesium3DTileset::updateTilesetOptionsFromProperties() {
+  Cesium3DTilesSelection::TilesetOptions& options =
+      this->_pTileset->getOptions();
+  // While memory is low, fewer and less detailed tiles are loaded and
+  // cached, so that the operating system doesn't have to terminate the
+  // application.
+  // Likewise while a mobile device is hot or its battery is low, so that it
+  // doesn't throttle itself, and at lower scalability levels.
+  const CesiumMemoryPressure& memoryPressure = CesiumMemoryPressure::get();
+  const CesiumMobileThrottling& mobileThrottling =
+      CesiumMobileThrottling::get();
+  const FCesiumScalabilityTier& scalabilityTier =
+      CesiumScalability::getViewDistanceTier();
+  options.maximumScreenSpaceError =
+      static_cast<double>(this->MaximumScreenSpaceError) *
+      this->GetGovernorScreenSpaceErrorScale() *
+      memoryPressure.getScreenSpaceErrorScale() *
+      mobileThrottling.getScreenSpaceErrorScale() *
+      double(scalabilityTier.MaximumScreenSpaceErrorScale);
+  options.preloadAncestors =
+      this->PreloadAncestors && !memoryPressure.isActive();
+  options.preloadSiblings = this->PreloadSiblings && !memoryPressure.isActive();
+  options.forbidHoles = this->ForbidHoles;
 
-        double hfov =
-            glm::degrees(2.0 * glm::atan(1.0 / one_over_tan_half_hfov));
+  int32 maximumSimultaneousTileLoads = this->MaximumSimultaneousTileLoads;
+  if (this->EnableDetailGovernor && this->_pDetailGovernor) {
+    maximumSimultaneousTileLoads = FMath::Max(
+        FMath::RoundToInt32(
+            maximumSimultaneousTileLoads *
+            this->_pDetailGovernor->getLoadScale()),
+        FMath::Min(maximumSimultaneousTileLoads, 1));
+  }
 
-        cameras.emplace_back(
-            stereoLeftSize,
-            leftEyeLocation,
-            leftEyeRotation,
-            hfov);
-      }
+  if (mobileThrottling.getLevel() != CesiumMobileThrottling::Level::None) {
+    maximumSimultaneousTileLoads = FMath::Max(
+        FMath::RoundToInt32(
+            maximumSimultaneousTileLoads *
+            mobileThrottling.getTileLoadScale()),
+        FMath::Min(maximumSimultaneousTileLoads, 1));
+  }
 
-      if (stereoRightSize.X >= 1.0 && stereoRightSize.Y >= 1.0) {
-        FVector rightEyeLocation = location;
-        FRotator rightEyeRotation = rotation;
-        pStereoRendering->CalculateStereoViewOffset(
-            rightEye,
-            rightEyeRotation,
-            worldToMeters,
-            rightEyeLocation);
+  const int32 backgroundTileLoads =
+      GetDefault<UCesiumRuntimeSettings>()
+          ->BackgroundEditorMaximumSimultaneousTileLoads;
+  if (backgroundTileLoads > 0 && isInBackgroundEditor(this->GetWorld())) {
+    maximumSimultaneousTileLoads =
+        FMath::Min(maximumSimultaneousTileLoads, backgroundTileLoads);
+  }
 
-        FMatrix projection =
-            pStereoRendering->GetStereoProjectionMatrix(rightEye);
+  CesiumWorldLoadBudget::Allocation allocation =
+      CesiumWorldLoadBudget::getAllocation(
+          this->GetWorld(),
+          this,
+          {maximumSimultaneousTileLoads, this->MaximumCachedBytes});
+  options.maximumSimultaneousTileLoads =
+      allocation.maximumSimultaneousTileLoads;
+  options.maximumCachedBytes = int64_t(
+      double(allocation.maximumCachedBytes) *
+      memoryPressure.getCachedBytesScale() *
+      double(scalabilityTier.MaximumCachedBytesScale));
+
+  // Cesium Native only counts the tile data it holds, so give it the share
+  // of the limit that remains once the Unreal resources created from that
+  // data are accounted for.
+  const int64 unrealBytes =
+      this->_memoryUsage.TotalCpuBytes + this->_memoryUsage.TotalGpuBytes;
+  const int64 nativeBytes = this->_pTileset->getTotalDataBytes();
+  if (this->IncludeUnrealResourcesInCachedBytes && unrealBytes > 0 &&
+      nativeBytes > 0) {
+    const double nativeFraction = std::clamp(
+        double(nativeBytes) / double(nativeBytes + unrealBytes),
+        0.1,
+        1.0);
+    options.maximumCachedBytes =
+        int64_t(double(options.maximumCachedBytes) * nativeFraction);
+  }
 
-        double one_over_tan_half_hfov = projection.M[0][0];
+  options.loadingDescendantLimit = this->LoadingDescendantLimit;
+  options.enableFrustumCulling = this->EnableFrustumCulling;
+  options.enableOcclusionCulling = this->GetEnableOcclusionCulling() &&
+                                   scalabilityTier.EnableOcclusionCulling;
+  options.showCreditsOnScreen = this->ShowCreditsOnScreen;
 
-        double hfov =
-            glm::degrees(2.0f * glm::atan(1.0f / one_over_tan_half_hfov));
+  options.delayRefinementForOcclusion = this->DelayRefinementForOcclusion;
+  options.enableFogCulling = this->EnableFogCulling;
 
-        cameras.emplace_back(
-            stereoRightSize,
-            rightEyeLocation,
-            rightEyeRotation,
-            hfov);
-      }
-    } else {
-      cameras.emplace_back(
-          FVector2D(sizeX / dpiScalingFactor, sizeY / dpiScalingFactor),
-          location,
-          rotation,
-          fov);
+  if (this->EnableHorizonCulling && !this->_pHorizonCullingExcluder) {
+    this->_pHorizonCullingExcluder =
+        std::make_shared<CesiumHorizonCullingExcluder>();
+  }
+  if (this->_pHorizonCullingExcluder) {
+    std::vector<std::shared_ptr<Cesium3DTilesSelection::ITileExcluder>>&
+        excluders = options.excluders;
+    auto it = std::find(
+        excluders.begin(),
+        excluders.end(),
+        this->_pHorizonCullingExcluder);
+    if (this->EnableHorizonCulling && it == excluders.end()) {
+      excluders.push_back(this->_pHorizonCullingExcluder);
+    } else if (!this->EnableHorizonCulling && it != excluders.end()) {
+      excluders.erase(it);
     }
   }
-
-  return cameras;
+  options.enforceCulledScreenSpaceError = this->EnforceCulledScreenSpaceError;
+  options.culledScreenSpaceError =
+      static_cast<double>(this->CulledScreenSpaceError);
+  options.enableLodTransitionPeriod = this->shouldUseLodTransitions();
+  options.lodTransitionLength = this->LodTransitionLength;
+  options.mainThreadLoadingTimeLimit =
+      CesiumFrameBudget::getMainThreadLoadingTimeLimit(this->GetWorld());
+  // options.kickDescendantsWhileFadingIn = false;
 }
 
-std::vector<FCesiumCamera> ACesium3DTileset::GetSceneCaptures() const {
-  // TODO: really USceneCaptureComponent2D can be attached to any actor, is it
-  // worth searching every actor? Might it be better to provide an interface
-  // where users can volunteer cameras to be used with the tile selection as
-  // needed?
-  TArray<AActor*> sceneCaptures;
-  static TSubclassOf<ASceneCapture2D> SceneCapture2D =
-      ASceneCapture2D::StaticClass();
-  UGameplayStatics::GetAllActorsOfClass(this, SceneCapture2D, sceneCaptures);
+void ACesium3DTileset::updateLastViewUpdateResultState(
+    const Cesium3DTilesSelection::ViewUpdateResult& result) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateLastViewUpdateResultState)
 
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(sceneCaptures.Num());
+  if (!this->LogSelectionStats) {
+    return;
+  }
 
-  for (AActor* pActor : sceneCaptures) {
-    ASceneCapture2D* pSceneCapture = static_cast<ASceneCapture2D*>(pActor);
-    if (!pSceneCapture) {
-      continue;
-    }
+  if (result.tilesToRenderThisFrame.size() != this->_lastTilesRendered ||
+      result.workerThreadTileLoadQueueLength !=
+          this->_lastWorkerThreadTileLoadQueueLength ||
+      result.mainThreadTileLoadQueueLength !=
+          this->_lastMainThreadTileLoadQueueLength ||
+      result.tilesVisited != this->_lastTilesVisited ||
+      result.culledTilesVisited != this->_lastCulledTilesVisited ||
+      result.tilesCulled != this->_lastTilesCulled ||
+      result.tilesOccluded != this->_lastTilesOccluded ||
+      result.tilesWaitingForOcclusionResults !=
+          this->_lastTilesWaitingForOcclusionResults ||
+      result.maxDepthVisited != this->_lastMaxDepthVisited) {
 
-    USceneCaptureComponent2D* pSceneCaptureComponent =
-        pSceneCapture->GetCaptureComponent2D();
-    if (!pSceneCaptureComponent) {
-      continue;
-    }
+    this->_lastTilesRendered = result.tilesToRenderThisFrame.size();
+    this->_lastWorkerThreadTileLoadQueueLength =
+        result.workerThreadTileLoadQueueLength;
+    this->_lastMainThreadTileLoadQueueLength =
+        result.mainThreadTileLoadQueueLength;
 
-    if (pSceneCaptureComponent->ProjectionType !=
-        ECameraProjectionMode::Type::Perspective) {
-      continue;
-    }
+    this->_lastTilesVisited = result.tilesVisited;
+    this->_lastCulledTilesVisited = result.culledTilesVisited;
+    this->_lastTilesCulled = result.tilesCulled;
+    this->_lastTilesOccluded = result.tilesOccluded;
+    this->_lastTilesWaitingForOcclusionResults =
+        result.tilesWaitingForOcclusionResults;
+    this->_lastMaxDepthVisited = result.maxDepthVisited;
 
-    UTextureRenderTarget2D* pRenderTarget =
-        pSceneCaptureComponent->TextureTarget;
-    if (!pRenderTarget) {
-      continue;
-    }
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT(
+            "%s: %d ms, Visited %d, Culled Visited %d, Rendered %d, Culled %d, Occluded %d, Waiting For Occlusion Results %d, Max Depth Visited: %d, Loading-Worker %d, Loading-Main %d (%.2f ms this frame, %.2f ms for all tilesets), Loaded tiles %g%%"),
+        *this->GetName(),
+        (std::chrono::high_resolution_clock::now() - this->_startTime).count() /
+            1000000,
+        result.tilesVisited,
+        result.culledTilesVisited,
+        result.tilesToRenderThisFrame.size(),
+        result.tilesCulled,
+        result.tilesOccluded,
+        result.tilesWaitingForOcclusionResults,
+        result.maxDepthVisited,
+        result.workerThreadTileLoadQueueLength,
+        result.mainThreadTileLoadQueueLength,
+        this->_mainThreadLoadingTimeThisFrame,
+        CesiumFrameBudget::getMainThreadLoadingTimeThisFrame(this->GetWorld()),
+        this->LoadProgress);
+  }
+}
 
-    FVector2D renderTargetSize(pRenderTarget->SizeX, pRenderTarget->SizeY);
-    if (renderTargetSize.X < 1.0 || renderTargetSize.Y < 1.0) {
+void ACesium3DTileset::showTilesToRender(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    const std::vector<UCesiumGltfComponent*>& gltfs) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShowTilesToRender)
+
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    Cesium3DTilesSelection::Tile* pTile = tiles[i];
+    UCesiumGltfComponent* Gltf = gltfs[i];
+    if (!Gltf) {
+      // When a tile does not have render resources (i.e. a glTF), then
+      // the resources either have not yet been loaded or prepared,
+      // or the tile is from an external tileset and does not directly
+      // own renderable content. In both cases, the tile is ignored here.
       continue;
     }
 
-    FVector captureLocation = pSceneCaptureComponent->GetComponentLocation();
-    FRotator captureRotation = pSceneCaptureComponent->GetComponentRotation();
-    double captureFov = pSceneCaptureComponent->FOVAngle;
-
-    cameras.emplace_back(
-        renderTargetSize,
-        captureLocation,
-        captureRotation,
-        captureFov);
-  }
-
-  return cameras;
-}
+    applyActorCollisionSettings(BodyInstance, Gltf);
 
-/*static*/ Cesium3DTilesSelection::ViewState
-ACesium3DTileset::CreateViewStateFromViewParameters(
-    const FCesiumCamera& camera,
-    const glm::dmat4& unrealWorldToTileset) {
+    if (Gltf->GetAttachParent() == nullptr) {
 
-  double horizontalFieldOfView =
-      FMath::DegreesToRadians(camera.FieldOfViewDegrees);
+      // The AttachToComponent method is ridiculously complex,
+      // so print a warning if attaching fails for some reason
+      bool attached = Gltf->AttachToComponent(
+          this->RootComponent,
+          FAttachmentTransformRules::KeepRelativeTransform);
+      if (!attached) {
+        FString tileIdString(
+            Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+                pTile->getTileID())
+                .c_str());
+        UE_LOG(
+            LogCesium,
+            Warning,
+            TEXT("Tile %s could not be attached to root"),
+            *tileIdString);
+      }
+    }
 
-  double actualAspectRatio;
-  glm::dvec2 size(camera.ViewportSize.X, camera.ViewportSize.Y);
+    if (!Gltf->IsVisible()) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityTrue)
+      Gltf->SetTileVisibility(true, this->KeepHiddenTilesInScene);
+
+      const double now = FPlatformTime::Seconds();
+      CesiumTileTrace::traceStage(
+          *this,
+          *pTile,
+          ECesiumTileTraceStage::Show,
+          now,
+          now,
+          Gltf->MemoryUsage.TotalCpuBytes + Gltf->MemoryUsage.TotalGpuBytes);
+    }
 
-  if (camera.OverrideAspectRatio != 0.0f) {
-    // Use aspect ratio and recompute effective viewport size after black bars
-    // are added.
-    actualAspectRatio = camera.OverrideAspectRatio;
-    double computedX = actualAspectRatio * camera.ViewportSize.Y;
-    double computedY = camera.ViewportSize.Y / actualAspectRatio;
+    if (Gltf->PendingTileTimings) {
+      this->GetTilePipelineHistograms().addTile(
+          *Gltf->PendingTileTimings,
+          FPlatformTime::Seconds());
+      Gltf->PendingTileTimings.reset();
+    }
 
-    double barWidth = camera.ViewportSize.X - computedX;
-    double barHeight = camera.ViewportSize.Y - computedY;
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionEnabled)
+      Gltf->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+    }
+  }
+}
 
-    if (barWidth > 0.0 && barWidth > barHeight) {
-      // Black bars on the sides
-      size.x = computedX;
-    } else if (barHeight > 0.0 && barHeight > barWidth) {
-      // Black bars on the top and bottom
-      size.y = computedY;
+void ACesium3DTileset::cookPhysicsMeshesNearInterestActors(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CookPhysicsMeshesNearInterestActors)
+
+  TArray<FVector, TInlineAllocator<8>> interestLocations;
+  for (const TSoftObjectPtr<AActor>& pInterestActor :
+       this->PhysicsInterestActors) {
+    const AActor* pActor = pInterestActor.Get();
+    if (pActor) {
+      interestLocations.Add(pActor->GetActorLocation());
     }
-  } else {
-    actualAspectRatio = camera.ViewportSize.X / camera.ViewportSize.Y;
   }
 
-  double verticalFieldOfView =
-      atan(tan(horizontalFieldOfView * 0.5) / actualAspectRatio) * 2.0;
+  const std::vector<UCesiumGltfComponent*> gltfs =
+      this->updateCollisionLevelTiles(tiles);
 
-  FVector direction = camera.Rotation.RotateVector(FVector(1.0f, 0.0f, 0.0f));
-  FVector up = camera.Rotation.RotateVector(FVector(0.0f, 0.0f, 1.0f));
+  if (interestLocations.IsEmpty()) {
+    return;
+  }
 
-  glm::dvec3 tilesetCameraLocation = glm::dvec3(
-      unrealWorldToTileset *
-      glm::dvec4(camera.Location.X, camera.Location.Y, camera.Location.Z, 1.0));
-  glm::dvec3 tilesetCameraFront = glm::normalize(glm::dvec3(
-      unrealWorldToTileset *
-      glm::dvec4(direction.X, direction.Y, direction.Z, 0.0)));
-  glm::dvec3 tilesetCameraUp = glm::normalize(
-      glm::dvec3(unrealWorldToTileset * glm::dvec4(up.X, up.Y, up.Z, 0.0)));
+  for (UCesiumGltfComponent* Gltf : gltfs) {
+    if (!Gltf) {
+      continue;
+    }
 
-  return Cesium3DTilesSelection::ViewState::create(
-      tilesetCameraLocation,
-      tilesetCameraFront,
-      tilesetCameraUp,
-      size,
-      horizontalFieldOfView,
-      verticalFieldOfView);
-}
+    for (USceneComponent* pChild : Gltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive || pPrimitive->PhysicsMeshRequested) {
+        continue;
+      }
 
-#if WITH_EDITOR
-std::vector<FCesiumCamera> ACesium3DTileset::GetEditorCameras() const {
-  if (!GEditor) {
-    return {};
-  }
+      const FBoxSphereBounds& bounds = pPrimitive->Bounds;
+      const bool isNearInterestActor =
+          interestLocations.ContainsByPredicate([&](const FVector& location) {
+            return FVector::Dist(location, bounds.Origin) -
+                       bounds.SphereRadius <=
+                   this->PhysicsInterestRadius;
+          });
+      if (!isNearInterestActor) {
+        continue;
+      }
 
-  UWorld* pWorld = this->GetWorld();
-  if (!IsValid(pWorld)) {
-    return {};
-  }
+      // Never try again for this primitive, even if it has no geometry to
+      // cook. The cooked mesh stays with the primitive until it's unloaded.
+      pPrimitive->PhysicsMeshRequested = true;
+
+      // The geometry is copied out of the glTF now, on the game thread,
+      // because the model may be unloaded while the mesh is being cooked.
+      TSharedRef<CesiumPhysicsMeshUtility::CollisionGeometry> pGeometry =
+          MakeShared<CesiumPhysicsMeshUtility::CollisionGeometry>();
+      if (!CesiumPhysicsMeshUtility::gatherCollisionGeometry(
+              *pPrimitive,
+              *pGeometry)) {
+        continue;
+      }
 
-  // Do not include editor cameras when running in a game world (which includes
-  // Play-in-Editor)
-  if (pWorld->IsGameWorld()) {
-    return {};
+      TWeakObjectPtr<UCesiumGltfPrimitiveComponent> pWeakPrimitive(pPrimitive);
+      TWeakObjectPtr<ACesium3DTileset> pWeakTileset(this);
+      getAsyncSystem()
+          .runInWorkerThread([pGeometry]() {
+            return CesiumPhysicsMeshUtility::buildChaosTriangleMesh(
+                MoveTemp(*pGeometry));
+          })
+          .thenInMainThread(
+              [pWeakPrimitive, pWeakTileset](
+                  TSharedPtr<
+                      Chaos::FTriangleMeshImplicitObject,
+                      ESPMode::ThreadSafe>&& pCollisionMesh) {
+                UCesiumGltfPrimitiveComponent* pPrimitive =
+                    pWeakPrimitive.Get();
+                if (!pPrimitive) {
+                  return;
+                }
+
+                const int64 bytesBefore =
+                    CesiumMemoryAccounting::measurePhysicsMesh(*pPrimitive);
+                CesiumPhysicsMeshUtility::applyCollisionMesh(
+                    *pPrimitive,
+                    pCollisionMesh);
+
+                // The cooked mesh belongs to the tile, so it's released with
+                // the rest of the tile's memory when the tile is unloaded.
+                UCesiumGltfComponent* pGltf =
+                    Cast<UCesiumGltfComponent>(pPrimitive->GetAttachParent());
+                ACesium3DTileset* pTileset = pWeakTileset.Get();
+                if (IsValid(pGltf) && pTileset) {
+                  FCesiumTilesetMemoryUsage usage;
+                  usage.PhysicsCpuBytes =
+                      CesiumMemoryAccounting::measurePhysicsMesh(*pPrimitive) -
+                      bytesBefore;
+                  CesiumMemoryAccounting::add(pTileset->_memoryUsage, usage);
+                  pGltf->MemoryUsage.PhysicsCpuBytes += usage.PhysicsCpuBytes;
+                  pGltf->MemoryUsage.TotalCpuBytes += usage.PhysicsCpuBytes;
+                }
+              });
+    }
   }
+}
 
-  const TArray<FEditorViewportClient*>& viewportClients =
-      GEditor->GetAllViewportClients();
+namespace {
 
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(viewportClients.Num());
+/**
+ * Finds the tile that a rendered tile's collision comes from when collision
+ * is limited to the given geometric error: its coarsest ancestor whose
+ * geometric error is no more than that, or the tile itself if it is coarser.
+ */
+const Cesium3DTilesSelection::Tile* findCollisionLevelTile(
+    const Cesium3DTilesSelection::Tile* pTile,
+    double geometricError) {
+  const Cesium3DTilesSelection::Tile* pResult = pTile;
+  for (const Cesium3DTilesSelection::Tile* pParent = pTile->getParent();
+       pParent && pParent->getGeometricError() <= geometricError;
+       pParent = pParent->getParent()) {
+    pResult = pParent;
+  }
+  return pResult;
+}
 
-  for (FEditorViewportClient* pEditorViewportClient : viewportClients) {
-    if (!pEditorViewportClient) {
+} // namespace
+
+std::vector<UCesiumGltfComponent*> ACesium3DTileset::updateCollisionLevelTiles(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateCollisionLevelTiles)
+
+  std::unordered_set<const Cesium3DTilesSelection::Tile*> renderedTiles(
+      tiles.begin(),
+      tiles.end());
+
+  std::vector<UCesiumGltfComponent*> result;
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> hiddenGltfs;
+  std::unordered_set<const Cesium3DTilesSelection::Tile*> visited;
+  for (const Cesium3DTilesSelection::Tile* pTile : tiles) {
+    const Cesium3DTilesSelection::Tile* pCollisionTile =
+        this->PhysicsGeometricError > 0.0
+            ? findCollisionLevelTile(pTile, this->PhysicsGeometricError)
+            : pTile;
+    if (!visited.insert(pCollisionTile).second) {
       continue;
     }
 
-    if (!pEditorViewportClient->IsVisible() ||
-        !pEditorViewportClient->IsRealtime() ||
-        !pEditorViewportClient->IsPerspective()) {
+    // Until the collision level tile is loaded, there's no collision here,
+    // rather than collision from a finer tile that would be replaced later.
+    UCesiumGltfComponent* pGltf = getGltfComponent(pCollisionTile);
+    if (!pGltf) {
       continue;
     }
+    result.push_back(pGltf);
+
+    // A collision level tile that was refined away is no longer rendered, so
+    // its collision is removed along with its visibility. It keeps colliding
+    // while its descendants are rendered in its place.
+    if (renderedTiles.find(pCollisionTile) == renderedTiles.end()) {
+      hiddenGltfs.Add(pGltf);
+      pGltf->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+    }
+  }
 
-    FRotator rotation;
-    if (pEditorViewportClient->bUsingOrbitCamera) {
-      rotation = (pEditorViewportClient->GetLookAtLocation() -
-                  pEditorViewportClient->GetViewLocation())
-                     .Rotation();
-    } else {
-      rotation = pEditorViewportClient->GetViewRotation();
+  for (const TWeakObjectPtr<UCesiumGltfComponent>& pWeakGltf :
+       this->_hiddenCollisionGltfs) {
+    UCesiumGltfComponent* pGltf = pWeakGltf.Get();
+    if (pGltf && !pGltf->IsVisible() && !hiddenGltfs.Contains(pWeakGltf)) {
+      pGltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     }
+  }
+  this->_hiddenCollisionGltfs = MoveTemp(hiddenGltfs);
 
-    const FVector& location = pEditorViewportClient->GetViewLocation();
-    double fov = pEditorViewportClient->ViewFOV;
-    FIntPoint offset;
-    FIntPoint size;
-    pEditorViewportClient->GetViewportDimensions(offset, size);
+  return result;
+}
 
-    if (size.X < 1 || size.Y < 1) {
+namespace {
+
+/**
+ * Finds the primitives of the given rendered tiles that are within the given
+ * distance of a camera and match the given predicate, closest first.
+ */
+template <typename Predicate>
+TArray<UCesiumGltfPrimitiveComponent*> findPrimitivesNearCameras(
+    const std::vector<FCesiumCamera>& cameras,
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    double maximumDistance,
+    Predicate&& predicate) {
+  struct Candidate {
+    UCesiumGltfPrimitiveComponent* pPrimitive;
+    double distance;
+  };
+  TArray<Candidate> candidates;
+
+  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
+    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
       continue;
     }
 
-    if (this->_scaleUsingDPI) {
-      float dpiScalingFactor = pEditorViewportClient->GetDPIScale();
-      size.X = static_cast<float>(size.X) / dpiScalingFactor;
-      size.Y = static_cast<float>(size.Y) / dpiScalingFactor;
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    if (!pRenderContent) {
+      continue;
     }
 
-    if (pEditorViewportClient->IsAspectRatioConstrained()) {
-      cameras.emplace_back(
-          size,
-          location,
-          rotation,
-          fov,
-          pEditorViewportClient->AspectRatio);
-    } else {
-      cameras.emplace_back(size, location, rotation, fov);
+    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
+        pRenderContent->getRenderResources());
+    if (!Gltf) {
+      continue;
+    }
+
+    for (USceneComponent* pChild : Gltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive || !predicate(*pPrimitive)) {
+        continue;
+      }
+
+      const FBoxSphereBounds& bounds = pPrimitive->Bounds;
+      double distance = TNumericLimits<double>::Max();
+      for (const FCesiumCamera& camera : cameras) {
+        distance = FMath::Min(
+            distance,
+            FVector::Dist(camera.Location, bounds.Origin) -
+                bounds.SphereRadius);
+      }
+      if (distance <= maximumDistance) {
+        candidates.Add({pPrimitive, distance});
+      }
     }
   }
 
-  return cameras;
-}
-#endif
+  candidates.Sort([](const Candidate& a, const Candidate& b) {
+    return a.distance < b.distance;
+  });
 
-bool ACesium3DTileset::ShouldTickIfViewportsOnly() const {
-  return this->UpdateInEditor;
+  TArray<UCesiumGltfPrimitiveComponent*> result;
+  result.Reserve(candidates.Num());
+  for (const Candidate& candidate : candidates) {
+    result.Add(candidate.pPrimitive);
+  }
+  return result;
 }
 
-namespace {
+} // namespace
 
-void removeVisibleTilesFromList(
-    std::vector<Cesium3DTilesSelection::Tile*>& list,
-    const std::vector<Cesium3DTilesSelection::Tile*>& visibleTiles) {
-  if (list.empty()) {
+void ACesium3DTileset::generateMeshDistanceFieldsNearCameras(
+    const std::vector<FCesiumCamera>& cameras,
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GenerateMeshDistanceFieldsNearCameras)
+
+  if (this->MaximumMeshDistanceFieldsPerFrame <= 0) {
     return;
   }
 
-  for (Cesium3DTilesSelection::Tile* pTile : visibleTiles) {
-    auto it = std::find(list.begin(), list.end(), pTile);
-    if (it != list.end()) {
-      list.erase(it);
+  const TArray<UCesiumGltfPrimitiveComponent*> candidates =
+      findPrimitivesNearCameras(
+          cameras,
+          tiles,
+          this->MeshDistanceFieldDistance,
+          [](const UCesiumGltfPrimitiveComponent& primitive) {
+            return !primitive.MeshDistanceFieldRequested &&
+                   CesiumMeshDistanceField::canHaveMeshDistanceField(
+                       primitive);
+          });
+
+  const int32 count =
+      FMath::Min(candidates.Num(), this->MaximumMeshDistanceFieldsPerFrame);
+  for (int32 i = 0; i < count; ++i) {
+    UCesiumGltfPrimitiveComponent* pPrimitive = candidates[i];
+
+    // Never try again for this primitive, even if it has no geometry to build
+    // a distance field from.
+    pPrimitive->MeshDistanceFieldRequested = true;
+
+    // The geometry is copied out of the glTF now, on the game thread, because
+    // the model may be unloaded while the distance field is being built.
+    TSharedRef<CesiumPhysicsMeshUtility::CollisionGeometry> pGeometry =
+        MakeShared<CesiumPhysicsMeshUtility::CollisionGeometry>();
+    if (!CesiumPhysicsMeshUtility::gatherCollisionGeometry(
+            *pPrimitive,
+            *pGeometry)) {
+      continue;
     }
+
+    // Distance fields are a visual improvement that nothing waits for, so
+    // they're built at a lower priority than tile loads and physics meshes.
+    CesiumAsync::Promise<TUniquePtr<FDistanceFieldVolumeData>> promise =
+        getAsyncSystem()
+            .createPromise<TUniquePtr<FDistanceFieldVolumeData>>();
+    UE::Tasks::Launch(
+        UE_SOURCE_LOCATION,
+        [promise, pGeometry]() mutable {
+          promise.resolve(
+              CesiumMeshDistanceField::buildMeshDistanceField(*pGeometry));
+        },
+        UE::Tasks::ETaskPriority::BackgroundLow);
+
+    TWeakObjectPtr<UCesiumGltfPrimitiveComponent> pWeakPrimitive(pPrimitive);
+    promise.getFuture().thenInMainThread(
+        [pWeakPrimitive](
+            TUniquePtr<FDistanceFieldVolumeData>&& pDistanceField) mutable {
+          CesiumMainThreadDispatcher::get().post(
+              CesiumMainThreadDispatcher::Priority::Low,
+              [pWeakPrimitive,
+               pDistanceField = MoveTemp(pDistanceField)]() mutable {
+                UCesiumGltfPrimitiveComponent* pPrimitive =
+                    pWeakPrimitive.Get();
+                if (pPrimitive && pPrimitive->MeshDistanceFieldRequested) {
+                  CesiumMeshDistanceField::applyMeshDistanceField(
+                      *pPrimitive,
+                      MoveTemp(pDistanceField));
+                }
+              });
+        });
   }
 }
 
-/**
- * @brief Hides the visual representations of the given tiles.
- *
- * The visual representations (i.e. the `getRendererResources` of the
- * tiles) are assumed to be `UCesiumGltfComponent` instances that
- * are made invisible by this call.
- *
- * @param tiles The tiles to hide
- */
-void hideTiles(const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HideTiles)
+void ACesium3DTileset::createRayTracingGeometryNearCameras(
+    const std::vector<FCesiumCamera>& cameras,
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateRayTracingGeometryNearCameras)
+
+  if (this->MaximumRayTracingGeometryBuildsPerFrame <= 0) {
+    return;
+  }
+
+  const TArray<UCesiumGltfPrimitiveComponent*> candidates =
+      findPrimitivesNearCameras(
+          cameras,
+          tiles,
+          this->RayTracingDistance,
+          [](const UCesiumGltfPrimitiveComponent& primitive) {
+            return CesiumRayTracingGeometry::canCreateRayTracingGeometry(
+                primitive);
+          });
+
+  const int32 count = FMath::Min(
+      candidates.Num(),
+      this->MaximumRayTracingGeometryBuildsPerFrame);
+  for (int32 i = 0; i < count; ++i) {
+    CesiumRayTracingGeometry::createRayTracingGeometry(*candidates[i]);
+  }
+}
+
+void ACesium3DTileset::updateTileShadowCasting(
+    const std::vector<FCesiumCamera>& cameras,
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileShadowCasting)
+
+  const bool limitShadowCasting = this->ShadowCastingDistance > 0.0;
+
   for (Cesium3DTilesSelection::Tile* pTile : tiles) {
-    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+    UCesiumGltfComponent* Gltf = getGltfComponent(pTile);
+    if (!Gltf) {
       continue;
     }
 
-    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (!pRenderContent) {
-      continue;
-    }
+    for (USceneComponent* pChild : Gltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive) {
+        continue;
+      }
 
-    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
-        pRenderContent->getRenderResources());
-    if (Gltf && Gltf->IsVisible()) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityFalse)
-      Gltf->SetVisibility(false, true);
-    } else {
-      // TODO: why is this happening?
-      UE_LOG(
-          LogCesium,
-          Verbose,
-          TEXT("Tile to no longer render does not have a visible Gltf"));
+      bool castShadow = true;
+      if (limitShadowCasting) {
+        const FBoxSphereBounds& bounds = pPrimitive->Bounds;
+        castShadow = std::any_of(
+            cameras.begin(),
+            cameras.end(),
+            [&](const FCesiumCamera& camera) {
+              return FVector::Dist(camera.Location, bounds.Origin) -
+                         bounds.SphereRadius <=
+                     this->ShadowCastingDistance;
+            });
+      }
+
+      // Changing whether a primitive casts shadows recreates its render
+      // state, so it's only done when the primitive crosses the distance.
+      if (pPrimitive->CastShadow != castShadow) {
+        pPrimitive->SetCastShadow(castShadow);
+      }
+      if (pPrimitive->InstancesComponent &&
+          pPrimitive->InstancesComponent->CastShadow != castShadow) {
+        pPrimitive->InstancesComponent->SetCastShadow(castShadow);
+      }
     }
   }
+
+  this->_shadowCastingLimited = limitShadowCasting;
 }
 
-/**
- * @brief Removes collision for tiles that have been removed from the render
- * list. This includes tiles that are fading out.
- */
-void removeCollisionForTiles(
-    const std::unordered_set<Cesium3DTilesSelection::Tile*>& tiles) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RemoveCollisionForTiles)
+void ACesium3DTileset::requestTextureResolutions(
+    const std::vector<FCesiumCamera>& cameras,
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RequestTextureResolutions)
+
+  CesiumTextureStreaming& streaming = CesiumTextureStreaming::get();
+  TArray<UTexture*> textures;
+
   for (Cesium3DTilesSelection::Tile* pTile : tiles) {
-    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+    UCesiumGltfComponent* Gltf = getGltfComponent(pTile);
+    if (!Gltf) {
       continue;
     }
 
-    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (!pRenderContent) {
-      continue;
+    for (USceneComponent* pChild : Gltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive) {
+        continue;
+      }
+
+      // A texture that covers the primitive once spans about as many pixels
+      // as the primitive's bounding sphere does, from the closest camera.
+      const FBoxSphereBounds& bounds = pPrimitive->Bounds;
+      double screenPixels = 0.0;
+      for (const FCesiumCamera& camera : cameras) {
+        const double distance = FMath::Max(
+            FVector::Dist(camera.Location, bounds.Origin) -
+                bounds.SphereRadius,
+            1.0);
+        const double viewWidth =
+            2.0 * distance *
+            FMath::Tan(FMath::DegreesToRadians(camera.FieldOfViewDegrees) *
+                       0.5);
+        screenPixels = FMath::Max(
+            screenPixels,
+            2.0 * bounds.SphereRadius / viewWidth * camera.ViewportSize.X);
+      }
+
+      textures.Reset();
+      pPrimitive->GetUsedTextures(textures, EMaterialQualityLevel::Num);
+      for (UTexture* pTexture : textures) {
+        streaming.requestResolution(pTexture, screenPixels);
+      }
     }
+  }
+}
 
-    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
-        pRenderContent->getRenderResources());
-    if (Gltf) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionDisabled)
-      Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+namespace {
+
+bool haveSameViews(
+    const std::vector<Cesium3DTilesSelection::ViewState>& a,
+    const std::vector<Cesium3DTilesSelection::ViewState>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].getPosition() != b[i].getPosition() ||
+        a[i].getDirection() != b[i].getDirection() ||
+        a[i].getUp() != b[i].getUp() ||
+        a[i].getViewportSize() != b[i].getViewportSize() ||
+        a[i].getHorizontalFieldOfView() != b[i].getHorizontalFieldOfView() ||
+        a[i].getVerticalFieldOfView() != b[i].getVerticalFieldOfView()) {
+      return false;
     }
   }
+
+  return true;
 }
 
 /**
- * @brief Applies the actor collision settings for a newly created glTF
- * component
- *
- * TODO Add details here what that means
- * @param BodyInstance ...
- * @param Gltf ...
+ * @brief Determines whether two sets of options select the same tiles for the
+ * same views. The load and cache budgets are not compared, because they are
+ * shared between tilesets and change from frame to frame, and they don't
+ * affect the selection once every selected tile is loaded.
  */
-void applyActorCollisionSettings(
-    const FBodyInstance& BodyInstance,
-    UCesiumGltfComponent* Gltf) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyActorCollisionSettings)
-
-  const TArray<USceneComponent*>& ChildrenComponents =
-      Gltf->GetAttachChildren();
+bool haveSameSelectionOptions(
+    const Cesium3DTilesSelection::TilesetOptions& a,
+    const Cesium3DTilesSelection::TilesetOptions& b) {
+  return a.maximumScreenSpaceError == b.maximumScreenSpaceError &&
+         a.preloadAncestors == b.preloadAncestors &&
+         a.preloadSiblings == b.preloadSiblings &&
+         a.forbidHoles == b.forbidHoles &&
+         a.loadingDescendantLimit == b.loadingDescendantLimit &&
+         a.enableFrustumCulling == b.enableFrustumCulling &&
+         a.enableOcclusionCulling == b.enableOcclusionCulling &&
+         a.showCreditsOnScreen == b.showCreditsOnScreen &&
+         a.delayRefinementForOcclusion == b.delayRefinementForOcclusion &&
+         a.enableFogCulling == b.enableFogCulling &&
+         a.enforceCulledScreenSpaceError == b.enforceCulledScreenSpaceError &&
+         a.culledScreenSpaceError == b.culledScreenSpaceError &&
+         a.enableLodTransitionPeriod == b.enableLodTransitionPeriod &&
+         a.lodTransitionLength == b.lodTransitionLength &&
+         a.excluders == b.excluders;
+}
 
-  for (USceneComponent* ChildComponent : ChildrenComponents) {
-    UCesiumGltfPrimitiveComponent* PrimitiveComponent =
-        Cast<UCesiumGltfPrimitiveComponent>(ChildComponent);
-    if (PrimitiveComponent != nullptr) {
-      if (PrimitiveComponent->GetCollisionObjectType() !=
-          BodyInstance.GetObjectType()) {
-        PrimitiveComponent->SetCollisionObjectType(
-            BodyInstance.GetObjectType());
-      }
-      const UEnum* ChannelEnum = StaticEnum<ECollisionChannel>();
-      if (ChannelEnum) {
-        FCollisionResponseContainer responseContainer =
-            BodyInstance.GetResponseToChannels();
-        PrimitiveComponent->SetCollisionResponseToChannels(responseContainer);
-      }
-    }
+/**
+ * @brief Determines whether any of the given excluders may exclude different
+ * tiles while the views stay the same. Only the horizon culling excluder
+ * depends on nothing but the views.
+ */
+bool haveViewIndependentExcluders(
+    const std::vector<std::shared_ptr<Cesium3DTilesSelection::ITileExcluder>>&
+        excluders,
+    const std::shared_ptr<CesiumHorizonCullingExcluder>&
+        pHorizonCullingExcluder) {
+  return std::any_of(
+      excluders.begin(),
+      excluders.end(),
+      [&pHorizonCullingExcluder](
+          const std::shared_ptr<Cesium3DTilesSelection::ITileExcluder>&
+              pExcluder) { return pExcluder != pHorizonCullingExcluder; });
+}
+
+/**
+ * @brief Computes the distance from the nearest of the given views to the
+ * tileset's root bounding volume, or 0 if a view is inside it or the root tile
+ * isn't loaded yet.
+ */
+double computeDistanceToRootTile(
+    const Cesium3DTilesSelection::Tileset& tileset,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  const Cesium3DTilesSelection::Tile* pRootTile = tileset.getRootTile();
+  if (!pRootTile || views.empty()) {
+    return 0.0;
+  }
+
+  double distanceSquared = std::numeric_limits<double>::max();
+  for (const Cesium3DTilesSelection::ViewState& view : views) {
+    distanceSquared = std::min(
+        distanceSquared,
+        view.computeDistanceSquaredToBoundingVolume(
+            pRootTile->getBoundingVolume()));
   }
+  return std::sqrt(distanceSquared);
 }
+
+// Tilesets stop being impostors a little closer than they start, so that a
+// camera around the ImpostorDistance doesn't switch them every frame.
+constexpr double ImpostorHysteresis = 0.9;
+
 } // namespace
 
-void ACesium3DTileset::updateTilesetOptionsFromProperties() {
-  Cesium3DTilesSelection::TilesetOptions& options =
-      this->_pTileset->getOptions();
-  options.maximumScreenSpaceError =
-      static_cast<double>(this->MaximumScreenSpaceError);
-  options.maximumCachedBytes = this->MaximumCachedBytes;
-  options.preloadAncestors = this->PreloadAncestors;
-  options.preloadSiblings = this->PreloadSiblings;
-  options.forbidHoles = this->ForbidHoles;
-  options.maximumSimultaneousTileLoads = this->MaximumSimultaneousTileLoads;
-  options.loadingDescendantLimit = this->LoadingDescendantLimit;
-  options.enableFrustumCulling = this->EnableFrustumCulling;
-  options.enableOcclusionCulling =
-      GetDefault<UCesiumRuntimeSettings>()
-          ->EnableExperimentalOcclusionCullingFeature &&
-      this->EnableOcclusionCulling;
-  options.showCreditsOnScreen = this->ShowCreditsOnScreen;
+bool ACesium3DTileset::updateImpostor(
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  // Height queries and movie captures need tiles to be selected, and there
+  // must be a selection to keep.
+  bool active = false;
+  if (this->EnableImpostor && this->_pLastViewUpdateResult &&
+      !this->_freezePending && !this->_captureMovieMode &&
+      this->_heightSampleQueries.IsEmpty()) {
+    const double threshold =
+        this->ImpostorDistance *
+        (this->_impostorActive ? ImpostorHysteresis : 1.0);
+    active = computeDistanceToRootTile(*this->_pTileset, views) > threshold;
+  }
 
-  options.delayRefinementForOcclusion = this->DelayRefinementForOcclusion;
-  options.enableFogCulling = this->EnableFogCulling;
-  options.enforceCulledScreenSpaceError = this->EnforceCulledScreenSpaceError;
-  options.culledScreenSpaceError =
-      static_cast<double>(this->CulledScreenSpaceError);
-  options.enableLodTransitionPeriod = this->UseLodTransitions;
-  options.lodTransitionLength = this->LodTransitionLength;
-  // options.kickDescendantsWhileFadingIn = false;
-}
+  if (!active) {
+    this->endImpostor();
+    return false;
+  }
 
-void ACesium3DTileset::updateLastViewUpdateResultState(
-    const Cesium3DTilesSelection::ViewUpdateResult& result) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateLastViewUpdateResultState)
+  if (this->_impostorActive) {
+    return true;
+  }
 
-  if (!this->LogSelectionStats) {
+  this->_impostorActive = true;
+  this->finishFades();
+
+  if (!this->ImpostorMesh) {
+    return true;
+  }
+
+  if (!this->ImpostorComponent) {
+    this->ImpostorComponent = NewObject<UStaticMeshComponent>(this);
+    this->ImpostorComponent->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    this->ImpostorComponent->SetCollisionEnabled(
+        ECollisionEnabled::NoCollision);
+    this->ImpostorComponent->SetMobility(this->RootComponent->Mobility);
+    this->ImpostorComponent->SetupAttachment(this->RootComponent);
+    this->ImpostorComponent->RegisterComponent();
+  }
+  this->ImpostorComponent->SetStaticMesh(this->ImpostorMesh);
+  this->ImpostorComponent->SetVisibility(true);
+
+  hideTiles(*this, this->_pLastViewUpdateResult->tilesToRenderThisFrame);
+  this->_impostorHidesTiles = true;
+  return true;
+}
+
+void ACesium3DTileset::endImpostor() {
+  if (!this->_impostorActive) {
     return;
   }
+  this->_impostorActive = false;
 
-  if (result.tilesToRenderThisFrame.size() != this->_lastTilesRendered ||
-      result.workerThreadTileLoadQueueLength !=
-          this->_lastWorkerThreadTileLoadQueueLength ||
-      result.mainThreadTileLoadQueueLength !=
-          this->_lastMainThreadTileLoadQueueLength ||
-      result.tilesVisited != this->_lastTilesVisited ||
-      result.culledTilesVisited != this->_lastCulledTilesVisited ||
-      result.tilesCulled != this->_lastTilesCulled ||
-      result.tilesOccluded != this->_lastTilesOccluded ||
-      result.tilesWaitingForOcclusionResults !=
-          this->_lastTilesWaitingForOcclusionResults ||
-      result.maxDepthVisited != this->_lastMaxDepthVisited) {
+  // The cameras may have moved anywhere in the meantime.
+  this->_lastViewIsStatic = false;
 
-    this->_lastTilesRendered = result.tilesToRenderThisFrame.size();
-    this->_lastWorkerThreadTileLoadQueueLength =
-        result.workerThreadTileLoadQueueLength;
-    this->_lastMainThreadTileLoadQueueLength =
-        result.mainThreadTileLoadQueueLength;
+  if (this->ImpostorComponent) {
+    this->ImpostorComponent->SetVisibility(false);
+  }
 
-    this->_lastTilesVisited = result.tilesVisited;
-    this->_lastCulledTilesVisited = result.culledTilesVisited;
-    this->_lastTilesCulled = result.tilesCulled;
-    this->_lastTilesOccluded = result.tilesOccluded;
-    this->_lastTilesWaitingForOcclusionResults =
-        result.tilesWaitingForOcclusionResults;
-    this->_lastMaxDepthVisited = result.maxDepthVisited;
+  // Show the tiles again right away, rather than wait for this tileset's
+  // next update.
+  if (this->_impostorHidesTiles && this->_pLastViewUpdateResult) {
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles =
+        this->_pLastViewUpdateResult->tilesToRenderThisFrame;
+    this->showTilesToRender(tiles, getGltfComponents(tiles));
+  }
+  this->_impostorHidesTiles = false;
+}
 
-    UE_LOG(
-        LogCesium,
-        Display,
-        TEXT(
-            "%s: %d ms, Visited %d, Culled Visited %d, Rendered %d, Culled %d, Occluded %d, Waiting For Occlusion Results %d, Max Depth Visited: %d, Loading-Worker %d, Loading-Main %d, Loaded tiles %g%%"),
-        *this->GetName(),
-        (std::chrono::high_resolution_clock::now() - this->_startTime).count() /
-            1000000,
-        result.tilesVisited,
-        result.culledTilesVisited,
-        result.tilesToRenderThisFrame.size(),
-        result.tilesCulled,
-        result.tilesOccluded,
-        result.tilesWaitingForOcclusionResults,
-        result.maxDepthVisited,
-        result.workerThreadTileLoadQueueLength,
-        result.mainThreadTileLoadQueueLength,
-        this->LoadProgress);
+bool ACesium3DTileset::isViewStatic(
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  return this->_pLastViewUpdateResult && this->_lastViewIsStatic &&
+         this->SkipUpdatesWhileViewIsStatic &&
+         !this->_captureMovieMode &&
+         !haveViewIndependentExcluders(
+             this->_pTileset->getOptions().excluders,
+             this->_pHorizonCullingExcluder) &&
+         haveSameViews(views, this->_lastViews) &&
+         haveSameSelectionOptions(
+             this->_pTileset->getOptions(),
+             this->_lastViewOptions);
+}
+
+namespace {
+// The values that the debug colors shade from green to red.
+constexpr double DebugColorMaximumLoadMilliseconds = 2000.0;
+constexpr double DebugColorMaximumBytes = 8.0 * 1024.0 * 1024.0;
+
+// The number of steps in the ramp from green to red. Values such as the
+// screen-space error change a little every time the views move, so they're
+// rounded to a step to avoid touching the materials of every tile in every
+// frame.
+constexpr float DebugColorRampSteps = 32.0f;
+
+FLinearColor debugColorRamp(double value, double maximum) {
+  const float t =
+      maximum > 0.0 ? float(FMath::Clamp(value / maximum, 0.0, 1.0)) : 1.0f;
+  return FLinearColor::LerpUsingHSV(
+      FLinearColor::Green,
+      FLinearColor::Red,
+      FMath::RoundToFloat(t * DebugColorRampSteps) / DebugColorRampSteps);
+}
+
+FLinearColor debugColorForLevel(const Cesium3DTilesSelection::Tile& tile) {
+  uint32 level = 0;
+  for (const Cesium3DTilesSelection::Tile* pParent = tile.getParent(); pParent;
+       pParent = pParent->getParent()) {
+    ++level;
   }
+
+  // Consecutive levels are far apart in hue, so neighbouring tiles of
+  // different levels are easy to tell apart.
+  return FLinearColor::MakeFromHSV8(uint8(level * 67), 192, 255);
 }
 
-void ACesium3DTileset::showTilesToRender(
-    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShowTilesToRender)
+double computeScreenSpaceError(
+    const Cesium3DTilesSelection::Tile& tile,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  double result = 0.0;
+  for (const Cesium3DTilesSelection::ViewState& view : views) {
+    const double distance = glm::sqrt(glm::max(
+        view.computeDistanceSquaredToBoundingVolume(tile.getBoundingVolume()),
+        0.0));
+    result = glm::max(
+        result,
+        view.computeScreenSpaceError(tile.getGeometricError(), distance));
+  }
+  return result;
+}
+} // namespace
 
-  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
-    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
-      continue;
+void ACesium3DTileset::updateDebugColors(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    const std::vector<UCesiumGltfComponent*>& gltfs,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  const ECesiumTileDebugColorMode mode = this->DebugColorMode;
+  if (mode == ECesiumTileDebugColorMode::None) {
+    if (this->_appliedDebugColorMode != ECesiumTileDebugColorMode::None) {
+      // Tiles that were tinted and then hidden are still tinted.
+      TArray<UCesiumGltfComponent*> gltfComponents;
+      this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+      for (UCesiumGltfComponent* pGltf : gltfComponents) {
+        pGltf->UpdateDebugColor(std::nullopt);
+      }
+      this->_appliedDebugColorMode = ECesiumTileDebugColorMode::None;
     }
+    return;
+  }
 
-    // That looks like some reeeally entertaining debug session...:
-    // const Cesium3DTilesSelection::TileID& id = pTile->getTileID();
-    // const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
-    // std::get_if<CesiumGeometry::QuadtreeTileID>(&id); if (!pQuadtreeID ||
-    // pQuadtreeID->level != 14 || pQuadtreeID->x != 5503 || pQuadtreeID->y !=
-    // 11626) { 	continue;
-    //}
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateDebugColors)
 
-    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (!pRenderContent) {
+  this->_appliedDebugColorMode = mode;
+
+  for (size_t i = 0; i < gltfs.size(); ++i) {
+    UCesiumGltfComponent* pGltf = gltfs[i];
+    if (!pGltf) {
       continue;
     }
 
-    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
-        pRenderContent->getRenderResources());
-    if (!Gltf) {
-      // When a tile does not have render resources (i.e. a glTF), then
-      // the resources either have not yet been loaded or prepared,
-      // or the tile is from an external tileset and does not directly
-      // own renderable content. In both cases, the tile is ignored here.
-      continue;
+    FLinearColor color;
+    switch (mode) {
+    case ECesiumTileDebugColorMode::LevelOfDetail:
+      color = debugColorForLevel(*tiles[i]);
+      break;
+    case ECesiumTileDebugColorMode::LoadTime:
+      color = debugColorRamp(
+          pGltf->LoadMilliseconds,
+          DebugColorMaximumLoadMilliseconds);
+      break;
+    case ECesiumTileDebugColorMode::Memory:
+      color = debugColorRamp(
+          double(
+              pGltf->MemoryUsage.TotalCpuBytes +
+              pGltf->MemoryUsage.TotalGpuBytes),
+          DebugColorMaximumBytes);
+      break;
+    case ECesiumTileDebugColorMode::ScreenSpaceError:
+    default:
+      color = debugColorRamp(
+          computeScreenSpaceError(*tiles[i], views),
+          this->MaximumScreenSpaceError);
+      break;
     }
 
-    applyActorCollisionSettings(BodyInstance, Gltf);
+    pGltf->UpdateDebugColor(color);
+  }
+}
 
-    if (Gltf->GetAttachParent() == nullptr) {
+void ACesium3DTileset::recordLastView(
+    std::vector<Cesium3DTilesSelection::ViewState>&& views,
+    const Cesium3DTilesSelection::ViewUpdateResult& result) {
+  this->_pLastViewUpdateResult = &result;
+  this->_lastViewIsStatic = false;
+
+  // A view update adds this tileset's credits to the credit system's current
+  // frame, so record them in order to add them again while updates are
+  // skipped. This may include credits that other tilesets added earlier in
+  // the same frame, which then stay on screen until this tileset is updated
+  // again. That errs towards showing attribution that is no longer needed,
+  // rather than hiding attribution that is.
+  const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem =
+      this->_pTileset->getExternals().pCreditSystem;
+  if (pCreditSystem) {
+    this->_lastViewCredits = pCreditSystem->getCreditsToShowThisFrame();
+  } else {
+    this->_lastViewCredits.clear();
+  }
 
-      // The AttachToComponent method is ridiculously complex,
-      // so print a warning if attaching fails for some reason
-      bool attached = Gltf->AttachToComponent(
-          this->RootComponent,
-          FAttachmentTransformRules::KeepRelativeTransform);
-      if (!attached) {
-        FString tileIdString(
-            Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
-                pTile->getTileID())
-                .c_str());
-        UE_LOG(
-            LogCesium,
-            Warning,
-            TEXT("Tile %s could not be attached to root"),
-            *tileIdString);
-      }
-    }
+  if (!this->SkipUpdatesWhileViewIsStatic || this->_captureMovieMode) {
+    return;
+  }
 
-    if (!Gltf->IsVisible()) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityTrue)
-      Gltf->SetVisibility(true, true);
+  // Occlusion results and tile excluders can change the selection without the
+  // views changing, so tilesets using them are always updated. Horizon
+  // culling only depends on the views.
+  const Cesium3DTilesSelection::TilesetOptions& options =
+      this->_pTileset->getOptions();
+  if (options.enableOcclusionCulling ||
+      haveViewIndependentExcluders(
+          options.excluders,
+          this->_pHorizonCullingExcluder)) {
+    return;
+  }
+
+  // The selection can only be reused once there is nothing left for a view
+  // update to do: no tiles or raster overlay tiles loading, and no tiles
+  // fading in or out.
+  if (result.workerThreadTileLoadQueueLength > 0 ||
+      result.mainThreadTileLoadQueueLength > 0 ||
+      !result.tilesFadingOut.empty() ||
+      this->_pTileset->computeLoadProgress() < 100.0f) {
+    return;
+  }
+
+  for (const Cesium3DTilesSelection::Tile* pTile :
+       result.tilesToRenderThisFrame) {
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    if (options.enableLodTransitionPeriod && pRenderContent &&
+        pRenderContent->getLodTransitionFadePercentage() < 1.0f) {
+      return;
     }
 
-    {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionEnabled)
-      Gltf->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+    for (const Cesium3DTilesSelection::RasterMappedTo3DTile& mapped :
+         pTile->getMappedRasterTiles()) {
+      if (mapped.getLoadingTile()) {
+        return;
+      }
     }
   }
+
+  this->_lastViews = std::move(views);
+  this->_lastViewOptions = options;
+  this->_lastViewIsStatic = true;
 }
 
-static void updateTileFade(Cesium3DTilesSelection::Tile* pTile, bool fadingIn) {
-  if (!pTile || !pTile->getContent().isRenderContent()) {
+void ACesium3DTileset::completeFreeze() {
+  this->_freezePending = false;
+  this->_selectionFrozen = true;
+
+  if (!this->_pTileset || !this->_pLastViewUpdateResult) {
     return;
   }
 
-  if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
-    return;
+  // Nothing moves the fades on while the selection is frozen, so finish
+  // them now rather than leave tiles half faded.
+  this->finishFades();
+}
+
+void ACesium3DTileset::finishFades() {
+  hideTiles(*this, this->_tilesToHideNextFrame);
+  this->_tilesToHideNextFrame.clear();
+  hideTiles(*this, this->_pLastViewUpdateResult->tilesFadingOut);
+
+  if (this->shouldUseLodTransitions()) {
+    for (Cesium3DTilesSelection::Tile* pTile :
+         this->_pLastViewUpdateResult->tilesToRenderThisFrame) {
+      UCesiumGltfComponent* pGltf = getGltfComponent(pTile);
+      if (pGltf) {
+        pGltf->UpdateFade(
+            1.0f,
+            true,
+            this->UseCustomPrimitiveDataForLodTransitions);
+      }
+    }
   }
+}
 
-  const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-      content.getRenderContent();
-  if (!pRenderContent) {
-    return;
+void ACesium3DTileset::reuseLastView() {
+  const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem =
+      this->_pTileset->getExternals().pCreditSystem;
+  if (pCreditSystem) {
+    for (const CesiumUtility::Credit& credit : this->_lastViewCredits) {
+      pCreditSystem->addCreditToFrame(credit);
+    }
   }
 
-  UCesiumGltfComponent* pGltf = reinterpret_cast<UCesiumGltfComponent*>(
-      pRenderContent->getRenderResources());
+  CesiumWorldLoadBudget::reportDemand(
+      this->GetWorld(),
+      this,
+      {this->_selectionFrozen || this->_impostorActive
+           ? 0
+           : std::min<int32_t>(
+                 this->MaximumSimultaneousTileLoads,
+                 this->_pLastViewUpdateResult->workerThreadTileLoadQueueLength),
+       std::min<int64_t>(
+           this->MaximumCachedBytes,
+           this->_pTileset->getTotalDataBytes())});
+
+  // The physics interest actors may move even though the views don't.
+  if (this->CreatePhysicsMeshes && this->CookPhysicsMeshesOnDemand &&
+      !this->_selectionFrozen && !this->_impostorActive) {
+    this->cookPhysicsMeshesNearInterestActors(
+        this->_pLastViewUpdateResult->tilesToRenderThisFrame);
+  }
+
+  // Regions watched since the last update may already be loaded, and the
+  // heights of a batch of samples stabilize without changing the views.
+  this->updateWatchedRegions(*this->_pLastViewUpdateResult);
+  this->updateHeightSampleQueries();
+
+  // With the views unchanged, the debug colors only change with their mode.
+  if (this->DebugColorMode != this->_appliedDebugColorMode) {
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles =
+        this->_pLastViewUpdateResult->tilesToRenderThisFrame;
+    this->updateDebugColors(tiles, getGltfComponents(tiles), this->_lastViews);
+  }
+}
+
+static void updateTileFade(
+    const Cesium3DTilesSelection::Tile* pTile,
+    bool fadingIn,
+    bool useCustomPrimitiveData) {
+  UCesiumGltfComponent* pGltf = pTile ? getGltfComponent(pTile) : nullptr;
   if (!pGltf) {
     return;
   }
@@ -1944,7 +5689,7 @@ static void updateTileFade(Cesium3DTilesSelection::Tile* pTile, bool fadingIn) {
   float percentage =
       pTile->getContent().getRenderContent()->getLodTransitionFadePercentage();
 
-  pGltf->UpdateFade(percentage, fadingIn);
+  pGltf->UpdateFade(percentage, fadingIn, useCustomPrimitiveData);
 }
 
 // Called every frame
@@ -1956,6 +5701,15 @@ void ACesium3DTileset::Tick(float DeltaTime) {
   this->ResolveGeoreference();
   this->ResolveCameraManager();
   this->ResolveCreditSystem();
+  this->resolvePendingPicks();
+  this->updateFeatureSelectionTextures();
+
+  // The point budget is global, not owned by the Tileset. We're just applying
+  // the setting to it here out of convenience.
+  CesiumPointBudget::setMaximumPoints(CesiumScalability::limitPoints(
+      CesiumScalability::getViewDistanceTier(),
+      GetDefault<UCesiumRuntimeSettings>()->MaximumPointsPerFrame));
+  this->updateScalabilityTextureSize();
 
   UCesium3DTilesetRoot* pRoot = Cast<UCesium3DTilesetRoot>(this->RootComponent);
   if (!pRoot) {
@@ -1966,6 +5720,19 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     return;
   }
 
+  if (this->_selectionFrozen) {
+    if (this->_pTileset && this->_pLastViewUpdateResult) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FrozenView)
+      this->reuseLastView();
+    }
+    return;
+  }
+
+  if (GetDefault<UCesiumRuntimeSettings>()->PauseTilesetsInBackgroundEditor &&
+      isInBackgroundEditor(this->GetWorld())) {
+    return;
+  }
+
   if (!this->_pTileset) {
     LoadTileset();
 
@@ -1977,7 +5744,9 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     }
   }
 
-  if (this->BoundingVolumePoolComponent && this->_cesiumViewExtension) {
+  if (this->_pHzbOcclusionPool) {
+    this->_pHzbOcclusionPool->UpdateOcclusion();
+  } else if (this->BoundingVolumePoolComponent && this->_cesiumViewExtension) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateOcclusion)
     const TArray<USceneComponent*>& children =
         this->BoundingVolumePoolComponent->GetAttachChildren();
@@ -1993,13 +5762,59 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     }
   }
 
+  this->updateDetailGovernor(DeltaTime);
   updateTilesetOptionsFromProperties();
 
+  if (this->_freezePending) {
+    // The last update before the selection is frozen starts no loads, and
+    // unloads every cached tile that it doesn't select.
+    Cesium3DTilesSelection::TilesetOptions& options =
+        this->_pTileset->getOptions();
+    options.maximumSimultaneousTileLoads = 0;
+    options.maximumCachedBytes = 0;
+  }
+
   std::vector<FCesiumCamera> cameras = this->GetCameras();
-  if (cameras.empty()) {
+  if (cameras.empty() && this->_heightSampleQueries.IsEmpty()) {
+    if (this->_freezePending) {
+      this->completeFreeze();
+    }
     return;
   }
 
+  // Distance fields and ray tracing geometry are only built near the cameras
+  // that are actually viewed from, for the tiles that were rendered last
+  // frame.
+  if (this->GenerateMeshDistanceFields && this->_pLastViewUpdateResult) {
+    this->generateMeshDistanceFieldsNearCameras(
+        cameras,
+        this->_pLastViewUpdateResult->tilesToRenderThisFrame);
+  }
+  if (this->LimitRayTracingGeometryBuilds && this->_pLastViewUpdateResult) {
+    this->createRayTracingGeometryNearCameras(
+        cameras,
+        this->_pLastViewUpdateResult->tilesToRenderThisFrame);
+  }
+  if ((this->ShadowCastingDistance > 0.0 || this->_shadowCastingLimited) &&
+      this->_pLastViewUpdateResult) {
+    this->updateTileShadowCasting(
+        cameras,
+        this->_pLastViewUpdateResult->tilesToRenderThisFrame);
+  }
+  if ((CesiumTextureStreaming::isEnabled() || this->SkipUnneededTextureMips) &&
+      this->_pLastViewUpdateResult) {
+    this->requestTextureResolutions(
+        cameras,
+        this->_pLastViewUpdateResult->tilesToRenderThisFrame);
+  }
+
+  this->applyCameraPriorities(cameras, DeltaTime);
+
+  const size_t viewCameraCount = cameras.size();
+  this->addMovieLookAheadCameras(cameras);
+  this->addPredictedCameras(cameras, DeltaTime);
+  this->addFoveatedCameras(cameras, viewCameraCount);
+
   glm::dmat4 ueTilesetToUeWorld =
       VecMath::createMatrix4D(this->GetActorTransform().ToMatrixWithScale());
 
@@ -2015,14 +5830,56 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     return;
   }
 
+  this->addInterestPointCameras(
+      cameras,
+      viewCameraCount,
+      unrealWorldToCesiumTileset);
+  this->addHeightSampleCameras(cameras);
+
   std::vector<Cesium3DTilesSelection::ViewState> frustums;
   for (const FCesiumCamera& camera : cameras) {
     frustums.push_back(
         CreateViewStateFromViewParameters(camera, unrealWorldToCesiumTileset));
   }
 
+  if (this->_pHorizonCullingExcluder) {
+    this->_pHorizonCullingExcluder->setViews(frustums);
+  }
+
+  if (this->updateImpostor(frustums)) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::Impostor)
+    this->reuseLastView();
+    return;
+  }
+
+  if (!this->_freezePending && this->isViewStatic(frustums)) {
+    // Nothing that affects the tile selection has changed and every selected
+    // tile is loaded, so the last selection is still correct and the tiles
+    // are already shown.
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::StaticView)
+    this->reuseLastView();
+    return;
+  }
+
+  CesiumTilesetUpdateScheduler::report(
+      this->GetWorld(),
+      this,
+      {computeDistanceToRootTile(*this->_pTileset, frustums),
+       !this->_pLastViewUpdateResult ||
+           this->_pTileset->computeLoadProgress() < 100.0f});
+
+  if (this->_pLastViewUpdateResult && !this->_freezePending &&
+      !CesiumTilesetUpdateScheduler::shouldUpdate(this->GetWorld(), this)) {
+    // Another tileset's turn. Keep showing the tiles selected last time.
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DeferredUpdate)
+    this->reuseLastView();
+    return;
+  }
+
+  this->_mainThreadLoadingTimeThisFrame = 0.0;
+
   const Cesium3DTilesSelection::ViewUpdateResult* pResult;
-  if (this->_captureMovieMode) {
+  if (this->_captureMovieMode && this->WaitForMovieFrameTiles) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
     pResult = &this->_pTileset->updateViewOffline(frustums);
   } else {
@@ -2031,44 +5888,113 @@ void ACesium3DTileset::Tick(float DeltaTime) {
   }
   updateLastViewUpdateResultState(*pResult);
 
+  // The tiles created by the update are registered, but not yet drawn.
+  if (this->_pRenderDataBatch) {
+    this->_pRenderDataBatch->flush();
+  }
+
+  if (!this->_movieLookAheadCameras.empty() &&
+      this->_pTileset->computeLoadProgress() >= 100.0f) {
+    this->_movieLookAheadCameras.clear();
+  }
+
+  this->applyPendingRasterTiles();
+
+  CesiumWorldLoadBudget::reportDemand(
+      this->GetWorld(),
+      this,
+      {std::min<int32_t>(
+           this->MaximumSimultaneousTileLoads,
+           pResult->workerThreadTileLoadQueueLength),
+       std::min<int64_t>(
+           this->MaximumCachedBytes,
+           this->_pTileset->getTotalDataBytes())});
+
   removeCollisionForTiles(pResult->tilesFadingOut);
 
   removeVisibleTilesFromList(
       _tilesToHideNextFrame,
       pResult->tilesToRenderThisFrame);
-  hideTiles(_tilesToHideNextFrame);
+  hideTiles(*this, _tilesToHideNextFrame);
 
   _tilesToHideNextFrame.clear();
   for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut) {
     Cesium3DTilesSelection::TileRenderContent* pRenderContent =
         pTile->getContent().getRenderContent();
-    if (!this->UseLodTransitions ||
+    if (!this->shouldUseLodTransitions() ||
         (pRenderContent &&
          pRenderContent->getLodTransitionFadePercentage() >= 1.0f)) {
       _tilesToHideNextFrame.push_back(pTile);
     }
   }
 
-  showTilesToRender(pResult->tilesToRenderThisFrame);
+  // Finding the glTF components of the tiles only reads tile state, so it's
+  // done in parallel. The components themselves are only modified here on the
+  // game thread.
+  const std::vector<UCesiumGltfComponent*> gltfsToRender =
+      getGltfComponents(pResult->tilesToRenderThisFrame);
+
+  showTilesToRender(pResult->tilesToRenderThisFrame, gltfsToRender);
+
+  if (this->CreatePhysicsMeshes && this->CookPhysicsMeshesOnDemand) {
+    this->cookPhysicsMeshesNearInterestActors(pResult->tilesToRenderThisFrame);
+  }
 
   if (this->UseLodTransitions) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileFades)
 
-    for (Cesium3DTilesSelection::Tile* pTile :
-         pResult->tilesToRenderThisFrame) {
-      updateTileFade(pTile, true);
+    // While the scalability tier turns the transitions off, tiles switch at
+    // once, so any that were still fading in are shown in full.
+    const bool fading = this->shouldUseLodTransitions();
+    for (size_t i = 0; i < gltfsToRender.size(); ++i) {
+      if (gltfsToRender[i]) {
+        gltfsToRender[i]->UpdateFade(
+            fading ? pResult->tilesToRenderThisFrame[i]
+                         ->getContent()
+                         .getRenderContent()
+                         ->getLodTransitionFadePercentage()
+                   : 1.0f,
+            true,
+            this->UseCustomPrimitiveDataForLodTransitions);
+      }
     }
 
-    for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut) {
-      updateTileFade(pTile, false);
+    if (fading) {
+      for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut) {
+        updateTileFade(
+            pTile,
+            false,
+            this->UseCustomPrimitiveDataForLodTransitions);
+      }
     }
   }
 
+  this->updateDebugColors(
+      pResult->tilesToRenderThisFrame,
+      gltfsToRender,
+      frustums);
+
   this->UpdateLoadStatus();
+
+  if (!this->_watchedRegions.IsEmpty()) {
+    this->_watchedRegionViews = frustums;
+  }
+
+  this->recordLastView(std::move(frustums), *pResult);
+
+  this->broadcastTileLoadEvents();
+  this->updateWatchedRegions(*pResult);
+  this->updateHeightSampleQueries();
+
+  if (this->_freezePending) {
+    this->completeFreeze();
+  }
 }
 
 void ACesium3DTileset::EndPlay(const EEndPlayReason::Type EndPlayReason) {
-  this->DestroyTileset();
+  // An actor whose level is only made invisible may be added to the world
+  // again, with its components.
+  this->DestroyTileset(EndPlayReason != EEndPlayReason::RemovedFromWorld);
   AActor::EndPlay(EndPlayReason);
 }
 
@@ -2124,19 +6050,61 @@ void ACesium3DTileset::PostEditChangeProperty(
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IonAssetEndpointUrl) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreatePhysicsMeshes) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      CookPhysicsMeshesOnDemand) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreateNavCollision) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableHeightQueries) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CollisionOnly) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, AlwaysIncludeTangents) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      UseFastTangentGeneration) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, GenerateSmoothNormals) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      WeldVerticesForSmoothNormals) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      ComputeFlatNormalsInMaterial) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      OrderPointsProgressively) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      ComputeOverlayTextureCoordinatesInMaterial) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CompressTextures) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ShareIdenticalTextures) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, SkipUnneededTextureMips) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, BuildNaniteMeshes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseVertexPulling) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PackVertexAttributes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseLightweightPrimitives) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, MergePrimitives) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      GenerateMeshDistanceFields) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      LimitRayTracingGeometryBuilds) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      TileShadowCacheInvalidationBehavior) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, GltfDataRetention) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableWaterMask) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IgnoreKhrMaterialsUnlit) ||
-      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Material) ||
-      PropName ==
-          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TranslucentMaterial) ||
-      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, WaterMaterial) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ApplyDpiScaling) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableOcclusionCulling) ||
@@ -2145,12 +6113,25 @@ void ACesium3DTileset::PostEditChangeProperty(
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ShowCreditsOnScreen) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Root) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, RuntimeVirtualTextures) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      VirtualTextureRenderPassType)) {
+    this->DestroyTileset();
+  } else if (
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Material) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TranslucentMaterial) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, WaterMaterial)) {
+    this->updateTileMaterials();
+  } else if (
       // For properties nested in structs, GET_MEMBER_NAME_CHECKED will prefix
       // with the struct name, so just do a manual string comparison.
       PropNameAsString == TEXT("RenderCustomDepth") ||
       PropNameAsString == TEXT("CustomDepthStencilValue") ||
       PropNameAsString == TEXT("CustomDepthStencilWriteMask")) {
-    this->DestroyTileset();
+    this->updateTileCustomDepthParameters();
   } else if (
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Georeference)) {
     this->InvalidateResolvedGeoreference();
@@ -2193,6 +6174,11 @@ void ACesium3DTileset::PostEditChangeChainProperty(
   if (PropName ==
       GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PointCloudShading)) {
     FCesiumGltfPointsSceneProxyUpdater::UpdateSettingsInProxies(this);
+    this->updateEyeDomeLighting();
+    this->updateTileCustomDepthParameters();
+  } else if (
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, FeatureStyle)) {
+    this->updateFeatureStyleTexture();
   }
 }
 
@@ -2215,25 +6201,13 @@ void ACesium3DTileset::PostEditImport() {
 
 void ACesium3DTileset::BeginDestroy() {
   this->InvalidateResolvedGeoreference();
-  this->DestroyTileset();
+  this->DestroyTileset(true);
 
   AActor::BeginDestroy();
 }
 
-bool ACesium3DTileset::IsReadyForFinishDestroy() {
-  bool ready = AActor::IsReadyForFinishDestroy();
-  ready &= this->_tilesetsBeingDestroyed == 0;
-
-  if (!ready) {
-    getAssetAccessor()->tick();
-    getAsyncSystem().dispatchMainThreadTasks();
-  }
-
-  return ready;
-}
-
 void ACesium3DTileset::Destroyed() {
-  this->DestroyTileset();
+  this->DestroyTileset(true);
 
   AActor::Destroyed();
 }
@@ -18,7 +18,7 @@ void UCesium3DTilesetRoot::HandleGeoreferenceUpdated() {
       Verbose,
       TEXT("Called HandleGeoreferenceUpdated for tileset root %s"),
       *this->GetName());
-  this->_updateTilesetToUnrealRelativeWorldTransform();
+  this->_updateTilesetToUnrealRelativeWorldTransform(true);
 }
 
 const glm::dmat4&
@@ -31,7 +31,7 @@ void UCesium3DTilesetRoot::BeginPlay() {
   Super::BeginPlay();
 
   this->_updateAbsoluteLocation();
-  this->_updateTilesetToUnrealRelativeWorldTransform();
+  this->_updateTilesetToUnrealRelativeWorldTransform(true);
 }
 
 bool UCesium3DTilesetRoot::MoveComponentImpl(
@@ -50,7 +50,13 @@ bool UCesium3DTilesetRoot::MoveComponentImpl(
       Teleport);
 
   this->_updateAbsoluteLocation();
-  this->_updateTilesetToUnrealRelativeWorldTransform();
+
+  // The tiles are attached to this component, so moving it has already moved
+  // them rigidly along with it. Their transforms relative to it only depend on
+  // the georeference, so they're left alone unless it has changed since they
+  // were last updated. This keeps the cost of animating a tileset independent
+  // of the number of tiles it has loaded.
+  this->_updateTilesetToUnrealRelativeWorldTransform(false);
 
   return result;
 }
@@ -60,12 +66,18 @@ void UCesium3DTilesetRoot::_updateAbsoluteLocation() {
   this->_absoluteLocation = VecMath::createVector3D(newLocation);
 }
 
-void UCesium3DTilesetRoot::_updateTilesetToUnrealRelativeWorldTransform() {
+void UCesium3DTilesetRoot::_updateTilesetToUnrealRelativeWorldTransform(
+    bool forceTileUpdate) {
   ACesium3DTileset* pTileset = this->GetOwner<ACesium3DTileset>();
 
-  this->_tilesetToUnrealRelativeWorld = VecMath::createMatrix4D(
+  const glm::dmat4 tilesetToUnrealRelativeWorld = VecMath::createMatrix4D(
       pTileset->ResolveGeoreference()
           ->ComputeEarthCenteredEarthFixedToUnrealTransformation());
+  if (!forceTileUpdate &&
+      tilesetToUnrealRelativeWorld == this->_tilesetToUnrealRelativeWorld) {
+    return;
+  }
 
+  this->_tilesetToUnrealRelativeWorld = tilesetToUnrealRelativeWorld;
   pTileset->UpdateTransformFromCesium();
 }
@@ -49,7 +49,11 @@ protected:
 
 private:
   void _updateAbsoluteLocation();
-  void _updateTilesetToUnrealRelativeWorldTransform();
+  /**
+   * Recomputes the transform from the georeference, and updates the
+   * transforms of the tiles if it changed or if forceTileUpdate is true.
+   */
+  void _updateTilesetToUnrealRelativeWorldTransform(bool forceTileUpdate);
 
   glm::dvec3 _absoluteLocation;
   glm::dmat4 _tilesetToUnrealRelativeWorld;
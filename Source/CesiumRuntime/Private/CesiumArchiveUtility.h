@@ -0,0 +1,27 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Serialization/Archive.h"
+
+namespace CesiumArchiveUtility {
+
+/**
+ * @brief Reads a buffer, such as a `std::string` or `std::vector<std::byte>`,
+ * that was written as its size in bytes followed by its content.
+ *
+ * @return false if the archive is in error or the size is invalid, in which
+ * case the contents of `value` are unspecified.
+ */
+template <typename TBuffer> bool readBuffer(FArchive& archive, TBuffer& value) {
+  int64 size = 0;
+  archive << size;
+  if (archive.IsError() || size < 0 || size > archive.TotalSize()) {
+    return false;
+  }
+  value.resize(size_t(size));
+  archive.Serialize(static_cast<void*>(value.data()), size);
+  return !archive.IsError();
+}
+
+} // namespace CesiumArchiveUtility
@@ -0,0 +1,38 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Vector.h"
+#include "Math/Vector2D.h"
+
+/**
+ * The triangles of a primitive that ACesium3DTileset::BakeRegionToStaticMeshes
+ * turns into a static mesh asset, relative to the primitive's component.
+ *
+ * The primitive's vertex and index buffers don't keep a copy in memory once
+ * they're uploaded, so these are gathered while the primitive is loaded, and
+ * only while the tileset is being baked.
+ */
+struct CesiumBakingGeometry {
+  TArray<FVector3f> positions;
+
+  /**
+   * The normal of each vertex, or empty if the primitive's vertices are
+   * pulled from a buffer in the shader, in which case they're computed when
+   * the static mesh is built.
+   */
+  TArray<FVector3f> normals;
+
+  /**
+   * The first texture coordinates of each vertex, or empty if the primitive
+   * doesn't have any.
+   */
+  TArray<FVector2f> texCoords;
+
+  /**
+   * The indices of the vertices of each triangle, in the same winding order
+   * as the primitive's index buffer.
+   */
+  TArray<uint32> indices;
+};
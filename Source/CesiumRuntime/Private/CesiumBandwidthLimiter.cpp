@@ -0,0 +1,401 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumBandwidthLimiter.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include <algorithm>
+#include <exception>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Bandwidth Deferred Requests"),
+    STAT_CesiumBandwidthDeferredRequests,
+    STATGROUP_Cesium);
+
+namespace {
+
+// How much of a stream's expected request size each response contributes.
+constexpr double RequestBytesSmoothing = 0.125;
+
+// The priority classes whose requests wait for bandwidth, in the order they
+// are handed it.
+constexpr ECesiumRequestPriority LimitedPriorities[] = {
+    ECesiumRequestPriority::High,
+    ECesiumRequestPriority::Normal,
+    ECesiumRequestPriority::Background};
+
+} // namespace
+
+const std::string CesiumBandwidthLimiter::streamHeader =
+    "X-Cesium-Unreal-Bandwidth-Stream";
+
+/*static*/ CesiumBandwidthLimiter& CesiumBandwidthLimiter::get() {
+  static CesiumBandwidthLimiter limiter;
+  return limiter;
+}
+
+/*static*/ std::optional<uint64_t> CesiumBandwidthLimiter::extractStream(
+    std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  auto it = std::find_if(
+      headers.begin(),
+      headers.end(),
+      [](const CesiumAsync::IAssetAccessor::THeader& header) {
+        return header.first == streamHeader;
+      });
+  if (it == headers.end()) {
+    return std::nullopt;
+  }
+
+  std::optional<uint64_t> result;
+  try {
+    result = std::stoull(it->second);
+  } catch (const std::exception&) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Ignoring invalid bandwidth stream: %s"),
+        UTF8_TO_TCHAR(it->second.c_str()));
+  }
+
+  headers.erase(it);
+  return result;
+}
+
+uint64_t CesiumBandwidthLimiter::createStream(
+    ECesiumRequestPriority priority,
+    double share) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  const uint64_t stream = this->_nextStream++;
+  this->_streams.emplace(
+      stream,
+      Stream{
+          priority,
+          std::max(share, 0.0),
+          0.0,
+          double(InitialRequestBytes),
+          {}});
+  return stream;
+}
+
+void CesiumBandwidthLimiter::releaseStream(uint64_t stream) {
+  std::deque<StartFunction> waiting;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_streams.find(stream);
+    if (it == this->_streams.end()) {
+      return;
+    }
+    waiting = std::move(it->second.waiting);
+    this->_waitingRequestCount -= int32_t(waiting.size());
+    this->_streams.erase(it);
+  }
+
+  for (StartFunction& start : waiting) {
+    start(0);
+  }
+}
+
+void CesiumBandwidthLimiter::setOverlayStream(
+    const void* pOverlay,
+    uint64_t stream) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (stream == 0) {
+    this->_overlayStreams.erase(pOverlay);
+  } else {
+    this->_overlayStreams[pOverlay] = stream;
+  }
+}
+
+uint64_t CesiumBandwidthLimiter::findOverlayStream(const void* pOverlay) const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->_overlayStreams.find(pOverlay);
+  return it == this->_overlayStreams.end() ? 0 : it->second;
+}
+
+void CesiumBandwidthLimiter::schedule(uint64_t stream, StartFunction&& start) {
+  int64_t chargedBytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_streams.find(stream);
+    if (it != this->_streams.end() && this->_bytesPerSecond > 0.0) {
+      Stream& s = it->second;
+      chargedBytes = int64_t(s.expectedRequestBytes);
+      if (s.priority == ECesiumRequestPriority::Critical) {
+        this->_criticalBytes += double(chargedBytes);
+      } else if (s.waiting.empty() && s.tokens > 0.0) {
+        s.tokens -= double(chargedBytes);
+      } else {
+        // Requests that have to wait are charged once they're started, by
+        // which time the expected size may have changed.
+        s.waiting.emplace_back(std::move(start));
+        ++this->_waitingRequestCount;
+        ++this->_deferredRequestCount;
+        INC_DWORD_STAT(STAT_CesiumBandwidthDeferredRequests);
+        return;
+      }
+    }
+  }
+
+  start(chargedBytes);
+}
+
+void CesiumBandwidthLimiter::complete(
+    uint64_t stream,
+    int64_t chargedBytes,
+    int64_t receivedBytes) {
+  std::vector<std::pair<StartFunction, int64_t>> started;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_streams.find(stream);
+    if (it == this->_streams.end()) {
+      return;
+    }
+
+    Stream& s = it->second;
+    if (receivedBytes > 0) {
+      s.expectedRequestBytes +=
+          RequestBytesSmoothing * (double(receivedBytes) - s.expectedRequestBytes);
+    }
+
+    // Requests that were started while there was no limit weren't charged,
+    // so there's nothing to correct.
+    if (chargedBytes > 0) {
+      const double correction = double(chargedBytes - receivedBytes);
+      if (s.priority == ECesiumRequestPriority::Critical) {
+        this->_criticalBytes -= correction;
+      } else {
+        s.tokens += correction;
+      }
+    }
+
+    this->dispatch(started);
+  }
+
+  for (auto& [start, charged] : started) {
+    start(charged);
+  }
+}
+
+void CesiumBandwidthLimiter::update(float deltaTime, double bytesPerSecond) {
+  std::vector<std::pair<StartFunction, int64_t>> started;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_bytesPerSecond = bytesPerSecond;
+
+    if (bytesPerSecond <= 0.0) {
+      // Without a limit, nothing waits.
+      for (auto& [stream, s] : this->_streams) {
+        for (StartFunction& start : s.waiting) {
+          started.emplace_back(std::move(start), 0);
+        }
+        s.waiting.clear();
+        s.tokens = 0.0;
+      }
+      this->_waitingRequestCount = 0;
+      this->_criticalBytes = 0.0;
+    } else {
+      double available =
+          bytesPerSecond * double(deltaTime) - this->_criticalBytes;
+      this->_criticalBytes = std::max(-available, 0.0);
+
+      // Each class is only given what the classes before it couldn't use.
+      for (ECesiumRequestPriority priority : LimitedPriorities) {
+        if (available <= 0.0) {
+          break;
+        }
+
+        double totalShare = 0.0;
+        for (const auto& [stream, s] : this->_streams) {
+          if (s.priority == priority && !s.waiting.empty()) {
+            totalShare += s.share;
+          }
+        }
+        if (totalShare <= 0.0) {
+          continue;
+        }
+
+        double given = 0.0;
+        for (auto& [stream, s] : this->_streams) {
+          if (s.priority != priority || s.waiting.empty()) {
+            continue;
+          }
+          // A stream can always save up enough for one request, so that
+          // requests larger than the burst are still sent eventually.
+          const double capacity =
+              std::max(bytesPerSecond * BurstSeconds, s.expectedRequestBytes) -
+              s.tokens;
+          const double amount =
+              std::clamp(available * s.share / totalShare, 0.0, capacity);
+          s.tokens += amount;
+          given += amount;
+        }
+        available -= given;
+      }
+
+      this->dispatch(started);
+    }
+  }
+
+  for (auto& [start, charged] : started) {
+    start(charged);
+  }
+}
+
+void CesiumBandwidthLimiter::dispatch(
+    std::vector<std::pair<StartFunction, int64_t>>& started) {
+  for (ECesiumRequestPriority priority : LimitedPriorities) {
+    for (auto& [stream, s] : this->_streams) {
+      if (s.priority != priority) {
+        continue;
+      }
+      while (!s.waiting.empty() && s.tokens > 0.0) {
+        const int64_t chargedBytes = int64_t(s.expectedRequestBytes);
+        s.tokens -= double(chargedBytes);
+        started.emplace_back(std::move(s.waiting.front()), chargedBytes);
+        s.waiting.pop_front();
+        --this->_waitingRequestCount;
+      }
+    }
+  }
+}
+
+int32_t CesiumBandwidthLimiter::getWaitingRequestCount() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_waitingRequestCount;
+}
+
+int64_t CesiumBandwidthLimiter::getDeferredRequestCount() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_deferredRequestCount;
+}
+
+void CesiumBandwidthLimiter::Tick(float DeltaTime) {
+  this->update(
+      DeltaTime,
+      double(GetDefault<UCesiumRuntimeSettings>()->MaximumBandwidth) *
+          1000000.0 / 8.0);
+}
+
+ETickableTickType CesiumBandwidthLimiter::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool CesiumBandwidthLimiter::IsTickableWhenPaused() const { return true; }
+
+bool CesiumBandwidthLimiter::IsTickableInEditor() const { return true; }
+
+TStatId CesiumBandwidthLimiter::GetStatId() const { return TStatId(); }
+
+CesiumBandwidthStreamAssetAccessor::CesiumBandwidthStreamAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    uint64_t stream)
+    : _pAssetAccessor(pAssetAccessor),
+      _streamHeaderValue(std::to_string(stream)) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumBandwidthStreamAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  // The requests of an overlay are made through the accessor of the tileset
+  // it's attached to, and stay in the overlay's stream.
+  const bool inStream = std::any_of(
+      headers.begin(),
+      headers.end(),
+      [](const CesiumAsync::IAssetAccessor::THeader& header) {
+        return header.first == CesiumBandwidthLimiter::streamHeader;
+      });
+  if (inStream) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  std::vector<CesiumAsync::IAssetAccessor::THeader> streamHeaders;
+  streamHeaders.reserve(headers.size() + 1);
+  streamHeaders.insert(streamHeaders.end(), headers.begin(), headers.end());
+  streamHeaders.emplace_back(
+      CesiumBandwidthLimiter::streamHeader,
+      this->_streamHeaderValue);
+  return this->_pAssetAccessor->get(asyncSystem, url, streamHeaders);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumBandwidthStreamAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumBandwidthStreamAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+CesiumBandwidthAssetAccessor::CesiumBandwidthAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    CesiumBandwidthLimiter& limiter)
+    : _pAssetAccessor(pAssetAccessor), _pLimiter(&limiter) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumBandwidthAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders = headers;
+  std::optional<uint64_t> maybeStream =
+      CesiumBandwidthLimiter::extractStream(requestHeaders);
+  if (!maybeStream) {
+    return this->_pAssetAccessor->get(asyncSystem, url, requestHeaders);
+  }
+
+  const uint64_t stream = *maybeStream;
+  CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+  CesiumBandwidthLimiter* pLimiter = this->_pLimiter;
+  pLimiter->schedule(
+      stream,
+      [pAssetAccessor = this->_pAssetAccessor,
+       pLimiter,
+       stream,
+       asyncSystem,
+       url,
+       requestHeaders = std::move(requestHeaders),
+       promise](int64_t chargedBytes) {
+        pAssetAccessor->get(asyncSystem, url, requestHeaders)
+            .thenImmediately(
+                [pLimiter, stream, chargedBytes, promise](
+                    std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+                  const CesiumAsync::IAssetResponse* pResponse =
+                      pRequest ? pRequest->response() : nullptr;
+                  pLimiter->complete(
+                      stream,
+                      chargedBytes,
+                      pResponse ? int64_t(pResponse->data().size()) : 0);
+                  promise.resolve(std::move(pRequest));
+                })
+            .catchImmediately([pLimiter, stream, chargedBytes, promise](
+                                  std::exception&& e) {
+              pLimiter->complete(stream, chargedBytes, 0);
+              promise.reject(std::move(e));
+            });
+      });
+  return promise.getFuture();
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumBandwidthAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumBandwidthAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
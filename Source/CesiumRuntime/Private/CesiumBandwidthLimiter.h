@@ -0,0 +1,250 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumRequestPriority.h"
+#include "Tickable.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Shares the bandwidth given by "Maximum Bandwidth" in the Cesium project
+ * settings between the tilesets and raster overlays that request tiles, so
+ * that a large tileset can't starve a small overlay that matters more.
+ *
+ * Each tileset and overlay makes its requests in a "stream", which has a
+ * priority class and a share. A request is assigned to a stream by a
+ * pseudo-header, named by {@link streamHeader}, which is added by a
+ * {@link CesiumBandwidthStreamAssetAccessor} and removed again by the
+ * {@link CesiumBandwidthAssetAccessor} that sits in front of the network.
+ * Requests that are answered from the cache never reach it, so they don't use
+ * any bandwidth.
+ *
+ * Each stream has a token bucket of bytes. Every frame, the bytes the link
+ * can carry in that frame are handed out to the streams that have requests
+ * waiting: first to those of High priority, then Normal, then Background,
+ * split by share among the streams of each class. A request is sent once its
+ * stream has bytes left, and the bytes its response is expected to take,
+ * based on the stream's recent responses, are taken from the bucket. Once
+ * the response has arrived, the bucket is corrected by the difference with
+ * its actual size. Critical requests are always sent at once, and the bytes
+ * they use are taken from what's handed out next.
+ *
+ * Since requests can't be slowed down once they've been sent, this limits
+ * how fast requests are started rather than how fast their responses are
+ * received, which evens out over a few requests.
+ *
+ * All functions may be called from any thread, except for update, which must
+ * be called from the game thread.
+ */
+class CesiumBandwidthLimiter : FTickableGameObject {
+public:
+  /**
+   * The name of the pseudo-header that assigns a request to a stream. It is
+   * never sent to the server.
+   */
+  static const std::string streamHeader;
+
+  /**
+   * The number of bytes a stream's first requests are expected to take.
+   */
+  static constexpr int64_t InitialRequestBytes = 64 * 1024;
+
+  /**
+   * The longest time, in seconds, for which a stream may save up bytes that
+   * it doesn't use.
+   */
+  static constexpr double BurstSeconds = 0.5;
+
+  /**
+   * Starts a request that was waiting for bandwidth. It is passed the number
+   * of bytes that were taken for it, which must be given back to
+   * {@link complete} once the request is done.
+   */
+  using StartFunction = std::function<void(int64_t)>;
+
+  /**
+   * Gets the limiter shared by all tilesets and overlays.
+   */
+  static CesiumBandwidthLimiter& get();
+
+  /**
+   * Removes the stream pseudo-header from the given request headers, if
+   * present.
+   *
+   * @return The stream the request belongs to, or std::nullopt if it doesn't
+   * belong to one.
+   */
+  static std::optional<uint64_t>
+  extractStream(std::vector<CesiumAsync::IAssetAccessor::THeader>& headers);
+
+  /**
+   * Creates a new stream.
+   *
+   * @param priority The priority class of the stream's requests.
+   * @param share The stream's share of the bandwidth of its priority class,
+   * relative to the shares of the other streams in the class.
+   */
+  uint64_t createStream(ECesiumRequestPriority priority, double share);
+
+  /**
+   * Removes a stream that no more requests will be made in. Any of its
+   * requests that are still waiting are started at once.
+   */
+  void releaseStream(uint64_t stream);
+
+  /**
+   * Assigns the requests of a cesium-native raster overlay to a stream, for a
+   * CesiumCoalescingRasterOverlay to find when it creates its tile provider.
+   * Passing 0 for the stream stops assigning them to one.
+   */
+  void setOverlayStream(const void* pOverlay, uint64_t stream);
+
+  /**
+   * Gets the stream that the requests of a cesium-native raster overlay are
+   * made in, or 0 if they aren't assigned to one.
+   */
+  uint64_t findOverlayStream(const void* pOverlay) const;
+
+  /**
+   * Starts a request in a stream as soon as the stream has bandwidth for it,
+   * which may be right away, on this thread, or in a later update. A stream
+   * that doesn't exist, or a limiter without a bandwidth limit, starts it
+   * right away.
+   */
+  void schedule(uint64_t stream, StartFunction&& start);
+
+  /**
+   * Records that a request started by {@link schedule} is done.
+   *
+   * @param stream The stream the request was made in.
+   * @param chargedBytes The bytes that were taken for it.
+   * @param receivedBytes The size of its response, or 0 if it failed.
+   */
+  void
+  complete(uint64_t stream, int64_t chargedBytes, int64_t receivedBytes);
+
+  /**
+   * Hands out the bytes the link can carry over the given time, and starts
+   * the waiting requests that they allow.
+   *
+   * @param deltaTime The time since the last update, in seconds.
+   * @param bytesPerSecond The bandwidth of the link, or 0 if it isn't limited.
+   */
+  void update(float deltaTime, double bytesPerSecond);
+
+  /**
+   * Gets the number of requests that are waiting for bandwidth.
+   */
+  int32_t getWaitingRequestCount() const;
+
+  /**
+   * Gets the total number of requests that have had to wait for bandwidth.
+   */
+  int64_t getDeferredRequestCount() const;
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const override;
+
+private:
+  struct Stream {
+    ECesiumRequestPriority priority;
+    double share;
+    // The bytes the stream may still use, which are negative once it has
+    // used more than it was given.
+    double tokens;
+    // The bytes each of the stream's requests is expected to take.
+    double expectedRequestBytes;
+    std::deque<StartFunction> waiting;
+  };
+
+  // Takes bytes from each stream that has requests waiting and bytes to spare
+  // for as many of those requests as it can, and returns them to be started
+  // once the lock is released.
+  void dispatch(std::vector<std::pair<StartFunction, int64_t>>& started);
+
+  mutable std::mutex _mutex;
+  double _bytesPerSecond = 0.0;
+  // The bytes used by Critical requests that haven't yet been taken from the
+  // other streams.
+  double _criticalBytes = 0.0;
+  uint64_t _nextStream = 1;
+  std::unordered_map<uint64_t, Stream> _streams;
+  std::unordered_map<const void*, uint64_t> _overlayStreams;
+  int32_t _waitingRequestCount = 0;
+  int64_t _deferredRequestCount = 0;
+};
+
+/**
+ * An asset accessor that makes every GET request it's given in a stream of
+ * the CesiumBandwidthLimiter, unless it is already in one.
+ */
+class CesiumBandwidthStreamAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  CesiumBandwidthStreamAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      uint64_t stream);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::string _streamHeaderValue;
+};
+
+/**
+ * An asset accessor that holds back the requests of each stream until the
+ * CesiumBandwidthLimiter has bandwidth for them, and removes the stream
+ * pseudo-header before passing them on to the accessor that performs them.
+ */
+class CesiumBandwidthAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  CesiumBandwidthAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      CesiumBandwidthLimiter& limiter = CesiumBandwidthLimiter::get());
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  CesiumBandwidthLimiter* _pLimiter;
+};
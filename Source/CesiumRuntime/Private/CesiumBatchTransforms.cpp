@@ -0,0 +1,398 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumBatchTransforms.h"
+#include "Async/ParallelFor.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumRuntime.h"
+#include "CesiumUtility/Math.h"
+#include "Math/VectorRegister.h"
+#include <cmath>
+#include <glm/mat4x4.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <optional>
+
+using namespace CesiumGeospatial;
+
+namespace {
+
+constexpr int32 Lanes = 4;
+
+// Batches up to this size are transformed on the calling thread. Larger ones
+// are split into chunks of this size and transformed on worker threads.
+constexpr int32 PositionsPerChunk = 16384;
+
+VectorRegister4Double splat(double value) {
+  return MakeVectorRegisterDouble(value, value, value, value);
+}
+
+/**
+ * The x, y, and z components of four positions, one position per lane.
+ */
+struct LanePositions {
+  VectorRegister4Double x;
+  VectorRegister4Double y;
+  VectorRegister4Double z;
+};
+
+/**
+ * The upper three rows of an affine matrix, with each element broadcast to
+ * all lanes.
+ */
+struct LaneMatrix {
+  explicit LaneMatrix(const glm::dmat4& matrix) {
+    for (int32 column = 0; column < 4; ++column) {
+      for (int32 row = 0; row < 3; ++row) {
+        this->elements[column][row] = splat(matrix[column][row]);
+      }
+    }
+  }
+
+  LanePositions transform(const LanePositions& positions) const {
+    return LanePositions{
+        this->transformRow(0, positions),
+        this->transformRow(1, positions),
+        this->transformRow(2, positions)};
+  }
+
+  VectorRegister4Double elements[4][3];
+
+private:
+  VectorRegister4Double
+  transformRow(int32 row, const LanePositions& positions) const {
+    return VectorMultiplyAdd(
+        this->elements[0][row],
+        positions.x,
+        VectorMultiplyAdd(
+            this->elements[1][row],
+            positions.y,
+            VectorMultiplyAdd(
+                this->elements[2][row],
+                positions.z,
+                this->elements[3][row])));
+  }
+};
+
+LanePositions loadLanes(const glm::dvec3* pPositions) {
+  return LanePositions{
+      MakeVectorRegisterDouble(
+          pPositions[0].x,
+          pPositions[1].x,
+          pPositions[2].x,
+          pPositions[3].x),
+      MakeVectorRegisterDouble(
+          pPositions[0].y,
+          pPositions[1].y,
+          pPositions[2].y,
+          pPositions[3].y),
+      MakeVectorRegisterDouble(
+          pPositions[0].z,
+          pPositions[1].z,
+          pPositions[2].z,
+          pPositions[3].z)};
+}
+
+void storeLanes(const LanePositions& positions, glm::dvec3* pPositions) {
+  alignas(32) double x[Lanes];
+  alignas(32) double y[Lanes];
+  alignas(32) double z[Lanes];
+  VectorStoreAligned(positions.x, x);
+  VectorStoreAligned(positions.y, y);
+  VectorStoreAligned(positions.z, z);
+  for (int32 lane = 0; lane < Lanes; ++lane) {
+    pPositions[lane] = glm::dvec3(x[lane], y[lane], z[lane]);
+  }
+}
+
+glm::dvec3 transformPosition(const glm::dmat4& transform, const glm::dvec3& p) {
+  return glm::dvec3(transform * glm::dvec4(p, 1.0));
+}
+
+/**
+ * The same computation as `Ellipsoid::cartographicToCartesian`, for one
+ * position given in degrees.
+ */
+glm::dvec3 longitudeLatitudeHeightToEcef(
+    const glm::dvec3& radiiSquared,
+    const glm::dvec3& longitudeLatitudeHeight) {
+  const double longitude =
+      CesiumUtility::Math::degreesToRadians(longitudeLatitudeHeight.x);
+  const double latitude =
+      CesiumUtility::Math::degreesToRadians(longitudeLatitudeHeight.y);
+  const double cosLatitude = std::cos(latitude);
+  const glm::dvec3 normal(
+      cosLatitude * std::cos(longitude),
+      cosLatitude * std::sin(longitude),
+      std::sin(latitude));
+  const glm::dvec3 k = radiiSquared * normal;
+  const double gamma = std::sqrt(glm::dot(normal, k));
+  return k / gamma + normal * longitudeLatitudeHeight.z;
+}
+
+/**
+ * Converts four positions given in degrees to ECEF, one position per lane.
+ * The sines and cosines are computed per position, and everything after that
+ * is done across all four lanes at once.
+ */
+LanePositions longitudeLatitudeHeightToEcefLanes(
+    const LanePositions& radiiSquared,
+    const glm::dvec3* pLongitudeLatitudeHeight) {
+  alignas(32) double cosLongitude[Lanes];
+  alignas(32) double sinLongitude[Lanes];
+  alignas(32) double cosLatitude[Lanes];
+  alignas(32) double sinLatitude[Lanes];
+  alignas(32) double height[Lanes];
+  for (int32 lane = 0; lane < Lanes; ++lane) {
+    const glm::dvec3& llh = pLongitudeLatitudeHeight[lane];
+    const double longitude = CesiumUtility::Math::degreesToRadians(llh.x);
+    const double latitude = CesiumUtility::Math::degreesToRadians(llh.y);
+    cosLongitude[lane] = std::cos(longitude);
+    sinLongitude[lane] = std::sin(longitude);
+    cosLatitude[lane] = std::cos(latitude);
+    sinLatitude[lane] = std::sin(latitude);
+    height[lane] = llh.z;
+  }
+
+  const VectorRegister4Double cosLat = VectorLoadAligned(cosLatitude);
+  const VectorRegister4Double h = VectorLoadAligned(height);
+
+  const VectorRegister4Double nx =
+      VectorMultiply(cosLat, VectorLoadAligned(cosLongitude));
+  const VectorRegister4Double ny =
+      VectorMultiply(cosLat, VectorLoadAligned(sinLongitude));
+  const VectorRegister4Double nz = VectorLoadAligned(sinLatitude);
+
+  const VectorRegister4Double kx = VectorMultiply(radiiSquared.x, nx);
+  const VectorRegister4Double ky = VectorMultiply(radiiSquared.y, ny);
+  const VectorRegister4Double kz = VectorMultiply(radiiSquared.z, nz);
+
+  const VectorRegister4Double gamma = VectorSqrt(VectorMultiplyAdd(
+      nx,
+      kx,
+      VectorMultiplyAdd(ny, ky, VectorMultiply(nz, kz))));
+
+  return LanePositions{
+      VectorMultiplyAdd(nx, h, VectorDivide(kx, gamma)),
+      VectorMultiplyAdd(ny, h, VectorDivide(ky, gamma)),
+      VectorMultiplyAdd(nz, h, VectorDivide(kz, gamma))};
+}
+
+glm::dvec3 ecefToLongitudeLatitudeHeight(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& ecef) {
+  std::optional<Cartographic> llh = ellipsoid.cartesianToCartographic(ecef);
+  if (!llh) {
+    return glm::dvec3(0.0, 0.0, 0.0);
+  }
+  return glm::dvec3(
+      glm::degrees(llh->longitude),
+      glm::degrees(llh->latitude),
+      llh->height);
+}
+
+glm::dvec3 scalePositionToGeodeticSurface(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& ecef) {
+  std::optional<glm::dvec3> surface = ellipsoid.scaleToGeodeticSurface(ecef);
+  return surface ? *surface : glm::dvec3(0.0, 0.0, 0.0);
+}
+
+/**
+ * The same computation as `Ellipsoid::geodeticSurfaceNormal`, for four
+ * positions, one position per lane.
+ */
+LanePositions geodeticSurfaceNormalLanes(
+    const LanePositions& oneOverRadiiSquared,
+    const LanePositions& positions) {
+  const VectorRegister4Double x =
+      VectorMultiply(positions.x, oneOverRadiiSquared.x);
+  const VectorRegister4Double y =
+      VectorMultiply(positions.y, oneOverRadiiSquared.y);
+  const VectorRegister4Double z =
+      VectorMultiply(positions.z, oneOverRadiiSquared.z);
+  const VectorRegister4Double length = VectorSqrt(VectorMultiplyAdd(
+      x,
+      x,
+      VectorMultiplyAdd(y, y, VectorMultiply(z, z))));
+  return LanePositions{
+      VectorDivide(x, length),
+      VectorDivide(y, length),
+      VectorDivide(z, length)};
+}
+
+/**
+ * Calls `transformRange(begin, end)` to cover `[0, count)`, on worker threads
+ * if the batch is large enough to be worth it.
+ */
+template <typename TransformRange>
+void forEachChunk(int32 count, const TransformRange& transformRange) {
+  if (count <= PositionsPerChunk) {
+    transformRange(0, count);
+    return;
+  }
+
+  const int32 chunks = (count + PositionsPerChunk - 1) / PositionsPerChunk;
+  ParallelFor(chunks, [count, &transformRange](int32 chunk) {
+    const int32 begin = chunk * PositionsPerChunk;
+    transformRange(begin, FMath::Min(begin + PositionsPerChunk, count));
+  });
+}
+
+} // namespace
+
+namespace CesiumBatchTransforms {
+
+void transformPositions(
+    const glm::dmat4& transform,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output) {
+  check(input.Num() == output.Num());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BatchTransformPositions)
+
+  const LaneMatrix laneTransform(transform);
+  const glm::dvec3* pInput = input.GetData();
+  glm::dvec3* pOutput = output.GetData();
+
+  forEachChunk(input.Num(), [&](int32 begin, int32 end) {
+    int32 i = begin;
+    for (; i + Lanes <= end; i += Lanes) {
+      storeLanes(laneTransform.transform(loadLanes(pInput + i)), pOutput + i);
+    }
+    for (; i < end; ++i) {
+      pOutput[i] = transformPosition(transform, pInput[i]);
+    }
+  });
+}
+
+void transformLongitudeLatitudeHeightPositions(
+    const Ellipsoid& ellipsoid,
+    const glm::dmat4& ecefToOutput,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output) {
+  check(input.Num() == output.Num());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(
+      Cesium::BatchTransformLongitudeLatitudeHeightPositions)
+
+  const glm::dvec3 radiiSquared = ellipsoid.getRadii() * ellipsoid.getRadii();
+  const LanePositions laneRadiiSquared{
+      splat(radiiSquared.x),
+      splat(radiiSquared.y),
+      splat(radiiSquared.z)};
+  const LaneMatrix laneTransform(ecefToOutput);
+  const glm::dvec3* pInput = input.GetData();
+  glm::dvec3* pOutput = output.GetData();
+
+  forEachChunk(input.Num(), [&](int32 begin, int32 end) {
+    int32 i = begin;
+    for (; i + Lanes <= end; i += Lanes) {
+      storeLanes(
+          laneTransform.transform(
+              longitudeLatitudeHeightToEcefLanes(laneRadiiSquared, pInput + i)),
+          pOutput + i);
+    }
+    for (; i < end; ++i) {
+      pOutput[i] = transformPosition(
+          ecefToOutput,
+          longitudeLatitudeHeightToEcef(radiiSquared, pInput[i]));
+    }
+  });
+}
+
+void transformPositionsToLongitudeLatitudeHeight(
+    const Ellipsoid& ellipsoid,
+    const glm::dmat4& inputToEcef,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output) {
+  check(input.Num() == output.Num());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(
+      Cesium::BatchTransformPositionsToLongitudeLatitudeHeight)
+
+  const LaneMatrix laneTransform(inputToEcef);
+  const glm::dvec3* pInput = input.GetData();
+  glm::dvec3* pOutput = output.GetData();
+
+  // The iterative projection onto the ellipsoid stays per position; only the
+  // matrix multiply is done across lanes.
+  forEachChunk(input.Num(), [&](int32 begin, int32 end) {
+    int32 i = begin;
+    for (; i + Lanes <= end; i += Lanes) {
+      storeLanes(laneTransform.transform(loadLanes(pInput + i)), pOutput + i);
+      for (int32 lane = 0; lane < Lanes; ++lane) {
+        pOutput[i + lane] =
+            ecefToLongitudeLatitudeHeight(ellipsoid, pOutput[i + lane]);
+      }
+    }
+    for (; i < end; ++i) {
+      pOutput[i] = ecefToLongitudeLatitudeHeight(
+          ellipsoid,
+          transformPosition(inputToEcef, pInput[i]));
+    }
+  });
+}
+
+void transformDirections(
+    const glm::dmat4& transform,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output) {
+  glm::dmat4 linear = transform;
+  linear[3] = glm::dvec4(0.0, 0.0, 0.0, 1.0);
+  transformPositions(linear, input, output);
+}
+
+void scaleToGeodeticSurface(
+    const Ellipsoid& ellipsoid,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output) {
+  check(input.Num() == output.Num());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BatchScaleToGeodeticSurface)
+
+  const glm::dvec3* pInput = input.GetData();
+  glm::dvec3* pOutput = output.GetData();
+
+  // Like the projection to cartographic coordinates, the iterative projection
+  // onto the surface stays per position.
+  forEachChunk(input.Num(), [&](int32 begin, int32 end) {
+    for (int32 i = begin; i < end; ++i) {
+      pOutput[i] = scalePositionToGeodeticSurface(ellipsoid, pInput[i]);
+    }
+  });
+}
+
+void computeGeodeticSurfaceNormals(
+    const Ellipsoid& ellipsoid,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output) {
+  check(input.Num() == output.Num());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BatchComputeGeodeticSurfaceNormals)
+
+  const glm::dvec3 oneOverRadiiSquared =
+      1.0 / (ellipsoid.getRadii() * ellipsoid.getRadii());
+  const LanePositions laneOneOverRadiiSquared{
+      splat(oneOverRadiiSquared.x),
+      splat(oneOverRadiiSquared.y),
+      splat(oneOverRadiiSquared.z)};
+  const glm::dvec3* pInput = input.GetData();
+  glm::dvec3* pOutput = output.GetData();
+
+  forEachChunk(input.Num(), [&](int32 begin, int32 end) {
+    int32 i = begin;
+    for (; i + Lanes <= end; i += Lanes) {
+      storeLanes(
+          geodeticSurfaceNormalLanes(
+              laneOneOverRadiiSquared,
+              loadLanes(pInput + i)),
+          pOutput + i);
+    }
+    for (; i < end; ++i) {
+      pOutput[i] = ellipsoid.geodeticSurfaceNormal(pInput[i]);
+    }
+  });
+}
+
+} // namespace CesiumBatchTransforms
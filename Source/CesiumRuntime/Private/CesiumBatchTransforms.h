@@ -0,0 +1,102 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Vector.h"
+#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+} // namespace CesiumGeospatial
+
+/**
+ * @brief Transforms many positions at once, for callers that convert whole
+ * point sets, splines, or feature geometry rather than one position at a time.
+ *
+ * Positions are processed four at a time, one position per SIMD lane, with a
+ * scalar loop for the remainder. Large batches are also split across worker
+ * threads. In every function, `output` must have the same number of elements
+ * as `input`, and may be the same array to transform in place.
+ */
+namespace CesiumBatchTransforms {
+
+/**
+ * @brief Transforms positions by the given affine matrix.
+ */
+void transformPositions(
+    const glm::dmat4& transform,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output);
+
+/**
+ * @brief Converts longitude in degrees (x), latitude in degrees (y), and
+ * height in meters (z) to Earth-Centered, Earth-Fixed positions on the given
+ * ellipsoid, and then transforms those by the given affine matrix. Pass an
+ * identity matrix to get ECEF positions.
+ */
+void transformLongitudeLatitudeHeightPositions(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    const glm::dmat4& ecefToOutput,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output);
+
+/**
+ * @brief Transforms positions by the given affine matrix into Earth-Centered,
+ * Earth-Fixed coordinates, and then converts those to longitude in degrees
+ * (x), latitude in degrees (y), and height in meters (z). Pass an identity
+ * matrix if the input is already ECEF. Positions that have no cartographic
+ * equivalent, near the center of the ellipsoid, become (0, 0, 0).
+ */
+void transformPositionsToLongitudeLatitudeHeight(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    const glm::dmat4& inputToEcef,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output);
+
+/**
+ * @brief Transforms direction vectors by the upper-left 3x3 part of the given
+ * affine matrix, ignoring its translation.
+ */
+void transformDirections(
+    const glm::dmat4& transform,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output);
+
+/**
+ * @brief Scales Earth-Centered, Earth-Fixed positions along the geodetic
+ * surface normal so that they are on the surface of the given ellipsoid.
+ * Positions near the center of the ellipsoid, whose surface positions are
+ * undefined, become (0, 0, 0).
+ */
+void scaleToGeodeticSurface(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output);
+
+/**
+ * @brief Computes the normals of the planes tangent to the surface of the
+ * given ellipsoid at Earth-Centered, Earth-Fixed positions.
+ */
+void computeGeodeticSurfaceNormals(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    TArrayView<const glm::dvec3> input,
+    TArrayView<glm::dvec3> output);
+
+static_assert(
+    sizeof(FVector) == sizeof(glm::dvec3),
+    "FVector arrays are transformed in place as glm::dvec3 arrays");
+
+/**
+ * @brief Views an array of `FVector` as an array of `glm::dvec3`, so that
+ * Blueprint arrays can be transformed in place.
+ */
+inline TArrayView<glm::dvec3> asDVec3s(TArray<FVector>& vectors) {
+  return TArrayView<glm::dvec3>(
+      reinterpret_cast<glm::dvec3*>(vectors.GetData()),
+      vectors.Num());
+}
+
+} // namespace CesiumBatchTransforms
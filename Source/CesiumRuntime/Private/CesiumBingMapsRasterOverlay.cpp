@@ -2,6 +2,7 @@
 
 #include "CesiumBingMapsRasterOverlay.h"
 #include "Cesium3DTilesSelection/Tileset.h"
+#include "CesiumCoalescingAssetAccessor.h"
 #include "CesiumRasterOverlays/BingMapsRasterOverlay.h"
 
 std::unique_ptr<CesiumRasterOverlays::RasterOverlay>
@@ -37,7 +38,8 @@ UCesiumBingMapsRasterOverlay::CreateOverlay(
     break;
   }
 
-  return std::make_unique<CesiumRasterOverlays::BingMapsRasterOverlay>(
+  return std::make_unique<CesiumCoalescingRasterOverlay<
+      CesiumRasterOverlays::BingMapsRasterOverlay>>(
       TCHAR_TO_UTF8(*this->MaterialLayerKey),
       "https://dev.virtualearth.net",
       TCHAR_TO_UTF8(*this->BingMapsKey),
@@ -16,7 +16,11 @@ UCesiumBoundingVolumePoolComponent::UCesiumBoundingVolumePoolComponent()
   SetMobility(EComponentMobility::Movable);
 }
 
-void UCesiumBoundingVolumePoolComponent::initPool(int32 maxPoolSize) {
+void UCesiumBoundingVolumePoolComponent::initPool(
+    int32 maxPoolSize,
+    const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
+        pViewExtension) {
+  this->_pViewExtension = pViewExtension;
   this->_pPool = std::make_shared<CesiumBoundingVolumePool>(this, maxPoolSize);
 }
 
@@ -30,6 +34,14 @@ TileOcclusionRendererProxy* UCesiumBoundingVolumePoolComponent::createProxy() {
   pBoundingVolume->SetFlags(
       RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
   pBoundingVolume->SetupAttachment(this);
+
+  // The slot must be assigned before the scene proxy is created.
+  if (this->_pViewExtension) {
+    pBoundingVolume->_pViewExtension = this->_pViewExtension;
+    pBoundingVolume->_occlusionSlot =
+        this->_pViewExtension->AllocateOcclusionSlot();
+  }
+
   pBoundingVolume->RegisterComponent();
 
   pBoundingVolume->UpdateTransformFromCesium(this->_cesiumToUnreal);
@@ -79,7 +91,26 @@ void UCesiumBoundingVolumePoolComponent::UpdateTransformFromCesium(
 class FCesiumBoundingVolumeSceneProxy : public FPrimitiveSceneProxy {
 public:
   FCesiumBoundingVolumeSceneProxy(UCesiumBoundingVolumeComponent* pComponent)
-      : FPrimitiveSceneProxy(pComponent /*, name?*/) {}
+      : FPrimitiveSceneProxy(pComponent /*, name?*/),
+        _pViewExtension(pComponent->_pViewExtension),
+        _occlusionSlot(pComponent->_occlusionSlot) {}
+
+  void CreateRenderThreadResources() override {
+    if (this->_pViewExtension) {
+      this->_pViewExtension->SetOcclusionSlotProxy_RenderThread(
+          this->_occlusionSlot,
+          this);
+    }
+  }
+
+  void DestroyRenderThreadResources() override {
+    if (this->_pViewExtension) {
+      this->_pViewExtension->ClearOcclusionSlotProxy_RenderThread(
+          this->_occlusionSlot,
+          this);
+    }
+  }
+
   SIZE_T GetTypeHash() const override {
     static size_t UniquePointer;
     return reinterpret_cast<size_t>(&UniquePointer);
@@ -88,12 +119,26 @@ public:
   uint32 GetMemoryFootprint(void) const override {
     return sizeof(FCesiumBoundingVolumeSceneProxy) + GetAllocatedSize();
   }
+
+private:
+  TSharedPtr<CesiumViewExtension, ESPMode::ThreadSafe> _pViewExtension;
+  int32 _occlusionSlot;
 };
 
 FPrimitiveSceneProxy* UCesiumBoundingVolumeComponent::CreateSceneProxy() {
   return new FCesiumBoundingVolumeSceneProxy(this);
 }
 
+void UCesiumBoundingVolumeComponent::BeginDestroy() {
+  if (this->_pViewExtension) {
+    this->_pViewExtension->ReleaseOcclusionSlot(this->_occlusionSlot);
+    this->_pViewExtension = nullptr;
+    this->_occlusionSlot = INDEX_NONE;
+  }
+
+  Super::BeginDestroy();
+}
+
 void UCesiumBoundingVolumeComponent::UpdateOcclusion(
     const CesiumViewExtension& cesiumViewExtension) {
   if (!_isMapped) {
@@ -103,6 +148,7 @@ void UCesiumBoundingVolumeComponent::UpdateOcclusion(
   TileOcclusionState occlusionState =
       cesiumViewExtension.getPrimitiveOcclusionState(
           this->ComponentId,
+          this->_occlusionSlot,
           _occlusionState == TileOcclusionState::Occluded,
           _mappedFrameTime);
 
@@ -26,8 +26,15 @@ public:
 
   /**
    * Initialize the TileOcclusionRendererProxyPool implementation.
+   *
+   * @param maxPoolSize The maximum number of bounding volumes in the pool.
+   * @param pViewExtension The view extension that aggregates the bounding
+   * volumes' occlusion results.
    */
-  void initPool(int32 maxPoolSize);
+  void initPool(
+      int32 maxPoolSize,
+      const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
+          pViewExtension);
 
   /**
    * Updates bounding volume transforms from a new double-precision
@@ -45,6 +52,8 @@ public:
 private:
   glm::dmat4 _cesiumToUnreal;
 
+  TSharedPtr<CesiumViewExtension, ESPMode::ThreadSafe> _pViewExtension;
+
   // These are really implementations of the functions in
   // TileOcclusionRendererProxyPool, but we can't use multiple inheritance with
   // UObjects. Instead use the CesiumBoundingVolumePool and forward virtual
@@ -108,7 +117,7 @@ public:
 
   bool ShouldRecreateProxyOnUpdateTransform() const override { return true; }
 
-  // virtual void BeginDestroy() override;
+  virtual void BeginDestroy() override;
 
   Cesium3DTilesSelection::TileOcclusionState
   getOcclusionState() const override {
@@ -119,8 +128,16 @@ protected:
   void reset(const Cesium3DTilesSelection::Tile* pTile) override;
 
 private:
+  friend class UCesiumBoundingVolumePoolComponent;
+  friend class FCesiumBoundingVolumeSceneProxy;
+
   void _updateTransform();
 
+  // The view extension that aggregates this bounding volume's occlusion
+  // results, and the slot they're stored in.
+  TSharedPtr<CesiumViewExtension, ESPMode::ThreadSafe> _pViewExtension;
+  int32 _occlusionSlot = INDEX_NONE;
+
   Cesium3DTilesSelection::TileOcclusionState _occlusionState =
       Cesium3DTilesSelection::TileOcclusionState::OcclusionUnavailable;
 
@@ -0,0 +1,39 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumBoxTileExcluder.h"
+
+void UCesiumBoxTileExcluder::ShouldExcludeTiles(
+    TConstArrayView<FBoxSphereBounds> TileBounds,
+    TBitArray<>& OutExcluded) {
+  OutExcluded.Init(false, TileBounds.Num());
+
+  const FQuat worldToBox = this->Rotation.Quaternion().Inverse();
+  const FVector boxExtent = this->Extent.ComponentMax(FVector::ZeroVector);
+
+  for (int32 i = 0; i < TileBounds.Num(); ++i) {
+    const FBoxSphereBounds& bounds = TileBounds[i];
+
+    // Bring the tile's box into the box's frame. The rotated box is bounded
+    // by a larger axis-aligned box there, so both tests below are
+    // conservative: a tile is only excluded when it certainly should be.
+    const FVector center =
+        worldToBox.RotateVector(bounds.Origin - this->Center);
+    const FVector axisX = worldToBox.RotateVector(FVector::XAxisVector);
+    const FVector axisY = worldToBox.RotateVector(FVector::YAxisVector);
+    const FVector axisZ = worldToBox.RotateVector(FVector::ZAxisVector);
+    const FVector extent = axisX.GetAbs() * bounds.BoxExtent.X +
+                           axisY.GetAbs() * bounds.BoxExtent.Y +
+                           axisZ.GetAbs() * bounds.BoxExtent.Z;
+    const FVector distance = center.GetAbs();
+
+    if (this->ExcludeTilesInside) {
+      OutExcluded[i] = distance.X + extent.X <= boxExtent.X &&
+                       distance.Y + extent.Y <= boxExtent.Y &&
+                       distance.Z + extent.Z <= boxExtent.Z;
+    } else {
+      OutExcluded[i] = distance.X - extent.X > boxExtent.X ||
+                       distance.Y - extent.Y > boxExtent.Y ||
+                       distance.Z - extent.Z > boxExtent.Z;
+    }
+  }
+}
@@ -0,0 +1,109 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumCachePrewarming.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/GlobeTransforms.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/geometric.hpp>
+
+using namespace CesiumGeospatial;
+
+namespace {
+
+// Adjacent views overlap by this fraction of their footprint, so that tiles on
+// the boundary between two views are loaded at full detail.
+constexpr double ViewOverlap = 0.2;
+
+bool isInsidePolygon(
+    const std::vector<glm::dvec2>& vertices,
+    double longitude,
+    double latitude) {
+  bool inside = false;
+  const size_t count = vertices.size();
+  for (size_t i = 0, j = count - 1; i < count; j = i++) {
+    const glm::dvec2& a = vertices[i];
+    const glm::dvec2& b = vertices[j];
+    if ((a.y > latitude) != (b.y > latitude) &&
+        longitude < (b.x - a.x) * (latitude - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+Cesium3DTilesSelection::ViewState
+createNadirView(double longitude, double latitude, double height) {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const glm::dvec3 position = ellipsoid.cartographicToCartesian(
+      Cartographic(longitude, latitude, height));
+  const glm::dmat4 enu =
+      GlobeTransforms::eastNorthUpToFixedFrame(position, ellipsoid);
+  const glm::dvec3 north = glm::normalize(glm::dvec3(enu[1]));
+  const glm::dvec3 up = glm::normalize(glm::dvec3(enu[2]));
+
+  return Cesium3DTilesSelection::ViewState::create(
+      position,
+      -up,
+      north,
+      glm::dvec2(CesiumCachePrewarming::ViewportSize),
+      CesiumCachePrewarming::ViewFieldOfView,
+      CesiumCachePrewarming::ViewFieldOfView);
+}
+
+} // namespace
+
+namespace CesiumCachePrewarming {
+
+std::vector<Cesium3DTilesSelection::ViewState> createNadirViews(
+    const CartographicPolygon& polygon,
+    double height) {
+  const std::vector<glm::dvec2>& vertices = polygon.getVertices();
+  const std::optional<GlobeRectangle>& maybeRectangle =
+      polygon.getBoundingRectangle();
+  if (vertices.size() < 3 || !maybeRectangle) {
+    return {};
+  }
+
+  const GlobeRectangle& rectangle = *maybeRectangle;
+  const double radius = Ellipsoid::WGS84.getMaximumRadius();
+
+  // The width of the ground visible from each view, less the overlap.
+  const double spacing = std::max(
+      2.0 * std::max(height, 1.0) * std::tan(ViewFieldOfView * 0.5) *
+          (1.0 - ViewOverlap),
+      1.0);
+  const double latitudeStep = spacing / radius;
+
+  std::vector<Cesium3DTilesSelection::ViewState> views;
+
+  for (double latitude = rectangle.getSouth() + latitudeStep * 0.5;
+       latitude < rectangle.getNorth() + latitudeStep * 0.5;
+       latitude += latitudeStep) {
+    const double clampedLatitude = std::min(latitude, rectangle.getNorth());
+    const double longitudeStep =
+        latitudeStep / std::max(std::cos(clampedLatitude), 1e-6);
+
+    for (double longitude = rectangle.getWest() + longitudeStep * 0.5;
+         longitude < rectangle.getEast() + longitudeStep * 0.5;
+         longitude += longitudeStep) {
+      const double clampedLongitude = std::min(longitude, rectangle.getEast());
+      if (isInsidePolygon(vertices, clampedLongitude, clampedLatitude)) {
+        views.emplace_back(
+            createNadirView(clampedLongitude, clampedLatitude, height));
+      }
+    }
+  }
+
+  // A region that's smaller than a single view's footprint may not contain any
+  // grid points, so view it from its center instead.
+  if (views.empty()) {
+    const Cartographic center = rectangle.computeCenter();
+    views.emplace_back(
+        createNadirView(center.longitude, center.latitude, height));
+  }
+
+  return views;
+}
+
+} // namespace CesiumCachePrewarming
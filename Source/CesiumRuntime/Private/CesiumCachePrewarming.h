@@ -0,0 +1,40 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "CesiumGeospatial/CartographicPolygon.h"
+#include <vector>
+
+namespace CesiumCachePrewarming {
+
+/**
+ * The horizontal and vertical field of view, in radians, of the views created
+ * by {@link createNadirViews}.
+ */
+constexpr double ViewFieldOfView = 1.0471975511965976; // 60 degrees
+
+/**
+ * The viewport size, in pixels, of the views created by
+ * {@link createNadirViews}.
+ */
+constexpr double ViewportSize = 1024.0;
+
+/**
+ * @brief Creates views looking straight down at the ellipsoid from the given
+ * height, arranged in a grid that covers the given polygon with some overlap.
+ * Loading the tiles needed by all of these views loads every tile needed to
+ * view the region from that height or higher.
+ *
+ * The views are in Earth-centered, Earth-fixed coordinates, which is the
+ * coordinate system used for tile selection.
+ *
+ * @param polygon The region to cover. It must not cross the antimeridian.
+ * @param height The height of the views above the WGS84 ellipsoid, in meters.
+ * @return The views, which is empty if the polygon is empty.
+ */
+std::vector<Cesium3DTilesSelection::ViewState> createNadirViews(
+    const CesiumGeospatial::CartographicPolygon& polygon,
+    double height);
+
+} // namespace CesiumCachePrewarming
@@ -9,7 +9,9 @@ FCesiumCamera::FCesiumCamera()
       Location(0.0, 0.0, 0.0),
       Rotation(0.0, 0.0, 0.0),
       FieldOfViewDegrees(0.0),
-      OverrideAspectRatio(0.0) {}
+      OverrideAspectRatio(0.0),
+      PriorityWeight(1.0f),
+      MaximumScreenSpaceErrorMultiplier(1.0) {}
 
 FCesiumCamera::FCesiumCamera(
     const FVector2D& ViewportSize_,
@@ -20,7 +22,9 @@ FCesiumCamera::FCesiumCamera(
       Location(Location_),
       Rotation(Rotation_),
       FieldOfViewDegrees(FieldOfViewDegrees_),
-      OverrideAspectRatio(0.0) {}
+      OverrideAspectRatio(0.0),
+      PriorityWeight(1.0f),
+      MaximumScreenSpaceErrorMultiplier(1.0) {}
 
 FCesiumCamera::FCesiumCamera(
     const FVector2D& ViewportSize_,
@@ -32,4 +36,6 @@ FCesiumCamera::FCesiumCamera(
       Location(Location_),
       Rotation(Rotation_),
       FieldOfViewDegrees(FieldOfViewDegrees_),
-      OverrideAspectRatio(OverrideAspectRatio_) {}
+      OverrideAspectRatio(OverrideAspectRatio_),
+      PriorityWeight(1.0f),
+      MaximumScreenSpaceErrorMultiplier(1.0) {}
@@ -2,6 +2,7 @@
 
 #include "CesiumCartographicPolygon.h"
 #include "CesiumActors.h"
+#include "CesiumRuntime.h"
 #include "CesiumUtility/Math.h"
 #include "Components/SceneComponent.h"
 #include "StaticMeshResources.h"
@@ -45,10 +46,38 @@ void ACesiumCartographicPolygon::BeginPlay() {
 CesiumGeospatial::CartographicPolygon
 ACesiumCartographicPolygon::CreateCartographicPolygon(
     const FTransform& worldToTileset) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateCartographicPolygon)
+
+  const ACesiumGeoreference* pGeoreference =
+      this->GlobeAnchor->ResolveGeoreference();
+  const FMatrix ecefToUnreal =
+      pGeoreference->ComputeEarthCenteredEarthFixedToUnrealTransformation();
+  const FTransform& splineTransform = this->Polygon->GetComponentTransform();
+
+  // Sampling the spline and converting every point to cartographic is slow
+  // for polygons with many points, so only do it when something the result
+  // depends on has changed.
+  if (this->_cartographicPolygon &&
+      this->_splineVersion == this->Polygon->SplineCurves.Version &&
+      this->_pGeoreference.Get() == pGeoreference &&
+      this->_ecefToUnreal.Equals(ecefToUnreal, 0.0) &&
+      this->_splineTransform.Equals(splineTransform, 0.0) &&
+      this->_worldToTileset.Equals(worldToTileset, 0.0)) {
+    return *this->_cartographicPolygon;
+  }
+
+  this->_splineVersion = this->Polygon->SplineCurves.Version;
+  this->_pGeoreference = pGeoreference;
+  this->_ecefToUnreal = ecefToUnreal;
+  this->_splineTransform = splineTransform;
+  this->_worldToTileset = worldToTileset;
+  ++this->_cartographicPolygonRevision;
+
   int32 splinePointsCount = this->Polygon->GetNumberOfSplinePoints();
 
   if (splinePointsCount < 3) {
-    return CartographicPolygon({});
+    this->_cartographicPolygon.emplace(std::vector<glm::dvec2>());
+    return *this->_cartographicPolygon;
   }
 
   std::vector<glm::dvec2> polygon(splinePointsCount);
@@ -65,13 +94,14 @@ ACesiumCartographicPolygon::CreateCartographicPolygon(
             i,
             ESplineCoordinateSpace::World));
     FVector cartographic =
-        this->GlobeAnchor->ResolveGeoreference()
-            ->TransformUnrealPositionToLongitudeLatitudeHeight(unrealPosition);
+        pGeoreference->TransformUnrealPositionToLongitudeLatitudeHeight(
+            unrealPosition);
     polygon[i] =
         glm::dvec2(glm::radians(cartographic.X), glm::radians(cartographic.Y));
   }
 
-  return CartographicPolygon(polygon);
+  this->_cartographicPolygon.emplace(polygon);
+  return *this->_cartographicPolygon;
 }
 
 void ACesiumCartographicPolygon::MakeLinear() {
@@ -87,3 +117,13 @@ void ACesiumCartographicPolygon::PostLoad() {
   if (CesiumActors::shouldValidateFlags(this))
     CesiumActors::validateActorFlags(this);
 }
+
+#if WITH_EDITOR
+void ACesiumCartographicPolygon::PostEditUndo() {
+  Super::PostEditUndo();
+
+  // Undo restores the spline's earlier version number along with its points,
+  // so the version alone can't tell that the cached polygon is out of date.
+  this->_cartographicPolygon.reset();
+}
+#endif
@@ -0,0 +1,189 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumClippingVolumeComponent.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCartographicPolygon.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumMaterialParameterNames.h"
+#include "Components/SplineComponent.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+namespace {
+
+// Must match CESIUM_CLIPPING_TEXTURE_WIDTH in CesiumClippingVolumes.ush.
+constexpr int32 ClippingTextureWidth = 1024;
+
+// The volume types as they are encoded, which must match
+// CesiumClippingVolumes.ush.
+constexpr float PolygonVolume = 0.0f;
+constexpr float BoxVolume = 1.0f;
+
+} // namespace
+
+UCesiumClippingVolumeComponent::UCesiumClippingVolumeComponent() {
+  this->PrimaryComponentTick.bCanEverTick = true;
+  this->bTickInEditor = true;
+}
+
+void UCesiumClippingVolumeComponent::ApplyToMaterial(
+    UMaterialInstanceDynamic* pMaterial) const {
+  if (pMaterial && this->_pTexture) {
+    pMaterial->SetTextureParameterValue(
+        CesiumMaterialParameterNames::ClippingVolumes,
+        this->_pTexture);
+  }
+}
+
+void UCesiumClippingVolumeComponent::TickComponent(
+    float DeltaTime,
+    ELevelTick TickType,
+    FActorComponentTickFunction* ThisTickFunction) {
+  Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+  // The polygons may move at any time, so they are encoded again each frame,
+  // but the texture and the tile materials are only updated when that
+  // changes the encoding.
+  if (this->encodeVolumes()) {
+    this->updateTexture();
+  }
+}
+
+void UCesiumClippingVolumeComponent::OnRegister() {
+  Super::OnRegister();
+  this->encodeVolumes();
+  this->updateTexture();
+}
+
+void UCesiumClippingVolumeComponent::OnUnregister() {
+  Super::OnUnregister();
+  this->applyToTileset(nullptr);
+  this->_pTexture = nullptr;
+  this->_encodedVolumesInTexture.Empty();
+}
+
+bool UCesiumClippingVolumeComponent::encodeVolumes() {
+  TArray<FVector4f>& encoded = this->_encodedVolumes;
+  encoded.Reset();
+
+  // The first texel holds the number of volumes and whether the selection is
+  // inverted. Each volume is then a header texel with its type and the number
+  // of texels that follow it.
+  encoded.Emplace(0.0f, this->InvertSelection ? 1.0f : 0.0f, 0.0f, 0.0f);
+  int32 volumeCount = 0;
+
+  for (const ACesiumCartographicPolygon* pPolygon : this->Polygons) {
+    if (!IsValid(pPolygon) || !IsValid(pPolygon->Polygon)) {
+      continue;
+    }
+
+    const USplineComponent* pSpline = pPolygon->Polygon;
+    const int32 pointCount = pSpline->GetNumberOfSplinePoints();
+    if (pointCount < 3) {
+      continue;
+    }
+
+    // A polygon is its bounding rectangle, for rejecting pixels quickly,
+    // followed by one texel for each edge.
+    encoded.Emplace(PolygonVolume, float(pointCount + 1), 0.0f, 0.0f);
+    const int32 boundsIndex = encoded.AddUninitialized();
+
+    FBox2D bounds(ForceInit);
+    FVector2D previous(0.0);
+    for (int32 i = 0; i <= pointCount; ++i) {
+      const FVector location = pSpline->GetLocationAtSplinePoint(
+          i % pointCount,
+          ESplineCoordinateSpace::World);
+      const FVector2D point(location.X, location.Y);
+      if (i > 0) {
+        encoded.Emplace(previous.X, previous.Y, point.X, point.Y);
+      }
+      bounds += point;
+      previous = point;
+    }
+
+    encoded[boundsIndex] =
+        FVector4f(bounds.Min.X, bounds.Min.Y, bounds.Max.X, bounds.Max.Y);
+    ++volumeCount;
+  }
+
+  for (const FCesiumClippingBox& box : this->Boxes) {
+    // A box is the rows of the matrix that takes a world position to the
+    // cube from -1 to 1 along each axis.
+    const FVector extent = box.Extent.ComponentMax(FVector(UE_SMALL_NUMBER));
+    const FMatrix worldToBox =
+        FTransform(box.Rotation, box.Center, extent).ToInverseMatrixWithScale();
+
+    encoded.Emplace(BoxVolume, 3.0f, 0.0f, 0.0f);
+    for (int32 row = 0; row < 3; ++row) {
+      encoded.Emplace(
+          worldToBox.M[0][row],
+          worldToBox.M[1][row],
+          worldToBox.M[2][row],
+          worldToBox.M[3][row]);
+    }
+    ++volumeCount;
+  }
+
+  encoded[0].X = float(volumeCount);
+
+  return encoded != this->_encodedVolumesInTexture;
+}
+
+void UCesiumClippingVolumeComponent::updateTexture() {
+  const TArray<FVector4f>& encoded = this->_encodedVolumes;
+  const int32 width = FMath::Min(encoded.Num(), ClippingTextureWidth);
+  const int32 height = FMath::DivideAndRoundUp(encoded.Num(), width);
+
+  UTexture2D* pTexture =
+      UTexture2D::CreateTransient(width, height, PF_A32B32G32R32F);
+  if (!pTexture) {
+    return;
+  }
+
+  pTexture->SRGB = false;
+  pTexture->Filter = TextureFilter::TF_Nearest;
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  pTexture->NeverStream = true;
+
+  FTexture2DMipMap& mip = pTexture->GetPlatformData()->Mips[0];
+  FVector4f* pData =
+      static_cast<FVector4f*>(mip.BulkData.Lock(LOCK_READ_WRITE));
+  FMemory::Memzero(pData, width * height * sizeof(FVector4f));
+  FMemory::Memcpy(pData, encoded.GetData(), encoded.Num() * sizeof(FVector4f));
+  mip.BulkData.Unlock();
+  pTexture->UpdateResource();
+
+  this->_pTexture = pTexture;
+  this->_encodedVolumesInTexture = encoded;
+  this->applyToTileset(pTexture);
+}
+
+void UCesiumClippingVolumeComponent::applyToTileset(
+    UTexture2D* pTexture) const {
+  const ACesium3DTileset* pTileset = this->GetOwner<ACesium3DTileset>();
+  if (!pTileset) {
+    return;
+  }
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  pTileset->GetComponents<UCesiumGltfComponent>(gltfComponents);
+
+  for (const UCesiumGltfComponent* pGltf : gltfComponents) {
+    for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      UMaterialInstanceDynamic* pMaterial =
+          pPrimitive
+              ? Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(0))
+              : nullptr;
+      if (pMaterial) {
+        pMaterial->SetTextureParameterValue(
+            CesiumMaterialParameterNames::ClippingVolumes,
+            pTexture);
+      }
+    }
+  }
+}
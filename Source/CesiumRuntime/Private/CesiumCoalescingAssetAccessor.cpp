@@ -0,0 +1,302 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumCoalescingAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumBandwidthLimiter.h"
+#include "CesiumRequestCancellation.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * The successful responses most recently received by any
+ * CesiumCoalescingAssetAccessor, up to "Shared Raster Overlay Cache Bytes" of
+ * them. This lets an overlay that is attached to several tilesets fetch each
+ * of its tiles once, rather than once for each tileset.
+ *
+ * Unlike requests in flight, which are only shared within one tile provider,
+ * these are shared by all of them. A completed response can't be affected by
+ * cancelling the request group of the tileset that requested it.
+ */
+class RecentResponses {
+public:
+  static RecentResponses& get() {
+    static RecentResponses responses;
+    return responses;
+  }
+
+  /**
+   * Gets the key that identifies a request, which ignores the request group
+   * and bandwidth stream pseudo-headers.
+   */
+  static std::string getKey(
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+    std::string key = url;
+    for (const CesiumAsync::IAssetAccessor::THeader& header : headers) {
+      if (header.first == CesiumRequestCancellation::groupHeader ||
+          header.first == CesiumBandwidthLimiter::streamHeader) {
+        continue;
+      }
+      key += '\n';
+      key += header.first;
+      key += ": ";
+      key += header.second;
+    }
+    return key;
+  }
+
+  std::shared_ptr<CesiumAsync::IAssetRequest> find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(key);
+    if (it == this->_entries.end()) {
+      return nullptr;
+    }
+
+    // Move the response to the most recently used end.
+    this->_order.splice(this->_order.end(), this->_order, it->second);
+    return it->second->pRequest;
+  }
+
+  void add(
+      const std::string& key,
+      const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest) {
+    const CesiumAsync::IAssetResponse* pResponse =
+        pRequest ? pRequest->response() : nullptr;
+    // Only images are kept. Other responses, such as the Cesium ion
+    // endpoint, can contain access tokens that expire.
+    if (!pResponse || pResponse->statusCode() != 200 ||
+        pResponse->contentType().rfind("image/", 0) != 0) {
+      return;
+    }
+
+    const int64_t maximumBytes =
+        GetDefault<UCesiumRuntimeSettings>()->SharedRasterOverlayCacheBytes;
+    const int64_t bytes = int64_t(pResponse->data().size());
+    if (bytes <= 0 || bytes > maximumBytes / 4) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_entries.find(key) != this->_entries.end()) {
+      return;
+    }
+
+    this->_order.push_back(Entry{key, pRequest, bytes});
+    this->_entries.emplace(key, std::prev(this->_order.end()));
+    this->_bytes += bytes;
+
+    while (this->_bytes > maximumBytes && !this->_order.empty()) {
+      const Entry& oldest = this->_order.front();
+      this->_bytes -= oldest.bytes;
+      this->_entries.erase(oldest.key);
+      this->_order.pop_front();
+    }
+  }
+
+  void clear() {
+    std::list<Entry> order;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      order.swap(this->_order);
+      this->_entries.clear();
+      this->_bytes = 0;
+    }
+  }
+
+private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    int64_t bytes;
+  };
+
+  std::mutex _mutex;
+  std::list<Entry> _order;
+  std::unordered_map<std::string, std::list<Entry>::iterator> _entries;
+  int64_t _bytes = 0;
+};
+
+} // namespace
+
+class CesiumCoalescingAssetAccessor::InFlight
+    : public std::enable_shared_from_this<
+          CesiumCoalescingAssetAccessor::InFlight> {
+public:
+  InFlight(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      bool shareAcrossRequestGroups)
+      : _pAssetAccessor(pAssetAccessor),
+        _shareAcrossRequestGroups(shareAcrossRequestGroups),
+        _mutex(),
+        _requests(),
+        _coalescedRequestCount(0),
+        _sharedResponseCount(0) {}
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+    const std::string recentKey = RecentResponses::getKey(url, headers);
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRecent =
+        RecentResponses::get().find(recentKey);
+    if (pRecent) {
+      ++this->_sharedResponseCount;
+      return asyncSystem.createResolvedFuture(std::move(pRecent));
+    }
+
+    Key key{url, headers};
+    if (this->_shareAcrossRequestGroups) {
+      CesiumRequestCancellation::extractGroup(key.second);
+      CesiumBandwidthLimiter::extractStream(key.second);
+    }
+
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise =
+        asyncSystem
+            .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+    CesiumAsync::Promise<Outcome> sharedPromise =
+        asyncSystem.createPromise<Outcome>();
+
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      auto it = this->_requests.find(key);
+      if (it != this->_requests.end()) {
+        ++this->_coalescedRequestCount;
+        return this->follow(it->second, asyncSystem, url, headers);
+      }
+
+      this->_requests.emplace(key, sharedPromise.getFuture().share());
+    }
+
+    // The request is made without holding the lock, because it may complete
+    // immediately, such as when it is read from the cache.
+    std::shared_ptr<InFlight> pThis = this->shared_from_this();
+    this->_pAssetAccessor->get(asyncSystem, url, headers)
+        .thenImmediately(
+            [pThis, key, recentKey, promise, sharedPromise](
+                std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+              RecentResponses::get().add(recentKey, pRequest);
+              pThis->finish(key);
+              sharedPromise.resolve(Outcome{pRequest, false});
+              promise.resolve(std::move(pRequest));
+            })
+        .catchImmediately(
+            [pThis, key, promise, sharedPromise](std::exception&& e) {
+              pThis->finish(key);
+              sharedPromise.resolve(Outcome{nullptr, true});
+              promise.reject(std::move(e));
+            });
+
+    return promise.getFuture();
+  }
+
+  int64_t getCoalescedRequestCount() const {
+    return this->_coalescedRequestCount;
+  }
+
+  int64_t getSharedResponseCount() const {
+    return this->_sharedResponseCount;
+  }
+
+private:
+  using Key =
+      std::pair<std::string, std::vector<CesiumAsync::IAssetAccessor::THeader>>;
+
+  // The result of a request, as seen by the requests that share it.
+  struct Outcome {
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    bool failed;
+  };
+
+  /**
+   * Gives a request the result of the request in flight that it shares. If
+   * that request fails, such as because the request group that made it was
+   * cancelled, this request is made again on its own, since its own group may
+   * still want it.
+   */
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> follow(
+      const CesiumAsync::SharedFuture<Outcome>& future,
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+    return future.thenImmediately(
+        [pAssetAccessor = this->_pAssetAccessor, asyncSystem, url, headers](
+            const Outcome& outcome) {
+          if (outcome.failed) {
+            return pAssetAccessor->get(asyncSystem, url, headers);
+          }
+          std::shared_ptr<CesiumAsync::IAssetRequest> pRequest =
+              outcome.pRequest;
+          return asyncSystem.createResolvedFuture(std::move(pRequest));
+        });
+  }
+
+  void finish(const Key& key) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_requests.erase(key);
+  }
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  bool _shareAcrossRequestGroups;
+  std::mutex _mutex;
+  std::map<Key, CesiumAsync::SharedFuture<Outcome>> _requests;
+  std::atomic<int64_t> _coalescedRequestCount;
+  std::atomic<int64_t> _sharedResponseCount;
+};
+
+CesiumCoalescingAssetAccessor::CesiumCoalescingAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    bool shareAcrossRequestGroups)
+    : _pAssetAccessor(pAssetAccessor),
+      _pInFlight(std::make_shared<InFlight>(
+          pAssetAccessor,
+          shareAcrossRequestGroups)) {}
+
+/*static*/ const std::shared_ptr<CesiumCoalescingAssetAccessor>&
+CesiumCoalescingAssetAccessor::getSharedByAllTilesets() {
+  static std::shared_ptr<CesiumCoalescingAssetAccessor> pShared =
+      std::make_shared<CesiumCoalescingAssetAccessor>(getAssetAccessor(), true);
+  return pShared;
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumCoalescingAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  return this->_pInFlight->get(asyncSystem, url, headers);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumCoalescingAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumCoalescingAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+/*static*/ void CesiumCoalescingAssetAccessor::clearSharedResponses() {
+  RecentResponses::get().clear();
+}
+
+int64_t CesiumCoalescingAssetAccessor::getCoalescedRequestCount() const {
+  return this->_pInFlight->getCoalescedRequestCount();
+}
+
+int64_t CesiumCoalescingAssetAccessor::getSharedResponseCount() const {
+  return this->_pInFlight->getSharedResponseCount();
+}
@@ -0,0 +1,145 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumBandwidthLimiter.h"
+#include "CesiumRasterOverlays/RasterOverlay.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * An asset accessor that shares one request among all of the GET requests
+ * for the same URL, with the same headers, that are made while it is in
+ * flight. Every caller receives the same completed request.
+ *
+ * Raster overlays that request their tiles over the network create one of
+ * these for each of their tile providers, so that overlay tiles that are
+ * requested by several geometry tiles being refined at the same time are only
+ * fetched once. The most recent successful responses are also kept, in
+ * memory shared by every one of these accessors, so that an overlay attached
+ * to several tilesets fetches each tile once. Requests made with
+ * IAssetAccessor::request are passed straight through to the underlying
+ * accessor.
+ *
+ * Every tileset also requests its content through the accessor returned by
+ * {@link getSharedByAllTilesets}, so that tilesets with the same source, such
+ * as one that is rendered and one that is only used for collision, fetch
+ * each of their tiles once.
+ *
+ * If a shared request fails, such as because the request group that made it
+ * was cancelled, each of the other requests that shared it is made again on
+ * its own.
+ */
+class CesiumCoalescingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @param pAssetAccessor The accessor that performs the requests.
+   * @param shareAcrossRequestGroups Whether requests in different request
+   * groups and bandwidth streams share a request in flight. Otherwise, the
+   * group and stream pseudo-headers are compared like any other header.
+   */
+  CesiumCoalescingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      bool shareAcrossRequestGroups = false);
+
+  /**
+   * Gets the accessor, shared by every tileset, that shares the requests
+   * for the same content made by different tilesets while they are in flight.
+   */
+  static const std::shared_ptr<CesiumCoalescingAssetAccessor>&
+  getSharedByAllTilesets();
+
+  /**
+   * Forgets the recent responses that are shared by every one of these
+   * accessors, such as when memory is low. Requests in flight are unaffected.
+   */
+  static void clearSharedResponses();
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Gets the number of requests that were given the result of a request that
+   * was already in flight, rather than being made again.
+   */
+  int64_t getCoalescedRequestCount() const;
+
+  /**
+   * Gets the number of requests that were given a recent response, received
+   * by this or any other CesiumCoalescingAssetAccessor, rather than being
+   * made again.
+   */
+  int64_t getSharedResponseCount() const;
+
+private:
+  class InFlight;
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<InFlight> _pInFlight;
+};
+
+/**
+ * A raster overlay that requests its tiles through a
+ * CesiumCoalescingAssetAccessor, so that each of its tiles is fetched only
+ * once while it is in flight. Its requests are also made in the bandwidth
+ * stream that the UCesiumRasterOverlay that created it assigned it to with
+ * CesiumBandwidthLimiter::setOverlayStream, if any.
+ *
+ * @tparam TOverlay The cesium-native raster overlay to derive from. Its
+ * constructor arguments are passed through.
+ */
+template <typename TOverlay>
+class CesiumCoalescingRasterOverlay : public TOverlay {
+public:
+  using TOverlay::TOverlay;
+
+  virtual CesiumAsync::Future<
+      CesiumRasterOverlays::RasterOverlay::CreateTileProviderResult>
+  createTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<
+          CesiumRasterOverlays::IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumUtility::IntrusivePointer<const CesiumRasterOverlays::RasterOverlay>
+          pOwner) const override {
+    // The overlay's requests are made in its own bandwidth stream, if it has
+    // one, rather than in that of the tileset it's attached to.
+    std::shared_ptr<CesiumAsync::IAssetAccessor> pOverlayAssetAccessor =
+        pAssetAccessor;
+    const uint64_t stream = CesiumBandwidthLimiter::get().findOverlayStream(
+        pOwner ? pOwner.get() : this);
+    if (stream != 0) {
+      pOverlayAssetAccessor =
+          std::make_shared<CesiumBandwidthStreamAssetAccessor>(
+              pAssetAccessor,
+              stream);
+    }
+
+    return TOverlay::createTileProvider(
+        asyncSystem,
+        std::make_shared<CesiumCoalescingAssetAccessor>(pOverlayAssetAccessor),
+        pCreditSystem,
+        pPrepareRendererResources,
+        pLogger,
+        std::move(pOwner));
+  }
+};
@@ -0,0 +1,200 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumContentDecoding.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformTime.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Compressed Tile Content Decodes"),
+    STAT_CesiumCompressedDecodes,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Compressed Tile Content Decodes Waiting"),
+    STAT_CesiumCompressedDecodesWaiting,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_COUNTER_STAT(
+    TEXT("Draco Decode Time (ms)"),
+    STAT_CesiumDracoDecodeTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_COUNTER_STAT(
+    TEXT("Meshopt Decode Time (ms)"),
+    STAT_CesiumMeshoptDecodeTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_COUNTER_STAT(
+    TEXT("KTX2 Transcode Time (ms)"),
+    STAT_CesiumKtx2DecodeTime,
+    STATGROUP_Cesium);
+
+/*static*/ std::array<
+    CesiumContentDecoding::Counters,
+    CesiumContentDecoding::CodecCount>
+    CesiumContentDecoding::_counters;
+/*static*/ std::atomic<int64> CesiumContentDecoding::_totalWaitMicroseconds =
+    0;
+
+namespace {
+
+std::mutex decodingMutex;
+std::condition_variable decodingFinished;
+int32 activeDecodes = 0;
+
+uint32 readUint32(const gsl::span<const std::byte>& content, size_t offset) {
+  uint32 value;
+  std::memcpy(&value, content.data() + offset, sizeof(value));
+  return value;
+}
+
+bool hasMagic(
+    const gsl::span<const std::byte>& content,
+    size_t offset,
+    const char* magic) {
+  return content.size() >= offset + 4 &&
+         std::memcmp(content.data() + offset, magic, 4) == 0;
+}
+
+// Finds the JSON chunk of binary glTF, which may be inside a Batched 3D
+// Model after its header and its feature and batch tables.
+std::string_view findGltfJson(const gsl::span<const std::byte>& content) {
+  size_t offset = 0;
+  if (hasMagic(content, 0, "b3dm")) {
+    constexpr size_t b3dmHeaderLength = 28;
+    if (content.size() < b3dmHeaderLength) {
+      return {};
+    }
+    offset = b3dmHeaderLength + size_t(readUint32(content, 12)) +
+             size_t(readUint32(content, 16)) +
+             size_t(readUint32(content, 20)) +
+             size_t(readUint32(content, 24));
+  }
+
+  // The JSON chunk follows the 12-byte header, and its own length and type.
+  constexpr size_t jsonStart = 20;
+  if (!hasMagic(content, offset, "glTF") ||
+      content.size() < offset + jsonStart) {
+    return {};
+  }
+  const size_t jsonLength = readUint32(content, offset + 12);
+  if (content.size() - offset - jsonStart < jsonLength) {
+    return {};
+  }
+  return std::string_view(
+      reinterpret_cast<const char*>(content.data() + offset + jsonStart),
+      jsonLength);
+}
+
+void updateMaximum(std::atomic<int64>& maximum, int64 value) {
+  int64 current = maximum.load();
+  while (value > current && !maximum.compare_exchange_weak(current, value)) {
+  }
+}
+
+} // namespace
+
+/*static*/ uint8
+CesiumContentDecoding::detectCodecs(const gsl::span<const std::byte>& content) {
+  const std::string_view json = findGltfJson(content);
+  uint8 codecs = 0;
+  if (json.find("KHR_draco_mesh_compression") != std::string_view::npos) {
+    codecs |= Draco;
+  }
+  if (json.find("EXT_meshopt_compression") != std::string_view::npos) {
+    codecs |= Meshopt;
+  }
+  if (json.find("KHR_texture_basisu") != std::string_view::npos) {
+    codecs |= Ktx2;
+  }
+  return codecs;
+}
+
+/*static*/ CesiumContentDecoding::Statistics
+CesiumContentDecoding::getStatistics(Codec codec) {
+  const int32 index = FMath::FloorLog2(uint32(codec));
+  const Counters& counters = _counters[index];
+  Statistics statistics;
+  statistics.count = counters.count;
+  statistics.totalMilliseconds = double(counters.totalMicroseconds) / 1000.0;
+  statistics.maximumMilliseconds =
+      double(counters.maximumMicroseconds) / 1000.0;
+  return statistics;
+}
+
+/*static*/ double CesiumContentDecoding::getTotalWaitMilliseconds() {
+  return double(_totalWaitMicroseconds) / 1000.0;
+}
+
+/*static*/ int32 CesiumContentDecoding::getActiveCount() {
+  std::lock_guard<std::mutex> lock(decodingMutex);
+  return activeDecodes;
+}
+
+CesiumContentDecoding::Scope::Scope(uint8 codecs)
+    : _codecs(codecs), _startSeconds(0.0) {
+  if (this->_codecs == 0) {
+    return;
+  }
+
+  const double waitStart = FPlatformTime::Seconds();
+  {
+    std::unique_lock<std::mutex> lock(decodingMutex);
+    const int32 maximum = GetDefault<UCesiumRuntimeSettings>()
+                              ->MaximumSimultaneousCompressedDecodes;
+    if (maximum > 0 && activeDecodes >= maximum) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WaitForCompressedDecode)
+      INC_DWORD_STAT(STAT_CesiumCompressedDecodesWaiting);
+      decodingFinished.wait(lock, [] {
+        const int32 maximum = GetDefault<UCesiumRuntimeSettings>()
+                                  ->MaximumSimultaneousCompressedDecodes;
+        return maximum <= 0 || activeDecodes < maximum;
+      });
+      DEC_DWORD_STAT(STAT_CesiumCompressedDecodesWaiting);
+    }
+    ++activeDecodes;
+  }
+  INC_DWORD_STAT(STAT_CesiumCompressedDecodes);
+
+  this->_startSeconds = FPlatformTime::Seconds();
+  _totalWaitMicroseconds +=
+      int64((this->_startSeconds - waitStart) * 1000000.0);
+}
+
+CesiumContentDecoding::Scope::~Scope() {
+  if (this->_codecs == 0) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(decodingMutex);
+    --activeDecodes;
+  }
+  decodingFinished.notify_one();
+  DEC_DWORD_STAT(STAT_CesiumCompressedDecodes);
+
+  const double milliseconds =
+      (FPlatformTime::Seconds() - this->_startSeconds) * 1000.0;
+  const int64 microseconds = int64(milliseconds * 1000.0);
+  for (int32 i = 0; i < CodecCount; ++i) {
+    if ((this->_codecs & (1 << i)) == 0) {
+      continue;
+    }
+    Counters& counters = _counters[i];
+    ++counters.count;
+    counters.totalMicroseconds += microseconds;
+    updateMaximum(counters.maximumMicroseconds, microseconds);
+  }
+
+  if (this->_codecs & Draco) {
+    INC_FLOAT_STAT_BY(STAT_CesiumDracoDecodeTime, milliseconds);
+  }
+  if (this->_codecs & Meshopt) {
+    INC_FLOAT_STAT_BY(STAT_CesiumMeshoptDecodeTime, milliseconds);
+  }
+  if (this->_codecs & Ktx2) {
+    INC_FLOAT_STAT_BY(STAT_CesiumKtx2DecodeTime, milliseconds);
+  }
+}
@@ -0,0 +1,117 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "HAL/Platform.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <gsl/span>
+
+/**
+ * Limits and measures the decoding of tile content that needs Draco or
+ * meshopt mesh decompression, or has KTX2 images to transcode, which takes
+ * far longer than decoding other glTF content.
+ *
+ * At most "Maximum Simultaneous Compressed Decodes" of them are decoded at
+ * once, across all tilesets. The others wait on their worker thread until
+ * one finishes, so that a tileset full of compressed tiles can't keep every
+ * core busy decoding while the game and render threads, and the other
+ * tilesets' lighter content, wait for them. Content that isn't compressed
+ * is never held up.
+ *
+ * The time spent decoding content with each codec is counted, and shown by
+ * `stat Cesium` and written to the telemetry. Content that uses several
+ * codecs counts toward each of them.
+ *
+ * All functions may be called from any thread.
+ */
+class CesiumContentDecoding {
+public:
+  enum Codec : uint8 {
+    Draco = 1 << 0,
+    Meshopt = 1 << 1,
+    Ktx2 = 1 << 2,
+  };
+
+  /**
+   * Statistics of the content decoded with one codec since startup.
+   */
+  struct Statistics {
+    /** The number of decoded tile contents. */
+    int64 count = 0;
+
+    /** The total time spent decoding them, in milliseconds. */
+    double totalMilliseconds = 0.0;
+
+    /** The longest time spent decoding one of them, in milliseconds. */
+    double maximumMilliseconds = 0.0;
+  };
+
+  /**
+   * Decodes content within the limit, and counts the time it takes toward
+   * its codecs. Content without any of the codecs is decoded right away and
+   * isn't counted.
+   *
+   * @param content The binary glTF or Batched 3D Model content.
+   * @param function The function that decodes it.
+   */
+  template <typename Function>
+  static auto
+  decode(const gsl::span<const std::byte>& content, Function&& function) {
+    Scope scope(detectCodecs(content));
+    return function();
+  }
+
+  /**
+   * Finds the codecs that binary glTF content, or the glTF in Batched 3D
+   * Model content, declares in its extensionsUsed, as a combination of
+   * Codec flags. Other content has none.
+   */
+  static uint8 detectCodecs(const gsl::span<const std::byte>& content);
+
+  /**
+   * Gets the statistics of the content decoded with a codec.
+   */
+  static Statistics getStatistics(Codec codec);
+
+  /**
+   * Gets the total time, in milliseconds, that compressed content has waited
+   * for the decodes ahead of it to finish.
+   */
+  static double getTotalWaitMilliseconds();
+
+  /**
+   * Gets the number of compressed contents being decoded right now.
+   */
+  static int32 getActiveCount();
+
+  /**
+   * Waits for a slot to decode content with the given codecs in, and counts
+   * the time until it's destroyed toward them.
+   */
+  class Scope {
+  public:
+    explicit Scope(uint8 codecs);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    uint8 _codecs;
+    double _startSeconds;
+  };
+
+private:
+  static constexpr int32 CodecCount = 3;
+
+  struct Counters {
+    std::atomic<int64> count = 0;
+    std::atomic<int64> totalMicroseconds = 0;
+    std::atomic<int64> maximumMicroseconds = 0;
+  };
+
+  static std::array<Counters, CodecCount> _counters;
+  static std::atomic<int64> _totalWaitMicroseconds;
+};
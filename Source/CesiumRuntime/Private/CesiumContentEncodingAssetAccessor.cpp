@@ -0,0 +1,396 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumContentEncodingAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <zlib.h>
+
+DECLARE_MEMORY_STAT(
+    TEXT("Http Encoded Bytes Decoded"),
+    STAT_CesiumHttpEncodedBytes,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Http Decoded Bytes"),
+    STAT_CesiumHttpDecodedBytes,
+    STATGROUP_Cesium);
+
+namespace {
+
+std::atomic<int64_t> totalEncodedBytes{0};
+std::atomic<int64_t> totalDecodedBytes{0};
+
+std::string trimAndLower(const std::string& s) {
+  const size_t begin = s.find_first_not_of(" \t");
+  if (begin == std::string::npos) {
+    return std::string();
+  }
+  const size_t end = s.find_last_not_of(" \t");
+  std::string result = s.substr(begin, end - begin + 1);
+  std::transform(result.begin(), result.end(), result.begin(), [](char c) {
+    return char(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return result;
+}
+
+// Splits a comma-separated header value into its trimmed, lower-case items.
+std::vector<std::string> splitList(const std::string& value) {
+  std::vector<std::string> items;
+  size_t begin = 0;
+  while (begin <= value.size()) {
+    size_t end = value.find(',', begin);
+    if (end == std::string::npos) {
+      end = value.size();
+    }
+    std::string item = trimAndLower(value.substr(begin, end - begin));
+    if (!item.empty()) {
+      items.emplace_back(std::move(item));
+    }
+    begin = end + 1;
+  }
+  return items;
+}
+
+// The most bytes that a gzip body may decode to.
+constexpr size_t MaximumGzipDecodedBytes =
+    size_t(std::numeric_limits<int32>::max());
+
+// The most that the size in a gzip trailer is trusted, as a multiple of the
+// encoded size, when allocating the decoded data up front.
+constexpr size_t MaximumGzipInitialExpansion = 16;
+
+// The smallest that the decoded data grows by when it runs out of room.
+constexpr size_t MinimumGzipGrowthBytes = 64 * 1024;
+
+bool isGzipMember(const Bytef* pData, uInt size) {
+  return size >= 2 && pData[0] == 0x1f && pData[1] == 0x8b;
+}
+
+bool decodeGzip(
+    const gsl::span<const std::byte>& encoded,
+    std::vector<std::byte>& decoded) {
+  const Bytef* pEncoded = reinterpret_cast<const Bytef*>(encoded.data());
+  if (encoded.size() < 18 ||
+      encoded.size() > size_t(std::numeric_limits<int32>::max()) ||
+      !isGzipMember(pEncoded, uInt(encoded.size()))) {
+    return false;
+  }
+
+  // A gzip member ends with the size of its uncompressed data, modulo 2^32.
+  // That comes from the server, and only describes the last member when there
+  // are several, so it is only a hint for how much to allocate up front.
+  const uint8* pTrailer =
+      reinterpret_cast<const uint8*>(encoded.data() + encoded.size() - 4);
+  const size_t sizeHint =
+      size_t(uint32(pTrailer[0]) | uint32(pTrailer[1]) << 8 |
+             uint32(pTrailer[2]) << 16 | uint32(pTrailer[3]) << 24);
+  decoded.resize(std::min(
+      std::clamp(
+          sizeHint,
+          encoded.size(),
+          encoded.size() * MaximumGzipInitialExpansion),
+      MaximumGzipDecodedBytes));
+
+  z_stream stream{};
+  if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+    return false;
+  }
+  stream.next_in = const_cast<Bytef*>(pEncoded);
+  stream.avail_in = uInt(encoded.size());
+
+  size_t decodedSize = 0;
+  int result = Z_OK;
+  while (result == Z_OK) {
+    if (decodedSize == decoded.size()) {
+      if (decoded.size() >= MaximumGzipDecodedBytes) {
+        break;
+      }
+      decoded.resize(std::min(
+          decoded.size() + std::max(decoded.size(), MinimumGzipGrowthBytes),
+          MaximumGzipDecodedBytes));
+    }
+
+    const size_t available = decoded.size() - decodedSize;
+    stream.next_out = reinterpret_cast<Bytef*>(decoded.data() + decodedSize);
+    stream.avail_out = uInt(available);
+    result = inflate(&stream, Z_NO_FLUSH);
+    decodedSize += available - stream.avail_out;
+
+    // Concatenated gzip members decode to the concatenation of their data.
+    // Anything else after a member is ignored, as gunzip does.
+    if (result == Z_STREAM_END &&
+        isGzipMember(stream.next_in, stream.avail_in)) {
+      result = inflateReset(&stream);
+    }
+  }
+
+  inflateEnd(&stream);
+  if (result != Z_STREAM_END) {
+    return false;
+  }
+
+  decoded.resize(decodedSize);
+  return true;
+}
+
+class DecoderRegistry {
+public:
+  static DecoderRegistry& get() {
+    static DecoderRegistry registry;
+    return registry;
+  }
+
+  void add(
+      const std::string& encoding,
+      CesiumContentEncodingAssetAccessor::Decoder&& decoder) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_decoders[trimAndLower(encoding)] = std::move(decoder);
+  }
+
+  std::optional<CesiumContentEncodingAssetAccessor::Decoder>
+  find(const std::string& encoding) const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_decoders.find(encoding);
+    if (it == this->_decoders.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+private:
+  DecoderRegistry() { this->_decoders.emplace("gzip", decodeGzip); }
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, CesiumContentEncodingAssetAccessor::Decoder>
+      _decoders;
+};
+
+/**
+ * A response whose body was decoded. It no longer has the Content-Encoding
+ * and Content-Length headers of the encoded body.
+ */
+class DecodedAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  DecodedAssetResponse(
+      const CesiumAsync::IAssetResponse& encoded,
+      std::vector<std::byte>&& data)
+      : _statusCode(encoded.statusCode()),
+        _contentType(encoded.contentType()),
+        _headers(encoded.headers()),
+        _data(std::move(data)) {
+    this->_headers.erase("Content-Encoding");
+    this->_headers.erase("Content-Length");
+  }
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data);
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class DecodedAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  DecodedAssetRequest(
+      const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest,
+      std::vector<std::byte>&& data)
+      : _pRequest(pRequest),
+        _response(*pRequest->response(), std::move(data)) {}
+
+  virtual const std::string& method() const override {
+    return this->_pRequest->method();
+  }
+
+  virtual const std::string& url() const override {
+    return this->_pRequest->url();
+  }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_pRequest->headers();
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetRequest> _pRequest;
+  DecodedAssetResponse _response;
+};
+
+std::shared_ptr<CesiumAsync::IAssetRequest>
+decodeResponse(std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+  const CesiumAsync::IAssetResponse* pResponse =
+      pRequest ? pRequest->response() : nullptr;
+  if (!pResponse) {
+    return std::move(pRequest);
+  }
+
+  const CesiumAsync::HttpHeaders& headers = pResponse->headers();
+  auto it = headers.find("Content-Encoding");
+  if (it == headers.end()) {
+    return std::move(pRequest);
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DecodeResponse)
+
+  const gsl::span<const std::byte> encoded = pResponse->data();
+  std::optional<std::vector<std::byte>> maybeDecoded =
+      CesiumContentEncodingAssetAccessor::decode(it->second, encoded);
+  if (!maybeDecoded) {
+    // This is usually a response that the HTTP module already decoded, and
+    // that is passed on as it is.
+    return std::move(pRequest);
+  }
+
+  totalEncodedBytes += int64_t(encoded.size());
+  totalDecodedBytes += int64_t(maybeDecoded->size());
+  INC_MEMORY_STAT_BY(STAT_CesiumHttpEncodedBytes, encoded.size());
+  INC_MEMORY_STAT_BY(STAT_CesiumHttpDecodedBytes, maybeDecoded->size());
+
+  return std::make_shared<DecodedAssetRequest>(
+      pRequest,
+      std::move(*maybeDecoded));
+}
+
+} // namespace
+
+CesiumContentEncodingAssetAccessor::CesiumContentEncodingAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::string& acceptEncoding)
+    : _pAssetAccessor(pAssetAccessor), _acceptEncoding(acceptEncoding) {}
+
+/*static*/ void CesiumContentEncodingAssetAccessor::registerDecoder(
+    const std::string& encoding,
+    Decoder&& decoder) {
+  DecoderRegistry::get().add(encoding, std::move(decoder));
+}
+
+/*static*/ bool
+CesiumContentEncodingAssetAccessor::canDecode(const std::string& encoding) {
+  const std::string name = trimAndLower(encoding);
+  return name == "identity" || DecoderRegistry::get().find(name).has_value();
+}
+
+/*static*/ std::string CesiumContentEncodingAssetAccessor::filterAcceptEncoding(
+    const std::string& acceptEncoding) {
+  std::string result;
+  for (const std::string& item : splitList(acceptEncoding)) {
+    // Each encoding may be followed by a quality value, such as "gzip;q=0.5".
+    if (!canDecode(item.substr(0, item.find(';')))) {
+      continue;
+    }
+    if (!result.empty()) {
+      result += ", ";
+    }
+    result += item;
+  }
+  return result;
+}
+
+/*static*/ std::optional<std::vector<std::byte>>
+CesiumContentEncodingAssetAccessor::decode(
+    const std::string& contentEncoding,
+    const gsl::span<const std::byte>& encoded) {
+  std::vector<std::string> encodings = splitList(contentEncoding);
+  encodings.erase(
+      std::remove(encodings.begin(), encodings.end(), "identity"),
+      encodings.end());
+  if (encodings.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<Decoder> decoders;
+  decoders.reserve(encodings.size());
+  for (const std::string& encoding : encodings) {
+    std::optional<Decoder> maybeDecoder = DecoderRegistry::get().find(encoding);
+    if (!maybeDecoder) {
+      return std::nullopt;
+    }
+    decoders.emplace_back(std::move(*maybeDecoder));
+  }
+
+  // The last encoding listed is the last one that was applied.
+  std::vector<std::byte> decoded;
+  std::vector<std::byte> previous;
+  gsl::span<const std::byte> data = encoded;
+  for (auto it = decoders.rbegin(); it != decoders.rend(); ++it) {
+    std::swap(previous, decoded);
+    decoded.clear();
+    if (!(*it)(data, decoded)) {
+      return std::nullopt;
+    }
+    data = gsl::span<const std::byte>(decoded);
+  }
+
+  return decoded;
+}
+
+/*static*/ int64_t CesiumContentEncodingAssetAccessor::getTotalEncodedBytes() {
+  return totalEncodedBytes;
+}
+
+/*static*/ int64_t CesiumContentEncodingAssetAccessor::getTotalDecodedBytes() {
+  return totalDecodedBytes;
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumContentEncodingAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  const std::string acceptEncoding =
+      filterAcceptEncoding(this->_acceptEncoding);
+  const bool hasAcceptEncoding = std::any_of(
+      headers.begin(),
+      headers.end(),
+      [](const CesiumAsync::IAssetAccessor::THeader& header) {
+        return trimAndLower(header.first) == "accept-encoding";
+      });
+
+  if (acceptEncoding.empty() || hasAcceptEncoding) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers)
+        .thenInWorkerThread(decodeResponse);
+  }
+
+  std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders = headers;
+  requestHeaders.emplace_back("Accept-Encoding", acceptEncoding);
+  return this->_pAssetAccessor->get(asyncSystem, url, requestHeaders)
+      .thenInWorkerThread(decodeResponse);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumContentEncodingAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload)
+      .thenInWorkerThread(decodeResponse);
+}
+
+void CesiumContentEncodingAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
@@ -1,12 +1,14 @@
 // Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "CesiumCreditSystem.h"
+#include "CesiumMainThreadDispatcher.h"
 #include "CesiumCreditSystemBPLoader.h"
 #include "CesiumRuntime.h"
 #include "CesiumUtility/CreditSystem.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "ScreenCreditsWidget.h"
+#include <algorithm>
 #include <string>
 #include <tidybuffio.h>
 #include <vector>
@@ -169,7 +171,8 @@ ACesiumCreditSystem::GetDefaultCreditSystem(const UObject* WorldContextObject) {
 ACesiumCreditSystem::ACesiumCreditSystem()
     : AActor(),
       _pCreditSystem(std::make_shared<CesiumUtility::CreditSystem>()),
-      _lastCreditsCount(0) {
+      _lastCredits(),
+      _lastCreditsRtf() {
   PrimaryActorTick.bCanEverTick = true;
 #if WITH_EDITOR
   this->SetIsSpatiallyLoaded(false);
@@ -253,6 +256,13 @@ void ACesiumCreditSystem::updateCreditsViewport(bool recreateWidget) {
   if (!IsValid(CreditsWidget) || recreateWidget) {
     CreditsWidget =
         CreateWidget<UScreenCreditsWidget>(GetWorld(), CreditsWidgetClass);
+
+    // The RTF of credits with images refers to images loaded by the widget,
+    // so a new widget needs all of the credits to be converted again.
+    this->_lastCredits.clear();
+    this->_lastCreditsRtf.clear();
+    this->_htmlToRtf.clear();
+    this->_htmlBeingConverted.clear();
   }
 
 #if WITH_EDITOR
@@ -319,6 +329,23 @@ void ACesiumCreditSystem::OnCleanseEditor() {
 
 bool ACesiumCreditSystem::ShouldTickIfViewportsOnly() const { return true; }
 
+namespace {
+bool haveSameCredits(
+    const std::vector<CesiumUtility::Credit>& a,
+    const std::vector<CesiumUtility::Credit>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  // There are only ever a few dozen credits, so this is cheaper than hashing.
+  for (const CesiumUtility::Credit& credit : a) {
+    if (std::find(b.begin(), b.end(), credit) == b.end()) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 void ACesiumCreditSystem::Tick(float DeltaTime) {
   Super::Tick(DeltaTime);
 
@@ -329,30 +356,46 @@ void ACesiumCreditSystem::Tick(float DeltaTime) {
   const std::vector<CesiumUtility::Credit>& creditsToShowThisFrame =
       _pCreditSystem->getCreditsToShowThisFrame();
 
-  // if the credit list has changed, we want to reformat the credits
-  CreditsUpdated =
-      creditsToShowThisFrame.size() != _lastCreditsCount ||
-      _pCreditSystem->getCreditsToNoLongerShowThisFrame().size() > 0;
+  // Credits are compared as a set, because their order changes whenever the
+  // number of tiles that reference them does, which can be every frame. Only
+  // a credit being added or removed changes what's shown.
+  CreditsUpdated = !haveSameCredits(creditsToShowThisFrame, _lastCredits);
 
   if (CreditsUpdated) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateCredits)
+
+    std::vector<FString> creditsRtf;
+    creditsRtf.reserve(creditsToShowThisFrame.size());
+
     FString OnScreenCredits;
     FString Credits;
 
-    _lastCreditsCount = creditsToShowThisFrame.size();
-
     bool firstCreditOnScreen = true;
     for (int i = 0; i < creditsToShowThisFrame.size(); i++) {
       const CesiumUtility::Credit& credit = creditsToShowThisFrame[i];
 
-      FString CreditRtf;
-      const std::string& html = _pCreditSystem->getHtml(credit);
-
-      auto htmlFind = _htmlToRtf.find(html);
-      if (htmlFind != _htmlToRtf.end()) {
-        CreditRtf = htmlFind->second;
+      auto lastFind =
+          std::find(_lastCredits.begin(), _lastCredits.end(), credit);
+      if (lastFind != _lastCredits.end()) {
+        creditsRtf.emplace_back(
+            MoveTemp(_lastCreditsRtf[lastFind - _lastCredits.begin()]));
       } else {
-        CreditRtf = ConvertHtmlToRtf(html);
-        _htmlToRtf.insert({html, CreditRtf});
+        const std::string& html = _pCreditSystem->getHtml(credit);
+        auto htmlFind = _htmlToRtf.find(html);
+        if (htmlFind != _htmlToRtf.end()) {
+          creditsRtf.emplace_back(htmlFind->second);
+        } else {
+          // The credit is left out until it has been converted, which
+          // triggers another update.
+          if (_htmlBeingConverted.insert(html).second) {
+            ConvertHtmlToRtfAsync(html);
+          }
+          creditsRtf.emplace_back();
+        }
+      }
+      const FString& CreditRtf = creditsRtf.back();
+      if (CreditRtf.IsEmpty()) {
+        continue;
       }
 
       if (_pCreditSystem->shouldBeShownOnScreen(credit)) {
@@ -364,7 +407,7 @@ void ACesiumCreditSystem::Tick(float DeltaTime) {
 
         OnScreenCredits += CreditRtf;
       } else {
-        if (i != 0) {
+        if (!Credits.IsEmpty()) {
           Credits += "\n";
         }
 
@@ -376,18 +419,28 @@ void ACesiumCreditSystem::Tick(float DeltaTime) {
       OnScreenCredits += "<credits url=\"popup\" text=\" Data attribution\"/>";
     }
 
+    _lastCredits = creditsToShowThisFrame;
+    _lastCreditsRtf = std::move(creditsRtf);
+
     CreditsWidget->SetCredits(Credits, OnScreenCredits);
   }
   _pCreditSystem->startNextFrame();
 }
 
 namespace {
+
+// The RTF of a credit, with the images it refers to still to be loaded by
+// the credits widget. Each image's ID goes at its offset in the RTF.
+struct ConvertedCreditHtml {
+  std::string rtf;
+  std::vector<std::pair<size_t, std::string>> images;
+};
+
 void convertHtmlToRtf(
-    std::string& output,
+    ConvertedCreditHtml& output,
     std::string& parentUrl,
     TidyDoc tdoc,
-    TidyNode tnod,
-    UScreenCreditsWidget* CreditsWidget) {
+    TidyNode tnod) {
   TidyNode child;
   TidyBuffer buf;
   tidyBufInit(&buf);
@@ -402,10 +455,10 @@ void convertHtmlToRtf(
           text.pop_back();
         }
         if (!parentUrl.empty()) {
-          output +=
+          output.rtf +=
               "<credits url=\"" + parentUrl + "\"" + " text=\"" + text + "\"/>";
         } else {
-          output += text;
+          output.rtf += text;
         }
       }
     } else if (tidyNodeGetId(child) == TidyTagId::TidyTag_IMG) {
@@ -413,14 +466,15 @@ void convertHtmlToRtf(
       if (srcAttr) {
         auto srcValue = tidyAttrValue(srcAttr);
         if (srcValue) {
-          output += "<credits id=\"" +
-                    CreditsWidget->LoadImage(
-                        std::string(reinterpret_cast<const char*>(srcValue))) +
-                    "\"";
+          output.rtf += "<credits id=\"";
+          output.images.emplace_back(
+              output.rtf.size(),
+              std::string(reinterpret_cast<const char*>(srcValue)));
+          output.rtf += "\"";
           if (!parentUrl.empty()) {
-            output += " url=\"" + parentUrl + "\"";
+            output.rtf += " url=\"" + parentUrl + "\"";
           }
-          output += "/>";
+          output.rtf += "/>";
         }
       }
     }
@@ -429,13 +483,14 @@ void convertHtmlToRtf(
       auto hrefValue = tidyAttrValue(hrefAttr);
       parentUrl = std::string(reinterpret_cast<const char*>(hrefValue));
     }
-    convertHtmlToRtf(output, parentUrl, tdoc, child, CreditsWidget);
+    convertHtmlToRtf(output, parentUrl, tdoc, child);
   }
   tidyBufFree(&buf);
 }
-} // namespace
 
-FString ACesiumCreditSystem::ConvertHtmlToRtf(std::string html) {
+ConvertedCreditHtml convertHtmlToRtf(std::string html) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ConvertCreditHtmlToRtf)
+
   TidyDoc tdoc;
   TidyBuffer tidy_errbuf = {0};
   int err;
@@ -449,12 +504,53 @@ FString ACesiumCreditSystem::ConvertHtmlToRtf(std::string html) {
 
   html = "<!DOCTYPE html><html><body>" + html + "</body></html>";
 
-  std::string output, url;
+  ConvertedCreditHtml output;
+  std::string url;
   err = tidyParseString(tdoc, html.c_str());
   if (err < 2) {
-    convertHtmlToRtf(output, url, tdoc, tidyGetRoot(tdoc), CreditsWidget);
+    convertHtmlToRtf(output, url, tdoc, tidyGetRoot(tdoc));
   }
   tidyBufFree(&tidy_errbuf);
   tidyRelease(tdoc);
-  return UTF8_TO_TCHAR(output.c_str());
+  return output;
+}
+
+} // namespace
+
+void ACesiumCreditSystem::ConvertHtmlToRtfAsync(const std::string& html) {
+  // Parsing the HTML with tidy is slow enough to cause a hitch when many
+  // credits appear at once, so it's done in a worker thread. The images are
+  // loaded by the widget, which must happen on the game thread.
+  getAsyncSystem()
+      .runInWorkerThread([html]() { return convertHtmlToRtf(html); })
+      .thenInMainThread([pWeakThis = TWeakObjectPtr<ACesiumCreditSystem>(this),
+                         html](ConvertedCreditHtml&& converted) mutable {
+        // A credit showing up a few frames late isn't noticeable.
+        CesiumMainThreadDispatcher::get().post(
+            CesiumMainThreadDispatcher::Priority::Low,
+            [pWeakThis,
+             html = std::move(html),
+             converted = std::move(converted)]() mutable {
+              ACesiumCreditSystem* pThis = pWeakThis.Get();
+              if (!pThis || !IsValid(pThis->CreditsWidget) ||
+                  pThis->_htmlBeingConverted.erase(html) == 0) {
+                return;
+              }
+
+              std::string& rtf = converted.rtf;
+              for (auto it = converted.images.rbegin();
+                   it != converted.images.rend();
+                   ++it) {
+                rtf.insert(
+                    it->first,
+                    pThis->CreditsWidget->LoadImage(it->second));
+              }
+
+              pThis->_htmlToRtf.insert({html, UTF8_TO_TCHAR(rtf.c_str())});
+
+              // Rebuild the credits on the next tick, now including this one.
+              pThis->_lastCredits.clear();
+              pThis->_lastCreditsRtf.clear();
+            });
+      });
 }
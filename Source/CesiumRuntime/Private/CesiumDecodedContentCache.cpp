@@ -0,0 +1,273 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumDecodedContentCache.h"
+#include "Cesium3DTilesContent/GltfConverterResult.h"
+#include "Cesium3DTilesContent/GltfConverters.h"
+#include "CesiumContentDecoding.h"
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "Hash/CityHash.h"
+#include <array>
+
+using namespace Cesium3DTilesContent;
+
+DECLARE_MEMORY_STAT(
+    TEXT("Decoded Tile Content Cache"),
+    STAT_CesiumDecodedContentCacheBytes,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Decoded Tile Content Cache Hits"),
+    STAT_CesiumDecodedContentCacheHits,
+    STATGROUP_Cesium);
+
+namespace {
+
+// The converters registered by cesium-native, which decode the content that
+// isn't found in the cache.
+GltfConverters::ConverterFunction originalBinaryGltfConverter = nullptr;
+GltfConverters::ConverterFunction originalB3dmConverter = nullptr;
+
+// Finishes decoding content even if its converter throws.
+struct DecodingScope {
+  CesiumDecodedContentCache& cache;
+  uint64_t key;
+  ~DecodingScope() { cache.finishDecoding(key); }
+};
+
+GltfConverterResult fromCache(CesiumGltf::Model&& model) {
+  INC_DWORD_STAT(STAT_CesiumDecodedContentCacheHits);
+  GltfConverterResult result;
+  result.model = std::move(model);
+  return result;
+}
+
+// Decodes content with cesium-native's converter, within the limit on
+// compressed content being decoded at once.
+GltfConverterResult decode(
+    GltfConverters::ConverterFunction original,
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  return CesiumContentDecoding::decode(content, [&]() {
+    return original(content, options);
+  });
+}
+
+GltfConverterResult convertWithCache(
+    GltfConverters::ConverterFunction original,
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  const int64_t maximumBytes =
+      GetDefault<UCesiumRuntimeSettings>()->DecodedTileContentCacheBytes;
+  if (maximumBytes <= 0) {
+    return decode(original, content, options);
+  }
+
+  CesiumDecodedContentCache& cache = CesiumDecodedContentCache::get();
+  const uint64_t key = CesiumDecodedContentCache::getKey(content, options);
+
+  std::optional<CesiumGltf::Model> cached = cache.find(key);
+  if (!cached) {
+    // If another tileset is decoding the same content, its model is waited
+    // for rather than decoded again.
+    std::shared_future<void> decoding;
+    if (cache.startDecoding(key, decoding)) {
+      DecodingScope scope{cache, key};
+      // Another thread may have finished decoding it in the meantime.
+      cached = cache.find(key);
+      if (cached) {
+        return fromCache(std::move(*cached));
+      }
+
+      GltfConverterResult result = decode(original, content, options);
+      // Content with errors is decoded again each time, so that its errors
+      // are reported each time.
+      if (result.model && !result.errors.hasErrors()) {
+        cache.add(key, *result.model, maximumBytes);
+        SET_MEMORY_STAT(STAT_CesiumDecodedContentCacheBytes, cache.getBytes());
+      }
+      return result;
+    }
+
+    decoding.wait();
+    cached = cache.find(key);
+    if (!cached) {
+      return decode(original, content, options);
+    }
+  }
+
+  return fromCache(std::move(*cached));
+}
+
+GltfConverterResult convertBinaryGltf(
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  return convertWithCache(originalBinaryGltfConverter, content, options);
+}
+
+GltfConverterResult convertB3dm(
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  return convertWithCache(originalB3dmConverter, content, options);
+}
+
+GltfConverters::ConverterFunction findConverterByMagic(const char* magic) {
+  std::array<std::byte, 4> header;
+  for (size_t i = 0; i < header.size(); ++i) {
+    header[i] = std::byte(magic[i]);
+  }
+  return GltfConverters::getConverterByMagic(header);
+}
+
+} // namespace
+
+/*static*/ CesiumDecodedContentCache& CesiumDecodedContentCache::get() {
+  static CesiumDecodedContentCache cache;
+  return cache;
+}
+
+/*static*/ void CesiumDecodedContentCache::registerConverters() {
+  // Composite tiles aren't wrapped, because their inner tiles are converted
+  // through these converters and are cached individually.
+  originalBinaryGltfConverter = findConverterByMagic("glTF");
+  if (originalBinaryGltfConverter &&
+      originalBinaryGltfConverter != convertBinaryGltf) {
+    GltfConverters::registerMagic("glTF", convertBinaryGltf);
+    if (GltfConverters::getConverterByFileExtension("content.glb") ==
+        originalBinaryGltfConverter) {
+      GltfConverters::registerFileExtension(".glb", convertBinaryGltf);
+    }
+  }
+
+  originalB3dmConverter = findConverterByMagic("b3dm");
+  if (originalB3dmConverter && originalB3dmConverter != convertB3dm) {
+    GltfConverters::registerMagic("b3dm", convertB3dm);
+  }
+}
+
+/*static*/ uint64_t CesiumDecodedContentCache::getKey(
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  const uint64_t optionBits = uint64_t(options.decodeDataUrls) |
+                              uint64_t(options.clearDecodedDataUrls) << 1 |
+                              uint64_t(options.decodeEmbeddedImages) << 2 |
+                              uint64_t(options.resolveExternalImages) << 3 |
+                              uint64_t(options.decodeDraco) << 4;
+  return CityHash64WithSeeds(
+      reinterpret_cast<const char*>(content.data()),
+      uint32(content.size()),
+      uint64_t(content.size()),
+      optionBits);
+}
+
+/*static*/ int64_t
+CesiumDecodedContentCache::getModelBytes(const CesiumGltf::Model& model) {
+  int64_t bytes = int64_t(sizeof(CesiumGltf::Model));
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    bytes += int64_t(buffer.cesium.data.size());
+  }
+  for (const CesiumGltf::Image& image : model.images) {
+    bytes += int64_t(image.cesium.pixelData.size());
+  }
+  bytes += int64_t(model.accessors.size() * sizeof(CesiumGltf::Accessor));
+  bytes += int64_t(model.meshes.size() * sizeof(CesiumGltf::Mesh));
+  bytes += int64_t(model.nodes.size() * sizeof(CesiumGltf::Node));
+  return bytes;
+}
+
+std::optional<CesiumGltf::Model>
+CesiumDecodedContentCache::find(uint64_t key) {
+  std::shared_ptr<const CesiumGltf::Model> pModel;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(key);
+    if (it == this->_entries.end()) {
+      return std::nullopt;
+    }
+
+    // Move the model to the most recently used end.
+    this->_order.splice(this->_order.end(), this->_order, it->second);
+    pModel = it->second->pModel;
+  }
+
+  ++this->_hitCount;
+
+  // The copy is made without holding the lock, because it can be large.
+  return *pModel;
+}
+
+void CesiumDecodedContentCache::add(
+    uint64_t key,
+    const CesiumGltf::Model& model,
+    int64_t maximumBytes) {
+  const int64_t bytes = getModelBytes(model);
+  if (bytes > maximumBytes / 4) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_entries.find(key) != this->_entries.end()) {
+      return;
+    }
+  }
+
+  std::shared_ptr<const CesiumGltf::Model> pModel =
+      std::make_shared<const CesiumGltf::Model>(model);
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (this->_entries.find(key) != this->_entries.end()) {
+    return;
+  }
+
+  this->_order.push_back(Entry{key, std::move(pModel), bytes});
+  this->_entries.emplace(key, std::prev(this->_order.end()));
+  this->_bytes += bytes;
+
+  while (this->_bytes > maximumBytes && !this->_order.empty()) {
+    const Entry& oldest = this->_order.front();
+    this->_bytes -= oldest.bytes;
+    this->_entries.erase(oldest.key);
+    this->_order.pop_front();
+  }
+}
+
+bool CesiumDecodedContentCache::startDecoding(
+    uint64_t key,
+    std::shared_future<void>& decoding) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->_decoding.find(key);
+  if (it != this->_decoding.end()) {
+    decoding = it->second.future;
+    return false;
+  }
+
+  Decoding& started = this->_decoding[key];
+  started.future = started.promise.get_future().share();
+  return true;
+}
+
+void CesiumDecodedContentCache::finishDecoding(uint64_t key) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->_decoding.find(key);
+  if (it != this->_decoding.end()) {
+    it->second.promise.set_value();
+    this->_decoding.erase(it);
+  }
+}
+
+void CesiumDecodedContentCache::clear() {
+  std::list<Entry> order;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    order.swap(this->_order);
+    this->_entries.clear();
+    this->_bytes = 0;
+  }
+  SET_MEMORY_STAT(STAT_CesiumDecodedContentCacheBytes, 0);
+}
+
+int64_t CesiumDecodedContentCache::getBytes() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_bytes;
+}
@@ -0,0 +1,137 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGltf/Model.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <gsl/span>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace CesiumGltfReader {
+struct GltfReaderOptions;
+}
+
+/**
+ * Keeps the glTF models most recently decoded from tile content, up to
+ * "Decoded Tile Content Cache Bytes" of them, so that a tileset that loads
+ * the same content again gets a copy of the decoded model instead of
+ * decoding it again.
+ *
+ * Decoding a tile's glTF, including its Draco meshes and its images, is most
+ * of the background work of loading it. Starting Play-In-Editor duplicates
+ * the world, and refreshing a tileset recreates it, and either way every tile
+ * that was just loaded is loaded again. Their content then comes from the
+ * request cache, and with this, their decoded models come from here.
+ *
+ * Models are found by a hash of the tile content and of the options it was
+ * read with, so the same content is shared by every tileset and every world.
+ * Textures that are still in use by another world are shared through
+ * CesiumTextureCache as well, when the tileset shares identical textures.
+ *
+ * When several tilesets load the same content at the same time, such as a
+ * tileset that is only used for collision next to the one that is rendered,
+ * only one of them decodes it, and the others wait for its model.
+ *
+ * All functions may be called from any thread.
+ */
+class CesiumDecodedContentCache {
+public:
+  /**
+   * Gets the cache shared by all tilesets.
+   */
+  static CesiumDecodedContentCache& get();
+
+  /**
+   * Replaces cesium-native's converters for binary glTF and Batched 3D Model
+   * content with ones that use this cache, and that decode compressed content
+   * within the limit of CesiumContentDecoding. This must be called after the
+   * tile content types are registered.
+   */
+  static void registerConverters();
+
+  /**
+   * Gets the key that identifies content read with the given options.
+   */
+  static uint64_t getKey(
+      const gsl::span<const std::byte>& content,
+      const CesiumGltfReader::GltfReaderOptions& options);
+
+  /**
+   * Gets the approximate number of bytes of memory used by a model.
+   */
+  static int64_t getModelBytes(const CesiumGltf::Model& model);
+
+  /**
+   * Gets a copy of the model with the given key, or std::nullopt if it isn't
+   * in the cache.
+   */
+  std::optional<CesiumGltf::Model> find(uint64_t key);
+
+  /**
+   * Adds a copy of the model with the given key, and removes the least
+   * recently used models until the cache is no larger than the maximum
+   * number of bytes. A model larger than a quarter of the maximum isn't
+   * added.
+   */
+  void add(
+      uint64_t key,
+      const CesiumGltf::Model& model,
+      int64_t maximumBytes);
+
+  /**
+   * Starts decoding the content with the given key, unless it is already
+   * being decoded.
+   *
+   * @return True if the caller must decode the content and then call {@link
+   * finishDecoding}. False if another thread is already decoding it, in which
+   * case the caller can wait for the given future before looking for its
+   * model.
+   */
+  bool startDecoding(uint64_t key, std::shared_future<void>& decoding);
+
+  /**
+   * Finishes decoding the content with the given key, whether or not its model
+   * was added, and releases the threads waiting for it.
+   */
+  void finishDecoding(uint64_t key);
+
+  /**
+   * Removes every model from the cache.
+   */
+  void clear();
+
+  /**
+   * Gets the approximate number of bytes of the models in the cache.
+   */
+  int64_t getBytes() const;
+
+  /**
+   * Gets the number of times a model was found in the cache.
+   */
+  int64_t getHitCount() const { return this->_hitCount; }
+
+private:
+  struct Entry {
+    uint64_t key;
+    std::shared_ptr<const CesiumGltf::Model> pModel;
+    int64_t bytes;
+  };
+
+  mutable std::mutex _mutex;
+  std::list<Entry> _order;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> _entries;
+  int64_t _bytes = 0;
+  std::atomic<int64_t> _hitCount = 0;
+
+  struct Decoding {
+    std::promise<void> promise;
+    std::shared_future<void> future;
+  };
+  std::unordered_map<uint64_t, Decoding> _decoding;
+};
@@ -0,0 +1,398 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumDepthPicking.h"
+#include "Cesium3DTileset.h"
+#include "CesiumGltfPointsComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "CoreGlobals.h"
+#include "Engine/HitResult.h"
+#include "GlobalShader.h"
+#include "GltfAccessors.h"
+#include "RHIGPUReadback.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderingThread.h"
+#include "Runtime/Renderer/Private/SceneRendering.h"
+#include "SceneView.h"
+#include "ShaderParameterStruct.h"
+
+namespace {
+
+constexpr int32 DepthPickingThreadGroupSize = 64;
+
+// A pick whose view hasn't been rendered after this many frames misses, such
+// as when its view target isn't viewed by any player.
+constexpr uint64 MaximumPickFrames = 30;
+
+// Results that no tileset has taken after this many frames are discarded,
+// such as when the tileset that requested them was destroyed.
+constexpr uint64 MaximumResultFrames = 60;
+
+} // namespace
+
+class FCesiumDepthPickingCS : public FGlobalShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumDepthPickingCS);
+  SHADER_USE_PARAMETER_STRUCT(FCesiumDepthPickingCS, FGlobalShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER(uint32, NumPicks)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneDepthTexture)
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FUintVector2>, PickPixels)
+  SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<float>, RWPickDepths)
+  END_SHADER_PARAMETER_STRUCT()
+
+  static bool ShouldCompilePermutation(
+      const FGlobalShaderPermutationParameters& Parameters) {
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+  }
+};
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumDepthPickingCS,
+    "/Plugin/CesiumForUnreal/Private/CesiumDepthPicking.usf",
+    "MainCS",
+    SF_Compute);
+
+CesiumDepthPicking::CesiumDepthPicking() {}
+
+CesiumDepthPicking::~CesiumDepthPicking() {}
+
+uint64 CesiumDepthPicking::requestPick(
+    const AActor* pViewActor,
+    const FVector2D& screenPosition) {
+  check(IsInGameThread());
+
+  const uint64 pickId = this->_nextPickId++;
+  this->_newRequests.Add(
+      Request{pickId, pViewActor, screenPosition, GFrameCounter});
+  return pickId;
+}
+
+bool CesiumDepthPicking::takeResult(uint64 pickId, Result& result) {
+  check(IsInGameThread());
+
+  if (!this->_results.RemoveAndCopyValue(pickId, result)) {
+    return false;
+  }
+
+  this->_resultFrames.Remove(pickId);
+  return true;
+}
+
+void CesiumDepthPicking::beginRenderViewFamily() {
+  check(IsInGameThread());
+
+  TPair<uint64, Result> result;
+  while (this->_resultsQueue.Dequeue(result)) {
+    this->_results.Add(result.Key, result.Value);
+    this->_resultFrames.Add(result.Key, GFrameCounter);
+  }
+
+  for (auto it = this->_resultFrames.CreateIterator(); it; ++it) {
+    if (GFrameCounter > it->Value + MaximumResultFrames) {
+      this->_results.Remove(it->Key);
+      it.RemoveCurrent();
+    }
+  }
+
+  if (this->_newRequests.IsEmpty()) {
+    return;
+  }
+
+  ENQUEUE_RENDER_COMMAND(CesiumAddDepthPicks)
+  ([this, requests = MoveTemp(this->_newRequests)](
+       FRHICommandListImmediate& RHICmdList) {
+    this->_requests_renderThread.Append(requests);
+  });
+  this->_newRequests.Reset();
+}
+
+void CesiumDepthPicking::postRenderBasePass_RenderThread(
+    FRDGBuilder& graphBuilder,
+    const FSceneView& view,
+    FRDGTextureRef pSceneDepth) {
+  if (this->_requests_renderThread.IsEmpty() || !pSceneDepth) {
+    return;
+  }
+
+  // Screen positions are in the unscaled view rectangle, but the scene depth
+  // is at the view's rendering resolution.
+  const FIntRect& unscaledRect = view.UnscaledViewRect;
+  const FIntRect& viewRect = static_cast<const FViewInfo&>(view).ViewRect;
+  const FVector2D unscaledSize(unscaledRect.Size());
+  if (unscaledSize.X <= 0.0 || unscaledSize.Y <= 0.0) {
+    return;
+  }
+  const FVector2D scale = FVector2D(viewRect.Size()) / unscaledSize;
+
+  PendingReadback pending;
+  TArray<FUintVector2> pixels;
+  for (int32 i = 0; i < this->_requests_renderThread.Num();) {
+    const Request& request = this->_requests_renderThread[i];
+    const FVector2D relative =
+        request.screenPosition - FVector2D(unscaledRect.Min);
+    if (request.pViewActor != view.ViewActor || relative.X < 0.0 ||
+        relative.Y < 0.0 || relative.X >= unscaledSize.X ||
+        relative.Y >= unscaledSize.Y) {
+      ++i;
+      continue;
+    }
+
+    const FIntPoint pixel =
+        viewRect.Min +
+        FIntPoint(
+            FMath::FloorToInt32(relative.X * scale.X),
+            FMath::FloorToInt32(relative.Y * scale.Y));
+    pixels.Add(FUintVector2(uint32(pixel.X), uint32(pixel.Y)));
+    pending.ids.Add(request.id);
+    pending.clipPositions.Add(FVector2D(
+        2.0 * relative.X / unscaledSize.X - 1.0,
+        1.0 - 2.0 * relative.Y / unscaledSize.Y));
+
+    this->_requests_renderThread.RemoveAtSwap(i);
+  }
+
+  if (pixels.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReadPickDepths)
+
+  const int32 pickCount = pixels.Num();
+  FRDGBufferRef pDepths = graphBuilder.CreateBuffer(
+      FRDGBufferDesc::CreateStructuredDesc(sizeof(float), pickCount),
+      TEXT("CesiumDepthPickingDepths"));
+
+  FCesiumDepthPickingCS::FParameters* pParameters =
+      graphBuilder.AllocParameters<FCesiumDepthPickingCS::FParameters>();
+  pParameters->NumPicks = uint32(pickCount);
+  pParameters->SceneDepthTexture = pSceneDepth;
+  pParameters->PickPixels = graphBuilder.CreateSRV(CreateStructuredBuffer(
+      graphBuilder,
+      TEXT("CesiumDepthPickingPixels"),
+      sizeof(FUintVector2),
+      pickCount,
+      pixels.GetData(),
+      pixels.Num() * sizeof(FUintVector2)));
+  pParameters->RWPickDepths = graphBuilder.CreateUAV(pDepths);
+
+  TShaderMapRef<FCesiumDepthPickingCS> shader(
+      GetGlobalShaderMap(view.GetFeatureLevel()));
+  FComputeShaderUtils::AddPass(
+      graphBuilder,
+      RDG_EVENT_NAME("CesiumDepthPicking"),
+      shader,
+      pParameters,
+      FComputeShaderUtils::GetGroupCount(
+          pickCount,
+          DepthPickingThreadGroupSize));
+
+  pending.invViewProjection = view.ViewMatrices.GetInvViewProjectionMatrix();
+  pending.viewOrigin = view.ViewMatrices.GetViewOrigin();
+  pending.pReadback =
+      MakeUnique<FRHIGPUBufferReadback>(TEXT("CesiumDepthPickingReadback"));
+  AddEnqueueCopyPass(
+      graphBuilder,
+      pending.pReadback.Get(),
+      pDepths,
+      pickCount * sizeof(float));
+
+  this->_pendingReadbacks_renderThread.Add(MoveTemp(pending));
+}
+
+void CesiumDepthPicking::postRenderViewFamily_RenderThread() {
+  this->pollReadbacks_RenderThread();
+
+  for (int32 i = 0; i < this->_requests_renderThread.Num();) {
+    const Request& request = this->_requests_renderThread[i];
+    if (GFrameCounterRenderThread > request.frame + MaximumPickFrames) {
+      this->_resultsQueue.Enqueue(TPair<uint64, Result>(request.id, Result()));
+      this->_requests_renderThread.RemoveAtSwap(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+void CesiumDepthPicking::pollReadbacks_RenderThread() {
+  // Readbacks complete in the order they were enqueued.
+  while (this->_pendingReadbacks_renderThread.Num() > 0 &&
+         this->_pendingReadbacks_renderThread[0].pReadback->IsReady()) {
+    PendingReadback pending =
+        MoveTemp(this->_pendingReadbacks_renderThread[0]);
+    this->_pendingReadbacks_renderThread.RemoveAt(0);
+
+    const int32 pickCount = pending.ids.Num();
+    const float* pDepths = static_cast<const float*>(
+        pending.pReadback->Lock(pickCount * sizeof(float)));
+
+    for (int32 i = 0; i < pickCount; ++i) {
+      Result result;
+      result.viewOrigin = pending.viewOrigin;
+
+      // With reversed Z, a depth of 0 is the far plane, where nothing was
+      // drawn.
+      const float deviceZ = pDepths[i];
+      if (deviceZ > 0.0f) {
+        const FVector2D& clip = pending.clipPositions[i];
+        const FVector4 world = pending.invViewProjection.TransformFVector4(
+            FVector4(clip.X, clip.Y, deviceZ, 1.0));
+        if (world.W != 0.0) {
+          result.hit = true;
+          result.location = FVector(world) / world.W;
+        }
+      }
+
+      this->_resultsQueue.Enqueue(
+          TPair<uint64, Result>(pending.ids[i], result));
+    }
+
+    pending.pReadback->Unlock();
+  }
+}
+
+namespace {
+
+struct FaceMatch {
+  const UCesiumGltfPrimitiveComponent* pPrimitive = nullptr;
+  int64 faceIndex = -1;
+  FVector location = FVector::ZeroVector;
+  FVector normal = FVector::ZeroVector;
+  double distanceSquared = TNumericLimits<double>::Max();
+};
+
+// Finds the face of a primitive, drawn with the given transform, that's
+// closest to a location.
+void findClosestFace(
+    const UCesiumGltfPrimitiveComponent& primitive,
+    const FTransform& transform,
+    const FVector& location,
+    FaceMatch& match) {
+  const CesiumGltf::AccessorView<FVector3f>& positions =
+      primitive.PositionAccessor;
+  if (positions.status() != CesiumGltf::AccessorViewStatus::Valid) {
+    return;
+  }
+
+  const int64 vertexCount = positions.size();
+  int64 indexCount = vertexCount;
+  if (!std::holds_alternative<std::monostate>(primitive.IndexAccessor)) {
+    indexCount = std::visit(CesiumCountFromAccessor{}, primitive.IndexAccessor);
+  }
+  const int64 faceCount = indexCount / 3;
+
+  const FVector localLocation = transform.InverseTransformPosition(location);
+  for (int64 faceIndex = 0; faceIndex < faceCount; ++faceIndex) {
+    const std::array<int64, 3> vertexIndices = std::visit(
+        CesiumFaceVertexIndicesFromAccessor{faceIndex, vertexCount},
+        primitive.IndexAccessor);
+
+    FVector triangle[3];
+    bool valid = true;
+    for (size_t i = 0; i < vertexIndices.size(); ++i) {
+      const int64 vertexIndex = vertexIndices[i];
+      if (vertexIndex < 0 || vertexIndex >= vertexCount) {
+        valid = false;
+        break;
+      }
+
+      // The Y-component of glTF positions must be inverted
+      const FVector3f& position = positions[vertexIndex];
+      triangle[i] = FVector(position.X, -position.Y, position.Z);
+    }
+
+    if (!valid) {
+      continue;
+    }
+
+    const FVector closest = transform.TransformPosition(
+        FMath::ClosestPointOnTriangleToPoint(
+            localLocation,
+            triangle[0],
+            triangle[1],
+            triangle[2]));
+    const double distanceSquared = FVector::DistSquared(closest, location);
+    if (distanceSquared < match.distanceSquared) {
+      match.pPrimitive = &primitive;
+      match.faceIndex = faceIndex;
+      match.location = closest;
+      match.normal = transform.TransformVectorNoScale(
+          FVector::CrossProduct(
+              triangle[2] - triangle[0],
+              triangle[1] - triangle[0])
+              .GetSafeNormal());
+      match.distanceSquared = distanceSquared;
+    }
+  }
+}
+
+} // namespace
+
+bool findTilesetHit(
+    const ACesium3DTileset& tileset,
+    const CesiumDepthPicking::Result& result,
+    FHitResult& hit) {
+  if (!result.hit) {
+    return false;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FindTilesetHit)
+
+  // The depth is only so precise, and less so farther from the view.
+  const double distance = FVector::Dist(result.location, result.viewOrigin);
+  const double tolerance = 10.0 + 0.005 * distance;
+
+  FaceMatch match;
+  TArray<UCesiumGltfPrimitiveComponent*> primitives;
+  tileset.GetComponents<UCesiumGltfPrimitiveComponent>(primitives);
+  for (const UCesiumGltfPrimitiveComponent* pPrimitive : primitives) {
+    if (!IsValid(pPrimitive) || !pPrimitive->IsVisible() ||
+        pPrimitive->IsA<UCesiumGltfPointsComponent>()) {
+      continue;
+    }
+
+    const UInstancedStaticMeshComponent* pInstances =
+        pPrimitive->InstancesComponent;
+    const FBox bounds =
+        (pInstances ? pInstances->Bounds : pPrimitive->Bounds).GetBox();
+    if (!bounds.ExpandBy(tolerance).IsInside(result.location)) {
+      continue;
+    }
+
+    if (!pInstances) {
+      findClosestFace(
+          *pPrimitive,
+          pPrimitive->GetComponentTransform(),
+          result.location,
+          match);
+      continue;
+    }
+
+    for (int32 i = 0; i < pInstances->GetInstanceCount(); ++i) {
+      FTransform instanceTransform;
+      if (pInstances->GetInstanceTransform(i, instanceTransform, true)) {
+        findClosestFace(*pPrimitive, instanceTransform, result.location, match);
+      }
+    }
+  }
+
+  if (!match.pPrimitive || match.distanceSquared > FMath::Square(tolerance)) {
+    return false;
+  }
+
+  UCesiumGltfPrimitiveComponent* pPrimitive =
+      const_cast<UCesiumGltfPrimitiveComponent*>(match.pPrimitive);
+  hit = FHitResult(
+      pPrimitive->GetOwner(),
+      pPrimitive,
+      match.location,
+      match.normal);
+  hit.bBlockingHit = true;
+  hit.FaceIndex = int32(match.faceIndex);
+  hit.TraceStart = result.viewOrigin;
+  hit.TraceEnd = result.location;
+  hit.Distance = float(FVector::Dist(result.viewOrigin, match.location));
+  return true;
+}
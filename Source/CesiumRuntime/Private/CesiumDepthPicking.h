@@ -0,0 +1,137 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Queue.h"
+#include "Math/Matrix.h"
+#include "Math/Vector.h"
+#include "Math/Vector2D.h"
+#include "RenderGraphDefinitions.h"
+#include "Templates/UniquePtr.h"
+#include <cstdint>
+
+class AActor;
+class ACesium3DTileset;
+class FRHIGPUBufferReadback;
+class FSceneView;
+struct FHitResult;
+
+/**
+ * Picks the surfaces drawn at pixels of a player's view from the view's scene
+ * depth, so that tiles can be picked at the level of detail that's actually
+ * rendered, without collision meshes.
+ *
+ * A pick is requested on the game thread for a pixel of the view of a view
+ * target. The next time that view is rendered, the depth at the pixel is read
+ * in a compute shader after the base pass, and read back asynchronously. The
+ * world position of the surface is then available to the game thread a few
+ * frames later, where it's resolved to a primitive and face with
+ * findTilesetHit.
+ */
+class CesiumDepthPicking {
+public:
+  /**
+   * The result of a pick.
+   */
+  struct Result {
+    /**
+     * Whether anything opaque was drawn at the pixel.
+     */
+    bool hit = false;
+
+    /**
+     * The world position of the surface drawn at the pixel.
+     */
+    FVector location = FVector::ZeroVector;
+
+    /**
+     * The origin of the view that was picked from.
+     */
+    FVector viewOrigin = FVector::ZeroVector;
+  };
+
+  CesiumDepthPicking();
+  ~CesiumDepthPicking();
+
+  /**
+   * Requests a pick at a position of the view that the given actor is the
+   * view target of, in viewport pixels, and returns its ID. Must be called
+   * from the game thread.
+   */
+  uint64 requestPick(const AActor* pViewActor, const FVector2D& screenPosition);
+
+  /**
+   * Takes the result of a pick if it's ready, returning false if it isn't
+   * yet. A pick whose view isn't rendered soon after it's requested misses.
+   * Must be called from the game thread.
+   */
+  bool takeResult(uint64 pickId, Result& result);
+
+  /**
+   * Applies results that have been read back since the last call, and sends
+   * the picks requested since then to the render thread. Must be called from
+   * the game thread before each view family is rendered.
+   */
+  void beginRenderViewFamily();
+
+  /**
+   * Reads the depth for the picks of the given view. Must be called from the
+   * render thread after the view's base pass.
+   */
+  void postRenderBasePass_RenderThread(
+      FRDGBuilder& graphBuilder,
+      const FSceneView& view,
+      FRDGTextureRef pSceneDepth);
+
+  /**
+   * Polls for the depths read in previous frames. Must be called from the
+   * render thread after each view family is rendered.
+   */
+  void postRenderViewFamily_RenderThread();
+
+private:
+  struct Request {
+    uint64 id = 0;
+    const AActor* pViewActor = nullptr;
+    FVector2D screenPosition = FVector2D::ZeroVector;
+    uint64 frame = 0;
+  };
+
+  struct PendingReadback {
+    TArray<uint64> ids;
+    TArray<FVector2D> clipPositions;
+    FMatrix invViewProjection;
+    FVector viewOrigin;
+    TUniquePtr<FRHIGPUBufferReadback> pReadback;
+  };
+
+  void pollReadbacks_RenderThread();
+
+  // Game thread state.
+  TArray<Request> _newRequests;
+  TMap<uint64, Result> _results;
+  TMap<uint64, uint64> _resultFrames;
+  uint64 _nextPickId = 1;
+
+  // Render thread state.
+  TArray<Request> _requests_renderThread;
+  TArray<PendingReadback> _pendingReadbacks_renderThread;
+
+  // A queue to pass results from the render thread to the game thread.
+  TQueue<TPair<uint64, Result>, EQueueMode::Spsc> _resultsQueue;
+};
+
+/**
+ * Finds the face of one of a tileset's visible primitives that's at a picked
+ * location, from the glTF positions and indices that every primitive keeps,
+ * and fills in a hit on it, which can be used with
+ * UCesiumMetadataPickingBlueprintLibrary. Returns false if no face of the
+ * tileset is close enough to the location, because something else was drawn
+ * there. Must be called from the game thread.
+ */
+bool findTilesetHit(
+    const ACesium3DTileset& tileset,
+    const CesiumDepthPicking::Result& result,
+    FHitResult& hit);
@@ -0,0 +1,70 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumDetailGovernor.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace {
+// The time constant of the frame time average, in seconds.
+constexpr double FrameTimeSmoothing = 0.5;
+// The least time between changes to the scale, in seconds, which gives the
+// tile selection time to respond to the last change.
+constexpr double MinimumTimeBetweenChanges = 1.0;
+// The scale is raised when a measurement is over its target, and lowered
+// only when every measurement is under this fraction of its target.
+constexpr double LowerThreshold = 0.85;
+// The factor that each change multiplies or divides the scale by.
+constexpr double ScaleStep = 1.25;
+} // namespace
+
+bool CesiumDetailGovernor::update(
+    const Targets& targets,
+    double frameTime,
+    int64 memoryBytes,
+    double deltaTime) {
+  if (deltaTime <= 0.0) {
+    return false;
+  }
+
+  if (this->_averageFrameTime <= 0.0) {
+    this->_averageFrameTime = frameTime;
+  } else {
+    const double alpha = 1.0 - FMath::Exp(-deltaTime / FrameTimeSmoothing);
+    this->_averageFrameTime += (frameTime - this->_averageFrameTime) * alpha;
+  }
+
+  this->_timeSinceChange += deltaTime;
+  if (this->_timeSinceChange < MinimumTimeBetweenChanges) {
+    return false;
+  }
+
+  const bool hasMemoryLimit = targets.memoryBytes > 0;
+  const bool overFrameTime = this->_averageFrameTime > targets.frameTime;
+  const bool overMemory = hasMemoryLimit && memoryBytes > targets.memoryBytes;
+  const bool underFrameTime =
+      this->_averageFrameTime < targets.frameTime * LowerThreshold;
+  const bool underMemory =
+      !hasMemoryLimit ||
+      double(memoryBytes) < double(targets.memoryBytes) * LowerThreshold;
+
+  const double maximumScale = FMath::Max(targets.maximumScale, 1.0);
+  double scale = this->_scale;
+  if (overFrameTime || overMemory) {
+    scale = FMath::Min(scale * ScaleStep, maximumScale);
+  } else if (underFrameTime && underMemory) {
+    scale = FMath::Max(scale / ScaleStep, 1.0);
+  }
+
+  if (scale == this->_scale) {
+    return false;
+  }
+
+  this->_scale = scale;
+  this->_timeSinceChange = 0.0;
+  return true;
+}
+
+void CesiumDetailGovernor::reset() {
+  this->_scale = 1.0;
+  this->_averageFrameTime = 0.0;
+  this->_timeSinceChange = 0.0;
+}
@@ -0,0 +1,77 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+/**
+ * Adjusts the level of detail of a tileset in a closed loop, so that the
+ * frame time stays near a target and the tileset's memory stays under a
+ * limit. The level of detail is lowered by multiplying the maximum
+ * screen-space error by a scale, which is raised by a step while either
+ * target is exceeded and lowered again once both are comfortably met. The
+ * gap between the two thresholds, and the minimum time between changes, keep
+ * the scale from oscillating.
+ */
+class CesiumDetailGovernor {
+public:
+  struct Targets {
+    /**
+     * The frame time to stay under, in seconds.
+     */
+    double frameTime;
+
+    /**
+     * The number of bytes to stay under, or 0 for no memory limit.
+     */
+    int64 memoryBytes;
+
+    /**
+     * The largest screen-space error scale to use.
+     */
+    double maximumScale;
+  };
+
+  /**
+   * Feeds in the measurements of the latest frame.
+   *
+   * @param targets What to keep the measurements under.
+   * @param frameTime The time the frame took, in seconds.
+   * @param memoryBytes The memory used by the tileset, in bytes.
+   * @param deltaTime The time since the last update, in seconds.
+   * @return True if the scale changed.
+   */
+  bool update(
+      const Targets& targets,
+      double frameTime,
+      int64 memoryBytes,
+      double deltaTime);
+
+  /**
+   * Goes back to the full level of detail.
+   */
+  void reset();
+
+  /**
+   * Gets the factor to multiply the maximum screen-space error by.
+   */
+  double getScreenSpaceErrorScale() const { return this->_scale; }
+
+  /**
+   * Gets the factor to multiply the maximum number of simultaneous tile loads
+   * by. Fewer tiles are loaded at once while the level of detail is lowered,
+   * which also spreads the cost of loading over more frames.
+   */
+  double getLoadScale() const { return 1.0 / this->_scale; }
+
+  /**
+   * Gets the smoothed frame time that the last decision was based on, in
+   * seconds.
+   */
+  double getAverageFrameTime() const { return this->_averageFrameTime; }
+
+private:
+  double _scale = 1.0;
+  double _averageFrameTime = 0.0;
+  double _timeSinceChange = 0.0;
+};
@@ -0,0 +1,50 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumDistanceTileExcluder.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+void UCesiumDistanceTileExcluder::PrepareForNewFrame() {
+  this->_originLocation.Reset();
+
+  if (IsValid(this->Origin)) {
+    this->_originLocation = this->Origin->GetActorLocation();
+    return;
+  }
+
+  const UWorld* pWorld = this->GetWorld();
+  const APlayerController* pController =
+      pWorld ? pWorld->GetFirstPlayerController() : nullptr;
+  if (pController && pController->PlayerCameraManager) {
+    this->_originLocation =
+        pController->PlayerCameraManager->GetCameraLocation();
+  }
+}
+
+void UCesiumDistanceTileExcluder::SetOriginLocation(const FVector& Location) {
+  this->_originLocation = Location;
+}
+
+void UCesiumDistanceTileExcluder::ShouldExcludeTiles(
+    TConstArrayView<FBoxSphereBounds> TileBounds,
+    TBitArray<>& OutExcluded) {
+  OutExcluded.Init(false, TileBounds.Num());
+  if (!this->_originLocation) {
+    return;
+  }
+
+  const FVector origin = *this->_originLocation;
+  const double maximumDistanceSquared =
+      this->MaximumDistance * this->MaximumDistance;
+
+  for (int32 i = 0; i < TileBounds.Num(); ++i) {
+    const FBoxSphereBounds& bounds = TileBounds[i];
+    const double sphereDistance =
+        FVector::Dist(origin, bounds.Origin) - bounds.SphereRadius;
+    OutExcluded[i] =
+        sphereDistance > this->MaximumDistance ||
+        bounds.GetBox().ComputeSquaredDistanceToPoint(origin) >
+            maximumDistanceSquared;
+  }
+}
@@ -13,7 +13,10 @@
 #include "CesiumPropertyTable.h"
 #include "CesiumPropertyTexture.h"
 #include "CesiumRuntime.h"
+#include "Async/ParallelFor.h"
 #include "Containers/Map.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
 #include "PixelFormat.h"
 #include "TextureResource.h"
 #include <CesiumGltf/FeatureIdTextureView.h>
@@ -327,6 +330,11 @@ FString getMaterialNameForPropertyTextureProperty(
       MaterialPropertyTexturePrefix + propertyTextureName + "_" + propertyName);
 }
 
+FString getMaterialNameForFeatureSelection(const FString& propertyTableName) {
+  // Example: "FSELECT_houses"
+  return createHlslSafeName(MaterialFeatureSelectionPrefix + propertyTableName);
+}
+
 namespace {
 
 struct EncodedPixelFormat {
@@ -466,6 +474,118 @@ bool isValidPropertyTexturePropertyDescription(
   return true;
 }
 
+// Encoded metadata textures shared by all models, keyed by a hash of their
+// contents. Sibling tiles often have identical property tables and property
+// textures, and sharing their textures avoids creating and uploading the same
+// texture for each tile. Textures are only pinned or released while holding
+// the lock, so that a loading model can't pick up a texture that the last
+// model using it is destroying.
+struct SharedEncodedTextures {
+  FCriticalSection lock;
+  TMap<uint64, TWeakPtr<LoadedTextureResult>> textures;
+  int32 pruneThreshold = 256;
+};
+
+SharedEncodedTextures& getSharedEncodedTextures() {
+  static SharedEncodedTextures sharedTextures;
+  return sharedTextures;
+}
+
+// Hashes a texture's pixels along with everything else that determines how
+// it's sampled. The sampler state is packed into the given 64-bit value.
+uint64 hashTextureContents(
+    const void* pData,
+    size_t size,
+    int32 width,
+    int32 height,
+    uint64 samplerState) {
+  return CityHash64WithSeeds(
+      static_cast<const char*>(pData),
+      static_cast<uint32>(size),
+      (uint64(uint32(width)) << 32) | uint64(uint32(height)),
+      samplerState);
+}
+
+uint64 hashPropertyTextureImage(
+    const CesiumGltf::ImageCesium& image,
+    const CesiumGltf::Sampler& sampler) {
+  return hashTextureContents(
+      image.pixelData.data(),
+      image.pixelData.size(),
+      image.width,
+      image.height,
+      (uint64(uint32(sampler.wrapS)) << 32) | uint64(uint32(sampler.wrapT)));
+}
+
+TSharedPtr<LoadedTextureResult> findSharedEncodedTexture(uint64 hash) {
+  SharedEncodedTextures& shared = getSharedEncodedTextures();
+  FScopeLock lock(&shared.lock);
+  const TWeakPtr<LoadedTextureResult>* pFound = shared.textures.Find(hash);
+  return pFound ? pFound->Pin() : nullptr;
+}
+
+// Shares the given texture under the given hash, unless another model has
+// already shared one, in which case that texture is returned instead.
+TSharedPtr<LoadedTextureResult> addSharedEncodedTexture(
+    uint64 hash,
+    const TSharedPtr<LoadedTextureResult>& pTexture) {
+  SharedEncodedTextures& shared = getSharedEncodedTextures();
+  FScopeLock lock(&shared.lock);
+
+  // A texture's entry isn't removed when it's last released by a model that
+  // is discarded before it's destroyed, or by a property that shares another
+  // property's texture within a model, so expired entries are removed here.
+  if (shared.textures.Num() >= shared.pruneThreshold) {
+    for (auto it = shared.textures.CreateIterator(); it; ++it) {
+      if (!it.Value().IsValid()) {
+        it.RemoveCurrent();
+      }
+    }
+    shared.pruneThreshold =
+        FMath::Max(shared.pruneThreshold, 2 * shared.textures.Num());
+  }
+
+  TWeakPtr<LoadedTextureResult>& pShared = shared.textures.FindOrAdd(hash);
+  if (TSharedPtr<LoadedTextureResult> pExisting = pShared.Pin()) {
+    return pExisting;
+  }
+
+  pShared = pTexture;
+  return pTexture;
+}
+
+// Releases a model's reference to a texture, and destroys the texture's
+// UTexture2D if no other model uses it.
+void destroySharedEncodedTexture(
+    uint64 hash,
+    TSharedPtr<LoadedTextureResult>& pTexture) {
+  if (!pTexture) {
+    return;
+  }
+
+  {
+    SharedEncodedTextures& shared = getSharedEncodedTextures();
+    FScopeLock lock(&shared.lock);
+    if (pTexture.GetSharedReferenceCount() > 1) {
+      pTexture.Reset();
+      return;
+    }
+
+    if (hash != 0) {
+      const TWeakPtr<LoadedTextureResult>* pFound = shared.textures.Find(hash);
+      if (pFound &&
+          (!pFound->IsValid() || pFound->HasSameObject(pTexture.Get()))) {
+        shared.textures.Remove(hash);
+      }
+    }
+  }
+
+  if (pTexture->pTexture.IsValid()) {
+    CesiumLifetime::destroy(pTexture->pTexture.Get());
+    pTexture->pTexture.Reset();
+  }
+}
+
 } // namespace
 
 EncodedPropertyTable encodePropertyTableAnyThreadPart(
@@ -483,6 +603,21 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
   const TMap<FString, FCesiumPropertyTableProperty>& properties =
       UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable);
 
+  // Textures are allocated serially, then the properties are encoded into them
+  // in parallel. Encoding is by far the most expensive part, especially for
+  // string conversions.
+  struct EncodingJob {
+    int32 propertyIndex;
+    const FCesiumPropertyTablePropertyDescription* pDescription;
+    const FCesiumPropertyTableProperty* pProperty;
+    FTexture2DMipMap* pMip;
+    gsl::span<std::byte> textureData;
+    EncodedPixelFormat format;
+    uint64 hash;
+  };
+  TArray<EncodingJob> jobs;
+  jobs.Reserve(properties.Num());
+
   encodedPropertyTable.properties.Reserve(properties.Num());
   for (const auto& pair : properties) {
     const FCesiumPropertyTableProperty& property = pair.Value;
@@ -541,8 +676,6 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
       continue;
     }
 
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTableProperty)
-
     EncodedPropertyTableProperty& encodedProperty =
         encodedPropertyTable.properties.Emplace_GetRef();
     encodedProperty.name = createHlslSafeName(pDescription->Name);
@@ -558,7 +691,7 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
               ? floorSqrtFeatureCount
               : (floorSqrtFeatureCount + 1);
 
-      encodedProperty.pTexture = MakeUnique<LoadedTextureResult>();
+      encodedProperty.pTexture = MakeShared<LoadedTextureResult>();
       encodedProperty.pTexture->sRGB = false;
       // TODO: upgrade to new texture creation path.
       encodedProperty.pTexture->textureSource = LegacyTextureSource{};
@@ -594,21 +727,14 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
           reinterpret_cast<std::byte*>(pTextureData),
           static_cast<size_t>(pMip->BulkData.GetBulkDataSize()));
 
-      if (encodingDetails.Conversion ==
-          ECesiumEncodedMetadataConversion::ParseColorFromString) {
-        CesiumEncodedMetadataParseColorFromString::encode(
-            *pDescription,
-            property,
-            textureData,
-            encodedFormat.pixelSize);
-      } else /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
-        CesiumEncodedMetadataCoerce::encode(
-            *pDescription,
-            property,
-            textureData,
-            encodedFormat.pixelSize);
-      }
-      pMip->BulkData.Unlock();
+      jobs.Add(
+          {encodedPropertyTable.properties.Num() - 1,
+           pDescription,
+           &property,
+           pMip,
+           textureData,
+           encodedFormat,
+           0});
     }
 
     if (pDescription->PropertyDetails.bHasOffset) {
@@ -652,6 +778,45 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     }
   }
 
+  ParallelFor(jobs.Num(), [&jobs](int32 i) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTableProperty)
+
+    EncodingJob& job = jobs[i];
+    if (job.pDescription->EncodingDetails.Conversion ==
+        ECesiumEncodedMetadataConversion::ParseColorFromString) {
+      CesiumEncodedMetadataParseColorFromString::encode(
+          *job.pDescription,
+          *job.pProperty,
+          job.textureData,
+          job.format.pixelSize);
+    } else /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
+      CesiumEncodedMetadataCoerce::encode(
+          *job.pDescription,
+          *job.pProperty,
+          job.textureData,
+          job.format.pixelSize);
+    }
+
+    // Every property table texture is sampled the same way, so only its
+    // format needs to be hashed along with its contents.
+    job.hash = hashTextureContents(
+        job.textureData.data(),
+        job.textureData.size(),
+        job.pMip->SizeX,
+        job.pMip->SizeY,
+        uint64(job.format.format));
+  });
+
+  for (const EncodingJob& job : jobs) {
+    job.pMip->BulkData.Unlock();
+
+    EncodedPropertyTableProperty& encodedProperty =
+        encodedPropertyTable.properties[job.propertyIndex];
+    encodedProperty.pTexture =
+        addSharedEncodedTexture(job.hash, encodedProperty.pTexture);
+    encodedProperty.textureHash = job.hash;
+  }
+
   return encodedPropertyTable;
 }
 
@@ -711,8 +876,22 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
 
       TWeakPtr<LoadedTextureResult>* pMappedUnrealImageIt =
           propertyTexturePropertyMap.Find(pImage);
+
+      // Identical images in other models, such as sibling tiles, share a
+      // texture.
+      const uint64 imageHash =
+          pMappedUnrealImageIt
+              ? 0
+              : hashPropertyTextureImage(*pImage, *property.getSampler());
+      TSharedPtr<LoadedTextureResult> pSharedTexture =
+          pMappedUnrealImageIt ? nullptr : findSharedEncodedTexture(imageHash);
+
       if (pMappedUnrealImageIt) {
         encodedProperty.pTexture = pMappedUnrealImageIt->Pin();
+      } else if (pSharedTexture) {
+        encodedProperty.pTexture = pSharedTexture;
+        encodedProperty.textureHash = imageHash;
+        propertyTexturePropertyMap.Emplace(pImage, pSharedTexture);
       } else {
         encodedProperty.pTexture = MakeShared<LoadedTextureResult>();
         // TODO: upgrade to new texture creation path.
@@ -774,6 +953,11 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
             pImage->pixelData.size());
 
         pMip->BulkData.Unlock();
+
+        encodedProperty.pTexture =
+            addSharedEncodedTexture(imageHash, encodedProperty.pTexture);
+        encodedProperty.textureHash = imageHash;
+        propertyTexturePropertyMap.Emplace(pImage, encodedProperty.pTexture);
       }
     };
 
@@ -832,17 +1016,18 @@ EncodedPrimitiveMetadata encodePrimitiveMetadataAnyThreadPart(
   return result;
 }
 
-EncodedModelMetadata encodeModelMetadataAnyThreadPart(
+TArray<EncodedPropertyTable> encodePropertyTablesAnyThreadPart(
     const FCesiumModelMetadataDescription& metadataDescription,
     const FCesiumModelMetadata& metadata) {
-
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodeModelMetadata)
-
-  EncodedModelMetadata result;
+  TArray<EncodedPropertyTable> result;
+  if (metadataDescription.PropertyTables.IsEmpty()) {
+    // Don't create the property tables if none of them are encoded.
+    return result;
+  }
 
   const TArray<FCesiumPropertyTable>& propertyTables =
       UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(metadata);
-  result.propertyTables.Reserve(propertyTables.Num());
+  result.Reserve(propertyTables.Num());
   for (const auto& propertyTable : propertyTables) {
     const FString propertyTableName = getNameForPropertyTable(propertyTable);
 
@@ -857,13 +1042,26 @@ EncodedModelMetadata encodeModelMetadataAnyThreadPart(
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTable)
 
       auto& encodedPropertyTable =
-          result.propertyTables.Emplace_GetRef(encodePropertyTableAnyThreadPart(
+          result.Emplace_GetRef(encodePropertyTableAnyThreadPart(
               *pExpectedPropertyTable,
               propertyTable));
       encodedPropertyTable.name = propertyTableName;
     }
   }
 
+  return result;
+}
+
+EncodedModelMetadata encodeModelMetadataAnyThreadPart(
+    const FCesiumModelMetadataDescription& metadataDescription,
+    const FCesiumModelMetadata& metadata) {
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodeModelMetadata)
+
+  EncodedModelMetadata result;
+  result.propertyTables =
+      encodePropertyTablesAnyThreadPart(metadataDescription, metadata);
+
   const TArray<FCesiumPropertyTexture>& propertyTextures =
       UCesiumModelMetadataBlueprintLibrary::GetPropertyTextures(metadata);
   result.propertyTextures.Reserve(propertyTextures.Num());
@@ -953,26 +1151,27 @@ bool encodeModelMetadataGameThreadPart(EncodedModelMetadata& encodedMetadata) {
   return success;
 }
 
-void destroyEncodedModelMetadata(EncodedModelMetadata& encodedMetadata) {
-  for (auto& propertyTable : encodedMetadata.propertyTables) {
+void destroyEncodedPropertyTables(
+    TArray<EncodedPropertyTable>& encodedPropertyTables) {
+  for (auto& propertyTable : encodedPropertyTables) {
     for (EncodedPropertyTableProperty& encodedProperty :
          propertyTable.properties) {
-      if (encodedProperty.pTexture &&
-          encodedProperty.pTexture->pTexture.IsValid()) {
-        CesiumLifetime::destroy(encodedProperty.pTexture->pTexture.Get());
-        encodedProperty.pTexture->pTexture.Reset();
-      }
+      destroySharedEncodedTexture(
+          encodedProperty.textureHash,
+          encodedProperty.pTexture);
     }
   }
+}
+
+void destroyEncodedModelMetadata(EncodedModelMetadata& encodedMetadata) {
+  destroyEncodedPropertyTables(encodedMetadata.propertyTables);
 
   for (auto& encodedPropertyTextureIt : encodedMetadata.propertyTextures) {
     for (EncodedPropertyTextureProperty& encodedPropertyTextureProperty :
          encodedPropertyTextureIt.properties) {
-      if (encodedPropertyTextureProperty.pTexture->pTexture.IsValid()) {
-        CesiumLifetime::destroy(
-            encodedPropertyTextureProperty.pTexture->pTexture.Get());
-        encodedPropertyTextureProperty.pTexture->pTexture.Reset();
-      }
+      destroySharedEncodedTexture(
+          encodedPropertyTextureProperty.textureHash,
+          encodedPropertyTextureProperty.pTexture);
     }
   }
 }
@@ -73,6 +73,11 @@ static const FString MaterialPropertyTablePrefix = "PTABLE_";
  */
 static const FString MaterialPropertyTexturePrefix = "PTEXTURE_";
 
+/**
+ * - Feature Selection: "FSELECT_" + PropertyTableName
+ */
+static const FString MaterialFeatureSelectionPrefix = "FSELECT_";
+
 /**
  * Below, "PropertyEntityName" represents the name of either a property table or
  * property texture.
@@ -296,6 +301,18 @@ FString getMaterialNameForPropertyTextureProperty(
     const FString& propertyTableName,
     const FString& propertyName);
 
+/**
+ * @brief Generates an HLSL-safe name for the feature selection of a property
+ * table in a glTF model's EXT_structural_metadata. This is formatted like so:
+ *
+ * "FSELECT_<table name>"
+ *
+ * This is used to name the texture parameter that holds the colors and
+ * visibility of the property table's features in the generated Unreal
+ * material.
+ */
+FString getMaterialNameForFeatureSelection(const FString& propertyTableName);
+
 /**
  * A property table property that has been encoded for access on the GPU.
  */
@@ -306,9 +323,17 @@ struct EncodedPropertyTableProperty {
   FString name;
 
   /**
-   * @brief The property table property values, encoded into a texture.
+   * @brief The property table property values, encoded into a texture. This
+   * may be shared with other models whose properties encode to the same
+   * values.
    */
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
+
+  /**
+   * @brief The hash of the texture's contents, under which it is shared with
+   * other models, or 0 if it isn't shared.
+   */
+  uint64 textureHash = 0;
 
   /**
    * @brief The type that the metadata will be encoded as.
@@ -363,10 +388,17 @@ struct EncodedPropertyTextureProperty {
   FString name;
 
   /**
-   * @brief The texture used by the property texture property.
+   * @brief The texture used by the property texture property. This may be
+   * shared with other properties and other models that use the same image.
    */
   TSharedPtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
 
+  /**
+   * @brief The hash of the texture's contents, under which it is shared with
+   * other models, or 0 if it isn't shared.
+   */
+  uint64 textureHash = 0;
+
   /**
    * @brief The type that of the metadata encoded in the texture.
    */
@@ -462,6 +494,14 @@ EncodedPrimitiveMetadata encodePrimitiveMetadataAnyThreadPart(
     const FCesiumPrimitiveMetadata& primitive,
     const FCesiumModelMetadata& modelMetadata);
 
+/**
+ * @brief Encodes only the property tables of a model's metadata, so that they
+ * can be encoded again for a new description without the property textures.
+ */
+TArray<EncodedPropertyTable> encodePropertyTablesAnyThreadPart(
+    const FCesiumModelMetadataDescription& metadataDescription,
+    const FCesiumModelMetadata& modelMetadata);
+
 EncodedModelMetadata encodeModelMetadataAnyThreadPart(
     const FCesiumModelMetadataDescription& metadataDescription,
     const FCesiumModelMetadata& modelMetadata);
@@ -476,6 +516,9 @@ bool encodePropertyTextureGameThreadPart(
 
 bool encodeModelMetadataGameThreadPart(EncodedModelMetadata& encodedMetadata);
 
+void destroyEncodedPropertyTables(
+    TArray<EncodedPropertyTable>& encodedPropertyTables);
+
 void destroyEncodedModelMetadata(EncodedModelMetadata& encodedMetadata);
 
 #pragma endregion
@@ -175,6 +175,34 @@ void coerceAndEncodeArrays(
   }
 }
 
+// The number of values that are read from a property at once while it's
+// encoded, so that the whole column isn't copied.
+constexpr int64 EncodeChunkSize = 1024;
+
+/**
+ * Reads the raw values of a property a chunk at a time, converted to TValue
+ * the same way that the UCesiumMetadataValueBlueprintLibrary getters convert
+ * the result of GetRawValue, and passes each chunk to the given function.
+ */
+template <typename TValue, typename Callback>
+void forEachRawValueChunk(
+    const FCesiumPropertyTableProperty& property,
+    int64 propertySize,
+    const TValue& defaultValue,
+    Callback&& callback) {
+  const TCesiumPropertyColumn<TValue> column(property);
+  TArray<TValue> values;
+  values.SetNumUninitialized(
+      static_cast<int32>(std::min(EncodeChunkSize, propertySize)));
+  for (int64 first = 0; first < propertySize; first += EncodeChunkSize) {
+    TArrayView<TValue> chunk(
+        values.GetData(),
+        static_cast<int32>(std::min(EncodeChunkSize, propertySize - first)));
+    column.GetRawValues(first, chunk, defaultValue);
+    callback(TArrayView<const TValue>(chunk));
+  }
+}
+
 template <typename T>
 void coerceAndEncodeScalars(
     const FCesiumPropertyTableProperty& property,
@@ -186,21 +214,15 @@ void coerceAndEncodeScalars(
         "Buffer is too small to store the data of this property.");
   }
 
+  // Scalars are tightly packed, so they're converted straight into the
+  // texture.
   T* pWritePos = reinterpret_cast<T*>(textureData.data());
-
-  for (int64 i = 0; i < propertySize; ++i) {
-    FCesiumMetadataValue value =
-        UCesiumPropertyTablePropertyBlueprintLibrary::GetRawValue(property, i);
-
-    if constexpr (std::is_same_v<T, uint8>) {
-      *pWritePos = UCesiumMetadataValueBlueprintLibrary::GetByte(value, 0);
-    } else if constexpr (std::is_same_v<T, float>) {
-      *pWritePos = UCesiumMetadataValueBlueprintLibrary::GetFloat(value, 0.0f);
-    }
-
-    ++pWritePos;
+  const TCesiumPropertyColumn<T> column(property);
+  for (int64 first = 0; first < propertySize; first += EncodeChunkSize) {
+    const int32 count =
+        static_cast<int32>(std::min(EncodeChunkSize, propertySize - first));
+    column.GetRawValues(first, TArrayView<T>(pWritePos + first, count), T(0));
   }
-  return;
 }
 
 template <typename T>
@@ -217,33 +239,39 @@ void coerceAndEncodeVec2s(
 
   uint8* pWritePos = reinterpret_cast<uint8*>(textureData.data());
 
-  for (int64 i = 0; i < propertySize; ++i) {
-    FCesiumMetadataValue value =
-        UCesiumPropertyTablePropertyBlueprintLibrary::GetRawValue(property, i);
-
-    if constexpr (std::is_same_v<T, uint8>) {
-      FIntPoint vec2 = UCesiumMetadataValueBlueprintLibrary::GetIntPoint(
-          value,
-          FIntPoint(0));
-      for (int64 j = 0; j < 2; ++j) {
-        *(pWritePos + j) =
-            CesiumMetadataConversions<uint8, int32>::convert(vec2[j], 0);
-      }
-    } else if constexpr (std::is_same_v<T, float>) {
-      FVector2D vec2 = UCesiumMetadataValueBlueprintLibrary::GetVector2D(
-          value,
-          FVector2D::Zero());
-
-      // Floats are encoded backwards (e.g., ABGR)
-      float* pWritePosF = reinterpret_cast<float*>(pWritePos + pixelSize) - 1;
-      for (int64 j = 0; j < 2; ++j) {
-        *pWritePosF =
-            CesiumMetadataConversions<float, double>::convert(vec2[j], 0.0f);
-        --pWritePosF;
-      }
-    }
-
-    pWritePos += pixelSize;
+  if constexpr (std::is_same_v<T, uint8>) {
+    forEachRawValueChunk<FIntPoint>(
+        property,
+        propertySize,
+        FIntPoint(0),
+        [&pWritePos, pixelSize](TArrayView<const FIntPoint> values) {
+          for (const FIntPoint& vec2 : values) {
+            for (int64 j = 0; j < 2; ++j) {
+              *(pWritePos + j) =
+                  CesiumMetadataConversions<uint8, int32>::convert(vec2[j], 0);
+            }
+            pWritePos += pixelSize;
+          }
+        });
+  } else if constexpr (std::is_same_v<T, float>) {
+    forEachRawValueChunk<FVector2D>(
+        property,
+        propertySize,
+        FVector2D::Zero(),
+        [&pWritePos, pixelSize](TArrayView<const FVector2D> values) {
+          for (const FVector2D& vec2 : values) {
+            // Floats are encoded backwards (e.g., ABGR)
+            float* pWritePosF =
+                reinterpret_cast<float*>(pWritePos + pixelSize) - 1;
+            for (int64 j = 0; j < 2; ++j) {
+              *pWritePosF = CesiumMetadataConversions<float, double>::convert(
+                  vec2[j],
+                  0.0f);
+              --pWritePosF;
+            }
+            pWritePos += pixelSize;
+          }
+        });
   }
 }
 
@@ -261,32 +289,37 @@ void coerceAndEncodeVec3s(
 
   uint8* pWritePos = reinterpret_cast<uint8*>(textureData.data());
 
-  for (int64 i = 0; i < propertySize; ++i) {
-    FCesiumMetadataValue value =
-        UCesiumPropertyTablePropertyBlueprintLibrary::GetRawValue(property, i);
-
-    if constexpr (std::is_same_v<T, uint8>) {
-      FIntVector vec3 = UCesiumMetadataValueBlueprintLibrary::GetIntVector(
-          value,
-          FIntVector(0));
-      for (int64 j = 0; j < 3; ++j) {
-        *(pWritePos + j) =
-            CesiumMetadataConversions<uint8, int32>::convert(vec3[j], 0);
-      }
-    } else if constexpr (std::is_same_v<T, float>) {
-      FVector3f vec3 = UCesiumMetadataValueBlueprintLibrary::GetVector3f(
-          value,
-          FVector3f::Zero());
-
-      // Floats are encoded backwards (e.g., ABGR)
-      float* pWritePosF = reinterpret_cast<float*>(pWritePos + pixelSize) - 1;
-      for (int64 j = 0; j < 3; ++j) {
-        *pWritePosF = vec3[j];
-        --pWritePosF;
-      }
-    }
-
-    pWritePos += pixelSize;
+  if constexpr (std::is_same_v<T, uint8>) {
+    forEachRawValueChunk<FIntVector>(
+        property,
+        propertySize,
+        FIntVector(0),
+        [&pWritePos, pixelSize](TArrayView<const FIntVector> values) {
+          for (const FIntVector& vec3 : values) {
+            for (int64 j = 0; j < 3; ++j) {
+              *(pWritePos + j) =
+                  CesiumMetadataConversions<uint8, int32>::convert(vec3[j], 0);
+            }
+            pWritePos += pixelSize;
+          }
+        });
+  } else if constexpr (std::is_same_v<T, float>) {
+    forEachRawValueChunk<FVector3f>(
+        property,
+        propertySize,
+        FVector3f::Zero(),
+        [&pWritePos, pixelSize](TArrayView<const FVector3f> values) {
+          for (const FVector3f& vec3 : values) {
+            // Floats are encoded backwards (e.g., ABGR)
+            float* pWritePosF =
+                reinterpret_cast<float*>(pWritePos + pixelSize) - 1;
+            for (int64 j = 0; j < 3; ++j) {
+              *pWritePosF = vec3[j];
+              --pWritePosF;
+            }
+            pWritePos += pixelSize;
+          }
+        });
   }
 }
 
@@ -304,30 +337,31 @@ void coerceAndEncodeVec4s(
 
   uint8* pWritePos = reinterpret_cast<uint8*>(textureData.data());
 
-  for (int64 i = 0; i < propertySize; ++i) {
-    FCesiumMetadataValue value =
-        UCesiumPropertyTablePropertyBlueprintLibrary::GetRawValue(property, i);
-    FVector4 vec4 = UCesiumMetadataValueBlueprintLibrary::GetVector4(
-        value,
-        FVector4::Zero());
-
-    if constexpr (std::is_same_v<T, uint8>) {
-      for (int64 j = 0; j < 4; ++j) {
-        *(pWritePos + j) =
-            CesiumMetadataConversions<uint8, double>::convert(vec4[j], 0);
-      }
-    } else if constexpr (std::is_same_v<T, float>) {
-      // Floats are encoded backwards (e.g., ABGR)
-      float* pWritePosF = reinterpret_cast<float*>(pWritePos + pixelSize) - 1;
-      for (int64 j = 0; j < 4; ++j) {
-        *pWritePosF =
-            CesiumMetadataConversions<float, double>::convert(vec4[j], 0.0f);
-        --pWritePosF;
-      }
-    }
-
-    pWritePos += pixelSize;
-  }
+  forEachRawValueChunk<FVector4>(
+      property,
+      propertySize,
+      FVector4::Zero(),
+      [&pWritePos, pixelSize](TArrayView<const FVector4> values) {
+        for (const FVector4& vec4 : values) {
+          if constexpr (std::is_same_v<T, uint8>) {
+            for (int64 j = 0; j < 4; ++j) {
+              *(pWritePos + j) =
+                  CesiumMetadataConversions<uint8, double>::convert(vec4[j], 0);
+            }
+          } else if constexpr (std::is_same_v<T, float>) {
+            // Floats are encoded backwards (e.g., ABGR)
+            float* pWritePosF =
+                reinterpret_cast<float*>(pWritePos + pixelSize) - 1;
+            for (int64 j = 0; j < 4; ++j) {
+              *pWritePosF = CesiumMetadataConversions<float, double>::convert(
+                  vec4[j],
+                  0.0f);
+              --pWritePosF;
+            }
+          }
+          pWritePos += pixelSize;
+        }
+      });
 }
 } // namespace
 
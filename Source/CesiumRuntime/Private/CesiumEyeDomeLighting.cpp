@@ -0,0 +1,133 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumEyeDomeLighting.h"
+#include "CoreGlobals.h"
+#include "GlobalShader.h"
+#include "PixelShaderUtils.h"
+#include "RHIStaticStates.h"
+#include "RenderGraphBuilder.h"
+#include "RenderingThread.h"
+#include "Runtime/Renderer/Private/PostProcess/PostProcessing.h"
+#include "Runtime/Renderer/Private/SceneRendering.h"
+#include "SceneView.h"
+#include "ShaderParameterStruct.h"
+
+class FCesiumEyeDomeLightingPS : public FGlobalShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumEyeDomeLightingPS);
+  SHADER_USE_PARAMETER_STRUCT(FCesiumEyeDomeLightingPS, FGlobalShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture2D, CustomDepthTexture)
+  SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2D<uint2>, CustomStencilTexture)
+  SHADER_PARAMETER(FIntPoint, ViewMin)
+  SHADER_PARAMETER(FIntPoint, ViewMax)
+  SHADER_PARAMETER(float, Strength)
+  SHADER_PARAMETER(float, Radius)
+  SHADER_PARAMETER(uint32, StencilValue)
+  RENDER_TARGET_BINDING_SLOTS()
+  END_SHADER_PARAMETER_STRUCT()
+
+  static bool ShouldCompilePermutation(
+      const FGlobalShaderPermutationParameters& Parameters) {
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+  }
+};
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumEyeDomeLightingPS,
+    "/Plugin/CesiumForUnreal/Private/CesiumEyeDomeLighting.usf",
+    "MainPS",
+    SF_Pixel);
+
+CesiumEyeDomeLighting::CesiumEyeDomeLighting() {}
+
+CesiumEyeDomeLighting::~CesiumEyeDomeLighting() {}
+
+void CesiumEyeDomeLighting::setSettings(
+    const ACesium3DTileset* pTileset,
+    const Settings* pSettings) {
+  check(IsInGameThread());
+
+  if (!pSettings) {
+    this->_settingsChanged |= this->_settingsByTileset.Remove(pTileset) > 0;
+    return;
+  }
+
+  const Settings* pExisting = this->_settingsByTileset.Find(pTileset);
+  if (!pExisting || !(*pExisting == *pSettings)) {
+    this->_settingsByTileset.Add(pTileset, *pSettings);
+    this->_settingsChanged = true;
+  }
+}
+
+void CesiumEyeDomeLighting::beginRenderViewFamily() {
+  check(IsInGameThread());
+
+  if (!this->_settingsChanged) {
+    return;
+  }
+  this->_settingsChanged = false;
+
+  TArray<Settings> settings;
+  for (const TPair<const ACesium3DTileset*, Settings>& pair :
+       this->_settingsByTileset) {
+    settings.AddUnique(pair.Value);
+  }
+
+  ENQUEUE_RENDER_COMMAND(CesiumSetEyeDomeLightingSettings)
+  ([this, settings = MoveTemp(settings)](FRHICommandListImmediate& RHICmdList) {
+    this->_settings_renderThread = settings;
+  });
+}
+
+void CesiumEyeDomeLighting::prePostProcessPass_RenderThread(
+    FRDGBuilder& graphBuilder,
+    const FSceneView& view,
+    const FPostProcessingInputs& inputs) {
+  if (this->_settings_renderThread.IsEmpty() || !inputs.SceneTextures) {
+    return;
+  }
+
+  const FSceneTextureUniformParameters* pSceneTextures =
+      inputs.SceneTextures->GetParameters();
+  if (!pSceneTextures->SceneColorTexture ||
+      !pSceneTextures->CustomDepthTexture ||
+      !pSceneTextures->CustomStencilTexture) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EyeDomeLighting)
+
+  const FIntRect& viewRect = static_cast<const FViewInfo&>(view).ViewRect;
+  FGlobalShaderMap* pShaderMap = GetGlobalShaderMap(view.GetFeatureLevel());
+  TShaderMapRef<FCesiumEyeDomeLightingPS> shader(pShaderMap);
+
+  for (const Settings& settings : this->_settings_renderThread) {
+    FCesiumEyeDomeLightingPS::FParameters* pParameters =
+        graphBuilder.AllocParameters<FCesiumEyeDomeLightingPS::FParameters>();
+    pParameters->View = view.ViewUniformBuffer;
+    pParameters->CustomDepthTexture = pSceneTextures->CustomDepthTexture;
+    pParameters->CustomStencilTexture = pSceneTextures->CustomStencilTexture;
+    pParameters->ViewMin = viewRect.Min;
+    pParameters->ViewMax = viewRect.Max - FIntPoint(1, 1);
+    pParameters->Strength = settings.strength;
+    pParameters->Radius = settings.radius;
+    pParameters->StencilValue = settings.stencilValue;
+    pParameters->RenderTargets[0] = FRenderTargetBinding(
+        pSceneTextures->SceneColorTexture,
+        ERenderTargetLoadAction::ELoad);
+
+    // The scene color is multiplied by the shade that the pixel shader
+    // outputs, so pixels without points can simply be discarded.
+    FPixelShaderUtils::AddFullscreenPass(
+        graphBuilder,
+        pShaderMap,
+        RDG_EVENT_NAME("CesiumEyeDomeLighting"),
+        shader,
+        pParameters,
+        viewRect,
+        TStaticBlendState<CW_RGB, BO_Add, BF_Zero, BF_SourceColor>::GetRHI());
+  }
+}
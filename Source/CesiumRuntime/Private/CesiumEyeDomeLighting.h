@@ -0,0 +1,72 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "RenderGraphDefinitions.h"
+
+class ACesium3DTileset;
+class FSceneView;
+struct FPostProcessingInputs;
+
+/**
+ * Shades the points of point cloud tilesets with Eye-Dome Lighting (EDL), so
+ * that they can be drawn with an unlit material and still show their shape.
+ *
+ * The points of a tileset with EDL enabled are drawn into the CustomDepth pass
+ * with a stencil value of its choosing. Before post processing, a full-screen
+ * pass compares the custom depth of each pixel with that value to the depth of
+ * its neighbors, and multiplies the scene color by a shade that's darker the
+ * farther the pixel lies behind them. Only the custom depth is read, so the
+ * cost doesn't depend on the number of points.
+ */
+class CesiumEyeDomeLighting {
+public:
+  /**
+   * The EDL settings of a tileset.
+   */
+  struct Settings {
+    float strength = 1.0f;
+    float radius = 1.0f;
+    uint32 stencilValue = 255;
+
+    bool operator==(const Settings& other) const {
+      return strength == other.strength && radius == other.radius &&
+             stencilValue == other.stencilValue;
+    }
+  };
+
+  CesiumEyeDomeLighting();
+  ~CesiumEyeDomeLighting();
+
+  /**
+   * Sets the EDL settings of a tileset, or removes them if pSettings is
+   * nullptr. Must be called from the game thread.
+   */
+  void
+  setSettings(const ACesium3DTileset* pTileset, const Settings* pSettings);
+
+  /**
+   * Sends the settings changed since the last call to the render thread. Must
+   * be called from the game thread before each view family is rendered.
+   */
+  void beginRenderViewFamily();
+
+  /**
+   * Shades the view's points. Must be called from the render thread before
+   * the view's post processing.
+   */
+  void prePostProcessPass_RenderThread(
+      FRDGBuilder& graphBuilder,
+      const FSceneView& view,
+      const FPostProcessingInputs& inputs);
+
+private:
+  // Game thread state.
+  TMap<const ACesium3DTileset*, Settings> _settingsByTileset;
+  bool _settingsChanged = false;
+
+  // Render thread state. Tilesets with the same settings share a pass.
+  TArray<Settings> _settings_renderThread;
+};
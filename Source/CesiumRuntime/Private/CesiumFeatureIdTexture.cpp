@@ -5,11 +5,86 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumMetadataPickingBlueprintLibrary.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
 
 #include <optional>
 
 using namespace CesiumGltf;
 
+FCesiumFeatureIdImage::FCesiumFeatureIdImage(
+    const FeatureIdTextureView& FeatureIdTextureView)
+    : _featureIdTextureView(FeatureIdTextureView),
+      _width(0),
+      _height(0),
+      _featureIDs() {
+  const ImageCesium* pImage = FeatureIdTextureView.getImage();
+  if (FeatureIdTextureView.status() != FeatureIdTextureViewStatus::Valid ||
+      !pImage) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DecodeFeatureIdImage)
+
+  const int64 texelCount = int64(pImage->width) * int64(pImage->height);
+  const int64 bytesPerTexel =
+      int64(pImage->channels) * int64(pImage->bytesPerChannel);
+  if (texelCount <= 0 || texelCount > MAX_int32 ||
+      int64(pImage->pixelData.size()) < texelCount * bytesPerTexel) {
+    return;
+  }
+
+  // Each channel holds the next eight bits of the feature ID, from the least
+  // significant.
+  const std::vector<int64_t>& channels = FeatureIdTextureView.getChannels();
+  this->_featureIDs.SetNumUninitialized(int32(texelCount));
+  const std::byte* pTexel = pImage->pixelData.data();
+  for (int32 i = 0; i < int32(texelCount); ++i, pTexel += bytesPerTexel) {
+    uint32 featureID = 0;
+    for (size_t j = 0; j < channels.size() && j < 4; ++j) {
+      featureID |= uint32(pTexel[channels[j]]) << (8 * j);
+    }
+    this->_featureIDs[i] = featureID;
+  }
+
+  this->_width = pImage->width;
+  this->_height = pImage->height;
+}
+
+int64 FCesiumFeatureIdImage::GetFeatureIDForUV(const FVector2D& UV) const {
+  if (this->_featureIDs.IsEmpty()) {
+    return -1;
+  }
+
+  if (UV.X < 0.0 || UV.X > 1.0 || UV.Y < 0.0 || UV.Y > 1.0) {
+    return this->_featureIdTextureView.getFeatureID(UV.X, UV.Y);
+  }
+
+  const int32 x = FMath::Clamp(
+      FMath::FloorToInt32(UV.X * this->_width),
+      0,
+      this->_width - 1);
+  const int32 y = FMath::Clamp(
+      FMath::FloorToInt32(UV.Y * this->_height),
+      0,
+      this->_height - 1);
+  return this->_featureIDs[y * this->_width + x];
+}
+
+void FCesiumFeatureIdImage::GetFeatureIDsForUVs(
+    TArrayView<const FVector2D> UVs,
+    TArrayView<int64> OutFeatureIDs) const {
+  check(UVs.Num() == OutFeatureIDs.Num());
+  for (int32 i = 0; i < UVs.Num(); ++i) {
+    OutFeatureIDs[i] = this->GetFeatureIDForUV(UVs[i]);
+  }
+}
+
+struct FCesiumFeatureIdTexture::DecodedImage {
+  FCriticalSection lock;
+  TSharedPtr<const FCesiumFeatureIdImage, ESPMode::ThreadSafe> pImage;
+};
+
 FCesiumFeatureIdTexture::FCesiumFeatureIdTexture(
     const Model& Model,
     const MeshPrimitive& Primitive,
@@ -44,6 +119,9 @@ FCesiumFeatureIdTexture::FCesiumFeatureIdTexture(
       Model,
       Primitive,
       this->_textureCoordinateSetIndex);
+
+  // Nothing is decoded until it's needed.
+  this->_pDecodedImage = MakeShared<DecodedImage, ESPMode::ThreadSafe>();
 }
 
 const FString& UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureTableName(
@@ -98,6 +176,41 @@ int64 UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDForUV(
   return FeatureIDTexture._featureIdTextureView.getFeatureID(UV[0], UV[1]);
 }
 
+TArray<int64> UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDsForUVs(
+    UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture,
+    const TArray<FVector2D>& UVs) {
+  TArray<int64> featureIDs;
+  TSharedPtr<const FCesiumFeatureIdImage, ESPMode::ThreadSafe> pImage =
+      GetDecodedImage(FeatureIDTexture);
+  if (!pImage) {
+    featureIDs.Init(-1, UVs.Num());
+    return featureIDs;
+  }
+
+  featureIDs.SetNumUninitialized(UVs.Num());
+  pImage->GetFeatureIDsForUVs(UVs, featureIDs);
+  return featureIDs;
+}
+
+TSharedPtr<const FCesiumFeatureIdImage, ESPMode::ThreadSafe>
+UCesiumFeatureIdTextureBlueprintLibrary::GetDecodedImage(
+    const FCesiumFeatureIdTexture& FeatureIDTexture) {
+  if (FeatureIDTexture._status != ECesiumFeatureIdTextureStatus::Valid ||
+      !FeatureIDTexture._pDecodedImage) {
+    return nullptr;
+  }
+
+  FCesiumFeatureIdTexture::DecodedImage& decoded =
+      *FeatureIDTexture._pDecodedImage;
+  FScopeLock lock(&decoded.lock);
+  if (!decoded.pImage) {
+    decoded.pImage =
+        MakeShared<const FCesiumFeatureIdImage, ESPMode::ThreadSafe>(
+            FeatureIDTexture._featureIdTextureView);
+  }
+  return decoded.pImage;
+}
+
 int64 UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDForVertex(
     UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture,
     int64 VertexIndex) {
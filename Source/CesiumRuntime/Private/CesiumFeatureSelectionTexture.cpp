@@ -0,0 +1,67 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureSelectionTexture.h"
+#include "Engine/Texture2D.h"
+
+namespace CesiumFeatureSelectionTexture {
+
+FIntPoint getSize(int64 featureCount) {
+  const int64 capacity = FMath::RoundUpToPowerOfTwo64(
+      uint64(FMath::Clamp(featureCount, int64(1), MaximumFeatureCount)));
+  const int64 width = FMath::Min(capacity, int64(MaximumWidth));
+  return FIntPoint(int32(width), int32(capacity / width));
+}
+
+UTexture2D* create(const TArray<FColor>& texels, const FIntPoint& size) {
+  check(texels.Num() == size.X * size.Y);
+
+  UTexture2D* pTexture =
+      UTexture2D::CreateTransient(size.X, size.Y, PF_B8G8R8A8);
+  if (!pTexture) {
+    return nullptr;
+  }
+
+  pTexture->SRGB = false;
+  pTexture->Filter = TextureFilter::TF_Nearest;
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  pTexture->NeverStream = true;
+
+  FTexture2DMipMap& mip = pTexture->GetPlatformData()->Mips[0];
+  void* pData = mip.BulkData.Lock(LOCK_READ_WRITE);
+  FMemory::Memcpy(pData, texels.GetData(), texels.Num() * sizeof(FColor));
+  mip.BulkData.Unlock();
+  pTexture->UpdateResource();
+
+  return pTexture;
+}
+
+void update(UTexture2D* pTexture, const TArray<FColor>& texels) {
+  if (!pTexture) {
+    return;
+  }
+
+  const int32 width = pTexture->GetSizeX();
+  const int32 height = pTexture->GetSizeY();
+  check(texels.Num() == width * height);
+
+  // The data must remain valid until the render thread has copied it.
+  FUpdateTextureRegion2D* pRegion =
+      new FUpdateTextureRegion2D(0, 0, 0, 0, width, height);
+  FColor* pData = new FColor[texels.Num()];
+  FMemory::Memcpy(pData, texels.GetData(), texels.Num() * sizeof(FColor));
+
+  pTexture->UpdateTextureRegions(
+      0,
+      1,
+      pRegion,
+      width * sizeof(FColor),
+      sizeof(FColor),
+      reinterpret_cast<uint8*>(pData),
+      [](uint8* pSrcData, const FUpdateTextureRegion2D* pRegions) {
+        delete[] reinterpret_cast<FColor*>(pSrcData);
+        delete pRegions;
+      });
+}
+
+} // namespace CesiumFeatureSelectionTexture
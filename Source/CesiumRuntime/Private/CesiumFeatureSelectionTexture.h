@@ -0,0 +1,56 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Color.h"
+#include "Math/IntPoint.h"
+
+class UTexture2D;
+
+/**
+ * Encodes the colors and visibility that are given to individual features of
+ * a property table into the texture that the "Apply Feature Selection" node of
+ * generated materials reads.
+ *
+ * The texture has a texel for each feature, in rows, indexed by feature ID.
+ * Each texel holds the color that the feature is multiplied by, and whether
+ * it's shown in its alpha. Features beyond the end of the texture are left
+ * white and shown.
+ */
+namespace CesiumFeatureSelectionTexture {
+
+/**
+ * The widest that the texture is, in texels.
+ */
+constexpr int32 MaximumWidth = 4096;
+
+/**
+ * The most features that can be given colors or hidden.
+ */
+constexpr int64 MaximumFeatureCount = int64(MaximumWidth) * MaximumWidth;
+
+/**
+ * The texel of features that are left as they are.
+ */
+constexpr FColor DefaultTexel = FColor(255, 255, 255, 255);
+
+/**
+ * Gets the size of a texture that holds at least the given number of
+ * features. Sizes are rounded up to powers of two, so that a selection that
+ * keeps growing only needs a new texture now and then.
+ */
+FIntPoint getSize(int64 featureCount);
+
+/**
+ * Creates a texture of the given size that holds the given texels.
+ */
+UTexture2D* create(const TArray<FColor>& texels, const FIntPoint& size);
+
+/**
+ * Replaces the texels of a texture made by create, in place, so that the
+ * materials using it don't need to be updated.
+ */
+void update(UTexture2D* pTexture, const TArray<FColor>& texels);
+
+} // namespace CesiumFeatureSelectionTexture
@@ -0,0 +1,120 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureStyleTexture.h"
+#include "CesiumFeatureStyle.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "Engine/Texture2D.h"
+
+namespace CesiumFeatureStyleTexture {
+
+int32 getPropertyIndex(
+    const TArray<FCesiumPropertyTableDescription>& propertyTables,
+    const FString& propertyTableName,
+    const FString& propertyName) {
+  int32 index = 0;
+  for (const FCesiumPropertyTableDescription& propertyTable : propertyTables) {
+    for (const FCesiumPropertyTablePropertyDescription& property :
+         propertyTable.Properties) {
+      // These are the properties that the material generation gives a value
+      // to.
+      if (property.EncodingDetails.Conversion ==
+              ECesiumEncodedMetadataConversion::None ||
+          !property.EncodingDetails.HasValidType()) {
+        continue;
+      }
+
+      if (propertyTable.Name == propertyTableName &&
+          property.Name == propertyName) {
+        return index;
+      }
+      ++index;
+    }
+  }
+
+  return -1;
+}
+
+TArray<FVector4f>
+encode(const FCesiumFeatureStyle& style, int32 propertyIndex) {
+  int32 conditionCount = 0;
+  if (propertyIndex >= 0) {
+    conditionCount = FMath::Min(style.Conditions.Num(), MaximumConditions);
+  }
+
+  TArray<FVector4f> encoded;
+  encoded.SetNumZeroed(Width);
+  encoded[0] = FVector4f(float(propertyIndex), float(conditionCount), 0, 0);
+  encoded[1] = FVector4f(
+      style.DefaultColor.R,
+      style.DefaultColor.G,
+      style.DefaultColor.B,
+      style.bDefaultShow ? 1.0f : 0.0f);
+
+  for (int32 i = 0; i < conditionCount; ++i) {
+    const FCesiumFeatureStyleCondition& condition = style.Conditions[i];
+    encoded[2 + 2 * i] = FVector4f(
+        float(condition.Minimum),
+        float(condition.Maximum),
+        0.0f,
+        0.0f);
+    encoded[3 + 2 * i] = FVector4f(
+        condition.Color.R,
+        condition.Color.G,
+        condition.Color.B,
+        condition.bShow ? 1.0f : 0.0f);
+  }
+
+  return encoded;
+}
+
+UTexture2D* create(const TArray<FVector4f>& encoded) {
+  check(encoded.Num() == Width);
+
+  UTexture2D* pTexture =
+      UTexture2D::CreateTransient(Width, 1, PF_A32B32G32R32F);
+  if (!pTexture) {
+    return nullptr;
+  }
+
+  pTexture->SRGB = false;
+  pTexture->Filter = TextureFilter::TF_Nearest;
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  pTexture->NeverStream = true;
+
+  FTexture2DMipMap& mip = pTexture->GetPlatformData()->Mips[0];
+  void* pData = mip.BulkData.Lock(LOCK_READ_WRITE);
+  FMemory::Memcpy(pData, encoded.GetData(), Width * sizeof(FVector4f));
+  mip.BulkData.Unlock();
+  pTexture->UpdateResource();
+
+  return pTexture;
+}
+
+void update(UTexture2D* pTexture, const TArray<FVector4f>& encoded) {
+  check(encoded.Num() == Width);
+
+  if (!pTexture) {
+    return;
+  }
+
+  // The data must remain valid until the render thread has copied it.
+  FUpdateTextureRegion2D* pRegion =
+      new FUpdateTextureRegion2D(0, 0, 0, 0, Width, 1);
+  FVector4f* pData = new FVector4f[Width];
+  FMemory::Memcpy(pData, encoded.GetData(), Width * sizeof(FVector4f));
+
+  pTexture->UpdateTextureRegions(
+      0,
+      1,
+      pRegion,
+      Width * sizeof(FVector4f),
+      sizeof(FVector4f),
+      reinterpret_cast<uint8*>(pData),
+      [](uint8* pSrcData, const FUpdateTextureRegion2D* pRegions) {
+        delete[] reinterpret_cast<FVector4f*>(pSrcData);
+        delete pRegions;
+      });
+}
+
+} // namespace CesiumFeatureStyleTexture
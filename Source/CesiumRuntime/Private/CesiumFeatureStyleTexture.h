@@ -0,0 +1,61 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Math/Vector4.h"
+
+struct FCesiumFeatureStyle;
+struct FCesiumPropertyTableDescription;
+class UTexture2D;
+
+/**
+ * Encodes a FCesiumFeatureStyle into the small float texture that the
+ * "Apply Feature Style" nodes of generated materials read.
+ *
+ * The texture is a single row. The first texel holds the index of the styled
+ * property and the number of conditions, and the second holds the default
+ * color and visibility. Each condition is then a texel with its range,
+ * followed by a texel with its color and visibility.
+ */
+namespace CesiumFeatureStyleTexture {
+
+/**
+ * The most conditions that a style has in the texture.
+ */
+constexpr int32 MaximumConditions = 16;
+
+/**
+ * The width of the texture, in texels.
+ */
+constexpr int32 Width = 2 + 2 * MaximumConditions;
+
+/**
+ * Gets the index that the generated material uses for a property table
+ * property, which counts the encoded properties of every property table in
+ * order, or -1 if the property isn't encoded.
+ */
+int32 getPropertyIndex(
+    const TArray<FCesiumPropertyTableDescription>& propertyTables,
+    const FString& propertyTableName,
+    const FString& propertyName);
+
+/**
+ * Encodes a style, given the index of its property from getPropertyIndex.
+ * If the index is negative, features are left unstyled.
+ */
+TArray<FVector4f> encode(const FCesiumFeatureStyle& style, int32 propertyIndex);
+
+/**
+ * Creates a texture that holds the given encoding.
+ */
+UTexture2D* create(const TArray<FVector4f>& encoded);
+
+/**
+ * Replaces the encoding in a texture made by create, in place, so that the
+ * materials using it don't need to be updated.
+ */
+void update(UTexture2D* pTexture, const TArray<FVector4f>& encoded);
+
+} // namespace CesiumFeatureStyleTexture
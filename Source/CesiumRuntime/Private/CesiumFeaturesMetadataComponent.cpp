@@ -4,8 +4,10 @@
 #include "Cesium3DTileset.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataConversions.h"
+#include "CesiumFeatureStyleTexture.h"
 #include "CesiumGltfComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumMaterialParameterNames.h"
 #include "CesiumMetadataConversions.h"
 #include "CesiumModelMetadata.h"
 #include "CesiumRuntime.h"
@@ -15,8 +17,10 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "ComponentReregisterContext.h"
 #include "Containers/Map.h"
+#include "Engine/Texture2D.h"
 #include "ContentBrowserModule.h"
 #include "Factories/MaterialFunctionMaterialLayerFactory.h"
+#include "HAL/PlatformTime.h"
 #include "IContentBrowserSingleton.h"
 #include "IMaterialEditor.h"
 #include "Materials/Material.h"
@@ -329,30 +333,26 @@ void AutoFillPropertyTextureNames(
   }
 }
 
+// How long AutoFill scans tiles for in each frame, in seconds.
+const double AutoFillTimeSlice = 0.005;
 } // namespace
 
-void UCesiumFeaturesMetadataComponent::AutoFill() {
-  const ACesium3DTileset* pOwner = this->GetOwner<ACesium3DTileset>();
-  if (!pOwner) {
-    return;
-  }
+struct UCesiumFeaturesMetadataComponent::AutoFillScan {
+  TArray<TWeakObjectPtr<const UCesiumGltfComponent>> Tiles;
+  int32 NextTile = 0;
 
-  Super::PreEditChange(NULL);
-
-  // This assumes that the property tables are the same across all models in the
-  // tileset, and that they all have the same schema.
-  for (const UActorComponent* pComponent : pOwner->GetComponents()) {
-    const UCesiumGltfComponent* pGltf = Cast<UCesiumGltfComponent>(pComponent);
-    if (!pGltf) {
-      continue;
-    }
+  TArray<FCesiumFeatureIdSetDescription> FeatureIdSets;
+  TSet<FString> PropertyTextureNames;
+  TArray<FCesiumPropertyTableDescription> PropertyTables;
+  TArray<FCesiumPropertyTextureDescription> PropertyTextures;
 
-    const FCesiumModelMetadata& modelMetadata = pGltf->Metadata;
+  void scanTile(const UCesiumGltfComponent& Gltf) {
+    const FCesiumModelMetadata& modelMetadata = Gltf.Metadata;
     AutoFillPropertyTableDescriptions(this->PropertyTables, modelMetadata);
     AutoFillPropertyTextureDescriptions(this->PropertyTextures, modelMetadata);
 
     TArray<USceneComponent*> childComponents;
-    pGltf->GetChildrenComponents(false, childComponents);
+    Gltf.GetChildrenComponents(false, childComponents);
 
     for (const USceneComponent* pChildComponent : childComponents) {
       const UCesiumGltfPrimitiveComponent* pGltfPrimitive =
@@ -382,8 +382,87 @@ void UCesiumFeaturesMetadataComponent::AutoFill() {
           propertyTextures);
     }
   }
+};
+
+void UCesiumFeaturesMetadataComponent::AutoFill() {
+  const ACesium3DTileset* pOwner = this->GetOwner<ACesium3DTileset>();
+  if (!pOwner) {
+    return;
+  }
+
+  // A scan that's in progress is started again, so that it includes the tiles
+  // that have loaded since.
+  if (this->_autoFillTickerHandle.IsValid()) {
+    FTSTicker::GetCoreTicker().RemoveTicker(this->_autoFillTickerHandle);
+    this->_autoFillTickerHandle.Reset();
+  }
+
+  // This assumes that the property tables are the same across all models in the
+  // tileset, and that they all have the same schema.
+  this->_pAutoFillScan = MakeShared<AutoFillScan>();
+  AutoFillScan& scan = *this->_pAutoFillScan;
+  scan.FeatureIdSets = this->FeatureIdSets;
+  scan.PropertyTextureNames = this->PropertyTextureNames;
+  scan.PropertyTables = this->PropertyTables;
+  scan.PropertyTextures = this->PropertyTextures;
+
+  for (const UActorComponent* pComponent : pOwner->GetComponents()) {
+    const UCesiumGltfComponent* pGltf = Cast<UCesiumGltfComponent>(pComponent);
+    if (pGltf) {
+      scan.Tiles.Add(pGltf);
+    }
+  }
+
+  // Small tilesets are scanned right away.
+  if (this->tickAutoFill(0.0f)) {
+    this->_autoFillTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(
+            this,
+            &UCesiumFeaturesMetadataComponent::tickAutoFill));
+  }
+}
+
+bool UCesiumFeaturesMetadataComponent::tickAutoFill(float DeltaTime) {
+  AutoFillScan* pScan = this->_pAutoFillScan.Get();
+  if (!pScan) {
+    this->_autoFillTickerHandle.Reset();
+    return false;
+  }
+
+  const double EndTime = FPlatformTime::Seconds() + AutoFillTimeSlice;
+  while (pScan->NextTile < pScan->Tiles.Num()) {
+    // Tiles that have been unloaded since the scan started are skipped.
+    const UCesiumGltfComponent* pGltf = pScan->Tiles[pScan->NextTile++].Get();
+    if (pGltf) {
+      pScan->scanTile(*pGltf);
+    }
+
+    if (FPlatformTime::Seconds() >= EndTime) {
+      break;
+    }
+  }
 
+  if (pScan->NextTile < pScan->Tiles.Num()) {
+    return true;
+  }
+
+  Super::PreEditChange(NULL);
+  this->FeatureIdSets = MoveTemp(pScan->FeatureIdSets);
+  this->PropertyTextureNames = MoveTemp(pScan->PropertyTextureNames);
+  this->PropertyTables = MoveTemp(pScan->PropertyTables);
+  this->PropertyTextures = MoveTemp(pScan->PropertyTextures);
   Super::PostEditChange();
+
+  UE_LOG(
+      LogCesium,
+      Log,
+      TEXT("Auto Fill scanned %d tiles of %s."),
+      pScan->Tiles.Num(),
+      *GetNameSafe(this->GetOwner()));
+
+  this->_pAutoFillScan.Reset();
+  this->_autoFillTickerHandle.Reset();
+  return false;
 }
 
 template <typename ObjClass>
@@ -430,7 +509,9 @@ static void ClassifyNodes(
       UMaterialExpressionCustom* CustomNode =
           Cast<UMaterialExpressionCustom>(Node);
       if (CustomNode &&
-          CustomNode->Description.Contains("Get Property Values From")) {
+          (CustomNode->Description.Contains("Get Property Values From") ||
+           CustomNode->Description.Contains("Apply Feature Style To") ||
+           CustomNode->Description.Contains("Apply Feature Selection To"))) {
         Classification.GetPropertyValueNodes.Add(CustomNode);
         continue;
       }
@@ -1652,12 +1733,195 @@ void GenerateNodesForMetadataPropertyTransforms(
   NodeY += Incr;
 }
 
+/**
+ * @brief A property whose value is given to the "Apply Feature Style" node of
+ * its property table.
+ */
+struct StyledProperty {
+  FString Name;
+  int32 GetPropertyValuesOutputIndex;
+  int32 StyleIndex;
+};
+
+/**
+ * @brief Generates the node that applies the tileset's FeatureStyle to the
+ * features of a property table. It reads the style from the
+ * CesiumFeatureStyle texture, picks the styled property from the given ones by
+ * its index, and outputs the color and visibility of the first condition that
+ * the value meets. Features are left white and shown when the style is for
+ * another property table.
+ */
+void GenerateNodesForFeatureStyle(
+    const FCesiumPropertyTableDescription& PropertyTable,
+    const TArray<StyledProperty>& StyledProperties,
+    TArray<UMaterialExpression*>& AutoGeneratedNodes,
+    UMaterialFunctionMaterialLayer* TargetMaterialLayer,
+    int32& NodeX,
+    int32 NodeY,
+    UMaterialExpressionCustom* GetPropertyValuesFunction) {
+  UMaterialExpressionTextureObjectParameter* StyleData =
+      NewObject<UMaterialExpressionTextureObjectParameter>(
+          TargetMaterialLayer);
+  StyleData->ParameterName = CesiumMaterialParameterNames::FeatureStyle;
+  StyleData->MaterialExpressionEditorX = NodeX;
+  StyleData->MaterialExpressionEditorY = NodeY - Incr;
+  AutoGeneratedNodes.Add(StyleData);
+
+  UMaterialExpressionCustom* ApplyStyleFunction =
+      NewObject<UMaterialExpressionCustom>(TargetMaterialLayer);
+  ApplyStyleFunction->Inputs.Reserve(StyledProperties.Num() + 1);
+  ApplyStyleFunction->Outputs.Reset(2);
+  ApplyStyleFunction->Outputs.Add(FExpressionOutput(TEXT("Style Color")));
+  ApplyStyleFunction->AdditionalOutputs.Reserve(1);
+  ApplyStyleFunction->bShowOutputNameOnPin = true;
+  ApplyStyleFunction->OutputType = ECustomMaterialOutputType::CMOT_Float3;
+  ApplyStyleFunction->Description =
+      "Apply Feature Style To " + PropertyTable.Name;
+  ApplyStyleFunction->MaterialExpressionEditorX = NodeX + Incr;
+  ApplyStyleFunction->MaterialExpressionEditorY = NodeY;
+  AutoGeneratedNodes.Add(ApplyStyleFunction);
+
+  FCustomInput& StyleInput = ApplyStyleFunction->Inputs[0];
+  StyleInput.InputName = CesiumMaterialParameterNames::FeatureStyle;
+  StyleInput.Input.Expression = StyleData;
+
+  FCustomOutput& ShowOutput =
+      ApplyStyleFunction->AdditionalOutputs.Emplace_GetRef();
+  ShowOutput.OutputName = FName("StyleShow");
+  ShowOutput.OutputType = ECustomMaterialOutputType::CMOT_Float1;
+  ApplyStyleFunction->Outputs.Add(FExpressionOutput(ShowOutput.OutputName));
+
+  const FString StyleName =
+      CesiumMaterialParameterNames::FeatureStyle.ToString();
+
+  // The first texel of the style holds the index of the styled property and
+  // the number of conditions. See CesiumFeatureStyleTexture.
+  FString& Code = ApplyStyleFunction->Code;
+  Code = "float4 _czm_header = " + StyleName + ".Load(int3(0, 0, 0));\n";
+  Code += "float _czm_value = 0.0f;\n";
+  Code += "switch ((int)round(_czm_header.x)) {\n";
+  for (const StyledProperty& Property : StyledProperties) {
+    FCustomInput& PropertyInput = ApplyStyleFunction->Inputs.Emplace_GetRef();
+    PropertyInput.InputName = FName(Property.Name);
+    PropertyInput.Input.Expression = GetPropertyValuesFunction;
+    PropertyInput.Input.OutputIndex = Property.GetPropertyValuesOutputIndex;
+
+    // Vectors and arrays are styled by their first component.
+    Code += FString::Printf(TEXT("case %d:\n"), Property.StyleIndex);
+    Code += "  _czm_value = " + Property.Name + ".x;\n";
+    Code += "  break;\n";
+  }
+  Code += "default:\n";
+  Code += "  StyleShow = 1.0f;\n";
+  Code += "  return float3(1.0f, 1.0f, 1.0f);\n";
+  Code += "}\n";
+  Code += "float4 _czm_style = " + StyleName + ".Load(int3(1, 0, 0));\n";
+  Code += "int _czm_count = round(_czm_header.y);\n";
+  Code += "for (int _czm_i = 0; _czm_i < _czm_count; ++_czm_i) {\n";
+  Code += "  float4 _czm_range = " + StyleName +
+          ".Load(int3(2 + 2 * _czm_i, 0, 0));\n";
+  Code += "  if (_czm_value >= _czm_range.x && _czm_value <= _czm_range.y) {\n";
+  Code += "    _czm_style = " + StyleName +
+          ".Load(int3(3 + 2 * _czm_i, 0, 0));\n";
+  Code += "    break;\n";
+  Code += "  }\n";
+  Code += "}\n";
+  Code += "StyleShow = _czm_style.a;\n";
+  Code += "return _czm_style.rgb;";
+
+  NodeX = ApplyStyleFunction->MaterialExpressionEditorX +
+          Incr * GetNameLengthScalar(ApplyStyleFunction->Description);
+}
+
+/**
+ * @brief Generates the node that applies the colors and visibility given to
+ * individual features of a property table by the tileset's feature selection.
+ * It reads the texel of the feature ID from the property table's
+ * FSELECT_<table name> texture, and outputs the color and visibility in it.
+ * Features beyond the end of the texture are left white and shown.
+ */
+void GenerateNodesForFeatureSelection(
+    const FCesiumPropertyTableDescription& PropertyTable,
+    TArray<UMaterialExpression*>& AutoGeneratedNodes,
+    UMaterialFunctionMaterialLayer* TargetMaterialLayer,
+    int32& NodeX,
+    int32 NodeY,
+    UMaterialExpressionCustom* GetPropertyValuesFunction) {
+  const FString SelectionName =
+      CesiumEncodedFeaturesMetadata::getMaterialNameForFeatureSelection(
+          PropertyTable.Name);
+
+  UMaterialExpressionTextureObjectParameter* SelectionData =
+      NewObject<UMaterialExpressionTextureObjectParameter>(
+          TargetMaterialLayer);
+  SelectionData->ParameterName = FName(SelectionName);
+  // Tiles are only given a texture once features of the table are selected,
+  // so the default must leave every feature as it is.
+  SelectionData->Texture = LoadObject<UTexture2D>(
+      nullptr,
+      TEXT("/Engine/EngineResources/WhiteSquareTexture.WhiteSquareTexture"));
+  SelectionData->MaterialExpressionEditorX = NodeX;
+  SelectionData->MaterialExpressionEditorY = NodeY + Incr;
+  AutoGeneratedNodes.Add(SelectionData);
+
+  UMaterialExpressionCustom* ApplySelectionFunction =
+      NewObject<UMaterialExpressionCustom>(TargetMaterialLayer);
+  ApplySelectionFunction->Inputs.Reserve(2);
+  ApplySelectionFunction->Outputs.Reset(2);
+  ApplySelectionFunction->Outputs.Add(
+      FExpressionOutput(TEXT("Selection Color")));
+  ApplySelectionFunction->AdditionalOutputs.Reserve(1);
+  ApplySelectionFunction->bShowOutputNameOnPin = true;
+  ApplySelectionFunction->OutputType = ECustomMaterialOutputType::CMOT_Float3;
+  ApplySelectionFunction->Description =
+      "Apply Feature Selection To " + PropertyTable.Name;
+  ApplySelectionFunction->MaterialExpressionEditorX = NodeX + Incr;
+  ApplySelectionFunction->MaterialExpressionEditorY = NodeY + Incr;
+  AutoGeneratedNodes.Add(ApplySelectionFunction);
+
+  FCustomInput& FeatureIDInput = ApplySelectionFunction->Inputs[0];
+  FeatureIDInput.InputName = FName("FeatureID");
+  FeatureIDInput.Input.Expression = GetPropertyValuesFunction;
+  FeatureIDInput.Input.OutputIndex = 0;
+
+  FCustomInput& SelectionInput =
+      ApplySelectionFunction->Inputs.Emplace_GetRef();
+  SelectionInput.InputName = FName(SelectionName);
+  SelectionInput.Input.Expression = SelectionData;
+
+  FCustomOutput& ShowOutput =
+      ApplySelectionFunction->AdditionalOutputs.Emplace_GetRef();
+  ShowOutput.OutputName = FName("SelectionShow");
+  ShowOutput.OutputType = ECustomMaterialOutputType::CMOT_Float1;
+  ApplySelectionFunction->Outputs.Add(
+      FExpressionOutput(ShowOutput.OutputName));
+
+  FString& Code = ApplySelectionFunction->Code;
+  Code = "uint _czm_width;\nuint _czm_height;\n";
+  Code += SelectionName + ".GetDimensions(_czm_width, _czm_height);\n";
+  Code += "uint _czm_featureIndex = round(FeatureID);\n";
+  Code += "SelectionShow = 1.0f;\n";
+  Code += "if (FeatureID < 0.0f || _czm_featureIndex >= _czm_width * "
+          "_czm_height) {\n";
+  Code += "  return float3(1.0f, 1.0f, 1.0f);\n";
+  Code += "}\n";
+  Code += "float4 _czm_selection = " + SelectionName +
+          ".Load(int3(_czm_featureIndex % _czm_width, _czm_featureIndex / "
+          "_czm_width, 0));\n";
+  Code += "SelectionShow = _czm_selection.a;\n";
+  Code += "return _czm_selection.rgb;";
+
+  NodeX = ApplySelectionFunction->MaterialExpressionEditorX +
+          Incr * GetNameLengthScalar(ApplySelectionFunction->Description);
+}
+
 /**
  * @brief Generates the nodes necessary to retrieve values from a property
  * table.
  */
 void GenerateNodesForPropertyTable(
     const FCesiumPropertyTableDescription& PropertyTable,
+    const TArray<FCesiumPropertyTableDescription>& PropertyTables,
     TArray<UMaterialExpression*>& AutoGeneratedNodes,
     UMaterialFunctionMaterialLayer* TargetMaterialLayer,
     int32& NodeX,
@@ -1709,6 +1973,7 @@ void GenerateNodesForPropertyTable(
 
   FString PropertyTableName = createHlslSafeName(PropertyTable.Name);
   bool foundFirstProperty = false;
+  TArray<StyledProperty> StyledProperties;
   for (const FCesiumPropertyTablePropertyDescription& Property :
        PropertyTable.Properties) {
     if (Property.EncodingDetails.Conversion ==
@@ -1775,6 +2040,14 @@ void GenerateNodesForPropertyTable(
     GetPropertyValuesFunction->Outputs.Add(
         FExpressionOutput(PropertyOutput.OutputName));
 
+    StyledProperties.Add(StyledProperty{
+        OutputName,
+        GetPropertyValuesFunction->Outputs.Num() - 1,
+        CesiumFeatureStyleTexture::getPropertyIndex(
+            PropertyTables,
+            PropertyTable.Name,
+            Property.Name)});
+
     FString swizzle = GetSwizzleForEncodedType(Property.EncodingDetails.Type);
     PropertyOutput.OutputType =
         GetOutputTypeForEncodedType(Property.EncodingDetails.Type);
@@ -1835,6 +2108,29 @@ void GenerateNodesForPropertyTable(
   NodeX = GetPropertyValuesFunction->MaterialExpressionEditorX +
           GetPropertyValuesFunctionWidth + MaximumPropertyTransformsSectionX +
           Incr;
+
+  const int32 FeatureNodesX = NodeX;
+  if (!StyledProperties.IsEmpty()) {
+    GenerateNodesForFeatureStyle(
+        PropertyTable,
+        StyledProperties,
+        AutoGeneratedNodes,
+        TargetMaterialLayer,
+        NodeX,
+        GetPropertyValuesFunction->MaterialExpressionEditorY,
+        GetPropertyValuesFunction);
+  }
+
+  int32 SelectionNodeX = FeatureNodesX;
+  GenerateNodesForFeatureSelection(
+      PropertyTable,
+      AutoGeneratedNodes,
+      TargetMaterialLayer,
+      SelectionNodeX,
+      GetPropertyValuesFunction->MaterialExpressionEditorY,
+      GetPropertyValuesFunction);
+  NodeX = FMath::Max(NodeX, SelectionNodeX);
+
   NodeY = FMath::Max(PropertyDataSectionY, PropertyTransformsSectionY) + Incr;
 }
 
@@ -2151,6 +2447,7 @@ void GenerateMaterialNodes(
       if (pPropertyTable) {
         GenerateNodesForPropertyTable(
             *pPropertyTable,
+            pComponent->PropertyTables,
             AutoGeneratedNodes,
             pComponent->TargetMaterialLayer,
             NodeX,
@@ -2190,6 +2487,7 @@ void GenerateMaterialNodes(
     if (!GeneratedPropertyTableNames.Find(propertyTable.Name)) {
       GenerateNodesForPropertyTable(
           propertyTable,
+          pComponent->PropertyTables,
           AutoGeneratedNodes,
           pComponent->TargetMaterialLayer,
           NodeX,
@@ -2326,6 +2624,73 @@ void GenerateMaterialNodes(
   OutputMaterial->A.Expression = SetMaterialAttributes;
 }
 
+/**
+ * Computes a hash of auto-generated nodes, from their classes, the values of
+ * their properties, and their connections to each other, to tell whether
+ * regenerating a material layer would change it. Connections to other nodes
+ * are left out, since user-made connections are remapped to the new nodes.
+ * GUIDs are left out too, because every new node has new ones.
+ */
+uint32 HashAutoGeneratedNodes(const TArray<UMaterialExpression*>& Nodes) {
+  uint32 Hash = GetTypeHash(Nodes.Num());
+  for (UMaterialExpression* Node : Nodes) {
+    Hash = FCrc::StrCrc32(*Node->GetClass()->GetName(), Hash);
+
+    for (TFieldIterator<FProperty> It(Node->GetClass()); It; ++It) {
+      const FProperty* Property = *It;
+      if (Property->HasAnyPropertyFlags(CPF_Transient)) {
+        continue;
+      }
+
+      const FStructProperty* StructProperty =
+          CastField<FStructProperty>(Property);
+      if (StructProperty &&
+          StructProperty->Struct == TBaseStructure<FGuid>::Get()) {
+        continue;
+      }
+
+      // References to assets, such as material functions, are compared by
+      // path. References to other nodes are compared below.
+      const FObjectPropertyBase* ObjectProperty =
+          CastField<FObjectPropertyBase>(Property);
+      if (ObjectProperty) {
+        const UObject* Object =
+            ObjectProperty->GetObjectPropertyValue_InContainer(Node);
+        if (!Cast<UMaterialExpression>(Object)) {
+          Hash = FCrc::StrCrc32(*GetPathNameSafe(Object), Hash);
+        }
+        continue;
+      }
+
+      TArray<const FStructProperty*> EncounteredStructProperties;
+      if (Property->ContainsObjectReference(EncounteredStructProperties)) {
+        continue;
+      }
+
+      FString Value;
+      Property->ExportTextItem_InContainer(
+          Value,
+          Node,
+          nullptr,
+          nullptr,
+          PPF_None);
+      Hash = FCrc::StrCrc32(*Value, Hash);
+    }
+
+    const TArray<FExpressionInput*> Inputs = Node->GetInputs();
+    for (int32 i = 0; i < Inputs.Num(); ++i) {
+      Hash = FCrc::StrCrc32(*Node->GetInputName(i).ToString(), Hash);
+
+      UMaterialExpression* InputNode = Inputs[i]->Expression;
+      const int32 InputNodeIndex = Nodes.IndexOfByKey(InputNode);
+      if (InputNodeIndex != INDEX_NONE) {
+        Hash = HashCombine(Hash, GetTypeHash(InputNodeIndex));
+        Hash = HashCombine(Hash, GetTypeHash(Inputs[i]->OutputIndex));
+      }
+    }
+  }
+  return Hash;
+}
 } // namespace
 
 void UCesiumFeaturesMetadataComponent::GenerateMaterial() {
@@ -2370,8 +2735,6 @@ void UCesiumFeaturesMetadataComponent::GenerateMaterial() {
   if (this->TargetMaterialLayer) {
     // Overwriting an existing material layer.
     Overwriting = true;
-    GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()
-        ->CloseAllEditorsForAsset(this->TargetMaterialLayer);
   } else {
     UPackage* Package = CreatePackage(*PackageName);
 
@@ -2391,6 +2754,49 @@ void UCesiumFeaturesMetadataComponent::GenerateMaterial() {
     Package->SetDirtyFlag(true);
   }
 
+  TArray<UMaterialExpression*> AutoGeneratedNodes;
+  TArray<UMaterialExpression*> OneTimeGeneratedNodes;
+
+  GenerateMaterialNodes(
+      this,
+      AutoGeneratedNodes,
+      OneTimeGeneratedNodes,
+      SelectTexCoordsFunction,
+      GetFeatureIdsFromAttributeFunction,
+      GetFeatureIdsFromTextureFunction);
+
+  for (UMaterialExpression* AutoGeneratedNode : AutoGeneratedNodes) {
+    // Mark as auto-generated. If the material is regenerated, we will look
+    // for this exact description to determine whether it was autogenerated.
+    AutoGeneratedNode->Desc = AutogeneratedMessage;
+  }
+
+  if (Overwriting && OneTimeGeneratedNodes.IsEmpty()) {
+    // Leave the layer as it is if it already has the same nodes, rather than
+    // replacing them and compiling every material that uses it again. The
+    // nodes that were just generated are garbage collected.
+    MaterialNodeClassification Classification;
+    ClassifyNodes(
+        this->TargetMaterialLayer,
+        Classification,
+        GetFeatureIdsFromAttributeFunction,
+        GetFeatureIdsFromTextureFunction);
+    if (HashAutoGeneratedNodes(Classification.AutoGeneratedNodes) ==
+        HashAutoGeneratedNodes(AutoGeneratedNodes)) {
+      UE_LOG(
+          LogCesium,
+          Log,
+          TEXT("The material layer %s is already up to date."),
+          *this->TargetMaterialLayer->GetName());
+      return;
+    }
+  }
+
+  if (Overwriting) {
+    GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()
+        ->CloseAllEditorsForAsset(this->TargetMaterialLayer);
+  }
+
   this->TargetMaterialLayer->PreEditChange(NULL);
 
   // Maps autogenerated nodes to the FExpressionInputs that it previously sent
@@ -2407,25 +2813,8 @@ void UCesiumFeaturesMetadataComponent::GenerateMaterial() {
       GetFeatureIdsFromAttributeFunction,
       GetFeatureIdsFromTextureFunction);
 
-  TArray<UMaterialExpression*> AutoGeneratedNodes;
-  TArray<UMaterialExpression*> OneTimeGeneratedNodes;
-
-  GenerateMaterialNodes(
-      this,
-      AutoGeneratedNodes,
-      OneTimeGeneratedNodes,
-      SelectTexCoordsFunction,
-      GetFeatureIdsFromAttributeFunction,
-      GetFeatureIdsFromTextureFunction);
-
   // Add the generated nodes to the material.
-
   for (UMaterialExpression* AutoGeneratedNode : AutoGeneratedNodes) {
-    // Mark as auto-generated. If the material is regenerated, we will look
-    // for this exact description to determine whether it was autogenerated.
-
-    AutoGeneratedNode->Desc = AutogeneratedMessage;
-
     this->TargetMaterialLayer->GetExpressionCollection().AddExpression(
         AutoGeneratedNode);
   }
@@ -2479,4 +2868,29 @@ void UCesiumFeaturesMetadataComponent::GenerateMaterial() {
   }
 }
 
+void UCesiumFeaturesMetadataComponent::PostEditChangeChainProperty(
+    FPropertyChangedChainEvent& PropertyChangedChainEvent) {
+  Super::PostEditChangeChainProperty(PropertyChangedChainEvent);
+
+  if (PropertyChangedChainEvent.PropertyChain.IsEmpty()) {
+    return;
+  }
+
+  FName PropName =
+      PropertyChangedChainEvent.PropertyChain.GetHead()->GetValue()->GetFName();
+  if (PropName != GET_MEMBER_NAME_CHECKED(
+                      UCesiumFeaturesMetadataComponent,
+                      PropertyTables) &&
+      PropName != GET_MEMBER_NAME_CHECKED(
+                      UCesiumFeaturesMetadataComponent,
+                      DiscardUnencodedPropertyTableData)) {
+    return;
+  }
+
+  ACesium3DTileset* pTileset = Cast<ACesium3DTileset>(this->GetOwner());
+  if (pTileset) {
+    pTileset->UpdateFeaturesMetadata();
+  }
+}
+
 #endif // WITH_EDITOR
@@ -1,12 +1,19 @@
 #include "CesiumFlyToComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCamera.h"
+#include "CesiumCameraManager.h"
 #include "CesiumGeoreference.h"
 #include "CesiumGlobeAnchorComponent.h"
 #include "CesiumWgs84Ellipsoid.h"
 #include "Curves/CurveFloat.h"
+#include "EngineUtils.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "UObject/ConstructorHelpers.h"
 
+#include <algorithm>
 #include <glm/gtx/quaternion.hpp>
 
 UCesiumFlyToComponent::UCesiumFlyToComponent() {
@@ -133,6 +140,9 @@ void UCesiumFlyToComponent::FlyToLocationEarthCenteredEarthFixed(
   this->_canInterruptByMoving = CanInterruptByMoving;
   this->_previousPositionEcef = ecefSource;
   this->_flightInProgress = true;
+
+  this->sampleFlightPath();
+  this->addPreloadCameras();
 }
 
 void UCesiumFlyToComponent::FlyToLocationLongitudeLatitudeHeight(
@@ -185,6 +195,9 @@ void UCesiumFlyToComponent::FlyToLocationUnreal(
 
 void UCesiumFlyToComponent::InterruptFlight() {
   this->_flightInProgress = false;
+  this->_sampledPositionsEcef.Empty();
+  this->_sampledFlyPercentages.Empty();
+  this->removePreloadCameras();
 
   UCesiumGlobeAnchorComponent* GlobeAnchor = this->GetGlobeAnchor();
   if (IsValid(GlobeAnchor)) {
@@ -224,19 +237,14 @@ void UCesiumFlyToComponent::TickComponent(
 
   this->_currentFlyTime += DeltaTime;
 
-  // In order to accelerate at start and slow down at end, we use a progress
-  // profile curve
-  float flyPercentage;
-  if (this->_currentFlyTime >= this->Duration) {
-    flyPercentage = 1.0f;
-  } else if (this->ProgressCurve) {
-    flyPercentage = glm::clamp(
-        this->ProgressCurve->GetFloatValue(
-            this->_currentFlyTime / this->Duration),
-        0.0f,
-        1.0f);
+  FVector currentPosition;
+  float flyPercentage = 0.0f;
+  if (this->_sampledPositionsEcef.IsEmpty()) {
+    flyPercentage = this->computeFlyPercentage(this->_currentFlyTime);
   } else {
-    flyPercentage = this->_currentFlyTime / this->Duration;
+    flyPercentage = this->evaluateSampledFlightPath(
+        this->_currentFlyTime,
+        currentPosition);
   }
 
   // If we reached the end, set actual destination location and
@@ -248,6 +256,9 @@ void UCesiumFlyToComponent::TickComponent(
     this->SetCurrentRotationEastSouthUp(this->_destinationRotation);
     this->_flightInProgress = false;
     this->_currentFlyTime = 0.0f;
+    this->_sampledPositionsEcef.Empty();
+    this->_sampledFlyPercentages.Empty();
+    this->removePreloadCameras();
 
     // Trigger callback accessible from BP
     UE_LOG(LogCesium, Verbose, TEXT("Broadcasting OnFlightComplete"));
@@ -257,8 +268,50 @@ void UCesiumFlyToComponent::TickComponent(
   }
 
   // We're currently in flight. Interpolate the position and orientation:
+  if (this->_sampledPositionsEcef.IsEmpty()) {
+    currentPosition =
+        this->computePositionEarthCenteredEarthFixed(flyPercentage);
+  }
+
+  // Set Location
+  GlobeAnchor->MoveToEarthCenteredEarthFixedPosition(currentPosition);
+
+  // Interpolate rotation in the ESU frame. The local ESU ControlRotation will
+  // be transformed to the appropriate world rotation as we fly.
+  FQuat currentQuat = FQuat::Slerp(
+      this->_sourceRotation,
+      this->_destinationRotation,
+      flyPercentage);
+  this->SetCurrentRotationEastSouthUp(currentQuat);
+
+  this->_previousPositionEcef =
+      GlobeAnchor->GetEarthCenteredEarthFixedPosition();
+
+  this->updatePreloadCameras(flyPercentage);
+}
+
+void UCesiumFlyToComponent::OnComponentDestroyed(bool bDestroyingHierarchy) {
+  this->removePreloadCameras();
+  Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+float UCesiumFlyToComponent::computeFlyPercentage(float flyTime) const {
+  // In order to accelerate at start and slow down at end, we use a progress
+  // profile curve
+  if (flyTime >= this->Duration) {
+    return 1.0f;
+  } else if (this->ProgressCurve) {
+    return glm::clamp(
+        this->ProgressCurve->GetFloatValue(flyTime / this->Duration),
+        0.0f,
+        1.0f);
+  } else {
+    return flyTime / this->Duration;
+  }
+}
 
-  // Get the current position by interpolating with flyPercentage
+FVector UCesiumFlyToComponent::computePositionEarthCenteredEarthFixed(
+    float flyPercentage) const {
   // Rotate our normalized source direction, interpolating with time
   FVector rotatedDirection = this->_sourceDirection.RotateAngleAxis(
       flyPercentage * this->_totalAngle,
@@ -283,21 +336,178 @@ void UCesiumFlyToComponent::TickComponent(
     altitudeOffset += curveOffset;
   }
 
-  FVector currentPosition = geodeticPosition + geodeticUp * altitudeOffset;
+  return geodeticPosition + geodeticUp * altitudeOffset;
+}
 
-  // Set Location
-  GlobeAnchor->MoveToEarthCenteredEarthFixedPosition(currentPosition);
+void UCesiumFlyToComponent::sampleFlightPath() {
+  this->_sampledPositionsEcef.Reset();
+  this->_sampledFlyPercentages.Reset();
+  if (this->FlightPathSamples <= 0 || this->Duration <= 0.0f) {
+    return;
+  }
 
-  // Interpolate rotation in the ESU frame. The local ESU ControlRotation will
-  // be transformed to the appropriate world rotation as we fly.
-  FQuat currentQuat = FQuat::Slerp(
-      this->_sourceRotation,
-      this->_destinationRotation,
-      flyPercentage);
-  this->SetCurrentRotationEastSouthUp(currentQuat);
+  const int32 count = std::max(this->FlightPathSamples, 2);
+  this->_sampledPositionsEcef.Reserve(count);
+  this->_sampledFlyPercentages.Reserve(count);
+  for (int32 i = 0; i < count; ++i) {
+    const float flyPercentage = this->computeFlyPercentage(
+        this->Duration * float(i) / float(count - 1));
+    this->_sampledFlyPercentages.Add(flyPercentage);
+    this->_sampledPositionsEcef.Add(
+        this->computePositionEarthCenteredEarthFixed(flyPercentage));
+  }
+}
 
-  this->_previousPositionEcef =
-      GlobeAnchor->GetEarthCenteredEarthFixedPosition();
+float UCesiumFlyToComponent::evaluateSampledFlightPath(
+    float flyTime,
+    FVector& positionEcef) const {
+  const int32 count = this->_sampledPositionsEcef.Num();
+  const float sample =
+      FMath::Clamp(flyTime / this->Duration, 0.0f, 1.0f) * float(count - 1);
+  const int32 i = FMath::Min(FMath::FloorToInt32(sample), count - 2);
+  const float t = sample - float(i);
+
+  // A Catmull-Rom spline through the samples keeps the path smooth where it
+  // curves, such as at the top of the height profile.
+  const FVector& p0 = this->_sampledPositionsEcef[FMath::Max(i - 1, 0)];
+  const FVector& p1 = this->_sampledPositionsEcef[i];
+  const FVector& p2 = this->_sampledPositionsEcef[i + 1];
+  const FVector& p3 = this->_sampledPositionsEcef[FMath::Min(i + 2, count - 1)];
+  const double t2 = double(t) * double(t);
+  const double t3 = t2 * double(t);
+  positionEcef = 0.5 * ((2.0 * p1) + (p2 - p0) * double(t) +
+                        (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3) * t2 +
+                        (3.0 * p1 - p0 - 3.0 * p2 + p3) * t3);
+
+  return FMath::Lerp(
+      this->_sampledFlyPercentages[i],
+      this->_sampledFlyPercentages[i + 1],
+      t);
+}
+
+bool UCesiumFlyToComponent::computePreloadCamera(
+    float flyPercentage,
+    FCesiumCamera& camera) {
+  UCesiumGlobeAnchorComponent* GlobeAnchor = this->GetGlobeAnchor();
+  ACesiumGeoreference* Georeference =
+      IsValid(GlobeAnchor) ? GlobeAnchor->ResolveGeoreference() : nullptr;
+  if (!IsValid(Georeference)) {
+    return false;
+  }
+
+  const FVector positionEcef =
+      flyPercentage >= 1.0f
+          ? this->_destinationEcef
+          : this->computePositionEarthCenteredEarthFixed(flyPercentage);
+  camera.Location =
+      Georeference->TransformEarthCenteredEarthFixedPositionToUnreal(
+          positionEcef);
+  camera.Rotation = Georeference->TransformEastSouthUpRotatorToUnreal(
+      FQuat::Slerp(
+          this->_sourceRotation,
+          this->_destinationRotation,
+          flyPercentage)
+          .Rotator(),
+      camera.Location);
+
+  // Use the player's viewport and field of view if this is a player's pawn,
+  // or typical values otherwise.
+  camera.ViewportSize = FVector2D(1920.0, 1080.0);
+  camera.FieldOfViewDegrees = 90.0;
+  camera.OverrideAspectRatio = 0.0;
+
+  APawn* Pawn = Cast<APawn>(this->GetOwner());
+  APlayerController* Controller =
+      IsValid(Pawn) ? Cast<APlayerController>(Pawn->Controller) : nullptr;
+  if (Controller) {
+    int32 sizeX = 0;
+    int32 sizeY = 0;
+    Controller->GetViewportSize(sizeX, sizeY);
+    if (sizeX > 0 && sizeY > 0) {
+      camera.ViewportSize = FVector2D(sizeX, sizeY);
+    }
+
+    if (Controller->PlayerCameraManager) {
+      camera.FieldOfViewDegrees =
+          Controller->PlayerCameraManager->GetFOVAngle();
+    }
+  }
+
+  return true;
+}
+
+void UCesiumFlyToComponent::addPreloadCameras() {
+  this->removePreloadCameras();
+
+  UWorld* pWorld = this->GetWorld();
+  if (!this->PreloadTilesAlongFlight || !pWorld) {
+    return;
+  }
+
+  // Tilesets may use different Camera Managers, so add the cameras to each of
+  // them.
+  TArray<ACesiumCameraManager*> cameraManagers;
+  for (TActorIterator<ACesium3DTileset> it(pWorld); it; ++it) {
+    ACesiumCameraManager* pCameraManager = it->ResolveCameraManager();
+    if (IsValid(pCameraManager)) {
+      cameraManagers.AddUnique(pCameraManager);
+    }
+  }
+
+  // The views are evenly spaced in time, and the last one is the destination.
+  const int32 viewCount = std::max(this->PreloadFlightPathSteps, 0) + 1;
+  for (int32 i = 1; i <= viewCount; ++i) {
+    const float flyPercentage = this->computeFlyPercentage(
+        this->Duration * float(i) / float(viewCount));
+
+    FCesiumCamera camera;
+    if (!this->computePreloadCamera(flyPercentage, camera)) {
+      return;
+    }
+
+    for (ACesiumCameraManager* pCameraManager : cameraManagers) {
+      this->_preloadCameras.Add(PreloadCamera{
+          pCameraManager,
+          pCameraManager->AddCamera(camera),
+          flyPercentage});
+    }
+  }
+}
+
+void UCesiumFlyToComponent::updatePreloadCameras(float flyPercentage) {
+  for (int32 i = this->_preloadCameras.Num() - 1; i >= 0; --i) {
+    const PreloadCamera& preloadCamera = this->_preloadCameras[i];
+    ACesiumCameraManager* pCameraManager = preloadCamera.pCameraManager.Get();
+    if (!pCameraManager) {
+      this->_preloadCameras.RemoveAtSwap(i, 1, false);
+      continue;
+    }
+
+    if (preloadCamera.flyPercentage <= flyPercentage) {
+      // The flight has passed this view, so its tiles are no longer needed
+      // ahead of time.
+      pCameraManager->RemoveCamera(preloadCamera.cameraId);
+      this->_preloadCameras.RemoveAtSwap(i, 1, false);
+      continue;
+    }
+
+    // Recompute the camera in case the georeference origin has moved during
+    // the flight.
+    FCesiumCamera camera;
+    if (this->computePreloadCamera(preloadCamera.flyPercentage, camera)) {
+      pCameraManager->UpdateCamera(preloadCamera.cameraId, camera);
+    }
+  }
+}
+
+void UCesiumFlyToComponent::removePreloadCameras() {
+  for (const PreloadCamera& preloadCamera : this->_preloadCameras) {
+    ACesiumCameraManager* pCameraManager = preloadCamera.pCameraManager.Get();
+    if (pCameraManager) {
+      pCameraManager->RemoveCamera(preloadCamera.cameraId);
+    }
+  }
+  this->_preloadCameras.Empty();
 }
 
 FQuat UCesiumFlyToComponent::GetCurrentRotationEastSouthUp() {
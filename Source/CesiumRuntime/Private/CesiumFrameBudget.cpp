@@ -0,0 +1,93 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumFrameBudget.h"
+#include "CesiumRuntimeSettings.h"
+#include "CoreGlobals.h"
+#include "Engine/World.h"
+#include <algorithm>
+
+namespace {
+// Small enough that cesium-native will stop immediately after finalizing the
+// first tile in its queue, but still positive so it isn't treated as
+// "unlimited".
+constexpr double MinimumTimeLimitMilliseconds = 0.001;
+} // namespace
+
+/*static*/ TMap<TObjectKey<UWorld>, CesiumFrameBudget::WorldFrame>
+    CesiumFrameBudget::_frames{};
+/*static*/ double CesiumFrameBudget::_totalMainThreadLoadingMilliseconds = 0.0;
+
+/*static*/ double
+CesiumFrameBudget::getMainThreadLoadingTimeLimit(const UWorld* pWorld) {
+  const double budget = static_cast<double>(
+      GetDefault<UCesiumRuntimeSettings>()->MainThreadLoadingTimeBudget);
+  if (budget <= 0.0) {
+    return 0.0;
+  }
+
+  const WorldFrame& frame = getCurrentFrame(pWorld);
+  return std::max(
+      budget - frame.mainThreadLoadingMilliseconds,
+      MinimumTimeLimitMilliseconds);
+}
+
+/*static*/ void CesiumFrameBudget::recordMainThreadLoadingTime(
+    const UWorld* pWorld,
+    double milliseconds) {
+  getCurrentFrame(pWorld).mainThreadLoadingMilliseconds += milliseconds;
+  _totalMainThreadLoadingMilliseconds += milliseconds;
+}
+
+/*static*/ double
+CesiumFrameBudget::getMainThreadLoadingTimeThisFrame(const UWorld* pWorld) {
+  return getCurrentFrame(pWorld).mainThreadLoadingMilliseconds;
+}
+
+/*static*/ double
+CesiumFrameBudget::getMainThreadLoadingTimeThisFrameInAllWorlds() {
+  double milliseconds = 0.0;
+  for (const auto& pair : _frames) {
+    if (pair.Value.frameNumber == GFrameCounter) {
+      milliseconds += pair.Value.mainThreadLoadingMilliseconds;
+    }
+  }
+  return milliseconds;
+}
+
+/*static*/ double CesiumFrameBudget::reduceMainThreadLoadingTimeLimit(
+    double limit,
+    double milliseconds) {
+  if (limit <= 0.0) {
+    return limit;
+  }
+  return std::max(limit - milliseconds, MinimumTimeLimitMilliseconds);
+}
+
+/*static*/ double CesiumFrameBudget::getTotalMainThreadLoadingTime() {
+  return _totalMainThreadLoadingMilliseconds;
+}
+
+/*static*/ CesiumFrameBudget::WorldFrame&
+CesiumFrameBudget::getCurrentFrame(const UWorld* pWorld) {
+  const uint64 frameNumber = GFrameCounter;
+  const TObjectKey<UWorld> key(pWorld);
+
+  WorldFrame* pFrame = _frames.Find(key);
+  if (pFrame && pFrame->frameNumber == frameNumber) {
+    return *pFrame;
+  }
+
+  // First use of this world in a new frame. Drop any worlds that weren't
+  // updated last frame, too, so that PIE and editor preview worlds don't
+  // accumulate here.
+  for (auto it = _frames.CreateIterator(); it; ++it) {
+    if (it.Value().frameNumber + 1 < frameNumber) {
+      it.RemoveCurrent();
+    }
+  }
+
+  WorldFrame& frame = _frames.FindOrAdd(key);
+  frame.frameNumber = frameNumber;
+  frame.mainThreadLoadingMilliseconds = 0.0;
+  return frame;
+}
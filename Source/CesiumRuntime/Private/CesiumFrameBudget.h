@@ -0,0 +1,81 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "UObject/ObjectKey.h"
+
+class UWorld;
+
+/**
+ * Tracks the game-thread time spent finalizing tile renderer resources in the
+ * current frame, summed across every tileset in a world, including the
+ * textures of raster overlay tiles. This lets all of the tilesets in a world
+ * share a single per-frame budget, rather than each one being allowed its
+ * own, which multiplies the worst-case hitch by the number of tilesets.
+ */
+class CesiumFrameBudget {
+public:
+  /**
+   * Gets the value to use for
+   * `Cesium3DTilesSelection::TilesetOptions::mainThreadLoadingTimeLimit` for
+   * a tileset in the given world that is about to be updated this frame.
+   *
+   * When the budget has already been exhausted by other tilesets, this
+   * returns a very small positive limit so that each tileset still finalizes
+   * at least one tile (its highest priority one) per frame and loading can
+   * never stall entirely. A return value of 0.0 means the budget is disabled
+   * and there is no limit.
+   */
+  static double getMainThreadLoadingTimeLimit(const UWorld* pWorld);
+
+  /**
+   * Records time spent on the game thread preparing tile renderer resources
+   * for a tileset in the given world.
+   */
+  static void recordMainThreadLoadingTime(
+      const UWorld* pWorld,
+      double milliseconds);
+
+  /**
+   * Gets the total time, in milliseconds, spent on the game thread preparing
+   * tile renderer resources for the given world in the current frame.
+   */
+  static double getMainThreadLoadingTimeThisFrame(const UWorld* pWorld);
+
+  /**
+   * Gets the total time, in milliseconds, spent on the game thread preparing
+   * tile renderer resources for every world in the current frame.
+   */
+  static double getMainThreadLoadingTimeThisFrameInAllWorlds();
+
+  /**
+   * Reduces a tileset's `mainThreadLoadingTimeLimit` by time that was spent
+   * on other main thread work after the limit was computed, such as
+   * preparing raster overlay tiles while the tileset updates. A limit of 0.0,
+   * which means there is no limit, is left unchanged, and the limit is never
+   * reduced below the small positive limit that still lets the tileset
+   * finalize one tile.
+   */
+  static double reduceMainThreadLoadingTimeLimit(
+      double limit,
+      double milliseconds);
+
+  /**
+   * Gets the total time, in milliseconds, spent on the game thread preparing
+   * tile renderer resources in all worlds since startup. Benchmarks take the
+   * difference between two calls to measure a span of frames.
+   */
+  static double getTotalMainThreadLoadingTime();
+
+private:
+  struct WorldFrame {
+    uint64 frameNumber;
+    double mainThreadLoadingMilliseconds;
+  };
+
+  static WorldFrame& getCurrentFrame(const UWorld* pWorld);
+
+  static TMap<TObjectKey<UWorld>, WorldFrame> _frames;
+  static double _totalMainThreadLoadingMilliseconds;
+};
@@ -3,8 +3,10 @@
 #include "CesiumGeoreference.h"
 #include "Camera/PlayerCameraManager.h"
 #include "CesiumActors.h"
+#include "CesiumBatchTransforms.h"
 #include "CesiumCommon.h"
 #include "CesiumCustomVersion.h"
+#include "CesiumGlobeAnchorBatch.h"
 #include "CesiumGeospatial/Cartographic.h"
 #include "CesiumOriginShiftComponent.h"
 #include "CesiumRuntime.h"
@@ -296,6 +298,52 @@ FVector ACesiumGeoreference::TransformUnrealPositionToEarthCenteredEarthFixed(
       VecMath::createVector3D(UnrealPosition)));
 }
 
+TArray<FVector>
+ACesiumGeoreference::TransformLongitudeLatitudeHeightPositionsToUnreal(
+    const TArray<FVector>& LongitudeLatitudeHeights) const {
+  TArray<FVector> result = LongitudeLatitudeHeights;
+  CesiumBatchTransforms::transformLongitudeLatitudeHeightPositions(
+      Ellipsoid::WGS84,
+      this->_coordinateSystem.getEcefToLocalTransformation(),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
+TArray<FVector>
+ACesiumGeoreference::TransformUnrealPositionsToLongitudeLatitudeHeight(
+    const TArray<FVector>& UnrealPositions) const {
+  TArray<FVector> result = UnrealPositions;
+  CesiumBatchTransforms::transformPositionsToLongitudeLatitudeHeight(
+      Ellipsoid::WGS84,
+      this->_coordinateSystem.getLocalToEcefTransformation(),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
+TArray<FVector>
+ACesiumGeoreference::TransformEarthCenteredEarthFixedPositionsToUnreal(
+    const TArray<FVector>& EarthCenteredEarthFixedPositions) const {
+  TArray<FVector> result = EarthCenteredEarthFixedPositions;
+  CesiumBatchTransforms::transformPositions(
+      this->_coordinateSystem.getEcefToLocalTransformation(),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
+TArray<FVector>
+ACesiumGeoreference::TransformUnrealPositionsToEarthCenteredEarthFixed(
+    const TArray<FVector>& UnrealPositions) const {
+  TArray<FVector> result = UnrealPositions;
+  CesiumBatchTransforms::transformPositions(
+      this->_coordinateSystem.getLocalToEcefTransformation(),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
 FVector ACesiumGeoreference::TransformEarthCenteredEarthFixedDirectionToUnreal(
     const FVector& EarthCenteredEarthFixedDirection) const {
   return VecMath::createVector(this->_coordinateSystem.ecefDirectionToLocal(
@@ -308,6 +356,28 @@ FVector ACesiumGeoreference::TransformUnrealDirectionToEarthCenteredEarthFixed(
       VecMath::createVector3D(UnrealDirection)));
 }
 
+TArray<FVector>
+ACesiumGeoreference::TransformEarthCenteredEarthFixedDirectionsToUnreal(
+    const TArray<FVector>& EarthCenteredEarthFixedDirections) const {
+  TArray<FVector> result = EarthCenteredEarthFixedDirections;
+  CesiumBatchTransforms::transformDirections(
+      this->_coordinateSystem.getEcefToLocalTransformation(),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
+TArray<FVector>
+ACesiumGeoreference::TransformUnrealDirectionsToEarthCenteredEarthFixed(
+    const TArray<FVector>& UnrealDirections) const {
+  TArray<FVector> result = UnrealDirections;
+  CesiumBatchTransforms::transformDirections(
+      this->_coordinateSystem.getLocalToEcefTransformation(),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
 FRotator ACesiumGeoreference::TransformUnrealRotatorToEastSouthUp(
     const FRotator& UnrealRotator,
     const FVector& UnrealLocation) const {
@@ -839,6 +909,15 @@ ACesiumGeoreference::ACesiumGeoreference() : AActor() {
           "SubLevelSwitcher");
 }
 
+ACesiumGeoreference::~ACesiumGeoreference() = default;
+
+CesiumGlobeAnchorBatch& ACesiumGeoreference::GetGlobeAnchorBatch() {
+  if (!this->_pGlobeAnchorBatch) {
+    this->_pGlobeAnchorBatch = MakeUnique<CesiumGlobeAnchorBatch>();
+  }
+  return *this->_pGlobeAnchorBatch;
+}
+
 void ACesiumGeoreference::UpdateGeoreference() {
   this->_updateCoordinateSystem();
 
@@ -859,6 +938,10 @@ void ACesiumGeoreference::UpdateGeoreference() {
     }
   }
 
+  if (this->_pGlobeAnchorBatch) {
+    this->_pGlobeAnchorBatch->update(this->_coordinateSystem);
+  }
+
   UE_LOG(
       LogCesium,
       Verbose,
@@ -0,0 +1,104 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGlobeAnchorBatch.h"
+#include "Async/ParallelFor.h"
+#include "CesiumGeospatial/LocalHorizontalCoordinateSystem.h"
+#include "CesiumGlobeAnchorComponent.h"
+#include "CesiumRuntime.h"
+#include "VecMath.h"
+#include <algorithm>
+
+namespace {
+// The fewest anchors that are worth handing to a worker thread. Georeference
+// updates for levels with fewer anchors than this are done entirely on the
+// game thread.
+constexpr int32 MinimumAnchorsPerParallelBatch = 256;
+} // namespace
+
+void CesiumGlobeAnchorBatch::add(UCesiumGlobeAnchorComponent* pAnchor) {
+  check(IsInGameThread());
+
+  if (!pAnchor || this->contains(pAnchor)) {
+    return;
+  }
+
+  pAnchor->_globeAnchorBatchIndex = this->_anchors.Add(pAnchor);
+}
+
+void CesiumGlobeAnchorBatch::remove(UCesiumGlobeAnchorComponent* pAnchor) {
+  check(IsInGameThread());
+
+  if (!pAnchor || !this->contains(pAnchor)) {
+    return;
+  }
+
+  // Move the last anchor into the removed one's place so that the array stays
+  // contiguous.
+  const int32 index = pAnchor->_globeAnchorBatchIndex;
+  this->_anchors.RemoveAtSwap(index, 1, false);
+  if (index < this->_anchors.Num()) {
+    this->_anchors[index]->_globeAnchorBatchIndex = index;
+  }
+  pAnchor->_globeAnchorBatchIndex = INDEX_NONE;
+}
+
+void CesiumGlobeAnchorBatch::update(
+    const CesiumGeospatial::LocalHorizontalCoordinateSystem& local) {
+  check(IsInGameThread());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateGlobeAnchors)
+
+  // Gather the globe transforms. Anchors without one yet are updated from
+  // their actor's transform instead, when they're next synchronized.
+  this->_updating.Reset();
+  this->_anchorToFixed.Reset();
+  for (UCesiumGlobeAnchorComponent* pAnchor : this->_anchors) {
+    if (IsValid(pAnchor) && pAnchor->_actorToECEFIsValid) {
+      this->_updating.Add(pAnchor);
+      this->_anchorToFixed.Add(VecMath::createMatrix4D(
+          pAnchor->ActorToEarthCenteredEarthFixedMatrix));
+    }
+  }
+
+  // Compute the new relative transforms. This is the equivalent of
+  // GlobeAnchor::getAnchorToLocalTransform for every anchor.
+  const int32 anchorCount = this->_anchorToFixed.Num();
+  this->_relativeTransforms.SetNum(anchorCount, false);
+
+  const glm::dmat4& ecefToLocal = local.getEcefToLocalTransformation();
+  const int32 batchCount =
+      (anchorCount + MinimumAnchorsPerParallelBatch - 1) /
+      MinimumAnchorsPerParallelBatch;
+  ParallelFor(
+      batchCount,
+      [this, &ecefToLocal, anchorCount](int32 batch) {
+        const int32 begin = batch * MinimumAnchorsPerParallelBatch;
+        const int32 end =
+            std::min(begin + MinimumAnchorsPerParallelBatch, anchorCount);
+        for (int32 i = begin; i < end; ++i) {
+          this->_relativeTransforms[i] = FTransform(
+              VecMath::createMatrix(ecefToLocal * this->_anchorToFixed[i]));
+        }
+      },
+      batchCount > 1 ? EParallelForFlags::None
+                     : EParallelForFlags::ForceSingleThread);
+
+  // Apply them. Moving an actor can run arbitrary code, so skip any anchor
+  // that was destroyed or left this batch while earlier ones were applied.
+  for (int32 i = 0; i < anchorCount; ++i) {
+    UCesiumGlobeAnchorComponent* pAnchor = this->_updating[i].Get();
+    if (IsValid(pAnchor) && this->contains(pAnchor)) {
+      pAnchor->_applyRelativeTransformFromGeoreference(
+          this->_relativeTransforms[i]);
+    }
+  }
+
+  this->_updating.Reset();
+}
+
+bool CesiumGlobeAnchorBatch::contains(
+    const UCesiumGlobeAnchorComponent* pAnchor) const {
+  const int32 index = pAnchor->_globeAnchorBatchIndex;
+  return this->_anchors.IsValidIndex(index) &&
+         this->_anchors[index] == pAnchor;
+}
@@ -0,0 +1,62 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Transform.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <glm/mat4x4.hpp>
+
+class UCesiumGlobeAnchorComponent;
+
+namespace CesiumGeospatial {
+class LocalHorizontalCoordinateSystem;
+} // namespace CesiumGeospatial
+
+/**
+ * The globe anchors that use a particular georeference, which are updated
+ * together when the georeference's origin changes.
+ *
+ * Rather than having every anchor respond to OnGeoreferenceUpdated on its own,
+ * the georeference updates all of its anchors in three passes. The anchors'
+ * globe transforms are gathered into contiguous arrays, their new Unreal
+ * transforms are computed from those on worker threads, and then the new
+ * transforms are applied to the anchored actors in one pass.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumGlobeAnchorBatch {
+public:
+  /**
+   * Adds an anchor to the batch, if it is not already in it.
+   */
+  void add(UCesiumGlobeAnchorComponent* pAnchor);
+
+  /**
+   * Removes an anchor from the batch, if it is in it.
+   */
+  void remove(UCesiumGlobeAnchorComponent* pAnchor);
+
+  /**
+   * Gets the number of anchors in the batch.
+   */
+  int32 getCount() const { return this->_anchors.Num(); }
+
+  /**
+   * Recomputes the Unreal transform of every anchor with a valid globe
+   * transform from the given coordinate system, and applies it to the anchored
+   * actor.
+   */
+  void update(const CesiumGeospatial::LocalHorizontalCoordinateSystem& local);
+
+private:
+  bool contains(const UCesiumGlobeAnchorComponent* pAnchor) const;
+
+  TArray<UCesiumGlobeAnchorComponent*> _anchors;
+
+  // The anchors being updated and their transforms, reused across updates so
+  // that an update doesn't allocate.
+  TArray<TWeakObjectPtr<UCesiumGlobeAnchorComponent>> _updating;
+  TArray<glm::dmat4> _anchorToFixed;
+  TArray<FTransform> _relativeTransforms;
+};
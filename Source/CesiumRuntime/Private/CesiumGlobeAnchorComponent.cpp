@@ -4,9 +4,11 @@
 #include "CesiumCustomVersion.h"
 #include "CesiumGeometry/Transforms.h"
 #include "CesiumGeoreference.h"
+#include "CesiumGlobeAnchorBatch.h"
 #include "CesiumRuntime.h"
 #include "CesiumWgs84Ellipsoid.h"
 #include "Components/SceneComponent.h"
+#include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "VecMath.h"
 #include <glm/gtx/quaternion.hpp>
@@ -33,18 +35,27 @@
 //
 // ## Georeference Changed
 //
-// * Detected by subscribing to the `GeoreferenceUpdated` event. The
-// subscription is added when a new Georeference is resolved in
-// `ResolveGeoreference` (in `OnRegister` at the latest) and removed in
-// `InvalidateResolvedGeoreference` (in `OnUnregister` and when the
-// Georeference property is changed).
-// * Updates the Actor transform from the existing ECEF transform.
+// * Happens when the component is added to the `CesiumGlobeAnchorBatch` of a
+// newly-resolved Georeference in `ResolveGeoreference` (in `OnRegister` at the
+// latest), which synchronizes it, and whenever the Georeference is updated
+// while the component is in its batch. The component is removed from the batch
+// in `OnUnregister` and when the Georeference property is changed.
+// * Updates the Actor transform from the existing ECEF transform. The batch
+// does this for all of a Georeference's anchors at once, just before it
+// broadcasts `OnGeoreferenceUpdated`.
 // * Ignores `AdjustOrientationForGlobeWhenMoving` because the globe position is
 // not changing.
 //
 // ## OriginLocation Changed
 //
-// * Handled by Unreal's normal `ApplyWorldOffset` mechanism.
+// * Handled by Unreal's normal `ApplyWorldOffset` mechanism, which moves the
+// Actor without raising `TransformUpdated`.
+// * The relative transform of an unattached root component is in Unreal world
+// coordinates, which are shifted along with the origin. So the `OriginLocation`
+// is added to it before relating it to the globe, in
+// `_getCurrentRelativeTransform`, and subtracted again in
+// `_setCurrentRelativeTransform`. The globe transform is unaffected by the
+// shift.
 
 namespace {
 
@@ -53,6 +64,23 @@ createNativeGlobeAnchor(const FMatrix& actorToECEF) {
   return CesiumGeospatial::GlobeAnchor(VecMath::createMatrix4D(actorToECEF));
 }
 
+/**
+ * Gets the offset from the given root component's relative location to its
+ * location in the frame that is unaffected by world origin rebasing. This is
+ * the world OriginLocation if the relative location is in world coordinates,
+ * and zero otherwise.
+ */
+FVector getWorldOriginOffset(const USceneComponent* pRoot) {
+  if (pRoot->GetAttachParent() != nullptr &&
+      !pRoot->IsUsingAbsoluteLocation()) {
+    return FVector::ZeroVector;
+  }
+
+  const UWorld* pWorld = pRoot->GetWorld();
+  return IsValid(pWorld) ? FVector(pWorld->OriginLocation)
+                         : FVector::ZeroVector;
+}
+
 } // namespace
 
 TSoftObjectPtr<ACesiumGeoreference>
@@ -65,7 +93,7 @@ void UCesiumGlobeAnchorComponent::SetGeoreference(
   ACesiumGeoreference* pOriginal = this->ResolvedGeoreference;
 
   if (IsValid(pOriginal)) {
-    pOriginal->OnGeoreferenceUpdated.RemoveAll(this);
+    pOriginal->GetGlobeAnchorBatch().remove(this);
   }
 
   this->ResolvedGeoreference = nullptr;
@@ -250,15 +278,13 @@ UCesiumGlobeAnchorComponent::ResolveGeoreference(bool bForceReresolve) {
       // old one so that the ECEF and Actor transforms are both up-to-date.
       this->Sync();
 
-      Previous->OnGeoreferenceUpdated.RemoveAll(this);
+      Previous->GetGlobeAnchorBatch().remove(this);
     }
 
     this->ResolvedGeoreference = Next;
 
     if (this->ResolvedGeoreference) {
-      this->ResolvedGeoreference->OnGeoreferenceUpdated.AddUniqueDynamic(
-          this,
-          &UCesiumGlobeAnchorComponent::_onGeoreferenceChanged);
+      this->ResolvedGeoreference->GetGlobeAnchorBatch().add(this);
 
       // Now synchronize based on the new georeference.
       this->Sync();
@@ -523,7 +549,7 @@ void UCesiumGlobeAnchorComponent::OnUnregister() {
 
   // Unsubscribe from the ResolvedGeoreference.
   if (IsValid(this->ResolvedGeoreference)) {
-    this->ResolvedGeoreference->OnGeoreferenceUpdated.RemoveAll(this);
+    this->ResolvedGeoreference->GetGlobeAnchorBatch().remove(this);
   }
   this->ResolvedGeoreference = nullptr;
 
@@ -581,7 +607,9 @@ UCesiumGlobeAnchorComponent::_getRootComponent(bool warnIfNull) const {
 
 FTransform UCesiumGlobeAnchorComponent::_getCurrentRelativeTransform() const {
   const USceneComponent* pOwnerRoot = this->_getRootComponent(true);
-  return pOwnerRoot->GetRelativeTransform();
+  FTransform relativeTransform = pOwnerRoot->GetRelativeTransform();
+  relativeTransform.AddToTranslation(getWorldOriginOffset(pOwnerRoot));
+  return relativeTransform;
 }
 
 void UCesiumGlobeAnchorComponent::_setCurrentRelativeTransform(
@@ -607,11 +635,14 @@ void UCesiumGlobeAnchorComponent::_setCurrentRelativeTransform(
     return;
   }
 
+  FTransform rootRelativeTransform = relativeTransform;
+  rootRelativeTransform.AddToTranslation(-getWorldOriginOffset(pOwnerRoot));
+
   // Set the new Actor relative transform, taking care not to do this
   // recursively.
   this->_updatingActorTransform = true;
   pOwnerRoot->SetRelativeTransform(
-      relativeTransform,
+      rootRelativeTransform,
       false,
       nullptr,
       this->TeleportWhenUpdatingTransform ? ETeleportType::TeleportPhysics
@@ -735,9 +766,22 @@ void UCesiumGlobeAnchorComponent::_setNewActorToECEFFromRelativeTransform() {
 #endif
 }
 
-void UCesiumGlobeAnchorComponent::_onGeoreferenceChanged() {
-  if (this->_actorToECEFIsValid) {
-    this->SetActorToEarthCenteredEarthFixedMatrix(
-        this->ActorToEarthCenteredEarthFixedMatrix);
+void UCesiumGlobeAnchorComponent::_applyRelativeTransformFromGeoreference(
+    const FTransform& relativeTransform) {
+  // This is the same as calling SetActorToEarthCenteredEarthFixedMatrix with
+  // the existing matrix, except that the new relative transform was computed
+  // by the CesiumGlobeAnchorBatch along with those of the other anchors.
+  USceneComponent* pOwnerRoot = this->_getRootComponent(/*warnIfNull*/ true);
+  if (!IsValid(pOwnerRoot)) {
+    return;
   }
+
+  this->_setCurrentRelativeTransform(relativeTransform);
+
+#if WITH_EDITOR
+  // In the Editor, mark this component and the root component modified so Undo
+  // works properly.
+  this->Modify();
+  pOwnerRoot->Modify();
+#endif
 }
@@ -2,6 +2,8 @@
 
 #include "CesiumGltfComponent.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "CesiumClippingVolumeComponent.h"
 #include "CesiumCommon.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
@@ -11,6 +13,7 @@
 #include "CesiumGeometry/Transforms.h"
 #include "CesiumGltf/AccessorView.h"
 #include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltf/ExtensionExtMeshGpuInstancing.h"
 #include "CesiumGltf/ExtensionKhrMaterialsUnlit.h"
 #include "CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h"
 #include "CesiumGltf/ExtensionModelExtFeatureMetadata.h"
@@ -20,21 +23,35 @@
 #include "CesiumGltfContent/GltfUtilities.h"
 #include "CesiumGltfPointsComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumMaterialParameterNames.h"
+#include "CesiumMaterialPool.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumNaniteBuilder.h"
+#include "CesiumPhysicsMeshUtility.h"
+#include "CesiumPointAttenuationVertexFactory.h"
+#include "CesiumPreparedMeshCache.h"
+#include "CesiumPrimitiveComponentPool.h"
+#include "CesiumPrimitiveMerging.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumRasterOverlays/RasterOverlay.h"
 #include "CesiumRasterOverlays/RasterOverlayTile.h"
 #include "CesiumRuntime.h"
+#include "CesiumTextureCache.h"
+#include "CesiumTextureStreaming.h"
 #include "CesiumTextureUtility.h"
 #include "CesiumTransforms.h"
 #include "CesiumUtility/Tracing.h"
 #include "CesiumUtility/joinToString.h"
+#include "CesiumVertexKernels.h"
+#include "CesiumVertexPullingVertexFactory.h"
 #include "Chaos/AABBTree.h"
 #include "Chaos/CollisionConvexMesh.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "CreateGltfOptions.h"
 #include "Engine/CollisionProfile.h"
 #include "Engine/StaticMesh.h"
+#include "Hash/CityHash.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "LoadGltfResult.h"
@@ -46,11 +63,13 @@
 #include "PixelFormat.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "StaticMeshOperations.h"
+#include "SceneInterface.h"
 #include "StaticMeshResources.h"
 #include "UObject/ConstructorHelpers.h"
 #include "VecMath.h"
 #include "mikktspace.h"
 #include <cstddef>
+#include <deque>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -61,6 +80,10 @@
 #include "ScopedTransaction.h"
 #endif
 
+#if ENGINE_VERSION_5_2_OR_HIGHER
+#include "DataDrivenShaderPlatformInfo.h"
+#endif
+
 using namespace CesiumGltf;
 using namespace CesiumTextureUtility;
 using namespace CreateGltfOptions;
@@ -76,7 +99,7 @@ static uint32_t nextMaterialId = 0;
 
 namespace {
 void destroyHalfLoadedTexture(
-    TUniquePtr<CesiumTextureUtility::LoadedTextureResult>& pHalfLoadedTexture) {
+    TSharedPtr<CesiumTextureUtility::LoadedTextureResult>& pHalfLoadedTexture) {
   if (pHalfLoadedTexture) {
     CesiumTextureUtility::destroyHalfLoadedTexture(*pHalfLoadedTexture.Get());
   }
@@ -102,6 +125,31 @@ public:
       }
     }
   }
+
+  virtual FGraphEventArray getTextureCreationEvents() const override {
+    FGraphEventArray events;
+    for (const LoadNodeResult& node : loadModelResult.nodeResults) {
+      if (node.meshResult) {
+        for (const LoadPrimitiveResult& primitive :
+             node.meshResult->primitiveResults) {
+          addTextureCreationEvent(primitive.baseColorTexture.Get(), events);
+          addTextureCreationEvent(
+              primitive.metallicRoughnessTexture.Get(),
+              events);
+          addTextureCreationEvent(primitive.normalTexture.Get(), events);
+          addTextureCreationEvent(primitive.emissiveTexture.Get(), events);
+          addTextureCreationEvent(primitive.occlusionTexture.Get(), events);
+          addTextureCreationEvent(primitive.waterMaskTexture.Get(), events);
+        }
+      }
+    }
+    return events;
+  }
+
+  virtual void releaseGltfData(
+      Model& model,
+      bool keepMetadataAndPickingData,
+      bool keepPositionsAndIndices) override;
 };
 } // namespace
 
@@ -111,12 +159,122 @@ template <class T> struct IsAccessorView<T> : std::false_type {};
 
 template <class T> struct IsAccessorView<AccessorView<T>> : std::true_type {};
 
+namespace {
+/**
+ * The vertex attributes of a primitive that is being loaded. Positions are
+ * written straight into the primitive's final position vertex buffer. The
+ * other attributes are each stored in their own array until the static mesh
+ * vertex buffer can be created, with only the texture coordinate sets that
+ * are actually used. This needs a fraction of the memory of an array of
+ * FStaticMeshBuildVertex, which always has room for every attribute and
+ * MAX_STATIC_TEXCOORDS texture coordinate sets.
+ */
+struct PrimitiveVertices {
+  PrimitiveVertices(FPositionVertexBuffer& positionVertexBuffer, int32 count)
+      : positions(positionVertexBuffer),
+        normals(),
+        tangentsX(),
+        tangentsY(),
+        uvs() {
+    this->positions.Init(static_cast<uint32>(count), false);
+    this->normals.SetNumZeroed(count);
+  }
+
+  /**
+   * Wraps a position vertex buffer that already holds the final positions,
+   * such as one read from CesiumPreparedMeshCache. The other attributes are
+   * already in the static mesh vertex buffer, so none are gathered.
+   */
+  explicit PrimitiveVertices(FPositionVertexBuffer& positionVertexBuffer)
+      : positions(positionVertexBuffer),
+        normals(),
+        tangentsX(),
+        tangentsY(),
+        uvs() {}
+
+  int32 Num() const {
+    return static_cast<int32>(this->positions.GetNumVertices());
+  }
+
+  TMeshVector3& position(int32 i) {
+    return this->positions.VertexPosition(static_cast<uint32>(i));
+  }
+
+  const TMeshVector3& position(int32 i) const {
+    return this->positions.VertexPosition(static_cast<uint32>(i));
+  }
+
+  /**
+   * Allocates storage for tangents, which are only needed when the primitive
+   * has a normal map or tangents are explicitly requested.
+   */
+  void allocateTangents() {
+    this->tangentsX.SetNumZeroed(this->Num());
+    this->tangentsY.SetNumZeroed(this->Num());
+  }
+
+  bool hasTangents() const { return this->tangentsX.Num() == this->Num(); }
+
+  /**
+   * Gets the texture coordinates for the given Unreal texture coordinate
+   * index, allocating zero-initialized storage for them (and any lower
+   * indices) if necessary.
+   */
+  TArray<TMeshVector2>& uv(uint32 textureCoordinateIndex) {
+    while (this->uvs.Num() <= static_cast<int32>(textureCoordinateIndex)) {
+      this->uvs.AddDefaulted_GetRef().SetNumZeroed(this->Num());
+    }
+    return this->uvs[textureCoordinateIndex];
+  }
+
+  /**
+   * Copies the normals, tangents, and texture coordinates into the given
+   * vertex buffer.
+   */
+  void initVertexBuffer(
+      FStaticMeshVertexBuffer& vertexBuffer,
+      uint32 numTexCoords) const {
+    const uint32 count = static_cast<uint32>(this->Num());
+    vertexBuffer.Init(count, numTexCoords, false);
+
+    const bool includeTangents = this->hasTangents();
+    const TMeshVector3 zero(0.0f);
+    for (uint32 i = 0; i < count; ++i) {
+      vertexBuffer.SetVertexTangents(
+          i,
+          includeTangents ? this->tangentsX[i] : zero,
+          includeTangents ? this->tangentsY[i] : zero,
+          this->normals[i]);
+    }
+
+    for (uint32 uvIndex = 0; uvIndex < numTexCoords; ++uvIndex) {
+      if (uvIndex < static_cast<uint32>(this->uvs.Num())) {
+        const TArray<TMeshVector2>& source = this->uvs[uvIndex];
+        for (uint32 i = 0; i < count; ++i) {
+          vertexBuffer.SetVertexUV(i, uvIndex, source[i]);
+        }
+      } else {
+        for (uint32 i = 0; i < count; ++i) {
+          vertexBuffer.SetVertexUV(i, uvIndex, TMeshVector2(0.0f, 0.0f));
+        }
+      }
+    }
+  }
+
+  FPositionVertexBuffer& positions;
+  TArray<TMeshVector3> normals;
+  TArray<TMeshVector3> tangentsX;
+  TArray<TMeshVector3> tangentsY;
+  TArray<TArray<TMeshVector2>> uvs;
+};
+} // namespace
+
 template <class T>
 static uint32_t updateTextureCoordinates(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    PrimitiveVertices* pVertices,
     const TArray<uint32>& indices,
     const std::optional<T>& texture,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -128,17 +286,24 @@ static uint32_t updateTextureCoordinates(
       model,
       primitive,
       duplicateVertices,
-      vertices,
+      pVertices,
       indices,
       "TEXCOORD_" + std::to_string(texture.value().texCoord),
       gltfToUnrealTexCoordMap);
 }
 
+/**
+ * Assigns an Unreal texture coordinate index to the given glTF texture
+ * coordinate attribute, and copies the texture coordinates into pVertices.
+ * If pVertices is nullptr, the index is only assigned, because the texture
+ * coordinates are read from the glTF buffer views by
+ * FCesiumVertexPullingVertexFactory.
+ */
 uint32_t updateTextureCoordinates(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    PrimitiveVertices* pVertices,
     const TArray<uint32>& indices,
     const std::string& attributeName,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -158,29 +323,29 @@ uint32_t updateTextureCoordinates(
   size_t textureCoordinateIndex = gltfToUnrealTexCoordMap.size();
   gltfToUnrealTexCoordMap[uvAccessorID] = textureCoordinateIndex;
 
+  if (!pVertices) {
+    return textureCoordinateIndex;
+  }
+
   AccessorView<TMeshVector2> uvAccessor(model, uvAccessorID);
   if (uvAccessor.status() != AccessorViewStatus::Valid) {
     return 0;
   }
 
+  // The texture coordinates are zero-initialized, so out-of-range vertices
+  // can be skipped.
+  TArray<TMeshVector2>& uvs = pVertices->uv(textureCoordinateIndex);
   if (duplicateVertices) {
     for (int i = 0; i < indices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
       uint32 vertexIndex = indices[i];
       if (vertexIndex >= 0 && vertexIndex < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[vertexIndex];
-      } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+        uvs[i] = uvAccessor[vertexIndex];
       }
     }
   } else {
-    for (int i = 0; i < vertices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
-      if (i >= 0 && i < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[i];
-      } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-      }
+    const int64 count = std::min<int64>(uvs.Num(), uvAccessor.size());
+    for (int i = 0; i < count; ++i) {
+      uvs[i] = uvAccessor[i];
     }
   }
 
@@ -188,15 +353,15 @@ uint32_t updateTextureCoordinates(
 }
 
 static int mikkGetNumFaces(const SMikkTSpaceContext* Context) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
+  PrimitiveVertices& vertices =
+      *reinterpret_cast<PrimitiveVertices*>(Context->m_pUserData);
   return vertices.Num() / 3;
 }
 
 static int
 mikkGetNumVertsOfFace(const SMikkTSpaceContext* Context, const int FaceIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
+  PrimitiveVertices& vertices =
+      *reinterpret_cast<PrimitiveVertices*>(Context->m_pUserData);
   return FaceIdx < (vertices.Num() / 3) ? 3 : 0;
 }
 
@@ -205,9 +370,9 @@ static void mikkGetPosition(
     float Position[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& position = vertices[FaceIdx * 3 + VertIdx].Position;
+  PrimitiveVertices& vertices =
+      *reinterpret_cast<PrimitiveVertices*>(Context->m_pUserData);
+  const TMeshVector3& position = vertices.position(FaceIdx * 3 + VertIdx);
   Position[0] = position.X;
   Position[1] = -position.Y;
   Position[2] = position.Z;
@@ -218,9 +383,9 @@ static void mikkGetNormal(
     float Normal[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& normal = vertices[FaceIdx * 3 + VertIdx].TangentZ;
+  PrimitiveVertices& vertices =
+      *reinterpret_cast<PrimitiveVertices*>(Context->m_pUserData);
+  const TMeshVector3& normal = vertices.normals[FaceIdx * 3 + VertIdx];
   Normal[0] = normal.X;
   Normal[1] = -normal.Y;
   Normal[2] = normal.Z;
@@ -231,9 +396,9 @@ static void mikkGetTexCoord(
     float UV[2],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector2& uv = vertices[FaceIdx * 3 + VertIdx].UVs[0];
+  PrimitiveVertices& vertices =
+      *reinterpret_cast<PrimitiveVertices*>(Context->m_pUserData);
+  const TMeshVector2& uv = vertices.uv(0)[FaceIdx * 3 + VertIdx];
   UV[0] = uv.X;
   UV[1] = uv.Y;
 }
@@ -244,11 +409,11 @@ static void mikkSetTSpaceBasic(
     const float BitangentSign,
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  FStaticMeshBuildVertex& vertex = vertices[FaceIdx * 3 + VertIdx];
+  PrimitiveVertices& vertices =
+      *reinterpret_cast<PrimitiveVertices*>(Context->m_pUserData);
+  const int32 vertexIndex = FaceIdx * 3 + VertIdx;
 
-  FVector3f TangentZ = vertex.TangentZ;
+  FVector3f TangentZ = vertices.normals[vertexIndex];
   TangentZ.Y = -TangentZ.Y;
 
   FVector3f TangentX = TMeshVector3(Tangent[0], Tangent[1], Tangent[2]);
@@ -258,11 +423,19 @@ static void mikkSetTSpaceBasic(
   TangentX.Y = -TangentX.Y;
   TangentY.Y = -TangentY.Y;
 
-  vertex.TangentX = TangentX;
-  vertex.TangentY = TangentY;
+  vertices.tangentsX[vertexIndex] = TangentX;
+  vertices.tangentsY[vertexIndex] = TangentY;
 }
 
-static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
+static void computeTangentSpace(PrimitiveVertices& vertices) {
+  if (!vertices.hasTangents()) {
+    vertices.allocateTangents();
+  }
+
+  // Make sure the first texture coordinate set exists before mikktspace
+  // starts reading it.
+  vertices.uv(0);
+
   SMikkTSpaceInterface MikkTInterface{};
   MikkTInterface.m_getNormal = mikkGetNormal;
   MikkTInterface.m_getNumFaces = mikkGetNumFaces;
@@ -279,56 +452,215 @@ static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
   genTangSpaceDefault(&MikkTContext);
 }
 
-static void setUniformNormals(
+/**
+ * Computes a tangent space basis for each vertex by averaging the tangent
+ * directions of the triangles that share it, weighted by their area. Unlike
+ * computeTangentSpace, this doesn't need the vertices to be duplicated, and
+ * makes only two linear passes over the triangles and vertices.
+ *
+ * @param indices The triangle indices. If the vertices are duplicated, these
+ * are ignored and each group of three consecutive vertices is a triangle.
+ * @param duplicateVertices Whether the vertices are duplicated.
+ * @param vertices The vertices, with their normals and first texture
+ * coordinate set already populated.
+ */
+static void computeIndexedTangentSpace(
     const TArray<uint32_t>& indices,
-    TArray<FStaticMeshBuildVertex>& vertices,
-    TMeshVector3 normal) {
-  for (int i = 0; i < indices.Num(); i++) {
-    FStaticMeshBuildVertex& v = vertices[i];
-    v.TangentX = v.TangentY = TMeshVector3(0.0f);
-    v.TangentZ = normal;
+    bool duplicateVertices,
+    PrimitiveVertices& vertices) {
+  if (!vertices.hasTangents()) {
+    vertices.allocateTangents();
+  }
+
+  const TArray<TMeshVector2>& uvs = vertices.uv(0);
+  TArray<TMeshVector3>& tangents = vertices.tangentsX;
+  TArray<TMeshVector3>& bitangents = vertices.tangentsY;
+  const int32 vertexCount = vertices.Num();
+
+  for (int32 i = 0; i + 2 < indices.Num(); i += 3) {
+    const uint32 i0 = duplicateVertices ? i : indices[i];
+    const uint32 i1 = duplicateVertices ? i + 1 : indices[i + 1];
+    const uint32 i2 = duplicateVertices ? i + 2 : indices[i + 2];
+    if (i0 >= uint32(vertexCount) || i1 >= uint32(vertexCount) ||
+        i2 >= uint32(vertexCount)) {
+      continue;
+    }
+
+    const TMeshVector3 edge1 = vertices.position(i1) - vertices.position(i0);
+    const TMeshVector3 edge2 = vertices.position(i2) - vertices.position(i0);
+    const TMeshVector2 uvEdge1 = uvs[i1] - uvs[i0];
+    const TMeshVector2 uvEdge2 = uvs[i2] - uvs[i0];
+
+    const float determinant = uvEdge1.X * uvEdge2.Y - uvEdge2.X * uvEdge1.Y;
+    if (determinant == 0.0f) {
+      continue;
+    }
+
+    // Only the sign of the determinant is applied, rather than dividing by
+    // it, so that larger triangles contribute more to the average.
+    const float sign = determinant > 0.0f ? 1.0f : -1.0f;
+    const TMeshVector3 tangent =
+        (edge1 * uvEdge2.Y - edge2 * uvEdge1.Y) * sign;
+    const TMeshVector3 bitangent =
+        (edge2 * uvEdge1.X - edge1 * uvEdge2.X) * sign;
+
+    tangents[i0] += tangent;
+    tangents[i1] += tangent;
+    tangents[i2] += tangent;
+    bitangents[i0] += bitangent;
+    bitangents[i1] += bitangent;
+    bitangents[i2] += bitangent;
+  }
+
+  for (int32 i = 0; i < vertexCount; ++i) {
+    const TMeshVector3& normal = vertices.normals[i];
+
+    // Make the tangent orthogonal to the normal.
+    TMeshVector3 tangentX =
+        tangents[i] - normal * TMeshVector3::DotProduct(normal, tangents[i]);
+    if (!tangentX.Normalize()) {
+      // The vertex has no usable texture coordinates, so any direction
+      // perpendicular to the normal will do.
+      TMeshVector3 unused;
+      normal.FindBestAxisVectors(tangentX, unused);
+    }
+
+    TMeshVector3 tangentY = TMeshVector3::CrossProduct(normal, tangentX);
+    if (TMeshVector3::DotProduct(tangentY, bitangents[i]) < 0.0f) {
+      tangentY = -tangentY;
+    }
+
+    tangents[i] = tangentX;
+    bitangents[i] = tangentY;
+  }
+}
+
+static void
+setUniformNormals(PrimitiveVertices& vertices, TMeshVector3 normal) {
+  for (int i = 0; i < vertices.Num(); i++) {
+    vertices.normals[i] = normal;
   }
 }
 
 static void computeFlatNormals(
     const TArray<uint32_t>& indices,
-    TArray<FStaticMeshBuildVertex>& vertices) {
+    PrimitiveVertices& vertices) {
   // Compute flat normals
   for (int i = 0; i < indices.Num(); i += 3) {
-    FStaticMeshBuildVertex& v0 = vertices[i];
-    FStaticMeshBuildVertex& v1 = vertices[i + 1];
-    FStaticMeshBuildVertex& v2 = vertices[i + 2];
+    const TMeshVector3& p0 = vertices.position(i);
+    const TMeshVector3& p1 = vertices.position(i + 1);
+    const TMeshVector3& p2 = vertices.position(i + 2);
 
     // The Y axis has previously been inverted, so undo that before
     // computing the normal direction. Then invert the Y coordinate of the
     // normal, too.
 
-    TMeshVector3 v01 = v1.Position - v0.Position;
+    TMeshVector3 v01 = p1 - p0;
     v01.Y = -v01.Y;
-    TMeshVector3 v02 = v2.Position - v0.Position;
+    TMeshVector3 v02 = p2 - p0;
     v02.Y = -v02.Y;
     TMeshVector3 normal = TMeshVector3::CrossProduct(v01, v02);
 
     normal.Y = -normal.Y;
 
-    v0.TangentX = v1.TangentX = v2.TangentX = TMeshVector3(0.0f);
-    v0.TangentY = v1.TangentY = v2.TangentY = TMeshVector3(0.0f);
-    v0.TangentZ = v1.TangentZ = v2.TangentZ = normal.GetSafeNormal();
+    vertices.normals[i] = vertices.normals[i + 1] = vertices.normals[i + 2] =
+        normal.GetSafeNormal();
   }
 }
 
-template <typename TIndex>
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices);
+/**
+ * Computes smooth normals by averaging the normals of the triangles that
+ * share each position. Vertices at the same position are welded together for
+ * this even if the glTF gives them separate indices, as photogrammetry often
+ * does, so the shading is smooth across them too.
+ *
+ * Positions are welded by hashing them into a grid of cells that are a small
+ * fraction of the size of the primitive, so this takes linear time.
+ *
+ * @param indices The triangle indices. If the vertices are duplicated, these
+ * are ignored and each group of three consecutive vertices is a triangle.
+ * @param duplicateVertices Whether the vertices are duplicated.
+ * @param cellSize The size of the cells of the welding grid.
+ * @param vertices The vertices, with their positions already populated.
+ */
+static void computeWeldedSmoothNormals(
+    const TArray<uint32_t>& indices,
+    bool duplicateVertices,
+    float cellSize,
+    PrimitiveVertices& vertices) {
+  const int32 vertexCount = vertices.Num();
+  const float inverseCellSize = cellSize > 0.0f ? 1.0f / cellSize : 0.0f;
+
+  // Find the weld group of every vertex.
+  TArray<int32> groups;
+  groups.SetNumUninitialized(vertexCount);
+  TMap<FIntVector, int32> groupsByCell;
+  groupsByCell.Reserve(vertexCount);
+  for (int32 i = 0; i < vertexCount; ++i) {
+    const TMeshVector3& position = vertices.position(i);
+    const FIntVector cell(
+        FMath::RoundToInt(position.X * inverseCellSize),
+        FMath::RoundToInt(position.Y * inverseCellSize),
+        FMath::RoundToInt(position.Z * inverseCellSize));
+    groups[i] = groupsByCell.FindOrAdd(cell, groupsByCell.Num());
+  }
+
+  // Accumulate the area-weighted normal of each triangle into its groups.
+  TArray<TMeshVector3> groupNormals;
+  groupNormals.SetNumZeroed(groupsByCell.Num());
+  for (int32 i = 0; i + 2 < indices.Num(); i += 3) {
+    const uint32 i0 = duplicateVertices ? i : indices[i];
+    const uint32 i1 = duplicateVertices ? i + 1 : indices[i + 1];
+    const uint32 i2 = duplicateVertices ? i + 2 : indices[i + 2];
+
+    // The Y axis of the positions has been inverted, which reverses the
+    // winding of the triangle, so the edges are crossed in the reverse order
+    // to get a normal with its Y axis inverted too.
+    const TMeshVector3 normal = TMeshVector3::CrossProduct(
+        vertices.position(i2) - vertices.position(i0),
+        vertices.position(i1) - vertices.position(i0));
+
+    groupNormals[groups[i0]] += normal;
+    groupNormals[groups[i1]] += normal;
+    groupNormals[groups[i2]] += normal;
+  }
+
+  ParallelFor(groupNormals.Num(), [&groupNormals](int32 i) {
+    groupNormals[i] = groupNormals[i].GetSafeNormal();
+  });
+
+  for (int32 i = 0; i < vertexCount; ++i) {
+    vertices.normals[i] = groupNormals[groups[i]];
+  }
+}
 
 static const Material defaultMaterial;
 static const MaterialPBRMetallicRoughness defaultPbrMetallicRoughness;
 
+/**
+ * The number of components of a glTF vertex color type, or 0 if the type
+ * isn't a valid vertex color.
+ */
+template <typename T> struct ColorComponentCount {
+  static constexpr int32 value = 0;
+};
+
+template <typename T>
+constexpr bool IsColorComponent = std::is_same_v<T, float> ||
+                                  std::is_same_v<T, uint8_t> ||
+                                  std::is_same_v<T, uint16_t>;
+
+template <typename T> struct ColorComponentCount<AccessorTypes::VEC3<T>> {
+  static constexpr int32 value = IsColorComponent<T> ? 3 : 0;
+};
+
+template <typename T> struct ColorComponentCount<AccessorTypes::VEC4<T>> {
+  static constexpr int32 value = IsColorComponent<T> ? 4 : 0;
+};
+
 struct ColorVisitor {
   bool duplicateVertices;
-  TArray<FStaticMeshBuildVertex>& StaticMeshBuildVertices;
+  FColorVertexBuffer& ColorVertexBuffer;
   const TArray<uint32>& indices;
 
   bool operator()(AccessorView<nullptr_t>&& invalidView) { return false; }
@@ -338,80 +670,118 @@ struct ColorVisitor {
       return false;
     }
 
-    bool success = true;
-    if (duplicateVertices) {
-      for (int i = 0; success && i < this->indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
-        uint32 vertexIndex = this->indices[i];
-        if (vertexIndex >= colorView.size()) {
-          success = false;
-        } else {
-          success =
-              ColorVisitor::convertColor(colorView[vertexIndex], vertex.Color);
-        }
-      }
-    } else {
-      for (int i = 0; success && i < this->StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
-        if (i >= colorView.size()) {
-          success = false;
-        } else {
-          success = ColorVisitor::convertColor(colorView[i], vertex.Color);
-        }
-      }
+    const int64 count = int64(this->ColorVertexBuffer.GetNumVertices());
+    if (count == 0) {
+      return true;
+    }
+    if (!this->duplicateVertices && colorView.size() < count) {
+      return false;
     }
 
-    return success;
-  }
+    auto colors = CesiumVertexKernels::getElements(colorView);
+    if (!this->duplicateVertices) {
+      colors.count = count;
+    }
 
-  template <typename TElement>
-  static bool
-  convertColor(const AccessorTypes::VEC3<TElement>& color, FColor& out) {
-    out.A = 255;
-    return convertElement(color.value[0], out.R) &&
-           convertElement(color.value[1], out.G) &&
-           convertElement(color.value[2], out.B);
+    return this->convertColors(
+        colors,
+        this->duplicateVertices ? TConstArrayView<uint32>(this->indices)
+                                : TConstArrayView<uint32>(),
+        &this->ColorVertexBuffer.VertexColor(0));
   }
 
-  template <typename TElement>
-  static bool
-  convertColor(const AccessorTypes::VEC4<TElement>& color, FColor& out) {
-    return convertElement(color.value[0], out.R) &&
-           convertElement(color.value[1], out.G) &&
-           convertElement(color.value[2], out.B) &&
-           convertElement(color.value[3], out.A);
+  template <typename TColor>
+  bool convertColors(
+      const CesiumVertexKernels::StridedElements<TColor>& colors,
+      TConstArrayView<uint32> colorIndices,
+      FColor* pDestination) {
+    constexpr int32 numComponents = ColorComponentCount<TColor>::value;
+    if constexpr (numComponents != 0) {
+      return CesiumVertexKernels::convertColors<TColor, numComponents>(
+          colors,
+          colorIndices,
+          pDestination);
+    } else {
+      return false;
+    }
   }
+};
 
-  static bool convertElement(float value, uint8_t& out) {
-    out = uint8_t(value * 255.0f);
-    return true;
-  }
+/**
+ * Reads a scalar point attribute that points can be filtered by, such as a
+ * classification or an intensity. Integers are read as they're stored, even if
+ * the accessor is normalized. If there are indices, the value of each point is
+ * read from the element at its index, for reordered points.
+ */
+struct PointFilterAttributeVisitor {
+  int64 count;
+  TConstArrayView<uint32> indices;
+  TArray<float>& values;
 
-  static bool convertElement(uint8_t value, uint8_t& out) {
-    out = value;
-    return true;
-  }
+  bool operator()(AccessorView<nullptr_t>&& invalidView) { return false; }
 
-  static bool convertElement(uint16_t value, uint8_t& out) {
-    out = uint8_t(value / 256);
-    return true;
-  }
+  template <typename T> bool operator()(AccessorView<T>&& view) {
+    if constexpr (!std::is_arithmetic_v<T>) {
+      return false;
+    } else {
+      if (view.status() != AccessorViewStatus::Valid) {
+        return false;
+      }
 
-  template <typename T> static bool convertColor(const T& color, FColor& out) {
-    return false;
-  }
+      if (this->indices.IsEmpty()) {
+        if (view.size() < count) {
+          return false;
+        }
 
-  template <typename T>
-  static bool convertElement(const T& color, uint8_t& out) {
-    return false;
+        this->values.SetNumUninitialized(int32(count));
+        for (int64 i = 0; i < count; ++i) {
+          this->values[int32(i)] = float(view[i]);
+        }
+        return true;
+      }
+
+      if (this->indices.Num() != count) {
+        return false;
+      }
+
+      this->values.SetNumUninitialized(int32(count));
+      for (int32 i = 0; i < this->indices.Num(); ++i) {
+        const uint32 index = this->indices[i];
+        if (int64(index) >= view.size()) {
+          return false;
+        }
+        this->values[i] = float(view[index]);
+      }
+      return true;
+    }
   }
 };
 
+static TArray<float> loadPointFilterAttribute(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const std::string& attributeName,
+    int64 count,
+    TConstArrayView<uint32> indices) {
+  TArray<float> values;
+  auto it = primitive.attributes.find(attributeName);
+  if (it != primitive.attributes.end() &&
+      !createAccessorView(
+          model,
+          it->second,
+          PointFilterAttributeVisitor{count, indices, values})) {
+    values.Empty();
+  }
+  return values;
+}
+
 template <class T>
-static TUniquePtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
+static TSharedPtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
     CesiumGltf::Model& model,
     const std::optional<T>& gltfTexture,
-    bool sRGB) {
+    bool sRGB,
+    bool compress,
+    const CreatePrimitiveOptions& options) {
   if (!gltfTexture || gltfTexture.value().index < 0 ||
       gltfTexture.value().index >= model.textures.size()) {
     if (gltfTexture && gltfTexture.value().index >= 0) {
@@ -428,13 +798,39 @@ static TUniquePtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
   const CesiumGltf::Texture& texture =
       model.textures[gltfTexture.value().index];
 
-  return loadTextureAnyThreadPart(model, texture, sRGB);
+  // Primitives that use the same texture in the same way share one loaded
+  // texture. This is guarded by the texture mutex, like the images.
+  const int64 key = int64(gltfTexture.value().index) << 2 |
+                    int64(sRGB) << 1 | int64(compress);
+  if (options.pLoadedTextures) {
+    const TSharedPtr<CesiumTextureUtility::LoadedTextureResult>* ppExisting =
+        options.pLoadedTextures->Find(key);
+    if (ppExisting) {
+      return *ppExisting;
+    }
+  }
+
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> pResult(
+      loadTextureAnyThreadPart(
+          model,
+          texture,
+          sRGB,
+          compress,
+          options.pMeshOptions->pNodeOptions->pModelOptions
+              ->shareTexturesAcrossTiles,
+          options.pMeshOptions->pNodeOptions->pModelOptions
+              ->skipUnneededTextureMips));
+  if (options.pLoadedTextures) {
+    options.pLoadedTextures->Add(key, pResult);
+  }
+  return pResult;
 }
 
 static void applyWaterMask(
     Model& model,
     const MeshPrimitive& primitive,
-    LoadPrimitiveResult& primitiveResult) {
+    LoadPrimitiveResult& primitiveResult,
+    const CreatePrimitiveOptions& options) {
   // Initialize water mask if needed.
   auto onlyWaterIt = primitive.extras.find("OnlyWater");
   auto onlyLandIt = primitive.extras.find("OnlyLand");
@@ -456,8 +852,16 @@ static void applyWaterMask(
         waterMaskInfo.index = waterMaskTextureId;
         if (waterMaskTextureId >= 0 &&
             waterMaskTextureId < model.textures.size()) {
-          primitiveResult.waterMaskTexture =
-              loadTexture(model, std::make_optional(waterMaskInfo), false);
+          // Water masks are single-channel, so they're compressed to BC4,
+          // which keeps texels that are entirely land or water exact. Tiles
+          // that are only land or only water don't need a mask at all.
+          primitiveResult.waterMaskTexture = loadTexture(
+              model,
+              std::make_optional(waterMaskInfo),
+              false,
+              options.pMeshOptions->pNodeOptions->pModelOptions
+                  ->compressTextures,
+              options);
         }
       }
     }
@@ -584,7 +988,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    PrimitiveVertices& vertices,
     const TArray<uint32>& indices,
     const FCesiumPrimitiveFeatures& primitiveFeatures,
     const CesiumEncodedFeaturesMetadata::EncodedPrimitiveFeatures&
@@ -623,7 +1027,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
               model,
               primitive,
               duplicateVertices,
-              vertices,
+              &vertices,
               indices,
               "TEXCOORD_" +
                   std::to_string(encodedProperty.textureCoordinateSetIndex),
@@ -673,30 +1077,25 @@ static void updateTextureCoordinatesForFeaturesMetadata(
 
       // We encode unsigned integer feature ids as floats in the u-channel of
       // a texture coordinate slot.
+      TArray<TMeshVector2>& uvs = vertices.uv(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
           if (vertexIndex >= 0 && vertexIndex < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIDAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            uvs[i] = TMeshVector2(featureId, 0.0f);
           }
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          if (i < vertexCount) {
-            float featureId = static_cast<float>(
-                UCesiumFeatureIdAttributeBlueprintLibrary::
-                    GetFeatureIDForVertex(featureIDAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-          }
+        const int64 count = std::min<int64>(uvs.Num(), vertexCount);
+        for (int64_t i = 0; i < count; ++i) {
+          float featureId = static_cast<float>(
+              UCesiumFeatureIdAttributeBlueprintLibrary::GetFeatureIDForVertex(
+                  featureIDAttribute,
+                  i));
+          uvs[i] = TMeshVector2(featureId, 0.0f);
         }
       }
     } else if (encodedFeatureIDSet.texture) {
@@ -708,7 +1107,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
               model,
               primitive,
               duplicateVertices,
-              vertices,
+              &vertices,
               indices,
               "TEXCOORD_" +
                   std::to_string(
@@ -724,18 +1123,15 @@ static void updateTextureCoordinatesForFeaturesMetadata(
       featuresMetadataTexcoordParameters.Emplace(
           SafeName,
           textureCoordinateIndex);
+      TArray<TMeshVector2>& uvs = vertices.uv(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(vertexIndex), 0.0f);
+          uvs[i] = TMeshVector2(static_cast<float>(vertexIndex), 0.0f);
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(i), 0.0f);
+        for (int64_t i = 0; i < uvs.Num(); ++i) {
+          uvs[i] = TMeshVector2(static_cast<float>(i), 0.0f);
         }
       }
     }
@@ -747,7 +1143,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    PrimitiveVertices& vertices,
     const TArray<uint32>& indices,
     const CesiumEncodedMetadataUtility::EncodedMetadata& encodedMetadata,
     const CesiumEncodedMetadataUtility::EncodedMetadataPrimitive&
@@ -767,7 +1163,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
             model,
             primitive,
             duplicateVertices,
-            vertices,
+            &vertices,
             indices,
             "TEXCOORD_" +
                 std::to_string(
@@ -789,7 +1185,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
                 model,
                 primitive,
                 duplicateVertices,
-                vertices,
+                &vertices,
                 indices,
                 "TEXCOORD_" + std::to_string(
                                   encodedProperty.textureCoordinateAttributeId),
@@ -830,30 +1226,25 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
 
       // We encode unsigned integer feature ids as floats in the u-channel of
       // a texture coordinate slot.
+      TArray<TMeshVector2>& uvs = vertices.uv(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
           if (vertexIndex >= 0 && vertexIndex < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIdAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            uvs[i] = TMeshVector2(featureId, 0.0f);
           }
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          if (i < vertexCount) {
-            float featureId = static_cast<float>(
-                UCesiumFeatureIdAttributeBlueprintLibrary::
-                    GetFeatureIDForVertex(featureIdAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-          }
+        const int64 count = std::min<int64>(uvs.Num(), vertexCount);
+        for (int64_t i = 0; i < count; ++i) {
+          float featureId = static_cast<float>(
+              UCesiumFeatureIdAttributeBlueprintLibrary::GetFeatureIDForVertex(
+                  featureIdAttribute,
+                  i));
+          uvs[i] = TMeshVector2(featureId, 0.0f);
         }
       }
     }
@@ -919,102 +1310,384 @@ FName createSafeName(
   return FName(combined.c_str());
 }
 
-} // namespace
-
-template <class TIndexAccessor>
-static void loadPrimitive(
-    LoadPrimitiveResult& primitiveResult,
-    const glm::dmat4x4& transform,
+/**
+ * Determines whether a primitive can be drawn by
+ * FCesiumVertexPullingVertexFactory, which reads its attributes straight from
+ * its glTF buffer views. Primitives that need vertex data that the vertex
+ * factory doesn't read, or that need the vertices of the static mesh, are
+ * loaded as usual.
+ */
+bool canPullVertices(
     const CreatePrimitiveOptions& options,
+    const Model& model,
+    const MeshPrimitive& primitive,
     const Accessor& positionAccessor,
-    const AccessorView<TMeshVector3>& positionView,
-    const TIndexAccessor& indicesView) {
-
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadPrimitive<T>)
-
-  Model& model = *options.pMeshOptions->pNodeOptions->pModelOptions->pModel;
-  const Mesh& mesh = *options.pMeshOptions->pMesh;
-  const MeshPrimitive& primitive = *options.pPrimitive;
+    bool isUnlit,
+    bool needsTangents) {
+  const CreateModelOptions& modelOptions =
+      *options.pMeshOptions->pNodeOptions->pModelOptions;
+  if (!modelOptions.useVertexPulling || modelOptions.buildNaniteMeshes ||
+      modelOptions.collisionOnly || modelOptions.pFeaturesMetadataDescription ||
+      modelOptions.pEncodedMetadataDescription_DEPRECATED || needsTangents ||
+      !RHISupportsManualVertexFetch(GMaxRHIShaderPlatform)) {
+    return false;
+  }
 
   if (primitive.mode != MeshPrimitive::Mode::TRIANGLES &&
-      primitive.mode != MeshPrimitive::Mode::TRIANGLE_STRIP &&
-      primitive.mode != MeshPrimitive::Mode::POINTS) {
-    // TODO: add support for other primitive types.
-    UE_LOG(
-        LogCesium,
-        Warning,
-        TEXT("Primitive mode %d is not supported"),
-        primitive.mode);
-    return;
+      primitive.mode != MeshPrimitive::Mode::TRIANGLE_STRIP) {
+    return false;
   }
 
-  std::string name = "glTF";
-
-  auto urlIt = model.extras.find("Cesium3DTiles_TileUrl");
-  if (urlIt != model.extras.end()) {
-    name = urlIt->second.getStringOrDefault("glTF");
-    name = constrainLength(name, 256);
+  // Instances are drawn with the static mesh.
+  const Node* pNode = options.pMeshOptions->pNodeOptions->pNode;
+  if (pNode && pNode->hasExtension<ExtensionExtMeshGpuInstancing>()) {
+    return false;
   }
 
-  auto meshIt = std::find_if(
-      model.meshes.begin(),
-      model.meshes.end(),
-      [&mesh](const Mesh& candidate) { return &candidate == &mesh; });
-  if (meshIt != model.meshes.end()) {
-    int64_t meshIndex = meshIt - model.meshes.begin();
-    name += " mesh " + std::to_string(meshIndex);
+  // The bounds come from the accessor, without reading the positions.
+  if (positionAccessor.min.size() != 3 || positionAccessor.max.size() != 3) {
+    return false;
   }
 
-  auto primitiveIt = std::find_if(
-      mesh.primitives.begin(),
-      mesh.primitives.end(),
-      [&primitive](const MeshPrimitive& candidate) {
-        return &candidate == &primitive;
-      });
-  if (primitiveIt != mesh.primitives.end()) {
-    int64_t primitiveIndex = primitiveIt - mesh.primitives.begin();
-    name += " primitive " + std::to_string(primitiveIndex);
+  // Generating flat or welded smooth normals would require reading the
+  // positions.
+  const bool hasNormals =
+      primitive.attributes.find("NORMAL") != primitive.attributes.end();
+  if (!hasNormals && !isUnlit &&
+      (!modelOptions.computeFlatNormalsInMaterial ||
+       modelOptions.weldSmoothNormals)) {
+    return false;
   }
 
-  primitiveResult.name = name;
-
-  if (positionView.status() != AccessorViewStatus::Valid) {
-    UE_LOG(
-        LogCesium,
-        Warning,
-        TEXT("%s: Invalid position buffer"),
-        UTF8_TO_TCHAR(name.c_str()));
-    return;
-  }
+  const int64_t vertexCount = positionAccessor.count;
+  int32 texCoordCount = 0;
+  for (const auto& [name, accessorID] : primitive.attributes) {
+    int64_t numComponents = 0;
+    if (name == "POSITION" || name == "NORMAL") {
+      numComponents = 3;
+    } else if (
+        name.rfind("TEXCOORD_", 0) == 0 ||
+        name.rfind("_CESIUMOVERLAY_", 0) == 0) {
+      numComponents = 2;
+      ++texCoordCount;
+    } else if (name == "COLOR_0") {
+      return false;
+    } else {
+      continue;
+    }
 
-  if constexpr (IsAccessorView<TIndexAccessor>::value) {
-    if (indicesView.status() != AccessorViewStatus::Valid) {
-      UE_LOG(
-          LogCesium,
-          Warning,
-          TEXT("%s: Invalid indices buffer"),
-          UTF8_TO_TCHAR(name.c_str()));
-      return;
+    if (!FCesiumGltfAttributeBuffer::IsSupportedAccessor(
+            model,
+            accessorID,
+            numComponents,
+            vertexCount)) {
+      return false;
     }
   }
 
-  auto normalAccessorIt = primitive.attributes.find("NORMAL");
-  AccessorView<TMeshVector3> normalAccessor;
-  bool hasNormals = false;
-  if (normalAccessorIt != primitive.attributes.end()) {
-    int normalAccessorID = normalAccessorIt->second;
-    normalAccessor = AccessorView<TMeshVector3>(model, normalAccessorID);
-    hasNormals = normalAccessor.status() == AccessorViewStatus::Valid;
-    if (!hasNormals) {
+  return texCoordCount <= FCesiumGltfAttributeBuffer::MaxTexCoords;
+}
+
+/**
+ * Computes the normal to use for every vertex of a primitive that doesn't
+ * have normals, which is the ellipsoid surface normal at its center, in the
+ * primitive's glTF coordinates.
+ */
+TMeshVector3
+computeUniformNormal(const glm::dmat4x4& transform, const FVector& center) {
+  glm::dvec3 ecefCenter =
+      glm::dvec3(transform * glm::dvec4(VecMath::createVector3D(center), 1.0));
+  return TMeshVector3(VecMath::createVector(
+      glm::affineInverse(transform) *
+      glm::dvec4(
+          CesiumGeospatial::Ellipsoid::WGS84.geodeticSurfaceNormal(
+              glm::dvec3(ecefCenter)),
+          0.0)));
+}
+
+} // namespace
+
+/**
+ * Determines the base material of a primitive and its material parameter
+ * values that don't depend on textures, so that the game thread doesn't need
+ * to derive them from the glTF material again.
+ */
+static void computeMaterialKey(
+    LoadPrimitiveResult& primitiveResult,
+    const Material& material,
+    const MaterialPBRMetallicRoughness& pbr) {
+  CesiumMaterialKey& key = primitiveResult.materialKey;
+
+  const bool isTranslucent = material.alphaMode == Material::AlphaMode::BLEND &&
+                             pbr.baseColorFactor.size() > 3 &&
+                             pbr.baseColorFactor[3] < 0.996; // 1. - 1. / 256.
+#if PLATFORM_MAC
+  // TODO: figure out why water material crashes mac
+  key.baseMaterial = isTranslucent
+                         ? CesiumMaterialKey::BaseMaterial::Translucent
+                         : CesiumMaterialKey::BaseMaterial::Opaque;
+#else
+  if (primitiveResult.onlyWater || !primitiveResult.onlyLand) {
+    key.baseMaterial = CesiumMaterialKey::BaseMaterial::Water;
+  } else {
+    key.baseMaterial = isTranslucent
+                           ? CesiumMaterialKey::BaseMaterial::Translucent
+                           : CesiumMaterialKey::BaseMaterial::Opaque;
+  }
+#endif
+
+  if (pbr.baseColorFactor.size() > 3) {
+    key.baseColorFactor = FLinearColor(
+        pbr.baseColorFactor[0],
+        pbr.baseColorFactor[1],
+        pbr.baseColorFactor[2],
+        pbr.baseColorFactor[3]);
+  } else if (pbr.baseColorFactor.size() == 3) {
+    key.baseColorFactor = FLinearColor(
+        pbr.baseColorFactor[0],
+        pbr.baseColorFactor[1],
+        pbr.baseColorFactor[2],
+        1.);
+  } else {
+    key.baseColorFactor = FLinearColor(1., 1., 1., 1.);
+  }
+
+  key.metallicFactor = static_cast<float>(
+      primitiveResult.isUnlit ? 0.0f : pbr.metallicFactor);
+  key.roughnessFactor = static_cast<float>(
+      primitiveResult.isUnlit ? 1.0f : pbr.roughnessFactor);
+
+  key.hasEmissiveFactor = material.emissiveFactor.size() >= 3;
+  if (key.hasEmissiveFactor) {
+    key.emissiveFactor = FVector(
+        material.emissiveFactor[0],
+        material.emissiveFactor[1],
+        material.emissiveFactor[2]);
+  }
+
+  key.textureCoordinateIndices.Reset(
+      primitiveResult.textureCoordinateParameters.Num());
+  for (const auto& textureCoordinateSet :
+       primitiveResult.textureCoordinateParameters) {
+    key.textureCoordinateIndices.Emplace(
+        textureCoordinateSet.Key,
+        textureCoordinateSet.Value);
+  }
+}
+
+// This matrix converts from right-handed Z-up to Unreal
+// left-handed Z-up by flipping the Y axis. It effectively undoes the Y-axis
+// flipping that we did when creating the mesh in the first place. This is
+// necessary to work around a problem in UE 5.1 where negatively-scaled meshes
+// don't work correctly for collision.
+// See https://github.com/CesiumGS/cesium-unreal/pull/1126
+static constexpr glm::dmat4 yInvertMatrix = {
+    1.0,
+    0.0,
+    0.0,
+    0.0,
+    0.0,
+    -1.0,
+    0.0,
+    0.0,
+    0.0,
+    0.0,
+    1.0,
+    0.0,
+    0.0,
+    0.0,
+    0.0,
+    1.0};
+
+/**
+ * Loads a primitive for CreateModelOptions::collisionOnly. Only the positions
+ * and indices are read, to build the physics mesh, navigation geometry and
+ * height query hierarchy, and the render data only holds the bounds.
+ */
+static void loadCollisionOnlyPrimitive(
+    LoadPrimitiveResult& primitiveResult,
+    const CreateModelOptions& modelOptions,
+    const AccessorView<TMeshVector3>& positionView,
+    TArray<uint32>&& indices,
+    TUniquePtr<FStaticMeshRenderData>&& RenderData) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadCollisionOnlyPrimitive)
+
+  TArray<FVector3f> positions;
+  positions.SetNumUninitialized(static_cast<int32>(positionView.size()));
+  if (positions.Num() > 0) {
+    RenderData->Bounds.SphereRadius = CesiumVertexKernels::copyPositionsFlipY(
+        CesiumVertexKernels::getElements(positionView),
+        TConstArrayView<uint32>(),
+        positions.GetData(),
+        FVector3f(RenderData->Bounds.Origin));
+  }
+
+  if ((modelOptions.createNavCollision || modelOptions.enableHeightQueries) &&
+      indices.Num() >= 3) {
+    TSharedPtr<CesiumNavigationGeometry, ESPMode::ThreadSafe> pGeometry =
+        MakeShared<CesiumNavigationGeometry, ESPMode::ThreadSafe>();
+    pGeometry->vertices.SetNumUninitialized(positions.Num());
+    for (int32 i = 0; i < positions.Num(); ++i) {
+      pGeometry->vertices[i] = FVector(positions[i]);
+    }
+    pGeometry->indices.SetNumUninitialized(indices.Num() - indices.Num() % 3);
+    for (int32 i = 0; i < pGeometry->indices.Num(); ++i) {
+      pGeometry->indices[i] = static_cast<int32>(indices[i]);
+    }
+
+    if (modelOptions.enableHeightQueries) {
+      TArray<FVector> vertices = modelOptions.createNavCollision
+                                     ? pGeometry->vertices
+                                     : MoveTemp(pGeometry->vertices);
+      primitiveResult.HeightQueryBvh =
+          MakeShared<const CesiumTriangleBvh, ESPMode::ThreadSafe>(
+              MoveTemp(vertices),
+              pGeometry->indices);
+    }
+    if (modelOptions.createNavCollision) {
+      primitiveResult.NavigationGeometry = MoveTemp(pGeometry);
+    }
+  }
+
+  if (modelOptions.createPhysicsMeshes && positions.Num() != 0 &&
+      indices.Num() != 0) {
+    CesiumPhysicsMeshUtility::CollisionGeometry geometry;
+    geometry.vertices.AddParticles(positions.Num());
+    for (int32 i = 0; i < positions.Num(); ++i) {
+      geometry.vertices.X(i) = positions[i];
+    }
+    geometry.indices = MoveTemp(indices);
+    primitiveResult.pCollisionMesh =
+        CesiumPhysicsMeshUtility::buildChaosTriangleMesh(MoveTemp(geometry));
+  }
+
+  primitiveResult.RenderData = MoveTemp(RenderData);
+  primitiveResult.collisionOnly = true;
+}
+
+template <typename TTextureInfo>
+static int64 getTexCoord(const std::optional<TTextureInfo>& maybeTexture) {
+  return maybeTexture ? maybeTexture->texCoord : -1;
+}
+
+/**
+ * Hashes everything besides the glTF data of a primitive that its vertex and
+ * index buffers depend on: the conversion flags, which texture coordinate sets
+ * the material uses, the number of overlays, and the transform that normals
+ * are computed in.
+ */
+static uint64 computePreparedMeshOptionsHash(
+    const Material& material,
+    const MaterialPBRMetallicRoughness& pbrMetallicRoughness,
+    const glm::dmat4x4& transform,
+    size_t overlayCount,
+    std::initializer_list<bool> flags) {
+  TArray<int64, TInlineAllocator<32>> description;
+  for (bool flag : flags) {
+    description.Add(flag ? 1 : 0);
+  }
+  description.Add(getTexCoord(pbrMetallicRoughness.baseColorTexture));
+  description.Add(getTexCoord(pbrMetallicRoughness.metallicRoughnessTexture));
+  description.Add(getTexCoord(material.normalTexture));
+  description.Add(getTexCoord(material.occlusionTexture));
+  description.Add(getTexCoord(material.emissiveTexture));
+  description.Add(int64(overlayCount));
+
+  const uint64 transformHash = CityHash64(
+      reinterpret_cast<const char*>(&transform[0][0]),
+      uint32(sizeof(glm::dmat4x4)));
+  return CityHash64WithSeed(
+      reinterpret_cast<const char*>(description.GetData()),
+      uint32(description.Num() * sizeof(int64)),
+      transformHash);
+}
+
+template <class TIndexAccessor>
+static void loadPrimitive(
+    LoadPrimitiveResult& primitiveResult,
+    const glm::dmat4x4& transform,
+    const CreatePrimitiveOptions& options,
+    const Accessor& positionAccessor,
+    const AccessorView<TMeshVector3>& positionView,
+    const TIndexAccessor& indicesView) {
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadPrimitive<T>)
+
+  Model& model = *options.pMeshOptions->pNodeOptions->pModelOptions->pModel;
+  const Mesh& mesh = *options.pMeshOptions->pMesh;
+  const MeshPrimitive& primitive = *options.pPrimitive;
+
+  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES &&
+      primitive.mode != MeshPrimitive::Mode::TRIANGLE_STRIP &&
+      primitive.mode != MeshPrimitive::Mode::POINTS) {
+    // TODO: add support for other primitive types.
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Primitive mode %d is not supported"),
+        primitive.mode);
+    return;
+  }
+
+  const CreateModelOptions& modelOptions =
+      *options.pMeshOptions->pNodeOptions->pModelOptions;
+
+  // Points have no collision.
+  if (modelOptions.collisionOnly &&
+      primitive.mode == MeshPrimitive::Mode::POINTS) {
+    return;
+  }
+
+  std::string name = "glTF";
+
+  auto urlIt = model.extras.find("Cesium3DTiles_TileUrl");
+  if (urlIt != model.extras.end()) {
+    name = urlIt->second.getStringOrDefault("glTF");
+    name = constrainLength(name, 256);
+  }
+
+  auto meshIt = std::find_if(
+      model.meshes.begin(),
+      model.meshes.end(),
+      [&mesh](const Mesh& candidate) { return &candidate == &mesh; });
+  if (meshIt != model.meshes.end()) {
+    int64_t meshIndex = meshIt - model.meshes.begin();
+    name += " mesh " + std::to_string(meshIndex);
+  }
+
+  auto primitiveIt = std::find_if(
+      mesh.primitives.begin(),
+      mesh.primitives.end(),
+      [&primitive](const MeshPrimitive& candidate) {
+        return &candidate == &primitive;
+      });
+  if (primitiveIt != mesh.primitives.end()) {
+    int64_t primitiveIndex = primitiveIt - mesh.primitives.begin();
+    name += " primitive " + std::to_string(primitiveIndex);
+  }
+
+  primitiveResult.name = name;
+
+  if constexpr (IsAccessorView<TIndexAccessor>::value) {
+    if (indicesView.status() != AccessorViewStatus::Valid) {
       UE_LOG(
           LogCesium,
           Warning,
-          TEXT(
-              "%s: Invalid normal buffer. Flat normals will be auto-generated instead."),
+          TEXT("%s: Invalid indices buffer"),
           UTF8_TO_TCHAR(name.c_str()));
+      return;
     }
   }
 
+  auto normalAccessorIt = primitive.attributes.find("NORMAL");
+  AccessorView<TMeshVector3> normalAccessor;
+  bool hasNormals = false;
+  if (normalAccessorIt != primitive.attributes.end()) {
+    int normalAccessorID = normalAccessorIt->second;
+    normalAccessor = AccessorView<TMeshVector3>(model, normalAccessorID);
+    hasNormals = normalAccessor.status() == AccessorViewStatus::Valid;
+  }
+
   int materialID = primitive.material;
   const Material& material =
       materialID >= 0 && materialID < model.materials.size()
@@ -1058,7 +1731,15 @@ static void loadPrimitive(
     }
   }
 
-  applyWaterMask(model, primitive, primitiveResult);
+  {
+    std::unique_lock<std::mutex> textureLock;
+    if (options.pTextureMutex) {
+      textureLock = std::unique_lock<std::mutex>(*options.pTextureMutex);
+    }
+    if (!modelOptions.collisionOnly) {
+      applyWaterMask(model, primitive, primitiveResult, options);
+    }
+  }
 
   // The water effect works by animating the normal, and the normal is
   // expressed in tangent space. So if we have water, we need tangents.
@@ -1066,6 +1747,40 @@ static void loadPrimitive(
     needsTangents = true;
   }
 
+  // Pulled vertices are decoded by the vertex shader, so the position and
+  // normal views don't need to be readable as floats.
+  const bool pullVertices = canPullVertices(
+      options,
+      model,
+      primitive,
+      positionAccessor,
+      primitiveResult.isUnlit,
+      needsTangents);
+
+  if (!pullVertices && positionView.status() != AccessorViewStatus::Valid) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("%s: Invalid position buffer"),
+        UTF8_TO_TCHAR(name.c_str()));
+    return;
+  }
+
+  if (pullVertices) {
+    hasNormals = normalAccessorIt != primitive.attributes.end();
+  } else if (normalAccessorIt != primitive.attributes.end() && !hasNormals) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "%s: Invalid normal buffer. Flat normals will be auto-generated instead."),
+        UTF8_TO_TCHAR(name.c_str()));
+  }
+
+  const int32 vertexCount = pullVertices
+                                ? static_cast<int32>(positionAccessor.count)
+                                : static_cast<int32>(positionView.size());
+
   TUniquePtr<FStaticMeshRenderData> RenderData =
       MakeUnique<FStaticMeshRenderData>();
   RenderData->AllocateLODResources(1);
@@ -1080,18 +1795,39 @@ static void loadPrimitive(
     glm::dvec3 minPosition{std::numeric_limits<double>::max()};
     glm::dvec3 maxPosition{std::numeric_limits<double>::lowest()};
     if (min.size() != 3 || max.size() != 3) {
-      for (int32_t i = 0; i < positionView.size(); ++i) {
-        minPosition.x = glm::min<double>(minPosition.x, positionView[i].X);
-        minPosition.y = glm::min<double>(minPosition.y, positionView[i].Y);
-        minPosition.z = glm::min<double>(minPosition.z, positionView[i].Z);
-
-        maxPosition.x = glm::max<double>(maxPosition.x, positionView[i].X);
-        maxPosition.y = glm::max<double>(maxPosition.y, positionView[i].Y);
-        maxPosition.z = glm::max<double>(maxPosition.z, positionView[i].Z);
+      FVector3f minimum;
+      FVector3f maximum;
+      if (CesiumVertexKernels::computeBounds(
+              CesiumVertexKernels::getElements(positionView),
+              minimum,
+              maximum)) {
+        minPosition = glm::dvec3(minimum.X, minimum.Y, minimum.Z);
+        maxPosition = glm::dvec3(maximum.X, maximum.Y, maximum.Z);
       }
     } else {
       minPosition = glm::dvec3(min[0], min[1], min[2]);
       maxPosition = glm::dvec3(max[0], max[1], max[2]);
+      if (positionAccessor.normalized) {
+        // The bounds of normalized positions are given in the stored integer
+        // values, not the values the positions are normalized to.
+        double scale = 1.0;
+        switch (positionAccessor.componentType) {
+        case Accessor::ComponentType::BYTE:
+          scale = 1.0 / 127.0;
+          break;
+        case Accessor::ComponentType::UNSIGNED_BYTE:
+          scale = 1.0 / 255.0;
+          break;
+        case Accessor::ComponentType::SHORT:
+          scale = 1.0 / 32767.0;
+          break;
+        case Accessor::ComponentType::UNSIGNED_SHORT:
+          scale = 1.0 / 65535.0;
+          break;
+        }
+        minPosition = glm::max(minPosition * scale, glm::dvec3(-1.0));
+        maxPosition = glm::max(maxPosition * scale, glm::dvec3(-1.0));
+      }
     }
 
     primitiveResult.dimensions =
@@ -1104,184 +1840,294 @@ static void loadPrimitive(
     aaBox.GetCenterAndExtents(
         RenderData->Bounds.Origin,
         RenderData->Bounds.BoxExtent);
-    RenderData->Bounds.SphereRadius = 0.0f;
+    // Pulled positions are never read on the CPU, so the sphere encloses the
+    // box instead of the positions.
+    RenderData->Bounds.SphereRadius =
+        pullVertices ? RenderData->Bounds.BoxExtent.Size() : 0.0f;
   }
 
   TArray<uint32> indices;
+  uint32 maximumIndex = 0;
   if (primitive.mode == MeshPrimitive::Mode::TRIANGLES ||
       primitive.mode == MeshPrimitive::Mode::POINTS) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(static_cast<TArray<uint32>::SizeType>(indicesView.size()));
-
-    for (int32 i = 0; i < indicesView.size(); ++i) {
-      indices[i] = indicesView[i];
-    }
+    indices.SetNumUninitialized(
+        static_cast<TArray<uint32>::SizeType>(indicesView.size()));
+    maximumIndex = CesiumVertexKernels::copyIndices(
+        CesiumVertexKernels::getElements(indicesView),
+        indices.GetData());
   } else {
     // assume TRIANGLE_STRIP because all others are rejected earlier.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(
-        static_cast<TArray<uint32>::SizeType>(3 * (indicesView.size() - 2)));
-    for (int32 i = 0; i < indicesView.size() - 2; ++i) {
-      if (i % 2) {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 2];
-        indices[3 * i + 2] = indicesView[i + 1];
-      } else {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 1];
-        indices[3 * i + 2] = indicesView[i + 2];
-      }
-    }
+    indices.SetNumUninitialized(static_cast<TArray<uint32>::SizeType>(
+        3 * FMath::Max<int64>(indicesView.size() - 2, 0)));
+    maximumIndex = CesiumVertexKernels::triangulateStrip(
+        CesiumVertexKernels::getElements(indicesView),
+        indices.GetData());
+  }
+
+  // The copy kernels read vertices without checking each index, so make sure
+  // they're all in range up front.
+  if (!indices.IsEmpty() && int64(maximumIndex) >= int64(vertexCount)) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("%s: Indices refer to vertices that don't exist"),
+        UTF8_TO_TCHAR(name.c_str()));
+    return;
+  }
+
+  if (modelOptions.collisionOnly) {
+    primitiveResult.pModel = &model;
+    primitiveResult.pMeshPrimitive = &primitive;
+    primitiveResult.pMaterial = &material;
+    primitiveResult.transform = transform * yInvertMatrix;
+    loadCollisionOnlyPrimitive(
+        primitiveResult,
+        modelOptions,
+        positionView,
+        MoveTemp(indices),
+        MoveTemp(RenderData));
+    return;
   }
 
   // If we don't have normals, the gltf spec prescribes that the client
   // implementation must generate flat normals, which requires duplicating
-  // vertices shared by multiple triangles. If we don't have tangents, but
-  // need them, we need to use a tangent space generation algorithm which
-  // requires duplicated vertices.
-  bool duplicateVertices = !hasNormals || (needsTangents && !hasTangents);
+  // vertices shared by multiple triangles. That isn't necessary when the
+  // material is unlit, or when it's going to derive flat normals itself. If
+  // we don't have tangents, but need them, we need to use a tangent space
+  // generation algorithm which requires duplicated vertices.
+  // Smooth normals are instead computed for welded positions if requested,
+  // which doesn't require duplicated vertices either.
+  const bool needsWeldedSmoothNormals =
+      !hasNormals && !primitiveResult.isUnlit &&
+      primitive.mode != MeshPrimitive::Mode::POINTS &&
+      options.pMeshOptions->pNodeOptions->pModelOptions->weldSmoothNormals;
+  const bool needsFlatNormals =
+      !hasNormals && !primitiveResult.isUnlit && !needsWeldedSmoothNormals &&
+      !options.pMeshOptions->pNodeOptions->pModelOptions
+           ->computeFlatNormalsInMaterial;
+  const bool useFastTangentGeneration =
+      options.pMeshOptions->pNodeOptions->pModelOptions
+          ->useFastTangentGeneration;
+  bool duplicateVertices =
+      needsFlatNormals ||
+      (needsTangents && !hasTangents && !useFastTangentGeneration);
   duplicateVertices =
       duplicateVertices && primitive.mode != MeshPrimitive::Mode::POINTS;
 
-  TArray<FStaticMeshBuildVertex> StaticMeshBuildVertices;
-  StaticMeshBuildVertices.SetNum(
-      duplicateVertices ? indices.Num()
-                        : static_cast<int>(positionView.size()));
+  // Points are put in a progressive order by copying them through the same
+  // indices that duplicated vertices are copied with.
+  if (primitive.mode == MeshPrimitive::Mode::POINTS && !pullVertices &&
+      modelOptions.orderPointsProgressively && indices.Num() > 1) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::OrderPointsProgressively)
+    CesiumVertexKernels::orderPointsProgressively(
+        CesiumVertexKernels::getElements(positionView),
+        indices);
+    duplicateVertices = true;
+  }
 
-  {
-    if (duplicateVertices) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyDuplicatedPositions)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        const TMeshVector3& pos = positionView[vertexIndex];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
-    } else {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPositions)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        const TMeshVector3& pos = positionView[i];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
-    }
+  // Points are kept in a compact form when they will be drawn by
+  // FCesiumPointAttenuationVertexFactory, which needs manual vertex fetch.
+  const bool quantizePoints =
+      primitive.mode == MeshPrimitive::Mode::POINTS &&
+      RHISupportsManualVertexFetch(GMaxRHIShaderPlatform);
+
+  // The vertex and index buffers of a primitive converted on the CPU may be
+  // in the prepared mesh cache, unless its texture coordinates also encode
+  // features and metadata. Its indices are then the final ones.
+  std::optional<uint64> preparedMeshKey;
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  if (!pullVertices && !quantizePoints &&
+      !modelOptions.pFeaturesMetadataDescription &&
+      !modelOptions.pEncodedMetadataDescription_DEPRECATED &&
+      CesiumPreparedMeshCache::isEnabled()) {
+    preparedMeshKey = CesiumPreparedMeshCache::getKey(
+        model,
+        primitive,
+        computePreparedMeshOptionsHash(
+            material,
+            pbrMetallicRoughness,
+            transform,
+            primitiveResult.overlayTextureCoordinateIDToUVIndex.size(),
+            {primitiveResult.isUnlit,
+             needsTangents,
+             needsWeldedSmoothNormals,
+             needsFlatNormals,
+             useFastTangentGeneration,
+             duplicateVertices,
+             modelOptions.orderPointsProgressively,
+             modelOptions.computeOverlayTextureCoordinatesInMaterial}));
+  }
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+  const bool preparedMeshFound =
+      preparedMeshKey &&
+      CesiumPreparedMeshCache::get().find(*preparedMeshKey, *RenderData);
+  if (preparedMeshFound) {
+    LODResources.IndexBuffer.GetCopy(indices);
+  }
+
+  // Positions and colors are written directly into the final vertex buffers.
+  // The remaining attributes are gathered in PrimitiveVertices and copied into
+  // the static mesh vertex buffer once the number of texture coordinate sets
+  // is known.
+  // Pulled vertices only need a placeholder vertex to satisfy the static mesh.
+  PrimitiveVertices vertices =
+      preparedMeshFound
+          ? PrimitiveVertices(LODResources.VertexBuffers.PositionVertexBuffer)
+          : PrimitiveVertices(
+                LODResources.VertexBuffers.PositionVertexBuffer,
+                pullVertices        ? 1
+                : duplicateVertices ? indices.Num()
+                                    : vertexCount);
+  PrimitiveVertices* pTexCoordVertices =
+      pullVertices || preparedMeshFound ? nullptr : &vertices;
+
+  if (pullVertices) {
+    vertices.position(0) = TMeshVector3(0.0f);
+  } else if (!preparedMeshFound && vertices.Num() > 0) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPositions)
+    RenderData->Bounds.SphereRadius = CesiumVertexKernels::copyPositionsFlipY(
+        CesiumVertexKernels::getElements(positionView),
+        duplicateVertices ? TConstArrayView<uint32>(indices)
+                          : TConstArrayView<uint32>(),
+        &vertices.position(0),
+        FVector3f(RenderData->Bounds.Origin));
   }
 
-  bool hasVertexColors = false;
+  bool hasVertexColors = preparedMeshFound && LODResources.bHasColorVertexData;
 
   auto colorAccessorIt = primitive.attributes.find("COLOR_0");
-  if (colorAccessorIt != primitive.attributes.end()) {
+  if (!preparedMeshFound && colorAccessorIt != primitive.attributes.end()) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyVertexColors)
     int colorAccessorID = colorAccessorIt->second;
+
+    FColorVertexBuffer& ColorVertexBuffer =
+        LODResources.VertexBuffers.ColorVertexBuffer;
+    ColorVertexBuffer.Init(static_cast<uint32>(vertices.Num()), false);
     hasVertexColors = createAccessorView(
         model,
         colorAccessorID,
-        ColorVisitor{duplicateVertices, StaticMeshBuildVertices, indices});
+        ColorVisitor{duplicateVertices, ColorVertexBuffer, indices});
+    if (!hasVertexColors) {
+      ColorVertexBuffer.CleanUp();
+    }
   }
 
   LODResources.bHasColorVertexData = hasVertexColors;
 
   // We need to copy the texture coordinates associated with each texture (if
-  // any) into the the appropriate UVs slot in FStaticMeshBuildVertex.
+  // any) into the the appropriate UVs slot in PrimitiveVertices.
 
   std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap =
       primitiveResult.GltfToUnrealTexCoordMap;
 
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadTextures)
-    primitiveResult.baseColorTexture =
-        loadTexture(model, pbrMetallicRoughness.baseColorTexture, true);
+    std::unique_lock<std::mutex> textureLock;
+    if (options.pTextureMutex) {
+      textureLock = std::unique_lock<std::mutex>(*options.pTextureMutex);
+    }
+    // Only color textures are compressed, because BC1 and BC3 noticeably
+    // degrade normal maps and packed data like metallic-roughness.
+    const bool compressColorTextures =
+        options.pMeshOptions->pNodeOptions->pModelOptions->compressTextures;
+    primitiveResult.baseColorTexture = loadTexture(
+        model,
+        pbrMetallicRoughness.baseColorTexture,
+        true,
+        compressColorTextures,
+        options);
     primitiveResult.metallicRoughnessTexture = loadTexture(
         model,
         pbrMetallicRoughness.metallicRoughnessTexture,
-        false);
+        false,
+        false,
+        options);
     primitiveResult.normalTexture =
-        loadTexture(model, material.normalTexture, false);
+        loadTexture(model, material.normalTexture, false, false, options);
     primitiveResult.occlusionTexture =
-        loadTexture(model, material.occlusionTexture, false);
-    primitiveResult.emissiveTexture =
-        loadTexture(model, material.emissiveTexture, true);
+        loadTexture(model, material.occlusionTexture, false, false, options);
+    primitiveResult.emissiveTexture = loadTexture(
+        model,
+        material.emissiveTexture,
+        true,
+        compressColorTextures,
+        options);
   }
 
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTextureCoordinates)
 
-    primitiveResult
-        .textureCoordinateParameters["baseColorTextureCoordinateIndex"] =
+    primitiveResult.textureCoordinateParameters.Add(
+        CesiumMaterialParameterNames::BaseColorTextureCoordinateIndex,
         updateTextureCoordinates(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            pTexCoordVertices,
             indices,
             pbrMetallicRoughness.baseColorTexture,
-            gltfToUnrealTexCoordMap);
-    primitiveResult.textureCoordinateParameters
-        ["metallicRoughnessTextureCoordinateIndex"] = updateTextureCoordinates(
-        model,
-        primitive,
-        duplicateVertices,
-        StaticMeshBuildVertices,
-        indices,
-        pbrMetallicRoughness.metallicRoughnessTexture,
-        gltfToUnrealTexCoordMap);
-    primitiveResult
-        .textureCoordinateParameters["normalTextureCoordinateIndex"] =
+            gltfToUnrealTexCoordMap));
+    primitiveResult.textureCoordinateParameters.Add(
+        CesiumMaterialParameterNames::MetallicRoughnessTextureCoordinateIndex,
+        updateTextureCoordinates(
+            model,
+            primitive,
+            duplicateVertices,
+            pTexCoordVertices,
+            indices,
+            pbrMetallicRoughness.metallicRoughnessTexture,
+            gltfToUnrealTexCoordMap));
+    primitiveResult.textureCoordinateParameters.Add(
+        CesiumMaterialParameterNames::NormalTextureCoordinateIndex,
         updateTextureCoordinates(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            pTexCoordVertices,
             indices,
             material.normalTexture,
-            gltfToUnrealTexCoordMap);
-    primitiveResult
-        .textureCoordinateParameters["occlusionTextureCoordinateIndex"] =
+            gltfToUnrealTexCoordMap));
+    primitiveResult.textureCoordinateParameters.Add(
+        CesiumMaterialParameterNames::OcclusionTextureCoordinateIndex,
         updateTextureCoordinates(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            pTexCoordVertices,
             indices,
             material.occlusionTexture,
-            gltfToUnrealTexCoordMap);
-    primitiveResult
-        .textureCoordinateParameters["emissiveTextureCoordinateIndex"] =
+            gltfToUnrealTexCoordMap));
+    primitiveResult.textureCoordinateParameters.Add(
+        CesiumMaterialParameterNames::EmissiveTextureCoordinateIndex,
         updateTextureCoordinates(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            pTexCoordVertices,
             indices,
             material.emissiveTexture,
-            gltfToUnrealTexCoordMap);
+            gltfToUnrealTexCoordMap));
 
+    // Materials that compute the overlay texture coordinates themselves
+    // don't need a texture coordinate channel for each projection.
+    const bool computeOverlayTextureCoordinatesInMaterial =
+        options.pMeshOptions->pNodeOptions->pModelOptions
+            ->computeOverlayTextureCoordinatesInMaterial;
     for (size_t i = 0;
          i < primitiveResult.overlayTextureCoordinateIDToUVIndex.size();
          ++i) {
       std::string attributeName = "_CESIUMOVERLAY_" + std::to_string(i);
       auto overlayIt = primitive.attributes.find(attributeName);
-      if (overlayIt != primitive.attributes.end()) {
+      if (overlayIt != primitive.attributes.end() &&
+          !computeOverlayTextureCoordinatesInMaterial) {
         primitiveResult.overlayTextureCoordinateIDToUVIndex[i] =
             updateTextureCoordinates(
                 model,
                 primitive,
                 duplicateVertices,
-                StaticMeshBuildVertices,
+                pTexCoordVertices,
                 indices,
                 attributeName,
                 gltfToUnrealTexCoordMap);
@@ -1335,7 +2181,7 @@ static void loadPrimitive(
         model,
         primitive,
         duplicateVertices,
-        StaticMeshBuildVertices,
+        vertices,
         indices,
         primitiveResult.Features,
         primitiveResult.EncodedFeatures,
@@ -1353,7 +2199,7 @@ static void loadPrimitive(
         model,
         primitive,
         duplicateVertices,
-        StaticMeshBuildVertices,
+        vertices,
         indices,
         *pModelResult->EncodedMetadata_DEPRECATED,
         *primitiveResult.EncodedMetadata_DEPRECATED,
@@ -1368,88 +2214,102 @@ static void loadPrimitive(
   // TangentY: Bi-tangent
   // TangentZ: Normal
 
-  if (hasNormals) {
+  TMeshVector3 uniformNormal(0.0f, 0.0f, 1.0f);
+
+  if (pullVertices) {
+    if (!hasNormals) {
+      uniformNormal =
+          computeUniformNormal(transform, RenderData->Bounds.Origin);
+    }
+  } else if (preparedMeshFound) {
+    // The normals and tangents are already in the cached vertex buffer.
+  } else if (hasNormals) {
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormalsForDuplicatedVertices)
       for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+        TMeshVector3& vertexNormal = vertices.normals[i];
         uint32 vertexIndex = indices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
         const TMeshVector3& normal = normalAccessor[vertexIndex];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
+        vertexNormal.X = normal.X;
+        vertexNormal.Y = -normal.Y;
+        vertexNormal.Z = normal.Z;
       }
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormals)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
+      for (int i = 0; i < vertices.Num(); ++i) {
+        TMeshVector3& vertexNormal = vertices.normals[i];
         const TMeshVector3& normal = normalAccessor[i];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
+        vertexNormal.X = normal.X;
+        vertexNormal.Y = -normal.Y;
+        vertexNormal.Z = normal.Z;
       }
     }
+  } else if (needsWeldedSmoothNormals) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeWeldedSmoothNormals)
+    // Weld positions that are within a millionth of the size of the
+    // primitive of each other.
+    const float cellSize =
+        float(RenderData->Bounds.BoxExtent.GetMax() * 2.0 * 1.0e-6);
+    computeWeldedSmoothNormals(indices, duplicateVertices, cellSize, vertices);
   } else {
-    if (primitiveResult.isUnlit) {
-      glm::dvec3 ecefCenter = glm::dvec3(
-          transform *
-          glm::dvec4(VecMath::createVector3D(RenderData->Bounds.Origin), 1.0));
-      TMeshVector3 upDir = TMeshVector3(VecMath::createVector(
-          glm::affineInverse(transform) *
-          glm::dvec4(
-              CesiumGeospatial::Ellipsoid::WGS84.geodeticSurfaceNormal(
-                  glm::dvec3(ecefCenter)),
-              0.0)));
+    if (!needsFlatNormals) {
+      // Use the ellipsoid surface normal for every vertex. Unlit materials
+      // don't use it for shading, and materials that compute their own flat
+      // normals replace it.
+      TMeshVector3 upDir =
+          computeUniformNormal(transform, RenderData->Bounds.Origin);
       upDir.Y *= -1;
-      setUniformNormals(indices, StaticMeshBuildVertices, upDir);
+      setUniformNormals(vertices, upDir);
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeFlatNormals)
-      computeFlatNormals(indices, StaticMeshBuildVertices);
+      computeFlatNormals(indices, vertices);
     }
   }
 
-  if (hasTangents) {
+  if (hasTangents && !pullVertices && !preparedMeshFound) {
+    vertices.allocateTangents();
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangentsForDuplicatedVertices)
       for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+        TMeshVector3& tangentX = vertices.tangentsX[i];
         uint32 vertexIndex = indices[i];
         const TMeshVector4& tangent = tangentAccessor[vertexIndex];
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
+        tangentX.X = tangent.X;
+        tangentX.Y = -tangent.Y;
+        tangentX.Z = tangent.Z;
+        vertices.tangentsY[i] =
+            TMeshVector3::CrossProduct(vertices.normals[i], tangentX) *
             tangent.W;
       }
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangents)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
+      for (int i = 0; i < vertices.Num(); ++i) {
+        TMeshVector3& tangentX = vertices.tangentsX[i];
         const TMeshVector4& tangent = tangentAccessor[i];
-        vertex.TangentX = tangent;
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
+        tangentX.X = tangent.X;
+        tangentX.Y = -tangent.Y;
+        tangentX.Z = tangent.Z;
+        vertices.tangentsY[i] =
+            TMeshVector3::CrossProduct(vertices.normals[i], tangentX) *
             tangent.W;
       }
     }
   }
 
-  if (needsTangents && !hasTangents) {
+  if (preparedMeshFound) {
+    // The tangents are already in the cached vertex buffer.
+  } else if (needsTangents && !hasTangents && useFastTangentGeneration) {
+    // Note that this assumes normals and UVs are already populated.
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeIndexedTangents)
+    computeIndexedTangentSpace(indices, duplicateVertices, vertices);
+  } else if (needsTangents && !hasTangents) {
     // Use mikktspace to calculate the tangents.
     // Note that this assumes normals and UVs are already populated.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeTangents)
-    computeTangentSpace(StaticMeshBuildVertices);
+    computeTangentSpace(vertices);
   }
 
-  {
+  if (!preparedMeshFound) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitBuffers)
 
     // Set to full precision (32-bit) UVs. This is especially important for
@@ -1458,21 +2318,97 @@ static void loadPrimitive(
     LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(
         true);
 
-    LODResources.VertexBuffers.PositionVertexBuffer.Init(
-        StaticMeshBuildVertices,
-        false);
+    if (quantizePoints) {
+      // The attenuation vertex factory reads the positions and normals from
+      // the quantized buffer, so the static mesh only needs real vertex data
+      // for the texture coordinates, if there are any. Colors are already
+      // compact.
+      const FBox3f bounds(
+          FVector3f(RenderData->Bounds.Origin - RenderData->Bounds.BoxExtent),
+          FVector3f(RenderData->Bounds.Origin + RenderData->Bounds.BoxExtent));
+      // Classifications and intensities are the attributes that LiDAR point
+      // clouds are most often filtered by, and the names that 3D Tiles 1.0
+      // point clouds have once they're converted to glTF.
+      const int64 pointCount =
+          int64(LODResources.VertexBuffers.PositionVertexBuffer
+                    .GetNumVertices());
+      const TConstArrayView<uint32> pointIndices =
+          duplicateVertices ? TConstArrayView<uint32>(indices)
+                            : TConstArrayView<uint32>();
+      const TArray<float> classifications = loadPointFilterAttribute(
+          model,
+          primitive,
+          "_CLASSIFICATION",
+          pointCount,
+          pointIndices);
+      const TArray<float> intensities = loadPointFilterAttribute(
+          model,
+          primitive,
+          "_INTENSITY",
+          pointCount,
+          pointIndices);
+      primitiveResult.QuantizedPoints =
+          FCesiumQuantizedPointsVertexBuffer::Create(
+              LODResources.VertexBuffers.PositionVertexBuffer,
+              vertices.normals,
+              bounds,
+              classifications,
+              intensities);
+
+      if (gltfToUnrealTexCoordMap.size() > 0) {
+        vertices.initVertexBuffer(
+            LODResources.VertexBuffers.StaticMeshVertexBuffer,
+            gltfToUnrealTexCoordMap.size());
+      } else {
+        FStaticMeshVertexBuffer& vertexBuffer =
+            LODResources.VertexBuffers.StaticMeshVertexBuffer;
+        vertexBuffer.Init(1, 1, false);
+        vertexBuffer.SetVertexTangents(
+            0,
+            TMeshVector3(1.0f, 0.0f, 0.0f),
+            TMeshVector3(0.0f, 1.0f, 0.0f),
+            TMeshVector3(0.0f, 0.0f, 1.0f));
+        vertexBuffer.SetVertexUV(0, 0, TMeshVector2(0.0f, 0.0f));
+      }
 
-    FColorVertexBuffer& ColorVertexBuffer =
-        LODResources.VertexBuffers.ColorVertexBuffer;
-    if (hasVertexColors) {
-      ColorVertexBuffer.Init(StaticMeshBuildVertices, false);
-    }
+      FPositionVertexBuffer& positionBuffer =
+          LODResources.VertexBuffers.PositionVertexBuffer;
+      positionBuffer.Init(1, false);
+      positionBuffer.VertexPosition(0) = TMeshVector3(0.0f);
+      indices.Empty();
+    } else if (pullVertices) {
+      TArray<int32_t> texCoordAccessorIDs;
+      texCoordAccessorIDs.SetNum(gltfToUnrealTexCoordMap.size());
+      for (const auto& [accessorID, unrealIndex] : gltfToUnrealTexCoordMap) {
+        texCoordAccessorIDs[unrealIndex] = accessorID;
+      }
 
-    LODResources.VertexBuffers.StaticMeshVertexBuffer.Init(
-        StaticMeshBuildVertices,
-        gltfToUnrealTexCoordMap.size() == 0 ? 1
-                                            : gltfToUnrealTexCoordMap.size(),
-        false);
+      primitiveResult.PulledAttributes = FCesiumGltfAttributeBuffer::Create(
+          model,
+          primitive.attributes.at("POSITION"),
+          hasNormals ? normalAccessorIt->second : -1,
+          texCoordAccessorIDs,
+          FVector3f(uniformNormal),
+          options.pMeshOptions->pNodeOptions->pModelOptions
+              ->packVertexAttributes);
+      if (!primitiveResult.PulledAttributes) {
+        UE_LOG(
+            LogCesium,
+            Warning,
+            TEXT("%s: Could not copy the vertex attributes to pull"),
+            UTF8_TO_TCHAR(name.c_str()));
+        return;
+      }
+
+      vertices.initVertexBuffer(
+          LODResources.VertexBuffers.StaticMeshVertexBuffer,
+          1);
+    } else {
+      vertices.initVertexBuffer(
+          LODResources.VertexBuffers.StaticMeshVertexBuffer,
+          gltfToUnrealTexCoordMap.size() == 0 ? 1
+                                              : gltfToUnrealTexCoordMap.size());
+    }
   }
 
   FStaticMeshSectionArray& Sections = LODResources.Sections;
@@ -1481,7 +2417,8 @@ static void loadPrimitive(
   section.NumTriangles = indices.Num() / 3;
   section.FirstIndex = 0;
   section.MinVertexIndex = 0;
-  section.MaxVertexIndex = StaticMeshBuildVertices.Num() - 1;
+  section.MaxVertexIndex =
+      (pullVertices ? vertexCount : vertices.Num()) - 1;
   section.bEnableCollision = primitive.mode != MeshPrimitive::Mode::POINTS;
   section.bCastShadow = true;
   section.MaterialIndex = 0;
@@ -1493,11 +2430,15 @@ static void loadPrimitive(
     }
   }
 
-  {
+  if (!preparedMeshFound) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetIndices)
+    // Every index of a primitive with up to 65536 vertices fits in 16 bits,
+    // which halves the size of the index buffer. That's most primitives.
+    const int64 indexedVertexCount =
+        pullVertices ? vertexCount : vertices.Num();
     LODResources.IndexBuffer.SetIndices(
         indices,
-        StaticMeshBuildVertices.Num() >= std::numeric_limits<uint16>::max()
+        indexedVertexCount > int64(std::numeric_limits<uint16>::max()) + 1
             ? EIndexBufferStride::Type::Force32Bit
             : EIndexBufferStride::Type::Force16Bit);
   }
@@ -1506,50 +2447,131 @@ static void loadPrimitive(
   LODResources.bHasReversedIndices = false;
   LODResources.bHasReversedDepthOnlyIndices = false;
 
+  if (preparedMeshKey && !preparedMeshFound) {
+    CesiumPreparedMeshCache::get().add(*preparedMeshKey, *RenderData);
+  }
+
+  // Nanite only renders opaque and masked triangles.
+  if (options.pMeshOptions->pNodeOptions->pModelOptions->buildNaniteMeshes &&
+      primitive.mode != MeshPrimitive::Mode::POINTS &&
+      material.alphaMode != Material::AlphaMode::BLEND) {
+    CesiumNaniteBuilder::build(*RenderData, indices);
+  }
+
+  computeMaterialKey(primitiveResult, material, pbrMetallicRoughness);
+
   primitiveResult.pModel = &model;
   primitiveResult.pMeshPrimitive = &primitive;
   primitiveResult.RenderData = std::move(RenderData);
   primitiveResult.pMaterial = &material;
   primitiveResult.pCollisionMesh = nullptr;
 
-  // This matrix converts from right-handed Z-up to Unreal
-  // left-handed Z-up by flipping the Y axis. It effectively undoes the Y-axis
-  // flipping that we did when creating the mesh in the first place. This is
-  // necessary to work around a problem in UE 5.1 where negatively-scaled meshes
-  // don't work correctly for collision.
-  // See https://github.com/CesiumGS/cesium-unreal/pull/1126
-  static constexpr glm::dmat4 yInvertMatrix = {
-      1.0,
-      0.0,
-      0.0,
-      0.0,
-      0.0,
-      -1.0,
-      0.0,
-      0.0,
-      0.0,
-      0.0,
-      1.0,
-      0.0,
-      0.0,
-      0.0,
-      0.0,
-      1.0};
-
   primitiveResult.transform = transform * yInvertMatrix;
 
+  if (primitive.mode != MeshPrimitive::Mode::POINTS &&
+      (modelOptions.createNavCollision || modelOptions.enableHeightQueries) &&
+      indices.Num() >= 3) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GatherNavigationGeometry)
+    TSharedPtr<CesiumNavigationGeometry, ESPMode::ThreadSafe> pGeometry =
+        MakeShared<CesiumNavigationGeometry, ESPMode::ThreadSafe>();
+    if (pullVertices) {
+      TArray<FVector3f> positions;
+      primitiveResult.PulledAttributes->GetPositions(positions);
+      pGeometry->vertices.SetNumUninitialized(positions.Num());
+      for (int32 i = 0; i < positions.Num(); ++i) {
+        pGeometry->vertices[i] = FVector(positions[i]);
+      }
+    } else {
+      const FPositionVertexBuffer& positions =
+          LODResources.VertexBuffers.PositionVertexBuffer;
+      pGeometry->vertices.SetNumUninitialized(vertices.Num());
+      for (int32 i = 0; i < vertices.Num(); ++i) {
+        pGeometry->vertices[i] =
+            FVector(positions.VertexPosition(static_cast<uint32>(i)));
+      }
+    }
+    pGeometry->indices.SetNumUninitialized(indices.Num() - indices.Num() % 3);
+    for (int32 i = 0; i < pGeometry->indices.Num(); ++i) {
+      pGeometry->indices[i] = static_cast<int32>(indices[i]);
+    }
+
+    // Height queries use the same triangles, so they're only copied if
+    // they're needed for navigation too.
+    if (modelOptions.enableHeightQueries) {
+      TArray<FVector> vertices = modelOptions.createNavCollision
+                                     ? pGeometry->vertices
+                                     : MoveTemp(pGeometry->vertices);
+      primitiveResult.HeightQueryBvh =
+          MakeShared<const CesiumTriangleBvh, ESPMode::ThreadSafe>(
+              MoveTemp(vertices),
+              pGeometry->indices);
+    }
+    if (modelOptions.createNavCollision) {
+      primitiveResult.NavigationGeometry = MoveTemp(pGeometry);
+    }
+  }
+
+  if (primitive.mode != MeshPrimitive::Mode::POINTS &&
+      modelOptions.keepMeshDataForBaking && indices.Num() >= 3) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GatherBakingGeometry)
+    TSharedPtr<CesiumBakingGeometry, ESPMode::ThreadSafe> pBaking =
+        MakeShared<CesiumBakingGeometry, ESPMode::ThreadSafe>();
+    if (pullVertices) {
+      primitiveResult.PulledAttributes->GetPositions(pBaking->positions);
+    } else {
+      // The vertex buffers are only readable until they're uploaded.
+      const FPositionVertexBuffer& positions =
+          LODResources.VertexBuffers.PositionVertexBuffer;
+      const FStaticMeshVertexBuffer& attributes =
+          LODResources.VertexBuffers.StaticMeshVertexBuffer;
+      const bool hasTexCoords = attributes.GetNumTexCoords() > 0;
+      pBaking->positions.SetNumUninitialized(vertices.Num());
+      pBaking->normals.SetNumUninitialized(vertices.Num());
+      if (hasTexCoords) {
+        pBaking->texCoords.SetNumUninitialized(vertices.Num());
+      }
+      for (int32 i = 0; i < vertices.Num(); ++i) {
+        const uint32 vertex = static_cast<uint32>(i);
+        pBaking->positions[i] = positions.VertexPosition(vertex);
+        pBaking->normals[i] = FVector3f(attributes.VertexTangentZ(vertex));
+        if (hasTexCoords) {
+          pBaking->texCoords[i] = attributes.GetVertexUV(vertex, 0);
+        }
+      }
+    }
+    pBaking->indices.Append(
+        indices.GetData(),
+        indices.Num() - indices.Num() % 3);
+    primitiveResult.BakingGeometry = MoveTemp(pBaking);
+  }
+
   if (primitive.mode != MeshPrimitive::Mode::POINTS &&
       options.pMeshOptions->pNodeOptions->pModelOptions->createPhysicsMeshes) {
-    if (StaticMeshBuildVertices.Num() != 0 && indices.Num() != 0) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
+    if (pullVertices && indices.Num() != 0) {
+      TArray<FVector3f> positions;
+      primitiveResult.PulledAttributes->GetPositions(positions);
+      CesiumPhysicsMeshUtility::CollisionGeometry geometry;
+      geometry.vertices.AddParticles(positions.Num());
+      for (int32 i = 0; i < positions.Num(); ++i) {
+        geometry.vertices.X(i) = positions[i];
+      }
+      geometry.indices = MoveTemp(indices);
+      primitiveResult.pCollisionMesh =
+          CesiumPhysicsMeshUtility::buildChaosTriangleMesh(
+              MoveTemp(geometry));
+    } else if (vertices.Num() != 0 && indices.Num() != 0) {
+      const FPositionVertexBuffer& positions =
+          LODResources.VertexBuffers.PositionVertexBuffer;
+      CesiumPhysicsMeshUtility::CollisionGeometry geometry;
+      geometry.vertices.AddParticles(vertices.Num());
+      for (int32 i = 0; i < vertices.Num(); ++i) {
+        geometry.vertices.X(i) =
+            positions.VertexPosition(static_cast<uint32>(i));
+      }
+      geometry.indices = MoveTemp(indices);
       primitiveResult.pCollisionMesh =
-          StaticMeshBuildVertices.Num() < TNumericLimits<uint16>::Max()
-              ? BuildChaosTriangleMeshes<uint16>(
-                    StaticMeshBuildVertices,
-                    indices)
-              : BuildChaosTriangleMeshes<int32>(
-                    StaticMeshBuildVertices,
-                    indices);
+          CesiumPhysicsMeshUtility::buildChaosTriangleMesh(
+              MoveTemp(geometry));
     }
   }
 }
@@ -1637,9 +2659,18 @@ static void loadPrimitive(
   AccessorView<TMeshVector3> positionView(model, *pPositionAccessor);
 
   if (primitive.indices < 0 || primitive.indices >= model.accessors.size()) {
-    std::vector<uint32_t> syntheticIndexBuffer(positionView.size());
-    syntheticIndexBuffer.resize(positionView.size());
-    for (uint32_t i = 0; i < positionView.size(); ++i) {
+    // Quantized positions can't be viewed as floats, but may still be pulled.
+    const int64_t vertexCount =
+        positionView.status() != AccessorViewStatus::Valid &&
+                FCesiumGltfAttributeBuffer::IsSupportedAccessor(
+                    model,
+                    positionAccessorID,
+                    3,
+                    0)
+            ? pPositionAccessor->count
+            : positionView.size();
+    std::vector<uint32_t> syntheticIndexBuffer(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i) {
       syntheticIndexBuffer[i] = i;
     }
     loadPrimitive(
@@ -1660,34 +2691,223 @@ static void loadPrimitive(
   result.PositionAccessor = std::move(positionView);
 }
 
+namespace {
+/**
+ * A primitive that was found while walking the glTF node hierarchy, but that
+ * has not been loaded yet. This holds copies of the node and mesh options
+ * that the primitive options point to, so that primitives can be loaded
+ * after the walk is finished, and in parallel.
+ */
+struct PrimitiveToLoad {
+  CreateNodeOptions nodeOptions;
+  CreateMeshOptions meshOptions;
+  CreatePrimitiveOptions primitiveOptions;
+  glm::dmat4x4 transform;
+  LoadPrimitiveResult* pResult;
+};
+} // namespace
+
 static void loadMesh(
     std::optional<LoadMeshResult>& result,
     const glm::dmat4x4& transform,
-    const CreateMeshOptions& options) {
+    const CreateMeshOptions& options,
+    std::deque<PrimitiveToLoad>& primitivesToLoad) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadMesh)
 
-  const Model& model = *options.pNodeOptions->pModelOptions->pModel;
   const Mesh& mesh = *options.pMesh;
 
   result = LoadMeshResult();
+
+  // Every primitive result is created up front so that the pointers held by
+  // primitivesToLoad stay valid until the primitives are loaded.
   result->primitiveResults.reserve(mesh.primitives.size());
   for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
-    CreatePrimitiveOptions primitiveOptions = {&options, &*result, &primitive};
-    auto& primitiveResult = result->primitiveResults.emplace_back();
-    loadPrimitive(primitiveResult, transform, primitiveOptions);
+    PrimitiveToLoad& toLoad = primitivesToLoad.emplace_back();
+    toLoad.nodeOptions = *options.pNodeOptions;
+    toLoad.meshOptions = options;
+    toLoad.meshOptions.pNodeOptions = &toLoad.nodeOptions;
+    toLoad.primitiveOptions = {&toLoad.meshOptions, &*result, &primitive};
+    toLoad.transform = transform;
+    toLoad.pResult = &result->primitiveResults.emplace_back();
+  }
+}
+
+static void loadPrimitives(std::deque<PrimitiveToLoad>& primitivesToLoad) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadPrimitives)
+
+  std::mutex textureMutex;
+  TMap<int64, TSharedPtr<CesiumTextureUtility::LoadedTextureResult>>
+      loadedTextures;
+  for (PrimitiveToLoad& toLoad : primitivesToLoad) {
+    toLoad.primitiveOptions.pTextureMutex = &textureMutex;
+    toLoad.primitiveOptions.pLoadedTextures = &loadedTextures;
+  }
+
+  // Primitives are independent of each other, so a model with many of them
+  // can be spread across multiple workers rather than occupying just one.
+  // ParallelFor also does work on the calling thread, so this can't starve
+  // if every other worker is busy.
+  ParallelFor(
+      static_cast<int32>(primitivesToLoad.size()),
+      [&primitivesToLoad](int32 i) {
+        PrimitiveToLoad& toLoad = primitivesToLoad[i];
+        loadPrimitive(
+            *toLoad.pResult,
+            toLoad.transform,
+            toLoad.primitiveOptions);
+      },
+      EParallelForFlags::Unbalanced | EParallelForFlags::BackgroundPriority);
+}
+
+static void removeUnloadedPrimitives(LoadModelResult& result) {
+  for (LoadNodeResult& nodeResult : result.nodeResults) {
+    if (!nodeResult.meshResult) {
+      continue;
+    }
+
+    std::vector<LoadPrimitiveResult>& primitiveResults =
+        nodeResult.meshResult->primitiveResults;
+
+    // If it doesn't have render data, then it can't be loaded.
+    auto hasRenderData = [](const LoadPrimitiveResult& primitiveResult) {
+      return primitiveResult.RenderData != nullptr;
+    };
+    if (std::all_of(
+            primitiveResults.begin(),
+            primitiveResults.end(),
+            hasRenderData)) {
+      continue;
+    }
+
+    std::vector<LoadPrimitiveResult> loadedPrimitiveResults;
+    loadedPrimitiveResults.reserve(primitiveResults.size());
+    for (LoadPrimitiveResult& primitiveResult : primitiveResults) {
+      if (hasRenderData(primitiveResult)) {
+        loadedPrimitiveResults.emplace_back(std::move(primitiveResult));
+      }
+    }
+    primitiveResults = std::move(loadedPrimitiveResults);
+  }
+}
+
+namespace {
+/**
+ * Reads a VEC3 or VEC4 instance attribute of EXT_mesh_gpu_instancing, which
+ * is either floating point or, for rotations, normalized signed integers.
+ */
+template <typename TVector>
+bool readInstanceAttribute(
+    const Model& model,
+    const ExtensionExtMeshGpuInstancing& instancing,
+    const std::string& name,
+    std::vector<TVector>& values) {
+  auto it = instancing.attributes.find(name);
+  if (it == instancing.attributes.end()) {
+    return false;
+  }
+
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, it->second);
+  if (!pAccessor) {
+    return false;
+  }
+
+  constexpr glm::length_t componentCount = TVector::length();
+  // Normalized values are scaled to [-1, 1], as described by the glTF spec.
+  auto read = [&values](const auto& view, double scale, bool normalized) {
+    if (view.status() != AccessorViewStatus::Valid) {
+      return false;
+    }
+    values.resize(size_t(view.size()));
+    for (int64_t i = 0; i < view.size(); ++i) {
+      for (glm::length_t c = 0; c < componentCount; ++c) {
+        const double value = double(view[i][c]) * scale;
+        values[size_t(i)][c] = normalized ? glm::max(value, -1.0) : value;
+      }
+    }
+    return true;
+  };
+
+  using Float = glm::vec<componentCount, float>;
+  using Int8 = glm::vec<componentCount, int8_t>;
+  using Int16 = glm::vec<componentCount, int16_t>;
+
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::FLOAT:
+    return read(AccessorView<Float>(model, *pAccessor), 1.0, false);
+  case Accessor::ComponentType::BYTE:
+    return pAccessor->normalized &&
+           read(AccessorView<Int8>(model, *pAccessor), 1.0 / 127.0, true);
+  case Accessor::ComponentType::SHORT:
+    return pAccessor->normalized &&
+           read(AccessorView<Int16>(model, *pAccessor), 1.0 / 32767.0, true);
+  default:
+    return false;
+  }
+}
+
+TArray<FTransform>
+loadInstanceTransforms(const Model& model, const Node& node) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadInstanceTransforms)
+
+  TArray<FTransform> result;
+
+  const ExtensionExtMeshGpuInstancing* pInstancing =
+      node.getExtension<ExtensionExtMeshGpuInstancing>();
+  if (!pInstancing) {
+    return result;
+  }
+
+  std::vector<glm::dvec3> translations;
+  std::vector<glm::dvec4> rotations;
+  std::vector<glm::dvec3> scales;
+  readInstanceAttribute(model, *pInstancing, "TRANSLATION", translations);
+  readInstanceAttribute(model, *pInstancing, "ROTATION", rotations);
+  readInstanceAttribute(model, *pInstancing, "SCALE", scales);
+
+  // Every attribute must have the same number of instances.
+  const size_t count =
+      std::max({translations.size(), rotations.size(), scales.size()});
+  if ((!translations.empty() && translations.size() != count) ||
+      (!rotations.empty() && rotations.size() != count) ||
+      (!scales.empty() && scales.size() != count)) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "EXT_mesh_gpu_instancing attributes have different counts, so the node's instances are ignored."));
+    return result;
+  }
 
-    // if it doesn't have render data, then it can't be loaded
-    if (!primitiveResult.RenderData) {
-      result->primitiveResults.pop_back();
+  // The transforms are in the same space as node transforms, so they can be
+  // given to the instanced component directly, the same way node transforms
+  // are turned into component transforms.
+  result.Reserve(int32(count));
+  for (size_t i = 0; i < count; ++i) {
+    glm::dmat4 transform(1.0);
+    if (!translations.empty()) {
+      transform = glm::translate(transform, translations[i]);
+    }
+    if (!rotations.empty()) {
+      const glm::dvec4& r = rotations[i];
+      const glm::dquat rotation(r.w, r.x, r.y, r.z);
+      transform = transform * glm::dmat4(glm::normalize(rotation));
     }
+    if (!scales.empty()) {
+      transform = glm::scale(transform, scales[i]);
+    }
+    result.Emplace(VecMath::createMatrix(transform));
   }
+
+  return result;
 }
+} // namespace
 
 static void loadNode(
     std::vector<LoadNodeResult>& loadNodeResults,
     const glm::dmat4x4& transform,
-    const CreateNodeOptions& options) {
+    const CreateNodeOptions& options,
+    std::deque<PrimitiveToLoad>& primitivesToLoad) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadNode)
 
@@ -1763,7 +2983,8 @@ static void loadNode(
   int meshId = node.mesh;
   if (meshId >= 0 && meshId < model.meshes.size()) {
     CreateMeshOptions meshOptions = {&options, &result, &model.meshes[meshId]};
-    loadMesh(result.meshResult, nodeTransform, meshOptions);
+    loadMesh(result.meshResult, nodeTransform, meshOptions, primitivesToLoad);
+    result.instanceTransforms = loadInstanceTransforms(model, node);
   }
 
   for (int childNodeId : node.children) {
@@ -1772,7 +2993,11 @@ static void loadNode(
           options.pModelOptions,
           options.pHalfConstructedModelResult,
           &model.nodes[childNodeId]};
-      loadNode(loadNodeResults, nodeTransform, childNodeOptions);
+      loadNode(
+          loadNodeResults,
+          nodeTransform,
+          childNodeOptions,
+          primitivesToLoad);
     }
   }
 }
@@ -1821,6 +3046,265 @@ void applyGltfUpAxisTransform(const Model& model, glm::dmat4x4& rootTransform) {
         gltfUpAxisValue);
   }
 }
+
+/**
+ * Frees the buffers that only hold the values of property table properties
+ * that the description doesn't encode for the material, so that they don't
+ * take memory for as long as the tile is loaded. The properties stay in the
+ * glTF, but their views will be invalid.
+ *
+ * Buffers that are also used by anything else, such as geometry, images, or
+ * encoded properties, are kept. This frees the most for tiles whose property
+ * values are in buffers of their own, like those converted from the batch
+ * tables of 3D Tiles 1.0.
+ */
+void discardUnencodedPropertyTableData(
+    Model& model,
+    const ExtensionModelExtStructuralMetadata& metadata,
+    const FCesiumModelMetadataDescription& description) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DiscardUnencodedPropertyTableData)
+
+  std::vector<bool> discardBufferViews(model.bufferViews.size(), false);
+  std::vector<bool> keepBufferViews(model.bufferViews.size(), false);
+  auto markBufferView = [](std::vector<bool>& marks, int32_t bufferView) {
+    if (bufferView >= 0 && size_t(bufferView) < marks.size()) {
+      marks[size_t(bufferView)] = true;
+    }
+  };
+
+  for (const Accessor& accessor : model.accessors) {
+    markBufferView(keepBufferViews, accessor.bufferView);
+  }
+  for (const Image& image : model.images) {
+    markBufferView(keepBufferViews, image.bufferView);
+  }
+
+  for (const PropertyTable& propertyTable : metadata.propertyTables) {
+    // Match the table by name the same way getNameForPropertyTable does.
+    std::string tableName = propertyTable.name.value_or("");
+    if (tableName.empty()) {
+      tableName = propertyTable.classProperty;
+    }
+    const FString propertyTableName(UTF8_TO_TCHAR(tableName.c_str()));
+    const FCesiumPropertyTableDescription* pTableDescription =
+        description.PropertyTables.FindByPredicate(
+            [&propertyTableName](
+                const FCesiumPropertyTableDescription& expectedPropertyTable) {
+              return propertyTableName == expectedPropertyTable.Name;
+            });
+
+    for (const auto& propertyIt : propertyTable.properties) {
+      const FString propertyName(UTF8_TO_TCHAR(propertyIt.first.c_str()));
+      const FCesiumPropertyTablePropertyDescription* pPropertyDescription =
+          pTableDescription
+              ? pTableDescription->Properties.FindByPredicate(
+                    [&propertyName](
+                        const FCesiumPropertyTablePropertyDescription&
+                            expectedProperty) {
+                      return propertyName == expectedProperty.Name;
+                    })
+              : nullptr;
+      const bool isEncoded =
+          pPropertyDescription &&
+          pPropertyDescription->EncodingDetails.Conversion !=
+              ECesiumEncodedMetadataConversion::None;
+
+      std::vector<bool>& marks =
+          isEncoded ? keepBufferViews : discardBufferViews;
+      markBufferView(marks, propertyIt.second.values);
+      markBufferView(marks, propertyIt.second.arrayOffsets);
+      markBufferView(marks, propertyIt.second.stringOffsets);
+    }
+  }
+
+  // A buffer is freed only if all of its buffer views are discarded.
+  std::vector<bool> discardBuffers(model.buffers.size(), false);
+  std::vector<bool> keepBuffers(model.buffers.size(), false);
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+    const int32_t buffer = model.bufferViews[i].buffer;
+    const bool discard = discardBufferViews[i] && !keepBufferViews[i];
+    markBufferView(discard ? discardBuffers : keepBuffers, buffer);
+  }
+
+  for (size_t i = 0; i < model.buffers.size(); ++i) {
+    if (discardBuffers[i] && !keepBuffers[i]) {
+      std::vector<std::byte>& data = model.buffers[i].cesium.data;
+      data.clear();
+      data.shrink_to_fit();
+    }
+  }
+}
+
+void keepCachedTextureImage(
+    const LoadedTextureResult* pTexture,
+    std::vector<bool>& keepImages) {
+  // A texture that was found in the cache in the background is looked up
+  // again on the game thread, and is created from the glTF image if it's
+  // gone by then.
+  const GltfImageIndex* pImageIndex =
+      pTexture ? std::get_if<GltfImageIndex>(&pTexture->textureSource)
+               : nullptr;
+  if (pImageIndex && pImageIndex->index >= 0 &&
+      size_t(pImageIndex->index) < keepImages.size()) {
+    keepImages[size_t(pImageIndex->index)] = true;
+  }
+}
+
+/**
+ * Releases the buffers and decoded images of a glTF once the meshes and
+ * textures of its tile have been created from them, so that they don't take
+ * memory for as long as the tile is loaded. Like
+ * discardUnencodedPropertyTableData, a buffer is only freed if none of its
+ * buffer views are kept.
+ */
+void HalfConstructedReal::releaseGltfData(
+    Model& model,
+    bool keepMetadataAndPickingData,
+    bool keepPositionsAndIndices) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleaseGltfData)
+
+  // The views of the deprecated EXT_feature_metadata aren't tracked, so none
+  // of its data can be released.
+  if (keepMetadataAndPickingData &&
+      model.hasExtension<ExtensionModelExtFeatureMetadata>()) {
+    return;
+  }
+
+  std::vector<bool> keepBufferViews(model.bufferViews.size(), false);
+  std::vector<bool> keepImages(model.images.size(), false);
+  auto mark = [](std::vector<bool>& marks, int32_t index) {
+    if (index >= 0 && size_t(index) < marks.size()) {
+      marks[size_t(index)] = true;
+    }
+  };
+  auto markAccessor = [&model, &keepBufferViews, &mark](int32_t accessor) {
+    const Accessor* pAccessor = Model::getSafe(&model.accessors, accessor);
+    if (pAccessor) {
+      mark(keepBufferViews, pAccessor->bufferView);
+      if (pAccessor->sparse) {
+        mark(keepBufferViews, pAccessor->sparse->indices.bufferView);
+        mark(keepBufferViews, pAccessor->sparse->values.bufferView);
+      }
+    }
+  };
+  auto markTexture = [&model, &keepImages, &mark](int32_t texture) {
+    const Texture* pTexture = Model::getSafe(&model.textures, texture);
+    if (pTexture) {
+      mark(keepImages, pTexture->source);
+    }
+  };
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      if (keepMetadataAndPickingData || keepPositionsAndIndices) {
+        auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt != primitive.attributes.end()) {
+          markAccessor(positionIt->second);
+        }
+        markAccessor(primitive.indices);
+      }
+
+      if (!keepMetadataAndPickingData) {
+        continue;
+      }
+
+      for (const auto& attribute : primitive.attributes) {
+        if (attribute.first.rfind("TEXCOORD_", 0) == 0 ||
+            attribute.first.rfind("_FEATURE_ID_", 0) == 0) {
+          markAccessor(attribute.second);
+        }
+      }
+
+      const ExtensionExtMeshFeatures* pFeatures =
+          primitive.getExtension<ExtensionExtMeshFeatures>();
+      if (pFeatures) {
+        for (const FeatureId& featureId : pFeatures->featureIds) {
+          if (featureId.texture) {
+            markTexture(featureId.texture->index);
+          }
+        }
+      }
+    }
+  }
+
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  if (keepMetadataAndPickingData && pMetadata) {
+    for (const PropertyTable& propertyTable : pMetadata->propertyTables) {
+      for (const auto& propertyIt : propertyTable.properties) {
+        mark(keepBufferViews, propertyIt.second.values);
+        mark(keepBufferViews, propertyIt.second.arrayOffsets);
+        mark(keepBufferViews, propertyIt.second.stringOffsets);
+      }
+    }
+    for (const PropertyTexture& propertyTexture :
+         pMetadata->propertyTextures) {
+      for (const auto& propertyIt : propertyTexture.properties) {
+        markTexture(propertyIt.second.index);
+      }
+    }
+  }
+
+  for (LoadNodeResult& node : this->loadModelResult.nodeResults) {
+    if (!node.meshResult) {
+      continue;
+    }
+    for (LoadPrimitiveResult& primitive : node.meshResult->primitiveResults) {
+      keepCachedTextureImage(primitive.baseColorTexture.Get(), keepImages);
+      keepCachedTextureImage(
+          primitive.metallicRoughnessTexture.Get(),
+          keepImages);
+      keepCachedTextureImage(primitive.normalTexture.Get(), keepImages);
+      keepCachedTextureImage(primitive.emissiveTexture.Get(), keepImages);
+      keepCachedTextureImage(primitive.occlusionTexture.Get(), keepImages);
+      keepCachedTextureImage(primitive.waterMaskTexture.Get(), keepImages);
+
+      if (keepMetadataAndPickingData) {
+        continue;
+      }
+
+      // These views are into the data that's about to be released.
+      PRAGMA_DISABLE_DEPRECATION_WARNINGS
+      primitive.Features = FCesiumPrimitiveFeatures();
+      primitive.Metadata = FCesiumPrimitiveMetadata();
+      primitive.Metadata_DEPRECATED = FCesiumMetadataPrimitive();
+      PRAGMA_ENABLE_DEPRECATION_WARNINGS
+      primitive.TexCoordAccessorMap.clear();
+      if (!keepPositionsAndIndices) {
+        primitive.PositionAccessor = AccessorView<FVector3f>();
+        primitive.IndexAccessor = CesiumIndexAccessorType();
+      }
+    }
+  }
+
+  if (!keepMetadataAndPickingData) {
+    this->loadModelResult.Metadata = FCesiumModelMetadata();
+  }
+
+  std::vector<bool> keepBuffers(model.buffers.size(), false);
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+    if (keepBufferViews[i]) {
+      mark(keepBuffers, model.bufferViews[i].buffer);
+    }
+  }
+
+  for (size_t i = 0; i < model.buffers.size(); ++i) {
+    if (!keepBuffers[i]) {
+      std::vector<std::byte>& data = model.buffers[i].cesium.data;
+      data.clear();
+      data.shrink_to_fit();
+    }
+  }
+
+  for (size_t i = 0; i < model.images.size(); ++i) {
+    if (!keepImages[i]) {
+      ImageCesium& image = model.images[i].cesium;
+      image.pixelData.clear();
+      image.pixelData.shrink_to_fit();
+      image.mipPositions.clear();
+    }
+  }
+}
 } // namespace
 
 static void loadModelAnyThreadPart(
@@ -1829,17 +3313,32 @@ static void loadModelAnyThreadPart(
     const CreateModelOptions& options) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadModelAnyThreadPart)
 
+  if (options.mergePrimitives) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MergePrimitives)
+    CesiumPrimitiveMerging::mergePrimitives(*options.pModel);
+  }
+
   const Model& model = *options.pModel;
 
+  const FCesiumFeaturesMetadataDescription* pFeaturesMetadataDescription =
+      options.pFeaturesMetadataDescription;
+
+  // The property tables are only created here if they're encoded. Otherwise,
+  // they're created on the game thread when they're first accessed.
   const ExtensionModelExtStructuralMetadata* pMetadataExtension =
       model.getExtension<ExtensionModelExtStructuralMetadata>();
   if (pMetadataExtension) {
+    if (pFeaturesMetadataDescription &&
+        pFeaturesMetadataDescription->DiscardUnencodedPropertyTableData) {
+      discardUnencodedPropertyTableData(
+          *options.pModel,
+          *pMetadataExtension,
+          pFeaturesMetadataDescription->ModelMetadata);
+    }
+
     result.Metadata = FCesiumModelMetadata(model, *pMetadataExtension);
   }
 
-  const FCesiumFeaturesMetadataDescription* pFeaturesMetadataDescription =
-      options.pFeaturesMetadataDescription;
-
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   const FMetadataDescription* pMetadataDescription_DEPRECATED =
       options.pEncodedMetadataDescription_DEPRECATED;
@@ -1864,24 +3363,40 @@ static void loadModelAnyThreadPart(
     applyGltfUpAxisTransform(model, rootTransform);
   }
 
+  // Walk the node hierarchy first, and then load all of the primitives that
+  // were found at once.
+  std::deque<PrimitiveToLoad> primitivesToLoad;
+
   if (model.scene >= 0 && model.scene < model.scenes.size()) {
     // Show the default scene
     const Scene& defaultScene = model.scenes[model.scene];
     for (int nodeId : defaultScene.nodes) {
       CreateNodeOptions nodeOptions = {&options, &result, &model.nodes[nodeId]};
-      loadNode(result.nodeResults, rootTransform, nodeOptions);
+      loadNode(
+          result.nodeResults,
+          rootTransform,
+          nodeOptions,
+          primitivesToLoad);
     }
   } else if (model.scenes.size() > 0) {
     // There's no default, so show the first scene
     const Scene& defaultScene = model.scenes[0];
     for (int nodeId : defaultScene.nodes) {
       CreateNodeOptions nodeOptions = {&options, &result, &model.nodes[nodeId]};
-      loadNode(result.nodeResults, rootTransform, nodeOptions);
+      loadNode(
+          result.nodeResults,
+          rootTransform,
+          nodeOptions,
+          primitivesToLoad);
     }
   } else if (model.nodes.size() > 0) {
     // No scenes at all, use the first node as the root node.
     CreateNodeOptions nodeOptions = {&options, &result, &model.nodes[0]};
-    loadNode(result.nodeResults, rootTransform, nodeOptions);
+    loadNode(
+        result.nodeResults,
+        rootTransform,
+        nodeOptions,
+        primitivesToLoad);
   } else if (model.meshes.size() > 0) {
     // No nodes either, show all the meshes.
     for (const Mesh& mesh : model.meshes) {
@@ -1891,9 +3406,16 @@ static void loadModelAnyThreadPart(
           &dummyNodeOptions,
           &dummyNodeResult,
           &mesh};
-      loadMesh(dummyNodeResult.meshResult, rootTransform, meshOptions);
+      loadMesh(
+          dummyNodeResult.meshResult,
+          rootTransform,
+          meshOptions,
+          primitivesToLoad);
     }
   }
+
+  loadPrimitives(primitivesToLoad);
+  removeUnloadedPrimitives(result);
 }
 
 bool applyTexture(
@@ -1907,6 +3429,9 @@ bool applyTexture(
     return false;
   }
 
+  // The texture may be shared with other primitives, so it's only destroyed
+  // once every material that uses it has released it.
+  CesiumTextureCache::get().addUse(pTexture, pLoadedTexture->contentKey);
   pMaterial->SetTextureParameterValueByInfo(info, pTexture);
 
   return true;
@@ -1914,93 +3439,118 @@ bool applyTexture(
 
 #pragma region Material Parameter setters
 
-static void SetGltfParameterValues(
-    const CesiumGltf::Model& model,
-    LoadPrimitiveResult& loadResult,
-    const Material& material,
-    const MaterialPBRMetallicRoughness& pbr,
+/**
+ * Sets the glTF material parameters that don't depend on the textures of the
+ * primitive. These are the same for every primitive with the same material
+ * key, so they are set on the template material in CesiumMaterialPool.
+ */
+static void SetGltfFactorParameterValues(
+    const CesiumMaterialKey& key,
     UMaterialInstanceDynamic* pMaterial,
     EMaterialParameterAssociation association,
     int32 index) {
-  for (auto& textureCoordinateSet : loadResult.textureCoordinateParameters) {
+  for (const TPair<FName, uint32>& textureCoordinateSet :
+       key.textureCoordinateIndices) {
     pMaterial->SetScalarParameterValueByInfo(
-        FMaterialParameterInfo(
-            UTF8_TO_TCHAR(textureCoordinateSet.first.c_str()),
-            association,
-            index),
-        static_cast<float>(textureCoordinateSet.second));
+        FMaterialParameterInfo(textureCoordinateSet.Key, association, index),
+        static_cast<float>(textureCoordinateSet.Value));
   }
 
-  if (pbr.baseColorFactor.size() > 3) {
-    pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo("baseColorFactor", association, index),
-        FLinearColor(
-            pbr.baseColorFactor[0],
-            pbr.baseColorFactor[1],
-            pbr.baseColorFactor[2],
-            pbr.baseColorFactor[3]));
-  } else if (pbr.baseColorFactor.size() == 3) {
-    pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo("baseColorFactor", association, index),
-        FLinearColor(
-            pbr.baseColorFactor[0],
-            pbr.baseColorFactor[1],
-            pbr.baseColorFactor[2],
-            1.));
-  } else {
-    pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo("baseColorFactor", association, index),
-        FLinearColor(1., 1., 1., 1.));
-  }
+  pMaterial->SetVectorParameterValueByInfo(
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::BaseColorFactor,
+          association,
+          index),
+      key.baseColorFactor);
   pMaterial->SetScalarParameterValueByInfo(
-      FMaterialParameterInfo("metallicFactor", association, index),
-      static_cast<float>(loadResult.isUnlit ? 0.0f : pbr.metallicFactor));
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::MetallicFactor,
+          association,
+          index),
+      key.metallicFactor);
   pMaterial->SetScalarParameterValueByInfo(
-      FMaterialParameterInfo("roughnessFactor", association, index),
-      static_cast<float>(loadResult.isUnlit ? 1.0f : pbr.roughnessFactor));
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::RoughnessFactor,
+          association,
+          index),
+      key.roughnessFactor);
   pMaterial->SetScalarParameterValueByInfo(
-      FMaterialParameterInfo("opacityMask", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::OpacityMask,
+          association,
+          index),
       1.0f);
 
+  if (key.hasEmissiveFactor) {
+    pMaterial->SetVectorParameterValueByInfo(
+        FMaterialParameterInfo(
+            CesiumMaterialParameterNames::EmissiveFactor,
+            association,
+            index),
+        key.emissiveFactor);
+  }
+}
+
+/**
+ * Sets the glTF textures of the primitive on its material, which already has
+ * the parameters from SetGltfFactorParameterValues.
+ */
+static void SetGltfTextureParameterValues(
+    const CesiumGltf::Model& model,
+    LoadPrimitiveResult& loadResult,
+    UMaterialInstanceDynamic* pMaterial,
+    EMaterialParameterAssociation association,
+    int32 index) {
   applyTexture(
       model,
       pMaterial,
-      FMaterialParameterInfo("baseColorTexture", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::BaseColorTexture,
+          association,
+          index),
       loadResult.baseColorTexture.Get());
   applyTexture(
       model,
       pMaterial,
-      FMaterialParameterInfo("metallicRoughnessTexture", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::MetallicRoughnessTexture,
+          association,
+          index),
       loadResult.metallicRoughnessTexture.Get());
   applyTexture(
       model,
       pMaterial,
-      FMaterialParameterInfo("normalTexture", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::NormalTexture,
+          association,
+          index),
       loadResult.normalTexture.Get());
   bool hasEmissiveTexture = applyTexture(
       model,
       pMaterial,
-      FMaterialParameterInfo("emissiveTexture", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::EmissiveTexture,
+          association,
+          index),
       loadResult.emissiveTexture.Get());
   applyTexture(
       model,
       pMaterial,
-      FMaterialParameterInfo("occlusionTexture", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::OcclusionTexture,
+          association,
+          index),
       loadResult.occlusionTexture.Get());
 
-  if (material.emissiveFactor.size() >= 3) {
-    pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo("emissiveFactor", association, index),
-        FVector(
-            material.emissiveFactor[0],
-            material.emissiveFactor[1],
-            material.emissiveFactor[2]));
-  } else if (hasEmissiveTexture) {
+  if (!loadResult.materialKey.hasEmissiveFactor && hasEmissiveTexture) {
     // When we have an emissive texture but not a factor, we need to use a
     // factor of vec3(1.0). The default, vec3(0.0), would disable the emission
     // from the texture.
     pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo("emissiveFactor", association, index),
+        FMaterialParameterInfo(
+            CesiumMaterialParameterNames::EmissiveFactor,
+            association,
+            index),
         FVector(1.0f, 1.0f, 1.0f));
   }
 }
@@ -2012,22 +3562,34 @@ void SetWaterParameterValues(
     EMaterialParameterAssociation association,
     int32 index) {
   pMaterial->SetScalarParameterValueByInfo(
-      FMaterialParameterInfo("OnlyLand", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::OnlyLand,
+          association,
+          index),
       static_cast<float>(loadResult.onlyLand));
   pMaterial->SetScalarParameterValueByInfo(
-      FMaterialParameterInfo("OnlyWater", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::OnlyWater,
+          association,
+          index),
       static_cast<float>(loadResult.onlyWater));
 
   if (!loadResult.onlyLand && !loadResult.onlyWater) {
     applyTexture(
         model,
         pMaterial,
-        FMaterialParameterInfo("WaterMask", association, index),
+        FMaterialParameterInfo(
+            CesiumMaterialParameterNames::WaterMask,
+            association,
+            index),
         loadResult.waterMaskTexture.Get());
   }
 
   pMaterial->SetVectorParameterValueByInfo(
-      FMaterialParameterInfo("WaterMaskTranslationScale", association, index),
+      FMaterialParameterInfo(
+          CesiumMaterialParameterNames::WaterMaskTranslationScale,
+          association,
+          index),
       FVector(
           loadResult.waterMaskTranslationX,
           loadResult.waterMaskTranslationY,
@@ -2505,126 +4067,29 @@ static void SetMetadataParameterValues_DEPRECATED(
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
 #pragma endregion
 
-static void loadPrimitiveGameThreadPart(
+// Creates the material of a primitive that is drawn, from the tileset's base
+// material and the primitive's glTF material.
+static void createPrimitiveMaterial(
     const CesiumGltf::Model& model,
     UCesiumGltfComponent* pGltf,
     LoadPrimitiveResult& loadResult,
-    const glm::dmat4x4& cesiumToUnrealTransform,
-    const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision,
-    ACesium3DTileset* pTilesetActor) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
-
-  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
-      tile.getContentBoundingVolume().value_or(tile.getBoundingVolume());
+    ACesium3DTileset* pTilesetActor,
+    UCesiumGltfPrimitiveComponent* pMesh) {
+  const CesiumMaterialKey& materialKey = loadResult.materialKey;
 
-  FName meshName = createSafeName(loadResult.name, "");
-  UCesiumGltfPrimitiveComponent* pMesh;
-  if (loadResult.pMeshPrimitive->mode == MeshPrimitive::Mode::POINTS) {
-    UCesiumGltfPointsComponent* pPointMesh =
-        NewObject<UCesiumGltfPointsComponent>(pGltf, meshName);
-    pPointMesh->UsesAdditiveRefinement =
-        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
-    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
-    pPointMesh->Dimensions = loadResult.dimensions;
-    pMesh = pPointMesh;
-  } else {
-    pMesh = NewObject<UCesiumGltfPrimitiveComponent>(pGltf, meshName);
+  UMaterialInterface* pBaseMaterial;
+  switch (materialKey.baseMaterial) {
+  case CesiumMaterialKey::BaseMaterial::Water:
+    pBaseMaterial = pGltf->BaseMaterialWithWater;
+    break;
+  case CesiumMaterialKey::BaseMaterial::Translucent:
+    pBaseMaterial = pGltf->BaseMaterialWithTranslucency;
+    break;
+  default:
+    pBaseMaterial = pGltf->BaseMaterial;
+    break;
   }
 
-  pMesh->pTilesetActor = pTilesetActor;
-  pMesh->overlayTextureCoordinateIDToUVIndex =
-      loadResult.overlayTextureCoordinateIDToUVIndex;
-  pMesh->GltfToUnrealTexCoordMap =
-      std::move(loadResult.GltfToUnrealTexCoordMap);
-  pMesh->TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
-  pMesh->PositionAccessor = std::move(loadResult.PositionAccessor);
-  pMesh->IndexAccessor = std::move(loadResult.IndexAccessor);
-  pMesh->HighPrecisionNodeTransform = loadResult.transform;
-  pMesh->UpdateTransformFromCesium(cesiumToUnrealTransform);
-
-  pMesh->bUseDefaultCollision = false;
-  pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
-  pMesh->SetFlags(
-      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-  pMesh->pModel = loadResult.pModel;
-  pMesh->pMeshPrimitive = loadResult.pMeshPrimitive;
-  pMesh->boundingVolume = boundingVolume;
-  pMesh->SetRenderCustomDepth(pGltf->CustomDepthParameters.RenderCustomDepth);
-  pMesh->SetCustomDepthStencilWriteMask(
-      pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
-  pMesh->SetCustomDepthStencilValue(
-      pGltf->CustomDepthParameters.CustomDepthStencilValue);
-  if (loadResult.isUnlit) {
-    pMesh->bCastDynamicShadow = false;
-  }
-
-  UStaticMesh* pStaticMesh = NewObject<UStaticMesh>(pMesh, meshName);
-  pMesh->SetStaticMesh(pStaticMesh);
-
-  pStaticMesh->SetFlags(
-      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-  pStaticMesh->NeverStream = true;
-
-  pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
-
-  const Material& material =
-      loadResult.pMaterial ? *loadResult.pMaterial : defaultMaterial;
-
-  const MaterialPBRMetallicRoughness& pbr =
-      material.pbrMetallicRoughness ? material.pbrMetallicRoughness.value()
-                                    : defaultPbrMetallicRoughness;
-
-  const FName ImportedSlotName(
-      *(TEXT("CesiumMaterial") + FString::FromInt(nextMaterialId++)));
-
-  const auto is_in_blend_mode = [](auto& result) {
-    return !!result.pMaterial && result.pMaterial->alphaMode ==
-                                     CesiumGltf::Material::AlphaMode::BLEND;
-  };
-
-#if PLATFORM_MAC
-  // TODO: figure out why water material crashes mac
-  UMaterialInterface* pBaseMaterial =
-      (is_in_blend_mode(loadResult) && pbr.baseColorFactor.size() > 3 &&
-       pbr.baseColorFactor[3] < 0.996) // 1. - 1. / 256.
-          ? pGltf->BaseMaterialWithTranslucency
-          : pGltf->BaseMaterial;
-#else
-  UMaterialInterface* pBaseMaterial;
-  if (loadResult.onlyWater || !loadResult.onlyLand) {
-    pBaseMaterial = pGltf->BaseMaterialWithWater;
-  } else {
-    pBaseMaterial =
-        (is_in_blend_mode(loadResult) && pbr.baseColorFactor.size() > 3 &&
-         pbr.baseColorFactor[3] < 0.996) // 1. - 1. / 256.
-            ? pGltf->BaseMaterialWithTranslucency
-            : pGltf->BaseMaterial;
-  }
-#endif
-
-  UMaterialInstanceDynamic* pMaterial = UMaterialInstanceDynamic::Create(
-      pBaseMaterial,
-      nullptr,
-      ImportedSlotName);
-
-  pMaterial->SetFlags(
-      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-  SetGltfParameterValues(
-      model,
-      loadResult,
-      material,
-      pbr,
-      pMaterial,
-      EMaterialParameterAssociation::GlobalParameter,
-      INDEX_NONE);
-  SetWaterParameterValues(
-      model,
-      loadResult,
-      pMaterial,
-      EMaterialParameterAssociation::GlobalParameter,
-      INDEX_NONE);
-
   UMaterialInstance* pBaseAsMaterialInstance =
       Cast<UMaterialInstance>(pBaseMaterial);
   UCesiumMaterialUserData* pCesiumData =
@@ -2655,36 +4120,94 @@ static void loadPrimitiveGameThreadPart(
   }
 #endif
 
+  // The parameters that don't depend on textures are set once on a template
+  // material for each material key, and copied from it to each primitive's
+  // material, rather than being set one at a time for every primitive.
+  const bool hasLayers = pCesiumData != nullptr;
+  CesiumMaterialPool& materialPool = CesiumMaterialPool::get();
+  UMaterialInstanceDynamic* pTemplate =
+      materialPool.findTemplate(pBaseMaterial, materialKey, hasLayers);
+  if (!pTemplate) {
+    pTemplate = UMaterialInstanceDynamic::Create(pBaseMaterial, nullptr);
+    pTemplate->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    SetGltfFactorParameterValues(
+        materialKey,
+        pTemplate,
+        EMaterialParameterAssociation::GlobalParameter,
+        INDEX_NONE);
+    if (hasLayers) {
+      SetGltfFactorParameterValues(
+          materialKey,
+          pTemplate,
+          EMaterialParameterAssociation::LayerParameter,
+          0);
+    }
+    materialPool.addTemplate(pBaseMaterial, materialKey, hasLayers, pTemplate);
+  }
+
+  // Reuse the material of an unloaded primitive if there is one, because
+  // creating a material instance is expensive.
+  UMaterialInstanceDynamic* pMaterial = materialPool.acquire(pBaseMaterial);
+  if (!pMaterial) {
+    const FName ImportedSlotName(
+        *(TEXT("CesiumMaterial") + FString::FromInt(nextMaterialId++)));
+    pMaterial = UMaterialInstanceDynamic::Create(
+        pBaseMaterial,
+        nullptr,
+        ImportedSlotName);
+  }
+
+  pMaterial->SetFlags(
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  pMaterial->CopyParameterOverrides(pTemplate);
+  SetGltfTextureParameterValues(
+      model,
+      loadResult,
+      pMaterial,
+      EMaterialParameterAssociation::GlobalParameter,
+      INDEX_NONE);
+  SetWaterParameterValues(
+      model,
+      loadResult,
+      pMaterial,
+      EMaterialParameterAssociation::GlobalParameter,
+      INDEX_NONE);
+
+  const UCesiumClippingVolumeComponent* pClippingVolumes =
+      pTilesetActor->FindComponentByClass<UCesiumClippingVolumeComponent>();
+  if (pClippingVolumes) {
+    pClippingVolumes->ApplyToMaterial(pMaterial);
+  }
+
   if (pCesiumData) {
-    SetGltfParameterValues(
+    SetGltfTextureParameterValues(
         model,
         loadResult,
-        material,
-        pbr,
         pMaterial,
         EMaterialParameterAssociation::LayerParameter,
         0);
 
     // Initialize fade uniform to fully visible, in case LOD transitions
     // are off.
-    int fadeLayerIndex = pCesiumData->LayerNames.Find("DitherFade");
+    int32 fadeLayerIndex = pCesiumData->DitherFadeLayerIndex;
     if (fadeLayerIndex >= 0) {
       pMaterial->SetScalarParameterValueByInfo(
           FMaterialParameterInfo(
-              "FadePercentage",
+              CesiumMaterialParameterNames::FadePercentage,
               EMaterialParameterAssociation::LayerParameter,
               fadeLayerIndex),
           1.0f);
       pMaterial->SetScalarParameterValueByInfo(
           FMaterialParameterInfo(
-              "FadingType",
+              CesiumMaterialParameterNames::FadingType,
               EMaterialParameterAssociation::LayerParameter,
               fadeLayerIndex),
           0.0f);
     }
 
     // If there's a "Water" layer, set its parameters
-    int32 waterIndex = pCesiumData->LayerNames.Find("Water");
+    int32 waterIndex = pCesiumData->WaterLayerIndex;
     if (waterIndex >= 0) {
       SetWaterParameterValues(
           model,
@@ -2694,9 +4217,8 @@ static void loadPrimitiveGameThreadPart(
           waterIndex);
     }
 
-    int32 featuresMetadataIndex =
-        pCesiumData->LayerNames.Find("FeaturesMetadata");
-    int32 metadataIndex = pCesiumData->LayerNames.Find("Metadata");
+    int32 featuresMetadataIndex = pCesiumData->FeaturesMetadataLayerIndex;
+    int32 metadataIndex = pCesiumData->MetadataLayerIndex;
     if (featuresMetadataIndex >= 0) {
       SetFeaturesMetadataParameterValues(
           model,
@@ -2705,6 +4227,22 @@ static void loadPrimitiveGameThreadPart(
           pMaterial,
           EMaterialParameterAssociation::LayerParameter,
           featuresMetadataIndex);
+      pMaterial->SetTextureParameterValueByInfo(
+          FMaterialParameterInfo(
+              CesiumMaterialParameterNames::FeatureStyle,
+              EMaterialParameterAssociation::LayerParameter,
+              featuresMetadataIndex),
+          pTilesetActor->GetFeatureStyleTexture());
+      for (const auto& selection :
+           pTilesetActor->GetFeatureSelectionTextures()) {
+        pMaterial->SetTextureParameterValueByInfo(
+            FMaterialParameterInfo(
+                FName(CesiumEncodedFeaturesMetadata::
+                          getMaterialNameForFeatureSelection(selection.Key)),
+                EMaterialParameterAssociation::LayerParameter,
+                featuresMetadataIndex),
+            selection.Value);
+      }
     } else if (metadataIndex >= 0) {
       // Set parameters for materials generated by the old implementation
       SetMetadataParameterValues_DEPRECATED(
@@ -2717,6 +4255,164 @@ static void loadPrimitiveGameThreadPart(
     }
   }
 
+  pMaterial->TwoSided = true;
+
+  UStaticMesh* pStaticMesh = pMesh->GetStaticMesh();
+  if (pStaticMesh) {
+    pStaticMesh->AddMaterial(pMaterial);
+  } else {
+    pMesh->SetMaterial(0, pMaterial);
+  }
+}
+
+static void loadPrimitiveGameThreadPart(
+    const CesiumGltf::Model& model,
+    UCesiumGltfComponent* pGltf,
+    LoadPrimitiveResult& loadResult,
+    const glm::dmat4x4& cesiumToUnrealTransform,
+    const Cesium3DTilesSelection::Tile& tile,
+    bool createNavCollision,
+    ACesium3DTileset* pTilesetActor,
+    const TArray<FTransform>& instanceTransforms) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
+
+  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
+      tile.getContentBoundingVolume().value_or(tile.getBoundingVolume());
+
+  // The tile is refined before its textures need their most detailed mips,
+  // so those aren't uploaded unless they're requested later.
+  if (pTilesetActor->GetSkipUnneededTextureMips() &&
+      pTilesetActor->GetTileset()) {
+    const double maximumScreenPixels =
+        CesiumTextureStreaming::computeMaximumScreenPixels(
+            tile,
+            pTilesetActor->GetTileset()->getOptions().maximumScreenSpaceError);
+    for (CesiumTextureUtility::LoadedTextureResult* pTexture :
+         {loadResult.baseColorTexture.Get(),
+          loadResult.metallicRoughnessTexture.Get(),
+          loadResult.normalTexture.Get(),
+          loadResult.emissiveTexture.Get(),
+          loadResult.occlusionTexture.Get()}) {
+      if (pTexture) {
+        pTexture->maximumScreenPixels = maximumScreenPixels;
+      }
+    }
+  }
+
+  // Components are taken from the tileset's pool, so they may have been used
+  // by another primitive before. Everything that isn't reset by
+  // UCesiumGltfPrimitiveComponent::PrepareForReuse must be set here.
+  CesiumPrimitiveComponentPool& componentPool =
+      pTilesetActor->GetPrimitiveComponentPool();
+
+  FName meshName = createSafeName(loadResult.name, "");
+  UCesiumGltfPrimitiveComponent* pMesh;
+  if (loadResult.pMeshPrimitive->mode == MeshPrimitive::Mode::POINTS) {
+    UCesiumGltfPointsComponent* pPointMesh =
+        componentPool.acquire<UCesiumGltfPointsComponent>(pGltf, meshName);
+    pPointMesh->UsesAdditiveRefinement =
+        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
+    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
+    pPointMesh->Dimensions = loadResult.dimensions;
+    pPointMesh->QuantizedPoints = std::move(loadResult.QuantizedPoints);
+    if (pPointMesh->QuantizedPoints) {
+      BeginInitResource(pPointMesh->QuantizedPoints.Get());
+    }
+    pMesh = pPointMesh;
+  } else {
+    pMesh =
+        componentPool.acquire<UCesiumGltfPrimitiveComponent>(pGltf, meshName);
+    pMesh->PulledAttributes = std::move(loadResult.PulledAttributes);
+    if (pMesh->PulledAttributes) {
+      BeginInitResource(pMesh->PulledAttributes.Get());
+    }
+  }
+
+  pMesh->pTilesetActor = pTilesetActor;
+  pMesh->overlayTextureCoordinateIDToUVIndex =
+      loadResult.overlayTextureCoordinateIDToUVIndex;
+  pMesh->GltfToUnrealTexCoordMap =
+      std::move(loadResult.GltfToUnrealTexCoordMap);
+  pMesh->TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
+  pMesh->PositionAccessor = std::move(loadResult.PositionAccessor);
+  pMesh->IndexAccessor = std::move(loadResult.IndexAccessor);
+  pMesh->HighPrecisionNodeTransform = loadResult.transform;
+  pMesh->UpdateTransformFromCesium(cesiumToUnrealTransform);
+
+  pMesh->bUseDefaultCollision = false;
+  pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
+  pMesh->SetFlags(
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  pMesh->pModel = loadResult.pModel;
+  pMesh->pMeshPrimitive = loadResult.pMeshPrimitive;
+  pMesh->boundingVolume = boundingVolume;
+  const FCustomDepthParameters customDepthParameters =
+      pMesh->IsA<UCesiumGltfPointsComponent>()
+          ? pTilesetActor->GetPointCustomDepthParameters()
+          : pGltf->CustomDepthParameters;
+  pMesh->SetRenderCustomDepth(customDepthParameters.RenderCustomDepth);
+  pMesh->SetCustomDepthStencilWriteMask(
+      customDepthParameters.CustomDepthStencilWriteMask);
+  pMesh->SetCustomDepthStencilValue(
+      customDepthParameters.CustomDepthStencilValue);
+  pMesh->RuntimeVirtualTextures.Append(
+      pTilesetActor->GetRuntimeVirtualTextures());
+  pMesh->VirtualTextureRenderPassType =
+      pTilesetActor->GetVirtualTextureRenderPassType();
+  if (loadResult.isUnlit) {
+    pMesh->bCastDynamicShadow = false;
+  }
+  pMesh->ShadowCacheInvalidationBehavior =
+      pTilesetActor->GetTileShadowCacheInvalidationBehavior();
+
+  // With lightweight primitives, the component owns the render data and
+  // draws it itself, so that no static mesh is created for the primitive.
+  // Instances, Nanite meshes, and navigation collision that isn't exported by
+  // the component still need a static mesh, as do collision-only primitives,
+  // whose empty render data is never initialized.
+  const bool hasNanite =
+      loadResult.RenderData->NaniteResources.PageStreamingStates.Num() > 0;
+  const bool useStaticMesh =
+      !pTilesetActor->GetUseLightweightPrimitives() ||
+      !instanceTransforms.IsEmpty() || loadResult.collisionOnly || hasNanite ||
+      (createNavCollision && !loadResult.NavigationGeometry);
+
+  UStaticMesh* pStaticMesh = nullptr;
+  if (useStaticMesh) {
+    pStaticMesh = NewObject<UStaticMesh>(pMesh, meshName);
+    pMesh->SetStaticMesh(pStaticMesh);
+
+    pStaticMesh->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    pStaticMesh->NeverStream = true;
+
+    pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
+
+    // The tileset creates the ray tracing geometry of nearby primitives
+    // later, a few at a time, so their acceleration structures aren't all
+    // built at once.
+    if (pTilesetActor->GetLimitRayTracingGeometryBuilds()) {
+      pStaticMesh->bSupportRayTracing = false;
+    }
+  } else {
+    loadResult.RenderData->ScreenSize[0].Default = 1.0f;
+    pMesh->SetOwnedRenderData(
+        std::move(loadResult.RenderData),
+        pTilesetActor->GetRenderDataBatch());
+  }
+
+  // Collision-only primitives are never drawn, so they have no material and
+  // their empty render data isn't initialized. It only provides their bounds,
+  // and a static mesh without vertices has no scene proxy.
+  if (!loadResult.collisionOnly) {
+    createPrimitiveMaterial(
+        model,
+        pGltf,
+        loadResult,
+        pTilesetActor,
+        pMesh);
+  }
+
   pMesh->Features = std::move(loadResult.Features);
   pMesh->Metadata = std::move(loadResult.Metadata);
 
@@ -2740,20 +4436,37 @@ static void loadPrimitiveGameThreadPart(
 
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
-  pMaterial->TwoSided = true;
-
-  pStaticMesh->AddMaterial(pMaterial);
-
-  pStaticMesh->SetLightingGuid();
-  pStaticMesh->InitResources();
-
-  // Set up RenderData bounds and LOD data
-  pStaticMesh->CalculateExtendedBounds();
-  pStaticMesh->GetRenderData()->ScreenSize[0].Default = 1.0f;
+  if (pStaticMesh) {
+    if (!loadResult.collisionOnly) {
+      pStaticMesh->SetLightingGuid();
+      pStaticMesh->InitResources();
+    }
 
-  pStaticMesh->CreateBodySetup();
+    // Set up RenderData bounds and LOD data
+    pStaticMesh->CalculateExtendedBounds();
+    pStaticMesh->GetRenderData()->ScreenSize[0].Default = 1.0f;
+
+    pStaticMesh->CreateBodySetup();
+  } else if (!pMesh->OwnedBodySetup) {
+    // A pooled component keeps its body setup, so this is only created once
+    // per component, the same way UStaticMesh::CreateBodySetup does.
+    pMesh->OwnedBodySetup = NewObject<UBodySetup>(pMesh);
+    pMesh->OwnedBodySetup->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    pMesh->OwnedBodySetup->DefaultInstance.SetCollisionProfileName(
+        UCollisionProfile::BlockAll_ProfileName);
+  }
 
-  if (createNavCollision) {
+  // The component exports the navigation geometry gathered while the
+  // primitive was loaded. Only instances, which have their own component,
+  // still need the static mesh's navigation collision.
+  pMesh->NavigationGeometry = std::move(loadResult.NavigationGeometry);
+  if (instanceTransforms.IsEmpty()) {
+    pMesh->HeightQueryBvh = std::move(loadResult.HeightQueryBvh);
+    pMesh->BakingGeometry = std::move(loadResult.BakingGeometry);
+  }
+  if (pStaticMesh && createNavCollision &&
+      (!pMesh->NavigationGeometry || !instanceTransforms.IsEmpty())) {
     pStaticMesh->CreateNavCollision(true);
   }
 
@@ -2775,8 +4488,19 @@ static void loadPrimitiveGameThreadPart(
 
   pMesh->SetMobility(pGltf->Mobility);
 
+  // Tiles are created without collision, which is enabled when they're
+  // shown, so don't create a physics state while registering only to
+  // destroy it again.
+  pMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
   pMesh->SetupAttachment(pGltf);
   pMesh->RegisterComponent();
+
+  // Points have their own scene proxy, so they are not instanced.
+  if (!instanceTransforms.IsEmpty() &&
+      !pMesh->IsA<UCesiumGltfPointsComponent>()) {
+    pMesh->CreateInstances(instanceTransforms);
+  }
 }
 
 /*static*/ TUniquePtr<UCesiumGltfComponent::HalfConstructed>
@@ -2817,6 +4541,7 @@ UCesiumGltfComponent::CreateOffGameThread(
   Gltf->SetFlags(RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
 
   Gltf->Metadata = std::move(pReal->loadModelResult.Metadata);
+  Gltf->Metadata.setModel(model);
   Gltf->EncodedMetadata = std::move(pReal->loadModelResult.EncodedMetadata);
   Gltf->EncodedMetadata_DEPRECATED =
       std::move(pReal->loadModelResult.EncodedMetadata_DEPRECATED);
@@ -2851,7 +4576,8 @@ UCesiumGltfComponent::CreateOffGameThread(
             cesiumToUnrealTransform,
             tile,
             createNavCollision,
-            pTilesetActor);
+            pTilesetActor,
+            node.instanceTransforms);
       }
     }
   }
@@ -2897,6 +4623,7 @@ UCesiumGltfComponent::~UCesiumGltfComponent() {
 
 void UCesiumGltfComponent::UpdateTransformFromCesium(
     const glm::dmat4& cesiumToUnrealTransform) {
+  this->_pendingCesiumToUnrealTransform.reset();
   for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
         Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
@@ -2906,6 +4633,24 @@ void UCesiumGltfComponent::UpdateTransformFromCesium(
   }
 }
 
+void UCesiumGltfComponent::UpdateTransformFromCesiumWhenNeeded(
+    const glm::dmat4& cesiumToUnrealTransform) {
+  if (this->IsVisible() ||
+      this->_collisionEnabled != ECollisionEnabled::NoCollision) {
+    this->UpdateTransformFromCesium(cesiumToUnrealTransform);
+  } else {
+    this->_pendingCesiumToUnrealTransform = cesiumToUnrealTransform;
+  }
+}
+
+void UCesiumGltfComponent::_applyPendingTransformFromCesium() {
+  if (this->_pendingCesiumToUnrealTransform) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyPendingTransform)
+    const glm::dmat4 transform = *this->_pendingCesiumToUnrealTransform;
+    this->UpdateTransformFromCesium(transform);
+  }
+}
+
 namespace {
 
 template <typename Func>
@@ -2939,122 +4684,612 @@ void forEachPrimitiveComponent(UCesiumGltfComponent* pGltf, Func&& f) {
   }
 } // namespace
 
+// Finds the parameter of a new material that corresponds to a parameter of
+// an old one, matching the parameters of material layers by the layer names.
+// The glTF parameters are always on the first layer.
+bool findMatchingParameter(
+    const FMaterialParameterInfo& oldInfo,
+    const UCesiumMaterialUserData* pOldCesiumData,
+    const UCesiumMaterialUserData* pNewCesiumData,
+    FMaterialParameterInfo& newInfo) {
+  newInfo = oldInfo;
+  if (oldInfo.Association == EMaterialParameterAssociation::GlobalParameter) {
+    return true;
+  }
+
+  if (!pOldCesiumData || !pNewCesiumData) {
+    return false;
+  }
+
+  if (oldInfo.Index == 0) {
+    return true;
+  }
+
+  if (!pOldCesiumData->LayerNames.IsValidIndex(oldInfo.Index)) {
+    return false;
+  }
+
+  const FString& layerName = pOldCesiumData->LayerNames[oldInfo.Index];
+  newInfo.Index = pNewCesiumData->LayerNames.Find(layerName);
+  return newInfo.Index != INDEX_NONE;
+}
+
+void copyMaterialParameterValues(
+    const UMaterialInstanceDynamic* pOldMaterial,
+    const UCesiumMaterialUserData* pOldCesiumData,
+    UMaterialInstanceDynamic* pNewMaterial,
+    const UCesiumMaterialUserData* pNewCesiumData) {
+  FMaterialParameterInfo info;
+  for (const FScalarParameterValue& value :
+       pOldMaterial->ScalarParameterValues) {
+    if (findMatchingParameter(
+            value.ParameterInfo,
+            pOldCesiumData,
+            pNewCesiumData,
+            info)) {
+      pNewMaterial->SetScalarParameterValueByInfo(info, value.ParameterValue);
+    }
+  }
+
+  for (const FVectorParameterValue& value :
+       pOldMaterial->VectorParameterValues) {
+    if (findMatchingParameter(
+            value.ParameterInfo,
+            pOldCesiumData,
+            pNewCesiumData,
+            info)) {
+      pNewMaterial->SetVectorParameterValueByInfo(info, value.ParameterValue);
+    }
+  }
+
+  for (const FTextureParameterValue& value :
+       pOldMaterial->TextureParameterValues) {
+    if (findMatchingParameter(
+            value.ParameterInfo,
+            pOldCesiumData,
+            pNewCesiumData,
+            info)) {
+      pNewMaterial->SetTextureParameterValueByInfo(info, value.ParameterValue);
+    }
+  }
+}
+
 } // namespace
 
-void UCesiumGltfComponent::AttachRasterTile(
+bool UCesiumGltfComponent::AttachRasterTile(
     const Cesium3DTilesSelection::Tile& tile,
     const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
     UTexture2D* pTexture,
     const glm::dvec2& translation,
     const glm::dvec2& scale,
     int32 textureCoordinateID) {
+  const bool first = this->_pendingRasterTiles.IsEmpty();
+
+  const ACesium3DTileset* pTileset = Cast<ACesium3DTileset>(this->GetOwner());
+  std::optional<CesiumOverlayTextureCoordinates::TileProjection> projection;
+  if (pTileset && pTileset->GetComputeOverlayTextureCoordinatesInMaterial()) {
+    projection = CesiumOverlayTextureCoordinates::getTileProjection(
+        tile,
+        textureCoordinateID);
+  }
 
-  FVector4 translationAndScale(translation.x, translation.y, scale.x, scale.y);
+  FString name(UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
+  this->_pendingRasterTiles.Add(
+      name,
+      PendingRasterTile{
+          pTexture,
+          FVector4(translation.x, translation.y, scale.x, scale.y),
+          textureCoordinateID,
+          projection});
+
+  return first;
+}
+
+bool UCesiumGltfComponent::DetachRasterTile(
+    const Cesium3DTilesSelection::Tile& tile,
+    const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+    UTexture2D* pTexture) {
+  const bool first = this->_pendingRasterTiles.IsEmpty();
+
+  // Detaching only clears the texture, so the other parameters don't matter.
+  FString name(UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
+  this->_pendingRasterTiles.Add(
+      name,
+      PendingRasterTile{
+          nullptr,
+          FVector4(0.0, 0.0, 1.0, 1.0),
+          0,
+          std::nullopt});
+
+  return first;
+}
+
+void UCesiumGltfComponent::ApplyPendingRasterTiles() {
+  // When a tile's own overlay tile hasn't loaded yet, cesium-native attaches
+  // the texture of its closest ancestor that has one, scaled to the tile's
+  // part of it. Only changes that differ from what the materials already
+  // show need to be applied.
+  for (auto it = this->_pendingRasterTiles.CreateIterator(); it; ++it) {
+    const PendingRasterTile* pApplied =
+        this->_appliedRasterTiles.Find(it->Key);
+    if (pApplied ? *pApplied == it->Value : it->Value.pTexture == nullptr) {
+      it.RemoveCurrent();
+    } else {
+      this->_appliedRasterTiles.Add(it->Key, it->Value);
+    }
+  }
+
+  if (this->_pendingRasterTiles.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyPendingRasterTiles)
 
   forEachPrimitiveComponent(
       this,
-      [&rasterTile, pTexture, &translationAndScale, textureCoordinateID](
+      [this](
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
-        // If this material uses material layers and has the Cesium user data,
-        // set the parameters on each material layer that maps to this overlay
-        // tile.
-        if (pCesiumData) {
-          FString name(
-              UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
-
-          for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
-            if (pCesiumData->LayerNames[i] != name) {
+        for (const TPair<FString, PendingRasterTile>& pending :
+             this->_pendingRasterTiles) {
+          const FString& name = pending.Key;
+          const PendingRasterTile& rasterTile = pending.Value;
+          const bool attach = rasterTile.pTexture != nullptr;
+          UTexture2D* pTexture =
+              attach ? rasterTile.pTexture : this->Transparent1x1;
+          const float textureCoordinateIndex =
+              attach ? static_cast<float>(
+                           pPrimitive->overlayTextureCoordinateIDToUVIndex
+                               [rasterTile.textureCoordinateID])
+                     : 0.0f;
+
+          // The material computes the texture coordinates itself, from these
+          // parameters, when they aren't in the primitive's vertices.
+          std::optional<CesiumOverlayTextureCoordinates::MaterialParameters>
+              overlayParameters;
+          if (attach && rasterTile.projection) {
+            overlayParameters =
+                CesiumOverlayTextureCoordinates::computeMaterialParameters(
+                    pPrimitive->HighPrecisionNodeTransform,
+                    *rasterTile.projection);
+          }
+          struct OverlayVector {
+            FName layerParameterName;
+            const char* parameterNameSuffix;
+            FVector4 value;
+          };
+          TArray<OverlayVector, TInlineAllocator<6>> overlayVectors;
+          if (overlayParameters) {
+            overlayVectors = {
+                {CesiumMaterialParameterNames::OverlayOrigin,
+                 "_OverlayOrigin",
+                 overlayParameters->origin},
+                {CesiumMaterialParameterNames::OverlayLocalToEcefX,
+                 "_OverlayLocalToEcefX",
+                 overlayParameters->localToEcefRows[0]},
+                {CesiumMaterialParameterNames::OverlayLocalToEcefY,
+                 "_OverlayLocalToEcefY",
+                 overlayParameters->localToEcefRows[1]},
+                {CesiumMaterialParameterNames::OverlayLocalToEcefZ,
+                 "_OverlayLocalToEcefZ",
+                 overlayParameters->localToEcefRows[2]},
+                {CesiumMaterialParameterNames::OverlayEllipsoid,
+                 "_OverlayEllipsoid",
+                 overlayParameters->ellipsoid},
+                {CesiumMaterialParameterNames::OverlayProjection,
+                 "_OverlayProjection",
+                 overlayParameters->projection}};
+          }
+
+          // If this material uses material layers and has the Cesium user
+          // data, set the parameters on each material layer that maps to this
+          // overlay.
+          if (pCesiumData) {
+            for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
+              if (pCesiumData->LayerNames[i] != name) {
+                continue;
+              }
+
+              pMaterial->SetTextureParameterValueByInfo(
+                  FMaterialParameterInfo(
+                      CesiumMaterialParameterNames::Texture,
+                      EMaterialParameterAssociation::LayerParameter,
+                      i),
+                  pTexture);
+              if (!attach) {
+                continue;
+              }
+
+              pMaterial->SetVectorParameterValueByInfo(
+                  FMaterialParameterInfo(
+                      CesiumMaterialParameterNames::TranslationScale,
+                      EMaterialParameterAssociation::LayerParameter,
+                      i),
+                  rasterTile.translationAndScale);
+              pMaterial->SetScalarParameterValueByInfo(
+                  FMaterialParameterInfo(
+                      CesiumMaterialParameterNames::TextureCoordinateIndex,
+                      EMaterialParameterAssociation::LayerParameter,
+                      i),
+                  textureCoordinateIndex);
+              for (const OverlayVector& vector : overlayVectors) {
+                pMaterial->SetVectorParameterValueByInfo(
+                    FMaterialParameterInfo(
+                        vector.layerParameterName,
+                        EMaterialParameterAssociation::LayerParameter,
+                        i),
+                    vector.value);
+              }
+            }
+          } else {
+            const std::string overlayName = TCHAR_TO_UTF8(*name);
+            pMaterial->SetTextureParameterValue(
+                createSafeName(overlayName, "_Texture"),
+                pTexture);
+            if (!attach) {
               continue;
             }
 
-            pMaterial->SetTextureParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "Texture",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                pTexture);
-            pMaterial->SetVectorParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TranslationScale",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                translationAndScale);
-            pMaterial->SetScalarParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TextureCoordinateIndex",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                static_cast<float>(
-                    pPrimitive->overlayTextureCoordinateIDToUVIndex
-                        [textureCoordinateID]));
+            pMaterial->SetVectorParameterValue(
+                createSafeName(overlayName, "_TranslationScale"),
+                rasterTile.translationAndScale);
+            pMaterial->SetScalarParameterValue(
+                createSafeName(overlayName, "_TextureCoordinateIndex"),
+                textureCoordinateIndex);
+            for (const OverlayVector& vector : overlayVectors) {
+              pMaterial->SetVectorParameterValue(
+                  createSafeName(overlayName, vector.parameterNameSuffix),
+                  vector.value);
+            }
           }
+        }
+      });
+
+  this->_pendingRasterTiles.Reset();
+}
+
+void UCesiumGltfComponent::UpdateBaseMaterials(
+    UMaterialInterface* pBaseMaterial,
+    UMaterialInterface* pBaseTranslucentMaterial,
+    UMaterialInterface* pBaseWaterMaterial) {
+  const UCesiumGltfComponent* pDefaults = GetDefault<UCesiumGltfComponent>();
+  if (!pBaseMaterial) {
+    pBaseMaterial = pDefaults->BaseMaterial;
+  }
+  if (!pBaseTranslucentMaterial) {
+    pBaseTranslucentMaterial = pDefaults->BaseMaterialWithTranslucency;
+  }
+  if (!pBaseWaterMaterial) {
+    pBaseWaterMaterial = pDefaults->BaseMaterialWithWater;
+  }
+
+  if (pBaseMaterial == this->BaseMaterial &&
+      pBaseTranslucentMaterial == this->BaseMaterialWithTranslucency &&
+      pBaseWaterMaterial == this->BaseMaterialWithWater) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateBaseMaterials)
+
+  auto findNewBaseMaterial =
+      [this, pBaseMaterial, pBaseTranslucentMaterial, pBaseWaterMaterial](
+          const UMaterialInterface* pOldBaseMaterial) -> UMaterialInterface* {
+    if (pOldBaseMaterial == this->BaseMaterial) {
+      return pBaseMaterial;
+    }
+    if (pOldBaseMaterial == this->BaseMaterialWithTranslucency) {
+      return pBaseTranslucentMaterial;
+    }
+    if (pOldBaseMaterial == this->BaseMaterialWithWater) {
+      return pBaseWaterMaterial;
+    }
+    return nullptr;
+  };
+
+  CesiumMaterialPool& materialPool = CesiumMaterialPool::get();
+  forEachPrimitiveComponent(
+      this,
+      [this, &findNewBaseMaterial, &materialPool](
+          UCesiumGltfPrimitiveComponent* pPrimitive,
+          UMaterialInstanceDynamic* pOldMaterial,
+          UCesiumMaterialUserData* pOldCesiumData) {
+        UMaterialInterface* pNewBaseMaterial =
+            findNewBaseMaterial(pOldMaterial->Parent);
+        UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+        if (!pNewBaseMaterial || pNewBaseMaterial == pOldMaterial->Parent ||
+            pPrimitive->GetNumMaterials() == 0) {
+          return;
+        }
+
+        UMaterialInstance* pNewBaseAsMaterialInstance =
+            Cast<UMaterialInstance>(pNewBaseMaterial);
+        const UCesiumMaterialUserData* pNewCesiumData =
+            pNewBaseAsMaterialInstance
+                ? pNewBaseAsMaterialInstance
+                      ->GetAssetUserData<UCesiumMaterialUserData>()
+                : nullptr;
+
+        UMaterialInstanceDynamic* pNewMaterial =
+            materialPool.acquire(pNewBaseMaterial);
+        if (!pNewMaterial) {
+          const FName ImportedSlotName(
+              *(TEXT("CesiumMaterial") + FString::FromInt(nextMaterialId++)));
+          pNewMaterial = UMaterialInstanceDynamic::Create(
+              pNewBaseMaterial,
+              nullptr,
+              ImportedSlotName);
+        }
+
+        pNewMaterial->SetFlags(
+            RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+        copyMaterialParameterValues(
+            pOldMaterial,
+            pOldCesiumData,
+            pNewMaterial,
+            pNewCesiumData);
+
+        // The fade isn't copied if the old base material had no layer for it.
+        const int32 fadeLayerIndex =
+            pNewCesiumData ? pNewCesiumData->DitherFadeLayerIndex : INDEX_NONE;
+        if (fadeLayerIndex >= 0 && !this->_fadeUsesCustomPrimitiveData) {
+          pNewMaterial->SetScalarParameterValueByInfo(
+              FMaterialParameterInfo(
+                  CesiumMaterialParameterNames::FadePercentage,
+                  EMaterialParameterAssociation::LayerParameter,
+                  fadeLayerIndex),
+              this->_fadePercentage);
+          pNewMaterial->SetScalarParameterValueByInfo(
+              FMaterialParameterInfo(
+                  CesiumMaterialParameterNames::FadingType,
+                  EMaterialParameterAssociation::LayerParameter,
+                  fadeLayerIndex),
+              this->_fadingIn ? 0.0f : 1.0f);
+        }
+
+        pNewMaterial->TwoSided = true;
+
+        // The primitive and its instances both draw the static mesh's
+        // material. Lightweight primitives have no static mesh, and draw
+        // their override material instead.
+        if (pStaticMesh) {
+          pStaticMesh->GetStaticMaterials()[0].MaterialInterface =
+              pNewMaterial;
         } else {
-          pMaterial->SetTextureParameterValue(
-              createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
-              pTexture);
-          pMaterial->SetVectorParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TranslationScale"),
-              translationAndScale);
-          pMaterial->SetScalarParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TextureCoordinateIndex"),
-              static_cast<float>(pPrimitive->overlayTextureCoordinateIDToUVIndex
-                                     [textureCoordinateID]));
+          pPrimitive->SetMaterial(0, pNewMaterial);
+        }
+        pPrimitive->MarkRenderStateDirty();
+        if (pPrimitive->InstancesComponent) {
+          pPrimitive->InstancesComponent->MarkRenderStateDirty();
         }
+
+        // The textures are now used by the new material, so they're not
+        // destroyed with the old one.
+        materialPool.release(pOldMaterial);
       });
+
+  this->BaseMaterial = pBaseMaterial;
+  this->BaseMaterialWithTranslucency = pBaseTranslucentMaterial;
+  this->BaseMaterialWithWater = pBaseWaterMaterial;
+
+  // The new base materials may have their overlay layers in a different
+  // order, so every overlay is applied to them again.
+  for (const TPair<FString, PendingRasterTile>& applied :
+       this->_appliedRasterTiles) {
+    if (!this->_pendingRasterTiles.Contains(applied.Key)) {
+      this->_pendingRasterTiles.Add(applied.Key, applied.Value);
+    }
+  }
+  this->_appliedRasterTiles.Reset();
+  this->ApplyPendingRasterTiles();
 }
 
-void UCesiumGltfComponent::DetachRasterTile(
-    const Cesium3DTilesSelection::Tile& tile,
-    const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
-    UTexture2D* pTexture) {
+void UCesiumGltfComponent::UpdateCustomDepthParameters(
+    const FCustomDepthParameters& Parameters,
+    const FCustomDepthParameters& PointParameters) {
+  this->CustomDepthParameters = Parameters;
+
+  for (USceneComponent* pChild : this->GetAttachChildren()) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+    if (!pPrimitive) {
+      continue;
+    }
+
+    if (pPrimitive->IsA<UCesiumGltfPointsComponent>()) {
+      pPrimitive->SetRenderCustomDepth(PointParameters.RenderCustomDepth);
+      pPrimitive->SetCustomDepthStencilWriteMask(
+          PointParameters.CustomDepthStencilWriteMask);
+      pPrimitive->SetCustomDepthStencilValue(
+          PointParameters.CustomDepthStencilValue);
+      continue;
+    }
+
+    pPrimitive->SetRenderCustomDepth(Parameters.RenderCustomDepth);
+    pPrimitive->SetCustomDepthStencilWriteMask(
+        Parameters.CustomDepthStencilWriteMask);
+    pPrimitive->SetCustomDepthStencilValue(Parameters.CustomDepthStencilValue);
+
+    if (pPrimitive->InstancesComponent) {
+      UInstancedStaticMeshComponent* pInstances =
+          pPrimitive->InstancesComponent;
+      pInstances->SetRenderCustomDepth(Parameters.RenderCustomDepth);
+      pInstances->SetCustomDepthStencilWriteMask(
+          Parameters.CustomDepthStencilWriteMask);
+      pInstances->SetCustomDepthStencilValue(
+          Parameters.CustomDepthStencilValue);
+    }
+  }
+}
+
+void UCesiumGltfComponent::UpdatePropertyTables(
+    const FCesiumModelMetadataDescription& MetadataDescription) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdatePropertyTables)
+
+  TArray<CesiumEncodedFeaturesMetadata::EncodedPropertyTable> propertyTables =
+      CesiumEncodedFeaturesMetadata::encodePropertyTablesAnyThreadPart(
+          MetadataDescription,
+          this->Metadata);
+  for (CesiumEncodedFeaturesMetadata::EncodedPropertyTable& propertyTable :
+       propertyTables) {
+    CesiumEncodedFeaturesMetadata::encodePropertyTableGameThreadPart(
+        propertyTable);
+  }
 
   forEachPrimitiveComponent(
       this,
-      [this, &rasterTile, pTexture](
+      [this, &propertyTables](
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
-        // If this material uses material layers and has the Cesium user data,
-        // clear the parameters on each material layer that maps to this
-        // overlay tile.
-        if (pCesiumData) {
-          FString name(
-              UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
-          for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
-            if (pCesiumData->LayerNames[i] != name) {
-              continue;
-            }
+        const int32 featuresMetadataIndex =
+            pCesiumData ? pCesiumData->FeaturesMetadataLayerIndex : INDEX_NONE;
+        if (featuresMetadataIndex < 0) {
+          return;
+        }
 
-            pMaterial->SetTextureParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "Texture",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                this->Transparent1x1);
+        // The old textures are destroyed below, so properties that are no
+        // longer encoded are given the defaults of the base material.
+        for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+                 propertyTable : this->EncodedMetadata.propertyTables) {
+          for (const CesiumEncodedFeaturesMetadata::
+                   EncodedPropertyTableProperty& encodedProperty :
+               propertyTable.properties) {
+            const FMaterialParameterInfo info(
+                FName(CesiumEncodedFeaturesMetadata::
+                          getMaterialNameForPropertyTableProperty(
+                              propertyTable.name,
+                              encodedProperty.name)),
+                EMaterialParameterAssociation::LayerParameter,
+                featuresMetadataIndex);
+            UTexture* pDefaultTexture = nullptr;
+            pMaterial->Parent->GetTextureParameterValue(info, pDefaultTexture);
+            pMaterial->SetTextureParameterValueByInfo(info, pDefaultTexture);
           }
-        } else {
-          pMaterial->SetTextureParameterValue(
-              createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
-              this->Transparent1x1);
         }
+
+        for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+                 propertyTable : propertyTables) {
+          SetPropertyTableParameterValues(
+              propertyTable,
+              pMaterial,
+              EMaterialParameterAssociation::LayerParameter,
+              featuresMetadataIndex);
+        }
+      });
+
+  // Textures that are still used are shared with the new encoding, so they
+  // aren't destroyed here.
+  CesiumEncodedFeaturesMetadata::destroyEncodedPropertyTables(
+      this->EncodedMetadata.propertyTables);
+  this->EncodedMetadata.propertyTables = MoveTemp(propertyTables);
+}
+
+void UCesiumGltfComponent::UpdateFeatureSelection(
+    const FString& PropertyTableName,
+    UTexture2D* pTexture) {
+  const FName parameterName(
+      CesiumEncodedFeaturesMetadata::getMaterialNameForFeatureSelection(
+          PropertyTableName));
+
+  forEachPrimitiveComponent(
+      this,
+      [&parameterName, pTexture](
+          UCesiumGltfPrimitiveComponent* pPrimitive,
+          UMaterialInstanceDynamic* pMaterial,
+          UCesiumMaterialUserData* pCesiumData) {
+        const int32 featuresMetadataIndex =
+            pCesiumData ? pCesiumData->FeaturesMetadataLayerIndex : INDEX_NONE;
+        if (featuresMetadataIndex < 0) {
+          return;
+        }
+
+        pMaterial->SetTextureParameterValueByInfo(
+            FMaterialParameterInfo(
+                parameterName,
+                EMaterialParameterAssociation::LayerParameter,
+                featuresMetadataIndex),
+            pTexture);
       });
 }
 
 void UCesiumGltfComponent::SetCollisionEnabled(
     ECollisionEnabled::Type NewType) {
+  this->_collisionEnabled = NewType;
+  if (NewType != ECollisionEnabled::NoCollision) {
+    this->_applyPendingTransformFromCesium();
+  }
+
   for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
         Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
     if (pPrimitive) {
-      pPrimitive->SetCollisionEnabled(NewType);
+      pPrimitive->SetPrimitiveCollisionEnabled(NewType);
+    }
+  }
+}
+
+namespace {
+
+// Far enough that every hidden primitive is nearer than it, but small enough
+// that the renderer can square it in single precision.
+constexpr float CulledMinDrawDistance = 1.0e18f;
+
+void setMinDrawDistance(UPrimitiveComponent* pPrimitive, float distance) {
+  pPrimitive->MinDrawDistance = distance;
+
+  // Unlike changing its visibility, this doesn't recreate the proxy.
+  FSceneInterface* pScene = pPrimitive->GetScene();
+  if (pScene && pPrimitive->SceneProxy) {
+    pScene->UpdatePrimitiveDrawDistance(
+        pPrimitive,
+        pPrimitive->MinDrawDistance,
+        pPrimitive->CachedMaxDrawDistance,
+        pPrimitive->GetVirtualTextureMainPassMaxDrawDistance());
+  }
+}
+
+} // namespace
+
+void UCesiumGltfComponent::SetTileVisibility(
+    bool bVisible,
+    bool bKeepInScene) {
+  if (bVisible) {
+    this->_applyPendingTransformFromCesium();
+  }
+
+  TArray<USceneComponent*> children;
+  if (this->_culledByDrawDistance || (bKeepInScene && this->IsVisible())) {
+    this->GetChildrenComponents(true, children);
+  }
+
+  if (this->_culledByDrawDistance) {
+    for (USceneComponent* pChild : children) {
+      UPrimitiveComponent* pPrimitive = Cast<UPrimitiveComponent>(pChild);
+      if (pPrimitive) {
+        setMinDrawDistance(pPrimitive, 0.0f);
+      }
+    }
+    this->_culledByDrawDistance = false;
+  }
+
+  if (bVisible || !bKeepInScene || !this->IsVisible()) {
+    // Primitives that have never been shown don't have proxies yet, so they
+    // are always shown and hidden the usual way.
+    this->SetVisibility(bVisible, true);
+    return;
+  }
+
+  for (USceneComponent* pChild : children) {
+    UPrimitiveComponent* pPrimitive = Cast<UPrimitiveComponent>(pChild);
+    if (pPrimitive) {
+      setMinDrawDistance(pPrimitive, CulledMinDrawDistance);
     }
   }
+  this->_culledByDrawDistance = true;
+
+  // Only this component is hidden, so that it reports the tile's visibility.
+  this->SetVisibility(false, false);
 }
 
 void UCesiumGltfComponent::BeginDestroy() {
@@ -3072,13 +5307,53 @@ void UCesiumGltfComponent::BeginDestroy() {
   Super::BeginDestroy();
 }
 
-void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
+void UCesiumGltfComponent::UpdateFade(
+    float fadePercentage,
+    bool fadingIn,
+    bool bUseCustomPrimitiveData) {
   if (!this->IsVisible()) {
     return;
   }
 
   fadePercentage = glm::clamp(fadePercentage, 0.0f, 1.0f);
 
+  // Most tiles that are rendered are not fading at all, so skip them.
+  if (fadePercentage == this->_fadePercentage &&
+      fadingIn == this->_fadingIn &&
+      bUseCustomPrimitiveData == this->_fadeUsesCustomPrimitiveData) {
+    return;
+  }
+
+  this->_fadePercentage = fadePercentage;
+  this->_fadingIn = fadingIn;
+  this->_fadeUsesCustomPrimitiveData = bUseCustomPrimitiveData;
+
+  if (bUseCustomPrimitiveData) {
+    // Custom primitive data is uploaded with the primitive's uniform buffer,
+    // so the material instances and their uniform expressions are untouched.
+    const float fadingType = fadingIn ? 0.0f : 1.0f;
+    for (USceneComponent* pChild : this->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive) {
+        continue;
+      }
+
+      UPrimitiveComponent* pRendered =
+          pPrimitive->InstancesComponent
+              ? static_cast<UPrimitiveComponent*>(
+                    pPrimitive->InstancesComponent)
+              : pPrimitive;
+      pRendered->SetCustomPrimitiveDataFloat(
+          CesiumCustomPrimitiveDataIndices::FadePercentage,
+          fadePercentage);
+      pRendered->SetCustomPrimitiveDataFloat(
+          CesiumCustomPrimitiveDataIndices::FadingType,
+          fadingType);
+    }
+    return;
+  }
+
   UCesiumMaterialUserData* pCesiumData =
       BaseMaterial->GetAssetUserData<UCesiumMaterialUserData>();
 
@@ -3086,7 +5361,7 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
     return;
   }
 
-  int fadeLayerIndex = pCesiumData->LayerNames.Find("DitherFade");
+  int32 fadeLayerIndex = pCesiumData->DitherFadeLayerIndex;
   if (fadeLayerIndex < 0) {
     return;
   }
@@ -3106,73 +5381,69 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
 
     pMaterial->SetScalarParameterValueByInfo(
         FMaterialParameterInfo(
-            "FadePercentage",
+            CesiumMaterialParameterNames::FadePercentage,
             EMaterialParameterAssociation::LayerParameter,
             fadeLayerIndex),
         fadePercentage);
     pMaterial->SetScalarParameterValueByInfo(
         FMaterialParameterInfo(
-            "FadingType",
+            CesiumMaterialParameterNames::FadingType,
             EMaterialParameterAssociation::LayerParameter,
             fadeLayerIndex),
         fadingIn ? 0.0f : 1.0f);
   }
 }
 
-static bool isTriangleDegenerate(
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& A,
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& B,
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& C) {
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType AB = B - A;
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType AC = C - A;
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType Normal =
-      Chaos::FTriangleMeshImplicitObject::ParticleVecType::CrossProduct(AB, AC);
-  return (Normal.SafeNormalize() < 1.e-8f);
-}
+void UCesiumGltfComponent::UpdateDebugColor(
+    const std::optional<FLinearColor>& color) {
+  if (color == this->_debugColor) {
+    return;
+  }
+  this->_debugColor = color;
 
-template <typename TIndex>
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices) {
+  const bool hasLayers =
+      BaseMaterial &&
+      BaseMaterial->GetAssetUserData<UCesiumMaterialUserData>() != nullptr;
 
-  int32 vertexCount = vertexData.Num();
-  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
-  vertices.AddParticles(vertexCount);
-  for (int32 i = 0; i < vertexCount; ++i) {
-    vertices.X(i) = vertexData[i].Position;
-  }
+  for (USceneComponent* pChild : this->GetAttachChildren()) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+    if (!pPrimitive || !pPrimitive->GetMaterials().Num()) {
+      continue;
+    }
 
-  int32 triangleCount = indices.Num() / 3;
-  TArray<Chaos::TVector<TIndex, 3>> triangles;
-  triangles.Reserve(triangleCount);
-  TArray<int32> faceRemap;
-  faceRemap.Reserve(triangleCount);
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterials()[0]);
+    if (!pMaterial) {
+      continue;
+    }
 
-  for (int32 i = 0; i < triangleCount; ++i) {
-    const int32 index0 = 3 * i;
-    int32 vIndex0 = indices[index0 + 1];
-    int32 vIndex1 = indices[index0];
-    int32 vIndex2 = indices[index0 + 2];
+    // The glTF factors are set both globally and on the first layer, like
+    // SetGltfFactorParameterValues does.
+    const FMaterialParameterInfo globalInfo(
+        CesiumMaterialParameterNames::BaseColorFactor);
+    const FMaterialParameterInfo layerInfo(
+        CesiumMaterialParameterNames::BaseColorFactor,
+        EMaterialParameterAssociation::LayerParameter,
+        0);
 
-    if (!isTriangleDegenerate(
-            vertices.X(vIndex0),
-            vertices.X(vIndex1),
-            vertices.X(vIndex2))) {
-      triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
-      faceRemap.Add(i);
+    if (!pPrimitive->BaseColorFactorBeforeDebugColor) {
+      FLinearColor baseColorFactor = FLinearColor::White;
+      pMaterial->GetVectorParameterValue(
+          hasLayers ? layerInfo : globalInfo,
+          baseColorFactor);
+      pPrimitive->BaseColorFactorBeforeDebugColor = baseColorFactor;
     }
-  }
 
-  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
-  TArray<uint16> materials;
-  materials.SetNum(triangles.Num());
+    const FLinearColor value =
+        color ? *color : *pPrimitive->BaseColorFactorBeforeDebugColor;
+    pMaterial->SetVectorParameterValueByInfo(globalInfo, value);
+    if (hasLayers) {
+      pMaterial->SetVectorParameterValueByInfo(layerInfo, value);
+    }
 
-  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
+    if (!color) {
+      pPrimitive->BaseColorFactorBeforeDebugColor = std::nullopt;
+    }
+  }
 }
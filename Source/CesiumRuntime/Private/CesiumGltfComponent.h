@@ -2,11 +2,14 @@
 
 #pragma once
 
+#include "Async/TaskGraphInterfaces.h"
 #include "Cesium3DTilesSelection/Tile.h"
 #include "Cesium3DTileset.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
 #include "CesiumModelMetadata.h"
+#include "CesiumOverlayTextureCoordinates.h"
+#include "CesiumTilePipelineTimings.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/SceneComponent.h"
 #include "CoreMinimal.h"
@@ -62,6 +65,35 @@ public:
   class HalfConstructed {
   public:
     virtual ~HalfConstructed() = default;
+
+    /**
+     * Gets the events that will be signaled when the textures that were
+     * created asynchronously for this model are ready to be used.
+     */
+    virtual FGraphEventArray getTextureCreationEvents() const = 0;
+
+    /**
+     * Releases the buffers and images of the model once its textures are
+     * ready, since the model's meshes and textures no longer need them. The
+     * views of the model that the primitives would keep for feature IDs,
+     * metadata, and picking are reset if their data is released.
+     *
+     * @param model The model that this was created from.
+     * @param keepMetadataAndPickingData Whether to keep the buffers and images
+     * that feature IDs, metadata, and picking need.
+     * @param keepPositionsAndIndices Whether to keep the positions and indices
+     * of the primitives, such as to cook their physics meshes later.
+     */
+    virtual void releaseGltfData(
+        CesiumGltf::Model& model,
+        bool keepMetadataAndPickingData,
+        bool keepPositionsAndIndices) = 0;
+
+    /**
+     * When the model's tile reached each stage of the loading pipeline so
+     * far.
+     */
+    CesiumTileTimings timings;
   };
 
   static TUniquePtr<HalfConstructed> CreateOffGameThread(
@@ -103,9 +135,45 @@ public:
       EncodedMetadata_DEPRECATED = std::nullopt;
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
+  // When this model's tile reached each stage of the loading pipeline, until
+  // it's added to the tileset's histograms the first time it's shown.
+  std::optional<CesiumTileTimings> PendingTileTimings = std::nullopt;
+
+  // The memory held by this model's meshes, physics meshes, textures, and
+  // materials, which is included in its tileset's memory usage.
+  FCesiumTilesetMemoryUsage MemoryUsage;
+
+  // The geometric error of this model's tile, in meters, which height queries
+  // report as the level of detail of the heights they sample from it.
+  double GeometricError = 0.0;
+
+  // The time from the request for this model's tile to the end of its
+  // main-thread loading, in milliseconds, which the tileset's debug colors
+  // can show.
+  double LoadMilliseconds = 0.0;
+
   void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
 
-  void AttachRasterTile(
+  /**
+   * Updates the transforms of this model's primitives like
+   * {@link UpdateTransformFromCesium}, but only once they're needed: right
+   * away if the tile is shown or has collision, or else when it's next shown
+   * or has its collision enabled. A georeference change, such as switching
+   * sub-levels, then only moves the tiles that are in use rather than every
+   * cached tile.
+   */
+  void UpdateTransformFromCesiumWhenNeeded(
+      const glm::dmat4& CesiumToUnrealTransform);
+
+  /**
+   * Queues a raster overlay tile to be attached to this model's primitives.
+   * The material parameters are not updated until
+   * {@link ApplyPendingRasterTiles} is called.
+   *
+   * @return True if this is the first raster tile change queued since the
+   * pending changes were last applied.
+   */
+  bool AttachRasterTile(
       const Cesium3DTilesSelection::Tile& Tile,
       const CesiumRasterOverlays::RasterOverlayTile& RasterTile,
       UTexture2D* Texture,
@@ -113,19 +181,150 @@ public:
       const glm::dvec2& Scale,
       int32_t TextureCoordinateID);
 
-  void DetachRasterTile(
+  /**
+   * Queues a raster overlay tile to be detached from this model's primitives.
+   * The material parameters are not updated until
+   * {@link ApplyPendingRasterTiles} is called.
+   *
+   * @return True if this is the first raster tile change queued since the
+   * pending changes were last applied.
+   */
+  bool DetachRasterTile(
       const Cesium3DTilesSelection::Tile& Tile,
       const CesiumRasterOverlays::RasterOverlayTile& RasterTile,
       UTexture2D* Texture);
 
+  /**
+   * Applies the raster overlay tiles that have been attached and detached
+   * since this was last called, updating each primitive's material once.
+   * Only the last change queued for each overlay is applied.
+   */
+  void ApplyPendingRasterTiles();
+
+  /**
+   * Changes the base materials of this model's primitives in place. Each
+   * primitive is given a material instance of its new base material, with the
+   * parameter values of its current material instance copied to it, so
+   * nothing needs to be loaded again. Parameters of material layers are
+   * matched to the layers of the new base material by name. A null base
+   * material means the default one.
+   */
+  void UpdateBaseMaterials(
+      UMaterialInterface* pBaseMaterial,
+      UMaterialInterface* pBaseTranslucentMaterial,
+      UMaterialInterface* pBaseWaterMaterial);
+
+  /**
+   * Applies new custom depth parameters to this model's primitives, and the
+   * given point parameters to its points.
+   */
+  void UpdateCustomDepthParameters(
+      const FCustomDepthParameters& Parameters,
+      const FCustomDepthParameters& PointParameters);
+
+  /**
+   * Encodes this model's property tables again, from the metadata kept since
+   * it was loaded, and gives them to the materials of its primitives. Feature
+   * ID sets and property textures are left as they were loaded, because they
+   * are encoded into the primitives' vertices.
+   */
+  void UpdatePropertyTables(
+      const FCesiumModelMetadataDescription& MetadataDescription);
+
+  /**
+   * Gives the materials of this model's primitives the texture that holds the
+   * colors and visibility of the features of a property table.
+   */
+  void UpdateFeatureSelection(
+      const FString& PropertyTableName,
+      UTexture2D* pTexture);
+
   UFUNCTION(BlueprintCallable, Category = "Collision")
   virtual void SetCollisionEnabled(ECollisionEnabled::Type NewType);
 
   virtual void BeginDestroy() override;
 
-  void UpdateFade(float fadePercentage, bool fadingIn);
+  /**
+   * Updates the LOD transition fade of this model's primitives, either in
+   * their dynamic material instances or, with bUseCustomPrimitiveData, in
+   * their custom primitive data. Nothing is updated if the fade hasn't
+   * changed since the last call.
+   */
+  void UpdateFade(
+      float fadePercentage,
+      bool fadingIn,
+      bool bUseCustomPrimitiveData);
+
+  /**
+   * Shows or hides this model's tile.
+   *
+   * Normally, hiding a tile hides its primitive components, which removes
+   * their scene proxies from the scene, and showing it adds them again. With
+   * bKeepInScene, hidden primitives are instead kept in the scene and culled
+   * by an enormous minimum draw distance, which the renderer can change
+   * without recreating their proxies or cached mesh draw commands.
+   *
+   * Either way, this component's own visibility is the tile's visibility.
+   */
+  void SetTileVisibility(bool bVisible, bool bKeepInScene);
+
+  /**
+   * Tints this model's primitives by replacing the baseColorFactor of their
+   * materials with the given color, or restores their own baseColorFactor if
+   * there's no color. Only that one parameter of the existing material
+   * instances is changed, so no textures or materials are created. Nothing is
+   * updated if the color hasn't changed since the last call.
+   */
+  void UpdateDebugColor(const std::optional<FLinearColor>& color);
 
 private:
+  // Whether the primitives are culled by draw distance rather than hidden,
+  // because the tile was last hidden with bKeepInScene.
+  bool _culledByDrawDistance = false;
+
+  // The fade last written by UpdateFade. Primitives are created fully faded
+  // in, so that's where this starts.
+  float _fadePercentage = 1.0f;
+  bool _fadingIn = true;
+  bool _fadeUsesCustomPrimitiveData = false;
+
+  // The color last written by UpdateDebugColor.
+  std::optional<FLinearColor> _debugColor;
+
+  // The collision last set by SetCollisionEnabled.
+  ECollisionEnabled::Type _collisionEnabled = ECollisionEnabled::QueryAndPhysics;
+
+  // The transform that UpdateTransformFromCesiumWhenNeeded deferred, to be
+  // applied when the tile is next shown or has its collision enabled.
+  std::optional<glm::dmat4> _pendingCesiumToUnrealTransform;
+
+  void _applyPendingTransformFromCesium();
+
   UPROPERTY()
   UTexture2D* Transparent1x1 = nullptr;
+
+  struct PendingRasterTile {
+    // The texture to use for the overlay, or nullptr to detach it.
+    UTexture2D* pTexture;
+    FVector4 translationAndScale;
+    int32 textureCoordinateID;
+    // The projection of the texture coordinate ID on this tile, when the
+    // material computes the overlay's texture coordinates itself.
+    std::optional<CesiumOverlayTextureCoordinates::TileProjection> projection;
+
+    bool operator==(const PendingRasterTile& rhs) const {
+      return this->pTexture == rhs.pTexture &&
+             this->translationAndScale == rhs.translationAndScale &&
+             this->textureCoordinateID == rhs.textureCoordinateID;
+    }
+  };
+
+  // The last raster tile change queued for each overlay, keyed by the
+  // overlay's name.
+  TMap<FString, PendingRasterTile> _pendingRasterTiles;
+
+  // The raster tile change that was last applied to the materials for each
+  // overlay, keyed by the overlay's name. A queued change that matches it is
+  // dropped rather than updating every primitive's material again.
+  TMap<FString, PendingRasterTile> _appliedRasterTiles;
 };
@@ -0,0 +1,84 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfMeshSceneProxy.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "SceneManagement.h"
+#include "StaticMeshResources.h"
+
+SIZE_T FCesiumGltfMeshSceneProxy::GetTypeHash() const {
+  static size_t UniquePointer;
+  return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+FCesiumGltfMeshSceneProxy::FCesiumGltfMeshSceneProxy(
+    UCesiumGltfPrimitiveComponent* InComponent,
+    ERHIFeatureLevel::Type InFeatureLevel)
+    : FPrimitiveSceneProxy(InComponent),
+      RenderData(InComponent->OwnedRenderData),
+      Material(InComponent->GetMaterial(0)),
+      MaterialRelevance(InComponent->GetMaterialRelevance(InFeatureLevel)) {}
+
+FCesiumGltfMeshSceneProxy::~FCesiumGltfMeshSceneProxy() {}
+
+void FCesiumGltfMeshSceneProxy::DrawStaticElements(
+    FStaticPrimitiveDrawInterface* PDI) {
+  if (!Material || RenderData->LODResources.IsEmpty()) {
+    return;
+  }
+
+  const FStaticMeshLODResources& LODResources = RenderData->LODResources[0];
+  const FLocalVertexFactory& VertexFactory =
+      RenderData->LODVertexFactories[0].VertexFactory;
+
+  for (const FStaticMeshSection& Section : LODResources.Sections) {
+    if (Section.NumTriangles == 0) {
+      continue;
+    }
+
+    FMeshBatch Mesh;
+    Mesh.VertexFactory = &VertexFactory;
+    Mesh.MaterialRenderProxy = Material->GetRenderProxy();
+    Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+    Mesh.Type = PT_TriangleList;
+    Mesh.DepthPriorityGroup = SDPG_World;
+    Mesh.LODIndex = 0;
+    Mesh.CastShadow = Section.bCastShadow;
+    Mesh.bUseAsOccluder = false;
+    Mesh.bWireframe = false;
+
+    FMeshBatchElement& BatchElement = Mesh.Elements[0];
+    BatchElement.IndexBuffer = &LODResources.IndexBuffer;
+    BatchElement.NumPrimitives = Section.NumTriangles;
+    BatchElement.FirstIndex = Section.FirstIndex;
+    BatchElement.MinVertexIndex = Section.MinVertexIndex;
+    BatchElement.MaxVertexIndex = Section.MaxVertexIndex;
+
+    PDI->DrawMesh(Mesh, FLT_MAX);
+  }
+}
+
+FPrimitiveViewRelevance
+FCesiumGltfMeshSceneProxy::GetViewRelevance(const FSceneView* View) const {
+  FPrimitiveViewRelevance Result;
+  Result.bDrawRelevance = IsShown(View);
+  Result.bDynamicRelevance = false;
+  Result.bStaticRelevance = true;
+
+  Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+  Result.bRenderInMainPass = ShouldRenderInMainPass();
+  Result.bRenderInDepthPass = ShouldRenderInDepthPass();
+  Result.bUsesLightingChannels =
+      GetLightingChannelMask() != GetDefaultLightingChannelMask();
+  Result.bShadowRelevance = IsShadowCast(View);
+  Result.bVelocityRelevance =
+      IsMovable() & Result.bOpaque & Result.bRenderInMainPass;
+
+  MaterialRelevance.SetPrimitiveViewRelevance(Result);
+
+  return Result;
+}
+
+uint32 FCesiumGltfMeshSceneProxy::GetMemoryFootprint(void) const {
+  return (sizeof(*this) + GetAllocatedSize());
+}
@@ -0,0 +1,45 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "PrimitiveSceneProxy.h"
+#include "Templates/SharedPointer.h"
+
+class FStaticMeshRenderData;
+class UCesiumGltfPrimitiveComponent;
+
+/**
+ * Draws a glTF triangle primitive whose static mesh render data is owned by
+ * its component, rather than by a UStaticMesh. The primitive is drawn as a
+ * static mesh, so its mesh draw commands are cached.
+ *
+ * Unlike FStaticMeshSceneProxy, this doesn't support ray tracing, distance
+ * fields, Nanite, or more than one LOD, none of which the primitives of a
+ * tileset that uses lightweight primitives have.
+ */
+class FCesiumGltfMeshSceneProxy final : public FPrimitiveSceneProxy {
+public:
+  SIZE_T GetTypeHash() const override;
+
+  FCesiumGltfMeshSceneProxy(
+      UCesiumGltfPrimitiveComponent* InComponent,
+      ERHIFeatureLevel::Type InFeatureLevel);
+
+  virtual ~FCesiumGltfMeshSceneProxy();
+
+protected:
+  virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override;
+
+  virtual FPrimitiveViewRelevance
+  GetViewRelevance(const FSceneView* View) const override;
+
+  virtual uint32 GetMemoryFootprint(void) const override;
+
+private:
+  // Keeps the render data alive until this proxy is destroyed on the render
+  // thread, even if the component has already let go of it.
+  TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe> RenderData;
+
+  UMaterialInterface* Material;
+  FMaterialRelevance MaterialRelevance;
+};
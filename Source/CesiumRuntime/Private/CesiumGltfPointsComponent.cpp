@@ -2,6 +2,7 @@
 
 #include "CesiumGltfPointsComponent.h"
 #include "CesiumGltfPointsSceneProxy.h"
+#include "CesiumPointAttenuationVertexFactory.h"
 #include "SceneInterface.h"
 
 // Sets default values for this component's properties
@@ -26,3 +27,8 @@ FPrimitiveSceneProxy* UCesiumGltfPointsComponent::CreateSceneProxy() {
 
   return Proxy;
 }
+
+void UCesiumGltfPointsComponent::ReleaseResources() {
+  Super::ReleaseResources();
+  this->QuantizedPoints.Reset();
+}
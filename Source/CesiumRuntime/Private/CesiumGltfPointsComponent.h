@@ -3,8 +3,11 @@
 #pragma once
 
 #include "CesiumGltfPrimitiveComponent.h"
+#include "Templates/SharedPointer.h"
 #include "CesiumGltfPointsComponent.generated.h"
 
+class FCesiumQuantizedPointsVertexBuffer;
+
 UCLASS()
 class UCesiumGltfPointsComponent : public UCesiumGltfPrimitiveComponent {
   GENERATED_BODY()
@@ -25,6 +28,14 @@ public:
   // error.
   glm::vec3 Dimensions;
 
+  // The quantized positions and normals of the points, if they are drawn by
+  // FCesiumPointAttenuationVertexFactory. The static mesh then only has
+  // placeholder positions.
+  TSharedPtr<FCesiumQuantizedPointsVertexBuffer, ESPMode::ThreadSafe>
+      QuantizedPoints;
+
   // Override UPrimitiveComponent interface.
   virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+
+  virtual void ReleaseResources() override;
 };
@@ -1,5 +1,6 @@
 #include "CesiumGltfPointsSceneProxy.h"
 #include "CesiumGltfPointsComponent.h"
+#include "CesiumPointBudget.h"
 #include "Engine/StaticMesh.h"
 #include "RHIResources.h"
 #include "Runtime/Launch/Resources/Version.h"
@@ -27,6 +28,15 @@ void FCesiumGltfPointsSceneProxyTilesetData::UpdateFromComponent(
   Dimensions = Component->Dimensions;
 }
 
+bool FCesiumGltfPointsSceneProxyTilesetData::operator==(
+    const FCesiumGltfPointsSceneProxyTilesetData& Other) const {
+  return PointCloudShading == Other.PointCloudShading &&
+         MaximumScreenSpaceError == Other.MaximumScreenSpaceError &&
+         UsesAdditiveRefinement == Other.UsesAdditiveRefinement &&
+         GeometricError == Other.GeometricError &&
+         Dimensions == Other.Dimensions;
+}
+
 SIZE_T FCesiumGltfPointsSceneProxy::GetTypeHash() const {
   static size_t UniquePointer;
   return reinterpret_cast<size_t>(&UniquePointer);
@@ -36,28 +46,62 @@ FCesiumGltfPointsSceneProxy::FCesiumGltfPointsSceneProxy(
     UCesiumGltfPointsComponent* InComponent,
     ERHIFeatureLevel::Type InFeatureLevel)
     : FPrimitiveSceneProxy(InComponent),
-      RenderData(InComponent->GetStaticMesh()->GetRenderData()),
-      NumPoints(RenderData->LODResources[0].IndexBuffer.GetNumIndices()),
+      RenderData(InComponent->GetPrimitiveRenderData()),
+      OwnedRenderData(InComponent->OwnedRenderData),
+      NumPoints(
+          InComponent->QuantizedPoints
+              ? InComponent->QuantizedPoints->GetNumPoints()
+              : RenderData->LODResources[0].IndexBuffer.GetNumIndices()),
       bAttenuationSupported(
+          InComponent->QuantizedPoints &&
           RHISupportsManualVertexFetch(GetScene().GetShaderPlatform())),
       TilesetData(),
+      QuantizedPoints(InComponent->QuantizedPoints),
       AttenuationVertexFactory(
           InFeatureLevel,
           &RenderData->LODResources[0].VertexBuffers.PositionVertexBuffer),
-      AttenuationIndexBuffer(NumPoints, bAttenuationSupported),
+      AttenuationUserData(),
       Material(InComponent->GetMaterial(0)),
-      MaterialRelevance(InComponent->GetMaterialRelevance(InFeatureLevel)) {}
+      MaterialRelevance(InComponent->GetMaterialRelevance(InFeatureLevel)) {
+  UpdatePointAttenuationUserData();
+}
 
 FCesiumGltfPointsSceneProxy::~FCesiumGltfPointsSceneProxy() {}
 
 void FCesiumGltfPointsSceneProxy::CreateRenderThreadResources() {
   AttenuationVertexFactory.InitResource();
-  AttenuationIndexBuffer.InitResource();
+  if (bAttenuationSupported) {
+    GCesiumPointAttenuationIndexBuffer.Reserve(NumPoints);
+
+    const FLocalVertexFactory& OriginalVertexFactory =
+        RenderData->LODVertexFactories[0].VertexFactory;
+
+    AttenuationUserData.QuantizedPointBuffer = QuantizedPoints->GetSRV();
+    AttenuationUserData.PositionOffset = QuantizedPoints->GetPositionOffset();
+    AttenuationUserData.PositionScale = QuantizedPoints->GetPositionScale();
+    AttenuationUserData.ColorBuffer =
+        OriginalVertexFactory.GetColorComponentsSRV();
+    AttenuationUserData.TexCoordBuffer =
+        OriginalVertexFactory.GetTextureCoordinatesSRV();
+    AttenuationUserData.bHasPointColors =
+        RenderData->LODResources[0].bHasColorVertexData;
+    AttenuationUserData.PointFilterBuffer = QuantizedPoints->GetFilterSRV();
+
+    // Points without texture coordinates only have a placeholder vertex in the
+    // static mesh vertex buffer.
+    const bool bHasTexCoords =
+        int32(RenderData->LODResources[0]
+                  .VertexBuffers.StaticMeshVertexBuffer.GetNumVertices()) >=
+        NumPoints;
+    AttenuationUserData.NumTexCoords =
+        bHasTexCoords ? OriginalVertexFactory.GetNumTexcoords() : 0;
+  }
+  CesiumPointBudget::addProxy(this);
 }
 
 void FCesiumGltfPointsSceneProxy::DestroyRenderThreadResources() {
+  CesiumPointBudget::removeProxy(this);
   AttenuationVertexFactory.ReleaseResource();
-  AttenuationIndexBuffer.ReleaseResource();
 }
 
 void FCesiumGltfPointsSceneProxy::GetDynamicMeshElements(
@@ -67,17 +111,26 @@ void FCesiumGltfPointsSceneProxy::GetDynamicMeshElements(
     FMeshElementCollector& Collector) const {
   QUICK_SCOPE_CYCLE_COUNTER(STAT_GltfPointsSceneProxy_GetDynamicMeshElements);
 
-  const bool useAttenuation =
-      bAttenuationSupported && TilesetData.PointCloudShading.Attenuation;
+  if (QuantizedPoints && !bAttenuationSupported) {
+    // The points were quantized for a shader platform with manual vertex
+    // fetch, so the static mesh only has placeholder positions.
+    return;
+  }
+
+  const int32 NumPointsToDraw =
+      CesiumPointBudget::getPointsToDraw(*this, ViewFamily, Views);
+  if (NumPointsToDraw <= 0) {
+    return;
+  }
 
   for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++) {
     if (VisibilityMap & (1 << ViewIndex)) {
       const FSceneView* View = Views[ViewIndex];
       FMeshBatch& Mesh = Collector.AllocateMesh();
-      if (useAttenuation) {
-        CreateMeshWithAttenuation(Mesh, View, Collector);
+      if (bAttenuationSupported) {
+        CreateMeshWithAttenuation(Mesh, NumPointsToDraw);
       } else {
-        CreateMesh(Mesh);
+        CreateMesh(Mesh, NumPointsToDraw);
       }
       Collector.AddMesh(ViewIndex, Mesh);
     }
@@ -113,7 +166,11 @@ uint32 FCesiumGltfPointsSceneProxy::GetMemoryFootprint(void) const {
 
 void FCesiumGltfPointsSceneProxy::UpdateTilesetData(
     const FCesiumGltfPointsSceneProxyTilesetData& InTilesetData) {
+  if (TilesetData == InTilesetData) {
+    return;
+  }
   TilesetData = InTilesetData;
+  UpdatePointAttenuationUserData();
 }
 
 float FCesiumGltfPointsSceneProxy::GetGeometricError() const {
@@ -133,27 +190,49 @@ float FCesiumGltfPointsSceneProxy::GetGeometricError() const {
   return FMath::Pow(Volume / NumPoints, 1.0f / 3.0f);
 }
 
-void FCesiumGltfPointsSceneProxy::CreatePointAttenuationUserData(
-    FMeshBatchElement& BatchElement,
-    const FSceneView* View,
-    FMeshElementCollector& Collector) const {
-  FCesiumPointAttenuationBatchElementUserDataWrapper* UserDataWrapper =
-      &Collector.AllocateOneFrameResource<
-          FCesiumPointAttenuationBatchElementUserDataWrapper>();
-
-  FCesiumPointAttenuationBatchElementUserData& UserData = UserDataWrapper->Data;
-  const FLocalVertexFactory& OriginalVertexFactory =
-      RenderData->LODVertexFactories[0].VertexFactory;
-
-  UserData.PositionBuffer = OriginalVertexFactory.GetPositionsSRV();
-  UserData.PackedTangentsBuffer = OriginalVertexFactory.GetTangentsSRV();
-  UserData.ColorBuffer = OriginalVertexFactory.GetColorComponentsSRV();
-  UserData.TexCoordBuffer = OriginalVertexFactory.GetTextureCoordinatesSRV();
-  UserData.NumTexCoords = OriginalVertexFactory.GetNumTexcoords();
-  UserData.bHasPointColors = RenderData->LODResources[0].bHasColorVertexData;
+void FCesiumGltfPointsSceneProxy::UpdatePointAttenuationUserData() {
+  if (!QuantizedPoints) {
+    return;
+  }
 
+  FCesiumPointAttenuationBatchElementUserData& UserData = AttenuationUserData;
   FCesiumPointCloudShading PointCloudShading = TilesetData.PointCloudShading;
 
+  UserData.PointFilterFlags = 0;
+  uint32 HiddenClassificationMask[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  if (QuantizedPoints->HasClassifications() &&
+      PointCloudShading.HiddenClassifications.Num() > 0) {
+    UserData.PointFilterFlags |= 1;
+    for (uint8 Classification : PointCloudShading.HiddenClassifications) {
+      HiddenClassificationMask[Classification >> 5] |= 1u
+                                                       << (Classification & 31);
+    }
+  }
+  UserData.HiddenClassificationsLow = FUintVector4(
+      HiddenClassificationMask[0],
+      HiddenClassificationMask[1],
+      HiddenClassificationMask[2],
+      HiddenClassificationMask[3]);
+  UserData.HiddenClassificationsHigh = FUintVector4(
+      HiddenClassificationMask[4],
+      HiddenClassificationMask[5],
+      HiddenClassificationMask[6],
+      HiddenClassificationMask[7]);
+  if (QuantizedPoints->HasIntensities() && PointCloudShading.FilterByIntensity) {
+    UserData.PointFilterFlags |= 2;
+  }
+  UserData.IntensityFilter = FVector4f(
+      QuantizedPoints->GetIntensityOffset(),
+      QuantizedPoints->GetIntensityScale(),
+      PointCloudShading.MinimumIntensity,
+      PointCloudShading.MaximumIntensity);
+
+  if (!PointCloudShading.Attenuation) {
+    // Draw every point as a single pixel, like a point list.
+    UserData.AttenuationParameters = FVector2f(1.0f, 0.0f);
+    return;
+  }
+
   float MaximumPointSize = TilesetData.UsesAdditiveRefinement
                                ? 5.0f
                                : TilesetData.MaximumScreenSpaceError;
@@ -166,21 +245,13 @@ void FCesiumGltfPointsSceneProxy::CreatePointAttenuationUserData(
   float GeometricError = GetGeometricError();
   GeometricError *= PointCloudShading.GeometricErrorScale;
 
-  // Depth Multiplier
-  float SSEDenominator = 2.0f * tanf(0.5f * FMath::DegreesToRadians(View->FOV));
-  float DepthMultiplier =
-      static_cast<float>(View->UnconstrainedViewRect.Height()) / SSEDenominator;
-
+  // The depth multiplier depends on the view, so the shader computes it.
   UserData.AttenuationParameters =
-      FVector3f(MaximumPointSize, GeometricError, DepthMultiplier);
-
-  BatchElement.UserData = &UserDataWrapper->Data;
+      FVector2f(MaximumPointSize, GeometricError);
 }
-
 void FCesiumGltfPointsSceneProxy::CreateMeshWithAttenuation(
     FMeshBatch& Mesh,
-    const FSceneView* View,
-    FMeshElementCollector& Collector) const {
+    int32 NumPointsToDraw) const {
   Mesh.VertexFactory = &AttenuationVertexFactory;
   Mesh.MaterialRenderProxy = Material->GetRenderProxy();
   Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
@@ -192,17 +263,19 @@ void FCesiumGltfPointsSceneProxy::CreateMeshWithAttenuation(
   Mesh.bWireframe = false;
 
   FMeshBatchElement& BatchElement = Mesh.Elements[0];
-  BatchElement.IndexBuffer = &AttenuationIndexBuffer;
-  BatchElement.NumPrimitives = NumPoints * 2;
+  BatchElement.IndexBuffer = &GCesiumPointAttenuationIndexBuffer;
+  BatchElement.NumPrimitives = NumPointsToDraw * 2;
   BatchElement.FirstIndex = 0;
   BatchElement.MinVertexIndex = 0;
-  BatchElement.MaxVertexIndex = NumPoints * 4 - 1;
+  BatchElement.MaxVertexIndex = NumPointsToDraw * 4 - 1;
   BatchElement.PrimitiveUniformBuffer = GetUniformBuffer();
 
-  CreatePointAttenuationUserData(BatchElement, View, Collector);
+  BatchElement.UserData = &AttenuationUserData;
 }
 
-void FCesiumGltfPointsSceneProxy::CreateMesh(FMeshBatch& Mesh) const {
+void FCesiumGltfPointsSceneProxy::CreateMesh(
+    FMeshBatch& Mesh,
+    int32 NumPointsToDraw) const {
   Mesh.VertexFactory = &RenderData->LODVertexFactories[0].VertexFactory;
   Mesh.MaterialRenderProxy = Material->GetRenderProxy();
   Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
@@ -215,8 +288,8 @@ void FCesiumGltfPointsSceneProxy::CreateMesh(FMeshBatch& Mesh) const {
 
   FMeshBatchElement& BatchElement = Mesh.Elements[0];
   BatchElement.IndexBuffer = &RenderData->LODResources[0].IndexBuffer;
-  BatchElement.NumPrimitives = NumPoints;
+  BatchElement.NumPrimitives = NumPointsToDraw;
   BatchElement.FirstIndex = 0;
   BatchElement.MinVertexIndex = 0;
-  BatchElement.MaxVertexIndex = BatchElement.NumPrimitives - 1;
+  BatchElement.MaxVertexIndex = NumPoints - 1;
 }
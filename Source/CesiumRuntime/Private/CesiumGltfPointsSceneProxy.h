@@ -21,12 +21,20 @@ struct FCesiumGltfPointsSceneProxyTilesetData {
   FCesiumGltfPointsSceneProxyTilesetData();
 
   void UpdateFromComponent(UCesiumGltfPointsComponent* Component);
+
+  bool operator==(const FCesiumGltfPointsSceneProxyTilesetData& Other) const;
+  bool operator!=(const FCesiumGltfPointsSceneProxyTilesetData& Other) const {
+    return !(*this == Other);
+  }
 };
 
 class FCesiumGltfPointsSceneProxy final : public FPrimitiveSceneProxy {
 private:
-  // The original render data of the static mesh.
+  // The original render data of the static mesh or component.
   const FStaticMeshRenderData* RenderData;
+  // Keeps render data that is owned by the component alive until this proxy
+  // is destroyed.
+  TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe> OwnedRenderData;
   int32_t NumPoints;
 
 public:
@@ -57,31 +65,38 @@ public:
   void UpdateTilesetData(
       const FCesiumGltfPointsSceneProxyTilesetData& InTilesetData);
 
+  int32 GetNumPoints() const { return NumPoints; }
+
+  float GetGeometricError() const;
+
 private:
-  // Whether or not the shader platform supports attenuation.
+  // Whether or not the points can be drawn by the attenuation vertex factory.
+  // Those points are always drawn by it, with or without attenuation.
   bool bAttenuationSupported;
 
   // Data from the UCesiumGltfComponent that owns this scene proxy, as well as
   // its ACesium3DTileset.
   FCesiumGltfPointsSceneProxyTilesetData TilesetData;
 
-  // The vertex factory and index buffer for point attenuation.
+  // The quantized positions and normals read by the attenuation vertex
+  // factory, or nullptr if the points are only in the static mesh.
+  TSharedPtr<FCesiumQuantizedPointsVertexBuffer, ESPMode::ThreadSafe>
+      QuantizedPoints;
+
+  // The vertex factory for point attenuation. Its index buffer is shared by
+  // all proxies; see GCesiumPointAttenuationIndexBuffer.
   FCesiumPointAttenuationVertexFactory AttenuationVertexFactory;
-  FCesiumPointAttenuationIndexBuffer AttenuationIndexBuffer;
+
+  // The parameters of the attenuation vertex factory, shared by every view.
+  // The buffers are set when the render thread resources are created, and the
+  // rest when the tileset data changes.
+  FCesiumPointAttenuationBatchElementUserData AttenuationUserData;
 
   UMaterialInterface* Material;
   FMaterialRelevance MaterialRelevance;
 
-  float GetGeometricError() const;
-
-  void CreatePointAttenuationUserData(
-      FMeshBatchElement& BatchElement,
-      const FSceneView* View,
-      FMeshElementCollector& Collector) const;
+  void UpdatePointAttenuationUserData();
 
-  void CreateMeshWithAttenuation(
-      FMeshBatch& Mesh,
-      const FSceneView* View,
-      FMeshElementCollector& Collector) const;
-  void CreateMesh(FMeshBatch& Mesh) const;
+  void CreateMeshWithAttenuation(FMeshBatch& Mesh, int32 NumPointsToDraw) const;
+  void CreateMesh(FMeshBatch& Mesh, int32 NumPointsToDraw) const;
 };
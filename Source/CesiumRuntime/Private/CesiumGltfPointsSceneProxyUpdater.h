@@ -28,9 +28,10 @@ public:
       FCesiumGltfPointsSceneProxy* PointsProxy =
           static_cast<FCesiumGltfPointsSceneProxy*>(
               PointsComponent->SceneProxy);
-      if (PointsProxy) {
-        SceneProxies.Add(PointsProxy);
+      if (!PointsProxy) {
+        continue;
       }
+      SceneProxies.Add(PointsProxy);
 
       FCesiumGltfPointsSceneProxyTilesetData TilesetData;
       TilesetData.UpdateFromComponent(PointsComponent);
@@ -41,7 +42,8 @@ public:
     ENQUEUE_RENDER_COMMAND(TransferCesium3DTilesetSettingsToPointsProxies)
     ([SceneProxies,
       ProxyTilesetData](FRHICommandListImmediate& RHICmdList) mutable {
-      // Iterate over proxies and update their data
+      // Iterate over proxies and update their data. Proxies whose data
+      // hasn't changed keep their attenuation parameters as they are.
       for (int32 i = 0; i < SceneProxies.Num(); i++) {
         SceneProxies[i]->UpdateTilesetData(ProxyTilesetData[i]);
       }
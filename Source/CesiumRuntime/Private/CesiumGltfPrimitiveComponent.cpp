@@ -1,15 +1,29 @@
 // Copyright 2020-2023 CesiumGS, Inc. and Contributors
 
 #include "CesiumGltfPrimitiveComponent.h"
+#include "AI/NavigationSystemHelpers.h"
 #include "CalcBounds.h"
 #include "CesiumGltf/MeshPrimitive.h"
 #include "CesiumGltf/Model.h"
+#include "CesiumGltfMeshSceneProxy.h"
 #include "CesiumLifetime.h"
+#include "CesiumMaterialParameterNames.h"
+#include "CesiumMaterialPool.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumBakingGeometry.h"
+#include "CesiumNavigationGeometry.h"
+#include "CesiumPhysicsStateQueue.h"
+#include "CesiumRenderDataBatch.h"
+#include "CesiumTriangleBvh.h"
+#include "CesiumVertexPullingSceneProxy.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "RenderingThread.h"
+#include "SceneInterface.h"
+#include "StaticMeshResources.h"
 #include "VecMath.h"
 #include <variant>
 
@@ -60,7 +74,7 @@ namespace {
 
 void destroyMaterialTexture(
     UMaterialInstanceDynamic* pMaterial,
-    const char* name,
+    FName name,
     EMaterialParameterAssociation assocation,
     int32 index) {
   UTexture* pTexture = nullptr;
@@ -76,26 +90,46 @@ void destroyGltfParameterValues(
     UMaterialInstanceDynamic* pMaterial,
     EMaterialParameterAssociation assocation,
     int32 index) {
-  destroyMaterialTexture(pMaterial, "baseColorTexture", assocation, index);
   destroyMaterialTexture(
       pMaterial,
-      "metallicRoughnessTexture",
+      CesiumMaterialParameterNames::BaseColorTexture,
+      assocation,
+      index);
+  destroyMaterialTexture(
+      pMaterial,
+      CesiumMaterialParameterNames::MetallicRoughnessTexture,
+      assocation,
+      index);
+  destroyMaterialTexture(
+      pMaterial,
+      CesiumMaterialParameterNames::NormalTexture,
+      assocation,
+      index);
+  destroyMaterialTexture(
+      pMaterial,
+      CesiumMaterialParameterNames::EmissiveTexture,
+      assocation,
+      index);
+  destroyMaterialTexture(
+      pMaterial,
+      CesiumMaterialParameterNames::OcclusionTexture,
       assocation,
       index);
-  destroyMaterialTexture(pMaterial, "normalTexture", assocation, index);
-  destroyMaterialTexture(pMaterial, "emissiveTexture", assocation, index);
-  destroyMaterialTexture(pMaterial, "occlusionTexture", assocation, index);
 }
 
 void destroyWaterParameterValues(
     UMaterialInstanceDynamic* pMaterial,
     EMaterialParameterAssociation assocation,
     int32 index) {
-  destroyMaterialTexture(pMaterial, "WaterMask", assocation, index);
+  destroyMaterialTexture(
+      pMaterial,
+      CesiumMaterialParameterNames::WaterMask,
+      assocation,
+      index);
 }
 } // namespace
 
-void UCesiumGltfPrimitiveComponent::BeginDestroy() {
+void UCesiumGltfPrimitiveComponent::ReleaseResources() {
   // This should mirror the logic in loadPrimitiveGameThreadPart in
   // CesiumGltfComponent.cpp
   UMaterialInstanceDynamic* pMaterial =
@@ -125,7 +159,7 @@ void UCesiumGltfPrimitiveComponent::BeginDestroy() {
           EMaterialParameterAssociation::LayerParameter,
           0);
 
-      int32 waterIndex = pCesiumData->LayerNames.Find("Water");
+      int32 waterIndex = pCesiumData->WaterLayerIndex;
       if (waterIndex >= 0) {
         destroyWaterParameterValues(
             pMaterial,
@@ -145,7 +179,7 @@ void UCesiumGltfPrimitiveComponent::BeginDestroy() {
     }
     PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
-    CesiumLifetime::destroy(pMaterial);
+    CesiumMaterialPool::get().release(pMaterial);
   }
 
   UStaticMesh* pMesh = this->GetStaticMesh();
@@ -159,9 +193,242 @@ void UCesiumGltfPrimitiveComponent::BeginDestroy() {
     CesiumLifetime::destroy(pMesh);
   }
 
+  this->OwnedRenderData.Reset();
+  this->PulledAttributes.Reset();
+}
+
+void UCesiumGltfPrimitiveComponent::SetOwnedRenderData(
+    TUniquePtr<FStaticMeshRenderData>&& RenderData,
+    CesiumRenderDataBatch& Batch) {
+  check(IsInGameThread());
+  check(!this->IsRegistered());
+
+  FStaticMeshRenderData* pRenderData = RenderData.Release();
+
+  // Scene proxies may hold a reference to the render data after its component
+  // has let go of it, so it's released on the render thread, after any proxy
+  // that was using it.
+  this->OwnedRenderData =
+      MakeShareable(pRenderData, [](FStaticMeshRenderData* p) {
+        ENQUEUE_RENDER_COMMAND(ReleaseCesiumPrimitiveRenderData)
+        ([p](FRHICommandListImmediate& RHICmdList) {
+          p->ReleaseResources();
+          delete p;
+        });
+      });
+
+  Batch.add(this->OwnedRenderData);
+}
+
+const FStaticMeshRenderData*
+UCesiumGltfPrimitiveComponent::GetPrimitiveRenderData() const {
+  if (this->OwnedRenderData) {
+    return this->OwnedRenderData.Get();
+  }
+  const UStaticMesh* pMesh = this->GetStaticMesh();
+  return pMesh ? pMesh->GetRenderData() : nullptr;
+}
+
+void UCesiumGltfPrimitiveComponent::CreateInstances(
+    const TArray<FTransform>& InstanceTransforms) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateInstances)
+
+  UInstancedStaticMeshComponent* pInstances =
+      NewObject<UInstancedStaticMeshComponent>(this, TEXT("Instances"));
+  pInstances->SetFlags(
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  pInstances->SetMobility(this->Mobility);
+  pInstances->SetStaticMesh(this->GetStaticMesh());
+  pInstances->bUseDefaultCollision = false;
+  pInstances->SetCollisionObjectType(this->GetCollisionObjectType());
+  pInstances->SetCollisionEnabled(this->GetCollisionEnabled());
+  pInstances->bCastDynamicShadow = this->bCastDynamicShadow;
+  pInstances->CastShadow = this->CastShadow;
+  pInstances->ShadowCacheInvalidationBehavior =
+      this->ShadowCacheInvalidationBehavior;
+  pInstances->SetRenderCustomDepth(this->bRenderCustomDepth);
+  pInstances->SetCustomDepthStencilWriteMask(
+      this->CustomDepthStencilWriteMask);
+  pInstances->SetCustomDepthStencilValue(this->CustomDepthStencilValue);
+  pInstances->RuntimeVirtualTextures = this->RuntimeVirtualTextures;
+  pInstances->VirtualTextureRenderPassType = this->VirtualTextureRenderPassType;
+  pInstances->SetVisibility(this->GetVisibleFlag());
+  pInstances->AddInstances(InstanceTransforms, false);
+
+  pInstances->SetupAttachment(this);
+  pInstances->RegisterComponent();
+
+  this->InstancesComponent = pInstances;
+
+  // The instances are drawn and collided with instead of this component.
+  this->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+  this->MarkRenderStateDirty();
+}
+
+void UCesiumGltfPrimitiveComponent::SetPrimitiveCollisionEnabled(
+    ECollisionEnabled::Type NewType) {
+  UPrimitiveComponent* pTarget = this;
+  if (this->InstancesComponent) {
+    pTarget = this->InstancesComponent;
+  }
+
+  // Enabling collision on a primitive that has no physics state yet creates
+  // its bodies, which is left to the queue. Anything else is cheap.
+  if (NewType != ECollisionEnabled::NoCollision &&
+      pTarget->GetCollisionEnabled() != NewType &&
+      !pTarget->IsPhysicsStateCreated() && pTarget->IsRegistered() &&
+      CesiumPhysicsStateQueue::isEnabled()) {
+    if (!this->PendingCollisionEnabled) {
+      CesiumPhysicsStateQueue::get().add(this);
+    }
+    this->PendingCollisionEnabled = NewType;
+    return;
+  }
+
+  this->PendingCollisionEnabled.reset();
+  pTarget->SetCollisionEnabled(NewType);
+}
+
+bool UCesiumGltfPrimitiveComponent::ApplyPendingCollisionEnabled() {
+  if (!this->PendingCollisionEnabled) {
+    return false;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyPendingCollisionEnabled)
+
+  const ECollisionEnabled::Type collisionEnabled =
+      *this->PendingCollisionEnabled;
+  this->PendingCollisionEnabled.reset();
+  if (this->InstancesComponent) {
+    this->InstancesComponent->SetCollisionEnabled(collisionEnabled);
+  } else {
+    this->SetCollisionEnabled(collisionEnabled);
+  }
+  return true;
+}
+
+void UCesiumGltfPrimitiveComponent::PrepareForReuse() {
+  check(!this->IsRegistered());
+
+  // The instances use the static mesh, so they go first.
+  if (this->InstancesComponent) {
+    CesiumLifetime::destroyComponentRecursively(this->InstancesComponent);
+    this->InstancesComponent = nullptr;
+  }
+
+  this->ReleaseResources();
+  this->SetStaticMesh(nullptr);
+  this->EmptyOverrideMaterials();
+
+  // The body setup is kept for the next primitive, without the collision of
+  // this one. This mirrors AmortizedDestructor::finalizeDestroy.
+  if (this->OwnedBodySetup) {
+    this->OwnedBodySetup->UVInfo.IndexBuffer.Empty();
+    this->OwnedBodySetup->UVInfo.VertPositions.Empty();
+    this->OwnedBodySetup->UVInfo.VertUVs.Empty();
+    this->OwnedBodySetup->FaceRemap.Empty();
+    this->OwnedBodySetup->ClearPhysicsMeshes();
+  }
+
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  this->Features = FCesiumPrimitiveFeatures();
+  this->Metadata = FCesiumPrimitiveMetadata();
+  this->EncodedFeatures =
+      CesiumEncodedFeaturesMetadata::EncodedPrimitiveFeatures();
+  this->EncodedMetadata =
+      CesiumEncodedFeaturesMetadata::EncodedPrimitiveMetadata();
+  this->Metadata_DEPRECATED = FCesiumMetadataPrimitive();
+  this->EncodedMetadata_DEPRECATED = std::nullopt;
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  this->pTilesetActor = nullptr;
+  this->pModel = nullptr;
+  this->pMeshPrimitive = nullptr;
+  this->GltfToUnrealTexCoordMap.clear();
+  this->TexCoordAccessorMap.clear();
+  this->PositionAccessor = CesiumGltf::AccessorView<FVector3f>();
+  this->IndexAccessor = CesiumIndexAccessorType();
+  this->PickingTrianglesMap.clear();
+  this->boundingVolume = std::nullopt;
+  this->PhysicsMeshRequested = false;
+  this->PendingCollisionEnabled.reset();
+  this->MeshDistanceFieldRequested = false;
+  this->NavigationGeometry.Reset();
+  this->HeightQueryBvh.Reset();
+  this->BakingGeometry.Reset();
+  this->BaseColorFactorBeforeDebugColor = std::nullopt;
+  this->RuntimeVirtualTextures.Empty();
+
+  // Match a newly-created component, since the glTF component and tileset
+  // only change these after the component is registered.
+  const UCesiumGltfPrimitiveComponent* pDefaults =
+      this->GetClass()->GetDefaultObject<UCesiumGltfPrimitiveComponent>();
+  this->bCastDynamicShadow = pDefaults->bCastDynamicShadow;
+  this->CastShadow = pDefaults->CastShadow;
+  this->ShadowCacheInvalidationBehavior =
+      pDefaults->ShadowCacheInvalidationBehavior;
+  this->MinDrawDistance = pDefaults->MinDrawDistance;
+  this->SetVisibility(pDefaults->GetVisibleFlag());
+  this->SetCollisionEnabled(pDefaults->GetCollisionEnabled());
+}
+
+void UCesiumGltfPrimitiveComponent::BeginDestroy() {
+  this->ReleaseResources();
   Super::BeginDestroy();
 }
 
+FPrimitiveSceneProxy* UCesiumGltfPrimitiveComponent::CreateSceneProxy() {
+  if (this->InstancesComponent) {
+    return nullptr;
+  }
+  if (this->PulledAttributes) {
+    if (!IsValid(this) || !this->GetPrimitiveRenderData()) {
+      return nullptr;
+    }
+    return new FCesiumVertexPullingSceneProxy(
+        this,
+        this->GetScene()->GetFeatureLevel());
+  }
+  if (this->OwnedRenderData) {
+    if (!IsValid(this)) {
+      return nullptr;
+    }
+    return new FCesiumGltfMeshSceneProxy(
+        this,
+        this->GetScene()->GetFeatureLevel());
+  }
+  return Super::CreateSceneProxy();
+}
+
+UBodySetup* UCesiumGltfPrimitiveComponent::GetBodySetup() {
+  if (!this->GetStaticMesh() && this->OwnedBodySetup) {
+    return this->OwnedBodySetup;
+  }
+  return Super::GetBodySetup();
+}
+
+int32 UCesiumGltfPrimitiveComponent::GetNumMaterials() const {
+  // Without a static mesh, the material is only an override material.
+  if (this->OwnedRenderData) {
+    return this->OverrideMaterials.Num();
+  }
+  return Super::GetNumMaterials();
+}
+
+void UCesiumGltfPrimitiveComponent::GetUsedMaterials(
+    TArray<UMaterialInterface*>& OutMaterials,
+    bool bGetDebugMaterials) const {
+  if (!this->OwnedRenderData) {
+    Super::GetUsedMaterials(OutMaterials, bGetDebugMaterials);
+    return;
+  }
+  for (UMaterialInterface* pMaterial : this->OverrideMaterials) {
+    if (pMaterial) {
+      OutMaterials.Add(pMaterial);
+    }
+  }
+}
+
 FBoxSphereBounds UCesiumGltfPrimitiveComponent::CalcBounds(
     const FTransform& LocalToWorld) const {
   if (!this->boundingVolume) {
@@ -172,3 +439,23 @@ FBoxSphereBounds UCesiumGltfPrimitiveComponent::CalcBounds(
       CalcBoundsOperation{LocalToWorld, this->HighPrecisionNodeTransform},
       *this->boundingVolume);
 }
+
+bool UCesiumGltfPrimitiveComponent::DoCustomNavigableGeometryExport(
+    FNavigableGeometryExport& GeomExport) const {
+  // Instances are exported by their own component.
+  if (!this->NavigationGeometry || this->InstancesComponent) {
+    return Super::DoCustomNavigableGeometryExport(GeomExport);
+  }
+
+  const CesiumNavigationGeometry& geometry = *this->NavigationGeometry;
+  GeomExport.ExportCustomMesh(
+      geometry.vertices.GetData(),
+      geometry.vertices.Num(),
+      geometry.indices.GetData(),
+      geometry.indices.Num(),
+      this->GetComponentTransform());
+
+  // The geometry is complete, so the static mesh's collision isn't exported
+  // too.
+  return false;
+}
@@ -12,16 +12,38 @@
 #include "Components/StaticMeshComponent.h"
 #include "CoreMinimal.h"
 #include "GltfAccessors.h"
+#include "Templates/SharedPointer.h"
 #include <cstdint>
 #include <glm/mat4x4.hpp>
+#include <optional>
 #include <unordered_map>
 #include "CesiumGltfPrimitiveComponent.generated.h"
 
+class CesiumRenderDataBatch;
+class FCesiumGltfAttributeBuffer;
+class FStaticMeshRenderData;
+struct CesiumBakingGeometry;
+struct CesiumNavigationGeometry;
+class CesiumTriangleBvh;
+class UBodySetup;
+class UInstancedStaticMeshComponent;
+
 namespace CesiumGltf {
 struct Model;
 struct MeshPrimitive;
 } // namespace CesiumGltf
 
+/**
+ * The positions and texture coordinates of a face of a glTF primitive, packed
+ * into 64 bytes so that looking up a face touches a single cache line.
+ */
+struct CesiumPickingTriangle {
+  FVector3f Positions[3];
+  FVector2f UVs[3];
+  // Whether the face's vertices and texture coordinates exist.
+  uint32 Valid;
+};
+
 UCLASS()
 class UCesiumGltfPrimitiveComponent : public UStaticMeshComponent {
   GENERATED_BODY()
@@ -102,8 +124,143 @@ public:
    */
   CesiumIndexAccessorType IndexAccessor;
 
+  /**
+   * The positions and texture coordinates of each face of the primitive,
+   * gathered from the accessors above, for each texture coordinate set that
+   * has been used for batched picking. See
+   * UCesiumMetadataPickingBlueprintLibrary::FindUVsFromHits.
+   */
+  std::unordered_map<int32_t, TArray<CesiumPickingTriangle>>
+      PickingTrianglesMap;
+
   std::optional<Cesium3DTilesSelection::BoundingVolume> boundingVolume;
 
+  /**
+   * Whether a physics mesh has already been requested for this primitive by a
+   * tileset that cooks physics meshes on demand. This prevents cooking the
+   * same primitive more than once.
+   */
+  bool PhysicsMeshRequested = false;
+
+  /**
+   * Whether a mesh distance field has already been requested for this
+   * primitive by a tileset that generates them. This prevents building the
+   * same distance field more than once.
+   */
+  bool MeshDistanceFieldRequested = false;
+
+  /**
+   * If the primitive's node uses EXT_mesh_gpu_instancing, the component that
+   * draws its instances. It shares this component's static mesh and
+   * material, and this component isn't drawn or collided with itself.
+   */
+  UPROPERTY(Transient)
+  UInstancedStaticMeshComponent* InstancesComponent = nullptr;
+
+  /**
+   * The vertex attributes of the primitive, copied from its glTF buffer
+   * views, if it's drawn by FCesiumVertexPullingVertexFactory. The static mesh
+   * then only has the primitive's indices and placeholder vertices.
+   */
+  TSharedPtr<FCesiumGltfAttributeBuffer, ESPMode::ThreadSafe> PulledAttributes;
+
+  /**
+   * The render data of the primitive, if it's drawn without a static mesh
+   * because its tileset uses lightweight primitives. The component then has
+   * no static mesh, and its material is set as an override material. Scene
+   * proxies share the render data, so it's released on the render thread
+   * after the last of them is destroyed.
+   */
+  TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe> OwnedRenderData;
+
+  /**
+   * The body setup of a primitive that has no static mesh. Unlike the other
+   * resources of the primitive, it's emptied rather than destroyed when the
+   * component is returned to the pool, and reused for its next primitive.
+   */
+  UPROPERTY(Transient)
+  UBodySetup* OwnedBodySetup = nullptr;
+
+  /**
+   * Makes the given render data this primitive's OwnedRenderData, so that the
+   * primitive is drawn without a static mesh. Its resources are initialized
+   * when the given batch is next flushed. Must be called from the game
+   * thread, before the component is registered.
+   */
+  void SetOwnedRenderData(
+      TUniquePtr<FStaticMeshRenderData>&& RenderData,
+      CesiumRenderDataBatch& Batch);
+
+  /**
+   * Gets the render data that this primitive is drawn from, whether it's
+   * owned by the component or by its static mesh.
+   */
+  const FStaticMeshRenderData* GetPrimitiveRenderData() const;
+
+  /**
+   * The triangles of the primitive, gathered while it was loaded, which are
+   * exported to the navigation system instead of the static mesh's
+   * navigation collision. This is only set if the tileset creates navigation
+   * collision.
+   */
+  TSharedPtr<const CesiumNavigationGeometry, ESPMode::ThreadSafe>
+      NavigationGeometry;
+
+  /**
+   * The hierarchy over the triangles of the primitive, built while it was
+   * loaded, that ACesium3DTileset::SampleHeightsOfLoadedTiles intersects.
+   * This is only set if the tileset enables height queries, and never for
+   * instanced primitives.
+   */
+  TSharedPtr<const CesiumTriangleBvh, ESPMode::ThreadSafe> HeightQueryBvh;
+
+  /**
+   * The triangles of the primitive, gathered while it was loaded, that
+   * ACesium3DTileset::BakeRegionToStaticMeshes turns into a static mesh asset.
+   * This is only set while the tileset is being baked, and never for
+   * instanced primitives.
+   */
+  TSharedPtr<const CesiumBakingGeometry, ESPMode::ThreadSafe> BakingGeometry;
+
+  /**
+   * The baseColorFactor of the primitive's material from before
+   * UCesiumGltfComponent::UpdateDebugColor replaced it, which is restored
+   * when the debug color is removed.
+   */
+  std::optional<FLinearColor> BaseColorFactorBeforeDebugColor;
+
+  /**
+   * Draws this primitive as the given instances, relative to its node,
+   * instead of once. Must be called after the component is registered and
+   * has its static mesh.
+   */
+  void CreateInstances(const TArray<FTransform>& InstanceTransforms);
+
+  /**
+   * Sets whether the primitive can be collided with. For an instanced
+   * primitive, this applies to its instances instead of the component.
+   *
+   * When "Main Thread Physics Time Budget" is set, enabling the collision of
+   * a primitive without a physics state is deferred to the
+   * CesiumPhysicsStateQueue, which creates its physics state in a later
+   * frame. Disabling collision always applies right away.
+   */
+  void SetPrimitiveCollisionEnabled(ECollisionEnabled::Type NewType);
+
+  /**
+   * Applies the collision that SetPrimitiveCollisionEnabled deferred, if it's
+   * still pending.
+   *
+   * @return Whether collision was pending and has been applied.
+   */
+  bool ApplyPendingCollisionEnabled();
+
+  /**
+   * The collision that SetPrimitiveCollisionEnabled deferred until the
+   * primitive's turn in the CesiumPhysicsStateQueue, if any.
+   */
+  std::optional<ECollisionEnabled::Type> PendingCollisionEnabled;
+
   /**
    * Updates this component's transform from a new double-precision
    * transformation from the Cesium world to the Unreal Engine world, as well as
@@ -113,7 +270,33 @@ public:
    */
   void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
 
+  /**
+   * Destroys the static mesh or render data, material, textures, and encoded
+   * metadata that were created for this primitive when it was loaded.
+   */
+  virtual void ReleaseResources();
+
+  /**
+   * Releases this primitive's resources and clears its glTF data, so that the
+   * component can be given the content of another primitive. The component
+   * must already be unregistered.
+   */
+  void PrepareForReuse();
+
   virtual void BeginDestroy() override;
 
+  virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+
   virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const;
+
+  virtual UBodySetup* GetBodySetup() override;
+
+  virtual int32 GetNumMaterials() const override;
+
+  virtual void GetUsedMaterials(
+      TArray<UMaterialInterface*>& OutMaterials,
+      bool bGetDebugMaterials = false) const override;
+
+  virtual bool DoCustomNavigableGeometryExport(
+      FNavigableGeometryExport& GeomExport) const override;
 };
@@ -0,0 +1,470 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumHedgedAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRequestCancellation.h"
+#include "CesiumRuntime.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "Math/UnrealMathUtility.h"
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Hedged Requests"),
+    STAT_CesiumHedgedRequests,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Hedged Requests Won"),
+    STAT_CesiumHedgesWon,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Request Timeouts"),
+    STAT_CesiumRequestTimeouts,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Request Retries"),
+    STAT_CesiumRequestRetries,
+    STATGROUP_Cesium);
+
+namespace {
+
+// The number of recent request latencies that the hedge delay is computed
+// from.
+constexpr size_t LatencySamples = 256;
+
+/**
+ * Calls a function on the game thread once a number of seconds have passed.
+ * This may be called from any thread.
+ */
+void runAfter(double seconds, std::function<void()>&& function) {
+  FTSTicker::GetCoreTicker().AddTicker(
+      FTickerDelegate::CreateLambda(
+          [function = std::move(function)](float /*deltaTime*/) {
+            function();
+            return false;
+          }),
+      float(FMath::Max(seconds, 0.0)));
+}
+
+// Responses with these status codes are for temporary conditions, such as an
+// overloaded server, that may be gone by the time the request is retried.
+bool isRetryableStatus(uint16_t statusCode) {
+  return statusCode == 408 || statusCode == 429 || statusCode == 500 ||
+         statusCode == 502 || statusCode == 503 || statusCode == 504;
+}
+
+} // namespace
+
+/**
+ * A request from the tileset, and the requests that are made for it until one
+ * of them succeeds or the last of them fails.
+ */
+class CesiumHedgedAssetAccessor::PendingRequest
+    : public std::enable_shared_from_this<PendingRequest> {
+public:
+  PendingRequest(
+      const std::shared_ptr<CesiumHedgedAssetAccessor>& pAccessor,
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      std::vector<CesiumAsync::IAssetAccessor::THeader>&& headers,
+      const CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>&
+          promise)
+      : _pAccessor(pAccessor),
+        _asyncSystem(asyncSystem),
+        _url(url),
+        _headers(std::move(headers)),
+        _promise(promise),
+        _startTime(FPlatformTime::Seconds()) {}
+
+  /**
+   * Makes the first request, and schedules its hedge.
+   *
+   * @param group The request group of the tileset's request, if it has one.
+   * @return False if the group has already been cancelled.
+   */
+  bool start(const std::optional<uint64_t>& group) {
+    if (group) {
+      this->_group = group;
+      this->_cancellationHandle = CesiumRequestCancellation::registerRequest(
+          *group,
+          [pWeakThis = std::weak_ptr<PendingRequest>(
+               this->shared_from_this())]() -> int64_t {
+            std::shared_ptr<PendingRequest> pThis = pWeakThis.lock();
+            if (pThis) {
+              pThis->cancel();
+            }
+            return 0;
+          });
+      if (!this->_cancellationHandle) {
+        return false;
+      }
+    }
+
+    this->attempt(false);
+
+    const double hedgeDelay = this->_pAccessor->getHedgeDelay();
+    if (hedgeDelay >= 0.0) {
+      runAfter(hedgeDelay, [pThis = this->shared_from_this()]() {
+        pThis->hedge();
+      });
+    }
+
+    return true;
+  }
+
+private:
+  void attempt(bool isHedge) {
+    const Options& options = this->_pAccessor->_options;
+    const uint64_t group = CesiumRequestCancellation::createGroup();
+    std::string url = this->_url;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if (this->_done) {
+        return;
+      }
+      this->_attemptGroups.emplace_back(group);
+      if (isHedge && !options.hedgeOrigins.empty()) {
+        url = replaceOrigin(
+            url,
+            options.hedgeOrigins
+                [this->_hedgeCount++ % options.hedgeOrigins.size()]);
+      }
+    }
+
+    std::vector<CesiumAsync::IAssetAccessor::THeader> headers = this->_headers;
+    headers.emplace_back(
+        CesiumRequestCancellation::groupHeader,
+        std::to_string(group));
+
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor =
+        isHedge ? this->_pAccessor->_pHedgeAssetAccessor
+                : this->_pAccessor->_pAssetAccessor;
+    std::shared_ptr<PendingRequest> pThis = this->shared_from_this();
+    pAssetAccessor->get(this->_asyncSystem, url, headers)
+        .thenImmediately(
+            [pThis, group, isHedge](
+                std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+              pThis->complete(group, isHedge, std::move(pRequest));
+            })
+        .catchImmediately([pThis, group](std::exception&& e) {
+          pThis->fail(group, std::runtime_error(e.what()));
+        });
+
+    if (options.timeout > 0.0) {
+      runAfter(options.timeout, [pThis, group]() { pThis->timeOut(group); });
+    }
+  }
+
+  void hedge() {
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      // Requests that are being retried are already being handled.
+      if (this->_done || this->_retries > 0 ||
+          this->_attemptGroups.size() != 1) {
+        return;
+      }
+    }
+
+    ++this->_pAccessor->_hedgedRequestCount;
+    INC_DWORD_STAT(STAT_CesiumHedgedRequests);
+    this->attempt(true);
+  }
+
+  // Removes an attempt that has finished, and returns false if it was
+  // already finished, such as because it timed out.
+  bool removeAttempt(uint64_t group) {
+    auto it = std::find(
+        this->_attemptGroups.begin(),
+        this->_attemptGroups.end(),
+        group);
+    if (it == this->_attemptGroups.end()) {
+      return false;
+    }
+    this->_attemptGroups.erase(it);
+    return true;
+  }
+
+  void complete(
+      uint64_t group,
+      bool isHedge,
+      std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+    CesiumRequestCancellation::releaseGroup(group);
+
+    const CesiumAsync::IAssetResponse* pResponse =
+        pRequest ? pRequest->response() : nullptr;
+    const bool retryable =
+        pResponse && isRetryableStatus(pResponse->statusCode());
+
+    std::vector<uint64_t> otherGroups;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if (!this->removeAttempt(group)) {
+        return;
+      }
+
+      if (retryable) {
+        // Another attempt that is still in flight may yet succeed.
+        if (!this->_attemptGroups.empty()) {
+          return;
+        }
+        if (this->scheduleRetry()) {
+          return;
+        }
+      }
+
+      this->_done = true;
+      otherGroups = std::move(this->_attemptGroups);
+      this->_attemptGroups.clear();
+
+      if (!retryable && this->_retries == 0) {
+        this->_pAccessor->recordLatency(
+            FPlatformTime::Seconds() - this->_startTime);
+      }
+    }
+
+    if (isHedge) {
+      ++this->_pAccessor->_hedgesWonCount;
+      INC_DWORD_STAT(STAT_CesiumHedgesWon);
+    }
+
+    this->finish(std::move(otherGroups));
+    this->_promise.resolve(std::move(pRequest));
+  }
+
+  void fail(uint64_t group, std::runtime_error&& error) {
+    CesiumRequestCancellation::releaseGroup(group);
+
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if (!this->removeAttempt(group) || !this->_attemptGroups.empty() ||
+          this->scheduleRetry()) {
+        return;
+      }
+      this->_done = true;
+    }
+
+    this->finish({});
+    this->_promise.reject(std::move(error));
+  }
+
+  void timeOut(uint64_t group) {
+    bool timedOut;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if (!this->removeAttempt(group)) {
+        return;
+      }
+      ++this->_pAccessor->_timedOutCount;
+      INC_DWORD_STAT(STAT_CesiumRequestTimeouts);
+
+      // The attempt is forgotten even if it can't be cancelled, such as while
+      // it waits to be sent, so that a retry doesn't wait for it.
+      timedOut = this->_attemptGroups.empty() && !this->scheduleRetry();
+      this->_done = timedOut;
+    }
+
+    CesiumRequestCancellation::cancelGroup(group);
+    CesiumRequestCancellation::releaseGroup(group);
+
+    if (timedOut) {
+      this->finish({});
+      this->_promise.reject(std::runtime_error("Request timed out."));
+    }
+  }
+
+  // Called when the tileset's request group is cancelled.
+  void cancel() {
+    std::vector<uint64_t> groups;
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      if (this->_done) {
+        return;
+      }
+      this->_done = true;
+      groups = std::move(this->_attemptGroups);
+      this->_attemptGroups.clear();
+    }
+
+    this->_cancellationHandle.reset();
+    for (uint64_t group : groups) {
+      CesiumRequestCancellation::cancelGroup(group);
+      CesiumRequestCancellation::releaseGroup(group);
+    }
+    this->_promise.reject(std::runtime_error("Request cancelled."));
+  }
+
+  // Schedules the next retry, if there are any left. The mutex must be held.
+  bool scheduleRetry() {
+    const Options& options = this->_pAccessor->_options;
+    if (this->_retries >= options.maximumRetries) {
+      return false;
+    }
+
+    // Each retry waits twice as long as the last, give or take a quarter, so
+    // that the requests that failed together aren't all retried together.
+    const double delay = options.retryDelay *
+                         double(int64_t(1) << FMath::Min(this->_retries, 16)) *
+                         FMath::FRandRange(0.75, 1.25);
+    ++this->_retries;
+    ++this->_pAccessor->_retryCount;
+    INC_DWORD_STAT(STAT_CesiumRequestRetries);
+
+    runAfter(delay, [pThis = this->shared_from_this()]() {
+      pThis->attempt(false);
+    });
+    return true;
+  }
+
+  // Stops tracking the tileset's request, and cancels the attempts that are
+  // no longer needed.
+  void finish(std::vector<uint64_t>&& otherGroups) {
+    if (this->_group && this->_cancellationHandle) {
+      CesiumRequestCancellation::unregisterRequest(
+          *this->_group,
+          *this->_cancellationHandle);
+    }
+
+    if (!otherGroups.empty()) {
+      this->_asyncSystem.runInMainThread(
+          [otherGroups = std::move(otherGroups)]() {
+            for (uint64_t group : otherGroups) {
+              CesiumRequestCancellation::cancelGroup(group);
+              CesiumRequestCancellation::releaseGroup(group);
+            }
+          });
+    }
+  }
+
+  std::shared_ptr<CesiumHedgedAssetAccessor> _pAccessor;
+  CesiumAsync::AsyncSystem _asyncSystem;
+  std::string _url;
+  std::vector<CesiumAsync::IAssetAccessor::THeader> _headers;
+  CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> _promise;
+  double _startTime;
+  std::optional<uint64_t> _group;
+  std::optional<uint64_t> _cancellationHandle;
+
+  std::mutex _mutex;
+  // The request groups of the attempts in flight.
+  std::vector<uint64_t> _attemptGroups;
+  int32_t _retries = 0;
+  size_t _hedgeCount = 0;
+  bool _done = false;
+};
+
+CesiumHedgedAssetAccessor::CesiumHedgedAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pHedgeAssetAccessor,
+    const Options& options)
+    : _pAssetAccessor(pAssetAccessor),
+      _pHedgeAssetAccessor(pHedgeAssetAccessor),
+      _options(options),
+      _mutex(),
+      _latencies(),
+      _nextLatency(0),
+      _hedgedRequestCount(0),
+      _hedgesWonCount(0),
+      _timedOutCount(0),
+      _retryCount(0) {}
+
+/*static*/ std::string CesiumHedgedAssetAccessor::replaceOrigin(
+    const std::string& url,
+    const std::string& origin) {
+  const size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string::npos) {
+    return url;
+  }
+  const size_t hostEnd = url.find_first_of("/?#", schemeEnd + 3);
+
+  std::string newOrigin = origin;
+  while (!newOrigin.empty() && newOrigin.back() == '/') {
+    newOrigin.pop_back();
+  }
+  return hostEnd == std::string::npos ? newOrigin
+                                      : newOrigin + url.substr(hostEnd);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumHedgedAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (!this->_options.hedge && this->_options.timeout <= 0.0 &&
+      this->_options.maximumRetries <= 0) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders = headers;
+  std::optional<uint64_t> group =
+      CesiumRequestCancellation::extractGroup(requestHeaders);
+
+  CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+  std::shared_ptr<PendingRequest> pPending = std::make_shared<PendingRequest>(
+      this->shared_from_this(),
+      asyncSystem,
+      url,
+      std::move(requestHeaders),
+      promise);
+  if (!pPending->start(group)) {
+    CesiumRequestCancellation::recordRequestNotSent();
+    promise.reject(std::runtime_error("Request cancelled."));
+  }
+
+  return promise.getFuture();
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumHedgedAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumHedgedAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+double CesiumHedgedAssetAccessor::getHedgeDelay() const {
+  if (!this->_options.hedge) {
+    return -1.0;
+  }
+
+  std::vector<double> latencies;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_latencies.size() < MinimumLatencySamples) {
+      return -1.0;
+    }
+    latencies = this->_latencies;
+  }
+
+  const double fraction =
+      FMath::Clamp(this->_options.hedgePercentile / 100.0, 0.0, 1.0);
+  const size_t index = FMath::Min(
+      size_t(fraction * double(latencies.size())),
+      latencies.size() - 1);
+  std::nth_element(
+      latencies.begin(),
+      latencies.begin() + index,
+      latencies.end());
+  return FMath::Max(latencies[index], this->_options.minimumHedgeDelay);
+}
+
+void CesiumHedgedAssetAccessor::recordLatency(double seconds) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (this->_latencies.size() < LatencySamples) {
+    this->_latencies.emplace_back(seconds);
+  } else {
+    this->_latencies[this->_nextLatency] = seconds;
+    this->_nextLatency = (this->_nextLatency + 1) % LatencySamples;
+  }
+}
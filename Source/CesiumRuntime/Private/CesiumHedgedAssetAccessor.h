@@ -0,0 +1,168 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * An asset accessor that limits how long a tileset waits for its slowest
+ * requests, for ACesium3DTileset::EnableHedgedRequests, RequestTimeout, and
+ * MaximumRequestRetries.
+ *
+ * When hedging is enabled, a request that hasn't completed within a
+ * percentile of the latencies of the tileset's recent requests is made again,
+ * to an alternate host if any are given, and whichever response arrives first
+ * is used while the other request is cancelled. Requests that take longer
+ * than the timeout are cancelled, and requests that fail, time out, or
+ * receive a response that indicates a temporary server error are retried
+ * after a delay that doubles each time.
+ *
+ * This accessor must be given requests that are in a request group, from a
+ * {@link CesiumRequestGroupAssetAccessor}. Each request it makes is put in a
+ * request group of its own, so that it can be cancelled on its own, and all
+ * of them are cancelled when the original group is.
+ */
+class CesiumHedgedAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CesiumHedgedAssetAccessor> {
+public:
+  struct Options {
+    /**
+     * Whether to make a second request for requests that take longer than
+     * usual.
+     */
+    bool hedge = false;
+
+    /**
+     * The percentile of recent request latencies after which a request is
+     * hedged.
+     */
+    double hedgePercentile = 95.0;
+
+    /**
+     * The shortest time, in seconds, after which a request is hedged.
+     */
+    double minimumHedgeDelay = 0.25;
+
+    /**
+     * The schemes and hosts, such as "https://mirror.example.com", that hedged
+     * requests are made to instead of the original host, in turn. If this is
+     * empty, they're made to the original URL.
+     */
+    std::vector<std::string> hedgeOrigins;
+
+    /**
+     * The time, in seconds, after which a request is cancelled, or 0 if
+     * requests don't time out.
+     */
+    double timeout = 0.0;
+
+    /**
+     * The number of times a failed request is retried.
+     */
+    int32_t maximumRetries = 0;
+
+    /**
+     * The time, in seconds, before a failed request is first retried. It
+     * doubles for each retry after that.
+     */
+    double retryDelay = 0.5;
+  };
+
+  /**
+   * The least number of completed requests whose latencies are needed before
+   * any request is hedged.
+   */
+  static constexpr size_t MinimumLatencySamples = 16;
+
+  /**
+   * @param pAssetAccessor The accessor that performs the requests.
+   * @param pHedgeAssetAccessor The accessor that performs hedged requests.
+   * This shouldn't share a request in flight with another request for the
+   * same URL, such as a CesiumCoalescingAssetAccessor does, or a hedged
+   * request to the original URL would only wait for the slow one.
+   * @param options The options.
+   *
+   * Instances must be created with std::make_shared.
+   */
+  CesiumHedgedAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pHedgeAssetAccessor,
+      const Options& options);
+
+  /**
+   * Replaces the scheme and host of a URL with another, or returns it
+   * unchanged if it doesn't have a host.
+   */
+  static std::string
+  replaceOrigin(const std::string& url, const std::string& origin);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Gets the time, in seconds, after which requests are currently hedged, or
+   * a negative number if they aren't.
+   */
+  double getHedgeDelay() const;
+
+  /**
+   * Gets the number of hedged requests that were made.
+   */
+  int64_t getHedgedRequestCount() const { return this->_hedgedRequestCount; }
+
+  /**
+   * Gets the number of hedged requests whose responses arrived first.
+   */
+  int64_t getHedgesWonCount() const { return this->_hedgesWonCount; }
+
+  /**
+   * Gets the number of requests that were cancelled because they timed out.
+   */
+  int64_t getTimedOutCount() const { return this->_timedOutCount; }
+
+  /**
+   * Gets the number of requests that were retried.
+   */
+  int64_t getRetryCount() const { return this->_retryCount; }
+
+private:
+  class PendingRequest;
+
+  void recordLatency(double seconds);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pHedgeAssetAccessor;
+  Options _options;
+
+  mutable std::mutex _mutex;
+  // The latencies of the most recent requests that succeeded on their first
+  // attempt, in seconds, as a ring buffer.
+  std::vector<double> _latencies;
+  size_t _nextLatency;
+
+  std::atomic<int64_t> _hedgedRequestCount;
+  std::atomic<int64_t> _hedgesWonCount;
+  std::atomic<int64_t> _timedOutCount;
+  std::atomic<int64_t> _retryCount;
+};
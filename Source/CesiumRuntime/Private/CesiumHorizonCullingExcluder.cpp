@@ -0,0 +1,103 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumHorizonCullingExcluder.h"
+#include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include <glm/geometric.hpp>
+#include <array>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace {
+
+using Corners = std::array<glm::dvec3, 8>;
+
+Corners getCorners(const OrientedBoundingBox& box) {
+  const glm::dvec3& center = box.getCenter();
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+  Corners corners;
+  for (size_t i = 0; i < corners.size(); ++i) {
+    corners[i] = center + ((i & 1) ? halfAxes[0] : -halfAxes[0]) +
+                 ((i & 2) ? halfAxes[1] : -halfAxes[1]) +
+                 ((i & 4) ? halfAxes[2] : -halfAxes[2]);
+  }
+  return corners;
+}
+
+struct CornersOperation {
+  Corners operator()(const BoundingSphere& sphere) const {
+    return getCorners(OrientedBoundingBox(
+        sphere.getCenter(),
+        glm::dmat3(sphere.getRadius())));
+  }
+
+  Corners operator()(const OrientedBoundingBox& box) const {
+    return getCorners(box);
+  }
+
+  Corners operator()(const BoundingRegion& region) const {
+    return getCorners(region.getBoundingBox());
+  }
+
+  Corners
+  operator()(const BoundingRegionWithLooseFittingHeights& region) const {
+    return getCorners(region.getBoundingRegion().getBoundingBox());
+  }
+
+  Corners operator()(const S2CellBoundingVolume& s2) const {
+    return getCorners(s2.computeBoundingRegion().getBoundingBox());
+  }
+};
+
+} // namespace
+
+void CesiumHorizonCullingExcluder::setViews(
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  this->_horizons.clear();
+
+  const glm::dvec3& radii = Ellipsoid::WGS84.getRadii();
+  for (const Cesium3DTilesSelection::ViewState& view : views) {
+    const glm::dvec3 position = view.getPosition() / radii;
+    const double distanceSquared = glm::dot(position, position) - 1.0;
+    if (distanceSquared <= 0.0) {
+      // A view below the surface sees past the horizon of the ellipsoid's
+      // surface, so no tile is known to be hidden from every view.
+      this->_horizons.clear();
+      return;
+    }
+    this->_horizons.push_back({position, distanceSquared});
+  }
+}
+
+bool CesiumHorizonCullingExcluder::shouldExclude(
+    const Cesium3DTilesSelection::Tile& tile) const noexcept {
+  if (this->_horizons.empty()) {
+    return false;
+  }
+
+  const glm::dvec3& radii = Ellipsoid::WGS84.getRadii();
+  const Corners corners =
+      std::visit(CornersOperation{}, tile.getBoundingVolume());
+
+  for (const Horizon& horizon : this->_horizons) {
+    for (const glm::dvec3& corner : corners) {
+      // A point is hidden if it's beyond the horizon plane, and inside of the
+      // cone from the view that touches the sphere.
+      const glm::dvec3 toCorner = corner / radii - horizon.position;
+      const double distanceBeyondView = -glm::dot(toCorner, horizon.position);
+      const bool isHidden =
+          distanceBeyondView > horizon.distanceSquared &&
+          distanceBeyondView * distanceBeyondView /
+                  glm::dot(toCorner, toCorner) >
+              horizon.distanceSquared;
+      if (!isHidden) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
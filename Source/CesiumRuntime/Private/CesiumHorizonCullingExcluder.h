@@ -0,0 +1,52 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Cesium3DTilesSelection/ITileExcluder.h"
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+class ViewState;
+} // namespace Cesium3DTilesSelection
+
+/**
+ * Excludes the tiles that are hidden behind the WGS84 ellipsoid from every
+ * view, so that views from high above the globe don't visit or load the
+ * tiles on the far side of it.
+ *
+ * A tile is hidden if all of the corners of the box around its bounding
+ * volume are beyond the horizon of each view, which is tested in the scaled
+ * space where the ellipsoid is the unit sphere, the same way as CesiumJS's
+ * EllipsoidalOccluder. The region hidden by a sphere from a point is convex,
+ * so the whole box is then hidden too. Nothing is excluded while any view is
+ * below the surface of the ellipsoid.
+ *
+ * Bounding volumes are assumed to be in Earth-Centered, Earth-Fixed
+ * coordinates, so this is only correct for tilesets that are placed on the
+ * globe.
+ */
+class CesiumHorizonCullingExcluder
+    : public Cesium3DTilesSelection::ITileExcluder {
+public:
+  /**
+   * Sets the views that tiles must be hidden from to be excluded. This must
+   * be called before each update of the tileset's view.
+   */
+  void setViews(const std::vector<Cesium3DTilesSelection::ViewState>& views);
+
+  virtual bool shouldExclude(
+      const Cesium3DTilesSelection::Tile& tile) const noexcept override;
+
+private:
+  struct Horizon {
+    // The position of the view in scaled space.
+    glm::dvec3 position;
+    // The squared distance from the view to its horizon plane in scaled
+    // space, which is the squared length of a tangent to the unit sphere.
+    double distanceSquared;
+  };
+
+  std::vector<Horizon> _horizons;
+};
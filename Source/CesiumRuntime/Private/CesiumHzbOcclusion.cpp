@@ -0,0 +1,320 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumHzbOcclusion.h"
+#include "CesiumRuntime.h"
+#include "CoreGlobals.h"
+#include "GlobalShader.h"
+#include "RHIGPUReadback.h"
+#include "RHIStaticStates.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderingThread.h"
+#include "Runtime/Renderer/Private/ScenePrivate.h"
+#include "SceneView.h"
+#include "ShaderParameterStruct.h"
+
+namespace {
+
+constexpr int32 ThreadGroupSize = 64;
+
+// If the GPU falls this far behind, stop testing boxes until it catches up,
+// rather than queueing ever more readbacks.
+constexpr int32 MaximumPendingReadbacks = 8;
+
+int32 getWordCount(int32 boxCount) { return (boxCount + 31) / 32; }
+
+} // namespace
+
+class FCesiumTileOcclusionCS : public FGlobalShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumTileOcclusionCS);
+  SHADER_USE_PARAMETER_STRUCT(FCesiumTileOcclusionCS, FGlobalShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER(uint32, NumBoxes)
+  SHADER_PARAMETER(FMatrix44f, TranslatedWorldToClip)
+  SHADER_PARAMETER(FVector2f, HZBUvFactor)
+  SHADER_PARAMETER(FVector2f, HZBSize)
+  SHADER_PARAMETER(float, HZBMaxMip)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture2D, HZBTexture)
+  SHADER_PARAMETER_SAMPLER(SamplerState, HZBSampler)
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, BoxCenters)
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, BoxExtents)
+  SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint>, RWVisibleBits)
+  END_SHADER_PARAMETER_STRUCT()
+
+  static bool ShouldCompilePermutation(
+      const FGlobalShaderPermutationParameters& Parameters) {
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+  }
+};
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumTileOcclusionCS,
+    "/Plugin/CesiumForUnreal/Private/CesiumTileOcclusion.usf",
+    "MainCS",
+    SF_Compute);
+
+CesiumHzbOcclusion::CesiumHzbOcclusion() {}
+
+CesiumHzbOcclusion::~CesiumHzbOcclusion() {}
+
+uint32 CesiumHzbOcclusion::registerPool() {
+  check(IsInGameThread());
+
+  const uint32 poolId = this->_nextPoolId++;
+  this->_resultsByPool.Add(poolId);
+  return poolId;
+}
+
+void CesiumHzbOcclusion::unregisterPool(uint32 poolId) {
+  check(IsInGameThread());
+  this->_resultsByPool.Remove(poolId);
+}
+
+void CesiumHzbOcclusion::addBox(uint32 poolId, uint32 slot, const FBox& box) {
+  check(IsInGameThread());
+
+  // Boxes added in a frame that was never rendered are stale by now.
+  if (this->_pendingBoxesFrame != GFrameCounter) {
+    this->_pendingBoxes = BoxSet();
+    this->_pendingBoxesFrame = GFrameCounter;
+  }
+
+  this->_pendingBoxes.boxes.Add(box);
+  this->_pendingBoxes.poolIds.Add(poolId);
+  this->_pendingBoxes.slots.Add(slot);
+}
+
+TArrayView<const CesiumHzbOcclusion::SlotResult>
+CesiumHzbOcclusion::getResults(uint32 poolId) const {
+  check(IsInGameThread());
+
+  const TArray<SlotResult>* pResults = this->_resultsByPool.Find(poolId);
+  return pResults ? TArrayView<const SlotResult>(*pResults)
+                  : TArrayView<const SlotResult>();
+}
+
+void CesiumHzbOcclusion::beginRenderViewFamily() {
+  check(IsInGameThread());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DequeueHzbOcclusionResults)
+
+  VisibilityResults results;
+  while (this->_resultsQueue.Dequeue(results)) {
+    this->applyResults(results);
+  }
+
+  // Tilesets add their boxes as they tick, so the first view family rendered
+  // in a frame sends them, and the rest test the same ones.
+  if (this->_lastSubmittedFrame == GFrameCounter) {
+    return;
+  }
+  this->_lastSubmittedFrame = GFrameCounter;
+
+  BoxSetPtr pBoxes;
+  if (this->_pendingBoxesFrame == GFrameCounter &&
+      this->_pendingBoxes.boxes.Num() > 0) {
+    this->_pendingBoxes.submission = this->_nextSubmission;
+    pBoxes = MakeShared<BoxSet, ESPMode::ThreadSafe>(
+        MoveTemp(this->_pendingBoxes));
+    this->_pendingBoxes = BoxSet();
+  }
+  ++this->_nextSubmission;
+
+  ENQUEUE_RENDER_COMMAND(CesiumSetHzbOcclusionBoxes)
+  ([this, pBoxes = MoveTemp(pBoxes)](FRHICommandListImmediate& RHICmdList) {
+    this->_pBoxes_renderThread = pBoxes;
+  });
+}
+
+void CesiumHzbOcclusion::postRenderViewFamily_RenderThread(
+    FRHICommandListImmediate& RHICmdList,
+    const FSceneViewFamily& viewFamily) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TestHzbOcclusion)
+
+  this->pollReadbacks_RenderThread();
+
+  if (!this->_pBoxes_renderThread ||
+      this->_pendingReadbacks_renderThread.Num() >= MaximumPendingReadbacks) {
+    return;
+  }
+
+  // Only views that kept an HZB from their previous frame can be tested.
+  TArray<const FSceneViewState*, TInlineAllocator<4>> viewStates;
+  for (const FSceneView* pView : viewFamily.Views) {
+    if (pView == nullptr || pView->State == nullptr)
+      continue;
+
+    const FSceneViewState* pViewState = pView->State->GetConcreteViewState();
+    if (pViewState && pViewState->PrevFrameViewInfo.HZB.IsValid()) {
+      viewStates.Add(pViewState);
+    }
+  }
+
+  if (viewStates.Num() == 0) {
+    return;
+  }
+
+  const BoxSet& boxes = *this->_pBoxes_renderThread;
+  const int32 boxCount = boxes.boxes.Num();
+  const int32 wordCount = getWordCount(boxCount);
+
+  FRDGBuilder graphBuilder(RHICmdList);
+
+  FRDGBufferRef pVisibleBits = graphBuilder.CreateBuffer(
+      FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32), wordCount),
+      TEXT("CesiumTileOcclusionVisibleBits"));
+  FRDGBufferUAVRef pVisibleBitsUAV = graphBuilder.CreateUAV(pVisibleBits);
+  AddClearUAVPass(graphBuilder, pVisibleBitsUAV, 0u);
+
+  // The extents are the same for every view, but each view has its own
+  // translated world space.
+  TArray<FVector4f> centers;
+  TArray<FVector4f> extents;
+  centers.SetNumUninitialized(boxCount);
+  extents.SetNumUninitialized(boxCount);
+  for (int32 i = 0; i < boxCount; ++i) {
+    extents[i] = FVector4f(FVector3f(boxes.boxes[i].GetExtent()), 0.0f);
+  }
+
+  FRDGBufferSRVRef pExtentsSRV =
+      graphBuilder.CreateSRV(CreateStructuredBuffer(
+          graphBuilder,
+          TEXT("CesiumTileOcclusionBoxExtents"),
+          sizeof(FVector4f),
+          boxCount,
+          extents.GetData(),
+          extents.Num() * sizeof(FVector4f)));
+
+  TShaderMapRef<FCesiumTileOcclusionCS> shader(
+      GetGlobalShaderMap(viewFamily.GetFeatureLevel()));
+
+  for (const FSceneViewState* pViewState : viewStates) {
+    // The HZB was built from the previous frame, so it must be tested with
+    // that frame's matrices.
+    const FPreviousViewInfo& previous = pViewState->PrevFrameViewInfo;
+    const FViewMatrices& matrices = previous.ViewMatrices;
+    const FVector preViewTranslation = matrices.GetPreViewTranslation();
+
+    for (int32 i = 0; i < boxCount; ++i) {
+      centers[i] = FVector4f(
+          FVector3f(boxes.boxes[i].GetCenter() + preViewTranslation),
+          0.0f);
+    }
+
+    FRDGTextureRef pHZB = graphBuilder.RegisterExternalTexture(previous.HZB);
+    const FIntPoint hzbSize = pHZB->Desc.Extent;
+    const FIntPoint viewSize = previous.ViewRect.Size();
+
+    FCesiumTileOcclusionCS::FParameters* pParameters =
+        graphBuilder.AllocParameters<FCesiumTileOcclusionCS::FParameters>();
+    pParameters->NumBoxes = uint32(boxCount);
+    pParameters->TranslatedWorldToClip =
+        FMatrix44f(matrices.GetTranslatedViewProjectionMatrix());
+    pParameters->HZBUvFactor = FVector2f(
+        float(viewSize.X) / float(2 * hzbSize.X),
+        float(viewSize.Y) / float(2 * hzbSize.Y));
+    pParameters->HZBSize = FVector2f(hzbSize);
+    pParameters->HZBMaxMip = float(pHZB->Desc.NumMips - 1);
+    pParameters->HZBTexture = pHZB;
+    pParameters->HZBSampler =
+        TStaticSamplerState<SF_Point, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+    pParameters->BoxCenters = graphBuilder.CreateSRV(CreateStructuredBuffer(
+        graphBuilder,
+        TEXT("CesiumTileOcclusionBoxCenters"),
+        sizeof(FVector4f),
+        boxCount,
+        centers.GetData(),
+        centers.Num() * sizeof(FVector4f)));
+    pParameters->BoxExtents = pExtentsSRV;
+    pParameters->RWVisibleBits = pVisibleBitsUAV;
+
+    FComputeShaderUtils::AddPass(
+        graphBuilder,
+        RDG_EVENT_NAME("CesiumTileOcclusion"),
+        shader,
+        pParameters,
+        FComputeShaderUtils::GetGroupCount(boxCount, ThreadGroupSize));
+  }
+
+  PendingReadback& pending =
+      this->_pendingReadbacks_renderThread.Emplace_GetRef();
+  pending.pBoxes = this->_pBoxes_renderThread;
+  pending.pReadback = MakeUnique<FRHIGPUBufferReadback>(
+      TEXT("CesiumTileOcclusionReadback"));
+  AddEnqueueCopyPass(
+      graphBuilder,
+      pending.pReadback.Get(),
+      pVisibleBits,
+      wordCount * sizeof(uint32));
+
+  graphBuilder.Execute();
+}
+
+void CesiumHzbOcclusion::applyResults(const VisibilityResults& results) {
+  const BoxSet& boxes = *results.pBoxes;
+  for (int32 i = 0; i < boxes.boxes.Num(); ++i) {
+    // The pool may have been unregistered since its boxes were added.
+    TArray<SlotResult>* pResults = this->_resultsByPool.Find(boxes.poolIds[i]);
+    if (!pResults) {
+      continue;
+    }
+
+    const int32 slot = int32(boxes.slots[i]);
+    if (slot >= pResults->Num()) {
+      pResults->SetNum(slot + 1);
+    }
+
+    SlotResult& result = (*pResults)[slot];
+    result.submission = boxes.submission;
+    result.visible = (results.visibleBits[i / 32] & (1u << (i % 32))) != 0;
+  }
+}
+
+void CesiumHzbOcclusion::pollReadbacks_RenderThread() {
+  // Readbacks complete in the order they were enqueued.
+  while (this->_pendingReadbacks_renderThread.Num() > 0 &&
+         this->_pendingReadbacks_renderThread[0].pReadback->IsReady()) {
+    PendingReadback pending =
+        MoveTemp(this->_pendingReadbacks_renderThread[0]);
+    this->_pendingReadbacks_renderThread.RemoveAt(0);
+
+    const int32 wordCount = getWordCount(pending.pBoxes->boxes.Num());
+    const uint32* pWords = static_cast<const uint32*>(
+        pending.pReadback->Lock(wordCount * sizeof(uint32)));
+
+    VisibilityResults& accumulated = this->_accumulatedResults_renderThread;
+    if (accumulated.pBoxes != pending.pBoxes) {
+      this->flushResults_RenderThread();
+      accumulated.pBoxes = pending.pBoxes;
+      accumulated.visibleBits.Append(pWords, wordCount);
+    } else {
+      for (int32 i = 0; i < wordCount; ++i) {
+        accumulated.visibleBits[i] |= pWords[i];
+      }
+    }
+
+    pending.pReadback->Unlock();
+  }
+
+  // Send the accumulated results once no other view family will test the
+  // same boxes.
+  const BoxSetPtr& pAccumulatedBoxes =
+      this->_accumulatedResults_renderThread.pBoxes;
+  if (pAccumulatedBoxes && pAccumulatedBoxes != this->_pBoxes_renderThread &&
+      !this->_pendingReadbacks_renderThread.ContainsByPredicate(
+          [&pAccumulatedBoxes](const PendingReadback& pending) {
+            return pending.pBoxes == pAccumulatedBoxes;
+          })) {
+    this->flushResults_RenderThread();
+  }
+}
+
+void CesiumHzbOcclusion::flushResults_RenderThread() {
+  if (this->_accumulatedResults_renderThread.pBoxes) {
+    this->_resultsQueue.Enqueue(
+        MoveTemp(this->_accumulatedResults_renderThread));
+  }
+  this->_accumulatedResults_renderThread = VisibilityResults();
+}
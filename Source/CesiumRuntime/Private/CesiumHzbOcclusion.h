@@ -0,0 +1,142 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Containers/Queue.h"
+#include "Math/Box.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+#include <cstdint>
+
+class FRHICommandListImmediate;
+class FRHIGPUBufferReadback;
+class FSceneViewFamily;
+
+/**
+ * Tests tile bounding boxes for occlusion against the hierarchical Z-buffer
+ * (HZB) of every view that renders them, in a compute shader.
+ *
+ * Each frame, tile occlusion proxy pools add the boxes of the tiles they're
+ * mapped to. The boxes are tested in each view family's post-render, against
+ * the HZB each view kept from its previous frame. The results are one bit per
+ * box, which are read back asynchronously and made available to the pools on
+ * the game thread a few frames later.
+ *
+ * A box is visible if it's visible in any view, and occluded only if it's
+ * hidden or outside the frustum in all of them.
+ */
+class CesiumHzbOcclusion {
+public:
+  /**
+   * The result of testing a single slot of a pool.
+   */
+  struct SlotResult {
+    /**
+     * The submission that this result is from, or 0 if the slot hasn't been
+     * tested yet.
+     */
+    uint64 submission = 0;
+
+    /**
+     * Whether the slot's box was visible in any view.
+     */
+    bool visible = false;
+  };
+
+  CesiumHzbOcclusion();
+  ~CesiumHzbOcclusion();
+
+  /**
+   * Registers a new pool of boxes, and returns its ID. Must be called from the
+   * game thread.
+   */
+  uint32 registerPool();
+
+  /**
+   * Unregisters a pool of boxes and discards its results. Must be called from
+   * the game thread.
+   */
+  void unregisterPool(uint32 poolId);
+
+  /**
+   * Gets the index of the submission that boxes added now will be part of.
+   * Results from this submission or later reflect boxes added from now on.
+   */
+  uint64 getNextSubmission() const { return this->_nextSubmission; }
+
+  /**
+   * Adds a box in Unreal world coordinates to be tested this frame, for the
+   * given slot of the given pool. Must be called from the game thread.
+   */
+  void addBox(uint32 poolId, uint32 slot, const FBox& box);
+
+  /**
+   * Gets the latest results for each slot of the given pool, indexed by slot.
+   * Slots that have never been tested may be missing from the end. Must be
+   * called from the game thread.
+   */
+  TArrayView<const SlotResult> getResults(uint32 poolId) const;
+
+  /**
+   * Applies results that have been read back since the last call, and sends
+   * the boxes added since then to the render thread. Must be called from the
+   * game thread before each view family is rendered.
+   */
+  void beginRenderViewFamily();
+
+  /**
+   * Tests the current boxes against the HZBs of the views in the given family,
+   * and polls for results from previous tests. Must be called from the render
+   * thread after the view family is rendered.
+   */
+  void postRenderViewFamily_RenderThread(
+      FRHICommandListImmediate& RHICmdList,
+      const FSceneViewFamily& viewFamily);
+
+private:
+  // The boxes added during a single frame.
+  struct BoxSet {
+    uint64 submission = 0;
+    TArray<FBox> boxes;
+    TArray<uint32> poolIds;
+    TArray<uint32> slots;
+  };
+
+  using BoxSetPtr = TSharedPtr<const BoxSet, ESPMode::ThreadSafe>;
+
+  struct PendingReadback {
+    BoxSetPtr pBoxes;
+    TUniquePtr<FRHIGPUBufferReadback> pReadback;
+  };
+
+  struct VisibilityResults {
+    BoxSetPtr pBoxes;
+    TArray<uint32> visibleBits;
+  };
+
+  void applyResults(const VisibilityResults& results);
+  void pollReadbacks_RenderThread();
+  void flushResults_RenderThread();
+
+  // Game thread state.
+  TMap<uint32, TArray<SlotResult>> _resultsByPool;
+  BoxSet _pendingBoxes;
+  uint64 _pendingBoxesFrame = 0;
+  uint32 _nextPoolId = 1;
+  uint64 _nextSubmission = 1;
+  uint64 _lastSubmittedFrame = 0;
+
+  // Render thread state.
+  BoxSetPtr _pBoxes_renderThread;
+  TArray<PendingReadback> _pendingReadbacks_renderThread;
+
+  // Results from all of the view families that tested the same boxes are
+  // combined here before they're sent to the game thread.
+  VisibilityResults _accumulatedResults_renderThread;
+
+  // A queue to pass results from the render thread to the game thread.
+  TQueue<VisibilityResults, EQueueMode::Spsc> _resultsQueue;
+};
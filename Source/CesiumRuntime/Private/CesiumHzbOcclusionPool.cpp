@@ -0,0 +1,118 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumHzbOcclusionPool.h"
+#include "Async/Async.h"
+#include "CalcBounds.h"
+#include "CesiumHzbOcclusion.h"
+#include "CesiumRuntime.h"
+#include "CesiumViewExtension.h"
+#include "VecMath.h"
+#include <Cesium3DTilesSelection/Tile.h>
+#include <variant>
+
+using namespace Cesium3DTilesSelection;
+
+CesiumHzbOcclusionProxy::CesiumHzbOcclusionProxy(
+    CesiumHzbOcclusionPool& pool,
+    uint32 slot)
+    : _pool(pool), _slot(slot) {}
+
+void CesiumHzbOcclusionProxy::reset(const Tile* pTile) {
+  this->_occlusionState = TileOcclusionState::OcclusionUnavailable;
+  this->_mappedSubmission = 0;
+
+  if (pTile) {
+    this->_tileBounds = pTile->getBoundingVolume();
+    this->_isMapped = true;
+    this->updateBounds(this->_pool._cesiumToUnreal);
+  } else {
+    this->_isMapped = false;
+  }
+}
+
+void CesiumHzbOcclusionProxy::updateBounds(const glm::dmat4& cesiumToUnreal) {
+  // Bounding volumes are already in tileset coordinates, so they don't need
+  // the tile's transform.
+  const FTransform tilesetToUnreal(VecMath::createMatrix(cesiumToUnreal));
+  const glm::dmat4 identity(1.0);
+  this->_worldBounds =
+      std::visit(
+          CalcBoundsOperation{tilesetToUnreal, identity},
+          this->_tileBounds)
+          .GetBox();
+}
+
+CesiumHzbOcclusionPool::CesiumHzbOcclusionPool(
+    const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>& pViewExtension,
+    int32 maxPoolSize)
+    : TileOcclusionRendererProxyPool(maxPoolSize),
+      _pViewExtension(pViewExtension),
+      _poolId(pViewExtension->GetHzbOcclusion().registerPool()) {}
+
+CesiumHzbOcclusionPool::~CesiumHzbOcclusionPool() {
+  // cesium-native may release the pool on a worker thread, once the tileset's
+  // asynchronous destruction completes.
+  if (IsInGameThread()) {
+    this->_pViewExtension->GetHzbOcclusion().unregisterPool(this->_poolId);
+  } else {
+    AsyncTask(
+        ENamedThreads::GameThread,
+        [pViewExtension = this->_pViewExtension, poolId = this->_poolId]() {
+          pViewExtension->GetHzbOcclusion().unregisterPool(poolId);
+        });
+  }
+}
+
+void CesiumHzbOcclusionPool::UpdateTransformFromCesium(
+    const glm::dmat4& CesiumToUnrealTransform) {
+  this->_cesiumToUnreal = CesiumToUnrealTransform;
+
+  for (const TUniquePtr<CesiumHzbOcclusionProxy>& pProxy : this->_proxies) {
+    if (pProxy && pProxy->_isMapped) {
+      pProxy->updateBounds(CesiumToUnrealTransform);
+    }
+  }
+}
+
+void CesiumHzbOcclusionPool::UpdateOcclusion() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateHzbOcclusion)
+
+  CesiumHzbOcclusion& occlusion = this->_pViewExtension->GetHzbOcclusion();
+  const TArrayView<const CesiumHzbOcclusion::SlotResult> results =
+      occlusion.getResults(this->_poolId);
+  const uint64 nextSubmission = occlusion.getNextSubmission();
+
+  for (const TUniquePtr<CesiumHzbOcclusionProxy>& pProxy : this->_proxies) {
+    if (!pProxy || !pProxy->_isMapped) {
+      continue;
+    }
+
+    const int32 slot = int32(pProxy->_slot);
+    if (pProxy->_mappedSubmission == 0) {
+      pProxy->_mappedSubmission = nextSubmission;
+    } else if (
+        results.IsValidIndex(slot) &&
+        results[slot].submission >= pProxy->_mappedSubmission) {
+      pProxy->_occlusionState = results[slot].visible
+                                    ? TileOcclusionState::NotOccluded
+                                    : TileOcclusionState::Occluded;
+    }
+
+    occlusion.addBox(this->_poolId, pProxy->_slot, pProxy->_worldBounds);
+  }
+}
+
+TileOcclusionRendererProxy* CesiumHzbOcclusionPool::createProxy() {
+  const uint32 slot = uint32(this->_proxies.Num());
+  return this->_proxies
+      .Add_GetRef(MakeUnique<CesiumHzbOcclusionProxy>(*this, slot))
+      .Get();
+}
+
+void CesiumHzbOcclusionPool::destroyProxy(TileOcclusionRendererProxy* pProxy) {
+  CesiumHzbOcclusionProxy* pHzbProxy =
+      static_cast<CesiumHzbOcclusionProxy*>(pProxy);
+  if (pHzbProxy && this->_proxies.IsValidIndex(int32(pHzbProxy->_slot))) {
+    this->_proxies[int32(pHzbProxy->_slot)].Reset();
+  }
+}
@@ -0,0 +1,104 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+
+class CesiumHzbOcclusionPool;
+class CesiumViewExtension;
+
+/**
+ * A tile occlusion proxy whose tile's bounding box is tested against the
+ * hierarchical Z-buffer by CesiumHzbOcclusion. Unlike
+ * UCesiumBoundingVolumeComponent, it isn't a primitive in the scene, so it's
+ * cheap enough to have one for every tile that needs an occlusion result.
+ */
+class CesiumHzbOcclusionProxy
+    : public Cesium3DTilesSelection::TileOcclusionRendererProxy {
+public:
+  CesiumHzbOcclusionProxy(CesiumHzbOcclusionPool& pool, uint32 slot);
+
+  Cesium3DTilesSelection::TileOcclusionState
+  getOcclusionState() const override {
+    return this->_occlusionState;
+  }
+
+protected:
+  void reset(const Cesium3DTilesSelection::Tile* pTile) override;
+
+private:
+  friend class CesiumHzbOcclusionPool;
+
+  void updateBounds(const glm::dmat4& cesiumToUnreal);
+
+  CesiumHzbOcclusionPool& _pool;
+  uint32 _slot;
+
+  Cesium3DTilesSelection::TileOcclusionState _occlusionState =
+      Cesium3DTilesSelection::TileOcclusionState::OcclusionUnavailable;
+
+  // Whether this proxy is currently mapped to a tile.
+  bool _isMapped = false;
+
+  // The first submission that included the current tile's box, or 0 if it
+  // hasn't been submitted yet. Results from earlier submissions are for the
+  // tile this proxy was previously mapped to.
+  uint64 _mappedSubmission = 0;
+
+  Cesium3DTilesSelection::BoundingVolume _tileBounds =
+      CesiumGeometry::OrientedBoundingBox(glm::dvec3(0.0), glm::dmat3(1.0));
+  FBox _worldBounds{ForceInit};
+};
+
+/**
+ * A pool of occlusion proxies for a tileset that uses CesiumHzbOcclusion.
+ * Each proxy has a slot in the pool, which is how its results are looked up.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumHzbOcclusionPool
+    : public Cesium3DTilesSelection::TileOcclusionRendererProxyPool {
+public:
+  CesiumHzbOcclusionPool(
+      const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
+          pViewExtension,
+      int32 maxPoolSize);
+  ~CesiumHzbOcclusionPool();
+
+  /**
+   * Updates the bounds of the mapped tiles from a new double-precision
+   * transformation from the Cesium world to the Unreal Engine world.
+   *
+   * @param CesiumToUnrealTransform The new transformation.
+   */
+  void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
+
+  /**
+   * Updates the occlusion state of each mapped tile from the latest results,
+   * and adds its bounds to be tested this frame.
+   */
+  void UpdateOcclusion();
+
+protected:
+  Cesium3DTilesSelection::TileOcclusionRendererProxy* createProxy() override;
+
+  void destroyProxy(
+      Cesium3DTilesSelection::TileOcclusionRendererProxy* pProxy) override;
+
+private:
+  friend class CesiumHzbOcclusionProxy;
+
+  TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe> _pViewExtension;
+  uint32 _poolId;
+  glm::dmat4 _cesiumToUnreal = glm::dmat4(1.0);
+
+  // The proxies, indexed by slot.
+  TArray<TUniquePtr<CesiumHzbOcclusionProxy>> _proxies;
+};
@@ -0,0 +1,447 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumIonEndpointAssetAccessor.h"
+#include "CesiumArchiveUtility.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRequestCancellation.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Hash/CityHash.h"
+#include "Misc/Base64.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+using RequestFuture =
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>;
+using SharedRequestFuture =
+    CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>;
+
+/**
+ * The endpoint requests shared by every CesiumIonEndpointAssetAccessor, in
+ * flight or recently completed, by their URL and headers.
+ */
+class SharedEndpoints {
+public:
+  static SharedEndpoints& get() {
+    static SharedEndpoints endpoints;
+    return endpoints;
+  }
+
+  std::optional<SharedRequestFuture> find(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(key);
+    if (it == this->_entries.end()) {
+      return std::nullopt;
+    }
+
+    const Entry& entry = it->second;
+    if (entry.receivedTime >= 0.0 &&
+        FPlatformTime::Seconds() - entry.receivedTime >
+            CesiumIonEndpointAssetAccessor::MaximumResponseAgeSeconds) {
+      this->_entries.erase(it);
+      return std::nullopt;
+    }
+
+    ++this->_sharedRequestCount;
+    return entry.future;
+  }
+
+  uint64_t add(const std::string& key, const SharedRequestFuture& future) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    const uint64_t id = ++this->_lastId;
+    this->_entries.insert_or_assign(key, Entry{future, -1.0, id});
+    return id;
+  }
+
+  // Marks a request as completed, or forgets it if it failed, so that the
+  // endpoint is requested again next time.
+  void complete(const std::string& key, uint64_t id, bool succeeded) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entries.find(key);
+    if (it == this->_entries.end() || it->second.id != id) {
+      return;
+    }
+    if (succeeded) {
+      it->second.receivedTime = FPlatformTime::Seconds();
+    } else {
+      this->_entries.erase(it);
+    }
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_entries.clear();
+  }
+
+  int64_t getSharedRequestCount() const { return this->_sharedRequestCount; }
+
+private:
+  struct Entry {
+    SharedRequestFuture future;
+    // When the response was received, or negative while it's in flight.
+    double receivedTime;
+    uint64_t id;
+  };
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, Entry> _entries;
+  uint64_t _lastId = 0;
+  std::atomic<int64_t> _sharedRequestCount = 0;
+};
+
+// "CEND", followed by the version of the saved response format.
+constexpr uint32 savedEndpointMagic = 0x43454e44;
+constexpr int32 savedEndpointVersion = 1;
+
+const std::string getMethod = "GET";
+
+/**
+ * An endpoint response that was saved on disk.
+ */
+class SavedEndpointRequest : public CesiumAsync::IAssetRequest,
+                             public CesiumAsync::IAssetResponse {
+public:
+  SavedEndpointRequest(
+      const std::string& url,
+      std::string&& contentType,
+      std::vector<std::byte>&& data)
+      : _url(url),
+        _contentType(std::move(contentType)),
+        _data(std::move(data)) {}
+
+  virtual const std::string& method() const { return getMethod; }
+
+  virtual const std::string& url() const { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return this;
+  }
+
+  virtual uint16_t statusCode() const override { return 200; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data);
+  }
+
+private:
+  std::string _url;
+  std::string _contentType;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+FString getSavedEndpointFilename(
+    const FString& directory,
+    const std::string& key) {
+  // The key contains the ion access token, so it isn't saved itself.
+  const uint64 hash = CityHash64(key.data(), uint32(key.size()));
+  return FPaths::Combine(directory, FString::Printf(TEXT("%016llx.bin"), hash));
+}
+
+// Reads a saved response, if there is one whose token won't expire soon.
+std::shared_ptr<CesiumAsync::IAssetRequest>
+readSavedEndpoint(const FString& filename, const std::string& url) {
+  TArray<uint8> bytes;
+  if (!FFileHelper::LoadFileToArray(bytes, *filename, FILEREAD_Silent)) {
+    return nullptr;
+  }
+
+  FMemoryReader reader(bytes);
+  uint32 magic = 0;
+  int32 version = 0;
+  int64 expiry = 0;
+  reader << magic << version << expiry;
+  if (reader.IsError() || magic != savedEndpointMagic ||
+      version != savedEndpointVersion ||
+      expiry - FDateTime::UtcNow().ToUnixTimestamp() <
+          CesiumIonEndpointAssetAccessor::MinimumTokenLifetimeSeconds) {
+    return nullptr;
+  }
+
+  std::string contentType;
+  std::vector<std::byte> data;
+  if (!CesiumArchiveUtility::readBuffer(reader, contentType) ||
+      !CesiumArchiveUtility::readBuffer(reader, data)) {
+    return nullptr;
+  }
+
+  return std::make_shared<SavedEndpointRequest>(
+      url,
+      std::move(contentType),
+      std::move(data));
+}
+
+void writeSavedEndpoint(
+    const FString& filename,
+    const CesiumAsync::IAssetRequest& request) {
+  const CesiumAsync::IAssetResponse* pResponse = request.response();
+  if (!pResponse || pResponse->statusCode() != 200) {
+    return;
+  }
+
+  // Responses without a token that expires, which can't be known to still be
+  // valid later, aren't saved.
+  std::optional<int64_t> maybeExpiry =
+      CesiumIonEndpointAssetAccessor::getTokenExpiry(pResponse->data());
+  if (!maybeExpiry) {
+    return;
+  }
+
+  TArray<uint8> bytes;
+  FMemoryWriter writer(bytes);
+  uint32 magic = savedEndpointMagic;
+  int32 version = savedEndpointVersion;
+  int64 expiry = *maybeExpiry;
+  writer << magic << version << expiry;
+
+  std::string contentType = pResponse->contentType();
+  int64 contentTypeSize = int64(contentType.size());
+  writer << contentTypeSize;
+  writer.Serialize(contentType.data(), contentTypeSize);
+
+  gsl::span<const std::byte> data = pResponse->data();
+  int64 dataSize = int64(data.size());
+  writer << dataSize;
+  writer.Serialize(const_cast<std::byte*>(data.data()), dataSize);
+
+  IFileManager::Get().MakeDirectory(*FPaths::GetPath(filename), true);
+  FFileHelper::SaveArrayToFile(bytes, *filename);
+}
+
+// Requests an endpoint and saves a successful response.
+RequestFuture fetchEndpoint(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const FString& filename) {
+  RequestFuture future = pAssetAccessor->get(asyncSystem, url, headers);
+  if (filename.IsEmpty()) {
+    return future;
+  }
+  return std::move(future).thenInWorkerThread(
+      [filename](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+        if (pRequest) {
+          writeSavedEndpoint(filename, *pRequest);
+        }
+        return std::move(pRequest);
+      });
+}
+
+// Uses a saved response if there is one, while requesting the endpoint again
+// in the background to save a fresh response for next time. Otherwise,
+// requests the endpoint and waits for it.
+RequestFuture loadEndpoint(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const FString& filename) {
+  return asyncSystem
+      .runInWorkerThread(
+          [filename, url]() { return readSavedEndpoint(filename, url); })
+      .thenImmediately(
+          [asyncSystem, pAssetAccessor, url, headers, filename](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pSaved) {
+            RequestFuture fetched = fetchEndpoint(
+                asyncSystem,
+                pAssetAccessor,
+                url,
+                headers,
+                filename);
+            if (!pSaved) {
+              return fetched;
+            }
+            return asyncSystem.createResolvedFuture(std::move(pSaved));
+          });
+}
+
+// Decodes base64url, as used by JSON Web Tokens.
+bool decodeBase64Url(const std::string& encoded, TArray<uint8>& decoded) {
+  FString base64(UTF8_TO_TCHAR(encoded.c_str()));
+  base64.ReplaceCharInline(TEXT('-'), TEXT('+'));
+  base64.ReplaceCharInline(TEXT('_'), TEXT('/'));
+  while (base64.Len() % 4 != 0) {
+    base64.AppendChar(TEXT('='));
+  }
+  return FBase64::Decode(base64, decoded);
+}
+
+RequestFuture shareResult(const SharedRequestFuture& future) {
+  return future.thenImmediately(
+      [](const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest) {
+        return pRequest;
+      });
+}
+
+} // namespace
+
+CesiumIonEndpointAssetAccessor::CesiumIonEndpointAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const FString& diskCacheDirectory)
+    : _pAssetAccessor(pAssetAccessor),
+      _diskCacheDirectory(diskCacheDirectory) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumIonEndpointAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (!isEndpointUrl(url)) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  std::vector<CesiumAsync::IAssetAccessor::THeader> sharedHeaders = headers;
+  CesiumRequestCancellation::extractGroup(sharedHeaders);
+
+  std::string key = url;
+  for (const CesiumAsync::IAssetAccessor::THeader& header : sharedHeaders) {
+    key += '\n';
+    key += header.first;
+    key += ": ";
+    key += header.second;
+  }
+
+  SharedEndpoints& endpoints = SharedEndpoints::get();
+  std::optional<SharedRequestFuture> maybeShared = endpoints.find(key);
+  if (maybeShared) {
+    return shareResult(*maybeShared);
+  }
+
+  SharedRequestFuture future =
+      this->_diskCacheDirectory.IsEmpty()
+          ? this->_pAssetAccessor->get(asyncSystem, url, sharedHeaders).share()
+          : loadEndpoint(
+                asyncSystem,
+                this->_pAssetAccessor,
+                url,
+                sharedHeaders,
+                getSavedEndpointFilename(this->_diskCacheDirectory, key))
+                .share();
+  const uint64_t id = endpoints.add(key, future);
+  future.thenImmediately(
+      [key = std::move(key),
+       id](const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest) {
+        const CesiumAsync::IAssetResponse* pResponse =
+            pRequest ? pRequest->response() : nullptr;
+        SharedEndpoints::get().complete(
+            key,
+            id,
+            pResponse && pResponse->statusCode() == 200);
+      });
+  return shareResult(future);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumIonEndpointAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumIonEndpointAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+bool CesiumIonEndpointAssetAccessor::isEndpointUrl(const std::string& url) {
+  const size_t assets = url.find("/v1/assets/");
+  if (assets == std::string::npos) {
+    return false;
+  }
+  const size_t endpoint = url.find("/endpoint", assets);
+  return endpoint != std::string::npos;
+}
+
+int64_t CesiumIonEndpointAssetAccessor::getSharedRequestCount() {
+  return SharedEndpoints::get().getSharedRequestCount();
+}
+
+void CesiumIonEndpointAssetAccessor::clear() { SharedEndpoints::get().clear(); }
+
+FString CesiumIonEndpointAssetAccessor::getDefaultDiskCacheDirectory() {
+  return FPaths::Combine(
+      FPaths::ProjectSavedDir(),
+      TEXT("Cesium"),
+      TEXT("IonEndpoints"));
+}
+
+std::optional<int64_t> CesiumIonEndpointAssetAccessor::getTokenExpiry(
+    const gsl::span<const std::byte>& data) {
+  const std::string json(
+      reinterpret_cast<const char*>(data.data()),
+      data.size());
+
+  // The token is a JSON Web Token, whose second part is its claims.
+  const std::string tokenProperty = "\"accessToken\"";
+  size_t tokenStart = json.find(tokenProperty);
+  if (tokenStart == std::string::npos) {
+    return std::nullopt;
+  }
+  const size_t tokenColon = json.find(':', tokenStart + tokenProperty.size());
+  if (tokenColon == std::string::npos) {
+    return std::nullopt;
+  }
+  tokenStart = json.find('"', tokenColon + 1);
+  if (tokenStart == std::string::npos) {
+    return std::nullopt;
+  }
+  const size_t tokenEnd = json.find('"', tokenStart + 1);
+  const size_t claimsStart = json.find('.', tokenStart + 1);
+  if (tokenEnd == std::string::npos || claimsStart >= tokenEnd) {
+    return std::nullopt;
+  }
+  const size_t claimsEnd = json.find('.', claimsStart + 1);
+  if (claimsEnd >= tokenEnd) {
+    return std::nullopt;
+  }
+
+  TArray<uint8> decoded;
+  if (!decodeBase64Url(
+          json.substr(claimsStart + 1, claimsEnd - claimsStart - 1),
+          decoded)) {
+    return std::nullopt;
+  }
+
+  const std::string claims(
+      reinterpret_cast<const char*>(decoded.GetData()),
+      size_t(decoded.Num()));
+  const std::string expProperty = "\"exp\"";
+  const size_t expStart = claims.find(expProperty);
+  if (expStart == std::string::npos) {
+    return std::nullopt;
+  }
+  const size_t colon = claims.find(':', expStart + expProperty.size());
+  if (colon == std::string::npos) {
+    return std::nullopt;
+  }
+
+  const char* pStart = claims.c_str() + colon + 1;
+  char* pEnd = nullptr;
+  const long long expiry = std::strtoll(pStart, &pEnd, 10);
+  if (pEnd == pStart || expiry <= 0) {
+    return std::nullopt;
+  }
+  return int64_t(expiry);
+}
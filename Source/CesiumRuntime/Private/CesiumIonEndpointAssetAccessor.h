@@ -0,0 +1,113 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "Containers/UnrealString.h"
+#include <cstdint>
+#include <gsl/span>
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * An asset accessor that shares Cesium ion endpoint requests, which resolve
+ * an ion asset ID and access token to the asset's URL and a short-lived
+ * bearer token, among every tileset and raster overlay in the process.
+ *
+ * When a level starts, each tileset and each of its Cesium ion overlays
+ * requests its endpoint before it can request anything else, and levels often
+ * have many actors using the same assets with the same token, such as the
+ * same imagery draped over every tileset. The first request for an endpoint is
+ * made as usual, and every request for the same endpoint URL and headers that
+ * is made while it's in flight, or shortly after it succeeds, is given the
+ * same response. Responses are only kept for a few minutes, well before the
+ * bearer tokens in them expire.
+ *
+ * Endpoint responses may also be saved in a directory on disk, so that they
+ * can be used by later sessions. A saved response is used until shortly
+ * before the access token in it expires, and each time it is used, the
+ * endpoint is requested again in the background to save a fresh response for
+ * next time. That way, startup isn't blocked on a round trip for each asset.
+ *
+ * Endpoint requests are removed from their request group, so that cancelling
+ * the requests of one tileset doesn't cancel an endpoint request that other
+ * tilesets are waiting for. They're small, so there's little to gain from
+ * cancelling them anyway. All other requests are passed straight through.
+ */
+class CesiumIonEndpointAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * How long a successful endpoint response is shared for, in seconds.
+   */
+  static constexpr double MaximumResponseAgeSeconds = 300.0;
+
+  /**
+   * How long the access token in a response saved on disk must remain valid
+   * for the response to be used, in seconds.
+   */
+  static constexpr int64_t MinimumTokenLifetimeSeconds = 600;
+
+  /**
+   * @param pAssetAccessor The accessor that performs the requests.
+   * @param diskCacheDirectory The directory to save endpoint responses in, or
+   * an empty string to only share them in memory.
+   */
+  CesiumIonEndpointAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const FString& diskCacheDirectory = FString());
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Whether a URL is a Cesium ion endpoint, like
+   * https://api.cesium.com/v1/assets/1/endpoint?access_token=...
+   */
+  static bool isEndpointUrl(const std::string& url);
+
+  /**
+   * Gets the number of endpoint requests, by any of these accessors, that
+   * were given another request's response rather than being made again.
+   */
+  static int64_t getSharedRequestCount();
+
+  /**
+   * Forgets every shared endpoint response, so that each endpoint is
+   * requested again.
+   */
+  static void clear();
+
+  /**
+   * Gets the directory that tilesets save endpoint responses in.
+   */
+  static FString getDefaultDiskCacheDirectory();
+
+  /**
+   * Finds when the access token in an endpoint response expires, from the
+   * "exp" claim of the JSON Web Token.
+   *
+   * @return The expiry time in seconds since the Unix epoch, or std::nullopt
+   * if the response doesn't have an access token with an expiry time.
+   */
+  static std::optional<int64_t>
+  getTokenExpiry(const gsl::span<const std::byte>& data);
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  FString _diskCacheDirectory;
+};
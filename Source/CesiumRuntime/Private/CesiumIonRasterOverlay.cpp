@@ -3,6 +3,7 @@
 #include "CesiumIonRasterOverlay.h"
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "CesiumActors.h"
+#include "CesiumCoalescingAssetAccessor.h"
 #include "CesiumRasterOverlays/IonRasterOverlay.h"
 #include "CesiumRuntime.h"
 #include "CesiumRuntimeSettings.h"
@@ -19,19 +20,22 @@ UCesiumIonRasterOverlay::CreateOverlay(
     return nullptr;
   }
 
+  using Overlay =
+      CesiumCoalescingRasterOverlay<CesiumRasterOverlays::IonRasterOverlay>;
+
   FString token =
       this->IonAccessToken.IsEmpty()
           ? GetDefault<UCesiumRuntimeSettings>()->DefaultIonAccessToken
           : this->IonAccessToken;
   if (!this->IonAssetEndpointUrl.IsEmpty()) {
-    return std::make_unique<CesiumRasterOverlays::IonRasterOverlay>(
+    return std::make_unique<Overlay>(
         TCHAR_TO_UTF8(*this->MaterialLayerKey),
         this->IonAssetID,
         TCHAR_TO_UTF8(*token),
         options,
         TCHAR_TO_UTF8(*this->IonAssetEndpointUrl));
   }
-  return std::make_unique<CesiumRasterOverlays::IonRasterOverlay>(
+  return std::make_unique<Overlay>(
       TCHAR_TO_UTF8(*this->MaterialLayerKey),
       this->IonAssetID,
       TCHAR_TO_UTF8(*token),
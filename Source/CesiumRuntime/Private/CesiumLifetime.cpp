@@ -2,19 +2,35 @@
 
 #include "CesiumLifetime.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
 #if WITH_EDITOR
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
 #include "Engine/Selection.h"
 #endif
+#include "Engine/Engine.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "StaticMeshResources.h"
 #include "UObject/Object.h"
+#include "UObject/UObjectGlobals.h"
 #include <algorithm>
 
+DECLARE_CYCLE_STAT(
+    TEXT("Amortized Destruction"),
+    STAT_CesiumAmortizedDestruction,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Objects Pending Destruction"),
+    STAT_CesiumObjectsPendingDestruction,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Objects Finalized"),
+    STAT_CesiumObjectsFinalized,
+    STATGROUP_Cesium);
+
 /*static*/
 AmortizedDestructor CesiumLifetime::amortizedDestructor = AmortizedDestructor();
 
@@ -59,7 +75,30 @@ CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
   UE_LOG(LogCesium, VeryVerbose, TEXT("Destroying scene component done"));
 }
 
-void AmortizedDestructor::Tick(float DeltaTime) { processPending(); }
+void AmortizedDestructor::Tick(float DeltaTime) {
+  processPending();
+
+  const int32 maximumPending =
+      GetDefault<UCesiumRuntimeSettings>()->MaximumPendingDestructions;
+  if (maximumPending > 0 && this->_pending.Num() > maximumPending) {
+    // Most pending objects are no longer referenced by anything, so the
+    // garbage collector can free them without waiting for their turn.
+    if (!this->_garbageCollectionRequested && GEngine) {
+      UE_LOG(
+          LogCesium,
+          Verbose,
+          TEXT(
+              "%d objects are waiting to be destroyed, requesting garbage collection."),
+          this->_pending.Num());
+      GEngine->ForceGarbageCollection(false);
+      this->_garbageCollectionRequested = true;
+    }
+  } else {
+    this->_garbageCollectionRequested = false;
+  }
+
+  SET_DWORD_STAT(STAT_CesiumObjectsPendingDestruction, this->_pending.Num());
+}
 
 ETickableTickType AmortizedDestructor::GetTickableTickType() const {
   return ETickableTickType::Always;
@@ -72,7 +111,18 @@ bool AmortizedDestructor::IsTickableInEditor() const { return true; }
 TStatId AmortizedDestructor::GetStatId() const { return TStatId(); }
 
 void AmortizedDestructor::destroy(UObject* pObject) {
-  if (!runDestruction(pObject)) {
+  SCOPE_CYCLE_COUNTER(STAT_CesiumAmortizedDestruction);
+
+  if (!this->hasTimeRemaining()) {
+    addToPending(pObject);
+    return;
+  }
+
+  const double start = FPlatformTime::Seconds();
+  const bool destroyed = runDestruction(pObject);
+  this->_secondsThisFrame += FPlatformTime::Seconds() - start;
+
+  if (!destroyed) {
     addToPending(pObject);
   }
 }
@@ -102,6 +152,7 @@ bool AmortizedDestructor::runDestruction(UObject* pObject) const {
     // IsReadyForFinishDestroy call is important, though. In some objects,
     // calling that actually continues the async destruction!
     finalizeDestroy(pObject);
+    INC_DWORD_STAT(STAT_CesiumObjectsFinalized);
     return true;
   }
 
@@ -116,9 +167,31 @@ void AmortizedDestructor::processPending() {
   std::swap(_nextPending, _pending);
   _pending.Empty();
 
-  for (TWeakObjectPtr<UObject> pObject : _nextPending) {
-    destroy(pObject.Get(true));
+  int32 i = 0;
+  for (; i < _nextPending.Num() && this->hasTimeRemaining(); ++i) {
+    destroy(_nextPending[i].Get(true));
   }
+
+  // The rest weren't tried this frame, so try them first next frame.
+  if (i < _nextPending.Num()) {
+    _pending.Insert(_nextPending.GetData() + i, _nextPending.Num() - i, 0);
+  }
+}
+
+bool AmortizedDestructor::hasTimeRemaining() {
+  if (!UObjectInitialized()) {
+    return true;
+  }
+
+  if (this->_frame != GFrameCounter) {
+    this->_frame = GFrameCounter;
+    this->_secondsThisFrame = 0.0;
+  }
+
+  const float budgetMilliseconds =
+      GetDefault<UCesiumRuntimeSettings>()->MainThreadDestructionTimeBudget;
+  return budgetMilliseconds <= 0.0f ||
+         this->_secondsThisFrame * 1000.0 < budgetMilliseconds;
 }
 
 void AmortizedDestructor::finalizeDestroy(UObject* pObject) const {
@@ -9,6 +9,17 @@
 class UObject;
 class UTexture;
 
+/**
+ * Destroys objects once they're ready to be destroyed, which for some objects
+ * is only after the render thread is done with them. Objects that aren't ready
+ * right away are retried every frame.
+ *
+ * The time spent destroying objects on the game thread is limited by the
+ * "Main Thread Destruction Time Budget" setting. Objects that don't fit in a
+ * frame's budget are destroyed in later frames, and if too many are waiting,
+ * a garbage collection is requested to free the ones that are no longer
+ * referenced.
+ */
 class AmortizedDestructor : FTickableGameObject {
 public:
   void Tick(float DeltaTime) override;
@@ -23,9 +34,18 @@ private:
   void addToPending(UObject* pObject);
   void processPending();
   void finalizeDestroy(UObject* pObject) const;
+  bool hasTimeRemaining();
 
   TArray<TWeakObjectPtr<UObject>> _pending;
   TArray<TWeakObjectPtr<UObject>> _nextPending;
+
+  // The frame that _secondsThisFrame was accumulated in.
+  uint64 _frame = 0;
+  double _secondsThisFrame = 0.0;
+
+  // Whether a garbage collection has been requested for the current backlog
+  // of pending objects.
+  bool _garbageCollectionRequested = false;
 };
 
 class CesiumLifetime {
@@ -0,0 +1,113 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMainThreadDispatcher.h"
+#include "CesiumFrameBudget.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformTime.h"
+#include <algorithm>
+
+DECLARE_CYCLE_STAT(
+    TEXT("Main Thread Dispatch"),
+    STAT_CesiumMainThreadDispatch,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Main Thread Tasks Deferred"),
+    STAT_CesiumMainThreadTasksDeferred,
+    STATGROUP_Cesium);
+
+/*static*/ CesiumMainThreadDispatcher& CesiumMainThreadDispatcher::get() {
+  static CesiumMainThreadDispatcher dispatcher;
+  return dispatcher;
+}
+
+void CesiumMainThreadDispatcher::post(
+    Priority priority,
+    TUniqueFunction<void()>&& task) {
+  check(IsInGameThread());
+  this->_tasks[int32(priority)].Add(
+      Task{MoveTemp(task), FPlatformTime::Seconds()});
+}
+
+void CesiumMainThreadDispatcher::dispatch(double milliseconds) {
+  SCOPE_CYCLE_COUNTER(STAT_CesiumMainThreadDispatch);
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DispatchMainThreadTasks)
+
+  const double start = FPlatformTime::Seconds();
+  bool ranAny = false;
+
+  for (int32 priority = 0; priority < PriorityCount; ++priority) {
+    // Tasks may post more tasks while they run, which wait for the next
+    // frame.
+    TArray<Task> tasks = MoveTemp(this->_tasks[priority]);
+
+    int32 i = 0;
+    for (; i < tasks.Num(); ++i) {
+      const bool hasTime =
+          milliseconds < 0.0 ||
+          (FPlatformTime::Seconds() - start) * 1000.0 < milliseconds;
+      if (Priority(priority) != Priority::High && ranAny && !hasTime) {
+        break;
+      }
+
+      this->run(Priority(priority), tasks[i]);
+      ranAny = true;
+    }
+
+    if (i < tasks.Num()) {
+      // The tasks that weren't run go before the ones posted since.
+      this->_statistics[priority].deferred += tasks.Num() - i;
+      tasks.RemoveAt(0, i, false);
+      tasks.Append(MoveTemp(this->_tasks[priority]));
+      this->_tasks[priority] = MoveTemp(tasks);
+    }
+  }
+
+  SET_DWORD_STAT(
+      STAT_CesiumMainThreadTasksDeferred,
+      this->_tasks[int32(Priority::Normal)].Num() +
+          this->_tasks[int32(Priority::Low)].Num());
+}
+
+int32 CesiumMainThreadDispatcher::getPendingCount(Priority priority) const {
+  return this->_tasks[int32(priority)].Num();
+}
+
+const CesiumMainThreadDispatcher::Statistics&
+CesiumMainThreadDispatcher::getStatistics(Priority priority) const {
+  return this->_statistics[int32(priority)];
+}
+
+void CesiumMainThreadDispatcher::Tick(float DeltaTime) {
+  // This ticks after the tilesets, so it gets whatever they left of the
+  // budget in this frame.
+  const double budget = double(
+      GetDefault<UCesiumRuntimeSettings>()->MainThreadLoadingTimeBudget);
+  if (budget <= 0.0) {
+    this->dispatch(-1.0);
+    return;
+  }
+
+  const double spent =
+      CesiumFrameBudget::getMainThreadLoadingTimeThisFrameInAllWorlds();
+  this->dispatch(std::max(budget - spent, 0.0));
+}
+
+ETickableTickType CesiumMainThreadDispatcher::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool CesiumMainThreadDispatcher::IsTickableWhenPaused() const { return true; }
+
+bool CesiumMainThreadDispatcher::IsTickableInEditor() const { return true; }
+
+TStatId CesiumMainThreadDispatcher::GetStatId() const { return TStatId(); }
+
+void CesiumMainThreadDispatcher::run(Priority priority, Task& task) {
+  Statistics& statistics = this->_statistics[int32(priority)];
+  statistics.maximumWaitMilliseconds = std::max(
+      statistics.maximumWaitMilliseconds,
+      (FPlatformTime::Seconds() - task.postedSeconds) * 1000.0);
+  ++statistics.dispatched;
+  task.function();
+}
@@ -0,0 +1,113 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Templates/Function.h"
+#include "Tickable.h"
+
+/**
+ * Runs the plugin's work that must happen on the game thread, such as the
+ * continuations of asynchronous loads, within the time left in each frame's
+ * "Main Thread Loading Time Budget" after tiles and raster overlay tiles have
+ * been finalized. Work that doesn't fit is deferred to later frames, in
+ * order of priority and then in the order it was posted.
+ *
+ * Continuations that cesium-native itself runs on the main thread, such as
+ * preparing raster overlay tiles, are dispatched by each tileset as it
+ * updates, and can't be deferred here. Their time is counted against the
+ * same budget instead, so they leave less of it for everything else.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumMainThreadDispatcher : FTickableGameObject {
+public:
+  /**
+   * The priority of work, which decides what is deferred when the budget is
+   * exhausted.
+   */
+  enum class Priority {
+    /**
+     * Cheap bookkeeping that other work waits for, such as releasing
+     * requests. It's never deferred.
+     */
+    High,
+
+    /**
+     * Work that affects what is drawn, such as replacing the preview of a
+     * raster overlay tile with its full image.
+     */
+    Normal,
+
+    /**
+     * Work that nothing waits for, such as credits and mesh distance fields.
+     */
+    Low
+  };
+
+  /**
+   * Statistics of the work of one priority since startup.
+   */
+  struct Statistics {
+    /** The number of tasks that have run. */
+    int64 dispatched = 0;
+
+    /**
+     * The number of times a task was left waiting at the end of a frame. A
+     * task that waits for three frames is counted three times.
+     */
+    int64 deferred = 0;
+
+    /** The longest time, in milliseconds, that a task waited to run. */
+    double maximumWaitMilliseconds = 0.0;
+  };
+
+  /**
+   * Gets the dispatcher shared by all tilesets.
+   */
+  static CesiumMainThreadDispatcher& get();
+
+  /**
+   * Runs a task on the game thread in this or a later frame.
+   */
+  void post(Priority priority, TUniqueFunction<void()>&& task);
+
+  /**
+   * Runs every high priority task, then normal and low priority tasks until
+   * the given time has been spent. At least one task is run each time, even
+   * if no time remains, so that no priority waits forever.
+   *
+   * @param milliseconds The time to spend, or a negative number to run every
+   * task.
+   */
+  void dispatch(double milliseconds);
+
+  /**
+   * Gets the number of tasks of the given priority that are waiting to run.
+   */
+  int32 getPendingCount(Priority priority) const;
+
+  /**
+   * Gets the statistics of the tasks of the given priority.
+   */
+  const Statistics& getStatistics(Priority priority) const;
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const override;
+
+private:
+  static constexpr int32 PriorityCount = 3;
+
+  struct Task {
+    TUniqueFunction<void()> function;
+    double postedSeconds;
+  };
+
+  void run(Priority priority, Task& task);
+
+  TArray<Task> _tasks[PriorityCount];
+  Statistics _statistics[PriorityCount];
+};
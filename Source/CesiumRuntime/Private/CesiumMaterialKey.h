@@ -0,0 +1,72 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Color.h"
+#include "Math/Vector.h"
+#include "Templates/TypeHash.h"
+#include "Templates/Tuple.h"
+#include "UObject/NameTypes.h"
+
+/**
+ * The parts of the material of a primitive that don't depend on its
+ * textures: which of the tileset's base materials it uses, the glTF material
+ * factors, and which texture coordinate set each texture reads.
+ *
+ * This is computed while the primitive is loaded, on any thread. Primitives
+ * with equal keys have the same material parameter values apart from their
+ * textures, so their materials can be copied from one template material in
+ * CesiumMaterialPool rather than having each parameter set on the game
+ * thread.
+ */
+struct CesiumMaterialKey {
+  /**
+   * Which of the tileset's base materials a primitive uses.
+   */
+  enum class BaseMaterial : uint8 { Opaque, Translucent, Water };
+
+  BaseMaterial baseMaterial = BaseMaterial::Opaque;
+
+  FLinearColor baseColorFactor = FLinearColor::White;
+  float metallicFactor = 0.0f;
+  float roughnessFactor = 1.0f;
+
+  /**
+   * Whether the glTF material has an emissive factor. Without one, the
+   * emissive factor is only set if the primitive has an emissive texture.
+   */
+  bool hasEmissiveFactor = false;
+  FVector emissiveFactor = FVector::ZeroVector;
+
+  /**
+   * The texture coordinate index parameter names and their values, in the
+   * order they are set on the material.
+   */
+  TArray<TPair<FName, uint32>> textureCoordinateIndices;
+
+  bool operator==(const CesiumMaterialKey& rhs) const {
+    return this->baseMaterial == rhs.baseMaterial &&
+           this->baseColorFactor == rhs.baseColorFactor &&
+           this->metallicFactor == rhs.metallicFactor &&
+           this->roughnessFactor == rhs.roughnessFactor &&
+           this->hasEmissiveFactor == rhs.hasEmissiveFactor &&
+           this->emissiveFactor == rhs.emissiveFactor &&
+           this->textureCoordinateIndices == rhs.textureCoordinateIndices;
+  }
+
+  friend uint32 GetTypeHash(const CesiumMaterialKey& key) {
+    uint32 hash = GetTypeHash(static_cast<uint8>(key.baseMaterial));
+    hash = HashCombine(hash, GetTypeHash(key.baseColorFactor));
+    hash = HashCombine(hash, GetTypeHash(key.metallicFactor));
+    hash = HashCombine(hash, GetTypeHash(key.roughnessFactor));
+    if (key.hasEmissiveFactor) {
+      hash = HashCombine(hash, GetTypeHash(key.emissiveFactor));
+    }
+    for (const TPair<FName, uint32>& index : key.textureCoordinateIndices) {
+      hash = HashCombine(hash, GetTypeHash(index.Key));
+      hash = HashCombine(hash, GetTypeHash(index.Value));
+    }
+    return hash;
+  }
+};
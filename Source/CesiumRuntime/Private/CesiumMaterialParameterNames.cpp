@@ -0,0 +1,55 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMaterialParameterNames.h"
+
+namespace CesiumMaterialParameterNames {
+
+// glTF material parameters.
+const FName BaseColorFactor = "baseColorFactor";
+const FName MetallicFactor = "metallicFactor";
+const FName RoughnessFactor = "roughnessFactor";
+const FName OpacityMask = "opacityMask";
+const FName EmissiveFactor = "emissiveFactor";
+const FName BaseColorTexture = "baseColorTexture";
+const FName MetallicRoughnessTexture = "metallicRoughnessTexture";
+const FName NormalTexture = "normalTexture";
+const FName EmissiveTexture = "emissiveTexture";
+const FName OcclusionTexture = "occlusionTexture";
+const FName BaseColorTextureCoordinateIndex = "baseColorTextureCoordinateIndex";
+const FName MetallicRoughnessTextureCoordinateIndex =
+    "metallicRoughnessTextureCoordinateIndex";
+const FName NormalTextureCoordinateIndex = "normalTextureCoordinateIndex";
+const FName OcclusionTextureCoordinateIndex = "occlusionTextureCoordinateIndex";
+const FName EmissiveTextureCoordinateIndex = "emissiveTextureCoordinateIndex";
+
+// Water mask parameters.
+const FName OnlyLand = "OnlyLand";
+const FName OnlyWater = "OnlyWater";
+const FName WaterMask = "WaterMask";
+const FName WaterMaskTranslationScale = "WaterMaskTranslationScale";
+
+// Dither fade parameters.
+const FName FadePercentage = "FadePercentage";
+const FName FadingType = "FadingType";
+
+// Raster overlay layer parameters.
+const FName Texture = "Texture";
+const FName TranslationScale = "TranslationScale";
+const FName TextureCoordinateIndex = "TextureCoordinateIndex";
+
+// Raster overlay texture coordinate parameters, for materials that compute
+// them with CesiumOverlayUVs.ush.
+const FName OverlayOrigin = "OverlayOrigin";
+const FName OverlayLocalToEcefX = "OverlayLocalToEcefX";
+const FName OverlayLocalToEcefY = "OverlayLocalToEcefY";
+const FName OverlayLocalToEcefZ = "OverlayLocalToEcefZ";
+const FName OverlayEllipsoid = "OverlayEllipsoid";
+const FName OverlayProjection = "OverlayProjection";
+
+// Clipping volume parameters.
+const FName ClippingVolumes = "CesiumClippingVolumes";
+
+// Feature style parameters.
+const FName FeatureStyle = "CesiumFeatureStyle";
+
+} // namespace CesiumMaterialParameterNames
@@ -0,0 +1,76 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "UObject/NameTypes.h"
+
+/**
+ * The names of the material parameters that Cesium for Unreal sets on the
+ * materials of tiles. Constructing an FName from a string looks it up in the
+ * global name table, so these are constructed once rather than each time a
+ * parameter is set. They're defined in CesiumMaterialParameterNames.cpp, so
+ * that every translation unit shares the same ones.
+ */
+namespace CesiumMaterialParameterNames {
+
+// glTF material parameters.
+extern const FName BaseColorFactor;
+extern const FName MetallicFactor;
+extern const FName RoughnessFactor;
+extern const FName OpacityMask;
+extern const FName EmissiveFactor;
+extern const FName BaseColorTexture;
+extern const FName MetallicRoughnessTexture;
+extern const FName NormalTexture;
+extern const FName EmissiveTexture;
+extern const FName OcclusionTexture;
+extern const FName BaseColorTextureCoordinateIndex;
+extern const FName MetallicRoughnessTextureCoordinateIndex;
+extern const FName NormalTextureCoordinateIndex;
+extern const FName OcclusionTextureCoordinateIndex;
+extern const FName EmissiveTextureCoordinateIndex;
+
+// Water mask parameters.
+extern const FName OnlyLand;
+extern const FName OnlyWater;
+extern const FName WaterMask;
+extern const FName WaterMaskTranslationScale;
+
+// Dither fade parameters.
+extern const FName FadePercentage;
+extern const FName FadingType;
+
+// Raster overlay layer parameters.
+extern const FName Texture;
+extern const FName TranslationScale;
+extern const FName TextureCoordinateIndex;
+
+// Raster overlay texture coordinate parameters, for materials that compute
+// them with CesiumOverlayUVs.ush.
+extern const FName OverlayOrigin;
+extern const FName OverlayLocalToEcefX;
+extern const FName OverlayLocalToEcefY;
+extern const FName OverlayLocalToEcefZ;
+extern const FName OverlayEllipsoid;
+extern const FName OverlayProjection;
+
+// Clipping volume parameters.
+extern const FName ClippingVolumes;
+
+// Feature style parameters.
+extern const FName FeatureStyle;
+
+} // namespace CesiumMaterialParameterNames
+
+/**
+ * The custom primitive data indices that Cesium for Unreal writes on the
+ * primitives of tiles, for materials that read them rather than material
+ * parameters. See ACesium3DTileset::UseCustomPrimitiveDataForLodTransitions.
+ */
+namespace CesiumCustomPrimitiveDataIndices {
+
+// Dither fade data.
+static constexpr int32 FadePercentage = 0;
+static constexpr int32 FadingType = 1;
+
+} // namespace CesiumCustomPrimitiveDataIndices
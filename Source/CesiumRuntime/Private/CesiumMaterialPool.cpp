@@ -0,0 +1,108 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMaterialPool.h"
+#include "CesiumLifetime.h"
+#include "CesiumRuntime.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+namespace {
+// The most material instances that may be waiting to be reused, across all
+// base materials. Material instances released beyond this are destroyed
+// instead.
+constexpr int32 MaximumFreeMaterials = 1024;
+
+// The most template material instances that are kept, across all base
+// materials.
+constexpr int32 MaximumTemplates = 512;
+} // namespace
+
+/*static*/ CesiumMaterialPool& CesiumMaterialPool::get() {
+  static CesiumMaterialPool pool;
+  return pool;
+}
+
+UMaterialInstanceDynamic*
+CesiumMaterialPool::acquire(UMaterialInterface* pBaseMaterial) {
+  check(IsInGameThread());
+
+  TArray<TObjectPtr<UMaterialInstanceDynamic>>* pFree =
+      this->_free.Find(pBaseMaterial);
+  if (!pFree) {
+    return nullptr;
+  }
+
+  while (!pFree->IsEmpty()) {
+    UMaterialInstanceDynamic* pMaterial = pFree->Pop(false);
+    --this->_freeCount;
+    if (IsValid(pMaterial) && pMaterial->Parent == pBaseMaterial) {
+      return pMaterial;
+    }
+  }
+
+  this->_free.Remove(pBaseMaterial);
+  return nullptr;
+}
+
+void CesiumMaterialPool::release(UMaterialInstanceDynamic* pMaterial) {
+  check(IsInGameThread());
+
+  if (!pMaterial) {
+    return;
+  }
+
+  // A material instance that is unreachable is about to be collected, and
+  // can't be kept alive again.
+  if (this->_freeCount >= MaximumFreeMaterials || !IsValid(pMaterial) ||
+      pMaterial->IsUnreachable() || !pMaterial->Parent) {
+    CesiumLifetime::destroy(pMaterial);
+    return;
+  }
+
+  pMaterial->ClearParameterValues();
+
+  this->_free.FindOrAdd(pMaterial->Parent).Add(pMaterial);
+  ++this->_freeCount;
+}
+
+UMaterialInstanceDynamic* CesiumMaterialPool::findTemplate(
+    UMaterialInterface* pBaseMaterial,
+    const CesiumMaterialKey& key,
+    bool hasLayers) const {
+  check(IsInGameThread());
+
+  const TObjectPtr<UMaterialInstanceDynamic>* ppTemplate =
+      this->_templates.Find(TemplateKey{pBaseMaterial, key, hasLayers});
+  if (!ppTemplate || !IsValid(*ppTemplate) ||
+      (*ppTemplate)->Parent != pBaseMaterial) {
+    return nullptr;
+  }
+
+  return *ppTemplate;
+}
+
+void CesiumMaterialPool::addTemplate(
+    UMaterialInterface* pBaseMaterial,
+    const CesiumMaterialKey& key,
+    bool hasLayers,
+    UMaterialInstanceDynamic* pTemplate) {
+  check(IsInGameThread());
+
+  if (this->_templates.Num() >= MaximumTemplates) {
+    this->_templates.Empty();
+  }
+
+  this->_templates.Add(TemplateKey{pBaseMaterial, key, hasLayers}, pTemplate);
+}
+
+void CesiumMaterialPool::AddReferencedObjects(FReferenceCollector& Collector) {
+  for (auto& free : this->_free) {
+    Collector.AddReferencedObjects(free.Value);
+  }
+  for (auto& materialTemplate : this->_templates) {
+    Collector.AddReferencedObject(materialTemplate.Value);
+  }
+}
+
+FString CesiumMaterialPool::GetReferencerName() const {
+  return TEXT("CesiumMaterialPool");
+}
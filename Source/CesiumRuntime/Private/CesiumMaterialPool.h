@@ -0,0 +1,114 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumMaterialKey.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/ObjectPtr.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+/**
+ * A pool of dynamic material instances that are reused for the primitives of
+ * tiles.
+ *
+ * Every primitive needs its own UMaterialInstanceDynamic, and creating one
+ * from its base material is expensive. Instead, the material of a primitive
+ * that is unloaded has its parameter values cleared, and is returned to this
+ * pool to be reused by a later primitive with the same base material. The
+ * layers of a material instance are determined entirely by its base material,
+ * so instances with the same base material are interchangeable once their
+ * parameters are cleared.
+ *
+ * The pool also keeps a template material instance for each combination of
+ * base material and CesiumMaterialKey that it has been asked for. A template
+ * has the parameter values that don't depend on the textures of a primitive
+ * already set, so a new primitive's material only needs to copy them from the
+ * template and then set its textures.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumMaterialPool : public FGCObject {
+public:
+  /**
+   * Gets the pool shared by all tilesets.
+   */
+  static CesiumMaterialPool& get();
+
+  /**
+   * Takes a material instance of the given base material from the pool, to
+   * be reused for a new primitive, or returns nullptr if none is available.
+   * A material instance returned from here has no parameter values set.
+   */
+  UMaterialInstanceDynamic* acquire(UMaterialInterface* pBaseMaterial);
+
+  /**
+   * Returns a material instance to the pool, clearing its parameter values.
+   * Textures that it references are not destroyed. If the pool is already
+   * full, or the material instance is being garbage collected, it is
+   * destroyed instead.
+   */
+  void release(UMaterialInstanceDynamic* pMaterial);
+
+  /**
+   * Finds the template material instance of the given base material and key,
+   * or returns nullptr if there isn't one yet.
+   */
+  UMaterialInstanceDynamic* findTemplate(
+      UMaterialInterface* pBaseMaterial,
+      const CesiumMaterialKey& key,
+      bool hasLayers) const;
+
+  /**
+   * Adds the template material instance of the given base material and key.
+   * Templates are never given to primitives, so their parameter values must
+   * not be changed after they're added. If there are already too many
+   * templates, the existing ones are discarded first.
+   */
+  void addTemplate(
+      UMaterialInterface* pBaseMaterial,
+      const CesiumMaterialKey& key,
+      bool hasLayers,
+      UMaterialInstanceDynamic* pTemplate);
+
+  /**
+   * Gets the number of material instances that are waiting to be reused.
+   */
+  int32 getFreeCount() const { return this->_freeCount; }
+
+  // FGCObject overrides
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  TMap<
+      TObjectKey<UMaterialInterface>,
+      TArray<TObjectPtr<UMaterialInstanceDynamic>>>
+      _free;
+  int32 _freeCount = 0;
+
+  struct TemplateKey {
+    TObjectKey<UMaterialInterface> baseMaterial;
+    CesiumMaterialKey materialKey;
+    // Whether the glTF parameters are also set on the first material layer.
+    bool hasLayers;
+
+    bool operator==(const TemplateKey& rhs) const {
+      return this->baseMaterial == rhs.baseMaterial &&
+             this->hasLayers == rhs.hasLayers &&
+             this->materialKey == rhs.materialKey;
+    }
+
+    friend uint32 GetTypeHash(const TemplateKey& key) {
+      return HashCombine(
+          HashCombine(GetTypeHash(key.baseMaterial), key.hasLayers),
+          GetTypeHash(key.materialKey));
+    }
+  };
+
+  TMap<TemplateKey, TObjectPtr<UMaterialInstanceDynamic>> _templates;
+};
@@ -4,6 +4,11 @@
 #include "Materials/MaterialInstance.h"
 #include "Runtime/Launch/Resources/Version.h"
 
+void UCesiumMaterialUserData::PostLoad() {
+  Super::PostLoad();
+  this->UpdateLayerIndices();
+}
+
 void UCesiumMaterialUserData::PostEditChangeOwner() {
   Super::PostEditChangeOwner();
 
@@ -24,4 +29,13 @@ void UCesiumMaterialUserData::PostEditChangeOwner() {
     }
   }
 #endif
+
+  this->UpdateLayerIndices();
+}
+
+void UCesiumMaterialUserData::UpdateLayerIndices() {
+  this->DitherFadeLayerIndex = this->LayerNames.Find("DitherFade");
+  this->WaterLayerIndex = this->LayerNames.Find("Water");
+  this->FeaturesMetadataLayerIndex = this->LayerNames.Find("FeaturesMetadata");
+  this->MetadataLayerIndex = this->LayerNames.Find("Metadata");
 }
@@ -22,8 +22,23 @@ class UCesiumMaterialUserData : public UAssetUserData {
   GENERATED_BODY()
 
 public:
+  virtual void PostLoad() override;
   virtual void PostEditChangeOwner() override;
 
   UPROPERTY()
   TArray<FString> LayerNames;
+
+  /**
+   * The indices in LayerNames of the layers that Cesium for Unreal sets
+   * parameters on when it creates a tile's material, or INDEX_NONE if the
+   * material doesn't have that layer. These are found from the layer names
+   * whenever they change, rather than every time a material is created.
+   */
+  int32 DitherFadeLayerIndex = INDEX_NONE;
+  int32 WaterLayerIndex = INDEX_NONE;
+  int32 FeaturesMetadataLayerIndex = INDEX_NONE;
+  int32 MetadataLayerIndex = INDEX_NONE;
+
+private:
+  void UpdateLayerIndices();
 };
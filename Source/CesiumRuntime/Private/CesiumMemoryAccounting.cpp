@@ -0,0 +1,243 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMemoryAccounting.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntime.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "StaticMeshResources.h"
+
+DECLARE_MEMORY_STAT(
+    TEXT("Tile Mesh Memory (CPU)"),
+    STAT_CesiumMeshCpuMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Tile Mesh Memory (GPU)"),
+    STAT_CesiumMeshGpuMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Tile Physics Memory (CPU)"),
+    STAT_CesiumPhysicsCpuMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Tile Texture Memory (GPU)"),
+    STAT_CesiumTextureGpuMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Tile Metadata Texture Memory (GPU)"),
+    STAT_CesiumMetadataTextureGpuMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Raster Overlay Texture Memory (GPU)"),
+    STAT_CesiumRasterOverlayTextureGpuMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Tile Material Memory (CPU)"),
+    STAT_CesiumMaterialCpuMemory,
+    STATGROUP_Cesium);
+
+TRACE_DECLARE_MEMORY_COUNTER(CesiumMeshCpu, TEXT("Cesium/Mesh CPU"));
+TRACE_DECLARE_MEMORY_COUNTER(CesiumMeshGpu, TEXT("Cesium/Mesh GPU"));
+TRACE_DECLARE_MEMORY_COUNTER(CesiumPhysicsCpu, TEXT("Cesium/Physics CPU"));
+TRACE_DECLARE_MEMORY_COUNTER(CesiumTextureGpu, TEXT("Cesium/Texture GPU"));
+TRACE_DECLARE_MEMORY_COUNTER(
+    CesiumMetadataTextureGpu,
+    TEXT("Cesium/Metadata Texture GPU"));
+TRACE_DECLARE_MEMORY_COUNTER(
+    CesiumRasterOverlayTextureGpu,
+    TEXT("Cesium/Raster Overlay Texture GPU"));
+TRACE_DECLARE_MEMORY_COUNTER(CesiumMaterialCpu, TEXT("Cesium/Material CPU"));
+
+namespace {
+
+FCesiumTilesetMemoryUsage globalUsage;
+
+void addTexture(
+    TSet<const UTexture*>& textures,
+    const TSharedPtr<CesiumTextureUtility::LoadedTextureResult>& pTexture) {
+  if (pTexture && pTexture->pTexture.IsValid()) {
+    textures.Add(pTexture->pTexture.Get());
+  }
+}
+
+void updateTotals(FCesiumTilesetMemoryUsage& usage) {
+  usage.TotalCpuBytes =
+      usage.MeshCpuBytes + usage.PhysicsCpuBytes + usage.MaterialCpuBytes;
+  usage.TotalGpuBytes = usage.MeshGpuBytes + usage.TextureGpuBytes +
+                        usage.MetadataTextureGpuBytes +
+                        usage.RasterOverlayTextureGpuBytes;
+}
+
+void accumulate(
+    FCesiumTilesetMemoryUsage& total,
+    const FCesiumTilesetMemoryUsage& usage,
+    int64 sign) {
+  total.MeshCpuBytes += sign * usage.MeshCpuBytes;
+  total.MeshGpuBytes += sign * usage.MeshGpuBytes;
+  total.PhysicsCpuBytes += sign * usage.PhysicsCpuBytes;
+  total.TextureGpuBytes += sign * usage.TextureGpuBytes;
+  total.MetadataTextureGpuBytes += sign * usage.MetadataTextureGpuBytes;
+  total.RasterOverlayTextureGpuBytes +=
+      sign * usage.RasterOverlayTextureGpuBytes;
+  total.MaterialCpuBytes += sign * usage.MaterialCpuBytes;
+  updateTotals(total);
+}
+
+void accumulateGlobal(const FCesiumTilesetMemoryUsage& usage, int64 sign) {
+  accumulate(globalUsage, usage, sign);
+
+  SET_MEMORY_STAT(STAT_CesiumMeshCpuMemory, globalUsage.MeshCpuBytes);
+  SET_MEMORY_STAT(STAT_CesiumMeshGpuMemory, globalUsage.MeshGpuBytes);
+  SET_MEMORY_STAT(STAT_CesiumPhysicsCpuMemory, globalUsage.PhysicsCpuBytes);
+  SET_MEMORY_STAT(STAT_CesiumTextureGpuMemory, globalUsage.TextureGpuBytes);
+  SET_MEMORY_STAT(
+      STAT_CesiumMetadataTextureGpuMemory,
+      globalUsage.MetadataTextureGpuBytes);
+  SET_MEMORY_STAT(
+      STAT_CesiumRasterOverlayTextureGpuMemory,
+      globalUsage.RasterOverlayTextureGpuBytes);
+  SET_MEMORY_STAT(STAT_CesiumMaterialCpuMemory, globalUsage.MaterialCpuBytes);
+
+  TRACE_COUNTER_SET(CesiumMeshCpu, globalUsage.MeshCpuBytes);
+  TRACE_COUNTER_SET(CesiumMeshGpu, globalUsage.MeshGpuBytes);
+  TRACE_COUNTER_SET(CesiumPhysicsCpu, globalUsage.PhysicsCpuBytes);
+  TRACE_COUNTER_SET(CesiumTextureGpu, globalUsage.TextureGpuBytes);
+  TRACE_COUNTER_SET(
+      CesiumMetadataTextureGpu,
+      globalUsage.MetadataTextureGpuBytes);
+  TRACE_COUNTER_SET(
+      CesiumRasterOverlayTextureGpu,
+      globalUsage.RasterOverlayTextureGpuBytes);
+  TRACE_COUNTER_SET(CesiumMaterialCpu, globalUsage.MaterialCpuBytes);
+}
+
+} // namespace
+
+namespace CesiumMemoryAccounting {
+
+FCesiumTilesetMemoryUsage measureModel(const UCesiumGltfComponent& gltf) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MeasureModelMemory)
+
+  FCesiumTilesetMemoryUsage result;
+
+  // Textures that encode feature IDs and metadata are created by
+  // CesiumEncodedFeaturesMetadata and bound to the materials alongside the
+  // glTF textures, so they have to be identified up front.
+  TSet<const UTexture*> metadataTextures;
+  for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+           propertyTable : gltf.EncodedMetadata.propertyTables) {
+    for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty&
+             property : propertyTable.properties) {
+      addTexture(metadataTextures, property.pTexture);
+    }
+  }
+  for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTexture&
+           propertyTexture : gltf.EncodedMetadata.propertyTextures) {
+    for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTextureProperty&
+             property : propertyTexture.properties) {
+      addTexture(metadataTextures, property.pTexture);
+    }
+  }
+
+  TSet<const UTexture*> countedTextures;
+  for (const USceneComponent* pSceneComponent : gltf.GetAttachChildren()) {
+    const UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
+    if (!pPrimitive) {
+      continue;
+    }
+
+    for (const CesiumEncodedFeaturesMetadata::EncodedFeatureIdSet&
+             featureIdSet : pPrimitive->EncodedFeatures.featureIdSets) {
+      if (featureIdSet.texture) {
+        addTexture(metadataTextures, featureIdSet.texture->pTexture);
+      }
+    }
+
+    const UStaticMesh* pMesh = pPrimitive->GetStaticMesh();
+    const FStaticMeshRenderData* pRenderData =
+        pPrimitive->GetPrimitiveRenderData();
+    if (pRenderData) {
+      FResourceSizeEx meshSize(EResourceSizeMode::Exclusive);
+      pRenderData->GetResourceSizeEx(meshSize);
+      const int64 meshBytes = int64(meshSize.GetTotalMemoryBytes());
+      result.MeshGpuBytes += meshBytes;
+      if (pMesh && pMesh->bAllowCPUAccess) {
+        result.MeshCpuBytes += meshBytes;
+      }
+    }
+
+    result.PhysicsCpuBytes += measurePhysicsMesh(*pPrimitive);
+
+    for (int32 i = 0; i < pPrimitive->GetNumMaterials(); ++i) {
+      UMaterialInstanceDynamic* pMaterial =
+          Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(i));
+      if (!pMaterial) {
+        continue;
+      }
+
+      result.MaterialCpuBytes += int64(
+          pMaterial->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+
+      for (const FTextureParameterValue& parameter :
+           pMaterial->TextureParameterValues) {
+        const UTexture* pTexture = parameter.ParameterValue;
+        if (!pTexture) {
+          continue;
+        }
+
+        bool alreadyCounted = false;
+        countedTextures.Add(pTexture, &alreadyCounted);
+        if (alreadyCounted) {
+          continue;
+        }
+
+        if (metadataTextures.Contains(pTexture)) {
+          result.MetadataTextureGpuBytes += measureTexture(*pTexture);
+        } else {
+          result.TextureGpuBytes += measureTexture(*pTexture);
+        }
+      }
+    }
+  }
+
+  updateTotals(result);
+  return result;
+}
+
+int64 measurePhysicsMesh(const UCesiumGltfPrimitiveComponent& primitive) {
+  const UStaticMesh* pMesh = primitive.GetStaticMesh();
+  UBodySetup* pBodySetup =
+      pMesh ? pMesh->GetBodySetup() : primitive.OwnedBodySetup;
+  if (!pBodySetup) {
+    return 0;
+  }
+  return int64(
+      pBodySetup->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+}
+
+int64 measureTexture(const UTexture& texture) {
+  return int64(texture.CalcTextureMemorySizeEnum(TMC_AllMips));
+}
+
+void add(
+    FCesiumTilesetMemoryUsage& total,
+    const FCesiumTilesetMemoryUsage& usage) {
+  accumulate(total, usage, 1);
+  accumulateGlobal(usage, 1);
+}
+
+void subtract(
+    FCesiumTilesetMemoryUsage& total,
+    const FCesiumTilesetMemoryUsage& usage) {
+  accumulate(total, usage, -1);
+  accumulateGlobal(usage, -1);
+}
+
+const FCesiumTilesetMemoryUsage& getGlobalUsage() { return globalUsage; }
+
+} // namespace CesiumMemoryAccounting
@@ -0,0 +1,53 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTilesetMemoryUsage.h"
+
+class UCesiumGltfComponent;
+class UCesiumGltfPrimitiveComponent;
+class UTexture;
+
+/**
+ * Measures the memory held by the Unreal Engine resources created for tiles,
+ * and keeps the totals across all tilesets that are shown by `stat Cesium`
+ * and as Unreal Insights counters. Must only be used from the game thread.
+ */
+namespace CesiumMemoryAccounting {
+
+/**
+ * Measures the meshes, physics meshes, textures, and materials of a tile's
+ * model, other than its raster overlay textures.
+ */
+FCesiumTilesetMemoryUsage measureModel(const UCesiumGltfComponent& gltf);
+
+/**
+ * Measures the memory of a primitive's physics mesh, in bytes.
+ */
+int64 measurePhysicsMesh(const UCesiumGltfPrimitiveComponent& primitive);
+
+/**
+ * Measures the memory of a texture, in bytes.
+ */
+int64 measureTexture(const UTexture& texture);
+
+/**
+ * Adds a tile's usage to its tileset's total and to the global total.
+ */
+void add(
+    FCesiumTilesetMemoryUsage& total,
+    const FCesiumTilesetMemoryUsage& usage);
+
+/**
+ * Removes a tile's usage from its tileset's total and from the global total.
+ */
+void subtract(
+    FCesiumTilesetMemoryUsage& total,
+    const FCesiumTilesetMemoryUsage& usage);
+
+/**
+ * Gets the usage of every tileset's loaded tiles combined.
+ */
+const FCesiumTilesetMemoryUsage& getGlobalUsage();
+
+} // namespace CesiumMemoryAccounting
@@ -0,0 +1,137 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMemoryPressure.h"
+#include "CesiumCoalescingAssetAccessor.h"
+#include "CesiumDecodedContentCache.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTexturePool.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CoreDelegates.h"
+
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Memory Pressure Active"),
+    STAT_CesiumMemoryPressureActive,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Memory Warnings"),
+    STAT_CesiumMemoryWarnings,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_COUNTER_STAT(
+    TEXT("Memory Pressure SSE Scale"),
+    STAT_CesiumMemoryPressureScreenSpaceErrorScale,
+    STATGROUP_Cesium);
+
+/*static*/ CesiumMemoryPressure& CesiumMemoryPressure::get() {
+  static CesiumMemoryPressure memoryPressure;
+  return memoryPressure;
+}
+
+void CesiumMemoryPressure::startListening() {
+  if (this->_memoryTrimHandle.IsValid()) {
+    return;
+  }
+
+  this->_memoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddLambda(
+      [this]() { this->_warningReceived = true; });
+}
+
+void CesiumMemoryPressure::stopListening() {
+  if (!this->_memoryTrimHandle.IsValid()) {
+    return;
+  }
+
+  FCoreDelegates::GetMemoryTrimDelegate().Remove(this->_memoryTrimHandle);
+  this->_memoryTrimHandle.Reset();
+}
+
+void CesiumMemoryPressure::notifyMemoryWarning() {
+  this->_warningReceived = true;
+  this->update(0.0f);
+}
+
+void CesiumMemoryPressure::update(float deltaTime) {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+
+  bool warning = this->_warningReceived.exchange(false);
+
+  // Polling isn't a warning in itself while the response is already active,
+  // so that memory that stays low doesn't empty the caches every frame. It
+  // does keep the response from ending, though.
+  const int64 lowAvailableBytes = pSettings->LowAvailablePhysicalMemoryBytes;
+  const bool lowAvailable =
+      lowAvailableBytes > 0 &&
+      int64(FPlatformMemory::GetStats().AvailablePhysical) < lowAvailableBytes;
+  if (lowAvailable && !this->_active) {
+    warning = true;
+  }
+
+  if (warning) {
+    this->respond();
+  } else if (this->_active) {
+    this->_timeSinceWarning =
+        lowAvailable ? 0.0f : this->_timeSinceWarning + deltaTime;
+    if (this->_timeSinceWarning >= pSettings->MemoryPressureRecoveryTime) {
+      this->_active = false;
+      UE_LOG(
+          LogCesium,
+          Log,
+          TEXT(
+              "No memory warnings for %.0f seconds, so tilesets are returning to their usual limits."),
+          this->_timeSinceWarning);
+    }
+  }
+
+  SET_DWORD_STAT(STAT_CesiumMemoryPressureActive, this->_active ? 1 : 0);
+  SET_DWORD_STAT(STAT_CesiumMemoryWarnings, this->_warningCount);
+  SET_FLOAT_STAT(
+      STAT_CesiumMemoryPressureScreenSpaceErrorScale,
+      this->getScreenSpaceErrorScale());
+}
+
+double CesiumMemoryPressure::getCachedBytesScale() const {
+  return this->_active
+             ? double(GetDefault<UCesiumRuntimeSettings>()
+                          ->MemoryPressureCachedBytesScale)
+             : 1.0;
+}
+
+double CesiumMemoryPressure::getScreenSpaceErrorScale() const {
+  return this->_active
+             ? double(GetDefault<UCesiumRuntimeSettings>()
+                          ->MemoryPressureScreenSpaceErrorScale)
+             : 1.0;
+}
+
+void CesiumMemoryPressure::respond() {
+  ++this->_warningCount;
+  this->_timeSinceWarning = 0.0f;
+
+  const int64 decodedBytes = CesiumDecodedContentCache::get().getBytes();
+  CesiumDecodedContentCache::get().clear();
+  CesiumCoalescingAssetAccessor::clearSharedResponses();
+  CesiumTexturePool::get().trim();
+
+  if (!this->_active) {
+    this->_active = true;
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "Memory is low, so tilesets are lowering their detail and cache limits. Freed %lld bytes of decoded tile content."),
+        decodedBytes);
+  }
+}
+
+void CesiumMemoryPressure::Tick(float DeltaTime) { this->update(DeltaTime); }
+
+ETickableTickType CesiumMemoryPressure::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool CesiumMemoryPressure::IsTickableWhenPaused() const { return true; }
+
+bool CesiumMemoryPressure::IsTickableInEditor() const { return true; }
+
+TStatId CesiumMemoryPressure::GetStatId() const { return TStatId(); }
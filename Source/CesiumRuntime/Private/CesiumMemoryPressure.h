@@ -0,0 +1,98 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Delegates/IDelegateInstance.h"
+#include "Tickable.h"
+#include <atomic>
+
+/**
+ * Responds to low memory, so that running out of it lowers the detail of
+ * tilesets rather than getting the application killed.
+ *
+ * Memory is considered low when the operating system warns that it is, by
+ * broadcasting FCoreDelegates' memory trim delegate, or when less physical
+ * memory is available than "Low Available Physical Memory Bytes". Memory
+ * warnings are common on mobile platforms and standalone headsets, which
+ * terminate applications that don't give memory back.
+ *
+ * On each warning, the shared caches of recently received raster overlay
+ * tiles and decoded tile content are emptied, and the raster overlay textures
+ * waiting to be reused are destroyed. Until "Memory Pressure Recovery Time"
+ * has passed without another warning, every tileset also caches fewer tiles,
+ * doesn't preload ancestors or siblings, and uses a larger maximum
+ * screen-space error.
+ *
+ * All functions must be called from the game thread, except for the memory
+ * trim delegate, which may be broadcast from any thread.
+ */
+class CesiumMemoryPressure : FTickableGameObject {
+public:
+  /**
+   * Gets the memory pressure response shared by all tilesets.
+   */
+  static CesiumMemoryPressure& get();
+
+  /**
+   * Starts listening to the operating system's memory warnings.
+   */
+  void startListening();
+
+  /**
+   * Stops listening to the operating system's memory warnings.
+   */
+  void stopListening();
+
+  /**
+   * Responds to a memory warning, as if one was received from the operating
+   * system.
+   */
+  void notifyMemoryWarning();
+
+  /**
+   * Advances the time since the last memory warning, and checks the available
+   * physical memory.
+   *
+   * @param deltaTime The time since the last update, in seconds.
+   */
+  void update(float deltaTime);
+
+  /**
+   * Determines whether memory is currently considered low.
+   */
+  bool isActive() const { return this->_active; }
+
+  /**
+   * Gets the factor to multiply each tileset's maximum cached bytes by.
+   */
+  double getCachedBytesScale() const;
+
+  /**
+   * Gets the factor to multiply each tileset's maximum screen-space error by.
+   */
+  double getScreenSpaceErrorScale() const;
+
+  /**
+   * Gets the number of memory warnings that have been responded to.
+   */
+  int32 getWarningCount() const { return this->_warningCount; }
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const override;
+
+private:
+  void respond();
+
+  FDelegateHandle _memoryTrimHandle;
+
+  // Set by memory warnings from any thread, and responded to by the next
+  // update.
+  std::atomic<bool> _warningReceived = false;
+
+  bool _active = false;
+  float _timeSinceWarning = 0.0f;
+  int32 _warningCount = 0;
+};
@@ -0,0 +1,360 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshDistanceField.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntime.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "DistanceFieldAtlas.h"
+#include "Engine/StaticMesh.h"
+#include "Math/UnrealMathUtility.h"
+#include "StaticMeshResources.h"
+
+namespace {
+// The number of distance field voxels per Unreal unit, which is the default
+// of the engine's r.DistanceFields.DefaultVoxelDensity.
+constexpr float VoxelsPerUnit = 0.2f;
+
+// The largest number of bricks along each side of the highest-resolution mip.
+// Tiles are much larger than most static meshes, so this, rather than the
+// voxel density, usually determines the resolution, and it bounds the time
+// it takes to build the distance field of a tile.
+constexpr int32 MaximumBricksPerDimension = 12;
+
+struct Triangle {
+  FVector v0;
+  FVector v1;
+  FVector v2;
+  // The normal of the front face of the triangle, which isn't normalized.
+  FVector normal;
+  FBox3f bounds;
+};
+
+float computeSignedDistance(
+    const FVector3f& position,
+    const TArray<const Triangle*>& candidates,
+    float maximumDistance) {
+  const FVector point(position);
+  double closestDistance = maximumDistance;
+  bool isInside = false;
+
+  for (const Triangle* pTriangle : candidates) {
+    const FVector closestPoint = FMath::ClosestPointOnTriangleToPoint(
+        point,
+        pTriangle->v0,
+        pTriangle->v1,
+        pTriangle->v2);
+    const double distance = FVector::Dist(point, closestPoint);
+    if (distance < closestDistance) {
+      closestDistance = distance;
+      isInside =
+          FVector::DotProduct(point - closestPoint, pTriangle->normal) < 0.0;
+    }
+  }
+
+  return isInside ? -float(closestDistance) : float(closestDistance);
+}
+
+/**
+ * Builds one mip of a sparse distance field, the same way as the engine's
+ * mesh distance field builder: the volume is divided into an indirection
+ * grid of bricks, and only the bricks that the surface passes through are
+ * stored, after the indirection table.
+ */
+void buildMip(
+    const TArray<Triangle>& triangles,
+    const FBox3f& localSpaceMeshBounds,
+    float localToVolumeScale,
+    const FIntVector& indirectionDimensions,
+    FSparseDistanceFieldMip& mip,
+    TArray<uint8>& mipData) {
+  // Expand the bounds by a voxel so that gradients can be found with bilinear
+  // filtering at the edges of the mesh.
+  const FVector3f texelObjectSpaceSize =
+      localSpaceMeshBounds.GetSize() /
+      FVector3f(
+          indirectionDimensions * DistanceField::UniqueDataBrickSize -
+          FIntVector(2 * DistanceField::MeshDistanceFieldObjectBorder));
+  const FBox3f volumeBounds =
+      localSpaceMeshBounds.ExpandBy(texelObjectSpaceSize);
+
+  const FVector3f indirectionVoxelSize =
+      volumeBounds.GetSize() / FVector3f(indirectionDimensions);
+  const FVector3f voxelSize =
+      indirectionVoxelSize / float(DistanceField::UniqueDataBrickSize);
+
+  const float maximumVolumeSpaceDistance =
+      (voxelSize * localToVolumeScale).Size() *
+      DistanceField::BandSizeInVoxels;
+  const float maximumLocalSpaceDistance =
+      maximumVolumeSpaceDistance / localToVolumeScale;
+  const FVector2f distanceFieldToVolumeScaleBias(
+      2.0f * maximumVolumeSpaceDistance,
+      -maximumVolumeSpaceDistance);
+
+  constexpr int32 brickVoxelCount = DistanceField::BrickSize *
+                                    DistanceField::BrickSize *
+                                    DistanceField::BrickSize;
+
+  TArray<uint32> indirectionTable;
+  indirectionTable.Init(
+      DistanceField::InvalidBrickIndex,
+      indirectionDimensions.X * indirectionDimensions.Y *
+          indirectionDimensions.Z);
+
+  TArray<uint8> brickData;
+  TArray<const Triangle*> candidates;
+  TArray<uint8> brick;
+  brick.SetNumUninitialized(brickVoxelCount);
+
+  for (int32 z = 0; z < indirectionDimensions.Z; ++z) {
+    for (int32 y = 0; y < indirectionDimensions.Y; ++y) {
+      for (int32 x = 0; x < indirectionDimensions.X; ++x) {
+        const FVector3f brickMinimum =
+            volumeBounds.Min +
+            FVector3f(float(x), float(y), float(z)) * indirectionVoxelSize;
+        const FBox3f brickBounds(
+            brickMinimum,
+            brickMinimum + indirectionVoxelSize);
+
+        // Only the triangles within the encoded distance of the brick can
+        // affect it. A brick without any is entirely outside of the mesh.
+        const FBox3f searchBounds =
+            brickBounds.ExpandBy(maximumLocalSpaceDistance);
+        candidates.Reset();
+        for (const Triangle& triangle : triangles) {
+          if (triangle.bounds.Intersect(searchBounds)) {
+            candidates.Add(&triangle);
+          }
+        }
+        if (candidates.IsEmpty()) {
+          continue;
+        }
+
+        uint8 minimumDistance = MAX_uint8;
+        uint8 maximumDistance = 0;
+        for (int32 voxelZ = 0; voxelZ < DistanceField::BrickSize; ++voxelZ) {
+          for (int32 voxelY = 0; voxelY < DistanceField::BrickSize; ++voxelY) {
+            for (int32 voxelX = 0; voxelX < DistanceField::BrickSize;
+                 ++voxelX) {
+              const FVector3f position =
+                  brickMinimum +
+                  FVector3f(float(voxelX), float(voxelY), float(voxelZ)) *
+                      voxelSize;
+              const float volumeSpaceDistance =
+                  computeSignedDistance(
+                      position,
+                      candidates,
+                      maximumLocalSpaceDistance) *
+                  localToVolumeScale;
+              const float rescaledDistance =
+                  (volumeSpaceDistance - distanceFieldToVolumeScaleBias.Y) /
+                  distanceFieldToVolumeScaleBias.X;
+              const uint8 quantizedDistance = uint8(FMath::Clamp(
+                  FMath::FloorToInt(rescaledDistance * 255.0f + 0.5f),
+                  0,
+                  255));
+
+              brick
+                  [(voxelZ * DistanceField::BrickSize + voxelY) *
+                       DistanceField::BrickSize +
+                   voxelX] = quantizedDistance;
+              minimumDistance = FMath::Min(minimumDistance, quantizedDistance);
+              maximumDistance = FMath::Max(maximumDistance, quantizedDistance);
+            }
+          }
+        }
+
+        // Bricks that are entirely outside or entirely inside of the band
+        // around the surface aren't stored.
+        if (minimumDistance == MAX_uint8 || maximumDistance == 0) {
+          continue;
+        }
+
+        indirectionTable
+            [(z * indirectionDimensions.Y + y) * indirectionDimensions.X + x] =
+                uint32(brickData.Num() / brickVoxelCount);
+        brickData.Append(brick);
+      }
+    }
+  }
+
+  mipData.Reset(indirectionTable.Num() * sizeof(uint32) + brickData.Num());
+  mipData.Append(
+      reinterpret_cast<const uint8*>(indirectionTable.GetData()),
+      indirectionTable.Num() * sizeof(uint32));
+  mipData.Append(brickData);
+
+  mip.IndirectionDimensions = indirectionDimensions;
+  mip.DistanceFieldToVolumeScaleBias = distanceFieldToVolumeScaleBias;
+  mip.NumDistanceFieldBricks = brickData.Num() / brickVoxelCount;
+
+  // Map the mesh bounds, in volume space, to the voxels inside of the border.
+  const FVector3f voxelDimensions =
+      FVector3f(indirectionDimensions * DistanceField::UniqueDataBrickSize);
+  const FVector3f virtualUVMinimum =
+      FVector3f(DistanceField::MeshDistanceFieldObjectBorder) /
+      voxelDimensions;
+  const FVector3f virtualUVSize =
+      (voxelDimensions -
+       FVector3f(2 * DistanceField::MeshDistanceFieldObjectBorder)) /
+      voxelDimensions;
+  const FVector3f volumeSpaceExtent =
+      localSpaceMeshBounds.GetExtent() * localToVolumeScale;
+  mip.VolumeToVirtualUVScale = virtualUVSize / (2.0f * volumeSpaceExtent);
+  mip.VolumeToVirtualUVAdd =
+      volumeSpaceExtent * mip.VolumeToVirtualUVScale + virtualUVMinimum;
+}
+} // namespace
+
+namespace CesiumMeshDistanceField {
+
+bool canHaveMeshDistanceField(const UCesiumGltfPrimitiveComponent& primitive) {
+  if (primitive.PulledAttributes || primitive.OwnedRenderData) {
+    return false;
+  }
+  const UStaticMesh* pMesh = primitive.GetStaticMesh();
+  const FStaticMeshRenderData* pRenderData =
+      pMesh ? pMesh->GetRenderData() : nullptr;
+  return pRenderData && !pRenderData->LODResources.IsEmpty() &&
+         !pRenderData->LODResources[0].DistanceFieldData;
+}
+
+TUniquePtr<FDistanceFieldVolumeData> buildMeshDistanceField(
+    const CesiumPhysicsMeshUtility::CollisionGeometry& geometry) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildMeshDistanceField)
+
+  const int32 vertexCount = int32(geometry.vertices.Size());
+  TArray<Triangle> triangles;
+  triangles.Reserve(geometry.indices.Num() / 3);
+  FBox3f bounds(ForceInit);
+
+  for (int32 i = 0; i + 2 < geometry.indices.Num(); i += 3) {
+    const uint32 index0 = geometry.indices[i];
+    const uint32 index1 = geometry.indices[i + 1];
+    const uint32 index2 = geometry.indices[i + 2];
+    if (index0 >= uint32(vertexCount) || index1 >= uint32(vertexCount) ||
+        index2 >= uint32(vertexCount)) {
+      continue;
+    }
+
+    Triangle& triangle = triangles.Emplace_GetRef();
+    triangle.v0 = FVector(geometry.vertices.X(index0));
+    triangle.v1 = FVector(geometry.vertices.X(index1));
+    triangle.v2 = FVector(geometry.vertices.X(index2));
+
+    // The Y axis of the positions is flipped from glTF, which reverses the
+    // winding order of the front faces.
+    triangle.normal = FVector::CrossProduct(
+        triangle.v2 - triangle.v0,
+        triangle.v1 - triangle.v0);
+    if (triangle.normal.IsNearlyZero(1e-12)) {
+      triangles.Pop(false);
+      continue;
+    }
+
+    triangle.bounds = FBox3f(ForceInit);
+    triangle.bounds += FVector3f(triangle.v0);
+    triangle.bounds += FVector3f(triangle.v1);
+    triangle.bounds += FVector3f(triangle.v2);
+    bounds += triangle.bounds;
+  }
+
+  if (triangles.IsEmpty()) {
+    return nullptr;
+  }
+
+  // Make sure the bounds have a positive size in every direction, so that
+  // flat tiles still get a volume.
+  const FVector3f center = bounds.GetCenter();
+  const FVector3f extent = FVector3f::Max(bounds.GetExtent(), FVector3f(1.0f));
+  const FBox3f localSpaceMeshBounds(center - extent, center + extent);
+
+  // Distance field tracing normalizes volume space by the largest extent.
+  const float localToVolumeScale = 1.0f / extent.GetMax();
+
+  const FVector3f desiredDimensions =
+      localSpaceMeshBounds.GetSize() *
+      (VoxelsPerUnit / float(DistanceField::UniqueDataBrickSize));
+  const FIntVector mip0Dimensions(
+      FMath::Clamp(
+          FMath::RoundToInt(desiredDimensions.X),
+          1,
+          MaximumBricksPerDimension),
+      FMath::Clamp(
+          FMath::RoundToInt(desiredDimensions.Y),
+          1,
+          MaximumBricksPerDimension),
+      FMath::Clamp(
+          FMath::RoundToInt(desiredDimensions.Z),
+          1,
+          MaximumBricksPerDimension));
+
+  TUniquePtr<FDistanceFieldVolumeData> pResult =
+      MakeUnique<FDistanceFieldVolumeData>();
+  pResult->LocalSpaceMeshBounds = localSpaceMeshBounds;
+  pResult->bMostlyTwoSided = false;
+
+  // The lowest-resolution mip is always loaded. The others are streamed in by
+  // the renderer when the primitive is close enough to need them, from bulk
+  // data that is kept in memory.
+  TArray<uint8> streamableMipData;
+  TArray<uint8> mipData;
+  for (int32 mipIndex = 0; mipIndex < DistanceField::NumMips; ++mipIndex) {
+    const FIntVector indirectionDimensions(
+        FMath::DivideAndRoundUp(mip0Dimensions.X, 1 << mipIndex),
+        FMath::DivideAndRoundUp(mip0Dimensions.Y, 1 << mipIndex),
+        FMath::DivideAndRoundUp(mip0Dimensions.Z, 1 << mipIndex));
+
+    FSparseDistanceFieldMip& mip = pResult->Mips[mipIndex];
+    buildMip(
+        triangles,
+        localSpaceMeshBounds,
+        localToVolumeScale,
+        indirectionDimensions,
+        mip,
+        mipData);
+
+    if (mipIndex == DistanceField::NumMips - 1) {
+      pResult->AlwaysLoadedMip = MoveTemp(mipData);
+    } else {
+      mip.BulkOffset = uint32(streamableMipData.Num());
+      mip.BulkSize = uint32(mipData.Num());
+      streamableMipData.Append(mipData);
+    }
+  }
+
+  pResult->StreamableMips.Lock(LOCK_READ_WRITE);
+  void* pStreamableMips =
+      pResult->StreamableMips.Realloc(streamableMipData.Num());
+  FMemory::Memcpy(
+      pStreamableMips,
+      streamableMipData.GetData(),
+      streamableMipData.Num());
+  pResult->StreamableMips.Unlock();
+
+  return pResult;
+}
+
+void applyMeshDistanceField(
+    UCesiumGltfPrimitiveComponent& primitive,
+    TUniquePtr<FDistanceFieldVolumeData>&& pDistanceField) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyMeshDistanceField)
+
+  if (!pDistanceField || !canHaveMeshDistanceField(primitive)) {
+    return;
+  }
+
+  // The render data owns the distance field from now on, and deletes it with
+  // the rest of the static mesh. Scene proxies read it when they're created,
+  // so the existing ones are replaced.
+  FStaticMeshRenderData* pRenderData =
+      primitive.GetStaticMesh()->GetRenderData();
+  pRenderData->LODResources[0].DistanceFieldData = pDistanceField.Release();
+
+  primitive.MarkRenderStateDirty();
+  if (primitive.InstancesComponent) {
+    primitive.InstancesComponent->MarkRenderStateDirty();
+  }
+}
+
+} // namespace CesiumMeshDistanceField
@@ -0,0 +1,44 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumPhysicsMeshUtility.h"
+#include "Templates/UniquePtr.h"
+
+class FDistanceFieldVolumeData;
+class UCesiumGltfPrimitiveComponent;
+
+namespace CesiumMeshDistanceField {
+/**
+ * @brief Determines whether a distance field built for the given primitive
+ * would be drawn. Only primitives drawn from their static mesh by the
+ * engine's static mesh scene proxy have distance fields.
+ */
+bool canHaveMeshDistanceField(const UCesiumGltfPrimitiveComponent& primitive);
+
+/**
+ * @brief Builds a sparse signed distance field from the triangles of a
+ * primitive, in the format of the distance fields that the engine builds for
+ * static mesh assets. This may be called from any thread.
+ *
+ * The sign of the distance is found from the winding order of the closest
+ * triangle, so the inside of a tile's surface is the side that faces away
+ * from its front faces. Lumen card representations aren't built.
+ *
+ * @param geometry The geometry gathered by
+ * CesiumPhysicsMeshUtility::gatherCollisionGeometry.
+ * @return The distance field, or nullptr if the geometry has no triangles.
+ */
+TUniquePtr<FDistanceFieldVolumeData> buildMeshDistanceField(
+    const CesiumPhysicsMeshUtility::CollisionGeometry& geometry);
+
+/**
+ * @brief Gives a distance field that was built after the primitive component
+ * was created to its static mesh, and recreates the render state of the
+ * primitive so the distance field takes effect. Must be called from the game
+ * thread.
+ */
+void applyMeshDistanceField(
+    UCesiumGltfPrimitiveComponent& primitive,
+    TUniquePtr<FDistanceFieldVolumeData>&& pDistanceField);
+} // namespace CesiumMeshDistanceField
@@ -0,0 +1,227 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMetadataIndex.h"
+#include "Algo/BinarySearch.h"
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumModelMetadata.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumPropertyTableProperty.h"
+#include <limits>
+
+namespace {
+struct CaseSensitiveLess {
+  bool operator()(const FString& lhs, const FString& rhs) const {
+    return lhs.Compare(rhs, ESearchCase::CaseSensitive) < 0;
+  }
+};
+
+const FCesiumPropertyTableProperty* findProperty(
+    const UCesiumGltfComponent& tile,
+    const FString& propertyTableName,
+    const FString& propertyName) {
+  const TArray<FCesiumPropertyTable>& propertyTables =
+      UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(tile.Metadata);
+  for (const FCesiumPropertyTable& propertyTable : propertyTables) {
+    if (CesiumEncodedFeaturesMetadata::getNameForPropertyTable(
+            propertyTable) == propertyTableName) {
+      return UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable)
+          .Find(propertyName);
+    }
+  }
+  return nullptr;
+}
+
+bool parseNumber(const FString& value, double& number) {
+  if (value.Equals(TEXT("true"), ESearchCase::IgnoreCase)) {
+    number = 1.0;
+    return true;
+  }
+  if (value.Equals(TEXT("false"), ESearchCase::IgnoreCase)) {
+    number = 0.0;
+    return true;
+  }
+  return LexTryParseString(number, *value);
+}
+
+template <typename T, typename Less>
+void sortByValue(TArray<T>& values, TArray<int64>& featureIDs, Less less) {
+  TArray<int32> order;
+  order.SetNumUninitialized(values.Num());
+  for (int32 i = 0; i < order.Num(); ++i) {
+    order[i] = i;
+  }
+  order.StableSort(
+      [&values, &less](int32 lhs, int32 rhs) {
+        return less(values[lhs], values[rhs]);
+      });
+
+  TArray<T> sortedValues;
+  sortedValues.Reserve(values.Num());
+  TArray<int64> sortedFeatureIDs;
+  sortedFeatureIDs.Reserve(values.Num());
+  for (int32 i : order) {
+    sortedValues.Add(MoveTemp(values[i]));
+    sortedFeatureIDs.Add(featureIDs[i]);
+  }
+  values = MoveTemp(sortedValues);
+  featureIDs = MoveTemp(sortedFeatureIDs);
+}
+} // namespace
+
+void CesiumMetadataIndex::addTile(UCesiumGltfComponent& tile) {
+  this->_tiles.Add(&tile);
+  for (auto& columnIt : this->_columns) {
+    indexTile(tile, columnIt.Key, columnIt.Value);
+  }
+}
+
+void CesiumMetadataIndex::removeTile(const UCesiumGltfComponent& tile) {
+  this->_tiles.RemoveAllSwap(
+      [&tile](const TWeakObjectPtr<UCesiumGltfComponent>& pTile) {
+        return !pTile.IsValid() || pTile.Get() == &tile;
+      });
+  for (auto& columnIt : this->_columns) {
+    columnIt.Value.tiles.Remove(&tile);
+  }
+}
+
+TArray<FCesiumFeatureHandle> CesiumMetadataIndex::findInRange(
+    const FString& propertyTableName,
+    const FString& propertyName,
+    double minimum,
+    double maximum) {
+  TArray<FCesiumFeatureHandle> result;
+  const Column& column =
+      this->findOrAddColumn(propertyTableName, propertyName);
+  for (const auto& tileIt : column.tiles) {
+    const TileValues& values = tileIt.Value;
+    UCesiumGltfComponent* pTile = values.pTile.Get();
+    if (!pTile || !pTile->IsVisible() || values.numbers.IsEmpty()) {
+      continue;
+    }
+
+    const int32 first = Algo::LowerBound(values.numbers, minimum);
+    const int32 last = Algo::UpperBound(values.numbers, maximum);
+    for (int32 i = first; i < last; ++i) {
+      result.Add(FCesiumFeatureHandle{pTile, values.featureIDs[i]});
+    }
+  }
+  return result;
+}
+
+TArray<FCesiumFeatureHandle> CesiumMetadataIndex::findEqual(
+    const FString& propertyTableName,
+    const FString& propertyName,
+    const FString& value) {
+  TArray<FCesiumFeatureHandle> result;
+  const Column& column =
+      this->findOrAddColumn(propertyTableName, propertyName);
+
+  double number = 0.0;
+  const bool isNumber = parseNumber(value, number);
+
+  for (const auto& tileIt : column.tiles) {
+    const TileValues& values = tileIt.Value;
+    UCesiumGltfComponent* pTile = values.pTile.Get();
+    if (!pTile || !pTile->IsVisible()) {
+      continue;
+    }
+
+    int32 first = 0;
+    int32 last = 0;
+    if (!values.strings.IsEmpty()) {
+      first = Algo::LowerBound(values.strings, value, CaseSensitiveLess());
+      last = Algo::UpperBound(values.strings, value, CaseSensitiveLess());
+    } else if (isNumber) {
+      first = Algo::LowerBound(values.numbers, number);
+      last = Algo::UpperBound(values.numbers, number);
+    }
+
+    for (int32 i = first; i < last; ++i) {
+      result.Add(FCesiumFeatureHandle{pTile, values.featureIDs[i]});
+    }
+  }
+  return result;
+}
+
+const CesiumMetadataIndex::Column& CesiumMetadataIndex::findOrAddColumn(
+    const FString& propertyTableName,
+    const FString& propertyName) {
+  const ColumnKey key(propertyTableName, propertyName);
+  Column* pColumn = this->_columns.Find(key);
+  if (pColumn) {
+    return *pColumn;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::IndexMetadataProperty)
+
+  Column& column = this->_columns.Add(key);
+  for (const TWeakObjectPtr<UCesiumGltfComponent>& pTile : this->_tiles) {
+    if (pTile.IsValid()) {
+      indexTile(*pTile, key, column);
+    }
+  }
+  return column;
+}
+
+/*static*/ void CesiumMetadataIndex::indexTile(
+    UCesiumGltfComponent& tile,
+    const ColumnKey& key,
+    Column& column) {
+  const FCesiumPropertyTableProperty* pProperty =
+      findProperty(tile, key.Key, key.Value);
+  if (!pProperty) {
+    return;
+  }
+
+  const FCesiumMetadataValueType valueType =
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValueType(*pProperty);
+  if (valueType.bIsArray) {
+    return;
+  }
+
+  TileValues values;
+  values.pTile = &tile;
+
+  switch (valueType.Type) {
+  case ECesiumMetadataType::Scalar:
+  case ECesiumMetadataType::Boolean: {
+    TCesiumPropertyColumn<double> propertyColumn(*pProperty);
+    TArray<double> numbers;
+    numbers.SetNumUninitialized(propertyColumn.Num());
+    propertyColumn.GetValues(
+        0,
+        numbers,
+        std::numeric_limits<double>::quiet_NaN());
+
+    // Values that can't be read are left out, rather than sorted as NaN.
+    values.numbers.Reserve(numbers.Num());
+    values.featureIDs.Reserve(numbers.Num());
+    for (int32 i = 0; i < numbers.Num(); ++i) {
+      if (!FMath::IsNaN(numbers[i])) {
+        values.numbers.Add(numbers[i]);
+        values.featureIDs.Add(i);
+      }
+    }
+    sortByValue(values.numbers, values.featureIDs, TLess<double>());
+    break;
+  }
+  case ECesiumMetadataType::String: {
+    TCesiumPropertyColumn<FString> propertyColumn(*pProperty);
+    values.strings.SetNum(propertyColumn.Num());
+    propertyColumn.GetValues(0, values.strings, FString());
+    values.featureIDs.SetNumUninitialized(values.strings.Num());
+    for (int32 i = 0; i < values.featureIDs.Num(); ++i) {
+      values.featureIDs[i] = i;
+    }
+    sortByValue(values.strings, values.featureIDs, CaseSensitiveLess());
+    break;
+  }
+  default:
+    // Vectors, matrices and enums aren't indexed.
+    return;
+  }
+
+  column.tiles.Add(&tile, MoveTemp(values));
+}
@@ -0,0 +1,96 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumFeatureHandle.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "Templates/Tuple.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UCesiumGltfComponent;
+
+/**
+ * An index of the values of property table properties across the loaded tiles
+ * of a tileset, which finds the features whose values are in a range or equal
+ * to a value without reading every property table.
+ *
+ * A property is indexed the first time it's queried. After that, tiles are
+ * added to and removed from the index as they're loaded and unloaded. The
+ * values of the property in each tile are kept sorted, with their feature IDs,
+ * so a query is a binary search in each tile.
+ *
+ * The index must only be used from the game thread.
+ */
+class CesiumMetadataIndex {
+public:
+  /**
+   * Adds a tile that has been loaded to the properties that are indexed.
+   */
+  void addTile(UCesiumGltfComponent& tile);
+
+  /**
+   * Removes a tile that's being unloaded.
+   */
+  void removeTile(const UCesiumGltfComponent& tile);
+
+  /**
+   * Finds the features of the tiles that are shown whose numeric value of a
+   * property is between minimum and maximum, inclusive.
+   */
+  TArray<FCesiumFeatureHandle> findInRange(
+      const FString& propertyTableName,
+      const FString& propertyName,
+      double minimum,
+      double maximum);
+
+  /**
+   * Finds the features of the tiles that are shown whose value of a property
+   * is equal to the given one. String values are compared case-sensitively.
+   * For numeric and boolean properties, the value is parsed as a number, or as
+   * "true" or "false".
+   */
+  TArray<FCesiumFeatureHandle> findEqual(
+      const FString& propertyTableName,
+      const FString& propertyName,
+      const FString& value);
+
+  /**
+   * Gets the number of properties that are indexed.
+   */
+  int32 getIndexedPropertyCount() const { return this->_columns.Num(); }
+
+private:
+  // The values of a property in one tile, sorted. Only one of numbers or
+  // strings is used, with the feature ID of each value at the same index.
+  struct TileValues {
+    TWeakObjectPtr<UCesiumGltfComponent> pTile;
+    TArray<double> numbers;
+    TArray<FString> strings;
+    TArray<int64> featureIDs;
+  };
+
+  // The values of a property in every tile that has it.
+  struct Column {
+    TMap<const UCesiumGltfComponent*, TileValues> tiles;
+  };
+
+  using ColumnKey = TPair<FString, FString>;
+
+  const Column& findOrAddColumn(
+      const FString& propertyTableName,
+      const FString& propertyName);
+
+  // Adds a tile's values of the column's property to it, if it has the
+  // property and its type can be indexed.
+  static void
+  indexTile(UCesiumGltfComponent& tile, const ColumnKey& key, Column& column);
+
+  // The tiles that have been added, to index properties that are queried
+  // after the tiles were loaded.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> _tiles;
+
+  // The indexed properties, by the names of their tables and themselves.
+  TMap<ColumnKey, Column> _columns;
+};
@@ -4,6 +4,7 @@
 #include "CesiumGltfComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumMetadataValue.h"
+#include "CesiumPrimitiveMerging.h"
 
 static TMap<FString, FCesiumMetadataValue> EmptyCesiumMetadataValueMap;
 
@@ -79,70 +80,252 @@ UCesiumMetadataPickingBlueprintLibrary::GetMetadataValuesForFaceAsStrings(
   return strings;
 }
 
-bool UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(
-    const FHitResult& Hit,
-    int64 GltfTexCoordSetIndex,
-    FVector2D& UV) {
-  const UCesiumGltfPrimitiveComponent* pGltfComponent =
-      Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
-  if (!IsValid(pGltfComponent)) {
-    return false;
+namespace {
+const CesiumTexCoordAccessorType* findTexCoordAccessor(
+    const UCesiumGltfPrimitiveComponent& primitive,
+    int64 gltfTexCoordSetIndex) {
+  if (primitive.PositionAccessor.status() !=
+      CesiumGltf::AccessorViewStatus::Valid) {
+    return nullptr;
   }
 
-  if (pGltfComponent->PositionAccessor.status() !=
-      CesiumGltf::AccessorViewStatus::Valid) {
-    return false;
+  auto accessorIt = primitive.TexCoordAccessorMap.find(gltfTexCoordSetIndex);
+  if (accessorIt == primitive.TexCoordAccessorMap.end()) {
+    return nullptr;
   }
 
-  auto accessorIt =
-      pGltfComponent->TexCoordAccessorMap.find(GltfTexCoordSetIndex);
-  if (accessorIt == pGltfComponent->TexCoordAccessorMap.end()) {
+  return &accessorIt->second;
+}
+
+bool getPickingTriangle(
+    const UCesiumGltfPrimitiveComponent& primitive,
+    const CesiumTexCoordAccessorType& texCoordAccessor,
+    int64 faceIndex,
+    CesiumPickingTriangle& triangle) {
+  if (faceIndex < 0) {
     return false;
   }
 
+  const int64 vertexCount = primitive.PositionAccessor.size();
   std::array<int64, 3> VertexIndices = std::visit(
-      CesiumFaceVertexIndicesFromAccessor{
-          Hit.FaceIndex,
-          pGltfComponent->PositionAccessor.size()},
-      pGltfComponent->IndexAccessor);
+      CesiumFaceVertexIndicesFromAccessor{faceIndex, vertexCount},
+      primitive.IndexAccessor);
+
+  for (size_t i = 0; i < VertexIndices.size(); i++) {
+    const int64 vertexIndex = VertexIndices[i];
+    if (vertexIndex < 0 || vertexIndex >= vertexCount) {
+      return false;
+    }
 
-  // Adapted from UBodySetup::CalcUVAtLocation. Compute the barycentric
-  // coordinates of the point relative to the face, then use those to
-  // interpolate the UVs.
-  std::array<FVector2D, 3> UVs;
-  const CesiumTexCoordAccessorType& accessor = accessorIt->second;
-  for (size_t i = 0; i < UVs.size(); i++) {
     auto maybeTexCoord =
-        std::visit(CesiumTexCoordFromAccessor{VertexIndices[i]}, accessor);
+        std::visit(CesiumTexCoordFromAccessor{vertexIndex}, texCoordAccessor);
     if (!maybeTexCoord) {
       return false;
     }
     const glm::dvec2& texCoord = *maybeTexCoord;
-    UVs[i] = FVector2D(texCoord[0], texCoord[1]);
-  }
+    triangle.UVs[i] = FVector2f(float(texCoord[0]), float(texCoord[1]));
 
-  std::array<FVector, 3> Positions;
-  for (size_t i = 0; i < Positions.size(); i++) {
-    auto& Position = pGltfComponent->PositionAccessor[VertexIndices[i]];
+    const FVector3f& Position = primitive.PositionAccessor[vertexIndex];
     // The Y-component of glTF positions must be inverted
-    Positions[i] = FVector(Position[0], -Position[1], Position[2]);
+    triangle.Positions[i] = FVector3f(Position[0], -Position[1], Position[2]);
   }
 
+  return true;
+}
+
+const TArray<CesiumPickingTriangle>& findOrCreatePickingTriangles(
+    UCesiumGltfPrimitiveComponent& primitive,
+    int32 gltfTexCoordSetIndex,
+    const CesiumTexCoordAccessorType& texCoordAccessor) {
+  auto trianglesIt = primitive.PickingTrianglesMap.find(gltfTexCoordSetIndex);
+  if (trianglesIt != primitive.PickingTrianglesMap.end()) {
+    return trianglesIt->second;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreatePickingTriangles)
+
+  int64 vertexCount = primitive.PositionAccessor.size();
+  if (!std::holds_alternative<std::monostate>(primitive.IndexAccessor)) {
+    vertexCount =
+        std::visit(CesiumCountFromAccessor{}, primitive.IndexAccessor);
+  }
+  const int64 faceCount = vertexCount / 3;
+
+  TArray<CesiumPickingTriangle>& triangles =
+      primitive.PickingTrianglesMap[gltfTexCoordSetIndex];
+  triangles.SetNumZeroed(int32(FMath::Min<int64>(faceCount, MAX_int32)));
+  for (int32 i = 0; i < triangles.Num(); i++) {
+    CesiumPickingTriangle& triangle = triangles[i];
+    triangle.Valid =
+        getPickingTriangle(primitive, texCoordAccessor, i, triangle) ? 1 : 0;
+  }
+
+  return triangles;
+}
+
+FVector2D interpolateUV(
+    const UCesiumGltfPrimitiveComponent& primitive,
+    const CesiumPickingTriangle& triangle,
+    const FVector& worldLocation) {
+  // Adapted from UBodySetup::CalcUVAtLocation. Compute the barycentric
+  // coordinates of the point relative to the face, then use those to
+  // interpolate the UVs.
   const FVector Location =
-      pGltfComponent->GetComponentToWorld().InverseTransformPosition(
-          Hit.Location);
+      primitive.GetComponentToWorld().InverseTransformPosition(worldLocation);
   FVector BaryCoords = FMath::ComputeBaryCentric2D(
       Location,
-      Positions[0],
-      Positions[1],
-      Positions[2]);
+      FVector(triangle.Positions[0]),
+      FVector(triangle.Positions[1]),
+      FVector(triangle.Positions[2]));
 
-  UV = (BaryCoords.X * UVs[0]) + (BaryCoords.Y * UVs[1]) +
-       (BaryCoords.Z * UVs[2]);
+  return (BaryCoords.X * FVector2D(triangle.UVs[0])) +
+         (BaryCoords.Y * FVector2D(triangle.UVs[1])) +
+         (BaryCoords.Z * FVector2D(triangle.UVs[2]));
+}
+} // namespace
 
+bool UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(
+    const FHitResult& Hit,
+    int64 GltfTexCoordSetIndex,
+    FVector2D& UV) {
+  const UCesiumGltfPrimitiveComponent* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
+  if (!IsValid(pGltfComponent)) {
+    return false;
+  }
+
+  const CesiumTexCoordAccessorType* pAccessor =
+      findTexCoordAccessor(*pGltfComponent, GltfTexCoordSetIndex);
+  if (!pAccessor) {
+    return false;
+  }
+
+  CesiumPickingTriangle triangle;
+  if (!getPickingTriangle(
+          *pGltfComponent,
+          *pAccessor,
+          Hit.FaceIndex,
+          triangle)) {
+    return false;
+  }
+
+  UV = interpolateUV(*pGltfComponent, triangle, Hit.Location);
   return true;
 }
 
+TArray<bool> UCesiumMetadataPickingBlueprintLibrary::FindUVsFromHits(
+    const TArray<FHitResult>& Hits,
+    int64 GltfTexCoordSetIndex,
+    TArray<FVector2D>& UVs,
+    bool CacheTriangles) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FindUVsFromHits)
+
+  TArray<bool> found;
+  found.Init(false, Hits.Num());
+  UVs.Init(FVector2D::Zero(), Hits.Num());
+
+  // Hits are usually grouped by component, so only look up the accessors and
+  // triangles again when the component changes.
+  const UPrimitiveComponent* pLastComponent = nullptr;
+  UCesiumGltfPrimitiveComponent* pGltfComponent = nullptr;
+  const CesiumTexCoordAccessorType* pAccessor = nullptr;
+  const TArray<CesiumPickingTriangle>* pTriangles = nullptr;
+
+  for (int32 i = 0; i < Hits.Num(); i++) {
+    const FHitResult& Hit = Hits[i];
+    UPrimitiveComponent* pComponent = Hit.Component.Get();
+    if (pComponent != pLastComponent) {
+      pLastComponent = pComponent;
+      pGltfComponent = Cast<UCesiumGltfPrimitiveComponent>(pComponent);
+      pAccessor = IsValid(pGltfComponent)
+                      ? findTexCoordAccessor(
+                            *pGltfComponent,
+                            GltfTexCoordSetIndex)
+                      : nullptr;
+      pTriangles = pAccessor && CacheTriangles
+                       ? &findOrCreatePickingTriangles(
+                             *pGltfComponent,
+                             int32(GltfTexCoordSetIndex),
+                             *pAccessor)
+                       : nullptr;
+    }
+
+    if (!pAccessor) {
+      continue;
+    }
+
+    CesiumPickingTriangle triangle;
+    const CesiumPickingTriangle* pTriangle = nullptr;
+    if (pTriangles) {
+      if (pTriangles->IsValidIndex(Hit.FaceIndex) &&
+          (*pTriangles)[Hit.FaceIndex].Valid) {
+        pTriangle = &(*pTriangles)[Hit.FaceIndex];
+      }
+    } else if (getPickingTriangle(
+                   *pGltfComponent,
+                   *pAccessor,
+                   Hit.FaceIndex,
+                   triangle)) {
+      pTriangle = &triangle;
+    }
+
+    if (pTriangle) {
+      UVs[i] = interpolateUV(*pGltfComponent, *pTriangle, Hit.Location);
+      found[i] = true;
+    }
+  }
+
+  return found;
+}
+
+bool UCesiumMetadataPickingBlueprintLibrary::FindSourcePrimitiveFromHit(
+    const FHitResult& Hit,
+    int64& MeshIndex,
+    int64& PrimitiveIndex) {
+  MeshIndex = -1;
+  PrimitiveIndex = -1;
+
+  const UCesiumGltfPrimitiveComponent* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
+  if (!IsValid(pGltfComponent) || !pGltfComponent->pModel ||
+      !pGltfComponent->pMeshPrimitive) {
+    return false;
+  }
+
+  const CesiumGltf::Model& model = *pGltfComponent->pModel;
+  const CesiumGltf::MeshPrimitive& primitive = *pGltfComponent->pMeshPrimitive;
+
+  if (CesiumPrimitiveMerging::isMergedPrimitive(primitive)) {
+    int64_t meshIndex = -1;
+    int64_t primitiveIndex = -1;
+    if (!CesiumPrimitiveMerging::findSourcePrimitive(
+            primitive,
+            Hit.FaceIndex,
+            meshIndex,
+            primitiveIndex)) {
+      return false;
+    }
+    MeshIndex = meshIndex;
+    PrimitiveIndex = primitiveIndex;
+    return true;
+  }
+
+  for (size_t i = 0; i < model.meshes.size(); ++i) {
+    const std::vector<CesiumGltf::MeshPrimitive>& primitives =
+        model.meshes[i].primitives;
+    if (!primitives.empty() && &primitive >= primitives.data() &&
+        &primitive < primitives.data() + primitives.size()) {
+      MeshIndex = int64(i);
+      PrimitiveIndex = CesiumPrimitiveMerging::getSourcePrimitiveIndex(
+          primitive,
+          int64_t(&primitive - primitives.data()));
+      return true;
+    }
+  }
+
+  return false;
+}
+
 TMap<FString, FCesiumMetadataValue>
 UCesiumMetadataPickingBlueprintLibrary::GetPropertyTableValuesFromHit(
     const FHitResult& Hit,
@@ -0,0 +1,150 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMobileThrottling.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/CoreDelegates.h"
+#include "UnrealTaskProcessor.h"
+
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Mobile Throttling Level"),
+    STAT_CesiumMobileThrottlingLevel,
+    STATGROUP_Cesium);
+
+namespace {
+// How far above the low battery level the battery must charge before it's no
+// longer low, in percent.
+constexpr int32 BatteryLevelHysteresis = 5;
+} // namespace
+
+/*static*/ CesiumMobileThrottling& CesiumMobileThrottling::get() {
+  static CesiumMobileThrottling mobileThrottling;
+  return mobileThrottling;
+}
+
+void CesiumMobileThrottling::startListening() {
+  if (!this->_temperatureChangeHandle.IsValid()) {
+    this->_temperatureChangeHandle =
+        FCoreDelegates::OnTemperatureChange.AddLambda(
+            [this](ETemperatureSeverity severity) {
+              this->_temperatureSeverity = uint8(severity);
+            });
+  }
+
+  if (!this->_lowPowerModeHandle.IsValid()) {
+    this->_lowPowerModeHandle = FCoreDelegates::OnLowPowerMode.AddLambda(
+        [this](bool lowPowerMode) { this->_lowPowerMode = lowPowerMode; });
+  }
+}
+
+void CesiumMobileThrottling::stopListening() {
+  if (this->_temperatureChangeHandle.IsValid()) {
+    FCoreDelegates::OnTemperatureChange.Remove(this->_temperatureChangeHandle);
+    this->_temperatureChangeHandle.Reset();
+  }
+
+  if (this->_lowPowerModeHandle.IsValid()) {
+    FCoreDelegates::OnLowPowerMode.Remove(this->_lowPowerModeHandle);
+    this->_lowPowerModeHandle.Reset();
+  }
+}
+
+void CesiumMobileThrottling::update(float deltaTime) {
+  const Level previousLevel = this->_level;
+  const Level targetLevel = this->computeTargetLevel();
+
+  if (targetLevel >= this->_level) {
+    this->_level = targetLevel;
+    this->_timeBelowLevel = 0.0f;
+  } else {
+    this->_timeBelowLevel += deltaTime;
+    if (this->_timeBelowLevel >=
+        GetDefault<UCesiumRuntimeSettings>()->ThrottlingRecoveryTime) {
+      this->_level = targetLevel;
+      this->_timeBelowLevel = 0.0f;
+    }
+  }
+
+  if (this->_level != previousLevel) {
+    UnrealTaskProcessor::setWorkerThreadScale(this->scaleForLevel(
+        GetDefault<UCesiumRuntimeSettings>()->ThrottledWorkerThreadScale));
+    UE_LOG(
+        LogCesium,
+        Log,
+        TEXT("Mobile throttling of tilesets changed from level %d to %d."),
+        int32(previousLevel),
+        int32(this->_level));
+  }
+
+  SET_DWORD_STAT(STAT_CesiumMobileThrottlingLevel, uint32(this->_level));
+}
+
+double CesiumMobileThrottling::getScreenSpaceErrorScale() const {
+  return this->scaleForLevel(
+      GetDefault<UCesiumRuntimeSettings>()->ThrottledScreenSpaceErrorScale);
+}
+
+double CesiumMobileThrottling::getTileLoadScale() const {
+  return this->scaleForLevel(
+      GetDefault<UCesiumRuntimeSettings>()->ThrottledTileLoadScale);
+}
+
+CesiumMobileThrottling::Level CesiumMobileThrottling::computeTargetLevel() {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (!pSettings->EnableMobileThrottling) {
+    this->_batteryLow = false;
+    return Level::None;
+  }
+
+  const ETemperatureSeverity severity =
+      ETemperatureSeverity(this->_temperatureSeverity.load());
+  if (severity == ETemperatureSeverity::Serious ||
+      severity == ETemperatureSeverity::Critical) {
+    return Level::Full;
+  }
+
+  // The battery level is unknown, and negative, on platforms without one.
+  const int32 batteryLevel = FPlatformMisc::GetBatteryLevel();
+  if (batteryLevel < 0 || !FPlatformMisc::IsRunningOnBattery()) {
+    this->_batteryLow = false;
+  } else if (batteryLevel < pSettings->ThrottlingLowBatteryLevel) {
+    this->_batteryLow = true;
+  } else if (
+      batteryLevel >=
+      pSettings->ThrottlingLowBatteryLevel + BatteryLevelHysteresis) {
+    this->_batteryLow = false;
+  }
+
+  if (severity == ETemperatureSeverity::Bad || this->_lowPowerMode ||
+      this->_batteryLow) {
+    return Level::Moderate;
+  }
+
+  return Level::None;
+}
+
+double CesiumMobileThrottling::scaleForLevel(double fullScale) const {
+  switch (this->_level) {
+  case Level::Full:
+    return fullScale;
+  case Level::Moderate:
+    return 0.5 * (1.0 + fullScale);
+  case Level::None:
+  default:
+    return 1.0;
+  }
+}
+
+void CesiumMobileThrottling::Tick(float DeltaTime) { this->update(DeltaTime); }
+
+ETickableTickType CesiumMobileThrottling::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool CesiumMobileThrottling::IsTickableWhenPaused() const { return true; }
+
+bool CesiumMobileThrottling::IsTickableInEditor() const { return true; }
+
+TStatId CesiumMobileThrottling::GetStatId() const { return TStatId(); }
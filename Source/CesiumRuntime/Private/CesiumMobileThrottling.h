@@ -0,0 +1,93 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Delegates/IDelegateInstance.h"
+#include "Tickable.h"
+#include <atomic>
+
+/**
+ * Throttles tile streaming while a mobile device is hot or its battery is
+ * low, when "Enable Mobile Throttling" is set in the project settings.
+ *
+ * The level of throttling follows the thermal state and low power mode that
+ * the operating system reports through FCoreDelegates, and the battery level.
+ * It rises as soon as the device's state calls for it, but only falls once
+ * the device has stayed in a better state for "Throttling Recovery Time", so
+ * that it doesn't switch back and forth as the state hovers around a
+ * threshold.
+ *
+ * While throttled, every tileset uses a larger maximum screen-space error and
+ * fewer simultaneous tile loads, and fewer of Cesium's background tasks run
+ * at once.
+ *
+ * All functions must be called from the game thread, except for the
+ * operating system's delegates, which may be broadcast from any thread.
+ */
+class CesiumMobileThrottling : FTickableGameObject {
+public:
+  enum class Level : uint8 { None, Moderate, Full };
+
+  /**
+   * Gets the throttling shared by all tilesets.
+   */
+  static CesiumMobileThrottling& get();
+
+  /**
+   * Starts listening to the operating system's thermal and power reports.
+   */
+  void startListening();
+
+  /**
+   * Stops listening to the operating system's thermal and power reports.
+   */
+  void stopListening();
+
+  /**
+   * Advances the time spent in a better state than the current level calls
+   * for, and checks the battery.
+   *
+   * @param deltaTime The time since the last update, in seconds.
+   */
+  void update(float deltaTime);
+
+  /**
+   * Gets the current level of throttling.
+   */
+  Level getLevel() const { return this->_level; }
+
+  /**
+   * Gets the factor to multiply each tileset's maximum screen-space error by.
+   */
+  double getScreenSpaceErrorScale() const;
+
+  /**
+   * Gets the factor to multiply each tileset's maximum simultaneous tile loads
+   * by.
+   */
+  double getTileLoadScale() const;
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const override;
+
+private:
+  // Gets the level that the device's current state calls for.
+  Level computeTargetLevel();
+
+  // Interpolates from no change to a fully throttled scale by the level.
+  double scaleForLevel(double fullScale) const;
+
+  FDelegateHandle _temperatureChangeHandle;
+  FDelegateHandle _lowPowerModeHandle;
+
+  // Set by the operating system's delegates from any thread.
+  std::atomic<uint8> _temperatureSeverity = 0;
+  std::atomic<bool> _lowPowerMode = false;
+
+  Level _level = Level::None;
+  float _timeBelowLevel = 0.0f;
+  bool _batteryLow = false;
+};
@@ -15,12 +15,10 @@ static FCesiumPropertyTexture EmptyPropertyTexture;
 
 FCesiumModelMetadata::FCesiumModelMetadata(
     const Model& InModel,
-    const ExtensionModelExtStructuralMetadata& Metadata) {
-  this->_propertyTables.Reserve(Metadata.propertyTables.size());
-  for (const auto& propertyTable : Metadata.propertyTables) {
-    this->_propertyTables.Emplace(FCesiumPropertyTable(InModel, propertyTable));
-  }
-
+    const ExtensionModelExtStructuralMetadata& Metadata)
+    : _pModel(&InModel),
+      _pMetadata(&Metadata),
+      _propertyTablesCreated(Metadata.propertyTables.empty()) {
   this->_propertyTextures.Reserve(Metadata.propertyTextures.size());
   for (const auto& propertyTexture : Metadata.propertyTextures) {
     this->_propertyTextures.Emplace(
@@ -28,6 +26,36 @@ FCesiumModelMetadata::FCesiumModelMetadata(
   }
 }
 
+const TArray<FCesiumPropertyTable>&
+FCesiumModelMetadata::getPropertyTables() const {
+  if (this->_propertyTablesCreated) {
+    return this->_propertyTables;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreatePropertyTables)
+
+  this->_propertyTables.Reserve(this->_pMetadata->propertyTables.size());
+  for (const auto& propertyTable : this->_pMetadata->propertyTables) {
+    this->_propertyTables.Emplace(
+        FCesiumPropertyTable(*this->_pModel, propertyTable));
+  }
+  this->_propertyTablesCreated = true;
+
+  return this->_propertyTables;
+}
+
+void FCesiumModelMetadata::setModel(const Model& InModel) {
+  // Created tables only refer to the buffers, which don't move with the glTF.
+  if (this->_propertyTablesCreated) {
+    return;
+  }
+
+  this->_pModel = &InModel;
+  this->_pMetadata =
+      InModel.getExtension<ExtensionModelExtStructuralMetadata>();
+  this->_propertyTablesCreated = this->_pMetadata == nullptr;
+}
+
 /*static*/
 const FCesiumModelMetadata&
 UCesiumModelMetadataBlueprintLibrary::GetModelMetadata(
@@ -53,7 +81,7 @@ UCesiumModelMetadataBlueprintLibrary::GetFeatureTables(
     UPARAM(ref) const FCesiumModelMetadata& ModelMetadata) {
   TMap<FString, FCesiumPropertyTable> result;
   for (const FCesiumPropertyTable& propertyTable :
-       ModelMetadata._propertyTables) {
+       ModelMetadata.getPropertyTables()) {
     result.Add(
         UCesiumPropertyTableBlueprintLibrary::GetPropertyTableName(
             propertyTable),
@@ -80,18 +108,20 @@ UCesiumModelMetadataBlueprintLibrary::GetFeatureTextures(
 const TArray<FCesiumPropertyTable>&
 UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(
     UPARAM(ref) const FCesiumModelMetadata& ModelMetadata) {
-  return ModelMetadata._propertyTables;
+  return ModelMetadata.getPropertyTables();
 }
 
 /*static*/ const FCesiumPropertyTable&
 UCesiumModelMetadataBlueprintLibrary::GetPropertyTable(
     UPARAM(ref) const FCesiumModelMetadata& ModelMetadata,
     const int64 Index) {
-  if (Index < 0 || Index >= ModelMetadata._propertyTables.Num()) {
+  const TArray<FCesiumPropertyTable>& propertyTables =
+      ModelMetadata.getPropertyTables();
+  if (Index < 0 || Index >= propertyTables.Num()) {
     return EmptyPropertyTable;
   }
 
-  return ModelMetadata._propertyTables[Index];
+  return propertyTables[Index];
 }
 
 /*static*/ const TArray<FCesiumPropertyTable>
@@ -0,0 +1,189 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMovieLookAhead.h"
+#include "Camera/CameraComponent.h"
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "LevelSequence.h"
+#include "LevelSequenceActor.h"
+#include "LevelSequencePlayer.h"
+#include "MovieScene.h"
+#include "Sections/MovieScene3DTransformSection.h"
+#include "Sections/MovieSceneCameraCutSection.h"
+#include "Tracks/MovieScene3DTransformTrack.h"
+#include "Tracks/MovieSceneCameraCutTrack.h"
+
+namespace {
+
+template <typename TSection>
+TSection* findActiveSection(
+    const TArray<UMovieSceneSection*>& sections,
+    FFrameNumber frame) {
+  for (UMovieSceneSection* pSection : sections) {
+    if (pSection && pSection->IsActive() &&
+        pSection->GetRange().Contains(frame)) {
+      if (TSection* pTyped = Cast<TSection>(pSection)) {
+        return pTyped;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Evaluates the transform of a camera actor relative to its attach parent,
+// starting from its current relative transform for any channels that aren't
+// keyed.
+FTransform evaluateRelativeTransform(
+    const UMovieScene& movieScene,
+    const FGuid& binding,
+    const USceneComponent& root,
+    FFrameTime time) {
+  FVector location = root.GetRelativeLocation();
+  FRotator rotation = root.GetRelativeRotation();
+
+  const UMovieScene3DTransformTrack* pTrack =
+      movieScene.FindTrack<UMovieScene3DTransformTrack>(binding);
+  UMovieScene3DTransformSection* pSection =
+      pTrack ? findActiveSection<UMovieScene3DTransformSection>(
+                   pTrack->GetAllSections(),
+                   time.FrameNumber)
+             : nullptr;
+  if (!pSection) {
+    return FTransform(rotation, location);
+  }
+
+  // The channels are the translation, then the rotation as roll, pitch and
+  // yaw, then the scale.
+  TArrayView<FMovieSceneDoubleChannel*> channels =
+      pSection->GetChannelProxy().GetChannels<FMovieSceneDoubleChannel>();
+  if (channels.Num() < 6) {
+    return FTransform(rotation, location);
+  }
+
+  double value = 0.0;
+  for (int32 i = 0; i < 3; ++i) {
+    if (channels[i] && channels[i]->Evaluate(time, value)) {
+      location[i] = value;
+    }
+  }
+  if (channels[3] && channels[3]->Evaluate(time, value)) {
+    rotation.Roll = value;
+  }
+  if (channels[4] && channels[4]->Evaluate(time, value)) {
+    rotation.Pitch = value;
+  }
+  if (channels[5] && channels[5]->Evaluate(time, value)) {
+    rotation.Yaw = value;
+  }
+
+  return FTransform(rotation, location);
+}
+
+} // namespace
+
+namespace CesiumMovieLookAhead {
+
+ALevelSequenceActor* findPlayingSequence(const UWorld* pWorld) {
+  if (!pWorld) {
+    return nullptr;
+  }
+
+  for (TActorIterator<ALevelSequenceActor> it(pWorld); it; ++it) {
+    ALevelSequenceActor* pSequenceActor = *it;
+    if (getCurrentFrame(*pSequenceActor)) {
+      return pSequenceActor;
+    }
+  }
+  return nullptr;
+}
+
+std::optional<int32>
+getCurrentFrame(const ALevelSequenceActor& sequenceActor) {
+  const ULevelSequencePlayer* pPlayer = sequenceActor.GetSequencePlayer();
+  if (!IsValid(pPlayer) || !pPlayer->IsPlaying()) {
+    return std::nullopt;
+  }
+  return pPlayer->GetCurrentTime().Time.FloorToFrame().Value;
+}
+
+void addSequenceCameras(
+    const ALevelSequenceActor& sequenceActor,
+    int32 firstFrame,
+    int32 frameCount,
+    const FVector2D& viewportSize,
+    double overrideAspectRatio,
+    std::vector<FCesiumCamera>& cameras) {
+  ULevelSequencePlayer* pPlayer = sequenceActor.GetSequencePlayer();
+  const ULevelSequence* pSequence = sequenceActor.GetSequence();
+  const UMovieScene* pMovieScene =
+      pSequence ? pSequence->GetMovieScene() : nullptr;
+  if (!IsValid(pPlayer) || !pMovieScene) {
+    return;
+  }
+
+  const UMovieSceneCameraCutTrack* pCutTrack =
+      Cast<UMovieSceneCameraCutTrack>(pMovieScene->GetCameraCutTrack());
+  if (!pCutTrack) {
+    return;
+  }
+
+  const FFrameRate displayRate = pPlayer->GetFrameRate();
+  const FFrameRate tickResolution = pMovieScene->GetTickResolution();
+
+  cameras.reserve(cameras.size() + size_t(FMath::Max(frameCount, 0)));
+  for (int32 i = 0; i < frameCount; ++i) {
+    const FFrameTime time = FFrameRate::TransformTime(
+        FFrameTime(FFrameNumber(firstFrame + i)),
+        displayRate,
+        tickResolution);
+
+    const UMovieSceneCameraCutSection* pCut =
+        findActiveSection<UMovieSceneCameraCutSection>(
+            pCutTrack->GetAllSections(),
+            time.FrameNumber);
+    if (!pCut) {
+      continue;
+    }
+
+    const FMovieSceneObjectBindingID& bindingID = pCut->GetCameraBindingID();
+    TArray<UObject*> boundObjects = pPlayer->GetBoundObjects(bindingID);
+    const AActor* pCameraActor =
+        boundObjects.Num() > 0 ? Cast<AActor>(boundObjects[0]) : nullptr;
+    const USceneComponent* pRoot =
+        pCameraActor ? pCameraActor->GetRootComponent() : nullptr;
+    const UCameraComponent* pCamera =
+        pCameraActor ? pCameraActor->FindComponentByClass<UCameraComponent>()
+                     : nullptr;
+    if (!pRoot || !pCamera) {
+      continue;
+    }
+
+    FTransform parentTransform = FTransform::Identity;
+    if (const USceneComponent* pParent = pRoot->GetAttachParent()) {
+      parentTransform =
+          pParent->GetSocketTransform(pRoot->GetAttachSocketName());
+    }
+
+    const FTransform actorTransform =
+        evaluateRelativeTransform(
+            *pMovieScene,
+            bindingID.GetGuid(),
+            *pRoot,
+            time) *
+        parentTransform;
+    const FTransform cameraTransform =
+        pCamera->GetComponentTransform().GetRelativeTransform(
+            pRoot->GetComponentTransform()) *
+        actorTransform;
+
+    cameras.emplace_back(
+        viewportSize,
+        cameraTransform.GetLocation(),
+        cameraTransform.Rotator(),
+        pCamera->FieldOfView,
+        overrideAspectRatio);
+  }
+}
+
+} // namespace CesiumMovieLookAhead
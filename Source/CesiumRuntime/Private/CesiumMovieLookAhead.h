@@ -0,0 +1,54 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCamera.h"
+#include <optional>
+#include <vector>
+
+class ALevelSequenceActor;
+class UWorld;
+
+namespace CesiumMovieLookAhead {
+
+/**
+ * @brief Finds a level sequence actor in the world whose sequence is playing,
+ * such as the one a movie is being rendered from.
+ *
+ * @return The actor, or nullptr if no sequence is playing.
+ */
+ALevelSequenceActor* findPlayingSequence(const UWorld* pWorld);
+
+/**
+ * @brief Gets the frame that a level sequence is playing, at its display
+ * rate, or std::nullopt if it isn't playing.
+ */
+std::optional<int32> getCurrentFrame(const ALevelSequenceActor& sequenceActor);
+
+/**
+ * @brief Adds a camera for each of the given frames of a level sequence,
+ * where the sequence's camera cut track cuts to a camera whose transform is
+ * keyed in the sequence.
+ *
+ * The camera transforms are evaluated from the keys in the root sequence,
+ * relative to each camera actor's current attach parent, without playing the
+ * sequence. Frames whose camera comes from a subsequence, or that have no
+ * camera cut, are skipped.
+ *
+ * @param sequenceActor The actor playing the sequence.
+ * @param firstFrame The first frame, at the sequence's display rate.
+ * @param frameCount The number of frames.
+ * @param viewportSize The viewport size of the cameras.
+ * @param overrideAspectRatio The aspect ratio of the cameras, or 0 to use the
+ * viewport's.
+ * @param cameras The list to add the cameras to.
+ */
+void addSequenceCameras(
+    const ALevelSequenceActor& sequenceActor,
+    int32 firstFrame,
+    int32 frameCount,
+    const FVector2D& viewportSize,
+    double overrideAspectRatio,
+    std::vector<FCesiumCamera>& cameras);
+
+} // namespace CesiumMovieLookAhead
@@ -0,0 +1,146 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumNaniteBuilder.h"
+#include "CesiumRuntime.h"
+#include "StaticMeshResources.h"
+
+#if WITH_EDITOR
+#include "DerivedDataCacheInterface.h"
+#include "Engine/EngineTypes.h"
+#include "Hash/xxhash.h"
+#include "NaniteBuilder.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#endif
+
+namespace CesiumNaniteBuilder {
+
+#if WITH_EDITOR
+
+namespace {
+
+// Change this to invalidate the Nanite meshes in the cache when the way they
+// are built changes. The Nanite builder's own version is also part of the
+// key.
+const TCHAR* NaniteCacheVersion = TEXT("1");
+
+TArray<FStaticMeshBuildVertex>
+getBuildVertices(const FStaticMeshLODResources& lod) {
+  const FPositionVertexBuffer& positions =
+      lod.VertexBuffers.PositionVertexBuffer;
+  const FStaticMeshVertexBuffer& vertices =
+      lod.VertexBuffers.StaticMeshVertexBuffer;
+  const FColorVertexBuffer& colors = lod.VertexBuffers.ColorVertexBuffer;
+
+  const uint32 count = positions.GetNumVertices();
+  const uint32 texCoordCount =
+      FMath::Min(vertices.GetNumTexCoords(), uint32(MAX_STATIC_TEXCOORDS));
+  const bool hasColors = lod.bHasColorVertexData && colors.GetNumVertices() == count;
+
+  TArray<FStaticMeshBuildVertex> result;
+  result.SetNumZeroed(int32(count));
+  for (uint32 i = 0; i < count; ++i) {
+    FStaticMeshBuildVertex& vertex = result[int32(i)];
+    vertex.Position = positions.VertexPosition(i);
+    vertex.TangentX = vertices.VertexTangentX(i);
+    vertex.TangentY = vertices.VertexTangentY(i);
+    vertex.TangentZ = vertices.VertexTangentZ(i);
+    for (uint32 uv = 0; uv < texCoordCount; ++uv) {
+      vertex.UVs[uv] = vertices.GetVertexUV(i, uv);
+    }
+    vertex.Color = hasColors ? colors.VertexColor(i) : FColor::White;
+  }
+  return result;
+}
+
+FString getCacheKey(
+    const TArray<FStaticMeshBuildVertex>& vertices,
+    const TArray<uint32>& indices,
+    uint32 texCoordCount) {
+  FXxHash64Builder hash;
+  hash.Update(vertices.GetData(), vertices.Num() * vertices.GetTypeSize());
+  hash.Update(indices.GetData(), indices.Num() * indices.GetTypeSize());
+  hash.Update(&texCoordCount, sizeof(texCoordCount));
+
+  return FString::Printf(
+      TEXT("CESIUMNANITE_%s_%s_%016llx"),
+      NaniteCacheVersion,
+      *INaniteBuilderModule::Get().GetVersionString(),
+      hash.Finalize().Hash);
+}
+
+} // namespace
+
+bool isSupported() { return true; }
+
+bool build(FStaticMeshRenderData& renderData, const TArray<uint32>& indices) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildNanite)
+
+  if (renderData.LODResources.Num() == 0 || indices.Num() < 3) {
+    return false;
+  }
+
+  const FStaticMeshLODResources& lod = renderData.LODResources[0];
+  const uint32 texCoordCount =
+      lod.VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords();
+
+  TArray<FStaticMeshBuildVertex> vertices = getBuildVertices(lod);
+  const FString cacheKey = getCacheKey(vertices, indices, texCoordCount);
+
+  FDerivedDataCacheInterface& ddc = GetDerivedDataCacheRef();
+
+  TArray<uint8> cached;
+  if (ddc.GetSynchronous(*cacheKey, cached, TEXT("CesiumNanite"))) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadCachedNanite)
+    FMemoryReader reader(cached, true);
+    renderData.NaniteResources.Serialize(reader, nullptr, false);
+    if (!reader.IsError() &&
+        renderData.NaniteResources.PageStreamingStates.Num() > 0) {
+      return true;
+    }
+    renderData.NaniteResources = Nanite::FResources();
+  }
+
+  // The builder modifies its inputs.
+  TArray<uint32> triangleIndices = indices;
+  TArray<int32> materialIndices;
+  materialIndices.SetNumZeroed(triangleIndices.Num() / 3);
+  TArray<uint32> meshTriangleCounts;
+  meshTriangleCounts.Add(uint32(materialIndices.Num()));
+
+  FMeshNaniteSettings settings;
+  settings.bEnabled = true;
+
+  Nanite::FResources resources;
+  if (!INaniteBuilderModule::Get().Build(
+          resources,
+          vertices,
+          triangleIndices,
+          materialIndices,
+          meshTriangleCounts,
+          texCoordCount,
+          settings)) {
+    UE_LOG(LogCesium, Warning, TEXT("Could not build a Nanite mesh."));
+    return false;
+  }
+
+  TArray<uint8> serialized;
+  FMemoryWriter writer(serialized, true);
+  resources.Serialize(writer, nullptr, false);
+  ddc.Put(*cacheKey, serialized, TEXT("CesiumNanite"));
+
+  renderData.NaniteResources = MoveTemp(resources);
+  return true;
+}
+
+#else
+
+bool isSupported() { return false; }
+
+bool build(FStaticMeshRenderData& renderData, const TArray<uint32>& indices) {
+  return false;
+}
+
+#endif
+
+} // namespace CesiumNaniteBuilder
@@ -0,0 +1,34 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+
+class FStaticMeshRenderData;
+
+namespace CesiumNaniteBuilder {
+
+/**
+ * Whether Nanite meshes can be built in this build of Unreal Engine. The
+ * Nanite builder is only available in the editor.
+ */
+bool isSupported();
+
+/**
+ * Builds the Nanite resources of a static mesh from its first LOD, which is
+ * kept as the fallback mesh for rendering paths that don't support Nanite.
+ *
+ * The built resources are stored in the Derived Data Cache, keyed by the
+ * mesh's vertices and indices, and are read from it instead when the same
+ * mesh is built again.
+ *
+ * This may be called from any thread.
+ *
+ * @param renderData The render data, whose LOD 0 vertex buffers must already
+ * be initialized.
+ * @param indices The triangle indices of LOD 0.
+ * @return Whether the render data now has Nanite resources.
+ */
+bool build(FStaticMeshRenderData& renderData, const TArray<uint32>& indices);
+
+} // namespace CesiumNaniteBuilder
@@ -0,0 +1,26 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Vector.h"
+
+/**
+ * The triangles of a primitive that the navigation system builds navigation
+ * meshes from, relative to the primitive's component.
+ *
+ * These are gathered while the primitive is loaded, off the game thread, so
+ * that the primitive component can export them to the navigation system as
+ * they are instead of the static mesh creating navigation collision on the
+ * game thread. They are never modified once created, so they may be read from
+ * the navigation mesh generator's threads.
+ */
+struct CesiumNavigationGeometry {
+  TArray<FVector> vertices;
+
+  /**
+   * The indices of the vertices of each triangle, in the same winding order
+   * as the primitive's index buffer.
+   */
+  TArray<int32> indices;
+};
@@ -3,9 +3,8 @@
 #include "CesiumOriginShiftComponent.h"
 #include "CesiumGeoreference.h"
 #include "CesiumGlobeAnchorComponent.h"
-#include "CesiumSubLevelComponent.h"
 #include "CesiumSubLevelSwitcherComponent.h"
-#include "CesiumWgs84Ellipsoid.h"
+#include "Engine/World.h"
 #include "LevelInstance/LevelInstanceActor.h"
 
 #if WITH_EDITOR
@@ -28,6 +27,15 @@ void UCesiumOriginShiftComponent::SetDistance(double NewDistance) {
   this->Distance = NewDistance;
 }
 
+double UCesiumOriginShiftComponent::GetSubLevelPreloadTime() const {
+  return this->SubLevelPreloadTime;
+}
+
+void UCesiumOriginShiftComponent::SetSubLevelPreloadTime(
+    double NewSubLevelPreloadTime) {
+  this->SubLevelPreloadTime = NewSubLevelPreloadTime;
+}
+
 UCesiumOriginShiftComponent::UCesiumOriginShiftComponent() {
   this->PrimaryComponentTick.bCanEverTick = true;
   this->PrimaryComponentTick.TickGroup = ETickingGroup::TG_PrePhysics;
@@ -93,39 +101,27 @@ void UCesiumOriginShiftComponent::TickComponent(
 
   FVector ActorEcef = GlobeAnchor->GetEarthCenteredEarthFixedPosition();
 
-  ALevelInstance* ClosestActiveLevel = nullptr;
-  double ClosestLevelDistance = std::numeric_limits<double>::max();
-
-  for (int32 i = 0; i < Sublevels.Num(); ++i) {
-    ALevelInstance* Current = Sublevels[i].Get();
-    if (!IsValid(Current))
-      continue;
-
-    UCesiumSubLevelComponent* SubLevelComponent =
-        Current->FindComponentByClass<UCesiumSubLevelComponent>();
-    if (!IsValid(SubLevelComponent))
-      continue;
-
-    if (!SubLevelComponent->GetEnabled())
-      continue;
-
-    FVector LevelEcef =
-        UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightToEarthCenteredEarthFixed(
-            FVector(
-                SubLevelComponent->GetOriginLongitude(),
-                SubLevelComponent->GetOriginLatitude(),
-                SubLevelComponent->GetOriginHeight()));
-
-    double LevelDistance = FVector::Distance(LevelEcef, ActorEcef);
-    if (LevelDistance < SubLevelComponent->GetLoadRadius() &&
-        LevelDistance < ClosestLevelDistance) {
-      ClosestActiveLevel = Current;
-      ClosestLevelDistance = LevelDistance;
-    }
-  }
+  ALevelInstance* ClosestActiveLevel =
+      Switcher->FindSubLevelAtEarthCenteredEarthFixedPosition(ActorEcef);
 
   Switcher->SetTargetSubLevel(ClosestActiveLevel);
 
+  // Preload the sub-level that the Actor will be in if it keeps its current
+  // velocity. ECEF positions aren't affected by origin shifts, so the
+  // velocity is too.
+  ALevelInstance* PredictedLevel = nullptr;
+  if (this->SubLevelPreloadTime > 0.0 && this->_hasPreviousEcef &&
+      DeltaTime > 0.0f) {
+    const FVector Velocity = (ActorEcef - this->_previousEcef) / DeltaTime;
+    PredictedLevel = Switcher->FindSubLevelAtEarthCenteredEarthFixedPosition(
+        ActorEcef + Velocity * this->SubLevelPreloadTime,
+        ClosestActiveLevel);
+  }
+  Switcher->SetPreloadSubLevel(PredictedLevel);
+
+  this->_previousEcef = ActorEcef;
+  this->_hasPreviousEcef = true;
+
   // Only shift the origin when we're outside of all sub-levels.
   bool doOriginShift =
       Switcher->GetTargetSubLevel() == nullptr &&
@@ -144,6 +140,19 @@ void UCesiumOriginShiftComponent::TickComponent(
   if (doOriginShift) {
     if (this->Mode == ECesiumOriginShiftMode::ChangeCesiumGeoreference) {
       Georeference->SetOriginEarthCenteredEarthFixed(ActorEcef);
+    } else if (
+        this->Mode == ECesiumOriginShiftMode::ChangeWorldOriginLocation) {
+      UWorld* World = this->GetWorld();
+      if (IsValid(World) && World->IsGameWorld()) {
+        // The world origin is an integer location, so this leaves the Actor
+        // within a centimeter of the new origin.
+        const FIntVector& OriginLocation = World->OriginLocation;
+        const FVector ActorLocation = this->GetOwner()->GetActorLocation();
+        World->SetNewWorldOrigin(FIntVector(
+            clampedAdd(ActorLocation.X, OriginLocation.X),
+            clampedAdd(ActorLocation.Y, OriginLocation.Y),
+            clampedAdd(ActorLocation.Z, OriginLocation.Z)));
+      }
     } else {
       check(false && "Missing ECesiumOriginShiftMode implementation.")
     }
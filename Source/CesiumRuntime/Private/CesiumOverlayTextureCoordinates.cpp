@@ -0,0 +1,89 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumOverlayTextureCoordinates.h"
+#include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "Cesium3DTilesSelection/Tile.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/WebMercatorProjection.h"
+#include <glm/gtc/matrix_access.hpp>
+#include <variant>
+
+using namespace CesiumGeospatial;
+
+namespace CesiumOverlayTextureCoordinates {
+
+std::optional<TileProjection>
+getTileProjection(const Cesium3DTilesSelection::Tile& tile, int32 id) {
+  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (!pRenderContent || id < 0) {
+    return std::nullopt;
+  }
+
+  const auto& details = pRenderContent->getRasterOverlayDetails();
+  if (size_t(id) >= details.rasterOverlayProjections.size() ||
+      size_t(id) >= details.rasterOverlayRectangles.size()) {
+    return std::nullopt;
+  }
+
+  return TileProjection{
+      Cesium3DTilesSelection::getBoundingVolumeCenter(
+          tile.getBoundingVolume()),
+      details.rasterOverlayProjections[id],
+      details.rasterOverlayRectangles[id]};
+}
+
+std::optional<MaterialParameters> computeMaterialParameters(
+    const glm::dmat4& localToEcef,
+    const TileProjection& projection) {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const std::optional<Cartographic> maybeCenter =
+      ellipsoid.cartesianToCartographic(projection.center);
+  const double width = projection.rectangle.computeWidth();
+  const double height = projection.rectangle.computeHeight();
+  if (!maybeCenter || width <= 0.0 || height <= 0.0) {
+    return std::nullopt;
+  }
+  const Cartographic& center = *maybeCenter;
+
+  const glm::dvec3& radii = ellipsoid.getRadii();
+  const double eccentricitySquared =
+      1.0 - (radii.z * radii.z) / (radii.x * radii.x);
+  const double sinLatitude = glm::sin(center.latitude);
+  const double primeVerticalRadius =
+      radii.x /
+      glm::sqrt(1.0 - eccentricitySquared * sinLatitude * sinLatitude);
+  const double distanceToAxis = primeVerticalRadius + center.height;
+
+  // The projections scale longitude and latitude by the semi-major axis, so
+  // the texture coordinates change by that much, over the size of the
+  // rectangle, per radian.
+  const glm::dvec3 projected = projectPosition(projection.projection, center);
+  const bool isWebMercator =
+      std::holds_alternative<WebMercatorProjection>(projection.projection);
+
+  MaterialParameters result;
+  result.origin = FVector4(
+      projection.center.x,
+      projection.center.y,
+      projection.center.z,
+      isWebMercator ? 1.0 : 0.0);
+  for (int32 i = 0; i < 3; ++i) {
+    const glm::dvec4 row = glm::row(localToEcef, i);
+    result.localToEcefRows[i] =
+        FVector4(row.x, row.y, row.z, row.w - projection.center[i]);
+  }
+  result.ellipsoid = FVector4(
+      1.0 - eccentricitySquared * primeVerticalRadius / distanceToAxis,
+      center.latitude,
+      distanceToAxis,
+      eccentricitySquared * primeVerticalRadius);
+  result.projection = FVector4(
+      (projected.x - projection.rectangle.minimumX) / width,
+      (projected.y - projection.rectangle.minimumY) / height,
+      radii.x / width,
+      radii.x / height);
+  return result;
+}
+
+} // namespace CesiumOverlayTextureCoordinates
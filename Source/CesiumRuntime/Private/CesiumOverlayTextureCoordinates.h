@@ -0,0 +1,97 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGeometry/Rectangle.h"
+#include "CesiumGeospatial/Projection.h"
+#include "Math/Vector4.h"
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <optional>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+}
+
+/**
+ * Computes the raster overlay texture coordinates of tiles in their materials,
+ * with the functions in "/Plugin/CesiumForUnreal/Private/CesiumOverlayUVs.ush",
+ * instead of in vertex texture coordinate channels.
+ */
+namespace CesiumOverlayTextureCoordinates {
+/**
+ * @brief The projection of one of a tile's overlay texture coordinate IDs.
+ */
+struct TileProjection {
+  /**
+   * The center of the tile's bounding volume, in ECEF coordinates, which the
+   * material computes coordinates relative to for precision.
+   */
+  glm::dvec3 center;
+
+  /**
+   * The projection that the overlay texture coordinates are computed in.
+   */
+  CesiumGeospatial::Projection projection;
+
+  /**
+   * The projected rectangle that covers the tile, which the overlay texture
+   * coordinates go from 0 to 1 across.
+   */
+  CesiumGeometry::Rectangle rectangle;
+};
+
+/**
+ * @brief The material parameters that CesiumComputeOverlayUV takes for a
+ * primitive and one of its overlays.
+ */
+struct MaterialParameters {
+  /**
+   * The ECEF center of the tile in xyz, and 1 in w for the Web Mercator
+   * projection or 0 for the geographic projection.
+   */
+  FVector4 origin;
+
+  /**
+   * The rows of the transformation from the primitive's local space to ECEF
+   * coordinates relative to the origin.
+   */
+  FVector4 localToEcefRows[3];
+
+  /**
+   * The ellipsoid at the origin: the factor k, which is 1 - e^2 N / (N + h),
+   * such that tan(latitude) = z / (k * sqrt(x^2 + y^2)); the origin's
+   * latitude; N + h; and e^2 N. N is the radius of curvature in the prime
+   * vertical, h is the height above the ellipsoid, and e is its eccentricity.
+   */
+  FVector4 ellipsoid;
+
+  /**
+   * The texture coordinates of the origin in xy, and the scale of the
+   * texture coordinates per radian of longitude and of latitude, or of Web
+   * Mercator y, in zw.
+   */
+  FVector4 projection;
+};
+
+/**
+ * @brief Finds the projection of the tile's given overlay texture coordinate
+ * ID, or std::nullopt if the tile has no overlay texture coordinates with
+ * that ID.
+ */
+std::optional<TileProjection>
+getTileProjection(const Cesium3DTilesSelection::Tile& tile, int32 id);
+
+/**
+ * @brief Computes the material parameters of a primitive for an overlay with
+ * the given projection, or std::nullopt if the tile's center is too close to
+ * the center of the ellipsoid.
+ *
+ * @param localToEcef The transformation from the local space of the
+ * primitive, which its material's Local Position is in, to ECEF coordinates.
+ * @param projection The projection of the overlay on the primitive's tile.
+ */
+std::optional<MaterialParameters> computeMaterialParameters(
+    const glm::dmat4& localToEcef,
+    const TileProjection& projection);
+} // namespace CesiumOverlayTextureCoordinates
@@ -0,0 +1,200 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshUtility.h"
+#include "CesiumGltf/MeshPrimitive.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntime.h"
+#include "PhysicsEngine/BodySetup.h"
+#include <variant>
+
+using namespace CesiumGltf;
+
+namespace {
+bool isTriangleDegenerate(
+    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& A,
+    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& B,
+    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& C) {
+  Chaos::FTriangleMeshImplicitObject::ParticleVecType AB = B - A;
+  Chaos::FTriangleMeshImplicitObject::ParticleVecType AC = C - A;
+  Chaos::FTriangleMeshImplicitObject::ParticleVecType Normal =
+      Chaos::FTriangleMeshImplicitObject::ParticleVecType::CrossProduct(AB, AC);
+  return (Normal.SafeNormalize() < 1.e-8f);
+}
+
+template <typename TIndex>
+TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
+buildChaosTriangleMesh(
+    Chaos::TParticles<Chaos::FRealSingle, 3>&& vertices,
+    const TArray<uint32>& indices) {
+  int32 triangleCount = indices.Num() / 3;
+  TArray<Chaos::TVector<TIndex, 3>> triangles;
+  triangles.Reserve(triangleCount);
+  TArray<int32> faceRemap;
+  faceRemap.Reserve(triangleCount);
+
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const int32 index0 = 3 * i;
+    int32 vIndex0 = indices[index0 + 1];
+    int32 vIndex1 = indices[index0];
+    int32 vIndex2 = indices[index0 + 2];
+
+    if (!isTriangleDegenerate(
+            vertices.X(vIndex0),
+            vertices.X(vIndex1),
+            vertices.X(vIndex2))) {
+      triangles.Add(Chaos::TVector<TIndex, 3>(
+          static_cast<TIndex>(vIndex0),
+          static_cast<TIndex>(vIndex1),
+          static_cast<TIndex>(vIndex2)));
+      faceRemap.Add(i);
+    }
+  }
+
+  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
+  TArray<uint16> materials;
+  materials.SetNum(triangles.Num());
+
+  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+}
+
+struct IndexCopier {
+  int64 vertexCount;
+  TArray<uint32>& indices;
+
+  bool operator()(std::monostate) {
+    indices.SetNum(static_cast<TArray<uint32>::SizeType>(vertexCount));
+    for (int64 i = 0; i < vertexCount; ++i) {
+      indices[i] = static_cast<uint32>(i);
+    }
+    return true;
+  }
+
+  template <typename T> bool operator()(const AccessorView<T>& indexView) {
+    if (indexView.status() != AccessorViewStatus::Valid) {
+      return false;
+    }
+
+    indices.SetNum(static_cast<TArray<uint32>::SizeType>(indexView.size()));
+    for (int64 i = 0; i < indexView.size(); ++i) {
+      const uint32 index = static_cast<uint32>(indexView[i]);
+      if (index >= vertexCount) {
+        return false;
+      }
+      indices[i] = index;
+    }
+    return true;
+  }
+};
+
+void triangulateStrip(TArray<uint32>& indices) {
+  if (indices.Num() < 3) {
+    indices.Empty();
+    return;
+  }
+
+  TArray<uint32> strip = MoveTemp(indices);
+  indices.SetNum(3 * (strip.Num() - 2));
+  for (int32 i = 0; i < strip.Num() - 2; ++i) {
+    if (i % 2) {
+      indices[3 * i] = strip[i];
+      indices[3 * i + 1] = strip[i + 2];
+      indices[3 * i + 2] = strip[i + 1];
+    } else {
+      indices[3 * i] = strip[i];
+      indices[3 * i + 1] = strip[i + 1];
+      indices[3 * i + 2] = strip[i + 2];
+    }
+  }
+}
+} // namespace
+
+namespace CesiumPhysicsMeshUtility {
+
+TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
+buildChaosTriangleMesh(CollisionGeometry&& geometry) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
+
+  if (geometry.vertices.Size() == 0 || geometry.indices.Num() < 3) {
+    return nullptr;
+  }
+
+  // Chaos stores the triangles of small meshes with 16-bit indices, which
+  // halves their size.
+  return geometry.vertices.Size() <=
+                 int32(TNumericLimits<uint16>::Max()) + 1
+             ? ::buildChaosTriangleMesh<uint16>(
+                   MoveTemp(geometry.vertices),
+                   geometry.indices)
+             : ::buildChaosTriangleMesh<int32>(
+                   MoveTemp(geometry.vertices),
+                   geometry.indices);
+}
+
+bool gatherCollisionGeometry(
+    const UCesiumGltfPrimitiveComponent& primitive,
+    CollisionGeometry& geometry) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GatherCollisionGeometry)
+
+  const MeshPrimitive* pMeshPrimitive = primitive.pMeshPrimitive;
+  if (!pMeshPrimitive ||
+      (pMeshPrimitive->mode != MeshPrimitive::Mode::TRIANGLES &&
+       pMeshPrimitive->mode != MeshPrimitive::Mode::TRIANGLE_STRIP)) {
+    return false;
+  }
+
+  const AccessorView<FVector3f>& positionView = primitive.PositionAccessor;
+  if (positionView.status() != AccessorViewStatus::Valid ||
+      positionView.size() == 0) {
+    return false;
+  }
+
+  const int64 vertexCount = positionView.size();
+  geometry.vertices = Chaos::TParticles<Chaos::FRealSingle, 3>();
+  geometry.vertices.AddParticles(static_cast<int32>(vertexCount));
+  for (int64 i = 0; i < vertexCount; ++i) {
+    // Flip the Y axis to match the render mesh positions.
+    const FVector3f& position = positionView[i];
+    geometry.vertices.X(static_cast<int32>(i)) =
+        FVector3f(position.X, -position.Y, position.Z);
+  }
+
+  geometry.indices.Reset();
+  if (!std::visit(
+          IndexCopier{vertexCount, geometry.indices},
+          primitive.IndexAccessor)) {
+    return false;
+  }
+
+  if (pMeshPrimitive->mode == MeshPrimitive::Mode::TRIANGLE_STRIP) {
+    triangulateStrip(geometry.indices);
+  }
+
+  return geometry.indices.Num() >= 3;
+}
+
+void applyCollisionMesh(
+    UCesiumGltfPrimitiveComponent& primitive,
+    const TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>&
+        pCollisionMesh) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyCollisionMesh)
+
+  if (!pCollisionMesh) {
+    return;
+  }
+
+  UBodySetup* pBodySetup = primitive.GetBodySetup();
+  if (!pBodySetup) {
+    return;
+  }
+
+  pBodySetup->ChaosTriMeshes.Add(pCollisionMesh);
+  primitive.RecreatePhysicsState();
+}
+
+} // namespace CesiumPhysicsMeshUtility
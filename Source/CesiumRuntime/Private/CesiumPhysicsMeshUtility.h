@@ -0,0 +1,55 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Chaos/TriangleMeshImplicitObject.h"
+#include "Containers/Array.h"
+#include "Templates/SharedPointer.h"
+
+class UCesiumGltfPrimitiveComponent;
+
+namespace CesiumPhysicsMeshUtility {
+/**
+ * @brief The vertices and triangle indices of a primitive's collision mesh,
+ * in the same space as the primitive's render mesh positions (i.e. with the
+ * glTF Y axis already flipped).
+ */
+struct CollisionGeometry {
+  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
+  TArray<uint32> indices;
+};
+
+/**
+ * @brief Cooks a Chaos triangle mesh from the given geometry. Degenerate
+ * triangles are skipped. This may be called from any thread.
+ *
+ * @return The cooked mesh, or nullptr if the geometry has no triangles.
+ */
+TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
+buildChaosTriangleMesh(CollisionGeometry&& geometry);
+
+/**
+ * @brief Copies the collision geometry of a loaded primitive component out of
+ * its glTF position and index accessors, so that a collision mesh can be
+ * cooked for it after it was created without one.
+ *
+ * This must be called from the game thread, because the glTF model backing
+ * the accessors may be unloaded at any time once control returns to the
+ * tileset.
+ *
+ * @return False if the primitive does not have triangle geometry.
+ */
+bool gatherCollisionGeometry(
+    const UCesiumGltfPrimitiveComponent& primitive,
+    CollisionGeometry& geometry);
+
+/**
+ * @brief Adds a collision mesh that was cooked after the primitive component
+ * was created to its body setup, and recreates its physics state so the mesh
+ * takes effect. Must be called from the game thread.
+ */
+void applyCollisionMesh(
+    UCesiumGltfPrimitiveComponent& primitive,
+    const TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>&
+        pCollisionMesh);
+} // namespace CesiumPhysicsMeshUtility
@@ -0,0 +1,74 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsStateQueue.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CYCLE_STAT(
+    TEXT("Amortized Physics State Creation"),
+    STAT_CesiumAmortizedPhysicsStateCreation,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Primitives Pending Collision"),
+    STAT_CesiumPrimitivesPendingCollision,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Physics States Created"),
+    STAT_CesiumPhysicsStatesCreated,
+    STATGROUP_Cesium);
+
+/*static*/ CesiumPhysicsStateQueue& CesiumPhysicsStateQueue::get() {
+  static CesiumPhysicsStateQueue queue;
+  return queue;
+}
+
+/*static*/ bool CesiumPhysicsStateQueue::isEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()->MainThreadPhysicsTimeBudget >
+         0.0f;
+}
+
+void CesiumPhysicsStateQueue::add(UCesiumGltfPrimitiveComponent* pPrimitive) {
+  this->_pending.Add(pPrimitive);
+}
+
+void CesiumPhysicsStateQueue::Tick(float DeltaTime) {
+  SCOPE_CYCLE_COUNTER(STAT_CesiumAmortizedPhysicsStateCreation);
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreatePendingPhysicsStates)
+
+  const double budgetSeconds =
+      GetDefault<UCesiumRuntimeSettings>()->MainThreadPhysicsTimeBudget /
+      1000.0;
+  const double start = FPlatformTime::Seconds();
+
+  int32 i = 0;
+  for (; i < this->_pending.Num(); ++i) {
+    // The budget may have been disabled since the primitives were added, in
+    // which case they're all enabled now.
+    if (budgetSeconds > 0.0 &&
+        FPlatformTime::Seconds() - start >= budgetSeconds) {
+      break;
+    }
+
+    UCesiumGltfPrimitiveComponent* pPrimitive = this->_pending[i].Get();
+    if (pPrimitive && pPrimitive->IsRegistered()) {
+      if (pPrimitive->ApplyPendingCollisionEnabled()) {
+        INC_DWORD_STAT(STAT_CesiumPhysicsStatesCreated);
+      }
+    }
+  }
+
+  this->_pending.RemoveAt(0, i, false);
+  SET_DWORD_STAT(STAT_CesiumPrimitivesPendingCollision, this->_pending.Num());
+}
+
+ETickableTickType CesiumPhysicsStateQueue::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool CesiumPhysicsStateQueue::IsTickableWhenPaused() const { return true; }
+
+bool CesiumPhysicsStateQueue::IsTickableInEditor() const { return true; }
+
+TStatId CesiumPhysicsStateQueue::GetStatId() const { return TStatId(); }
@@ -0,0 +1,57 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Tickable.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UCesiumGltfPrimitiveComponent;
+
+/**
+ * Enables the collision of tile primitives over several frames, so that
+ * creating their physics bodies doesn't stall the frame in which many tiles
+ * are shown at once.
+ *
+ * A primitive's physics state is created on the game thread when its
+ * collision is first enabled, which, for a triangle mesh, creates a Chaos
+ * body and adds it to the physics scene's acceleration structure. That is
+ * done here instead, for as many primitives as fit in the "Main Thread
+ * Physics Time Budget" each frame, in the order they were added. Primitives
+ * that already have a physics state are enabled right away, since that only
+ * updates the filters of their existing bodies.
+ */
+class CesiumPhysicsStateQueue : FTickableGameObject {
+public:
+  /**
+   * Gets the queue shared by all tilesets.
+   */
+  static CesiumPhysicsStateQueue& get();
+
+  /**
+   * Determines whether the creation of physics states is limited to a budget
+   * each frame, rather than done as soon as collision is enabled.
+   */
+  static bool isEnabled();
+
+  /**
+   * Enables the collision of a primitive in a later frame, when the budget
+   * allows it. The primitive's PendingCollisionEnabled must already be set,
+   * and is applied then, unless it's been reset in the meantime.
+   */
+  void add(UCesiumGltfPrimitiveComponent* pPrimitive);
+
+  /**
+   * Gets the number of primitives waiting for their collision to be enabled.
+   */
+  int32 getPendingCount() const { return this->_pending.Num(); }
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const override;
+
+private:
+  TArray<TWeakObjectPtr<UCesiumGltfPrimitiveComponent>> _pending;
+};
@@ -19,7 +19,7 @@ void FCesiumPointAttenuationIndexBuffer::InitRHI(
 #else
 void FCesiumPointAttenuationIndexBuffer::InitRHI() {
 #endif
-  if (!bAttenuationSupported) {
+  if (NumPoints == 0) {
     return;
   }
 
@@ -54,6 +54,225 @@ void FCesiumPointAttenuationIndexBuffer::InitRHI() {
   RHIUnlockBuffer(IndexBufferRHI);
 }
 
+void FCesiumPointAttenuationIndexBuffer::Reserve(int32 InNumPoints) {
+  check(IsInRenderingThread());
+
+  if (InNumPoints <= NumPoints) {
+    return;
+  }
+
+  // Grow geometrically so that loading gradually larger tiles doesn't
+  // recreate the buffer every time.
+  NumPoints = FMath::Max(InNumPoints, NumPoints + NumPoints / 2);
+
+  if (IsInitialized()) {
+    // Draws that were already submitted keep a reference to the old buffer.
+#if ENGINE_VERSION_5_3_OR_HIGHER
+    UpdateRHI(FRHICommandListImmediate::Get());
+#else
+    UpdateRHI();
+#endif
+  } else {
+    InitResource();
+  }
+}
+
+TGlobalResource<FCesiumPointAttenuationIndexBuffer>
+    GCesiumPointAttenuationIndexBuffer;
+
+namespace {
+uint16 quantizeComponent(float value, float offset, float scale) {
+  if (scale <= 0.0f) {
+    return 0;
+  }
+  return uint16(FMath::Clamp(
+      FMath::RoundToInt((value - offset) / scale),
+      0,
+      int32(MAX_uint16)));
+}
+
+constexpr uint32 MaxQuantizedIntensity = (1u << 24) - 1;
+
+uint32 quantizeIntensity(float value, float offset, float scale) {
+  if (scale <= 0.0f) {
+    return 0;
+  }
+  return uint32(FMath::Clamp(
+      FMath::RoundToInt64((value - offset) / scale),
+      int64(0),
+      int64(MaxQuantizedIntensity)));
+}
+
+/**
+ * Encodes a unit vector into two 8-bit components with the octahedral
+ * mapping. This must match DecodePointNormal in
+ * CesiumPointAttenuationVertexFactory.ush.
+ */
+uint16 octEncodeNormal(const FVector3f& normal) {
+  const float l1Norm =
+      FMath::Abs(normal.X) + FMath::Abs(normal.Y) + FMath::Abs(normal.Z);
+  if (l1Norm <= 0.0f) {
+    // Encode a degenerate normal as +Z.
+    return uint16(128 | (128 << 8));
+  }
+
+  float x = normal.X / l1Norm;
+  float y = normal.Y / l1Norm;
+  if (normal.Z < 0.0f) {
+    const float foldedX = (1.0f - FMath::Abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    const float foldedY = (1.0f - FMath::Abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    x = foldedX;
+    y = foldedY;
+  }
+
+  const int32 encodedX =
+      FMath::Clamp(FMath::RoundToInt((x * 0.5f + 0.5f) * 255.0f), 0, 255);
+  const int32 encodedY =
+      FMath::Clamp(FMath::RoundToInt((y * 0.5f + 0.5f) * 255.0f), 0, 255);
+  return uint16(encodedX | (encodedY << 8));
+}
+} // namespace
+
+/*static*/ TSharedPtr<FCesiumQuantizedPointsVertexBuffer, ESPMode::ThreadSafe>
+FCesiumQuantizedPointsVertexBuffer::Create(
+    const FPositionVertexBuffer& Positions,
+    TArrayView<const FVector3f> Normals,
+    const FBox3f& Bounds,
+    TArrayView<const float> Classifications,
+    TArrayView<const float> Intensities) {
+  FCesiumQuantizedPointsVertexBuffer* pBuffer =
+      new FCesiumQuantizedPointsVertexBuffer();
+
+  const int32 Count = int32(Positions.GetNumVertices());
+  check(Normals.Num() == Count);
+
+  pBuffer->NumPoints = Count;
+  pBuffer->PositionOffset = Bounds.Min;
+  pBuffer->PositionScale = (Bounds.Max - Bounds.Min) / float(MAX_uint16);
+  pBuffer->Data.SetNumUninitialized(Count * 2);
+
+  const FVector3f& Offset = pBuffer->PositionOffset;
+  const FVector3f& Scale = pBuffer->PositionScale;
+  for (int32 i = 0; i < Count; ++i) {
+    const FVector3f& Position = Positions.VertexPosition(uint32(i));
+    const uint32 X = quantizeComponent(Position.X, Offset.X, Scale.X);
+    const uint32 Y = quantizeComponent(Position.Y, Offset.Y, Scale.Y);
+    const uint32 Z = quantizeComponent(Position.Z, Offset.Z, Scale.Z);
+    const uint32 Normal = octEncodeNormal(Normals[i]);
+    pBuffer->Data[2 * i] = X | (Y << 16);
+    pBuffer->Data[2 * i + 1] = Z | (Normal << 16);
+  }
+
+  pBuffer->bHasClassifications = Classifications.Num() == Count && Count > 0;
+  pBuffer->bHasIntensities = Intensities.Num() == Count && Count > 0;
+
+  if (pBuffer->bHasIntensities) {
+    float MinimumIntensity = Intensities[0];
+    float MaximumIntensity = Intensities[0];
+    for (float Intensity : Intensities) {
+      MinimumIntensity = FMath::Min(MinimumIntensity, Intensity);
+      MaximumIntensity = FMath::Max(MaximumIntensity, Intensity);
+    }
+    pBuffer->IntensityOffset = MinimumIntensity;
+    pBuffer->IntensityScale =
+        (MaximumIntensity - MinimumIntensity) / float(MaxQuantizedIntensity);
+  }
+
+  if (pBuffer->bHasClassifications || pBuffer->bHasIntensities) {
+    pBuffer->FilterData.SetNumUninitialized(Count);
+    for (int32 i = 0; i < Count; ++i) {
+      const uint32 Classification =
+          pBuffer->bHasClassifications
+              ? uint32(FMath::Clamp(
+                    FMath::RoundToInt(Classifications[i]),
+                    0,
+                    int32(MAX_uint8)))
+              : 0;
+      const uint32 Intensity =
+          pBuffer->bHasIntensities
+              ? quantizeIntensity(
+                    Intensities[i],
+                    pBuffer->IntensityOffset,
+                    pBuffer->IntensityScale)
+              : 0;
+      pBuffer->FilterData[i] = Classification | (Intensity << 8);
+    }
+  } else {
+    // The shader still needs a buffer to bind, even if it never reads it.
+    pBuffer->FilterData.Add(0);
+  }
+
+  // Scene proxies may hold a reference to the buffer after its component has
+  // let go of it, so it's released on the render thread, after any proxy that
+  // was using it.
+  return MakeShareable(pBuffer, [](FCesiumQuantizedPointsVertexBuffer* p) {
+    ENQUEUE_RENDER_COMMAND(ReleaseCesiumQuantizedPoints)
+    ([p](FRHICommandListImmediate& RHICmdList) {
+      p->ReleaseResource();
+      delete p;
+    });
+  });
+}
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+void FCesiumQuantizedPointsVertexBuffer::InitRHI(
+    FRHICommandListBase& RHICmdList) {
+#else
+void FCesiumQuantizedPointsVertexBuffer::InitRHI() {
+#endif
+  if (Data.Num() == 0) {
+    return;
+  }
+
+  FRHIResourceCreateInfo CreateInfo(
+      TEXT("FCesiumQuantizedPointsVertexBuffer"));
+  const uint32 Size = uint32(Data.Num()) * sizeof(uint32);
+  VertexBufferRHI = RHICreateBuffer(
+      Size,
+      BUF_Static | BUF_VertexBuffer | BUF_ShaderResource,
+      0,
+      ERHIAccess::VertexOrIndexBuffer | ERHIAccess::SRVMask,
+      CreateInfo);
+
+  void* Contents = RHILockBuffer(VertexBufferRHI, 0, Size, RLM_WriteOnly);
+  FMemory::Memcpy(Contents, Data.GetData(), Size);
+  RHIUnlockBuffer(VertexBufferRHI);
+
+  SRV = RHICreateShaderResourceView(
+      VertexBufferRHI,
+      sizeof(uint32) * 2,
+      PF_R32G32_UINT);
+
+  FRHIResourceCreateInfo FilterCreateInfo(
+      TEXT("FCesiumQuantizedPointsFilterBuffer"));
+  const uint32 FilterSize = uint32(FilterData.Num()) * sizeof(uint32);
+  FilterBufferRHI = RHICreateBuffer(
+      FilterSize,
+      BUF_Static | BUF_ShaderResource,
+      0,
+      ERHIAccess::SRVMask,
+      FilterCreateInfo);
+
+  void* FilterContents =
+      RHILockBuffer(FilterBufferRHI, 0, FilterSize, RLM_WriteOnly);
+  FMemory::Memcpy(FilterContents, FilterData.GetData(), FilterSize);
+  RHIUnlockBuffer(FilterBufferRHI);
+
+  FilterSRV =
+      RHICreateShaderResourceView(FilterBufferRHI, sizeof(uint32), PF_R32_UINT);
+
+  // The GPU copy is all that's needed from here on.
+  Data.Empty();
+  FilterData.Empty();
+}
+
+void FCesiumQuantizedPointsVertexBuffer::ReleaseRHI() {
+  SRV.SafeRelease();
+  FilterSRV.SafeRelease();
+  FilterBufferRHI.SafeRelease();
+  FVertexBuffer::ReleaseRHI();
+}
+
 class FCesiumPointAttenuationVertexFactoryShaderParameters
     : public FVertexFactoryShaderParameters {
 
@@ -63,13 +282,23 @@ class FCesiumPointAttenuationVertexFactoryShaderParameters
 
 public:
   void Bind(const FShaderParameterMap& ParameterMap) {
-    PositionBuffer.Bind(ParameterMap, TEXT("PositionBuffer"));
-    PackedTangentsBuffer.Bind(ParameterMap, TEXT("PackedTangentsBuffer"));
+    QuantizedPointBuffer.Bind(ParameterMap, TEXT("QuantizedPointBuffer"));
+    PositionOffset.Bind(ParameterMap, TEXT("PositionOffset"));
+    PositionScale.Bind(ParameterMap, TEXT("PositionScale"));
     ColorBuffer.Bind(ParameterMap, TEXT("ColorBuffer"));
     TexCoordBuffer.Bind(ParameterMap, TEXT("TexCoordBuffer"));
     NumTexCoords.Bind(ParameterMap, TEXT("NumTexCoords"));
     bHasPointColors.Bind(ParameterMap, TEXT("bHasPointColors"));
     AttenuationParameters.Bind(ParameterMap, TEXT("AttenuationParameters"));
+    PointFilterBuffer.Bind(ParameterMap, TEXT("PointFilterBuffer"));
+    PointFilterFlags.Bind(ParameterMap, TEXT("PointFilterFlags"));
+    HiddenClassificationsLow.Bind(
+        ParameterMap,
+        TEXT("HiddenClassificationsLow"));
+    HiddenClassificationsHigh.Bind(
+        ParameterMap,
+        TEXT("HiddenClassificationsHigh"));
+    IntensityFilter.Bind(ParameterMap, TEXT("IntensityFilter"));
   }
 
   void GetElementShaderBindings(
@@ -84,11 +313,14 @@ public:
       FVertexInputStreamArray& VertexStreams) const {
     FCesiumPointAttenuationBatchElementUserData* UserData =
         (FCesiumPointAttenuationBatchElementUserData*)BatchElement.UserData;
-    if (UserData->PositionBuffer && PositionBuffer.IsBound()) {
-      ShaderBindings.Add(PositionBuffer, UserData->PositionBuffer);
+    if (UserData->QuantizedPointBuffer && QuantizedPointBuffer.IsBound()) {
+      ShaderBindings.Add(QuantizedPointBuffer, UserData->QuantizedPointBuffer);
+    }
+    if (PositionOffset.IsBound()) {
+      ShaderBindings.Add(PositionOffset, UserData->PositionOffset);
     }
-    if (UserData->PackedTangentsBuffer && PackedTangentsBuffer.IsBound()) {
-      ShaderBindings.Add(PackedTangentsBuffer, UserData->PackedTangentsBuffer);
+    if (PositionScale.IsBound()) {
+      ShaderBindings.Add(PositionScale, UserData->PositionScale);
     }
     if (UserData->ColorBuffer && ColorBuffer.IsBound()) {
       ShaderBindings.Add(ColorBuffer, UserData->ColorBuffer);
@@ -107,16 +339,41 @@ public:
           AttenuationParameters,
           UserData->AttenuationParameters);
     }
+    if (UserData->PointFilterBuffer && PointFilterBuffer.IsBound()) {
+      ShaderBindings.Add(PointFilterBuffer, UserData->PointFilterBuffer);
+    }
+    if (PointFilterFlags.IsBound()) {
+      ShaderBindings.Add(PointFilterFlags, UserData->PointFilterFlags);
+    }
+    if (HiddenClassificationsLow.IsBound()) {
+      ShaderBindings.Add(
+          HiddenClassificationsLow,
+          UserData->HiddenClassificationsLow);
+    }
+    if (HiddenClassificationsHigh.IsBound()) {
+      ShaderBindings.Add(
+          HiddenClassificationsHigh,
+          UserData->HiddenClassificationsHigh);
+    }
+    if (IntensityFilter.IsBound()) {
+      ShaderBindings.Add(IntensityFilter, UserData->IntensityFilter);
+    }
   }
 
 private:
-  LAYOUT_FIELD(FShaderResourceParameter, PositionBuffer);
-  LAYOUT_FIELD(FShaderResourceParameter, PackedTangentsBuffer);
+  LAYOUT_FIELD(FShaderResourceParameter, QuantizedPointBuffer);
+  LAYOUT_FIELD(FShaderParameter, PositionOffset);
+  LAYOUT_FIELD(FShaderParameter, PositionScale);
   LAYOUT_FIELD(FShaderResourceParameter, ColorBuffer);
   LAYOUT_FIELD(FShaderResourceParameter, TexCoordBuffer);
   LAYOUT_FIELD(FShaderParameter, NumTexCoords);
   LAYOUT_FIELD(FShaderParameter, bHasPointColors);
   LAYOUT_FIELD(FShaderParameter, AttenuationParameters);
+  LAYOUT_FIELD(FShaderResourceParameter, PointFilterBuffer);
+  LAYOUT_FIELD(FShaderParameter, PointFilterFlags);
+  LAYOUT_FIELD(FShaderParameter, HiddenClassificationsLow);
+  LAYOUT_FIELD(FShaderParameter, HiddenClassificationsHigh);
+  LAYOUT_FIELD(FShaderParameter, IntensityFilter);
 };
 
 /**
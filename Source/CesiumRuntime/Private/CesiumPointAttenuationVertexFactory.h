@@ -10,48 +10,160 @@
 #include "Rendering/PositionVertexBuffer.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "SceneManagement.h"
+#include "Templates/SharedPointer.h"
 
 /**
  * This generates the indices necessary for point attenuation in a
  * FCesiumGltfPointsComponent.
+ *
+ * The indices of every attenuated point mesh follow the same pattern, so a
+ * single buffer, GCesiumPointAttenuationIndexBuffer, is shared by all of them.
+ * It grows to fit the largest point mesh, and smaller meshes draw only the
+ * first part of it.
  */
 class FCesiumPointAttenuationIndexBuffer : public FIndexBuffer {
 public:
-  FCesiumPointAttenuationIndexBuffer(
-      const int32& NumPoints,
-      const bool bAttenuationSupported)
-      : NumPoints(NumPoints), bAttenuationSupported(bAttenuationSupported) {}
 #if ENGINE_VERSION_5_3_OR_HIGHER
   virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
 #else
   virtual void InitRHI() override;
 #endif
 
+  /**
+   * Grows the buffer, if necessary, so that it has indices for at least the
+   * given number of points. Must be called from the render thread.
+   */
+  void Reserve(int32 InNumPoints);
+
 private:
-  // The number of points in the original point mesh. Not to be confused with
+  // The number of points the buffer has indices for. Not to be confused with
   // the number of vertices in the attenuated point mesh.
-  const int32 NumPoints;
-  const bool bAttenuationSupported;
+  int32 NumPoints = 0;
+};
+
+extern TGlobalResource<FCesiumPointAttenuationIndexBuffer>
+    GCesiumPointAttenuationIndexBuffer;
+
+/**
+ * The positions and normals of a point cloud in the compact form that
+ * FCesiumPointAttenuationVertexFactory reads. Each position is quantized to 16
+ * bits per component within the point cloud's bounding box, and each normal is
+ * octahedron-encoded to 8 bits per component, so a point takes 8 bytes rather
+ * than the 20 bytes of a full-precision position and packed tangents.
+ *
+ * The quantized data is discarded once it has been copied to the GPU.
+ */
+class FCesiumQuantizedPointsVertexBuffer : public FVertexBuffer {
+public:
+  /**
+   * Quantizes the given positions and normals, which must have the same number
+   * of elements. This may be called from any thread. The buffer is released
+   * on the render thread once the last reference to it is gone.
+   *
+   * @param Positions The positions of the points.
+   * @param Normals The normals of the points.
+   * @param Bounds A box that contains all of the positions.
+   * @param Classifications The classifications of the points, used to filter
+   * them on the GPU, or an empty array if they have none.
+   * @param Intensities The intensities of the points, used to filter them on
+   * the GPU, or an empty array if they have none.
+   */
+  static TSharedPtr<FCesiumQuantizedPointsVertexBuffer, ESPMode::ThreadSafe>
+  Create(
+      const FPositionVertexBuffer& Positions,
+      TArrayView<const FVector3f> Normals,
+      const FBox3f& Bounds,
+      TArrayView<const float> Classifications = {},
+      TArrayView<const float> Intensities = {});
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void InitRHI() override;
+#endif
+  virtual void ReleaseRHI() override;
+
+  int32 GetNumPoints() const { return NumPoints; }
+
+  FRHIShaderResourceView* GetSRV() const { return SRV; }
+
+  /**
+   * Gets the position of a point whose quantized components are all 0.
+   */
+  const FVector3f& GetPositionOffset() const { return PositionOffset; }
+
+  /**
+   * Gets the distance between adjacent quantized positions along each axis.
+   */
+  const FVector3f& GetPositionScale() const { return PositionScale; }
+
+  /**
+   * Gets the view of the attributes that points can be filtered by. This is
+   * valid even if the points have none of them.
+   */
+  FRHIShaderResourceView* GetFilterSRV() const { return FilterSRV; }
+
+  bool HasClassifications() const { return bHasClassifications; }
+
+  bool HasIntensities() const { return bHasIntensities; }
+
+  /**
+   * Gets the intensity of a point whose quantized intensity is 0.
+   */
+  float GetIntensityOffset() const { return IntensityOffset; }
+
+  /**
+   * Gets the difference between adjacent quantized intensities.
+   */
+  float GetIntensityScale() const { return IntensityScale; }
+
+private:
+  FCesiumQuantizedPointsVertexBuffer() = default;
+
+  int32 NumPoints = 0;
+  FVector3f PositionOffset = FVector3f::ZeroVector;
+  FVector3f PositionScale = FVector3f::ZeroVector;
+
+  // Two words per point: X | (Y << 16), then Z | (Normal << 16).
+  TArray<uint32> Data;
+  FShaderResourceViewRHIRef SRV;
+
+  bool bHasClassifications = false;
+  bool bHasIntensities = false;
+  float IntensityOffset = 0.0f;
+  float IntensityScale = 0.0f;
+
+  // One word per point: Classification | (Intensity << 8), with the intensity
+  // quantized to 24 bits. A single zero word if the points have neither.
+  TArray<uint32> FilterData;
+  FBufferRHIRef FilterBufferRHI;
+  FShaderResourceViewRHIRef FilterSRV;
 };
 
 /**
- * The parameters to be passed as UserData to the
- * shader.
+ * The parameters to be passed as UserData to the shader. None of them depend
+ * on the view, so each scene proxy keeps a single copy that it updates when
+ * the tileset's settings change.
  */
 struct FCesiumPointAttenuationBatchElementUserData {
-  FRHIShaderResourceView* PositionBuffer;
-  FRHIShaderResourceView* PackedTangentsBuffer;
+  FRHIShaderResourceView* QuantizedPointBuffer;
+  FVector3f PositionOffset;
+  FVector3f PositionScale;
   FRHIShaderResourceView* ColorBuffer;
   FRHIShaderResourceView* TexCoordBuffer;
   uint32 NumTexCoords;
   uint32 bHasPointColors;
-  FVector3f AttenuationParameters;
-};
-
-class FCesiumPointAttenuationBatchElementUserDataWrapper
-    : public FOneFrameResource {
-public:
-  FCesiumPointAttenuationBatchElementUserData Data;
+  // The maximum point size, in pixels, and the geometric error that points
+  // are attenuated by, or 0 if they aren't.
+  FVector2f AttenuationParameters;
+  FRHIShaderResourceView* PointFilterBuffer;
+  // Bit 0 filters by classification, and bit 1 by intensity.
+  uint32 PointFilterFlags;
+  // One bit per classification to hide, 0-127 and then 128-255.
+  FUintVector4 HiddenClassificationsLow;
+  FUintVector4 HiddenClassificationsHigh;
+  // The intensity offset, scale, minimum, and maximum.
+  FVector4f IntensityFilter;
 };
 
 class FCesiumPointAttenuationVertexFactory : public FLocalVertexFactory {
@@ -0,0 +1,148 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPointBudget.h"
+#include "CesiumGltfPointsSceneProxy.h"
+#include "CesiumRuntime.h"
+#include "Misc/ScopeLock.h"
+#include "SceneView.h"
+#include <algorithm>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Points In View"),
+    STAT_CesiumPointsInView,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Points Trimmed By Budget"),
+    STAT_CesiumPointsTrimmedByBudget,
+    STATGROUP_Cesium);
+
+/*static*/ std::atomic<int64> CesiumPointBudget::_maximumPoints = 0;
+/*static*/ FCriticalSection CesiumPointBudget::_lock;
+/*static*/ TArray<const FCesiumGltfPointsSceneProxy*>
+    CesiumPointBudget::_proxies;
+/*static*/ const FSceneViewFamily* CesiumPointBudget::_pAllocatedViewFamily =
+    nullptr;
+/*static*/ uint32 CesiumPointBudget::_allocatedFrameNumber = 0;
+/*static*/ TMap<const FCesiumGltfPointsSceneProxy*, int32>
+    CesiumPointBudget::_trimmedPoints;
+
+/*static*/ void CesiumPointBudget::setMaximumPoints(int64 maximumPoints) {
+  _maximumPoints = maximumPoints;
+}
+
+/*static*/ void
+CesiumPointBudget::addProxy(const FCesiumGltfPointsSceneProxy* pProxy) {
+  FScopeLock lock(&_lock);
+  _proxies.Add(pProxy);
+  _pAllocatedViewFamily = nullptr;
+}
+
+/*static*/ void
+CesiumPointBudget::removeProxy(const FCesiumGltfPointsSceneProxy* pProxy) {
+  FScopeLock lock(&_lock);
+  _proxies.RemoveSingleSwap(pProxy, false);
+  _trimmedPoints.Remove(pProxy);
+  _pAllocatedViewFamily = nullptr;
+}
+
+/*static*/ int32 CesiumPointBudget::getPointsToDraw(
+    const FCesiumGltfPointsSceneProxy& proxy,
+    const FSceneViewFamily& viewFamily,
+    TArrayView<const FSceneView* const> views) {
+  if (_maximumPoints <= 0) {
+    return proxy.GetNumPoints();
+  }
+
+  FScopeLock lock(&_lock);
+
+  if (_pAllocatedViewFamily != &viewFamily ||
+      _allocatedFrameNumber != viewFamily.FrameNumber) {
+    allocate(viewFamily, views);
+    _pAllocatedViewFamily = &viewFamily;
+    _allocatedFrameNumber = viewFamily.FrameNumber;
+  }
+
+  const int32* pTrimmed = _trimmedPoints.Find(&proxy);
+  return pTrimmed ? *pTrimmed : proxy.GetNumPoints();
+}
+
+/*static*/ void CesiumPointBudget::allocate(
+    const FSceneViewFamily& viewFamily,
+    TArrayView<const FSceneView* const> views) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AllocatePointBudget)
+
+  struct Candidate {
+    const FCesiumGltfPointsSceneProxy* pProxy;
+    double priority;
+  };
+
+  TArray<Candidate> candidates;
+  candidates.Reserve(_proxies.Num());
+
+  int64 pointsInView = 0;
+  for (const FCesiumGltfPointsSceneProxy* pProxy : _proxies) {
+    if (&pProxy->GetScene() != viewFamily.Scene) {
+      continue;
+    }
+
+    // Rank tiles by their screen-space error in the view where it's largest.
+    // Tiles that aren't in any view aren't drawn, so they don't count against
+    // the budget.
+    const FBoxSphereBounds& bounds = pProxy->GetBounds();
+    const double geometricError = pProxy->GetGeometricError();
+    double priority = -1.0;
+    for (const FSceneView* pView : views) {
+      if (!pView->ViewFrustum.IntersectSphere(
+              bounds.Origin,
+              bounds.SphereRadius)) {
+        continue;
+      }
+
+      const double distance = FMath::Max(
+          FVector::Dist(pView->ViewMatrices.GetViewOrigin(), bounds.Origin) -
+              bounds.SphereRadius,
+          1.0);
+      const double sseDenominator =
+          2.0 * FMath::Tan(0.5 * FMath::DegreesToRadians(pView->FOV));
+      const double depthMultiplier =
+          double(pView->UnconstrainedViewRect.Height()) / sseDenominator;
+      priority =
+          FMath::Max(priority, geometricError * depthMultiplier / distance);
+    }
+
+    if (priority >= 0.0) {
+      candidates.Add({pProxy, priority});
+      pointsInView += pProxy->GetNumPoints();
+    }
+  }
+
+  _trimmedPoints.Reset();
+
+  const int64 maximumPoints = _maximumPoints;
+  int64 pointsTrimmed = 0;
+  if (pointsInView > maximumPoints) {
+    std::sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const Candidate& a, const Candidate& b) {
+          return a.priority > b.priority;
+        });
+
+    int64 remaining = maximumPoints;
+    for (const Candidate& candidate : candidates) {
+      const int32 numPoints = candidate.pProxy->GetNumPoints();
+      if (remaining >= numPoints) {
+        remaining -= numPoints;
+        continue;
+      }
+
+      const int32 pointsToDraw = int32(FMath::Max<int64>(remaining, 0));
+      _trimmedPoints.Add(candidate.pProxy, pointsToDraw);
+      pointsTrimmed += numPoints - pointsToDraw;
+      remaining = 0;
+    }
+  }
+
+  SET_DWORD_STAT(STAT_CesiumPointsInView, pointsInView);
+  SET_DWORD_STAT(STAT_CesiumPointsTrimmedByBudget, pointsTrimmed);
+}
@@ -0,0 +1,70 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+#include <cstdint>
+
+class FCesiumGltfPointsSceneProxy;
+class FSceneView;
+class FSceneViewFamily;
+
+/**
+ * Limits the total number of points drawn by all of the point cloud tiles in
+ * a view family, across all tilesets.
+ *
+ * When the points of the tiles in view exceed the budget, tiles are ranked by
+ * their geometric error as seen from the nearest view, and the points of the
+ * lowest-ranked tiles are dropped first. These are usually the most detailed
+ * tiles furthest from the camera. The tile that reaches the budget draws only
+ * as many of its points as fit.
+ */
+class CesiumPointBudget {
+public:
+  /**
+   * Sets the maximum number of points to draw per view family, or 0 to draw
+   * all of them. May be called from any thread.
+   */
+  static void setMaximumPoints(int64 maximumPoints);
+
+  /**
+   * Adds a point cloud scene proxy to the budget. Must be called from the
+   * render thread.
+   */
+  static void addProxy(const FCesiumGltfPointsSceneProxy* pProxy);
+
+  /**
+   * Removes a point cloud scene proxy from the budget. Must be called from the
+   * render thread.
+   */
+  static void removeProxy(const FCesiumGltfPointsSceneProxy* pProxy);
+
+  /**
+   * Gets the number of points that the given proxy may draw in the given view
+   * family. The budget is allocated among all of the proxies the first time
+   * this is called for a view family. Must be called from the render thread.
+   */
+  static int32 getPointsToDraw(
+      const FCesiumGltfPointsSceneProxy& proxy,
+      const FSceneViewFamily& viewFamily,
+      TArrayView<const FSceneView* const> views);
+
+private:
+  static void allocate(
+      const FSceneViewFamily& viewFamily,
+      TArrayView<const FSceneView* const> views);
+
+  static std::atomic<int64> _maximumPoints;
+  static FCriticalSection _lock;
+  static TArray<const FCesiumGltfPointsSceneProxy*> _proxies;
+
+  // The allocation for the last view family, for the proxies that don't get
+  // all of their points.
+  static const FSceneViewFamily* _pAllocatedViewFamily;
+  static uint32 _allocatedFrameNumber;
+  static TMap<const FCesiumGltfPointsSceneProxy*, int32> _trimmedPoints;
+};
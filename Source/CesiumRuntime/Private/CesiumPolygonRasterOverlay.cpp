@@ -1,11 +1,11 @@
 // Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "CesiumPolygonRasterOverlay.h"
-#include "Cesium3DTilesSelection/RasterizedPolygonsTileExcluder.h"
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "Cesium3DTileset.h"
 #include "CesiumBingMapsRasterOverlay.h"
 #include "CesiumCartographicPolygon.h"
+#include "CesiumPolygonRasterizer.h"
 #include "CesiumRasterOverlays/RasterizedPolygonsOverlay.h"
 
 using namespace Cesium3DTilesSelection;
@@ -27,20 +27,45 @@ UCesiumPolygonRasterOverlay::CreateOverlay(
 
   std::vector<CartographicPolygon> polygons;
   polygons.reserve(this->Polygons.Num());
+  std::vector<std::shared_ptr<const CesiumPreparedPolygon>> prepared;
+  prepared.reserve(this->Polygons.Num());
+
+  TMap<TWeakObjectPtr<const ACesiumCartographicPolygon>, PreparedPolygon>
+      preparedPolygons;
+  preparedPolygons.Reserve(this->Polygons.Num());
 
   for (ACesiumCartographicPolygon* pPolygon : this->Polygons) {
     if (!pPolygon) {
       continue;
     }
 
+    // The actor returns its cached polygon, with the same revision, unless
+    // the polygon has changed.
     CartographicPolygon polygon =
         pPolygon->CreateCartographicPolygon(worldToTileset);
+    const int64 revision = pPolygon->GetCartographicPolygonRevision();
+
+    PreparedPolygon* pPrepared = this->_preparedPolygons.Find(pPolygon);
+    if (!pPrepared || pPrepared->revision != revision) {
+      pPrepared = &this->_preparedPolygons.Add(
+          pPolygon,
+          PreparedPolygon{
+              revision,
+              CesiumPreparedPolygon::prepare(polygon.getVertices())});
+    }
+
+    prepared.emplace_back(pPrepared->pPolygon);
+    preparedPolygons.Add(pPolygon, *pPrepared);
     polygons.emplace_back(std::move(polygon));
   }
 
-  return std::make_unique<CesiumRasterOverlays::RasterizedPolygonsOverlay>(
+  // Forget the polygons that were removed from the overlay.
+  this->_preparedPolygons = std::move(preparedPolygons);
+
+  return std::make_unique<CesiumPolygonRasterizerOverlay>(
       TCHAR_TO_UTF8(*this->MaterialLayerKey),
       polygons,
+      std::make_shared<CesiumPolygonRasterizer>(std::move(prepared)),
       this->InvertSelection,
       CesiumGeospatial::Ellipsoid::WGS84,
       CesiumGeospatial::GeographicProjection(),
@@ -53,11 +78,12 @@ void UCesiumPolygonRasterOverlay::OnAdd(
   // If this overlay is used for culling, add it as an excluder too for
   // efficiency.
   if (pTileset && this->ExcludeSelectedTiles) {
-    RasterizedPolygonsOverlay* pPolygons =
-        static_cast<RasterizedPolygonsOverlay*>(pOverlay);
+    CesiumPolygonRasterizerOverlay* pPolygons =
+        static_cast<CesiumPolygonRasterizerOverlay*>(pOverlay);
     assert(this->_pExcluder == nullptr);
-    this->_pExcluder =
-        std::make_shared<RasterizedPolygonsTileExcluder>(pPolygons);
+    this->_pExcluder = std::make_shared<CesiumPolygonRasterizerExcluder>(
+        pPolygons->getRasterizer(),
+        this->InvertSelection);
     pTileset->getOptions().excluders.push_back(this->_pExcluder);
   }
 }
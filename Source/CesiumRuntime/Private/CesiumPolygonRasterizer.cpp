@@ -0,0 +1,601 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPolygonRasterizer.h"
+#include "CesiumRasterizerUtility.h"
+#include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "Cesium3DTilesSelection/Tile.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+#include "CesiumGeospatial/Projection.h"
+#include "CesiumRasterOverlays/RasterOverlayTile.h"
+#include "CesiumRasterOverlays/RasterOverlayTileProvider.h"
+#include <glm/common.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+
+// The most cells along each side of the grid over all of the polygons.
+constexpr int32_t MaximumPolygonGridSize = 64;
+
+// The most bands that the edges of a single polygon are sorted into.
+constexpr int32_t MaximumBands = 1024;
+
+// Whether the segment from a to b touches the rectangle, by clipping the
+// segment to each side of the rectangle in turn.
+bool segmentIntersects(
+    const glm::dvec2& a,
+    const glm::dvec2& b,
+    const Rectangle& rectangle) {
+  const glm::dvec2 direction = b - a;
+  const double p[4] = {-direction.x, direction.x, -direction.y, direction.y};
+  const double q[4] = {
+      a.x - rectangle.minimumX,
+      rectangle.maximumX - a.x,
+      a.y - rectangle.minimumY,
+      rectangle.maximumY - a.y};
+
+  double start = 0.0;
+  double end = 1.0;
+  for (int32_t i = 0; i < 4; ++i) {
+    if (p[i] == 0.0) {
+      if (q[i] < 0.0) {
+        return false;
+      }
+      continue;
+    }
+    const double t = q[i] / p[i];
+    if (p[i] < 0.0) {
+      start = std::max(start, t);
+    } else {
+      end = std::min(end, t);
+    }
+    if (start > end) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::vector<glm::dvec2>>
+getVertices(const std::vector<CartographicPolygon>& polygons) {
+  std::vector<std::vector<glm::dvec2>> result;
+  result.reserve(polygons.size());
+  for (const CartographicPolygon& polygon : polygons) {
+    result.emplace_back(polygon.getVertices());
+  }
+  return result;
+}
+
+std::vector<std::shared_ptr<const CesiumPreparedPolygon>>
+preparePolygons(const std::vector<std::vector<glm::dvec2>>& polygons) {
+  std::vector<std::shared_ptr<const CesiumPreparedPolygon>> result;
+  result.reserve(polygons.size());
+  for (const std::vector<glm::dvec2>& vertices : polygons) {
+    result.emplace_back(CesiumPreparedPolygon::prepare(vertices));
+  }
+  return result;
+}
+
+class PolygonTileProvider : public RasterOverlayTileProvider {
+public:
+  PolygonTileProvider(
+      const IntrusivePointer<const RasterOverlay>& pOwner,
+      const RasterOverlayTileProvider& tileProvider,
+      const std::shared_ptr<const CesiumPolygonRasterizer>& pRasterizer,
+      bool invertSelection)
+      : RasterOverlayTileProvider(
+            pOwner,
+            tileProvider.getAsyncSystem(),
+            tileProvider.getAssetAccessor(),
+            tileProvider.getCredit(),
+            tileProvider.getPrepareRendererResources(),
+            tileProvider.getLogger(),
+            tileProvider.getProjection(),
+            tileProvider.getCoverageRectangle()),
+        _pRasterizer(pRasterizer),
+        _invertSelection(invertSelection) {}
+
+protected:
+  virtual Future<LoadedRasterOverlayImage>
+  loadTileImage(RasterOverlayTile& overlayTile) override {
+    // Choose the texture size according to the geometry screen size and
+    // raster SSE, but no larger than the maximum texture size.
+    const RasterOverlayOptions& options = this->getOwner().getOptions();
+    const glm::dvec2 textureSize = glm::min(
+        overlayTile.getTargetScreenPixels() / options.maximumScreenSpaceError,
+        glm::dvec2(options.maximumTextureSize));
+
+    return this->getAsyncSystem().runInWorkerThread(
+        [pRasterizer = this->_pRasterizer,
+         invertSelection = this->_invertSelection,
+         projection = this->getProjection(),
+         rectangle = overlayTile.getRectangle(),
+         textureSize]() {
+          const GlobeRectangle globeRectangle =
+              unprojectRectangleSimple(projection, rectangle);
+          const Rectangle tileRectangle(
+              globeRectangle.getWest(),
+              globeRectangle.getSouth(),
+              globeRectangle.getEast(),
+              globeRectangle.getNorth());
+
+          const uint8_t insideValue = invertSelection ? 0 : 0xff;
+          const uint8_t outsideValue = invertSelection ? 0xff : 0;
+
+          LoadedRasterOverlayImage result;
+          result.rectangle = rectangle;
+
+          ImageCesium& image = result.image.emplace();
+          image.channels = 1;
+          image.bytesPerChannel = 1;
+
+          // A tile that no polygon overlaps is entirely outside the
+          // selection, which a single pixel shows just as well.
+          if (pRasterizer->findPolygons(tileRectangle).empty()) {
+            image.width = 1;
+            image.height = 1;
+            image.pixelData = {std::byte(outsideValue)};
+            result.moreDetailAvailable = false;
+            return result;
+          }
+
+          image.width = std::max(int32_t(glm::round(textureSize.x)), 1);
+          image.height = std::max(int32_t(glm::round(textureSize.y)), 1);
+          image.pixelData.resize(size_t(image.width) * size_t(image.height));
+          pRasterizer->rasterize(
+              tileRectangle,
+              image.width,
+              image.height,
+              insideValue,
+              outsideValue,
+              reinterpret_cast<uint8_t*>(image.pixelData.data()));
+          result.moreDetailAvailable = true;
+          return result;
+        });
+  }
+
+private:
+  std::shared_ptr<const CesiumPolygonRasterizer> _pRasterizer;
+  bool _invertSelection;
+};
+
+} // namespace
+
+std::shared_ptr<const CesiumPreparedPolygon>
+CesiumPreparedPolygon::prepare(const std::vector<glm::dvec2>& vertices) {
+  if (vertices.size() < 3) {
+    return nullptr;
+  }
+
+  auto pPolygon = std::make_shared<CesiumPreparedPolygon>();
+  CesiumPreparedPolygon& polygon = *pPolygon;
+  polygon.bounds =
+      Rectangle(vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y);
+  polygon.edges.reserve(vertices.size());
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const glm::dvec2& a = vertices[i];
+    const glm::dvec2& b = vertices[(i + 1) % vertices.size()];
+    polygon.bounds.minimumX = std::min(polygon.bounds.minimumX, a.x);
+    polygon.bounds.minimumY = std::min(polygon.bounds.minimumY, a.y);
+    polygon.bounds.maximumX = std::max(polygon.bounds.maximumX, a.x);
+    polygon.bounds.maximumY = std::max(polygon.bounds.maximumY, a.y);
+
+    // Horizontal edges never cross a row of pixel centers, since rows only
+    // count edges whose Y range includes them at the bottom, but they can
+    // still cross a rectangle that is being classified.
+    const glm::dvec2& bottom = a.y < b.y ? a : b;
+    const glm::dvec2& top = a.y < b.y ? b : a;
+    polygon.edges.push_back(Edge{
+        bottom,
+        top,
+        a.y == b.y ? 0.0 : (top.x - bottom.x) / (top.y - bottom.y)});
+  }
+
+  const int32_t bandCount =
+      std::clamp(int32_t(polygon.edges.size() / 4), 1, MaximumBands);
+  polygon.bandHeight =
+      std::max(polygon.bounds.computeHeight() / double(bandCount), 1e-12);
+  polygon.bands.resize(size_t(bandCount));
+  for (size_t i = 0; i < polygon.edges.size(); ++i) {
+    const Edge& edge = polygon.edges[i];
+    const int32_t first = CesiumRasterizerUtility::findCell(
+        edge.bottom.y,
+        polygon.bounds.minimumY,
+        polygon.bandHeight,
+        bandCount);
+    const int32_t last = CesiumRasterizerUtility::findCell(
+        edge.top.y,
+        polygon.bounds.minimumY,
+        polygon.bandHeight,
+        bandCount);
+    for (int32_t band = first; band <= last; ++band) {
+      polygon.bands[size_t(band)].push_back(uint32_t(i));
+    }
+  }
+
+  return pPolygon;
+}
+
+CesiumPolygonRasterizer::CesiumPolygonRasterizer(
+    const std::vector<std::vector<glm::dvec2>>& polygons)
+    : CesiumPolygonRasterizer(preparePolygons(polygons)) {}
+
+CesiumPolygonRasterizer::CesiumPolygonRasterizer(
+    std::vector<std::shared_ptr<const CesiumPreparedPolygon>> polygons)
+    : _polygons(std::move(polygons)),
+      _bounds(0.0, 0.0, 0.0, 0.0),
+      _columns(0),
+      _rows(0),
+      _cells() {
+  this->_polygons.erase(
+      std::remove(this->_polygons.begin(), this->_polygons.end(), nullptr),
+      this->_polygons.end());
+
+  for (size_t i = 0; i < this->_polygons.size(); ++i) {
+    const Rectangle& bounds = this->_polygons[i]->bounds;
+    if (i == 0) {
+      this->_bounds = bounds;
+    } else {
+      this->_bounds.minimumX =
+          std::min(this->_bounds.minimumX, bounds.minimumX);
+      this->_bounds.minimumY =
+          std::min(this->_bounds.minimumY, bounds.minimumY);
+      this->_bounds.maximumX =
+          std::max(this->_bounds.maximumX, bounds.maximumX);
+      this->_bounds.maximumY =
+          std::max(this->_bounds.maximumY, bounds.maximumY);
+    }
+  }
+
+  if (this->_polygons.empty()) {
+    return;
+  }
+
+  const int32_t gridSize = std::clamp(
+      int32_t(2.0 * std::sqrt(double(this->_polygons.size()))),
+      1,
+      MaximumPolygonGridSize);
+  this->_columns = gridSize;
+  this->_rows = gridSize;
+  this->_cells.resize(size_t(this->_columns) * size_t(this->_rows));
+
+  const double cellWidth =
+      std::max(this->_bounds.computeWidth() / this->_columns, 1e-12);
+  const double cellHeight =
+      std::max(this->_bounds.computeHeight() / this->_rows, 1e-12);
+  for (size_t i = 0; i < this->_polygons.size(); ++i) {
+    const Rectangle& bounds = this->_polygons[i]->bounds;
+    const int32_t west = CesiumRasterizerUtility::findCell(
+        bounds.minimumX,
+        this->_bounds.minimumX,
+        cellWidth,
+        this->_columns);
+    const int32_t east = CesiumRasterizerUtility::findCell(
+        bounds.maximumX,
+        this->_bounds.minimumX,
+        cellWidth,
+        this->_columns);
+    const int32_t south = CesiumRasterizerUtility::findCell(
+        bounds.minimumY,
+        this->_bounds.minimumY,
+        cellHeight,
+        this->_rows);
+    const int32_t north = CesiumRasterizerUtility::findCell(
+        bounds.maximumY,
+        this->_bounds.minimumY,
+        cellHeight,
+        this->_rows);
+    for (int32_t row = south; row <= north; ++row) {
+      for (int32_t column = west; column <= east; ++column) {
+        this->_cells[size_t(row * this->_columns + column)].push_back(
+            uint32_t(i));
+      }
+    }
+  }
+}
+
+std::vector<uint32_t>
+CesiumPolygonRasterizer::findPolygons(const Rectangle& rectangle) const {
+  std::vector<uint32_t> result;
+  if (this->_polygons.empty() ||
+      !CesiumRasterizerUtility::overlaps(rectangle, this->_bounds)) {
+    return result;
+  }
+
+  const double cellWidth =
+      std::max(this->_bounds.computeWidth() / this->_columns, 1e-12);
+  const double cellHeight =
+      std::max(this->_bounds.computeHeight() / this->_rows, 1e-12);
+  const int32_t west = CesiumRasterizerUtility::findCell(
+      rectangle.minimumX,
+      this->_bounds.minimumX,
+      cellWidth,
+      this->_columns);
+  const int32_t east = CesiumRasterizerUtility::findCell(
+      rectangle.maximumX,
+      this->_bounds.minimumX,
+      cellWidth,
+      this->_columns);
+  const int32_t south = CesiumRasterizerUtility::findCell(
+      rectangle.minimumY,
+      this->_bounds.minimumY,
+      cellHeight,
+      this->_rows);
+  const int32_t north = CesiumRasterizerUtility::findCell(
+      rectangle.maximumY,
+      this->_bounds.minimumY,
+      cellHeight,
+      this->_rows);
+
+  for (int32_t row = south; row <= north; ++row) {
+    for (int32_t column = west; column <= east; ++column) {
+      for (uint32_t i : this->_cells[size_t(row * this->_columns + column)]) {
+        if (CesiumRasterizerUtility::overlaps(
+                rectangle,
+                this->_polygons[i]->bounds)) {
+          result.push_back(i);
+        }
+      }
+    }
+  }
+
+  // Polygons that cover more than one cell are found once in each.
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+bool CesiumPolygonRasterizer::rasterize(
+    const Rectangle& rectangle,
+    int32_t width,
+    int32_t height,
+    uint8_t insideValue,
+    uint8_t outsideValue,
+    uint8_t* pPixels) const {
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+
+  std::memset(pPixels, outsideValue, size_t(width) * size_t(height));
+
+  const std::vector<uint32_t> polygons = this->findPolygons(rectangle);
+  if (polygons.empty()) {
+    return false;
+  }
+
+  const double pixelWidth = rectangle.computeWidth() / width;
+  const double pixelHeight = rectangle.computeHeight() / height;
+
+  // The first pixel whose center is at or east of the given X coordinate.
+  const auto findColumn = [&rectangle, pixelWidth, width](double x) {
+    const double column =
+        std::ceil((x - rectangle.minimumX) / pixelWidth - 0.5);
+    return int32_t(std::clamp(column, 0.0, double(width)));
+  };
+
+  std::vector<double> crossings;
+  for (int32_t row = 0; row < height; ++row) {
+    const double y = rectangle.maximumY - (double(row) + 0.5) * pixelHeight;
+    uint8_t* pRow = pPixels + size_t(row) * size_t(width);
+
+    for (uint32_t i : polygons) {
+      const CesiumPreparedPolygon& polygon = *this->_polygons[i];
+      if (y < polygon.bounds.minimumY || y >= polygon.bounds.maximumY) {
+        continue;
+      }
+
+      const int32_t band = CesiumRasterizerUtility::findCell(
+          y,
+          polygon.bounds.minimumY,
+          polygon.bandHeight,
+          int32_t(polygon.bands.size()));
+
+      crossings.clear();
+      for (uint32_t e : polygon.bands[size_t(band)]) {
+        const CesiumPreparedPolygon::Edge& edge = polygon.edges[e];
+        if (y >= edge.bottom.y && y < edge.top.y) {
+          crossings.push_back(edge.bottom.x + (y - edge.bottom.y) * edge.slope);
+        }
+      }
+      std::sort(crossings.begin(), crossings.end());
+
+      // Pixels between each pair of crossings are inside the polygon, by the
+      // even-odd rule.
+      for (size_t c = 0; c + 1 < crossings.size(); c += 2) {
+        const int32_t first = findColumn(crossings[c]);
+        const int32_t last = findColumn(crossings[c + 1]);
+        if (last > first) {
+          std::memset(pRow + first, insideValue, size_t(last - first));
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+CesiumPolygonRasterizer::Coverage
+CesiumPolygonRasterizer::classify(const Rectangle& rectangle) const {
+  const glm::dvec2 center(
+      (rectangle.minimumX + rectangle.maximumX) * 0.5,
+      (rectangle.minimumY + rectangle.maximumY) * 0.5);
+
+  // A rectangle that doesn't cross any of a polygon's edges is either
+  // entirely inside or entirely outside of it.
+  Coverage result = Coverage::Outside;
+  for (uint32_t i : this->findPolygons(rectangle)) {
+    const CesiumPreparedPolygon& polygon = *this->_polygons[i];
+    if (this->crossesEdges(polygon, rectangle)) {
+      result = Coverage::Partial;
+    } else if (this->contains(polygon, center)) {
+      return Coverage::Inside;
+    }
+  }
+  return result;
+}
+
+bool CesiumPolygonRasterizer::crossesEdges(
+    const CesiumPreparedPolygon& polygon,
+    const Rectangle& rectangle) const {
+  const int32_t bandCount = int32_t(polygon.bands.size());
+  const int32_t first = CesiumRasterizerUtility::findCell(
+      rectangle.minimumY,
+      polygon.bounds.minimumY,
+      polygon.bandHeight,
+      bandCount);
+  const int32_t last = CesiumRasterizerUtility::findCell(
+      rectangle.maximumY,
+      polygon.bounds.minimumY,
+      polygon.bandHeight,
+      bandCount);
+  for (int32_t band = first; band <= last; ++band) {
+    for (uint32_t e : polygon.bands[size_t(band)]) {
+      const CesiumPreparedPolygon::Edge& edge = polygon.edges[e];
+      if (segmentIntersects(edge.bottom, edge.top, rectangle)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool CesiumPolygonRasterizer::contains(
+    const CesiumPreparedPolygon& polygon,
+    const glm::dvec2& point) const {
+  if (point.y < polygon.bounds.minimumY ||
+      point.y >= polygon.bounds.maximumY) {
+    return false;
+  }
+
+  const int32_t band = CesiumRasterizerUtility::findCell(
+      point.y,
+      polygon.bounds.minimumY,
+      polygon.bandHeight,
+      int32_t(polygon.bands.size()));
+
+  // Count the crossings to the west of the point, by the same rule as the
+  // rows of rasterize.
+  bool inside = false;
+  for (uint32_t e : polygon.bands[size_t(band)]) {
+    const CesiumPreparedPolygon::Edge& edge = polygon.edges[e];
+    if (point.y >= edge.bottom.y && point.y < edge.top.y &&
+        edge.bottom.x + (point.y - edge.bottom.y) * edge.slope < point.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+CesiumPolygonRasterizerOverlay::CesiumPolygonRasterizerOverlay(
+    const std::string& name,
+    const std::vector<CartographicPolygon>& polygons,
+    bool invertSelection,
+    const Ellipsoid& ellipsoid,
+    const Projection& projection,
+    const RasterOverlayOptions& overlayOptions)
+    : RasterizedPolygonsOverlay(
+          name,
+          polygons,
+          invertSelection,
+          ellipsoid,
+          projection,
+          overlayOptions),
+      _pRasterizer(
+          std::make_shared<CesiumPolygonRasterizer>(getVertices(polygons))),
+      _invertSelection(invertSelection) {}
+
+CesiumPolygonRasterizerOverlay::CesiumPolygonRasterizerOverlay(
+    const std::string& name,
+    const std::vector<CartographicPolygon>& polygons,
+    const std::shared_ptr<const CesiumPolygonRasterizer>& pRasterizer,
+    bool invertSelection,
+    const Ellipsoid& ellipsoid,
+    const Projection& projection,
+    const RasterOverlayOptions& overlayOptions)
+    : RasterizedPolygonsOverlay(
+          name,
+          polygons,
+          invertSelection,
+          ellipsoid,
+          projection,
+          overlayOptions),
+      _pRasterizer(pRasterizer),
+      _invertSelection(invertSelection) {}
+
+Future<RasterOverlay::CreateTileProviderResult>
+CesiumPolygonRasterizerOverlay::createTileProvider(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CreditSystem>& pCreditSystem,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    IntrusivePointer<const RasterOverlay> pOwner) const {
+  if (!pOwner) {
+    pOwner = IntrusivePointer<const RasterOverlay>(this);
+  }
+
+  // The tile provider created by RasterizedPolygonsOverlay sets up the
+  // projection and coverage, and is replaced by one that rasterizes with the
+  // index.
+  return RasterizedPolygonsOverlay::createTileProvider(
+             asyncSystem,
+             pAssetAccessor,
+             pCreditSystem,
+             pPrepareRendererResources,
+             pLogger,
+             pOwner)
+      .thenImmediately(
+          [pOwner,
+           pRasterizer = this->_pRasterizer,
+           invertSelection = this->_invertSelection](
+              CreateTileProviderResult&& created) -> CreateTileProviderResult {
+            if (!created) {
+              return std::move(created);
+            }
+
+            return IntrusivePointer<RasterOverlayTileProvider>(
+                new PolygonTileProvider(
+                    pOwner,
+                    **created,
+                    pRasterizer,
+                    invertSelection));
+          });
+}
+
+CesiumPolygonRasterizerExcluder::CesiumPolygonRasterizerExcluder(
+    const std::shared_ptr<const CesiumPolygonRasterizer>& pRasterizer,
+    bool invertSelection)
+    : _pRasterizer(pRasterizer), _invertSelection(invertSelection) {}
+
+bool CesiumPolygonRasterizerExcluder::shouldExclude(
+    const Cesium3DTilesSelection::Tile& tile) const noexcept {
+  const std::optional<GlobeRectangle> maybeRectangle =
+      Cesium3DTilesSelection::estimateGlobeRectangle(tile.getBoundingVolume());
+
+  // Rectangles that cross the antimeridian aren't handled, so their tiles
+  // are kept.
+  if (!maybeRectangle ||
+      maybeRectangle->getWest() > maybeRectangle->getEast()) {
+    return false;
+  }
+
+  const CesiumPolygonRasterizer::Coverage coverage =
+      this->_pRasterizer->classify(Rectangle(
+          maybeRectangle->getWest(),
+          maybeRectangle->getSouth(),
+          maybeRectangle->getEast(),
+          maybeRectangle->getNorth()));
+  return this->_invertSelection
+             ? coverage == CesiumPolygonRasterizer::Coverage::Outside
+             : coverage == CesiumPolygonRasterizer::Coverage::Inside;
+}
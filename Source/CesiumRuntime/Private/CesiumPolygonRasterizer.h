@@ -0,0 +1,228 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Cesium3DTilesSelection/ITileExcluder.h"
+#include "CesiumGeometry/Rectangle.h"
+#include "CesiumRasterOverlays/RasterizedPolygonsOverlay.h"
+#include <glm/vec2.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A polygon whose edges are indexed for a CesiumPolygonRasterizer. Each
+ * polygon's edges are sorted into horizontal bands, so that each row of
+ * pixels only tests the edges that cross it.
+ *
+ * Prepared polygons are immutable, so a rasterizer that is rebuilt when one
+ * polygon changes can share the others with the rasterizer it replaces,
+ * instead of indexing every polygon's edges again.
+ */
+struct CesiumPreparedPolygon {
+  struct Edge {
+    // The end of the edge with the smaller Y coordinate.
+    glm::dvec2 bottom;
+    glm::dvec2 top;
+    // The change in X for each unit of Y, or 0 for horizontal edges.
+    double slope;
+  };
+
+  CesiumGeometry::Rectangle bounds{0.0, 0.0, 0.0, 0.0};
+  std::vector<Edge> edges;
+  // The edges that cross each horizontal band of the polygon's bounds.
+  std::vector<std::vector<uint32_t>> bands;
+  double bandHeight = 0.0;
+
+  /**
+   * Indexes the edges of a polygon.
+   *
+   * @param vertices The vertices of the polygon, as longitude and latitude in
+   * radians.
+   * @return The polygon, or nullptr if it has fewer than three vertices.
+   */
+  static std::shared_ptr<const CesiumPreparedPolygon>
+  prepare(const std::vector<glm::dvec2>& vertices);
+};
+
+/**
+ * Rasterizes polygons into coverage masks for rectangles of the globe.
+ *
+ * The polygons are indexed when this is constructed. A grid over all of the
+ * polygons records which polygons overlap each cell, so that rasterizing a
+ * rectangle only considers the polygons near it. Each polygon's edges are
+ * indexed by a CesiumPreparedPolygon. Rows are then filled span by span,
+ * between the points where the polygon's edges cross the row, instead of
+ * testing every pixel against the polygon.
+ *
+ * Once constructed, this may be used from any number of threads at once.
+ */
+class CesiumPolygonRasterizer {
+public:
+  /**
+   * @param polygons The vertices of each polygon, as longitude and latitude
+   * in radians. Polygons with fewer than three vertices are ignored.
+   */
+  explicit CesiumPolygonRasterizer(
+      const std::vector<std::vector<glm::dvec2>>& polygons);
+
+  /**
+   * @param polygons The prepared polygons, which may be shared with other
+   * rasterizers. Null polygons are ignored.
+   */
+  explicit CesiumPolygonRasterizer(
+      std::vector<std::shared_ptr<const CesiumPreparedPolygon>> polygons);
+
+  /**
+   * Finds the polygons whose bounding rectangles overlap a rectangle.
+   *
+   * @param rectangle The rectangle, in longitude and latitude radians.
+   * @return The indices of the polygons, in increasing order. Polygons that
+   * were ignored when this was constructed aren't counted.
+   */
+  std::vector<uint32_t>
+  findPolygons(const CesiumGeometry::Rectangle& rectangle) const;
+
+  /**
+   * Rasterizes the polygons over a rectangle into a single-channel 8-bit
+   * mask. Each pixel whose center is inside any polygon is set to
+   * insideValue, and every other pixel is set to outsideValue. Rows start at
+   * the north edge of the rectangle.
+   *
+   * @param rectangle The rectangle, in longitude and latitude radians.
+   * @param width The width of the image in pixels.
+   * @param height The height of the image in pixels.
+   * @param insideValue The value of pixels inside a polygon.
+   * @param outsideValue The value of pixels outside of all polygons.
+   * @param pPixels The mask, which must have room for width * height bytes.
+   * @return Whether any polygon overlaps the rectangle. If not, every pixel
+   * is set to outsideValue.
+   */
+  bool rasterize(
+      const CesiumGeometry::Rectangle& rectangle,
+      int32_t width,
+      int32_t height,
+      uint8_t insideValue,
+      uint8_t outsideValue,
+      uint8_t* pPixels) const;
+
+  /**
+   * How a rectangle is covered by the polygons.
+   */
+  enum class Coverage {
+    /** The rectangle doesn't overlap any polygon. */
+    Outside,
+    /** The rectangle crosses the edge of at least one polygon. */
+    Partial,
+    /** The rectangle is entirely inside at least one polygon. */
+    Inside
+  };
+
+  /**
+   * Determines how a rectangle is covered by the polygons.
+   *
+   * @param rectangle The rectangle, in longitude and latitude radians.
+   */
+  Coverage classify(const CesiumGeometry::Rectangle& rectangle) const;
+
+private:
+  bool crossesEdges(
+      const CesiumPreparedPolygon& polygon,
+      const CesiumGeometry::Rectangle& rectangle) const;
+  bool
+  contains(const CesiumPreparedPolygon& polygon, const glm::dvec2& point) const;
+
+  std::vector<std::shared_ptr<const CesiumPreparedPolygon>> _polygons;
+
+  CesiumGeometry::Rectangle _bounds;
+  int32_t _columns;
+  int32_t _rows;
+  // The polygons whose bounds overlap each cell of the grid over _bounds,
+  // row by row.
+  std::vector<std::vector<uint32_t>> _cells;
+};
+
+/**
+ * A cesium-native RasterizedPolygonsOverlay whose tiles are rasterized by a
+ * CesiumPolygonRasterizer. Tiles that no polygon overlaps are a single pixel,
+ * since they're uniformly outside the selection.
+ *
+ * This still derives from RasterizedPolygonsOverlay, so that
+ * RasterizedPolygonsTileExcluder can exclude tiles with the same polygons.
+ */
+class CesiumPolygonRasterizerOverlay
+    : public CesiumRasterOverlays::RasterizedPolygonsOverlay {
+public:
+  CesiumPolygonRasterizerOverlay(
+      const std::string& name,
+      const std::vector<CesiumGeospatial::CartographicPolygon>& polygons,
+      bool invertSelection,
+      const CesiumGeospatial::Ellipsoid& ellipsoid,
+      const CesiumGeospatial::Projection& projection,
+      const CesiumRasterOverlays::RasterOverlayOptions& overlayOptions = {});
+
+  /**
+   * Creates an overlay that rasterizes with an existing rasterizer, which
+   * must index the same polygons.
+   */
+  CesiumPolygonRasterizerOverlay(
+      const std::string& name,
+      const std::vector<CesiumGeospatial::CartographicPolygon>& polygons,
+      const std::shared_ptr<const CesiumPolygonRasterizer>& pRasterizer,
+      bool invertSelection,
+      const CesiumGeospatial::Ellipsoid& ellipsoid,
+      const CesiumGeospatial::Projection& projection,
+      const CesiumRasterOverlays::RasterOverlayOptions& overlayOptions = {});
+
+  virtual CesiumAsync::Future<
+      CesiumRasterOverlays::RasterOverlay::CreateTileProviderResult>
+  createTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<
+          CesiumRasterOverlays::IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumUtility::IntrusivePointer<const CesiumRasterOverlays::RasterOverlay>
+          pOwner) const override;
+
+  /**
+   * Gets the rasterizer, which indexes this overlay's polygons.
+   */
+  const std::shared_ptr<const CesiumPolygonRasterizer>&
+  getRasterizer() const noexcept {
+    return this->_pRasterizer;
+  }
+
+private:
+  std::shared_ptr<const CesiumPolygonRasterizer> _pRasterizer;
+  bool _invertSelection;
+};
+
+/**
+ * Excludes the tiles that are entirely inside the polygons of a
+ * CesiumPolygonRasterizerOverlay, or entirely outside all of them if the
+ * selection is inverted. Excluded tiles are skipped by the tile selection
+ * traversal, so neither they nor their descendants are requested.
+ *
+ * A tile is tested by the rectangle that cesium-native estimates for its
+ * bounding volume, which works for boxes and spheres as well as regions.
+ * With the rasterizer's index, each tile is only tested against the polygons
+ * near it, and only against the edges of those polygons that are near it.
+ */
+class CesiumPolygonRasterizerExcluder
+    : public Cesium3DTilesSelection::ITileExcluder {
+public:
+  CesiumPolygonRasterizerExcluder(
+      const std::shared_ptr<const CesiumPolygonRasterizer>& pRasterizer,
+      bool invertSelection);
+
+  virtual bool shouldExclude(
+      const Cesium3DTilesSelection::Tile& tile) const noexcept override;
+
+private:
+  std::shared_ptr<const CesiumPolygonRasterizer> _pRasterizer;
+  bool _invertSelection;
+};
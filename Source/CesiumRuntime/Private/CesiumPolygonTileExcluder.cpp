@@ -0,0 +1,102 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPolygonTileExcluder.h"
+#include "CesiumCartographicPolygon.h"
+#include "Components/SplineComponent.h"
+
+namespace {
+
+bool isInside(const TArray<FVector2D>& polygon, const FVector2D& point) {
+  bool inside = false;
+  for (int32 i = 0, j = polygon.Num() - 1; i < polygon.Num(); j = i++) {
+    const FVector2D& a = polygon[i];
+    const FVector2D& b = polygon[j];
+    if ((a.Y > point.Y) != (b.Y > point.Y) &&
+        point.X < (b.X - a.X) * (point.Y - a.Y) / (b.Y - a.Y) + a.X) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+double getSquaredDistanceToEdges(
+    const TArray<FVector2D>& polygon,
+    const FVector2D& point) {
+  double minimum = TNumericLimits<double>::Max();
+  for (int32 i = 0, j = polygon.Num() - 1; i < polygon.Num(); j = i++) {
+    const FVector2D& a = polygon[j];
+    const FVector2D edge = polygon[i] - a;
+    const double lengthSquared = edge.SizeSquared();
+    const double t =
+        lengthSquared > 0.0
+            ? FMath::Clamp((point - a).Dot(edge) / lengthSquared, 0.0, 1.0)
+            : 0.0;
+    minimum = FMath::Min(minimum, FVector2D::DistSquared(point, a + edge * t));
+  }
+  return minimum;
+}
+
+} // namespace
+
+void UCesiumPolygonTileExcluder::PrepareForNewFrame() {
+  this->_footprints.Reset(this->Polygons.Num());
+
+  for (const ACesiumCartographicPolygon* pPolygon : this->Polygons) {
+    if (!IsValid(pPolygon) || !IsValid(pPolygon->Polygon)) {
+      continue;
+    }
+
+    const USplineComponent* pSpline = pPolygon->Polygon;
+    const int32 pointCount = pSpline->GetNumberOfSplinePoints();
+    if (pointCount < 3) {
+      continue;
+    }
+
+    TArray<FVector2D>& footprint = this->_footprints.Emplace_GetRef();
+    footprint.Reserve(pointCount);
+    for (int32 i = 0; i < pointCount; ++i) {
+      const FVector location =
+          pSpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
+      footprint.Emplace(location.X, location.Y);
+    }
+  }
+}
+
+void UCesiumPolygonTileExcluder::SetFootprints(
+    TArray<TArray<FVector2D>>&& Footprints) {
+  this->_footprints = std::move(Footprints);
+}
+
+void UCesiumPolygonTileExcluder::ShouldExcludeTiles(
+    TConstArrayView<FBoxSphereBounds> TileBounds,
+    TBitArray<>& OutExcluded) {
+  OutExcluded.Init(false, TileBounds.Num());
+  if (this->_footprints.IsEmpty()) {
+    return;
+  }
+
+  for (int32 i = 0; i < TileBounds.Num(); ++i) {
+    const FBoxSphereBounds& bounds = TileBounds[i];
+    const FVector2D center(bounds.Origin.X, bounds.Origin.Y);
+    const double radiusSquared = bounds.SphereRadius * bounds.SphereRadius;
+
+    // A tile is entirely inside or outside a polygon when the circle around
+    // its footprint doesn't cross any of the polygon's edges.
+    bool insideAny = false;
+    bool outsideAll = true;
+    for (const TArray<FVector2D>& footprint : this->_footprints) {
+      const bool crossesEdge =
+          getSquaredDistanceToEdges(footprint, center) < radiusSquared;
+      const bool inside = isInside(footprint, center);
+      if (inside || crossesEdge) {
+        outsideAll = false;
+      }
+      if (inside && !crossesEdge) {
+        insideAny = true;
+        break;
+      }
+    }
+
+    OutExcluded[i] = this->InvertSelection ? outsideAll : insideAny;
+  }
+}
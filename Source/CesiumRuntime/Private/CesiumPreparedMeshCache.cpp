@@ -0,0 +1,385 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPreparedMeshCache.h"
+#include "Async/MappedFileHandle.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "StaticMeshResources.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Prepared Mesh Cache Hits"),
+    STAT_CesiumPreparedMeshCacheHits,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Prepared Mesh Cache Misses"),
+    STAT_CesiumPreparedMeshCacheMisses,
+    STATGROUP_Cesium);
+
+namespace {
+
+// Identifies the files of the cache, and the layout of the render data in
+// them. The version must be changed whenever the layout changes, or the
+// conversion of primitives does.
+constexpr uint32 PreparedMeshMagic = 0x434d5043; // "CPMC"
+constexpr uint32 PreparedMeshVersion = 1;
+
+// The cache is pruned each time 1/PruneFraction of its maximum size has been
+// written, down to that much below its maximum size.
+constexpr int64 PruneFraction = 16;
+
+struct PreparedMeshHeader {
+  uint32 magic;
+  uint32 version;
+  uint64 payloadHash;
+  int64 payloadBytes;
+};
+
+FString getDefaultDirectory() {
+#if PLATFORM_ANDROID
+  const FString baseDirectory = FPaths::ProjectPersistentDownloadDir();
+#elif PLATFORM_IOS
+  const FString baseDirectory =
+      FPaths::Combine(*FPaths::ProjectSavedDir(), TEXT("Cesium"));
+#else
+  const FString baseDirectory = FPaths::EngineUserDir();
+#endif
+  return FPaths::Combine(*baseDirectory, TEXT("cesium-prepared-mesh-cache"));
+}
+
+// The vertex buffers are kept without CPU access, like the ones loadPrimitive
+// creates, so their data is released once it's uploaded.
+void serializeRenderData(FArchive& ar, FStaticMeshRenderData& renderData) {
+  FStaticMeshLODResources& lod = renderData.LODResources[0];
+
+  float sphereRadius = renderData.Bounds.SphereRadius;
+  ar << sphereRadius;
+  bool hasColors = lod.bHasColorVertexData;
+  ar << hasColors;
+
+  lod.VertexBuffers.PositionVertexBuffer.Serialize(ar, false);
+  lod.VertexBuffers.StaticMeshVertexBuffer.Serialize(ar, false);
+  if (hasColors) {
+    lod.VertexBuffers.ColorVertexBuffer.Serialize(ar, false);
+  }
+  lod.IndexBuffer.Serialize(ar, false);
+
+  if (ar.IsLoading()) {
+    renderData.Bounds.SphereRadius = sphereRadius;
+    lod.bHasColorVertexData = hasColors;
+  }
+}
+
+uint64 hashAccessor(
+    const CesiumGltf::Model& model,
+    int32_t accessorID,
+    uint64 seed) {
+  const CesiumGltf::Accessor* pAccessor =
+      CesiumGltf::Model::getSafe(&model.accessors, accessorID);
+  if (!pAccessor) {
+    return seed;
+  }
+
+  const int64 description[] = {
+      pAccessor->count,
+      int64(pAccessor->componentType),
+      int64(pAccessor->normalized)};
+  seed = CityHash64WithSeed(
+      reinterpret_cast<const char*>(description),
+      sizeof(description),
+      seed);
+  seed = CityHash64WithSeed(
+      pAccessor->type.data(),
+      uint32(pAccessor->type.size()),
+      seed);
+
+  const CesiumGltf::BufferView* pBufferView =
+      CesiumGltf::Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+  const CesiumGltf::Buffer* pBuffer =
+      pBufferView
+          ? CesiumGltf::Model::getSafe(&model.buffers, pBufferView->buffer)
+          : nullptr;
+  if (!pBuffer) {
+    return seed;
+  }
+
+  const int64 bufferBytes = int64(pBuffer->cesium.data.size());
+  const int64 begin = std::clamp<int64>(
+      pBufferView->byteOffset + pAccessor->byteOffset,
+      0,
+      bufferBytes);
+  const int64 bytes = std::clamp<int64>(
+      pAccessor->computeByteStride(model) * pAccessor->count,
+      0,
+      bufferBytes - begin);
+  return CityHash64WithSeed(
+      reinterpret_cast<const char*>(pBuffer->cesium.data.data() + begin),
+      uint32(bytes),
+      seed);
+}
+
+} // namespace
+
+/*static*/ CesiumPreparedMeshCache& CesiumPreparedMeshCache::get() {
+  static CesiumPreparedMeshCache cache(
+      getDefaultDirectory(),
+      int64(GetDefault<UCesiumRuntimeSettings>()
+                ->PreparedMeshCacheSizeInMegabytes) *
+          1024 * 1024);
+  return cache;
+}
+
+/*static*/ bool CesiumPreparedMeshCache::isEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()
+             ->PreparedMeshCacheSizeInMegabytes > 0;
+}
+
+/*static*/ uint64 CesiumPreparedMeshCache::getKey(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::MeshPrimitive& primitive,
+    uint64 optionsHash) {
+  const int64 description[] = {
+      int64(PreparedMeshVersion),
+      int64(primitive.mode)};
+  uint64 key = CityHash64WithSeed(
+      reinterpret_cast<const char*>(description),
+      sizeof(description),
+      optionsHash);
+  key = hashAccessor(model, primitive.indices, key);
+
+  // The attributes are hashed in order of their names, so that the key
+  // doesn't depend on the order of the map.
+  std::vector<std::string> names;
+  names.reserve(primitive.attributes.size());
+  for (const auto& [name, accessorID] : primitive.attributes) {
+    names.push_back(name);
+  }
+  std::sort(names.begin(), names.end());
+
+  for (const std::string& name : names) {
+    key = CityHash64WithSeed(name.data(), uint32(name.size()), key);
+    key = hashAccessor(model, primitive.attributes.at(name), key);
+  }
+
+  return key;
+}
+
+CesiumPreparedMeshCache::CesiumPreparedMeshCache(
+    const FString& directory,
+    int64 maximumBytes)
+    : _directory(directory),
+      _maximumBytes(maximumBytes),
+      // Files left by previous sessions are pruned with the first write.
+      _bytesWrittenSincePrune(maximumBytes / PruneFraction) {}
+
+bool CesiumPreparedMeshCache::find(
+    uint64 key,
+    FStaticMeshRenderData& renderData) {
+  if (this->_maximumBytes <= 0) {
+    return false;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReadPreparedMesh)
+
+  const FString filename = this->getFilename(key);
+  IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+  // The region must be destroyed before the file handle it was mapped from,
+  // so it's declared after it.
+  TUniquePtr<IMappedFileHandle> pMappedFile;
+  TUniquePtr<IMappedFileRegion> pMappedRegion;
+  TArray<uint8> contents;
+  TArrayView<const uint8> bytes;
+
+  if (GetDefault<UCesiumRuntimeSettings>()->UseMemoryMappedFileReads) {
+    pMappedFile.Reset(platformFile.OpenMapped(*filename));
+    if (pMappedFile && pMappedFile->GetFileSize() > 0) {
+      pMappedRegion.Reset(
+          pMappedFile->MapRegion(0, pMappedFile->GetFileSize()));
+    }
+  }
+
+  if (pMappedRegion) {
+    bytes = TArrayView<const uint8>(
+        pMappedRegion->GetMappedPtr(),
+        int32(pMappedRegion->GetMappedSize()));
+  } else if (FFileHelper::LoadFileToArray(
+                 contents,
+                 *filename,
+                 FILEREAD_Silent)) {
+    bytes = contents;
+  } else {
+    ++this->_missCount;
+    INC_DWORD_STAT(STAT_CesiumPreparedMeshCacheMisses);
+    return false;
+  }
+
+  if (!read(bytes, renderData)) {
+    // A file that is truncated, or from another version, is deleted so that
+    // it's replaced by the next write.
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Deleting the invalid prepared mesh cache file %s"),
+        *filename);
+    pMappedRegion.Reset();
+    pMappedFile.Reset();
+    platformFile.DeleteFile(*filename);
+    ++this->_missCount;
+    INC_DWORD_STAT(STAT_CesiumPreparedMeshCacheMisses);
+    return false;
+  }
+
+  // The modification time records when the file was last used, so that
+  // pruning deletes the files that were used least recently.
+  platformFile.SetTimeStamp(*filename, FDateTime::UtcNow());
+
+  ++this->_hitCount;
+  INC_DWORD_STAT(STAT_CesiumPreparedMeshCacheHits);
+  return true;
+}
+
+void CesiumPreparedMeshCache::add(
+    uint64 key,
+    FStaticMeshRenderData& renderData) {
+  if (this->_maximumBytes <= 0) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WritePreparedMesh)
+
+  TArray<uint8> data;
+  data.AddZeroed(sizeof(PreparedMeshHeader));
+  {
+    FMemoryWriter writer(data);
+    writer.Seek(sizeof(PreparedMeshHeader));
+    serializeRenderData(writer, renderData);
+  }
+
+  PreparedMeshHeader header;
+  header.magic = PreparedMeshMagic;
+  header.version = PreparedMeshVersion;
+  header.payloadBytes = data.Num() - int64(sizeof(PreparedMeshHeader));
+  header.payloadHash = CityHash64(
+      reinterpret_cast<const char*>(data.GetData() + sizeof(header)),
+      uint32(header.payloadBytes));
+  FMemory::Memcpy(data.GetData(), &header, sizeof(header));
+
+  // The file is written under another name first, so that a reader never
+  // sees it half written.
+  const FString filename = this->getFilename(key);
+  const FString temporaryFilename = FPaths::CreateTempFilename(
+      *this->_directory,
+      TEXT("write-"),
+      TEXT(".tmp"));
+  if (!FFileHelper::SaveArrayToFile(data, *temporaryFilename) ||
+      !IFileManager::Get().Move(*filename, *temporaryFilename, true, true)) {
+    IFileManager::Get().Delete(*temporaryFilename, false, false, true);
+    return;
+  }
+
+  if ((this->_bytesWrittenSincePrune += data.Num()) >=
+      this->_maximumBytes / PruneFraction) {
+    this->_bytesWrittenSincePrune = 0;
+    this->prune();
+  }
+}
+
+void CesiumPreparedMeshCache::prune() {
+  // Only one thread prunes at a time. The others carry on loading.
+  if (this->_pruning.exchange(true)) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::PrunePreparedMeshes)
+
+  struct File {
+    FString filename;
+    FDateTime lastUsed;
+    int64 bytes;
+  };
+  TArray<File> files;
+  int64 totalBytes = 0;
+  IFileManager::Get().IterateDirectoryStat(
+      *this->_directory,
+      [&files, &totalBytes](const TCHAR* filename, const FFileStatData& stat) {
+        if (!stat.bIsDirectory) {
+          files.Add({filename, stat.ModificationTime, stat.FileSize});
+          totalBytes += stat.FileSize;
+        }
+        return true;
+      });
+
+  if (totalBytes > this->_maximumBytes) {
+    files.Sort([](const File& lhs, const File& rhs) {
+      return lhs.lastUsed < rhs.lastUsed;
+    });
+
+    // Prune below the maximum size, so that the next prune isn't needed
+    // right away.
+    const int64 targetBytes =
+        this->_maximumBytes - this->_maximumBytes / PruneFraction;
+    for (const File& file : files) {
+      if (totalBytes <= targetBytes) {
+        break;
+      }
+      if (IFileManager::Get().Delete(*file.filename, false, false, true)) {
+        totalBytes -= file.bytes;
+      }
+    }
+  }
+
+  this->_pruning = false;
+}
+
+FString CesiumPreparedMeshCache::getFilename(uint64 key) const {
+  return FPaths::Combine(
+      *this->_directory,
+      FString::Printf(TEXT("%016llx.mesh"), key));
+}
+
+/*static*/ bool CesiumPreparedMeshCache::read(
+    TArrayView<const uint8> bytes,
+    FStaticMeshRenderData& renderData) {
+  if (bytes.Num() < int32(sizeof(PreparedMeshHeader))) {
+    return false;
+  }
+
+  PreparedMeshHeader header;
+  FMemory::Memcpy(&header, bytes.GetData(), sizeof(header));
+  const TArrayView<const uint8> payload =
+      bytes.RightChop(sizeof(PreparedMeshHeader));
+  if (header.magic != PreparedMeshMagic ||
+      header.version != PreparedMeshVersion ||
+      header.payloadBytes != payload.Num() ||
+      header.payloadHash !=
+          CityHash64(
+              reinterpret_cast<const char*>(payload.GetData()),
+              uint32(payload.Num()))) {
+    return false;
+  }
+
+  // The payload's hash matches, so it was written completely and can only
+  // fail to be read if the engine reads buffers differently than it wrote
+  // them. The buffers that loadPrimitive fills are all initialized again if
+  // it converts the primitive after all, except for the color buffer.
+  FMemoryReaderView reader(payload);
+  serializeRenderData(reader, renderData);
+  if (reader.IsError() || reader.Tell() != payload.Num()) {
+    renderData.LODResources[0].VertexBuffers.ColorVertexBuffer.CleanUp();
+    renderData.LODResources[0].bHasColorVertexData = false;
+    return false;
+  }
+
+  return true;
+}
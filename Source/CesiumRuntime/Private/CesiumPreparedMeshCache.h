@@ -0,0 +1,119 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/UnrealString.h"
+#include "HAL/Platform.h"
+#include <atomic>
+#include <cstdint>
+
+namespace CesiumGltf {
+struct MeshPrimitive;
+struct Model;
+} // namespace CesiumGltf
+
+class FStaticMeshRenderData;
+
+/**
+ * Keeps the vertex and index buffers that the primitives of tiles are
+ * converted to on disk, up to "Prepared Mesh Cache Size In Megabytes" of
+ * them, so that loading the same primitive again reads its buffers in their
+ * final layout instead of copying its indices and computing its normals,
+ * tangents, and texture coordinates again.
+ *
+ * Each primitive is stored in its own file, named by a hash of the glTF data
+ * of the primitive and of the options it was converted with, so the same
+ * primitive is shared by every tileset and every session. Files are read
+ * through a memory mapping when "Use Memory Mapped File Reads" is enabled.
+ * The files that were used least recently are deleted once the cache grows
+ * larger than its maximum size.
+ *
+ * Only the primitive's render data is kept. Its textures, materials,
+ * metadata, and physics meshes are still created from the glTF, which still
+ * has to be read.
+ *
+ * All functions may be called from any thread.
+ */
+class CesiumPreparedMeshCache {
+public:
+  /**
+   * Gets the cache shared by all tilesets, in the directory next to the
+   * request cache.
+   */
+  static CesiumPreparedMeshCache& get();
+
+  /**
+   * Determines whether the cache shared by all tilesets is enabled in the
+   * project settings.
+   */
+  static bool isEnabled();
+
+  /**
+   * Gets the key that identifies the render data of a primitive, from the
+   * bytes of its indices and vertex attributes, its mode, and a hash of the
+   * options it is converted with.
+   */
+  static uint64 getKey(
+      const CesiumGltf::Model& model,
+      const CesiumGltf::MeshPrimitive& primitive,
+      uint64 optionsHash);
+
+  /**
+   * Creates a cache in the given directory.
+   *
+   * @param directory The directory of the files.
+   * @param maximumBytes The size of the files to prune the cache to, or 0 to
+   * disable the cache.
+   */
+  CesiumPreparedMeshCache(const FString& directory, int64 maximumBytes);
+
+  /**
+   * Reads the render data with the given key into the first LOD of the given
+   * render data, which must already be allocated: its position, static mesh,
+   * and color vertex buffers, its index buffer, and the radius of its bounding
+   * sphere.
+   *
+   * @return True if the render data was found, or false if it isn't in the
+   * cache, in which case the render data is unchanged.
+   */
+  bool find(uint64 key, FStaticMeshRenderData& renderData);
+
+  /**
+   * Writes the first LOD of the given render data with the given key,
+   * replacing any render data that already has the key, and prunes the cache
+   * when enough has been written since it was last pruned. The render data is
+   * not modified.
+   */
+  void add(uint64 key, FStaticMeshRenderData& renderData);
+
+  /**
+   * Deletes the files that were used least recently until the cache is
+   * smaller than its maximum size.
+   */
+  void prune();
+
+  /**
+   * Gets the number of times render data was found in the cache.
+   */
+  int64 getHitCount() const { return this->_hitCount; }
+
+  /**
+   * Gets the number of times render data was looked for and not found.
+   */
+  int64 getMissCount() const { return this->_missCount; }
+
+private:
+  FString getFilename(uint64 key) const;
+
+  static bool
+  read(TArrayView<const uint8> bytes, FStaticMeshRenderData& renderData);
+
+  FString _directory;
+  int64 _maximumBytes;
+
+  std::atomic<int64> _bytesWrittenSincePrune;
+  std::atomic<bool> _pruning = false;
+  std::atomic<int64> _hitCount = 0;
+  std::atomic<int64> _missCount = 0;
+};
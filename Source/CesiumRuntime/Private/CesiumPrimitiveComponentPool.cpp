@@ -0,0 +1,106 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveComponentPool.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumRuntime.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace {
+// The most components that may be waiting to be reused. Components released
+// beyond this are destroyed instead, so that unloading a large part of a
+// tileset doesn't hold on to components that won't be needed again soon.
+constexpr int32 MaximumFreeComponents = 1024;
+
+// Renaming a pooled component only moves it between outers, so it should
+// neither create redirectors nor be recorded in the undo buffer.
+constexpr ERenameFlags RenameFlags =
+    REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional;
+} // namespace
+
+CesiumPrimitiveComponentPool::CesiumPrimitiveComponentPool(UObject* pOwner)
+    : _pOwner(pOwner), _free() {}
+
+UCesiumGltfPrimitiveComponent* CesiumPrimitiveComponentPool::acquire(
+    UClass* pClass,
+    UObject* pOuter,
+    FName name) {
+  check(IsInGameThread());
+
+  for (int32 i = this->_free.Num() - 1; i >= 0; --i) {
+    UCesiumGltfPrimitiveComponent* pComponent = this->_free[i];
+    if (!IsValid(pComponent)) {
+      this->_free.RemoveAtSwap(i, 1, false);
+      continue;
+    }
+
+    if (pComponent->GetClass() != pClass) {
+      continue;
+    }
+
+    this->_free.RemoveAtSwap(i, 1, false);
+
+    if (StaticFindObjectFast(nullptr, pOuter, name)) {
+      name = MakeUniqueObjectName(pOuter, pClass, name);
+    }
+    pComponent->Rename(*name.ToString(), pOuter, RenameFlags);
+
+    return pComponent;
+  }
+
+  return NewObject<UCesiumGltfPrimitiveComponent>(pOuter, pClass, name);
+}
+
+void CesiumPrimitiveComponentPool::release(
+    UCesiumGltfPrimitiveComponent* pComponent) {
+  check(IsInGameThread());
+
+  if (!IsValid(pComponent)) {
+    return;
+  }
+
+  if (this->_free.Num() >= MaximumFreeComponents) {
+    CesiumLifetime::destroyComponentRecursively(pComponent);
+    return;
+  }
+
+  if (pComponent->IsRegistered()) {
+    pComponent->UnregisterComponent();
+  }
+  pComponent->DetachFromComponent(
+      FDetachmentTransformRules::KeepRelativeTransform);
+  pComponent->PrepareForReuse();
+
+  // Move the component out of its glTF component, which is about to be
+  // destroyed.
+  pComponent->Rename(nullptr, this->_pOwner, RenameFlags);
+
+  this->_free.Add(pComponent);
+}
+
+void CesiumPrimitiveComponentPool::releaseChildren(USceneComponent* pParent) {
+  if (!pParent) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleasePrimitiveComponents)
+
+  // Releasing a component detaches it, so don't iterate the children directly.
+  TArray<USceneComponent*> children = pParent->GetAttachChildren();
+  for (USceneComponent* pChild : children) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+    if (pPrimitive) {
+      this->release(pPrimitive);
+    }
+  }
+}
+
+void CesiumPrimitiveComponentPool::AddReferencedObjects(
+    FReferenceCollector& Collector) {
+  Collector.AddReferencedObjects(this->_free);
+}
+
+FString CesiumPrimitiveComponentPool::GetReferencerName() const {
+  return TEXT("CesiumPrimitiveComponentPool");
+}
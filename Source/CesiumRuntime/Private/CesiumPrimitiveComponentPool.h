@@ -0,0 +1,83 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "UObject/GCObject.h"
+#include "UObject/NameTypes.h"
+#include "UObject/ObjectPtr.h"
+
+class UCesiumGltfPrimitiveComponent;
+class UClass;
+class UObject;
+class USceneComponent;
+
+/**
+ * A pool of primitive components that are reused for the glTF primitives of a
+ * tileset's tiles.
+ *
+ * Every loaded tile creates a component for each of its primitives, and every
+ * unloaded tile destroys them, so a tileset that is streaming constantly
+ * allocates and garbage collects thousands of components. Instead, components
+ * of unloaded tiles are unregistered, stripped of their mesh and material,
+ * and returned to this pool, to be given new render data and registered again
+ * by a later tile. The pool keeps its free components alive, and renames them
+ * into the tileset so that they don't keep their previous glTF component
+ * alive.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumPrimitiveComponentPool : public FGCObject {
+public:
+  /**
+   * Creates a pool for the components of the given tileset.
+   *
+   * @param pOwner The tileset that owns this pool. Free components are moved
+   * into this object while they wait to be reused.
+   */
+  explicit CesiumPrimitiveComponentPool(UObject* pOwner);
+
+  /**
+   * Takes a component of exactly the given class from the pool, or creates a
+   * new one if none is available. The component is not registered or
+   * attached, and has no static mesh.
+   *
+   * @param pClass The class of the component, either
+   * UCesiumGltfPrimitiveComponent or a subclass of it.
+   * @param pOuter The outer of the component, usually its glTF component.
+   * @param name The name of the component.
+   */
+  UCesiumGltfPrimitiveComponent*
+  acquire(UClass* pClass, UObject* pOuter, FName name);
+
+  template <typename T> T* acquire(UObject* pOuter, FName name) {
+    return static_cast<T*>(this->acquire(T::StaticClass(), pOuter, name));
+  }
+
+  /**
+   * Returns a component to the pool, destroying its render data and
+   * material. If the pool is already full, the component is destroyed
+   * instead.
+   */
+  void release(UCesiumGltfPrimitiveComponent* pComponent);
+
+  /**
+   * Returns every primitive component attached to the given component to the
+   * pool. This is done before destroying a glTF component, so that its
+   * primitives outlive it.
+   */
+  void releaseChildren(USceneComponent* pParent);
+
+  /**
+   * Gets the number of components that are waiting to be reused.
+   */
+  int32 getFreeCount() const { return this->_free.Num(); }
+
+  // FGCObject overrides
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  UObject* _pOwner;
+  TArray<TObjectPtr<UCesiumGltfPrimitiveComponent>> _free;
+};
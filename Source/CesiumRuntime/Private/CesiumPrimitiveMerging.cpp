@@ -0,0 +1,596 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveMerging.h"
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltf/ExtensionExtMeshGpuInstancing.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumUtility/JsonValue.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <limits>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace CesiumPrimitiveMerging {
+
+namespace {
+
+// The primitive extras that map the faces of a merged primitive to the
+// primitives they came from. Each element is an array of the mesh index,
+// primitive index, and first face of one of the original primitives.
+const std::string MergedPrimitivesExtra = "CESIUM_merged_primitives";
+
+// The primitive extras that hold the original index of a primitive that's left
+// in a mesh that merged primitives were removed from.
+const std::string SourcePrimitiveIndexExtra = "CESIUM_source_primitive_index";
+
+struct SourcePrimitive {
+  int32_t meshIndex;
+  int32_t primitiveIndex;
+  glm::dmat4 transform;
+};
+
+bool startsWith(const std::string& string, const char* prefix) {
+  return string.rfind(prefix, 0) == 0;
+}
+
+template <typename T>
+bool isValidFloatAccessor(
+    const Model& model,
+    int32_t accessorIndex,
+    const std::string& type,
+    int64_t count) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->type != type ||
+      pAccessor->componentType != Accessor::ComponentType::FLOAT ||
+      pAccessor->normalized || pAccessor->sparse) {
+    return false;
+  }
+  AccessorView<T> view(model, *pAccessor);
+  return view.status() == AccessorViewStatus::Valid &&
+         (count < 0 || view.size() == count);
+}
+
+bool isValidScalarAccessor(
+    const Model& model,
+    int32_t accessorIndex,
+    bool isIndices) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->type != Accessor::Type::SCALAR ||
+      pAccessor->normalized || pAccessor->sparse) {
+    return false;
+  }
+
+  // These are the types of indices, and the types of feature IDs that
+  // FCesiumFeatureIdAttribute reads.
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return true;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    return isIndices;
+  case Accessor::ComponentType::BYTE:
+  case Accessor::ComponentType::SHORT:
+  case Accessor::ComponentType::FLOAT:
+    return !isIndices;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Gets the key that primitives must have in common to be merged, or an empty
+ * string if the primitive can't be merged.
+ */
+std::string getMergeKey(
+    const Model& model,
+    const Node& node,
+    const MeshPrimitive& primitive) {
+  if (node.skin >= 0 || !node.weights.empty() ||
+      node.hasExtension<ExtensionExtMeshGpuInstancing>()) {
+    return std::string();
+  }
+
+  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      !primitive.targets.empty() || !primitive.extras.empty()) {
+    return std::string();
+  }
+
+  // Draco is decoded before the primitive is loaded, so the extension is only
+  // left over.
+  for (const auto& extension : primitive.extensions) {
+    if (extension.first != ExtensionExtMeshFeatures::ExtensionName &&
+        extension.first != "KHR_draco_mesh_compression") {
+      return std::string();
+    }
+  }
+
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end() ||
+      !isValidFloatAccessor<glm::vec3>(
+          model,
+          positionIt->second,
+          Accessor::Type::VEC3,
+          -1)) {
+    return std::string();
+  }
+  const int64_t vertexCount = model.accessors[positionIt->second].count;
+
+  std::vector<std::string> names;
+  names.reserve(primitive.attributes.size());
+  for (const auto& attribute : primitive.attributes) {
+    const std::string& name = attribute.first;
+    bool valid = false;
+    if (name == "POSITION" || name == "NORMAL") {
+      valid = isValidFloatAccessor<glm::vec3>(
+          model,
+          attribute.second,
+          Accessor::Type::VEC3,
+          vertexCount);
+    } else if (
+        startsWith(name, "TEXCOORD_") || startsWith(name, "_CESIUMOVERLAY_")) {
+      valid = isValidFloatAccessor<glm::vec2>(
+          model,
+          attribute.second,
+          Accessor::Type::VEC2,
+          vertexCount);
+    } else if (startsWith(name, "_FEATURE_ID_")) {
+      valid = isValidScalarAccessor(model, attribute.second, false) &&
+              model.accessors[attribute.second].count == vertexCount;
+    }
+    if (!valid) {
+      return std::string();
+    }
+    names.push_back(name);
+  }
+  std::sort(names.begin(), names.end());
+
+  if (primitive.indices >= 0 &&
+      !isValidScalarAccessor(model, primitive.indices, true)) {
+    return std::string();
+  }
+
+  std::string key = std::to_string(primitive.material);
+  for (const std::string& name : names) {
+    key += "|" + name;
+  }
+
+  // Feature IDs are only kept if they're attributes, whose values are copied
+  // into the merged primitive. Implicit feature IDs are vertex indices, which
+  // change when the vertices are merged.
+  const ExtensionExtMeshFeatures* pFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (pFeatures) {
+    for (const FeatureId& featureId : pFeatures->featureIds) {
+      if (!featureId.attribute || featureId.texture ||
+          primitive.attributes.find(
+              "_FEATURE_ID_" + std::to_string(*featureId.attribute)) ==
+              primitive.attributes.end()) {
+        return std::string();
+      }
+      key += "|f" + std::to_string(*featureId.attribute) + "," +
+             std::to_string(featureId.propertyTable.value_or(-1)) + "," +
+             (featureId.nullFeatureId
+                  ? std::to_string(*featureId.nullFeatureId)
+                  : std::string()) +
+             "," + featureId.label.value_or(std::string());
+    }
+  }
+
+  return key;
+}
+
+template <typename T>
+void appendIndices(
+    const Model& model,
+    const Accessor& accessor,
+    uint32_t vertexBase,
+    std::vector<uint32_t>& indices) {
+  AccessorView<T> view(model, accessor);
+  const int64_t count = view.size() - view.size() % 3;
+  for (int64_t i = 0; i < count; ++i) {
+    indices.push_back(vertexBase + uint32_t(view[i]));
+  }
+}
+
+template <typename T>
+void appendScalars(
+    const Model& model,
+    const Accessor& accessor,
+    std::vector<float>& values) {
+  AccessorView<T> view(model, accessor);
+  for (int64_t i = 0; i < view.size(); ++i) {
+    values.push_back(float(view[i]));
+  }
+}
+
+void appendFeatureIds(
+    const Model& model,
+    const Accessor& accessor,
+    std::vector<float>& values) {
+  switch (accessor.componentType) {
+  case Accessor::ComponentType::BYTE:
+    appendScalars<int8_t>(model, accessor, values);
+    break;
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    appendScalars<uint8_t>(model, accessor, values);
+    break;
+  case Accessor::ComponentType::SHORT:
+    appendScalars<int16_t>(model, accessor, values);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    appendScalars<uint16_t>(model, accessor, values);
+    break;
+  default:
+    appendScalars<float>(model, accessor, values);
+    break;
+  }
+}
+
+/**
+ * Adds the given values to the buffer, and adds a buffer view and accessor
+ * for them to the model. Returns the index of the accessor.
+ */
+int32_t addAccessor(
+    Model& model,
+    int32_t bufferIndex,
+    const void* pValues,
+    size_t byteLength,
+    int64_t count,
+    const std::string& type,
+    int32_t componentType) {
+  std::vector<std::byte>& data = model.buffers[bufferIndex].cesium.data;
+
+  // Keep every buffer view aligned to four bytes.
+  const size_t byteOffset = (data.size() + 3) & ~size_t(3);
+  data.resize(byteOffset + byteLength);
+  std::memcpy(data.data() + byteOffset, pValues, byteLength);
+  model.buffers[bufferIndex].byteLength = int64_t(data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = bufferIndex;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(byteLength);
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = int32_t(model.bufferViews.size() - 1);
+  accessor.count = count;
+  accessor.type = type;
+  accessor.componentType = componentType;
+
+  return int32_t(model.accessors.size() - 1);
+}
+
+/**
+ * Merges the given primitives, which have the same merge key, into a new
+ * primitive.
+ */
+MeshPrimitive
+mergeGroup(Model& model, const std::vector<SourcePrimitive>& sources) {
+  const MeshPrimitive& first =
+      model.meshes[sources[0].meshIndex].primitives[sources[0].primitiveIndex];
+
+  std::vector<std::string> names;
+  for (const auto& attribute : first.attributes) {
+    names.push_back(attribute.first);
+  }
+
+  // Every attribute is merged as floats, since feature IDs that
+  // FCesiumFeatureIdAttribute reads fit in them exactly.
+  std::unordered_map<std::string, std::vector<float>> values;
+  std::vector<uint32_t> indices;
+  JsonValue::Array ranges;
+  ranges.reserve(sources.size());
+
+  uint32_t vertexBase = 0;
+  for (const SourcePrimitive& source : sources) {
+    const MeshPrimitive& primitive =
+        model.meshes[source.meshIndex].primitives[source.primitiveIndex];
+    const glm::dmat3 normalTransform =
+        glm::inverseTranspose(glm::dmat3(source.transform));
+
+    int64_t vertexCount = 0;
+    for (const std::string& name : names) {
+      const Accessor& accessor =
+          model.accessors[primitive.attributes.at(name)];
+      std::vector<float>& attributeValues = values[name];
+
+      if (name == "POSITION") {
+        AccessorView<glm::vec3> view(model, accessor);
+        vertexCount = view.size();
+        for (int64_t i = 0; i < view.size(); ++i) {
+          const glm::dvec3 position =
+              glm::dvec3(source.transform * glm::dvec4(view[i], 1.0));
+          attributeValues.push_back(float(position.x));
+          attributeValues.push_back(float(position.y));
+          attributeValues.push_back(float(position.z));
+        }
+      } else if (name == "NORMAL") {
+        AccessorView<glm::vec3> view(model, accessor);
+        for (int64_t i = 0; i < view.size(); ++i) {
+          glm::dvec3 normal = normalTransform * glm::dvec3(view[i]);
+          const double length = glm::length(normal);
+          if (length > 0.0) {
+            normal /= length;
+          }
+          attributeValues.push_back(float(normal.x));
+          attributeValues.push_back(float(normal.y));
+          attributeValues.push_back(float(normal.z));
+        }
+      } else if (accessor.type == Accessor::Type::VEC2) {
+        AccessorView<glm::vec2> view(model, accessor);
+        for (int64_t i = 0; i < view.size(); ++i) {
+          attributeValues.push_back(view[i].x);
+          attributeValues.push_back(view[i].y);
+        }
+      } else {
+        appendFeatureIds(model, accessor, attributeValues);
+      }
+    }
+
+    ranges.emplace_back(JsonValue::Array{
+        JsonValue(int64_t(source.meshIndex)),
+        JsonValue(int64_t(source.primitiveIndex)),
+        JsonValue(int64_t(indices.size() / 3))});
+
+    const Accessor* pIndices =
+        Model::getSafe(&model.accessors, primitive.indices);
+    if (!pIndices) {
+      const int64_t count = vertexCount - vertexCount % 3;
+      for (int64_t i = 0; i < count; ++i) {
+        indices.push_back(vertexBase + uint32_t(i));
+      }
+    } else if (
+        pIndices->componentType == Accessor::ComponentType::UNSIGNED_BYTE) {
+      appendIndices<uint8_t>(model, *pIndices, vertexBase, indices);
+    } else if (
+        pIndices->componentType == Accessor::ComponentType::UNSIGNED_SHORT) {
+      appendIndices<uint16_t>(model, *pIndices, vertexBase, indices);
+    } else {
+      appendIndices<uint32_t>(model, *pIndices, vertexBase, indices);
+    }
+
+    vertexBase += uint32_t(vertexCount);
+  }
+
+  const int32_t bufferIndex = int32_t(model.buffers.size());
+  model.buffers.emplace_back();
+
+  MeshPrimitive merged;
+  merged.mode = MeshPrimitive::Mode::TRIANGLES;
+  merged.material = first.material;
+
+  for (const std::string& name : names) {
+    const std::vector<float>& attributeValues = values[name];
+    const bool isVec3 = name == "POSITION" || name == "NORMAL";
+    const bool isScalar = startsWith(name, "_FEATURE_ID_");
+    const int64_t components = isVec3 ? 3 : isScalar ? 1 : 2;
+    const int32_t accessorIndex = addAccessor(
+        model,
+        bufferIndex,
+        attributeValues.data(),
+        attributeValues.size() * sizeof(float),
+        int64_t(attributeValues.size()) / components,
+        isVec3     ? Accessor::Type::VEC3
+        : isScalar ? Accessor::Type::SCALAR
+                   : Accessor::Type::VEC2,
+        Accessor::ComponentType::FLOAT);
+    merged.attributes.emplace(name, accessorIndex);
+
+    if (name == "POSITION") {
+      // glTF requires the bounds of positions.
+      Accessor& accessor = model.accessors[accessorIndex];
+      glm::vec3 minimum(std::numeric_limits<float>::max());
+      glm::vec3 maximum(std::numeric_limits<float>::lowest());
+      for (size_t i = 0; i + 2 < attributeValues.size(); i += 3) {
+        const glm::vec3 position(
+            attributeValues[i],
+            attributeValues[i + 1],
+            attributeValues[i + 2]);
+        minimum = glm::min(minimum, position);
+        maximum = glm::max(maximum, position);
+      }
+      accessor.min = {minimum.x, minimum.y, minimum.z};
+      accessor.max = {maximum.x, maximum.y, maximum.z};
+    }
+  }
+
+  merged.indices = addAccessor(
+      model,
+      bufferIndex,
+      indices.data(),
+      indices.size() * sizeof(uint32_t),
+      int64_t(indices.size()),
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_INT);
+
+  // The feature ID sets are the same for every merged primitive, apart from
+  // the number of features in each.
+  const ExtensionExtMeshFeatures* pFirstFeatures =
+      model.meshes[sources[0].meshIndex]
+          .primitives[sources[0].primitiveIndex]
+          .getExtension<ExtensionExtMeshFeatures>();
+  if (pFirstFeatures) {
+    ExtensionExtMeshFeatures& features =
+        merged.addExtension<ExtensionExtMeshFeatures>();
+    features.featureIds = pFirstFeatures->featureIds;
+    for (FeatureId& featureId : features.featureIds) {
+      const std::vector<float>& featureIds =
+          values["_FEATURE_ID_" + std::to_string(*featureId.attribute)];
+      std::unordered_set<int64_t> unique;
+      for (float id : featureIds) {
+        if (!featureId.nullFeatureId ||
+            int64_t(id) != *featureId.nullFeatureId) {
+          unique.insert(int64_t(id));
+        }
+      }
+      featureId.featureCount = int64_t(unique.size());
+    }
+  }
+
+  merged.extras.emplace(MergedPrimitivesExtra, std::move(ranges));
+
+  return merged;
+}
+
+} // namespace
+
+void mergePrimitives(Model& model) {
+  // The merged primitives are added to a new node at the root of the scene
+  // that is shown, so this needs a scene.
+  if (model.scenes.empty()) {
+    return;
+  }
+  const int32_t sceneIndex =
+      model.scene >= 0 && size_t(model.scene) < model.scenes.size()
+          ? model.scene
+          : 0;
+
+  // A mesh that's used by more than one node can't be merged into either.
+  std::unordered_map<const Mesh*, int32_t> meshUses;
+  model.forEachPrimitiveInScene(
+      sceneIndex,
+      [&meshUses](
+          Model&,
+          Node&,
+          Mesh& mesh,
+          MeshPrimitive& primitive,
+          const glm::dmat4&) {
+        if (&primitive == &mesh.primitives.front()) {
+          ++meshUses[&mesh];
+        }
+      });
+
+  // Ordered by key, so that the merged primitives are created in the same
+  // order every time.
+  std::map<std::string, std::vector<SourcePrimitive>> groups;
+  model.forEachPrimitiveInScene(
+      sceneIndex,
+      [&meshUses, &groups](
+          Model& gltf,
+          Node& node,
+          Mesh& mesh,
+          MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        if (meshUses[&mesh] != 1) {
+          return;
+        }
+        const std::string key = getMergeKey(gltf, node, primitive);
+        if (key.empty()) {
+          return;
+        }
+        groups[key].push_back(SourcePrimitive{
+            int32_t(&mesh - gltf.meshes.data()),
+            int32_t(&primitive - mesh.primitives.data()),
+            transform});
+      });
+
+  std::vector<MeshPrimitive> mergedPrimitives;
+  std::unordered_map<int32_t, std::vector<int32_t>> primitivesToRemove;
+  for (const auto& group : groups) {
+    const std::vector<SourcePrimitive>& sources = group.second;
+    if (sources.size() < 2) {
+      continue;
+    }
+
+    mergedPrimitives.emplace_back(mergeGroup(model, sources));
+    for (const SourcePrimitive& source : sources) {
+      primitivesToRemove[source.meshIndex].push_back(source.primitiveIndex);
+    }
+  }
+
+  if (mergedPrimitives.empty()) {
+    return;
+  }
+
+  for (auto& meshPrimitives : primitivesToRemove) {
+    std::vector<MeshPrimitive>& primitives =
+        model.meshes[meshPrimitives.first].primitives;
+    std::vector<int32_t>& indices = meshPrimitives.second;
+    std::sort(indices.begin(), indices.end(), std::greater<int32_t>());
+
+    for (size_t i = 0; i < primitives.size(); ++i) {
+      if (std::find(indices.begin(), indices.end(), int32_t(i)) ==
+          indices.end()) {
+        primitives[i].extras[SourcePrimitiveIndexExtra] = int64_t(i);
+      }
+    }
+
+    for (int32_t index : indices) {
+      primitives.erase(primitives.begin() + index);
+    }
+  }
+
+  Mesh& mergedMesh = model.meshes.emplace_back();
+  mergedMesh.name = "Merged";
+  mergedMesh.primitives = std::move(mergedPrimitives);
+
+  Node& mergedNode = model.nodes.emplace_back();
+  mergedNode.mesh = int32_t(model.meshes.size() - 1);
+  model.scenes[sceneIndex].nodes.push_back(int32_t(model.nodes.size() - 1));
+}
+
+bool isMergedPrimitive(const MeshPrimitive& primitive) {
+  return primitive.extras.find(MergedPrimitivesExtra) != primitive.extras.end();
+}
+
+bool findSourcePrimitive(
+    const MeshPrimitive& primitive,
+    int64_t faceIndex,
+    int64_t& meshIndex,
+    int64_t& primitiveIndex) {
+  auto extraIt = primitive.extras.find(MergedPrimitivesExtra);
+  if (extraIt == primitive.extras.end() || !extraIt->second.isArray() ||
+      faceIndex < 0) {
+    return false;
+  }
+
+  const auto getFirstFace = [](const JsonValue& range) {
+    return range.isArray() && range.getArray().size() >= 3
+               ? range.getArray()[2].getSafeNumberOrDefault<int64_t>(-1)
+               : int64_t(-1);
+  };
+
+  // The ranges are in the order of their first faces.
+  const JsonValue::Array& ranges = extraIt->second.getArray();
+  auto rangeIt = std::upper_bound(
+      ranges.begin(),
+      ranges.end(),
+      faceIndex,
+      [&getFirstFace](int64_t face, const JsonValue& range) {
+        return face < getFirstFace(range);
+      });
+  if (rangeIt == ranges.begin()) {
+    return false;
+  }
+  --rangeIt;
+  if (getFirstFace(*rangeIt) < 0) {
+    return false;
+  }
+
+  const JsonValue::Array& range = rangeIt->getArray();
+  meshIndex = range[0].getSafeNumberOrDefault<int64_t>(-1);
+  primitiveIndex = range[1].getSafeNumberOrDefault<int64_t>(-1);
+  return meshIndex >= 0 && primitiveIndex >= 0;
+}
+
+int64_t getSourcePrimitiveIndex(
+    const MeshPrimitive& primitive,
+    int64_t primitiveIndex) {
+  auto extraIt = primitive.extras.find(SourcePrimitiveIndexExtra);
+  if (extraIt == primitive.extras.end()) {
+    return primitiveIndex;
+  }
+  return extraIt->second.getSafeNumberOrDefault<int64_t>(primitiveIndex);
+}
+
+} // namespace CesiumPrimitiveMerging
@@ -0,0 +1,72 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <cstdint>
+
+namespace CesiumGltf {
+struct MeshPrimitive;
+struct Model;
+} // namespace CesiumGltf
+
+namespace CesiumPrimitiveMerging {
+
+/**
+ * Merges the triangle primitives of a glTF's scene that can be drawn as one,
+ * so that a tile made of many small primitives with the same material is
+ * drawn with a few draw calls instead of one for each primitive.
+ *
+ * Primitives are merged if they have the same material, the same float
+ * positions, normals, and texture coordinates, and the same feature ID
+ * attributes, and aren't instanced, skinned, or morphed. The transforms of
+ * their nodes are applied to their vertices, and the merged primitive is
+ * added to a new node at the root of the scene. The feature IDs of merged
+ * primitives are kept, so their metadata can still be picked, and the
+ * primitives that each merged primitive was made from can be found with
+ * findSourcePrimitive.
+ *
+ * The original primitives are removed from their meshes. Their accessors and
+ * buffers are left in the glTF, since they may be shared with other data. The
+ * primitives left in those meshes remember their original indices, which can
+ * be found with getSourcePrimitiveIndex.
+ *
+ * @param model The glTF to merge the primitives of.
+ */
+void mergePrimitives(CesiumGltf::Model& model);
+
+/**
+ * Determines whether a primitive was created by mergePrimitives.
+ */
+bool isMergedPrimitive(const CesiumGltf::MeshPrimitive& primitive);
+
+/**
+ * Finds the original primitive that a face of a primitive created by
+ * mergePrimitives came from.
+ *
+ * @param primitive The merged primitive.
+ * @param faceIndex The index of the face in the merged primitive.
+ * @param meshIndex The index of the original primitive's mesh.
+ * @param primitiveIndex The index of the original primitive in its mesh,
+ * before the merged primitives were removed from it.
+ * @return False if the primitive wasn't created by mergePrimitives, or the
+ * face isn't in it.
+ */
+bool findSourcePrimitive(
+    const CesiumGltf::MeshPrimitive& primitive,
+    int64_t faceIndex,
+    int64_t& meshIndex,
+    int64_t& primitiveIndex);
+
+/**
+ * Gets the index that a primitive that wasn't merged by mergePrimitives had
+ * in its mesh before the merged primitives were removed from it.
+ *
+ * @param primitive The primitive.
+ * @param primitiveIndex The index of the primitive in its mesh now.
+ * @return The index of the primitive in its mesh before it was merged.
+ */
+int64_t getSourcePrimitiveIndex(
+    const CesiumGltf::MeshPrimitive& primitive,
+    int64_t primitiveIndex);
+
+} // namespace CesiumPrimitiveMerging
@@ -7,6 +7,19 @@ using namespace CesiumGltf;
 
 static FCesiumPropertyTableProperty EmptyPropertyTableProperty;
 
+template <typename T>
+static TArray<T> getColumnAsArray(
+    const FCesiumPropertyTableProperty& Property,
+    const T& DefaultValue) {
+  TCesiumPropertyColumn<T> column(Property);
+
+  TArray<T> values;
+  values.SetNumUninitialized(
+      static_cast<int32>(FMath::Min<int64>(column.Num(), MAX_int32)));
+  column.GetValues(0, values, DefaultValue);
+  return values;
+}
+
 FCesiumPropertyTable::FCesiumPropertyTable(
     const Model& Model,
     const PropertyTable& PropertyTable)
@@ -110,6 +123,184 @@ UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeature(
   return values;
 }
 
+/*static*/ TArray<int32>
+UCesiumPropertyTableBlueprintLibrary::GetColumnAsIntegerArray(
+    UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+    const FString& PropertyName,
+    int32 DefaultValue) {
+  return getColumnAsArray<int32>(
+      FindProperty(PropertyTable, PropertyName),
+      DefaultValue);
+}
+
+/*static*/ TArray<int64>
+UCesiumPropertyTableBlueprintLibrary::GetColumnAsInteger64Array(
+    UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+    const FString& PropertyName,
+    int64 DefaultValue) {
+  return getColumnAsArray<int64>(
+      FindProperty(PropertyTable, PropertyName),
+      DefaultValue);
+}
+
+/*static*/ TArray<float>
+UCesiumPropertyTableBlueprintLibrary::GetColumnAsFloatArray(
+    UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+    const FString& PropertyName,
+    float DefaultValue) {
+  return getColumnAsArray<float>(
+      FindProperty(PropertyTable, PropertyName),
+      DefaultValue);
+}
+
+/*static*/ TArray<double>
+UCesiumPropertyTableBlueprintLibrary::GetColumnAsFloat64Array(
+    UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+    const FString& PropertyName,
+    double DefaultValue) {
+  return getColumnAsArray<double>(
+      FindProperty(PropertyTable, PropertyName),
+      DefaultValue);
+}
+
+/*static*/ int32 UCesiumPropertyTableBlueprintLibrary::FindPropertyIndex(
+    const FCesiumPropertyTable& PropertyTable,
+    const FString& PropertyName) {
+  int32 index = 0;
+  for (const auto& pair : PropertyTable._properties) {
+    if (pair.Key == PropertyName) {
+      return index;
+    }
+    ++index;
+  }
+
+  return INDEX_NONE;
+}
+
+/*static*/ void UCesiumPropertyTableBlueprintLibrary::GetValueRefsForFeature(
+    const FCesiumPropertyTable& PropertyTable,
+    int64 FeatureID,
+    TArray<FCesiumPropertyTableValueRef>& OutValues) {
+  OutValues.Reset();
+  if (PropertyTable._status != ECesiumPropertyTableStatus::Valid ||
+      FeatureID < 0 || FeatureID >= PropertyTable._count) {
+    return;
+  }
+
+  OutValues.Reserve(PropertyTable._properties.Num());
+  for (const auto& pair : PropertyTable._properties) {
+    OutValues.Emplace(pair.Value, FeatureID);
+  }
+}
+
+bool FCesiumPropertyTableValueRef::HasValue() const {
+  if (!this->_pProperty) {
+    return false;
+  }
+
+  const ECesiumPropertyTablePropertyStatus status =
+      UCesiumPropertyTablePropertyBlueprintLibrary::
+          GetPropertyTablePropertyStatus(*this->_pProperty);
+  return status == ECesiumPropertyTablePropertyStatus::Valid ||
+         status == ECesiumPropertyTablePropertyStatus::EmptyPropertyWithDefault;
+}
+
+bool FCesiumPropertyTableValueRef::GetBoolean(bool DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetBoolean(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+uint8 FCesiumPropertyTableValueRef::GetByte(uint8 DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetByte(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+int32 FCesiumPropertyTableValueRef::GetInteger(int32 DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetInteger(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+int64 FCesiumPropertyTableValueRef::GetInteger64(int64 DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetInteger64(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+float FCesiumPropertyTableValueRef::GetFloat(float DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+double FCesiumPropertyTableValueRef::GetFloat64(double DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+FVector
+FCesiumPropertyTableValueRef::GetVector(const FVector& DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetVector(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+FString
+FCesiumPropertyTableValueRef::GetString(const FString& DefaultValue) const {
+  return this->_pProperty
+             ? UCesiumPropertyTablePropertyBlueprintLibrary::GetString(
+                   *this->_pProperty,
+                   this->_featureID,
+                   DefaultValue)
+             : DefaultValue;
+}
+
+FCesiumMetadataValue FCesiumPropertyTableValueRef::GetValue() const {
+  if (!this->_pProperty) {
+    return FCesiumMetadataValue();
+  }
+
+  const ECesiumPropertyTablePropertyStatus status =
+      UCesiumPropertyTablePropertyBlueprintLibrary::
+          GetPropertyTablePropertyStatus(*this->_pProperty);
+  if (status == ECesiumPropertyTablePropertyStatus::Valid) {
+    return UCesiumPropertyTablePropertyBlueprintLibrary::GetValue(
+        *this->_pProperty,
+        this->_featureID);
+  }
+
+  if (status == ECesiumPropertyTablePropertyStatus::EmptyPropertyWithDefault) {
+    return UCesiumPropertyTablePropertyBlueprintLibrary::GetDefaultValue(
+        *this->_pProperty);
+  }
+
+  return FCesiumMetadataValue();
+}
+
 /*static*/ TMap<FString, FString>
 UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeatureAsStrings(
     UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
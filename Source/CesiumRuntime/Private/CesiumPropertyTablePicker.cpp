@@ -0,0 +1,182 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPropertyTablePicker.h"
+#include "CesiumFeatureIdSet.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumModelMetadata.h"
+#include "CesiumPrimitiveFeatures.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumPropertyTableProperty.h"
+#include "Engine/HitResult.h"
+
+FCesiumPropertyTablePicker::FCesiumPropertyTablePicker(
+    const TArray<FString>& PropertyNames,
+    int64 FeatureIDSetIndex)
+    : _propertyNames(PropertyNames), _featureIDSetIndex(FeatureIDSetIndex) {}
+
+int64 FCesiumPropertyTablePicker::GetFeatureIDFromHit(
+    const FHitResult& Hit) const {
+  const UCesiumGltfPrimitiveComponent* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
+  if (!IsValid(pGltfComponent)) {
+    return -1;
+  }
+
+  return UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromHit(
+      pGltfComponent->Features,
+      Hit,
+      this->_featureIDSetIndex);
+}
+
+FCesiumMetadataValue FCesiumPropertyTablePicker::GetValueFromHit(
+    const FHitResult& Hit,
+    int32 Handle) {
+  if (!this->_propertyNames.IsValidIndex(Handle)) {
+    return FCesiumMetadataValue();
+  }
+
+  const UCesiumGltfPrimitiveComponent* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
+  if (!IsValid(pGltfComponent)) {
+    return FCesiumMetadataValue();
+  }
+
+  const ResolvedPrimitive* pResolved = this->findOrResolve(*pGltfComponent);
+  if (!pResolved || !pResolved->hasPropertyTable) {
+    return FCesiumMetadataValue();
+  }
+
+  const ResolvedProperty& property = pResolved->properties[Handle];
+  if (!property.pProperty) {
+    return FCesiumMetadataValue();
+  }
+
+  if (property.useDefaultValue) {
+    return UCesiumPropertyTablePropertyBlueprintLibrary::GetDefaultValue(
+        *property.pProperty);
+  }
+
+  const int64 featureID = this->GetFeatureIDFromHit(Hit);
+  if (featureID < 0) {
+    return FCesiumMetadataValue();
+  }
+
+  return UCesiumPropertyTablePropertyBlueprintLibrary::GetValue(
+      *property.pProperty,
+      featureID);
+}
+
+bool FCesiumPropertyTablePicker::GetValuesFromHit(
+    const FHitResult& Hit,
+    TArrayView<FCesiumMetadataValue> Values) {
+  check(Values.Num() == this->_propertyNames.Num());
+
+  for (FCesiumMetadataValue& value : Values) {
+    value = FCesiumMetadataValue();
+  }
+
+  const UCesiumGltfPrimitiveComponent* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
+  if (!IsValid(pGltfComponent)) {
+    return false;
+  }
+
+  const ResolvedPrimitive* pResolved = this->findOrResolve(*pGltfComponent);
+  if (!pResolved || !pResolved->hasPropertyTable) {
+    return false;
+  }
+
+  const int64 featureID = this->GetFeatureIDFromHit(Hit);
+  if (featureID < 0) {
+    return false;
+  }
+
+  for (int32 i = 0; i < Values.Num(); i++) {
+    const ResolvedProperty& property = pResolved->properties[i];
+    if (!property.pProperty) {
+      continue;
+    }
+
+    Values[i] =
+        property.useDefaultValue
+            ? UCesiumPropertyTablePropertyBlueprintLibrary::GetDefaultValue(
+                  *property.pProperty)
+            : UCesiumPropertyTablePropertyBlueprintLibrary::GetValue(
+                  *property.pProperty,
+                  featureID);
+  }
+
+  return true;
+}
+
+void FCesiumPropertyTablePicker::Reset() { this->_primitives.Reset(); }
+
+const FCesiumPropertyTablePicker::ResolvedPrimitive*
+FCesiumPropertyTablePicker::findOrResolve(
+    const UCesiumGltfPrimitiveComponent& primitive) {
+  TWeakObjectPtr<const UCesiumGltfPrimitiveComponent> pPrimitive(&primitive);
+  if (const ResolvedPrimitive* pResolved = this->_primitives.Find(pPrimitive)) {
+    return pResolved;
+  }
+
+  const UCesiumGltfComponent* pModel =
+      Cast<UCesiumGltfComponent>(primitive.GetOuter());
+  if (!IsValid(pModel)) {
+    return nullptr;
+  }
+
+  if (this->_primitives.Num() >= this->_pruneThreshold) {
+    for (auto it = this->_primitives.CreateIterator(); it; ++it) {
+      if (!it.Key().IsValid()) {
+        it.RemoveCurrent();
+      }
+    }
+    this->_pruneThreshold =
+        FMath::Max(this->_pruneThreshold, 2 * this->_primitives.Num());
+  }
+
+  ResolvedPrimitive& resolved = this->_primitives.Add(pPrimitive);
+
+  const TArray<FCesiumFeatureIdSet>& featureIDSets =
+      UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(
+          primitive.Features);
+  if (this->_featureIDSetIndex < 0 ||
+      this->_featureIDSetIndex >= featureIDSets.Num()) {
+    return &resolved;
+  }
+
+  const int64 propertyTableIndex =
+      UCesiumFeatureIdSetBlueprintLibrary::GetPropertyTableIndex(
+          featureIDSets[this->_featureIDSetIndex]);
+  const TArray<FCesiumPropertyTable>& propertyTables =
+      UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(pModel->Metadata);
+  if (propertyTableIndex < 0 || propertyTableIndex >= propertyTables.Num()) {
+    return &resolved;
+  }
+
+  const TMap<FString, FCesiumPropertyTableProperty>& properties =
+      UCesiumPropertyTableBlueprintLibrary::GetProperties(
+          propertyTables[propertyTableIndex]);
+
+  resolved.hasPropertyTable = true;
+  resolved.properties.Reserve(this->_propertyNames.Num());
+  for (const FString& name : this->_propertyNames) {
+    const FCesiumPropertyTableProperty* pProperty = properties.Find(name);
+    const ECesiumPropertyTablePropertyStatus status =
+        pProperty ? UCesiumPropertyTablePropertyBlueprintLibrary::
+                        GetPropertyTablePropertyStatus(*pProperty)
+                  : ECesiumPropertyTablePropertyStatus::ErrorInvalidProperty;
+    if (status == ECesiumPropertyTablePropertyStatus::Valid) {
+      resolved.properties.Add({pProperty, false});
+    } else if (
+        status ==
+        ECesiumPropertyTablePropertyStatus::EmptyPropertyWithDefault) {
+      resolved.properties.Add({pProperty, true});
+    } else {
+      resolved.properties.Add({nullptr, false});
+    }
+  }
+
+  return &resolved;
+}
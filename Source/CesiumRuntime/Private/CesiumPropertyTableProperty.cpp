@@ -3,6 +3,7 @@
 #include "CesiumPropertyTableProperty.h"
 #include "CesiumGltf/PropertyTypeTraits.h"
 #include "CesiumMetadataConversions.h"
+#include <type_traits>
 #include <utility>
 
 using namespace CesiumGltf;
@@ -829,8 +830,189 @@ TResult propertyTablePropertyCallback(
   }
 }
 
+/**
+ * Gets a value from a PropertyTablePropertyView and converts it to TTo, the
+ * same way that the UCesiumPropertyTablePropertyBlueprintLibrary functions do.
+ */
+template <typename TTo, typename TView>
+TTo getColumnValue(
+    const TView& view,
+    int64 size,
+    int64 featureID,
+    const TTo& defaultValue) {
+  if (featureID < 0 || featureID >= size) {
+    return defaultValue;
+  }
+  auto maybeValue = view.get(featureID);
+  if (maybeValue) {
+    auto value = *maybeValue;
+    return CesiumMetadataConversions<TTo, decltype(value)>::convert(
+        value,
+        defaultValue);
+  }
+  return defaultValue;
+}
+
+template <typename TTo, typename TView>
+void readColumnRange(
+    const void* pView,
+    int64 firstFeatureID,
+    TArrayView<TTo> outValues,
+    const TTo& defaultValue) {
+  const TView& view = *static_cast<const TView*>(pView);
+  const int64 size = view.size();
+  for (int32 i = 0; i < outValues.Num(); ++i) {
+    outValues[i] =
+        getColumnValue<TTo>(view, size, firstFeatureID + i, defaultValue);
+  }
+}
+
+template <typename TTo, typename TView>
+void readColumnIndexed(
+    const void* pView,
+    TArrayView<const int64> featureIDs,
+    TArrayView<TTo> outValues,
+    const TTo& defaultValue) {
+  const TView& view = *static_cast<const TView*>(pView);
+  const int64 size = view.size();
+  for (int32 i = 0; i < outValues.Num(); ++i) {
+    outValues[i] = getColumnValue<TTo>(view, size, featureIDs[i], defaultValue);
+  }
+}
+
+template <typename TTo, typename TView>
+void readRawColumnRange(
+    const void* pView,
+    int64 firstFeatureID,
+    TArrayView<TTo> outValues,
+    const TTo& defaultValue) {
+  const TView& view = *static_cast<const TView*>(pView);
+  const int64 size = view.size();
+
+  // An empty property has no raw values, only a default value.
+  const bool isEmpty =
+      view.status() ==
+      PropertyTablePropertyViewStatus::EmptyPropertyWithDefault;
+  for (int32 i = 0; i < outValues.Num(); ++i) {
+    const int64 featureID = firstFeatureID + i;
+    if (isEmpty || featureID < 0 || featureID >= size) {
+      outValues[i] = defaultValue;
+      continue;
+    }
+    auto value = view.getRaw(featureID);
+    outValues[i] = CesiumMetadataConversions<TTo, decltype(value)>::convert(
+        value,
+        defaultValue);
+  }
+}
+
 } // namespace
 
+template <typename T>
+TCesiumPropertyColumn<T>::TCesiumPropertyColumn(
+    const FCesiumPropertyTableProperty& Property)
+    : _pView(nullptr),
+      _size(0),
+      _readRange(nullptr),
+      _readIndexed(nullptr),
+      _readRawRange(nullptr) {
+  propertyTablePropertyCallback<void>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      [this](const auto& view) {
+        // size() returns zero if the view is invalid. The callback may also be
+        // given a temporary invalid view, which mustn't be kept.
+        if (view.size() <= 0) {
+          return;
+        }
+
+        using TView = std::decay_t<decltype(view)>;
+        this->_pView = &view;
+        this->_size = view.size();
+        this->_readRange = &readColumnRange<T, TView>;
+        this->_readIndexed = &readColumnIndexed<T, TView>;
+        this->_readRawRange = &readRawColumnRange<T, TView>;
+      });
+}
+
+template <typename T>
+T TCesiumPropertyColumn<T>::Get(int64 FeatureID, const T& DefaultValue) const {
+  if (!this->_pView) {
+    return DefaultValue;
+  }
+
+  T value;
+  this->_readRange(
+      this->_pView,
+      FeatureID,
+      TArrayView<T>(&value, 1),
+      DefaultValue);
+  return value;
+}
+
+template <typename T>
+void TCesiumPropertyColumn<T>::GetValues(
+    int64 FirstFeatureID,
+    TArrayView<T> OutValues,
+    const T& DefaultValue) const {
+  if (!this->_pView) {
+    for (T& value : OutValues) {
+      value = DefaultValue;
+    }
+    return;
+  }
+
+  this->_readRange(this->_pView, FirstFeatureID, OutValues, DefaultValue);
+}
+
+template <typename T>
+void TCesiumPropertyColumn<T>::GetValues(
+    TArrayView<const int64> FeatureIDs,
+    TArrayView<T> OutValues,
+    const T& DefaultValue) const {
+  check(FeatureIDs.Num() == OutValues.Num());
+
+  if (!this->_pView) {
+    for (T& value : OutValues) {
+      value = DefaultValue;
+    }
+    return;
+  }
+
+  this->_readIndexed(this->_pView, FeatureIDs, OutValues, DefaultValue);
+}
+
+template <typename T>
+void TCesiumPropertyColumn<T>::GetRawValues(
+    int64 FirstFeatureID,
+    TArrayView<T> OutValues,
+    const T& DefaultValue) const {
+  if (!this->_pView) {
+    for (T& value : OutValues) {
+      value = DefaultValue;
+    }
+    return;
+  }
+
+  this->_readRawRange(this->_pView, FirstFeatureID, OutValues, DefaultValue);
+}
+
+template class TCesiumPropertyColumn<bool>;
+template class TCesiumPropertyColumn<uint8>;
+template class TCesiumPropertyColumn<int32>;
+template class TCesiumPropertyColumn<int64>;
+template class TCesiumPropertyColumn<float>;
+template class TCesiumPropertyColumn<double>;
+template class TCesiumPropertyColumn<FIntPoint>;
+template class TCesiumPropertyColumn<FVector2D>;
+template class TCesiumPropertyColumn<FIntVector>;
+template class TCesiumPropertyColumn<FVector3f>;
+template class TCesiumPropertyColumn<FVector>;
+template class TCesiumPropertyColumn<FVector4>;
+template class TCesiumPropertyColumn<FMatrix>;
+template class TCesiumPropertyColumn<FString>;
+
 ECesiumPropertyTablePropertyStatus
 UCesiumPropertyTablePropertyBlueprintLibrary::GetPropertyTablePropertyStatus(
     UPARAM(ref) const FCesiumPropertyTableProperty& Property) {
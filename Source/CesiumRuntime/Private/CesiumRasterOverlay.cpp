@@ -5,14 +5,16 @@
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "Cesium3DTileset.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumBandwidthLimiter.h"
 #include "CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h"
 #include "CesiumRuntime.h"
+#include "CesiumScalability.h"
 
 FCesiumRasterOverlayLoadFailure OnCesiumRasterOverlayLoadFailure{};
 
 // Sets default values for this component's properties
 UCesiumRasterOverlay::UCesiumRasterOverlay()
-    : _pOverlay(nullptr), _overlaysBeingDestroyed(0) {
+    : _pOverlay(nullptr), _overlaysBeingDestroyed(0), _bandwidthStream(0) {
   this->bAutoActivate = true;
 
   // Set this component to be initialized when the game starts, and to be ticked
@@ -43,10 +45,18 @@ void UCesiumRasterOverlay::AddToTileset() {
     return;
   }
 
+  // Overlays are only draped over tiles that are drawn.
+  ACesium3DTileset* pActor = this->GetOwner<ACesium3DTileset>();
+  if (pActor && pActor->IsCollisionOnly()) {
+    return;
+  }
+
   CesiumRasterOverlays::RasterOverlayOptions options{};
   options.maximumScreenSpaceError = this->MaximumScreenSpaceError;
   options.maximumSimultaneousTileLoads = this->MaximumSimultaneousTileLoads;
-  options.maximumTextureSize = this->MaximumTextureSize;
+  options.maximumTextureSize = CesiumScalability::limitTextureSize(
+      CesiumScalability::getTextureTier(),
+      this->MaximumTextureSize);
   options.subTileCacheBytes = this->SubTileCacheBytes;
   options.showCreditsOnScreen = this->ShowCreditsOnScreen;
   options.rendererOptions = &this->rendererOptions;
@@ -95,9 +105,21 @@ void UCesiumRasterOverlay::AddToTileset() {
   if (pOverlay) {
     this->_pOverlay = pOverlay.release();
 
+    // The stream must be assigned before the overlay is added, which creates
+    // its tile provider.
+    this->_bandwidthStream = CesiumBandwidthLimiter::get().createStream(
+        this->RequestPriority,
+        this->BandwidthShare);
+    CesiumBandwidthLimiter::get().setOverlayStream(
+        this->_pOverlay,
+        this->_bandwidthStream);
+
     pTileset->getOverlays().add(this->_pOverlay);
 
     this->OnAdd(pTileset, this->_pOverlay);
+
+    // The new overlay is only mapped to tiles by a view update.
+    this->GetOwner<ACesium3DTileset>()->InvalidateView();
   }
 }
 
@@ -121,7 +143,12 @@ void UCesiumRasterOverlay::RemoveFromTileset() {
 
   this->OnRemove(pTileset, this->_pOverlay);
   pTileset->getOverlays().remove(this->_pOverlay);
+  CesiumBandwidthLimiter::get().setOverlayStream(this->_pOverlay, 0);
+  CesiumBandwidthLimiter::get().releaseStream(this->_bandwidthStream);
+  this->_bandwidthStream = 0;
   this->_pOverlay = nullptr;
+
+  this->GetOwner<ACesium3DTileset>()->InvalidateView();
 }
 
 void UCesiumRasterOverlay::Refresh() {
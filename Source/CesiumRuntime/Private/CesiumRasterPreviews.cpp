@@ -0,0 +1,197 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumRasterPreviews.h"
+#include "CesiumGltf/ImageCesium.h"
+#include "CesiumMainThreadDispatcher.h"
+#include "CesiumRasterOverlay.h"
+#include "CesiumRuntime.h"
+#include "CesiumTextureUtility.h"
+#include "Containers/Map.h"
+#include "Engine/Texture2D.h"
+#include <mutex>
+#include <unordered_map>
+
+using namespace CesiumGltf;
+using namespace CesiumTextureUtility;
+
+namespace {
+
+struct DeferredImage {
+  ImageCesium image;
+  FRasterOverlayRendererOptions options;
+};
+
+// Full images waiting for their previews to be created on the game thread.
+// Previews are prepared in load threads, so this is shared between threads.
+std::mutex deferredMutex;
+std::unordered_map<const LoadedTextureResult*, DeferredImage> deferredImages;
+
+std::optional<DeferredImage> takeDeferred(const LoadedTextureResult* pPreview) {
+  std::lock_guard<std::mutex> lock(deferredMutex);
+  auto it = deferredImages.find(pPreview);
+  if (it == deferredImages.end()) {
+    return std::nullopt;
+  }
+  std::optional<DeferredImage> result = std::move(it->second);
+  deferredImages.erase(it);
+  return result;
+}
+
+// The full image load in progress for each preview texture, so that a load
+// finishing after its tile was freed, possibly after the texture has been
+// reused for another tile, is discarded. Only used on the game thread.
+TMap<UTexture2D*, uint64> loadsInProgress;
+uint64 lastLoad = 0;
+
+} // namespace
+
+namespace CesiumRasterPreviews {
+
+std::optional<ImageCesium> createPreview(const ImageCesium& image) {
+  const int32_t largest = std::max(image.width, image.height);
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      image.bytesPerChannel != 1 || image.channels < 1 || image.channels > 4 ||
+      largest <= 2 * MaximumPreviewSize) {
+    return std::nullopt;
+  }
+
+  const int64_t channels = image.channels;
+  const int64_t sourceRowBytes = int64_t(image.width) * channels;
+  if (int64_t(image.pixelData.size()) < sourceRowBytes * image.height) {
+    return std::nullopt;
+  }
+
+  int32_t factor = 2;
+  while (largest > factor * MaximumPreviewSize) {
+    factor *= 2;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateRasterPreview)
+
+  ImageCesium preview;
+  preview.width = (image.width + factor - 1) / factor;
+  preview.height = (image.height + factor - 1) / factor;
+  preview.channels = image.channels;
+  preview.bytesPerChannel = 1;
+  preview.pixelData.resize(
+      size_t(int64_t(preview.width) * preview.height * channels));
+
+  const uint8_t* pSource =
+      reinterpret_cast<const uint8_t*>(image.pixelData.data());
+  uint8_t* pDestination = reinterpret_cast<uint8_t*>(preview.pixelData.data());
+
+  // Each preview pixel is the average of the block of source pixels it
+  // covers. Blocks at the right and bottom edges may be cut off.
+  uint32_t sums[4];
+  for (int32_t y = 0; y < preview.height; ++y) {
+    const int32_t top = y * factor;
+    const int32_t bottom = std::min(top + factor, image.height);
+    for (int32_t x = 0; x < preview.width; ++x) {
+      const int32_t left = x * factor;
+      const int32_t right = std::min(left + factor, image.width);
+
+      std::fill(sums, sums + 4, 0u);
+      for (int32_t sourceY = top; sourceY < bottom; ++sourceY) {
+        const uint8_t* pRow =
+            pSource + sourceY * sourceRowBytes + left * channels;
+        for (int32_t sourceX = left; sourceX < right; ++sourceX) {
+          for (int64_t c = 0; c < channels; ++c) {
+            sums[c] += *pRow++;
+          }
+        }
+      }
+
+      const uint32_t count = uint32_t((bottom - top) * (right - left));
+      for (int64_t c = 0; c < channels; ++c) {
+        *pDestination++ = uint8_t((sums[c] + count / 2) / count);
+      }
+    }
+  }
+
+  return preview;
+}
+
+void deferFullImage(
+    const LoadedTextureResult* pPreview,
+    ImageCesium&& image,
+    const FRasterOverlayRendererOptions& options) {
+  if (!pPreview) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(deferredMutex);
+  deferredImages.insert_or_assign(
+      pPreview,
+      DeferredImage{std::move(image), options});
+}
+
+void loadFullImage(
+    const LoadedTextureResult* pPreview,
+    UTexture2D* pTexture,
+    TFunction<void(UTexture2D*)>&& onReplaced) {
+  check(IsInGameThread());
+
+  std::optional<DeferredImage> maybeDeferred = takeDeferred(pPreview);
+  if (!maybeDeferred || !pTexture) {
+    return;
+  }
+
+  const uint64 load = ++lastLoad;
+  loadsInProgress.Add(pTexture, load);
+
+  getAsyncSystem()
+      .runInWorkerThread([deferred = std::move(*maybeDeferred)]() mutable {
+        const FRasterOverlayRendererOptions& options = deferred.options;
+        return loadTextureAnyThreadPart(
+                   EmbeddedImageSource{std::move(deferred.image)},
+                   TextureAddress::TA_Clamp,
+                   TextureAddress::TA_Clamp,
+                   options.filter,
+                   options.group,
+                   options.useMipmaps,
+                   true,
+                   options.compressTextures)
+            .Release();
+      })
+      .thenInMainThread([pTexture, load, onReplaced = std::move(onReplaced)](
+                            LoadedTextureResult* pLoadedTexture) mutable {
+        // Replacing the preview only sharpens the overlay, so it waits for a
+        // frame with time to spare.
+        CesiumMainThreadDispatcher::get().post(
+            CesiumMainThreadDispatcher::Priority::Normal,
+            [pTexture,
+             load,
+             onReplaced = std::move(onReplaced),
+             pLoadedTexture]() {
+              TUniquePtr<LoadedTextureResult> pFull{pLoadedTexture};
+
+              const uint64* pLoad = loadsInProgress.Find(pTexture);
+              if (!pLoad || *pLoad != load) {
+                if (pFull) {
+                  destroyHalfLoadedTexture(*pFull);
+                }
+                return;
+              }
+              loadsInProgress.Remove(pTexture);
+
+              if (replaceTextureImage(pTexture, std::move(pFull))) {
+                onReplaced(pTexture);
+              } else if (pFull) {
+                destroyHalfLoadedTexture(*pFull);
+              }
+            });
+      });
+}
+
+void cancel(const LoadedTextureResult* pPreview, UTexture2D* pTexture) {
+  check(IsInGameThread());
+
+  if (pPreview) {
+    takeDeferred(pPreview);
+  }
+  if (pTexture) {
+    loadsInProgress.Remove(pTexture);
+  }
+}
+
+} // namespace CesiumRasterPreviews
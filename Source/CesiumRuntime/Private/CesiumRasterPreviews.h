@@ -0,0 +1,91 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Templates/Function.h"
+#include <optional>
+
+class UTexture2D;
+struct FRasterOverlayRendererOptions;
+
+namespace CesiumGltf {
+struct ImageCesium;
+} // namespace CesiumGltf
+
+namespace CesiumTextureUtility {
+struct LoadedTextureResult;
+} // namespace CesiumTextureUtility
+
+/**
+ * Low-resolution previews of raster overlay tiles, for overlays with
+ * FRasterOverlayRendererOptions::progressiveLoading enabled.
+ *
+ * A large overlay image takes a while to generate mips for, compress, and
+ * upload, and the tile can't show any of the overlay until it's done. With
+ * progressive loading, a downsampled copy of the image is prepared instead,
+ * which is quick, and the full image is kept aside. Once the preview texture
+ * has been created on the game thread, the full image is prepared in a worker
+ * thread and then swapped into the same texture with
+ * CesiumTextureUtility::replaceTextureImage, so the tiles it's attached to
+ * don't need to be updated.
+ */
+namespace CesiumRasterPreviews {
+
+/**
+ * The largest width or height of a preview.
+ */
+constexpr int32_t MaximumPreviewSize = 256;
+
+/**
+ * Downsamples an image by a power of two, averaging each block of pixels, so
+ * that neither of its dimensions is larger than MaximumPreviewSize. May be
+ * called from any thread.
+ *
+ * @return The preview, or std::nullopt if the image is compressed, doesn't
+ * have 8-bit channels, or is already small enough that a preview wouldn't load
+ * noticeably faster.
+ */
+std::optional<CesiumGltf::ImageCesium>
+createPreview(const CesiumGltf::ImageCesium& image);
+
+/**
+ * Keeps the full image of a raster overlay tile whose preview was prepared in
+ * a load thread, until the preview is created on the game thread. May be
+ * called from any thread.
+ *
+ * @param pPreview The result of loadTextureAnyThreadPart for the preview.
+ * @param image The full image.
+ * @param options The overlay's renderer options, to prepare the full image
+ * with.
+ */
+void deferFullImage(
+    const CesiumTextureUtility::LoadedTextureResult* pPreview,
+    CesiumGltf::ImageCesium&& image,
+    const FRasterOverlayRendererOptions& options);
+
+/**
+ * Starts preparing the full image that was deferred for a preview, if there
+ * is one, and replaces the image of the preview's texture with it once it's
+ * ready. Must be called from the game thread.
+ *
+ * @param pPreview The result of loadTextureAnyThreadPart for the preview.
+ * @param pTexture The texture that was created for the preview.
+ * @param onReplaced Called on the game thread after the texture's image has
+ * been replaced. It isn't called if the load is canceled first.
+ */
+void loadFullImage(
+    const CesiumTextureUtility::LoadedTextureResult* pPreview,
+    UTexture2D* pTexture,
+    TFunction<void(UTexture2D*)>&& onReplaced);
+
+/**
+ * Forgets the full image deferred for a preview and cancels replacing the
+ * image of its texture, for a raster overlay tile that is being freed. Either
+ * argument may be null. Must be called from the game thread, before the
+ * texture is released.
+ */
+void cancel(
+    const CesiumTextureUtility::LoadedTextureResult* pPreview,
+    UTexture2D* pTexture);
+
+} // namespace CesiumRasterPreviews
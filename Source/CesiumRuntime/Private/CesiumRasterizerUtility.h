@@ -0,0 +1,38 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGeometry/Rectangle.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Functions shared by the rasterizers that index their shapes in a
+ * grid of cells, such as CesiumPolygonRasterizer and CesiumVectorRasterizer.
+ */
+namespace CesiumRasterizerUtility {
+
+/**
+ * @brief Determines whether two rectangles overlap, including when they only
+ * touch at an edge or corner.
+ */
+inline bool overlaps(
+    const CesiumGeometry::Rectangle& a,
+    const CesiumGeometry::Rectangle& b) {
+  return a.minimumX <= b.maximumX && b.minimumX <= a.maximumX &&
+         a.minimumY <= b.maximumY && b.minimumY <= a.maximumY;
+}
+
+/**
+ * @brief Finds the cell that a value falls in, out of `count` cells of the
+ * given size starting at `minimum`. Values outside of the cells are clamped
+ * to the first or last cell.
+ */
+inline int32_t
+findCell(double value, double minimum, double cellSize, int32_t count) {
+  const double cell = std::floor((value - minimum) / cellSize);
+  return int32_t(std::clamp(cell, 0.0, double(count - 1)));
+}
+
+} // namespace CesiumRasterizerUtility
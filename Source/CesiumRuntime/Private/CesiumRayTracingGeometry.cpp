@@ -0,0 +1,88 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumRayTracingGeometry.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntime.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "RenderUtils.h"
+#include "RenderingThread.h"
+#include "StaticMeshResources.h"
+
+namespace CesiumRayTracingGeometry {
+
+bool canCreateRayTracingGeometry(
+    const UCesiumGltfPrimitiveComponent& primitive) {
+#if RHI_RAYTRACING
+  if (!IsRayTracingEnabled() || primitive.PulledAttributes ||
+      primitive.OwnedRenderData) {
+    return false;
+  }
+  const UStaticMesh* pMesh = primitive.GetStaticMesh();
+  const FStaticMeshRenderData* pRenderData =
+      pMesh ? pMesh->GetRenderData() : nullptr;
+  return pRenderData && !pMesh->bSupportRayTracing &&
+         pRenderData->IsInitialized() && !pRenderData->LODResources.IsEmpty();
+#else
+  return false;
+#endif
+}
+
+void createRayTracingGeometry(UCesiumGltfPrimitiveComponent& primitive) {
+#if RHI_RAYTRACING
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateRayTracingGeometry)
+
+  if (!canCreateRayTracingGeometry(primitive)) {
+    return;
+  }
+
+  // Scene proxies only draw into ray tracing scenes if their static mesh
+  // supports it, which they check when they're created.
+  UStaticMesh* pMesh = primitive.GetStaticMesh();
+  pMesh->bSupportRayTracing = true;
+
+  // This matches the ray tracing geometry that FStaticMeshLODResources
+  // creates when it's initialized, which happens before the existing scene
+  // proxies are replaced, since render commands run in order.
+  FStaticMeshLODResources* pLod = &pMesh->GetRenderData()->LODResources[0];
+  ENQUEUE_RENDER_COMMAND(CesiumCreateRayTracingGeometry)
+  ([pLod](FRHICommandListImmediate& RHICmdList) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitRayTracingGeometry)
+
+    const FPositionVertexBuffer& positions =
+        pLod->VertexBuffers.PositionVertexBuffer;
+
+    FRayTracingGeometryInitializer initializer;
+    initializer.DebugName = FName(TEXT("CesiumGltfPrimitive"));
+    initializer.IndexBuffer = pLod->IndexBuffer.IndexBufferRHI;
+    initializer.TotalPrimitiveCount = 0;
+    initializer.GeometryType = RTGT_Triangles;
+    initializer.bFastBuild = false;
+    initializer.bAllowUpdate = false;
+
+    for (const FStaticMeshSection& section : pLod->Sections) {
+      FRayTracingGeometrySegment segment;
+      segment.VertexBuffer = positions.VertexBufferRHI;
+      segment.VertexBufferElementType = VET_Float3;
+      segment.VertexBufferStride = positions.GetStride();
+      segment.VertexBufferOffset = 0;
+      segment.MaxVertices = positions.GetNumVertices();
+      segment.FirstPrimitive = section.FirstIndex / 3;
+      segment.NumPrimitives = section.NumTriangles;
+      segment.bEnabled = true;
+      initializer.Segments.Add(segment);
+      initializer.TotalPrimitiveCount += section.NumTriangles;
+    }
+
+    pLod->RayTracingGeometry.SetInitializer(initializer);
+    pLod->RayTracingGeometry.InitResource();
+  });
+
+  primitive.MarkRenderStateDirty();
+  if (primitive.InstancesComponent) {
+    primitive.InstancesComponent->MarkRenderStateDirty();
+  }
+#endif
+}
+
+} // namespace CesiumRayTracingGeometry
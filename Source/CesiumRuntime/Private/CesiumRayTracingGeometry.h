@@ -0,0 +1,25 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+class UCesiumGltfPrimitiveComponent;
+
+namespace CesiumRayTracingGeometry {
+/**
+ * @brief Determines whether ray tracing geometry can be created for the given
+ * primitive after it was loaded without any. Only primitives drawn from their
+ * static mesh by the engine's static mesh scene proxy are drawn into ray
+ * tracing scenes, and nothing is created when ray tracing isn't enabled.
+ */
+bool canCreateRayTracingGeometry(
+    const UCesiumGltfPrimitiveComponent& primitive);
+
+/**
+ * @brief Creates the ray tracing geometry of a primitive whose static mesh was
+ * initialized without any, which requests a build of its bottom-level
+ * acceleration structure, and recreates the render state of the primitive so
+ * that it's drawn into ray tracing scenes. Must be called from the game
+ * thread.
+ */
+void createRayTracingGeometry(UCesiumGltfPrimitiveComponent& primitive);
+} // namespace CesiumRayTracingGeometry
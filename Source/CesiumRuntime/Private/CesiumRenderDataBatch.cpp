@@ -0,0 +1,65 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumRenderDataBatch.h"
+#include "CesiumRuntime.h"
+#include "Engine/StaticMesh.h"
+#include "RenderingThread.h"
+#include "StaticMeshResources.h"
+#include "UObject/Package.h"
+
+CesiumRenderDataBatch::~CesiumRenderDataBatch() { this->flush(); }
+
+void CesiumRenderDataBatch::add(
+    const TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe>&
+        pRenderData) {
+  check(IsInGameThread());
+  if (pRenderData) {
+    this->_pending.Add(pRenderData);
+  }
+}
+
+void CesiumRenderDataBatch::flush() {
+  check(IsInGameThread());
+
+  if (this->_pending.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FlushRenderDataBatch)
+
+  UStaticMesh* pOwner = getRenderDataOwner();
+  const ERHIFeatureLevel::Type featureLevel = GMaxRHIFeatureLevel;
+
+  // The render data is released on the render thread when the last reference
+  // to it goes away, which may be this command's, so it's always initialized
+  // before it's released.
+  ENQUEUE_RENDER_COMMAND(CesiumInitPrimitiveRenderData)
+  ([pending = MoveTemp(this->_pending), pOwner, featureLevel](
+       FRHICommandListImmediate& RHICmdList) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitPrimitiveRenderData)
+    for (const TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe>&
+             pRenderData : pending) {
+      pRenderData->InitResources(featureLevel, pOwner);
+    }
+  });
+
+  this->_pending.Reset();
+}
+
+/*static*/ UStaticMesh* CesiumRenderDataBatch::getRenderDataOwner() {
+  check(IsInGameThread());
+
+  static UStaticMesh* pOwner = nullptr;
+  if (!pOwner) {
+    pOwner = NewObject<UStaticMesh>(
+        GetTransientPackage(),
+        TEXT("CesiumPrimitiveRenderDataOwner"),
+        RF_Transient);
+    pOwner->AddToRoot();
+    pOwner->NeverStream = true;
+    // FCesiumGltfMeshSceneProxy doesn't draw into ray tracing scenes, so
+    // don't build ray tracing geometry for it.
+    pOwner->bSupportRayTracing = false;
+  }
+  return pOwner;
+}
@@ -0,0 +1,66 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Templates/SharedPointer.h"
+
+class FStaticMeshRenderData;
+class UStaticMesh;
+
+/**
+ * Initializes the render resources of the render data owned by a tileset's
+ * primitive components in batches, rather than one primitive at a time.
+ *
+ * Initializing the render data of a static mesh enqueues separate render
+ * commands for each of its vertex buffers, its index buffer, and its vertex
+ * factories, and a tile that's loaded can have many primitives. Instead, the
+ * render data of every primitive created in a frame is added to this batch,
+ * and all of it is initialized by a single render command when the batch is
+ * flushed. The batch keeps the render data alive until then.
+ *
+ * The batch must be flushed after the components that draw the render data
+ * are registered, and before the frame is rendered. Scene proxies are only
+ * added to the scene when it's next rendered, so they never draw render data
+ * whose resources haven't been initialized yet.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumRenderDataBatch {
+public:
+  CesiumRenderDataBatch() = default;
+  ~CesiumRenderDataBatch();
+
+  CesiumRenderDataBatch(const CesiumRenderDataBatch&) = delete;
+  CesiumRenderDataBatch& operator=(const CesiumRenderDataBatch&) = delete;
+
+  /**
+   * Adds render data whose resources are to be initialized when this batch is
+   * next flushed.
+   */
+  void add(
+      const TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe>&
+          pRenderData);
+
+  /**
+   * Enqueues a single render command that initializes the resources of all of
+   * the render data added since the last flush.
+   */
+  void flush();
+
+  /**
+   * Gets the number of render data added since the last flush.
+   */
+  int32 getPendingCount() const { return this->_pending.Num(); }
+
+  /**
+   * Gets the static mesh that the render data owned by components is
+   * initialized with. FStaticMeshRenderData needs a static mesh to initialize
+   * its resources, but only reads settings from it that are the same for
+   * every primitive, so they all share this one.
+   */
+  static UStaticMesh* getRenderDataOwner();
+
+private:
+  TArray<TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe>> _pending;
+};
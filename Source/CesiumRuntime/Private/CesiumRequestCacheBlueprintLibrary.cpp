@@ -0,0 +1,42 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumRequestCacheBlueprintLibrary.h"
+#include "UnrealCacheDatabase.h"
+
+namespace {
+double averageMilliseconds(int64 totalMicroseconds, int64 count) {
+  return count > 0 ? double(totalMicroseconds) / double(count) / 1000.0 : 0.0;
+}
+} // namespace
+
+FCesiumRequestCacheStatistics
+UCesiumRequestCacheBlueprintLibrary::GetRequestCacheStatistics() {
+  const UnrealCacheDatabase::Statistics statistics =
+      UnrealCacheDatabase::getStatistics();
+
+  FCesiumRequestCacheStatistics result;
+  result.Hits = statistics.hits;
+  result.Misses = statistics.misses;
+  result.Writes = statistics.writes;
+  result.BytesWritten = statistics.bytesWritten;
+  result.Prunes = statistics.prunes;
+
+  const int64 reads = statistics.hits + statistics.misses;
+  result.AverageReadMilliseconds =
+      averageMilliseconds(statistics.readMicroseconds, reads);
+  result.MaximumReadMilliseconds =
+      double(statistics.maximumReadMicroseconds) / 1000.0;
+  result.AverageWriteMilliseconds =
+      averageMilliseconds(statistics.writeMicroseconds, statistics.writes);
+  result.MaximumWriteMilliseconds =
+      double(statistics.maximumWriteMicroseconds) / 1000.0;
+  result.AveragePruneMilliseconds =
+      averageMilliseconds(statistics.pruneMicroseconds, statistics.prunes);
+  result.MaximumPruneMilliseconds =
+      double(statistics.maximumPruneMicroseconds) / 1000.0;
+  return result;
+}
+
+void UCesiumRequestCacheBlueprintLibrary::ResetRequestCacheStatistics() {
+  UnrealCacheDatabase::resetStatistics();
+}
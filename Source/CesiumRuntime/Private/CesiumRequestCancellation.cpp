@@ -0,0 +1,180 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumRequestCancellation.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumRuntime.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  uint64_t nextHandle = 1;
+  std::unordered_map<
+      uint64_t,
+      std::unordered_map<uint64_t, CesiumRequestCancellation::CancelFunction>>
+      requestsByGroup;
+  std::unordered_set<uint64_t> cancelledGroups;
+};
+
+Registry& getRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+std::atomic<uint64_t> nextGroup{1};
+std::atomic<int64_t> cancelledRequestCount{0};
+std::atomic<int64_t> bytesAvoided{0};
+
+} // namespace
+
+const std::string CesiumRequestCancellation::groupHeader =
+    "X-Cesium-Unreal-Request-Group";
+
+/*static*/ uint64_t CesiumRequestCancellation::createGroup() {
+  return nextGroup++;
+}
+
+/*static*/ std::optional<uint64_t> CesiumRequestCancellation::extractGroup(
+    std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  auto it = std::find_if(
+      headers.begin(),
+      headers.end(),
+      [](const CesiumAsync::IAssetAccessor::THeader& header) {
+        return header.first == groupHeader;
+      });
+  if (it == headers.end()) {
+    return std::nullopt;
+  }
+
+  std::optional<uint64_t> result;
+  try {
+    result = std::stoull(it->second);
+  } catch (const std::exception&) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Ignoring invalid request group: %s"),
+        UTF8_TO_TCHAR(it->second.c_str()));
+  }
+
+  headers.erase(it);
+  return result;
+}
+
+/*static*/ std::optional<uint64_t> CesiumRequestCancellation::registerRequest(
+    uint64_t group,
+    CancelFunction&& cancel) {
+  Registry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  if (registry.cancelledGroups.find(group) != registry.cancelledGroups.end()) {
+    return std::nullopt;
+  }
+
+  uint64_t handle = registry.nextHandle++;
+  registry.requestsByGroup[group].emplace(handle, std::move(cancel));
+  return handle;
+}
+
+/*static*/ void
+CesiumRequestCancellation::unregisterRequest(uint64_t group, uint64_t handle) {
+  Registry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto it = registry.requestsByGroup.find(group);
+  if (it == registry.requestsByGroup.end()) {
+    return;
+  }
+
+  it->second.erase(handle);
+  if (it->second.empty()) {
+    registry.requestsByGroup.erase(it);
+  }
+}
+
+/*static*/ int32_t CesiumRequestCancellation::cancelGroup(uint64_t group) {
+  std::unordered_map<uint64_t, CancelFunction> requests;
+
+  {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.cancelledGroups.insert(group);
+
+    auto it = registry.requestsByGroup.find(group);
+    if (it != registry.requestsByGroup.end()) {
+      requests = std::move(it->second);
+      registry.requestsByGroup.erase(it);
+    }
+  }
+
+  // Cancel outside the lock, because cancelling a request may complete it
+  // synchronously, and completing it unregisters it.
+  int64_t bytes = 0;
+  for (auto& [handle, cancel] : requests) {
+    bytes += std::max<int64_t>(cancel(), 0);
+  }
+
+  cancelledRequestCount += int64_t(requests.size());
+  bytesAvoided += bytes;
+
+  return int32_t(requests.size());
+}
+
+/*static*/ void CesiumRequestCancellation::releaseGroup(uint64_t group) {
+  Registry& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.cancelledGroups.erase(group);
+}
+
+/*static*/ int64_t CesiumRequestCancellation::getCancelledRequestCount() {
+  return cancelledRequestCount;
+}
+
+/*static*/ int64_t CesiumRequestCancellation::getBytesAvoided() {
+  return bytesAvoided;
+}
+
+/*static*/ void CesiumRequestCancellation::recordRequestNotSent() {
+  ++cancelledRequestCount;
+}
+
+CesiumRequestGroupAssetAccessor::CesiumRequestGroupAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    uint64_t group)
+    : _pAssetAccessor(pAssetAccessor),
+      _group(group),
+      _groupHeaderValue(std::to_string(group)) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRequestGroupAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  std::vector<CesiumAsync::IAssetAccessor::THeader> groupHeaders;
+  groupHeaders.reserve(headers.size() + 1);
+  groupHeaders.insert(groupHeaders.end(), headers.begin(), headers.end());
+  groupHeaders.emplace_back(
+      CesiumRequestCancellation::groupHeader,
+      this->_groupHeaderValue);
+  return this->_pAssetAccessor->get(asyncSystem, url, groupHeaders);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRequestGroupAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumRequestGroupAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
@@ -0,0 +1,138 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Tracks in-flight network requests by "request group", so that all of the
+ * requests made on behalf of one owner (such as a tileset) can be cancelled
+ * at once when the owner no longer needs them.
+ *
+ * A request is assigned to a group by a pseudo-header, named by
+ * {@link groupHeader}, which is added by a
+ * {@link CesiumRequestGroupAssetAccessor} and removed again by the accessor
+ * that actually performs the request. That way the group survives the trip
+ * through the caching and decompressing accessors in between.
+ */
+class CesiumRequestCancellation {
+public:
+  /**
+   * The name of the pseudo-header that assigns a request to a group. It is
+   * never sent to the server.
+   */
+  static const std::string groupHeader;
+
+  /**
+   * A function that cancels a single request, returning the estimated number
+   * of response bytes that will not be downloaded as a result.
+   */
+  using CancelFunction = std::function<int64_t()>;
+
+  /**
+   * Creates a new, unique request group.
+   */
+  static uint64_t createGroup();
+
+  /**
+   * Removes the group pseudo-header from the given request headers, if
+   * present.
+   *
+   * @return The group the request belongs to, or std::nullopt if it doesn't
+   * belong to one.
+   */
+  static std::optional<uint64_t>
+  extractGroup(std::vector<CesiumAsync::IAssetAccessor::THeader>& headers);
+
+  /**
+   * Registers an in-flight request with a group.
+   *
+   * @return A handle that identifies the request to
+   * {@link unregisterRequest}, or std::nullopt if the group has already been
+   * cancelled, in which case the request should not be made at all.
+   */
+  static std::optional<uint64_t>
+  registerRequest(uint64_t group, CancelFunction&& cancel);
+
+  /**
+   * Unregisters a request that has completed.
+   */
+  static void unregisterRequest(uint64_t group, uint64_t handle);
+
+  /**
+   * Cancels every in-flight request in a group. Any request that is made in
+   * the group afterward is cancelled before it is sent. Must be called from
+   * the game thread.
+   *
+   * @return The number of in-flight requests that were cancelled.
+   */
+  static int32_t cancelGroup(uint64_t group);
+
+  /**
+   * Forgets a group that no more requests will be made in, so that a group
+   * that was cancelled no longer takes up memory. A request that is made in
+   * the group afterward isn't cancelled, so a group may only be released once
+   * its owner has stopped making requests, such as when a tileset's
+   * asynchronous destruction is complete.
+   */
+  static void releaseGroup(uint64_t group);
+
+  /**
+   * Gets the total number of requests that have been cancelled, including
+   * requests that were cancelled before they were sent.
+   */
+  static int64_t getCancelledRequestCount();
+
+  /**
+   * Gets the estimated total number of response bytes that were not
+   * downloaded because their requests were cancelled. Only requests whose
+   * response size was known when they were cancelled contribute to this.
+   */
+  static int64_t getBytesAvoided();
+
+  /**
+   * Records a request that was cancelled before it was sent.
+   */
+  static void recordRequestNotSent();
+};
+
+/**
+ * An asset accessor that adds every GET request it makes to a request group,
+ * so that they can be cancelled with
+ * {@link CesiumRequestCancellation::cancelGroup}.
+ */
+class CesiumRequestGroupAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  CesiumRequestGroupAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      uint64_t group);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  uint64_t getGroup() const noexcept { return this->_group; }
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  uint64_t _group;
+  std::string _groupHeaderValue;
+};
@@ -5,15 +5,28 @@
 #include "CesiumAsync/CachingAssetAccessor.h"
 #include "CesiumAsync/GunzipAssetAccessor.h"
 #include "CesiumAsync/SqliteCache.h"
+#include "CesiumBandwidthLimiter.h"
+#include "CesiumContentEncodingAssetAccessor.h"
+#include "CesiumDecodedContentCache.h"
+#include "CesiumMemoryPressure.h"
+#include "CesiumMobileThrottling.h"
+#include "CesiumTelemetry.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumStaleCacheDatabase.h"
 #include "CesiumUtility/Tracing.h"
 #include "HAL/FileManager.h"
 #include "HttpModule.h"
 #include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
 #include "Misc/Paths.h"
 #include "ShaderCore.h"
 #include "SpdlogUnrealLoggerSink.h"
 #include "UnrealAssetAccessor.h"
+#include "UnrealAssetRecording.h"
+#include "UnrealCacheDatabase.h"
+#include "UnrealPooledAssetAccessor.h"
 #include "UnrealTaskProcessor.h"
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetAccessor.h>
@@ -28,8 +41,24 @@
 
 DEFINE_LOG_CATEGORY(LogCesium);
 
+namespace {
+
+const TCHAR* const CacheConfigSection = TEXT("CesiumRequestCache");
+const TCHAR* const AverageItemBytesConfigKey = TEXT("AverageItemBytes");
+
+// The assumed size of a cached item, before any have been cached.
+constexpr int64 DefaultAverageCacheItemBytes = 64 * 1024;
+
+std::shared_ptr<UnrealCacheDatabase> pUnrealCacheDatabase;
+
+} // namespace
+
 void FCesiumRuntimeModule::StartupModule() {
   Cesium3DTilesContent::registerAllTileContentTypes();
+  CesiumDecodedContentCache::registerConverters();
+  CesiumMemoryPressure::get().startListening();
+  CesiumMobileThrottling::get().startListening();
+  CesiumTelemetry::startup();
 
   std::shared_ptr<spdlog::logger> pLogger = spdlog::default_logger();
   pLogger->sinks() = {std::make_shared<SpdlogUnrealLoggerSink>()};
@@ -52,7 +81,32 @@ void FCesiumRuntimeModule::StartupModule() {
       PluginShaderDir);
 }
 
-void FCesiumRuntimeModule::ShutdownModule() { CESIUM_TRACE_SHUTDOWN(); }
+void FCesiumRuntimeModule::ShutdownModule() {
+  CesiumMemoryPressure::get().stopListening();
+  CesiumMobileThrottling::get().stopListening();
+  CesiumTelemetry::shutdown();
+
+  // Write the responses that are still queued for the cache.
+  if (pUnrealCacheDatabase) {
+    pUnrealCacheDatabase->shutdown();
+  }
+
+  // Remember the average size of the cached items, so that the next session
+  // can better estimate how many items fit in the cache size limit.
+  if (pUnrealCacheDatabase && GConfig) {
+    const int64 averageItemBytes = pUnrealCacheDatabase->getAverageItemBytes();
+    if (averageItemBytes > 0) {
+      GConfig->SetInt64(
+          CacheConfigSection,
+          AverageItemBytesConfigKey,
+          averageItemBytes,
+          GGameUserSettingsIni);
+      GConfig->Flush(false, GGameUserSettingsIni);
+    }
+  }
+
+  CESIUM_TRACE_SHUTDOWN();
+}
 
 #undef LOCTEXT_NAMESPACE
 
@@ -100,28 +154,184 @@ std::string getCacheDatabaseName() {
 
 } // namespace
 
-std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
-  static int MaxCacheItems =
-      GetDefault<UCesiumRuntimeSettings>()->MaxCacheItems;
+namespace {
 
-  static std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
+std::shared_ptr<CesiumAsync::ICacheDatabase> createCacheDatabase() {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+
+  int maxItems = pSettings->MaxCacheItems;
+  int64 bytesPerPrune = 0;
+
+  if (pSettings->MaxCacheSizeInGigabytes > 0.0f) {
+    // SqliteCache can only limit the number of items it keeps, so estimate
+    // how many items fit in the byte budget.
+    int64 averageItemBytes = DefaultAverageCacheItemBytes;
+    GConfig->GetInt64(
+        CacheConfigSection,
+        AverageItemBytesConfigKey,
+        averageItemBytes,
+        GGameUserSettingsIni);
+    averageItemBytes = FMath::Max<int64>(averageItemBytes, 1);
+
+    const int64 maximumBytes = static_cast<int64>(
+        double(pSettings->MaxCacheSizeInGigabytes) * 1024.0 * 1024.0 * 1024.0);
+    maxItems = static_cast<int>(FMath::Clamp<int64>(
+        maximumBytes / averageItemBytes,
+        1,
+        TNumericLimits<int>::Max()));
+    bytesPerPrune = FMath::Max<int64>(maximumBytes / 100, 1);
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT(
+            "Limiting the Cesium request cache to %.2f GB, estimated at %d items of %lld bytes"),
+        pSettings->MaxCacheSizeInGigabytes,
+        maxItems,
+        averageItemBytes);
+  }
+
+  pUnrealCacheDatabase = std::make_shared<UnrealCacheDatabase>(
       std::make_shared<CesiumAsync::SqliteCache>(
           spdlog::default_logger(),
           getCacheDatabaseName(),
-          MaxCacheItems);
+          maxItems),
+      bytesPerPrune,
+      pSettings->UseCacheMaintenanceThread);
+  return pUnrealCacheDatabase;
+}
+
+} // namespace
+
+std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
+  static std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
+      createCacheDatabase();
 
   return pCacheDatabase;
 }
 
-const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor() {
-  static int RequestsPerCachePrune =
-      GetDefault<UCesiumRuntimeSettings>()->RequestsPerCachePrune;
-  static std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor =
-      std::make_shared<CesiumAsync::GunzipAssetAccessor>(
+namespace {
+
+std::shared_ptr<CesiumAsync::IAssetAccessor> createHttpAssetAccessor() {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pUnrealAssetAccessor =
+      std::make_shared<UnrealAssetAccessor>();
+
+  if (!pSettings->UsePooledHttpRequests) {
+    return pUnrealAssetAccessor;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("Limiting Cesium requests to %d connections per host"),
+      pSettings->MaximumConnectionsPerHost);
+
+  return std::make_shared<UnrealPooledAssetAccessor>(
+      pUnrealAssetAccessor,
+      pSettings->MaximumConnectionsPerHost);
+}
+
+/**
+ * Creates the accessor for requests that miss the cache. By default it makes
+ * them over HTTP. For reproducible performance testing, requests can instead
+ * be recorded to a directory with -CesiumRecordRequests=<dir> and served from
+ * it in a later run with -CesiumReplayRequests=<dir>. A replay can simulate a
+ * network with -CesiumReplayLatency=<milliseconds>,
+ * -CesiumReplayBandwidth=<megabits per second>, and
+ * -CesiumReplayRecordedLatency. Only cache misses are recorded, so the cache
+ * should be cleared before recording.
+ */
+std::shared_ptr<CesiumAsync::IAssetAccessor> createNetworkAssetAccessor() {
+  const TCHAR* commandLine = FCommandLine::Get();
+  FString archiveDirectory;
+
+  if (FParse::Value(
+          commandLine,
+          TEXT("CesiumReplayRequests="),
+          archiveDirectory)) {
+    UnrealReplayNetworkProfile profile;
+    profile.useRecordedLatency =
+        FParse::Param(commandLine, TEXT("CesiumReplayRecordedLatency"));
+    FParse::Value(
+        commandLine,
+        TEXT("CesiumReplayLatency="),
+        profile.latencyMilliseconds);
+    double megabitsPerSecond = 0.0;
+    FParse::Value(
+        commandLine,
+        TEXT("CesiumReplayBandwidth="),
+        megabitsPerSecond);
+    profile.bytesPerSecond = megabitsPerSecond * 1000000.0 / 8.0;
+
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Replaying Cesium requests from %s"),
+        *archiveDirectory);
+    return std::make_shared<UnrealReplayAssetAccessor>(
+        archiveDirectory,
+        profile);
+  }
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor =
+      createHttpAssetAccessor();
+
+  if (FParse::Value(
+          commandLine,
+          TEXT("CesiumRecordRequests="),
+          archiveDirectory)) {
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Recording Cesium requests to %s"),
+        *archiveDirectory);
+    return std::make_shared<UnrealRecordingAssetAccessor>(
+        pAssetAccessor,
+        archiveDirectory);
+  }
+
+  return pAssetAccessor;
+}
+
+std::shared_ptr<CesiumAsync::IAssetAccessor> createAssetAccessor() {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+
+  // Only requests that miss the cache wait for bandwidth.
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pNetworkAssetAccessor =
+      std::make_shared<CesiumBandwidthAssetAccessor>(
+          createNetworkAssetAccessor());
+
+  // Stale responses are revalidated directly with the server, since going
+  // through the cache would find the same stale response again.
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
+      getCacheDatabase();
+  if (pSettings->MaxCacheStalenessInHours > 0.0f) {
+    pCacheDatabase = std::make_shared<CesiumStaleCacheDatabase>(
+        pCacheDatabase,
+        pNetworkAssetAccessor,
+        std::time_t(double(pSettings->MaxCacheStalenessInHours) * 3600.0));
+  }
+
+  // Like gzip, other content encodings are stored in the cache as they were
+  // received, and decoded on a worker thread each time they're requested.
+  return std::make_shared<CesiumAsync::GunzipAssetAccessor>(
+      std::make_shared<CesiumContentEncodingAssetAccessor>(
           std::make_shared<CesiumAsync::CachingAssetAccessor>(
               spdlog::default_logger(),
-              std::make_shared<UnrealAssetAccessor>(),
-              getCacheDatabase(),
-              RequestsPerCachePrune));
+              pNetworkAssetAccessor,
+              pCacheDatabase,
+              pSettings->RequestsPerCachePrune),
+          TCHAR_TO_UTF8(*pSettings->HttpAcceptEncoding)));
+}
+
+} // namespace
+
+const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor() {
+  static std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor =
+      createAssetAccessor();
   return pAssetAccessor;
 }
@@ -6,4 +6,15 @@ UCesiumRuntimeSettings::UCesiumRuntimeSettings(
     const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer) {
   CategoryName = FName(TEXT("Plugins"));
+
+  LowScalabilityTier.MaximumScreenSpaceErrorScale = 2.0f;
+  LowScalabilityTier.MaximumCachedBytesScale = 0.5f;
+  LowScalabilityTier.MaximumTextureSize = 512;
+  LowScalabilityTier.MaximumPointsPerFrame = 2000000;
+  LowScalabilityTier.EnableLodTransitions = false;
+
+  MediumScalabilityTier.MaximumScreenSpaceErrorScale = 1.5f;
+  MediumScalabilityTier.MaximumCachedBytesScale = 0.75f;
+  MediumScalabilityTier.MaximumTextureSize = 1024;
+  MediumScalabilityTier.MaximumPointsPerFrame = 5000000;
 }
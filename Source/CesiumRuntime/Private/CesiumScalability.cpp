@@ -0,0 +1,67 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumScalability.h"
+#include "CesiumRuntimeSettings.h"
+#include "Scalability.h"
+#include <algorithm>
+
+namespace {
+const FCesiumScalabilityTier& getTierIfEnabled(int32 qualityLevel) {
+  // Leaves every tileset as it is.
+  static const FCesiumScalabilityTier defaultTier{};
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (!pSettings->EnableScalabilityTiers) {
+    return defaultTier;
+  }
+  return CesiumScalability::getTier(*pSettings, qualityLevel);
+}
+} // namespace
+
+/*static*/ const FCesiumScalabilityTier& CesiumScalability::getTier(
+    const UCesiumRuntimeSettings& settings,
+    int32 qualityLevel) {
+  switch (std::clamp(qualityLevel, 0, 4)) {
+  case 0:
+    return settings.LowScalabilityTier;
+  case 1:
+    return settings.MediumScalabilityTier;
+  case 2:
+    return settings.HighScalabilityTier;
+  case 3:
+    return settings.EpicScalabilityTier;
+  default:
+    return settings.CinematicScalabilityTier;
+  }
+}
+
+/*static*/ const FCesiumScalabilityTier&
+CesiumScalability::getViewDistanceTier() {
+  return getTierIfEnabled(Scalability::GetQualityLevels().ViewDistanceQuality);
+}
+
+/*static*/ const FCesiumScalabilityTier& CesiumScalability::getTextureTier() {
+  return getTierIfEnabled(Scalability::GetQualityLevels().TextureQuality);
+}
+
+/*static*/ int32 CesiumScalability::limitTextureSize(
+    const FCesiumScalabilityTier& tier,
+    int32 maximumTextureSize) {
+  if (tier.MaximumTextureSize <= 0) {
+    return maximumTextureSize;
+  }
+  return std::min(maximumTextureSize, tier.MaximumTextureSize);
+}
+
+/*static*/ int32 CesiumScalability::limitPoints(
+    const FCesiumScalabilityTier& tier,
+    int32 maximumPoints) {
+  if (tier.MaximumPointsPerFrame <= 0) {
+    return maximumPoints;
+  }
+  if (maximumPoints <= 0) {
+    return tier.MaximumPointsPerFrame;
+  }
+  return std::min(maximumPoints, tier.MaximumPointsPerFrame);
+}
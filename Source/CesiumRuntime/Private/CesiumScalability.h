@@ -0,0 +1,54 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+struct FCesiumScalabilityTier;
+class UCesiumRuntimeSettings;
+
+/**
+ * Chooses the FCesiumScalabilityTier that tilesets are adjusted by, from
+ * Unreal's current scalability settings. The tiers are only used when
+ * "Enable Scalability Tiers" is set in the project settings. Otherwise, a
+ * tier that leaves every tileset as it is is returned.
+ *
+ * The scalability settings are read each time, so changes to them apply as
+ * soon as tilesets next update. All functions must be called from the game
+ * thread.
+ */
+class CesiumScalability {
+public:
+  /**
+   * Gets the tier that the settings give for a quality level, from 0 (Low)
+   * to 4 (Cinematic). Levels outside that range use the nearest tier.
+   */
+  static const FCesiumScalabilityTier&
+  getTier(const UCesiumRuntimeSettings& settings, int32 qualityLevel);
+
+  /**
+   * Gets the tier for the current View Distance Quality, which sets the
+   * screen-space error, cached bytes, point budget, LOD transitions, and
+   * occlusion culling of tilesets.
+   */
+  static const FCesiumScalabilityTier& getViewDistanceTier();
+
+  /**
+   * Gets the tier for the current Texture Quality, which sets the size of
+   * raster overlay textures.
+   */
+  static const FCesiumScalabilityTier& getTextureTier();
+
+  /**
+   * Limits the maximum texture size of a raster overlay by a tier.
+   */
+  static int32 limitTextureSize(
+      const FCesiumScalabilityTier& tier,
+      int32 maximumTextureSize);
+
+  /**
+   * Limits the maximum points per frame, where 0 is unlimited, by a tier.
+   */
+  static int32
+  limitPoints(const FCesiumScalabilityTier& tier, int32 maximumPoints);
+};
@@ -0,0 +1,17 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumSceneCaptureDetailComponent.h"
+
+FVector2D UCesiumSceneCaptureDetailComponent::GetTileSelectionViewportSize(
+    const FVector2D& RenderTargetSize) const {
+  const FVector2D size = this->OverrideResolution
+                             ? FVector2D(
+                                   FMath::Max(this->Resolution.X, 1),
+                                   FMath::Max(this->Resolution.Y, 1))
+                             : RenderTargetSize;
+
+  // The screen-space error of a tile is proportional to the viewport height,
+  // so dividing the size by the multiplier multiplies the error by it. Both
+  // dimensions are scaled so that the aspect ratio stays the same.
+  return size / FMath::Max(this->ScreenSpaceErrorMultiplier, 0.01);
+}
@@ -0,0 +1,368 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumStaleCacheDatabase.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumBandwidthLimiter.h"
+#include "CesiumRuntime.h"
+#include "Misc/DateTime.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <exception>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Stale Cache Responses"),
+    STAT_CesiumStaleCacheResponses,
+    STATGROUP_Cesium);
+
+namespace {
+
+struct CacheControl {
+  bool noStore = false;
+  bool noCache = false;
+  bool mustRevalidate = false;
+  std::optional<int64_t> maxAge;
+};
+
+std::string toLower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) {
+    return char(std::tolower(c));
+  });
+  return s;
+}
+
+std::string trim(const std::string& s) {
+  const size_t first = s.find_first_not_of(" \t");
+  if (first == std::string::npos) {
+    return std::string();
+  }
+  const size_t last = s.find_last_not_of(" \t");
+  return s.substr(first, last - first + 1);
+}
+
+CacheControl parseCacheControl(const CesiumAsync::HttpHeaders& headers) {
+  CacheControl result;
+  auto it = headers.find("Cache-Control");
+  if (it == headers.end()) {
+    return result;
+  }
+
+  std::optional<int64_t> sharedMaxAge;
+  const std::string value = toLower(it->second);
+  size_t start = 0;
+  while (start <= value.size()) {
+    size_t end = value.find(',', start);
+    if (end == std::string::npos) {
+      end = value.size();
+    }
+    const std::string directive = trim(value.substr(start, end - start));
+    start = end + 1;
+
+    const size_t equals = directive.find('=');
+    const std::string name = trim(directive.substr(0, equals));
+    if (name == "no-store") {
+      result.noStore = true;
+    } else if (name == "no-cache") {
+      result.noCache = true;
+    } else if (name == "must-revalidate" || name == "proxy-revalidate") {
+      result.mustRevalidate = true;
+    } else if (
+        (name == "max-age" || name == "s-maxage") &&
+        equals != std::string::npos) {
+      try {
+        const int64_t seconds = std::stoll(directive.substr(equals + 1));
+        if (name == "max-age") {
+          result.maxAge = seconds;
+        } else {
+          sharedMaxAge = seconds;
+        }
+      } catch (const std::exception&) {
+      }
+    }
+  }
+
+  if (!result.maxAge) {
+    result.maxAge = sharedMaxAge;
+  }
+  return result;
+}
+
+// The stream that revalidations are made in, which only uses bandwidth that
+// no tileset or overlay needs.
+uint64_t getRevalidationStream() {
+  static const uint64_t stream = CesiumBandwidthLimiter::get().createStream(
+      ECesiumRequestPriority::Background,
+      1.0);
+  return stream;
+}
+
+bool isConditionalHeader(const std::string& name) {
+  const std::string lower = toLower(name);
+  return lower == "if-none-match" || lower == "if-modified-since";
+}
+
+} // namespace
+
+const std::string CesiumStaleCacheDatabase::freshUntilHeader =
+    "X-Cesium-Unreal-Fresh-Until";
+
+struct CesiumStaleCacheDatabase::State
+    : public std::enable_shared_from_this<CesiumStaleCacheDatabase::State> {
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pDatabase;
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor;
+  std::time_t maximumStaleness;
+
+  std::mutex mutex;
+  // The keys of the responses that are being revalidated.
+  std::unordered_set<std::string> revalidating;
+
+  std::atomic<int64_t> staleResponseCount{0};
+  std::atomic<int64_t> revalidationCount{0};
+
+  bool store(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) {
+    const CacheControl cacheControl = parseCacheControl(responseHeaders);
+    if (this->maximumStaleness <= 0 || cacheControl.mustRevalidate ||
+        cacheControl.noCache) {
+      return this->pDatabase->storeEntry(
+          key,
+          expiryTime,
+          url,
+          requestMethod,
+          requestHeaders,
+          statusCode,
+          responseHeaders,
+          responseData);
+    }
+
+    CesiumAsync::HttpHeaders headers = responseHeaders;
+    headers[freshUntilHeader] = std::to_string(int64_t(expiryTime));
+    return this->pDatabase->storeEntry(
+        key,
+        expiryTime + this->maximumStaleness,
+        url,
+        requestMethod,
+        requestHeaders,
+        statusCode,
+        headers,
+        responseData);
+  }
+
+  void revalidate(const std::string& key, const CesiumAsync::CacheItem& item) {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->revalidating.insert(key).second) {
+        return;
+      }
+    }
+
+    // The response is requested again with the headers it was requested with,
+    // except for those of any earlier revalidation.
+    std::vector<CesiumAsync::IAssetAccessor::THeader> headers;
+    for (const auto& header : item.cacheRequest.headers) {
+      if (!isConditionalHeader(header.first)) {
+        headers.emplace_back(header);
+      }
+    }
+    const CesiumAsync::HttpHeaders& responseHeaders =
+        item.cacheResponse.headers;
+    auto eTagIt = responseHeaders.find("ETag");
+    if (eTagIt != responseHeaders.end()) {
+      headers.emplace_back("If-None-Match", eTagIt->second);
+    }
+    auto lastModifiedIt = responseHeaders.find("Last-Modified");
+    if (lastModifiedIt != responseHeaders.end()) {
+      headers.emplace_back("If-Modified-Since", lastModifiedIt->second);
+    }
+    headers.emplace_back(
+        CesiumBandwidthLimiter::streamHeader,
+        std::to_string(getRevalidationStream()));
+
+    std::shared_ptr<State> pThis = this->shared_from_this();
+    this->pAssetAccessor->get(getAsyncSystem(), item.cacheRequest.url, headers)
+        .thenInWorkerThread(
+            [pThis, key, item](
+                std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+              pThis->finishRevalidation(key, item, pRequest.get());
+            })
+        .catchImmediately([pThis, key](std::exception&& e) {
+          UE_LOG(
+              LogCesium,
+              Verbose,
+              TEXT("Failed to revalidate a stale cached response: %s"),
+              UTF8_TO_TCHAR(e.what()));
+          pThis->endRevalidation(key);
+        });
+  }
+
+  void finishRevalidation(
+      const std::string& key,
+      const CesiumAsync::CacheItem& item,
+      const CesiumAsync::IAssetRequest* pRequest) {
+    const CesiumAsync::IAssetResponse* pResponse =
+        pRequest ? pRequest->response() : nullptr;
+    const std::time_t now = std::time(nullptr);
+
+    if (pResponse && pResponse->statusCode() == 304) {
+      // The stored response is still current, and only its headers, such as
+      // those that say when it expires, are updated.
+      CesiumAsync::HttpHeaders headers = item.cacheResponse.headers;
+      for (const auto& header : pResponse->headers()) {
+        headers[header.first] = header.second;
+      }
+      std::optional<std::time_t> expiryTime = computeExpiryTime(headers, now);
+      if (expiryTime) {
+        this->store(
+            key,
+            *expiryTime,
+            item.cacheRequest.url,
+            item.cacheRequest.method,
+            item.cacheRequest.headers,
+            item.cacheResponse.statusCode,
+            headers,
+            gsl::span<const std::byte>(item.cacheResponse.data));
+      }
+    } else if (
+        pResponse && pResponse->statusCode() >= 200 &&
+        pResponse->statusCode() < 300) {
+      std::optional<std::time_t> expiryTime =
+          computeExpiryTime(pResponse->headers(), now);
+      if (expiryTime) {
+        this->store(
+            key,
+            *expiryTime,
+            pRequest->url(),
+            pRequest->method(),
+            pRequest->headers(),
+            pResponse->statusCode(),
+            pResponse->headers(),
+            pResponse->data());
+      }
+    }
+
+    // Otherwise, such as when the server is unavailable, the stale response
+    // keeps being used until it's too old.
+    ++this->revalidationCount;
+    this->endRevalidation(key);
+  }
+
+  void endRevalidation(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->revalidating.erase(key);
+  }
+};
+
+CesiumStaleCacheDatabase::CesiumStaleCacheDatabase(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    std::time_t maximumStaleness)
+    : _pState(std::make_shared<State>()) {
+  this->_pState->pDatabase = pDatabase;
+  this->_pState->pAssetAccessor = pAssetAccessor;
+  this->_pState->maximumStaleness = maximumStaleness;
+}
+
+CesiumStaleCacheDatabase::~CesiumStaleCacheDatabase() noexcept = default;
+
+/*static*/ std::optional<std::time_t>
+CesiumStaleCacheDatabase::computeExpiryTime(
+    const CesiumAsync::HttpHeaders& headers,
+    std::time_t now) {
+  const CacheControl cacheControl = parseCacheControl(headers);
+  if (cacheControl.noStore) {
+    return std::nullopt;
+  }
+  if (cacheControl.maxAge) {
+    return now + std::time_t(*cacheControl.maxAge);
+  }
+
+  auto it = headers.find("Expires");
+  if (it != headers.end()) {
+    FDateTime expires;
+    if (FDateTime::ParseHttpDate(UTF8_TO_TCHAR(it->second.c_str()), expires)) {
+      return std::time_t(expires.ToUnixTimestamp());
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<CesiumAsync::CacheItem>
+CesiumStaleCacheDatabase::getEntry(const std::string& key) const {
+  std::optional<CesiumAsync::CacheItem> result =
+      this->_pState->pDatabase->getEntry(key);
+  if (!result) {
+    return result;
+  }
+
+  CesiumAsync::HttpHeaders& headers = result->cacheResponse.headers;
+  auto it = headers.find(freshUntilHeader);
+  if (it == headers.end()) {
+    return result;
+  }
+
+  std::optional<std::time_t> freshUntil;
+  try {
+    freshUntil = std::time_t(std::stoll(it->second));
+  } catch (const std::exception&) {
+  }
+  headers.erase(it);
+
+  // A response that is past its maximum staleness has an expiry time in the
+  // past, so the caching accessor revalidates it before it's used.
+  const std::time_t now = std::time(nullptr);
+  if (freshUntil && now >= *freshUntil && now < result->expiryTime) {
+    ++this->_pState->staleResponseCount;
+    INC_DWORD_STAT(STAT_CesiumStaleCacheResponses);
+    this->_pState->revalidate(key, *result);
+  }
+
+  return result;
+}
+
+bool CesiumStaleCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  return this->_pState->store(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+}
+
+bool CesiumStaleCacheDatabase::prune() {
+  return this->_pState->pDatabase->prune();
+}
+
+bool CesiumStaleCacheDatabase::clearAll() {
+  return this->_pState->pDatabase->clearAll();
+}
+
+int64_t CesiumStaleCacheDatabase::getStaleResponseCount() const {
+  return this->_pState->staleResponseCount;
+}
+
+int64_t CesiumStaleCacheDatabase::getRevalidationCount() const {
+  return this->_pState->revalidationCount;
+}
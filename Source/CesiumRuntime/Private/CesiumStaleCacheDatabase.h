@@ -0,0 +1,100 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/HttpHeaders.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/ICacheDatabase.h"
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * A cache database that answers requests for responses that have expired
+ * from the cache right away, and revalidates them in the background, for
+ * "Max Cache Staleness In Hours". That way, a tileset whose tiles are all
+ * cached never waits for a round trip to the server before it can use them,
+ * even after they've expired.
+ *
+ * Each response is stored for the maximum staleness beyond its expiry time,
+ * so that the database doesn't prune it as soon as it expires, and the expiry
+ * time that the server gave it is kept in a pseudo-header, named by
+ * {@link freshUntilHeader}, of the stored response. When a response that
+ * has expired, but not by more than the maximum staleness, is looked up, it
+ * is returned as if it were fresh, and a conditional request for it is made
+ * through the given accessor, which updates the stored response. Responses
+ * that expired longer ago than that are revalidated by the caching accessor
+ * before they're used, as usual. Responses whose Cache-Control forbids using
+ * them once they're stale, with must-revalidate or no-cache, are stored
+ * unchanged.
+ */
+class CesiumStaleCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * The name of the pseudo-header of stored responses that holds the time,
+   * in seconds since the epoch, at which they expire. It is never returned
+   * with a response.
+   */
+  static const std::string freshUntilHeader;
+
+  /**
+   * @param pDatabase The database that stores the cached items.
+   * @param pAssetAccessor The accessor that revalidates stale responses. It
+   * must not be the caching accessor that uses this database.
+   * @param maximumStaleness The longest time, in seconds, after a response
+   * has expired for which it may still be used.
+   */
+  CesiumStaleCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      std::time_t maximumStaleness);
+
+  virtual ~CesiumStaleCacheDatabase() noexcept;
+
+  /**
+   * Computes the time at which a response expires from its Cache-Control
+   * max-age or its Expires header, or std::nullopt if it mustn't be cached
+   * or doesn't say.
+   *
+   * @param headers The response headers.
+   * @param now The time at which the response was received.
+   */
+  static std::optional<std::time_t>
+  computeExpiryTime(const CesiumAsync::HttpHeaders& headers, std::time_t now);
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * Gets the number of stale responses that were used while they were being
+   * revalidated.
+   */
+  int64_t getStaleResponseCount() const;
+
+  /**
+   * Gets the number of revalidations that have completed, successfully or
+   * not.
+   */
+  int64_t getRevalidationCount() const;
+
+private:
+  struct State;
+
+  std::shared_ptr<State> _pState;
+};
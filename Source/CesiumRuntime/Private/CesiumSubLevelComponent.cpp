@@ -22,7 +22,10 @@ using namespace CesiumGeospatial;
 
 bool UCesiumSubLevelComponent::GetEnabled() const { return this->Enabled; }
 
-void UCesiumSubLevelComponent::SetEnabled(bool value) { this->Enabled = value; }
+void UCesiumSubLevelComponent::SetEnabled(bool value) {
+  this->Enabled = value;
+  this->_invalidateSwitcherIndex();
+}
 
 double UCesiumSubLevelComponent::GetOriginLongitude() const {
   return this->OriginLongitude;
@@ -30,6 +33,7 @@ double UCesiumSubLevelComponent::GetOriginLongitude() const {
 
 void UCesiumSubLevelComponent::SetOriginLongitude(double value) {
   this->OriginLongitude = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -39,6 +43,7 @@ double UCesiumSubLevelComponent::GetOriginLatitude() const {
 
 void UCesiumSubLevelComponent::SetOriginLatitude(double value) {
   this->OriginLatitude = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -48,6 +53,7 @@ double UCesiumSubLevelComponent::GetOriginHeight() const {
 
 void UCesiumSubLevelComponent::SetOriginHeight(double value) {
   this->OriginHeight = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -57,6 +63,7 @@ double UCesiumSubLevelComponent::GetLoadRadius() const {
 
 void UCesiumSubLevelComponent::SetLoadRadius(double value) {
   this->LoadRadius = value;
+  this->_invalidateSwitcherIndex();
 }
 
 TSoftObjectPtr<ACesiumGeoreference>
@@ -114,6 +121,7 @@ void UCesiumSubLevelComponent::SetOriginLongitudeLatitudeHeight(
     this->OriginLongitude = longitudeLatitudeHeight.X;
     this->OriginLatitude = longitudeLatitudeHeight.Y;
     this->OriginHeight = longitudeLatitudeHeight.Z;
+    this->_invalidateSwitcherIndex();
     this->UpdateGeoreferenceIfSubLevelIsActive();
   }
 }
@@ -410,6 +418,7 @@ void UCesiumSubLevelComponent::OnComponentCreated() {
     this->OriginLongitude = this->ResolvedGeoreference->GetOriginLongitude();
     this->OriginLatitude = this->ResolvedGeoreference->GetOriginLatitude();
     this->OriginHeight = this->ResolvedGeoreference->GetOriginHeight();
+    pSwitcher->InvalidateSubLevelIndex();
 
     // In Editor worlds, make the newly-created sub-level the active one. Unless
     // it's already hidden.
@@ -437,6 +446,9 @@ void UCesiumSubLevelComponent::PostEditChangeProperty(
 
   FName propertyName = PropertyChangedEvent.Property->GetFName();
 
+  // Any property may be edited through the details panel without a setter.
+  this->_invalidateSwitcherIndex();
+
   if (propertyName ==
           GET_MEMBER_NAME_CHECKED(UCesiumSubLevelComponent, OriginLongitude) ||
       propertyName ==
@@ -551,6 +563,12 @@ UCesiumSubLevelComponent::_getSwitcher() noexcept {
       ->FindComponentByClass<UCesiumSubLevelSwitcherComponent>();
 }
 
+void UCesiumSubLevelComponent::_invalidateSwitcherIndex() noexcept {
+  UCesiumSubLevelSwitcherComponent* pSwitcher = this->_getSwitcher();
+  if (pSwitcher)
+    pSwitcher->InvalidateSubLevelIndex();
+}
+
 ALevelInstance* UCesiumSubLevelComponent::_getLevelInstance() const noexcept {
   ALevelInstance* pOwner = Cast<ALevelInstance>(this->GetOwner());
   if (!pOwner) {
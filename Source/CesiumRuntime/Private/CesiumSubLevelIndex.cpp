@@ -0,0 +1,108 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumSubLevelIndex.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+// The most spheres in a leaf, below which testing each one is cheaper than
+// splitting further.
+constexpr int32 MaxSpheresPerLeaf = 4;
+
+FBox getSphereBounds(const CesiumSubLevelIndex::Sphere& sphere) {
+  const FVector extent(sphere.radius);
+  return FBox(sphere.center - extent, sphere.center + extent);
+}
+} // namespace
+
+void CesiumSubLevelIndex::build(TArray<Sphere>&& spheres) {
+  this->_spheres = MoveTemp(spheres);
+  this->_order.SetNumUninitialized(this->_spheres.Num());
+  for (int32 i = 0; i < this->_order.Num(); ++i) {
+    this->_order[i] = i;
+  }
+
+  this->_nodes.Reset();
+  if (this->_spheres.Num() > 0) {
+    this->buildNode(0, this->_spheres.Num());
+  }
+}
+
+int32 CesiumSubLevelIndex::buildNode(int32 begin, int32 end) {
+  const int32 nodeIndex = this->_nodes.AddUninitialized();
+
+  FBox bounds(ForceInit);
+  FBox centerBounds(ForceInit);
+  for (int32 i = begin; i < end; ++i) {
+    const Sphere& sphere = this->_spheres[this->_order[i]];
+    bounds += getSphereBounds(sphere);
+    centerBounds += sphere.center;
+  }
+
+  if (end - begin <= MaxSpheresPerLeaf) {
+    this->_nodes[nodeIndex] = Node{bounds, begin, end - begin};
+    return nodeIndex;
+  }
+
+  // Split at the median center along the longest axis of the centers.
+  const FVector size = centerBounds.GetSize();
+  const int32 axis = size.X >= size.Y && size.X >= size.Z ? 0
+                     : size.Y >= size.Z                   ? 1
+                                                          : 2;
+  const int32 middle = begin + (end - begin) / 2;
+  std::nth_element(
+      this->_order.GetData() + begin,
+      this->_order.GetData() + middle,
+      this->_order.GetData() + end,
+      [this, axis](int32 a, int32 b) {
+        return this->_spheres[a].center[axis] < this->_spheres[b].center[axis];
+      });
+
+  this->buildNode(begin, middle);
+  const int32 secondChild = this->buildNode(middle, end);
+  this->_nodes[nodeIndex] = Node{bounds, secondChild, 0};
+  return nodeIndex;
+}
+
+int32 CesiumSubLevelIndex::findClosestContaining(
+    const FVector& position,
+    int32 excludedIndex) const {
+  if (this->_nodes.Num() == 0) {
+    return INDEX_NONE;
+  }
+
+  int32 closest = INDEX_NONE;
+  double closestDistance = std::numeric_limits<double>::max();
+
+  TArray<int32, TInlineAllocator<64>> stack;
+  stack.Add(0);
+  while (stack.Num() > 0) {
+    const int32 nodeIndex = stack.Pop(false);
+    const Node& node = this->_nodes[nodeIndex];
+    if (!node.bounds.IsInsideOrOn(position)) {
+      continue;
+    }
+
+    if (node.count == 0) {
+      stack.Add(nodeIndex + 1);
+      stack.Add(node.first);
+      continue;
+    }
+
+    for (int32 i = node.first; i < node.first + node.count; ++i) {
+      const int32 sphereIndex = this->_order[i];
+      if (sphereIndex == excludedIndex) {
+        continue;
+      }
+
+      const Sphere& sphere = this->_spheres[sphereIndex];
+      const double distance = FVector::Distance(sphere.center, position);
+      if (distance < sphere.radius && distance < closestDistance) {
+        closest = sphereIndex;
+        closestDistance = distance;
+      }
+    }
+  }
+
+  return closest;
+}
@@ -0,0 +1,60 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "Math/Vector.h"
+
+/**
+ * A bounding volume hierarchy over the load spheres of sub-levels, in
+ * Earth-Centered, Earth-Fixed coordinates, which finds the sub-level that
+ * should be active at a position without testing every sub-level.
+ */
+class CesiumSubLevelIndex {
+public:
+  /**
+   * A sphere in the index. A position activates the sphere's sub-level when
+   * it is closer to the center than the radius.
+   */
+  struct Sphere {
+    FVector center;
+    double radius;
+  };
+
+  /**
+   * Rebuilds the index from the given spheres. Queries return indices into
+   * this array.
+   */
+  void build(TArray<Sphere>&& spheres);
+
+  /**
+   * Finds the sphere with the closest center that contains the given
+   * position, ignoring the sphere with the excluded index.
+   *
+   * @return The index of the sphere, or INDEX_NONE if no sphere contains the
+   * position.
+   */
+  int32 findClosestContaining(
+      const FVector& position,
+      int32 excludedIndex = INDEX_NONE) const;
+
+  int32 getSphereCount() const { return this->_spheres.Num(); }
+
+private:
+  struct Node {
+    FBox bounds;
+    // For a leaf, the first entry in _order and the number of entries.
+    // Otherwise, the index of the second child, and 0. The first child
+    // always directly follows its parent.
+    int32 first;
+    int32 count;
+  };
+
+  int32 buildNode(int32 begin, int32 end);
+
+  TArray<Sphere> _spheres;
+  // The sphere indices, ordered so that each leaf's spheres are contiguous.
+  TArray<int32> _order;
+  TArray<Node> _nodes;
+};
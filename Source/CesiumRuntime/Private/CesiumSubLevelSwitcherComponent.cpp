@@ -1,6 +1,8 @@
 #include "CesiumSubLevelSwitcherComponent.h"
 #include "CesiumRuntime.h"
 #include "CesiumSubLevelComponent.h"
+#include "CesiumSubLevelIndex.h"
+#include "CesiumWgs84Ellipsoid.h"
 #include "Engine/LevelStreaming.h"
 #include "Engine/World.h"
 #include "LevelInstance/LevelInstanceActor.h"
@@ -25,15 +27,32 @@ FString GetActorLabel(AActor* pActor) {
 #endif
 }
 
+/**
+ * Determines whether a sub-level is neither loaded, nor loading or unloading.
+ */
+bool IsUnloaded(ULevelStreaming* pStreaming) {
+  if (!IsValid(pStreaming))
+    return true;
+
+  ULevelStreaming::ECurrentState state = pStreaming->GetCurrentState();
+  return (state == ULevelStreaming::ECurrentState::Removed ||
+          state == ULevelStreaming::ECurrentState::Unloaded) &&
+         !pStreaming->ShouldBeLoaded();
+}
+
 } // namespace
 
 UCesiumSubLevelSwitcherComponent::UCesiumSubLevelSwitcherComponent() {
   this->PrimaryComponentTick.bCanEverTick = true;
 }
 
+UCesiumSubLevelSwitcherComponent::~UCesiumSubLevelSwitcherComponent() =
+    default;
+
 void UCesiumSubLevelSwitcherComponent::RegisterSubLevel(
     ALevelInstance* pSubLevel) noexcept {
   this->_sublevels.AddUnique(pSubLevel);
+  this->_subLevelIndexIsValid = false;
 
   // Do extra checks on the next tick so that if we're in a game and this level
   // is already loaded and shouldn't be, we can unload it.
@@ -53,6 +72,7 @@ void UCesiumSubLevelSwitcherComponent::RegisterSubLevel(
 void UCesiumSubLevelSwitcherComponent::UnregisterSubLevel(
     ALevelInstance* pSubLevel) noexcept {
   this->_sublevels.Remove(pSubLevel);
+  this->_subLevelIndexIsValid = false;
 
   // Next tick, we need to check if the target is still registered, in case this
   // method call just removed it. But we can't actually do the check here
@@ -79,6 +99,56 @@ UCesiumSubLevelSwitcherComponent::GetCurrentSubLevel() const noexcept {
   return this->_pCurrent.Get();
 }
 
+ALevelInstance*
+UCesiumSubLevelSwitcherComponent::FindSubLevelAtEarthCenteredEarthFixedPosition(
+    const FVector& EarthCenteredEarthFixedPosition,
+    const ALevelInstance* Excluded) {
+  if (!this->_pSubLevelIndex) {
+    this->_pSubLevelIndex = MakeUnique<CesiumSubLevelIndex>();
+  }
+
+  if (!this->_subLevelIndexIsValid) {
+    TArray<CesiumSubLevelIndex::Sphere> spheres;
+    this->_indexedSubLevels.Reset();
+    for (const TWeakObjectPtr<ALevelInstance>& pWeak : this->_sublevels) {
+      ALevelInstance* pSubLevel = pWeak.Get();
+      if (!IsValid(pSubLevel))
+        continue;
+
+      UCesiumSubLevelComponent* pComponent =
+          pSubLevel->FindComponentByClass<UCesiumSubLevelComponent>();
+      if (!IsValid(pComponent) || !pComponent->GetEnabled())
+        continue;
+
+      spheres.Add(CesiumSubLevelIndex::Sphere{
+          UCesiumWgs84Ellipsoid::
+              LongitudeLatitudeHeightToEarthCenteredEarthFixed(FVector(
+                  pComponent->GetOriginLongitude(),
+                  pComponent->GetOriginLatitude(),
+                  pComponent->GetOriginHeight())),
+          pComponent->GetLoadRadius()});
+      this->_indexedSubLevels.Add(pSubLevel);
+    }
+
+    this->_pSubLevelIndex->build(MoveTemp(spheres));
+    this->_subLevelIndexIsValid = true;
+  }
+
+  int32 excludedIndex = INDEX_NONE;
+  if (Excluded) {
+    excludedIndex = this->_indexedSubLevels.IndexOfByPredicate(
+        [Excluded](const TWeakObjectPtr<ALevelInstance>& pWeak) {
+          return pWeak.Get() == Excluded;
+        });
+  }
+
+  const int32 foundIndex = this->_pSubLevelIndex->findClosestContaining(
+      EarthCenteredEarthFixedPosition,
+      excludedIndex);
+  return foundIndex == INDEX_NONE ? nullptr
+                                  : this->_indexedSubLevels[foundIndex].Get();
+}
+
 ALevelInstance*
 UCesiumSubLevelSwitcherComponent::GetTargetSubLevel() const noexcept {
   return this->_pTarget.Get();
@@ -97,8 +167,48 @@ void UCesiumSubLevelSwitcherComponent::SetTargetSubLevel(
       UE_LOG(LogCesium, Display, TEXT("New target sub-level <none>"));
     }
 
+    ALevelInstance* pOldTarget = this->_pTarget.Get();
     this->_pTarget = pLevelInstance;
     this->_isTransitioningSubLevels = true;
+
+    // An old target may have been loaded, hidden, while the current sub-level
+    // was still shown. Nothing else would unload it.
+    UWorld* pWorld = this->GetWorld();
+    if (IsValid(pOldTarget) && pOldTarget != this->_pCurrent &&
+        pOldTarget != this->_pPreload && IsValid(pWorld) &&
+        pWorld->IsGameWorld() &&
+        !IsUnloaded(this->_getLevelStreamingForSubLevel(pOldTarget))) {
+      pOldTarget->UnloadLevelInstance();
+    }
+  }
+}
+
+ALevelInstance*
+UCesiumSubLevelSwitcherComponent::GetPreloadSubLevel() const noexcept {
+  return this->_pPreload.Get();
+}
+
+void UCesiumSubLevelSwitcherComponent::SetPreloadSubLevel(
+    ALevelInstance* pLevelInstance) noexcept {
+  if (this->_pPreload == pLevelInstance) {
+    return;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Verbose,
+      TEXT("New preload sub-level %s."),
+      *GetActorLabel(pLevelInstance));
+
+  ALevelInstance* pOldPreload = this->_pPreload.Get();
+  this->_pPreload = pLevelInstance;
+
+  UWorld* pWorld = this->GetWorld();
+  if (IsValid(pOldPreload) && pOldPreload != this->_pCurrent &&
+      pOldPreload != this->_pTarget && IsValid(pWorld) &&
+      pWorld->IsGameWorld() &&
+      !IsUnloaded(this->_getLevelStreamingForSubLevel(pOldPreload))) {
+    pOldPreload->UnloadLevelInstance();
   }
 }
 
@@ -126,7 +236,8 @@ void UCesiumSubLevelSwitcherComponent::TickComponent(
         if (!IsValid(pSubLevel))
           continue;
 
-        if (pSubLevel == this->_pCurrent || pSubLevel == this->_pTarget)
+        if (pSubLevel == this->_pCurrent || pSubLevel == this->_pTarget ||
+            pSubLevel == this->_pPreload)
           continue;
 
         ULevelStreaming* pStreaming =
@@ -173,6 +284,7 @@ void UCesiumSubLevelSwitcherComponent::TickComponent(
 #endif
 
   this->_updateSubLevelStateGame();
+  this->_updatePreloadSubLevelGame();
 }
 
 void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
@@ -190,6 +302,10 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
 
   this->_isTransitioningSubLevels = false;
 
+  // With room for more than one loaded sub-level, the target can be shown as
+  // soon as the current one is hidden, instead of once it's unloaded.
+  const bool allowOverlap = this->MaximumLoadedSubLevels > 1;
+
   if (this->_pCurrent != nullptr) {
     // Work toward unloading the current level.
 
@@ -220,8 +336,20 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
           *GetActorLabel(this->_pCurrent.Get()));
       this->_isTransitioningSubLevels = true;
       break;
-    case ULevelStreaming::ECurrentState::FailedToLoad:
     case ULevelStreaming::ECurrentState::LoadedNotVisible:
+      if (allowOverlap && !pStreaming->ShouldBeLoaded()) {
+        // The unload has started and the level is already hidden, so the
+        // target can be shown while this finishes in the background.
+        UE_LOG(
+            LogCesium,
+            Display,
+            TEXT("Hid sub-level %s, which will finish unloading later."),
+            *GetActorLabel(this->_pCurrent.Get()));
+        this->_pCurrent = nullptr;
+        break;
+      }
+      [[fallthrough]];
+    case ULevelStreaming::ECurrentState::FailedToLoad:
     case ULevelStreaming::ECurrentState::LoadedVisible:
       UE_LOG(
           LogCesium,
@@ -243,6 +371,12 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
     }
   }
 
+  if (allowOverlap && this->_pCurrent != nullptr &&
+      this->_pTarget != nullptr) {
+    // Load the target in the background while the current level unloads.
+    this->_loadSubLevelHidden(this->_pTarget.Get());
+  }
+
   if (this->_pCurrent == nullptr && this->_pTarget != nullptr) {
     // Now that the current level is unloaded, work toward loading the target
     // level.
@@ -296,6 +430,10 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
       // already. If we are, wait longer.
       if ((IsValid(pStreaming) && pStreaming->ShouldBeLoaded()) ||
           this->_pTarget.Get()->GetWorldAsset().IsNull()) {
+        // The level may have been loaded hidden, ahead of time.
+        if (IsValid(pStreaming) && !pStreaming->ShouldBeVisible()) {
+          pStreaming->SetShouldBeVisible(true);
+        }
         this->_pCurrent = this->_pTarget;
       } else {
         this->_isTransitioningSubLevels = true;
@@ -316,6 +454,54 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
   }
 }
 
+void UCesiumSubLevelSwitcherComponent::_updatePreloadSubLevelGame() {
+  ALevelInstance* pPreload = this->_pPreload.Get();
+  if (!IsValid(pPreload) || pPreload == this->_pCurrent ||
+      pPreload == this->_pTarget) {
+    return;
+  }
+
+  this->_loadSubLevelHidden(pPreload);
+}
+
+int32 UCesiumSubLevelSwitcherComponent::_countLoadedSubLevels() const {
+  int32 count = 0;
+  for (const TWeakObjectPtr<ALevelInstance>& pWeak : this->_sublevels) {
+    ALevelInstance* pSubLevel = pWeak.Get();
+    if (IsValid(pSubLevel) &&
+        !IsUnloaded(this->_getLevelStreamingForSubLevel(pSubLevel))) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+void UCesiumSubLevelSwitcherComponent::_loadSubLevelHidden(
+    ALevelInstance* pSubLevel) {
+  if (pSubLevel->GetWorldAsset().IsNull()) {
+    return;
+  }
+
+  ULevelStreaming* pStreaming = this->_getLevelStreamingForSubLevel(pSubLevel);
+  if (IsValid(pStreaming) && pStreaming->ShouldBeLoaded()) {
+    // Level instances are always loaded visible, so hide this one as soon as
+    // its streaming level exists. It is still loading by then, so it's never
+    // shown.
+    if (pStreaming->ShouldBeVisible()) {
+      pStreaming->SetShouldBeVisible(false);
+    }
+  } else if (
+      IsUnloaded(pStreaming) &&
+      this->_countLoadedSubLevels() < this->MaximumLoadedSubLevels) {
+    UE_LOG(
+        LogCesium,
+        Log,
+        TEXT("Starting background load of sub-level %s."),
+        *GetActorLabel(pSubLevel));
+    pSubLevel->LoadLevelInstance();
+  }
+}
+
 #if WITH_EDITOR
 
 void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateEditor() {
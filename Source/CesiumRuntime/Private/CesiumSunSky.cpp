@@ -117,6 +117,7 @@ void ACesiumSunSky::_handleTransformUpdated(
   // method will be called on georeference change. We need to update the sun
   // position for the new UE coordinate system.
   this->UpdateSun();
+  this->_atmosphereRadiusValid = false;
 }
 
 void ACesiumSunSky::OnConstruction(const FTransform& Transform) {
@@ -249,7 +250,8 @@ void ACesiumSunSky::Serialize(FArchive& Ar) {
 void ACesiumSunSky::Tick(float DeltaSeconds) {
   Super::Tick(DeltaSeconds);
 
-  if (this->UpdateAtmosphereAtRuntime) {
+  if (this->UpdateAtmosphereAtRuntime &&
+      this->_shouldUpdateAtmosphereRadius()) {
     this->UpdateAtmosphereRadius();
   }
 
@@ -488,6 +490,33 @@ FVector getViewLocation(UWorld* pWorld) {
 
 } // namespace
 
+bool ACesiumSunSky::_shouldUpdateAtmosphereRadius() {
+  if (this->AtmosphereUpdateDistance <= 0.0) {
+    return true;
+  }
+
+  const FVector viewLocation = getViewLocation(this->GetWorld());
+  const double scale = this->_computeScale();
+
+  // Unreal units are centimeters.
+  const double threshold = this->AtmosphereUpdateDistance * 100.0;
+  if (this->_atmosphereRadiusValid && scale == this->_lastAtmosphereScale &&
+      this->InscribedGroundThreshold == this->_lastInscribedGroundThreshold &&
+      this->CircumscribedGroundThreshold ==
+          this->_lastCircumscribedGroundThreshold &&
+      FVector::DistSquared(viewLocation, this->_lastAtmosphereViewLocation) <
+          threshold * threshold) {
+    return false;
+  }
+
+  this->_atmosphereRadiusValid = true;
+  this->_lastAtmosphereViewLocation = viewLocation;
+  this->_lastAtmosphereScale = scale;
+  this->_lastInscribedGroundThreshold = this->InscribedGroundThreshold;
+  this->_lastCircumscribedGroundThreshold = this->CircumscribedGroundThreshold;
+  return true;
+}
+
 void ACesiumSunSky::UpdateAtmosphereRadius() {
   // This Actor is located at the center of the Earth (the CesiumGlobeAnchor
   // keeps it there), so we ignore this Actor's transform and use only its
@@ -516,11 +545,18 @@ void ACesiumSunSky::UpdateAtmosphereRadius() {
         maxRadius * this->_computeScale() / 1000.0);
   } else {
     // Find the ellipsoid radius 100m below the surface at this location. See
-    // the comment at the top of this file.
-    glm::dvec3 ecef =
-        CesiumGeospatial::Ellipsoid::WGS84.cartographicToCartesian(
-            CesiumGeospatial::Cartographic::fromDegrees(llh.X, llh.Y, -100.0));
-    double minRadius = glm::length(ecef);
+    // the comment at the top of this file. It only depends on the latitude.
+    if (this->_minimumRadius <= 0.0 || llh.Y != this->_minimumRadiusLatitude) {
+      glm::dvec3 ecef =
+          CesiumGeospatial::Ellipsoid::WGS84.cartographicToCartesian(
+              CesiumGeospatial::Cartographic::fromDegrees(
+                  llh.X,
+                  llh.Y,
+                  -100.0));
+      this->_minimumRadius = glm::length(ecef);
+      this->_minimumRadiusLatitude = llh.Y;
+    }
+    double minRadius = this->_minimumRadius;
 
     if (llh.Z / 1000.0 < this->InscribedGroundThreshold) {
       this->SetSkyAtmosphereGroundRadius(
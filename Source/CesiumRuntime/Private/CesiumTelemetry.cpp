@@ -0,0 +1,489 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTelemetry.h"
+#include "Async/Async.h"
+#include "CesiumContentDecoding.h"
+#include "CesiumDecodedContentCache.h"
+#include "CesiumFrameBudget.h"
+#include "CesiumMemoryAccounting.h"
+#include "CesiumPreparedMeshCache.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTilePipelineStatistics.h"
+#include "CesiumTilePipelineTimings.h"
+#include "HAL/FileManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "Tasks/Task.h"
+#include "Tickable.h"
+#include "UnrealAssetAccessor.h"
+#include "UnrealCacheDatabase.h"
+
+namespace {
+
+// The largest StatsD payload, which fits in a datagram on any network.
+constexpr int32 MaximumStatsDPayloadBytes = 1432;
+
+// Formats a counter's value without an exponent or needless fractional
+// digits.
+FString formatValue(double value) { return FString::SanitizeFloat(value, 0); }
+
+FString escapeJson(const FString& text) {
+  return text.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+}
+
+void addStageCounters(
+    TArray<CesiumTelemetryCounter>& counters,
+    const TCHAR* stage,
+    const FCesiumTilePipelineStageStatistics& statistics) {
+  const FString prefix = FString::Printf(TEXT("tile_pipeline.%s."), stage);
+  counters.Add({prefix + TEXT("count"), double(statistics.Count)});
+  counters.Add({prefix + TEXT("average_ms"), statistics.AverageMilliseconds});
+  counters.Add({prefix + TEXT("median_ms"), statistics.MedianMilliseconds});
+  counters.Add({prefix + TEXT("p95_ms"), statistics.P95Milliseconds});
+  counters.Add({prefix + TEXT("maximum_ms"), statistics.MaximumMilliseconds});
+}
+
+void addDecodeCounters(
+    TArray<CesiumTelemetryCounter>& counters,
+    const TCHAR* codecName,
+    CesiumContentDecoding::Codec codec) {
+  const CesiumContentDecoding::Statistics statistics =
+      CesiumContentDecoding::getStatistics(codec);
+  const FString prefix = FString::Printf(TEXT("decode.%s."), codecName);
+  counters.Add({prefix + TEXT("count"), double(statistics.count)});
+  counters.Add(
+      {prefix + TEXT("average_ms"),
+       statistics.count > 0
+           ? statistics.totalMilliseconds / double(statistics.count)
+           : 0.0});
+  counters.Add({prefix + TEXT("maximum_ms"), statistics.maximumMilliseconds});
+}
+
+// Samples the counters every "Telemetry Interval" seconds, and writes them to
+// the sinks in a chain of background tasks, so that each sink gets the
+// samples one at a time and in order.
+class TelemetryExporter : FTickableGameObject {
+public:
+  static TelemetryExporter& get() {
+    static TelemetryExporter exporter;
+    return exporter;
+  }
+
+  TArray<TSharedRef<ICesiumTelemetrySink>> sinks;
+
+  void waitForWrites() { this->_lastWrite.Wait(); }
+
+  void Tick(float DeltaTime) override {
+    ++this->_frames;
+    this->_elapsedSeconds += DeltaTime;
+
+    const float interval = GetDefault<UCesiumRuntimeSettings>()->TelemetryInterval;
+    if (interval <= 0.0f || this->sinks.IsEmpty() ||
+        this->_elapsedSeconds < interval) {
+      return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SampleTelemetry)
+
+    TArray<CesiumTelemetryCounter> counters = CesiumTelemetry::sampleCounters();
+    this->addRates(counters);
+
+    const double timestampSeconds =
+        double((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks()) /
+        double(ETimespan::TicksPerSecond);
+    this->_lastWrite = UE::Tasks::Launch(
+        TEXT("Cesium::WriteTelemetry"),
+        [sinks = this->sinks, timestampSeconds, counters = MoveTemp(counters)]() {
+          for (const TSharedRef<ICesiumTelemetrySink>& pSink : sinks) {
+            pSink->write(timestampSeconds, counters);
+          }
+        },
+        UE::Tasks::Prerequisites(this->_lastWrite),
+        UE::Tasks::ETaskPriority::BackgroundLow);
+  }
+
+  ETickableTickType GetTickableTickType() const override {
+    return ETickableTickType::Always;
+  }
+  bool IsTickableWhenPaused() const override { return true; }
+  bool IsTickableInEditor() const override { return true; }
+  TStatId GetStatId() const override { return TStatId(); }
+
+private:
+  // Adds the counters that are rates over the interval since the last
+  // sample, and starts the next interval.
+  void addRates(TArray<CesiumTelemetryCounter>& counters) {
+    const UnrealCacheDatabase::Statistics cacheStatistics =
+        UnrealCacheDatabase::getStatistics();
+    const int64 bytesReceived = UnrealAssetAccessor::getTotalBytesReceived();
+    const double loadingMilliseconds =
+        CesiumFrameBudget::getTotalMainThreadLoadingTime();
+
+    const double seconds = FMath::Max(this->_elapsedSeconds, 1e-6);
+    const int64 hits = cacheStatistics.hits - this->_lastCacheHits;
+    const int64 misses = cacheStatistics.misses - this->_lastCacheMisses;
+    counters.Add(
+        {TEXT("request_cache.hit_rate"),
+         hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0});
+    counters.Add(
+        {TEXT("network.bytes_per_second"),
+         double(bytesReceived - this->_lastBytesReceived) / seconds});
+    counters.Add(
+        {TEXT("frame.average_ms"),
+         this->_frames > 0 ? this->_elapsedSeconds * 1000.0 / this->_frames
+                           : 0.0});
+    counters.Add(
+        {TEXT("frame.tile_loading_average_ms"),
+         this->_frames > 0
+             ? (loadingMilliseconds - this->_lastLoadingMilliseconds) /
+                   this->_frames
+             : 0.0});
+
+    this->_lastCacheHits = cacheStatistics.hits;
+    this->_lastCacheMisses = cacheStatistics.misses;
+    this->_lastBytesReceived = bytesReceived;
+    this->_lastLoadingMilliseconds = loadingMilliseconds;
+    this->_elapsedSeconds = 0.0;
+    this->_frames = 0;
+  }
+
+  UE::Tasks::FTask _lastWrite;
+
+  double _elapsedSeconds = 0.0;
+  int32 _frames = 0;
+  int64 _lastCacheHits = 0;
+  int64 _lastCacheMisses = 0;
+  int64 _lastBytesReceived = 0;
+  double _lastLoadingMilliseconds = 0.0;
+};
+
+} // namespace
+
+CesiumCsvTelemetrySink::CesiumCsvTelemetrySink(const FString& filename)
+    : _filename(filename), _columns() {}
+
+void CesiumCsvTelemetrySink::write(
+    double timestampSeconds,
+    const TArray<CesiumTelemetryCounter>& counters) {
+  TArray<FString> columns;
+  columns.Reserve(counters.Num());
+  for (const CesiumTelemetryCounter& counter : counters) {
+    columns.Add(counter.name);
+  }
+
+  FString text;
+  if (columns != this->_columns) {
+    text += TEXT("timestamp,") + FString::Join(columns, TEXT(",")) + TEXT("\n");
+    this->_columns = MoveTemp(columns);
+  }
+
+  text += FString::Printf(TEXT("%.3f"), timestampSeconds);
+  for (const CesiumTelemetryCounter& counter : counters) {
+    text += TEXT(",") + formatValue(counter.value);
+  }
+  text += TEXT("\n");
+
+  FFileHelper::SaveStringToFile(
+      text,
+      *this->_filename,
+      FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
+      &IFileManager::Get(),
+      FILEWRITE_Append);
+}
+
+class CesiumStatsDTelemetrySink::Socket {
+public:
+  Socket(const FString& server) {
+    FString host = server;
+    int32 port = 8125;
+    FString portString;
+    if (server.Split(
+            TEXT(":"),
+            &host,
+            &portString,
+            ESearchCase::IgnoreCase,
+            ESearchDir::FromEnd)) {
+      port = FCString::Atoi(*portString);
+    }
+
+    ISocketSubsystem* pSubsystem =
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (!pSubsystem) {
+      return;
+    }
+
+    FAddressInfoResult addresses = pSubsystem->GetAddressInfo(
+        *host,
+        nullptr,
+        EAddressInfoFlags::Default,
+        NAME_None,
+        ESocketType::SOCKTYPE_Datagram);
+    if (addresses.ReturnCode != SE_NO_ERROR || addresses.Results.IsEmpty()) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("Could not resolve the StatsD server %s for telemetry."),
+          *server);
+      return;
+    }
+
+    this->_pAddress = addresses.Results[0].Address;
+    this->_pAddress->SetPort(port);
+    this->_pSocket = pSubsystem->CreateSocket(
+        NAME_DGram,
+        TEXT("CesiumStatsDTelemetry"),
+        this->_pAddress->GetProtocolType());
+  }
+
+  ~Socket() {
+    if (this->_pSocket) {
+      this->_pSocket->Close();
+      ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)
+          ->DestroySocket(this->_pSocket);
+    }
+  }
+
+  void send(const FString& payload) {
+    if (!this->_pSocket) {
+      return;
+    }
+    const FTCHARToUTF8 utf8(*payload);
+    int32 bytesSent = 0;
+    this->_pSocket->SendTo(
+        reinterpret_cast<const uint8*>(utf8.Get()),
+        utf8.Length(),
+        bytesSent,
+        *this->_pAddress);
+  }
+
+private:
+  TSharedPtr<FInternetAddr> _pAddress;
+  FSocket* _pSocket = nullptr;
+};
+
+CesiumStatsDTelemetrySink::CesiumStatsDTelemetrySink(
+    const FString& server,
+    const FString& prefix)
+    : _server(server), _prefix(prefix), _pSocket() {}
+
+CesiumStatsDTelemetrySink::~CesiumStatsDTelemetrySink() = default;
+
+void CesiumStatsDTelemetrySink::write(
+    double timestampSeconds,
+    const TArray<CesiumTelemetryCounter>& counters) {
+  // The server's name is resolved on the first write, so that a slow lookup
+  // doesn't hold up the game thread.
+  if (!this->_pSocket) {
+    this->_pSocket = MakeUnique<Socket>(this->_server);
+  }
+
+  for (const FString& payload :
+       formatPayloads(this->_prefix, counters, MaximumStatsDPayloadBytes)) {
+    this->_pSocket->send(payload);
+  }
+}
+
+/*static*/ TArray<FString> CesiumStatsDTelemetrySink::formatPayloads(
+    const FString& prefix,
+    const TArray<CesiumTelemetryCounter>& counters,
+    int32 maximumPayloadBytes) {
+  TArray<FString> payloads;
+  FString payload;
+  for (const CesiumTelemetryCounter& counter : counters) {
+    const FString line = FString::Printf(
+        TEXT("%s%s%s:%s|g\n"),
+        *prefix,
+        prefix.IsEmpty() ? TEXT("") : TEXT("."),
+        *counter.name,
+        *formatValue(counter.value));
+    if (!payload.IsEmpty() &&
+        FTCHARToUTF8(*payload).Length() + FTCHARToUTF8(*line).Length() >
+            maximumPayloadBytes) {
+      payloads.Add(MoveTemp(payload));
+      payload.Reset();
+    }
+    payload += line;
+  }
+
+  if (!payload.IsEmpty()) {
+    payloads.Add(MoveTemp(payload));
+  }
+  return payloads;
+}
+
+CesiumOpenTelemetrySink::CesiumOpenTelemetrySink(
+    const FString& endpoint,
+    const FString& serviceName,
+    const FString& prefix)
+    : _endpoint(endpoint), _serviceName(serviceName), _prefix(prefix) {}
+
+void CesiumOpenTelemetrySink::write(
+    double timestampSeconds,
+    const TArray<CesiumTelemetryCounter>& counters) {
+  FString body =
+      formatJson(this->_serviceName, this->_prefix, timestampSeconds, counters);
+
+  // Only the request is made on the game thread, where the HTTP module
+  // expects it. Its response is ignored.
+  AsyncTask(
+      ENamedThreads::GameThread,
+      [endpoint = this->_endpoint, body = MoveTemp(body)]() {
+        if (!FHttpModule::IsAvailable()) {
+          return;
+        }
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
+            FHttpModule::Get().CreateRequest();
+        pRequest->SetURL(endpoint);
+        pRequest->SetVerb(TEXT("POST"));
+        pRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+        pRequest->SetContentAsString(body);
+        pRequest->ProcessRequest();
+      });
+}
+
+/*static*/ FString CesiumOpenTelemetrySink::formatJson(
+    const FString& serviceName,
+    const FString& prefix,
+    double timestampSeconds,
+    const TArray<CesiumTelemetryCounter>& counters) {
+  const FString timeUnixNano =
+      FString::Printf(TEXT("%llu"), uint64(timestampSeconds * 1e9));
+
+  TArray<FString> metrics;
+  metrics.Reserve(counters.Num());
+  for (const CesiumTelemetryCounter& counter : counters) {
+    metrics.Add(FString::Printf(
+        TEXT(
+            "{\"name\":\"%s%s%s\",\"gauge\":{\"dataPoints\":[{\"timeUnixNano\":\"%s\",\"asDouble\":%s}]}}"),
+        *escapeJson(prefix),
+        prefix.IsEmpty() ? TEXT("") : TEXT("."),
+        *escapeJson(counter.name),
+        *timeUnixNano,
+        *formatValue(counter.value)));
+  }
+
+  return FString::Printf(
+      TEXT(
+          "{\"resourceMetrics\":[{\"resource\":{\"attributes\":[{\"key\":\"service.name\",\"value\":{\"stringValue\":\"%s\"}}]},\"scopeMetrics\":[{\"scope\":{\"name\":\"CesiumForUnreal\"},\"metrics\":[%s]}]}]}"),
+      *escapeJson(serviceName),
+      *FString::Join(metrics, TEXT(",")));
+}
+
+/*static*/ void
+CesiumTelemetry::addSink(const TSharedRef<ICesiumTelemetrySink>& pSink) {
+  TelemetryExporter::get().sinks.AddUnique(pSink);
+}
+
+/*static*/ void
+CesiumTelemetry::removeSink(const TSharedRef<ICesiumTelemetrySink>& pSink) {
+  TelemetryExporter::get().sinks.Remove(pSink);
+}
+
+/*static*/ TArray<CesiumTelemetryCounter> CesiumTelemetry::sampleCounters() {
+  TArray<CesiumTelemetryCounter> counters;
+
+  const FCesiumTilePipelineStatistics pipeline =
+      CesiumTilePipelineHistograms::getGlobal().getStatistics();
+  addStageCounters(counters, TEXT("request"), pipeline.Request);
+  addStageCounters(counters, TEXT("parse"), pipeline.Parse);
+  addStageCounters(counters, TEXT("load_thread"), pipeline.LoadThread);
+  addStageCounters(
+      counters,
+      TEXT("main_thread_queue"),
+      pipeline.MainThreadQueue);
+  addStageCounters(counters, TEXT("main_thread"), pipeline.MainThread);
+  addStageCounters(counters, TEXT("first_render"), pipeline.FirstRender);
+  addStageCounters(counters, TEXT("total"), pipeline.Total);
+
+  const UnrealCacheDatabase::Statistics cache =
+      UnrealCacheDatabase::getStatistics();
+  counters.Add({TEXT("request_cache.hits"), double(cache.hits)});
+  counters.Add({TEXT("request_cache.misses"), double(cache.misses)});
+  counters.Add({TEXT("request_cache.bytes_written"), double(cache.bytesWritten)});
+  counters.Add(
+      {TEXT("decoded_content_cache.hits"),
+       double(CesiumDecodedContentCache::get().getHitCount())});
+  addDecodeCounters(counters, TEXT("draco"), CesiumContentDecoding::Draco);
+  addDecodeCounters(counters, TEXT("meshopt"), CesiumContentDecoding::Meshopt);
+  addDecodeCounters(counters, TEXT("ktx2"), CesiumContentDecoding::Ktx2);
+  counters.Add(
+      {TEXT("decode.wait_ms"),
+       CesiumContentDecoding::getTotalWaitMilliseconds()});
+  if (CesiumPreparedMeshCache::isEnabled()) {
+    counters.Add(
+        {TEXT("prepared_mesh_cache.hits"),
+         double(CesiumPreparedMeshCache::get().getHitCount())});
+    counters.Add(
+        {TEXT("prepared_mesh_cache.misses"),
+         double(CesiumPreparedMeshCache::get().getMissCount())});
+  }
+  counters.Add(
+      {TEXT("network.bytes_received"),
+       double(UnrealAssetAccessor::getTotalBytesReceived())});
+
+  const FCesiumTilesetMemoryUsage& memory =
+      CesiumMemoryAccounting::getGlobalUsage();
+  counters.Add({TEXT("memory.mesh_cpu_bytes"), double(memory.MeshCpuBytes)});
+  counters.Add({TEXT("memory.mesh_gpu_bytes"), double(memory.MeshGpuBytes)});
+  counters.Add(
+      {TEXT("memory.physics_cpu_bytes"), double(memory.PhysicsCpuBytes)});
+  counters.Add(
+      {TEXT("memory.texture_gpu_bytes"), double(memory.TextureGpuBytes)});
+  counters.Add(
+      {TEXT("memory.metadata_texture_gpu_bytes"),
+       double(memory.MetadataTextureGpuBytes)});
+  counters.Add(
+      {TEXT("memory.raster_overlay_texture_gpu_bytes"),
+       double(memory.RasterOverlayTextureGpuBytes)});
+  counters.Add(
+      {TEXT("memory.material_cpu_bytes"), double(memory.MaterialCpuBytes)});
+  counters.Add({TEXT("memory.total_cpu_bytes"), double(memory.TotalCpuBytes)});
+  counters.Add({TEXT("memory.total_gpu_bytes"), double(memory.TotalGpuBytes)});
+
+  counters.Add({TEXT("frame.last_ms"), FApp::GetDeltaTime() * 1000.0});
+  counters.Add(
+      {TEXT("frame.tile_loading_total_ms"),
+       CesiumFrameBudget::getTotalMainThreadLoadingTime()});
+
+  return counters;
+}
+
+/*static*/ void CesiumTelemetry::startup() {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  const FString& prefix = pSettings->TelemetryMetricPrefix;
+
+  if (!pSettings->TelemetryCsvFile.IsEmpty()) {
+    FString filename = pSettings->TelemetryCsvFile;
+    if (FPaths::IsRelative(filename)) {
+      filename = FPaths::Combine(FPaths::ProjectSavedDir(), filename);
+    }
+    addSink(MakeShared<CesiumCsvTelemetrySink>(filename));
+  }
+
+  if (!pSettings->TelemetryStatsDServer.IsEmpty()) {
+    addSink(MakeShared<CesiumStatsDTelemetrySink>(
+        pSettings->TelemetryStatsDServer,
+        prefix));
+  }
+
+  if (!pSettings->TelemetryOpenTelemetryEndpoint.IsEmpty()) {
+    addSink(MakeShared<CesiumOpenTelemetrySink>(
+        pSettings->TelemetryOpenTelemetryEndpoint,
+        prefix,
+        prefix));
+  }
+}
+
+/*static*/ void CesiumTelemetry::shutdown() {
+  TelemetryExporter& exporter = TelemetryExporter::get();
+  exporter.waitForWrites();
+  exporter.sinks.Empty();
+}
@@ -0,0 +1,86 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureCache.h"
+#include "Engine/Texture2D.h"
+#include "Misc/ScopeLock.h"
+
+/*static*/ CesiumTextureCache& CesiumTextureCache::get() {
+  static CesiumTextureCache cache;
+  return cache;
+}
+
+bool CesiumTextureCache::contains(uint64 contentKey) const {
+  FScopeLock lock(&this->_contentKeyLock);
+  return this->_byContentKey.Contains(contentKey);
+}
+
+UTexture2D* CesiumTextureCache::find(uint64 contentKey) const {
+  check(IsInGameThread());
+
+  FScopeLock lock(&this->_contentKeyLock);
+  const TObjectPtr<UTexture2D>* ppTexture =
+      this->_byContentKey.Find(contentKey);
+  return ppTexture && IsValid(*ppTexture) ? ppTexture->Get() : nullptr;
+}
+
+void CesiumTextureCache::addUse(UTexture2D* pTexture, uint64 contentKey) {
+  check(IsInGameThread());
+
+  if (!pTexture) {
+    return;
+  }
+
+  Entry* pEntry = this->_entries.Find(pTexture);
+  if (pEntry) {
+    ++pEntry->uses;
+    return;
+  }
+
+  // Only the first texture with a given key can be found by it. Another one
+  // can be created with the same key if two tiles with the same image are
+  // loaded at the same time, but it is still counted.
+  if (contentKey != 0) {
+    FScopeLock lock(&this->_contentKeyLock);
+    if (this->_byContentKey.Contains(contentKey)) {
+      contentKey = 0;
+    } else {
+      this->_byContentKey.Add(contentKey, pTexture);
+    }
+  }
+
+  this->_entries.Add(pTexture, Entry{contentKey, 1});
+}
+
+bool CesiumTextureCache::releaseUse(UTexture* pTexture) {
+  check(IsInGameThread());
+
+  Entry* pEntry = this->_entries.Find(pTexture);
+  if (!pEntry) {
+    return false;
+  }
+
+  if (--pEntry->uses > 0) {
+    return true;
+  }
+
+  if (pEntry->contentKey != 0) {
+    FScopeLock lock(&this->_contentKeyLock);
+    this->_byContentKey.Remove(pEntry->contentKey);
+  }
+  this->_entries.Remove(pTexture);
+  return false;
+}
+
+void CesiumTextureCache::AddReferencedObjects(FReferenceCollector& Collector) {
+  // Textures in use are referenced by their materials already, but one that
+  // can be found by its content key must stay alive until the game thread
+  // adds the use for a tile that found it.
+  FScopeLock lock(&this->_contentKeyLock);
+  for (TPair<uint64, TObjectPtr<UTexture2D>>& pair : this->_byContentKey) {
+    Collector.AddReferencedObject(pair.Value);
+  }
+}
+
+FString CesiumTextureCache::GetReferencerName() const {
+  return TEXT("CesiumTextureCache");
+}
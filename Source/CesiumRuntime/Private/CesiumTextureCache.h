@@ -0,0 +1,79 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectPtr.h"
+
+class UTexture;
+class UTexture2D;
+
+/**
+ * Counts the uses of the textures created for glTF materials, so that a
+ * texture can be shared by every primitive that uses it, and keeps the
+ * textures whose image content is known so that tiles with identical images
+ * can share them too.
+ *
+ * Each time a primitive's material is given a texture, that is a use of the
+ * texture, and each time the primitive releases it, the use ends. A texture
+ * is only destroyed when its last use ends. A texture that was created with
+ * a content key can be found by that key while it is in use, so a tile that
+ * loads an identical image doesn't need to create a texture for it at all.
+ *
+ * Content keys may be looked up from any thread. All other functions must be
+ * called from the game thread.
+ */
+class CesiumTextureCache : public FGCObject {
+public:
+  /**
+   * Gets the cache shared by all tilesets.
+   */
+  static CesiumTextureCache& get();
+
+  /**
+   * Determines whether a texture with the given content key is currently in
+   * use. This may be called from any thread, but the texture may stop being
+   * used before the game thread looks for it with {@link find}.
+   */
+  bool contains(uint64 contentKey) const;
+
+  /**
+   * Finds a texture with the given content key that is in use, or returns
+   * nullptr if there is none.
+   */
+  UTexture2D* find(uint64 contentKey) const;
+
+  /**
+   * Adds a use of the given texture. If the content key is not 0, and no
+   * other texture in use has that key, the texture can be found by the key
+   * until its last use ends.
+   */
+  void addUse(UTexture2D* pTexture, uint64 contentKey);
+
+  /**
+   * Ends a use of the given texture.
+   *
+   * @return True if the texture is still in use, and so must not be
+   * destroyed. False if this was its last use, or the texture's uses are not
+   * counted.
+   */
+  bool releaseUse(UTexture* pTexture);
+
+  // FGCObject overrides
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  struct Entry {
+    uint64 contentKey;
+    int32 uses;
+  };
+
+  TMap<UTexture*, Entry> _entries;
+
+  // Guards _byContentKey, which is read from any thread.
+  mutable FCriticalSection _contentKeyLock;
+  TMap<uint64, TObjectPtr<UTexture2D>> _byContentKey;
+};
@@ -0,0 +1,170 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureCompression.h"
+#include "CesiumRuntime.h"
+#include "PixelFormat.h"
+#include <CesiumGltf/ImageCesium.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#define STB_DXT_STATIC
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+using namespace CesiumGltf;
+
+namespace {
+
+constexpr int32 BlockSize = 4;
+
+bool hasTransparency(const ImageCesium& image) {
+  constexpr size_t BytesPerPixel = 4;
+  const std::vector<std::byte>& pixels = image.pixelData;
+  for (size_t i = 3; i < pixels.size(); i += BytesPerPixel) {
+    if (pixels[i] != std::byte(255)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Compresses one mip of an RGBA8 image to BC1 or BC3, or of an R8 image to
+ * BC4. Blocks that extend past the edge of a small mip repeat the mip's last
+ * row and column.
+ */
+void compressMip(
+    const std::byte* pSource,
+    int32 width,
+    int32 height,
+    size_t bytesPerPixel,
+    bool alpha,
+    std::byte* pDestination) {
+  const bool singleChannel = bytesPerPixel == 1;
+  const int32 blockBytes = alpha && !singleChannel ? 16 : 8;
+  unsigned char block[BlockSize * BlockSize * 4];
+
+  for (int32 blockY = 0; blockY < height; blockY += BlockSize) {
+    for (int32 blockX = 0; blockX < width; blockX += BlockSize) {
+      for (int32 y = 0; y < BlockSize; ++y) {
+        const int32 sourceY = std::min(blockY + y, height - 1);
+        for (int32 x = 0; x < BlockSize; ++x) {
+          const int32 sourceX = std::min(blockX + x, width - 1);
+          const std::byte* pPixel =
+              pSource + (size_t(sourceY) * size_t(width) + size_t(sourceX)) *
+                            bytesPerPixel;
+          std::memcpy(
+              &block[(y * BlockSize + x) * bytesPerPixel],
+              pPixel,
+              bytesPerPixel);
+        }
+      }
+
+      if (singleChannel) {
+        stb_compress_bc4_block(
+            reinterpret_cast<unsigned char*>(pDestination),
+            block);
+      } else {
+        stb_compress_dxt_block(
+            reinterpret_cast<unsigned char*>(pDestination),
+            block,
+            alpha ? 1 : 0,
+            STB_DXT_NORMAL);
+      }
+      pDestination += blockBytes;
+    }
+  }
+}
+
+} // namespace
+
+namespace CesiumTextureCompression {
+
+bool isCompressionSupported() {
+  return GPixelFormats[PF_DXT1].Supported &&
+         GPixelFormats[PF_DXT5].Supported && GPixelFormats[PF_BC4].Supported;
+}
+
+bool compressImage(ImageCesium& image) { return compressImage(image, image); }
+
+bool compressImage(const ImageCesium& image, ImageCesium& compressedImage) {
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      (image.channels != 4 && image.channels != 1) ||
+      image.bytesPerChannel != 1 || image.width <= 0 || image.height <= 0 ||
+      (image.width % BlockSize) != 0 || (image.height % BlockSize) != 0) {
+    return false;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CompressImage)
+
+  std::vector<ImageCesiumMipPosition> sourceMips = image.mipPositions;
+  if (sourceMips.empty()) {
+    sourceMips.push_back(ImageCesiumMipPosition{0, image.pixelData.size()});
+  }
+
+  const size_t bytesPerPixel = size_t(image.channels);
+  const bool singleChannel = image.channels == 1;
+  const bool alpha = !singleChannel && hasTransparency(image);
+  const size_t blockBytes = alpha ? 16 : 8;
+
+  std::vector<ImageCesiumMipPosition> compressedMips;
+  compressedMips.reserve(sourceMips.size());
+  size_t compressedSize = 0;
+
+  for (size_t i = 0; i < sourceMips.size(); ++i) {
+    const int32 width = std::max(image.width >> i, 1);
+    const int32 height = std::max(image.height >> i, 1);
+    const ImageCesiumMipPosition& mip = sourceMips[i];
+    if (mip.byteOffset + mip.byteSize > image.pixelData.size() ||
+        mip.byteSize < size_t(width) * size_t(height) * bytesPerPixel) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("Not compressing an image with an invalid mip %d."),
+          int32(i));
+      return false;
+    }
+
+    const size_t blocks = size_t((width + BlockSize - 1) / BlockSize) *
+                          size_t((height + BlockSize - 1) / BlockSize);
+    compressedMips.push_back(
+        ImageCesiumMipPosition{compressedSize, blocks * blockBytes});
+    compressedSize += blocks * blockBytes;
+  }
+
+  std::vector<std::byte> compressed(compressedSize);
+  for (size_t i = 0; i < sourceMips.size(); ++i) {
+    compressMip(
+        &image.pixelData[sourceMips[i].byteOffset],
+        std::max(image.width >> i, 1),
+        std::max(image.height >> i, 1),
+        bytesPerPixel,
+        alpha,
+        &compressed[compressedMips[i].byteOffset]);
+  }
+
+  // When compressing in place, compressedImage is image, so each field of
+  // image is read before it's written.
+  if (image.mipPositions.empty()) {
+    compressedMips.clear();
+  }
+  compressedImage.width = image.width;
+  compressedImage.height = image.height;
+  compressedImage.channels = image.channels;
+  compressedImage.bytesPerChannel = image.bytesPerChannel;
+  compressedImage.pixelData = std::move(compressed);
+  compressedImage.mipPositions = std::move(compressedMips);
+  if (singleChannel) {
+    compressedImage.compressedPixelFormat = GpuCompressedPixelFormat::BC4_R;
+  } else {
+    compressedImage.compressedPixelFormat =
+        alpha ? GpuCompressedPixelFormat::BC3_RGBA
+              : GpuCompressedPixelFormat::BC1_RGB;
+  }
+
+  return true;
+}
+
+} // namespace CesiumTextureCompression
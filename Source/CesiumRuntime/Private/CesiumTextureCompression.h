@@ -0,0 +1,48 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+namespace CesiumGltf {
+struct ImageCesium;
+} // namespace CesiumGltf
+
+namespace CesiumTextureCompression {
+
+/**
+ * @brief Determines whether images can be block compressed for the current
+ * RHI. Block compression is only done on platforms that support BC1, BC3, and
+ * BC4 textures, which are generally desktop platforms.
+ */
+bool isCompressionSupported();
+
+/**
+ * @brief Block compresses an uncompressed RGBA8 or R8 image in place,
+ * including all of its mips. Opaque RGBA images are compressed to BC1, RGBA
+ * images with any transparency are compressed to BC3, and single-channel
+ * images, such as water masks, are compressed to BC4. This should be called
+ * from a background thread, after any mips have been generated.
+ *
+ * Compression is skipped, leaving the image unchanged, if the image is already
+ * compressed, is not four-channel or single-channel 8-bit, or has dimensions
+ * that are not a multiple of four.
+ *
+ * @param image The image to compress.
+ * @return Whether the image was compressed.
+ */
+bool compressImage(CesiumGltf::ImageCesium& image);
+
+/**
+ * @brief Block compresses an uncompressed RGBA8 or R8 image like
+ * {@link compressImage}, but into another image, leaving the original
+ * unchanged. This is for images that other textures share.
+ *
+ * @param image The image to compress.
+ * @param compressed Set to the compressed image. It is unchanged if the image
+ * isn't compressed.
+ * @return Whether the image was compressed.
+ */
+bool compressImage(
+    const CesiumGltf::ImageCesium& image,
+    CesiumGltf::ImageCesium& compressed);
+
+} // namespace CesiumTextureCompression
@@ -0,0 +1,103 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTexturePool.h"
+#include "CesiumLifetime.h"
+#include "CesiumRuntime.h"
+#include "Engine/Texture2D.h"
+
+namespace {
+// The most textures that may be waiting to be reused. Textures released
+// beyond this are destroyed instead, so that a burst of freed tiles doesn't
+// hold on to textures that won't be needed again soon.
+constexpr int32 MaximumFreeTextures = 512;
+} // namespace
+
+/*static*/ CesiumTexturePool& CesiumTexturePool::get() {
+  static CesiumTexturePool pool;
+  return pool;
+}
+
+UTexture2D* CesiumTexturePool::acquire() {
+  check(IsInGameThread());
+
+  this->processReleasing();
+
+  while (!this->_free.IsEmpty()) {
+    UTexture2D* pTexture = this->_free.Pop(false);
+    if (IsValid(pTexture)) {
+      this->_inUse.Add(pTexture);
+      return pTexture;
+    }
+  }
+
+  return nullptr;
+}
+
+void CesiumTexturePool::track(UTexture2D* pTexture) {
+  check(IsInGameThread());
+
+  if (pTexture) {
+    this->_inUse.Add(pTexture);
+  }
+}
+
+void CesiumTexturePool::release(UTexture2D* pTexture) {
+  check(IsInGameThread());
+
+  if (!pTexture) {
+    return;
+  }
+
+  this->_inUse.Remove(pTexture);
+
+  if (this->getFreeCount() >= MaximumFreeTextures) {
+    CesiumLifetime::destroy(pTexture);
+    return;
+  }
+
+  // The texture can only be given new content once the render thread is done
+  // deleting its old resource.
+  pTexture->ReleaseResource();
+  TSharedRef<FRenderCommandFence> pFence = MakeShared<FRenderCommandFence>();
+  pFence->BeginFence();
+  this->_releasing.Add(ReleasingTexture{pTexture, pFence});
+}
+
+void CesiumTexturePool::trim() {
+  check(IsInGameThread());
+
+  this->processReleasing();
+
+  for (UTexture2D* pTexture : this->_free) {
+    if (IsValid(pTexture)) {
+      CesiumLifetime::destroy(pTexture);
+    }
+  }
+  this->_free.Empty();
+}
+
+void CesiumTexturePool::processReleasing() {
+  // Fences complete in the order they were begun.
+  int32 completed = 0;
+  while (completed < this->_releasing.Num() &&
+         this->_releasing[completed].pFence->IsFenceComplete()) {
+    this->_free.Add(this->_releasing[completed].pTexture);
+    ++completed;
+  }
+
+  if (completed > 0) {
+    this->_releasing.RemoveAt(0, completed, false);
+  }
+}
+
+void CesiumTexturePool::AddReferencedObjects(FReferenceCollector& Collector) {
+  Collector.AddReferencedObjects(this->_inUse);
+  Collector.AddReferencedObjects(this->_free);
+  for (ReleasingTexture& releasing : this->_releasing) {
+    Collector.AddReferencedObject(releasing.pTexture);
+  }
+}
+
+FString CesiumTexturePool::GetReferencerName() const {
+  return TEXT("CesiumTexturePool");
+}
@@ -0,0 +1,88 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Set.h"
+#include "RenderCommandFence.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectPtr.h"
+
+class UTexture2D;
+
+/**
+ * A pool of transient textures that are reused for raster overlay tiles.
+ *
+ * Raster overlay tiles are created and freed constantly as the camera moves,
+ * and each needs its own texture. Rather than creating a new UTexture2D for
+ * each tile, adding it to the root set to keep it alive, and destroying it
+ * when the tile is freed, textures are taken from and returned to this pool.
+ * The pool keeps every texture it owns alive itself, so none of them are GC
+ * roots, and released textures are reused once their renderer resources have
+ * been released. Only the RHI texture is created from scratch for each tile.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumTexturePool : public FGCObject {
+public:
+  /**
+   * Gets the pool shared by all raster overlays.
+   */
+  static CesiumTexturePool& get();
+
+  /**
+   * Takes a texture from the pool, to be reused for new content, or returns
+   * nullptr if no texture is available. A texture returned from here has no
+   * renderer resource, and its platform data should be replaced.
+   */
+  UTexture2D* acquire();
+
+  /**
+   * Adds a newly-created texture to the pool's in-use textures, so that the
+   * pool keeps it alive.
+   */
+  void track(UTexture2D* pTexture);
+
+  /**
+   * Returns a texture to the pool, releasing its renderer resource. The
+   * texture may be returned by {@link acquire} once the render thread is done
+   * with its resource. If the pool is already full, the texture is destroyed
+   * instead.
+   */
+  void release(UTexture2D* pTexture);
+
+  /**
+   * Destroys the textures that are waiting to be reused, such as when memory
+   * is low. Textures whose renderer resources are still being released are
+   * kept until they can be reused.
+   */
+  void trim();
+
+  /**
+   * Gets the number of textures that are currently in use.
+   */
+  int32 getInUseCount() const { return this->_inUse.Num(); }
+
+  /**
+   * Gets the number of textures that are waiting to be reused.
+   */
+  int32 getFreeCount() const {
+    return this->_free.Num() + this->_releasing.Num();
+  }
+
+  // FGCObject overrides
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  struct ReleasingTexture {
+    TObjectPtr<UTexture2D> pTexture;
+    TSharedRef<FRenderCommandFence> pFence;
+  };
+
+  void processReleasing();
+
+  TSet<UTexture2D*> _inUse;
+  TArray<ReleasingTexture> _releasing;
+  TArray<TObjectPtr<UTexture2D>> _free;
+};
@@ -0,0 +1,341 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureStreaming.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTextureUtility.h"
+#include "Engine/Texture2D.h"
+#include "RenderUtils.h"
+#include "TextureResource.h"
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <glm/geometric.hpp>
+#include <variant>
+
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Streamed Textures"),
+    STAT_CesiumStreamedTextures,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Streamed Texture Resident Bytes"),
+    STAT_CesiumStreamedTextureResidentBytes,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Streamed Texture Full Bytes"),
+    STAT_CesiumStreamedTextureFullBytes,
+    STATGROUP_Cesium);
+
+namespace {
+// How long a texture keeps the mips it was last requested with after it
+// stops being requested, in seconds. This keeps tiles that are briefly hidden,
+// such as while a tileset's update is deferred, from losing their detail.
+constexpr float UnrequestedTime = 1.0f;
+
+// The most textures whose resident mips are changed by each update. Each
+// change recreates an RHI texture on the render thread.
+constexpr int32 MaximumChangesPerUpdate = 16;
+
+struct BoundingRadiusOperation {
+  double operator()(const CesiumGeometry::BoundingSphere& sphere) const {
+    return sphere.getRadius();
+  }
+
+  double operator()(const CesiumGeometry::OrientedBoundingBox& box) const {
+    const glm::dmat3& halfAxes = box.getHalfAxes();
+    return glm::length(halfAxes[0] + halfAxes[1] + halfAxes[2]);
+  }
+
+  double operator()(const CesiumGeospatial::BoundingRegion& region) const {
+    return (*this)(region.getBoundingBox());
+  }
+
+  double operator()(
+      const CesiumGeospatial::BoundingRegionWithLooseFittingHeights& region)
+      const {
+    return (*this)(region.getBoundingRegion());
+  }
+
+  double
+  operator()(const CesiumGeospatial::S2CellBoundingVolume& s2) const {
+    return (*this)(s2.computeBoundingRegion());
+  }
+};
+
+int64 computeResidentBytes(
+    int32 width,
+    int32 height,
+    EPixelFormat format,
+    int32 mipCount,
+    int32 firstMip) {
+  return int64(CalcTextureSize(
+      uint32(FMath::Max(width >> firstMip, 1)),
+      uint32(FMath::Max(height >> firstMip, 1)),
+      format,
+      uint32(mipCount - firstMip)));
+}
+} // namespace
+
+/*static*/ CesiumTextureStreaming& CesiumTextureStreaming::get() {
+  static CesiumTextureStreaming streaming;
+  return streaming;
+}
+
+/*static*/ bool CesiumTextureStreaming::isEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()->UseTextureStreaming;
+}
+
+/*static*/ int32 CesiumTextureStreaming::computeFirstResidentMip(
+    int32 width,
+    int32 height,
+    int32 mipCount,
+    double screenPixels,
+    int32 minimumSize) {
+  const int32 size = FMath::Max(width, height);
+
+  int32 lowestMip = FMath::Max(mipCount - 1, 0);
+  while (lowestMip > 0 && (size >> lowestMip) < minimumSize) {
+    --lowestMip;
+  }
+
+  if (screenPixels <= 0.0) {
+    return lowestMip;
+  }
+
+  // One more mip than the on-screen size needs is kept, for textures that are
+  // only partly mapped to a tile, such as a parent tile's overlay texture, and
+  // for surfaces seen at an angle.
+  const double texelsPerPixel = double(size) / (screenPixels * 2.0);
+  if (texelsPerPixel <= 1.0) {
+    return 0;
+  }
+
+  return FMath::Clamp(
+      FMath::FloorToInt32(FMath::Log2(texelsPerPixel)),
+      0,
+      lowestMip);
+}
+
+/*static*/ int32 CesiumTextureStreaming::computeFirstResidentMipForTexture(
+    int32 width,
+    int32 height,
+    int32 mipCount,
+    EPixelFormat format,
+    double screenPixels) {
+  int32 mip = computeFirstResidentMip(
+      width,
+      height,
+      mipCount,
+      screenPixels,
+      GetDefault<UCesiumRuntimeSettings>()->TextureStreamingMinimumMipSize);
+
+  // The most detailed resident mip of a block compressed texture must still
+  // be made of whole blocks.
+  const int32 blockSizeX = GPixelFormats[format].BlockSizeX;
+  const int32 blockSizeY = GPixelFormats[format].BlockSizeY;
+  while (mip > 0 && ((width >> mip) % blockSizeX != 0 ||
+                     (height >> mip) % blockSizeY != 0)) {
+    --mip;
+  }
+
+  return mip;
+}
+
+/*static*/ double CesiumTextureStreaming::computeMaximumScreenPixels(
+    double radius,
+    double geometricError,
+    double maximumScreenSpaceError) {
+  if (radius <= 0.0 || geometricError <= 0.0 ||
+      maximumScreenSpaceError <= 0.0) {
+    return 0.0;
+  }
+
+  // Both are divided by the same distance and projection, so the ratio of
+  // the tile's diameter to its geometric error is the same on the screen.
+  return 2.0 * radius * maximumScreenSpaceError / geometricError;
+}
+
+/*static*/ double CesiumTextureStreaming::computeMaximumScreenPixels(
+    const Cesium3DTilesSelection::Tile& tile,
+    double maximumScreenSpaceError) {
+  // Leaf tiles can be seen from arbitrarily close.
+  if (tile.getChildren().empty()) {
+    return 0.0;
+  }
+
+  return computeMaximumScreenPixels(
+      std::visit(
+          BoundingRadiusOperation{},
+          tile.getContentBoundingVolume().value_or(tile.getBoundingVolume())),
+      tile.getGeometricError(),
+      maximumScreenSpaceError);
+}
+
+void CesiumTextureStreaming::track(
+    UTexture2D* pTexture,
+    int32 mipCount,
+    int32 firstResidentMip) {
+  check(IsInGameThread());
+
+  if (!pTexture || mipCount <= 1) {
+    return;
+  }
+
+  StreamedTexture& texture = this->_textures.FindOrAdd(pTexture);
+  texture.pTexture = pTexture;
+  texture.pResource = pTexture->GetResource();
+  texture.width = pTexture->GetSizeX();
+  texture.height = pTexture->GetSizeY();
+  texture.mipCount = mipCount;
+  texture.format = pTexture->GetPixelFormat();
+  texture.firstResidentMip = firstResidentMip;
+  texture.pendingPixels = 0.0;
+  texture.requestedPixels = -1.0;
+  texture.timeSinceRequested = 0.0f;
+}
+
+void CesiumTextureStreaming::untrack(UTexture2D* pTexture) {
+  check(IsInGameThread());
+
+  if (pTexture) {
+    this->_textures.Remove(pTexture);
+  }
+}
+
+void CesiumTextureStreaming::requestResolution(
+    UTexture* pTexture,
+    double screenPixels) {
+  StreamedTexture* pStreamed =
+      this->_textures.Find(static_cast<const UTexture2D*>(pTexture));
+  if (pStreamed) {
+    pStreamed->pendingPixels =
+        FMath::Max(pStreamed->pendingPixels, screenPixels);
+  }
+}
+
+int32 CesiumTextureStreaming::getFirstResidentMip(
+    const UTexture2D* pTexture) const {
+  const StreamedTexture* pStreamed = this->_textures.Find(pTexture);
+  return pStreamed ? pStreamed->firstResidentMip : -1;
+}
+
+/*static*/ int32
+CesiumTextureStreaming::computeWantedMip(const StreamedTexture& texture) {
+  // A new texture keeps the mips that it was created with until its tile is
+  // shown, or until it has been hidden for a while.
+  double screenPixels = 0.0;
+  if (texture.timeSinceRequested < UnrequestedTime) {
+    if (texture.requestedPixels < 0.0) {
+      return texture.firstResidentMip;
+    }
+    screenPixels = texture.requestedPixels;
+  }
+
+  return computeFirstResidentMipForTexture(
+      texture.width,
+      texture.height,
+      texture.mipCount,
+      texture.format,
+      screenPixels);
+}
+
+void CesiumTextureStreaming::update(float deltaTime) {
+  check(IsInGameThread());
+
+  if (this->_textures.IsEmpty()) {
+    SET_DWORD_STAT(STAT_CesiumStreamedTextures, 0);
+    SET_MEMORY_STAT(STAT_CesiumStreamedTextureResidentBytes, 0);
+    SET_MEMORY_STAT(STAT_CesiumStreamedTextureFullBytes, 0);
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTextureStreaming)
+
+  TArray<TPair<StreamedTexture*, int32>> streamIn;
+  TArray<TPair<StreamedTexture*, int32>> streamOut;
+  int64 residentBytes = 0;
+  int64 fullBytes = 0;
+
+  for (auto it = this->_textures.CreateIterator(); it; ++it) {
+    StreamedTexture& texture = it->Value;
+    UTexture2D* pTexture = texture.pTexture.Get();
+    if (!pTexture || pTexture->GetResource() != texture.pResource) {
+      it.RemoveCurrent();
+      continue;
+    }
+
+    if (texture.pendingPixels > 0.0) {
+      texture.requestedPixels = texture.pendingPixels;
+      texture.pendingPixels = 0.0;
+      texture.timeSinceRequested = 0.0f;
+    } else {
+      texture.timeSinceRequested += deltaTime;
+    }
+
+    const int32 wantedMip = computeWantedMip(texture);
+    if (wantedMip < texture.firstResidentMip) {
+      streamIn.Emplace(&texture, wantedMip);
+    } else if (wantedMip > texture.firstResidentMip) {
+      streamOut.Emplace(&texture, wantedMip);
+    }
+
+    residentBytes += computeResidentBytes(
+        texture.width,
+        texture.height,
+        texture.format,
+        texture.mipCount,
+        texture.firstResidentMip);
+    fullBytes += computeResidentBytes(
+        texture.width,
+        texture.height,
+        texture.format,
+        texture.mipCount,
+        0);
+  }
+
+  // Textures that look blurry are more noticeable than textures that use more
+  // memory than they need to for a few more frames.
+  int32 changes = 0;
+  for (TArray<TPair<StreamedTexture*, int32>>* pChanges :
+       {&streamIn, &streamOut}) {
+    for (const TPair<StreamedTexture*, int32>& change : *pChanges) {
+      if (changes >= MaximumChangesPerUpdate) {
+        break;
+      }
+
+      StreamedTexture& texture = *change.Key;
+      residentBytes += computeResidentBytes(
+                           texture.width,
+                           texture.height,
+                           texture.format,
+                           texture.mipCount,
+                           change.Value) -
+                       computeResidentBytes(
+                           texture.width,
+                           texture.height,
+                           texture.format,
+                           texture.mipCount,
+                           texture.firstResidentMip);
+      texture.firstResidentMip = change.Value;
+      CesiumTextureUtility::setFirstResidentMip(
+          texture.pTexture.Get(),
+          change.Value);
+      ++changes;
+    }
+  }
+
+  SET_DWORD_STAT(STAT_CesiumStreamedTextures, this->_textures.Num());
+  SET_MEMORY_STAT(STAT_CesiumStreamedTextureResidentBytes, residentBytes);
+  SET_MEMORY_STAT(STAT_CesiumStreamedTextureFullBytes, fullBytes);
+}
+
+void CesiumTextureStreaming::Tick(float DeltaTime) { this->update(DeltaTime); }
+
+ETickableTickType CesiumTextureStreaming::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool CesiumTextureStreaming::IsTickableWhenPaused() const { return true; }
+
+bool CesiumTextureStreaming::IsTickableInEditor() const { return true; }
+
+TStatId CesiumTextureStreaming::GetStatId() const { return TStatId(); }
@@ -0,0 +1,186 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "PixelFormat.h"
+#include "Tickable.h"
+#include "UObject/WeakObjectPtr.h"
+
+namespace Cesium3DTilesSelection {
+class Tile;
+}
+
+class FTextureResource;
+class UTexture;
+class UTexture2D;
+
+/**
+ * Streams the mips of tile and raster overlay textures, so that only the ones
+ * a texture's on-screen size needs are resident on the GPU.
+ *
+ * Unreal's texture streamer only streams textures whose mips are in cooked
+ * bulk data, so tile textures, which are created at runtime, are never
+ * streamed by it. Instead, when "Use Texture Streaming" is enabled, each tile
+ * texture with a mip chain keeps its image on the CPU, and its RHI texture is
+ * recreated with fewer mips when it is seen from further away and with more
+ * when it is seen from closer. Tilesets request the resolution that each of
+ * their rendered textures needs every frame. Textures that haven't been
+ * requested for a while, such as those of tiles that are cached but not
+ * shown, keep only their low mips.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumTextureStreaming : FTickableGameObject {
+public:
+  /**
+   * Gets the texture streaming shared by all tilesets.
+   */
+  static CesiumTextureStreaming& get();
+
+  /**
+   * Determines whether tile textures are created to be streamed.
+   */
+  static bool isEnabled();
+
+  /**
+   * Computes the index of the most detailed mip that a texture needs to keep
+   * resident.
+   *
+   * @param width The width of the texture's full-resolution mip.
+   * @param height The height of the texture's full-resolution mip.
+   * @param mipCount The number of mips in the texture's image.
+   * @param screenPixels The number of pixels that the texture spans on the
+   * screen, or 0 if it isn't on the screen.
+   * @param minimumSize The smallest size that the most detailed resident mip
+   * may have, in texels.
+   * @return The index of the mip.
+   */
+  static int32 computeFirstResidentMip(
+      int32 width,
+      int32 height,
+      int32 mipCount,
+      double screenPixels,
+      int32 minimumSize);
+
+  /**
+   * Computes the index of the most detailed mip that a texture needs to keep
+   * resident, with "Texture Streaming Minimum Mip Size". The mip is made of
+   * whole blocks, if the texture is block compressed.
+   *
+   * @param width The width of the texture's full-resolution mip.
+   * @param height The height of the texture's full-resolution mip.
+   * @param mipCount The number of mips in the texture's image.
+   * @param format The pixel format of the texture.
+   * @param screenPixels The number of pixels that the texture spans on the
+   * screen, or 0 if it isn't on the screen.
+   * @return The index of the mip.
+   */
+  static int32 computeFirstResidentMipForTexture(
+      int32 width,
+      int32 height,
+      int32 mipCount,
+      EPixelFormat format,
+      double screenPixels);
+
+  /**
+   * Computes the most pixels that a tile can span on the screen before it's
+   * refined. A tile is refined once its screen-space error, which is its
+   * geometric error projected to the screen, exceeds the maximum, and its
+   * bounding sphere is projected to the screen in the same way.
+   *
+   * @param radius The radius of the tile's bounding sphere.
+   * @param geometricError The tile's geometric error.
+   * @param maximumScreenSpaceError The tileset's maximum screen-space error.
+   * @return The number of pixels, or 0 if there's no limit.
+   */
+  static double computeMaximumScreenPixels(
+      double radius,
+      double geometricError,
+      double maximumScreenSpaceError);
+
+  /**
+   * Computes the most pixels that a tile's content can span on the screen
+   * before the tile is refined, or 0 if there's no limit because the tile has
+   * no children to refine to.
+   */
+  static double computeMaximumScreenPixels(
+      const Cesium3DTilesSelection::Tile& tile,
+      double maximumScreenSpaceError);
+
+  /**
+   * Starts streaming the mips of a texture. If the texture is already
+   * streamed, such as when its image was replaced, it's streamed from its new
+   * image.
+   *
+   * @param pTexture The texture.
+   * @param mipCount The number of mips in the texture's image.
+   * @param firstResidentMip The index of the most detailed mip that the
+   * texture was created with.
+   */
+  void track(UTexture2D* pTexture, int32 mipCount, int32 firstResidentMip);
+
+  /**
+   * Stops streaming the mips of a texture, such as when it's destroyed.
+   */
+  void untrack(UTexture2D* pTexture);
+
+  /**
+   * Requests that a texture has enough mips resident to span the given number
+   * of pixels on the screen. The largest request from any tileset since the
+   * last update is used. Does nothing if the texture isn't streamed.
+   *
+   * @param pTexture The texture.
+   * @param screenPixels The number of pixels that the texture spans.
+   */
+  void requestResolution(UTexture* pTexture, double screenPixels);
+
+  /**
+   * Changes the resident mips of the streamed textures whose requested
+   * resolutions need different ones. Textures that need more mips are
+   * streamed in before textures that need fewer are streamed out.
+   *
+   * @param deltaTime The time since the last update, in seconds.
+   */
+  void update(float deltaTime);
+
+  /**
+   * Gets the number of textures that are streamed.
+   */
+  int32 getTrackedCount() const { return this->_textures.Num(); }
+
+  /**
+   * Gets the index of the most detailed mip of a texture that is resident, or
+   * -1 if the texture isn't streamed.
+   */
+  int32 getFirstResidentMip(const UTexture2D* pTexture) const;
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const override;
+
+private:
+  struct StreamedTexture {
+    TWeakObjectPtr<UTexture2D> pTexture;
+    // The resource that the mips were streamed for. When a pooled texture is
+    // given new content, it has a new resource.
+    const FTextureResource* pResource;
+    int32 width;
+    int32 height;
+    int32 mipCount;
+    EPixelFormat format;
+    int32 firstResidentMip;
+    // The largest resolution requested since the last update.
+    double pendingPixels;
+    // The largest resolution requested by the last update that had requests,
+    // or -1 if the texture hasn't been requested yet.
+    double requestedPixels;
+    float timeSinceRequested;
+  };
+
+  static int32 computeWantedMip(const StreamedTexture& texture);
+
+  TMap<const UTexture2D*, StreamedTexture> _textures;
+};
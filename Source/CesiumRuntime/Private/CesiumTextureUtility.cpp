@@ -7,12 +7,20 @@
 #include "CesiumCommon.h"
 #include "CesiumLifetime.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTextureCache.h"
+#include "CesiumTextureCompression.h"
+#include "CesiumTextureStreaming.h"
 #include "Containers/ResourceArray.h"
 #include "DynamicRHI.h"
+#include "GenerateMips.h"
 #include "GenericPlatform/GenericPlatformProcess.h"
+#include "Hash/CityHash.h"
 #include "PixelFormat.h"
 #include "RHIDefinitions.h"
 #include "RHIResources.h"
+#include "RenderGraphBuilder.h"
+#include "RenderTargetPool.h"
 #include "RenderUtils.h"
 #include "RenderingThread.h"
 #include "Runtime/Launch/Resources/Version.h"
@@ -31,68 +39,6 @@
 using namespace CesiumGltf;
 
 namespace {
-// Legacy texture creation code path - creates textures using Unreal's
-// FTexture2DMipMap and Texture2D::UpdateResource(). While this is slightly
-// less efficient than other approaches we've found, the other approaches
-// are not always supported on certain platforms. Once image sources from tiles
-// and raster tiles can be safely read from the render-thread, this approach
-// should no longer be necessary.
-void legacy_populateMips(
-    FTexturePlatformData& platformData,
-    const CesiumGltf::ImageCesium& image,
-    bool generateMipMaps) {
-  uint32 width = static_cast<uint32>(image.width);
-  uint32 height = static_cast<uint32>(image.height);
-
-  if (image.mipPositions.empty()) {
-    // Only the full image is available.
-    FTexture2DMipMap* pMip = new FTexture2DMipMap();
-    platformData.Mips.Add(pMip);
-    pMip->SizeX = width;
-    pMip->SizeY = height;
-
-    pMip->BulkData.Lock(LOCK_READ_WRITE);
-    void* pDest =
-        pMip->BulkData.Realloc(static_cast<int64>(image.pixelData.size()));
-
-    FMemory::Memcpy(pDest, image.pixelData.data(), image.pixelData.size());
-
-    pMip->BulkData.Unlock();
-
-    return;
-  }
-
-  for (const CesiumGltf::ImageCesiumMipPosition& mipPos : image.mipPositions) {
-    FTexture2DMipMap* pMip = new FTexture2DMipMap();
-    platformData.Mips.Add(pMip);
-    pMip->SizeX = width;
-    pMip->SizeY = height;
-
-    pMip->BulkData.Lock(LOCK_READ_WRITE);
-    void* pDest = pMip->BulkData.Realloc(static_cast<int64>(mipPos.byteSize));
-
-    FMemory::Memcpy(
-        pDest,
-        &image.pixelData[mipPos.byteOffset],
-        mipPos.byteSize);
-
-    pMip->BulkData.Unlock();
-
-    if (!generateMipMaps) {
-      // Only populate mip 0 if we don't want the full mip chain.
-      return;
-    }
-
-    if (width > 1) {
-      width >>= 1;
-    }
-
-    if (height > 1) {
-      height >>= 1;
-    }
-  }
-}
-
 struct GetImageFromSource {
   CesiumGltf::ImageCesium*
   operator()(CesiumTextureUtility::GltfImagePtr& imagePtr) {
@@ -174,11 +120,14 @@ void CopyMip(
  */
 class FCesiumTextureData : public FResourceBulkDataInterface {
 public:
-  FCesiumTextureData(const CesiumGltf::ImageCesium& image)
-      : _textureData(image.pixelData.data()),
+  FCesiumTextureData(const CesiumGltf::ImageCesium& image, uint32 mipIndex = 0)
+      : _textureData(
+            (!image.mipPositions.empty())
+                ? &image.pixelData[image.mipPositions[mipIndex].byteOffset]
+                : image.pixelData.data()),
         _textureDataSize(
             (!image.mipPositions.empty())
-                ? static_cast<uint32>(image.mipPositions[0].byteSize)
+                ? static_cast<uint32>(image.mipPositions[mipIndex].byteSize)
                 : static_cast<uint32>(image.pixelData.size())) {}
 
   const void* GetResourceBulkData() const override {
@@ -223,12 +172,51 @@ ESamplerAddressMode convertAddressMode(TextureAddress address) {
   }
 }
 
+/**
+ * @brief Computes the number of mips in a full mip chain for a texture of the
+ * given size.
+ */
+uint32 computeFullMipCount(uint32 width, uint32 height) {
+  return FMath::FloorLog2(FMath::Max(width, height)) + 1;
+}
+
+/**
+ * @brief Gets the flags required to generate a texture's mips on the GPU.
+ * Compute shaders can't write to sRGB textures, so those are rendered to
+ * instead.
+ */
+ETextureCreateFlags getGpuMipGenerationFlags(bool sRGB) {
+  return sRGB ? TexCreate_RenderTargetable
+              : (TexCreate_RenderTargetable | TexCreate_UAV);
+}
+
+/**
+ * @brief Generates mips 1 and higher of the given texture from its mip 0. Must
+ * be called on the render thread.
+ */
+void generateMipsOnGpu(FRHITexture* pTexture) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GenerateMipsOnGpu)
+
+  FRHICommandListImmediate& RHICmdList =
+      FRHICommandListExecutor::GetImmediateCommandList();
+  FRDGBuilder graphBuilder(RHICmdList);
+  FRDGTextureRef rdgTexture = graphBuilder.RegisterExternalTexture(
+      CreateRenderTarget(pTexture, TEXT("CesiumGenerateMips")));
+  FGenerateMips::Execute(
+      graphBuilder,
+      GMaxRHIFeatureLevel,
+      rdgTexture,
+      TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI());
+  graphBuilder.Execute();
+}
+
 /**
  * @brief An RHI resource that creates and destroys RHI textures. If a non-null
- * FTexture2DRHIRef is given, ownership of it is assumed and it will be
- * destroyed in ReleaseResource. Otherwise, the RHI texture will be created
- * from the in-memory Cesium glTF image in InitRHI (on the render thread).
- *
+ * FTexture2DRHIRef is given, ownership of it is assumed. Otherwise, the RHI
+ * texture will be created from the in-memory Cesium glTF image in InitRHI (on
+ * the render thread). Once the image is no longer kept, the RHI texture is
+ * kept until this resource is destroyed instead, so that it can be
+ * reinitialized.
  */
 class FCesiumTextureResource : public FTextureResource {
 public:
@@ -242,6 +230,9 @@ public:
       TextureAddress addressX,
       TextureAddress addressY,
       bool sRGB,
+      bool generateMipMapsOnGpu,
+      bool streamable,
+      uint32 firstResidentMip,
       uint32 extData)
       : _pTexture(pTexture),
         _textureSource(std::move(textureSource)),
@@ -251,6 +242,9 @@ public:
         _filter(convertFilter(filter)),
         _addressX(convertAddressMode(addressX)),
         _addressY(convertAddressMode(addressY)),
+        _generateMipMapsOnGpu(generateMipMapsOnGpu),
+        _streamable(streamable),
+        _firstResidentMip(firstResidentMip),
         _platformExtData(extData) {
     this->bGreyScaleFormat = (_format == PF_G8) || (_format == PF_BC4);
     this->bSRGB = sRGB;
@@ -260,6 +254,7 @@ public:
             &this->_textureSource);
     if (pAsyncTexture) {
       this->TextureRHI = pAsyncTexture->rhiTextureRef;
+      this->_uploadedTextureRHI = this->TextureRHI;
       pAsyncTexture->rhiTextureRef.SafeRelease();
     }
   }
@@ -308,91 +303,192 @@ public:
     this->DeferredPassSamplerStateRHI =
         GetOrCreateSamplerState(deferredSamplerStateInitializer);
 
-    if (!this->TextureRHI) {
-      // TODO: Currently copying from `ImageCesium` on the render-thread is
-      // unsafe. Currently we should never hit this code. Remove this in the
-      // future when images from tiles and raster tiles can be safely accessed
-      // from the render thread.
-      checkNoEntry();
-
-      // Asynchronous RHI texture creation was not available. So create it now
-      // directly from the in-memory cesium mips.
-      CesiumGltf::ImageCesium* pImage =
-          std::visit(GetImageFromSource{}, this->_textureSource);
-
-      check(pImage != nullptr);
-
-      // Wrap mip0 as a bulk data source.
-      FCesiumTextureData bulkData(*pImage);
-
-      FRHIResourceCreateInfo createInfo{TEXT("CesiumTextureUtility")};
-      createInfo.BulkData = &bulkData;
-      createInfo.ExtData = _platformExtData;
-
-      ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
-
-      if (this->bSRGB) {
-        textureFlags |= TexCreate_SRGB;
+    if (!this->TextureRHI && this->_uploadedTextureRHI) {
+      // The resource was released after its image was freed, such as when the
+      // feature level changed, so there's nothing to create the texture from
+      // again. Use the texture that was created before.
+      this->TextureRHI = this->_uploadedTextureRHI;
+    } else if (!this->TextureRHI) {
+      // Asynchronous RHI texture creation was not available, or the texture is
+      // streamed. So create it now directly from the in-memory cesium mips.
+      // The texture source owns its image (see loadTextureAnyThreadPart), so
+      // it's safe to read here.
+      this->TextureRHI = this->createTextureFromImage();
+
+      // Every mip has now been copied to the RHI, so the CPU copy of the image
+      // is no longer needed, unless mips are streamed in from it later.
+      if (!this->_streamable) {
+        this->_textureSource = CesiumTextureUtility::EmbeddedImageSource{};
+        this->_uploadedTextureRHI = this->TextureRHI;
       }
+    }
+
+    if (this->_generateMipMapsOnGpu) {
+      generateMipsOnGpu(this->TextureRHI);
+    }
 
-      uint32 mipCount =
-          FMath::Max(1, static_cast<int32>(pImage->mipPositions.size()));
+    RHIUpdateTextureReference(TextureReferenceRHI, this->TextureRHI);
+  }
 
-      FTexture2DRHIRef rhiTexture;
+  /**
+   * Replaces the image of this resource, such as a low-resolution preview of
+   * a raster overlay tile, with the given one. The texture reference is
+   * updated, so materials that sample the texture show the new image without
+   * being changed. Must be called from the render thread.
+   */
+  void ReplaceImage(
+      FRHICommandListImmediate& RHICmdList,
+      CesiumTextureUtility::CesiumTextureSource&& textureSource,
+      uint32 width,
+      uint32 height,
+      EPixelFormat format,
+      bool generateMipMapsOnGpu,
+      bool streamable,
+      uint32 extData) {
+    this->_textureSource = std::move(textureSource);
+    this->_width = width;
+    this->_height = height;
+    this->_format = format;
+    this->_generateMipMapsOnGpu = generateMipMapsOnGpu;
+    this->_streamable = streamable;
+    this->_firstResidentMip = 0;
+    this->_platformExtData = extData;
+    this->bGreyScaleFormat = (_format == PF_G8) || (_format == PF_BC4);
 
-      // Copies over mip0, allocates the rest of the mips if needed.
+    this->TextureRHI.SafeRelease();
+    this->_uploadedTextureRHI.SafeRelease();
+    CesiumTextureUtility::AsyncCreatedTexture* pAsyncTexture =
+        std::get_if<CesiumTextureUtility::AsyncCreatedTexture>(
+            &this->_textureSource);
+    if (pAsyncTexture) {
+      this->TextureRHI = pAsyncTexture->rhiTextureRef;
+      this->_uploadedTextureRHI = this->TextureRHI;
+      pAsyncTexture->rhiTextureRef.SafeRelease();
+    }
 
-      // RHICreateTexture2D can actually copy over all the mips in one shot,
-      // but it expects a particular memory layout. Might be worth configuring
-      // Cesium Native's mip-map generation to obey a standard memory layout.
 #if ENGINE_VERSION_5_3_OR_HIGHER
-      rhiTexture = RHICreateTexture(
-          FRHITextureCreateDesc::Create2D(createInfo.DebugName)
-              .SetExtent(int32(this->_width), int32(this->_height))
-              .SetFormat(this->_format)
-              .SetNumMips(uint8(mipCount))
-              .SetNumSamples(1)
-              .SetFlags(textureFlags)
-              .SetInitialState(ERHIAccess::Unknown)
-              .SetExtData(createInfo.ExtData)
-              .SetBulkData(createInfo.BulkData)
-              .SetGPUMask(createInfo.GPUMask)
-              .SetClearValue(createInfo.ClearValueBinding));
+    this->InitRHI(RHICmdList);
 #else
-      rhiTexture = RHICreateTexture2D(
-          this->_width,
-          this->_height,
-          this->_format,
-          mipCount,
-          1,
-          textureFlags,
-          createInfo);
+    this->InitRHI();
 #endif
+  }
 
-      // Copies over rest of the mips
-      for (uint32 i = 1; i < mipCount; ++i) {
-        uint32 DestPitch;
-        void* pDestination =
-            RHILockTexture2D(rhiTexture, i, RLM_WriteOnly, DestPitch, false);
-        CopyMip(pDestination, DestPitch, _format, *pImage, i);
-        RHIUnlockTexture2D(rhiTexture, i, false);
-      }
+  virtual void ReleaseRHI() override {
+    RHIUpdateTextureReference(TextureReferenceRHI, nullptr);
+
+    FTextureResource::ReleaseRHI();
+  }
 
-      this->TextureRHI = std::move(rhiTexture);
+  /**
+   * Recreates the RHI texture of a streamed texture so that only the mips
+   * from the given one down are resident on the GPU. The texture reference is
+   * updated, so materials that sample the texture use the new mips without
+   * being changed. Does nothing if this texture isn't streamed. Must be called
+   * from the render thread.
+   */
+  void SetFirstResidentMip(uint32 firstMip) {
+    if (!this->_streamable || !this->TextureRHI ||
+        firstMip == this->_firstResidentMip) {
+      return;
     }
 
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::StreamTextureMips)
+
+    this->_firstResidentMip = firstMip;
+    this->TextureRHI = this->createTextureFromImage();
     RHIUpdateTextureReference(TextureReferenceRHI, this->TextureRHI);
   }
 
-  virtual void ReleaseRHI() override {
-    RHIUpdateTextureReference(TextureReferenceRHI, nullptr);
+private:
+  /**
+   * Creates an RHI texture from the image in this resource's texture source,
+   * with the mips from _firstResidentMip down.
+   */
+  FTexture2DRHIRef createTextureFromImage() {
+    CesiumGltf::ImageCesium* pImage =
+        std::visit(GetImageFromSource{}, this->_textureSource);
+
+    check(pImage != nullptr);
+    check(!pImage->pixelData.empty());
+
+    const uint32 firstMip = FMath::Min(
+        this->_firstResidentMip,
+        uint32(FMath::Max(1, int32(pImage->mipPositions.size())) - 1));
+    const uint32 width = FMath::Max(this->_width >> firstMip, 1u);
+    const uint32 height = FMath::Max(this->_height >> firstMip, 1u);
+
+    // Wrap the first mip as a bulk data source.
+    FCesiumTextureData bulkData(*pImage, firstMip);
+
+    FRHIResourceCreateInfo createInfo{TEXT("CesiumTextureUtility")};
+    createInfo.BulkData = &bulkData;
+    createInfo.ExtData = _platformExtData;
+
+    ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
+
+    if (this->bSRGB) {
+      textureFlags |= TexCreate_SRGB;
+    }
 
-    FTextureResource::ReleaseRHI();
+    uint32 mipCount =
+        FMath::Max(1, static_cast<int32>(pImage->mipPositions.size())) -
+        firstMip;
+    uint32 uploadedMipCount = mipCount;
+
+    if (this->_generateMipMapsOnGpu) {
+      textureFlags |= getGpuMipGenerationFlags(this->bSRGB);
+      mipCount = computeFullMipCount(width, height);
+      uploadedMipCount = 1;
+    }
+
+    FTexture2DRHIRef rhiTexture;
+
+    // Copies over the first mip, allocates the rest of the mips if needed.
+
+    // RHICreateTexture2D can actually copy over all the mips in one shot,
+    // but it expects a particular memory layout. Might be worth configuring
+    // Cesium Native's mip-map generation to obey a standard memory layout.
+#if ENGINE_VERSION_5_3_OR_HIGHER
+    rhiTexture = RHICreateTexture(
+        FRHITextureCreateDesc::Create2D(createInfo.DebugName)
+            .SetExtent(int32(width), int32(height))
+            .SetFormat(this->_format)
+            .SetNumMips(uint8(mipCount))
+            .SetNumSamples(1)
+            .SetFlags(textureFlags)
+            .SetInitialState(ERHIAccess::Unknown)
+            .SetExtData(createInfo.ExtData)
+            .SetBulkData(createInfo.BulkData)
+            .SetGPUMask(createInfo.GPUMask)
+            .SetClearValue(createInfo.ClearValueBinding));
+#else
+    rhiTexture = RHICreateTexture2D(
+        width,
+        height,
+        this->_format,
+        mipCount,
+        1,
+        textureFlags,
+        createInfo);
+#endif
+
+    // Copies over rest of the mips
+    for (uint32 i = 1; i < uploadedMipCount; ++i) {
+      uint32 DestPitch;
+      void* pDestination =
+          RHILockTexture2D(rhiTexture, i, RLM_WriteOnly, DestPitch, false);
+      CopyMip(pDestination, DestPitch, _format, *pImage, firstMip + i);
+      RHIUnlockTexture2D(rhiTexture, i, false);
+    }
+
+    return rhiTexture;
   }
 
-private:
   UTexture* _pTexture;
   CesiumTextureUtility::CesiumTextureSource _textureSource;
+  // The RHI texture, once the texture source no longer has the image it was
+  // created from, so that InitRHI can restore it after ReleaseRHI.
+  FTexture2DRHIRef _uploadedTextureRHI;
 
   uint32 _width;
   uint32 _height;
@@ -400,24 +496,29 @@ private:
   ESamplerFilter _filter;
   ESamplerAddressMode _addressX;
   ESamplerAddressMode _addressY;
+  bool _generateMipMapsOnGpu;
+  bool _streamable;
+  uint32 _firstResidentMip;
 
   uint32 _platformExtData;
 };
 
 namespace {
 
-FTexture2DRHIRef createAsyncTextureAndWait(
+FTexture2DRHIRef createAsyncTexture(
     uint32 SizeX,
     uint32 SizeY,
     uint8 Format,
     uint32 NumMips,
     ETextureCreateFlags Flags,
     void** InitialMipData,
-    uint32 NumInitialMips) {
+    uint32 NumInitialMips,
+    FGraphEventRef& CompletionEvent) {
 #if ENGINE_VERSION_5_3_OR_HIGHER
-  FGraphEventRef CompletionEvent;
-
-  FTexture2DRHIRef result = RHIAsyncCreateTexture2D(
+  // The texture may not be usable until the completion event is signaled.
+  // Rather than waiting for it here, which would park this worker thread, the
+  // event is handed back so that whoever uses the texture can wait for it.
+  return RHIAsyncCreateTexture2D(
       SizeX,
       SizeY,
       Format,
@@ -426,13 +527,8 @@ FTexture2DRHIRef createAsyncTextureAndWait(
       InitialMipData,
       NumInitialMips,
       CompletionEvent);
-
-  if (CompletionEvent) {
-    CompletionEvent->Wait();
-  }
-
-  return result;
 #else
+  CompletionEvent = nullptr;
   return RHIAsyncCreateTexture2D(
       SizeX,
       SizeY,
@@ -454,13 +550,16 @@ FTexture2DRHIRef createAsyncTextureAndWait(
  * @param format The pixel format of the image.
  * @param generateMipMaps Whether the RHI texture should have a mipmap.
  * @param Whether to use a sRGB color-space.
+ * @param completionEvent Set to an event that is signaled when the texture is
+ * ready to be used, or to null if it is ready already.
  * @return The RHI texture reference.
  */
 FTexture2DRHIRef CreateRHITexture2D_Async(
     const CesiumGltf::ImageCesium& image,
     EPixelFormat format,
     bool generateMipMaps,
-    bool sRGB) {
+    bool sRGB,
+    FGraphEventRef& completionEvent) {
   check(GRHISupportsAsyncTextureCreation);
 
   ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
@@ -482,24 +581,26 @@ FTexture2DRHIRef CreateRHITexture2D_Async(
       mipsData[i] = (void*)(&image.pixelData[mipPos.byteOffset]);
     }
 
-    return createAsyncTextureAndWait(
+    return createAsyncTexture(
         static_cast<uint32>(image.width),
         static_cast<uint32>(image.height),
         format,
         mipCount,
         textureFlags,
         mipsData,
-        mipCount);
+        mipCount,
+        completionEvent);
   } else {
     void* pTextureData = (void*)(image.pixelData.data());
-    return createAsyncTextureAndWait(
+    return createAsyncTexture(
         static_cast<uint32>(image.width),
         static_cast<uint32>(image.height),
         format,
         1,
         textureFlags,
         &pTextureData,
-        1);
+        1,
+        completionEvent);
   }
 }
 } // namespace
@@ -536,20 +637,109 @@ createTexturePlatformData(int32 sizeX, int32 sizeY, EPixelFormat format) {
   }
 }
 
-static UTexture2D* CreateTexture2D(LoadedTextureResult* pHalfLoadedTexture) {
+namespace {
+uint64 computeContentKey(
+    const CesiumGltf::ImageCesium& image,
+    TextureAddress addressX,
+    TextureAddress addressY,
+    TextureFilter filter,
+    bool generateMipMaps,
+    bool sRGB,
+    bool compress) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HashTextureImage)
+
+  const uint64 properties[] = {
+      uint64(image.width),
+      uint64(image.height),
+      uint64(image.channels),
+      uint64(image.bytesPerChannel),
+      uint64(image.compressedPixelFormat),
+      uint64(image.mipPositions.size()),
+      uint64(addressX),
+      uint64(addressY),
+      uint64(filter),
+      uint64(generateMipMaps) | uint64(sRGB) << 1 | uint64(compress) << 2};
+  const uint64 propertiesHash =
+      CityHash64(reinterpret_cast<const char*>(properties), sizeof(properties));
+
+  const uint64 key = CityHash64WithSeed(
+      reinterpret_cast<const char*>(image.pixelData.data()),
+      uint32(image.pixelData.size()),
+      propertiesHash);
+
+  // 0 means that a texture has no key.
+  return key != 0 ? key : 1;
+}
+
+// Prepares a texture whose image was skipped in the background because an
+// identical texture was in use, once that texture has turned out to be gone.
+bool prepareUncachedTexture(LoadedTextureResult& halfLoaded) {
+  GltfImagePtr* pImage = std::get_if<GltfImagePtr>(&halfLoaded.textureSource);
+  if (!pImage || !pImage->pImage) {
+    return false;
+  }
+
+  TUniquePtr<LoadedTextureResult> pPrepared = loadTextureAnyThreadPart(
+      GltfImagePtr{pImage->pImage},
+      halfLoaded.addressX,
+      halfLoaded.addressY,
+      halfLoaded.filter,
+      halfLoaded.group,
+      halfLoaded.generateMipMaps,
+      halfLoaded.sRGB,
+      halfLoaded.compress,
+      halfLoaded.streamable);
+  if (!pPrepared) {
+    return false;
+  }
+
+  pPrepared->compress = halfLoaded.compress;
+  pPrepared->contentKey = halfLoaded.contentKey;
+  pPrepared->maximumScreenPixels = halfLoaded.maximumScreenPixels;
+  halfLoaded = MoveTemp(*pPrepared);
+  return true;
+}
+
+// Gets the number of mips of a half-loaded texture that can be streamed, or 0
+// if it isn't streamed.
+int32 getStreamedMipCount(LoadedTextureResult& halfLoaded) {
+  if (!halfLoaded.streamable) {
+    return 0;
+  }
+
+  const CesiumGltf::ImageCesium* pImage =
+      std::visit(GetImageFromSource{}, halfLoaded.textureSource);
+  if (!pImage || pImage->mipPositions.size() <= 1) {
+    return 0;
+  }
+
+  return int32(pImage->mipPositions.size());
+}
+} // namespace
+
+static UTexture2D* CreateTexture2D(
+    LoadedTextureResult* pHalfLoadedTexture,
+    UTexture2D* pTextureToReuse) {
   if (!pHalfLoadedTexture) {
     return nullptr;
   }
 
   UTexture2D* pTexture = pHalfLoadedTexture->pTexture.Get();
   if (!pTexture && pHalfLoadedTexture->pTextureData) {
-    pTexture = NewObject<UTexture2D>(
-        GetTransientPackage(),
-        MakeUniqueObjectName(
-            GetTransientPackage(),
-            UTexture2D::StaticClass(),
-            "CesiumRuntimeTexture"),
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    if (pTextureToReuse) {
+      pTexture = pTextureToReuse;
+      FTexturePlatformData* pOldPlatformData = pTexture->GetPlatformData();
+      pTexture->SetPlatformData(nullptr);
+      delete pOldPlatformData;
+    } else {
+      pTexture = NewObject<UTexture2D>(
+          GetTransientPackage(),
+          MakeUniqueObjectName(
+              GetTransientPackage(),
+              UTexture2D::StaticClass(),
+              "CesiumRuntimeTexture"),
+          RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    }
 
     pTexture->SetPlatformData(pHalfLoadedTexture->pTextureData.Release());
     pTexture->AddressX = pHalfLoadedTexture->addressX;
@@ -573,21 +763,37 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     const TextureFilter& filter,
     const TextureGroup& group,
     bool generateMipMaps,
-    bool sRGB) {
+    bool sRGB,
+    bool compress,
+    bool stream,
+    bool allowAsyncCreation) {
 
   CesiumGltf::ImageCesium* pImage =
       std::visit(GetImageFromSource{}, imageSource);
 
   assert(pImage != nullptr);
-  CesiumGltf::ImageCesium& image = *pImage;
 
-  if (image.pixelData.empty() || image.width == 0 || image.height == 0) {
+  if (pImage->pixelData.empty() || pImage->width == 0 ||
+      pImage->height == 0) {
     return nullptr;
   }
 
-  if (generateMipMaps) {
+  // Images without mips that won't be block compressed can have their mips
+  // generated on the GPU instead.
+  const bool generateMipMapsOnGpu =
+      generateMipMaps && pImage->mipPositions.empty() &&
+      pImage->compressedPixelFormat == GpuCompressedPixelFormat::NONE &&
+      !(compress && CesiumTextureCompression::isCompressionSupported()) &&
+      GetDefault<UCesiumRuntimeSettings>()->GenerateMipMapsOnGpu;
+
+  // Streamed textures are recreated from their CPU mips whenever their
+  // resident mips change, so mips generated on the GPU can't be streamed.
+  const bool streamable = generateMipMaps && !generateMipMapsOnGpu &&
+                          (stream || CesiumTextureStreaming::isEnabled());
+
+  if (generateMipMaps && !generateMipMapsOnGpu) {
     std::optional<std::string> errorMessage =
-        CesiumGltfReader::GltfReader::generateMipMaps(image);
+        CesiumGltfReader::GltfReader::generateMipMaps(*pImage);
     if (errorMessage) {
       UE_LOG(
           LogCesium,
@@ -597,6 +803,22 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     }
   }
 
+  if (compress && CesiumTextureCompression::isCompressionSupported()) {
+    if (std::holds_alternative<GltfImagePtr>(imageSource)) {
+      // The glTF's image may also be used by textures that aren't compressed,
+      // such as a normal map, so compress a copy that only this texture uses.
+      EmbeddedImageSource compressed;
+      if (CesiumTextureCompression::compressImage(*pImage, compressed.image)) {
+        imageSource = std::move(compressed);
+        pImage = std::visit(GetImageFromSource{}, imageSource);
+      }
+    } else {
+      CesiumTextureCompression::compressImage(*pImage);
+    }
+  }
+
+  CesiumGltf::ImageCesium& image = *pImage;
+
   EPixelFormat pixelFormat;
   if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
     switch (image.compressedPixelFormat) {
@@ -666,27 +888,44 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
   pResult->group = group;
   pResult->sRGB = sRGB;
   pResult->generateMipMaps = generateMipMaps;
-
-  if (GRHISupportsAsyncTextureCreation) {
+  pResult->generateMipMapsOnGpu = generateMipMapsOnGpu;
+  pResult->streamable = streamable && image.mipPositions.size() > 1;
+
+  // Textures whose mips are generated on the GPU must be render targetable,
+  // which asynchronously created textures can't be, so they're created on the
+  // render thread.
+  if (allowAsyncCreation && GRHISupportsAsyncTextureCreation &&
+      !pResult->streamable && !generateMipMapsOnGpu) {
     // Create RHI texture resource asynchronously.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateRHITexture2D)
 
-    pResult->textureSource = AsyncCreatedTexture{
-        CreateRHITexture2D_Async(image, pixelFormat, generateMipMaps, sRGB)};
+    AsyncCreatedTexture asyncTexture;
+    asyncTexture.rhiTextureRef = CreateRHITexture2D_Async(
+        image,
+        pixelFormat,
+        generateMipMaps,
+        sRGB,
+        asyncTexture.completionEvent);
+    pResult->textureSource = std::move(asyncTexture);
   } else {
     // The RHI texture will be created later on the render thread, directly
-    // from this texture source.
-    // pResult->textureSource = std::move(imageSource);
+    // from this texture source. An image that belongs to a tile or raster tile
+    // may be freed before then, so the texture source must own its image. The
+    // image is freed as soon as it has been uploaded, unless the texture is
+    // streamed.
+    if (!std::holds_alternative<EmbeddedImageSource>(imageSource)) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyImageForRenderThread)
+      imageSource = EmbeddedImageSource{image};
+    }
 
-    // TODO: Use the above texture creation path instead when the image source
-    // becomes render-thread safe in the future. Currently that is not the
-    // case for any `CesiumGltf::ImageCesium` from tiles or raster tiles.
+    if (!generateMipMaps && image.mipPositions.size() > 1) {
+      // Only upload mip 0.
+      EmbeddedImageSource& embedded =
+          std::get<EmbeddedImageSource>(imageSource);
+      embedded.image.mipPositions.resize(1);
+    }
 
-    // Legacy texture creation copies mip data into the FTexturePlatformData.
-    legacy_populateMips(*pResult->pTextureData, image, generateMipMaps);
-    // Mark the image source as legacy, so we later know where to look for image
-    // data.
-    pResult->textureSource = LegacyTextureSource{};
+    pResult->textureSource = std::move(imageSource);
   }
 
   return pResult;
@@ -695,7 +934,10 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
 TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     CesiumGltf::Model& model,
     const CesiumGltf::Texture& texture,
-    bool sRGB) {
+    bool sRGB,
+    bool compress,
+    bool shareWithOtherTiles,
+    bool stream) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTexture)
 
@@ -835,6 +1077,39 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     }
   }
 
+  uint64 contentKey = 0;
+  if (shareWithOtherTiles && !image.pixelData.empty()) {
+    contentKey = computeContentKey(
+        image,
+        addressX,
+        addressY,
+        filter,
+        useMipMaps,
+        sRGB,
+        compress);
+
+    // Another tile already has this texture, so there's no need to prepare
+    // the image. It's kept in the model in case the other tile's texture is
+    // destroyed before this tile's game thread part looks for it.
+    if (CesiumTextureCache::get().contains(contentKey)) {
+      TUniquePtr<LoadedTextureResult> pResult =
+          MakeUnique<LoadedTextureResult>();
+      pResult->addressX = addressX;
+      pResult->addressY = addressY;
+      pResult->filter = filter;
+      pResult->group = TextureGroup::TEXTUREGROUP_World;
+      pResult->generateMipMaps = useMipMaps;
+      pResult->sRGB = sRGB;
+      pResult->compress = compress;
+      // Whether to stream the texture if it has to be prepared after all.
+      pResult->streamable = stream;
+      pResult->contentKey = contentKey;
+      pResult->useCachedTexture = true;
+      pResult->textureSource = GltfImageIndex{source};
+      return pResult;
+    }
+  }
+
   TUniquePtr<LoadedTextureResult> result = loadTextureAnyThreadPart(
       GltfImagePtr{&image},
       addressX,
@@ -842,7 +1117,14 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
       filter,
       TextureGroup::TEXTUREGROUP_World,
       useMipMaps,
-      sRGB);
+      sRGB,
+      compress,
+      stream);
+
+  if (result) {
+    result->compress = compress;
+    result->contentKey = contentKey;
+  }
 
   // Replace the image pointer with an index, in case the pointer gets
   // invalidated before the main thread loading continues.
@@ -854,6 +1136,12 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
 }
 
 UTexture2D* loadTextureGameThreadPart(LoadedTextureResult* pHalfLoadedTexture) {
+  return loadTextureGameThreadPart(pHalfLoadedTexture, nullptr);
+}
+
+UTexture2D* loadTextureGameThreadPart(
+    LoadedTextureResult* pHalfLoadedTexture,
+    UTexture2D* pTextureToReuse) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTexture)
 
   if (!pHalfLoadedTexture) {
@@ -864,13 +1152,50 @@ UTexture2D* loadTextureGameThreadPart(LoadedTextureResult* pHalfLoadedTexture) {
     return pHalfLoadedTexture->pTexture.Get();
   }
 
-  UTexture2D* pTexture = CreateTexture2D(pHalfLoadedTexture);
+  if (pHalfLoadedTexture->useCachedTexture) {
+    UTexture2D* pCachedTexture =
+        CesiumTextureCache::get().find(pHalfLoadedTexture->contentKey);
+    if (pCachedTexture) {
+      pHalfLoadedTexture->pTexture = pCachedTexture;
+      return pCachedTexture;
+    }
+
+    // The texture that was found in the background has since been destroyed,
+    // so this one must be prepared from its image after all.
+    if (!prepareUncachedTexture(*pHalfLoadedTexture)) {
+      return nullptr;
+    }
+  }
+
+  UTexture2D* pTexture = CreateTexture2D(pHalfLoadedTexture, pTextureToReuse);
+  if (!pTexture) {
+    return nullptr;
+  }
 
   if (std::get_if<LegacyTextureSource>(&pHalfLoadedTexture->textureSource)) {
     pTexture->UpdateResource();
     return pTexture;
   }
 
+  FGraphEventRef completionEvent;
+  AsyncCreatedTexture* pAsyncTexture =
+      std::get_if<AsyncCreatedTexture>(&pHalfLoadedTexture->textureSource);
+  if (pAsyncTexture) {
+    completionEvent = std::move(pAsyncTexture->completionEvent);
+  }
+
+  const int32 streamedMipCount = getStreamedMipCount(*pHalfLoadedTexture);
+  int32 firstResidentMip = 0;
+  if (streamedMipCount > 0 && pHalfLoadedTexture->maximumScreenPixels > 0.0) {
+    firstResidentMip =
+        CesiumTextureStreaming::computeFirstResidentMipForTexture(
+            pTexture->GetSizeX(),
+            pTexture->GetSizeY(),
+            streamedMipCount,
+            pTexture->GetPixelFormat(),
+            pHalfLoadedTexture->maximumScreenPixels);
+  }
+
   FCesiumTextureResource* pCesiumTextureResource = new FCesiumTextureResource(
       pTexture,
       std::move(pHalfLoadedTexture->textureSource),
@@ -881,12 +1206,32 @@ UTexture2D* loadTextureGameThreadPart(LoadedTextureResult* pHalfLoadedTexture) {
       pHalfLoadedTexture->addressX,
       pHalfLoadedTexture->addressY,
       pHalfLoadedTexture->sRGB,
+      pHalfLoadedTexture->generateMipMapsOnGpu,
+      streamedMipCount > 0,
+      uint32(firstResidentMip),
       pTexture->GetPlatformData()->GetExtData());
 
   pTexture->SetResource(pCesiumTextureResource);
 
+  if (streamedMipCount > 0) {
+    CesiumTextureStreaming::get().track(
+        pTexture,
+        streamedMipCount,
+        firstResidentMip);
+  }
+
   ENQUEUE_RENDER_COMMAND(Cesium_InitResource)
-  ([pTexture, pCesiumTextureResource](FRHICommandListImmediate& RHICmdList) {
+  ([pTexture,
+    pCesiumTextureResource,
+    completionEvent = std::move(completionEvent)](
+       FRHICommandListImmediate& RHICmdList) {
+    if (completionEvent && !completionEvent->IsComplete()) {
+      // Tiles aren't finished loading until their textures have been created
+      // (see waitForTextureCreation), so this should only happen for raster
+      // overlay textures, whose loading can't be deferred.
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WaitForAsyncTextureCreation)
+      completionEvent->Wait(ENamedThreads::GetRenderThread_Local());
+    }
     pCesiumTextureResource->SetTextureReference(
         pTexture->TextureReference.TextureReferenceRHI);
     pCesiumTextureResource->InitResource();
@@ -911,6 +1256,71 @@ UTexture2D* loadTextureGameThreadPart(
   return loadTextureGameThreadPart(pHalfLoadedTexture);
 }
 
+bool replaceTextureImage(
+    UTexture2D* pTexture,
+    TUniquePtr<LoadedTextureResult>&& pHalfLoadedTexture) {
+  check(IsInGameThread());
+
+  if (!pTexture || !pHalfLoadedTexture ||
+      !pHalfLoadedTexture->pTextureData ||
+      std::get_if<LegacyTextureSource>(&pHalfLoadedTexture->textureSource)) {
+    return false;
+  }
+
+  FCesiumTextureResource* pCesiumTextureResource =
+      static_cast<FCesiumTextureResource*>(pTexture->GetResource());
+  if (!pCesiumTextureResource) {
+    return false;
+  }
+
+  FTexturePlatformData* pOldPlatformData = pTexture->GetPlatformData();
+  pTexture->SetPlatformData(pHalfLoadedTexture->pTextureData.Release());
+  delete pOldPlatformData;
+
+  FGraphEventRef completionEvent;
+  AsyncCreatedTexture* pAsyncTexture =
+      std::get_if<AsyncCreatedTexture>(&pHalfLoadedTexture->textureSource);
+  if (pAsyncTexture) {
+    completionEvent = std::move(pAsyncTexture->completionEvent);
+  }
+
+  // The new image starts with all of its mips resident.
+  const int32 streamedMipCount = getStreamedMipCount(*pHalfLoadedTexture);
+  if (streamedMipCount > 0) {
+    CesiumTextureStreaming::get().track(pTexture, streamedMipCount, 0);
+  } else {
+    CesiumTextureStreaming::get().untrack(pTexture);
+  }
+
+  ENQUEUE_RENDER_COMMAND(Cesium_ReplaceTextureImage)
+  ([pCesiumTextureResource,
+    textureSource = std::move(pHalfLoadedTexture->textureSource),
+    width = static_cast<uint32>(pTexture->GetSizeX()),
+    height = static_cast<uint32>(pTexture->GetSizeY()),
+    format = pTexture->GetPixelFormat(),
+    generateMipMapsOnGpu = pHalfLoadedTexture->generateMipMapsOnGpu,
+    streamable = streamedMipCount > 0,
+    extData = pTexture->GetPlatformData()->GetExtData(),
+    completionEvent = std::move(completionEvent)](
+       FRHICommandListImmediate& RHICmdList) mutable {
+    if (completionEvent && !completionEvent->IsComplete()) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WaitForAsyncTextureCreation)
+      completionEvent->Wait(ENamedThreads::GetRenderThread_Local());
+    }
+    pCesiumTextureResource->ReplaceImage(
+        RHICmdList,
+        std::move(textureSource),
+        width,
+        height,
+        format,
+        generateMipMapsOnGpu,
+        streamable,
+        extData);
+  });
+
+  return true;
+}
+
 void destroyHalfLoadedTexture(LoadedTextureResult& halfLoaded) {
   AsyncCreatedTexture* pAsyncCreatedTexture =
       std::get_if<AsyncCreatedTexture>(&halfLoaded.textureSource);
@@ -926,8 +1336,65 @@ void destroyHalfLoadedTexture(LoadedTextureResult& halfLoaded) {
   }
 }
 
+void addTextureCreationEvent(
+    const LoadedTextureResult* pHalfLoadedTexture,
+    FGraphEventArray& events) {
+  if (!pHalfLoadedTexture) {
+    return;
+  }
+
+  const AsyncCreatedTexture* pAsyncCreatedTexture =
+      std::get_if<AsyncCreatedTexture>(&pHalfLoadedTexture->textureSource);
+  if (pAsyncCreatedTexture && pAsyncCreatedTexture->completionEvent &&
+      !pAsyncCreatedTexture->completionEvent->IsComplete()) {
+    events.Add(pAsyncCreatedTexture->completionEvent);
+  }
+}
+
+CesiumAsync::Future<void> waitForTextureCreation(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    FGraphEventArray&& events) {
+  if (events.IsEmpty()) {
+    return asyncSystem.createResolvedFuture();
+  }
+
+  CesiumAsync::Promise<void> promise = asyncSystem.createPromise<void>();
+  CesiumAsync::Future<void> future = promise.getFuture();
+
+  FFunctionGraphTask::CreateAndDispatchWhenReady(
+      [promise = std::move(promise)]() { promise.resolve(); },
+      TStatId(),
+      &events,
+      ENamedThreads::AnyBackgroundThreadNormalTask);
+
+  return future;
+}
+
+void setFirstResidentMip(UTexture2D* pTexture, int32 firstMip) {
+  check(IsInGameThread());
+
+  FCesiumTextureResource* pCesiumTextureResource =
+      pTexture ? static_cast<FCesiumTextureResource*>(pTexture->GetResource())
+               : nullptr;
+  if (!pCesiumTextureResource) {
+    return;
+  }
+
+  // The resource can only be released by a render command that's enqueued
+  // after this one.
+  ENQUEUE_RENDER_COMMAND(Cesium_SetFirstResidentMip)
+  ([pCesiumTextureResource,
+    firstMip = uint32(FMath::Max(firstMip, 0))](FRHICommandListImmediate&) {
+    pCesiumTextureResource->SetFirstResidentMip(firstMip);
+  });
+}
+
 void destroyTexture(UTexture* pTexture) {
   check(pTexture != nullptr);
+  if (CesiumTextureCache::get().releaseUse(pTexture)) {
+    return;
+  }
+  CesiumTextureStreaming::get().untrack(Cast<UTexture2D>(pTexture));
   CesiumLifetime::destroy(pTexture);
 }
 } // namespace CesiumTextureUtility
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "Async/TaskGraphInterfaces.h"
+#include "CesiumAsync/AsyncSystem.h"
 #include "CesiumGltf/Model.h"
 #include "CesiumMetadataValueType.h"
 #include "Engine/Texture.h"
@@ -24,6 +26,12 @@ namespace CesiumTextureUtility {
  */
 struct AsyncCreatedTexture {
   FTextureRHIRef rhiTextureRef{};
+
+  /**
+   * @brief An event that is signaled when the texture is ready to be used, or
+   * null if it was ready as soon as it was created.
+   */
+  FGraphEventRef completionEvent{};
 };
 
 /**
@@ -56,6 +64,8 @@ struct EmbeddedImageSource {
 /**
  * @brief This indicates that the image mips are stored in the
  * FTexturePlatformData and expect a standard, Unreal texture construction.
+ * This is used for textures, such as encoded metadata, whose mips are written
+ * directly into the FTexturePlatformData.
  *
  * WARNING: Unreal's default texture creation method (via
  * UTexture::UpdateResource) requires an extra memcpy on the game thread and
@@ -86,7 +96,42 @@ struct LoadedTextureResult {
   TextureFilter filter;
   TextureGroup group;
   bool generateMipMaps;
+  /**
+   * @brief Whether only mip 0 of the texture's image is uploaded, with the rest
+   * of the mip chain generated on the GPU.
+   */
+  bool generateMipMapsOnGpu{false};
   bool sRGB{true};
+  /**
+   * @brief Whether the texture's image is block compressed, if it is
+   * uncompressed and the platform supports it.
+   */
+  bool compress{false};
+  /**
+   * @brief A hash of the texture's image and sampling, which identical
+   * textures in other tiles share, or 0 if the texture shouldn't be shared
+   * with other tiles. See {@link CesiumTextureCache}.
+   */
+  uint64 contentKey{0};
+  /**
+   * @brief Whether a texture with the same contentKey was already in use when
+   * this one was loaded, so that it wasn't prepared in the background. The
+   * game thread part uses that texture if it's still in use, and otherwise
+   * prepares this one from its image.
+   */
+  bool useCachedTexture{false};
+  /**
+   * @brief Whether the texture's mips are streamed, so that only the ones its
+   * on-screen size needs are resident on the GPU. A streamed texture keeps
+   * its image on the CPU. See {@link CesiumTextureStreaming}.
+   */
+  bool streamable{false};
+  /**
+   * @brief The most pixels that the texture can span on the screen before its
+   * tile is refined, or 0 if there's no limit. A streamed texture is first
+   * uploaded with only the mips that this needs.
+   */
+  double maximumScreenPixels{0.0};
   TWeakObjectPtr<UTexture2D> pTexture;
   CesiumTextureSource textureSource;
 };
@@ -100,13 +145,22 @@ createTexturePlatformData(int32 sizeX, int32 sizeY, EPixelFormat format);
  * this image within the given glTF, if needed.
  *
  * @param imageSource The source for this image. This function may add mip-maps
- * to the image if needed.
+ * to the image if needed. When asynchronous RHI texture creation isn't
+ * supported, an image that isn't already an EmbeddedImageSource is copied so
+ * that the render thread can create the texture from it later.
  * @param addressX The X addressing mode.
  * @param addressY The Y addressing mode.
  * @param filter The sampler filtering to use for this texture.
  * @param group The texture group of this texture.
  * @param generateMipMaps Whether to generate a mipmap for this image.
  * @param sRGB Whether this texture uses a sRGB color space.
+ * @param compress Whether to block compress this image, if it is uncompressed
+ * and the platform supports it. See {@link CesiumTextureCompression}.
+ * @param stream Whether to stream the texture's mips, even if "Use Texture
+ * Streaming" isn't enabled. See {@link CesiumTextureStreaming}.
+ * @param allowAsyncCreation Whether the RHI texture may be created in this
+ * thread when the RHI supports asynchronous texture creation. If false, it is
+ * always created later on the render thread.
  * @return The loaded texture.
  */
 TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
@@ -116,7 +170,10 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     const TextureFilter& filter,
     const TextureGroup& group,
     bool generateMipMaps,
-    bool sRGB);
+    bool sRGB,
+    bool compress,
+    bool stream = false,
+    bool allowAsyncCreation = true);
 
 /**
  * @brief Does the asynchronous part of renderer resource preparation for this
@@ -126,12 +183,22 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
  * @param model The model.
  * @param texture The texture to load.
  * @param sRGB Whether this texture uses a sRGB color space.
+ * @param compress Whether to block compress this texture's image, if it is
+ * uncompressed and the platform supports it.
+ * @param shareWithOtherTiles Whether to hash the texture's image so that it
+ * can share a texture that another tile created for an identical image. When
+ * such a texture is in use, this texture's image is not prepared at all.
+ * @param stream Whether to stream the texture's mips, even if "Use Texture
+ * Streaming" isn't enabled.
  * @return The loaded texture.
  */
 TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     CesiumGltf::Model& model,
     const CesiumGltf::Texture& texture,
-    bool sRGB);
+    bool sRGB,
+    bool compress,
+    bool shareWithOtherTiles = false,
+    bool stream = false);
 
 /**
  * @brief Does the main-thread part of render resource preparation for this
@@ -146,6 +213,20 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
  */
 UTexture2D* loadTextureGameThreadPart(LoadedTextureResult* pHalfLoadedTexture);
 
+/**
+ * @brief Does the main-thread part of render resource preparation for this
+ * image, giving the new content to an existing texture instead of creating a
+ * new one.
+ *
+ * @param pHalfLoadedTexture The half-loaded renderer texture.
+ * @param pTextureToReuse The texture to reuse, which must not have a renderer
+ * resource. If this is nullptr, a new texture is created.
+ * @return The Unreal texture result.
+ */
+UTexture2D* loadTextureGameThreadPart(
+    LoadedTextureResult* pHalfLoadedTexture,
+    UTexture2D* pTextureToReuse);
+
 /**
  * @brief Does the main-thread part of render resource preparation for this
  * image and queues up any required render-thread tasks to finish preparing the
@@ -160,6 +241,64 @@ UTexture2D* loadTextureGameThreadPart(
     const CesiumGltf::Model& model,
     LoadedTextureResult* pHalfLoadedTexture);
 
+/**
+ * @brief Adds the event that will be signaled when the given half-loaded
+ * texture's RHI texture is ready, if it was created asynchronously and isn't
+ * ready yet.
+ *
+ * @param pHalfLoadedTexture The half-loaded texture, which may be null.
+ * @param events The events to add to.
+ */
+void addTextureCreationEvent(
+    const LoadedTextureResult* pHalfLoadedTexture,
+    FGraphEventArray& events);
+
+/**
+ * @brief Creates a future that resolves, without blocking any thread, once all
+ * of the given texture creation events have been signaled.
+ *
+ * @param asyncSystem The async system.
+ * @param events The events to wait for.
+ * @return The future.
+ */
+CesiumAsync::Future<void> waitForTextureCreation(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    FGraphEventArray&& events);
+
+/**
+ * @brief Replaces the image of a texture created by loadTextureGameThreadPart
+ * with a newly half-loaded one, such as the full image of a raster overlay
+ * tile that was first shown as a low-resolution preview. The texture keeps its
+ * resource and texture reference, so materials that use it don't need to be
+ * updated. The texture's sampling is unchanged. Must be called from the game
+ * thread.
+ *
+ * @param pTexture The texture, which must not be shared with other tiles.
+ * @param pHalfLoadedTexture The result of loadTextureAnyThreadPart for the new
+ * image.
+ * @return Whether the image was replaced. If not, pHalfLoadedTexture is left
+ * for the caller to destroy.
+ */
+bool replaceTextureImage(
+    UTexture2D* pTexture,
+    TUniquePtr<LoadedTextureResult>&& pHalfLoadedTexture);
+
 void destroyHalfLoadedTexture(LoadedTextureResult& halfLoaded);
+
+/**
+ * @brief Changes which mips of a streamed texture are resident on the GPU.
+ * The render thread recreates the texture's RHI texture from its CPU image,
+ * with only the mips from the given one down. Does nothing if the texture
+ * isn't streamed. Must be called from the game thread.
+ *
+ * @param pTexture The texture, which was created by loadTextureGameThreadPart.
+ * @param firstMip The index of the most detailed mip to keep resident.
+ */
+void setFirstResidentMip(UTexture2D* pTexture, int32 firstMip);
+
+/**
+ * @brief Destroys a texture, unless it has uses in {@link CesiumTextureCache}
+ * other than the one being released.
+ */
 void destroyTexture(UTexture* pTexture);
 } // namespace CesiumTextureUtility
@@ -85,6 +85,20 @@ bool UCesiumTileExcluder::ShouldExclude_Implementation(
   return false;
 }
 
+void UCesiumTileExcluder::ShouldExcludeTiles(
+    TConstArrayView<FBoxSphereBounds> TileBounds,
+    TBitArray<>& OutExcluded) {
+  OutExcluded.Init(false, TileBounds.Num());
+  if (!IsValid(CesiumTile)) {
+    return;
+  }
+
+  for (int32 i = 0; i < TileBounds.Num(); ++i) {
+    CesiumTile->Bounds = TileBounds[i];
+    OutExcluded[i] = this->ShouldExclude(CesiumTile);
+  }
+}
+
 void UCesiumTileExcluder::Activate(bool bReset) {
   Super::Activate(bReset);
   this->AddToTileset();
@@ -1,4 +1,5 @@
 #include "CesiumTileExcluderAdapter.h"
+#include "CalcBounds.h"
 #include "Cesium3DTilesSelection/Tile.h"
 #include "CesiumGeoreference.h"
 #include "VecMath.h"
@@ -9,8 +10,14 @@ bool CesiumTileExcluderAdapter::shouldExclude(
     return false;
   }
   Tile->_tileBounds = tile.getBoundingVolume();
-  Tile->UpdateBounds();
-  return Excluder->ShouldExclude(Tile);
+  const FBoxSphereBounds bounds = std::visit(
+      CalcBoundsOperation{this->TileLocalToWorld, Tile->_tileTransform},
+      Tile->_tileBounds);
+
+  Excluder->ShouldExcludeTiles(
+      TConstArrayView<FBoxSphereBounds>(&bounds, 1),
+      this->Excluded);
+  return this->Excluded.Num() > 0 && this->Excluded[0];
 }
 
 void CesiumTileExcluderAdapter::startNewFrame() noexcept {
@@ -23,6 +30,9 @@ void CesiumTileExcluderAdapter::startNewFrame() noexcept {
   Tile->_tileTransform =
       Georeference->GetGeoTransforms()
           .GetAbsoluteUnrealWorldToEllipsoidCenteredTransform();
+  this->TileLocalToWorld = Tile->GetComponentTransform();
+
+  Excluder->PrepareForNewFrame();
 }
 
 CesiumTileExcluderAdapter::CesiumTileExcluderAdapter(
@@ -1,6 +1,7 @@
 #pragma once
 #include "CesiumTile.h"
 #include "CesiumTileExcluder.h"
+#include "Containers/BitArray.h"
 #include <Cesium3DTilesSelection/ITileExcluder.h>
 
 class ACesiumGeoreference;
@@ -20,6 +21,13 @@ private:
   ACesiumGeoreference* Georeference;
   bool IsExcluderValid;
 
+  // The transform of the Tile component as of the start of the frame, so
+  // that tile bounds can be computed without going through the component.
+  FTransform TileLocalToWorld;
+
+  // Reused for every tile to avoid allocating.
+  mutable TBitArray<> Excluded;
+
 public:
   CesiumTileExcluderAdapter(
       TWeakObjectPtr<UCesiumTileExcluder> pExcluder,
@@ -1,6 +1,7 @@
 ﻿// Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "CesiumTileMapServiceRasterOverlay.h"
+#include "CesiumCoalescingAssetAccessor.h"
 #include "CesiumRasterOverlays/TileMapServiceRasterOverlay.h"
 #include "CesiumRuntime.h"
 
@@ -12,7 +13,8 @@ UCesiumTileMapServiceRasterOverlay::CreateOverlay(
     tmsOptions.minimumLevel = MinimumLevel;
     tmsOptions.maximumLevel = MaximumLevel;
   }
-  return std::make_unique<CesiumRasterOverlays::TileMapServiceRasterOverlay>(
+  return std::make_unique<CesiumCoalescingRasterOverlay<
+      CesiumRasterOverlays::TileMapServiceRasterOverlay>>(
       TCHAR_TO_UTF8(*this->MaterialLayerKey),
       TCHAR_TO_UTF8(*this->Url),
       std::vector<CesiumAsync::IAssetAccessor::THeader>(),
@@ -0,0 +1,315 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilePipelineTimings.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRuntime.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Tile Request Time p95 (ms)"),
+    STAT_CesiumTileRequestTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Tile Parse Time p95 (ms)"),
+    STAT_CesiumTileParseTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Tile Load Thread Time p95 (ms)"),
+    STAT_CesiumTileLoadThreadTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Tile Main Thread Queue Time p95 (ms)"),
+    STAT_CesiumTileMainThreadQueueTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Tile Main Thread Time p95 (ms)"),
+    STAT_CesiumTileMainThreadTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Tile First Render Time p95 (ms)"),
+    STAT_CesiumTileFirstRenderTime,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Tile Total Load Time p95 (ms)"),
+    STAT_CesiumTileTotalLoadTime,
+    STATGROUP_Cesium);
+
+namespace {
+
+// Request times that haven't been claimed by a tile after this long are
+// for content that isn't a tile's, like subtrees and external tilesets.
+constexpr double staleRequestSeconds = 60.0;
+constexpr size_t requestsBeforePrune = 256;
+
+} // namespace
+
+class CesiumRequestTimingAssetAccessor::Times {
+public:
+  void add(const std::string& url, double start, double response) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    if (this->_times.size() >= this->_pruneThreshold) {
+      for (auto it = this->_times.begin(); it != this->_times.end();) {
+        if (it->second.response + staleRequestSeconds < response) {
+          it = this->_times.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      this->_pruneThreshold =
+          std::max(requestsBeforePrune, this->_times.size() * 2);
+    }
+
+    this->_times[url] = {start, response};
+  }
+
+  bool take(const std::string& url, CesiumTileTimings& timings) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_times.find(url);
+    if (it == this->_times.end()) {
+      return false;
+    }
+
+    timings.requestStart = it->second.start;
+    timings.response = it->second.response;
+    this->_times.erase(it);
+    return true;
+  }
+
+private:
+  struct Entry {
+    double start;
+    double response;
+  };
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, Entry> _times;
+  size_t _pruneThreshold = requestsBeforePrune;
+};
+
+CesiumRequestTimingAssetAccessor::CesiumRequestTimingAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor)
+    : _pAssetAccessor(pAssetAccessor), _pTimes(std::make_shared<Times>()) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRequestTimingAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  const double start = FPlatformTime::Seconds();
+  return this->_pAssetAccessor->get(asyncSystem, url, headers)
+      .thenImmediately(
+          [pTimes = this->_pTimes, url, start](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            pTimes->add(url, start, FPlatformTime::Seconds());
+            return std::move(pRequest);
+          });
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRequestTimingAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumRequestTimingAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+bool CesiumRequestTimingAssetAccessor::takeRequestTimes(
+    const std::string& url,
+    CesiumTileTimings& timings) {
+  return this->_pTimes->take(url, timings);
+}
+
+void CesiumTilePipelineHistograms::Histogram::add(double milliseconds) {
+  milliseconds = std::max(milliseconds, 0.0);
+
+  int32 bucket = 0;
+  if (milliseconds > SmallestBucketMilliseconds) {
+    bucket = int32(std::ceil(
+        BucketsPerOctave *
+        std::log2(milliseconds / SmallestBucketMilliseconds)));
+  }
+  ++this->buckets[std::clamp(bucket, 0, BucketCount - 1)];
+
+  ++this->count;
+  this->sumMilliseconds += milliseconds;
+  this->maximumMilliseconds =
+      std::max(this->maximumMilliseconds, milliseconds);
+}
+
+double
+CesiumTilePipelineHistograms::Histogram::getPercentile(double fraction) const {
+  if (this->count == 0) {
+    return 0.0;
+  }
+
+  const int64 rank =
+      std::max(int64(std::ceil(fraction * double(this->count))), int64(1));
+  int64 cumulative = 0;
+  for (int32 bucket = 0; bucket < BucketCount; ++bucket) {
+    cumulative += this->buckets[bucket];
+    if (cumulative >= rank) {
+      return std::min(
+          getBucketUpperBound(bucket),
+          this->maximumMilliseconds);
+    }
+  }
+
+  return this->maximumMilliseconds;
+}
+
+FCesiumTilePipelineStageStatistics
+CesiumTilePipelineHistograms::Histogram::getStatistics() const {
+  FCesiumTilePipelineStageStatistics result;
+  result.Count = this->count;
+  result.AverageMilliseconds =
+      this->count > 0 ? this->sumMilliseconds / double(this->count) : 0.0;
+  result.MedianMilliseconds = this->getPercentile(0.5);
+  result.P95Milliseconds = this->getPercentile(0.95);
+  result.MaximumMilliseconds = this->maximumMilliseconds;
+  return result;
+}
+
+/*static*/ double
+CesiumTilePipelineHistograms::getBucketUpperBound(int32 bucket) {
+  return SmallestBucketMilliseconds *
+         std::exp2(double(bucket) / double(BucketsPerOctave));
+}
+
+void CesiumTilePipelineHistograms::addTile(
+    const CesiumTileTimings& timings,
+    double firstRenderTime) {
+  this->addStages(timings, firstRenderTime);
+
+  CesiumTilePipelineHistograms& global = getGlobal();
+  if (this == &global) {
+    return;
+  }
+
+  global.addStages(timings, firstRenderTime);
+
+  SET_FLOAT_STAT(
+      STAT_CesiumTileRequestTime,
+      global._histograms[Request].getPercentile(0.95));
+  SET_FLOAT_STAT(
+      STAT_CesiumTileParseTime,
+      global._histograms[Parse].getPercentile(0.95));
+  SET_FLOAT_STAT(
+      STAT_CesiumTileLoadThreadTime,
+      global._histograms[LoadThread].getPercentile(0.95));
+  SET_FLOAT_STAT(
+      STAT_CesiumTileMainThreadQueueTime,
+      global._histograms[MainThreadQueue].getPercentile(0.95));
+  SET_FLOAT_STAT(
+      STAT_CesiumTileMainThreadTime,
+      global._histograms[MainThread].getPercentile(0.95));
+  SET_FLOAT_STAT(
+      STAT_CesiumTileFirstRenderTime,
+      global._histograms[FirstRender].getPercentile(0.95));
+  SET_FLOAT_STAT(
+      STAT_CesiumTileTotalLoadTime,
+      global._histograms[Total].getPercentile(0.95));
+}
+
+void CesiumTilePipelineHistograms::addStages(
+    const CesiumTileTimings& timings,
+    double firstRenderTime) {
+  if (timings.requestStart > 0.0) {
+    this->addStage(Request, timings.requestStart, timings.response);
+    this->addStage(Parse, timings.response, timings.loadThreadStart);
+  }
+  this->addStage(LoadThread, timings.loadThreadStart, timings.loadThreadEnd);
+  this->addStage(
+      MainThreadQueue,
+      timings.loadThreadEnd,
+      timings.mainThreadStart);
+  this->addStage(MainThread, timings.mainThreadStart, timings.mainThreadEnd);
+  this->addStage(FirstRender, timings.mainThreadEnd, firstRenderTime);
+  this->addStage(
+      Total,
+      timings.requestStart > 0.0 ? timings.requestStart
+                                 : timings.loadThreadStart,
+      firstRenderTime);
+}
+
+void CesiumTilePipelineHistograms::addStage(
+    Stage stage,
+    double start,
+    double end) {
+  if (start <= 0.0 || end <= 0.0) {
+    return;
+  }
+  this->_histograms[stage].add((end - start) * 1000.0);
+}
+
+FCesiumTilePipelineStatistics
+CesiumTilePipelineHistograms::getStatistics() const {
+  FCesiumTilePipelineStatistics result;
+  result.Request = this->_histograms[Request].getStatistics();
+  result.Parse = this->_histograms[Parse].getStatistics();
+  result.LoadThread = this->_histograms[LoadThread].getStatistics();
+  result.MainThreadQueue = this->_histograms[MainThreadQueue].getStatistics();
+  result.MainThread = this->_histograms[MainThread].getStatistics();
+  result.FirstRender = this->_histograms[FirstRender].getStatistics();
+  result.Total = this->_histograms[Total].getStatistics();
+  return result;
+}
+
+void CesiumTilePipelineHistograms::reset() {
+  this->_histograms = std::array<Histogram, StageCount>();
+}
+
+bool CesiumTilePipelineHistograms::writeCsv(const FString& filename) const {
+  static const TCHAR* stageNames[StageCount] = {
+      TEXT("Request"),
+      TEXT("Parse"),
+      TEXT("LoadThread"),
+      TEXT("MainThreadQueue"),
+      TEXT("MainThread"),
+      TEXT("FirstRender"),
+      TEXT("Total")};
+
+  FString csv = TEXT("Stage,Count,AverageMs,MedianMs,P95Ms,MaximumMs");
+  for (int32 bucket = 0; bucket < BucketCount; ++bucket) {
+    csv += FString::Printf(TEXT(",<=%gms"), getBucketUpperBound(bucket));
+  }
+  csv += TEXT("\n");
+
+  for (int32 stage = 0; stage < StageCount; ++stage) {
+    const Histogram& histogram = this->_histograms[stage];
+    const FCesiumTilePipelineStageStatistics statistics =
+        histogram.getStatistics();
+    csv += FString::Printf(
+        TEXT("%s,%lld,%f,%f,%f,%f"),
+        stageNames[stage],
+        statistics.Count,
+        statistics.AverageMilliseconds,
+        statistics.MedianMilliseconds,
+        statistics.P95Milliseconds,
+        statistics.MaximumMilliseconds);
+    for (int64 bucketCount : histogram.buckets) {
+      csv += FString::Printf(TEXT(",%lld"), bucketCount);
+    }
+    csv += TEXT("\n");
+  }
+
+  return FFileHelper::SaveStringToFile(csv, *filename);
+}
+
+/*static*/ CesiumTilePipelineHistograms&
+CesiumTilePipelineHistograms::getGlobal() {
+  static CesiumTilePipelineHistograms global;
+  return global;
+}
@@ -0,0 +1,133 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumTilePipelineStatistics.h"
+#include "Containers/UnrealString.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * The times, from FPlatformTime::Seconds, at which a tile reached each stage
+ * of the tile loading pipeline. A time of 0.0 means the stage wasn't timed.
+ */
+struct CesiumTileTimings {
+  double requestStart = 0.0;
+  double response = 0.0;
+  double loadThreadStart = 0.0;
+  double loadThreadEnd = 0.0;
+  double mainThreadStart = 0.0;
+  double mainThreadEnd = 0.0;
+
+  // The size of the response to the tile's content request, in bytes.
+  int64 responseBytes = 0;
+};
+
+/**
+ * An asset accessor that remembers when each of its requests was made and
+ * when its response arrived, so that the times can be attached to the tile
+ * whose content the request was for once it reaches
+ * `prepareInLoadThread`.
+ */
+class CesiumRequestTimingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  CesiumRequestTimingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Removes the times of the completed GET request for the given URL and
+   * copies them into the given timings. Returns false if there's no such
+   * request. May be called from any thread.
+   */
+  bool takeRequestTimes(const std::string& url, CesiumTileTimings& timings);
+
+private:
+  class Times;
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<Times> _pTimes;
+};
+
+/**
+ * Histograms of the time tiles have spent in each stage of the tile loading
+ * pipeline. Must only be used from the game thread.
+ */
+class CesiumTilePipelineHistograms {
+public:
+  /**
+   * Adds the stages of a tile that was rendered for the first time at the
+   * given time to these histograms and to the global ones.
+   */
+  void addTile(const CesiumTileTimings& timings, double firstRenderTime);
+
+  FCesiumTilePipelineStatistics getStatistics() const;
+
+  void reset();
+
+  /**
+   * Writes one row per stage, with the count, mean, percentiles, and the
+   * number of tiles in each histogram bucket, to a CSV file.
+   */
+  bool writeCsv(const FString& filename) const;
+
+  /**
+   * Gets histograms of the tiles of every tileset since startup, which are
+   * shown by `stat Cesium`.
+   */
+  static CesiumTilePipelineHistograms& getGlobal();
+
+private:
+  enum Stage {
+    Request,
+    Parse,
+    LoadThread,
+    MainThreadQueue,
+    MainThread,
+    FirstRender,
+    Total,
+    StageCount
+  };
+
+  // Four buckets per doubling of the time, from 1/16 ms to about 65 seconds.
+  static constexpr int32 BucketsPerOctave = 4;
+  static constexpr int32 BucketCount = 80;
+  static constexpr double SmallestBucketMilliseconds = 1.0 / 16.0;
+
+  struct Histogram {
+    int64 count = 0;
+    double sumMilliseconds = 0.0;
+    double maximumMilliseconds = 0.0;
+    std::array<int64, BucketCount> buckets{};
+
+    void add(double milliseconds);
+    double getPercentile(double fraction) const;
+    FCesiumTilePipelineStageStatistics getStatistics() const;
+  };
+
+  static double getBucketUpperBound(int32 bucket);
+
+  void addStages(const CesiumTileTimings& timings, double firstRenderTime);
+  void addStage(Stage stage, double start, double end);
+
+  std::array<Histogram, StageCount> _histograms;
+};
@@ -0,0 +1,86 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileTrace.h"
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/TileID.h"
+#include "Cesium3DTileset.h"
+#include "HAL/PlatformTime.h"
+#include "Trace/Trace.inl"
+#include <algorithm>
+
+UE_TRACE_CHANNEL_DEFINE(CesiumChannel)
+
+UE_TRACE_EVENT_BEGIN(Cesium, TileEvent)
+  UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+  UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+  UE_TRACE_EVENT_FIELD(uint64, Tileset)
+  UE_TRACE_EVENT_FIELD(uint64, Tile)
+  UE_TRACE_EVENT_FIELD(int64, Bytes)
+  UE_TRACE_EVENT_FIELD(double, GeometricError)
+  UE_TRACE_EVENT_FIELD(uint32, Depth)
+  UE_TRACE_EVENT_FIELD(uint8, Stage)
+  UE_TRACE_EVENT_FIELD(UE::Trace::WideString, TilesetName)
+  UE_TRACE_EVENT_FIELD(UE::Trace::WideString, TileId)
+UE_TRACE_EVENT_END()
+
+namespace {
+
+// Trace events are timestamped in cycles, but the tile loading pipeline is
+// timed with FPlatformTime::Seconds, which may be offset from them.
+uint64 secondsToCycles(double seconds, double nowSeconds, uint64 nowCycles) {
+  const double secondsAgo = std::max(nowSeconds - seconds, 0.0);
+  const uint64 cyclesAgo =
+      uint64(secondsAgo / FPlatformTime::GetSecondsPerCycle64());
+  return cyclesAgo < nowCycles ? nowCycles - cyclesAgo : 0;
+}
+
+uint32 getDepth(const Cesium3DTilesSelection::Tile& tile) {
+  uint32 depth = 0;
+  for (const Cesium3DTilesSelection::Tile* pParent = tile.getParent();
+       pParent;
+       pParent = pParent->getParent()) {
+    ++depth;
+  }
+  return depth;
+}
+
+} // namespace
+
+namespace CesiumTileTrace {
+
+bool isEnabled() { return UE_TRACE_CHANNELEXPR_IS_ENABLED(CesiumChannel); }
+
+void traceStage(
+    const ACesium3DTileset& tileset,
+    const Cesium3DTilesSelection::Tile& tile,
+    ECesiumTileTraceStage stage,
+    double startSeconds,
+    double endSeconds,
+    int64 bytes) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  const double nowSeconds = FPlatformTime::Seconds();
+  const uint64 nowCycles = FPlatformTime::Cycles64();
+
+  const FString tilesetName = tileset.GetName();
+  const FString tileId(
+      Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+          tile.getTileID())
+          .c_str());
+
+  UE_TRACE_LOG(Cesium, TileEvent, CesiumChannel)
+      << TileEvent.StartCycle(
+             secondsToCycles(startSeconds, nowSeconds, nowCycles))
+      << TileEvent.EndCycle(secondsToCycles(endSeconds, nowSeconds, nowCycles))
+      << TileEvent.Tileset(uint64(reinterpret_cast<UPTRINT>(&tileset)))
+      << TileEvent.Tile(uint64(reinterpret_cast<UPTRINT>(&tile)))
+      << TileEvent.Bytes(bytes)
+      << TileEvent.GeometricError(tile.getGeometricError())
+      << TileEvent.Depth(getDepth(tile)) << TileEvent.Stage(uint8(stage))
+      << TileEvent.TilesetName(*tilesetName, tilesetName.Len())
+      << TileEvent.TileId(*tileId, tileId.Len());
+}
+
+} // namespace CesiumTileTrace
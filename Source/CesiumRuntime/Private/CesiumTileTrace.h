@@ -0,0 +1,62 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ACesium3DTileset;
+
+namespace Cesium3DTilesSelection {
+class Tile;
+}
+
+/**
+ * The stages of a tile's life that are sent as `Cesium.TileEvent` events on
+ * the `Cesium` trace channel, for the Cesium tracks in Unreal Insights. The
+ * values are part of the trace format, so they must not be changed.
+ */
+enum class ECesiumTileTraceStage : uint8 {
+  Request = 0,
+  Load = 1,
+  Upload = 2,
+  Show = 3,
+  Hide = 4,
+  Free = 5
+};
+
+/**
+ * Sends tile events on the `Cesium` trace channel, which is enabled with
+ * `-trace=cpu,cesium` or `Trace.Enable Cesium`. Must only be used from the
+ * game thread.
+ */
+namespace CesiumTileTrace {
+
+/**
+ * Whether the `Cesium` trace channel is enabled. Events are only worth
+ * gathering when it is.
+ */
+bool isEnabled();
+
+/**
+ * Sends an event for a stage of a tile that started and ended at the given
+ * times, from FPlatformTime::Seconds. An instant stage, like Show or Hide,
+ * starts and ends at the same time.
+ *
+ * @param tileset The tileset the tile belongs to.
+ * @param tile The tile.
+ * @param stage The stage.
+ * @param startSeconds When the stage started.
+ * @param endSeconds When the stage ended.
+ * @param bytes The size of the tile's data in this stage: the size of the
+ * response for Request and the memory of the tile's Unreal resources for the
+ * other stages.
+ */
+void traceStage(
+    const ACesium3DTileset& tileset,
+    const Cesium3DTilesSelection::Tile& tile,
+    ECesiumTileTraceStage stage,
+    double startSeconds,
+    double endSeconds,
+    int64 bytes);
+
+} // namespace CesiumTileTrace
@@ -0,0 +1,183 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetBaking.h"
+#include "CesiumBakingGeometry.h"
+#include "CesiumGltfPrimitiveComponent.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+#include "UObject/Package.h"
+#include "WorldPartition/HLOD/HLODLayer.h"
+#endif
+
+namespace CesiumTilesetBaking {
+
+#if WITH_EDITOR
+
+namespace {
+
+// The primitive's materials are transient instances, so the first asset they
+// were created from is used instead.
+UMaterialInterface* getMaterialAsset(UMaterialInterface* pMaterial) {
+  while (pMaterial && pMaterial->HasAnyFlags(RF_Transient)) {
+    UMaterialInstance* pInstance = Cast<UMaterialInstance>(pMaterial);
+    pMaterial = pInstance ? pInstance->Parent.Get() : nullptr;
+  }
+  return pMaterial;
+}
+
+FMeshDescription createMeshDescription(const CesiumBakingGeometry& geometry) {
+  FMeshDescription description;
+  FStaticMeshAttributes attributes(description);
+  attributes.Register();
+
+  TVertexAttributesRef<FVector3f> positions =
+      attributes.GetVertexPositions();
+  TVertexInstanceAttributesRef<FVector3f> normals =
+      attributes.GetVertexInstanceNormals();
+  TVertexInstanceAttributesRef<FVector2f> texCoords =
+      attributes.GetVertexInstanceUVs();
+
+  const int32 vertexCount = geometry.positions.Num();
+  const int32 triangleCount = geometry.indices.Num() / 3;
+  description.ReserveNewVertices(vertexCount);
+  description.ReserveNewVertexInstances(geometry.indices.Num());
+  description.ReserveNewTriangles(triangleCount);
+
+  for (int32 i = 0; i < vertexCount; ++i) {
+    const FVertexID vertex = description.CreateVertex();
+    positions[vertex] = geometry.positions[i];
+  }
+
+  const bool hasNormals = geometry.normals.Num() == vertexCount;
+  const bool hasTexCoords = geometry.texCoords.Num() == vertexCount;
+  const FPolygonGroupID polygonGroup = description.CreatePolygonGroup();
+  TArray<FVertexInstanceID, TInlineAllocator<3>> corners;
+  for (int32 triangle = 0; triangle < triangleCount; ++triangle) {
+    corners.Reset();
+    bool valid = true;
+    for (int32 corner = 0; corner < 3; ++corner) {
+      const uint32 index = geometry.indices[3 * triangle + corner];
+      if (index >= uint32(vertexCount)) {
+        valid = false;
+        break;
+      }
+      const FVertexInstanceID instance =
+          description.CreateVertexInstance(FVertexID(int32(index)));
+      if (hasNormals) {
+        normals[instance] = geometry.normals[index];
+      }
+      if (hasTexCoords) {
+        texCoords[instance] = geometry.texCoords[index];
+      }
+      corners.Add(instance);
+    }
+    if (valid) {
+      description.CreateTriangle(polygonGroup, corners);
+    }
+  }
+
+  return description;
+}
+
+} // namespace
+
+bool isSupported() { return true; }
+
+AActor* bakePrimitive(
+    UWorld& world,
+    const UCesiumGltfPrimitiveComponent& primitive,
+    const FString& packagePath,
+    const FString& assetName,
+    const FName& folderPath,
+    UHLODLayer* pHLODLayer,
+    bool buildNanite) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BakePrimitive)
+
+  if (!primitive.BakingGeometry ||
+      primitive.BakingGeometry->indices.Num() < 3) {
+    return nullptr;
+  }
+  const CesiumBakingGeometry& geometry = *primitive.BakingGeometry;
+
+  UPackage* pPackage = CreatePackage(*(packagePath / assetName));
+  if (!pPackage) {
+    return nullptr;
+  }
+  pPackage->FullyLoad();
+
+  UStaticMesh* pMesh = NewObject<UStaticMesh>(
+      pPackage,
+      FName(*assetName),
+      RF_Public | RF_Standalone | RF_Transactional);
+
+  // The whole primitive uses a single material, since glTF primitives only
+  // have one.
+  pMesh->GetStaticMaterials().Add(
+      FStaticMaterial(getMaterialAsset(primitive.GetMaterial(0))));
+
+  FStaticMeshSourceModel& sourceModel = pMesh->AddSourceModel();
+  sourceModel.BuildSettings.bRecomputeNormals = geometry.normals.IsEmpty();
+  sourceModel.BuildSettings.bRecomputeTangents = true;
+  sourceModel.BuildSettings.bUseMikkTSpace = true;
+  sourceModel.BuildSettings.bGenerateLightmapUVs = false;
+  sourceModel.BuildSettings.bRemoveDegenerates = true;
+  pMesh->NaniteSettings.bEnabled = buildNanite;
+
+  pMesh->CreateMeshDescription(0, createMeshDescription(geometry));
+  pMesh->CommitMeshDescription(0);
+  pMesh->Build(true);
+  pMesh->PostEditChange();
+
+  FAssetRegistryModule::AssetCreated(pMesh);
+  pPackage->MarkPackageDirty();
+
+  FActorSpawnParameters spawnParameters;
+  spawnParameters.Name = FName(*assetName);
+  spawnParameters.NameMode =
+      FActorSpawnParameters::ESpawnActorNameMode::Requested;
+  AStaticMeshActor* pActor = world.SpawnActor<AStaticMeshActor>(
+      AStaticMeshActor::StaticClass(),
+      primitive.GetComponentTransform(),
+      spawnParameters);
+  if (!pActor) {
+    return nullptr;
+  }
+
+  pActor->SetMobility(EComponentMobility::Static);
+  pActor->GetStaticMeshComponent()->SetStaticMesh(pMesh);
+  pActor->SetActorLabel(assetName);
+  pActor->SetFolderPath(folderPath);
+  pActor->SetIsSpatiallyLoaded(true);
+  if (pHLODLayer) {
+    pActor->SetHLODLayer(pHLODLayer);
+  }
+  pActor->MarkPackageDirty();
+
+  return pActor;
+}
+
+#else
+
+bool isSupported() { return false; }
+
+AActor* bakePrimitive(
+    UWorld& world,
+    const UCesiumGltfPrimitiveComponent& primitive,
+    const FString& packagePath,
+    const FString& assetName,
+    const FName& folderPath,
+    UHLODLayer* pHLODLayer,
+    bool buildNanite) {
+  return nullptr;
+}
+
+#endif
+
+} // namespace CesiumTilesetBaking
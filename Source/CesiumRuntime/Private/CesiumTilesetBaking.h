@@ -0,0 +1,50 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/UnrealString.h"
+
+class AActor;
+class UCesiumGltfPrimitiveComponent;
+class UHLODLayer;
+class UWorld;
+
+namespace CesiumTilesetBaking {
+
+/**
+ * Whether tilesets can be baked in this build of Unreal Engine. Static mesh
+ * assets can only be created in the editor.
+ */
+bool isSupported();
+
+/**
+ * @brief Creates a static mesh asset from the baking geometry of a loaded
+ * primitive, and a static mesh actor that shows it in place of the
+ * primitive.
+ *
+ * The mesh keeps the primitive's coordinates, relative to its component, and
+ * the actor is given the component's transform. Each section uses the asset
+ * that the primitive's material was created from, since the primitive's own
+ * material is transient. The new package is marked dirty, but isn't saved.
+ *
+ * @param world The world to spawn the actor in.
+ * @param primitive The primitive, which must have baking geometry.
+ * @param packagePath The content path to create the asset in, such as
+ * "/Game/Cesium/Baked".
+ * @param assetName The name of the asset, which must be unique in the path.
+ * @param folderPath The World Outliner folder to put the actor in.
+ * @param pHLODLayer The HLOD layer to assign to the actor, or nullptr to use
+ * the world's default.
+ * @param buildNanite Whether to enable Nanite for the mesh.
+ * @return The actor, or nullptr if the mesh could not be created.
+ */
+AActor* bakePrimitive(
+    UWorld& world,
+    const UCesiumGltfPrimitiveComponent& primitive,
+    const FString& packagePath,
+    const FString& assetName,
+    const FName& folderPath,
+    UHLODLayer* pHLODLayer,
+    bool buildNanite);
+
+} // namespace CesiumTilesetBaking
@@ -0,0 +1,58 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetReaper.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumRuntime.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Tilesets Pending Destruction"),
+    STAT_CesiumTilesetsPendingDestruction,
+    STATGROUP_Cesium);
+
+/*static*/ CesiumTilesetReaper& CesiumTilesetReaper::get() {
+  static CesiumTilesetReaper reaper;
+  return reaper;
+}
+
+void CesiumTilesetReaper::reap(
+    TUniquePtr<Cesium3DTilesSelection::Tileset>&& pTileset) {
+  if (!pTileset) {
+    return;
+  }
+
+  ++this->_pending;
+  pTileset->getAsyncDestructionCompleteEvent().thenInMainThread([this]() {
+    --this->_pending;
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("A destroyed tileset finished its outstanding work, %d remain"),
+        this->_pending);
+  });
+
+  pTileset.Reset();
+}
+
+void CesiumTilesetReaper::Tick(float DeltaTime) {
+  SET_DWORD_STAT(STAT_CesiumTilesetsPendingDestruction, this->_pending);
+
+  if (this->_pending == 0) {
+    return;
+  }
+
+  // Tilesets dispatch these themselves as they update, but the destroyed
+  // tilesets' loads must finish even if no other tileset is left.
+  getAssetAccessor()->tick();
+  getAsyncSystem().dispatchMainThreadTasks();
+}
+
+ETickableTickType CesiumTilesetReaper::GetTickableTickType() const {
+  return ETickableTickType::Always;
+}
+
+bool CesiumTilesetReaper::IsTickableWhenPaused() const { return true; }
+
+bool CesiumTilesetReaper::IsTickableInEditor() const { return true; }
+
+TStatId CesiumTilesetReaper::GetStatId() const { return TStatId(); }
@@ -0,0 +1,53 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Templates/UniquePtr.h"
+#include "Tickable.h"
+
+namespace Cesium3DTilesSelection {
+class Tileset;
+}
+
+/**
+ * Takes over cesium-native tilesets that their ACesium3DTileset no longer
+ * needs, so that the actor can be destroyed without waiting for them.
+ *
+ * A tileset's loads that are in flight when it is destroyed keep running in
+ * the background, and its asynchronous destruction isn't complete until they
+ * have finished. The tileset's renderer resources must be detached from its
+ * actor before it is given to the reaper, so that those loads don't use the
+ * actor. The reaper then keeps dispatching the main thread work that the
+ * loads are waiting on, even when there isn't any other tileset left to do
+ * so, until every tileset it was given is completely destroyed.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumTilesetReaper : FTickableGameObject {
+public:
+  /**
+   * Gets the reaper shared by all tilesets.
+   */
+  static CesiumTilesetReaper& get();
+
+  /**
+   * Destroys the tileset, and keeps its outstanding asynchronous work going
+   * until its destruction is complete.
+   */
+  void reap(TUniquePtr<Cesium3DTilesSelection::Tileset>&& pTileset);
+
+  /**
+   * Gets the number of tilesets whose asynchronous destruction isn't
+   * complete yet.
+   */
+  int32 getPendingCount() const { return this->_pending; }
+
+  void Tick(float DeltaTime) override;
+  ETickableTickType GetTickableTickType() const override;
+  bool IsTickableWhenPaused() const override;
+  bool IsTickableInEditor() const override;
+  TStatId GetStatId() const override;
+
+private:
+  int32 _pending = 0;
+};
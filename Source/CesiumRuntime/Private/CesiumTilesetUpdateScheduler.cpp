@@ -0,0 +1,147 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetUpdateScheduler.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntimeSettings.h"
+#include "CoreGlobals.h"
+#include "Engine/World.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+// Tilesets that are loading tiles are updated this many times as often as
+// idle tilesets at the same distance.
+constexpr double LoadingPriorityFactor = 4.0;
+
+// The distance, in meters, at which a tileset is updated half as often as one
+// that a camera is inside.
+constexpr double HalfPriorityDistance = 1000.0;
+
+// A tileset that has waited this many frames is updated ahead of any tileset
+// that has waited less, no matter how far away it is.
+constexpr int32 MaximumFramesBetweenUpdates = 60;
+constexpr double OverduePriority = 1.0e6;
+
+double computePriority(
+    const CesiumTilesetUpdateScheduler::Report& report,
+    int32 framesSinceUpdate) {
+  // Other priorities are at most MaximumFramesBetweenUpdates *
+  // LoadingPriorityFactor, so this puts overdue tilesets first, longest
+  // waiting first.
+  if (framesSinceUpdate >= MaximumFramesBetweenUpdates) {
+    return OverduePriority * double(framesSinceUpdate);
+  }
+
+  double priority = double(framesSinceUpdate + 1) /
+                    (1.0 + report.distance / HalfPriorityDistance);
+  if (report.isLoading) {
+    priority *= LoadingPriorityFactor;
+  }
+  return priority;
+}
+} // namespace
+
+/*static*/ TMap<TObjectKey<UWorld>, CesiumTilesetUpdateScheduler::WorldState>
+    CesiumTilesetUpdateScheduler::_worlds{};
+
+/*static*/ bool CesiumTilesetUpdateScheduler::shouldUpdate(
+    const UWorld* pWorld,
+    const ACesium3DTileset* pTileset) {
+  if (GetDefault<UCesiumRuntimeSettings>()->MaximumTilesetUpdatesPerFrame <=
+      0) {
+    return true;
+  }
+
+  const WorldState& state = getCurrentState(pWorld);
+
+  // A tileset that wasn't considered in this frame's schedule (e.g. it was
+  // just created) is updated right away.
+  const TObjectKey<ACesium3DTileset> key(pTileset);
+  return !state.framesSinceUpdate.Contains(key) ||
+         state.scheduled.Contains(key);
+}
+
+/*static*/ void CesiumTilesetUpdateScheduler::report(
+    const UWorld* pWorld,
+    const ACesium3DTileset* pTileset,
+    const Report& report) {
+  if (GetDefault<UCesiumRuntimeSettings>()->MaximumTilesetUpdatesPerFrame <=
+      0) {
+    return;
+  }
+
+  getCurrentState(pWorld).reports.Add(pTileset, report);
+}
+
+/*static*/ CesiumTilesetUpdateScheduler::WorldState&
+CesiumTilesetUpdateScheduler::getCurrentState(const UWorld* pWorld) {
+  const uint64 frameNumber = GFrameCounter;
+  const TObjectKey<UWorld> key(pWorld);
+
+  WorldState* pState = _worlds.Find(key);
+  if (pState && pState->frameNumber == frameNumber) {
+    return *pState;
+  }
+
+  // Forget worlds that haven't been updated recently, such as ended PIE
+  // sessions.
+  for (auto it = _worlds.CreateIterator(); it; ++it) {
+    if (it.Value().frameNumber + 1 < frameNumber) {
+      it.RemoveCurrent();
+    }
+  }
+
+  WorldState& state = _worlds.FindOrAdd(key);
+  if (state.frameNumber + 1 == frameNumber) {
+    computeSchedule(state);
+  } else {
+    state.framesSinceUpdate.Empty();
+    state.scheduled.Empty();
+  }
+  state.reports.Empty();
+  state.frameNumber = frameNumber;
+  return state;
+}
+
+/*static*/ void
+CesiumTilesetUpdateScheduler::computeSchedule(WorldState& state) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeTilesetUpdateSchedule)
+
+  const int32 maximumUpdates =
+      GetDefault<UCesiumRuntimeSettings>()->MaximumTilesetUpdatesPerFrame;
+
+  // Only the tilesets that reported in the last frame are scheduled. Any
+  // others have been destroyed, or don't currently need updates.
+  std::vector<std::pair<double, TObjectKey<ACesium3DTileset>>> priorities;
+  priorities.reserve(state.reports.Num());
+  for (const auto& pair : state.reports) {
+    const int32* pFrames = state.framesSinceUpdate.Find(pair.Key);
+    priorities.emplace_back(
+        computePriority(pair.Value, pFrames ? *pFrames : 0),
+        pair.Key);
+  }
+
+  const size_t updateCount =
+      std::min(priorities.size(), size_t(std::max(maximumUpdates, 0)));
+  std::partial_sort(
+      priorities.begin(),
+      priorities.begin() + updateCount,
+      priorities.end(),
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  TMap<TObjectKey<ACesium3DTileset>, int32> framesSinceUpdate;
+  framesSinceUpdate.Reserve(int32(priorities.size()));
+  state.scheduled.Empty(int32(updateCount));
+  for (size_t i = 0; i < priorities.size(); ++i) {
+    const TObjectKey<ACesium3DTileset>& key = priorities[i].second;
+    if (i < updateCount) {
+      state.scheduled.Add(key);
+      framesSinceUpdate.Add(key, 0);
+    } else {
+      const int32* pFrames = state.framesSinceUpdate.Find(key);
+      framesSinceUpdate.Add(key, (pFrames ? *pFrames : 0) + 1);
+    }
+  }
+  state.framesSinceUpdate = MoveTemp(framesSinceUpdate);
+}
@@ -0,0 +1,68 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "UObject/ObjectKey.h"
+#include <cstdint>
+
+class ACesium3DTileset;
+class UWorld;
+
+/**
+ * Limits how many of the tilesets in a world update their tile selection each
+ * frame, so that the cost of a level with many tilesets is bounded rather than
+ * growing with the number of tilesets.
+ *
+ * Each frame, every tileset reports how urgently it needs to be updated, and
+ * the tilesets that update in the next frame are chosen from those reports.
+ * A tileset's priority grows with every frame that it waits, and grows faster
+ * when it is loading tiles or is close to a camera, so tilesets take turns
+ * and none of them waits forever.
+ */
+class CesiumTilesetUpdateScheduler {
+public:
+  struct Report {
+    /**
+     * The distance, in meters, from the nearest view to the tileset's root
+     * bounding volume, or 0 if a view is inside it.
+     */
+    double distance;
+
+    /**
+     * Whether the tileset was still loading tiles after its last update.
+     */
+    bool isLoading;
+  };
+
+  /**
+   * Determines whether a tileset should update its tile selection this
+   * frame. When `MaximumTilesetUpdatesPerFrame` in `UCesiumRuntimeSettings`
+   * is 0, this always returns true.
+   */
+  static bool
+  shouldUpdate(const UWorld* pWorld, const ACesium3DTileset* pTileset);
+
+  /**
+   * Reports how urgently a tileset needs to be updated. This should be called
+   * every frame, whether or not the tileset was updated.
+   */
+  static void report(
+      const UWorld* pWorld,
+      const ACesium3DTileset* pTileset,
+      const Report& report);
+
+private:
+  struct WorldState {
+    uint64 frameNumber = 0;
+    TMap<TObjectKey<ACesium3DTileset>, Report> reports;
+    TMap<TObjectKey<ACesium3DTileset>, int32> framesSinceUpdate;
+    TSet<TObjectKey<ACesium3DTileset>> scheduled;
+  };
+
+  static WorldState& getCurrentState(const UWorld* pWorld);
+  static void computeSchedule(WorldState& state);
+
+  static TMap<TObjectKey<UWorld>, WorldState> _worlds;
+};
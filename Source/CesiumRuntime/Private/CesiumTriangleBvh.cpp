@@ -0,0 +1,244 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTriangleBvh.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int32 MaximumLeafTriangles = 4;
+
+struct BuildJob {
+  int32 begin;
+  int32 end;
+  // The node whose second child this is, or INDEX_NONE.
+  int32 parent;
+};
+
+bool intersectBox(
+    const FBox& box,
+    const FVector& origin,
+    const FVector& inverseDirection,
+    double maximumDistance) {
+  double tMin = 0.0;
+  double tMax = maximumDistance;
+  for (int32 axis = 0; axis < 3; ++axis) {
+    double t0 = (box.Min[axis] - origin[axis]) * inverseDirection[axis];
+    double t1 = (box.Max[axis] - origin[axis]) * inverseDirection[axis];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    // Written so that NaNs, from rays parallel to a face, don't reject the
+    // box.
+    tMin = t0 > tMin ? t0 : tMin;
+    tMax = t1 < tMax ? t1 : tMax;
+    if (tMin > tMax) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Moller-Trumbore, accepting hits from either side.
+bool intersectTriangle(
+    const FVector& origin,
+    const FVector& direction,
+    const FVector& v0,
+    const FVector& v1,
+    const FVector& v2,
+    double& outDistance) {
+  const FVector edge1 = v1 - v0;
+  const FVector edge2 = v2 - v0;
+  const FVector p = FVector::CrossProduct(direction, edge2);
+  const double determinant = FVector::DotProduct(edge1, p);
+  if (FMath::Abs(determinant) < 1e-20) {
+    return false;
+  }
+
+  const double inverseDeterminant = 1.0 / determinant;
+  const FVector s = origin - v0;
+  const double u = FVector::DotProduct(s, p) * inverseDeterminant;
+  if (u < 0.0 || u > 1.0) {
+    return false;
+  }
+
+  const FVector q = FVector::CrossProduct(s, edge1);
+  const double v = FVector::DotProduct(direction, q) * inverseDeterminant;
+  if (v < 0.0 || u + v > 1.0) {
+    return false;
+  }
+
+  const double t = FVector::DotProduct(edge2, q) * inverseDeterminant;
+  if (t < 0.0) {
+    return false;
+  }
+
+  outDistance = t;
+  return true;
+}
+
+} // namespace
+
+CesiumTriangleBvh::CesiumTriangleBvh(
+    TArray<FVector>&& vertices,
+    const TArray<int32>& indices)
+    : _vertices(MoveTemp(vertices)) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildTriangleBvh)
+
+  const int32 vertexCount = this->_vertices.Num();
+  TArray<int32> triangles;
+  TArray<FVector> centroids;
+  triangles.Reserve(indices.Num() / 3);
+  centroids.Reserve(indices.Num() / 3);
+  for (int32 i = 0; i + 2 < indices.Num(); i += 3) {
+    const int32 i0 = indices[i];
+    const int32 i1 = indices[i + 1];
+    const int32 i2 = indices[i + 2];
+    if (i0 < 0 || i0 >= vertexCount || i1 < 0 || i1 >= vertexCount ||
+        i2 < 0 || i2 >= vertexCount) {
+      continue;
+    }
+    triangles.Add(i);
+    centroids.Add(
+        (this->_vertices[i0] + this->_vertices[i1] + this->_vertices[i2]) /
+        3.0);
+  }
+
+  if (triangles.IsEmpty()) {
+    return;
+  }
+
+  // The order of the triangles, by their index in centroids.
+  TArray<int32> order;
+  order.SetNumUninitialized(triangles.Num());
+  for (int32 i = 0; i < order.Num(); ++i) {
+    order[i] = i;
+  }
+
+  this->_nodes.Reserve(2 * triangles.Num() / MaximumLeafTriangles + 1);
+
+  // Nodes are added depth first, so that each node's first child follows it.
+  TArray<BuildJob> jobs;
+  jobs.Add(BuildJob{0, order.Num(), INDEX_NONE});
+  while (!jobs.IsEmpty()) {
+    const BuildJob job = jobs.Pop(false);
+    const int32 nodeIndex = this->_nodes.Num();
+    if (job.parent != INDEX_NONE) {
+      this->_nodes[job.parent].firstOrSecondChild = nodeIndex;
+    }
+
+    FBox bounds(ForceInit);
+    FBox centroidBounds(ForceInit);
+    for (int32 i = job.begin; i < job.end; ++i) {
+      const int32 first = triangles[order[i]];
+      bounds += this->_vertices[indices[first]];
+      bounds += this->_vertices[indices[first + 1]];
+      bounds += this->_vertices[indices[first + 2]];
+      centroidBounds += centroids[order[i]];
+    }
+
+    const int32 count = job.end - job.begin;
+    const FVector extent = centroidBounds.GetSize();
+    const int32 axis = extent.X >= extent.Y && extent.X >= extent.Z ? 0
+                       : extent.Y >= extent.Z                       ? 1
+                                                                    : 2;
+    if (count <= MaximumLeafTriangles || extent[axis] <= 0.0) {
+      this->_nodes.Add(Node{bounds, this->_triangles.Num(), count});
+      for (int32 i = job.begin; i < job.end; ++i) {
+        const int32 first = triangles[order[i]];
+        this->_triangles.Add(indices[first]);
+        this->_triangles.Add(indices[first + 1]);
+        this->_triangles.Add(indices[first + 2]);
+      }
+      continue;
+    }
+
+    // Split at the median centroid along the longest axis.
+    const int32 middle = job.begin + count / 2;
+    std::nth_element(
+        order.GetData() + job.begin,
+        order.GetData() + middle,
+        order.GetData() + job.end,
+        [&centroids, axis](int32 a, int32 b) {
+          return centroids[a][axis] < centroids[b][axis];
+        });
+
+    this->_nodes.Add(Node{bounds, INDEX_NONE, 0});
+    jobs.Add(BuildJob{middle, job.end, nodeIndex});
+    jobs.Add(BuildJob{job.begin, middle, INDEX_NONE});
+  }
+}
+
+FBox CesiumTriangleBvh::getBounds() const {
+  return this->_nodes.IsEmpty() ? FBox(ForceInit) : this->_nodes[0].bounds;
+}
+
+bool CesiumTriangleBvh::intersectRay(
+    const FVector& origin,
+    const FVector& direction,
+    double maximumDistance,
+    double& outDistance,
+    int32* pOutTriangle) const {
+  if (this->_nodes.IsEmpty()) {
+    return false;
+  }
+
+  const FVector inverseDirection(
+      1.0 / direction.X,
+      1.0 / direction.Y,
+      1.0 / direction.Z);
+
+  double closest = maximumDistance;
+  int32 closestTriangle = INDEX_NONE;
+
+  TArray<int32, TInlineAllocator<64>> stack;
+  stack.Add(0);
+  while (!stack.IsEmpty()) {
+    const Node& node = this->_nodes[stack.Pop(false)];
+    if (!intersectBox(node.bounds, origin, inverseDirection, closest)) {
+      continue;
+    }
+
+    if (node.triangleCount == 0) {
+      const int32 nodeIndex = int32(&node - this->_nodes.GetData());
+      stack.Add(node.firstOrSecondChild);
+      stack.Add(nodeIndex + 1);
+      continue;
+    }
+
+    const int32 end = node.firstOrSecondChild + 3 * node.triangleCount;
+    for (int32 i = node.firstOrSecondChild; i < end; i += 3) {
+      double distance;
+      if (intersectTriangle(
+              origin,
+              direction,
+              this->_vertices[this->_triangles[i]],
+              this->_vertices[this->_triangles[i + 1]],
+              this->_vertices[this->_triangles[i + 2]],
+              distance) &&
+          distance <= closest) {
+        closest = distance;
+        closestTriangle = i / 3;
+      }
+    }
+  }
+
+  if (closestTriangle == INDEX_NONE) {
+    return false;
+  }
+
+  outDistance = closest;
+  if (pOutTriangle) {
+    *pOutTriangle = closestTriangle;
+  }
+  return true;
+}
+
+void CesiumTriangleBvh::getTriangle(
+    int32 triangle,
+    FVector& v0,
+    FVector& v1,
+    FVector& v2) const {
+  v0 = this->_vertices[this->_triangles[3 * triangle]];
+  v1 = this->_vertices[this->_triangles[3 * triangle + 1]];
+  v2 = this->_vertices[this->_triangles[3 * triangle + 2]];
+}
@@ -0,0 +1,81 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "Math/Vector.h"
+
+/**
+ * A bounding volume hierarchy over the triangles of a primitive, relative to
+ * the primitive's component, for finding where rays hit the primitive without
+ * a physics mesh.
+ *
+ * It is built while the primitive is loaded, off the game thread, and is never
+ * modified once built, so it may be queried from any thread.
+ */
+class CesiumTriangleBvh {
+public:
+  /**
+   * Builds the hierarchy.
+   *
+   * @param vertices The positions of the vertices.
+   * @param indices The indices of the vertices of each triangle. Triangles
+   * with an index outside of the vertices are ignored.
+   */
+  CesiumTriangleBvh(TArray<FVector>&& vertices, const TArray<int32>& indices);
+
+  /**
+   * Whether there are no triangles to hit.
+   */
+  bool isEmpty() const { return this->_nodes.IsEmpty(); }
+
+  /**
+   * Gets the bounds of all of the triangles.
+   */
+  FBox getBounds() const;
+
+  /**
+   * Finds the closest point where a ray hits a triangle, from either side.
+   *
+   * @param origin The origin of the ray.
+   * @param direction The direction of the ray, which doesn't need to be
+   * normalized.
+   * @param maximumDistance The distance along the ray beyond which hits are
+   * ignored, in multiples of the length of the direction.
+   * @param outDistance The distance to the closest hit, in multiples of the
+   * length of the direction, if there is one.
+   * @param pOutTriangle If not null, the triangle that is hit, which may be
+   * passed to getTriangle.
+   * @return Whether the ray hits a triangle.
+   */
+  bool intersectRay(
+      const FVector& origin,
+      const FVector& direction,
+      double maximumDistance,
+      double& outDistance,
+      int32* pOutTriangle = nullptr) const;
+
+  /**
+   * Gets the vertices of a triangle found by intersectRay, in the same
+   * winding order as the primitive.
+   */
+  void
+  getTriangle(int32 triangle, FVector& v0, FVector& v1, FVector& v2) const;
+
+private:
+  struct Node {
+    FBox bounds;
+    // For leaves, the first triangle in _triangles. For interior nodes, the
+    // index of the second child. The first child always follows its parent.
+    int32 firstOrSecondChild;
+    // The number of triangles of a leaf, or 0 for interior nodes.
+    int32 triangleCount;
+  };
+
+  TArray<FVector> _vertices;
+  // The indices of the vertices of each triangle, ordered so that the
+  // triangles of each leaf are together.
+  TArray<int32> _triangles;
+  TArray<Node> _nodes;
+};
@@ -0,0 +1,32 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumVectorRasterOverlay.h"
+#include "CesiumVectorRasterizer.h"
+#include "Misc/Paths.h"
+
+namespace {
+glm::u8vec4 toRgba8(const FLinearColor& color) {
+  const FColor srgb = color.ToFColor(true);
+  return glm::u8vec4(srgb.R, srgb.G, srgb.B, srgb.A);
+}
+} // namespace
+
+std::unique_ptr<CesiumRasterOverlays::RasterOverlay>
+UCesiumVectorRasterOverlay::CreateOverlay(
+    const CesiumRasterOverlays::RasterOverlayOptions& options) {
+  const FString filename =
+      FPaths::IsRelative(this->GeoJsonFile.FilePath)
+          ? FPaths::Combine(FPaths::ProjectDir(), this->GeoJsonFile.FilePath)
+          : this->GeoJsonFile.FilePath;
+
+  CesiumVectorStyle style;
+  style.lineColor = toRgba8(this->LineColor);
+  style.lineWidth = double(this->LineWidth);
+  style.fillColor = toRgba8(this->FillColor);
+
+  return std::make_unique<CesiumVectorRasterizerOverlay>(
+      TCHAR_TO_UTF8(*this->MaterialLayerKey),
+      TCHAR_TO_UTF8(*FPaths::ConvertRelativePathToFull(filename)),
+      style,
+      options);
+}
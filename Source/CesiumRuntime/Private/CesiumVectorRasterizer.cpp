@@ -0,0 +1,708 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumVectorRasterizer.h"
+#include "CesiumRasterizerUtility.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+#include "CesiumGeospatial/Projection.h"
+#include "CesiumJsonReader/JsonObjectJsonHandler.h"
+#include "CesiumJsonReader/JsonReader.h"
+#include "CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h"
+#include "CesiumRasterOverlays/RasterOverlayTile.h"
+#include "CesiumRasterOverlays/RasterOverlayTileProvider.h"
+#include "CesiumUtility/JsonValue.h"
+#include "CesiumUtility/Math.h"
+#include "Misc/FileHelper.h"
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+
+// The most cells along each side of the grid over all of the segments.
+constexpr int32_t MaximumSegmentGridSize = 2048;
+
+Rectangle getSegmentBounds(const glm::dvec2& a, const glm::dvec2& b) {
+  return Rectangle(
+      std::min(a.x, b.x),
+      std::min(a.y, b.y),
+      std::max(a.x, b.x),
+      std::max(a.y, b.y));
+}
+
+void expandToInclude(
+    std::optional<Rectangle>& bounds,
+    const Rectangle& other) {
+  if (!bounds) {
+    bounds = other;
+    return;
+  }
+  bounds->minimumX = std::min(bounds->minimumX, other.minimumX);
+  bounds->minimumY = std::min(bounds->minimumY, other.minimumY);
+  bounds->maximumX = std::max(bounds->maximumX, other.maximumX);
+  bounds->maximumY = std::max(bounds->maximumY, other.maximumY);
+}
+
+// Reads a GeoJSON position, in degrees, as longitude and latitude in
+// radians.
+bool readPosition(const JsonValue& value, glm::dvec2& position) {
+  if (!value.isArray() || value.getArray().size() < 2) {
+    return false;
+  }
+  const JsonValue::Array& coordinates = value.getArray();
+  position = glm::dvec2(
+      Math::degreesToRadians(coordinates[0].getSafeNumberOrDefault(0.0)),
+      Math::degreesToRadians(coordinates[1].getSafeNumberOrDefault(0.0)));
+  return true;
+}
+
+std::vector<glm::dvec2> readPositions(const JsonValue& value) {
+  std::vector<glm::dvec2> positions;
+  if (!value.isArray()) {
+    return positions;
+  }
+  positions.reserve(value.getArray().size());
+  for (const JsonValue& item : value.getArray()) {
+    glm::dvec2 position;
+    if (readPosition(item, position)) {
+      positions.push_back(position);
+    }
+  }
+  return positions;
+}
+
+// Concatenates the rings of a polygon, closing each one, so that the
+// even-odd rule leaves out the holes. The edges that connect one ring to the
+// next are traversed once in each direction, so they cancel out.
+void readPolygon(const JsonValue& value, CesiumVectorFeatures& features) {
+  if (!value.isArray()) {
+    return;
+  }
+
+  std::vector<glm::dvec2> vertices;
+  for (const JsonValue& ringValue : value.getArray()) {
+    std::vector<glm::dvec2> ring = readPositions(ringValue);
+    if (ring.size() < 3) {
+      continue;
+    }
+    if (ring.front() != ring.back()) {
+      ring.push_back(ring.front());
+    }
+    vertices.insert(vertices.end(), ring.begin(), ring.end());
+  }
+
+  if (vertices.size() >= 3) {
+    features.polygons.emplace_back(std::move(vertices));
+  }
+}
+
+void readGeometry(const JsonValue& geometry, CesiumVectorFeatures& features) {
+  const std::string* pType =
+      geometry.getValuePtrForKey<JsonValue::String>("type");
+  if (!pType) {
+    return;
+  }
+
+  if (*pType == "GeometryCollection") {
+    const JsonValue::Array* pGeometries =
+        geometry.getValuePtrForKey<JsonValue::Array>("geometries");
+    if (pGeometries) {
+      for (const JsonValue& child : *pGeometries) {
+        readGeometry(child, features);
+      }
+    }
+    return;
+  }
+
+  const JsonValue* pCoordinates = geometry.getValuePtrForKey("coordinates");
+  if (!pCoordinates || !pCoordinates->isArray()) {
+    return;
+  }
+
+  if (*pType == "LineString") {
+    std::vector<glm::dvec2> line = readPositions(*pCoordinates);
+    if (line.size() >= 2) {
+      features.lines.emplace_back(std::move(line));
+    }
+  } else if (*pType == "MultiLineString") {
+    for (const JsonValue& lineValue : pCoordinates->getArray()) {
+      std::vector<glm::dvec2> line = readPositions(lineValue);
+      if (line.size() >= 2) {
+        features.lines.emplace_back(std::move(line));
+      }
+    }
+  } else if (*pType == "Polygon") {
+    readPolygon(*pCoordinates, features);
+  } else if (*pType == "MultiPolygon") {
+    for (const JsonValue& polygonValue : pCoordinates->getArray()) {
+      readPolygon(polygonValue, features);
+    }
+  }
+}
+
+void readGeoJson(const JsonValue& root, CesiumVectorFeatures& features) {
+  const std::string* pType = root.getValuePtrForKey<JsonValue::String>("type");
+  if (!pType) {
+    return;
+  }
+
+  if (*pType == "FeatureCollection") {
+    const JsonValue::Array* pFeatures =
+        root.getValuePtrForKey<JsonValue::Array>("features");
+    if (pFeatures) {
+      for (const JsonValue& feature : *pFeatures) {
+        readGeoJson(feature, features);
+      }
+    }
+  } else if (*pType == "Feature") {
+    const JsonValue* pGeometry = root.getValuePtrForKey("geometry");
+    if (pGeometry && pGeometry->isObject()) {
+      readGeometry(*pGeometry, features);
+    }
+  } else {
+    readGeometry(root, features);
+  }
+}
+
+// The distance from a point to the segment from a to b.
+double distanceToSegment(
+    const glm::dvec2& point,
+    const glm::dvec2& a,
+    const glm::dvec2& b) {
+  const glm::dvec2 direction = b - a;
+  const double lengthSquared = glm::dot(direction, direction);
+  const double t =
+      lengthSquared > 0.0
+          ? std::clamp(glm::dot(point - a, direction) / lengthSquared, 0.0, 1.0)
+          : 0.0;
+  return glm::distance(point, a + t * direction);
+}
+
+// Blends a color over a pixel, both with straight alpha.
+void blendOver(uint8_t* pPixel, const glm::u8vec4& color, double coverage) {
+  const double sourceAlpha = coverage * color.a / 255.0;
+  const double destinationAlpha = pPixel[3] / 255.0;
+  const double alpha = sourceAlpha + destinationAlpha * (1.0 - sourceAlpha);
+  if (alpha <= 0.0) {
+    return;
+  }
+  for (int32_t c = 0; c < 3; ++c) {
+    const double blended =
+        (color[c] * sourceAlpha +
+         pPixel[c] * destinationAlpha * (1.0 - sourceAlpha)) /
+        alpha;
+    pPixel[c] = uint8_t(std::clamp(std::round(blended), 0.0, 255.0));
+  }
+  pPixel[3] = uint8_t(std::clamp(std::round(alpha * 255.0), 0.0, 255.0));
+}
+
+class VectorTileProvider : public RasterOverlayTileProvider {
+public:
+  VectorTileProvider(
+      const IntrusivePointer<const RasterOverlay>& pOwner,
+      const AsyncSystem& asyncSystem,
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const Rectangle& coverageRectangle,
+      const std::shared_ptr<const CesiumVectorRasterizer>& pRasterizer)
+      : RasterOverlayTileProvider(
+            pOwner,
+            asyncSystem,
+            pAssetAccessor,
+            std::nullopt,
+            pPrepareRendererResources,
+            pLogger,
+            GeographicProjection(),
+            coverageRectangle),
+        _pRasterizer(pRasterizer) {}
+
+protected:
+  virtual Future<LoadedRasterOverlayImage>
+  loadTileImage(RasterOverlayTile& overlayTile) override {
+    // Choose the texture size according to the geometry screen size and
+    // raster SSE, but no larger than the maximum texture size.
+    const RasterOverlayOptions& options = this->getOwner().getOptions();
+    const glm::dvec2 textureSize = glm::min(
+        overlayTile.getTargetScreenPixels() / options.maximumScreenSpaceError,
+        glm::dvec2(options.maximumTextureSize));
+
+    return this->getAsyncSystem().runInWorkerThread(
+        [pRasterizer = this->_pRasterizer,
+         projection = this->getProjection(),
+         rectangle = overlayTile.getRectangle(),
+         textureSize]() {
+          const GlobeRectangle globeRectangle =
+              unprojectRectangleSimple(projection, rectangle);
+          const Rectangle tileRectangle(
+              globeRectangle.getWest(),
+              globeRectangle.getSouth(),
+              globeRectangle.getEast(),
+              globeRectangle.getNorth());
+
+          const int32_t width =
+              std::max(int32_t(glm::round(textureSize.x)), 1);
+          const int32_t height =
+              std::max(int32_t(glm::round(textureSize.y)), 1);
+
+          LoadedRasterOverlayImage result;
+          result.rectangle = rectangle;
+
+          ImageCesium& image = result.image.emplace();
+          image.channels = 4;
+          image.bytesPerChannel = 1;
+
+          // A tile that no feature reaches is entirely transparent, which a
+          // single pixel shows just as well.
+          if (!pRasterizer->overlaps(tileRectangle, width, height)) {
+            image.width = 1;
+            image.height = 1;
+            image.pixelData.resize(4, std::byte(0));
+            result.moreDetailAvailable = false;
+            return result;
+          }
+
+          image.width = width;
+          image.height = height;
+          image.pixelData.resize(size_t(width) * size_t(height) * 4);
+          pRasterizer->rasterize(
+              tileRectangle,
+              width,
+              height,
+              reinterpret_cast<uint8_t*>(image.pixelData.data()));
+          result.moreDetailAvailable = true;
+          return result;
+        });
+  }
+
+private:
+  std::shared_ptr<const CesiumVectorRasterizer> _pRasterizer;
+};
+
+} // namespace
+
+/*static*/ std::optional<CesiumVectorFeatures>
+CesiumVectorFeatures::parseGeoJson(
+    const std::vector<std::byte>& data,
+    std::string& error) {
+  CesiumJsonReader::JsonObjectJsonHandler handler;
+  CesiumJsonReader::ReadJsonResult<JsonValue> json =
+      CesiumJsonReader::JsonReader::readJson(data, handler);
+  if (!json.value) {
+    error = json.errors.empty() ? "The GeoJSON is not valid JSON."
+                                : json.errors.front();
+    return std::nullopt;
+  }
+  if (!json.value->isObject()) {
+    error = "The GeoJSON is not a JSON object.";
+    return std::nullopt;
+  }
+
+  CesiumVectorFeatures features;
+  readGeoJson(*json.value, features);
+  return features;
+}
+
+CesiumVectorRasterizer::CesiumVectorRasterizer(
+    const CesiumVectorFeatures& features,
+    const CesiumVectorStyle& style)
+    : _style(style),
+      _vertices(),
+      _segments(),
+      _segmentBounds(),
+      _columns(0),
+      _rows(0),
+      _cellStarts(),
+      _cellSegments(),
+      _polygons(),
+      _polygonBounds() {
+  size_t vertexCount = 0;
+  for (const std::vector<glm::dvec2>& line : features.lines) {
+    vertexCount += line.size();
+  }
+  this->_vertices.reserve(vertexCount);
+  this->_segments.reserve(vertexCount);
+
+  for (const std::vector<glm::dvec2>& line : features.lines) {
+    if (line.size() < 2) {
+      continue;
+    }
+    const uint32_t first = uint32_t(this->_vertices.size());
+    this->_vertices.insert(this->_vertices.end(), line.begin(), line.end());
+    for (uint32_t i = 0; i + 1 < uint32_t(line.size()); ++i) {
+      this->_segments.push_back(first + i);
+      expandToInclude(
+          this->_segmentBounds,
+          getSegmentBounds(line[i], line[i + 1]));
+    }
+  }
+
+  if (!features.polygons.empty()) {
+    this->_polygons.emplace(features.polygons);
+    for (const std::vector<glm::dvec2>& polygon : features.polygons) {
+      for (const glm::dvec2& vertex : polygon) {
+        expandToInclude(
+            this->_polygonBounds,
+            Rectangle(vertex.x, vertex.y, vertex.x, vertex.y));
+      }
+    }
+  }
+
+  if (this->_segments.empty()) {
+    return;
+  }
+
+  // Aim for a few segments per cell.
+  const int32_t gridSize = std::clamp(
+      int32_t(std::sqrt(double(this->_segments.size()) / 4.0)),
+      1,
+      MaximumSegmentGridSize);
+  this->_columns = gridSize;
+  this->_rows = gridSize;
+
+  const Rectangle& bounds = *this->_segmentBounds;
+  const double cellWidth =
+      std::max(bounds.computeWidth() / this->_columns, 1e-12);
+  const double cellHeight =
+      std::max(bounds.computeHeight() / this->_rows, 1e-12);
+  const auto forEachCell = [&](uint32_t segment, auto&& callback) {
+    const uint32_t vertex = this->_segments[segment];
+    const Rectangle segmentBounds = getSegmentBounds(
+        this->_vertices[vertex],
+        this->_vertices[vertex + 1]);
+    const int32_t west = CesiumRasterizerUtility::findCell(
+        segmentBounds.minimumX,
+        bounds.minimumX,
+        cellWidth,
+        this->_columns);
+    const int32_t east = CesiumRasterizerUtility::findCell(
+        segmentBounds.maximumX,
+        bounds.minimumX,
+        cellWidth,
+        this->_columns);
+    const int32_t south = CesiumRasterizerUtility::findCell(
+        segmentBounds.minimumY,
+        bounds.minimumY,
+        cellHeight,
+        this->_rows);
+    const int32_t north = CesiumRasterizerUtility::findCell(
+        segmentBounds.maximumY,
+        bounds.minimumY,
+        cellHeight,
+        this->_rows);
+    for (int32_t row = south; row <= north; ++row) {
+      for (int32_t column = west; column <= east; ++column) {
+        callback(size_t(row * this->_columns + column));
+      }
+    }
+  };
+
+  // The segments are counted first, so that each cell's segments can be
+  // stored in one array without allocating per cell.
+  const size_t cellCount = size_t(this->_columns) * size_t(this->_rows);
+  std::vector<uint32_t> counts(cellCount, 0);
+  for (uint32_t i = 0; i < uint32_t(this->_segments.size()); ++i) {
+    forEachCell(i, [&counts](size_t cell) { ++counts[cell]; });
+  }
+
+  this->_cellStarts.resize(cellCount + 1);
+  this->_cellStarts[0] = 0;
+  for (size_t cell = 0; cell < cellCount; ++cell) {
+    this->_cellStarts[cell + 1] = this->_cellStarts[cell] + counts[cell];
+  }
+
+  this->_cellSegments.resize(this->_cellStarts[cellCount]);
+  std::copy(
+      this->_cellStarts.begin(),
+      this->_cellStarts.end() - 1,
+      counts.begin());
+  for (uint32_t i = 0; i < uint32_t(this->_segments.size()); ++i) {
+    forEachCell(i, [this, &counts, i](size_t cell) {
+      this->_cellSegments[counts[cell]++] = i;
+    });
+  }
+}
+
+std::optional<Rectangle> CesiumVectorRasterizer::getBounds() const {
+  std::optional<Rectangle> bounds = this->_segmentBounds;
+  if (this->_polygonBounds) {
+    expandToInclude(bounds, *this->_polygonBounds);
+  }
+  return bounds;
+}
+
+std::vector<uint32_t>
+CesiumVectorRasterizer::findSegments(const Rectangle& rectangle) const {
+  std::vector<uint32_t> result;
+  if (!this->_segmentBounds ||
+      !CesiumRasterizerUtility::overlaps(rectangle, *this->_segmentBounds)) {
+    return result;
+  }
+
+  const Rectangle& bounds = *this->_segmentBounds;
+  const double cellWidth =
+      std::max(bounds.computeWidth() / this->_columns, 1e-12);
+  const double cellHeight =
+      std::max(bounds.computeHeight() / this->_rows, 1e-12);
+  const int32_t west = CesiumRasterizerUtility::findCell(
+      rectangle.minimumX,
+      bounds.minimumX,
+      cellWidth,
+      this->_columns);
+  const int32_t east = CesiumRasterizerUtility::findCell(
+      rectangle.maximumX,
+      bounds.minimumX,
+      cellWidth,
+      this->_columns);
+  const int32_t south = CesiumRasterizerUtility::findCell(
+      rectangle.minimumY,
+      bounds.minimumY,
+      cellHeight,
+      this->_rows);
+  const int32_t north = CesiumRasterizerUtility::findCell(
+      rectangle.maximumY,
+      bounds.minimumY,
+      cellHeight,
+      this->_rows);
+
+  for (int32_t row = south; row <= north; ++row) {
+    for (int32_t column = west; column <= east; ++column) {
+      const size_t cell = size_t(row * this->_columns + column);
+      for (uint32_t i = this->_cellStarts[cell];
+           i < this->_cellStarts[cell + 1];
+           ++i) {
+        const uint32_t segment = this->_cellSegments[i];
+        const uint32_t vertex = this->_segments[segment];
+        if (CesiumRasterizerUtility::overlaps(
+                rectangle,
+                getSegmentBounds(
+                    this->_vertices[vertex],
+                    this->_vertices[vertex + 1]))) {
+          result.push_back(segment);
+        }
+      }
+    }
+  }
+
+  // Segments that cover more than one cell are found once in each.
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+bool CesiumVectorRasterizer::overlaps(
+    const Rectangle& rectangle,
+    int32_t width,
+    int32_t height) const {
+  if (this->_polygons && !this->_polygons->findPolygons(rectangle).empty()) {
+    return true;
+  }
+  return !this->findSegments(this->expandByLineWidth(rectangle, width, height))
+              .empty();
+}
+
+bool CesiumVectorRasterizer::rasterize(
+    const Rectangle& rectangle,
+    int32_t width,
+    int32_t height,
+    uint8_t* pPixels) const {
+  if (width <= 0 || height <= 0) {
+    return false;
+  }
+
+  const size_t pixelCount = size_t(width) * size_t(height);
+  std::memset(pPixels, 0, pixelCount * 4);
+
+  bool drawn = false;
+
+  if (this->_polygons && this->_style.fillColor.a > 0) {
+    std::vector<uint8_t> mask(pixelCount);
+    if (this->_polygons
+            ->rasterize(rectangle, width, height, 1, 0, mask.data())) {
+      for (size_t i = 0; i < pixelCount; ++i) {
+        if (mask[i]) {
+          std::memcpy(pPixels + i * 4, &this->_style.fillColor, 4);
+        }
+      }
+      drawn = true;
+    }
+  }
+
+  const std::vector<uint32_t> segments =
+      this->findSegments(this->expandByLineWidth(rectangle, width, height));
+  if (segments.empty() || this->_style.lineColor.a == 0 ||
+      this->_style.lineWidth <= 0.0) {
+    return drawn;
+  }
+
+  // The coverage of each pixel by the nearest line, so that lines that
+  // overlap, like the segments that meet at each vertex, aren't drawn twice.
+  std::vector<uint8_t> coverage(pixelCount, 0);
+
+  const double pixelWidth = rectangle.computeWidth() / width;
+  const double pixelHeight = rectangle.computeHeight() / height;
+  const double halfWidth = this->_style.lineWidth * 0.5;
+  const auto toPixels = [&rectangle, pixelWidth, pixelHeight](
+                            const glm::dvec2& position) {
+    return glm::dvec2(
+        (position.x - rectangle.minimumX) / pixelWidth,
+        (rectangle.maximumY - position.y) / pixelHeight);
+  };
+
+  for (uint32_t segment : segments) {
+    const uint32_t vertex = this->_segments[segment];
+    const glm::dvec2 a = toPixels(this->_vertices[vertex]);
+    const glm::dvec2 b = toPixels(this->_vertices[vertex + 1]);
+
+    // Only the pixels within half the line width of the segment, plus one
+    // for antialiasing, can be covered by it.
+    const double reach = halfWidth + 1.0;
+    const auto clampPixel = [](double pixel, int32_t count) {
+      return int32_t(std::clamp(pixel, 0.0, double(count)));
+    };
+    const int32_t firstColumn =
+        clampPixel(std::floor(std::min(a.x, b.x) - reach), width);
+    const int32_t lastColumn =
+        clampPixel(std::ceil(std::max(a.x, b.x) + reach), width);
+    const int32_t firstRow =
+        clampPixel(std::floor(std::min(a.y, b.y) - reach), height);
+    const int32_t lastRow =
+        clampPixel(std::ceil(std::max(a.y, b.y) + reach), height);
+
+    for (int32_t row = firstRow; row < lastRow; ++row) {
+      uint8_t* pRow = coverage.data() + size_t(row) * size_t(width);
+      for (int32_t column = firstColumn; column < lastColumn; ++column) {
+        const double distance = distanceToSegment(
+            glm::dvec2(double(column) + 0.5, double(row) + 0.5),
+            a,
+            b);
+        const double pixelCoverage =
+            std::clamp(halfWidth + 0.5 - distance, 0.0, 1.0);
+        pRow[column] = std::max(
+            pRow[column],
+            uint8_t(std::round(pixelCoverage * 255.0)));
+      }
+    }
+  }
+
+  for (size_t i = 0; i < pixelCount; ++i) {
+    if (coverage[i]) {
+      blendOver(pPixels + i * 4, this->_style.lineColor, coverage[i] / 255.0);
+      drawn = true;
+    }
+  }
+
+  return drawn;
+}
+
+Rectangle CesiumVectorRasterizer::expandByLineWidth(
+    const Rectangle& rectangle,
+    int32_t width,
+    int32_t height) const {
+  // Lines whose segments are just outside of the rectangle still reach into
+  // it by half their width.
+  const double reach = this->_style.lineWidth * 0.5 + 1.0;
+  const double dx = reach * rectangle.computeWidth() / std::max(width, 1);
+  const double dy = reach * rectangle.computeHeight() / std::max(height, 1);
+  return Rectangle(
+      rectangle.minimumX - dx,
+      rectangle.minimumY - dy,
+      rectangle.maximumX + dx,
+      rectangle.maximumY + dy);
+}
+
+CesiumVectorRasterizerOverlay::CesiumVectorRasterizerOverlay(
+    const std::string& name,
+    const std::string& filename,
+    const CesiumVectorStyle& style,
+    const RasterOverlayOptions& overlayOptions)
+    : RasterOverlay(name, overlayOptions),
+      _filename(filename),
+      _style(style) {}
+
+Future<RasterOverlay::CreateTileProviderResult>
+CesiumVectorRasterizerOverlay::createTileProvider(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CreditSystem>& /*pCreditSystem*/,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    IntrusivePointer<const RasterOverlay> pOwner) const {
+  if (!pOwner) {
+    pOwner = IntrusivePointer<const RasterOverlay>(this);
+  }
+
+  // Millions of segments take a while to read and index, so that's done on
+  // a worker thread rather than while the overlay is added.
+  return asyncSystem.runInWorkerThread(
+      [asyncSystem,
+       pAssetAccessor,
+       pPrepareRendererResources,
+       pLogger,
+       pOwner,
+       filename = this->_filename,
+       style = this->_style]() -> CreateTileProviderResult {
+        TArray<uint8> bytes;
+        if (!FFileHelper::LoadFileToArray(
+                bytes,
+                UTF8_TO_TCHAR(filename.c_str()))) {
+          return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+              RasterOverlayLoadType::TileProvider,
+              nullptr,
+              "Could not read the GeoJSON file " + filename + "."});
+        }
+
+        const std::vector<std::byte> data(
+            reinterpret_cast<const std::byte*>(bytes.GetData()),
+            reinterpret_cast<const std::byte*>(bytes.GetData()) + bytes.Num());
+        bytes.Empty();
+
+        std::string error;
+        std::optional<CesiumVectorFeatures> maybeFeatures =
+            CesiumVectorFeatures::parseGeoJson(data, error);
+        if (!maybeFeatures) {
+          return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+              RasterOverlayLoadType::TileProvider,
+              nullptr,
+              "Could not read the GeoJSON file " + filename + ": " + error});
+        }
+
+        auto pRasterizer = std::make_shared<const CesiumVectorRasterizer>(
+            *maybeFeatures,
+            style);
+
+        // The overlay covers the features, so tiles elsewhere don't get
+        // overlay tiles at all.
+        const GeographicProjection projection;
+        const std::optional<Rectangle> maybeBounds = pRasterizer->getBounds();
+        const Rectangle coverage =
+            maybeBounds ? projectRectangleSimple(
+                              projection,
+                              GlobeRectangle(
+                                  maybeBounds->minimumX,
+                                  maybeBounds->minimumY,
+                                  maybeBounds->maximumX,
+                                  maybeBounds->maximumY))
+                        : Rectangle(0.0, 0.0, 0.0, 0.0);
+
+        return IntrusivePointer<RasterOverlayTileProvider>(
+            new VectorTileProvider(
+                pOwner,
+                asyncSystem,
+                pAssetAccessor,
+                pPrepareRendererResources,
+                pLogger,
+                coverage,
+                pRasterizer));
+      });
+}
@@ -0,0 +1,195 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGeometry/Rectangle.h"
+#include "CesiumPolygonRasterizer.h"
+#include "CesiumRasterOverlays/RasterOverlay.h"
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * The lines and polygons of vector data, such as a GeoJSON file, as longitude
+ * and latitude in radians.
+ */
+struct CesiumVectorFeatures {
+  /**
+   * The vertices of each line, which is drawn as a segment between each pair
+   * of consecutive vertices.
+   */
+  std::vector<std::vector<glm::dvec2>> lines;
+
+  /**
+   * The vertices of each polygon. The rings of a polygon with holes are
+   * concatenated, each closed by repeating its first vertex, so that the
+   * holes are left out by the even-odd rule.
+   */
+  std::vector<std::vector<glm::dvec2>> polygons;
+
+  /**
+   * Reads the lines and polygons of a GeoJSON FeatureCollection, Feature, or
+   * geometry. LineString, MultiLineString, Polygon, MultiPolygon, and
+   * GeometryCollection geometries are read, and points are ignored.
+   *
+   * @param data The GeoJSON text.
+   * @param error Set to a description of the problem if the GeoJSON can't be
+   * read.
+   * @return The features, or std::nullopt if the GeoJSON can't be read.
+   */
+  static std::optional<CesiumVectorFeatures>
+  parseGeoJson(const std::vector<std::byte>& data, std::string& error);
+};
+
+/**
+ * How the features of a CesiumVectorRasterizer are drawn.
+ */
+struct CesiumVectorStyle {
+  /** The color of lines, in 8-bit RGBA. */
+  glm::u8vec4 lineColor{255, 255, 0, 255};
+
+  /** The width of lines, in pixels of the overlay's textures. */
+  double lineWidth = 2.0;
+
+  /** The color that polygons are filled with, in 8-bit RGBA. */
+  glm::u8vec4 fillColor{255, 255, 0, 64};
+};
+
+/**
+ * Rasterizes lines and polygons into RGBA images for rectangles of the globe.
+ *
+ * The segments of the lines are indexed when this is constructed, in a grid
+ * over all of them that records which segments overlap each cell in one
+ * contiguous array, so that rasterizing a rectangle only considers the
+ * segments near it. That keeps rasterizing an overlay tile proportional to
+ * the segments in it, even with millions of segments in total. The polygons
+ * are indexed and filled by a CesiumPolygonRasterizer.
+ *
+ * Lines are drawn with antialiased edges, by the distance from each pixel
+ * center to the nearest segment, so their width is the same at every level
+ * of detail.
+ *
+ * Once constructed, this may be used from any number of threads at once.
+ */
+class CesiumVectorRasterizer {
+public:
+  CesiumVectorRasterizer(
+      const CesiumVectorFeatures& features,
+      const CesiumVectorStyle& style);
+
+  /**
+   * Gets the rectangle that encloses every feature, in longitude and
+   * latitude radians, or std::nullopt if there are none.
+   */
+  std::optional<CesiumGeometry::Rectangle> getBounds() const;
+
+  /**
+   * Gets the number of line segments.
+   */
+  size_t getSegmentCount() const { return this->_segments.size(); }
+
+  /**
+   * Finds the line segments whose bounding rectangles overlap a rectangle.
+   *
+   * @param rectangle The rectangle, in longitude and latitude radians.
+   * @return The indices of the segments, in increasing order.
+   */
+  std::vector<uint32_t>
+  findSegments(const CesiumGeometry::Rectangle& rectangle) const;
+
+  /**
+   * Determines whether any feature may be drawn in a rectangle, including
+   * lines that are near enough for their width to reach into it.
+   *
+   * @param rectangle The rectangle, in longitude and latitude radians.
+   * @param width The width of an image of the rectangle in pixels.
+   * @param height The height of an image of the rectangle in pixels.
+   */
+  bool overlaps(
+      const CesiumGeometry::Rectangle& rectangle,
+      int32_t width,
+      int32_t height) const;
+
+  /**
+   * Rasterizes the features over a rectangle into an 8-bit RGBA image. Pixels
+   * inside polygons are filled with the fill color, lines are drawn over
+   * them, and every other pixel is transparent. Rows start at the north edge
+   * of the rectangle.
+   *
+   * @param rectangle The rectangle, in longitude and latitude radians.
+   * @param width The width of the image in pixels.
+   * @param height The height of the image in pixels.
+   * @param pPixels The image, which must have room for width * height * 4
+   * bytes.
+   * @return Whether any feature was drawn. If not, every pixel is
+   * transparent.
+   */
+  bool rasterize(
+      const CesiumGeometry::Rectangle& rectangle,
+      int32_t width,
+      int32_t height,
+      uint8_t* pPixels) const;
+
+private:
+  CesiumGeometry::Rectangle expandByLineWidth(
+      const CesiumGeometry::Rectangle& rectangle,
+      int32_t width,
+      int32_t height) const;
+
+  CesiumVectorStyle _style;
+
+  std::vector<glm::dvec2> _vertices;
+  // The index of the first vertex of each segment, whose second vertex
+  // follows it.
+  std::vector<uint32_t> _segments;
+
+  std::optional<CesiumGeometry::Rectangle> _segmentBounds;
+  int32_t _columns;
+  int32_t _rows;
+  // The segments that overlap each cell of the grid over _segmentBounds, row
+  // by row. The segments of cell i are at [_cellStarts[i], _cellStarts[i + 1])
+  // in _cellSegments.
+  std::vector<uint32_t> _cellStarts;
+  std::vector<uint32_t> _cellSegments;
+
+  std::optional<CesiumPolygonRasterizer> _polygons;
+  std::optional<CesiumGeometry::Rectangle> _polygonBounds;
+};
+
+/**
+ * A cesium-native RasterOverlay whose tiles are rasterized from the features
+ * of a GeoJSON file by a CesiumVectorRasterizer. The file is read and indexed
+ * on a worker thread when the tile provider is created. Tiles that no feature
+ * overlaps are a single transparent pixel.
+ */
+class CesiumVectorRasterizerOverlay
+    : public CesiumRasterOverlays::RasterOverlay {
+public:
+  CesiumVectorRasterizerOverlay(
+      const std::string& name,
+      const std::string& filename,
+      const CesiumVectorStyle& style,
+      const CesiumRasterOverlays::RasterOverlayOptions& overlayOptions = {});
+
+  virtual CesiumAsync::Future<
+      CesiumRasterOverlays::RasterOverlay::CreateTileProviderResult>
+  createTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<
+          CesiumRasterOverlays::IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumUtility::IntrusivePointer<const CesiumRasterOverlays::RasterOverlay>
+          pOwner) const override;
+
+private:
+  std::string _filename;
+  CesiumVectorStyle _style;
+};
@@ -0,0 +1,134 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexKernels.h"
+#include "Algo/Sort.h"
+#include "Containers/Array.h"
+#include "Math/NumericLimits.h"
+#include "Math/UnrealMathUtility.h"
+#include "Math/VectorRegister.h"
+
+namespace CesiumVertexKernels {
+
+bool computeBounds(
+    const StridedElements<FVector3f>& positions,
+    FVector3f& outMinimum,
+    FVector3f& outMaximum) {
+  if (positions.count <= 0) {
+    return false;
+  }
+
+  VectorRegister4Float minimum =
+      VectorSetFloat1(TNumericLimits<float>::Max());
+  VectorRegister4Float maximum =
+      VectorSetFloat1(TNumericLimits<float>::Lowest());
+  for (int64 i = 0; i < positions.count; ++i) {
+    const VectorRegister4Float position = VectorLoadFloat3(&positions[i].X);
+    minimum = VectorMin(minimum, position);
+    maximum = VectorMax(maximum, position);
+  }
+
+  VectorStoreFloat3(minimum, &outMinimum.X);
+  VectorStoreFloat3(maximum, &outMaximum.X);
+  return true;
+}
+
+float copyPositionsFlipY(
+    const StridedElements<FVector3f>& positions,
+    TConstArrayView<uint32> indices,
+    FVector3f* pDestination,
+    const FVector3f& center) {
+  const VectorRegister4Float flipY =
+      MakeVectorRegisterFloat(1.0f, -1.0f, 1.0f, 0.0f);
+  const VectorRegister4Float centerRegister = VectorLoadFloat3(&center.X);
+
+  // The squared distances are compared, so only one square root is needed.
+  VectorRegister4Float maximumDistanceSquared = VectorZeroFloat();
+  const auto copy = [&](const FVector3f& source, FVector3f& destination) {
+    const VectorRegister4Float position =
+        VectorMultiply(VectorLoadFloat3(&source.X), flipY);
+    VectorStoreFloat3(position, &destination.X);
+    const VectorRegister4Float offset =
+        VectorSubtract(position, centerRegister);
+    maximumDistanceSquared =
+        VectorMax(maximumDistanceSquared, VectorDot3(offset, offset));
+  };
+
+  if (indices.IsEmpty()) {
+    for (int64 i = 0; i < positions.count; ++i) {
+      copy(positions[i], pDestination[i]);
+    }
+  } else {
+    for (int32 i = 0; i < indices.Num(); ++i) {
+      copy(positions[indices[i]], pDestination[i]);
+    }
+  }
+
+  return FMath::Sqrt(VectorGetComponent(maximumDistanceSquared, 0));
+}
+
+namespace {
+
+// Spreads the lowest 21 bits of a value out to every third bit.
+uint64 spreadMortonBits(uint64 value) {
+  value &= 0x1fffff;
+  value = (value | value << 32) & 0x1f00000000ffff;
+  value = (value | value << 16) & 0x1f0000ff0000ff;
+  value = (value | value << 8) & 0x100f00f00f00f00f;
+  value = (value | value << 4) & 0x10c30c30c30c30c3;
+  value = (value | value << 2) & 0x1249249249249249;
+  return value;
+}
+
+} // namespace
+
+void orderPointsProgressively(
+    const StridedElements<FVector3f>& positions,
+    TArrayView<uint32> indices) {
+  const int32 count = indices.Num();
+  if (count < 2) {
+    return;
+  }
+
+  FVector3f minimum(TNumericLimits<float>::Max());
+  FVector3f maximum(TNumericLimits<float>::Lowest());
+  for (uint32 index : indices) {
+    minimum = FVector3f::Min(minimum, positions[index]);
+    maximum = FVector3f::Max(maximum, positions[index]);
+  }
+
+  // Each axis of the bounds is divided into 2^21 cells, so that the Morton
+  // code of a cell fits in 63 bits.
+  constexpr float cellsPerAxis = float(1 << 21) - 1.0f;
+  const FVector3f extent = maximum - minimum;
+  const FVector3f scale(
+      extent.X > 0.0f ? cellsPerAxis / extent.X : 0.0f,
+      extent.Y > 0.0f ? cellsPerAxis / extent.Y : 0.0f,
+      extent.Z > 0.0f ? cellsPerAxis / extent.Z : 0.0f);
+
+  TArray<TPair<uint64, uint32>> sorted;
+  sorted.SetNumUninitialized(count);
+  for (int32 i = 0; i < count; ++i) {
+    const FVector3f cell = (positions[indices[i]] - minimum) * scale;
+    sorted[i] = TPair<uint64, uint32>(
+        spreadMortonBits(uint64(cell.X)) |
+            spreadMortonBits(uint64(cell.Y)) << 1 |
+            spreadMortonBits(uint64(cell.Z)) << 2,
+        indices[i]);
+  }
+  Algo::SortBy(sorted, [](const TPair<uint64, uint32>& pair) {
+    return pair.Key;
+  });
+
+  // Reversing the bits of every position along the curve up to the next
+  // power of two, and skipping those past the end, visits each point once.
+  const uint32 bits = FMath::CeilLogTwo(uint32(count));
+  int32 next = 0;
+  for (uint32 i = 0; next < count; ++i) {
+    const uint32 reversed = ReverseBits(i) >> (32 - bits);
+    if (reversed < uint32(count)) {
+      indices[next++] = sorted[reversed].Value;
+    }
+  }
+}
+
+} // namespace CesiumVertexKernels
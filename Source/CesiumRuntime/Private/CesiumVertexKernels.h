@@ -0,0 +1,229 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGltf/AccessorView.h"
+#include "Containers/ArrayView.h"
+#include "Math/Color.h"
+#include "Math/Vector.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Bulk kernels for the per-vertex stages of loading a glTF primitive, such as
+ * computing its bounds and copying its positions, indices, and colors into
+ * Unreal's vertex and index buffers.
+ *
+ * Reading elements one at a time through CesiumGltf::AccessorView checks the
+ * bounds of each access, which keeps the compiler from vectorizing the loops
+ * that run over every vertex of every loaded tile. These kernels read the
+ * elements directly from the glTF buffer instead, after the view has been
+ * validated. All of them may be called from any thread.
+ */
+namespace CesiumVertexKernels {
+
+/**
+ * The elements of a glTF accessor, which are spaced a fixed number of bytes
+ * apart in memory.
+ */
+template <typename T> struct StridedElements {
+  const std::byte* pData = nullptr;
+  int64 stride = sizeof(T);
+  int64 count = 0;
+
+  const T& operator[](int64 i) const {
+    return *reinterpret_cast<const T*>(this->pData + i * this->stride);
+  }
+};
+
+/**
+ * Gets the elements of a valid accessor view.
+ */
+template <typename T>
+StridedElements<T> getElements(const CesiumGltf::AccessorView<T>& view) {
+  StridedElements<T> result;
+  result.count = view.size();
+  if (result.count > 0) {
+    result.pData = reinterpret_cast<const std::byte*>(&view[0]);
+  }
+  if (result.count > 1) {
+    result.stride =
+        reinterpret_cast<const std::byte*>(&view[1]) - result.pData;
+  }
+  return result;
+}
+
+/**
+ * Gets the elements of a vector.
+ */
+template <typename T>
+StridedElements<T> getElements(const std::vector<T>& elements) {
+  StridedElements<T> result;
+  result.pData = reinterpret_cast<const std::byte*>(elements.data());
+  result.count = static_cast<int64>(elements.size());
+  return result;
+}
+
+/**
+ * Computes the componentwise minimum and maximum of the given positions.
+ *
+ * @return False if there are no positions.
+ */
+bool computeBounds(
+    const StridedElements<FVector3f>& positions,
+    FVector3f& outMinimum,
+    FVector3f& outMaximum);
+
+/**
+ * Copies glTF positions into Unreal positions by negating their Y
+ * components.
+ *
+ * @param positions The glTF positions.
+ * @param indices If not empty, the index of the glTF position to copy to
+ * each Unreal position, for duplicated vertices. Every index must be less than
+ * the number of glTF positions. If empty, the positions are copied in order.
+ * @param pDestination Where to write the Unreal positions, which there must be
+ * room for one of for each index, or for each glTF position.
+ * @param center The point to measure the distance of the Unreal positions
+ * from.
+ * @return The largest distance of any of the copied positions from center.
+ */
+float copyPositionsFlipY(
+    const StridedElements<FVector3f>& positions,
+    TConstArrayView<uint32> indices,
+    FVector3f* pDestination,
+    const FVector3f& center);
+
+/**
+ * Reorders the indices of points so that every prefix of them is spread
+ * evenly over the points' bounds, which makes drawing only the first points
+ * a uniform subsample of all of them.
+ *
+ * The points are sorted along a Morton curve through their bounds, and then
+ * taken in the bit-reversed order of their position along it. The first half
+ * of the result is every other point along the curve, the first quarter every
+ * fourth point, and so on.
+ *
+ * @param positions The positions of the points.
+ * @param indices The indices of the points to reorder, each of which must be
+ * less than the number of positions.
+ */
+void orderPointsProgressively(
+    const StridedElements<FVector3f>& positions,
+    TArrayView<uint32> indices);
+
+/**
+ * Copies indices, widening them to 32 bits.
+ *
+ * @return The largest index, or 0 if there are none.
+ */
+template <typename TIndex>
+uint32
+copyIndices(const StridedElements<TIndex>& source, uint32* pDestination) {
+  uint32 maximum = 0;
+  if (source.stride == sizeof(TIndex)) {
+    const TIndex* pSource = reinterpret_cast<const TIndex*>(source.pData);
+    for (int64 i = 0; i < source.count; ++i) {
+      const uint32 index = static_cast<uint32>(pSource[i]);
+      pDestination[i] = index;
+      maximum = index > maximum ? index : maximum;
+    }
+  } else {
+    for (int64 i = 0; i < source.count; ++i) {
+      const uint32 index = static_cast<uint32>(source[i]);
+      pDestination[i] = index;
+      maximum = index > maximum ? index : maximum;
+    }
+  }
+  return maximum;
+}
+
+/**
+ * Expands the indices of a triangle strip into the indices of the same
+ * triangles in a triangle list. A strip has two fewer triangles than it has
+ * indices. Every other triangle has its winding reversed so that all
+ * triangles face the same way.
+ *
+ * @return The largest index, or 0 if there are none.
+ */
+template <typename TIndex>
+uint32 triangulateStrip(
+    const StridedElements<TIndex>& strip,
+    uint32* pDestination) {
+  uint32 maximum = 0;
+  for (int64 i = 0; i + 2 < strip.count; ++i) {
+    const uint32 a = static_cast<uint32>(strip[i]);
+    const uint32 b = static_cast<uint32>(strip[i + 1]);
+    const uint32 c = static_cast<uint32>(strip[i + 2]);
+    const bool odd = (i & 1) != 0;
+    pDestination[3 * i] = a;
+    pDestination[3 * i + 1] = odd ? c : b;
+    pDestination[3 * i + 2] = odd ? b : c;
+    maximum = a > maximum ? a : maximum;
+  }
+  if (strip.count >= 3) {
+    const uint32 b = static_cast<uint32>(strip[strip.count - 2]);
+    const uint32 c = static_cast<uint32>(strip[strip.count - 1]);
+    maximum = b > maximum ? b : maximum;
+    maximum = c > maximum ? c : maximum;
+  }
+  return maximum;
+}
+
+namespace Private {
+inline uint8 convertColorComponent(float value) {
+  return uint8(value * 255.0f);
+}
+inline uint8 convertColorComponent(uint8 value) { return value; }
+inline uint8 convertColorComponent(uint16 value) { return uint8(value / 256); }
+} // namespace Private
+
+/**
+ * Converts glTF vertex colors, with three or four float, normalized
+ * unsigned byte, or normalized unsigned short components, into Unreal
+ * vertex colors. Colors with three components are opaque.
+ *
+ * @param colors The glTF colors.
+ * @param indices If not empty, the index of the glTF color to convert for
+ * each Unreal color, for duplicated vertices. If empty, the colors are
+ * converted in order.
+ * @param pDestination Where to write the Unreal colors, which there must be
+ * room for one of for each index, or for each glTF color.
+ * @return False if any index is out of range.
+ */
+template <typename TElement, int32 NumComponents>
+bool convertColors(
+    const StridedElements<TElement>& colors,
+    TConstArrayView<uint32> indices,
+    FColor* pDestination) {
+  static_assert(NumComponents == 3 || NumComponents == 4);
+
+  const auto convert = [](const TElement& color, FColor& out) {
+    out.R = Private::convertColorComponent(color.value[0]);
+    out.G = Private::convertColorComponent(color.value[1]);
+    out.B = Private::convertColorComponent(color.value[2]);
+    if constexpr (NumComponents == 4) {
+      out.A = Private::convertColorComponent(color.value[3]);
+    } else {
+      out.A = 255;
+    }
+  };
+
+  if (indices.IsEmpty()) {
+    for (int64 i = 0; i < colors.count; ++i) {
+      convert(colors[i], pDestination[i]);
+    }
+    return true;
+  }
+
+  for (int32 i = 0; i < indices.Num(); ++i) {
+    if (int64(indices[i]) >= colors.count) {
+      return false;
+    }
+    convert(colors[indices[i]], pDestination[i]);
+  }
+  return true;
+}
+
+} // namespace CesiumVertexKernels
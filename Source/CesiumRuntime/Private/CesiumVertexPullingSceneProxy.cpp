@@ -0,0 +1,98 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexPullingSceneProxy.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "SceneManagement.h"
+#include "StaticMeshResources.h"
+
+SIZE_T FCesiumVertexPullingSceneProxy::GetTypeHash() const {
+  static size_t UniquePointer;
+  return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+FCesiumVertexPullingSceneProxy::FCesiumVertexPullingSceneProxy(
+    UCesiumGltfPrimitiveComponent* InComponent,
+    ERHIFeatureLevel::Type InFeatureLevel)
+    : FPrimitiveSceneProxy(InComponent),
+      RenderData(InComponent->GetPrimitiveRenderData()),
+      OwnedRenderData(InComponent->OwnedRenderData),
+      Attributes(InComponent->PulledAttributes),
+      VertexFactory(InFeatureLevel),
+      UserData(),
+      Material(InComponent->GetMaterial(0)),
+      MaterialRelevance(InComponent->GetMaterialRelevance(InFeatureLevel)) {}
+
+FCesiumVertexPullingSceneProxy::~FCesiumVertexPullingSceneProxy() {}
+
+void FCesiumVertexPullingSceneProxy::CreateRenderThreadResources() {
+  VertexFactory.InitResource();
+
+  // The attribute buffer is initialized before the component is registered,
+  // so its SRV is ready by the time this runs.
+  UserData.AttributeBuffer = Attributes->GetSRV();
+  UserData.NumTexCoords = uint32(Attributes->GetNumTexCoords());
+  UserData.UniformNormal = Attributes->GetUniformNormal();
+  UserData.PositionOffset = Attributes->GetPositionOffset();
+  UserData.PositionScale = Attributes->GetPositionScale();
+}
+
+void FCesiumVertexPullingSceneProxy::DestroyRenderThreadResources() {
+  VertexFactory.ReleaseResource();
+}
+
+void FCesiumVertexPullingSceneProxy::DrawStaticElements(
+    FStaticPrimitiveDrawInterface* PDI) {
+  const FStaticMeshLODResources& LODResources = RenderData->LODResources[0];
+  const int32 NumIndices = int32(LODResources.IndexBuffer.GetNumIndices());
+  if (NumIndices < 3) {
+    return;
+  }
+
+  FMeshBatch Mesh;
+  Mesh.VertexFactory = &VertexFactory;
+  Mesh.MaterialRenderProxy = Material->GetRenderProxy();
+  Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+  Mesh.Type = PT_TriangleList;
+  Mesh.DepthPriorityGroup = SDPG_World;
+  Mesh.LODIndex = 0;
+  Mesh.CastShadow = true;
+  Mesh.bUseAsOccluder = false;
+  Mesh.bWireframe = false;
+
+  FMeshBatchElement& BatchElement = Mesh.Elements[0];
+  BatchElement.IndexBuffer = &LODResources.IndexBuffer;
+  BatchElement.NumPrimitives = NumIndices / 3;
+  BatchElement.FirstIndex = 0;
+  BatchElement.MinVertexIndex = 0;
+  BatchElement.MaxVertexIndex = Attributes->GetNumVertices() - 1;
+  BatchElement.UserData = &UserData;
+
+  PDI->DrawMesh(Mesh, FLT_MAX);
+}
+
+FPrimitiveViewRelevance
+FCesiumVertexPullingSceneProxy::GetViewRelevance(const FSceneView* View) const {
+  FPrimitiveViewRelevance Result;
+  Result.bDrawRelevance = IsShown(View);
+  Result.bDynamicRelevance = false;
+  Result.bStaticRelevance = true;
+
+  Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+  Result.bRenderInMainPass = ShouldRenderInMainPass();
+  Result.bRenderInDepthPass = ShouldRenderInDepthPass();
+  Result.bUsesLightingChannels =
+      GetLightingChannelMask() != GetDefaultLightingChannelMask();
+  Result.bShadowRelevance = IsShadowCast(View);
+  Result.bVelocityRelevance =
+      IsMovable() & Result.bOpaque & Result.bRenderInMainPass;
+
+  MaterialRelevance.SetPrimitiveViewRelevance(Result);
+
+  return Result;
+}
+
+uint32 FCesiumVertexPullingSceneProxy::GetMemoryFootprint(void) const {
+  return (sizeof(*this) + GetAllocatedSize());
+}
@@ -0,0 +1,57 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumVertexPullingVertexFactory.h"
+#include "PrimitiveSceneProxy.h"
+#include "Templates/SharedPointer.h"
+
+class FStaticMeshRenderData;
+class UCesiumGltfPrimitiveComponent;
+
+/**
+ * Draws a glTF triangle primitive whose vertex attributes are pulled from its
+ * glTF buffer views by FCesiumVertexPullingVertexFactory. The primitive is
+ * drawn as a static mesh, so its mesh draw commands are cached.
+ */
+class FCesiumVertexPullingSceneProxy final : public FPrimitiveSceneProxy {
+public:
+  SIZE_T GetTypeHash() const override;
+
+  FCesiumVertexPullingSceneProxy(
+      UCesiumGltfPrimitiveComponent* InComponent,
+      ERHIFeatureLevel::Type InFeatureLevel);
+
+  virtual ~FCesiumVertexPullingSceneProxy();
+
+protected:
+  virtual void CreateRenderThreadResources() override;
+  virtual void DestroyRenderThreadResources() override;
+
+  virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override;
+
+  virtual FPrimitiveViewRelevance
+  GetViewRelevance(const FSceneView* View) const override;
+
+  virtual uint32 GetMemoryFootprint(void) const override;
+
+private:
+  // The render data of the static mesh or component, which has the
+  // primitive's indices but only placeholder vertices.
+  const FStaticMeshRenderData* RenderData;
+
+  // Keeps render data that is owned by the component alive until this proxy
+  // is destroyed.
+  TSharedPtr<FStaticMeshRenderData, ESPMode::ThreadSafe> OwnedRenderData;
+
+  TSharedPtr<FCesiumGltfAttributeBuffer, ESPMode::ThreadSafe> Attributes;
+
+  FCesiumVertexPullingVertexFactory VertexFactory;
+
+  // The shader parameters of every draw. These don't change, so the cached
+  // mesh draw commands can refer to them.
+  FCesiumVertexPullingBatchElementUserData UserData;
+
+  UMaterialInterface* Material;
+  FMaterialRelevance MaterialRelevance;
+};
@@ -0,0 +1,605 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexPullingVertexFactory.h"
+
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/Model.h"
+#include "Math/Float16.h"
+#include "MeshBatch.h"
+#include "MeshDrawShaderBindings.h"
+#include "MeshMaterialShader.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#if ENGINE_VERSION_5_2_OR_HIGHER
+#include "DataDrivenShaderPlatformInfo.h"
+#include "MaterialDomain.h"
+#endif
+
+using namespace CesiumGltf;
+
+namespace {
+// The attribute table slots. These must match
+// CesiumVertexPullingVertexFactory.ush.
+constexpr int32 PositionSlot = 0;
+constexpr int32 NormalSlot = 1;
+constexpr int32 FirstTexCoordSlot = 2;
+constexpr int32 NumSlots =
+    FirstTexCoordSlot + FCesiumGltfAttributeBuffer::MaxTexCoords;
+constexpr int32 WordsPerSlot = 4;
+
+// The component types of packed attributes that glTF has no equivalent for.
+// These must match CesiumVertexPullingVertexFactory.ush.
+constexpr int32_t OctEncodedComponentType = 1;
+constexpr int32_t HalfFloatComponentType = 5131;
+
+// The byte stride of each kind of packed attribute.
+constexpr int64_t PackedPositionStride = 3 * sizeof(uint16);
+constexpr int64_t PackedNormalStride = 2 * sizeof(uint16);
+constexpr int64_t PackedTexCoordStride = 2 * sizeof(uint16);
+
+int64_t computePackedStride(int32 slot) {
+  return slot == PositionSlot ? PackedPositionStride
+         : slot == NormalSlot ? PackedNormalStride
+                              : PackedTexCoordStride;
+}
+
+uint16 quantizeUnorm16(float value) {
+  return uint16(
+      FMath::Clamp(FMath::RoundToInt(value * 65535.0f), 0, int32(MAX_uint16)));
+}
+
+/**
+ * Quantizes float positions to 16 bits per component, relative to their
+ * bounds, and returns the bounds' offset and scale that decode them.
+ */
+void packPositions(
+    const Model& model,
+    const Accessor& accessor,
+    int64_t count,
+    uint16* pOut,
+    FVector3f& offset,
+    FVector3f& scale) {
+  AccessorView<FVector3f> positions(model, accessor);
+
+  FBox3f bounds(ForceInit);
+  for (int64_t i = 0; i < count; ++i) {
+    bounds += positions[i];
+  }
+  offset = bounds.Min;
+  scale = bounds.Max - bounds.Min;
+
+  for (int64_t i = 0; i < count; ++i) {
+    const FVector3f& position = positions[i];
+    for (int32 c = 0; c < 3; ++c) {
+      pOut[3 * i + c] =
+          scale[c] > 0.0f
+              ? quantizeUnorm16((position[c] - offset[c]) / scale[c])
+              : 0;
+    }
+  }
+}
+
+/**
+ * Encodes float normals into two 16-bit components each with the octahedral
+ * mapping. This must match DecodeOctNormal in
+ * CesiumVertexPullingVertexFactory.ush.
+ */
+void packNormals(
+    const Model& model,
+    const Accessor& accessor,
+    int64_t count,
+    uint16* pOut) {
+  AccessorView<FVector3f> normals(model, accessor);
+
+  for (int64_t i = 0; i < count; ++i) {
+    const FVector3f& normal = normals[i];
+    const float l1Norm =
+        FMath::Abs(normal.X) + FMath::Abs(normal.Y) + FMath::Abs(normal.Z);
+    float x = 0.0f;
+    float y = 0.0f;
+    if (l1Norm > 0.0f) {
+      x = normal.X / l1Norm;
+      y = normal.Y / l1Norm;
+      if (normal.Z < 0.0f) {
+        const float foldedX =
+            (1.0f - FMath::Abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float foldedY =
+            (1.0f - FMath::Abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+      }
+    }
+    pOut[2 * i] = quantizeUnorm16(x * 0.5f + 0.5f);
+    pOut[2 * i + 1] = quantizeUnorm16(y * 0.5f + 0.5f);
+  }
+}
+
+void packTexCoords(
+    const Model& model,
+    const Accessor& accessor,
+    int64_t count,
+    uint16* pOut) {
+  AccessorView<FVector2f> texCoords(model, accessor);
+
+  for (int64_t i = 0; i < count; ++i) {
+    pOut[2 * i] = FFloat16(texCoords[i].X).Encoded;
+    pOut[2 * i + 1] = FFloat16(texCoords[i].Y).Encoded;
+  }
+}
+
+int64_t computeElementSize(const Accessor& accessor) {
+  return int64_t(accessor.computeNumberOfComponents()) *
+         int64_t(accessor.computeByteSizeOfComponent());
+}
+
+/**
+ * Decodes one component of an attribute. This must match
+ * DecodeComponent in CesiumVertexPullingVertexFactory.ush.
+ */
+float decodeComponent(
+    const uint8* pComponent,
+    int32_t componentType,
+    bool normalized) {
+  switch (componentType) {
+  case Accessor::ComponentType::BYTE: {
+    const float value = float(*reinterpret_cast<const int8*>(pComponent));
+    return normalized ? FMath::Max(value / 127.0f, -1.0f) : value;
+  }
+  case Accessor::ComponentType::UNSIGNED_BYTE: {
+    const float value = float(*pComponent);
+    return normalized ? value / 255.0f : value;
+  }
+  case Accessor::ComponentType::SHORT: {
+    int16 component;
+    FMemory::Memcpy(&component, pComponent, sizeof(component));
+    const float value = float(component);
+    return normalized ? FMath::Max(value / 32767.0f, -1.0f) : value;
+  }
+  case Accessor::ComponentType::UNSIGNED_SHORT: {
+    uint16 component;
+    FMemory::Memcpy(&component, pComponent, sizeof(component));
+    const float value = float(component);
+    return normalized ? value / 65535.0f : value;
+  }
+  default: {
+    float component;
+    FMemory::Memcpy(&component, pComponent, sizeof(component));
+    return component;
+  }
+  }
+}
+} // namespace
+
+/*static*/ bool FCesiumGltfAttributeBuffer::IsSupportedAccessor(
+    const Model& GltfModel,
+    int32_t AccessorID,
+    int64_t NumComponents,
+    int64_t MinimumCount) {
+  const Accessor* pAccessor = Model::getSafe(&GltfModel.accessors, AccessorID);
+  if (!pAccessor || pAccessor->sparse ||
+      pAccessor->computeNumberOfComponents() != NumComponents ||
+      pAccessor->count < MinimumCount) {
+    return false;
+  }
+
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::FLOAT:
+  case Accessor::ComponentType::BYTE:
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+  case Accessor::ComponentType::SHORT:
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    break;
+  default:
+    return false;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&GltfModel.bufferViews, pAccessor->bufferView);
+  if (!pBufferView) {
+    return false;
+  }
+
+  const Buffer* pBuffer =
+      Model::getSafe(&GltfModel.buffers, pBufferView->buffer);
+  if (!pBuffer || pBufferView->byteOffset < 0 ||
+      pBufferView->byteOffset + pBufferView->byteLength >
+          int64_t(pBuffer->cesium.data.size())) {
+    return false;
+  }
+
+  const int64_t stride = pAccessor->computeByteStride(GltfModel);
+  if (stride <= 0 || pAccessor->byteOffset < 0) {
+    return false;
+  }
+
+  const int64_t end = pAccessor->byteOffset +
+                      (pAccessor->count - 1) * stride +
+                      computeElementSize(*pAccessor);
+  return pAccessor->count == 0 || end <= pBufferView->byteLength;
+}
+
+/*static*/ TSharedPtr<FCesiumGltfAttributeBuffer, ESPMode::ThreadSafe>
+FCesiumGltfAttributeBuffer::Create(
+    const Model& GltfModel,
+    int32_t PositionAccessorID,
+    int32_t NormalAccessorID,
+    TArrayView<const int32_t> TexCoordAccessorIDs,
+    const FVector3f& UniformNormal,
+    bool bPackAttributes) {
+  const Accessor* pPositionAccessor =
+      Model::getSafe(&GltfModel.accessors, PositionAccessorID);
+  if (!pPositionAccessor || TexCoordAccessorIDs.Num() > MaxTexCoords ||
+      !IsSupportedAccessor(GltfModel, PositionAccessorID, 3, 0)) {
+    return nullptr;
+  }
+
+  const int64_t numVertices = pPositionAccessor->count;
+  if (numVertices <= 0) {
+    return nullptr;
+  }
+
+  int32_t slotAccessorIDs[NumSlots];
+  for (int32 slot = 0; slot < NumSlots; ++slot) {
+    slotAccessorIDs[slot] = -1;
+  }
+  slotAccessorIDs[PositionSlot] = PositionAccessorID;
+
+  if (NormalAccessorID >= 0) {
+    if (!IsSupportedAccessor(GltfModel, NormalAccessorID, 3, numVertices)) {
+      return nullptr;
+    }
+    slotAccessorIDs[NormalSlot] = NormalAccessorID;
+  }
+
+  for (int32 i = 0; i < TexCoordAccessorIDs.Num(); ++i) {
+    if (!IsSupportedAccessor(
+            GltfModel,
+            TexCoordAccessorIDs[i],
+            2,
+            numVertices)) {
+      return nullptr;
+    }
+    slotAccessorIDs[FirstTexCoordSlot + i] = TexCoordAccessorIDs[i];
+  }
+
+  // Quantized attributes are already compact, so only float attributes are
+  // packed.
+  bool packSlot[NumSlots];
+  for (int32 slot = 0; slot < NumSlots; ++slot) {
+    packSlot[slot] = bPackAttributes && slotAccessorIDs[slot] >= 0 &&
+                     GltfModel.accessors[slotAccessorIDs[slot]].componentType ==
+                         Accessor::ComponentType::FLOAT;
+  }
+
+  // Only the part of each buffer view that's used by these accessors is
+  // copied, because a buffer view may be shared by many primitives.
+  struct CopiedRange {
+    int64_t begin;
+    int64_t end;
+    uint32 dataOffset;
+  };
+  TMap<int32_t, CopiedRange> ranges;
+
+  for (int32 slot = 0; slot < NumSlots; ++slot) {
+    if (slotAccessorIDs[slot] < 0 || packSlot[slot]) {
+      continue;
+    }
+
+    const Accessor& accessor = GltfModel.accessors[slotAccessorIDs[slot]];
+    const int64_t begin = accessor.byteOffset;
+    const int64_t end = accessor.byteOffset +
+                        (numVertices - 1) *
+                            accessor.computeByteStride(GltfModel) +
+                        computeElementSize(accessor);
+
+    CopiedRange* pRange = ranges.Find(accessor.bufferView);
+    if (pRange) {
+      pRange->begin = FMath::Min(pRange->begin, begin);
+      pRange->end = FMath::Max(pRange->end, end);
+    } else {
+      ranges.Add(accessor.bufferView, CopiedRange{begin, end, 0});
+    }
+  }
+
+  // Every range starts on a word, so that accessors that are aligned within
+  // their buffer view are also aligned within the byte address buffer.
+  int64_t dataSize = int64_t(NumSlots * WordsPerSlot) * sizeof(uint32);
+  for (TPair<int32_t, CopiedRange>& range : ranges) {
+    range.Value.dataOffset = uint32(dataSize);
+    dataSize += Align(range.Value.end - range.Value.begin, sizeof(uint32));
+  }
+
+  // Packed attributes follow the copied buffer views.
+  int64_t packedOffsets[NumSlots];
+  for (int32 slot = 0; slot < NumSlots; ++slot) {
+    packedOffsets[slot] = dataSize;
+    if (packSlot[slot]) {
+      dataSize +=
+          Align(numVertices * computePackedStride(slot), sizeof(uint32));
+    }
+  }
+
+  if (dataSize > int64_t(MAX_int32)) {
+    return nullptr;
+  }
+
+  FCesiumGltfAttributeBuffer* pBuffer = new FCesiumGltfAttributeBuffer();
+  pBuffer->NumVertices = int32(numVertices);
+  pBuffer->NumTexCoords = TexCoordAccessorIDs.Num();
+  pBuffer->UniformNormal =
+      FVector3f(UniformNormal.X, -UniformNormal.Y, UniformNormal.Z);
+  pBuffer->Data.SetNumZeroed(int32(dataSize / sizeof(uint32)));
+
+  uint8* pData = reinterpret_cast<uint8*>(pBuffer->Data.GetData());
+  for (const TPair<int32_t, CopiedRange>& range : ranges) {
+    const BufferView& bufferView = GltfModel.bufferViews[range.Key];
+    const Buffer& buffer = GltfModel.buffers[bufferView.buffer];
+    FMemory::Memcpy(
+        pData + range.Value.dataOffset,
+        buffer.cesium.data.data() + bufferView.byteOffset + range.Value.begin,
+        range.Value.end - range.Value.begin);
+  }
+
+  for (int32 slot = 0; slot < NumSlots; ++slot) {
+    if (slotAccessorIDs[slot] < 0) {
+      continue;
+    }
+
+    const Accessor& accessor = GltfModel.accessors[slotAccessorIDs[slot]];
+    uint32* pSlot = &pBuffer->Data[slot * WordsPerSlot];
+
+    if (packSlot[slot]) {
+      uint16* pPacked = reinterpret_cast<uint16*>(pData + packedOffsets[slot]);
+      pSlot[0] = uint32(packedOffsets[slot]);
+      pSlot[1] = uint32(computePackedStride(slot));
+      if (slot == PositionSlot) {
+        packPositions(
+            GltfModel,
+            accessor,
+            numVertices,
+            pPacked,
+            pBuffer->PositionOffset,
+            pBuffer->PositionScale);
+        pSlot[2] = uint32(Accessor::ComponentType::UNSIGNED_SHORT);
+        pSlot[3] = 1;
+      } else if (slot == NormalSlot) {
+        packNormals(GltfModel, accessor, numVertices, pPacked);
+        pSlot[2] = uint32(OctEncodedComponentType);
+        pSlot[3] = 1;
+      } else {
+        packTexCoords(GltfModel, accessor, numVertices, pPacked);
+        pSlot[2] = uint32(HalfFloatComponentType);
+        pSlot[3] = 0;
+      }
+      continue;
+    }
+
+    const CopiedRange& range = ranges.FindChecked(accessor.bufferView);
+    pSlot[0] = uint32(range.dataOffset + accessor.byteOffset - range.begin);
+    pSlot[1] = uint32(accessor.computeByteStride(GltfModel));
+    pSlot[2] = uint32(accessor.componentType);
+    pSlot[3] = accessor.normalized ? 1 : 0;
+  }
+
+  // Scene proxies may hold a reference to the buffer after its component has
+  // let go of it, so it's released on the render thread, after any proxy that
+  // was using it.
+  return MakeShareable(pBuffer, [](FCesiumGltfAttributeBuffer* p) {
+    ENQUEUE_RENDER_COMMAND(ReleaseCesiumGltfAttributeBuffer)
+    ([p](FRHICommandListImmediate& RHICmdList) {
+      p->ReleaseResource();
+      delete p;
+    });
+  });
+}
+
+void FCesiumGltfAttributeBuffer::GetPositions(
+    TArray<FVector3f>& OutPositions) const {
+  check(Data.Num() > 0);
+
+  const uint32* pSlot = &Data[PositionSlot * WordsPerSlot];
+  const uint8* pData = reinterpret_cast<const uint8*>(Data.GetData());
+  const int32_t componentType = int32_t(pSlot[2]);
+  const bool normalized = pSlot[3] != 0;
+  const uint32 componentSize =
+      componentType == Accessor::ComponentType::FLOAT ? 4
+      : componentType == Accessor::ComponentType::SHORT ||
+              componentType == Accessor::ComponentType::UNSIGNED_SHORT
+          ? 2
+          : 1;
+
+  OutPositions.SetNumUninitialized(NumVertices);
+  for (int32 i = 0; i < NumVertices; ++i) {
+    const uint8* pElement = pData + pSlot[0] + uint32(i) * pSlot[1];
+    const FVector3f position =
+        PositionOffset +
+        PositionScale *
+            FVector3f(
+                decodeComponent(pElement, componentType, normalized),
+                decodeComponent(
+                    pElement + componentSize,
+                    componentType,
+                    normalized),
+                decodeComponent(
+                    pElement + 2 * componentSize,
+                    componentType,
+                    normalized));
+    OutPositions[i] = FVector3f(position.X, -position.Y, position.Z);
+  }
+}
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+void FCesiumGltfAttributeBuffer::InitRHI(FRHICommandListBase& RHICmdList) {
+#else
+void FCesiumGltfAttributeBuffer::InitRHI() {
+#endif
+  if (Data.Num() == 0) {
+    return;
+  }
+
+  FRHIResourceCreateInfo CreateInfo(TEXT("FCesiumGltfAttributeBuffer"));
+  const uint32 Size = uint32(Data.Num()) * sizeof(uint32);
+  BufferRHI = RHICreateBuffer(
+      Size,
+      BUF_Static | BUF_ByteAddressBuffer | BUF_ShaderResource,
+      sizeof(uint32),
+      ERHIAccess::SRVMask,
+      CreateInfo);
+
+  void* Contents = RHILockBuffer(BufferRHI, 0, Size, RLM_WriteOnly);
+  FMemory::Memcpy(Contents, Data.GetData(), Size);
+  RHIUnlockBuffer(BufferRHI);
+
+  SRV = RHICreateShaderResourceView(BufferRHI);
+
+  // The GPU copy is all that's needed from here on.
+  Data.Empty();
+}
+
+void FCesiumGltfAttributeBuffer::ReleaseRHI() {
+  SRV.SafeRelease();
+  BufferRHI.SafeRelease();
+}
+
+class FCesiumVertexPullingVertexFactoryShaderParameters
+    : public FVertexFactoryShaderParameters {
+
+  DECLARE_TYPE_LAYOUT(
+      FCesiumVertexPullingVertexFactoryShaderParameters,
+      NonVirtual);
+
+public:
+  void Bind(const FShaderParameterMap& ParameterMap) {
+    AttributeBuffer.Bind(ParameterMap, TEXT("AttributeBuffer"));
+    NumTexCoords.Bind(ParameterMap, TEXT("NumTexCoords"));
+    UniformNormal.Bind(ParameterMap, TEXT("UniformNormal"));
+    PositionOffset.Bind(ParameterMap, TEXT("PositionOffset"));
+    PositionScale.Bind(ParameterMap, TEXT("PositionScale"));
+  }
+
+  void GetElementShaderBindings(
+      const FSceneInterface* Scene,
+      const FSceneView* View,
+      const FMeshMaterialShader* Shader,
+      const EVertexInputStreamType InputStreamType,
+      ERHIFeatureLevel::Type FeatureLevel,
+      const FVertexFactory* VertexFactory,
+      const FMeshBatchElement& BatchElement,
+      FMeshDrawSingleShaderBindings& ShaderBindings,
+      FVertexInputStreamArray& VertexStreams) const {
+    FCesiumVertexPullingBatchElementUserData* UserData =
+        (FCesiumVertexPullingBatchElementUserData*)BatchElement.UserData;
+    if (UserData->AttributeBuffer && AttributeBuffer.IsBound()) {
+      ShaderBindings.Add(AttributeBuffer, UserData->AttributeBuffer);
+    }
+    if (NumTexCoords.IsBound()) {
+      ShaderBindings.Add(NumTexCoords, UserData->NumTexCoords);
+    }
+    if (UniformNormal.IsBound()) {
+      ShaderBindings.Add(UniformNormal, UserData->UniformNormal);
+    }
+    if (PositionOffset.IsBound()) {
+      ShaderBindings.Add(PositionOffset, UserData->PositionOffset);
+    }
+    if (PositionScale.IsBound()) {
+      ShaderBindings.Add(PositionScale, UserData->PositionScale);
+    }
+  }
+
+private:
+  LAYOUT_FIELD(FShaderResourceParameter, AttributeBuffer);
+  LAYOUT_FIELD(FShaderParameter, NumTexCoords);
+  LAYOUT_FIELD(FShaderParameter, UniformNormal);
+  LAYOUT_FIELD(FShaderParameter, PositionOffset);
+  LAYOUT_FIELD(FShaderParameter, PositionScale);
+};
+
+/**
+ * A dummy vertex buffer to bind when rendering pulled vertices. This prevents
+ * rendering pipeline errors that can occur with zero-stream input layouts.
+ */
+class FCesiumVertexPullingDummyVertexBuffer : public FVertexBuffer {
+public:
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void InitRHI() override;
+#endif
+};
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+void FCesiumVertexPullingDummyVertexBuffer::InitRHI(
+    FRHICommandListBase& RHICmdList) {
+#else
+void FCesiumVertexPullingDummyVertexBuffer::InitRHI() {
+#endif
+  FRHIResourceCreateInfo CreateInfo(
+      TEXT("FCesiumVertexPullingDummyVertexBuffer"));
+  VertexBufferRHI = RHICreateBuffer(
+      sizeof(FVector3f),
+      BUF_Static | BUF_VertexBuffer,
+      0,
+      ERHIAccess::VertexOrIndexBuffer,
+      CreateInfo);
+  FVector3f* DummyContents = (FVector3f*)
+      RHILockBuffer(VertexBufferRHI, 0, sizeof(FVector3f), RLM_WriteOnly);
+  DummyContents[0] = FVector3f(0.0f, 0.0f, 0.0f);
+  RHIUnlockBuffer(VertexBufferRHI);
+}
+
+TGlobalResource<FCesiumVertexPullingDummyVertexBuffer>
+    GCesiumVertexPullingDummyVertexBuffer;
+
+FCesiumVertexPullingVertexFactory::FCesiumVertexPullingVertexFactory(
+    ERHIFeatureLevel::Type InFeatureLevel)
+    : FLocalVertexFactory(
+          InFeatureLevel,
+          "FCesiumVertexPullingVertexFactory") {}
+
+bool FCesiumVertexPullingVertexFactory::ShouldCompilePermutation(
+    const FVertexFactoryShaderPermutationParameters& Parameters) {
+  if (!RHISupportsManualVertexFetch(Parameters.Platform)) {
+    return false;
+  }
+
+  return Parameters.MaterialParameters.MaterialDomain == MD_Surface ||
+         Parameters.MaterialParameters.bIsDefaultMaterial ||
+         Parameters.MaterialParameters.bIsSpecialEngineMaterial;
+}
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+void FCesiumVertexPullingVertexFactory::InitRHI(
+    FRHICommandListBase& RHICmdList) {
+#else
+void FCesiumVertexPullingVertexFactory::InitRHI() {
+#endif
+  // Every vertex reads the same dummy element; the real attributes are pulled
+  // from the attribute buffer in the vertex shader.
+  FVertexDeclarationElementList Elements;
+  Elements.Add(AccessStreamComponent(
+      FVertexStreamComponent(
+          &GCesiumVertexPullingDummyVertexBuffer,
+          0,
+          0,
+          VET_Float3),
+      0));
+  InitDeclaration(Elements);
+}
+
+void FCesiumVertexPullingVertexFactory::ReleaseRHI() {
+  FVertexFactory::ReleaseRHI();
+}
+
+IMPLEMENT_TYPE_LAYOUT(FCesiumVertexPullingVertexFactoryShaderParameters);
+
+IMPLEMENT_VERTEX_FACTORY_PARAMETER_TYPE(
+    FCesiumVertexPullingVertexFactory,
+    SF_Vertex,
+    FCesiumVertexPullingVertexFactoryShaderParameters);
+
+IMPLEMENT_VERTEX_FACTORY_TYPE(
+    FCesiumVertexPullingVertexFactory,
+    "/Plugin/CesiumForUnreal/Private/CesiumVertexPullingVertexFactory.ush",
+    EVertexFactoryFlags::UsedWithMaterials |
+        EVertexFactoryFlags::SupportsDynamicLighting |
+        EVertexFactoryFlags::SupportsCachingMeshDrawCommands);
@@ -0,0 +1,174 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "LocalVertexFactory.h"
+#include "RHIDefinitions.h"
+#include "RHIResources.h"
+#include "RenderResource.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Templates/SharedPointer.h"
+#include <cstdint>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+/**
+ * The vertex attributes of a glTF triangle primitive, copied nearly as-is
+ * from the glTF buffer views into a byte address buffer. These are read by
+ * FCesiumVertexPullingVertexFactory, which decodes each attribute in the
+ * vertex shader according to its accessor, so the attributes don't need to be
+ * converted to Unreal vertex formats first. This includes the quantized
+ * attributes of KHR_mesh_quantization.
+ *
+ * The buffer starts with a table that describes where each attribute is. Each
+ * buffer view is copied once, however many attributes are interleaved in it.
+ * Float attributes may instead be packed into smaller formats, which the
+ * vertex factory decodes the same way.
+ *
+ * The copied data is discarded once it has been copied to the GPU.
+ */
+class FCesiumGltfAttributeBuffer : public FRenderResource {
+public:
+  /**
+   * The most texture coordinate sets that a primitive drawn with pulled
+   * vertices may use.
+   */
+  static constexpr int32 MaxTexCoords = 8;
+
+  /**
+   * Determines whether the given accessor can be read by the vertex factory.
+   * It must have the given number of components, at least the given number
+   * of elements, a component type that the vertex factory can decode, and no
+   * sparse values.
+   */
+  static bool IsSupportedAccessor(
+      const CesiumGltf::Model& GltfModel,
+      int32_t AccessorID,
+      int64_t NumComponents,
+      int64_t MinimumCount);
+
+  /**
+   * Copies the buffer views of the given accessors. This may be called from
+   * any thread. The buffer is released on the render thread once the last
+   * reference to it is gone.
+   *
+   * @param GltfModel The glTF model.
+   * @param PositionAccessorID The accessor of the VEC3 positions.
+   * @param NormalAccessorID The accessor of the VEC3 normals, or -1 to use
+   * UniformNormal for every vertex.
+   * @param TexCoordAccessorIDs The accessors of the VEC2 texture coordinates,
+   * in the order of their Unreal texture coordinate indices.
+   * @param UniformNormal The normal of every vertex, in glTF coordinates, if
+   * there's no normal accessor.
+   * @param bPackAttributes Whether to pack float positions into 16 bits
+   * relative to their bounds, float normals into 16-bit octahedral pairs, and
+   * float texture coordinates into half floats, rather than copying them.
+   * @return The buffer, or nullptr if any of the accessors is not supported.
+   */
+  static TSharedPtr<FCesiumGltfAttributeBuffer, ESPMode::ThreadSafe> Create(
+      const CesiumGltf::Model& GltfModel,
+      int32_t PositionAccessorID,
+      int32_t NormalAccessorID,
+      TArrayView<const int32_t> TexCoordAccessorIDs,
+      const FVector3f& UniformNormal,
+      bool bPackAttributes);
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void InitRHI() override;
+#endif
+  virtual void ReleaseRHI() override;
+
+  /**
+   * Decodes the positions, with the Y axis flipped to match the positions of
+   * an Unreal static mesh. This must be called before the buffer is
+   * initialized, because the data is discarded after that.
+   */
+  void GetPositions(TArray<FVector3f>& OutPositions) const;
+
+  int32 GetNumVertices() const { return NumVertices; }
+
+  int32 GetNumTexCoords() const { return NumTexCoords; }
+
+  /**
+   * Gets the normal of every vertex if the primitive has no normals, with the
+   * Y axis flipped.
+   */
+  const FVector3f& GetUniformNormal() const { return UniformNormal; }
+
+  /**
+   * Gets the glTF position of a vertex whose decoded position components are
+   * all 0. This is only nonzero if the positions were packed.
+   */
+  const FVector3f& GetPositionOffset() const { return PositionOffset; }
+
+  /**
+   * Gets the factor that the decoded position components are multiplied by
+   * before PositionOffset is added. This is only not 1 if the positions were
+   * packed.
+   */
+  const FVector3f& GetPositionScale() const { return PositionScale; }
+
+  FRHIShaderResourceView* GetSRV() const { return SRV; }
+
+private:
+  FCesiumGltfAttributeBuffer() = default;
+
+  int32 NumVertices = 0;
+  int32 NumTexCoords = 0;
+  FVector3f UniformNormal = FVector3f::UnitZ();
+  FVector3f PositionOffset = FVector3f::ZeroVector;
+  FVector3f PositionScale = FVector3f::OneVector;
+
+  // The attribute table, followed by the copied buffer views. The table has
+  // four words for each of the position, the normal, and MaxTexCoords texture
+  // coordinate sets: the byte offset of the first element, the byte stride,
+  // the glTF component type, and whether the values are normalized. Packed
+  // normals and texture coordinates use component types that glTF doesn't
+  // have. This must match CesiumVertexPullingVertexFactory.ush.
+  TArray<uint32> Data;
+  FBufferRHIRef BufferRHI;
+  FShaderResourceViewRHIRef SRV;
+};
+
+/**
+ * The parameters to be passed as UserData to the
+ * shader.
+ */
+struct FCesiumVertexPullingBatchElementUserData {
+  FRHIShaderResourceView* AttributeBuffer;
+  uint32 NumTexCoords;
+  FVector3f UniformNormal;
+  FVector3f PositionOffset;
+  FVector3f PositionScale;
+};
+
+/**
+ * A vertex factory that pulls the vertex attributes of a glTF triangle
+ * primitive from an FCesiumGltfAttributeBuffer, like
+ * FCesiumPointAttenuationVertexFactory does for points. The primitive is
+ * drawn with the index buffer of its static mesh, which has only placeholder
+ * vertices.
+ */
+class FCesiumVertexPullingVertexFactory : public FLocalVertexFactory {
+
+  DECLARE_VERTEX_FACTORY_TYPE(FCesiumVertexPullingVertexFactory);
+
+public:
+  FCesiumVertexPullingVertexFactory(ERHIFeatureLevel::Type InFeatureLevel);
+
+  static bool ShouldCompilePermutation(
+      const FVertexFactoryShaderPermutationParameters& Parameters);
+
+private:
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void InitRHI() override;
+#endif
+  virtual void ReleaseRHI() override;
+};
@@ -14,6 +14,7 @@ CesiumViewExtension::~CesiumViewExtension() {}
 
 TileOcclusionState CesiumViewExtension::getPrimitiveOcclusionState(
     const FPrimitiveComponentId& id,
+    int32 occlusionSlot,
     bool previouslyOccluded,
     float frameTimeCutoff) const {
   if (_currentOcclusionResults.occlusionResultsByView.size() == 0) {
@@ -25,8 +26,13 @@ TileOcclusionState CesiumViewExtension::getPrimitiveOcclusionState(
 
   for (const SceneViewOcclusionResults& viewOcclusionResults :
        _currentOcclusionResults.occlusionResultsByView) {
+    const TArray<PrimitiveOcclusionResult>& results =
+        viewOcclusionResults.PrimitiveOcclusionResults;
     const PrimitiveOcclusionResult* pOcclusionResult =
-        viewOcclusionResults.PrimitiveOcclusionResults.Find(id);
+        results.IsValidIndex(occlusionSlot) &&
+                results[occlusionSlot].PrimitiveId == id
+            ? &results[occlusionSlot]
+            : nullptr;
 
     if (pOcclusionResult &&
         pOcclusionResult->LastConsideredTime >= frameTimeCutoff) {
@@ -57,6 +63,50 @@ TileOcclusionState CesiumViewExtension::getPrimitiveOcclusionState(
   }
 }
 
+int32 CesiumViewExtension::AllocateOcclusionSlot() {
+  check(IsInGameThread());
+
+  if (this->_freeOcclusionSlots.Num() > 0) {
+    return this->_freeOcclusionSlots.Pop(false);
+  }
+  return this->_occlusionSlotCount++;
+}
+
+void CesiumViewExtension::ReleaseOcclusionSlot(int32 occlusionSlot) {
+  check(IsInGameThread());
+
+  if (occlusionSlot != INDEX_NONE) {
+    this->_freeOcclusionSlots.Add(occlusionSlot);
+  }
+}
+
+void CesiumViewExtension::SetOcclusionSlotProxy_RenderThread(
+    int32 occlusionSlot,
+    const FPrimitiveSceneProxy* pProxy) {
+  check(IsInRenderingThread());
+
+  if (occlusionSlot == INDEX_NONE) {
+    return;
+  }
+
+  if (occlusionSlot >= this->_occlusionSlotProxies_renderThread.Num()) {
+    this->_occlusionSlotProxies_renderThread.SetNumZeroed(occlusionSlot + 1);
+  }
+  this->_occlusionSlotProxies_renderThread[occlusionSlot] = pProxy;
+}
+
+void CesiumViewExtension::ClearOcclusionSlotProxy_RenderThread(
+    int32 occlusionSlot,
+    const FPrimitiveSceneProxy* pProxy) {
+  check(IsInRenderingThread());
+
+  // A primitive's proxy may be recreated before the old one is removed.
+  if (this->_occlusionSlotProxies_renderThread.IsValidIndex(occlusionSlot) &&
+      this->_occlusionSlotProxies_renderThread[occlusionSlot] == pProxy) {
+    this->_occlusionSlotProxies_renderThread[occlusionSlot] = nullptr;
+  }
+}
+
 void CesiumViewExtension::SetupViewFamily(FSceneViewFamily& InViewFamily) {}
 
 void CesiumViewExtension::SetupView(
@@ -65,6 +115,13 @@ void CesiumViewExtension::SetupView(
 
 void CesiumViewExtension::BeginRenderViewFamily(
     FSceneViewFamily& InViewFamily) {
+  if (this->_isHzbOcclusionEnabled) {
+    this->_hzbOcclusion.beginRenderViewFamily();
+  }
+
+  this->_depthPicking.beginRenderViewFamily();
+  this->_eyeDomeLighting.beginRenderViewFamily();
+
   if (!this->_isEnabled)
     return;
 
@@ -106,9 +163,40 @@ getOcclusionHistorySet(const FSceneViewState* pViewState) {
 
 } // namespace
 
+void CesiumViewExtension::PostRenderBasePassDeferred_RenderThread(
+    FRDGBuilder& GraphBuilder,
+    FSceneView& InView,
+    const FRenderTargetBindingSlots& RenderTargets,
+    TRDGUniformBufferRef<FSceneTextureUniformParameters> SceneTextures) {
+  if (SceneTextures) {
+    this->_depthPicking.postRenderBasePass_RenderThread(
+        GraphBuilder,
+        InView,
+        SceneTextures->GetParameters()->SceneDepthTexture);
+  }
+}
+
+void CesiumViewExtension::PrePostProcessPass_RenderThread(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View,
+    const FPostProcessingInputs& Inputs) {
+  this->_eyeDomeLighting.prePostProcessPass_RenderThread(
+      GraphBuilder,
+      View,
+      Inputs);
+}
+
 void CesiumViewExtension::PostRenderViewFamily_RenderThread(
     FRHICommandListImmediate& RHICmdList,
     FSceneViewFamily& InViewFamily) {
+  if (this->_isHzbOcclusionEnabled) {
+    this->_hzbOcclusion.postRenderViewFamily_RenderThread(
+        RHICmdList,
+        InViewFamily);
+  }
+
+  this->_depthPicking.postRenderViewFamily_RenderThread();
+
   if (!this->_isEnabled)
     return;
 
@@ -124,6 +212,9 @@ void CesiumViewExtension::PostRenderViewFamily_RenderThread(
   }
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AggregateOcclusionForViewFamily)
+  FScene* pScene = InViewFamily.Scene->GetRenderScene();
+  const int32 slotCount = this->_occlusionSlotProxies_renderThread.Num();
+
   for (const FSceneView* pView : InViewFamily.Views) {
     if (pView == nullptr || pView->State == nullptr)
       continue;
@@ -137,21 +228,19 @@ void CesiumViewExtension::PostRenderViewFamily_RenderThread(
       occlusionResults.pView = pView;
 
       if (!_recycledOcclusionResultSets.IsEmpty()) {
-        // Recycle a previously allocated occlusion history set, if one is
+        // Recycle a previously allocated occlusion result array, if one is
         // available.
         occlusionResults.PrimitiveOcclusionResults =
             std::move(*_recycledOcclusionResultSets.Peek());
         _recycledOcclusionResultSets.Pop();
       } else {
-        // If no previously-allocated set exists, just allocate a new one. It
+        // If no previously-allocated array exists, just allocate a new one. It
         // will be recycled later.
       }
 
-      occlusionResults.PrimitiveOcclusionResults.Reserve(
-          getOcclusionHistorySet(pViewState).Num());
-      for (const auto& element : getOcclusionHistorySet(pViewState)) {
-        occlusionResults.PrimitiveOcclusionResults.Emplace(element);
-      }
+      TArray<PrimitiveOcclusionResult>& occlusion =
+          occlusionResults.PrimitiveOcclusionResults;
+      occlusion.SetNum(slotCount, false);
 
       // Unreal will not execute occlusion queries that get frustum culled in a
       // particular view, leaving the occlusion results indefinite. And by just
@@ -160,35 +249,44 @@ void CesiumViewExtension::PostRenderViewFamily_RenderThread(
       // that were culled. So here we detect primitives that have been
       // conclusively proven to be not visible (outside the view frustum) and
       // also mark them definitely occluded.
-      FScene* pScene = InViewFamily.Scene->GetRenderScene();
-      if (pView->bIsViewInfo && pScene != nullptr) {
-        const FViewInfo* pViewInfo = static_cast<const FViewInfo*>(pView);
-        const FSceneBitArray& visibility = pViewInfo->PrimitiveVisibilityMap;
-        auto& occlusion = occlusionResults.PrimitiveOcclusionResults;
-
-        const uint32 PrimitiveCount = pScene->Primitives.Num();
-        for (uint32 i = 0; i < PrimitiveCount; ++i) {
-          // We're only concerned with primitives that are not visible
-          if (visibility[i])
-            continue;
-
-          FPrimitiveSceneInfo* pSceneInfo = pScene->Primitives[i];
-          if (pSceneInfo == nullptr)
-            continue;
-
-          const PrimitiveOcclusionResult* pOcclusionResult =
-              occlusion.Find(pSceneInfo->PrimitiveComponentId);
-          if (!pOcclusionResult || pOcclusionResult->LastConsideredTime <
-                                       pViewState->LastRenderTime) {
-            // No valid occlusion history for this culled primitive, so create
-            // it.
-            occlusion.Emplace(PrimitiveOcclusionResult(
-                pSceneInfo->PrimitiveComponentId,
-                pViewState->LastRenderTime,
-                0.0f,
-                true,
-                true));
-          }
+      const FSceneBitArray* pVisibility =
+          pView->bIsViewInfo
+              ? &static_cast<const FViewInfo*>(pView)->PrimitiveVisibilityMap
+              : nullptr;
+
+      for (int32 slot = 0; slot < slotCount; ++slot) {
+        PrimitiveOcclusionResult& result = occlusion[slot];
+        result = PrimitiveOcclusionResult();
+
+        const FPrimitiveSceneProxy* pProxy =
+            this->_occlusionSlotProxies_renderThread[slot];
+        const FPrimitiveSceneInfo* pSceneInfo =
+            pProxy ? pProxy->GetPrimitiveSceneInfo() : nullptr;
+        if (pSceneInfo == nullptr || pSceneInfo->Scene != pScene)
+          continue;
+
+        const FPrimitiveOcclusionHistory* pHistory =
+            getOcclusionHistorySet(pViewState)
+                .Find(FPrimitiveOcclusionHistoryKey(
+                    pSceneInfo->PrimitiveComponentId,
+                    0));
+        if (pHistory) {
+          result = PrimitiveOcclusionResult(*pHistory);
+        }
+
+        const int32 primitiveIndex = pSceneInfo->GetIndex();
+        if (pVisibility && pVisibility->IsValidIndex(primitiveIndex) &&
+            !(*pVisibility)[primitiveIndex] &&
+            (!pHistory ||
+             pHistory->LastConsideredTime < pViewState->LastRenderTime)) {
+          // No valid occlusion history for this culled primitive, so create
+          // it.
+          result = PrimitiveOcclusionResult(
+              pSceneInfo->PrimitiveComponentId,
+              pViewState->LastRenderTime,
+              0.0f,
+              true,
+              true);
         }
       }
     }
@@ -198,3 +296,7 @@ void CesiumViewExtension::PostRenderViewFamily_RenderThread(
 void CesiumViewExtension::SetEnabled(bool enabled) {
   this->_isEnabled = enabled;
 }
+
+void CesiumViewExtension::SetHzbOcclusionEnabled(bool enabled) {
+  this->_isHzbOcclusionEnabled = enabled;
+}
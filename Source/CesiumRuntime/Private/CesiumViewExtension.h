@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include "CesiumDepthPicking.h"
+#include "CesiumEyeDomeLighting.h"
+#include "CesiumHzbOcclusion.h"
 #include "Containers/Queue.h"
 #include "Containers/Set.h"
 #include "Runtime/Renderer/Private/ScenePrivate.h"
@@ -17,6 +20,8 @@ class CesiumViewExtension : public FSceneViewExtensionBase {
 private:
   // Occlusion results for a single view.
   struct PrimitiveOcclusionResult {
+    PrimitiveOcclusionResult() = default;
+
     PrimitiveOcclusionResult(
         const FPrimitiveComponentId primitiveId,
         float lastConsideredTime,
@@ -38,34 +43,19 @@ private:
               renderer.OcclusionStateWasDefiniteLastFrame),
           WasOccludedLastFrame(renderer.WasOccludedLastFrame) {}
 
-    FPrimitiveComponentId PrimitiveId;
-    float LastConsideredTime;
-    float LastPixelsPercentage;
-    bool OcclusionStateWasDefiniteLastFrame;
-    bool WasOccludedLastFrame;
+    // A default-constructed result has an invalid PrimitiveId, which never
+    // matches a registered primitive.
+    FPrimitiveComponentId PrimitiveId{};
+    float LastConsideredTime = -1.0f;
+    float LastPixelsPercentage = 0.0f;
+    bool OcclusionStateWasDefiniteLastFrame = false;
+    bool WasOccludedLastFrame = false;
   };
 
-  // Defines how PrimitiveOcclusionResult is stored in a TSet
-  struct PrimitiveOcclusionResultKeyFuncs
-      : BaseKeyFuncs<PrimitiveOcclusionResult, FPrimitiveComponentId> {
-    typedef FPrimitiveComponentId KeyInitType;
-
-    static KeyInitType GetSetKey(const PrimitiveOcclusionResult& Element) {
-      return Element.PrimitiveId;
-    }
-
-    static bool Matches(KeyInitType A, KeyInitType B) { return A == B; }
-
-    static uint32 GetKeyHash(KeyInitType Key) {
-      return GetTypeHash(Key.PrimIDValue);
-    }
-  };
-
-  // The occlusion results for a single view.
+  // The occlusion results for a single view, indexed by occlusion slot.
   struct SceneViewOcclusionResults {
     const FSceneView* pView = nullptr;
-    TSet<PrimitiveOcclusionResult, PrimitiveOcclusionResultKeyFuncs>
-        PrimitiveOcclusionResults{};
+    TArray<PrimitiveOcclusionResult> PrimitiveOcclusionResults{};
   };
 
   // A collection of occlusion results by view.
@@ -81,29 +71,84 @@ private:
   // thread.
   TQueue<AggregatedOcclusionUpdate, EQueueMode::Spsc> _occlusionResultsQueue;
 
-  // A queue to recycle the previously-allocated occlusion result sets. The
-  // game thread recycles the sets by moving them into the queue and sending
+  // A queue to recycle the previously-allocated occlusion result arrays. The
+  // game thread recycles the arrays by moving them into the queue and sending
   // them back to the render thread.
-  TQueue<
-      TSet<PrimitiveOcclusionResult, PrimitiveOcclusionResultKeyFuncs>,
-      EQueueMode::Spsc>
+  TQueue<TArray<PrimitiveOcclusionResult>, EQueueMode::Spsc>
       _recycledOcclusionResultSets;
 
+  // The scene proxies of the registered occlusion primitives, indexed by
+  // occlusion slot. Only these primitives' occlusion histories are
+  // aggregated, rather than those of every primitive in the scene.
+  TArray<const FPrimitiveSceneProxy*> _occlusionSlotProxies_renderThread;
+
+  // Occlusion slots that were released and can be reused.
+  TArray<int32> _freeOcclusionSlots;
+  int32 _occlusionSlotCount = 0;
+
   // The last known frame number. This is used to determine when an occlusion
   // results aggregation is complete.
   int64_t _frameNumber_renderThread = -1;
 
   std::atomic<bool> _isEnabled = false;
 
+  // Tests tile bounding boxes against each view's HZB, as an alternative to
+  // the occlusion queries of UCesiumBoundingVolumeComponent primitives.
+  CesiumHzbOcclusion _hzbOcclusion;
+
+  std::atomic<bool> _isHzbOcclusionEnabled = false;
+
+  // Reads the scene depth at the pixels that tilesets are picked at.
+  CesiumDepthPicking _depthPicking;
+
+  // Shades the points of tilesets with Eye-Dome Lighting enabled.
+  CesiumEyeDomeLighting _eyeDomeLighting;
+
 public:
   CesiumViewExtension(const FAutoRegister& autoRegister);
   ~CesiumViewExtension();
 
+  /**
+   * Gets the occlusion state of the primitive with the given ID, which must
+   * have been registered in the given occlusion slot. Must be called from the
+   * game thread.
+   */
   Cesium3DTilesSelection::TileOcclusionState getPrimitiveOcclusionState(
       const FPrimitiveComponentId& id,
+      int32 occlusionSlot,
       bool previouslyOccluded,
       float frameTimeCutoff) const;
 
+  /**
+   * Allocates an occlusion slot for a primitive whose occlusion state will be
+   * queried with getPrimitiveOcclusionState. Must be called from the game
+   * thread.
+   */
+  int32 AllocateOcclusionSlot();
+
+  /**
+   * Releases an occlusion slot so that it can be reused. Must be called from
+   * the game thread.
+   */
+  void ReleaseOcclusionSlot(int32 occlusionSlot);
+
+  /**
+   * Sets the scene proxy of the primitive in the given occlusion slot. Must be
+   * called from the render thread, when the proxy is added to the scene.
+   */
+  void SetOcclusionSlotProxy_RenderThread(
+      int32 occlusionSlot,
+      const FPrimitiveSceneProxy* pProxy);
+
+  /**
+   * Clears the scene proxy of the primitive in the given occlusion slot, if
+   * it's still the given one. Must be called from the render thread, when the
+   * proxy is removed from the scene.
+   */
+  void ClearOcclusionSlotProxy_RenderThread(
+      int32 occlusionSlot,
+      const FPrimitiveSceneProxy* pProxy);
+
   void SetupViewFamily(FSceneViewFamily& InViewFamily) override;
   void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
   void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
@@ -113,9 +158,29 @@ public:
   void PreRenderView_RenderThread(
       FRHICommandListImmediate& RHICmdList,
       FSceneView& InView) override;
+  void PostRenderBasePassDeferred_RenderThread(
+      FRDGBuilder& GraphBuilder,
+      FSceneView& InView,
+      const FRenderTargetBindingSlots& RenderTargets,
+      TRDGUniformBufferRef<FSceneTextureUniformParameters> SceneTextures)
+      override;
+  void PrePostProcessPass_RenderThread(
+      FRDGBuilder& GraphBuilder,
+      const FSceneView& View,
+      const FPostProcessingInputs& Inputs) override;
   void PostRenderViewFamily_RenderThread(
       FRHICommandListImmediate& RHICmdList,
       FSceneViewFamily& InViewFamily) override;
 
   void SetEnabled(bool enabled);
+
+  CesiumHzbOcclusion& GetHzbOcclusion() { return this->_hzbOcclusion; }
+
+  void SetHzbOcclusionEnabled(bool enabled);
+
+  CesiumDepthPicking& GetDepthPicking() { return this->_depthPicking; }
+
+  CesiumEyeDomeLighting& GetEyeDomeLighting() {
+    return this->_eyeDomeLighting;
+  }
 };
@@ -0,0 +1,180 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumWarmStartAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <optional>
+
+namespace {
+
+// Gets the scheme and host of a URL, such as "https://example.com", or the
+// whole URL if it doesn't have a host.
+std::string getOrigin(const std::string& url) {
+  const size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string::npos) {
+    return url;
+  }
+  const size_t hostEnd = url.find_first_of("/?#", schemeEnd + 3);
+  return url.substr(0, hostEnd);
+}
+
+// URLs with access tokens, such as the Cesium ion endpoint, aren't saved to
+// disk. They're only requested once each anyway.
+bool canRecord(const std::string& url) {
+  return url.find("access_token=") == std::string::npos &&
+         url.find('\n') == std::string::npos;
+}
+
+} // namespace
+
+CesiumWarmStartAssetAccessor::CesiumWarmStartAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    std::vector<std::string>&& urls)
+    : _pAssetAccessor(pAssetAccessor),
+      _recording(true),
+      _prefetchedRequestCount(0) {
+  if (urls.size() > MaximumUrls) {
+    urls.resize(MaximumUrls);
+  }
+  for (std::string& url : urls) {
+    if (canRecord(url)) {
+      this->_pendingUrls[getOrigin(url)].emplace_back(std::move(url));
+    }
+  }
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumWarmStartAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  std::vector<std::string> urlsToPrefetch;
+  std::optional<
+      CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>>
+      maybePrefetched;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_recording && this->_recordedUrls.size() < MaximumUrls &&
+        canRecord(url) && this->_recordedUrlSet.insert(url).second) {
+      this->_recordedUrls.emplace_back(url);
+    }
+
+    auto prefetchedIt = this->_prefetched.find(url);
+    if (prefetchedIt != this->_prefetched.end()) {
+      maybePrefetched = std::move(prefetchedIt->second);
+      this->_prefetched.erase(prefetchedIt);
+    }
+
+    // The first request to each host starts prefetching everything else
+    // from it, with its headers, which carry any authorization the host
+    // needs.
+    auto pendingIt = this->_pendingUrls.find(getOrigin(url));
+    if (pendingIt != this->_pendingUrls.end()) {
+      urlsToPrefetch = std::move(pendingIt->second);
+      this->_pendingUrls.erase(pendingIt);
+    }
+  }
+
+  if (!urlsToPrefetch.empty()) {
+    std::vector<std::pair<
+        std::string,
+        CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>>>
+        prefetched;
+    prefetched.reserve(urlsToPrefetch.size());
+    for (std::string& urlToPrefetch : urlsToPrefetch) {
+      if (urlToPrefetch == url) {
+        continue;
+      }
+      CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>
+          future =
+              this->_pAssetAccessor->get(asyncSystem, urlToPrefetch, headers)
+                  .share();
+      prefetched.emplace_back(std::move(urlToPrefetch), std::move(future));
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_recording) {
+      for (auto& entry : prefetched) {
+        this->_prefetched.emplace(std::move(entry.first), entry.second);
+      }
+    }
+  }
+
+  if (maybePrefetched) {
+    ++this->_prefetchedRequestCount;
+    return maybePrefetched->thenImmediately(
+        [](const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest) {
+          return pRequest;
+        });
+  }
+
+  return this->_pAssetAccessor->get(asyncSystem, url, headers);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumWarmStartAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumWarmStartAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+bool CesiumWarmStartAssetAccessor::isRecording() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_recording;
+}
+
+std::vector<std::string> CesiumWarmStartAssetAccessor::finishRecording() {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_recording = false;
+  this->_pendingUrls.clear();
+  this->_prefetched.clear();
+  this->_recordedUrlSet.clear();
+  return std::move(this->_recordedUrls);
+}
+
+int64_t CesiumWarmStartAssetAccessor::getPrefetchedRequestCount() const {
+  return this->_prefetchedRequestCount;
+}
+
+std::vector<std::string>
+CesiumWarmStartAssetAccessor::loadUrls(const FString& filename) {
+  TArray<FString> lines;
+  if (!FFileHelper::LoadFileToStringArray(lines, *filename)) {
+    return {};
+  }
+
+  std::vector<std::string> urls;
+  urls.reserve(size_t(lines.Num()));
+  for (const FString& line : lines) {
+    if (!line.IsEmpty()) {
+      urls.emplace_back(TCHAR_TO_UTF8(*line));
+    }
+  }
+  return urls;
+}
+
+bool CesiumWarmStartAssetAccessor::saveUrls(
+    const FString& filename,
+    const std::vector<std::string>& urls) {
+  IFileManager::Get().MakeDirectory(*FPaths::GetPath(filename), true);
+
+  TArray<FString> lines;
+  lines.Reserve(int32(urls.size()));
+  for (const std::string& url : urls) {
+    lines.Add(UTF8_TO_TCHAR(url.c_str()));
+  }
+  return FFileHelper::SaveStringArrayToFile(
+      lines,
+      *filename,
+      FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
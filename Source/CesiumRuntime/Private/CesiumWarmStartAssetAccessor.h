@@ -0,0 +1,110 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "Containers/UnrealString.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * An asset accessor that warm-starts loading a tileset from the URLs it
+ * requested the last time it was loaded, for ACesium3DTileset::EnableWarmStart.
+ *
+ * Tile selection refines a tileset level by level, so each tile isn't
+ * requested until its parent is loaded, and reaching full detail for a view
+ * takes one round trip per level. This accessor is given the URLs that were
+ * requested until the tileset last reached full detail. As soon as the tileset
+ * makes its first request to the host of some of those URLs, they are all
+ * requested at once, with the same headers, so that their responses are
+ * already on their way or have arrived by the time the tiles are requested.
+ *
+ * At the same time, it records the URLs that are requested, so that they can
+ * be given to it the next time the tileset is loaded.
+ */
+class CesiumWarmStartAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * The most URLs that are recorded and prefetched.
+   */
+  static constexpr size_t MaximumUrls = 4096;
+
+  /**
+   * @param pAssetAccessor The accessor that performs the requests.
+   * @param urls The URLs to prefetch.
+   */
+  CesiumWarmStartAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      std::vector<std::string>&& urls);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Whether URLs are still being recorded.
+   */
+  bool isRecording() const;
+
+  /**
+   * Stops recording URLs and forgets the prefetched responses that haven't
+   * been requested, once the tileset has reached full detail.
+   *
+   * @return The URLs that were requested, in the order they were first
+   * requested.
+   */
+  std::vector<std::string> finishRecording();
+
+  /**
+   * Gets the number of requests that were given a prefetched response.
+   */
+  int64_t getPrefetchedRequestCount() const;
+
+  /**
+   * Reads URLs saved with saveUrls, or returns none if the file doesn't
+   * exist.
+   */
+  static std::vector<std::string> loadUrls(const FString& filename);
+
+  /**
+   * Saves URLs to a file, one per line, creating its directory if necessary.
+   */
+  static bool
+  saveUrls(const FString& filename, const std::vector<std::string>& urls);
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+
+  mutable std::mutex _mutex;
+  // The URLs that haven't been prefetched yet, by their scheme and host.
+  std::unordered_map<std::string, std::vector<std::string>> _pendingUrls;
+  // The prefetched requests that haven't been requested by the tileset yet.
+  std::unordered_map<
+      std::string,
+      CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>>
+      _prefetched;
+  bool _recording;
+  std::vector<std::string> _recordedUrls;
+  std::unordered_set<std::string> _recordedUrlSet;
+
+  std::atomic<int64_t> _prefetchedRequestCount;
+};
@@ -0,0 +1,297 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumWebMapServiceMetatiles.h"
+#include "CesiumGeometry/QuadtreeTileID.h"
+#include "CesiumGeospatial/Projection.h"
+#include "CesiumRasterOverlays/QuadtreeRasterOverlayTileProvider.h"
+#include "CesiumUtility/Math.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+
+/**
+ * Copies the tile in the given column and row, counted from the top left, out
+ * of the image of a metatile that is the given number of tiles wide and high.
+ */
+LoadedRasterOverlayImage sliceMetatile(
+    const LoadedRasterOverlayImage& metatile,
+    const Rectangle& rectangle,
+    uint32_t column,
+    uint32_t row,
+    uint32_t columns,
+    uint32_t rows) {
+  LoadedRasterOverlayImage result;
+  result.rectangle = rectangle;
+  result.credits = metatile.credits;
+  result.errors = metatile.errors;
+  result.warnings = metatile.warnings;
+  result.moreDetailAvailable = metatile.moreDetailAvailable;
+
+  if (!metatile.image) {
+    return result;
+  }
+
+  const ImageCesium& source = *metatile.image;
+  const size_t pixelBytes =
+      size_t(source.channels) * size_t(source.bytesPerChannel);
+  if (source.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      !source.mipPositions.empty() || source.width <= 0 ||
+      source.height <= 0 || (source.width % columns) != 0 ||
+      (source.height % rows) != 0 ||
+      source.pixelData.size() <
+          size_t(source.width) * size_t(source.height) * pixelBytes) {
+    result.errors.emplace_back(
+        "The Web Map Service metatile image could not be divided into tiles.");
+    return result;
+  }
+
+  ImageCesium& image = result.image.emplace();
+  image.width = source.width / int32_t(columns);
+  image.height = source.height / int32_t(rows);
+  image.channels = source.channels;
+  image.bytesPerChannel = source.bytesPerChannel;
+
+  const size_t rowBytes = size_t(image.width) * pixelBytes;
+  const size_t sourceRowBytes = size_t(source.width) * pixelBytes;
+  image.pixelData.resize(rowBytes * size_t(image.height));
+  for (int32_t y = 0; y < image.height; ++y) {
+    const size_t sourceY = size_t(row) * size_t(image.height) + size_t(y);
+    std::memcpy(
+        &image.pixelData[size_t(y) * rowBytes],
+        &source.pixelData[sourceY * sourceRowBytes + size_t(column) * rowBytes],
+        rowBytes);
+  }
+
+  return result;
+}
+
+class MetatileTileProvider : public QuadtreeRasterOverlayTileProvider {
+public:
+  MetatileTileProvider(
+      const IntrusivePointer<const RasterOverlay>& pOwner,
+      const QuadtreeRasterOverlayTileProvider& tileProvider,
+      const std::string& getMapUrl,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      uint32_t metatileSize)
+      : QuadtreeRasterOverlayTileProvider(
+            pOwner,
+            tileProvider.getAsyncSystem(),
+            tileProvider.getAssetAccessor(),
+            tileProvider.getCredit(),
+            tileProvider.getPrepareRendererResources(),
+            tileProvider.getLogger(),
+            tileProvider.getProjection(),
+            tileProvider.getTilingScheme(),
+            tileProvider.getCoverageRectangle(),
+            tileProvider.getMinimumLevel(),
+            tileProvider.getMaximumLevel(),
+            tileProvider.getWidth(),
+            tileProvider.getHeight()),
+        _getMapUrl(getMapUrl),
+        _headers(headers),
+        _metatileSize(metatileSize),
+        _mutex(),
+        _metatiles() {}
+
+protected:
+  virtual Future<LoadedRasterOverlayImage>
+  loadQuadtreeTileImage(const QuadtreeTileID& tileID) const override {
+    const QuadtreeTilingScheme& tilingScheme = this->getTilingScheme();
+    const uint32_t size = this->_metatileSize;
+    const uint32_t firstX = tileID.x / size * size;
+    const uint32_t firstY = tileID.y / size * size;
+
+    // Metatiles at the edges of the tiling scheme are cut short.
+    const uint32_t columns = std::min(
+        size,
+        tilingScheme.getNumberOfXTilesAtLevel(tileID.level) - firstX);
+    const uint32_t rows = std::min(
+        size,
+        tilingScheme.getNumberOfYTilesAtLevel(tileID.level) - firstY);
+
+    // Tile Y coordinates increase to the north, while image rows start at
+    // the top.
+    const uint32_t column = tileID.x - firstX;
+    const uint32_t row = firstY + rows - 1 - tileID.y;
+
+    return this
+        ->getMetatile(
+            QuadtreeTileID(tileID.level, tileID.x / size, tileID.y / size),
+            firstX,
+            firstY,
+            columns,
+            rows)
+        .thenInWorkerThread(
+            [rectangle = tilingScheme.tileToRectangle(tileID),
+             column,
+             row,
+             columns,
+             rows](const LoadedRasterOverlayImage& metatile) {
+              return sliceMetatile(
+                  metatile,
+                  rectangle,
+                  column,
+                  row,
+                  columns,
+                  rows);
+            });
+  }
+
+private:
+  /**
+   * The number of recently requested metatiles to keep, so that the rest of
+   * their tiles, which are usually requested soon after, don't need to
+   * request or decode them again.
+   */
+  static constexpr size_t MaximumMetatiles = 8;
+
+  SharedFuture<LoadedRasterOverlayImage> getMetatile(
+      const QuadtreeTileID& metatileID,
+      uint32_t firstX,
+      uint32_t firstY,
+      uint32_t columns,
+      uint32_t rows) const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    for (const auto& metatile : this->_metatiles) {
+      if (metatile.first == metatileID) {
+        return metatile.second;
+      }
+    }
+
+    const QuadtreeTilingScheme& tilingScheme = this->getTilingScheme();
+    const Rectangle first = tilingScheme.tileToRectangle(
+        QuadtreeTileID(metatileID.level, firstX, firstY));
+    const Rectangle last = tilingScheme.tileToRectangle(QuadtreeTileID(
+        metatileID.level,
+        firstX + columns - 1,
+        firstY + rows - 1));
+
+    LoadTileImageFromUrlOptions options;
+    options.rectangle = Rectangle(
+        first.minimumX,
+        first.minimumY,
+        last.maximumX,
+        last.maximumY);
+    options.moreDetailAvailable = metatileID.level < this->getMaximumLevel();
+
+    // With the EPSG:4326 coordinate system, WMS 1.3.0 orders the bounding box
+    // by latitude, then longitude.
+    const CesiumGeospatial::GlobeRectangle globeRectangle =
+        CesiumGeospatial::unprojectRectangleSimple(
+            this->getProjection(),
+            options.rectangle);
+    const auto degrees = [](double radians) {
+      return std::to_string(Math::radiansToDegrees(radians));
+    };
+    const std::string url =
+        this->_getMapUrl +
+        "&width=" + std::to_string(this->getWidth() * columns) +
+        "&height=" + std::to_string(this->getHeight() * rows) +
+        "&bbox=" + degrees(globeRectangle.getSouth()) + "," +
+        degrees(globeRectangle.getWest()) + "," +
+        degrees(globeRectangle.getNorth()) + "," +
+        degrees(globeRectangle.getEast());
+
+    SharedFuture<LoadedRasterOverlayImage> result =
+        this->loadTileImageFromUrl(url, this->_headers, std::move(options))
+            .share();
+
+    if (this->_metatiles.size() >= MaximumMetatiles) {
+      this->_metatiles.erase(this->_metatiles.begin());
+    }
+    this->_metatiles.emplace_back(metatileID, result);
+    return result;
+  }
+
+  std::string _getMapUrl;
+  std::vector<IAssetAccessor::THeader> _headers;
+  uint32_t _metatileSize;
+
+  mutable std::mutex _mutex;
+  mutable std::vector<
+      std::pair<QuadtreeTileID, SharedFuture<LoadedRasterOverlayImage>>>
+      _metatiles;
+};
+
+} // namespace
+
+CesiumWebMapServiceMetatileRasterOverlay::
+    CesiumWebMapServiceMetatileRasterOverlay(
+        const std::string& name,
+        const std::string& url,
+        const std::vector<IAssetAccessor::THeader>& headers,
+        const WebMapServiceRasterOverlayOptions& wmsOptions,
+        const RasterOverlayOptions& overlayOptions,
+        int32_t metatileSize)
+    : CesiumCoalescingRasterOverlay(
+          name,
+          url,
+          headers,
+          wmsOptions,
+          overlayOptions),
+      _getMapUrl(
+          url + (url.find('?') == std::string::npos ? "?" : "&") +
+          "request=GetMap&TRANSPARENT=TRUE&version=" + wmsOptions.version +
+          "&service=WMS&format=" + wmsOptions.format +
+          "&styles=&layers=" + wmsOptions.layers + "&crs=EPSG:4326"),
+      _headers(headers),
+      _metatileSize(uint32_t(std::max(metatileSize, 1))) {}
+
+Future<RasterOverlay::CreateTileProviderResult>
+CesiumWebMapServiceMetatileRasterOverlay::createTileProvider(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CreditSystem>& pCreditSystem,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    IntrusivePointer<const RasterOverlay> pOwner) const {
+  if (!pOwner) {
+    pOwner = IntrusivePointer<const RasterOverlay>(this);
+  }
+
+  Future<CreateTileProviderResult> result =
+      CesiumCoalescingRasterOverlay::createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          pCreditSystem,
+          pPrepareRendererResources,
+          pLogger,
+          pOwner);
+  if (this->_metatileSize <= 1) {
+    return result;
+  }
+
+  // The tile provider created by WebMapServiceRasterOverlay, after checking
+  // the server's capabilities, is replaced by one that requests metatiles
+  // with the same tiling scheme.
+  return std::move(result).thenImmediately(
+      [pOwner,
+       getMapUrl = this->_getMapUrl,
+       headers = this->_headers,
+       metatileSize = this->_metatileSize](
+          CreateTileProviderResult&& created) -> CreateTileProviderResult {
+        if (!created) {
+          return std::move(created);
+        }
+
+        const QuadtreeRasterOverlayTileProvider& tileProvider =
+            static_cast<const QuadtreeRasterOverlayTileProvider&>(**created);
+        return IntrusivePointer<RasterOverlayTileProvider>(
+            new MetatileTileProvider(
+                pOwner,
+                tileProvider,
+                getMapUrl,
+                headers,
+                metatileSize));
+      });
+}
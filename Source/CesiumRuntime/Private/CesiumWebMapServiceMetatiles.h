@@ -0,0 +1,60 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCoalescingAssetAccessor.h"
+#include "CesiumRasterOverlays/WebMapServiceRasterOverlay.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A Web Map Service raster overlay that fetches blocks of its tiles, called
+ * metatiles, with a single GetMap request. Each tile of a metatile is sliced
+ * out of the metatile's image on a worker thread. For servers with a high
+ * overhead per request, this can load the overlay much more quickly than a
+ * request for every tile.
+ *
+ * The server's capabilities are checked, and the tiling scheme is set up, by
+ * the cesium-native WebMapServiceRasterOverlay that this derives from.
+ */
+class CesiumWebMapServiceMetatileRasterOverlay
+    : public CesiumCoalescingRasterOverlay<
+          CesiumRasterOverlays::WebMapServiceRasterOverlay> {
+public:
+  /**
+   * @param name The user-given name of this overlay layer.
+   * @param url The base URL of the Web Map Service.
+   * @param headers The headers to send with each request.
+   * @param wmsOptions The Web Map Service options.
+   * @param overlayOptions The raster overlay options.
+   * @param metatileSize The number of tiles along each side of a metatile.
+   * If this is 1 or less, tiles are fetched one at a time.
+   */
+  CesiumWebMapServiceMetatileRasterOverlay(
+      const std::string& name,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const CesiumRasterOverlays::WebMapServiceRasterOverlayOptions&
+          wmsOptions,
+      const CesiumRasterOverlays::RasterOverlayOptions& overlayOptions,
+      int32_t metatileSize);
+
+  virtual CesiumAsync::Future<
+      CesiumRasterOverlays::RasterOverlay::CreateTileProviderResult>
+  createTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<
+          CesiumRasterOverlays::IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumUtility::IntrusivePointer<const CesiumRasterOverlays::RasterOverlay>
+          pOwner) const override;
+
+private:
+  std::string _getMapUrl;
+  std::vector<CesiumAsync::IAssetAccessor::THeader> _headers;
+  uint32_t _metatileSize;
+};
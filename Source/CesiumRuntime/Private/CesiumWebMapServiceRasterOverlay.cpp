@@ -4,6 +4,7 @@
 #include "Algo/Transform.h"
 #include "CesiumRasterOverlays/WebMapServiceRasterOverlay.h"
 #include "CesiumRuntime.h"
+#include "CesiumWebMapServiceMetatiles.h"
 
 std::unique_ptr<CesiumRasterOverlays::RasterOverlay>
 UCesiumWebMapServiceRasterOverlay::CreateOverlay(
@@ -17,10 +18,11 @@ UCesiumWebMapServiceRasterOverlay::CreateOverlay(
   wmsOptions.layers = TCHAR_TO_UTF8(*Layers);
   wmsOptions.tileWidth = TileWidth;
   wmsOptions.tileHeight = TileHeight;
-  return std::make_unique<CesiumRasterOverlays::WebMapServiceRasterOverlay>(
+  return std::make_unique<CesiumWebMapServiceMetatileRasterOverlay>(
       TCHAR_TO_UTF8(*this->MaterialLayerKey),
       TCHAR_TO_UTF8(*this->BaseUrl),
       std::vector<CesiumAsync::IAssetAccessor::THeader>(),
       wmsOptions,
-      options);
+      options,
+      this->MetatileSize);
 }
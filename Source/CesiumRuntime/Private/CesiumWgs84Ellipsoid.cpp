@@ -1,10 +1,12 @@
 // Copyright 2020-2023 CesiumGS, Inc. and Contributors
 
 #include "CesiumWgs84Ellipsoid.h"
+#include "CesiumBatchTransforms.h"
 #include "VecMath.h"
 #include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGeospatial/GlobeTransforms.h>
 #include <CesiumUtility/Math.h>
+#include <glm/mat4x4.hpp>
 
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -63,6 +65,50 @@ FVector UCesiumWgs84Ellipsoid::EarthCenteredEarthFixedToLongitudeLatitudeHeight(
   }
 }
 
+TArray<FVector> UCesiumWgs84Ellipsoid::ScalePositionsToGeodeticSurface(
+    const TArray<FVector>& EarthCenteredEarthFixedPositions) {
+  TArray<FVector> result = EarthCenteredEarthFixedPositions;
+  CesiumBatchTransforms::scaleToGeodeticSurface(
+      Ellipsoid::WGS84,
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
+TArray<FVector> UCesiumWgs84Ellipsoid::GeodeticSurfaceNormals(
+    const TArray<FVector>& EarthCenteredEarthFixedPositions) {
+  TArray<FVector> result = EarthCenteredEarthFixedPositions;
+  CesiumBatchTransforms::computeGeodeticSurfaceNormals(
+      Ellipsoid::WGS84,
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
+TArray<FVector>
+UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightsToEarthCenteredEarthFixed(
+    const TArray<FVector>& LongitudeLatitudeHeights) {
+  TArray<FVector> result = LongitudeLatitudeHeights;
+  CesiumBatchTransforms::transformLongitudeLatitudeHeightPositions(
+      Ellipsoid::WGS84,
+      glm::dmat4(1.0),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
+TArray<FVector>
+UCesiumWgs84Ellipsoid::EarthCenteredEarthFixedToLongitudeLatitudeHeights(
+    const TArray<FVector>& EarthCenteredEarthFixedPositions) {
+  TArray<FVector> result = EarthCenteredEarthFixedPositions;
+  CesiumBatchTransforms::transformPositionsToLongitudeLatitudeHeight(
+      Ellipsoid::WGS84,
+      glm::dmat4(1.0),
+      CesiumBatchTransforms::asDVec3s(result),
+      CesiumBatchTransforms::asDVec3s(result));
+  return result;
+}
+
 FMatrix UCesiumWgs84Ellipsoid::EastNorthUpToEarthCenteredEarthFixed(
     const FVector& EarthCenteredEarthFixedPosition) {
   return VecMath::createMatrix(
@@ -0,0 +1,176 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumWorldLoadBudget.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntimeSettings.h"
+#include "CoreGlobals.h"
+#include "Engine/World.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+/**
+ * Distributes `total` between consumers with the given demands. Consumers
+ * that want less than an even share of what remains get all they want, and
+ * the rest is divided evenly between the others. Every consumer receives at
+ * least `minimum`, even if that means exceeding `total`.
+ */
+template <typename T>
+std::vector<T>
+fillDemands(const std::vector<T>& demands, T total, T minimum) {
+  std::vector<size_t> order(demands.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&demands](size_t a, size_t b) {
+    return demands[a] < demands[b];
+  });
+
+  std::vector<T> result(demands.size(), minimum);
+  T remaining = total;
+  for (size_t i = 0; i < order.size(); ++i) {
+    const T share = remaining / static_cast<T>(order.size() - i);
+    const T granted = std::max(minimum, std::min(demands[order[i]], share));
+    result[order[i]] = granted;
+    remaining = std::max(static_cast<T>(0), remaining - granted);
+  }
+
+  // Hand out whatever is left evenly, too, so that consumers that are
+  // currently getting everything they want still have room to grow.
+  if (!result.empty() && remaining > 0) {
+    const T extra = remaining / static_cast<T>(result.size());
+    for (T& value : result) {
+      value += extra;
+    }
+  }
+
+  return result;
+}
+} // namespace
+
+/*static*/ TMap<TObjectKey<UWorld>, CesiumWorldLoadBudget::WorldState>
+    CesiumWorldLoadBudget::_worlds{};
+
+/*static*/ CesiumWorldLoadBudget::Allocation
+CesiumWorldLoadBudget::getAllocation(
+    const UWorld* pWorld,
+    const ACesium3DTileset* pTileset,
+    const Allocation& limits) {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  const int32_t worldLoads = pSettings->MaximumSimultaneousTileLoadsPerWorld;
+  const int64_t worldBytes = pSettings->MaximumCachedBytesPerWorld;
+  if (worldLoads <= 0 && worldBytes <= 0) {
+    return limits;
+  }
+
+  WorldState& state = getCurrentState(pWorld);
+
+  Allocation result = limits;
+  const Allocation* pAllocation = state.allocations.Find(pTileset);
+  if (pAllocation) {
+    if (worldLoads > 0) {
+      result.maximumSimultaneousTileLoads = std::min(
+          limits.maximumSimultaneousTileLoads,
+          pAllocation->maximumSimultaneousTileLoads);
+    }
+    if (worldBytes > 0) {
+      result.maximumCachedBytes =
+          std::min(limits.maximumCachedBytes, pAllocation->maximumCachedBytes);
+    }
+  } else {
+    // A tileset that hasn't reported yet (e.g. it was just created) gets an
+    // even share until the next allocation round.
+    const int32_t count = state.allocations.Num() + 1;
+    if (worldLoads > 0) {
+      result.maximumSimultaneousTileLoads = std::min(
+          limits.maximumSimultaneousTileLoads,
+          std::max(worldLoads / count, 1));
+    }
+    if (worldBytes > 0) {
+      result.maximumCachedBytes =
+          std::min(limits.maximumCachedBytes, worldBytes / count);
+    }
+  }
+
+  return result;
+}
+
+/*static*/ void CesiumWorldLoadBudget::reportDemand(
+    const UWorld* pWorld,
+    const ACesium3DTileset* pTileset,
+    const Allocation& demand) {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (pSettings->MaximumSimultaneousTileLoadsPerWorld <= 0 &&
+      pSettings->MaximumCachedBytesPerWorld <= 0) {
+    return;
+  }
+
+  getCurrentState(pWorld).demands.Add(pTileset, demand);
+}
+
+/*static*/ CesiumWorldLoadBudget::WorldState&
+CesiumWorldLoadBudget::getCurrentState(const UWorld* pWorld) {
+  const uint64 frameNumber = GFrameCounter;
+  const TObjectKey<UWorld> key(pWorld);
+
+  WorldState* pState = _worlds.Find(key);
+  if (pState && pState->frameNumber == frameNumber) {
+    return *pState;
+  }
+
+  // Forget worlds that haven't been updated recently, such as ended PIE
+  // sessions.
+  for (auto it = _worlds.CreateIterator(); it; ++it) {
+    if (it.Value().frameNumber + 1 < frameNumber) {
+      it.RemoveCurrent();
+    }
+  }
+
+  WorldState& state = _worlds.FindOrAdd(key);
+  if (state.frameNumber + 1 == frameNumber) {
+    computeAllocations(state);
+  } else {
+    state.allocations.Empty();
+  }
+  state.demands.Empty();
+  state.frameNumber = frameNumber;
+  return state;
+}
+
+/*static*/ void CesiumWorldLoadBudget::computeAllocations(WorldState& state) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeWorldLoadBudget)
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+
+  std::vector<TObjectKey<ACesium3DTileset>> tilesets;
+  std::vector<int32_t> loadDemands;
+  std::vector<int64_t> byteDemands;
+  tilesets.reserve(state.demands.Num());
+  loadDemands.reserve(state.demands.Num());
+  byteDemands.reserve(state.demands.Num());
+
+  for (const auto& pair : state.demands) {
+    tilesets.push_back(pair.Key);
+    loadDemands.push_back(pair.Value.maximumSimultaneousTileLoads);
+    byteDemands.push_back(pair.Value.maximumCachedBytes);
+  }
+
+  // Every tileset may always load at least one tile at a time, so that none
+  // of them can be starved completely.
+  const std::vector<int32_t> loads = fillDemands<int32_t>(
+      loadDemands,
+      pSettings->MaximumSimultaneousTileLoadsPerWorld,
+      1);
+  const std::vector<int64_t> bytes = fillDemands<int64_t>(
+      byteDemands,
+      pSettings->MaximumCachedBytesPerWorld,
+      0);
+
+  state.allocations.Empty(int32(tilesets.size()));
+  for (size_t i = 0; i < tilesets.size(); ++i) {
+    state.allocations.Add(tilesets[i], Allocation{loads[i], bytes[i]});
+  }
+}
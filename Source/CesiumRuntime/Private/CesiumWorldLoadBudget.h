@@ -0,0 +1,61 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "UObject/ObjectKey.h"
+#include <cstdint>
+
+class ACesium3DTileset;
+class UWorld;
+
+/**
+ * Divides a single world-wide tile request budget and a single world-wide
+ * cache budget between all of the tilesets in a world, so that a level with
+ * many tilesets doesn't oversubscribe the network and memory by a factor of
+ * the number of tilesets.
+ *
+ * Each frame, every tileset reports how much it wants (bounded by its own
+ * per-actor limits), and the next frame's allocations are computed from those
+ * reports. Tilesets that want less than an even share leave the remainder
+ * for the others.
+ */
+class CesiumWorldLoadBudget {
+public:
+  struct Allocation {
+    int32_t maximumSimultaneousTileLoads;
+    int64_t maximumCachedBytes;
+  };
+
+  /**
+   * Gets the limits a tileset should use this frame. The `limits` are the
+   * tileset's own per-actor settings, which are never exceeded. When the
+   * corresponding world-wide limit in `UCesiumRuntimeSettings` is 0, the
+   * per-actor value is returned unchanged.
+   */
+  static Allocation getAllocation(
+      const UWorld* pWorld,
+      const ACesium3DTileset* pTileset,
+      const Allocation& limits);
+
+  /**
+   * Reports how many simultaneous loads and how many cached bytes a tileset
+   * could make use of, based on the outcome of its latest view update.
+   */
+  static void reportDemand(
+      const UWorld* pWorld,
+      const ACesium3DTileset* pTileset,
+      const Allocation& demand);
+
+private:
+  struct WorldState {
+    uint64 frameNumber = 0;
+    TMap<TObjectKey<ACesium3DTileset>, Allocation> demands;
+    TMap<TObjectKey<ACesium3DTileset>, Allocation> allocations;
+  };
+
+  static WorldState& getCurrentState(const UWorld* pWorld);
+  static void computeAllocations(WorldState& state);
+
+  static TMap<TObjectKey<UWorld>, WorldState> _worlds;
+};
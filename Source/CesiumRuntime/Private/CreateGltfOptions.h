@@ -8,6 +8,7 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumGltf/Node.h"
 #include "LoadGltfResult.h"
+#include <mutex>
 
 // TODO: internal documentation
 namespace CreateGltfOptions {
@@ -22,6 +23,87 @@ struct CreateModelOptions {
   const FMetadataDescription* pEncodedMetadataDescription_DEPRECATED = nullptr;
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
   bool alwaysIncludeTangents = false;
+  /**
+   * Whether to generate missing tangents on the shared vertices of the glTF
+   * instead of with MikkTSpace, which requires duplicated vertices.
+   */
+  bool useFastTangentGeneration = false;
+  /**
+   * Whether to compute smooth normals for primitives without them, with
+   * vertices at the same position welded together, instead of leaving them to
+   * be generated by Cesium Native.
+   */
+  bool weldSmoothNormals = false;
+  /**
+   * Whether to gather the triangles of primitives for the navigation system.
+   */
+  bool createNavCollision = false;
+  /**
+   * Whether to build a bounding volume hierarchy over the triangles of
+   * primitives, so that the tileset can sample heights from them.
+   */
+  bool enableHeightQueries = false;
+  /**
+   * Whether to keep a copy of the triangles of primitives, so that the tileset
+   * can bake them into static mesh assets.
+   */
+  bool keepMeshDataForBaking = false;
+  /**
+   * Whether primitives are only loaded for collision, navigation and height
+   * queries, such as on a dedicated server. Their textures, materials and
+   * vertex attributes other than positions aren't loaded, and they have no
+   * render resources.
+   */
+  bool collisionOnly = false;
+  /**
+   * Whether the tileset's material computes flat normals itself, so that
+   * primitives without normals don't need their vertices duplicated.
+   */
+  bool computeFlatNormalsInMaterial = false;
+  /**
+   * Whether to reorder the points of point primitives so that every prefix of
+   * them is spread evenly over the primitive.
+   */
+  bool orderPointsProgressively = false;
+  /**
+   * Whether the tileset's material computes raster overlay texture
+   * coordinates itself, so that they aren't copied to the vertices.
+   */
+  bool computeOverlayTextureCoordinatesInMaterial = false;
+  /**
+   * Whether to block compress uncompressed color textures as they're loaded.
+   */
+  bool compressTextures = false;
+  /**
+   * Whether to build Nanite meshes for opaque triangle primitives.
+   */
+  bool buildNaniteMeshes = false;
+  /**
+   * Whether to draw triangle primitives with vertex attributes pulled from
+   * their glTF buffer views, instead of converting them to static mesh
+   * vertices.
+   */
+  bool useVertexPulling = false;
+  /**
+   * Whether to pack the float attributes of pulled vertices into 16-bit
+   * positions and normals and half-precision texture coordinates.
+   */
+  bool packVertexAttributes = false;
+  /**
+   * Whether to share textures with other tiles that have identical images,
+   * found by hashing each image.
+   */
+  bool shareTexturesAcrossTiles = false;
+  /**
+   * Whether to stream the mips of textures, so that the tile's game thread
+   * part can skip uploading the ones that the tile can't use.
+   */
+  bool skipUnneededTextureMips = false;
+  /**
+   * Whether to merge the small primitives of the glTF that have the same
+   * material and vertex attributes into fewer primitives before loading it.
+   */
+  bool mergePrimitives = false;
   bool createPhysicsMeshes = true;
   bool ignoreKhrMaterialsUnlit = false;
 };
@@ -42,5 +124,18 @@ struct CreatePrimitiveOptions {
   const CreateMeshOptions* pMeshOptions = nullptr;
   const LoadGltfResult::LoadMeshResult* pHalfConstructedMeshResult = nullptr;
   const CesiumGltf::MeshPrimitive* pPrimitive = nullptr;
+  /**
+   * Guards access to the model's images, which may be shared by primitives
+   * that are loaded concurrently and are modified when textures are loaded
+   * (e.g. when generating mipmaps).
+   */
+  std::mutex* pTextureMutex = nullptr;
+  /**
+   * The textures that have already been loaded for other primitives of the
+   * model, keyed by texture index and how they're loaded. Guarded by
+   * pTextureMutex.
+   */
+  TMap<int64, TSharedPtr<CesiumTextureUtility::LoadedTextureResult>>*
+      pLoadedTextures = nullptr;
 };
 } // namespace CreateGltfOptions
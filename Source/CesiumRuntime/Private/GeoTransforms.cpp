@@ -2,6 +2,7 @@
 
 #include "GeoTransforms.h"
 
+#include "CesiumBatchTransforms.h"
 #include "CesiumGeospatial/GlobeTransforms.h"
 #include "CesiumRuntime.h"
 #include "CesiumTransforms.h"
@@ -13,6 +14,27 @@ using namespace CesiumGeospatial;
 
 namespace {
 
+/**
+ * Adds a translation by `-origin` after the given transform, for transforming
+ * into Unreal coordinates relative to the floating origin.
+ */
+glm::dmat4
+subtractOrigin(const glm::dmat4& toUnreal, const glm::dvec3& origin) {
+  glm::dmat4 result = toUnreal;
+  result[3] -= glm::dvec4(origin, 0.0);
+  return result;
+}
+
+/**
+ * Adds a translation by `origin` before the given transform, for transforming
+ * from Unreal coordinates relative to the floating origin.
+ */
+glm::dmat4 addOrigin(const glm::dmat4& fromUnreal, const glm::dvec3& origin) {
+  glm::dmat4 result = fromUnreal;
+  result[3] += fromUnreal * glm::dvec4(origin, 0.0);
+  return result;
+}
+
 LocalHorizontalCoordinateSystem createCoordinateSystem(
     const Ellipsoid& ellipsoid,
     const glm::dvec3& center,
@@ -175,6 +197,76 @@ glm::dvec3 GeoTransforms::TransformUnrealToEcef(
   return this->_coordinateSystem.localPositionToEcef(ue + origin);
 }
 
+void GeoTransforms::TransformLongitudeLatitudeHeightToEcef(
+    TArrayView<const glm::dvec3> longitudeLatitudeHeight,
+    TArrayView<glm::dvec3> output) const noexcept {
+  CesiumBatchTransforms::transformLongitudeLatitudeHeightPositions(
+      this->_ellipsoid,
+      glm::dmat4(1.0),
+      longitudeLatitudeHeight,
+      output);
+}
+
+void GeoTransforms::TransformEcefToLongitudeLatitudeHeight(
+    TArrayView<const glm::dvec3> ecef,
+    TArrayView<glm::dvec3> output) const noexcept {
+  CesiumBatchTransforms::transformPositionsToLongitudeLatitudeHeight(
+      this->_ellipsoid,
+      glm::dmat4(1.0),
+      ecef,
+      output);
+}
+
+void GeoTransforms::TransformLongitudeLatitudeHeightToUnreal(
+    const glm::dvec3& origin,
+    TArrayView<const glm::dvec3> longitudeLatitudeHeight,
+    TArrayView<glm::dvec3> output) const noexcept {
+  CesiumBatchTransforms::transformLongitudeLatitudeHeightPositions(
+      this->_ellipsoid,
+      subtractOrigin(
+          this->_coordinateSystem.getEcefToLocalTransformation(),
+          origin),
+      longitudeLatitudeHeight,
+      output);
+}
+
+void GeoTransforms::TransformUnrealToLongitudeLatitudeHeight(
+    const glm::dvec3& origin,
+    TArrayView<const glm::dvec3> ue,
+    TArrayView<glm::dvec3> output) const noexcept {
+  CesiumBatchTransforms::transformPositionsToLongitudeLatitudeHeight(
+      this->_ellipsoid,
+      addOrigin(
+          this->_coordinateSystem.getLocalToEcefTransformation(),
+          origin),
+      ue,
+      output);
+}
+
+void GeoTransforms::TransformEcefToUnreal(
+    const glm::dvec3& origin,
+    TArrayView<const glm::dvec3> ecef,
+    TArrayView<glm::dvec3> output) const noexcept {
+  CesiumBatchTransforms::transformPositions(
+      subtractOrigin(
+          this->_coordinateSystem.getEcefToLocalTransformation(),
+          origin),
+      ecef,
+      output);
+}
+
+void GeoTransforms::TransformUnrealToEcef(
+    const glm::dvec3& origin,
+    TArrayView<const glm::dvec3> ue,
+    TArrayView<glm::dvec3> output) const noexcept {
+  CesiumBatchTransforms::transformPositions(
+      addOrigin(
+          this->_coordinateSystem.getLocalToEcefTransformation(),
+          origin),
+      ue,
+      output);
+}
+
 glm::dquat GeoTransforms::TransformRotatorUnrealToEastSouthUp(
     const glm::dvec3& origin,
     const glm::dquat& UERotator,
@@ -3,15 +3,21 @@
 #pragma once
 
 #include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumMaterialKey.h"
 #include "CesiumGltf/Material.h"
 #include "CesiumGltf/MeshPrimitive.h"
 #include "CesiumGltf/Model.h"
 #include "CesiumMetadataPrimitive.h"
+#include "CesiumBakingGeometry.h"
+#include "CesiumNavigationGeometry.h"
 #include "CesiumModelMetadata.h"
+#include "CesiumPointAttenuationVertexFactory.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumPrimitiveMetadata.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTriangleBvh.h"
+#include "CesiumVertexPullingVertexFactory.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
 #include "Containers/Map.h"
 #include "Containers/UnrealString.h"
@@ -39,6 +45,22 @@ struct LoadPrimitiveResult {
    */
   TUniquePtr<FStaticMeshRenderData> RenderData = nullptr;
 
+  /**
+   * The quantized positions and normals of a point cloud, if it's drawn by
+   * FCesiumPointAttenuationVertexFactory. This is given to the points
+   * component created on the main thread.
+   */
+  TSharedPtr<FCesiumQuantizedPointsVertexBuffer, ESPMode::ThreadSafe>
+      QuantizedPoints = nullptr;
+
+  /**
+   * The vertex attributes of a triangle primitive, copied from its glTF
+   * buffer views, if it's drawn by FCesiumVertexPullingVertexFactory. This is
+   * given to the primitive component created on the main thread.
+   */
+  TSharedPtr<FCesiumGltfAttributeBuffer, ESPMode::ThreadSafe>
+      PulledAttributes = nullptr;
+
   /**
    * A pointer to the glTF material.
    */
@@ -46,16 +68,39 @@ struct LoadPrimitiveResult {
   glm::dmat4x4 transform{1.0};
   TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
       pCollisionMesh = nullptr;
+  /**
+   * The triangles to export to the navigation system, if the tileset creates
+   * navigation collision.
+   */
+  TSharedPtr<const CesiumNavigationGeometry, ESPMode::ThreadSafe>
+      NavigationGeometry = nullptr;
+  /**
+   * The hierarchy over the primitive's triangles to sample heights from, if
+   * the tileset enables height queries.
+   */
+  TSharedPtr<const CesiumTriangleBvh, ESPMode::ThreadSafe> HeightQueryBvh =
+      nullptr;
+  /**
+   * The triangles to bake into a static mesh asset, if the tileset is being
+   * baked.
+   */
+  TSharedPtr<const CesiumBakingGeometry, ESPMode::ThreadSafe> BakingGeometry =
+      nullptr;
   std::string name{};
 
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> baseColorTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult>
+  // The loaded textures may be shared by several primitives of the model.
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> baseColorTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult>
       metallicRoughnessTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> normalTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> emissiveTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> occlusionTexture;
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> waterMaskTexture;
-  std::unordered_map<std::string, uint32_t> textureCoordinateParameters;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> normalTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> emissiveTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> occlusionTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> waterMaskTexture;
+  /**
+   * A map of glTF texture coordinate index parameter names to their
+   * corresponding texture coordinate indices in the Unreal mesh.
+   */
+  TMap<FName, uint32_t> textureCoordinateParameters;
   /**
    * A map of feature ID set names to their corresponding texture coordinate
    * indices in the Unreal mesh.
@@ -64,6 +109,12 @@ struct LoadPrimitiveResult {
 
   bool isUnlit = false;
 
+  /**
+   * Whether this primitive was loaded with CreateModelOptions::collisionOnly,
+   * so its render data only holds its bounds and it has no material.
+   */
+  bool collisionOnly = false;
+
   bool onlyLand = true;
   bool onlyWater = false;
 
@@ -71,6 +122,12 @@ struct LoadPrimitiveResult {
   double waterMaskTranslationY = 0.0;
   double waterMaskScale = 1.0;
 
+  /**
+   * The choice of base material and the material parameter values that
+   * don't depend on textures, computed while the primitive is loaded.
+   */
+  CesiumMaterialKey materialKey{};
+
   /**
    * The dimensions of the primitive. Passed to a CesiumGltfPointsComponent for
    * use in computing attenuation.
@@ -148,6 +205,13 @@ struct LoadMeshResult {
  */
 struct LoadNodeResult {
   std::optional<LoadMeshResult> meshResult = std::nullopt;
+
+  /**
+   * The transforms of the instances of the node's mesh, from its
+   * EXT_mesh_gpu_instancing extension, relative to the node. This is empty if
+   * the node isn't instanced.
+   */
+  TArray<FTransform> instanceTransforms{};
 };
 
 /**
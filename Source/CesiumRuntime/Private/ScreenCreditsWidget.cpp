@@ -6,11 +6,15 @@
 #include "Engine/Font.h"
 #include "Engine/Texture2D.h"
 #include "Framework/Application/SlateApplication.h"
+#include "CesiumMainThreadDispatcher.h"
+#include "CesiumRuntime.h"
 #include "HttpModule.h"
-#include "ImageUtils.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Math/UnrealMathUtility.h"
 #include "Misc/Base64.h"
+#include "Modules/ModuleManager.h"
 #include "Rendering/DrawElements.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Slate/SlateGameResources.h"
@@ -20,6 +24,7 @@
 #include "Widgets/Input/SRichTextHyperlink.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/SCompoundWidget.h"
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -212,19 +217,105 @@ void UScreenCreditsWidget::HandleImageRequest(
     FHttpResponsePtr HttpResponse,
     bool bSucceeded,
     int32 id) {
-  UTexture2D* texture = nullptr;
   if (bSucceeded && HttpResponse.IsValid() &&
-      HttpResponse->GetContentLength() > 0 &&
-      (texture = FImageUtils::ImportBufferAsTexture2D(
-           HttpResponse->GetContent())) != nullptr) {
-    texture->SRGB = true;
-    texture->UpdateResource();
-    _textures.Add(texture);
-    FTexturePlatformData* pPlatformData = texture->GetPlatformData();
-    int32 SizeX = pPlatformData->SizeX;
-    int32 SizeY = pPlatformData->SizeY;
-    _creditImages[id] = new FSlateImageBrush(texture, FVector2D(SizeX, SizeY));
+      HttpResponse->GetContentLength() > 0) {
+    this->DecodeImageAsync(id, TArray<uint8>(HttpResponse->GetContent()));
+  } else {
+    this->FinishImageLoad();
+  }
+}
+
+namespace {
+struct DecodedCreditImage {
+  TArray64<uint8> bgra;
+  int32 width = 0;
+  int32 height = 0;
+};
+
+std::optional<DecodedCreditImage> decodeCreditImage(
+    IImageWrapperModule& imageWrapperModule,
+    const TArray<uint8>& encodedImage) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DecodeCreditImage)
+
+  const EImageFormat format = imageWrapperModule.DetectImageFormat(
+      encodedImage.GetData(),
+      encodedImage.Num());
+  if (format == EImageFormat::Invalid) {
+    return std::nullopt;
+  }
+
+  TSharedPtr<IImageWrapper> pImageWrapper =
+      imageWrapperModule.CreateImageWrapper(format);
+  DecodedCreditImage result;
+  if (!pImageWrapper ||
+      !pImageWrapper->SetCompressed(
+          encodedImage.GetData(),
+          encodedImage.Num()) ||
+      !pImageWrapper->GetRaw(ERGBFormat::BGRA, 8, result.bgra)) {
+    return std::nullopt;
   }
+
+  result.width = int32(pImageWrapper->GetWidth());
+  result.height = int32(pImageWrapper->GetHeight());
+  return result;
+}
+} // namespace
+
+void UScreenCreditsWidget::DecodeImageAsync(
+    int32 id,
+    TArray<uint8>&& encodedImage) {
+  // The module must be loaded on the game thread, but decoding with it is
+  // safe on any thread.
+  IImageWrapperModule& imageWrapperModule =
+      FModuleManager::LoadModuleChecked<IImageWrapperModule>(
+          FName("ImageWrapper"));
+
+  getAsyncSystem()
+      .runInWorkerThread([&imageWrapperModule,
+                          encodedImage = MoveTemp(encodedImage)]() {
+        return decodeCreditImage(imageWrapperModule, encodedImage);
+      })
+      .thenInMainThread(
+          [pWeakThis = TWeakObjectPtr<UScreenCreditsWidget>(this),
+           id](std::optional<DecodedCreditImage>&& image) mutable {
+            CesiumMainThreadDispatcher::get().post(
+                CesiumMainThreadDispatcher::Priority::Low,
+                [pWeakThis, id, image = std::move(image)]() {
+                  UScreenCreditsWidget* pThis = pWeakThis.Get();
+                  if (!pThis) {
+                    return;
+                  }
+
+                  if (image && image->width > 0 && image->height > 0) {
+                    UTexture2D* texture = UTexture2D::CreateTransient(
+                        image->width,
+                        image->height,
+                        PF_B8G8R8A8);
+                    if (texture) {
+                      texture->SRGB = true;
+                      FTexture2DMipMap& mip =
+                          texture->GetPlatformData()->Mips[0];
+                      void* pData = mip.BulkData.Lock(LOCK_READ_WRITE);
+                      FMemory::Memcpy(
+                          pData,
+                          image->bgra.GetData(),
+                          image->bgra.Num());
+                      mip.BulkData.Unlock();
+                      texture->UpdateResource();
+
+                      pThis->_textures.Add(texture);
+                      pThis->_creditImages[id] = new FSlateImageBrush(
+                          texture,
+                          FVector2D(image->width, image->height));
+                    }
+                  }
+
+                  pThis->FinishImageLoad();
+                });
+          });
+}
+
+void UScreenCreditsWidget::FinishImageLoad() {
   // Only update credits after all of the images are done loading.
   --_numImagesLoading;
   if (_numImagesLoading == 0) {
@@ -233,44 +324,45 @@ void UScreenCreditsWidget::HandleImageRequest(
 }
 
 std::string UScreenCreditsWidget::LoadImage(const std::string& url) {
+  // Every image is decoded in a worker thread, so its brush is only filled
+  // in once it's ready. The credits are shown when all of them are.
+  ++_numImagesLoading;
+  _creditImages.AddDefaulted();
+  const int32 id = _creditImages.Num() - 1;
+
   const std::string base64Prefix = "data:image/png;base64,";
   if (url.rfind(base64Prefix, 0) == 0) {
     TArray<uint8> dataBuffer;
     FString base64 = UTF8_TO_TCHAR(url.c_str() + base64Prefix.length());
     if (FBase64::Decode(base64, dataBuffer)) {
-      UTexture2D* texture = FImageUtils::ImportBufferAsTexture2D(dataBuffer);
-      texture->SRGB = true;
-      texture->UpdateResource();
-      _textures.Add(texture);
-      FTexturePlatformData* pPlatformData = texture->GetPlatformData();
-      int32 SizeX = pPlatformData->SizeX;
-      int32 SizeY = pPlatformData->SizeY;
-      _creditImages.Add(new FSlateImageBrush(texture, FVector2D(SizeX, SizeY)));
+      this->DecodeImageAsync(id, MoveTemp(dataBuffer));
+    } else {
+      this->FinishImageLoad();
     }
   } else {
-    ++_numImagesLoading;
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest =
         FHttpModule::Get().CreateRequest();
 
-    _creditImages.AddDefaulted();
     HttpRequest->OnProcessRequestComplete().BindUObject(
         this,
         &UScreenCreditsWidget::HandleImageRequest,
-        _creditImages.Num() - 1);
+        id);
 
     HttpRequest->SetURL(UTF8_TO_TCHAR(url.c_str()));
     HttpRequest->SetVerb(TEXT("GET"));
     HttpRequest->ProcessRequest();
   }
-  return std::to_string(_creditImages.Num() - 1);
+  return std::to_string(id);
 }
 
 void UScreenCreditsWidget::SetCredits(
     const FString& InCredits,
     const FString& InOnScreenCredits) {
+  // Keep the latest credits, so that they can be shown again once images
+  // that are still loading are ready.
+  _credits = InCredits;
+  _onScreenCredits = InOnScreenCredits;
   if (_numImagesLoading != 0) {
-    _credits = InCredits;
-    _onScreenCredits = InOnScreenCredits;
     return;
   }
   if (RichTextPopup) {
@@ -37,6 +37,13 @@ private:
       bool bSucceeded,
       int32 id);
 
+  /**
+   * Decodes the image with the given ID from the encoded data in a worker
+   * thread, then creates its texture and brush on the game thread.
+   */
+  void DecodeImageAsync(int32 id, TArray<uint8>&& encodedImage);
+  void FinishImageLoad();
+
   UPROPERTY(meta = (BindWidget))
   class URichTextBlock* RichTextOnScreen;
 
@@ -0,0 +1,125 @@
+#include "CesiumBandwidthLimiter.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestFixtures.h"
+#include "Misc/AutomationTest.h"
+
+using CesiumTestHelpers::TestAssetAccessor;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumBandwidthLimiterSpec,
+    "Cesium.Unit.BandwidthLimiter",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+TUniquePtr<CesiumBandwidthLimiter> pLimiter;
+
+// The bytes the tests' link can carry each second.
+static constexpr double BytesPerSecond = 1000.0;
+
+// Schedules a request that records the bytes charged for it once it starts.
+std::shared_ptr<int64_t> Schedule(uint64_t stream) {
+  std::shared_ptr<int64_t> pCharged = std::make_shared<int64_t>(-1);
+  pLimiter->schedule(stream, [pCharged](int64_t chargedBytes) {
+    *pCharged = chargedBytes;
+  });
+  return pCharged;
+}
+END_DEFINE_SPEC(FCesiumBandwidthLimiterSpec)
+
+void FCesiumBandwidthLimiterSpec::Define() {
+  BeforeEach([this]() { pLimiter = MakeUnique<CesiumBandwidthLimiter>(); });
+
+  AfterEach([this]() { pLimiter.Reset(); });
+
+  It("starts requests right away when the bandwidth isn't limited", [this]() {
+    const uint64_t stream =
+        pLimiter->createStream(ECesiumRequestPriority::Background, 1.0);
+    pLimiter->update(1.0f, 0.0);
+
+    TestEqual("started", *Schedule(stream), int64_t(0));
+    TestEqual("waiting", pLimiter->getWaitingRequestCount(), 0);
+  });
+
+  It("holds back requests until their stream has bandwidth", [this]() {
+    const uint64_t stream =
+        pLimiter->createStream(ECesiumRequestPriority::Normal, 1.0);
+    pLimiter->update(0.0f, BytesPerSecond);
+
+    std::shared_ptr<int64_t> pFirst = Schedule(stream);
+    std::shared_ptr<int64_t> pSecond = Schedule(stream);
+    TestEqual("both waiting", pLimiter->getWaitingRequestCount(), 2);
+
+    pLimiter->update(0.1f, BytesPerSecond);
+    TestEqual(
+        "first started",
+        *pFirst,
+        CesiumBandwidthLimiter::InitialRequestBytes);
+    TestEqual("second waiting", *pSecond, int64_t(-1));
+
+    // The first response was much smaller than expected, which leaves
+    // bandwidth for the second request.
+    pLimiter->complete(stream, *pFirst, 50);
+    TestTrue("second started", *pSecond > 0);
+    TestEqual("none waiting", pLimiter->getWaitingRequestCount(), 0);
+    TestEqual("deferred", pLimiter->getDeferredRequestCount(), int64_t(2));
+  });
+
+  It("hands bandwidth to higher priorities first", [this]() {
+    const uint64_t background =
+        pLimiter->createStream(ECesiumRequestPriority::Background, 1.0);
+    const uint64_t high =
+        pLimiter->createStream(ECesiumRequestPriority::High, 1.0);
+    pLimiter->update(0.0f, BytesPerSecond);
+
+    std::shared_ptr<int64_t> pBackground = Schedule(background);
+    std::shared_ptr<int64_t> pHigh = Schedule(high);
+    pLimiter->update(1.0f, BytesPerSecond);
+    TestTrue("high started", *pHigh > 0);
+    TestEqual("background waiting", *pBackground, int64_t(-1));
+
+    // Once the stream of higher priority has nothing waiting, the bandwidth
+    // goes to the stream of lower priority.
+    pLimiter->update(1.0f, BytesPerSecond);
+    TestTrue("background started", *pBackground > 0);
+  });
+
+  It("never holds back critical requests", [this]() {
+    const uint64_t stream =
+        pLimiter->createStream(ECesiumRequestPriority::Critical, 1.0);
+    pLimiter->update(0.0f, BytesPerSecond);
+
+    TestTrue("started", *Schedule(stream) > 0);
+    TestTrue("started again", *Schedule(stream) > 0);
+    TestEqual("waiting", pLimiter->getWaitingRequestCount(), 0);
+  });
+
+  It("starts the waiting requests of a released stream", [this]() {
+    const uint64_t stream =
+        pLimiter->createStream(ECesiumRequestPriority::Normal, 1.0);
+    pLimiter->update(0.0f, BytesPerSecond);
+
+    std::shared_ptr<int64_t> pCharged = Schedule(stream);
+    pLimiter->releaseStream(stream);
+    TestEqual("started", *pCharged, int64_t(0));
+    TestEqual("waiting", pLimiter->getWaitingRequestCount(), 0);
+  });
+
+  It("removes the stream pseudo-header before requests are made", [this]() {
+    std::shared_ptr<TestAssetAccessor> pRecording =
+        std::make_shared<TestAssetAccessor>();
+    pRecording->finishImmediately = true;
+    const uint64_t stream =
+        pLimiter->createStream(ECesiumRequestPriority::Normal, 1.0);
+    CesiumBandwidthStreamAssetAccessor streamAccessor(
+        std::make_shared<CesiumBandwidthAssetAccessor>(pRecording, *pLimiter),
+        stream);
+
+    streamAccessor.get(getAsyncSystem(), "a", {{"Accept", "*/*"}});
+    TestEqual("made", pRecording->requestCount, 1);
+    const CesiumAsync::HttpHeaders headers = pRecording->getLastHeaders();
+    TestTrue("other headers", headers.count("Accept") > 0);
+    TestFalse(
+        "stream header",
+        headers.count(CesiumBandwidthLimiter::streamHeader) > 0);
+  });
+}
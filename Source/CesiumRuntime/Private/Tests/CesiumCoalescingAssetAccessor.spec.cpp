@@ -0,0 +1,105 @@
+#include "CesiumCoalescingAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRequestCancellation.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestFixtures.h"
+#include "Misc/AutomationTest.h"
+#include <optional>
+
+using CesiumTestHelpers::RequestFuture;
+using CesiumTestHelpers::TestAssetAccessor;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCoalescingAssetAccessorSpec,
+    "Cesium.Unit.CoalescingAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<TestAssetAccessor> pPending;
+std::optional<CesiumCoalescingAssetAccessor> coalescing;
+
+int32 CountCompleted(std::vector<RequestFuture>&& futures) {
+  int32 completed = 0;
+  for (auto& future : futures) {
+    std::move(future).thenImmediately(
+        [&completed](std::shared_ptr<CesiumAsync::IAssetRequest>&&) {
+          ++completed;
+        });
+  }
+  return completed;
+}
+END_DEFINE_SPEC(FCesiumCoalescingAssetAccessorSpec)
+
+void FCesiumCoalescingAssetAccessorSpec::Define() {
+  BeforeEach([this]() {
+    pPending = std::make_shared<TestAssetAccessor>();
+    coalescing.emplace(pPending);
+  });
+
+  AfterEach([this]() {
+    coalescing.reset();
+    pPending.reset();
+  });
+
+  It("shares a request for the same URL while it is in flight", [this]() {
+    std::vector<RequestFuture> futures;
+    futures.emplace_back(coalescing->get(getAsyncSystem(), "a", {}));
+    futures.emplace_back(coalescing->get(getAsyncSystem(), "a", {}));
+    TestEqual("requests", pPending->requestCount, 1);
+    TestEqual("coalesced", coalescing->getCoalescedRequestCount(), int64(1));
+
+    pPending->finishAll();
+    TestEqual("completed", CountCompleted(std::move(futures)), 2);
+  });
+
+  It("makes a new request once the last one has finished", [this]() {
+    RequestFuture first = coalescing->get(getAsyncSystem(), "a", {});
+    pPending->finishAll();
+    RequestFuture second = coalescing->get(getAsyncSystem(), "a", {});
+    TestEqual("requests", pPending->requestCount, 2);
+    pPending->finishAll();
+  });
+
+  It("does not share requests with different URLs or headers", [this]() {
+    coalescing->get(getAsyncSystem(), "a", {});
+    coalescing->get(getAsyncSystem(), "b", {});
+    coalescing->get(getAsyncSystem(), "a", {{"Accept", "image/png"}});
+    TestEqual("requests", pPending->requestCount, 3);
+    TestEqual("coalesced", coalescing->getCoalescedRequestCount(), int64(0));
+    pPending->finishAll();
+  });
+
+  It("only shares requests across request groups if asked to", [this]() {
+    const std::vector<CesiumAsync::IAssetAccessor::THeader> first{
+        {CesiumRequestCancellation::groupHeader, "1"}};
+    const std::vector<CesiumAsync::IAssetAccessor::THeader> second{
+        {CesiumRequestCancellation::groupHeader, "2"}};
+
+    coalescing->get(getAsyncSystem(), "a", first);
+    coalescing->get(getAsyncSystem(), "a", second);
+    TestEqual("requests", pPending->requestCount, 2);
+    pPending->finishAll();
+
+    CesiumCoalescingAssetAccessor shared(pPending, true);
+    std::vector<RequestFuture> futures;
+    futures.emplace_back(shared.get(getAsyncSystem(), "a", first));
+    futures.emplace_back(shared.get(getAsyncSystem(), "a", second));
+    TestEqual("shared requests", pPending->requestCount, 3);
+    TestEqual("coalesced", shared.getCoalescedRequestCount(), int64(1));
+
+    pPending->finishAll();
+    TestEqual("completed", CountCompleted(std::move(futures)), 2);
+  });
+
+  It("makes a shared request again if it fails", [this]() {
+    std::vector<RequestFuture> futures;
+    futures.emplace_back(coalescing->get(getAsyncSystem(), "a", {}));
+    futures.emplace_back(coalescing->get(getAsyncSystem(), "a", {}));
+    TestEqual("requests", pPending->requestCount, 1);
+
+    pPending->failAll();
+    TestEqual("retried", pPending->requestCount, 2);
+
+    pPending->finishAll();
+    TestEqual("completed", CountCompleted(std::move(futures)), 1);
+  });
+}
@@ -0,0 +1,117 @@
+#include "CesiumContentDecoding.h"
+#include "Misc/AutomationTest.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumContentDecodingSpec,
+    "Cesium.Unit.ContentDecoding",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+void appendUint32(std::vector<std::byte>& bytes, uint32 value) {
+  const size_t offset = bytes.size();
+  bytes.resize(offset + sizeof(value));
+  std::memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+void appendText(std::vector<std::byte>& bytes, const std::string& text) {
+  for (char c : text) {
+    bytes.push_back(std::byte(c));
+  }
+}
+
+std::vector<std::byte> createGlb(const std::string& json) {
+  std::vector<std::byte> glb;
+  appendText(glb, "glTF");
+  appendUint32(glb, 2);
+  appendUint32(glb, uint32(20 + json.size()));
+  appendUint32(glb, uint32(json.size()));
+  appendText(glb, "JSON");
+  appendText(glb, json);
+  return glb;
+}
+
+std::vector<std::byte> createB3dm(const std::vector<std::byte>& glb) {
+  std::vector<std::byte> b3dm;
+  appendText(b3dm, "b3dm");
+  appendUint32(b3dm, 1);
+  appendUint32(b3dm, uint32(28 + glb.size()));
+  for (int32 i = 0; i < 4; ++i) {
+    appendUint32(b3dm, 0);
+  }
+  b3dm.insert(b3dm.end(), glb.begin(), glb.end());
+  return b3dm;
+}
+END_DEFINE_SPEC(FCesiumContentDecodingSpec)
+
+void FCesiumContentDecodingSpec::Define() {
+  Describe("detectCodecs", [this]() {
+    It("finds the codecs in the extensions of binary glTF", [this]() {
+      const std::vector<std::byte> glb = createGlb(
+          R"({"extensionsUsed":["KHR_draco_mesh_compression",)"
+          R"("KHR_texture_basisu"]})");
+      TestEqual(
+          "codecs",
+          CesiumContentDecoding::detectCodecs(glb),
+          uint8(CesiumContentDecoding::Draco | CesiumContentDecoding::Ktx2));
+    });
+
+    It("finds the codecs of the glTF in a Batched 3D Model", [this]() {
+      const std::vector<std::byte> b3dm = createB3dm(
+          createGlb(R"({"extensionsUsed":["EXT_meshopt_compression"]})"));
+      TestEqual(
+          "codecs",
+          CesiumContentDecoding::detectCodecs(b3dm),
+          uint8(CesiumContentDecoding::Meshopt));
+    });
+
+    It("finds no codecs in uncompressed glTF", [this]() {
+      const std::vector<std::byte> glb =
+          createGlb(R"({"asset":{"version":"2.0"}})");
+      TestEqual("codecs", CesiumContentDecoding::detectCodecs(glb), uint8(0));
+    });
+
+    It("ignores content that isn't binary glTF", [this]() {
+      std::vector<std::byte> content;
+      appendText(content, R"({"KHR_draco_mesh_compression":true})");
+      TestEqual(
+          "codecs",
+          CesiumContentDecoding::detectCodecs(content),
+          uint8(0));
+    });
+
+    It("ignores a JSON chunk longer than the content", [this]() {
+      std::vector<std::byte> glb =
+          createGlb(R"({"extensionsUsed":["KHR_draco_mesh_compression"]})");
+      glb.resize(glb.size() - 4);
+      TestEqual("codecs", CesiumContentDecoding::detectCodecs(glb), uint8(0));
+    });
+  });
+
+  It("counts the decoding time toward each codec", [this]() {
+    const CesiumContentDecoding::Statistics draco =
+        CesiumContentDecoding::getStatistics(CesiumContentDecoding::Draco);
+    const CesiumContentDecoding::Statistics meshopt =
+        CesiumContentDecoding::getStatistics(CesiumContentDecoding::Meshopt);
+
+    const std::vector<std::byte> glb =
+        createGlb(R"({"extensionsUsed":["KHR_draco_mesh_compression"]})");
+    const int32 result =
+        CesiumContentDecoding::decode(glb, []() { return 42; });
+    TestEqual("result", result, 42);
+
+    TestEqual(
+        "draco",
+        CesiumContentDecoding::getStatistics(CesiumContentDecoding::Draco)
+            .count,
+        draco.count + 1);
+    TestEqual(
+        "meshopt",
+        CesiumContentDecoding::getStatistics(CesiumContentDecoding::Meshopt)
+            .count,
+        meshopt.count);
+    TestEqual("active", CesiumContentDecoding::getActiveCount(), 0);
+  });
+}
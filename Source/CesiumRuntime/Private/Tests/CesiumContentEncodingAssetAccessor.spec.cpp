@@ -0,0 +1,298 @@
+#include "CesiumContentEncodingAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Compression.h"
+#include <algorithm>
+
+namespace {
+
+class TestAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  TestAssetResponse(
+      CesiumAsync::HttpHeaders&& headers,
+      std::vector<std::byte>&& data)
+      : _headers(std::move(headers)), _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return 200; }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data);
+  }
+
+private:
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class TestAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  TestAssetRequest(
+      const std::string& url,
+      CesiumAsync::HttpHeaders&& headers,
+      TestAssetResponse&& response)
+      : _url(url),
+        _headers(std::move(headers)),
+        _response(std::move(response)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method = "GET";
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  TestAssetResponse _response;
+};
+
+/**
+ * Responds to every request with the same body and Content-Encoding, and
+ * keeps the headers of the last request.
+ */
+class EncodedAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override {
+    this->lastHeaders = CesiumAsync::HttpHeaders(headers.begin(), headers.end());
+    CesiumAsync::HttpHeaders responseHeaders;
+    if (!this->contentEncoding.empty()) {
+      responseHeaders.emplace("Content-Encoding", this->contentEncoding);
+    }
+    return asyncSystem.createResolvedFuture<
+        std::shared_ptr<CesiumAsync::IAssetRequest>>(
+        std::make_shared<TestAssetRequest>(
+            url,
+            CesiumAsync::HttpHeaders(this->lastHeaders),
+            TestAssetResponse(
+                std::move(responseHeaders),
+                std::vector<std::byte>(this->body))));
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  std::string contentEncoding;
+  std::vector<std::byte> body;
+  CesiumAsync::HttpHeaders lastHeaders;
+};
+
+std::vector<std::byte> toBytes(const std::string& s) {
+  const std::byte* pBegin = reinterpret_cast<const std::byte*>(s.data());
+  return std::vector<std::byte>(pBegin, pBegin + s.size());
+}
+
+std::string toString(const gsl::span<const std::byte>& data) {
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+std::vector<std::byte> compressGzip(const std::vector<std::byte>& data) {
+  int32 compressedSize =
+      FCompression::CompressMemoryBound(NAME_Gzip, int32(data.size()));
+  std::vector<std::byte> compressed(size_t(compressedSize));
+  FCompression::CompressMemory(
+      NAME_Gzip,
+      compressed.data(),
+      compressedSize,
+      data.data(),
+      int32(data.size()));
+  compressed.resize(size_t(compressedSize));
+  return compressed;
+}
+
+// A stand-in for an encoding that a project links a decoder for.
+bool decodeReversed(
+    const gsl::span<const std::byte>& encoded,
+    std::vector<std::byte>& decoded) {
+  decoded.assign(encoded.rbegin(), encoded.rend());
+  return true;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumContentEncodingAssetAccessorSpec,
+    "Cesium.Unit.ContentEncodingAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<EncodedAssetAccessor> pEncoded;
+
+std::shared_ptr<CesiumAsync::IAssetRequest>
+Get(const std::string& acceptEncoding) {
+  CesiumContentEncodingAssetAccessor accessor(pEncoded, acceptEncoding);
+  std::shared_ptr<CesiumAsync::IAssetRequest> pResult;
+  bool done = false;
+  accessor.get(getAsyncSystem(), "a", {})
+      .thenInMainThread(
+          [&](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            pResult = std::move(pRequest);
+            done = true;
+          });
+  while (!done) {
+    getAsyncSystem().dispatchMainThreadTasks();
+  }
+  return pResult;
+}
+END_DEFINE_SPEC(FCesiumContentEncodingAssetAccessorSpec)
+
+void FCesiumContentEncodingAssetAccessorSpec::Define() {
+  BeforeEach([this]() {
+    pEncoded = std::make_shared<EncodedAssetAccessor>();
+    CesiumContentEncodingAssetAccessor::registerDecoder(
+        "x-reversed",
+        decodeReversed);
+  });
+
+  AfterEach([this]() { pEncoded.reset(); });
+
+  It("only asks for encodings that can be decoded", [this]() {
+    TestEqual(
+        "filtered",
+        CesiumContentEncodingAssetAccessor::filterAcceptEncoding(
+            "x-unknown, GZIP;q=0.8, x-reversed"),
+        std::string("gzip;q=0.8, x-reversed"));
+    TestEqual(
+        "none",
+        CesiumContentEncodingAssetAccessor::filterAcceptEncoding("x-unknown"),
+        std::string());
+  });
+
+  It("sends the Accept-Encoding header", [this]() {
+    Get("x-unknown, x-reversed");
+    auto it = pEncoded->lastHeaders.find("Accept-Encoding");
+    TestTrue("sent", it != pEncoded->lastHeaders.end());
+    if (it != pEncoded->lastHeaders.end()) {
+      TestEqual("value", it->second, std::string("x-reversed"));
+    }
+
+    Get("x-unknown");
+    TestTrue(
+        "not sent",
+        pEncoded->lastHeaders.find("Accept-Encoding") ==
+            pEncoded->lastHeaders.end());
+  });
+
+  It("decodes gzip", [this]() {
+    const std::string text = "Some text that is compressed.";
+    TestEqual(
+        "decoded",
+        CesiumContentEncodingAssetAccessor::decode(
+            "gzip",
+            compressGzip(toBytes(text)))
+            .value_or(std::vector<std::byte>()),
+        toBytes(text));
+  });
+
+  It("decodes gzip that is much larger than it was encoded", [this]() {
+    const std::vector<std::byte> zeros(4 * 1024 * 1024, std::byte(0));
+    TestTrue(
+        "decoded",
+        CesiumContentEncodingAssetAccessor::decode("gzip", compressGzip(zeros))
+            .value_or(std::vector<std::byte>()) == zeros);
+  });
+
+  It("decodes concatenated gzip members", [this]() {
+    std::vector<std::byte> encoded = compressGzip(toBytes("Some text "));
+    const std::vector<std::byte> second =
+        compressGzip(toBytes("in two parts."));
+    encoded.insert(encoded.end(), second.begin(), second.end());
+    TestEqual(
+        "decoded",
+        CesiumContentEncodingAssetAccessor::decode("gzip", encoded)
+            .value_or(std::vector<std::byte>()),
+        toBytes("Some text in two parts."));
+  });
+
+  It("doesn't decode truncated gzip", [this]() {
+    std::vector<std::byte> encoded =
+        compressGzip(toBytes("Some text that is compressed."));
+    encoded.resize(encoded.size() - 6);
+    TestFalse(
+        "decoded",
+        CesiumContentEncodingAssetAccessor::decode("gzip", encoded)
+            .has_value());
+  });
+
+  It("decodes encodings in the reverse of the order they're listed",
+     [this]() {
+       const std::string text = "Some text that is compressed.";
+       std::vector<std::byte> reversed = toBytes(text);
+       std::reverse(reversed.begin(), reversed.end());
+       TestEqual(
+           "decoded",
+           CesiumContentEncodingAssetAccessor::decode(
+               "x-reversed, gzip",
+               compressGzip(reversed))
+               .value_or(std::vector<std::byte>()),
+           toBytes(text));
+     });
+
+  It("decodes responses and removes their Content-Encoding", [this]() {
+    pEncoded->contentEncoding = "x-reversed";
+    pEncoded->body = toBytes("dedoced");
+    const int64 encodedBefore =
+        CesiumContentEncodingAssetAccessor::getTotalEncodedBytes();
+
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest = Get("");
+    const CesiumAsync::IAssetResponse* pResponse =
+        pRequest ? pRequest->response() : nullptr;
+    TestNotNull("response", pResponse);
+    if (!pResponse) {
+      return;
+    }
+
+    TestEqual("data", toString(pResponse->data()), std::string("decoded"));
+    TestTrue(
+        "no Content-Encoding",
+        pResponse->headers().find("Content-Encoding") ==
+            pResponse->headers().end());
+    TestEqual(
+        "encoded bytes",
+        CesiumContentEncodingAssetAccessor::getTotalEncodedBytes() -
+            encodedBefore,
+        int64(7));
+  });
+
+  It("passes on responses that aren't encoded as they say", [this]() {
+    pEncoded->contentEncoding = "gzip";
+    pEncoded->body = toBytes("already decoded");
+
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest = Get("");
+    const CesiumAsync::IAssetResponse* pResponse =
+        pRequest ? pRequest->response() : nullptr;
+    TestNotNull("response", pResponse);
+    if (pResponse) {
+      TestEqual(
+          "data",
+          toString(pResponse->data()),
+          std::string("already decoded"));
+    }
+  });
+}
@@ -0,0 +1,97 @@
+#include "CesiumDecodedContentCache.h"
+#include "CesiumGltfReader/GltfReader.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+namespace {
+
+CesiumGltf::Model createModel(size_t bufferBytes) {
+  CesiumGltf::Model model;
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(bufferBytes, std::byte(7));
+  buffer.byteLength = int64_t(bufferBytes);
+  return model;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumDecodedContentCacheSpec,
+    "Cesium.Unit.DecodedContentCache",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumDecodedContentCacheSpec)
+
+void FCesiumDecodedContentCacheSpec::Define() {
+  BeforeEach([]() { CesiumDecodedContentCache::get().clear(); });
+  AfterEach([]() { CesiumDecodedContentCache::get().clear(); });
+
+  It("identifies content by its bytes and reader options", [this]() {
+    const std::vector<std::byte> content(64, std::byte(1));
+    std::vector<std::byte> otherContent = content;
+    otherContent.back() = std::byte(2);
+
+    CesiumGltfReader::GltfReaderOptions options;
+    CesiumGltfReader::GltfReaderOptions otherOptions;
+    otherOptions.decodeDraco = !options.decodeDraco;
+
+    const uint64_t key = CesiumDecodedContentCache::getKey(content, options);
+    TestEqual(
+        "same",
+        CesiumDecodedContentCache::getKey(content, options),
+        key);
+    TestNotEqual(
+        "other content",
+        CesiumDecodedContentCache::getKey(otherContent, options),
+        key);
+    TestNotEqual(
+        "other options",
+        CesiumDecodedContentCache::getKey(content, otherOptions),
+        key);
+  });
+
+  It("returns a copy of a model that was added", [this]() {
+    CesiumDecodedContentCache& cache = CesiumDecodedContentCache::get();
+    TestFalse("find before", cache.find(1).has_value());
+
+    cache.add(1, createModel(100), 1 << 20);
+    std::optional<CesiumGltf::Model> found = cache.find(1);
+    if (!TestTrue("find", found.has_value())) {
+      return;
+    }
+    TestEqual("buffers", found->buffers.size(), size_t(1));
+    TestEqual("bytes", found->buffers[0].cesium.data.size(), size_t(100));
+
+    // Changing the copy doesn't change the cached model.
+    found->buffers.clear();
+    TestEqual("buffers again", cache.find(1)->buffers.size(), size_t(1));
+  });
+
+  It("removes the least recently used models when it's full", [this]() {
+    CesiumDecodedContentCache& cache = CesiumDecodedContentCache::get();
+    const int64_t modelBytes =
+        CesiumDecodedContentCache::getModelBytes(createModel(1000));
+    const int64_t maximumBytes = modelBytes * 4;
+
+    cache.add(1, createModel(1000), maximumBytes);
+    cache.add(2, createModel(1000), maximumBytes);
+    cache.add(3, createModel(1000), maximumBytes);
+    cache.add(4, createModel(1000), maximumBytes);
+
+    // Using the first model makes the second the least recently used.
+    TestTrue("find first", cache.find(1).has_value());
+    cache.add(5, createModel(1000), maximumBytes);
+
+    TestTrue("first", cache.find(1).has_value());
+    TestFalse("second", cache.find(2).has_value());
+    TestTrue("fifth", cache.find(5).has_value());
+    TestTrue("size", cache.getBytes() <= maximumBytes);
+  });
+
+  It("doesn't add a model larger than a quarter of the maximum", [this]() {
+    CesiumDecodedContentCache& cache = CesiumDecodedContentCache::get();
+    cache.add(1, createModel(1000), 1000);
+    TestFalse("find", cache.find(1).has_value());
+    TestEqual("size", cache.getBytes(), int64_t(0));
+  });
+}
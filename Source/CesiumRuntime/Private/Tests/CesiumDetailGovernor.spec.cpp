@@ -0,0 +1,67 @@
+#include "CesiumDetailGovernor.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumDetailGovernorSpec,
+    "Cesium.Unit.DetailGovernor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+const CesiumDetailGovernor::Targets targets{0.016, 1000, 4.0};
+END_DEFINE_SPEC(FCesiumDetailGovernorSpec)
+
+void FCesiumDetailGovernorSpec::Define() {
+  It("raises the scale while the frame time is over the target", [this]() {
+    CesiumDetailGovernor governor;
+    for (int32 i = 0; i < 200; ++i) {
+      governor.update(this->targets, 0.030, 0, 0.1);
+    }
+    TestEqual("scale", governor.getScreenSpaceErrorScale(), 4.0);
+    TestEqual("load scale", governor.getLoadScale(), 0.25);
+  });
+
+  It("raises the scale while memory is over the limit", [this]() {
+    CesiumDetailGovernor governor;
+    for (int32 i = 0; i < 20; ++i) {
+      governor.update(this->targets, 0.005, 2000, 0.1);
+    }
+    TestTrue("scale", governor.getScreenSpaceErrorScale() > 1.0);
+  });
+
+  It("waits between changes", [this]() {
+    CesiumDetailGovernor governor;
+    TestFalse("first", governor.update(this->targets, 0.030, 0, 0.5));
+    TestTrue("second", governor.update(this->targets, 0.030, 0, 0.5));
+    TestFalse("third", governor.update(this->targets, 0.030, 0, 0.5));
+  });
+
+  It("holds the scale near the target", [this]() {
+    CesiumDetailGovernor governor;
+    for (int32 i = 0; i < 20; ++i) {
+      governor.update(this->targets, 0.030, 0, 0.1);
+    }
+
+    // Let the average settle between the lower threshold and the target,
+    // after which nothing changes.
+    for (int32 i = 0; i < 50; ++i) {
+      governor.update(this->targets, 0.015, 0, 0.1);
+    }
+    const double scale = governor.getScreenSpaceErrorScale();
+    TestTrue("raised", scale > 1.0);
+
+    for (int32 i = 0; i < 200; ++i) {
+      TestFalse("changed", governor.update(this->targets, 0.015, 0, 0.1));
+    }
+    TestEqual("scale", governor.getScreenSpaceErrorScale(), scale);
+  });
+
+  It("lowers the scale once both targets are met", [this]() {
+    CesiumDetailGovernor governor;
+    for (int32 i = 0; i < 20; ++i) {
+      governor.update(this->targets, 0.030, 0, 0.1);
+    }
+    for (int32 i = 0; i < 200; ++i) {
+      governor.update(this->targets, 0.005, 100, 0.1);
+    }
+    TestEqual("scale", governor.getScreenSpaceErrorScale(), 1.0);
+  });
+}
@@ -272,6 +272,121 @@ void FCesiumFeatureIdTextureSpec::Define() {
     });
   });
 
+  Describe("GetFeatureIDsForUVs", [this]() {
+    BeforeEach([this]() {
+      model = Model();
+      Mesh& mesh = model.meshes.emplace_back();
+      pPrimitive = &mesh.primitives.emplace_back();
+    });
+
+    It("returns -1 for invalid texture", [this]() {
+      CesiumGltf::Texture& gltfTexture = model.textures.emplace_back();
+      gltfTexture.source = -1;
+
+      FeatureIdTexture texture;
+      texture.index = 0;
+      texture.texCoord = 0;
+      texture.channels = {0};
+
+      FCesiumFeatureIdTexture featureIDTexture(
+          model,
+          *pPrimitive,
+          texture,
+          "PropertyTableName");
+
+      const TArray<int64> featureIDs =
+          UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDsForUVs(
+              featureIDTexture,
+              {FVector2D(0, 0), FVector2D(0.5, 0.5)});
+      TestEqual("number of feature IDs", featureIDs.Num(), 2);
+      for (int64 featureID : featureIDs) {
+        TestEqual("FeatureID", featureID, -1);
+      }
+      TestFalse(
+          "decoded image",
+          UCesiumFeatureIdTextureBlueprintLibrary::GetDecodedImage(
+              featureIDTexture)
+              .IsValid());
+    });
+
+    It("returns the same values as GetFeatureIDForUV", [this]() {
+      const std::vector<uint8_t> featureIDs{0, 3, 1, 2};
+
+      FeatureId& featureId = AddFeatureIDsAsTextureToModel(
+          model,
+          *pPrimitive,
+          featureIDs,
+          4,
+          2,
+          2,
+          texCoords,
+          0);
+
+      FCesiumFeatureIdTexture featureIDTexture(
+          model,
+          *pPrimitive,
+          *featureId.texture,
+          "PropertyTableName");
+
+      TArray<FVector2D> uvs;
+      for (const glm::vec2& texCoord : texCoords) {
+        uvs.Emplace(texCoord[0], texCoord[1]);
+      }
+      uvs.Emplace(0.99, 0.99);
+      uvs.Emplace(1.0, 1.0);
+
+      const TArray<int64> values =
+          UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDsForUVs(
+              featureIDTexture,
+              uvs);
+      if (!TestEqual("number of feature IDs", values.Num(), uvs.Num())) {
+        return;
+      }
+
+      for (int32 i = 0; i < uvs.Num(); i++) {
+        TestEqual(
+            "FeatureID",
+            values[i],
+            UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDForUV(
+                featureIDTexture,
+                uvs[i]));
+      }
+    });
+
+    It("shares the decoded image between copies", [this]() {
+      const std::vector<uint8_t> featureIDs{0, 3, 1, 2};
+
+      FeatureId& featureId = AddFeatureIDsAsTextureToModel(
+          model,
+          *pPrimitive,
+          featureIDs,
+          4,
+          2,
+          2,
+          texCoords,
+          0);
+
+      FCesiumFeatureIdTexture featureIDTexture(
+          model,
+          *pPrimitive,
+          *featureId.texture,
+          "PropertyTableName");
+      FCesiumFeatureIdTexture copy = featureIDTexture;
+
+      auto pImage = UCesiumFeatureIdTextureBlueprintLibrary::GetDecodedImage(
+          featureIDTexture);
+      if (!TestTrue("decoded image", pImage.IsValid())) {
+        return;
+      }
+      TestEqual("width", pImage->GetWidth(), 2);
+      TestEqual("height", pImage->GetHeight(), 2);
+      TestTrue(
+          "copy shares image",
+          UCesiumFeatureIdTextureBlueprintLibrary::GetDecodedImage(copy) ==
+              pImage);
+    });
+  });
+
   Describe("GetFeatureIDForVertex", [this]() {
     BeforeEach([this]() {
       model = Model();
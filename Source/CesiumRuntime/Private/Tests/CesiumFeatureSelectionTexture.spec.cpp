@@ -0,0 +1,54 @@
+#include "CesiumFeatureSelectionTexture.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumFeatureSelectionTextureSpec,
+    "Cesium.Unit.FeatureSelectionTexture",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumFeatureSelectionTextureSpec)
+
+void FCesiumFeatureSelectionTextureSpec::Define() {
+  Describe("getSize", [this]() {
+    It("rounds small selections up to a power of two wide", [this]() {
+      TestEqual(
+          "one",
+          CesiumFeatureSelectionTexture::getSize(1),
+          FIntPoint(1, 1));
+      TestEqual(
+          "five",
+          CesiumFeatureSelectionTexture::getSize(5),
+          FIntPoint(8, 1));
+      TestEqual(
+          "maximum width",
+          CesiumFeatureSelectionTexture::getSize(
+              CesiumFeatureSelectionTexture::MaximumWidth),
+          FIntPoint(CesiumFeatureSelectionTexture::MaximumWidth, 1));
+    });
+
+    It("wraps large selections into rows", [this]() {
+      const int32 width = CesiumFeatureSelectionTexture::MaximumWidth;
+      TestEqual(
+          "one more than the maximum width",
+          CesiumFeatureSelectionTexture::getSize(width + 1),
+          FIntPoint(width, 2));
+      TestEqual(
+          "rounded up rows",
+          CesiumFeatureSelectionTexture::getSize(2 * width + 1),
+          FIntPoint(width, 4));
+    });
+
+    It("limits the number of features", [this]() {
+      const int32 width = CesiumFeatureSelectionTexture::MaximumWidth;
+      TestEqual(
+          "too many",
+          CesiumFeatureSelectionTexture::getSize(
+              CesiumFeatureSelectionTexture::MaximumFeatureCount * 2),
+          FIntPoint(width, width));
+      TestEqual(
+          "none",
+          CesiumFeatureSelectionTexture::getSize(0),
+          FIntPoint(1, 1));
+    });
+  });
+}
@@ -0,0 +1,134 @@
+#include "CesiumFeatureStyle.h"
+#include "CesiumFeatureStyleTexture.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "Misc/AutomationTest.h"
+
+namespace {
+
+FCesiumPropertyTablePropertyDescription
+makeProperty(const FString& name, bool encoded) {
+  FCesiumPropertyTablePropertyDescription property;
+  property.Name = name;
+  if (encoded) {
+    property.EncodingDetails = FCesiumMetadataEncodingDetails(
+        ECesiumEncodedMetadataType::Scalar,
+        ECesiumEncodedMetadataComponentType::Float,
+        ECesiumEncodedMetadataConversion::Coerce);
+  }
+  return property;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumFeatureStyleSpec,
+    "Cesium.Unit.FeatureStyle",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+TArray<FCesiumPropertyTableDescription> propertyTables;
+END_DEFINE_SPEC(FCesiumFeatureStyleSpec)
+
+void FCesiumFeatureStyleSpec::Define() {
+  BeforeEach([this]() {
+    FCesiumPropertyTableDescription buildings;
+    buildings.Name = "buildings";
+    buildings.Properties.Add(makeProperty("height", true));
+    buildings.Properties.Add(makeProperty("name", false));
+    buildings.Properties.Add(makeProperty("year", true));
+
+    FCesiumPropertyTableDescription roads;
+    roads.Name = "roads";
+    roads.Properties.Add(makeProperty("lanes", true));
+
+    propertyTables = {buildings, roads};
+  });
+
+  Describe("getPropertyIndex", [this]() {
+    It("counts the encoded properties of every table", [this]() {
+      TestEqual(
+          "height",
+          CesiumFeatureStyleTexture::getPropertyIndex(
+              propertyTables,
+              "buildings",
+              "height"),
+          0);
+      TestEqual(
+          "year",
+          CesiumFeatureStyleTexture::getPropertyIndex(
+              propertyTables,
+              "buildings",
+              "year"),
+          1);
+      TestEqual(
+          "lanes",
+          CesiumFeatureStyleTexture::getPropertyIndex(
+              propertyTables,
+              "roads",
+              "lanes"),
+          2);
+    });
+
+    It("returns -1 for properties that aren't encoded", [this]() {
+      TestEqual(
+          "unencoded",
+          CesiumFeatureStyleTexture::getPropertyIndex(
+              propertyTables,
+              "buildings",
+              "name"),
+          -1);
+      TestEqual(
+          "other table",
+          CesiumFeatureStyleTexture::getPropertyIndex(
+              propertyTables,
+              "roads",
+              "height"),
+          -1);
+    });
+  });
+
+  Describe("encode", [this]() {
+    It("encodes the conditions after the header", [this]() {
+      FCesiumFeatureStyle style;
+      style.DefaultColor = FLinearColor(0.5f, 0.5f, 0.5f);
+      style.bDefaultShow = false;
+      FCesiumFeatureStyleCondition& condition =
+          style.Conditions.Emplace_GetRef();
+      condition.Minimum = 10.0;
+      condition.Maximum = 20.0;
+      condition.Color = FLinearColor::Red;
+
+      TArray<FVector4f> encoded = CesiumFeatureStyleTexture::encode(style, 2);
+      if (!TestEqual(
+              "width",
+              encoded.Num(),
+              CesiumFeatureStyleTexture::Width)) {
+        return;
+      }
+      TestTrue("header", encoded[0] == FVector4f(2.0f, 1.0f, 0.0f, 0.0f));
+      TestTrue("default", encoded[1] == FVector4f(0.5f, 0.5f, 0.5f, 0.0f));
+      TestTrue("range", encoded[2] == FVector4f(10.0f, 20.0f, 0.0f, 0.0f));
+      TestTrue("color", encoded[3] == FVector4f(1.0f, 0.0f, 0.0f, 1.0f));
+    });
+
+    It("limits the number of conditions", [this]() {
+      FCesiumFeatureStyle style;
+      style.Conditions.SetNum(CesiumFeatureStyleTexture::MaximumConditions + 4);
+
+      TArray<FVector4f> encoded = CesiumFeatureStyleTexture::encode(style, 0);
+      TestEqual(
+          "count",
+          encoded[0].Y,
+          float(CesiumFeatureStyleTexture::MaximumConditions));
+      TestEqual("width", encoded.Num(), CesiumFeatureStyleTexture::Width);
+    });
+
+    It("leaves features unstyled without a property", [this]() {
+      FCesiumFeatureStyle style;
+      style.Conditions.SetNum(3);
+
+      TArray<FVector4f> encoded = CesiumFeatureStyleTexture::encode(style, -1);
+      TestEqual("property", encoded[0].X, -1.0f);
+      TestEqual("count", encoded[0].Y, 0.0f);
+    });
+  });
+}
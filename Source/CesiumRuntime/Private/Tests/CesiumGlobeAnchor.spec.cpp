@@ -68,6 +68,49 @@ void FCesiumGlobeAnchorSpec::Define() {
         beforeLLH);
   });
 
+  It("maintains globe position when the georeference origin changes",
+     [this]() {
+       AActor* pOtherActor = this->pActor->GetWorld()->SpawnActor<AActor>();
+       pOtherActor->AddComponentByClass(
+           USceneComponent::StaticClass(),
+           false,
+           FTransform::Identity,
+           false);
+       pOtherActor->SetActorRelativeTransform(
+           FTransform(FVector(1000.0, 2000.0, 3000.0)));
+       UCesiumGlobeAnchorComponent* pOtherGlobeAnchor =
+           Cast<UCesiumGlobeAnchorComponent>(pOtherActor->AddComponentByClass(
+               UCesiumGlobeAnchorComponent::StaticClass(),
+               false,
+               FTransform::Identity,
+               false));
+
+       FTransform beforeTransform = this->pActor->GetActorTransform();
+       FTransform otherBeforeTransform = pOtherActor->GetActorTransform();
+       FVector beforeLLH = this->pGlobeAnchor->GetLongitudeLatitudeHeight();
+       FVector otherBeforeLLH = pOtherGlobeAnchor->GetLongitudeLatitudeHeight();
+
+       this->pGlobeAnchor->ResolveGeoreference()
+           ->SetOriginLongitudeLatitudeHeight(FVector(10.0, 20.0, 30.0));
+
+       TestFalse(
+           "Transforms are equal",
+           this->pActor->GetActorTransform().Equals(beforeTransform));
+       TestFalse(
+           "Other transforms are equal",
+           pOtherActor->GetActorTransform().Equals(otherBeforeTransform));
+       TestEqual(
+           "Globe Position",
+           this->pGlobeAnchor->GetLongitudeLatitudeHeight(),
+           beforeLLH);
+       TestEqual(
+           "Other Globe Position",
+           pOtherGlobeAnchor->GetLongitudeLatitudeHeight(),
+           otherBeforeLLH);
+
+       pOtherActor->Destroy();
+     });
+
   It("updates actor transform when globe anchor position is changed", [this]() {
     FTransform beforeTransform = this->pActor->GetActorTransform();
     this->pGlobeAnchor->MoveToLongitudeLatitudeHeight(FVector(4.0, 5.0, 6.0));
@@ -0,0 +1,341 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumRuntime.h"
+#include "CreateGltfOptions.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include <algorithm>
+#include <vector>
+
+using namespace CesiumGltf;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumGltfConversionBenchmark,
+    "Cesium.Performance.GltfConversion",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+// The vertex attributes, besides positions, of a benchmark model.
+struct GridAttributes {
+  bool normals = false;
+  bool texCoords = false;
+  bool colors = false;
+  bool featureIdsAndMetadata = false;
+};
+
+// The indices of two triangles for each square of a grid of vertices.
+template <typename T> std::vector<T> createGridIndices(int32 size) {
+  std::vector<T> indices;
+  indices.reserve((size - 1) * (size - 1) * 6);
+  for (int32 y = 0; y < size - 1; ++y) {
+    for (int32 x = 0; x < size - 1; ++x) {
+      const T topLeft = T(y * size + x);
+      const T topRight = T(topLeft + 1);
+      const T bottomLeft = T(topLeft + size);
+      const T bottomRight = T(bottomLeft + 1);
+      indices.insert(
+          indices.end(),
+          {topLeft, bottomLeft, topRight, topRight, bottomLeft, bottomRight});
+    }
+  }
+  return indices;
+}
+
+/**
+ * Creates a model with a single primitive, which is a grid of the given
+ * number of vertices across and the given attributes. The indices are 16-bit
+ * when there are few enough vertices, like most glTF exporters write them.
+ */
+Model createGridModel(int32 size, const GridAttributes& attributes) {
+  Model model;
+  model.scenes.emplace_back().nodes.push_back(0);
+  model.scene = 0;
+  model.nodes.emplace_back().mesh = 0;
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+
+  const int32 vertexCount = size * size;
+  std::vector<glm::vec3> positions(vertexCount);
+  std::vector<glm::vec3> normals(vertexCount);
+  std::vector<glm::vec2> texCoords(vertexCount);
+  std::vector<glm::vec4> colors(vertexCount);
+  std::vector<uint8_t> featureIds(vertexCount);
+  for (int32 y = 0; y < size; ++y) {
+    for (int32 x = 0; x < size; ++x) {
+      const int32 i = y * size + x;
+      const glm::vec2 uv(float(x) / (size - 1), float(y) / (size - 1));
+      // A gentle wave, so that the normals and tangents aren't all the same.
+      const float height =
+          10.0f * glm::sin(uv.x * 6.0f) * glm::cos(uv.y * 4.0f);
+      positions[i] = glm::vec3(uv.x * 1000.0f, height, uv.y * 1000.0f);
+      normals[i] = glm::normalize(glm::vec3(-uv.y, 1.0f, uv.x));
+      texCoords[i] = uv;
+      colors[i] = glm::vec4(uv, 0.5f, 1.0f);
+      featureIds[i] = uint8_t((x / 8 + y / 8) % 256);
+    }
+  }
+
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  Accessor& positionAccessor = model.accessors.back();
+  positionAccessor.min = {0.0, -10.0, 0.0};
+  positionAccessor.max = {1000.0, 10.0, 1000.0};
+
+  if (attributes.normals) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "NORMAL",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        normals);
+  }
+  if (attributes.texCoords) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "TEXCOORD_0",
+        AccessorSpec::Type::VEC2,
+        AccessorSpec::ComponentType::FLOAT,
+        texCoords);
+  }
+  if (attributes.colors) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "COLOR_0",
+        AccessorSpec::Type::VEC4,
+        AccessorSpec::ComponentType::FLOAT,
+        colors);
+  }
+  if (attributes.featureIdsAndMetadata) {
+    FeatureId& featureId =
+        AddFeatureIDsAsAttributeToModel(model, primitive, featureIds, 256, 0);
+    featureId.propertyTable = 0;
+
+    ExtensionModelExtStructuralMetadata& metadata =
+        model.addExtension<ExtensionModelExtStructuralMetadata>();
+    metadata.schema.emplace().classes["building"];
+    PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+    propertyTable.classProperty = "building";
+    propertyTable.count = 256;
+    std::vector<int32_t> heights(256);
+    for (int32 i = 0; i < 256; ++i) {
+      heights[i] = i * 3;
+    }
+    AddPropertyTablePropertyToModel(
+        model,
+        propertyTable,
+        "height",
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::INT32,
+        heights);
+  }
+
+  if (vertexCount <= 65536) {
+    CreateIndicesForPrimitive(
+        model,
+        primitive,
+        AccessorSpec::ComponentType::UNSIGNED_SHORT,
+        createGridIndices<uint16_t>(size));
+  } else {
+    CreateIndicesForPrimitive(
+        model,
+        primitive,
+        AccessorSpec::ComponentType::UNSIGNED_INT,
+        createGridIndices<uint32_t>(size));
+  }
+
+  return model;
+}
+
+struct Measurement {
+  double medianMilliseconds = 0.0;
+  double minimumMilliseconds = 0.0;
+  // The growth in the process's physical memory while the result was alive,
+  // which is only approximate, since the allocator keeps freed memory.
+  int64 peakMemoryBytes = 0;
+};
+
+/**
+ * Converts a copy of the model the given number of times, after one
+ * conversion to warm up, and measures the conversions.
+ */
+Measurement measureConversion(
+    const Model& model,
+    const CreateGltfOptions::CreateModelOptions& options,
+    int32 iterations) {
+  std::vector<double> milliseconds;
+  int64 peakMemoryBytes = 0;
+  for (int32 i = 0; i <= iterations; ++i) {
+    // The conversion may change the model, such as by generating normals, so
+    // it's given a fresh copy each time, outside of the measurement.
+    Model copy = model;
+    CreateGltfOptions::CreateModelOptions iterationOptions = options;
+    iterationOptions.pModel = &copy;
+
+    const uint64 memoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+    const double start = FPlatformTime::Seconds();
+    TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf =
+        UCesiumGltfComponent::CreateOffGameThread(
+            glm::dmat4(1.0),
+            iterationOptions);
+    const double end = FPlatformTime::Seconds();
+    const uint64 memoryAfter = FPlatformMemory::GetStats().UsedPhysical;
+    pHalf.Reset();
+
+    if (i > 0) {
+      milliseconds.push_back((end - start) * 1000.0);
+      peakMemoryBytes = std::max(
+          peakMemoryBytes,
+          int64(memoryAfter) - int64(memoryBefore));
+    }
+  }
+
+  std::sort(milliseconds.begin(), milliseconds.end());
+  Measurement result;
+  result.medianMilliseconds = milliseconds[milliseconds.size() / 2];
+  result.minimumMilliseconds = milliseconds.front();
+  result.peakMemoryBytes = peakMemoryBytes;
+  return result;
+}
+
+CreateGltfOptions::CreateModelOptions createBaselineOptions() {
+  CreateGltfOptions::CreateModelOptions options;
+  options.createPhysicsMeshes = false;
+  return options;
+}
+
+} // namespace
+
+/**
+ * Measures UCesiumGltfComponent::CreateOffGameThread, which converts each
+ * tile's glTF to Unreal meshes in a worker thread, for synthesized models of
+ * several sizes and vertex layouts. The cost of each optional stage, such as
+ * generating tangents or cooking physics meshes, is reported as the
+ * difference from the same model without it.
+ *
+ * Each case is marked with a trace bookmark, so that the CPU scopes of the
+ * stages and, with "-trace=memory", the allocations made by each case can be
+ * inspected in Unreal Insights.
+ */
+bool FCesiumGltfConversionBenchmark::RunTest(const FString& Parameters) {
+  constexpr int32 iterations = 5;
+
+  struct Layout {
+    const TCHAR* name;
+    GridAttributes attributes;
+  };
+  const Layout layouts[] = {
+      {TEXT("positions"), {}},
+      {TEXT("normals"), {true}},
+      {TEXT("normals, UVs"), {true, true}},
+      {TEXT("normals, UVs, colors"), {true, true, true}},
+      {TEXT("normals, UVs, colors, metadata"), {true, true, true, true}}};
+
+  struct Stage {
+    const TCHAR* name;
+    void (*apply)(CreateGltfOptions::CreateModelOptions&);
+  };
+  const Stage stages[] = {
+      {TEXT("MikkTSpace tangents"),
+       [](CreateGltfOptions::CreateModelOptions& options) {
+         options.alwaysIncludeTangents = true;
+       }},
+      {TEXT("fast tangents"),
+       [](CreateGltfOptions::CreateModelOptions& options) {
+         options.alwaysIncludeTangents = true;
+         options.useFastTangentGeneration = true;
+       }},
+      {TEXT("welded smooth normals"),
+       [](CreateGltfOptions::CreateModelOptions& options) {
+         options.weldSmoothNormals = true;
+       }},
+      {TEXT("physics meshes"),
+       [](CreateGltfOptions::CreateModelOptions& options) {
+         options.createPhysicsMeshes = true;
+       }},
+      {TEXT("navigation collision"),
+       [](CreateGltfOptions::CreateModelOptions& options) {
+         options.createNavCollision = true;
+       }},
+      {TEXT("height queries"),
+       [](CreateGltfOptions::CreateModelOptions& options) {
+         options.enableHeightQueries = true;
+       }}};
+
+  AddInfo(FString::Printf(
+      TEXT("%-48s %10s %10s %10s"),
+      TEXT("Case"),
+      TEXT("Median ms"),
+      TEXT("Min ms"),
+      TEXT("Peak KiB")));
+
+  auto report = [this](const FString& name, const Measurement& measurement) {
+    const FString line = FString::Printf(
+        TEXT("%-48s %10.3f %10.3f %10lld"),
+        *name,
+        measurement.medianMilliseconds,
+        measurement.minimumMilliseconds,
+        measurement.peakMemoryBytes / 1024);
+    AddInfo(line);
+    UE_LOG(LogCesium, Display, TEXT("glTF conversion: %s"), *line);
+  };
+
+  for (const int32 size : {16, 128, 512}) {
+    for (const Layout& layout : layouts) {
+      const Model model = createGridModel(size, layout.attributes);
+      const FString name = FString::Printf(
+          TEXT("%d vertices (%s), %s"),
+          size * size,
+          size * size <= 65536 ? TEXT("16-bit") : TEXT("32-bit"),
+          layout.name);
+
+      TRACE_BOOKMARK(TEXT("glTF conversion: %s"), *name);
+      const Measurement baseline =
+          measureConversion(model, createBaselineOptions(), iterations);
+      report(name, baseline);
+
+      // The optional stages only matter with a realistic vertex layout.
+      if (!layout.attributes.normals || !layout.attributes.texCoords) {
+        continue;
+      }
+
+      for (const Stage& stage : stages) {
+        CreateGltfOptions::CreateModelOptions options = createBaselineOptions();
+        stage.apply(options);
+
+        const FString stageName =
+            FString::Printf(TEXT("%s + %s"), *name, stage.name);
+        TRACE_BOOKMARK(TEXT("glTF conversion: %s"), *stageName);
+        const Measurement measurement =
+            measureConversion(model, options, iterations);
+        report(stageName, measurement);
+
+        Measurement difference;
+        difference.medianMilliseconds =
+            measurement.medianMilliseconds - baseline.medianMilliseconds;
+        difference.minimumMilliseconds =
+            measurement.minimumMilliseconds - baseline.minimumMilliseconds;
+        difference.peakMemoryBytes =
+            measurement.peakMemoryBytes - baseline.peakMemoryBytes;
+        report(FString::Printf(TEXT("  %s only"), stage.name), difference);
+      }
+    }
+  }
+
+  return true;
+}
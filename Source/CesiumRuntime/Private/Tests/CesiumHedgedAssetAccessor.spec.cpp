@@ -0,0 +1,130 @@
+#include "CesiumHedgedAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestFixtures.h"
+#include "Containers/Ticker.h"
+#include "Misc/AutomationTest.h"
+
+using CesiumTestHelpers::RequestFuture;
+using CesiumTestHelpers::TestAssetAccessor;
+
+namespace {
+
+void tickTimers() {
+  FTSTicker::GetCoreTicker().Tick(0.0f);
+  getAsyncSystem().dispatchMainThreadTasks();
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumHedgedAssetAccessorSpec,
+    "Cesium.Unit.HedgedAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<TestAssetAccessor> pPending;
+
+struct TrackedRequest {
+  bool succeeded = false;
+  bool failed = false;
+};
+
+std::shared_ptr<TrackedRequest> Track(RequestFuture&& future) {
+  std::shared_ptr<TrackedRequest> pResult =
+      std::make_shared<TrackedRequest>();
+  std::move(future)
+      .thenImmediately(
+          [pResult](std::shared_ptr<CesiumAsync::IAssetRequest>&&) {
+            pResult->succeeded = true;
+          })
+      .catchImmediately([pResult](std::exception&&) { pResult->failed = true; });
+  return pResult;
+}
+END_DEFINE_SPEC(FCesiumHedgedAssetAccessorSpec)
+
+void FCesiumHedgedAssetAccessorSpec::Define() {
+  BeforeEach([this]() { pPending = std::make_shared<TestAssetAccessor>(); });
+
+  AfterEach([this]() {
+    // Let any timers that are still scheduled finish.
+    tickTimers();
+    pPending.reset();
+  });
+
+  It("replaces the origin of URLs", [this]() {
+    TestEqual(
+        "path",
+        CesiumHedgedAssetAccessor::replaceOrigin(
+            "https://a.example.com/tiles/1.glb?v=1",
+            "https://b.example.com/"),
+        std::string("https://b.example.com/tiles/1.glb?v=1"));
+    TestEqual(
+        "no path",
+        CesiumHedgedAssetAccessor::replaceOrigin(
+            "https://a.example.com",
+            "http://b.example.com:8080"),
+        std::string("http://b.example.com:8080"));
+    TestEqual(
+        "no host",
+        CesiumHedgedAssetAccessor::replaceOrigin("tiles/1.glb", "https://b"),
+        std::string("tiles/1.glb"));
+  });
+
+  It("retries failed requests", [this]() {
+    CesiumHedgedAssetAccessor::Options options;
+    options.maximumRetries = 2;
+    options.retryDelay = 0.0;
+    std::shared_ptr<CesiumHedgedAssetAccessor> pAccessor =
+        std::make_shared<CesiumHedgedAssetAccessor>(pPending, pPending, options);
+
+    std::shared_ptr<TrackedRequest> pResult =
+        Track(pAccessor->get(getAsyncSystem(), "https://a/1", {}));
+
+    pPending->fail(0);
+    tickTimers();
+    TestEqual("first retry", pPending->promises.size(), size_t(2));
+
+    pPending->fail(1);
+    tickTimers();
+    TestEqual("second retry", pPending->promises.size(), size_t(3));
+
+    pPending->fail(2);
+    tickTimers();
+    TestEqual("no more retries", pPending->promises.size(), size_t(3));
+    TestTrue("failed", pResult->failed);
+    TestEqual("retries", pAccessor->getRetryCount(), int64_t(2));
+  });
+
+  It("hedges requests that take longer than usual", [this]() {
+    CesiumHedgedAssetAccessor::Options options;
+    options.hedge = true;
+    options.minimumHedgeDelay = 0.0;
+    options.hedgeOrigins = {"https://mirror"};
+    std::shared_ptr<CesiumHedgedAssetAccessor> pAccessor =
+        std::make_shared<CesiumHedgedAssetAccessor>(pPending, pPending, options);
+
+    // Requests aren't hedged until enough of them are known to have finished.
+    for (size_t i = 0; i < CesiumHedgedAssetAccessor::MinimumLatencySamples;
+         ++i) {
+      TestTrue("no delay yet", pAccessor->getHedgeDelay() < 0.0);
+      Track(pAccessor->get(getAsyncSystem(), "https://a/tile", {}));
+      pPending->finish(i);
+    }
+    TestTrue("delay", pAccessor->getHedgeDelay() >= 0.0);
+
+    const size_t slow = pPending->promises.size();
+    std::shared_ptr<TrackedRequest> pResult =
+        Track(pAccessor->get(getAsyncSystem(), "https://a/tile", {}));
+    tickTimers();
+    TestEqual("hedged", pPending->promises.size(), slow + 2);
+    TestEqual("mirror", pPending->urls.back(), std::string("https://mirror/tile"));
+
+    pPending->finish(slow + 1);
+    TestTrue("succeeded", pResult->succeeded);
+    TestEqual("hedges won", pAccessor->getHedgesWonCount(), int64_t(1));
+
+    // The slow request finishing afterward is ignored.
+    pPending->finish(slow);
+    TestEqual("hedged requests", pAccessor->getHedgedRequestCount(), int64_t(1));
+  });
+}
@@ -0,0 +1,84 @@
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "CesiumGeospatial/Cartographic.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumHorizonCullingExcluder.h"
+#include "Misc/AutomationTest.h"
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace {
+ViewState createView(const glm::dvec3& position) {
+  return ViewState::create(
+      position,
+      glm::normalize(-position),
+      glm::dvec3(1.0, 0.0, 0.0),
+      glm::dvec2(1024.0, 1024.0),
+      1.0,
+      1.0);
+}
+
+bool excludesSphere(
+    const CesiumHorizonCullingExcluder& excluder,
+    const glm::dvec3& center,
+    double radius) {
+  Tile tile(nullptr);
+  tile.setBoundingVolume(BoundingSphere(center, radius));
+  return excluder.shouldExclude(tile);
+}
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumHorizonCullingExcluderSpec,
+    "Cesium.Unit.HorizonCullingExcluder",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumHorizonCullingExcluderSpec)
+
+void FCesiumHorizonCullingExcluderSpec::Define() {
+  const double polarRadius = Ellipsoid::WGS84.getRadii().z;
+  const glm::dvec3 northPole(0.0, 0.0, polarRadius);
+
+  It("excludes tiles on the far side of the globe", [this, northPole]() {
+    CesiumHorizonCullingExcluder excluder;
+    excluder.setViews({createView(northPole * 3.0)});
+
+    TestFalse("near side", excludesSphere(excluder, northPole, 1000.0));
+    TestTrue("far side", excludesSphere(excluder, -northPole, 1000.0));
+  });
+
+  It("keeps tiles in front of the horizon", [this, northPole]() {
+    CesiumHorizonCullingExcluder excluder;
+    excluder.setViews({createView(northPole * 3.0)});
+
+    // From three times the polar radius, the horizon is at about 20 degrees
+    // of latitude.
+    const glm::dvec3 midLatitude = Ellipsoid::WGS84.cartographicToCartesian(
+        Cartographic::fromDegrees(0.0, 45.0, 0.0));
+    const glm::dvec3 equator = Ellipsoid::WGS84.cartographicToCartesian(
+        Cartographic::fromDegrees(0.0, 0.0, 0.0));
+    TestFalse("mid latitude", excludesSphere(excluder, midLatitude, 1000.0));
+    TestTrue("equator", excludesSphere(excluder, equator, 1000.0));
+
+    const double radius = Ellipsoid::WGS84.getRadii().x;
+    TestFalse("whole globe", excludesSphere(excluder, glm::dvec3(0.0), radius));
+  });
+
+  It("excludes only tiles hidden from every view", [this, northPole]() {
+    CesiumHorizonCullingExcluder excluder;
+    excluder.setViews(
+        {createView(northPole * 3.0), createView(-northPole * 3.0)});
+
+    TestFalse("north", excludesSphere(excluder, northPole, 1000.0));
+    TestFalse("south", excludesSphere(excluder, -northPole, 1000.0));
+  });
+
+  It("excludes nothing from below the surface", [this, northPole]() {
+    CesiumHorizonCullingExcluder excluder;
+    excluder.setViews({createView(northPole * 0.5)});
+
+    TestFalse("far side", excludesSphere(excluder, -northPole, 1000.0));
+  });
+}
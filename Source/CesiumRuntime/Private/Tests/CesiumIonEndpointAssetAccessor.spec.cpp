@@ -0,0 +1,119 @@
+#include "CesiumIonEndpointAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRequestCancellation.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestFixtures.h"
+#include "Misc/AutomationTest.h"
+#include <optional>
+
+using CesiumTestHelpers::TestAssetAccessor;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumIonEndpointAssetAccessorSpec,
+    "Cesium.Unit.IonEndpointAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<TestAssetAccessor> pPending;
+std::optional<CesiumIonEndpointAssetAccessor> first;
+std::optional<CesiumIonEndpointAssetAccessor> second;
+
+const std::string endpoint =
+    "https://api.cesium.com/v1/assets/2/endpoint?access_token=abc";
+END_DEFINE_SPEC(FCesiumIonEndpointAssetAccessorSpec)
+
+void FCesiumIonEndpointAssetAccessorSpec::Define() {
+  BeforeEach([this]() {
+    CesiumIonEndpointAssetAccessor::clear();
+    pPending = std::make_shared<TestAssetAccessor>();
+    first.emplace(pPending);
+    second.emplace(pPending);
+  });
+
+  AfterEach([this]() {
+    pPending->finishAll();
+    first.reset();
+    second.reset();
+    pPending.reset();
+    CesiumIonEndpointAssetAccessor::clear();
+  });
+
+  It("recognizes endpoint URLs", [this]() {
+    TestTrue(
+        "endpoint",
+        CesiumIonEndpointAssetAccessor::isEndpointUrl(endpoint));
+    TestFalse(
+        "tileset",
+        CesiumIonEndpointAssetAccessor::isEndpointUrl(
+            "https://assets.ion.cesium.com/1/tileset.json"));
+  });
+
+  It("shares an endpoint request between accessors", [this]() {
+    const int64 sharedBefore =
+        CesiumIonEndpointAssetAccessor::getSharedRequestCount();
+    first->get(getAsyncSystem(), endpoint, {});
+    second->get(getAsyncSystem(), endpoint, {});
+    TestEqual("requests", pPending->requestCount, 1);
+    TestEqual(
+        "shared",
+        CesiumIonEndpointAssetAccessor::getSharedRequestCount() - sharedBefore,
+        int64(1));
+  });
+
+  It("shares endpoint requests across request groups", [this]() {
+    first->get(
+        getAsyncSystem(),
+        endpoint,
+        {{CesiumRequestCancellation::groupHeader, "1"}});
+    second->get(
+        getAsyncSystem(),
+        endpoint,
+        {{CesiumRequestCancellation::groupHeader, "2"}});
+    TestEqual("requests", pPending->requestCount, 1);
+  });
+
+  It("requests a failed endpoint again", [this]() {
+    first->get(getAsyncSystem(), endpoint, {});
+    // The pending accessor finishes requests without a response.
+    pPending->finishAll();
+    second->get(getAsyncSystem(), endpoint, {});
+    TestEqual("requests", pPending->requestCount, 2);
+  });
+
+  Describe("getTokenExpiry", [this]() {
+    auto expiryOf = [](const std::string& json) {
+      return CesiumIonEndpointAssetAccessor::getTokenExpiry(
+          gsl::span<const std::byte>(
+              reinterpret_cast<const std::byte*>(json.data()),
+              json.size()));
+    };
+
+    It("reads the expiry of the access token", [this, expiryOf]() {
+      // The claims are {"jti":"x","exp":1700000000}, in base64url without
+      // padding.
+      std::optional<int64_t> expiry = expiryOf(
+          "{\"type\":\"3DTILES\",\"url\":\"https://a.com/tileset.json\","
+          "\"accessToken\": \"eyJhbGciOiJIUzI1NiJ9."
+          "eyJqdGkiOiJ4IiwiZXhwIjoxNzAwMDAwMDAwfQ.signature\"}");
+      if (!TestTrue("has expiry", expiry.has_value())) {
+        return;
+      }
+      TestEqual("expiry", *expiry, int64_t(1700000000));
+    });
+
+    It("has no expiry without an access token", [this, expiryOf]() {
+      TestFalse(
+          "external",
+          expiryOf("{\"type\":\"3DTILES\",\"externalType\":\"x\"}")
+              .has_value());
+      TestFalse(
+          "not a JWT",
+          expiryOf("{\"accessToken\":\"opaque\"}").has_value());
+    });
+  });
+
+  It("passes other requests through", [this]() {
+    first->get(getAsyncSystem(), "https://assets.ion.cesium.com/a", {});
+    second->get(getAsyncSystem(), "https://assets.ion.cesium.com/a", {});
+    TestEqual("requests", pPending->requestCount, 2);
+  });
+}
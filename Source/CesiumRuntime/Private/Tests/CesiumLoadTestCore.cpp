@@ -4,15 +4,29 @@
 
 #include "CesiumLoadTestCore.h"
 
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTileset.h"
 #include "CesiumAsync/ICacheDatabase.h"
+#include "CesiumFrameBudget.h"
 #include "CesiumRuntime.h"
+#include "UnrealAssetAccessor.h"
 
+#include "Dom/JsonObject.h"
 #include "Editor.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
 #include "Settings/LevelEditorPlaySettings.h"
 #include "Tests/AutomationCommon.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "UnrealClient.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Cesium {
 
 struct LoadTestContext {
@@ -36,6 +50,74 @@ struct LoadTestContext {
 
 LoadTestContext gLoadTestContext;
 
+double getFrameTimePercentile(const TestPass& pass, double fraction) {
+  if (pass.frameTimes.empty())
+    return 0.0;
+
+  std::vector<double> sorted = pass.frameTimes;
+  std::sort(sorted.begin(), sorted.end());
+
+  // Nearest rank
+  size_t rank = size_t(std::ceil(fraction * double(sorted.size())));
+  rank = std::clamp(rank, size_t(1), sorted.size());
+  return sorted[rank - 1];
+}
+
+namespace {
+
+bool isCameraPathDone(const TestPass& pass, double elapsedTime) {
+  return pass.cameraPath.empty() ||
+         elapsedTime >= pass.cameraPath.back().time;
+}
+
+void updateCameraPath(
+    SceneGenerationContext& playContext,
+    const TestPass& pass,
+    double elapsedTime) {
+  const std::vector<CameraKeyframe>& path = pass.cameraPath;
+  if (path.empty())
+    return;
+
+  // Find the segment containing this time, and hold the ends of the path
+  auto next = std::upper_bound(
+      path.begin(),
+      path.end(),
+      elapsedTime,
+      [](double time, const CameraKeyframe& keyframe) {
+        return time < keyframe.time;
+      });
+  if (next == path.begin() || next == path.end()) {
+    const CameraKeyframe& keyframe =
+        next == path.begin() ? path.front() : path.back();
+    playContext.setPlayerCamera(keyframe.position, keyframe.rotation);
+    return;
+  }
+
+  const CameraKeyframe& previous = *(next - 1);
+  const double duration = next->time - previous.time;
+  const double alpha =
+      duration > 0.0 ? (elapsedTime - previous.time) / duration : 1.0;
+  const FVector position =
+      FMath::Lerp(previous.position, next->position, alpha);
+  const FQuat rotation = FQuat::Slerp(
+      previous.rotation.Quaternion(),
+      next->rotation.Quaternion(),
+      alpha);
+  playContext.setPlayerCamera(position, rotation.Rotator());
+}
+
+int64 getNumberOfTilesLoaded(const SceneGenerationContext& playContext) {
+  int64 tilesLoaded = 0;
+  for (const ACesium3DTileset* tileset : playContext.tilesets) {
+    const Cesium3DTilesSelection::Tileset* pTileset = tileset->GetTileset();
+    if (pTileset)
+      tilesLoaded += pTileset->getNumberOfTilesLoaded();
+  }
+  return tilesLoaded;
+}
+
+} // namespace
+
 DEFINE_LATENT_AUTOMATION_COMMAND_THREE_PARAMETER(
     TimeLoadingCommand,
     FString,
@@ -55,6 +137,12 @@ bool TimeLoadingCommand::Update() {
 
     // Start test mark, turn updates back on
     pass.startMark = FPlatformTime::Seconds();
+    pass.lastFrameMark = pass.startMark;
+    pass.startMainThreadLoadingTime =
+        CesiumFrameBudget::getTotalMainThreadLoadingTime();
+    pass.startBytesReceived = UnrealAssetAccessor::getTotalBytesReceived();
+    pass.frameTimes.clear();
+    pass.peakUsedPhysicalMemory = FPlatformMemory::GetStats().UsedPhysical;
     UE_LOG(LogCesium, Display, TEXT("-- Load start mark -- %s"), *loggingName);
 
     playContext.setSuspendUpdate(false);
@@ -69,14 +157,31 @@ bool TimeLoadingCommand::Update() {
 
   pass.elapsedTime = timeMark - pass.startMark;
 
-  // The command is over if tilesets are loaded, or timed out
-  // Wait for a maximum of 30 seconds
-  const size_t testTimeout = 30;
-  bool tilesetsloaded = playContext.areTilesetsDoneLoading();
+  // Sample the frame that just ticked
+  pass.frameTimes.push_back((timeMark - pass.lastFrameMark) * 1000.0);
+  pass.lastFrameMark = timeMark;
+  pass.peakUsedPhysicalMemory = std::max(
+      pass.peakUsedPhysicalMemory,
+      uint64(FPlatformMemory::GetStats().UsedPhysical));
+
+  updateCameraPath(playContext, pass, pass.elapsedTime);
+
+  // The command is over if tilesets are loaded and the camera path is done,
+  // or timed out. Wait for a maximum of 30 seconds past the end of the path.
+  const double testTimeout =
+      30.0 + (pass.cameraPath.empty() ? 0.0 : pass.cameraPath.back().time);
+  bool tilesetsloaded = playContext.areTilesetsDoneLoading() &&
+                        isCameraPathDone(pass, pass.elapsedTime);
   bool timedOut = pass.elapsedTime >= testTimeout;
 
   if (tilesetsloaded || timedOut) {
     pass.endMark = timeMark;
+    pass.mainThreadLoadingTime =
+        CesiumFrameBudget::getTotalMainThreadLoadingTime() -
+        pass.startMainThreadLoadingTime;
+    pass.bytesReceived =
+        UnrealAssetAccessor::getTotalBytesReceived() - pass.startBytesReceived;
+    pass.tilesLoaded = getNumberOfTilesLoaded(playContext);
     UE_LOG(LogCesium, Display, TEXT("-- Load end mark -- %s"), *loggingName);
 
     if (timedOut) {
@@ -111,6 +216,10 @@ DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(
     FString,
     screenshotName);
 bool LoadTestScreenshotCommand::Update() {
+  // Headless runs (-nullrhi) have nothing to capture
+  if (!FApp::CanEverRender())
+    return true;
+
   UE_LOG(
       LogCesium,
       Display,
@@ -133,12 +242,93 @@ void defaultReportStep(const std::vector<TestPass>& testPasses) {
     const TestPass& pass = *it;
     reportStr +=
         FString::Printf(TEXT("%.2f secs - %s\n"), pass.elapsedTime, *pass.name);
+    reportStr += FString::Printf(
+        TEXT("    frame p50/p95/p99: %.2f / %.2f / %.2f ms\n"),
+        getFrameTimePercentile(pass, 0.5),
+        getFrameTimePercentile(pass, 0.95),
+        getFrameTimePercentile(pass, 0.99));
+    reportStr += FString::Printf(
+        TEXT("    %lld tiles, %.2f MB received, %.2f ms loading on game thread\n"),
+        pass.tilesLoaded,
+        double(pass.bytesReceived) / (1024.0 * 1024.0),
+        pass.mainThreadLoadingTime);
   }
   reportStr += "-----------------------------\n";
 
   UE_LOG(LogCesium, Display, TEXT("%s"), *reportStr);
 }
 
+/**
+ * Writes the measurements of each pass to
+ * Saved/Automation/CesiumLoadTests/<testName>.json, so that runs on a build
+ * machine can be compared against each other.
+ */
+void writeJsonReport(
+    const FString& testName,
+    const std::vector<TestPass>& testPasses) {
+  TArray<TSharedPtr<FJsonValue>> passes;
+  for (const TestPass& pass : testPasses) {
+    const double tilesPerSecond =
+        pass.elapsedTime > 0.0 ? double(pass.tilesLoaded) / pass.elapsedTime
+                               : 0.0;
+    TSharedRef<FJsonObject> pPass = MakeShared<FJsonObject>();
+    pPass->SetStringField(TEXT("name"), pass.name);
+    pPass->SetNumberField(TEXT("elapsedSeconds"), pass.elapsedTime);
+    pPass->SetNumberField(TEXT("frames"), double(pass.frameTimes.size()));
+    pPass->SetNumberField(
+        TEXT("frameTimeP50"),
+        getFrameTimePercentile(pass, 0.5));
+    pPass->SetNumberField(
+        TEXT("frameTimeP95"),
+        getFrameTimePercentile(pass, 0.95));
+    pPass->SetNumberField(
+        TEXT("frameTimeP99"),
+        getFrameTimePercentile(pass, 0.99));
+    pPass->SetNumberField(
+        TEXT("mainThreadLoadingMilliseconds"),
+        pass.mainThreadLoadingTime);
+    pPass->SetNumberField(TEXT("tilesLoaded"), double(pass.tilesLoaded));
+    pPass->SetNumberField(TEXT("tilesPerSecond"), tilesPerSecond);
+    pPass->SetNumberField(TEXT("bytesReceived"), double(pass.bytesReceived));
+    pPass->SetNumberField(
+        TEXT("peakUsedPhysicalMemory"),
+        double(pass.peakUsedPhysicalMemory));
+    passes.Add(MakeShared<FJsonValueObject>(pPass));
+  }
+
+  TSharedRef<FJsonObject> pRoot = MakeShared<FJsonObject>();
+  pRoot->SetStringField(TEXT("test"), testName);
+  pRoot->SetArrayField(TEXT("passes"), passes);
+
+  FString json;
+  if (!FJsonSerializer::Serialize(pRoot, TJsonWriterFactory<>::Create(&json))) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Could not serialize the load test report for %s"),
+        *testName);
+    return;
+  }
+
+  const FString filename = FPaths::Combine(
+      FPaths::ProjectSavedDir(),
+      TEXT("Automation"),
+      TEXT("CesiumLoadTests"),
+      testName + TEXT(".json"));
+  if (FFileHelper::SaveStringToFile(
+          json,
+          *filename,
+          FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)) {
+    UE_LOG(LogCesium, Display, TEXT("Wrote load test report to %s"), *filename);
+  } else {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Could not write load test report to %s"),
+        *filename);
+  }
+}
+
 DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(
     TestCleanupCommand,
     LoadTestContext&,
@@ -163,6 +353,8 @@ bool TestCleanupCommand::Update() {
   else
     defaultReportStep(context.testPasses);
 
+  writeJsonReport(context.testName, context.testPasses);
+
   // Turn on the editor tileset updates so we can see what we loaded
   gLoadTestContext.creationContext.setSuspendUpdate(false);
   return true;
@@ -6,11 +6,19 @@
 
 #include <functional>
 #include <variant>
+#include <vector>
 
 #include "CesiumSceneGeneration.h"
 
 namespace Cesium {
 
+struct CameraKeyframe {
+  // Seconds since the start of the pass
+  double time;
+  FVector position;
+  FRotator rotation;
+};
+
 struct TestPass {
   typedef std::variant<int, float> TestingParameter;
   typedef std::function<void(SceneGenerationContext&, TestingParameter)>
@@ -21,14 +29,36 @@ struct TestPass {
   PassCallback verifyStep;
   TestingParameter optionalParameter;
 
+  // An optional camera path, flown by the player during the pass. The pass
+  // isn't done until the last keyframe is reached and the tilesets are loaded.
+  std::vector<CameraKeyframe> cameraPath;
+
   bool testInProgress = false;
   double startMark = 0;
   double endMark = 0;
   double elapsedTime = 0;
+  double lastFrameMark = 0;
+
+  // Counter values at the start of the pass
+  double startMainThreadLoadingTime = 0;
+  int64 startBytesReceived = 0;
+
+  // Measured during the pass
+  std::vector<double> frameTimes; // milliseconds
+  double mainThreadLoadingTime = 0; // milliseconds
+  int64 tilesLoaded = 0;
+  int64 bytesReceived = 0;
+  uint64 peakUsedPhysicalMemory = 0;
 
   bool isFastest = false;
 };
 
+/**
+ * Gets the frame time, in milliseconds, below which the given fraction of a
+ * pass's frames fall, or 0 if no frames were measured.
+ */
+double getFrameTimePercentile(const TestPass& pass, double fraction);
+
 typedef std::function<void(const std::vector<TestPass>&)> ReportCallback;
 
 bool RunLoadTest(
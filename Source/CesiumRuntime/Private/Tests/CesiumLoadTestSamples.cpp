@@ -20,6 +20,11 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     "Cesium.Performance.SampleLocaleDenver",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumSampleFlyoverDenver,
+    "Cesium.Performance.SampleFlyoverDenver",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
 IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     FCesiumSampleMelbourne,
     "Cesium.Performance.SampleLocaleMelbourne",
@@ -153,6 +158,36 @@ bool FCesiumSampleDenver::RunTest(const FString& Parameters) {
       768);
 }
 
+bool FCesiumSampleFlyoverDenver::RunTest(const FString& Parameters) {
+  // Fly the same path on every run, so the frame times and the tiles streamed
+  // in along the way can be compared between builds. Positions are in Unreal
+  // units relative to the Denver origin.
+  std::vector<CameraKeyframe> cameraPath;
+  cameraPath.push_back({0.0, FVector(0, 0, 0), FRotator(-5.2, -149.4, 0)});
+  cameraPath.push_back(
+      {10.0, FVector(-150000, -90000, 30000), FRotator(-10.0, -120.0, 0)});
+  cameraPath.push_back(
+      {20.0, FVector(-250000, 50000, 60000), FRotator(-20.0, -60.0, 0)});
+  cameraPath.push_back(
+      {30.0, FVector(-100000, 200000, 100000), FRotator(-35.0, 30.0, 0)});
+
+  TestPass coldPass{"Cold Cache", nullptr, nullptr};
+  coldPass.cameraPath = cameraPath;
+  TestPass warmPass{"Warm Cache", refreshSampleTilesets, nullptr};
+  warmPass.cameraPath = cameraPath;
+
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(coldPass);
+  testPasses.push_back(warmPass);
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForDenver,
+      testPasses,
+      1280,
+      720);
+}
+
 bool FCesiumSampleMelbourne::RunTest(const FString& Parameters) {
   std::vector<TestPass> testPasses;
   testPasses.push_back(TestPass{"Cold Cache", nullptr, nullptr});
@@ -0,0 +1,87 @@
+#include "CesiumMainThreadDispatcher.h"
+#include "Misc/AutomationTest.h"
+#include <optional>
+#include <vector>
+
+using Priority = CesiumMainThreadDispatcher::Priority;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMainThreadDispatcherSpec,
+    "Cesium.Unit.MainThreadDispatcher",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::optional<CesiumMainThreadDispatcher> dispatcher;
+std::vector<int> order;
+
+void postRecording(Priority priority, int id) {
+  dispatcher->post(priority, [this, id]() { order.push_back(id); });
+}
+END_DEFINE_SPEC(FCesiumMainThreadDispatcherSpec)
+
+void FCesiumMainThreadDispatcherSpec::Define() {
+  BeforeEach([this]() {
+    dispatcher.emplace();
+    order.clear();
+  });
+  AfterEach([this]() { dispatcher.reset(); });
+
+  It("runs every task when the time is unlimited", [this]() {
+    postRecording(Priority::Low, 1);
+    postRecording(Priority::Normal, 2);
+    postRecording(Priority::High, 3);
+    dispatcher->dispatch(-1.0);
+
+    TestEqual("order", order, std::vector<int>{3, 2, 1});
+    TestEqual("pending", dispatcher->getPendingCount(Priority::Low), 0);
+  });
+
+  It("runs high priority tasks even without time", [this]() {
+    postRecording(Priority::High, 1);
+    postRecording(Priority::High, 2);
+    postRecording(Priority::Normal, 3);
+    dispatcher->dispatch(0.0);
+
+    TestEqual("order", order, std::vector<int>{1, 2});
+    TestEqual("pending", dispatcher->getPendingCount(Priority::Normal), 1);
+  });
+
+  It("runs one task without time and defers the rest", [this]() {
+    postRecording(Priority::Low, 1);
+    postRecording(Priority::Normal, 2);
+    postRecording(Priority::Low, 3);
+    dispatcher->dispatch(0.0);
+
+    TestEqual("order", order, std::vector<int>{2});
+    TestEqual("pending", dispatcher->getPendingCount(Priority::Low), 2);
+    TestEqual(
+        "deferred",
+        dispatcher->getStatistics(Priority::Low).deferred,
+        int64(2));
+    TestEqual(
+        "dispatched",
+        dispatcher->getStatistics(Priority::Normal).dispatched,
+        int64(1));
+  });
+
+  It("runs deferred tasks before the ones posted after them", [this]() {
+    postRecording(Priority::Low, 1);
+    postRecording(Priority::Low, 2);
+    dispatcher->dispatch(0.0);
+    postRecording(Priority::Low, 3);
+    dispatcher->dispatch(-1.0);
+
+    TestEqual("order", order, std::vector<int>{1, 2, 3});
+  });
+
+  It("runs tasks posted by a task in the next dispatch", [this]() {
+    dispatcher->post(Priority::Normal, [this]() {
+      order.push_back(1);
+      postRecording(Priority::Normal, 2);
+    });
+    dispatcher->dispatch(-1.0);
+    TestEqual("first", order, std::vector<int>{1});
+
+    dispatcher->dispatch(-1.0);
+    TestEqual("second", order, std::vector<int>{1, 2});
+  });
+}
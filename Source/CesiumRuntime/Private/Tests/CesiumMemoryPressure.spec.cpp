@@ -0,0 +1,59 @@
+#include "CesiumMemoryPressure.h"
+#include "CesiumRuntimeSettings.h"
+#include "Misc/AutomationTest.h"
+#include <optional>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMemoryPressureSpec,
+    "Cesium.Unit.MemoryPressure",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::optional<CesiumMemoryPressure> memoryPressure;
+END_DEFINE_SPEC(FCesiumMemoryPressureSpec)
+
+void FCesiumMemoryPressureSpec::Define() {
+  BeforeEach([this]() { memoryPressure.emplace(); });
+  AfterEach([this]() { memoryPressure.reset(); });
+
+  It("uses the usual limits until memory is low", [this]() {
+    memoryPressure->update(1.0f);
+    TestFalse("active", memoryPressure->isActive());
+    TestEqual("cached bytes", memoryPressure->getCachedBytesScale(), 1.0);
+    TestEqual("SSE", memoryPressure->getScreenSpaceErrorScale(), 1.0);
+  });
+
+  It("lowers the limits on a memory warning", [this]() {
+    const UCesiumRuntimeSettings* pSettings =
+        GetDefault<UCesiumRuntimeSettings>();
+
+    memoryPressure->notifyMemoryWarning();
+    TestTrue("active", memoryPressure->isActive());
+    TestEqual("warnings", memoryPressure->getWarningCount(), 1);
+    TestEqual(
+        "cached bytes",
+        memoryPressure->getCachedBytesScale(),
+        double(pSettings->MemoryPressureCachedBytesScale));
+    TestEqual(
+        "SSE",
+        memoryPressure->getScreenSpaceErrorScale(),
+        double(pSettings->MemoryPressureScreenSpaceErrorScale));
+  });
+
+  It("recovers once there have been no warnings for a while", [this]() {
+    const float recoveryTime =
+        GetDefault<UCesiumRuntimeSettings>()->MemoryPressureRecoveryTime;
+
+    memoryPressure->notifyMemoryWarning();
+    memoryPressure->update(recoveryTime * 0.5f);
+    TestTrue("active halfway", memoryPressure->isActive());
+
+    // Another warning starts the recovery time again.
+    memoryPressure->notifyMemoryWarning();
+    memoryPressure->update(recoveryTime * 0.75f);
+    TestTrue("active after second warning", memoryPressure->isActive());
+    TestEqual("warnings", memoryPressure->getWarningCount(), 2);
+
+    memoryPressure->update(recoveryTime * 0.5f);
+    TestFalse("active", memoryPressure->isActive());
+  });
+}
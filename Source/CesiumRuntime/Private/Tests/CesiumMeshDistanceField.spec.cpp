@@ -0,0 +1,140 @@
+#include "CesiumMeshDistanceField.h"
+#include "DistanceFieldAtlas.h"
+#include "Misc/AutomationTest.h"
+
+namespace {
+// A square in the XY plane at the given height, whose front faces point up.
+CesiumPhysicsMeshUtility::CollisionGeometry
+createSquare(float size, float height) {
+  CesiumPhysicsMeshUtility::CollisionGeometry geometry;
+  geometry.vertices.AddParticles(4);
+  geometry.vertices.X(0) = FVector3f(0.0f, 0.0f, height);
+  geometry.vertices.X(1) = FVector3f(size, 0.0f, height);
+  geometry.vertices.X(2) = FVector3f(size, size, height);
+  geometry.vertices.X(3) = FVector3f(0.0f, size, height);
+  geometry.indices = {0, 3, 2, 0, 2, 1};
+  return geometry;
+}
+
+uint32 getBrickIndex(
+    const FDistanceFieldVolumeData& distanceField,
+    const FIntVector& brick) {
+  const FSparseDistanceFieldMip& mip =
+      distanceField.Mips[DistanceField::NumMips - 1];
+  const int32 index =
+      (brick.Z * mip.IndirectionDimensions.Y + brick.Y) *
+          mip.IndirectionDimensions.X +
+      brick.X;
+  uint32 brickIndex;
+  FMemory::Memcpy(
+      &brickIndex,
+      &distanceField.AlwaysLoadedMip[index * sizeof(uint32)],
+      sizeof(uint32));
+  return brickIndex;
+}
+
+uint8 getVoxel(
+    const FDistanceFieldVolumeData& distanceField,
+    uint32 brickIndex,
+    const FIntVector& voxel) {
+  const FSparseDistanceFieldMip& mip =
+      distanceField.Mips[DistanceField::NumMips - 1];
+  const int32 indirectionTableBytes = mip.IndirectionDimensions.X *
+                                      mip.IndirectionDimensions.Y *
+                                      mip.IndirectionDimensions.Z *
+                                      sizeof(uint32);
+  const int32 brickBytes = DistanceField::BrickSize *
+                           DistanceField::BrickSize * DistanceField::BrickSize;
+  return distanceField.AlwaysLoadedMip
+      [indirectionTableBytes + brickIndex * brickBytes +
+       (voxel.Z * DistanceField::BrickSize + voxel.Y) *
+           DistanceField::BrickSize +
+       voxel.X];
+}
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMeshDistanceFieldSpec,
+    "Cesium.Unit.MeshDistanceField",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumMeshDistanceFieldSpec)
+
+void FCesiumMeshDistanceFieldSpec::Define() {
+  It("builds nothing without valid triangles", [this]() {
+    CesiumPhysicsMeshUtility::CollisionGeometry geometry =
+        createSquare(1000.0f, 0.0f);
+    geometry.indices = {0, 1, 4, 2, 2, 2};
+    TestNull(
+        "distance field",
+        CesiumMeshDistanceField::buildMeshDistanceField(geometry).Get());
+  });
+
+  It("stores only the bricks near the surface", [this]() {
+    TUniquePtr<FDistanceFieldVolumeData> pDistanceField =
+        CesiumMeshDistanceField::buildMeshDistanceField(
+            createSquare(1000.0f, 500.0f));
+    if (!TestNotNull("distance field", pDistanceField.Get())) {
+      return;
+    }
+
+    TestTrue(
+        "bounds",
+        pDistanceField->LocalSpaceMeshBounds.IsInside(
+            FVector3f(500.0f, 500.0f, 500.0f)));
+
+    for (int32 i = 0; i < DistanceField::NumMips; ++i) {
+      const FSparseDistanceFieldMip& mip = pDistanceField->Mips[i];
+      TestEqual("flat", mip.IndirectionDimensions.Z, 1);
+      TestEqual(
+          "bricks",
+          mip.NumDistanceFieldBricks,
+          mip.IndirectionDimensions.X * mip.IndirectionDimensions.Y);
+    }
+
+    const FSparseDistanceFieldMip& lowestMip =
+        pDistanceField->Mips[DistanceField::NumMips - 1];
+    const int32 brickBytes = DistanceField::BrickSize *
+                             DistanceField::BrickSize *
+                             DistanceField::BrickSize;
+    TestEqual(
+        "always loaded mip size",
+        pDistanceField->AlwaysLoadedMip.Num(),
+        lowestMip.IndirectionDimensions.X * lowestMip.IndirectionDimensions.Y *
+                int32(sizeof(uint32)) +
+            lowestMip.NumDistanceFieldBricks * brickBytes);
+
+    const FSparseDistanceFieldMip& highestMip = pDistanceField->Mips[0];
+    TestEqual(
+        "streamable mips size",
+        int64(pDistanceField->StreamableMips.GetBulkDataSize()),
+        int64(highestMip.BulkSize + pDistanceField->Mips[1].BulkSize));
+  });
+
+  It("is negative behind the front faces", [this]() {
+    TUniquePtr<FDistanceFieldVolumeData> pDistanceField =
+        CesiumMeshDistanceField::buildMeshDistanceField(
+            createSquare(1000.0f, 500.0f));
+    if (!TestNotNull("distance field", pDistanceField.Get())) {
+      return;
+    }
+
+    const uint32 brickIndex =
+        getBrickIndex(*pDistanceField, FIntVector(1, 1, 0));
+    if (!TestNotEqual(
+            "brick",
+            brickIndex,
+            DistanceField::InvalidBrickIndex)) {
+      return;
+    }
+
+    const uint8 below =
+        getVoxel(*pDistanceField, brickIndex, FIntVector(0, 0, 0));
+    const uint8 above = getVoxel(
+        *pDistanceField,
+        brickIndex,
+        FIntVector(0, 0, DistanceField::BrickSize - 1));
+    TestTrue("below is inside", below < 128);
+    TestTrue("above is outside", above >= 128);
+  });
+}
@@ -0,0 +1,228 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMetadataConversions.h"
+#include "CesiumMetadataValue.h"
+#include "CesiumPropertyArray.h"
+#include "CesiumPropertyArrayBlueprintLibrary.h"
+#include "CesiumRuntime.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumMetadataConversionsBenchmark,
+    "Cesium.Performance.MetadataConversions",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+// The number of values converted by each pass, and the number of timed
+// passes. The fastest pass is reported, since it's the least disturbed by the
+// rest of the process.
+constexpr int32 valueCount = 1 << 16;
+constexpr int32 passCount = 8;
+
+// Reduces a converted value to a number that the benchmark adds up, so that
+// the conversions can't be optimized away.
+template <typename T> double checksum(const T& value) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return double(value);
+  } else if constexpr (std::is_same_v<T, FString>) {
+    return double(value.Len());
+  } else {
+    return double(value.X);
+  }
+}
+
+struct Result {
+  double nanosecondsPerConversion;
+  double checksum;
+};
+
+/**
+ * Times the given function, which converts the value at the index it's given
+ * and returns a checksum of the result, over valueCount values.
+ */
+template <typename Func> Result measure(Func&& convert) {
+  double sum = 0.0;
+  for (int32 i = 0; i < valueCount; ++i) {
+    sum += convert(i);
+  }
+
+  double fastest = std::numeric_limits<double>::max();
+  for (int32 pass = 0; pass < passCount; ++pass) {
+    const double start = FPlatformTime::Seconds();
+    for (int32 i = 0; i < valueCount; ++i) {
+      sum += convert(i);
+    }
+    fastest = FMath::Min(fastest, FPlatformTime::Seconds() - start);
+  }
+
+  return Result{fastest * 1.0e9 / valueCount, sum};
+}
+
+template <typename TTo, typename TFrom>
+Result
+measureConversion(const std::vector<TFrom>& values, const TTo& defaultValue) {
+  return measure([&values, &defaultValue](int32 i) {
+    return checksum(CesiumMetadataConversions<TTo, TFrom>::convert(
+        values[i],
+        defaultValue));
+  });
+}
+
+template <typename T, typename Func>
+std::vector<T> createValues(Func&& create) {
+  std::vector<T> values;
+  values.reserve(valueCount);
+  for (int32 i = 0; i < valueCount; ++i) {
+    values.push_back(create(i));
+  }
+  return values;
+}
+
+// String values that are views of strings that must outlive them.
+std::vector<std::string_view>
+createStringViews(const std::vector<std::string>& strings) {
+  return std::vector<std::string_view>(strings.begin(), strings.end());
+}
+
+} // namespace
+
+/**
+ * Measures the throughput of CesiumMetadataConversions for common pairs of
+ * types, and of the Blueprint library path that converts the elements of
+ * metadata arrays. Each result is the time of the fastest of several passes
+ * over the same values, so that results can be compared between runs on the
+ * same machine.
+ */
+bool FCesiumMetadataConversionsBenchmark::RunTest(const FString& Parameters) {
+  AddInfo(FString::Printf(
+      TEXT("%-40s %12s %14s"),
+      TEXT("Conversion"),
+      TEXT("ns/value"),
+      TEXT("Mvalues/s")));
+
+  double total = 0.0;
+  auto report = [this, &total](const TCHAR* name, const Result& result) {
+    const FString line = FString::Printf(
+        TEXT("%-40s %12.2f %14.1f"),
+        name,
+        result.nanosecondsPerConversion,
+        1.0e3 / result.nanosecondsPerConversion);
+    AddInfo(line);
+    UE_LOG(LogCesium, Display, TEXT("Metadata conversion: %s"), *line);
+    total += result.checksum;
+  };
+
+  // Scalars
+  const std::vector<int32_t> int32s =
+      createValues<int32_t>([](int32 i) { return i * 37 - 1000000; });
+  const std::vector<int64_t> int64s = createValues<int64_t>(
+      [](int32 i) { return int64_t(i) * 1234567891 - 4000000000000; });
+  const std::vector<uint8_t> uint8s =
+      createValues<uint8_t>([](int32 i) { return uint8_t(i); });
+  const std::vector<float> floats =
+      createValues<float>([](int32 i) { return float(i) * 0.37f - 5000.0f; });
+  const std::vector<double> doubles =
+      createValues<double>([](int32 i) { return double(i) * 1.0e5 + 0.25; });
+
+  report(TEXT("int32 -> float"), measureConversion(int32s, 0.0f));
+  report(TEXT("int64 -> double"), measureConversion(int64s, 0.0));
+  report(TEXT("uint8 -> int32"), measureConversion(uint8s, int32_t(0)));
+  report(TEXT("int64 -> int32 (range checked)"), measureConversion(int64s, 0));
+  report(TEXT("float -> int32 (range checked)"), measureConversion(floats, 0));
+  report(TEXT("double -> float"), measureConversion(doubles, 0.0f));
+  report(TEXT("int32 -> bool"), measureConversion(int32s, false));
+
+  // Vectors
+  const std::vector<glm::vec2> vec2s = createValues<glm::vec2>(
+      [](int32 i) { return glm::vec2(float(i), float(-i)); });
+  const std::vector<glm::ivec3> ivec3s = createValues<glm::ivec3>(
+      [](int32 i) { return glm::ivec3(i, i * 2, i * 3); });
+  const std::vector<glm::dvec3> dvec3s = createValues<glm::dvec3>(
+      [](int32 i) { return glm::dvec3(i * 0.5, i * 0.25, i * 0.125); });
+  const std::vector<glm::vec4> vec4s = createValues<glm::vec4>(
+      [](int32 i) { return glm::vec4(float(i), 1.0f, 2.0f, 3.0f); });
+
+  report(TEXT("vec2 -> FVector3f"), measureConversion(vec2s, FVector3f(0.0f)));
+  report(TEXT("ivec3 -> FIntPoint"), measureConversion(ivec3s, FIntPoint(0)));
+  report(TEXT("dvec3 -> FVector"), measureConversion(dvec3s, FVector(0.0)));
+  report(TEXT("vec4 -> FVector2D"), measureConversion(vec4s, FVector2D(0.0)));
+
+  // Strings
+  const std::vector<std::string> intStrings = createValues<std::string>(
+      [](int32 i) { return std::to_string(i * 37 - 1000000); });
+  const std::vector<std::string> doubleStrings = createValues<std::string>(
+      [](int32 i) { return std::to_string(double(i) * 1.0e-3); });
+  const std::vector<std::string> boolStrings = createValues<std::string>(
+      [](int32 i) { return std::string(i % 2 ? "true" : "no"); });
+  const std::vector<std::string> vectorStrings =
+      createValues<std::string>([](int32 i) {
+        return "X=" + std::to_string(i) + " Y=1.5 Z=" + std::to_string(-i);
+      });
+
+  report(
+      TEXT("string -> int32"),
+      measureConversion(createStringViews(intStrings), int32_t(0)));
+  report(
+      TEXT("string -> double"),
+      measureConversion(createStringViews(doubleStrings), 0.0));
+  report(
+      TEXT("string -> bool"),
+      measureConversion(createStringViews(boolStrings), false));
+  report(
+      TEXT("string -> FVector"),
+      measureConversion(createStringViews(vectorStrings), FVector(0.0)));
+  report(
+      TEXT("string -> FString"),
+      measureConversion(createStringViews(intStrings), FString()));
+  report(TEXT("int32 -> FString"), measureConversion(int32s, FString()));
+  report(TEXT("double -> FString"), measureConversion(doubles, FString()));
+  report(TEXT("vec4 -> FString"), measureConversion(vec4s, FString()));
+
+  // Arrays, whose elements are each converted to the type the caller asks
+  // for, through the Blueprint libraries.
+  std::vector<int16_t> arrayValues = createValues<int16_t>(
+      [](int32 i) { return int16_t(i % 30000 - 15000); });
+  const FCesiumPropertyArray array(
+      PropertyArrayView<int16_t>(std::move(arrayValues)));
+
+  report(
+      TEXT("array<int16> element -> double"),
+      measure([&array](int32 i) {
+        FCesiumMetadataValue value =
+            UCesiumPropertyArrayBlueprintLibrary::GetValue(array, i);
+        return UCesiumMetadataValueBlueprintLibrary::GetFloat64(value, 0.0);
+      }));
+  report(
+      TEXT("array<int16> element -> int64"),
+      measure([&array](int32 i) {
+        FCesiumMetadataValue value =
+            UCesiumPropertyArrayBlueprintLibrary::GetValue(array, i);
+        return double(
+            UCesiumMetadataValueBlueprintLibrary::GetInteger64(value, 0));
+      }));
+  report(
+      TEXT("array<int16> element -> FString"),
+      measure([&array](int32 i) {
+        FCesiumMetadataValue value =
+            UCesiumPropertyArrayBlueprintLibrary::GetValue(array, i);
+        return checksum(
+            UCesiumMetadataValueBlueprintLibrary::GetString(value, ""));
+      }));
+
+  // The checksum is only logged so that it's used.
+  UE_LOG(
+      LogCesium,
+      Verbose,
+      TEXT("Metadata conversion checksum: %f"),
+      total);
+
+  return true;
+}
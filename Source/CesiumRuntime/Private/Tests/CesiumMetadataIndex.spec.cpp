@@ -0,0 +1,136 @@
+#include "CesiumMetadataIndex.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMetadataIndexSpec,
+    "Cesium.Unit.MetadataIndex",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+TObjectPtr<UCesiumGltfComponent> pTile;
+TObjectPtr<UCesiumGltfComponent> pOtherTile;
+const std::vector<int32_t> floors{5, 25, 30, 10, 25};
+
+TArray<int64> getFeatureIDs(
+    const TArray<FCesiumFeatureHandle>& handles,
+    const UCesiumGltfComponent* pExpectedTile) {
+  TArray<int64> featureIDs;
+  for (const FCesiumFeatureHandle& handle : handles) {
+    if (handle.Tile == pExpectedTile) {
+      featureIDs.Add(handle.FeatureID);
+    }
+  }
+  featureIDs.Sort();
+  return featureIDs;
+}
+END_DEFINE_SPEC(FCesiumMetadataIndexSpec)
+
+void FCesiumMetadataIndexSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    ExtensionModelExtStructuralMetadata& metadata =
+        model.addExtension<ExtensionModelExtStructuralMetadata>();
+    metadata.schema.emplace();
+    metadata.schema->classes["building"];
+
+    PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+    propertyTable.name = "buildings";
+    propertyTable.classProperty = "building";
+    propertyTable.count = static_cast<int64_t>(floors.size());
+    AddPropertyTablePropertyToModel(
+        model,
+        propertyTable,
+        "floors",
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::INT32,
+        floors);
+
+    pTile = NewObject<UCesiumGltfComponent>();
+    pTile->Metadata = FCesiumModelMetadata(model, metadata);
+    pOtherTile = NewObject<UCesiumGltfComponent>();
+    pOtherTile->Metadata = FCesiumModelMetadata(model, metadata);
+  });
+
+  Describe("findInRange", [this]() {
+    It("finds the features with values in the range", [this]() {
+      CesiumMetadataIndex index;
+      index.addTile(*pTile);
+
+      TArray<int64> expected{1, 2, 4};
+      TestTrue(
+          "feature IDs",
+          getFeatureIDs(
+              index.findInRange("buildings", "floors", 20.0, 30.0),
+              pTile) == expected);
+      TestEqual("indexed properties", index.getIndexedPropertyCount(), 1);
+    });
+
+    It("finds nothing for properties that don't exist", [this]() {
+      CesiumMetadataIndex index;
+      index.addTile(*pTile);
+
+      TestTrue(
+          "other property",
+          index.findInRange("buildings", "height", 0.0, 100.0).IsEmpty());
+      TestTrue(
+          "other table",
+          index.findInRange("roads", "floors", 0.0, 100.0).IsEmpty());
+    });
+
+    It("indexes tiles as they're added and removed", [this]() {
+      CesiumMetadataIndex index;
+      index.addTile(*pTile);
+      TestEqual(
+          "before adding",
+          index.findInRange("buildings", "floors", 0.0, 100.0).Num(),
+          5);
+
+      index.addTile(*pOtherTile);
+      TArray<FCesiumFeatureHandle> handles =
+          index.findInRange("buildings", "floors", 0.0, 6.0);
+      TestTrue(
+          "first tile",
+          getFeatureIDs(handles, pTile) == TArray<int64>{0});
+      TestTrue(
+          "added tile",
+          getFeatureIDs(handles, pOtherTile) == TArray<int64>{0});
+
+      index.removeTile(*pTile);
+      handles = index.findInRange("buildings", "floors", 0.0, 6.0);
+      TestEqual("after removing", handles.Num(), 1);
+      TestTrue("remaining tile", handles[0].Tile == pOtherTile);
+    });
+
+    It("skips tiles that aren't shown", [this]() {
+      CesiumMetadataIndex index;
+      index.addTile(*pTile);
+      pTile->SetVisibility(false);
+
+      TestTrue(
+          "hidden",
+          index.findInRange("buildings", "floors", 0.0, 100.0).IsEmpty());
+    });
+  });
+
+  Describe("findEqual", [this]() {
+    It("finds the features with the parsed value", [this]() {
+      CesiumMetadataIndex index;
+      index.addTile(*pTile);
+
+      TArray<int64> expected{1, 4};
+      TestTrue(
+          "feature IDs",
+          getFeatureIDs(index.findEqual("buildings", "floors", "25"), pTile) ==
+              expected);
+      TestTrue(
+          "not a number",
+          index.findEqual("buildings", "floors", "tall").IsEmpty());
+    });
+  });
+}
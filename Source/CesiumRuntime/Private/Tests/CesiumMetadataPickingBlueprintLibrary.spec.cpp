@@ -177,6 +177,54 @@ void FCesiumMetadataPickingSpec::Define() {
           UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(Hit, 0, UV));
       TestEqual("UV at point", UV, FVector2D(0, 1));
     });
+
+    It("finds UVs for batches of hits", [this]() {
+      TArray<FHitResult> Hits;
+      Hits.SetNum(4);
+      Hits[0].Location = FVector_NetQuantize(0, -1, 0);
+      Hits[0].FaceIndex = 0;
+      Hits[0].Component = pPrimitiveComponent;
+      Hits[1].Location = FVector_NetQuantize(0, -0.5, 0);
+      Hits[1].FaceIndex = 0;
+      Hits[1].Component = pPrimitiveComponent;
+      Hits[2].Location = FVector_NetQuantize(0, -1, 0);
+      Hits[2].FaceIndex = 0;
+      Hits[2].Component = nullptr;
+      Hits[3].Location = FVector_NetQuantize(0, -4, 0);
+      Hits[3].FaceIndex = 1;
+      Hits[3].Component = pPrimitiveComponent;
+
+      for (bool cacheTriangles : {false, true}) {
+        TArray<FVector2D> UVs;
+        TArray<bool> found =
+            UCesiumMetadataPickingBlueprintLibrary::FindUVsFromHits(
+                Hits,
+                0,
+                UVs,
+                cacheTriangles);
+        TestEqual("number of results", found.Num(), Hits.Num());
+        TestEqual("number of UVs", UVs.Num(), Hits.Num());
+        if (found.Num() != Hits.Num() || UVs.Num() != Hits.Num()) {
+          return;
+        }
+
+        TestTrue("found first hit", found[0]);
+        TestEqual("UV at first hit", UVs[0], FVector2D(0, 1));
+        TestTrue("found second hit", found[1]);
+        TestTrue("UV at second hit", UVs[1].Equals(FVector2D(0, 0.5), 1e-6));
+        TestFalse("found hit without component", found[2]);
+        TestTrue("found fourth hit", found[3]);
+        TestEqual("UV at fourth hit", UVs[3], FVector2D(0, 1));
+
+        TestFalse(
+            "batch with nonexistent texcoord set found hit",
+            UCesiumMetadataPickingBlueprintLibrary::FindUVsFromHits(
+                Hits,
+                1,
+                UVs,
+                cacheTriangles)[0]);
+      }
+    });
   });
 
   Describe("GetPropertyTableValuesFromHit", [this]() {
@@ -160,6 +160,59 @@ void FCesiumOriginShiftComponentSpec::Define() {
           GEditor->RequestEndPlayMap();
         });
       });
+
+  Describe(
+      "shifts origin by changing the world origin when mode is ChangeWorldOriginLocation",
+      [this]() {
+        LatentBeforeEach(
+            EAsyncExecution::TaskGraphMainThread,
+            [this](const FDoneDelegate& done) {
+              subscriptionPostPIEStarted =
+                  FEditorDelegates::PostPIEStarted.AddLambda(
+                      [done](bool isSimulating) { done.Execute(); });
+              FRequestPlaySessionParams params{};
+              GEditor->RequestPlaySession(params);
+            });
+        BeforeEach(EAsyncExecution::TaskGraphMainThread, [this]() {
+          FEditorDelegates::PostPIEStarted.Remove(subscriptionPostPIEStarted);
+
+          findInPlay(pGeoreference)
+              ->SetOriginLongitudeLatitudeHeight(FVector(0.0, 0.0, 0.0));
+
+          // Activate world origin shifting
+          findInPlay(pOriginShiftComponent)
+              ->SetMode(ECesiumOriginShiftMode::ChangeWorldOriginLocation);
+
+          findInPlay(pOriginShiftActor)
+              ->SetActorLocation(FVector(100000.0, 200000.0, 300.0));
+        });
+        It("", [this]() {
+          AActor* pActor = findInPlay(pOriginShiftActor);
+          TestTrue(
+              "world origin",
+              pActor->GetWorld()->OriginLocation ==
+                  FIntVector(100000, 200000, 300));
+          TestTrue(
+              "location",
+              pActor->GetActorLocation().Equals(FVector::Zero(), 1.0));
+
+          // The globe position is unaffected by the world origin shift.
+          UCesiumGlobeAnchorComponent* pGlobeAnchor =
+              pActor->FindComponentByClass<UCesiumGlobeAnchorComponent>();
+          FVector expectedLLH =
+              findInPlay(pGeoreference)
+                  ->TransformUnrealPositionToLongitudeLatitudeHeight(
+                      FVector(100000.0, 200000.0, 300.0));
+          TestTrue(
+              "globe position",
+              pGlobeAnchor->GetLongitudeLatitudeHeight().Equals(
+                  expectedLLH,
+                  1e-6));
+        });
+        AfterEach(EAsyncExecution::TaskGraphMainThread, [this]() {
+          GEditor->RequestEndPlayMap();
+        });
+      });
 }
 
 #endif // #if WITH_EDITOR
@@ -0,0 +1,174 @@
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/GeographicProjection.h"
+#include "CesiumGeospatial/WebMercatorProjection.h"
+#include "CesiumOverlayTextureCoordinates.h"
+#include "Misc/AutomationTest.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumOverlayTextureCoordinates;
+
+namespace {
+// The same as CesiumComputeOverlayUV in CesiumOverlayUVs.ush, in single
+// precision like the shader.
+FVector2f computeOverlayUV(
+    const FVector3f& localPosition,
+    const MaterialParameters& parameters) {
+  const FVector4f position(localPosition, 1.0f);
+  const FVector3f offset(
+      Dot4(FVector4f(parameters.localToEcefRows[0]), position),
+      Dot4(FVector4f(parameters.localToEcefRows[1]), position),
+      Dot4(FVector4f(parameters.localToEcefRows[2]), position));
+  const FVector4f origin(parameters.origin);
+  const FVector4f ellipsoid(parameters.ellipsoid);
+  const FVector4f projection(parameters.projection);
+  const FVector2f center(origin.X, origin.Y);
+  const FVector2f offsetXY(offset.X, offset.Y);
+
+  const float deltaLongitude = FMath::Atan2(
+      center.X * offset.Y - center.Y * offset.X,
+      center.Dot(center + offsetXY));
+
+  const float k0 = ellipsoid.X;
+  const float latitude0 = ellipsoid.Y;
+  const float rho0 = FMath::Max(center.Length(), 1.0f);
+  const float deltaRho =
+      (2.0f * center.Dot(offsetXY) + offsetXY.Dot(offsetXY)) /
+      ((center + offsetXY).Length() + rho0);
+  const FVector3f up0(
+      FMath::Cos(latitude0) * center.X / rho0,
+      FMath::Cos(latitude0) * center.Y / rho0,
+      FMath::Sin(latitude0));
+  const float deltaHeight = up0.Dot(offset);
+  const float deltaK = ellipsoid.W * deltaHeight /
+                       (ellipsoid.Z * (ellipsoid.Z + deltaHeight));
+  const float k = k0 + deltaK;
+  const float rho = rho0 + deltaRho;
+  const float deltaLatitude = FMath::Atan2(
+      k0 * rho0 * offset.Z - origin.Z * (k0 * deltaRho + deltaK * rho),
+      k * rho * k0 * rho0 + (origin.Z + offset.Z) * origin.Z);
+
+  float deltaY = deltaLatitude;
+  if (origin.W > 0.5f) {
+    const float sin0 = FMath::Sin(latitude0);
+    const float sin1 = FMath::Sin(latitude0 + deltaLatitude);
+    const float deltaSin = 2.0f * FMath::Cos(latitude0 + 0.5f * deltaLatitude) *
+                           FMath::Sin(0.5f * deltaLatitude);
+    const float ratio = deltaSin / (1.0f - sin0 * sin1);
+    deltaY = 0.5f * FMath::Loge((1.0f + ratio) / (1.0f - ratio));
+  }
+
+  return FVector2f(
+      projection.X + deltaLongitude * projection.Z,
+      projection.Y + deltaY * projection.W);
+}
+
+// The overlay texture coordinates that Cesium Native computes for a vertex.
+FVector2D computeExpectedUV(
+    const glm::dvec3& ecef,
+    const TileProjection& projection) {
+  const glm::dvec3 projected = projectPosition(
+      projection.projection,
+      *Ellipsoid::WGS84.cartesianToCartographic(ecef));
+  return FVector2D(
+      (projected.x - projection.rectangle.minimumX) /
+          projection.rectangle.computeWidth(),
+      (projected.y - projection.rectangle.minimumY) /
+          projection.rectangle.computeHeight());
+}
+
+TileProjection createTileProjection(
+    const Projection& projection,
+    const Cartographic& center,
+    double size) {
+  const glm::dvec3 southwest = projectPosition(
+      projection,
+      Cartographic(
+          center.longitude - size,
+          center.latitude - size,
+          center.height));
+  const glm::dvec3 northeast = projectPosition(
+      projection,
+      Cartographic(
+          center.longitude + size,
+          center.latitude + size,
+          center.height));
+  return TileProjection{
+      Ellipsoid::WGS84.cartographicToCartesian(center),
+      projection,
+      Rectangle(southwest.x, southwest.y, northeast.x, northeast.y)};
+}
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumOverlayTextureCoordinatesSpec,
+    "Cesium.Unit.OverlayTextureCoordinates",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+void testProjection(const Projection& projection, double tileSize);
+END_DEFINE_SPEC(FCesiumOverlayTextureCoordinatesSpec)
+
+void FCesiumOverlayTextureCoordinatesSpec::testProjection(
+    const Projection& projection,
+    double tileSize) {
+  const Cartographic center = Cartographic::fromDegrees(10.0, 45.0, 300.0);
+  const TileProjection tileProjection =
+      createTileProjection(projection, center, tileSize);
+
+  // Tiles are usually positioned with a translation, and their vertices are
+  // relative to a nearby origin.
+  const glm::dvec3 localOrigin =
+      tileProjection.center + glm::dvec3(100.0, -200.0, 50.0);
+  const glm::dmat4 localToEcef =
+      glm::translate(glm::dmat4(1.0), localOrigin);
+
+  const std::optional<MaterialParameters> maybeParameters =
+      computeMaterialParameters(localToEcef, tileProjection);
+  if (!TestTrue("parameters", maybeParameters.has_value())) {
+    return;
+  }
+
+  // Nearly every offset is inside the tile, including ones far above and
+  // below the ellipsoid.
+  const double extent = tileSize * Ellipsoid::WGS84.getMaximumRadius();
+  const glm::dvec3 offsets[] = {
+      glm::dvec3(0.0, 0.0, 0.0),
+      glm::dvec3(0.3 * extent, -0.2 * extent, 0.1 * extent),
+      glm::dvec3(-0.4 * extent, 0.1 * extent, -0.3 * extent),
+      glm::dvec3(0.1 * extent, 0.4 * extent, 0.2 * extent) +
+          2000.0 * Ellipsoid::WGS84.geodeticSurfaceNormal(center)};
+  for (const glm::dvec3& offset : offsets) {
+    const FVector2D expected = computeExpectedUV(
+        tileProjection.center + offset,
+        tileProjection);
+    const glm::dvec3 local = tileProjection.center + offset - localOrigin;
+    const FVector2f actual = computeOverlayUV(
+        FVector3f(float(local.x), float(local.y), float(local.z)),
+        *maybeParameters);
+    TestEqual("u", double(actual.X), expected.X, 1e-4);
+    TestEqual("v", double(actual.Y), expected.Y, 1e-4);
+  }
+}
+
+void FCesiumOverlayTextureCoordinatesSpec::Define() {
+  It("matches geographic texture coordinates", [this]() {
+    this->testProjection(GeographicProjection(), 1e-4);
+    this->testProjection(GeographicProjection(), 1e-2);
+  });
+
+  It("matches Web Mercator texture coordinates", [this]() {
+    this->testProjection(WebMercatorProjection(), 1e-4);
+    this->testProjection(WebMercatorProjection(), 1e-2);
+  });
+
+  It("has no parameters for a tile at the center of the ellipsoid", [this]() {
+    const TileProjection projection{
+        glm::dvec3(0.0),
+        GeographicProjection(),
+        Rectangle(0.0, 0.0, 1.0, 1.0)};
+    TestFalse(
+        "parameters",
+        computeMaterialParameters(glm::dmat4(1.0), projection).has_value());
+  });
+}
@@ -0,0 +1,190 @@
+#include "CesiumPolygonRasterizer.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGeometry;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPolygonRasterizerSpec,
+    "Cesium.Unit.PolygonRasterizer",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumPolygonRasterizerSpec)
+
+void FCesiumPolygonRasterizerSpec::Define() {
+  Describe("findPolygons", [this]() {
+    It("finds only the polygons near the rectangle", [this]() {
+      std::vector<std::vector<glm::dvec2>> polygons;
+      for (int32_t i = 0; i < 16; ++i) {
+        const double x = double(i);
+        polygons.push_back(
+            {glm::dvec2(x, 0.0), glm::dvec2(x + 0.5, 0.0), glm::dvec2(x, 0.5)});
+      }
+      polygons.push_back({glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 1.0)});
+
+      CesiumPolygonRasterizer rasterizer(polygons);
+      const std::vector<uint32_t> found =
+          rasterizer.findPolygons(Rectangle(2.75, 0.25, 4.25, 1.0));
+      TestEqual("count", found.size(), size_t(2));
+      if (found.size() == 2) {
+        TestEqual("first", found[0], uint32_t(3));
+        TestEqual("second", found[1], uint32_t(4));
+      }
+    });
+  });
+
+  Describe("classify", [this]() {
+    It("classifies rectangles inside, across, and outside", [this]() {
+      CesiumPolygonRasterizer rasterizer({{
+          glm::dvec2(0.0, 0.0),
+          glm::dvec2(4.0, 0.0),
+          glm::dvec2(4.0, 4.0),
+          glm::dvec2(0.0, 4.0),
+      }});
+
+      TestEqual(
+          "inside",
+          rasterizer.classify(Rectangle(1.0, 1.0, 2.0, 2.0)),
+          CesiumPolygonRasterizer::Coverage::Inside);
+      TestEqual(
+          "across",
+          rasterizer.classify(Rectangle(3.0, 1.0, 5.0, 2.0)),
+          CesiumPolygonRasterizer::Coverage::Partial);
+      TestEqual(
+          "outside",
+          rasterizer.classify(Rectangle(5.0, 5.0, 6.0, 6.0)),
+          CesiumPolygonRasterizer::Coverage::Outside);
+    });
+
+    It("finds rectangles that only cross horizontal edges", [this]() {
+      CesiumPolygonRasterizer rasterizer({{
+          glm::dvec2(0.0, 0.0),
+          glm::dvec2(3.0, 0.0),
+          glm::dvec2(3.0, 1.5),
+          glm::dvec2(0.0, 1.5),
+      }});
+
+      TestEqual(
+          "across",
+          rasterizer.classify(Rectangle(1.0, 1.0, 2.0, 2.0)),
+          CesiumPolygonRasterizer::Coverage::Partial);
+    });
+
+    It("is outside when a polygon's bounds only overlap", [this]() {
+      // A triangle whose bounds cover the rectangle, but whose hypotenuse
+      // keeps it away.
+      CesiumPolygonRasterizer rasterizer({{
+          glm::dvec2(0.0, 0.0),
+          glm::dvec2(4.0, 0.0),
+          glm::dvec2(0.0, 4.0),
+      }});
+
+      TestEqual(
+          "outside",
+          rasterizer.classify(Rectangle(3.0, 3.0, 4.0, 4.0)),
+          CesiumPolygonRasterizer::Coverage::Outside);
+    });
+  });
+
+  Describe("rasterize", [this]() {
+    It("fills the pixels inside a polygon", [this]() {
+      // A square covering the middle two of four columns and the top two of
+      // four rows.
+      CesiumPolygonRasterizer rasterizer({{
+          glm::dvec2(1.0, 2.0),
+          glm::dvec2(3.0, 2.0),
+          glm::dvec2(3.0, 4.0),
+          glm::dvec2(1.0, 4.0),
+      }});
+
+      uint8_t pixels[16];
+      TestTrue(
+          "overlaps",
+          rasterizer
+              .rasterize(Rectangle(0.0, 0.0, 4.0, 4.0), 4, 4, 1, 0, pixels));
+      const uint8_t expected[16] =
+          {0, 1, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+      for (int32_t i = 0; i < 16; ++i) {
+        TestEqual("pixel", pixels[i], expected[i]);
+      }
+    });
+
+    It("leaves the holes of concave polygons outside", [this]() {
+      // A U shape, open to the north.
+      CesiumPolygonRasterizer rasterizer({{
+          glm::dvec2(0.0, 0.0),
+          glm::dvec2(3.0, 0.0),
+          glm::dvec2(3.0, 3.0),
+          glm::dvec2(2.0, 3.0),
+          glm::dvec2(2.0, 1.0),
+          glm::dvec2(1.0, 1.0),
+          glm::dvec2(1.0, 3.0),
+          glm::dvec2(0.0, 3.0),
+      }});
+
+      uint8_t pixels[9];
+      rasterizer.rasterize(Rectangle(0.0, 0.0, 3.0, 3.0), 3, 3, 1, 0, pixels);
+      const uint8_t expected[9] = {1, 0, 1, 1, 0, 1, 1, 1, 1};
+      for (int32_t i = 0; i < 9; ++i) {
+        TestEqual("pixel", pixels[i], expected[i]);
+      }
+    });
+
+    It("sets every pixel outside when no polygon overlaps", [this]() {
+      CesiumPolygonRasterizer rasterizer({{
+          glm::dvec2(10.0, 10.0),
+          glm::dvec2(11.0, 10.0),
+          glm::dvec2(11.0, 11.0),
+      }});
+
+      uint8_t pixels[4] = {9, 9, 9, 9};
+      TestFalse(
+          "overlaps",
+          rasterizer
+              .rasterize(Rectangle(0.0, 0.0, 1.0, 1.0), 2, 2, 1, 7, pixels));
+      for (int32_t i = 0; i < 4; ++i) {
+        TestEqual("pixel", pixels[i], uint8_t(7));
+      }
+    });
+  });
+
+  Describe("CesiumPreparedPolygon", [this]() {
+    It("ignores polygons with fewer than three vertices", [this]() {
+      TestNull(
+          "prepared",
+          CesiumPreparedPolygon::prepare(
+              {glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 1.0)})
+              .get());
+    });
+
+    It("is shared by rasterizers that are rebuilt", [this]() {
+      std::shared_ptr<const CesiumPreparedPolygon> pUnchanged =
+          CesiumPreparedPolygon::prepare(
+              {glm::dvec2(0.0, 0.0),
+               glm::dvec2(1.0, 0.0),
+               glm::dvec2(1.0, 1.0),
+               glm::dvec2(0.0, 1.0)});
+      std::shared_ptr<const CesiumPreparedPolygon> pMoved =
+          CesiumPreparedPolygon::prepare(
+              {glm::dvec2(2.0, 0.0),
+               glm::dvec2(3.0, 0.0),
+               glm::dvec2(3.0, 1.0),
+               glm::dvec2(2.0, 1.0)});
+
+      CesiumPolygonRasterizer before({pUnchanged, nullptr});
+      CesiumPolygonRasterizer after({pUnchanged, pMoved});
+
+      TestEqual(
+          "before",
+          before.findPolygons(Rectangle(0.0, 0.0, 4.0, 1.0)).size(),
+          size_t(1));
+      TestEqual(
+          "after",
+          after.findPolygons(Rectangle(0.0, 0.0, 4.0, 1.0)).size(),
+          size_t(2));
+      TestEqual(
+          "inside moved polygon",
+          after.classify(Rectangle(2.25, 0.25, 2.75, 0.75)),
+          CesiumPolygonRasterizer::Coverage::Inside);
+    });
+  });
+}
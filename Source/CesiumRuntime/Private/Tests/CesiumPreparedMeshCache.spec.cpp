@@ -0,0 +1,136 @@
+#include "CesiumPreparedMeshCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "StaticMeshResources.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPreparedMeshCacheSpec,
+    "Cesium.Unit.PreparedMeshCache",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+FString directory;
+
+TUniquePtr<FStaticMeshRenderData> createTriangle() {
+  TUniquePtr<FStaticMeshRenderData> pRenderData =
+      MakeUnique<FStaticMeshRenderData>();
+  pRenderData->AllocateLODResources(1);
+  pRenderData->Bounds.SphereRadius = 2.0f;
+
+  FStaticMeshLODResources& lod = pRenderData->LODResources[0];
+  lod.VertexBuffers.PositionVertexBuffer.Init(3, false);
+  lod.VertexBuffers.PositionVertexBuffer.VertexPosition(0) =
+      FVector3f(0.0f, 0.0f, 0.0f);
+  lod.VertexBuffers.PositionVertexBuffer.VertexPosition(1) =
+      FVector3f(1.0f, 0.0f, 0.0f);
+  lod.VertexBuffers.PositionVertexBuffer.VertexPosition(2) =
+      FVector3f(0.0f, 1.0f, 0.0f);
+
+  lod.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(true);
+  lod.VertexBuffers.StaticMeshVertexBuffer.Init(3, 1, false);
+  for (uint32 i = 0; i < 3; ++i) {
+    lod.VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(
+        i,
+        FVector3f(1.0f, 0.0f, 0.0f),
+        FVector3f(0.0f, 1.0f, 0.0f),
+        FVector3f(0.0f, 0.0f, 1.0f));
+    lod.VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(
+        i,
+        0,
+        FVector2f(float(i), 0.5f));
+  }
+
+  lod.IndexBuffer.SetIndices(
+      TArray<uint32>{0, 1, 2},
+      EIndexBufferStride::Type::Force16Bit);
+  return pRenderData;
+}
+END_DEFINE_SPEC(FCesiumPreparedMeshCacheSpec)
+
+void FCesiumPreparedMeshCacheSpec::Define() {
+  BeforeEach([this]() {
+    directory = FPaths::Combine(
+        FPaths::ProjectIntermediateDir(),
+        TEXT("CesiumPreparedMeshCacheSpec"));
+    IFileManager::Get().DeleteDirectory(*directory, false, true);
+    IFileManager::Get().MakeDirectory(*directory, true);
+  });
+
+  AfterEach([this]() {
+    IFileManager::Get().DeleteDirectory(*directory, false, true);
+  });
+
+  It("reads back the render data that was added", [this]() {
+    CesiumPreparedMeshCache cache(directory, 1024 * 1024);
+    TUniquePtr<FStaticMeshRenderData> pAdded = createTriangle();
+    cache.add(42, *pAdded);
+
+    FStaticMeshRenderData found;
+    found.AllocateLODResources(1);
+    TestTrue("found", cache.find(42, found));
+    TestEqual("hits", cache.getHitCount(), int64(1));
+
+    const FStaticMeshLODResources& lod = found.LODResources[0];
+    TestEqual("sphere radius", found.Bounds.SphereRadius, 2.0f);
+    TestFalse("colors", lod.bHasColorVertexData);
+    TestEqual(
+        "vertices",
+        lod.VertexBuffers.PositionVertexBuffer.GetNumVertices(),
+        3u);
+    TestEqual(
+        "position",
+        lod.VertexBuffers.PositionVertexBuffer.VertexPosition(1),
+        FVector3f(1.0f, 0.0f, 0.0f));
+    TestEqual(
+        "uv",
+        lod.VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(2, 0),
+        FVector2f(2.0f, 0.5f));
+
+    TArray<uint32> indices;
+    lod.IndexBuffer.GetCopy(indices);
+    TestEqual("indices", indices, TArray<uint32>{0, 1, 2});
+  });
+
+  It("misses a key that wasn't added", [this]() {
+    CesiumPreparedMeshCache cache(directory, 1024 * 1024);
+    FStaticMeshRenderData found;
+    found.AllocateLODResources(1);
+    TestFalse("found", cache.find(7, found));
+    TestEqual("misses", cache.getMissCount(), int64(1));
+  });
+
+  It("deletes a corrupted file and misses it", [this]() {
+    CesiumPreparedMeshCache cache(directory, 1024 * 1024);
+    TUniquePtr<FStaticMeshRenderData> pAdded = createTriangle();
+    cache.add(42, *pAdded);
+
+    TArray<FString> filenames;
+    IFileManager::Get().FindFiles(filenames, *directory, TEXT("mesh"));
+    TestEqual("files", filenames.Num(), 1);
+    if (filenames.Num() != 1) {
+      return;
+    }
+
+    const FString filename = FPaths::Combine(directory, filenames[0]);
+    TArray<uint8> bytes;
+    FFileHelper::LoadFileToArray(bytes, *filename);
+    bytes.Last() ^= 0xff;
+    FFileHelper::SaveArrayToFile(bytes, *filename);
+
+    FStaticMeshRenderData found;
+    found.AllocateLODResources(1);
+    TestFalse("found", cache.find(42, found));
+    TestFalse("exists", IFileManager::Get().FileExists(*filename));
+  });
+
+  It("does nothing when its maximum size is zero", [this]() {
+    CesiumPreparedMeshCache cache(directory, 0);
+    TUniquePtr<FStaticMeshRenderData> pAdded = createTriangle();
+    cache.add(42, *pAdded);
+
+    FStaticMeshRenderData found;
+    found.AllocateLODResources(1);
+    TestFalse("found", cache.find(42, found));
+  });
+}
@@ -0,0 +1,189 @@
+#include "CesiumPrimitiveMerging.h"
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+namespace {
+// Adds a node with its own mesh, which has one triangle, to the scene.
+MeshPrimitive& addTriangleNode(
+    Model& model,
+    int32_t material,
+    const std::vector<double>& translation) {
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  primitive.material = material;
+
+  Node& node = model.nodes.emplace_back();
+  node.mesh = int32_t(model.meshes.size() - 1);
+  node.translation = translation;
+  model.scenes[0].nodes.push_back(int32_t(model.nodes.size() - 1));
+
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      std::vector<glm::vec3>{
+          glm::vec3(0.0f, 0.0f, 0.0f),
+          glm::vec3(1.0f, 0.0f, 0.0f),
+          glm::vec3(0.0f, 1.0f, 0.0f)});
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_SHORT,
+      std::vector<uint16_t>{0, 1, 2});
+
+  return primitive;
+}
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPrimitiveMergingSpec,
+    "Cesium.Unit.PrimitiveMerging",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+END_DEFINE_SPEC(FCesiumPrimitiveMergingSpec)
+
+void FCesiumPrimitiveMergingSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    model.scenes.emplace_back();
+    model.scene = 0;
+    model.materials.resize(2);
+  });
+
+  It("merges primitives with the same material", [this]() {
+    addTriangleNode(model, 0, {0.0, 0.0, 0.0});
+    addTriangleNode(model, 0, {10.0, 0.0, 0.0});
+
+    CesiumPrimitiveMerging::mergePrimitives(model);
+
+    TestEqual("meshes", model.meshes.size(), size_t(3));
+    TestTrue("first mesh removed", model.meshes[0].primitives.empty());
+    TestTrue("second mesh removed", model.meshes[1].primitives.empty());
+    TestEqual("scene nodes", model.scenes[0].nodes.size(), size_t(3));
+
+    const Mesh& merged = model.meshes[2];
+    if (!TestEqual("merged primitives", merged.primitives.size(), size_t(1))) {
+      return;
+    }
+    const MeshPrimitive& primitive = merged.primitives[0];
+    TestTrue(
+        "isMergedPrimitive",
+        CesiumPrimitiveMerging::isMergedPrimitive(primitive));
+
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    AccessorView<uint32_t> indices(model, primitive.indices);
+    if (!TestEqual("positions", positions.size(), int64_t(6)) ||
+        !TestEqual("indices", indices.size(), int64_t(6))) {
+      return;
+    }
+    TestEqual("translated", positions[4].x, 11.0f);
+    TestEqual("second triangle", indices[3], uint32_t(3));
+
+    int64_t meshIndex = -1;
+    int64_t primitiveIndex = -1;
+    TestTrue(
+        "findSourcePrimitive",
+        CesiumPrimitiveMerging::findSourcePrimitive(
+            primitive,
+            1,
+            meshIndex,
+            primitiveIndex));
+    TestEqual("meshIndex", meshIndex, int64_t(1));
+    TestEqual("primitiveIndex", primitiveIndex, int64_t(0));
+    TestFalse(
+        "out of bounds",
+        CesiumPrimitiveMerging::findSourcePrimitive(
+            primitive,
+            -1,
+            meshIndex,
+            primitiveIndex));
+  });
+
+  It("doesn't merge primitives with different materials", [this]() {
+    addTriangleNode(model, 0, {0.0, 0.0, 0.0});
+    addTriangleNode(model, 1, {10.0, 0.0, 0.0});
+
+    CesiumPrimitiveMerging::mergePrimitives(model);
+
+    TestEqual("meshes", model.meshes.size(), size_t(2));
+    TestEqual("first mesh", model.meshes[0].primitives.size(), size_t(1));
+    TestEqual("second mesh", model.meshes[1].primitives.size(), size_t(1));
+  });
+
+  It("doesn't merge meshes that are used by more than one node", [this]() {
+    addTriangleNode(model, 0, {0.0, 0.0, 0.0});
+    Node& node = model.nodes.emplace_back();
+    node.mesh = 0;
+    model.scenes[0].nodes.push_back(int32_t(model.nodes.size() - 1));
+    addTriangleNode(model, 0, {10.0, 0.0, 0.0});
+
+    CesiumPrimitiveMerging::mergePrimitives(model);
+
+    TestEqual("meshes", model.meshes.size(), size_t(2));
+  });
+
+  It("keeps the feature IDs of merged primitives", [this]() {
+    MeshPrimitive& first = addTriangleNode(model, 0, {0.0, 0.0, 0.0});
+    AddFeatureIDsAsAttributeToModel(model, first, {0, 1, 1}, 2, 0);
+    MeshPrimitive& second = addTriangleNode(model, 0, {10.0, 0.0, 0.0});
+    AddFeatureIDsAsAttributeToModel(model, second, {2, 2, 2}, 1, 0);
+
+    CesiumPrimitiveMerging::mergePrimitives(model);
+
+    if (!TestEqual("meshes", model.meshes.size(), size_t(3))) {
+      return;
+    }
+    const MeshPrimitive& primitive = model.meshes[2].primitives[0];
+    const ExtensionExtMeshFeatures* pFeatures =
+        primitive.getExtension<ExtensionExtMeshFeatures>();
+    if (!TestNotNull("EXT_mesh_features", pFeatures) ||
+        !TestEqual("featureIds", pFeatures->featureIds.size(), size_t(1))) {
+      return;
+    }
+    TestEqual(
+        "featureCount",
+        pFeatures->featureIds[0].featureCount,
+        int64_t(3));
+
+    AccessorView<float> featureIds(
+        model,
+        primitive.attributes.at("_FEATURE_ID_0"));
+    if (TestEqual("feature ID count", featureIds.size(), int64_t(6))) {
+      TestEqual("first", featureIds[1], 1.0f);
+      TestEqual("second", featureIds[3], 2.0f);
+    }
+  });
+
+  It("remembers the indices of primitives that aren't merged", [this]() {
+    addTriangleNode(model, 0, {0.0, 0.0, 0.0});
+    MeshPrimitive& kept = model.meshes[0].primitives.emplace_back();
+    kept.mode = MeshPrimitive::Mode::POINTS;
+    kept.attributes = model.meshes[0].primitives[0].attributes;
+    addTriangleNode(model, 0, {10.0, 0.0, 0.0});
+
+    CesiumPrimitiveMerging::mergePrimitives(model);
+
+    if (!TestEqual(
+            "first mesh",
+            model.meshes[0].primitives.size(),
+            size_t(1))) {
+      return;
+    }
+    TestEqual(
+        "getSourcePrimitiveIndex",
+        CesiumPrimitiveMerging::getSourcePrimitiveIndex(
+            model.meshes[0].primitives[0],
+            0),
+        int64_t(1));
+  });
+}
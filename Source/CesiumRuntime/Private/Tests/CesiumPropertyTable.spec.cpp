@@ -664,6 +664,104 @@ void FCesiumPropertyTableSpec::Define() {
     });
   });
 
+  Describe("GetValueRefsForFeature", [this]() {
+    BeforeEach([this]() { pPropertyTable->classProperty = "testClass"; });
+
+    It("returns no values for out-of-bounds feature IDs", [this]() {
+      std::string scalarPropertyName("scalarProperty");
+      std::vector<int32_t> scalarValues{1, 2, 3, 4};
+      pPropertyTable->count = static_cast<int64_t>(scalarValues.size());
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          scalarPropertyName,
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::INT32,
+          scalarValues);
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+
+      TArray<FCesiumPropertyTableValueRef> values;
+      UCesiumPropertyTableBlueprintLibrary::GetValueRefsForFeature(
+          propertyTable,
+          -1,
+          values);
+      TestTrue("no values for negative feature ID", values.IsEmpty());
+
+      UCesiumPropertyTableBlueprintLibrary::GetValueRefsForFeature(
+          propertyTable,
+          static_cast<int64>(scalarValues.size()),
+          values);
+      TestTrue("no values for feature ID past the end", values.IsEmpty());
+    });
+
+    It("returns values of every property by index", [this]() {
+      std::string scalarPropertyName("scalarProperty");
+      std::vector<int32_t> scalarValues{1, 2, 3, 4};
+      pPropertyTable->count = static_cast<int64_t>(scalarValues.size());
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          scalarPropertyName,
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::INT32,
+          scalarValues);
+
+      std::string badPropertyName("badProperty");
+      std::vector<int8_t> badValues{0, 1, 2};
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          badPropertyName,
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::INT32,
+          badValues);
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+
+      const int32 scalarIndex =
+          UCesiumPropertyTableBlueprintLibrary::FindPropertyIndex(
+              propertyTable,
+              FString(scalarPropertyName.c_str()));
+      const int32 badIndex =
+          UCesiumPropertyTableBlueprintLibrary::FindPropertyIndex(
+              propertyTable,
+              FString(badPropertyName.c_str()));
+      TestNotEqual("scalar index", scalarIndex, int32(INDEX_NONE));
+      TestNotEqual("bad index", badIndex, int32(INDEX_NONE));
+      TestEqual(
+          "nonexistent index",
+          UCesiumPropertyTableBlueprintLibrary::FindPropertyIndex(
+              propertyTable,
+              FString("nonexistent")),
+          int32(INDEX_NONE));
+
+      TArray<FCesiumPropertyTableValueRef> values;
+      for (size_t i = 0; i < scalarValues.size(); i++) {
+        UCesiumPropertyTableBlueprintLibrary::GetValueRefsForFeature(
+            propertyTable,
+            static_cast<int64>(i),
+            values);
+        if (!TestEqual("number of values", values.Num(), 2)) {
+          return;
+        }
+
+        TestTrue("scalar has value", values[scalarIndex].HasValue());
+        TestEqual(
+            "scalar value",
+            values[scalarIndex].GetInteger(0),
+            scalarValues[i]);
+        TestEqual(
+            "scalar metadata value",
+            UCesiumMetadataValueBlueprintLibrary::GetInteger(
+                values[scalarIndex].GetValue(),
+                0),
+            scalarValues[i]);
+
+        TestFalse("bad property has no value", values[badIndex].HasValue());
+        TestEqual("bad property default", values[badIndex].GetInteger(-1), -1);
+      }
+    });
+  });
+
   Describe("GetMetadataValuesForFeatureAsStrings", [this]() {
     BeforeEach([this]() { pPropertyTable->classProperty = "testClass"; });
 
@@ -836,4 +934,79 @@ void FCesiumPropertyTableSpec::Define() {
       TestTrue("values map is empty", values.IsEmpty());
     });
   });
+
+  Describe("GetColumnAsArray", [this]() {
+    BeforeEach([this]() { pPropertyTable->classProperty = "testClass"; });
+
+    It("returns empty arrays for nonexistent property", [this]() {
+      std::vector<int32_t> values{1, 2, 3, 4};
+      pPropertyTable->count = static_cast<int64_t>(values.size());
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          "testProperty",
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::INT32,
+          values);
+
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      TestEqual(
+          "Integer array size",
+          UCesiumPropertyTableBlueprintLibrary::GetColumnAsIntegerArray(
+              propertyTable,
+              FString("nonexistent property"))
+              .Num(),
+          0);
+      TestEqual(
+          "Float array size",
+          UCesiumPropertyTableBlueprintLibrary::GetColumnAsFloatArray(
+              propertyTable,
+              FString("nonexistent property"))
+              .Num(),
+          0);
+    });
+
+    It("gets and converts all values of a property", [this]() {
+      std::string propertyName("testProperty");
+      std::vector<float> values{1.5f, -2.25f, 3.0f, 400.75f};
+      pPropertyTable->count = static_cast<int64_t>(values.size());
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          propertyName,
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::FLOAT32,
+          values);
+
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      const FString name(propertyName.c_str());
+      TArray<float> floats =
+          UCesiumPropertyTableBlueprintLibrary::GetColumnAsFloatArray(
+              propertyTable,
+              name);
+      TArray<int64> integers =
+          UCesiumPropertyTableBlueprintLibrary::GetColumnAsInteger64Array(
+              propertyTable,
+              name);
+      TestEqual("Float array size", floats.Num(), int32(values.size()));
+      TestEqual("Integer64 array size", integers.Num(), int32(values.size()));
+
+      const FCesiumPropertyTableProperty& property =
+          UCesiumPropertyTableBlueprintLibrary::FindProperty(
+              propertyTable,
+              name);
+      for (int32 i = 0; i < floats.Num() && i < integers.Num(); i++) {
+        TestEqual(
+            std::string("float" + std::to_string(i)).c_str(),
+            floats[i],
+            values[i]);
+        TestEqual(
+            std::string("integer" + std::to_string(i)).c_str(),
+            integers[i],
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetInteger64(
+                property,
+                i));
+      }
+    });
+  });
 }
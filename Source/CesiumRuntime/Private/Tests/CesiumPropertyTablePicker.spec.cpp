@@ -0,0 +1,189 @@
+#include "CesiumPropertyTablePicker.h"
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPropertyTablePickerSpec,
+    "Cesium.Unit.PropertyTablePicker",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+MeshPrimitive* pPrimitive;
+ExtensionExtMeshFeatures* pMeshFeatures;
+ExtensionModelExtStructuralMetadata* pModelMetadata;
+PropertyTable* pPropertyTable;
+TObjectPtr<UCesiumGltfComponent> pModelComponent;
+TObjectPtr<UCesiumGltfPrimitiveComponent> pPrimitiveComponent;
+const std::string scalarPropertyName = "scalarProperty";
+const std::string vec2PropertyName = "vec2Property";
+const std::vector<int32_t> scalarValues{1, 2};
+const std::vector<glm::vec2> vec2Values{
+    glm::vec2(1.0f, 2.5f),
+    glm::vec2(3.1f, -4.0f)};
+END_DEFINE_SPEC(FCesiumPropertyTablePickerSpec)
+
+void FCesiumPropertyTablePickerSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    Mesh& mesh = model.meshes.emplace_back();
+    pPrimitive = &mesh.primitives.emplace_back();
+
+    // Two disconnected triangles.
+    std::vector<glm::vec3> positions{
+        glm::vec3(-1, 1, 0),
+        glm::vec3(1, 1, 0),
+        glm::vec3(1, -1, 0),
+        glm::vec3(2, 2, 0),
+        glm::vec3(-2, 2, 0),
+        glm::vec3(-2, -2, 0),
+    };
+    std::vector<std::byte> positionData(positions.size() * sizeof(glm::vec3));
+    std::memcpy(positionData.data(), positions.data(), positionData.size());
+    CreateAttributeForPrimitive(
+        model,
+        *pPrimitive,
+        "POSITION",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        std::move(positionData));
+    int32_t positionAccessorIndex =
+        static_cast<int32_t>(model.accessors.size() - 1);
+
+    pMeshFeatures = &pPrimitive->addExtension<ExtensionExtMeshFeatures>();
+    pModelMetadata = &model.addExtension<ExtensionModelExtStructuralMetadata>();
+
+    std::string className = "testClass";
+    pModelMetadata->schema.emplace();
+    pModelMetadata->schema->classes[className];
+
+    pPropertyTable = &pModelMetadata->propertyTables.emplace_back();
+    pPropertyTable->classProperty = className;
+
+    std::vector<uint8_t> featureIDs{0, 0, 0, 1, 1, 1};
+    FeatureId& featureId =
+        AddFeatureIDsAsAttributeToModel(model, *pPrimitive, featureIDs, 2, 0);
+    featureId.propertyTable =
+        static_cast<int64_t>(pModelMetadata->propertyTables.size() - 1);
+
+    pPropertyTable->count = static_cast<int64_t>(scalarValues.size());
+    AddPropertyTablePropertyToModel(
+        model,
+        *pPropertyTable,
+        scalarPropertyName,
+        ClassProperty::Type::SCALAR,
+        ClassProperty::ComponentType::INT32,
+        scalarValues);
+    AddPropertyTablePropertyToModel(
+        model,
+        *pPropertyTable,
+        vec2PropertyName,
+        ClassProperty::Type::VEC2,
+        ClassProperty::ComponentType::FLOAT32,
+        vec2Values);
+
+    pModelComponent = NewObject<UCesiumGltfComponent>();
+    pPrimitiveComponent =
+        NewObject<UCesiumGltfPrimitiveComponent>(pModelComponent);
+    pPrimitiveComponent->AttachToComponent(
+        pModelComponent,
+        FAttachmentTransformRules(EAttachmentRule::KeepRelative, false));
+    pPrimitiveComponent->PositionAccessor =
+        AccessorView<FVector3f>(model, positionAccessorIndex);
+
+    pModelComponent->Metadata = FCesiumModelMetadata(model, *pModelMetadata);
+    pPrimitiveComponent->Features =
+        FCesiumPrimitiveFeatures(model, *pPrimitive, *pMeshFeatures);
+  });
+
+  It("returns empty values for invalid hits", [this]() {
+    FCesiumPropertyTablePicker picker({FString(scalarPropertyName.c_str())});
+
+    FHitResult Hit;
+    Hit.FaceIndex = -1;
+    Hit.Component = nullptr;
+
+    TArray<FCesiumMetadataValue> values;
+    values.SetNum(picker.Num());
+    TestFalse("found values", picker.GetValuesFromHit(Hit, values));
+    TestEqual(
+        "value type",
+        UCesiumMetadataValueBlueprintLibrary::GetValueType(
+            picker.GetValueFromHit(Hit, 0))
+            .Type,
+        ECesiumMetadataType::Invalid);
+
+    FCesiumPropertyTablePicker invalidSetPicker(
+        {FString(scalarPropertyName.c_str())},
+        1);
+    Hit.FaceIndex = 0;
+    Hit.Component = pPrimitiveComponent;
+    TestFalse(
+        "found values for invalid feature ID set",
+        invalidSetPicker.GetValuesFromHit(Hit, values));
+  });
+
+  It("gets values by handle", [this]() {
+    FCesiumPropertyTablePicker picker(
+        {FString(vec2PropertyName.c_str()),
+         FString("nonexistent property"),
+         FString(scalarPropertyName.c_str())});
+    TestEqual("number of handles", picker.Num(), 3);
+
+    const int32 scalarHandle =
+        picker.GetPropertyHandle(FString(scalarPropertyName.c_str()));
+    const int32 vec2Handle =
+        picker.GetPropertyHandle(FString(vec2PropertyName.c_str()));
+    TestEqual("scalar handle", scalarHandle, 2);
+    TestEqual("vec2 handle", vec2Handle, 0);
+    TestEqual(
+        "unknown handle",
+        picker.GetPropertyHandle(FString("unknown")),
+        INDEX_NONE);
+
+    FHitResult Hit;
+    Hit.Component = pPrimitiveComponent;
+
+    TArray<FCesiumMetadataValue> values;
+    values.SetNum(picker.Num());
+    for (size_t i = 0; i < scalarValues.size(); i++) {
+      Hit.FaceIndex = i;
+
+      TestEqual("feature ID", picker.GetFeatureIDFromHit(Hit), int64(i));
+      TestEqual(
+          "scalar value",
+          UCesiumMetadataValueBlueprintLibrary::GetInteger(
+              picker.GetValueFromHit(Hit, scalarHandle),
+              0),
+          scalarValues[i]);
+
+      TestTrue("found values", picker.GetValuesFromHit(Hit, values));
+      TestEqual(
+          "scalar value from values",
+          UCesiumMetadataValueBlueprintLibrary::GetInteger(
+              values[scalarHandle],
+              0),
+          scalarValues[i]);
+
+      FVector2D expected(
+          static_cast<double>(vec2Values[i][0]),
+          static_cast<double>(vec2Values[i][1]));
+      TestEqual(
+          "vec2 value from values",
+          UCesiumMetadataValueBlueprintLibrary::GetVector2D(
+              values[vec2Handle],
+              FVector2D::Zero()),
+          expected);
+      TestEqual(
+          "nonexistent property value type",
+          UCesiumMetadataValueBlueprintLibrary::GetValueType(values[1]).Type,
+          ECesiumMetadataType::Invalid);
+    }
+  });
+}
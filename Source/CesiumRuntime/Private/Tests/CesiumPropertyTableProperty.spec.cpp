@@ -4272,4 +4272,119 @@ void FCesiumPropertyTablePropertySpec::Define() {
       }
     });
   });
+
+  Describe("TCesiumPropertyColumn", [this]() {
+    It("returns default values for invalid property", [this]() {
+      FCesiumPropertyTableProperty property;
+      TCesiumPropertyColumn<int32> column(property);
+      TestEqual<int64>("size", column.Num(), 0);
+      TestEqual("value", column.Get(0, -1), -1);
+
+      TArray<int32> values;
+      values.SetNum(3);
+      column.GetValues(0, values, -1);
+      for (int32 i = 0; i < values.Num(); i++) {
+        TestEqual(
+            std::string("value" + std::to_string(i)).c_str(),
+            values[i],
+            -1);
+      }
+    });
+
+    It("gets range of values", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::INT32;
+
+      std::vector<int32_t> values{-1, 2, -3, 4};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<int32_t> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+      TCesiumPropertyColumn<int32> column(property);
+      TestEqual<int64>("size", column.Num(), values.size());
+
+      // Read one value past each end to check the out-of-range values.
+      TArray<int32> result;
+      result.SetNum(static_cast<int32>(values.size()) + 2);
+      column.GetValues(-1, result, 0);
+      TestEqual("negative index", result[0], 0);
+      for (size_t i = 0; i < values.size(); i++) {
+        TestEqual(
+            std::string("value" + std::to_string(i)).c_str(),
+            result[static_cast<int32>(i) + 1],
+            values[i]);
+      }
+      TestEqual("out-of-range positive index", result.Last(), 0);
+    });
+
+    It("gets values for feature IDs with conversion", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::FLOAT32;
+
+      std::vector<float> values{1.5f, -24.5f, 2456.8f};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<float> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+      TCesiumPropertyColumn<int32> column(property);
+
+      TArray<int64> featureIDs{2, 0, 10, 1};
+      TArray<int32> result;
+      result.SetNum(featureIDs.Num());
+      column.GetValues(featureIDs, result, -1);
+      for (int32 i = 0; i < featureIDs.Num(); i++) {
+        TestEqual(
+            std::string("value" + std::to_string(i)).c_str(),
+            result[i],
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetInteger(
+                property,
+                featureIDs[i],
+                -1));
+      }
+    });
+
+    It("gets range of raw values without transforms", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::UINT8;
+      classProperty.normalized = true;
+      classProperty.offset = 1.0;
+      classProperty.scale = 2.0;
+
+      std::vector<uint8_t> values{0, 12, 255};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<uint8_t, true> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+      TCesiumPropertyColumn<uint8> column(property);
+
+      TArray<uint8> result;
+      result.SetNum(static_cast<int32>(values.size()) + 1);
+      column.GetRawValues(0, result, 7);
+      for (size_t i = 0; i < values.size(); i++) {
+        TestEqual(
+            std::string("value" + std::to_string(i)).c_str(),
+            result[static_cast<int32>(i)],
+            values[i]);
+      }
+      TestEqual("out-of-range index", result.Last(), uint8(7));
+    });
+  });
 }
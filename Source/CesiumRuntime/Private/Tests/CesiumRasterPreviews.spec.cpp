@@ -0,0 +1,77 @@
+#include "CesiumRasterPreviews.h"
+#include "CesiumGltf/ImageCesium.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+namespace {
+ImageCesium createImage(int32_t width, int32_t height, int32_t channels) {
+  ImageCesium image;
+  image.width = width;
+  image.height = height;
+  image.channels = channels;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(width * height * channels));
+  return image;
+}
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumRasterPreviewsSpec,
+    "Cesium.Unit.RasterPreviews",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumRasterPreviewsSpec)
+
+void FCesiumRasterPreviewsSpec::Define() {
+  Describe("createPreview", [this]() {
+    It("skips images that are already small", [this]() {
+      ImageCesium image = createImage(512, 256, 4);
+      TestFalse(
+          "preview",
+          CesiumRasterPreviews::createPreview(image).has_value());
+    });
+
+    It("skips compressed images", [this]() {
+      ImageCesium image = createImage(1024, 1024, 4);
+      image.compressedPixelFormat = GpuCompressedPixelFormat::BC1_RGB;
+      TestFalse(
+          "preview",
+          CesiumRasterPreviews::createPreview(image).has_value());
+    });
+
+    It("downsamples by a power of two", [this]() {
+      ImageCesium image = createImage(2048, 1000, 3);
+      std::optional<ImageCesium> maybePreview =
+          CesiumRasterPreviews::createPreview(image);
+      if (!TestTrue("preview", maybePreview.has_value())) {
+        return;
+      }
+      TestEqual("width", maybePreview->width, 256);
+      TestEqual("height", maybePreview->height, 125);
+      TestEqual("channels", maybePreview->channels, 3);
+      TestEqual(
+          "size",
+          maybePreview->pixelData.size(),
+          size_t(256 * 125 * 3));
+    });
+
+    It("averages each block of pixels", [this]() {
+      ImageCesium image = createImage(1024, 1024, 1);
+      // Make the first 4x4 block half black and half white.
+      for (int32_t y = 0; y < 4; ++y) {
+        for (int32_t x = 0; x < 2; ++x) {
+          image.pixelData[size_t(y * 1024 + x)] = std::byte(255);
+        }
+      }
+      std::optional<ImageCesium> maybePreview =
+          CesiumRasterPreviews::createPreview(image);
+      if (!TestTrue("preview", maybePreview.has_value())) {
+        return;
+      }
+      TestEqual("width", maybePreview->width, 256);
+      TestEqual("first", uint8_t(maybePreview->pixelData[0]), uint8_t(128));
+      TestEqual("second", uint8_t(maybePreview->pixelData[1]), uint8_t(0));
+    });
+  });
+}
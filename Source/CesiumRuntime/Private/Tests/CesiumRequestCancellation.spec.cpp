@@ -0,0 +1,142 @@
+#include "CesiumRequestCancellation.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestFixtures.h"
+#include "Misc/AutomationTest.h"
+
+using CesiumTestHelpers::TestAssetAccessor;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumRequestCancellationSpec,
+    "Cesium.Unit.RequestCancellation",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+uint64_t group;
+END_DEFINE_SPEC(FCesiumRequestCancellationSpec)
+
+void FCesiumRequestCancellationSpec::Define() {
+  BeforeEach([this]() { group = CesiumRequestCancellation::createGroup(); });
+
+  AfterEach([this]() { CesiumRequestCancellation::releaseGroup(group); });
+
+  It("creates a different group each time", [this]() {
+    TestNotEqual(
+        "group",
+        CesiumRequestCancellation::createGroup(),
+        CesiumRequestCancellation::createGroup());
+  });
+
+  It("cancels the requests registered with a group", [this]() {
+    int32 cancelled = 0;
+    CesiumRequestCancellation::registerRequest(group, [&cancelled]() {
+      ++cancelled;
+      return int64_t(100);
+    });
+    CesiumRequestCancellation::registerRequest(group, [&cancelled]() {
+      ++cancelled;
+      return int64_t(-1);
+    });
+
+    const int64_t bytesAvoided = CesiumRequestCancellation::getBytesAvoided();
+    const int64_t cancelledRequests =
+        CesiumRequestCancellation::getCancelledRequestCount();
+    TestEqual("count", CesiumRequestCancellation::cancelGroup(group), 2);
+    TestEqual("cancelled", cancelled, 2);
+    TestEqual(
+        "cancelled requests",
+        CesiumRequestCancellation::getCancelledRequestCount(),
+        cancelledRequests + 2);
+    TestEqual(
+        "bytes avoided",
+        CesiumRequestCancellation::getBytesAvoided(),
+        bytesAvoided + 100);
+  });
+
+  It("doesn't cancel requests that were unregistered", [this]() {
+    bool cancelled = false;
+    std::optional<uint64_t> handle =
+        CesiumRequestCancellation::registerRequest(group, [&cancelled]() {
+          cancelled = true;
+          return int64_t(0);
+        });
+    TestTrue("registered", handle.has_value());
+    if (!handle) {
+      return;
+    }
+
+    CesiumRequestCancellation::unregisterRequest(group, *handle);
+    TestEqual("count", CesiumRequestCancellation::cancelGroup(group), 0);
+    TestFalse("cancelled", cancelled);
+  });
+
+  It("doesn't cancel requests in other groups", [this]() {
+    const uint64_t otherGroup = CesiumRequestCancellation::createGroup();
+    bool cancelled = false;
+    CesiumRequestCancellation::registerRequest(otherGroup, [&cancelled]() {
+      cancelled = true;
+      return int64_t(0);
+    });
+
+    CesiumRequestCancellation::cancelGroup(group);
+    TestFalse("cancelled", cancelled);
+
+    CesiumRequestCancellation::cancelGroup(otherGroup);
+    CesiumRequestCancellation::releaseGroup(otherGroup);
+  });
+
+  It("rejects requests in a group after it was cancelled", [this]() {
+    CesiumRequestCancellation::cancelGroup(group);
+    TestFalse(
+        "registered",
+        CesiumRequestCancellation::registerRequest(group, []() {
+          return int64_t(0);
+        }).has_value());
+  });
+
+  It("accepts requests in a group again once it's released", [this]() {
+    CesiumRequestCancellation::cancelGroup(group);
+    CesiumRequestCancellation::releaseGroup(group);
+    std::optional<uint64_t> handle =
+        CesiumRequestCancellation::registerRequest(group, []() {
+          return int64_t(0);
+        });
+    TestTrue("registered", handle.has_value());
+    if (handle) {
+      CesiumRequestCancellation::unregisterRequest(group, *handle);
+    }
+  });
+
+  Describe("CesiumRequestGroupAssetAccessor", [this]() {
+    It("adds the group of its GET requests to their headers", [this]() {
+      std::shared_ptr<TestAssetAccessor> pRecording =
+          std::make_shared<TestAssetAccessor>();
+      pRecording->finishImmediately = true;
+      CesiumRequestGroupAssetAccessor accessor(pRecording, group);
+      accessor.get(getAsyncSystem(), "a", {{"Accept", "image/png"}});
+
+      std::vector<CesiumAsync::IAssetAccessor::THeader> headers =
+          pRecording->requestHeaders.back();
+      TestEqual("headers", headers.size(), size_t(2));
+
+      std::optional<uint64_t> extracted =
+          CesiumRequestCancellation::extractGroup(headers);
+      TestTrue("extracted", extracted == group);
+      TestEqual("remaining headers", headers.size(), size_t(1));
+      TestTrue("accept", headers[0].first == "Accept");
+    });
+
+    It("doesn't add a group to other requests", [this]() {
+      std::shared_ptr<TestAssetAccessor> pRecording =
+          std::make_shared<TestAssetAccessor>();
+      pRecording->finishImmediately = true;
+      CesiumRequestGroupAssetAccessor accessor(pRecording, group);
+      accessor.request(getAsyncSystem(), "POST", "a", {}, {});
+
+      std::vector<CesiumAsync::IAssetAccessor::THeader> headers =
+          pRecording->requestHeaders.back();
+      TestFalse(
+          "extracted",
+          CesiumRequestCancellation::extractGroup(headers).has_value());
+    });
+  });
+}
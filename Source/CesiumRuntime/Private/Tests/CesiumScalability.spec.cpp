@@ -0,0 +1,70 @@
+#include "CesiumRuntimeSettings.h"
+#include "CesiumScalability.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumScalabilitySpec,
+    "Cesium.Unit.Scalability",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumScalabilitySpec)
+
+void FCesiumScalabilitySpec::Define() {
+  It("gets the tier of each quality level", [this]() {
+    const UCesiumRuntimeSettings& settings =
+        *GetDefault<UCesiumRuntimeSettings>();
+    TestEqual(
+        "low",
+        &CesiumScalability::getTier(settings, 0),
+        &settings.LowScalabilityTier);
+    TestEqual(
+        "epic",
+        &CesiumScalability::getTier(settings, 3),
+        &settings.EpicScalabilityTier);
+    TestEqual(
+        "cinematic",
+        &CesiumScalability::getTier(settings, 4),
+        &settings.CinematicScalabilityTier);
+  });
+
+  It("uses the nearest tier for levels out of range", [this]() {
+    const UCesiumRuntimeSettings& settings =
+        *GetDefault<UCesiumRuntimeSettings>();
+    TestEqual(
+        "below",
+        &CesiumScalability::getTier(settings, -1),
+        &settings.LowScalabilityTier);
+    TestEqual(
+        "above",
+        &CesiumScalability::getTier(settings, 10),
+        &settings.CinematicScalabilityTier);
+  });
+
+  It("limits the texture size only when the tier has a limit", [this]() {
+    FCesiumScalabilityTier tier;
+    TestEqual(
+        "no limit",
+        CesiumScalability::limitTextureSize(tier, 2048),
+        2048);
+
+    tier.MaximumTextureSize = 512;
+    TestEqual(
+        "larger",
+        CesiumScalability::limitTextureSize(tier, 2048),
+        512);
+    TestEqual(
+        "smaller",
+        CesiumScalability::limitTextureSize(tier, 256),
+        256);
+  });
+
+  It("limits unlimited points to the tier's limit", [this]() {
+    FCesiumScalabilityTier tier;
+    TestEqual("no limit", CesiumScalability::limitPoints(tier, 0), 0);
+
+    tier.MaximumPointsPerFrame = 1000;
+    TestEqual("unlimited", CesiumScalability::limitPoints(tier, 0), 1000);
+    TestEqual("larger", CesiumScalability::limitPoints(tier, 5000), 1000);
+    TestEqual("smaller", CesiumScalability::limitPoints(tier, 100), 100);
+  });
+}
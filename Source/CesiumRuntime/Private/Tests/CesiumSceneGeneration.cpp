@@ -47,6 +47,13 @@ void SceneGenerationContext::refreshTilesets() {
     (*it)->RefreshTileset();
 }
 
+void SceneGenerationContext::destroyTilesets() {
+  std::vector<ACesium3DTileset*>::iterator it;
+  for (it = tilesets.begin(); it != tilesets.end(); ++it)
+    (*it)->Destroy();
+  tilesets.clear();
+}
+
 void SceneGenerationContext::setSuspendUpdate(bool suspend) {
   std::vector<ACesium3DTileset*>::iterator it;
   for (it = tilesets.begin(); it != tilesets.end(); ++it)
@@ -141,6 +148,17 @@ void SceneGenerationContext::syncWorldCamera() {
   }
 }
 
+void SceneGenerationContext::setPlayerCamera(
+    const FVector& position,
+    const FRotator& rotation) {
+  assert(GEditor && GEditor->IsPlayingSessionInEditor());
+
+  APlayerController* controller = world->GetFirstPlayerController();
+  assert(controller);
+
+  controller->ClientSetLocation(position, rotation);
+}
+
 void createCommonWorldObjects(SceneGenerationContext& context) {
 
   context.world = FAutomationEditorCommonUtils::CreateNewMap();
@@ -33,6 +33,7 @@ struct SceneGenerationContext {
       float fieldOfView);
 
   void refreshTilesets();
+  void destroyTilesets();
   void setSuspendUpdate(bool suspend);
   void setMaximumSimultaneousTileLoads(int32 value);
   bool areTilesetsDoneLoading();
@@ -40,6 +41,7 @@ struct SceneGenerationContext {
   void trackForPlay();
   void initForPlay(SceneGenerationContext& creationContext);
   void syncWorldCamera();
+  void setPlayerCamera(const FVector& position, const FRotator& rotation);
 
   static FString testIonToken;
 };
@@ -0,0 +1,147 @@
+#include "CesiumStaleCacheDatabase.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumBandwidthLimiter.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestFixtures.h"
+#include "Misc/AutomationTest.h"
+
+using CesiumTestHelpers::MemoryCacheDatabase;
+using CesiumTestHelpers::TestAssetAccessor;
+
+namespace {
+
+// The maximum staleness of the tests' database, in seconds.
+constexpr std::time_t MaximumStaleness = 3600;
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumStaleCacheDatabaseSpec,
+    "Cesium.Unit.StaleCacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<MemoryCacheDatabase> pMemory;
+std::shared_ptr<TestAssetAccessor> pPending;
+std::shared_ptr<CesiumStaleCacheDatabase> pDatabase;
+
+void Store(std::time_t expiryTime, const std::string& cacheControl) {
+  CesiumAsync::HttpHeaders responseHeaders{
+      {"Cache-Control", cacheControl},
+      {"ETag", "\"1\""}};
+  const std::byte data[] = {std::byte(1), std::byte(2)};
+  pDatabase->storeEntry(
+      "a",
+      expiryTime,
+      "https://example.com/a",
+      "GET",
+      CesiumAsync::HttpHeaders{{"Accept", "*/*"}},
+      200,
+      responseHeaders,
+      gsl::span<const std::byte>(data));
+}
+END_DEFINE_SPEC(FCesiumStaleCacheDatabaseSpec)
+
+void FCesiumStaleCacheDatabaseSpec::Define() {
+  BeforeEach([this]() {
+    pMemory = std::make_shared<MemoryCacheDatabase>();
+    pPending = std::make_shared<TestAssetAccessor>();
+    pDatabase = std::make_shared<CesiumStaleCacheDatabase>(
+        pMemory,
+        pPending,
+        MaximumStaleness);
+  });
+
+  AfterEach([this]() {
+    pDatabase.reset();
+    pPending.reset();
+    pMemory.reset();
+  });
+
+  It("computes expiry times from response headers", [this]() {
+    const std::time_t now = 1000;
+    TestEqual(
+        "max-age",
+        CesiumStaleCacheDatabase::computeExpiryTime(
+            {{"Cache-Control", "public, Max-Age=60"}},
+            now)
+            .value_or(0),
+        std::time_t(1060));
+    TestEqual(
+        "s-maxage",
+        CesiumStaleCacheDatabase::computeExpiryTime(
+            {{"Cache-Control", "s-maxage=30"}},
+            now)
+            .value_or(0),
+        std::time_t(1030));
+    TestEqual(
+        "Expires",
+        CesiumStaleCacheDatabase::computeExpiryTime(
+            {{"Expires", "Thu, 01 Jan 1970 00:20:00 GMT"}},
+            now)
+            .value_or(0),
+        std::time_t(1200));
+    TestFalse(
+        "no-store",
+        CesiumStaleCacheDatabase::computeExpiryTime(
+            {{"Cache-Control", "no-store, max-age=60"}},
+            now)
+            .has_value());
+    TestFalse(
+        "nothing",
+        CesiumStaleCacheDatabase::computeExpiryTime({}, now).has_value());
+  });
+
+  It("keeps responses for the maximum staleness past their expiry", [this]() {
+    const std::time_t expiryTime = std::time(nullptr) + 60;
+    Store(expiryTime, "max-age=60");
+    TestEqual(
+        "stored expiry",
+        pMemory->items["a"].expiryTime,
+        expiryTime + MaximumStaleness);
+
+    std::optional<CesiumAsync::CacheItem> item = pDatabase->getEntry("a");
+    TestTrue("found", item.has_value());
+    if (item) {
+      TestTrue(
+          "no pseudo-header",
+          item->cacheResponse.headers.find(
+              CesiumStaleCacheDatabase::freshUntilHeader) ==
+              item->cacheResponse.headers.end());
+    }
+    TestEqual("not revalidated", pPending->urls.size(), size_t(0));
+  });
+
+  It("uses stale responses while they're revalidated", [this]() {
+    Store(std::time(nullptr) - 60, "max-age=60");
+
+    std::optional<CesiumAsync::CacheItem> item = pDatabase->getEntry("a");
+    TestTrue("found", item.has_value());
+    if (item) {
+      TestTrue("fresh", item->expiryTime > std::time(nullptr));
+    }
+    TestEqual("stale responses", pDatabase->getStaleResponseCount(), int64_t(1));
+    TestEqual("revalidated", pPending->urls.size(), size_t(1));
+    CesiumAsync::HttpHeaders headers = pPending->getLastHeaders();
+    TestEqual("If-None-Match", headers["If-None-Match"], std::string("\"1\""));
+    TestTrue(
+        "in a bandwidth stream",
+        headers.find(CesiumBandwidthLimiter::streamHeader) != headers.end());
+
+    // A response is only revalidated once at a time.
+    pDatabase->getEntry("a");
+    TestEqual("revalidated once", pPending->urls.size(), size_t(1));
+  });
+
+  It("doesn't use responses that must be revalidated once stale", [this]() {
+    const std::time_t expiryTime = std::time(nullptr) - 60;
+    Store(expiryTime, "max-age=60, must-revalidate");
+    TestEqual("stored expiry", pMemory->items["a"].expiryTime, expiryTime);
+
+    std::optional<CesiumAsync::CacheItem> item = pDatabase->getEntry("a");
+    TestTrue("found", item.has_value());
+    if (item) {
+      TestEqual("expired", item->expiryTime, expiryTime);
+    }
+    TestEqual("not revalidated", pPending->urls.size(), size_t(0));
+  });
+}
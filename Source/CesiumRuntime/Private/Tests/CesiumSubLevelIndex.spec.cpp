@@ -0,0 +1,96 @@
+#include "CesiumSubLevelIndex.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumSubLevelIndexSpec,
+    "Cesium.Unit.SubLevelIndex",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumSubLevelIndexSpec)
+
+void FCesiumSubLevelIndexSpec::Define() {
+  It("finds nothing in an empty index", [this]() {
+    CesiumSubLevelIndex index;
+    index.build({});
+    TestEqual(
+        "found",
+        index.findClosestContaining(FVector::ZeroVector),
+        INDEX_NONE);
+  });
+
+  It("finds the sphere that contains a position", [this]() {
+    CesiumSubLevelIndex index;
+    index.build(
+        {CesiumSubLevelIndex::Sphere{FVector(0.0), 10.0},
+         CesiumSubLevelIndex::Sphere{FVector(100.0, 0.0, 0.0), 10.0}});
+
+    TestEqual(
+        "first",
+        index.findClosestContaining(FVector(5.0, 0.0, 0.0)),
+        0);
+    TestEqual(
+        "second",
+        index.findClosestContaining(FVector(95.0, 0.0, 0.0)),
+        1);
+    TestEqual(
+        "neither",
+        index.findClosestContaining(FVector(50.0, 0.0, 0.0)),
+        INDEX_NONE);
+  });
+
+  It("prefers the closest center when spheres overlap", [this]() {
+    CesiumSubLevelIndex index;
+    index.build(
+        {CesiumSubLevelIndex::Sphere{FVector(0.0), 100.0},
+         CesiumSubLevelIndex::Sphere{FVector(50.0, 0.0, 0.0), 10.0}});
+
+    TestEqual(
+        "closest",
+        index.findClosestContaining(FVector(45.0, 0.0, 0.0)),
+        1);
+    TestEqual(
+        "excluded",
+        index.findClosestContaining(FVector(45.0, 0.0, 0.0), 1),
+        0);
+  });
+
+  It("agrees with testing every sphere", [this]() {
+    // A grid of spheres, large enough to need several levels of the
+    // hierarchy, with some of them overlapping.
+    TArray<CesiumSubLevelIndex::Sphere> spheres;
+    for (int32 x = 0; x < 10; ++x) {
+      for (int32 y = 0; y < 10; ++y) {
+        spheres.Add(CesiumSubLevelIndex::Sphere{
+            FVector(x * 1000.0, y * 1000.0, (x + y) * 10.0),
+            300.0 + (x * y % 4) * 200.0});
+      }
+    }
+    TArray<CesiumSubLevelIndex::Sphere> copy = spheres;
+
+    CesiumSubLevelIndex index;
+    index.build(MoveTemp(copy));
+    TestEqual("count", index.getSphereCount(), spheres.Num());
+
+    for (double x = -500.0; x < 10000.0; x += 370.0) {
+      for (double y = -500.0; y < 10000.0; y += 410.0) {
+        const FVector position(x, y, 0.0);
+
+        int32 expected = INDEX_NONE;
+        double expectedDistance = std::numeric_limits<double>::max();
+        for (int32 i = 0; i < spheres.Num(); ++i) {
+          const double distance =
+              FVector::Distance(spheres[i].center, position);
+          if (distance < spheres[i].radius && distance < expectedDistance) {
+            expected = i;
+            expectedDistance = distance;
+          }
+        }
+
+        TestEqual(
+            FString::Printf(TEXT("at %f, %f"), x, y),
+            index.findClosestContaining(position),
+            expected);
+      }
+    }
+  });
+}
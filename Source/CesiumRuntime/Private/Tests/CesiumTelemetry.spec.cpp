@@ -0,0 +1,93 @@
+#include "CesiumTelemetry.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTelemetrySpec,
+    "Cesium.Unit.Telemetry",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+TArray<CesiumTelemetryCounter> counters;
+END_DEFINE_SPEC(FCesiumTelemetrySpec)
+
+void FCesiumTelemetrySpec::Define() {
+  BeforeEach([this]() {
+    counters = {
+        {TEXT("tile_pipeline.total.p95_ms"), 12.5},
+        {TEXT("request_cache.hits"), 40.0},
+        {TEXT("memory.total_gpu_bytes"), 1048576.0}};
+  });
+
+  Describe("StatsD", [this]() {
+    It("formats each counter as a gauge", [this]() {
+      TArray<FString> payloads =
+          CesiumStatsDTelemetrySink::formatPayloads(TEXT("game"), counters, 1400);
+      TestEqual("payloads", payloads.Num(), 1);
+      TestEqual(
+          "payload",
+          payloads[0],
+          FString(TEXT("game.tile_pipeline.total.p95_ms:12.5|g\n"
+                       "game.request_cache.hits:40|g\n"
+                       "game.memory.total_gpu_bytes:1048576|g\n")));
+    });
+
+    It("splits the gauges into payloads that fit", [this]() {
+      TArray<FString> payloads =
+          CesiumStatsDTelemetrySink::formatPayloads(TEXT("game"), counters, 64);
+      TestEqual("payloads", payloads.Num(), 3);
+      for (const FString& payload : payloads) {
+        TestTrue("fits", payload.Len() <= 64);
+        TestTrue("whole lines", payload.EndsWith(TEXT("|g\n")));
+      }
+    });
+  });
+
+  Describe("OpenTelemetry", [this]() {
+    It("formats each counter as a gauge data point", [this]() {
+      const FString json = CesiumOpenTelemetrySink::formatJson(
+          TEXT("game"),
+          TEXT("cesium"),
+          1700000000.0,
+          counters);
+      TestTrue(
+          "service name",
+          json.Contains(TEXT("{\"stringValue\":\"game\"}")));
+      TestTrue(
+          "data point",
+          json.Contains(
+              TEXT("{\"name\":\"cesium.request_cache.hits\",\"gauge\":{"
+                   "\"dataPoints\":[{\"timeUnixNano\":\"1700000000000000000\","
+                   "\"asDouble\":40}]}}")));
+    });
+  });
+
+  Describe("CSV", [this]() {
+    It("writes a header row and then one row per sample", [this]() {
+      const FString filename = FPaths::Combine(
+          FPaths::ProjectIntermediateDir(),
+          TEXT("CesiumTelemetrySpec.csv"));
+      IFileManager::Get().Delete(*filename);
+
+      CesiumCsvTelemetrySink sink(filename);
+      sink.write(1.0, counters);
+      sink.write(2.0, counters);
+
+      TArray<FString> lines;
+      FFileHelper::LoadFileToStringArray(lines, *filename);
+      IFileManager::Get().Delete(*filename);
+
+      TestEqual("lines", lines.Num(), 3);
+      if (lines.Num() == 3) {
+        TestEqual(
+            "header",
+            lines[0],
+            FString(TEXT("timestamp,tile_pipeline.total.p95_ms,"
+                         "request_cache.hits,memory.total_gpu_bytes")));
+        TestEqual("first row", lines[1], FString(TEXT("1.000,12.5,40,1048576")));
+        TestEqual("second row", lines[2], FString(TEXT("2.000,12.5,40,1048576")));
+      }
+    });
+  });
+}
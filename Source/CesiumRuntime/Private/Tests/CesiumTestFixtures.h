@@ -0,0 +1,211 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/HttpHeaders.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/ICacheDatabase.h"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace CesiumTestHelpers {
+
+using RequestFuture =
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>;
+
+/**
+ * An asset accessor for specs, which records the URL and headers of every
+ * request made through it. Requests are held in flight until the spec
+ * finishes or fails them, or succeed right away without a response if
+ * finishImmediately is set.
+ */
+class TestAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  virtual RequestFuture
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override {
+    ++this->requestCount;
+    this->urls.emplace_back(url);
+    this->requestHeaders.emplace_back(headers);
+    if (this->finishImmediately) {
+      return asyncSystem
+          .createResolvedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
+              nullptr);
+    }
+
+    this->promises.emplace_back(
+        asyncSystem
+            .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>());
+    return this->promises.back().getFuture();
+  }
+
+  virtual RequestFuture request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  /**
+   * Finishes the held request at the given index of promises, without a
+   * response.
+   */
+  void finish(size_t index) {
+    // Finishing may make another request, which can reallocate the promises.
+    auto promise = this->promises[index];
+    promise.resolve(nullptr);
+  }
+
+  /**
+   * Fails the held request at the given index of promises.
+   */
+  void fail(size_t index) {
+    auto promise = this->promises[index];
+    promise.reject(std::runtime_error("Request failed."));
+  }
+
+  /**
+   * Finishes every held request without a response. Requests that are made
+   * when these finish are held like any other.
+   */
+  void finishAll() {
+    auto finishing = std::move(this->promises);
+    this->promises.clear();
+    for (auto& promise : finishing) {
+      promise.resolve(nullptr);
+    }
+  }
+
+  /**
+   * Fails every held request. Requests that are made again when these fail
+   * are held like any other.
+   */
+  void failAll() {
+    auto failing = std::move(this->promises);
+    this->promises.clear();
+    for (auto& promise : failing) {
+      promise.reject(std::runtime_error("Request failed."));
+    }
+  }
+
+  /**
+   * Gets the headers of the last request, or no headers if none was made.
+   */
+  CesiumAsync::HttpHeaders getLastHeaders() const {
+    if (this->requestHeaders.empty()) {
+      return {};
+    }
+    return CesiumAsync::HttpHeaders(
+        this->requestHeaders.back().begin(),
+        this->requestHeaders.back().end());
+  }
+
+  bool finishImmediately = false;
+  int32 requestCount = 0;
+  std::vector<std::string> urls;
+  std::vector<std::vector<CesiumAsync::IAssetAccessor::THeader>>
+      requestHeaders;
+  std::vector<CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>>
+      promises;
+};
+
+/**
+ * A cache database for specs, which keeps cached items in memory and counts
+ * writes and prunes. Writes can be held until the spec lets them finish.
+ */
+class MemoryCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    CesiumAsync::CacheItem item;
+    item.expiryTime = expiryTime;
+    item.cacheRequest.url = url;
+    item.cacheRequest.method = requestMethod;
+    item.cacheRequest.headers = requestHeaders;
+    item.cacheResponse.statusCode = statusCode;
+    item.cacheResponse.headers = responseHeaders;
+    item.cacheResponse.data.assign(responseData.begin(), responseData.end());
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (this->blockWrites) {
+      ++this->blockedWriteCount;
+      this->unblocked.wait(lock, [this]() { return !this->blockWrites; });
+    }
+    this->items[key] = std::move(item);
+    ++this->writeCount;
+    return true;
+  }
+
+  virtual bool prune() override {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->pruneCount;
+    return true;
+  }
+
+  virtual bool clearAll() override {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->items.clear();
+    return true;
+  }
+
+  /**
+   * Gets the number of writes that have waited because blockWrites is set.
+   */
+  int32 getBlockedWriteCount() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->blockedWriteCount;
+  }
+
+  /**
+   * Clears blockWrites and lets the writes that are waiting finish.
+   */
+  void unblockWrites() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->blockWrites = false;
+    }
+    this->unblocked.notify_all();
+  }
+
+  mutable std::mutex mutex;
+  std::condition_variable unblocked;
+  std::map<std::string, CesiumAsync::CacheItem> items;
+  int32 writeCount = 0;
+  int32 pruneCount = 0;
+  bool blockWrites = false;
+  int32 blockedWriteCount = 0;
+};
+
+} // namespace CesiumTestHelpers
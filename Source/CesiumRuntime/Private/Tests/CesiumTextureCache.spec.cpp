@@ -0,0 +1,52 @@
+#include "CesiumTextureCache.h"
+#include "Engine/Texture2D.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTextureCacheSpec,
+    "Cesium.Unit.TextureCache",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+UTexture2D* pTexture;
+UTexture2D* pOtherTexture;
+END_DEFINE_SPEC(FCesiumTextureCacheSpec)
+
+void FCesiumTextureCacheSpec::Define() {
+  BeforeEach([this]() {
+    this->pTexture = NewObject<UTexture2D>();
+    this->pOtherTexture = NewObject<UTexture2D>();
+  });
+
+  It("keeps a texture until its last use ends", [this]() {
+    CesiumTextureCache& cache = CesiumTextureCache::get();
+    cache.addUse(this->pTexture, 0);
+    cache.addUse(this->pTexture, 0);
+
+    TestTrue("first release", cache.releaseUse(this->pTexture));
+    TestFalse("last release", cache.releaseUse(this->pTexture));
+  });
+
+  It("doesn't count textures it wasn't given", [this]() {
+    TestFalse(
+        "release",
+        CesiumTextureCache::get().releaseUse(this->pOtherTexture));
+  });
+
+  It("finds a texture by its content key while it's in use", [this]() {
+    CesiumTextureCache& cache = CesiumTextureCache::get();
+    const uint64 key = 0x1234;
+    TestFalse("contains before", cache.contains(key));
+
+    cache.addUse(this->pTexture, key);
+    TestTrue("contains", cache.contains(key));
+    TestEqual("find", cache.find(key), this->pTexture);
+
+    // A second texture with the same key doesn't replace the first.
+    cache.addUse(this->pOtherTexture, key);
+    TestEqual("find first", cache.find(key), this->pTexture);
+
+    TestFalse("release", cache.releaseUse(this->pTexture));
+    TestFalse("contains after", cache.contains(key));
+    TestFalse("release other", cache.releaseUse(this->pOtherTexture));
+  });
+}
@@ -0,0 +1,115 @@
+#include "CesiumTextureCompression.h"
+#include "CesiumGltf/ImageCesium.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTextureCompressionSpec,
+    "Cesium.Unit.TextureCompression",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+ImageCesium image;
+
+void CreateImage(int32_t width, int32_t height, uint8_t alpha) {
+  image = ImageCesium();
+  image.width = width;
+  image.height = height;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(width * height * 4));
+  for (size_t i = 0; i < image.pixelData.size(); i += 4) {
+    image.pixelData[i] = std::byte(200);
+    image.pixelData[i + 1] = std::byte(100);
+    image.pixelData[i + 2] = std::byte(50);
+    image.pixelData[i + 3] = std::byte(alpha);
+  }
+}
+END_DEFINE_SPEC(FCesiumTextureCompressionSpec)
+
+void FCesiumTextureCompressionSpec::Define() {
+  It("compresses opaque images to BC1", [this]() {
+    CreateImage(8, 8, 255);
+    TestTrue("compressed", CesiumTextureCompression::compressImage(image));
+    TestEqual(
+        "format",
+        image.compressedPixelFormat,
+        GpuCompressedPixelFormat::BC1_RGB);
+    TestEqual("size", image.pixelData.size(), size_t(4 * 8));
+  });
+
+  It("compresses transparent images to BC3", [this]() {
+    CreateImage(8, 8, 128);
+    TestTrue("compressed", CesiumTextureCompression::compressImage(image));
+    TestEqual(
+        "format",
+        image.compressedPixelFormat,
+        GpuCompressedPixelFormat::BC3_RGBA);
+    TestEqual("size", image.pixelData.size(), size_t(4 * 16));
+  });
+
+  It("compresses single-channel images to BC4", [this]() {
+    image = ImageCesium();
+    image.width = 8;
+    image.height = 8;
+    image.channels = 1;
+    image.bytesPerChannel = 1;
+    image.pixelData.resize(64, std::byte(255));
+    TestTrue("compressed", CesiumTextureCompression::compressImage(image));
+    TestEqual(
+        "format",
+        image.compressedPixelFormat,
+        GpuCompressedPixelFormat::BC4_R);
+    TestEqual("size", image.pixelData.size(), size_t(4 * 8));
+  });
+
+  It("compresses every mip", [this]() {
+    CreateImage(8, 4, 255);
+    // Append 4x2, 2x1, and 1x1 mips after the 8x4 image.
+    image.mipPositions = {{0, 128}, {128, 32}, {160, 8}, {168, 4}};
+    image.pixelData.resize(172, std::byte(255));
+
+    TestTrue("compressed", CesiumTextureCompression::compressImage(image));
+    TestEqual("mip count", image.mipPositions.size(), size_t(4));
+    TestEqual("mip 0 size", image.mipPositions[0].byteSize, size_t(16));
+    TestEqual("mip 1 offset", image.mipPositions[1].byteOffset, size_t(16));
+    TestEqual("mip 1 size", image.mipPositions[1].byteSize, size_t(8));
+    TestEqual("mip 3 offset", image.mipPositions[3].byteOffset, size_t(32));
+    TestEqual("size", image.pixelData.size(), size_t(40));
+  });
+
+  It("compresses into a copy without changing the original", [this]() {
+    CreateImage(8, 8, 255);
+    ImageCesium compressed;
+    TestTrue(
+        "compressed",
+        CesiumTextureCompression::compressImage(image, compressed));
+    TestEqual(
+        "format",
+        compressed.compressedPixelFormat,
+        GpuCompressedPixelFormat::BC1_RGB);
+    TestEqual("width", compressed.width, 8);
+    TestEqual("size", compressed.pixelData.size(), size_t(4 * 8));
+    TestEqual(
+        "original format",
+        image.compressedPixelFormat,
+        GpuCompressedPixelFormat::NONE);
+    TestEqual("original size", image.pixelData.size(), size_t(8 * 8 * 4));
+  });
+
+  It("does not compress images with unaligned dimensions", [this]() {
+    CreateImage(6, 8, 255);
+    TestFalse("compressed", CesiumTextureCompression::compressImage(image));
+    TestEqual(
+        "format",
+        image.compressedPixelFormat,
+        GpuCompressedPixelFormat::NONE);
+    TestEqual("size", image.pixelData.size(), size_t(6 * 8 * 4));
+  });
+
+  It("does not compress images that are already compressed", [this]() {
+    CreateImage(8, 8, 255);
+    image.compressedPixelFormat = GpuCompressedPixelFormat::BC7_RGBA;
+    TestFalse("compressed", CesiumTextureCompression::compressImage(image));
+  });
+}
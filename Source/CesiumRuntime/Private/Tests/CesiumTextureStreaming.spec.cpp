@@ -0,0 +1,120 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureStreaming.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTextureStreamingSpec,
+    "Cesium.Unit.TextureStreaming",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTextureStreamingSpec)
+
+void FCesiumTextureStreamingSpec::Define() {
+  Describe("computeFirstResidentMip", [this]() {
+    It("keeps every mip of a texture that is close", [this]() {
+      TestEqual(
+          "mip",
+          CesiumTextureStreaming::computeFirstResidentMip(
+              4096,
+              4096,
+              13,
+              4096.0,
+              64),
+          0);
+      TestEqual(
+          "mip when larger than the screen",
+          CesiumTextureStreaming::computeFirstResidentMip(
+              4096,
+              4096,
+              13,
+              100000.0,
+              64),
+          0);
+    });
+
+    It("keeps one more mip than the on-screen size needs", [this]() {
+      // 256 pixels need a 256 texel mip, and one more is kept.
+      TestEqual(
+          "mip",
+          CesiumTextureStreaming::computeFirstResidentMip(
+              4096,
+              4096,
+              13,
+              256.0,
+              64),
+          3);
+      TestEqual(
+          "mip of a rectangular texture",
+          CesiumTextureStreaming::computeFirstResidentMip(
+              4096,
+              1024,
+              13,
+              256.0,
+              64),
+          3);
+    });
+
+    It("keeps the minimum mip size for distant and hidden textures",
+       [this]() {
+         TestEqual(
+             "distant",
+             CesiumTextureStreaming::computeFirstResidentMip(
+                 4096,
+                 4096,
+                 13,
+                 1.0,
+                 64),
+             6);
+         TestEqual(
+             "hidden",
+             CesiumTextureStreaming::computeFirstResidentMip(
+                 4096,
+                 4096,
+                 13,
+                 0.0,
+                 64),
+             6);
+       });
+
+    It("never drops below the smallest mip", [this]() {
+      TestEqual(
+          "mip",
+          CesiumTextureStreaming::computeFirstResidentMip(
+              256,
+              256,
+              3,
+              0.0,
+              1),
+          2);
+      TestEqual(
+          "texture smaller than the minimum size",
+          CesiumTextureStreaming::computeFirstResidentMip(
+              32,
+              32,
+              6,
+              0.0,
+              64),
+          0);
+    });
+  });
+
+  Describe("computeMaximumScreenPixels", [this]() {
+    It("projects the tile's diameter like its geometric error", [this]() {
+      // A tile with a 100 meter radius and 2 meters of geometric error is
+      // refined once the error spans 16 pixels, so its diameter spans at most
+      // 1600 pixels.
+      TestEqual(
+          "pixels",
+          CesiumTextureStreaming::computeMaximumScreenPixels(100.0, 2.0, 16.0),
+          1600.0);
+    });
+
+    It("has no limit without a geometric error", [this]() {
+      TestEqual(
+          "pixels",
+          CesiumTextureStreaming::computeMaximumScreenPixels(100.0, 0.0, 16.0),
+          0.0);
+    });
+  });
+}
@@ -0,0 +1,374 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltf/ImageCesium.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTextureUtility.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "RenderingThread.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumTextureUtility;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumTextureUploadBenchmark,
+    "Cesium.Performance.TextureUpload",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+// The number of textures created by each batch, and the number of measured
+// batches. The fastest batch is reported.
+constexpr int32 batchSize = 16;
+constexpr int32 batchCount = 4;
+
+// The ways that a texture's RHI resource can be created.
+enum class CreationPath {
+  // CreateRHITexture2D_Async in a worker thread.
+  AsyncRhi,
+  // FCesiumTextureResource, on the render thread, from the image.
+  RenderThread,
+  // UTexture2D::UpdateResource, from mips copied to the platform data.
+  Legacy
+};
+
+const TCHAR* getPathName(CreationPath path) {
+  switch (path) {
+  case CreationPath::AsyncRhi:
+    return TEXT("async RHI");
+  case CreationPath::RenderThread:
+    return TEXT("render thread");
+  case CreationPath::Legacy:
+  default:
+    return TEXT("legacy");
+  }
+}
+
+/**
+ * An image like those that tiles use: either the RGBA pixels of a decoded
+ * JPEG or PNG, or the block compressed pixels that a KTX2 image is transcoded
+ * to, optionally with its full mip chain.
+ */
+ImageCesium createUploadImage(
+    int32 size,
+    GpuCompressedPixelFormat compressedPixelFormat,
+    bool withMips) {
+  ImageCesium image;
+  image.width = size;
+  image.height = size;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.compressedPixelFormat = compressedPixelFormat;
+
+  // Bytes per 4x4 block, or per pixel when uncompressed.
+  const bool compressed =
+      compressedPixelFormat != GpuCompressedPixelFormat::NONE;
+  const size_t bytesPerUnit =
+      compressedPixelFormat == GpuCompressedPixelFormat::BC1_RGB ? 8
+      : compressed                                               ? 16
+                                                                 : 4;
+
+  size_t byteOffset = 0;
+  for (int32 mipSize = size; mipSize > 0; mipSize /= 2) {
+    const size_t units =
+        compressed ? size_t(FMath::DivideAndRoundUp(mipSize, 4)) *
+                         size_t(FMath::DivideAndRoundUp(mipSize, 4))
+                   : size_t(mipSize) * size_t(mipSize);
+    const size_t byteSize = units * bytesPerUnit;
+    if (withMips) {
+      image.mipPositions.push_back({byteOffset, byteSize});
+    }
+    byteOffset += byteSize;
+    if (!withMips) {
+      break;
+    }
+  }
+
+  image.pixelData.resize(byteOffset);
+  for (size_t i = 0; i < image.pixelData.size(); ++i) {
+    image.pixelData[i] = std::byte((i * 2654435761u) >> 24);
+  }
+  return image;
+}
+
+// The block compressed format that a KTX2 image would be transcoded to on
+// this platform, or NONE if none is supported.
+GpuCompressedPixelFormat getKtx2Format() {
+  if (GPixelFormats[PF_BC7].Supported) {
+    return GpuCompressedPixelFormat::BC7_RGBA;
+  }
+  if (GPixelFormats[PF_DXT1].Supported) {
+    return GpuCompressedPixelFormat::BC1_RGB;
+  }
+  if (GPixelFormats[PF_ETC2_RGBA].Supported) {
+    return GpuCompressedPixelFormat::ETC2_RGBA;
+  }
+  return GpuCompressedPixelFormat::NONE;
+}
+
+EPixelFormat getPixelFormat(GpuCompressedPixelFormat format) {
+  switch (format) {
+  case GpuCompressedPixelFormat::BC7_RGBA:
+    return PF_BC7;
+  case GpuCompressedPixelFormat::BC1_RGB:
+    return PF_DXT1;
+  case GpuCompressedPixelFormat::ETC2_RGBA:
+    return PF_ETC2_RGBA;
+  default:
+    return PF_R8G8B8A8;
+  }
+}
+
+/**
+ * Prepares a texture for the legacy path, the way encoded feature ID and
+ * property textures are, by copying each of the image's mips to the platform
+ * data.
+ */
+TUniquePtr<LoadedTextureResult> loadLegacyTexture(const ImageCesium& image) {
+  TUniquePtr<LoadedTextureResult> pResult = MakeUnique<LoadedTextureResult>();
+  pResult->textureSource = LegacyTextureSource{};
+  pResult->addressX = TextureAddress::TA_Wrap;
+  pResult->addressY = TextureAddress::TA_Wrap;
+  pResult->filter = TextureFilter::TF_Default;
+  pResult->group = TextureGroup::TEXTUREGROUP_World;
+  pResult->generateMipMaps = false;
+  pResult->pTextureData = createTexturePlatformData(
+      image.width,
+      image.height,
+      getPixelFormat(image.compressedPixelFormat));
+  if (!pResult->pTextureData) {
+    return nullptr;
+  }
+
+  std::vector<ImageCesiumMipPosition> mips = image.mipPositions;
+  if (mips.empty()) {
+    mips.push_back({0, image.pixelData.size()});
+  }
+
+  int32 mipSize = image.width;
+  for (const ImageCesiumMipPosition& mip : mips) {
+    FTexture2DMipMap* pMip = new FTexture2DMipMap();
+    pResult->pTextureData->Mips.Add(pMip);
+    pMip->SizeX = mipSize;
+    pMip->SizeY = mipSize;
+    pMip->BulkData.Lock(LOCK_READ_WRITE);
+    void* pData = pMip->BulkData.Realloc(mip.byteSize);
+    FMemory::Memcpy(pData, &image.pixelData[mip.byteOffset], mip.byteSize);
+    pMip->BulkData.Unlock();
+    mipSize = FMath::Max(mipSize / 2, 1);
+  }
+
+  return pResult;
+}
+
+struct TextureUploadMeasurement {
+  // The time spent in the worker thread part, which is done on the game
+  // thread here so that it isn't overlapped with the other parts.
+  double workerMilliseconds = std::numeric_limits<double>::max();
+  double gameThreadMilliseconds = std::numeric_limits<double>::max();
+  // The time for the render thread to finish creating the textures, after the
+  // game thread part has queued them.
+  double renderThreadMilliseconds = std::numeric_limits<double>::max();
+  double totalMilliseconds = std::numeric_limits<double>::max();
+  // The largest growth in the process's physical memory during a batch,
+  // which is only approximate, since the allocator keeps freed memory.
+  int64 peakMemoryBytes = 0;
+};
+
+/**
+ * Creates batches of textures from copies of the image through the given
+ * path, after one batch to warm up, and measures the fastest batch.
+ */
+TextureUploadMeasurement measureBatches(
+    const ImageCesium& image,
+    bool generateMipMaps,
+    CreationPath path) {
+  TextureUploadMeasurement result;
+
+  for (int32 batch = 0; batch <= batchCount; ++batch) {
+    // The texture creation takes ownership of or modifies its image, so each
+    // texture is given a fresh copy, outside of the measurement.
+    std::vector<ImageCesium> images(batchSize, image);
+    TArray<TUniquePtr<LoadedTextureResult>> halfLoaded;
+    TArray<UTexture2D*> textures;
+
+    const uint64 memoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+    uint64 memoryPeak = memoryBefore;
+    auto sampleMemory = [&memoryPeak]() {
+      memoryPeak =
+          std::max(memoryPeak, FPlatformMemory::GetStats().UsedPhysical);
+    };
+
+    const double start = FPlatformTime::Seconds();
+    for (ImageCesium& batchImage : images) {
+      if (path == CreationPath::Legacy) {
+        halfLoaded.Add(loadLegacyTexture(batchImage));
+      } else {
+        // The render thread path is the one taken when the RHI can't create
+        // textures asynchronously, so it is measured on RHIs that can by not
+        // allowing asynchronous creation.
+        halfLoaded.Add(loadTextureAnyThreadPart(
+            EmbeddedImageSource{std::move(batchImage)},
+            TextureAddress::TA_Wrap,
+            TextureAddress::TA_Wrap,
+            TextureFilter::TF_Default,
+            TextureGroup::TEXTUREGROUP_World,
+            generateMipMaps,
+            true,
+            false,
+            false,
+            path == CreationPath::AsyncRhi));
+      }
+    }
+    sampleMemory();
+    const double workerEnd = FPlatformTime::Seconds();
+
+    for (TUniquePtr<LoadedTextureResult>& pHalfLoaded : halfLoaded) {
+      textures.Add(loadTextureGameThreadPart(pHalfLoaded.Get()));
+    }
+    sampleMemory();
+    const double gameThreadEnd = FPlatformTime::Seconds();
+
+    FlushRenderingCommands();
+    sampleMemory();
+    const double end = FPlatformTime::Seconds();
+
+    for (UTexture2D* pTexture : textures) {
+      if (pTexture) {
+        destroyTexture(pTexture);
+      }
+    }
+    halfLoaded.Empty();
+    FlushRenderingCommands();
+
+    if (batch > 0) {
+      result.workerMilliseconds = std::min(
+          result.workerMilliseconds,
+          (workerEnd - start) * 1000.0);
+      result.gameThreadMilliseconds = std::min(
+          result.gameThreadMilliseconds,
+          (gameThreadEnd - workerEnd) * 1000.0);
+      result.renderThreadMilliseconds = std::min(
+          result.renderThreadMilliseconds,
+          (end - gameThreadEnd) * 1000.0);
+      result.totalMilliseconds =
+          std::min(result.totalMilliseconds, (end - start) * 1000.0);
+      result.peakMemoryBytes = std::max(
+          result.peakMemoryBytes,
+          int64(memoryPeak) - int64(memoryBefore));
+    }
+  }
+
+  return result;
+}
+
+} // namespace
+
+/**
+ * Measures the throughput of creating textures from the kinds of images that
+ * tiles and raster overlays use, through each of the ways that
+ * CesiumTextureUtility creates RHI textures. The throughput is of the image's
+ * bytes, including any mips that it already has, over the time from the
+ * start of the worker thread part until the render thread has created the
+ * texture.
+ *
+ * Each case is marked with a trace bookmark, so that the game and render
+ * thread scopes of each case can be inspected in Unreal Insights.
+ */
+bool FCesiumTextureUploadBenchmark::RunTest(const FString& Parameters) {
+  if (!FApp::CanEverRender()) {
+    AddInfo(TEXT("Skipped, because there is no renderer."));
+    return true;
+  }
+
+  const GpuCompressedPixelFormat ktx2Format = getKtx2Format();
+
+  struct ImageKind {
+    const TCHAR* name;
+    bool compressed;
+    bool withMips;
+    bool generateMipMaps;
+  };
+  const ImageKind kinds[] = {
+      {TEXT("RGBA"), false, false, false},
+      {TEXT("RGBA, generated mips"), false, false, true},
+      {TEXT("KTX2"), true, false, false},
+      {TEXT("KTX2 with mips"), true, true, true}};
+
+  AddInfo(FString::Printf(
+      TEXT("Async RHI texture creation is %s; mips are generated on the %s."),
+      GRHISupportsAsyncTextureCreation ? TEXT("supported")
+                                       : TEXT("not supported"),
+      GetDefault<UCesiumRuntimeSettings>()->GenerateMipMapsOnGpu
+          ? TEXT("GPU")
+          : TEXT("CPU")));
+  AddInfo(FString::Printf(
+      TEXT("%-44s %9s %9s %9s %9s %9s"),
+      TEXT("Case"),
+      TEXT("Worker ms"),
+      TEXT("Game ms"),
+      TEXT("Render ms"),
+      TEXT("MB/s"),
+      TEXT("Peak MiB")));
+
+  for (const int32 size : {256, 1024}) {
+    for (const ImageKind& kind : kinds) {
+      if (kind.compressed && ktx2Format == GpuCompressedPixelFormat::NONE) {
+        continue;
+      }
+
+      const ImageCesium image = createUploadImage(
+          size,
+          kind.compressed ? ktx2Format : GpuCompressedPixelFormat::NONE,
+          kind.withMips);
+      const double megabytes =
+          double(image.pixelData.size()) * batchSize / (1024.0 * 1024.0);
+
+      for (const CreationPath path :
+           {CreationPath::AsyncRhi,
+            CreationPath::RenderThread,
+            CreationPath::Legacy}) {
+        if (path == CreationPath::AsyncRhi &&
+            !GRHISupportsAsyncTextureCreation) {
+          continue;
+        }
+        // The legacy path only copies the mips that the image already has.
+        if (path == CreationPath::Legacy && kind.generateMipMaps &&
+            !kind.withMips) {
+          continue;
+        }
+
+        const FString name = FString::Printf(
+            TEXT("%dx%d %s, %s"),
+            size,
+            size,
+            kind.name,
+            getPathName(path));
+        TRACE_BOOKMARK(TEXT("Texture upload: %s"), *name);
+        const TextureUploadMeasurement measurement =
+            measureBatches(image, kind.generateMipMaps, path);
+
+        const FString line = FString::Printf(
+            TEXT("%-44s %9.3f %9.3f %9.3f %9.1f %9.1f"),
+            *name,
+            measurement.workerMilliseconds,
+            measurement.gameThreadMilliseconds,
+            measurement.renderThreadMilliseconds,
+            megabytes / (measurement.totalMilliseconds / 1000.0),
+            double(measurement.peakMemoryBytes) / (1024.0 * 1024.0));
+        AddInfo(line);
+        UE_LOG(LogCesium, Display, TEXT("Texture upload: %s"), *line);
+      }
+    }
+  }
+
+  return true;
+}
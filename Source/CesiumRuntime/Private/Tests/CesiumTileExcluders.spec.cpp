@@ -0,0 +1,130 @@
+#include "CesiumBoxTileExcluder.h"
+#include "CesiumDistanceTileExcluder.h"
+#include "CesiumPolygonTileExcluder.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileExcludersSpec,
+    "Cesium.Unit.TileExcluders",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+TArray<FBoxSphereBounds> tileBounds;
+TBitArray<> excluded;
+
+END_DEFINE_SPEC(FCesiumTileExcludersSpec)
+
+void FCesiumTileExcludersSpec::Define() {
+  BeforeEach([this]() {
+    // One tile near the origin, one far away, and one straddling x = 1000.
+    tileBounds = {
+        FBoxSphereBounds(FVector(0.0), FVector(10.0), 10.0 * UE_SQRT_3),
+        FBoxSphereBounds(FVector(5000.0), FVector(10.0), 10.0 * UE_SQRT_3),
+        FBoxSphereBounds(
+            FVector(1000.0, 0.0, 0.0),
+            FVector(50.0),
+            50.0 * UE_SQRT_3)};
+    excluded.Reset();
+  });
+
+  Describe("UCesiumBoxTileExcluder", [this]() {
+    It("excludes tiles entirely outside the box", [this]() {
+      UCesiumBoxTileExcluder* pExcluder = NewObject<UCesiumBoxTileExcluder>();
+      pExcluder->Extent = FVector(1000.0);
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+
+      TestEqual("Num", excluded.Num(), 3);
+      TestFalse("inside", excluded[0]);
+      TestTrue("outside", excluded[1]);
+      TestFalse("straddling", excluded[2]);
+    });
+
+    It("excludes tiles entirely inside the box", [this]() {
+      UCesiumBoxTileExcluder* pExcluder = NewObject<UCesiumBoxTileExcluder>();
+      pExcluder->Extent = FVector(1000.0);
+      pExcluder->ExcludeTilesInside = true;
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+
+      TestTrue("inside", excluded[0]);
+      TestFalse("outside", excluded[1]);
+      TestFalse("straddling", excluded[2]);
+    });
+
+    It("accounts for the box's rotation", [this]() {
+      UCesiumBoxTileExcluder* pExcluder = NewObject<UCesiumBoxTileExcluder>();
+      pExcluder->Extent = FVector(2000.0, 100.0, 100.0);
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+      TestFalse("along the long axis", excluded[2]);
+
+      pExcluder->Rotation = FRotator(0.0, 90.0, 0.0);
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+      TestTrue("across the short axis", excluded[2]);
+    });
+  });
+
+  Describe("UCesiumPolygonTileExcluder", [this]() {
+    It("excludes tiles entirely inside a polygon", [this]() {
+      UCesiumPolygonTileExcluder* pExcluder =
+          NewObject<UCesiumPolygonTileExcluder>();
+      pExcluder->SetFootprints(
+          {{FVector2D(-1000.0, -1000.0),
+            FVector2D(1000.0, -1000.0),
+            FVector2D(1000.0, 1000.0),
+            FVector2D(-1000.0, 1000.0)}});
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+
+      TestTrue("inside", excluded[0]);
+      TestFalse("outside", excluded[1]);
+      TestFalse("straddling", excluded[2]);
+    });
+
+    It("excludes tiles entirely outside all polygons when inverted",
+       [this]() {
+         UCesiumPolygonTileExcluder* pExcluder =
+             NewObject<UCesiumPolygonTileExcluder>();
+         pExcluder->InvertSelection = true;
+         pExcluder->SetFootprints(
+             {{FVector2D(-1000.0, -1000.0),
+               FVector2D(1000.0, -1000.0),
+               FVector2D(1000.0, 1000.0),
+               FVector2D(-1000.0, 1000.0)}});
+         pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+
+         TestFalse("inside", excluded[0]);
+         TestTrue("outside", excluded[1]);
+         TestFalse("straddling", excluded[2]);
+       });
+
+    It("excludes nothing without polygons", [this]() {
+      UCesiumPolygonTileExcluder* pExcluder =
+          NewObject<UCesiumPolygonTileExcluder>();
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+
+      TestEqual("Num", excluded.Num(), 3);
+      TestEqual("excluded", excluded.CountSetBits(), 0);
+    });
+  });
+
+  Describe("UCesiumDistanceTileExcluder", [this]() {
+    It("excludes tiles entirely beyond the maximum distance", [this]() {
+      UCesiumDistanceTileExcluder* pExcluder =
+          NewObject<UCesiumDistanceTileExcluder>();
+      pExcluder->MaximumDistance = 1000.0;
+      pExcluder->SetOriginLocation(FVector(0.0));
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+
+      TestFalse("near", excluded[0]);
+      TestTrue("far", excluded[1]);
+      TestFalse("straddling", excluded[2]);
+    });
+
+    It("excludes nothing without an origin", [this]() {
+      UCesiumDistanceTileExcluder* pExcluder =
+          NewObject<UCesiumDistanceTileExcluder>();
+      pExcluder->MaximumDistance = 1.0;
+      pExcluder->ShouldExcludeTiles(tileBounds, excluded);
+
+      TestEqual("excluded", excluded.CountSetBits(), 0);
+    });
+  });
+}
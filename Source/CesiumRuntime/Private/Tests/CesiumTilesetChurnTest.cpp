@@ -0,0 +1,314 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#if WITH_EDITOR
+
+#include "CesiumSceneGeneration.h"
+
+#include "Misc/AutomationTest.h"
+
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTileset.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumIonRasterOverlay.h"
+#include "CesiumRuntime.h"
+
+#include "HAL/PlatformMemory.h"
+#include "Tests/AutomationCommon.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectIterator.h"
+
+#include <algorithm>
+
+using namespace Cesium;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FCesiumTilesetChurn,
+    "Cesium.Performance.TilesetChurn",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+namespace {
+
+// The number of times the tilesets are spawned and destroyed.
+constexpr int32 cycleCount = 5;
+
+// How long to let the tilesets load before destroying them, and how long to
+// wait for them to be torn down.
+constexpr double loadSeconds = 15.0;
+constexpr double teardownTimeoutSeconds = 30.0;
+
+struct ChurnCycle {
+  int64 tilesLoaded = 0;
+  int32 gltfComponents = 0;
+
+  // The time in AActor::Destroy, which destroys the native tileset.
+  double destroyMilliseconds = 0;
+  // The time from AActor::Destroy until every glTF component of the tilesets
+  // has been destroyed by CesiumLifetime.
+  double teardownMilliseconds = 0;
+  // The time for a garbage collection to free the destroyed objects.
+  double garbageCollectionMilliseconds = 0;
+
+  // The tileset actors and glTF components that garbage collection couldn't
+  // free, because something still refers to them.
+  int32 leakedTilesets = 0;
+  int32 leakedGltfComponents = 0;
+
+  uint64 peakUsedPhysicalMemory = 0;
+  uint64 usedPhysicalMemoryAfter = 0;
+};
+
+struct ChurnTestContext {
+  SceneGenerationContext scene;
+  std::vector<ChurnCycle> cycles;
+  int32 gltfComponentsBefore = 0;
+  uint64 usedPhysicalMemoryBefore = 0;
+
+  // The state of the current cycle.
+  enum class Phase { Spawn, Load, Teardown } phase = Phase::Spawn;
+  double phaseStart = 0.0;
+  TArray<TWeakObjectPtr<ACesium3DTileset>> tilesets;
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> gltfComponents;
+};
+
+ChurnTestContext gChurnTestContext;
+
+int32 countGltfComponents() {
+  int32 count = 0;
+  for (TObjectIterator<UCesiumGltfComponent> it; it; ++it) {
+    ++count;
+  }
+  return count;
+}
+
+void sampleMemory(ChurnCycle& cycle) {
+  cycle.peakUsedPhysicalMemory = std::max(
+      cycle.peakUsedPhysicalMemory,
+      uint64(FPlatformMemory::GetStats().UsedPhysical));
+}
+
+/**
+ * Spawns Cesium World Terrain with a Bing Maps Aerial overlay, and a
+ * photogrammetry tileset on top of it, the way a dataset switch would.
+ */
+void spawnTilesets(SceneGenerationContext& context) {
+  ACesium3DTileset* worldTerrainTileset =
+      context.world->SpawnActor<ACesium3DTileset>();
+  worldTerrainTileset->SetTilesetSource(ETilesetSource::FromCesiumIon);
+  worldTerrainTileset->SetIonAssetID(1);
+  worldTerrainTileset->SetIonAccessToken(SceneGenerationContext::testIonToken);
+
+  UCesiumIonRasterOverlay* pOverlay = NewObject<UCesiumIonRasterOverlay>(
+      worldTerrainTileset,
+      FName("Bing Maps Aerial"),
+      RF_Transactional);
+  pOverlay->MaterialLayerKey = TEXT("Overlay0");
+  pOverlay->IonAssetID = 2;
+  pOverlay->SetActive(true);
+  pOverlay->OnComponentCreated();
+  worldTerrainTileset->AddInstanceComponent(pOverlay);
+
+  ACesium3DTileset* aerometrexTileset =
+      context.world->SpawnActor<ACesium3DTileset>();
+  aerometrexTileset->SetTilesetSource(ETilesetSource::FromCesiumIon);
+  aerometrexTileset->SetIonAssetID(354307);
+  aerometrexTileset->SetIonAccessToken(SceneGenerationContext::testIonToken);
+  aerometrexTileset->SetMaximumScreenSpaceError(2.0);
+
+  context.tilesets.push_back(worldTerrainTileset);
+  context.tilesets.push_back(aerometrexTileset);
+}
+
+bool isTeardownDone(const ChurnTestContext& context) {
+  for (const TWeakObjectPtr<UCesiumGltfComponent>& pGltf :
+       context.gltfComponents) {
+    // CesiumLifetime marks objects as garbage once they're destroyed.
+    if (IsValid(pGltf.Get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(
+    TilesetChurnCycleCommand,
+    ChurnTestContext&,
+    context);
+bool TilesetChurnCycleCommand::Update() {
+  const double now = FPlatformTime::Seconds();
+
+  if (context.phase == ChurnTestContext::Phase::Spawn) {
+    context.cycles.emplace_back();
+    sampleMemory(context.cycles.back());
+    spawnTilesets(context.scene);
+    context.phase = ChurnTestContext::Phase::Load;
+    context.phaseStart = now;
+    return false;
+  }
+
+  ChurnCycle& cycle = context.cycles.back();
+  sampleMemory(cycle);
+
+  if (context.phase == ChurnTestContext::Phase::Load) {
+    if (!context.scene.areTilesetsDoneLoading() &&
+        now - context.phaseStart < loadSeconds) {
+      return false;
+    }
+
+    context.tilesets.Empty();
+    context.gltfComponents.Empty();
+    for (ACesium3DTileset* pTileset : context.scene.tilesets) {
+      context.tilesets.Add(pTileset);
+      const Cesium3DTilesSelection::Tileset* pNativeTileset =
+          pTileset->GetTileset();
+      if (pNativeTileset) {
+        cycle.tilesLoaded += pNativeTileset->getNumberOfTilesLoaded();
+      }
+
+      TInlineComponentArray<UCesiumGltfComponent*> gltfComponents;
+      pTileset->GetComponents<UCesiumGltfComponent>(gltfComponents);
+      for (UCesiumGltfComponent* pGltf : gltfComponents) {
+        context.gltfComponents.Add(pGltf);
+      }
+    }
+    cycle.gltfComponents = context.gltfComponents.Num();
+
+    const double destroyStart = FPlatformTime::Seconds();
+    context.scene.destroyTilesets();
+    const double destroyEnd = FPlatformTime::Seconds();
+    cycle.destroyMilliseconds = (destroyEnd - destroyStart) * 1000.0;
+
+    context.phase = ChurnTestContext::Phase::Teardown;
+    context.phaseStart = destroyStart;
+    return false;
+  }
+
+  // Let the amortized destructor work in the background of normal frames,
+  // like it would in an application.
+  const bool timedOut = now - context.phaseStart >= teardownTimeoutSeconds;
+  if (!isTeardownDone(context) && !timedOut) {
+    return false;
+  }
+
+  cycle.teardownMilliseconds = (now - context.phaseStart) * 1000.0;
+  if (timedOut) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("TIMED OUT: Tilesets weren't torn down after %.2f seconds"),
+        teardownTimeoutSeconds);
+  }
+
+  const double collectStart = FPlatformTime::Seconds();
+  CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+  cycle.garbageCollectionMilliseconds =
+      (FPlatformTime::Seconds() - collectStart) * 1000.0;
+
+  for (const TWeakObjectPtr<ACesium3DTileset>& pTileset : context.tilesets) {
+    if (!pTileset.IsStale(true)) {
+      ++cycle.leakedTilesets;
+    }
+  }
+  for (const TWeakObjectPtr<UCesiumGltfComponent>& pGltf :
+       context.gltfComponents) {
+    if (!pGltf.IsStale(true)) {
+      ++cycle.leakedGltfComponents;
+    }
+  }
+  context.tilesets.Empty();
+  context.gltfComponents.Empty();
+
+  sampleMemory(cycle);
+  cycle.usedPhysicalMemoryAfter = FPlatformMemory::GetStats().UsedPhysical;
+
+  context.phase = ChurnTestContext::Phase::Spawn;
+  return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(
+    TilesetChurnReportCommand,
+    ChurnTestContext&,
+    context);
+bool TilesetChurnReportCommand::Update() {
+  FString reportStr;
+  reportStr += "\n\nTileset Churn Results\n";
+  reportStr += "-----------------------------\n";
+  int32 leaked = 0;
+  for (size_t index = 0; index < context.cycles.size(); ++index) {
+    const ChurnCycle& cycle = context.cycles[index];
+    reportStr += FString::Printf(
+        TEXT("Cycle %d: %lld tiles, %d glTF components\n"),
+        int32(index) + 1,
+        cycle.tilesLoaded,
+        cycle.gltfComponents);
+    reportStr += FString::Printf(
+        TEXT("    destroy %.2f ms, teardown %.2f ms, GC %.2f ms\n"),
+        cycle.destroyMilliseconds,
+        cycle.teardownMilliseconds,
+        cycle.garbageCollectionMilliseconds);
+    reportStr += FString::Printf(
+        TEXT("    peak %.2f MB, after %.2f MB (+%.2f MB since start)\n"),
+        double(cycle.peakUsedPhysicalMemory) / (1024.0 * 1024.0),
+        double(cycle.usedPhysicalMemoryAfter) / (1024.0 * 1024.0),
+        (double(cycle.usedPhysicalMemoryAfter) -
+         double(context.usedPhysicalMemoryBefore)) /
+            (1024.0 * 1024.0));
+    reportStr += FString::Printf(
+        TEXT("    leaked %d tilesets, %d glTF components\n"),
+        cycle.leakedTilesets,
+        cycle.leakedGltfComponents);
+    leaked += cycle.leakedTilesets + cycle.leakedGltfComponents;
+  }
+
+  const int32 gltfComponentsAfter = countGltfComponents();
+  reportStr += FString::Printf(
+      TEXT("glTF components before %d, after %d\n"),
+      context.gltfComponentsBefore,
+      gltfComponentsAfter);
+  reportStr += "-----------------------------\n";
+  UE_LOG(LogCesium, Display, TEXT("%s"), *reportStr);
+
+  if (leaked > 0 || gltfComponentsAfter > context.gltfComponentsBefore) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Destroyed tilesets left objects that couldn't be freed"));
+  }
+  return true;
+}
+
+/**
+ * Repeatedly spawns tilesets with raster overlays, lets them load, and
+ * destroys them again, like an application that switches between datasets.
+ * Each cycle measures the game thread time of destroying the tilesets, the
+ * time for CesiumLifetime to finish tearing down their glTF components, the
+ * peak physical memory, and the objects that garbage collection couldn't
+ * free afterward.
+ */
+bool FCesiumTilesetChurn::RunTest(const FString& Parameters) {
+  ChurnTestContext& context = gChurnTestContext;
+  context = ChurnTestContext();
+
+  createCommonWorldObjects(context.scene);
+  context.scene.setCommonProperties(
+      FVector(-104.988892, 39.743462, 1798.679443),
+      FVector(0, 0, 0),
+      FRotator(-5.2, -149.4, 0),
+      90.0f);
+  context.scene.syncWorldCamera();
+
+  CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+  context.gltfComponentsBefore = countGltfComponents();
+  context.usedPhysicalMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+  ADD_LATENT_AUTOMATION_COMMAND(FWaitForShadersToFinishCompiling);
+  for (int32 i = 0; i < cycleCount; ++i) {
+    ADD_LATENT_AUTOMATION_COMMAND(TilesetChurnCycleCommand(context));
+  }
+  ADD_LATENT_AUTOMATION_COMMAND(TilesetChurnReportCommand(context));
+
+  return true;
+}
+
+#endif
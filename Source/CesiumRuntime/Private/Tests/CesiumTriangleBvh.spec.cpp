@@ -0,0 +1,130 @@
+#include "CesiumTriangleBvh.h"
+#include "Misc/AutomationTest.h"
+
+namespace {
+// A grid of size x size squares, each split into two triangles, in the XY
+// plane at the given height.
+void addGrid(
+    TArray<FVector>& vertices,
+    TArray<int32>& indices,
+    int32 size,
+    double height) {
+  const int32 first = vertices.Num();
+  for (int32 y = 0; y <= size; ++y) {
+    for (int32 x = 0; x <= size; ++x) {
+      vertices.Add(FVector(x, y, height));
+    }
+  }
+  for (int32 y = 0; y < size; ++y) {
+    for (int32 x = 0; x < size; ++x) {
+      const int32 corner = first + y * (size + 1) + x;
+      indices.Append({corner, corner + 1, corner + size + 2});
+      indices.Append({corner, corner + size + 2, corner + size + 1});
+    }
+  }
+}
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTriangleBvhSpec,
+    "Cesium.Unit.TriangleBvh",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTriangleBvhSpec)
+
+void FCesiumTriangleBvhSpec::Define() {
+  It("is empty without valid triangles", [this]() {
+    TArray<FVector> vertices{FVector(0.0), FVector(1.0)};
+    TArray<int32> indices{0, 1, 2};
+    CesiumTriangleBvh bvh(MoveTemp(vertices), indices);
+    TestTrue("isEmpty", bvh.isEmpty());
+
+    double distance;
+    TestFalse(
+        "hit",
+        bvh.intersectRay(FVector(0.0), FVector(0.0, 0.0, 1.0), 1.0, distance));
+  });
+
+  It("finds the closest hit from either side", [this]() {
+    TArray<FVector> vertices;
+    TArray<int32> indices;
+    addGrid(vertices, indices, 16, 10.0);
+    addGrid(vertices, indices, 16, 20.0);
+    CesiumTriangleBvh bvh(MoveTemp(vertices), indices);
+    TestFalse("isEmpty", bvh.isEmpty());
+    TestEqual("bounds", bvh.getBounds().Max.Z, 20.0);
+
+    double distance = 0.0;
+    TestTrue(
+        "down",
+        bvh.intersectRay(
+            FVector(3.3, 7.6, 100.0),
+            FVector(0.0, 0.0, -1.0),
+            1000.0,
+            distance));
+    TestEqual("down distance", distance, 80.0, 1e-9);
+
+    TestTrue(
+        "up",
+        bvh.intersectRay(
+            FVector(12.7, 0.4, 0.0),
+            FVector(0.0, 0.0, 2.0),
+            1000.0,
+            distance));
+    TestEqual("up distance", distance, 5.0, 1e-9);
+  });
+
+  It("reports the triangle that is hit", [this]() {
+    TArray<FVector> vertices{
+        FVector(0.0, 0.0, 0.0),
+        FVector(1.0, 0.0, 0.0),
+        FVector(0.0, 1.0, 0.0),
+        FVector(0.0, 0.0, 5.0),
+        FVector(0.0, 1.0, 5.0),
+        FVector(1.0, 0.0, 5.0)};
+    TArray<int32> indices{0, 1, 2, 3, 4, 5};
+    CesiumTriangleBvh bvh(MoveTemp(vertices), indices);
+
+    double distance;
+    int32 triangle = INDEX_NONE;
+    if (!TestTrue(
+            "hit",
+            bvh.intersectRay(
+                FVector(0.25, 0.25, 10.0),
+                FVector(0.0, 0.0, -1.0),
+                100.0,
+                distance,
+                &triangle))) {
+      return;
+    }
+
+    FVector v0, v1, v2;
+    bvh.getTriangle(triangle, v0, v1, v2);
+    TestEqual("v0", v0, FVector(0.0, 0.0, 5.0));
+    TestEqual("v1", v1, FVector(0.0, 1.0, 5.0));
+    TestEqual("v2", v2, FVector(1.0, 0.0, 5.0));
+  });
+
+  It("ignores hits beyond the maximum distance", [this]() {
+    TArray<FVector> vertices;
+    TArray<int32> indices;
+    addGrid(vertices, indices, 8, 0.0);
+    CesiumTriangleBvh bvh(MoveTemp(vertices), indices);
+
+    double distance;
+    TestFalse(
+        "short",
+        bvh.intersectRay(
+            FVector(4.5, 4.5, 10.0),
+            FVector(0.0, 0.0, -1.0),
+            5.0,
+            distance));
+    TestFalse(
+        "outside",
+        bvh.intersectRay(
+            FVector(20.0, 4.5, 10.0),
+            FVector(0.0, 0.0, -1.0),
+            100.0,
+            distance));
+  });
+}
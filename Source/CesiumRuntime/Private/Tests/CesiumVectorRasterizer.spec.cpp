@@ -0,0 +1,164 @@
+#include "CesiumUtility/Math.h"
+#include "CesiumVectorRasterizer.h"
+#include "Misc/AutomationTest.h"
+#include <cstring>
+
+using namespace CesiumGeometry;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumVectorRasterizerSpec,
+    "Cesium.Unit.VectorRasterizer",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+std::vector<std::byte> toBytes(const char* text) {
+  std::vector<std::byte> bytes(std::strlen(text));
+  std::memcpy(bytes.data(), text, bytes.size());
+  return bytes;
+}
+
+glm::u8vec4 getPixel(
+    const std::vector<uint8_t>& pixels,
+    int32_t width,
+    int32_t column,
+    int32_t row) {
+  const uint8_t* pPixel = pixels.data() + (size_t(row) * width + column) * 4;
+  return glm::u8vec4(pPixel[0], pPixel[1], pPixel[2], pPixel[3]);
+}
+END_DEFINE_SPEC(FCesiumVectorRasterizerSpec)
+
+void FCesiumVectorRasterizerSpec::Define() {
+  Describe("parseGeoJson", [this]() {
+    It("reads lines and polygons and ignores points", [this]() {
+      std::string error;
+      std::optional<CesiumVectorFeatures> features =
+          CesiumVectorFeatures::parseGeoJson(
+              toBytes(R"({
+                "type": "FeatureCollection",
+                "features": [
+                  {
+                    "type": "Feature",
+                    "geometry": {
+                      "type": "LineString",
+                      "coordinates": [[0, 0], [90, 0], [90, 45]]
+                    }
+                  },
+                  {
+                    "type": "Feature",
+                    "geometry": {
+                      "type": "Polygon",
+                      "coordinates": [[[0, 0], [1, 0], [1, 1], [0, 0]]]
+                    }
+                  },
+                  {
+                    "type": "Feature",
+                    "geometry": { "type": "Point", "coordinates": [0, 0] }
+                  }
+                ]
+              })"),
+              error);
+      TestTrue("parsed", features.has_value());
+      if (!features) {
+        return;
+      }
+
+      TestEqual("lines", features->lines.size(), size_t(1));
+      TestEqual("polygons", features->polygons.size(), size_t(1));
+      if (features->lines.size() == 1) {
+        TestEqual("vertices", features->lines[0].size(), size_t(3));
+        TestEqual(
+            "longitude in radians",
+            features->lines[0][1].x,
+            CesiumUtility::Math::degreesToRadians(90.0));
+      }
+    });
+
+    It("fails on invalid JSON", [this]() {
+      std::string error;
+      TestFalse(
+          "parsed",
+          CesiumVectorFeatures::parseGeoJson(toBytes("{ \"type\": "), error)
+              .has_value());
+      TestFalse("error", error.empty());
+    });
+  });
+
+  Describe("findSegments", [this]() {
+    It("finds only the segments near the rectangle", [this]() {
+      CesiumVectorFeatures features;
+      for (int32_t i = 0; i < 16; ++i) {
+        const double x = double(i);
+        features.lines.push_back(
+            {glm::dvec2(x, 0.0), glm::dvec2(x + 0.5, 0.5)});
+      }
+
+      CesiumVectorRasterizer rasterizer(features, CesiumVectorStyle());
+      TestEqual("segments", rasterizer.getSegmentCount(), size_t(16));
+
+      const std::vector<uint32_t> found =
+          rasterizer.findSegments(Rectangle(2.75, 0.25, 4.25, 1.0));
+      TestEqual("count", found.size(), size_t(2));
+      if (found.size() == 2) {
+        TestEqual("first", found[0], uint32_t(3));
+        TestEqual("second", found[1], uint32_t(4));
+      }
+    });
+  });
+
+  Describe("rasterize", [this]() {
+    It("draws lines with their width", [this]() {
+      CesiumVectorFeatures features;
+      features.lines.push_back({glm::dvec2(-1.0, 0.5), glm::dvec2(2.0, 0.5)});
+      CesiumVectorStyle style;
+      style.lineColor = glm::u8vec4(255, 0, 0, 255);
+      style.lineWidth = 2.0;
+
+      CesiumVectorRasterizer rasterizer(features, style);
+      const Rectangle rectangle(0.0, 0.0, 1.0, 1.0);
+      std::vector<uint8_t> pixels(8 * 8 * 4);
+      TestTrue("overlaps", rasterizer.overlaps(rectangle, 8, 8));
+      TestTrue("drawn", rasterizer.rasterize(rectangle, 8, 8, pixels.data()));
+
+      TestEqual("on line", getPixel(pixels, 8, 2, 3), style.lineColor);
+      TestEqual("on line", getPixel(pixels, 8, 5, 4), style.lineColor);
+      TestEqual("away", getPixel(pixels, 8, 2, 0).a, uint8_t(0));
+      TestEqual("away", getPixel(pixels, 8, 5, 7).a, uint8_t(0));
+    });
+
+    It("fills polygons", [this]() {
+      CesiumVectorFeatures features;
+      features.polygons.push_back(
+          {glm::dvec2(0.25, 0.25),
+           glm::dvec2(0.75, 0.25),
+           glm::dvec2(0.75, 0.75),
+           glm::dvec2(0.25, 0.75)});
+      CesiumVectorStyle style;
+      style.fillColor = glm::u8vec4(0, 0, 255, 128);
+
+      CesiumVectorRasterizer rasterizer(features, style);
+      std::vector<uint8_t> pixels(8 * 8 * 4);
+      TestTrue(
+          "drawn",
+          rasterizer.rasterize(
+              Rectangle(0.0, 0.0, 1.0, 1.0),
+              8,
+              8,
+              pixels.data()));
+
+      TestEqual("inside", getPixel(pixels, 8, 4, 4), style.fillColor);
+      TestEqual("outside", getPixel(pixels, 8, 0, 0).a, uint8_t(0));
+    });
+
+    It("leaves rectangles away from every feature transparent", [this]() {
+      CesiumVectorFeatures features;
+      features.lines.push_back({glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 1.0)});
+      CesiumVectorRasterizer rasterizer(features, CesiumVectorStyle());
+
+      const Rectangle rectangle(5.0, 5.0, 6.0, 6.0);
+      std::vector<uint8_t> pixels(4 * 4 * 4, 0xff);
+      TestFalse("overlaps", rasterizer.overlaps(rectangle, 4, 4));
+      TestFalse("drawn", rasterizer.rasterize(rectangle, 4, 4, pixels.data()));
+      TestEqual("transparent", getPixel(pixels, 4, 1, 1).a, uint8_t(0));
+    });
+  });
+}
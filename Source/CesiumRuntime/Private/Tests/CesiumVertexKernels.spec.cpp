@@ -0,0 +1,191 @@
+#include "CesiumVertexKernels.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumVertexKernels;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumVertexKernelsSpec,
+    "Cesium.Unit.VertexKernels",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumVertexKernelsSpec)
+
+void FCesiumVertexKernelsSpec::Define() {
+  Describe("computeBounds", [this]() {
+    It("finds the minimum and maximum of each component", [this]() {
+      std::vector<FVector3f> positions{
+          FVector3f(1.0f, -2.0f, 3.0f),
+          FVector3f(-4.0f, 5.0f, 0.5f),
+          FVector3f(2.0f, 0.0f, -6.0f)};
+      FVector3f minimum;
+      FVector3f maximum;
+      TestTrue(
+          "computed",
+          computeBounds(getElements(positions), minimum, maximum));
+      TestEqual("minimum", minimum, FVector3f(-4.0f, -2.0f, -6.0f));
+      TestEqual("maximum", maximum, FVector3f(2.0f, 5.0f, 3.0f));
+    });
+
+    It("fails without positions", [this]() {
+      std::vector<FVector3f> positions;
+      FVector3f minimum;
+      FVector3f maximum;
+      TestFalse(
+          "computed",
+          computeBounds(getElements(positions), minimum, maximum));
+    });
+  });
+
+  Describe("copyPositionsFlipY", [this]() {
+    It("negates Y and measures the farthest position", [this]() {
+      std::vector<FVector3f> positions{
+          FVector3f(1.0f, 2.0f, 3.0f),
+          FVector3f(0.0f, -4.0f, 0.0f)};
+      TArray<FVector3f> copied;
+      copied.SetNum(2);
+      const float radius = copyPositionsFlipY(
+          getElements(positions),
+          TConstArrayView<uint32>(),
+          copied.GetData(),
+          FVector3f::ZeroVector);
+      TestEqual("first", copied[0], FVector3f(1.0f, -2.0f, 3.0f));
+      TestEqual("second", copied[1], FVector3f(0.0f, 4.0f, 0.0f));
+      TestEqual("radius", radius, 4.0f);
+    });
+
+    It("duplicates indexed positions", [this]() {
+      std::vector<FVector3f> positions{
+          FVector3f(1.0f, 0.0f, 0.0f),
+          FVector3f(0.0f, 1.0f, 0.0f)};
+      const TArray<uint32> indices{1, 0, 1};
+      TArray<FVector3f> copied;
+      copied.SetNum(3);
+      copyPositionsFlipY(
+          getElements(positions),
+          indices,
+          copied.GetData(),
+          FVector3f::ZeroVector);
+      TestEqual("first", copied[0], FVector3f(0.0f, -1.0f, 0.0f));
+      TestEqual("second", copied[1], FVector3f(1.0f, 0.0f, 0.0f));
+      TestEqual("third", copied[2], FVector3f(0.0f, -1.0f, 0.0f));
+    });
+  });
+
+  Describe("copyIndices", [this]() {
+    It("widens strided indices and returns the largest", [this]() {
+      // Every other uint16 is padding.
+      const uint16 data[] = {3, 99, 7, 99, 1, 99};
+      StridedElements<uint16> source;
+      source.pData = reinterpret_cast<const std::byte*>(data);
+      source.stride = 2 * sizeof(uint16);
+      source.count = 3;
+
+      uint32 copied[3];
+      TestEqual("maximum", copyIndices(source, copied), uint32(7));
+      TestEqual("first", copied[0], uint32(3));
+      TestEqual("second", copied[1], uint32(7));
+      TestEqual("third", copied[2], uint32(1));
+    });
+  });
+
+  Describe("triangulateStrip", [this]() {
+    It("alternates the winding of the triangles", [this]() {
+      std::vector<uint32> strip{0, 1, 2, 3};
+      uint32 triangles[6];
+      TestEqual(
+          "maximum",
+          triangulateStrip(getElements(strip), triangles),
+          uint32(3));
+      const uint32 expected[6] = {0, 1, 2, 1, 3, 2};
+      for (int32 i = 0; i < 6; ++i) {
+        TestEqual("index", triangles[i], expected[i]);
+      }
+    });
+  });
+
+  Describe("orderPointsProgressively", [this]() {
+    It("keeps every point exactly once", [this]() {
+      std::vector<FVector3f> positions;
+      TArray<uint32> indices;
+      for (int32 i = 0; i < 100; ++i) {
+        positions.emplace_back(float(i % 10), float(i / 10), 0.0f);
+        indices.Add(uint32(i));
+      }
+
+      orderPointsProgressively(getElements(positions), indices);
+
+      TArray<uint32> sorted = indices;
+      sorted.Sort();
+      for (int32 i = 0; i < sorted.Num(); ++i) {
+        TestEqual("index", sorted[i], uint32(i));
+      }
+    });
+
+    It("spreads the first points over the bounds", [this]() {
+      // Points along a line, stored in order from one end to the other.
+      std::vector<FVector3f> positions;
+      TArray<uint32> indices;
+      for (int32 i = 0; i < 64; ++i) {
+        positions.emplace_back(float(i), 0.0f, 0.0f);
+        indices.Add(uint32(i));
+      }
+
+      orderPointsProgressively(getElements(positions), indices);
+
+      // The first quarter of the points should reach both halves of the line.
+      bool hasLow = false;
+      bool hasHigh = false;
+      for (int32 i = 0; i < 16; ++i) {
+        hasLow |= indices[i] < 32;
+        hasHigh |= indices[i] >= 32;
+      }
+      TestTrue("has low", hasLow);
+      TestTrue("has high", hasHigh);
+    });
+  });
+
+  Describe("convertColors", [this]() {
+    It("converts normalized unsigned shorts", [this]() {
+      using Color = CesiumGltf::AccessorTypes::VEC4<uint16_t>;
+      std::vector<Color> colors(1);
+      colors[0].value[0] = 65535;
+      colors[0].value[1] = 32768;
+      colors[0].value[2] = 0;
+      colors[0].value[3] = 256;
+
+      FColor converted;
+      TestTrue(
+          "converted",
+          convertColors<Color, 4>(
+              getElements(colors),
+              TConstArrayView<uint32>(),
+              &converted));
+      TestEqual("color", converted, FColor(255, 128, 0, 1));
+    });
+
+    It("makes three-component colors opaque", [this]() {
+      using Color = CesiumGltf::AccessorTypes::VEC3<float>;
+      std::vector<Color> colors(1);
+      colors[0].value[0] = 1.0f;
+      colors[0].value[1] = 0.0f;
+      colors[0].value[2] = 1.0f;
+
+      FColor converted;
+      convertColors<Color, 3>(
+          getElements(colors),
+          TConstArrayView<uint32>(),
+          &converted);
+      TestEqual("color", converted, FColor(255, 0, 255, 255));
+    });
+
+    It("fails if an index is out of range", [this]() {
+      using Color = CesiumGltf::AccessorTypes::VEC3<uint8_t>;
+      std::vector<Color> colors(1);
+      const TArray<uint32> indices{0, 1};
+      FColor converted[2];
+      TestFalse(
+          "converted",
+          convertColors<Color, 3>(getElements(colors), indices, converted));
+    });
+  });
+}
@@ -0,0 +1,86 @@
+#include "CesiumWarmStartAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestFixtures.h"
+#include "Misc/AutomationTest.h"
+#include <optional>
+
+using CesiumTestHelpers::TestAssetAccessor;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumWarmStartAssetAccessorSpec,
+    "Cesium.Unit.WarmStartAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<TestAssetAccessor> pPending;
+std::optional<CesiumWarmStartAssetAccessor> warmStart;
+END_DEFINE_SPEC(FCesiumWarmStartAssetAccessorSpec)
+
+void FCesiumWarmStartAssetAccessorSpec::Define() {
+  BeforeEach([this]() {
+    pPending = std::make_shared<TestAssetAccessor>();
+    warmStart.emplace(
+        pPending,
+        std::vector<std::string>{
+            "https://a.com/tileset.json",
+            "https://a.com/1.glb",
+            "https://a.com/2.glb",
+            "https://b.com/3.glb"});
+  });
+
+  AfterEach([this]() {
+    pPending->finishAll();
+    warmStart.reset();
+    pPending.reset();
+  });
+
+  It("prefetches a host's URLs with its first request's headers", [this]() {
+    warmStart->get(
+        getAsyncSystem(),
+        "https://a.com/tileset.json",
+        {{"Authorization", "Bearer x"}});
+    if (!TestEqual("requests", pPending->urls.size(), size_t(3))) {
+      return;
+    }
+    TestTrue("prefetched", pPending->urls[0] == "https://a.com/1.glb");
+    TestTrue(
+        "headers",
+        pPending->requestHeaders[0].size() == 1 &&
+            pPending->requestHeaders[0][0].second == "Bearer x");
+  });
+
+  It("gives prefetched responses to later requests", [this]() {
+    warmStart->get(getAsyncSystem(), "https://a.com/tileset.json", {});
+    const size_t requests = pPending->urls.size();
+
+    warmStart->get(getAsyncSystem(), "https://a.com/2.glb", {});
+    TestEqual("requests", pPending->urls.size(), requests);
+    TestEqual("prefetched", warmStart->getPrefetchedRequestCount(), int64(1));
+
+    // Each prefetched response is only used once.
+    warmStart->get(getAsyncSystem(), "https://a.com/2.glb", {});
+    TestEqual("requests again", pPending->urls.size(), requests + 1);
+  });
+
+  It("records each URL once, in order, until finished", [this]() {
+    warmStart->get(getAsyncSystem(), "https://c.com/x", {});
+    warmStart->get(getAsyncSystem(), "https://c.com/y", {});
+    warmStart->get(getAsyncSystem(), "https://c.com/x", {});
+    warmStart->get(
+        getAsyncSystem(),
+        "https://api.c.com/endpoint?access_token=secret",
+        {});
+
+    std::vector<std::string> urls = warmStart->finishRecording();
+    TestFalse("recording", warmStart->isRecording());
+    if (!TestEqual("count", urls.size(), size_t(2))) {
+      return;
+    }
+    TestTrue("first", urls[0] == "https://c.com/x");
+    TestTrue("second", urls[1] == "https://c.com/y");
+
+    // Nothing is prefetched once recording has finished.
+    warmStart->get(getAsyncSystem(), "https://b.com/other.glb", {});
+    TestEqual("requests", pPending->urls.size(), size_t(5));
+  });
+}
@@ -0,0 +1,96 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumWgs84Ellipsoid.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumWgs84EllipsoidSpec,
+    "Cesium.Unit.CesiumWgs84Ellipsoid",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+// Enough positions to be split across worker threads, and not a multiple of
+// four, so that the remainder of every chunk is exercised too.
+static constexpr int32 PositionCount = 40003;
+
+TArray<FVector> CreateLongitudeLatitudeHeights() {
+  TArray<FVector> result;
+  result.Reserve(PositionCount);
+  for (int32 i = 0; i < PositionCount; ++i) {
+    result.Emplace(
+        -180.0 + 360.0 * i / PositionCount,
+        -89.0 + 178.0 * ((i * 7919) % PositionCount) / PositionCount,
+        -100.0 + (i % 1000) * 10.0);
+  }
+  return result;
+}
+
+END_DEFINE_SPEC(FCesiumWgs84EllipsoidSpec)
+
+void FCesiumWgs84EllipsoidSpec::Define() {
+  Describe("batch functions", [this]() {
+    It("match the single-position functions", [this]() {
+      const TArray<FVector> llh = CreateLongitudeLatitudeHeights();
+      const TArray<FVector> ecef =
+          UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightsToEarthCenteredEarthFixed(
+              llh);
+      const TArray<FVector> roundTrip =
+          UCesiumWgs84Ellipsoid::EarthCenteredEarthFixedToLongitudeLatitudeHeights(
+              ecef);
+      const TArray<FVector> surface =
+          UCesiumWgs84Ellipsoid::ScalePositionsToGeodeticSurface(ecef);
+      const TArray<FVector> normals =
+          UCesiumWgs84Ellipsoid::GeodeticSurfaceNormals(ecef);
+
+      TestEqual("ECEF count", ecef.Num(), PositionCount);
+      TestEqual("LLH count", roundTrip.Num(), PositionCount);
+      TestEqual("surface count", surface.Num(), PositionCount);
+      TestEqual("normal count", normals.Num(), PositionCount);
+      if (ecef.Num() != PositionCount || roundTrip.Num() != PositionCount ||
+          surface.Num() != PositionCount || normals.Num() != PositionCount) {
+        return;
+      }
+
+      for (int32 i = 0; i < PositionCount; ++i) {
+        const FVector expectedEcef =
+            UCesiumWgs84Ellipsoid::LongitudeLatitudeHeightToEarthCenteredEarthFixed(
+                llh[i]);
+        if (!ecef[i].Equals(expectedEcef, 1e-6)) {
+          AddError(FString::Printf(TEXT("ECEF position %d differs"), i));
+          return;
+        }
+        if (!roundTrip[i].Equals(
+                UCesiumWgs84Ellipsoid::
+                    EarthCenteredEarthFixedToLongitudeLatitudeHeight(ecef[i]),
+                1e-9)) {
+          AddError(FString::Printf(TEXT("LLH position %d differs"), i));
+          return;
+        }
+        if (!surface[i].Equals(
+                UCesiumWgs84Ellipsoid::ScaleToGeodeticSurface(ecef[i]),
+                1e-6)) {
+          AddError(FString::Printf(TEXT("surface position %d differs"), i));
+          return;
+        }
+        if (!normals[i].Equals(
+                UCesiumWgs84Ellipsoid::GeodeticSurfaceNormal(ecef[i]),
+                1e-12)) {
+          AddError(FString::Printf(TEXT("surface normal %d differs"), i));
+          return;
+        }
+      }
+    });
+
+    It("return empty arrays for empty input", [this]() {
+      const TArray<FVector> empty;
+      TestEqual(
+          "surface positions",
+          UCesiumWgs84Ellipsoid::ScalePositionsToGeodeticSurface(empty).Num(),
+          0);
+      TestEqual(
+          "surface normals",
+          UCesiumWgs84Ellipsoid::GeodeticSurfaceNormals(empty).Num(),
+          0);
+    });
+  });
+}
@@ -28,4 +28,87 @@ void FGeoTransformsSpec::Define() {
       TestEqual("is at the origin", ue, glm::dvec3(0.0));
     });
   });
+
+  Describe("batch transforms", [this]() {
+    It("matches the single-position transforms", [this]() {
+      // Seven positions, so that both the four-wide path and the remainder are
+      // exercised.
+      const TArray<glm::dvec3> longitudeLatitudeHeights{
+          glm::dvec3(12.0, 23.0, 1000.0),
+          glm::dvec3(-75.6, 40.0, 0.0),
+          glm::dvec3(170.0, -89.5, 8848.0),
+          glm::dvec3(0.0, 0.0, -100.0),
+          glm::dvec3(151.2, -33.9, 58.0),
+          glm::dvec3(-0.1, 51.5, 11.0),
+          glm::dvec3(139.7, 35.7, 40.0)};
+
+      GeoTransforms geotransforms{};
+      geotransforms.setCenter(
+          geotransforms.TransformLongitudeLatitudeHeightToEcef(
+              glm::dvec3(-75.0, 40.0, 100.0)));
+      const glm::dvec3 origin(1000.0, -2000.0, 300.0);
+
+      TArray<glm::dvec3> ue;
+      ue.SetNum(longitudeLatitudeHeights.Num());
+      geotransforms.TransformLongitudeLatitudeHeightToUnreal(
+          origin,
+          longitudeLatitudeHeights,
+          ue);
+
+      TArray<glm::dvec3> ecef;
+      ecef.SetNum(ue.Num());
+      geotransforms.TransformUnrealToEcef(origin, ue, ecef);
+
+      TArray<glm::dvec3> llh;
+      llh.SetNum(ue.Num());
+      geotransforms.TransformUnrealToLongitudeLatitudeHeight(origin, ue, llh);
+
+      for (int32 i = 0; i < longitudeLatitudeHeights.Num(); ++i) {
+        const glm::dvec3 expectedUe =
+            geotransforms.TransformLongitudeLatitudeHeightToUnreal(
+                origin,
+                longitudeLatitudeHeights[i]);
+        TestTrue(
+            "Unreal position",
+            Math::equalsEpsilon(ue[i], expectedUe, 0.0, 1e-6));
+        TestTrue(
+            "ECEF position",
+            Math::equalsEpsilon(
+                ecef[i],
+                geotransforms.TransformUnrealToEcef(origin, expectedUe),
+                0.0,
+                1e-6));
+        TestTrue(
+            "round trip",
+            Math::equalsEpsilon(
+                llh[i],
+                longitudeLatitudeHeights[i],
+                0.0,
+                1e-4));
+      }
+    });
+
+    It("transforms in place", [this]() {
+      GeoTransforms geotransforms{};
+      const glm::dvec3 origin(0.0);
+      TArray<glm::dvec3> positions{
+          glm::dvec3(6378137.0, 0.0, 0.0),
+          glm::dvec3(0.0, 6378137.0, 0.0),
+          glm::dvec3(0.0, 0.0, 6356752.0),
+          glm::dvec3(1.0, 2.0, 3.0),
+          glm::dvec3(-6378137.0, 0.0, 0.0)};
+      TArray<glm::dvec3> expected;
+      for (const glm::dvec3& position : positions) {
+        expected.Add(geotransforms.TransformEcefToUnreal(origin, position));
+      }
+
+      geotransforms.TransformEcefToUnreal(origin, positions, positions);
+
+      for (int32 i = 0; i < positions.Num(); ++i) {
+        TestTrue(
+            "Unreal position",
+            Math::equalsEpsilon(positions[i], expected[i], 0.0, 1e-6));
+      }
+    });
+  });
 }
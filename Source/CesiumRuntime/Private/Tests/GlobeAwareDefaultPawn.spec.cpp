@@ -89,6 +89,39 @@ void FGlobeAwareDefaultPawnSpec::Define() {
 
           pPawn->Destroy();
         });
+        It("with a sampled flight path", [this]() {
+          UWorld* pWorld = GEditor->PlayWorld;
+
+          TActorIterator<AGlobeAwareDefaultPawn> it(pWorld);
+          AGlobeAwareDefaultPawn* pPawn = *it;
+          UCesiumFlyToComponent* pFlyTo =
+              pPawn->FindComponentByClass<UCesiumFlyToComponent>();
+          TestNotNull("pFlyTo", pFlyTo);
+          pFlyTo->Duration = 5.0f;
+          pFlyTo->FlightPathSamples = 64;
+
+          UCesiumGlobeAnchorComponent* pGlobeAnchor =
+              pPawn->FindComponentByClass<UCesiumGlobeAnchorComponent>();
+          TestNotNull("pGlobeAnchor", pGlobeAnchor);
+
+          pFlyTo->FlyToLocationLongitudeLatitudeHeight(
+              FVector(25.0, 10.0, 100.0),
+              0.0,
+              0.0,
+              false);
+
+          Cast<UActorComponent>(pFlyTo)->TickComponent(
+              4.9999f,
+              ELevelTick::LEVELTICK_All,
+              nullptr);
+
+          FVector llh = pGlobeAnchor->GetLongitudeLatitudeHeight();
+          TestTrue(
+              "Height is close to final height",
+              FMath::IsNearlyEqual(llh.Z, 100.0, 10.0));
+
+          pPawn->Destroy();
+        });
       });
 }
 
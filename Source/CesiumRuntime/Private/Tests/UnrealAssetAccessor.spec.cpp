@@ -1,6 +1,7 @@
 #include "Async/Async.h"
 #include "CesiumAsync/IAssetResponse.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/AutomationTest.h"
 #include "Misc/FileHelper.h"
@@ -16,6 +17,7 @@ BEGIN_DEFINE_SPEC(
 FString Filename;
 std::string randomText = "Some random text.";
 IPlatformFile* FileManager;
+bool useMemoryMappedFileReads;
 
 void TestAccessorRequest(const FString& Uri, const std::string& expectedData) {
   bool done = false;
@@ -48,6 +50,10 @@ END_DEFINE_SPEC(FUnrealAssetAccessorSpec)
 
 void FUnrealAssetAccessorSpec::Define() {
   BeforeEach([this]() {
+    // Tests may change this, so it's restored after each one even if it fails.
+    useMemoryMappedFileReads =
+        GetDefault<UCesiumRuntimeSettings>()->UseMemoryMappedFileReads;
+
     Filename = FPaths::ConvertRelativePathToFull(
         FPaths::CreateTempFilename(*FPaths::ProjectSavedDir()));
 
@@ -58,7 +64,11 @@ void FUnrealAssetAccessorSpec::Define() {
         FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
   });
 
-  AfterEach([this]() { FileManager->DeleteFile(*Filename); });
+  AfterEach([this]() {
+    FileManager->DeleteFile(*Filename);
+    GetMutableDefault<UCesiumRuntimeSettings>()->UseMemoryMappedFileReads =
+        useMemoryMappedFileReads;
+  });
 
   It("Fails with non-existant file:/// URLs", [this]() {
     FString Uri = TEXT("file:///") + Filename;
@@ -85,4 +95,15 @@ void FUnrealAssetAccessorSpec::Define() {
 
     TestAccessorRequest(Uri, randomText);
   });
+
+  It("Can access file:/// URLs with memory-mapped reads", [this]() {
+    FString Uri = TEXT("file:///") + Filename;
+    Uri.ReplaceCharInline('\\', '/');
+    Uri.ReplaceInline(TEXT(" "), TEXT("%20"));
+
+    GetMutableDefault<UCesiumRuntimeSettings>()->UseMemoryMappedFileReads =
+        true;
+
+    TestAccessorRequest(Uri, randomText);
+  });
 }
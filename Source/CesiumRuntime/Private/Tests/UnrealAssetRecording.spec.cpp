@@ -0,0 +1,123 @@
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UnrealAssetAccessor.h"
+#include "UnrealAssetRecording.h"
+
+BEGIN_DEFINE_SPEC(
+    FUnrealAssetRecordingSpec,
+    "Cesium.Unit.UnrealAssetRecording",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+FString Filename;
+FString Uri;
+FString ArchiveDirectory;
+std::string randomText = "Some random text.";
+
+std::shared_ptr<CesiumAsync::IAssetRequest>
+RequestAndWait(CesiumAsync::IAssetAccessor& accessor, const FString& url) {
+  std::shared_ptr<CesiumAsync::IAssetRequest> pResult;
+  bool done = false;
+
+  accessor.get(getAsyncSystem(), TCHAR_TO_UTF8(*url), {})
+      .thenInMainThread(
+          [&](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            pResult = std::move(pRequest);
+            done = true;
+          });
+
+  while (!done) {
+    accessor.tick();
+    getAsyncSystem().dispatchMainThreadTasks();
+  }
+
+  return pResult;
+}
+
+std::string GetData(const CesiumAsync::IAssetRequest& request) {
+  const CesiumAsync::IAssetResponse* pResponse = request.response();
+  if (!pResponse)
+    return std::string();
+
+  gsl::span<const std::byte> data = pResponse->data();
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+END_DEFINE_SPEC(FUnrealAssetRecordingSpec)
+
+void FUnrealAssetRecordingSpec::Define() {
+  BeforeEach([this]() {
+    Filename = FPaths::ConvertRelativePathToFull(
+        FPaths::CreateTempFilename(*FPaths::ProjectSavedDir()));
+    FFileHelper::SaveStringToFile(
+        UTF8_TO_TCHAR(randomText.c_str()),
+        *Filename,
+        FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+    Uri = TEXT("file:///") + Filename;
+    Uri.ReplaceCharInline('\\', '/');
+    Uri.ReplaceInline(TEXT(" "), TEXT("%20"));
+
+    ArchiveDirectory = FPaths::ConvertRelativePathToFull(
+        FPaths::CreateTempFilename(*FPaths::ProjectSavedDir()));
+  });
+
+  AfterEach([this]() {
+    IFileManager::Get().Delete(*Filename);
+    IFileManager::Get().DeleteDirectory(*ArchiveDirectory, false, true);
+  });
+
+  It("Replays recorded responses", [this]() {
+    UnrealRecordingAssetAccessor recorder(
+        std::make_shared<UnrealAssetAccessor>(),
+        ArchiveDirectory);
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRecorded =
+        RequestAndWait(recorder, Uri);
+    TestEqual("recorded data", GetData(*pRecorded), randomText);
+
+    // Replay must not read the original file
+    IFileManager::Get().Delete(*Filename);
+
+    UnrealReplayAssetAccessor replayer(ArchiveDirectory);
+    std::shared_ptr<CesiumAsync::IAssetRequest> pReplayed =
+        RequestAndWait(replayer, Uri);
+    TestEqual("url", pReplayed->url(), std::string(TCHAR_TO_UTF8(*Uri)));
+    TestEqual(
+        "status code",
+        pReplayed->response()->statusCode(),
+        pRecorded->response()->statusCode());
+    TestEqual("replayed data", GetData(*pReplayed), randomText);
+  });
+
+  It("Returns 404 for requests that were not recorded", [this]() {
+    UnrealReplayAssetAccessor replayer(ArchiveDirectory);
+    std::shared_ptr<CesiumAsync::IAssetRequest> pReplayed =
+        RequestAndWait(replayer, Uri);
+    TestEqual("status code", pReplayed->response()->statusCode(), 404);
+    TestEqual("data", GetData(*pReplayed), std::string());
+  });
+
+  It("Delays responses by the simulated latency", [this]() {
+    UnrealRecordingAssetAccessor recorder(
+        std::make_shared<UnrealAssetAccessor>(),
+        ArchiveDirectory);
+    RequestAndWait(recorder, Uri);
+
+    UnrealReplayNetworkProfile profile;
+    profile.latencyMilliseconds = 100.0;
+    UnrealReplayAssetAccessor replayer(ArchiveDirectory, profile);
+
+    const double start = FPlatformTime::Seconds();
+    std::shared_ptr<CesiumAsync::IAssetRequest> pReplayed =
+        RequestAndWait(replayer, Uri);
+    const double elapsed = FPlatformTime::Seconds() - start;
+
+    TestTrue("delayed", elapsed >= 0.1);
+    TestEqual("replayed data", GetData(*pReplayed), randomText);
+  });
+}
@@ -0,0 +1,98 @@
+#include "UnrealCacheDatabase.h"
+#include "Async/Async.h"
+#include "CesiumTestFixtures.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+using CesiumTestHelpers::MemoryCacheDatabase;
+
+BEGIN_DEFINE_SPEC(
+    FUnrealCacheDatabaseSpec,
+    "Cesium.Unit.UnrealCacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<MemoryCacheDatabase> pMemory;
+
+void Store(UnrealCacheDatabase& database, const std::string& key, uint8 value) {
+  const std::byte data[] = {std::byte(value)};
+  database.storeEntry(
+      key,
+      0,
+      key,
+      "GET",
+      {},
+      200,
+      {},
+      gsl::span<const std::byte>(data));
+}
+END_DEFINE_SPEC(FUnrealCacheDatabaseSpec)
+
+void FUnrealCacheDatabaseSpec::Define() {
+  BeforeEach([this]() { pMemory = std::make_shared<MemoryCacheDatabase>(); });
+
+  AfterEach([this]() { pMemory.reset(); });
+
+  It("writes right away without a maintenance thread", [this]() {
+    UnrealCacheDatabase database(pMemory, 0);
+    Store(database, "a", 1);
+    TestEqual("written", pMemory->writeCount, 1);
+    TestEqual("queued", database.getQueuedWriteCount(), 0);
+  });
+
+  It("finds queued writes before they're written", [this]() {
+    UnrealCacheDatabase database(pMemory, 0, true);
+    Store(database, "a", 1);
+    Store(database, "a", 2);
+
+    std::optional<CesiumAsync::CacheItem> item = database.getEntry("a");
+    TestTrue("found", item.has_value());
+    if (item) {
+      TestEqual(
+          "latest",
+          item->cacheResponse.data,
+          std::vector<std::byte>{std::byte(2)});
+    }
+
+    // Shutting down writes everything that's still queued.
+    database.shutdown();
+    TestEqual("queued", database.getQueuedWriteCount(), 0);
+    TestTrue("written", pMemory->writeCount >= 1);
+    TestTrue("stored", pMemory->getEntry("a").has_value());
+  });
+
+  It("doesn't write responses that were queued before clearing", [this]() {
+    pMemory->blockWrites = true;
+    UnrealCacheDatabase database(pMemory, 0, true);
+    Store(database, "a", 1);
+
+    // Wait for the maintenance thread to start writing the first batch.
+    const double timeout = FPlatformTime::Seconds() + 10.0;
+    while (pMemory->getBlockedWriteCount() == 0 &&
+           FPlatformTime::Seconds() < timeout) {
+      FPlatformProcess::Sleep(0.001f);
+    }
+    TestEqual("writing", pMemory->getBlockedWriteCount(), 1);
+    Store(database, "b", 2);
+
+    TFuture<bool> cleared = Async(EAsyncExecution::Thread, [&database]() {
+      return database.clearAll();
+    });
+    pMemory->unblockWrites();
+    TestTrue("cleared", cleared.Get());
+
+    // Shutting down writes everything that's still queued.
+    database.shutdown();
+    TestEqual("queued", database.getQueuedWriteCount(), 0);
+    TestEqual("items", pMemory->items.size(), size_t(0));
+    TestFalse("a", database.getEntry("a").has_value());
+    TestFalse("b", database.getEntry("b").has_value());
+  });
+
+  It("prunes on the maintenance thread", [this]() {
+    UnrealCacheDatabase database(pMemory, 0, true);
+    database.prune();
+    database.shutdown();
+    TestEqual("pruned", pMemory->pruneCount, 1);
+  });
+}
@@ -3,11 +3,16 @@
 #include "UnrealAssetAccessor.h"
 #include "Async/Async.h"
 #include "Async/AsyncWork.h"
+#include "Async/MappedFileHandle.h"
 
 #include "CesiumAsync/AsyncSystem.h"
 #include "CesiumAsync/IAssetRequest.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumCommon.h"
+#include "CesiumRequestCancellation.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformFileManager.h"
 #include "HttpManager.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpRequest.h"
@@ -16,11 +21,15 @@
 #include "Misc/App.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/FileHelper.h"
+#include "UnrealAssetAccessorUtility.h"
+#include <atomic>
 #include <cstddef>
 #include <cstring>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <uriparser/Uri.h>
+#include <vector>
 
 namespace {
 
@@ -40,11 +49,86 @@ CesiumAsync::HttpHeaders parseHeaders(const TArray<FString>& unrealHeaders) {
   return result;
 }
 
+/**
+ * HTTP headers that are parsed from an Unreal request or response the first
+ * time they're needed, because most of them never are.
+ */
+class LazyHeaders {
+public:
+  template <typename TRequestOrResponse>
+  const CesiumAsync::HttpHeaders&
+  get(const TRequestOrResponse& requestOrResponse) const {
+    std::call_once(this->_parsed, [this, &requestOrResponse]() {
+      this->_headers = parseHeaders(requestOrResponse.GetAllHeaders());
+    });
+    return this->_headers;
+  }
+
+private:
+  mutable std::once_flag _parsed;
+  mutable CesiumAsync::HttpHeaders _headers;
+};
+
+// The total size of the content of every HTTP response received so far.
+std::atomic<int64_t> totalBytesReceived{0};
+
+/**
+ * The body of a response that is received as it's downloaded, when "Use
+ * Streaming Http Responses" is enabled. The HTTP module writes each chunk of
+ * the body here from its own thread, instead of into the response, and the
+ * completed body is given to cesium-native without being copied.
+ */
+class StreamedBody {
+public:
+  bool append(
+      const TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>& pWeakRequest,
+      const void* pChunk,
+      int64 length) {
+    if (length <= 0) {
+      return true;
+    }
+
+    // The headers have been received by the time the first chunk of the body
+    // is, so the whole body can be allocated at once when its length is known.
+    if (this->_data.empty()) {
+      TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> pRequest =
+          pWeakRequest.Pin();
+      FHttpResponsePtr pResponse = pRequest ? pRequest->GetResponse() : nullptr;
+      if (pResponse && pResponse->GetContentLength() > length) {
+        this->_data.reserve(size_t(pResponse->GetContentLength()));
+      }
+    }
+
+    const std::byte* pBytes = static_cast<const std::byte*>(pChunk);
+    this->_data.insert(this->_data.end(), pBytes, pBytes + length);
+    this->_bytesReceived += length;
+    totalBytesReceived += length;
+    return true;
+  }
+
+  gsl::span<const std::byte> data() const {
+    return gsl::span<const std::byte>(this->_data);
+  }
+
+  /**
+   * Gets the number of bytes of the body received so far, which may be read
+   * from any thread while the body is being received.
+   */
+  const std::atomic<int64_t>& getBytesReceived() const {
+    return this->_bytesReceived;
+  }
+
+private:
+  std::vector<std::byte> _data;
+  std::atomic<int64_t> _bytesReceived{0};
+};
+
 class UnrealAssetResponse : public CesiumAsync::IAssetResponse {
 public:
-  UnrealAssetResponse(FHttpResponsePtr pResponse)
-      : _pResponse(pResponse),
-        _headers(parseHeaders(pResponse->GetAllHeaders())) {}
+  UnrealAssetResponse(
+      FHttpResponsePtr pResponse,
+      const std::shared_ptr<StreamedBody>& pBody)
+      : _pResponse(pResponse), _pBody(pBody), _headers() {}
 
   virtual uint16_t statusCode() const override {
     return static_cast<uint16_t>(this->_pResponse->GetResponseCode());
@@ -55,10 +139,14 @@ public:
   }
 
   virtual const CesiumAsync::HttpHeaders& headers() const override {
-    return this->_headers;
+    return this->_headers.get(*this->_pResponse);
   }
 
   virtual gsl::span<const std::byte> data() const override {
+    if (this->_pBody) {
+      return this->_pBody->data();
+    }
+
     const TArray<uint8>& content = this->_pResponse->GetContent();
     return gsl::span(
         reinterpret_cast<const std::byte*>(content.GetData()),
@@ -67,15 +155,18 @@ public:
 
 private:
   FHttpResponsePtr _pResponse;
-  CesiumAsync::HttpHeaders _headers;
+  std::shared_ptr<StreamedBody> _pBody;
+  LazyHeaders _headers;
 };
 
 class UnrealAssetRequest : public CesiumAsync::IAssetRequest {
 public:
-  UnrealAssetRequest(FHttpRequestPtr pRequest, FHttpResponsePtr pResponse)
+  UnrealAssetRequest(
+      FHttpRequestPtr pRequest,
+      FHttpResponsePtr pResponse,
+      const std::shared_ptr<StreamedBody>& pBody)
       : _pRequest(pRequest),
-        _pResponse(std::make_unique<UnrealAssetResponse>(pResponse)) {
-    this->_headers = parseHeaders(this->_pRequest->GetAllHeaders());
+        _pResponse(std::make_unique<UnrealAssetResponse>(pResponse, pBody)) {
     this->_url = TCHAR_TO_UTF8(*this->_pRequest->GetURL());
     this->_method = TCHAR_TO_UTF8(*this->_pRequest->GetVerb());
   }
@@ -85,7 +176,7 @@ public:
   virtual const std::string& url() const { return this->_url; }
 
   virtual const CesiumAsync::HttpHeaders& headers() const override {
-    return _headers;
+    return this->_headers.get(*this->_pRequest);
   }
 
   virtual const CesiumAsync::IAssetResponse* response() const override {
@@ -97,11 +188,38 @@ private:
   std::unique_ptr<UnrealAssetResponse> _pResponse;
   std::string _url;
   std::string _method;
-  CesiumAsync::HttpHeaders _headers;
+  LazyHeaders _headers;
 };
 
+/**
+ * Resolves a promise with a completed request from a worker thread. The HTTP
+ * module calls request completion callbacks on the game thread, so this keeps
+ * both the wrapping and any continuations attached to the promise off of it.
+ * A streamed body has already been counted as it was received.
+ */
+void resolveInWorkerThread(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>&
+        promise,
+    FHttpRequestPtr pRequest,
+    FHttpResponsePtr pResponse,
+    const std::shared_ptr<StreamedBody>& pBody = nullptr) {
+  if (pResponse && !pBody) {
+    totalBytesReceived += pResponse->GetContent().Num();
+  }
+
+  asyncSystem.runInWorkerThread([promise, pRequest, pResponse, pBody]() {
+    promise.resolve(
+        std::make_unique<UnrealAssetRequest>(pRequest, pResponse, pBody));
+  });
+}
+
 } // namespace
 
+/*static*/ int64 UnrealAssetAccessor::getTotalBytesReceived() {
+  return totalBytesReceived;
+}
+
 UnrealAssetAccessor::UnrealAssetAccessor()
     : _userAgent(), _cesiumRequestHeaders() {
   FString OsVersion, OsSubVersion;
@@ -139,16 +257,6 @@ UnrealAssetAccessor::UnrealAssetAccessor()
   this->_cesiumRequestHeaders.Add(TEXT("X-Cesium-Client-OS"), OsVersion);
 }
 
-namespace {
-
-const char fileProtocol[] = "file:///";
-
-bool isFile(const std::string& url) {
-  return url.compare(0, sizeof(fileProtocol) - 1, fileProtocol) == 0;
-}
-
-} // namespace
-
 CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
 UnrealAssetAccessor::get(
     const CesiumAsync::AsyncSystem& asyncSystem,
@@ -157,8 +265,14 @@ UnrealAssetAccessor::get(
 
   CESIUM_TRACE_BEGIN_IN_TRACK("requestAsset");
 
-  if (isFile(url)) {
-    return getFromFile(asyncSystem, url, headers);
+  // The request group pseudo-header is only used to track the request here,
+  // and must not be sent.
+  std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders = headers;
+  std::optional<uint64_t> requestGroup =
+      CesiumRequestCancellation::extractGroup(requestHeaders);
+
+  if (UnrealAssetAccessorUtility::isFileUrl(url)) {
+    return getFromFile(asyncSystem, url, requestHeaders);
   }
 
   const FString& userAgent = this->_userAgent;
@@ -166,13 +280,18 @@ UnrealAssetAccessor::get(
       this->_cesiumRequestHeaders;
 
   return asyncSystem.createFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
-      [&url, &headers, &userAgent, &cesiumRequestHeaders](const auto& promise) {
+      [&asyncSystem,
+       &url,
+       &requestHeaders,
+       &userAgent,
+       &cesiumRequestHeaders,
+       &requestGroup](const auto& promise) {
         FHttpModule& httpModule = FHttpModule::Get();
         TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
             httpModule.CreateRequest();
         pRequest->SetURL(UTF8_TO_TCHAR(url.c_str()));
 
-        for (const auto& header : headers) {
+        for (const auto& header : requestHeaders) {
           pRequest->SetHeader(
               UTF8_TO_TCHAR(header.first.c_str()),
               UTF8_TO_TCHAR(header.second.c_str()));
@@ -184,17 +303,97 @@ UnrealAssetAccessor::get(
 
         pRequest->AppendToHeader(TEXT("User-Agent"), userAgent);
 
+        std::shared_ptr<StreamedBody> pBody;
+#if ENGINE_VERSION_5_3_OR_HIGHER
+        if (GetDefault<UCesiumRuntimeSettings>()->UseStreamingHttpResponses) {
+          pBody = std::make_shared<StreamedBody>();
+          pRequest->SetResponseBodyReceiveStreamDelegate(
+              FHttpRequestStreamDelegate::CreateLambda(
+                  [pBody,
+                   pWeakRequest =
+                       TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>(pRequest)](
+                      void* pChunk,
+                      int64 length) {
+                    return pBody->append(pWeakRequest, pChunk, length);
+                  }));
+        }
+#endif
+
+        std::optional<uint64_t> cancellationHandle;
+        if (requestGroup) {
+          std::shared_ptr<const std::atomic<int64_t>> pBytesReceived;
+          if (pBody) {
+            pBytesReceived = std::shared_ptr<const std::atomic<int64_t>>(
+                pBody,
+                &pBody->getBytesReceived());
+          } else {
+            std::shared_ptr<std::atomic<int64_t>> pProgress =
+                std::make_shared<std::atomic<int64_t>>(0);
+            pRequest->OnRequestProgress().BindLambda(
+                [pProgress](
+                    FHttpRequestPtr pRequest,
+                    int32 bytesSent,
+                    int32 bytesReceived) { *pProgress = bytesReceived; });
+            pBytesReceived = pProgress;
+          }
+
+          cancellationHandle = CesiumRequestCancellation::registerRequest(
+              *requestGroup,
+              [pWeakRequest =
+                   TWeakPtr<IHttpRequest, ESPMode::ThreadSafe>(pRequest),
+               pBytesReceived]() -> int64_t {
+                TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> pRequest =
+                    pWeakRequest.Pin();
+                if (!pRequest) {
+                  return 0;
+                }
+
+                int64_t bytesRemaining = 0;
+                FHttpResponsePtr pResponse = pRequest->GetResponse();
+                if (pResponse) {
+                  bytesRemaining = int64_t(pResponse->GetContentLength()) -
+                                   pBytesReceived->load();
+                }
+
+                pRequest->CancelRequest();
+                return bytesRemaining;
+              });
+
+          if (!cancellationHandle) {
+            // The group was cancelled before this request could be sent.
+            CESIUM_TRACE_END_IN_TRACK("requestAsset");
+            CesiumRequestCancellation::recordRequestNotSent();
+            promise.reject(std::runtime_error("Request cancelled."));
+            return;
+          }
+        }
+
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise, CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
+            [asyncSystem,
+             promise,
+             requestGroup,
+             cancellationHandle,
+             pBody,
+             CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) mutable {
               CESIUM_TRACE_USE_CAPTURED_TRACK();
               CESIUM_TRACE_END_IN_TRACK("requestAsset");
 
+              if (requestGroup && cancellationHandle) {
+                CesiumRequestCancellation::unregisterRequest(
+                    *requestGroup,
+                    *cancellationHandle);
+              }
+
               if (connectedSuccessfully) {
-                promise.resolve(
-                    std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
+                resolveInWorkerThread(
+                    asyncSystem,
+                    promise,
+                    pRequest,
+                    pResponse,
+                    pBody);
               } else {
                 switch (pRequest->GetStatus()) {
                 case EHttpRequestStatus::Failed_ConnectionError:
@@ -222,7 +421,8 @@ UnrealAssetAccessor::request(
       this->_cesiumRequestHeaders;
 
   return asyncSystem.createFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
-      [&verb,
+      [&asyncSystem,
+       &verb,
        &url,
        &headers,
        &userAgent,
@@ -251,13 +451,16 @@ UnrealAssetAccessor::request(
             contentPayload.size()));
 
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise](
+            [asyncSystem, promise](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) {
               if (connectedSuccessfully) {
-                promise.resolve(
-                    std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
+                resolveInWorkerThread(
+                    asyncSystem,
+                    promise,
+                    pRequest,
+                    pResponse);
               } else {
                 switch (pRequest->GetStatus()) {
                 case EHttpRequestStatus::Failed_ConnectionError:
@@ -286,7 +489,26 @@ public:
       std::string&& url,
       uint16_t statusCode,
       TArray64<uint8>&& data)
-      : _url(std::move(url)), _statusCode(statusCode), _data(data) {}
+      : _url(std::move(url)),
+        _statusCode(statusCode),
+        _data(MoveTemp(data)),
+        _pMappedFile(),
+        _pMappedRegion() {}
+
+  /**
+   * Creates a successful response whose data is a memory-mapped region of a
+   * file, rather than a copy of its contents. The region must cover the
+   * entire file.
+   */
+  UnrealFileAssetRequestResponse(
+      std::string&& url,
+      TUniquePtr<IMappedFileHandle>&& pMappedFile,
+      TUniquePtr<IMappedFileRegion>&& pMappedRegion)
+      : _url(std::move(url)),
+        _statusCode(200),
+        _data(),
+        _pMappedFile(MoveTemp(pMappedFile)),
+        _pMappedRegion(MoveTemp(pMappedRegion)) {}
 
   virtual const std::string& method() const { return getMethod; }
 
@@ -305,6 +527,13 @@ public:
   virtual std::string contentType() const override { return std::string(); }
 
   virtual gsl::span<const std::byte> data() const override {
+    if (this->_pMappedRegion) {
+      return gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(
+              this->_pMappedRegion->GetMappedPtr()),
+          size_t(this->_pMappedRegion->GetMappedSize()));
+    }
+
     return gsl::span<const std::byte>(
         reinterpret_cast<const std::byte*>(this->_data.GetData()),
         size_t(this->_data.Num()));
@@ -317,6 +546,11 @@ private:
   std::string _url;
   uint16_t _statusCode;
   TArray64<uint8> _data;
+
+  // The region must be destroyed before the file handle it was mapped from,
+  // so it's declared after it.
+  TUniquePtr<IMappedFileHandle> _pMappedFile;
+  TUniquePtr<IMappedFileRegion> _pMappedRegion;
 };
 
 const std::string UnrealFileAssetRequestResponse::getMethod = "GET";
@@ -355,8 +589,10 @@ class FCesiumReadFileWorker : public FNonAbandonableTask {
 public:
   FCesiumReadFileWorker(
       const std::string& url,
-      const CesiumAsync::AsyncSystem& asyncSystem)
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      bool useMemoryMapping)
       : _url(url),
+        _useMemoryMapping(useMemoryMapping),
         _promise(
             asyncSystem
                 .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>()) {
@@ -375,6 +611,11 @@ public:
   void DoWork() {
     FString filename =
         UTF8_TO_TCHAR(convertFileUriToFilename(this->_url).c_str());
+
+    if (this->_useMemoryMapping && this->TryMapFile(filename)) {
+      return;
+    }
+
     TArray64<uint8> data;
     if (FFileHelper::LoadFileToArray(data, *filename)) {
       this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
@@ -390,7 +631,36 @@ public:
   }
 
 private:
+  /**
+   * Attempts to resolve the promise with a memory-mapped view of the entire
+   * file. Returns false, without resolving the promise, if the file can't be
+   * mapped. Empty files can't be mapped, and neither can files on platforms
+   * without memory-mapping support.
+   */
+  bool TryMapFile(const FString& filename) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MapFile)
+
+    TUniquePtr<IMappedFileHandle> pMappedFile(
+        FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*filename));
+    if (!pMappedFile || pMappedFile->GetFileSize() <= 0) {
+      return false;
+    }
+
+    TUniquePtr<IMappedFileRegion> pMappedRegion(
+        pMappedFile->MapRegion(0, pMappedFile->GetFileSize()));
+    if (!pMappedRegion) {
+      return false;
+    }
+
+    this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
+        std::move(this->_url),
+        MoveTemp(pMappedFile),
+        MoveTemp(pMappedRegion)));
+    return true;
+  }
+
   std::string _url;
+  bool _useMemoryMapping;
   CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> _promise;
 };
 
@@ -403,8 +673,10 @@ UnrealAssetAccessor::getFromFile(
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
   check(!url.empty());
 
-  auto pTaskOwner =
-      std::make_unique<FAsyncTask<FCesiumReadFileWorker>>(url, asyncSystem);
+  auto pTaskOwner = std::make_unique<FAsyncTask<FCesiumReadFileWorker>>(
+      url,
+      asyncSystem,
+      GetDefault<UCesiumRuntimeSettings>()->UseMemoryMappedFileReads);
 
   FAsyncTask<FCesiumReadFileWorker>* pTask = pTaskOwner.get();
 
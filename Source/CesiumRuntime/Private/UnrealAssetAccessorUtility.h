@@ -0,0 +1,18 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <string>
+
+namespace UnrealAssetAccessorUtility {
+
+/**
+ * @brief Determines whether a URL is a file:/// URL, which is read from the
+ * local file system rather than requested over HTTP.
+ */
+inline bool isFileUrl(const std::string& url) {
+  constexpr char fileProtocol[] = "file:///";
+  return url.compare(0, sizeof(fileProtocol) - 1, fileProtocol) == 0;
+}
+
+} // namespace UnrealAssetAccessorUtility
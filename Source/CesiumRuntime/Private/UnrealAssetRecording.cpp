@@ -0,0 +1,442 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "UnrealAssetRecording.h"
+#include "CesiumArchiveUtility.h"
+#include "CesiumAsync/HttpHeaders.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// "CREC", followed by the version of the record format.
+constexpr uint32 recordMagic = 0x43524543;
+constexpr int32 recordVersion = 1;
+
+FString getRecordFilename(
+    const FString& archiveDirectory,
+    const std::string& verb,
+    const std::string& url) {
+  const std::string key = verb + " " + url;
+  const uint64 hash = CityHash64(key.data(), uint32(key.size()));
+  return FPaths::Combine(
+      archiveDirectory,
+      FString::Printf(TEXT("%016llx.bin"), hash));
+}
+
+void serializeBytes(FArchive& archive, void* pData, int64 size) {
+  archive << size;
+  archive.Serialize(pData, size);
+}
+
+void writeString(FArchive& archive, const std::string& value) {
+  serializeBytes(
+      archive,
+      const_cast<char*>(value.data()),
+      int64(value.size()));
+}
+
+void writeHeaders(FArchive& archive, const CesiumAsync::HttpHeaders& headers) {
+  int32 count = int32(headers.size());
+  archive << count;
+  for (const auto& header : headers) {
+    writeString(archive, header.first);
+    writeString(archive, header.second);
+  }
+}
+
+bool readHeaders(FArchive& archive, CesiumAsync::HttpHeaders& headers) {
+  int32 count = 0;
+  archive << count;
+  for (int32 i = 0; i < count && !archive.IsError(); ++i) {
+    std::string key;
+    std::string value;
+    if (!CesiumArchiveUtility::readBuffer(archive, key) ||
+        !CesiumArchiveUtility::readBuffer(archive, value)) {
+      return false;
+    }
+    headers.emplace(std::move(key), std::move(value));
+  }
+  return !archive.IsError();
+}
+
+class ReplayedAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  ReplayedAssetResponse(
+      uint16_t statusCode,
+      std::string&& contentType,
+      CesiumAsync::HttpHeaders&& headers,
+      std::vector<std::byte>&& data)
+      : _statusCode(statusCode),
+        _contentType(std::move(contentType)),
+        _headers(std::move(headers)),
+        _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data);
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+/**
+ * A request served from an archive, along with the time its response took to
+ * arrive when it was recorded.
+ */
+class ReplayedAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  ReplayedAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      CesiumAsync::HttpHeaders&& headers,
+      std::unique_ptr<ReplayedAssetResponse>&& pResponse,
+      double recordedLatency)
+      : _method(method),
+        _url(url),
+        _headers(std::move(headers)),
+        _pResponse(std::move(pResponse)),
+        _recordedLatency(recordedLatency) {}
+
+  virtual const std::string& method() const { return this->_method; }
+
+  virtual const std::string& url() const { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return this->_pResponse.get();
+  }
+
+  /**
+   * Gets the time, in seconds, that the response took to arrive when it was
+   * recorded.
+   */
+  double getRecordedLatency() const { return this->_recordedLatency; }
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  std::unique_ptr<ReplayedAssetResponse> _pResponse;
+  double _recordedLatency;
+};
+
+void writeRecord(
+    const FString& filename,
+    const CesiumAsync::IAssetRequest& request,
+    double latency) {
+  const CesiumAsync::IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    return;
+  }
+
+  TArray<uint8> bytes;
+  FMemoryWriter writer(bytes);
+
+  uint32 magic = recordMagic;
+  int32 version = recordVersion;
+  writer << magic;
+  writer << version;
+  writer << latency;
+
+  int32 statusCode = pResponse->statusCode();
+  writer << statusCode;
+  writeString(writer, pResponse->contentType());
+  writeHeaders(writer, pResponse->headers());
+
+  gsl::span<const std::byte> data = pResponse->data();
+  serializeBytes(
+      writer,
+      const_cast<std::byte*>(data.data()),
+      int64(data.size()));
+
+  if (!FFileHelper::SaveArrayToFile(bytes, *filename)) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Could not record the response to %s to %s"),
+        UTF8_TO_TCHAR(request.url().c_str()),
+        *filename);
+  }
+}
+
+std::shared_ptr<ReplayedAssetRequest> readRecord(
+    const FString& filename,
+    const std::string& verb,
+    const std::string& url,
+    CesiumAsync::HttpHeaders&& requestHeaders) {
+  TArray<uint8> bytes;
+  bool valid = FFileHelper::LoadFileToArray(bytes, *filename, FILEREAD_Silent);
+
+  FMemoryReader reader(bytes);
+  uint32 magic = 0;
+  int32 version = 0;
+  double latency = 0.0;
+  int32 statusCode = 0;
+  std::string contentType;
+  CesiumAsync::HttpHeaders responseHeaders;
+  std::vector<std::byte> data;
+
+  if (valid) {
+    reader << magic;
+    reader << version;
+    valid = !reader.IsError() && magic == recordMagic &&
+            version == recordVersion;
+  }
+
+  if (valid) {
+    reader << latency;
+    reader << statusCode;
+    valid = !reader.IsError() &&
+            CesiumArchiveUtility::readBuffer(reader, contentType) &&
+            readHeaders(reader, responseHeaders) &&
+            CesiumArchiveUtility::readBuffer(reader, data);
+  }
+
+  if (!valid) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("No recorded response for %s %s"),
+        UTF8_TO_TCHAR(verb.c_str()),
+        UTF8_TO_TCHAR(url.c_str()));
+    return std::make_shared<ReplayedAssetRequest>(
+        verb,
+        url,
+        std::move(requestHeaders),
+        std::make_unique<ReplayedAssetResponse>(
+            uint16_t(404),
+            std::string(),
+            CesiumAsync::HttpHeaders(),
+            std::vector<std::byte>()),
+        0.0);
+  }
+
+  return std::make_shared<ReplayedAssetRequest>(
+      verb,
+      url,
+      std::move(requestHeaders),
+      std::make_unique<ReplayedAssetResponse>(
+          uint16_t(statusCode),
+          std::move(contentType),
+          std::move(responseHeaders),
+          std::move(data)),
+      latency);
+}
+
+} // namespace
+
+UnrealRecordingAssetAccessor::UnrealRecordingAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const FString& archiveDirectory)
+    : _pAssetAccessor(pAssetAccessor), _archiveDirectory(archiveDirectory) {
+  IFileManager::Get().MakeDirectory(*this->_archiveDirectory, true);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+UnrealRecordingAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  return this->record(
+      "GET",
+      url,
+      this->_pAssetAccessor->get(asyncSystem, url, headers));
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+UnrealRecordingAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->record(
+      verb,
+      url,
+      this->_pAssetAccessor
+          ->request(asyncSystem, verb, url, headers, contentPayload));
+}
+
+void UnrealRecordingAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+UnrealRecordingAssetAccessor::record(
+    const std::string& verb,
+    const std::string& url,
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+        future) {
+  const double startTime = FPlatformTime::Seconds();
+  return std::move(future)
+      .thenImmediately(
+          [startTime](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            return std::make_pair(
+                std::move(pRequest),
+                FPlatformTime::Seconds() - startTime);
+          })
+      .thenInWorkerThread(
+          [filename = getRecordFilename(this->_archiveDirectory, verb, url)](
+              std::pair<std::shared_ptr<CesiumAsync::IAssetRequest>, double>&&
+                  result) {
+            // The request isn't complete until it's recorded, so that a run
+            // that finishes loading has a complete archive.
+            writeRecord(filename, *result.first, result.second);
+            return std::move(result.first);
+          });
+}
+
+/**
+ * Delays replayed responses according to a network profile. Responses that
+ * are delayed are held until a `tick` after they are due.
+ */
+class UnrealReplayAssetAccessor::Link {
+public:
+  Link(const UnrealReplayNetworkProfile& profile)
+      : _profile(profile), _mutex(), _pending(), _idleTime(0.0) {}
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> deliver(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      std::shared_ptr<ReplayedAssetRequest>&& pRequest) {
+    double latency = this->_profile.latencyMilliseconds / 1000.0;
+    if (this->_profile.useRecordedLatency) {
+      latency += pRequest->getRecordedLatency();
+    }
+
+    const double bytesPerSecond = this->_profile.bytesPerSecond;
+    if (latency <= 0.0 && bytesPerSecond <= 0.0) {
+      return asyncSystem.createResolvedFuture<
+          std::shared_ptr<CesiumAsync::IAssetRequest>>(std::move(pRequest));
+    }
+
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise =
+        asyncSystem
+            .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> future =
+        promise.getFuture();
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    double dueTime = FPlatformTime::Seconds() + latency;
+    if (bytesPerSecond > 0.0) {
+      // The link carries one response at a time, so a response that arrives
+      // while it's busy waits for the ones ahead of it.
+      dueTime = std::max(dueTime, this->_idleTime) +
+                double(pRequest->response()->data().size()) / bytesPerSecond;
+      this->_idleTime = dueTime;
+    }
+
+    this->_pending.push_back({dueTime, promise, std::move(pRequest)});
+    return future;
+  }
+
+  void tick() {
+    std::vector<PendingResponse> due;
+
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      const double now = FPlatformTime::Seconds();
+      auto it = std::partition(
+          this->_pending.begin(),
+          this->_pending.end(),
+          [now](const PendingResponse& pending) {
+            return pending.dueTime > now;
+          });
+      due.insert(
+          due.end(),
+          std::make_move_iterator(it),
+          std::make_move_iterator(this->_pending.end()));
+      this->_pending.erase(it, this->_pending.end());
+    }
+
+    for (PendingResponse& pending : due) {
+      pending.promise.resolve(std::move(pending.pRequest));
+    }
+  }
+
+private:
+  struct PendingResponse {
+    double dueTime;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+  };
+
+  UnrealReplayNetworkProfile _profile;
+  std::mutex _mutex;
+  std::vector<PendingResponse> _pending;
+
+  // The time at which the last response on the link finishes arriving.
+  double _idleTime;
+};
+
+UnrealReplayAssetAccessor::UnrealReplayAssetAccessor(
+    const FString& archiveDirectory,
+    const UnrealReplayNetworkProfile& profile)
+    : _archiveDirectory(archiveDirectory),
+      _pLink(std::make_shared<Link>(profile)) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+UnrealReplayAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  return this->request(asyncSystem, "GET", url, headers, {});
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+UnrealReplayAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return asyncSystem
+      .runInWorkerThread(
+          [filename = getRecordFilename(this->_archiveDirectory, verb, url),
+           verb,
+           url,
+           requestHeaders =
+               CesiumAsync::HttpHeaders(headers.begin(), headers.end())]() {
+            return readRecord(
+                filename,
+                verb,
+                url,
+                CesiumAsync::HttpHeaders(requestHeaders));
+          })
+      .thenImmediately(
+          [asyncSystem, pLink = this->_pLink](
+              std::shared_ptr<ReplayedAssetRequest>&& pRequest) {
+            return pLink->deliver(asyncSystem, std::move(pRequest));
+          });
+}
+
+void UnrealReplayAssetAccessor::tick() noexcept { this->_pLink->tick(); }
@@ -0,0 +1,122 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "Containers/UnrealString.h"
+#include <memory>
+
+/**
+ * An asset accessor that saves every request it makes, along with its
+ * response and how long the response took to arrive, to an archive directory.
+ * The archive can then be served by UnrealReplayAssetAccessor, so that load
+ * tests and profiling sessions see exactly the same data on every run and on
+ * every machine, without any network noise.
+ *
+ * Each request is saved to its own file, named by a hash of its verb and URL.
+ * A URL that is requested more than once is saved with its latest response.
+ */
+class UnrealRecordingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @param pAssetAccessor The accessor that performs the requests.
+   * @param archiveDirectory The directory to save the requests to. It is
+   * created if it does not exist.
+   */
+  UnrealRecordingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const FString& archiveDirectory);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> record(
+      const std::string& verb,
+      const std::string& url,
+      CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+          future);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  FString _archiveDirectory;
+};
+
+/**
+ * The simulated network conditions under which UnrealReplayAssetAccessor
+ * serves recorded responses.
+ */
+struct UnrealReplayNetworkProfile {
+  /**
+   * Whether to wait as long for each response as it took when it was
+   * recorded.
+   */
+  bool useRecordedLatency = false;
+
+  /**
+   * A latency to add to every response, in milliseconds.
+   */
+  double latencyMilliseconds = 0.0;
+
+  /**
+   * The bandwidth shared by all responses, in bytes per second, or 0 for
+   * unlimited bandwidth. Responses are delivered one after another at this
+   * rate once their latency has elapsed.
+   */
+  double bytesPerSecond = 0.0;
+};
+
+/**
+ * An asset accessor that serves the requests saved by
+ * UnrealRecordingAssetAccessor instead of making them. A request that is not
+ * in the archive gets a 404 response.
+ *
+ * Responses that are delayed by the network profile are delivered from
+ * `tick`, so they arrive at the start of a frame, as they would with the HTTP
+ * module.
+ */
+class UnrealReplayAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @param archiveDirectory The directory the requests were recorded to.
+   * @param profile The network conditions to simulate.
+   */
+  UnrealReplayAssetAccessor(
+      const FString& archiveDirectory,
+      const UnrealReplayNetworkProfile& profile = {});
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  class Link;
+
+  FString _archiveDirectory;
+  std::shared_ptr<Link> _pLink;
+};
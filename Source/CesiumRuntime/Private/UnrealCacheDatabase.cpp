@@ -0,0 +1,438 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "UnrealCacheDatabase.h"
+#include "Async/Async.h"
+#include "CesiumRuntime.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include <mutex>
+#include <unordered_map>
+
+DECLARE_CYCLE_STAT(TEXT("Cache Read"), STAT_CesiumCacheRead, STATGROUP_Cesium);
+DECLARE_CYCLE_STAT(
+    TEXT("Cache Write"),
+    STAT_CesiumCacheWrite,
+    STATGROUP_Cesium);
+DECLARE_CYCLE_STAT(
+    TEXT("Cache Prune"),
+    STAT_CesiumCachePrune,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Cache Queued Writes"),
+    STAT_CesiumCacheQueuedWrites,
+    STATGROUP_Cesium);
+
+namespace {
+std::atomic<int64_t> hits{0};
+std::atomic<int64_t> misses{0};
+std::atomic<int64_t> writes{0};
+std::atomic<int64_t> bytesWritten{0};
+std::atomic<int64_t> prunes{0};
+std::atomic<int64_t> readMicroseconds{0};
+std::atomic<int64_t> maximumReadMicroseconds{0};
+std::atomic<int64_t> writeMicroseconds{0};
+std::atomic<int64_t> maximumWriteMicroseconds{0};
+std::atomic<int64_t> pruneMicroseconds{0};
+std::atomic<int64_t> maximumPruneMicroseconds{0};
+
+// The longest time, in milliseconds, that a queued write waits to be written.
+constexpr uint32 WriteBatchIntervalMilliseconds = 100;
+
+// The number of queued writes at which they're written without waiting for
+// the rest of the interval.
+constexpr size_t WriteBatchSize = 64;
+
+void recordLatency(
+    std::atomic<int64_t>& total,
+    std::atomic<int64_t>& maximum,
+    double startSeconds) {
+  const int64_t microseconds =
+      int64_t((FPlatformTime::Seconds() - startSeconds) * 1000000.0);
+  total += microseconds;
+  int64_t previous = maximum;
+  while (previous < microseconds &&
+         !maximum.compare_exchange_weak(previous, microseconds)) {
+  }
+}
+} // namespace
+
+struct UnrealCacheDatabase::State {
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pDatabase;
+  std::atomic<bool> isPruning{false};
+  std::atomic<int64_t> bytesSinceLastPrune{0};
+  std::atomic<int64_t> itemsWritten{0};
+  std::atomic<int64_t> bytesWritten{0};
+
+  // Held by the maintenance thread while it writes a batch, and by clearAll,
+  // so that a batch is never written after the cache it was queued for is
+  // cleared. It's always taken before queueMutex.
+  std::mutex writeMutex;
+  std::mutex queueMutex;
+  // The responses that are queued to be written by the maintenance thread.
+  std::unordered_map<std::string, CesiumAsync::CacheItem> queuedWrites;
+  // The batch of responses that the maintenance thread is writing, which
+  // reads still find until it has been written.
+  std::unordered_map<std::string, CesiumAsync::CacheItem> writingBatch;
+  bool pruneRequested = false;
+
+  bool write(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) {
+    const double start = FPlatformTime::Seconds();
+    bool stored;
+    {
+      SCOPE_CYCLE_COUNTER(STAT_CesiumCacheWrite);
+      stored = this->pDatabase->storeEntry(
+          key,
+          expiryTime,
+          url,
+          requestMethod,
+          requestHeaders,
+          statusCode,
+          responseHeaders,
+          responseData);
+    }
+    recordLatency(writeMicroseconds, maximumWriteMicroseconds, start);
+
+    if (stored) {
+      const int64_t size = int64_t(responseData.size());
+      ++writes;
+      ::bytesWritten += size;
+      ++this->itemsWritten;
+      this->bytesWritten += size;
+      this->bytesSinceLastPrune += size;
+    }
+
+    return stored;
+  }
+
+  void runPrune() {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::PruneCache)
+    const double start = FPlatformTime::Seconds();
+    bool pruned;
+    {
+      SCOPE_CYCLE_COUNTER(STAT_CesiumCachePrune);
+      pruned = this->pDatabase->prune();
+    }
+    recordLatency(pruneMicroseconds, maximumPruneMicroseconds, start);
+
+    if (!pruned) {
+      UE_LOG(LogCesium, Warning, TEXT("Failed to prune the request cache."));
+    }
+    ++prunes;
+  }
+};
+
+/**
+ * The thread that writes queued responses in batches and runs prunes, at the
+ * lowest priority.
+ */
+class UnrealCacheDatabase::MaintenanceThread : public FRunnable {
+public:
+  MaintenanceThread(const std::shared_ptr<State>& pState, int64_t bytesPerPrune)
+      : _pState(pState),
+        _bytesPerPrune(bytesPerPrune),
+        _pWakeEvent(FPlatformProcess::GetSynchEventFromPool(false)),
+        _stopping(false),
+        _running(false),
+        _pThread(nullptr) {
+    this->_pThread = FRunnableThread::Create(
+        this,
+        TEXT("CesiumCacheMaintenance"),
+        0,
+        TPri_Lowest);
+    this->_running = this->_pThread != nullptr;
+  }
+
+  virtual ~MaintenanceThread() {
+    this->stop();
+    FPlatformProcess::ReturnSynchEventToPool(this->_pWakeEvent);
+  }
+
+  bool isRunning() const { return this->_running; }
+
+  void wake() { this->_pWakeEvent->Trigger(); }
+
+  void stop() {
+    if (!this->_pThread) {
+      return;
+    }
+    this->_running = false;
+    this->_stopping = true;
+    this->_pWakeEvent->Trigger();
+    this->_pThread->WaitForCompletion();
+    delete this->_pThread;
+    this->_pThread = nullptr;
+  }
+
+  virtual uint32 Run() override {
+    while (!this->_stopping) {
+      this->_pWakeEvent->Wait(WriteBatchIntervalMilliseconds);
+      this->runMaintenance();
+    }
+
+    // Write whatever was queued before stopping.
+    this->runMaintenance();
+    return 0;
+  }
+
+private:
+  void runMaintenance() {
+    State& state = *this->_pState;
+    std::unique_lock<std::mutex> writeLock(state.writeMutex);
+
+    bool prune;
+    {
+      std::lock_guard<std::mutex> lock(state.queueMutex);
+      state.writingBatch.swap(state.queuedWrites);
+      prune = state.pruneRequested;
+      state.pruneRequested = false;
+    }
+
+    // The batch is only changed while the lock is held, so reads can find its
+    // responses while they're being written.
+    for (const auto& [key, item] : state.writingBatch) {
+      state.write(
+          key,
+          item.expiryTime,
+          item.cacheRequest.url,
+          item.cacheRequest.method,
+          item.cacheRequest.headers,
+          item.cacheResponse.statusCode,
+          item.cacheResponse.headers,
+          gsl::span<const std::byte>(item.cacheResponse.data));
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(state.queueMutex);
+      DEC_DWORD_STAT_BY(
+          STAT_CesiumCacheQueuedWrites,
+          state.writingBatch.size());
+      state.writingBatch.clear();
+    }
+    writeLock.unlock();
+
+    if (this->_bytesPerPrune > 0 &&
+        state.bytesSinceLastPrune >= this->_bytesPerPrune) {
+      prune = true;
+    }
+    if (prune) {
+      state.bytesSinceLastPrune = 0;
+      state.runPrune();
+    }
+  }
+
+  std::shared_ptr<State> _pState;
+  int64_t _bytesPerPrune;
+  FEvent* _pWakeEvent;
+  std::atomic<bool> _stopping;
+  std::atomic<bool> _running;
+  FRunnableThread* _pThread;
+};
+
+UnrealCacheDatabase::UnrealCacheDatabase(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+    int64_t bytesPerPrune,
+    bool useMaintenanceThread)
+    : _pState(std::make_shared<State>()),
+      _bytesPerPrune(bytesPerPrune),
+      _pMaintenanceThread(nullptr) {
+  this->_pState->pDatabase = pDatabase;
+
+  if (useMaintenanceThread && FPlatformProcess::SupportsMultithreading()) {
+    this->_pMaintenanceThread =
+        std::make_unique<MaintenanceThread>(this->_pState, bytesPerPrune);
+  }
+}
+
+UnrealCacheDatabase::~UnrealCacheDatabase() noexcept { this->shutdown(); }
+
+std::optional<CesiumAsync::CacheItem>
+UnrealCacheDatabase::getEntry(const std::string& key) const {
+  if (this->_pMaintenanceThread) {
+    std::lock_guard<std::mutex> lock(this->_pState->queueMutex);
+    auto queuedIt = this->_pState->queuedWrites.find(key);
+    if (queuedIt != this->_pState->queuedWrites.end()) {
+      ++hits;
+      return queuedIt->second;
+    }
+    auto writingIt = this->_pState->writingBatch.find(key);
+    if (writingIt != this->_pState->writingBatch.end()) {
+      ++hits;
+      return writingIt->second;
+    }
+  }
+
+  const double start = FPlatformTime::Seconds();
+  std::optional<CesiumAsync::CacheItem> result;
+  {
+    SCOPE_CYCLE_COUNTER(STAT_CesiumCacheRead);
+    result = this->_pState->pDatabase->getEntry(key);
+  }
+  recordLatency(readMicroseconds, maximumReadMicroseconds, start);
+
+  if (result) {
+    ++hits;
+  } else {
+    ++misses;
+  }
+  return result;
+}
+
+bool UnrealCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  if (this->_pMaintenanceThread && this->_pMaintenanceThread->isRunning()) {
+    CesiumAsync::CacheItem item;
+    item.expiryTime = expiryTime;
+    item.cacheRequest.url = url;
+    item.cacheRequest.method = requestMethod;
+    item.cacheRequest.headers = requestHeaders;
+    item.cacheResponse.statusCode = statusCode;
+    item.cacheResponse.headers = responseHeaders;
+    item.cacheResponse.data.assign(responseData.begin(), responseData.end());
+
+    size_t queuedCount;
+    {
+      std::lock_guard<std::mutex> lock(this->_pState->queueMutex);
+      const bool inserted =
+          this->_pState->queuedWrites.insert_or_assign(key, std::move(item))
+              .second;
+      if (inserted) {
+        INC_DWORD_STAT(STAT_CesiumCacheQueuedWrites);
+      }
+      queuedCount = this->_pState->queuedWrites.size();
+    }
+
+    if (queuedCount >= WriteBatchSize) {
+      this->_pMaintenanceThread->wake();
+    }
+    return true;
+  }
+
+  const bool stored = this->_pState->write(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+
+  if (stored && this->_bytesPerPrune > 0 &&
+      this->_pState->bytesSinceLastPrune >= this->_bytesPerPrune) {
+    this->prune();
+  }
+
+  return stored;
+}
+
+bool UnrealCacheDatabase::prune() {
+  if (this->_bytesPerPrune > 0 &&
+      this->_pState->bytesSinceLastPrune < this->_bytesPerPrune) {
+    return true;
+  }
+
+  if (this->_pMaintenanceThread && this->_pMaintenanceThread->isRunning()) {
+    {
+      std::lock_guard<std::mutex> lock(this->_pState->queueMutex);
+      this->_pState->pruneRequested = true;
+    }
+    this->_pMaintenanceThread->wake();
+    return true;
+  }
+
+  // Only one prune runs at a time. Asking for another while one is running
+  // does nothing, because the running prune will catch up.
+  bool expected = false;
+  if (!this->_pState->isPruning.compare_exchange_strong(expected, true)) {
+    return true;
+  }
+
+  this->_pState->bytesSinceLastPrune = 0;
+
+  Async(EAsyncExecution::ThreadPool, [pState = this->_pState]() {
+    pState->runPrune();
+    pState->isPruning = false;
+  });
+
+  return true;
+}
+
+bool UnrealCacheDatabase::clearAll() {
+  // Wait for the batch that's being written, if any, and keep the next one
+  // from being written until the cache is cleared.
+  std::lock_guard<std::mutex> writeLock(this->_pState->writeMutex);
+  {
+    std::lock_guard<std::mutex> lock(this->_pState->queueMutex);
+    DEC_DWORD_STAT_BY(
+        STAT_CesiumCacheQueuedWrites,
+        this->_pState->queuedWrites.size());
+    this->_pState->queuedWrites.clear();
+  }
+  this->_pState->bytesSinceLastPrune = 0;
+  return this->_pState->pDatabase->clearAll();
+}
+
+void UnrealCacheDatabase::shutdown() {
+  if (this->_pMaintenanceThread) {
+    this->_pMaintenanceThread->stop();
+  }
+}
+
+int32_t UnrealCacheDatabase::getQueuedWriteCount() const {
+  std::lock_guard<std::mutex> lock(this->_pState->queueMutex);
+  return int32_t(
+      this->_pState->queuedWrites.size() + this->_pState->writingBatch.size());
+}
+
+int64_t UnrealCacheDatabase::getAverageItemBytes() const {
+  const int64_t items = this->_pState->itemsWritten;
+  return items > 0 ? this->_pState->bytesWritten / items : 0;
+}
+
+/*static*/ UnrealCacheDatabase::Statistics
+UnrealCacheDatabase::getStatistics() {
+  return Statistics{
+      hits,
+      misses,
+      writes,
+      bytesWritten,
+      prunes,
+      readMicroseconds,
+      maximumReadMicroseconds,
+      writeMicroseconds,
+      maximumWriteMicroseconds,
+      pruneMicroseconds,
+      maximumPruneMicroseconds};
+}
+
+/*static*/ void UnrealCacheDatabase::resetStatistics() {
+  hits = 0;
+  misses = 0;
+  writes = 0;
+  bytesWritten = 0;
+  prunes = 0;
+  readMicroseconds = 0;
+  maximumReadMicroseconds = 0;
+  writeMicroseconds = 0;
+  maximumWriteMicroseconds = 0;
+  pruneMicroseconds = 0;
+  maximumPruneMicroseconds = 0;
+}
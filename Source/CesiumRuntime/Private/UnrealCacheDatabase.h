@@ -0,0 +1,112 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/ICacheDatabase.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * A cache database that counts cache hits, misses, and writes, times its
+ * reads, writes, and prunes, and that runs pruning as a background task
+ * instead of inline with requests.
+ *
+ * When a byte threshold is given, a prune requested by the caching asset
+ * accessor is only honored once at least that many bytes have been written
+ * since the last prune, so that pruning tracks the amount of data being
+ * cached rather than the number of requests being made.
+ *
+ * When a maintenance thread is used, writes are also taken off of the request
+ * path: each one is queued, and the queue is written in batches by a thread
+ * of the lowest priority, which also runs the prunes, so that neither holds
+ * up the reads of requests in flight. Reads find the responses that are
+ * queued to be written, and a response that is written again before its
+ * batch is written replaces the queued one.
+ */
+class UnrealCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * Counters for the requests handled by every UnrealCacheDatabase.
+   */
+  struct Statistics {
+    int64_t hits;
+    int64_t misses;
+    int64_t writes;
+    int64_t bytesWritten;
+    int64_t prunes;
+    int64_t readMicroseconds;
+    int64_t maximumReadMicroseconds;
+    int64_t writeMicroseconds;
+    int64_t maximumWriteMicroseconds;
+    int64_t pruneMicroseconds;
+    int64_t maximumPruneMicroseconds;
+  };
+
+  /**
+   * @param pDatabase The database that stores the cached items.
+   * @param bytesPerPrune The number of bytes that must be written between
+   * prunes, or 0 to prune whenever asked.
+   * @param useMaintenanceThread Whether to write and prune on a maintenance
+   * thread.
+   */
+  UnrealCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+      int64_t bytesPerPrune,
+      bool useMaintenanceThread = false);
+
+  virtual ~UnrealCacheDatabase() noexcept;
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * Writes every queued response, and stops the maintenance thread, if there
+   * is one. Responses that are written afterward are written right away.
+   */
+  void shutdown();
+
+  /**
+   * Gets the number of responses that are queued to be written by the
+   * maintenance thread.
+   */
+  int32_t getQueuedWriteCount() const;
+
+  /**
+   * Gets the average size, in bytes, of the responses written to the cache so
+   * far, or 0 if nothing has been written.
+   */
+  int64_t getAverageItemBytes() const;
+
+  /**
+   * Gets the counters for all of the cache databases.
+   */
+  static Statistics getStatistics();
+
+  /**
+   * Resets the counters for all of the cache databases to zero.
+   */
+  static void resetStatistics();
+
+private:
+  struct State;
+  class MaintenanceThread;
+
+  std::shared_ptr<State> _pState;
+  int64_t _bytesPerPrune;
+  std::unique_ptr<MaintenanceThread> _pMaintenanceThread;
+};
@@ -0,0 +1,191 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "UnrealPooledAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumRuntime.h"
+#include "UnrealAssetAccessorUtility.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <uriparser/Uri.h>
+
+namespace {
+
+/**
+ * Gets the "host:port" part of a URL, which identifies the connections that
+ * a request can share. Returns an empty string if the URL can't be parsed,
+ * so that all such requests share a single pool.
+ */
+std::string getHostKey(const std::string& url) {
+  UriUriA uri;
+  if (uriParseSingleUriA(&uri, url.c_str(), nullptr) != URI_SUCCESS) {
+    return std::string();
+  }
+
+  std::string result;
+  if (uri.hostText.first && uri.hostText.afterLast) {
+    result.assign(uri.hostText.first, uri.hostText.afterLast);
+  }
+  if (uri.portText.first && uri.portText.afterLast) {
+    result += ':';
+    result.append(uri.portText.first, uri.portText.afterLast);
+  }
+
+  uriFreeUriMembersA(&uri);
+  return result;
+}
+
+} // namespace
+
+class UnrealPooledAssetAccessor::Pool
+    : public std::enable_shared_from_this<UnrealPooledAssetAccessor::Pool> {
+public:
+  Pool(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      int32_t maximumConnectionsPerHost)
+      : _pAssetAccessor(pAssetAccessor),
+        _maximumConnectionsPerHost(std::max(maximumConnectionsPerHost, 1)),
+        _mutex(),
+        _hosts(),
+        _queuedRequestCount(0) {}
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> enqueue(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+    PendingRequest request{
+        asyncSystem,
+        getHostKey(url),
+        url,
+        headers,
+        asyncSystem
+            .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>()};
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> future =
+        request.promise.getFuture();
+
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      Host& host = this->_hosts[request.hostKey];
+      if (host.activeRequests >= this->_maximumConnectionsPerHost) {
+        host.queue.emplace_back(std::move(request));
+        ++this->_queuedRequestCount;
+        return future;
+      }
+      ++host.activeRequests;
+    }
+
+    this->start(std::move(request));
+    return future;
+  }
+
+  size_t getQueuedRequestCount() const {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    return this->_queuedRequestCount;
+  }
+
+private:
+  struct PendingRequest {
+    CesiumAsync::AsyncSystem asyncSystem;
+    std::string hostKey;
+    std::string url;
+    std::vector<CesiumAsync::IAssetAccessor::THeader> headers;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+
+  struct Host {
+    int32_t activeRequests = 0;
+    std::deque<PendingRequest> queue;
+  };
+
+  void start(PendingRequest&& request) {
+    std::shared_ptr<Pool> pThis = this->shared_from_this();
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise =
+        request.promise;
+
+    this->_pAssetAccessor
+        ->get(request.asyncSystem, request.url, request.headers)
+        .thenImmediately(
+            [promise](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+              promise.resolve(std::move(pRequest));
+            })
+        .catchImmediately([promise](std::exception&& e) {
+          promise.reject(std::move(e));
+        })
+        .thenImmediately([pThis, hostKey = std::move(request.hostKey)]() {
+          pThis->finish(hostKey);
+        });
+  }
+
+  void finish(const std::string& hostKey) {
+    std::optional<PendingRequest> next;
+
+    {
+      std::lock_guard<std::mutex> lock(this->_mutex);
+      auto it = this->_hosts.find(hostKey);
+      if (it == this->_hosts.end()) {
+        return;
+      }
+
+      Host& host = it->second;
+      if (host.queue.empty()) {
+        if (--host.activeRequests <= 0) {
+          this->_hosts.erase(it);
+        }
+        return;
+      }
+
+      // Hand this request's slot straight to the next one in the queue.
+      next.emplace(std::move(host.queue.front()));
+      host.queue.pop_front();
+      --this->_queuedRequestCount;
+    }
+
+    this->start(std::move(*next));
+  }
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  int32_t _maximumConnectionsPerHost;
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, Host> _hosts;
+  size_t _queuedRequestCount;
+};
+
+UnrealPooledAssetAccessor::UnrealPooledAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    int32_t maximumConnectionsPerHost)
+    : _pAssetAccessor(pAssetAccessor),
+      _pPool(
+          std::make_shared<Pool>(pAssetAccessor, maximumConnectionsPerHost)) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+UnrealPooledAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (UnrealAssetAccessorUtility::isFileUrl(url)) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  return this->_pPool->enqueue(asyncSystem, url, headers);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+UnrealPooledAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void UnrealPooledAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+size_t UnrealPooledAssetAccessor::getQueuedRequestCount() const {
+  return this->_pPool->getQueuedRequestCount();
+}
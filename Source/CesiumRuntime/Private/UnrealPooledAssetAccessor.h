@@ -0,0 +1,58 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include <cstdint>
+#include <memory>
+
+/**
+ * An asset accessor that limits the number of requests in flight to each
+ * host, queueing the rest in the order they were made. Bounding the requests
+ * per host lets the HTTP module keep a small pool of persistent (and, where
+ * the server supports it, multiplexed) connections busy, rather than opening
+ * and tearing down a connection for every burst of tile requests.
+ *
+ * Requests for file:/// URLs, and requests other than GET, are passed
+ * straight through to the underlying accessor.
+ */
+class UnrealPooledAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * @param pAssetAccessor The accessor that performs the requests.
+   * @param maximumConnectionsPerHost The maximum number of requests to each
+   * host that may be in flight at once. Must be at least 1.
+   */
+  UnrealPooledAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      int32_t maximumConnectionsPerHost);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Gets the number of requests that are waiting for a connection to their
+   * host to become available.
+   */
+  size_t getQueuedRequestCount() const;
+
+private:
+  class Pool;
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<Pool> _pPool;
+};
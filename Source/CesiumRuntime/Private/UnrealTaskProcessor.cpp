@@ -1,12 +1,202 @@
 // Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "UnrealTaskProcessor.h"
-#include "Async/Async.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
 #include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+#include <vector>
 
-void UnrealTaskProcessor::startTask(std::function<void()> f) {
-  AsyncTask(ENamedThreads::Type::AnyBackgroundThreadNormalTask, [f]() {
+namespace {
+
+thread_local bool isSpeculative = false;
+
+// The fraction of the worker threads that tasks may run on at once, set by
+// UnrealTaskProcessor::setWorkerThreadScale.
+std::atomic<double> workerThreadScale = 1.0;
+
+EThreadPriority getThreadPriority(ECesiumWorkerThreadPriority priority) {
+  switch (priority) {
+  case ECesiumWorkerThreadPriority::Lowest:
+    return TPri_Lowest;
+  case ECesiumWorkerThreadPriority::Normal:
+    return TPri_Normal;
+  case ECesiumWorkerThreadPriority::BelowNormal:
+  default:
+    return TPri_BelowNormal;
+  }
+}
+
+class CesiumQueuedWork : public IQueuedWork {
+public:
+  CesiumQueuedWork(
+      std::function<void()>&& f,
+      uint64 affinityMask,
+      bool speculative)
+      : _f(std::move(f)),
+        _affinityMask(affinityMask),
+        _speculative(speculative) {}
+
+  virtual void DoThreadedWork() override {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AsyncTask)
-    f();
-  });
+
+    // The pool doesn't set the affinity of its threads, so each one sets its
+    // own before running its first task.
+    thread_local uint64 appliedAffinityMask = 0;
+    if (this->_affinityMask != 0 &&
+        appliedAffinityMask != this->_affinityMask) {
+      FPlatformProcess::SetThreadAffinityMask(this->_affinityMask);
+      appliedAffinityMask = this->_affinityMask;
+    }
+
+    // Tasks that continue a speculative task are speculative too.
+    isSpeculative = this->_speculative;
+    this->_f();
+    isSpeculative = false;
+    delete this;
+  }
+
+  virtual void Abandon() override { delete this; }
+
+private:
+  std::function<void()> _f;
+  uint64 _affinityMask;
+  bool _speculative;
+};
+
+} // namespace
+
+UnrealTaskProcessor::UnrealTaskProcessor()
+    : _pThreadPool(nullptr),
+      _affinityMask(0),
+      _threadCount(FMath::Max(FPlatformMisc::NumberOfWorkerThreadsToSpawn(), 1)),
+      _pendingTasksLock(),
+      _pendingTasks(),
+      _activeTasks(0) {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (!pSettings || !pSettings->UseDedicatedWorkerThreads ||
+      !FPlatformProcess::SupportsMultithreading()) {
+    return;
+  }
+
+  int32 threadCount = pSettings->WorkerThreadCount;
+  if (threadCount <= 0) {
+    threadCount = FMath::Max(
+        FPlatformMisc::NumberOfCoresIncludingHyperthreads() / 2,
+        1);
+  }
+
+  this->_pThreadPool = FQueuedThreadPool::Allocate();
+  if (!this->_pThreadPool->Create(
+          uint32(threadCount),
+          128 * 1024,
+          getThreadPriority(pSettings->WorkerThreadPriority),
+          TEXT("CesiumWorkerThreadPool"))) {
+    delete this->_pThreadPool;
+    this->_pThreadPool = nullptr;
+    return;
+  }
+
+  this->_affinityMask = uint64(pSettings->WorkerThreadAffinityMask);
+  this->_threadCount = threadCount;
+}
+
+UnrealTaskProcessor::~UnrealTaskProcessor() {
+  if (this->_pThreadPool) {
+    this->_pThreadPool->Destroy();
+    delete this->_pThreadPool;
+  }
+}
+
+void UnrealTaskProcessor::startTask(std::function<void()> f) {
+  const bool speculative = isSpeculative;
+  const int32 maximumActiveTasks = this->getMaximumActiveTasks();
+  {
+    FScopeLock lock(&this->_pendingTasksLock);
+    if (maximumActiveTasks > 0 && this->_activeTasks >= maximumActiveTasks) {
+      this->_pendingTasks.push_back({std::move(f), speculative});
+      return;
+    }
+    ++this->_activeTasks;
+  }
+
+  this->launch(std::move(f), speculative);
+}
+
+/*static*/ void UnrealTaskProcessor::setWorkerThreadScale(double scale) {
+  workerThreadScale = FMath::Clamp(scale, 0.0, 1.0);
+}
+
+int32 UnrealTaskProcessor::getMaximumActiveTasks() const {
+  const double scale = workerThreadScale.load(std::memory_order_relaxed);
+  if (scale >= 1.0) {
+    return 0;
+  }
+  return FMath::Max(FMath::FloorToInt32(this->_threadCount * scale), 1);
+}
+
+void UnrealTaskProcessor::launch(std::function<void()>&& f, bool speculative) {
+  if (this->_pThreadPool) {
+    this->_pThreadPool->AddQueuedWork(
+        new CesiumQueuedWork(
+            [this, f = std::move(f)]() {
+              f();
+              this->finishTask();
+            },
+            this->_affinityMask,
+            speculative),
+        speculative ? EQueuedWorkPriority::Lowest
+                    : EQueuedWorkPriority::Normal);
+    return;
+  }
+
+  // Launch directly on the low-level task scheduler, which has less
+  // overhead per task than the task graph that AsyncTask goes through. The
+  // function is moved into the task rather than copied, so starting a task
+  // allocates only the task itself.
+  UE::Tasks::Launch(
+      TEXT("Cesium::AsyncTask"),
+      [this, f = std::move(f), speculative]() {
+        TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AsyncTask)
+        isSpeculative = speculative;
+        f();
+        isSpeculative = false;
+        this->finishTask();
+      },
+      speculative ? UE::Tasks::ETaskPriority::BackgroundLow
+                  : UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void UnrealTaskProcessor::finishTask() {
+  // The finished task's slot passes to the first waiting task, and more
+  // waiting tasks start if the limit has been raised since they were queued.
+  std::vector<PendingTask> tasksToStart;
+  {
+    FScopeLock lock(&this->_pendingTasksLock);
+    --this->_activeTasks;
+    const int32 maximumActiveTasks = this->getMaximumActiveTasks();
+    while (!this->_pendingTasks.empty() &&
+           (maximumActiveTasks <= 0 ||
+            this->_activeTasks < maximumActiveTasks)) {
+      tasksToStart.push_back(std::move(this->_pendingTasks.front()));
+      this->_pendingTasks.pop_front();
+      ++this->_activeTasks;
+    }
+  }
+
+  for (PendingTask& task : tasksToStart) {
+    this->launch(std::move(task.f), task.speculative);
+  }
+}
+
+UnrealTaskProcessor::SpeculativeScope::SpeculativeScope()
+    : _wasSpeculative(isSpeculative) {
+  isSpeculative = true;
+}
+
+UnrealTaskProcessor::SpeculativeScope::~SpeculativeScope() {
+  isSpeculative = this->_wasSpeculative;
 }
@@ -6,31 +6,58 @@
 #include "Cesium3DTilesSelection/ViewState.h"
 #include "Cesium3DTilesSelection/ViewUpdateResult.h"
 #include "Cesium3DTilesetLoadFailureDetails.h"
+#include "CesiumCamera.h"
 #include "CesiumCreditSystem.h"
 #include "CesiumEncodedMetadataComponent.h"
+#include "CesiumFeatureHandle.h"
+#include "CesiumFeatureStyle.h"
 #include "CesiumFeaturesMetadataComponent.h"
 #include "CesiumGeoreference.h"
+#include "CesiumInterestPoint.h"
 #include "CesiumPointCloudShading.h"
+#include "CesiumRequestPriority.h"
+#include "CesiumTilePipelineStatistics.h"
+#include "CesiumTilesetMemoryUsage.h"
+#include "CesiumUtility/CreditSystem.h"
 #include "CoreMinimal.h"
 #include "CustomDepthParameters.h"
 #include "Engine/EngineTypes.h"
 #include "GameFramework/Actor.h"
 #include "Interfaces/IHttpRequest.h"
 #include "PrimitiveSceneProxy.h"
+#include "VT/RuntimeVirtualTextureEnum.h"
 #include <PhysicsEngine/BodyInstance.h>
 #include <atomic>
 #include <chrono>
 #include <glm/mat4x4.hpp>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include "Cesium3DTileset.generated.h"
 
 class UMaterialInterface;
+class UTexture2D;
+class URuntimeVirtualTexture;
+class ACesiumCartographicPolygon;
 class ACesiumCartographicSelection;
 class ACesiumCameraManager;
+class ALevelSequenceActor;
+class APlayerController;
+class UHLODLayer;
+class CesiumHzbOcclusionPool;
+class CesiumPrimitiveComponentPool;
+class CesiumRenderDataBatch;
+class CesiumDetailGovernor;
+class CesiumHorizonCullingExcluder;
+class CesiumMetadataIndex;
+class CesiumTilePipelineHistograms;
+class CesiumWarmStartAssetAccessor;
+class UnrealResourcePreparer;
 class UCesiumBoundingVolumePoolComponent;
+class UStaticMesh;
+class UStaticMeshComponent;
+class UCesiumGltfComponent;
 class CesiumViewExtension;
-struct FCesiumCamera;
 
 namespace Cesium3DTilesSelection {
 class Tileset;
@@ -52,6 +79,52 @@ DECLARE_MULTICAST_DELEGATE_OneParam(
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FCompletedLoadTrigger);
 
+/**
+ * The delegate for ACesium3DTileset::OnTileLoaded and
+ * ACesium3DTileset::OnTileUnloaded, which is called with the bounds of the
+ * tile in Unreal world coordinates and its geometric error in meters.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+    FCesiumTileLoadTrigger,
+    const FBox&,
+    Bounds,
+    float,
+    GeometricError);
+
+/**
+ * The delegate for ACesium3DTileset::OnRegionLoaded, which is called with the
+ * ID that ACesium3DTileset::WatchRegion returned for the region.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+    FCesiumRegionLoadTrigger,
+    int32,
+    RegionID);
+
+/**
+ * The delegate for ACesium3DTileset::PickFromScreenPosition, which is called
+ * with whether the tileset was picked, and the hit on it if it was.
+ */
+DECLARE_DYNAMIC_DELEGATE_TwoParams(
+    FCesiumPickCallback,
+    bool,
+    bHit,
+    const FHitResult&,
+    Hit);
+
+/**
+ * The delegate for ACesium3DTileset::SampleHeightMostDetailed, which is called
+ * with the sampled positions, whether each was sampled, and the geometric
+ * error of the tile that each was sampled from.
+ */
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(
+    FCesiumSampleHeightMostDetailedCallback,
+    const TArray<FVector>&,
+    LongitudeLatitudeHeights,
+    const TArray<bool>&,
+    SampleSuccess,
+    const TArray<double>&,
+    GeometricErrors);
+
 CESIUMRUNTIME_API extern FCesium3DTilesetLoadFailure
     OnCesium3DTilesetLoadFailure;
 
@@ -72,6 +145,68 @@ enum class ETilesetSource : uint8 {
 UENUM(BlueprintType)
 enum class EApplyDpiScaling : uint8 { Yes, No, UseProjectDefault };
 
+/**
+ * The glTF data that a tileset keeps on the CPU for each loaded tile, once the
+ * tile's meshes, textures, and physics meshes have been created from it.
+ */
+UENUM(BlueprintType)
+enum class ECesiumGltfDataRetention : uint8 {
+  /**
+   * All of the tile's glTF buffers and images are kept for as long as the tile
+   * is loaded.
+   */
+  KeepAll,
+
+  /**
+   * Only the glTF buffers and images that feature IDs, metadata, and picking
+   * need are kept: positions, indices, texture coordinates, feature IDs,
+   * property tables, and the images of feature ID and property textures.
+   */
+  KeepMetadataAndPicking,
+
+  /**
+   * All of the tile's glTF buffers and images are released. The tile's feature
+   * IDs and metadata can't be accessed or picked, but the feature IDs and
+   * properties that are encoded for its material are still rendered.
+   */
+  ReleaseAll
+};
+
+/**
+ * The property of each tile that a tileset's debug colors show.
+ */
+UENUM(BlueprintType)
+enum class ECesiumTileDebugColorMode : uint8 {
+  /**
+   * Tiles are shown in their own colors.
+   */
+  None,
+
+  /**
+   * Each level of the tile tree, counted from the root tile, has its own
+   * color.
+   */
+  LevelOfDetail,
+
+  /**
+   * Tiles are shaded from green to red by the time from the request for their
+   * content until they were ready to render, from 0 to 2 seconds.
+   */
+  LoadTime,
+
+  /**
+   * Tiles are shaded from green to red by the CPU and GPU memory held by their
+   * meshes, textures, and materials, from 0 to 8 MiB.
+   */
+  Memory,
+
+  /**
+   * Tiles are shaded from green to red by their screen-space error in the
+   * current views, from 0 to the tileset's Maximum Screen Space Error.
+   */
+  ScreenSpaceError
+};
+
 UCLASS()
 class CESIUMRUNTIME_API ACesium3DTileset : public AActor {
   GENERATED_BODY()
@@ -212,6 +347,23 @@ private:
       Meta = (AllowPrivateAccess))
   TSoftObjectPtr<ACesiumCameraManager> CameraManager;
 
+  /**
+   * Whether to select tiles only for the cameras of the Camera Manager, so
+   * that every node of a render cluster, such as an nDisplay LED wall, selects
+   * exactly the same tiles.
+   *
+   * Each node of a cluster normally selects tiles for its own view, so
+   * neighboring nodes may show different levels of detail where their views
+   * meet. With this enabled, the player, scene capture and editor cameras are
+   * ignored, and each node should add the views of every node in the cluster
+   * to the Camera Manager. Tiles are then selected for all of those views at
+   * once, and the things that depend on the local node, which are occlusion
+   * culling, the detail governor and eye tracking, are turned off so that the
+   * selection doesn't either.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool UseClusterSelection = false;
+
   /**
    * The resolved Camera Manager used by this Tileset. This is not serialized
    * because it may point to a Camera Manager in the PersistentLevel while this
@@ -238,6 +390,17 @@ private:
       Meta = (AllowPrivateAccess))
   UCesiumBoundingVolumePoolComponent* BoundingVolumePoolComponent = nullptr;
 
+  /**
+   * The component that draws the ImpostorMesh while this tileset is an
+   * impostor. It's created the first time it's needed.
+   */
+  UPROPERTY(
+      Transient,
+      BlueprintReadOnly,
+      Category = "Cesium",
+      Meta = (AllowPrivateAccess))
+  UStaticMeshComponent* ImpostorComponent = nullptr;
+
   /**
    * The custom view extension this tileset uses to pull renderer view
    * information.
@@ -245,6 +408,12 @@ private:
   TSharedPtr<CesiumViewExtension, ESPMode::ThreadSafe> _cesiumViewExtension =
       nullptr;
 
+  /**
+   * The occlusion proxies for this tileset's tiles, when they're tested
+   * against the HZB instead of with bounding volume components.
+   */
+  std::shared_ptr<CesiumHzbOcclusionPool> _pHzbOcclusionPool = nullptr;
+
 public:
   /** @copydoc ACesium3DTileset::CreditSystem */
   UFUNCTION(BlueprintCallable, Category = "Cesium")
@@ -326,6 +495,68 @@ public:
       meta = (ClampMin = 0.0))
   double MaximumScreenSpaceError = 16.0;
 
+  /**
+   * Whether to adjust the level of detail automatically to keep the frame
+   * time under GovernorTargetFrameTime and this tileset's memory under
+   * GovernorMemoryLimit.
+   *
+   * While either is exceeded, the Maximum Screen Space Error is raised step
+   * by step, up to GovernorMaximumScreenSpaceErrorScale times its value, and
+   * fewer tiles are loaded at once. It is lowered back once both are well
+   * under their targets. Each change is logged.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail")
+  bool EnableDetailGovernor = false;
+
+  /**
+   * The frame time, in milliseconds, that the detail governor tries to stay
+   * under. The frame time is the longest of the game thread, render thread,
+   * and GPU times, so it doesn't include time spent waiting for vertical
+   * sync.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta =
+          (EditCondition = "EnableDetailGovernor",
+           ClampMin = 1.0,
+           Units = "ms"))
+  float GovernorTargetFrameTime = 16.6f;
+
+  /**
+   * The number of bytes of tile data and Unreal resources for this tileset
+   * that the detail governor tries to stay under, or 0 for no limit. See
+   * GetMemoryUsage for what is counted.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta = (EditCondition = "EnableDetailGovernor", ClampMin = 0))
+  int64 GovernorMemoryLimit = 0;
+
+  /**
+   * The most that the detail governor may multiply the Maximum Screen Space
+   * Error by.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta = (EditCondition = "EnableDetailGovernor", ClampMin = 1.0))
+  float GovernorMaximumScreenSpaceErrorScale = 4.0f;
+
+  /**
+   * Gets the factor that the detail governor currently multiplies the
+   * Maximum Screen Space Error by. This is 1.0 when the governor is disabled.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Level of Detail")
+  double GetGovernorScreenSpaceErrorScale() const;
+
   /**
    * Scale Level-of-Detail by Display DPI. This increases the performance for
    * mobile devices and high DPI screens.
@@ -336,6 +567,58 @@ public:
       Category = "Cesium|Level of Detail")
   EApplyDpiScaling ApplyDpiScaling = EApplyDpiScaling::UseProjectDefault;
 
+  /**
+   * Whether to stop selecting tiles while every camera is farther than
+   * ImpostorDistance from this tileset's root bounding volume, and draw an
+   * impostor of the tileset instead. This suits scenes with many small
+   * tilesets spread across a region, such as individual buildings, where
+   * each distant tileset would otherwise keep traversing its tiles every
+   * frame.
+   *
+   * The impostor is the ImpostorMesh, if there is one, in which case the
+   * tiles are hidden but stay cached. Otherwise, the tiles that were shown
+   * when the cameras moved out of range, usually only the coarsest ones, are
+   * kept as they are. Tiles are selected again once a camera comes within 90%
+   * of ImpostorDistance.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail")
+  bool EnableImpostor = false;
+
+  /**
+   * The distance, in meters, beyond which this tileset is drawn as an
+   * impostor when EnableImpostor is set.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta = (EditCondition = "EnableImpostor", ClampMin = 0.0, Units = "m"))
+  double ImpostorDistance = 5000.0;
+
+  /**
+   * A low-detail mesh drawn in place of the tiles while this tileset is an
+   * impostor, such as a simplified mesh baked with BakeRegionToStaticMeshes.
+   * It's drawn with the transform of this actor and without collision. If
+   * this is not set, the last tiles that were shown are drawn instead.
+   * Changes take effect the next time the tileset becomes an impostor.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta = (EditCondition = "EnableImpostor"))
+  UStaticMesh* ImpostorMesh = nullptr;
+
+  /**
+   * Whether this tileset is currently drawn as an impostor, without
+   * selecting tiles. See EnableImpostor.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Level of Detail")
+  bool IsImpostor() const { return this->_impostorActive; }
+
   /**
    * Whether to preload ancestor tiles.
    *
@@ -396,6 +679,40 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
   int64 MaximumCachedBytes = 256 * 1024 * 1024;
 
+  /**
+   * Whether the meshes, physics meshes, textures, and materials that Unreal
+   * Engine creates for loaded tiles count toward MaximumCachedBytes, in
+   * addition to the tile data itself.
+   *
+   * When this is false, only the tile data held by Cesium Native is counted,
+   * so the memory actually used by the tileset may be well above
+   * MaximumCachedBytes. See GetMemoryUsage for what is counted.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool IncludeUnrealResourcesInCachedBytes = true;
+
+  /**
+   * The glTF data to keep on the CPU for each loaded tile, once its meshes,
+   * textures, and physics meshes have been created from it.
+   *
+   * By default, a tile's vertices, indices, and images stay in memory for as
+   * long as the tile is loaded, in addition to the copies on the GPU. Releasing
+   * them lowers the memory used by each tile, so more tiles fit within
+   * MaximumCachedBytes.
+   *
+   * All of the data is kept for tiles that raster overlays are draped on,
+   * since their children may be subdivided from their glTF for the overlays.
+   * The positions and indices are kept when physics meshes are cooked on
+   * demand. Changing this reloads the tileset.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetGltfDataRetention,
+      BlueprintSetter = SetGltfDataRetention,
+      Category = "Cesium|Tile Loading")
+  ECesiumGltfDataRetention GltfDataRetention =
+      ECesiumGltfDataRetention::KeepAll;
+
   /**
    * The number of loading descendents a tile should allow before deciding to
    * render itself instead of waiting.
@@ -415,374 +732,1607 @@ public:
   int32 LoadingDescendantLimit = 20;
 
   /**
-   * Whether to cull tiles that are outside the frustum.
+   * Whether to warm-start loading this tileset from the requests it made the
+   * last time it was loaded.
    *
-   * By default this is true, meaning that tiles that are not visible with the
-   * current camera configuration will be ignored. It can be set to false, so
-   * that these tiles are still considered for loading, refinement and
-   * rendering.
+   * Tiles are normally discovered level by level, starting from the root, so
+   * reaching full detail takes a round trip to the server for each level.
+   * When this is enabled, the URLs that the tileset requests until it first
+   * reaches full detail are saved in the project's Saved/Cesium/WarmStart
+   * directory. The next time the tileset is loaded, they're all requested at
+   * once, as soon as the tileset makes its first request to their server, so
+   * that the tiles for a view that is the same as the last time, like the
+   * starting view of a kiosk app, have already arrived when they're needed.
    *
-   * This will cause more tiles to be loaded, but helps to avoid holes and
-   * provides a more consistent mesh, which may be helpful for physics.
+   * Tilesets whose URLs change between sessions, such as ones with session
+   * keys in their URLs, won't benefit from this.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool EnableWarmStart = false;
+
+  /**
+   * Whether to request tiles a second time when they take longer than usual
+   * to arrive.
    *
-   * Note that this will always be disabled if UseLodTransitions is set to true.
+   * A request that hasn't completed within HedgedRequestPercentile of the
+   * latencies of this tileset's recent requests is made again, to the next of
+   * the HedgedRequestHosts if there are any, and whichever response arrives
+   * first is used while the other request is cancelled. This keeps a few
+   * unusually slow requests, which the tileset would otherwise wait for
+   * before refining further, from stalling loading, at the cost of a few
+   * percent more requests. Requests aren't hedged until enough of them have
+   * completed to know how long they usually take. Takes effect when the
+   * tileset is next loaded.
    */
   UPROPERTY(
       EditAnywhere,
       BlueprintReadWrite,
-      Category = "Cesium|Tile Culling",
-      Meta = (EditCondition = "!UseLodTransitions", EditConditionHides))
-  bool EnableFrustumCulling = true;
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay)
+  bool EnableHedgedRequests = false;
 
   /**
-   * Whether to cull tiles that are occluded by fog.
-   *
-   * This does not refer to the atmospheric fog of the Unreal Engine,
-   * but to an internal representation of fog: Depending on the height
-   * of the camera above the ground, tiles that are far away (close to
-   * the horizon) will be culled when this flag is enabled.
-   *
-   * Note that this will always be disabled if UseLodTransitions is set to true.
+   * The percentile of the latencies of recent requests after which a request
+   * is hedged, when EnableHedgedRequests is true. Lower values hedge more
+   * requests sooner.
    */
   UPROPERTY(
       EditAnywhere,
       BlueprintReadWrite,
-      Category = "Cesium|Tile Culling",
-      Meta = (EditCondition = "!UseLodTransitions", EditConditionHides))
-  bool EnableFogCulling = true;
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay,
+      meta =
+          (ClampMin = 50.0,
+           ClampMax = 99.9,
+           EditCondition = "EnableHedgedRequests"))
+  float HedgedRequestPercentile = 95.0f;
 
   /**
-   * Whether a specified screen-space error should be enforced for tiles that
-   * are outside the frustum or hidden in fog.
-   *
-   * When "Enable Frustum Culling" and "Enable Fog Culling" are both true, tiles
-   * outside the view frustum or hidden in fog are effectively ignored, and so
-   * their level-of-detail doesn't matter. And in this scenario, this property
-   * is ignored.
-   *
-   * However, when either of those flags are false, these "would-be-culled"
-   * tiles continue to be processed, and the question arises of how to handle
-   * their level-of-detail. When this property is false, refinement terminates
-   * at these tiles, no matter what their current screen-space error. The tiles
-   * are available for physics, shadows, etc., but their level-of-detail may
-   * be very low.
-   *
-   * When set to true, these tiles are refined until they achieve the specified
-   * "Culled Screen Space Error". This allows control over the minimum quality
-   * of these would-be-culled tiles.
+   * The shortest time, in seconds, after which a request is hedged, when
+   * EnableHedgedRequests is true.
    */
-  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Culling")
-  bool EnforceCulledScreenSpaceError = false;
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay,
+      meta =
+          (ClampMin = 0.0, Units = "s", EditCondition = "EnableHedgedRequests"))
+  float MinimumHedgedRequestDelay = 0.25f;
 
   /**
-   * The screen-space error to be enforced for tiles that are outside the view
-   * frustum or hidden in fog.
-   *
-   * When "Enable Frustum Culling" and "Enable Fog Culling" are both true, tiles
-   * outside the view frustum or hidden in fog are effectively ignored, and so
-   * their level-of-detail doesn't matter. And in this scenario, this property
-   * is ignored.
-   *
-   * However, when either of those flags are false, these "would-be-culled"
-   * tiles continue to be processed, and the question arises of how to handle
-   * their level-of-detail. When "Enforce Culled Screen Space Error" is false,
-   * this property is ignored and refinement terminates at these tiles, no
-   * matter what their current screen-space error. The tiles are available for
-   * physics, shadows, etc., but their level-of-detail may be very low.
-   *
-   * When set to true, these tiles are refined until they achieve the
-   * screen-space error specified by this property.
+   * The mirrors that hedged requests are made to instead of the host of the
+   * original request, in turn, given by their scheme and host, such as
+   * "https://mirror.example.com". When this is empty, hedged requests are
+   * made to the original URL.
    */
   UPROPERTY(
       EditAnywhere,
       BlueprintReadWrite,
-      Category = "Cesium|Tile Culling",
-      meta = (EditCondition = "EnforceCulledScreenSpaceError", ClampMin = 0.0))
-  double CulledScreenSpaceError = 64.0;
-
-  // This mirrors
-  // UCesiumRuntimeSettings::EnableExperimentalOcclusionCullingFeature so that
-  // it can be used as an EditCondition.
-  UPROPERTY(Transient, VisibleDefaultsOnly, Category = "Cesium|Tile Occlusion")
-  bool CanEnableOcclusionCulling = false;
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay,
+      meta = (EditCondition = "EnableHedgedRequests"))
+  TArray<FString> HedgedRequestHosts;
 
   /**
-   * Whether to cull tiles that are occluded.
-   *
-   * If this option is disabled, check that "Enable Experimental Occlusion
-   * Culling Feature" is enabled in the Plugins -> Cesium section of the Project
-   * Settings.
-   *
-   * When enabled, this feature will use Unreal's occlusion system to determine
-   * if tiles are actually visible on the screen. For tiles found to be
-   * occluded, the tile will not refine to show descendants, but it will still
-   * be rendered to avoid holes. This results in less tile loads and less GPU
-   * resource usage for dense, high-occlusion scenes like ground-level views in
-   * cities.
-   *
-   * This will not work for tilesets with poorly fit bounding volumes and cause
-   * more draw calls with very few extra culled tiles. When there is minimal
-   * occlusion in a scene, such as with terrain tilesets and applications
-   * focused on top-down views, this feature will yield minimal benefit and
-   * potentially cause needless overhead.
+   * The time, in seconds, after which a request of this tileset is cancelled
+   * and, if it has retries left, retried. Set this to 0 for requests to never
+   * time out. Takes effect when the tileset is next loaded.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetEnableOcclusionCulling,
-      BlueprintSetter = SetEnableOcclusionCulling,
-      Category = "Cesium|Tile Occlusion",
-      meta = (EditCondition = "CanEnableOcclusionCulling"))
-  bool EnableOcclusionCulling = true;
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay,
+      meta = (ClampMin = 0.0, Units = "s"))
+  float RequestTimeout = 0.0f;
 
   /**
-   * The number of CesiumBoundingVolumeComponents to use for querying the
-   * occlusion state of traversed tiles.
-   *
-   * Only applicable when EnableOcclusionCulling is enabled.
+   * The number of times that a request of this tileset is retried after it
+   * fails, times out, or receives a response that indicates a temporary
+   * server error, such as 503 Service Unavailable. Takes effect when the
+   * tileset is next loaded.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetOcclusionPoolSize,
-      BlueprintSetter = SetOcclusionPoolSize,
-      Category = "Cesium|Tile Occlusion",
-      meta =
-          (EditCondition =
-               "EnableOcclusionCulling && CanEnableOcclusionCulling",
-           ClampMin = "0",
-           ClampMax = "1000"))
-  int32 OcclusionPoolSize = 500;
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay,
+      meta = (ClampMin = 0))
+  int32 MaximumRequestRetries = 0;
+
+  /**
+   * The time, in seconds, before a failed request is first retried. Each
+   * retry after that waits twice as long as the last.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay,
+      meta =
+          (ClampMin = 0.0,
+           Units = "s",
+           EditCondition = "MaximumRequestRetries > 0"))
+  float RequestRetryDelay = 0.5f;
+
+  /**
+   * The priority class of this tileset's requests, which decides whether
+   * they're sent before or after those of other tilesets and raster overlays
+   * when "Maximum Bandwidth" in the Cesium project settings limits how fast
+   * tiles may be downloaded. Takes effect when the tileset is next loaded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay)
+  ECesiumRequestPriority RequestPriority = ECesiumRequestPriority::Normal;
+
+  /**
+   * This tileset's share of the bandwidth of its Request Priority, relative
+   * to the shares of the other tilesets and raster overlays with the same
+   * priority. A tileset with a share of 2 is given twice the bandwidth of one
+   * with a share of 1 while both are waiting for tiles. Takes effect when the
+   * tileset is next loaded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay,
+      meta = (ClampMin = 0.01))
+  float BandwidthShare = 1.0f;
+
+  /**
+   * Whether to skip updating this tileset while its views are static.
+   *
+   * When this is true and nothing that affects tile selection has changed
+   * since the last frame (the cameras, the tileset's transform and
+   * georeference, and its level-of-detail and culling settings) and every
+   * selected tile is loaded, the previous frame's tile selection is reused
+   * instead of traversing the tileset again. Tilesets with active Tile
+   * Excluders are always updated. Call InvalidateView to force an update
+   * after making any other change that should affect tile selection.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      AdvancedDisplay)
+  bool SkipUpdatesWhileViewIsStatic = true;
+
+  /**
+   * Forces this tileset's tile selection to be updated in the next frame, even
+   * if its views are static or another tileset would otherwise take its turn.
+   * See SkipUpdatesWhileViewIsStatic and the Maximum Tileset Updates Per Frame
+   * project setting.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void InvalidateView();
+
+  /**
+   * Whether to load tiles ahead of moving cameras.
+   *
+   * When this is true, the velocity of each camera is extrapolated
+   * PrefetchTime seconds ahead, and the tiles needed to view the tileset from
+   * the predicted position are loaded along with those needed for the current
+   * view. This helps fast fly-throughs avoid outrunning tile loading, at the
+   * cost of loading tiles that may never be seen.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool PrefetchAlongCameraPath = false;
+
+  /**
+   * How far ahead, in seconds, to predict the position of moving cameras when
+   * PrefetchAlongCameraPath is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta =
+          (EditCondition = "PrefetchAlongCameraPath",
+           ClampMin = 0.0,
+           Units = "s"))
+  float PrefetchTime = 2.0f;
+
+  /**
+   * The level of detail to load for predicted camera positions, relative to
+   * the level of detail of the current view, when PrefetchAlongCameraPath is
+   * enabled. Smaller values load fewer, coarser tiles ahead of the camera,
+   * which are then refined once the camera arrives.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta =
+          (EditCondition = "PrefetchAlongCameraPath",
+           ClampMin = 0.01,
+           ClampMax = 1.0))
+  float PrefetchDetailFactor = 0.5f;
+
+  /**
+   * Whether to load less detail away from where the viewer is looking.
+   *
+   * When this is true, tiles are refined to the full level of detail only
+   * within FovealAngle of the gaze direction, and to PeripheralDetailFactor
+   * of it elsewhere in the view. The gaze direction comes from the eye tracker
+   * when UseEyeTracking is enabled and one is connected, or from
+   * SetGazeDirection, and is the center of each view otherwise. This is
+   * meant for head-mounted displays, where the periphery is seen at a much
+   * lower resolution than the center.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool UseFoveatedScreenSpaceError = false;
+
+  /**
+   * The angle, in degrees, of the cone around the gaze direction in which
+   * tiles are refined to the full level of detail, when
+   * UseFoveatedScreenSpaceError is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta =
+          (EditCondition = "UseFoveatedScreenSpaceError",
+           ClampMin = 1.0,
+           ClampMax = 179.0,
+           Units = "deg"))
+  float FovealAngle = 30.0f;
+
+  /**
+   * The level of detail to load outside of FovealAngle, relative to the
+   * level of detail at the gaze direction, when UseFoveatedScreenSpaceError
+   * is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta =
+          (EditCondition = "UseFoveatedScreenSpaceError",
+           ClampMin = 0.01,
+           ClampMax = 1.0))
+  float PeripheralDetailFactor = 0.5f;
+
+  /**
+   * Whether to take the gaze direction from the eye tracker of the first
+   * player, when UseFoveatedScreenSpaceError is enabled and an eye tracker is
+   * connected. This takes precedence over SetGazeDirection.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (EditCondition = "UseFoveatedScreenSpaceError"))
+  bool UseEyeTracking = true;
+
+  /**
+   * Sets the direction that the viewer is looking in, in Unreal world
+   * coordinates, for UseFoveatedScreenSpaceError. This is for gaze sources
+   * other than the eye tracker. A zero vector clears the direction, so that
+   * the center of each view is used.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void SetGazeDirection(const FVector& Direction);
+
+  /**
+   * Adds a place to load tiles around whether or not any camera is looking at
+   * it, so that its tiles are ready before the camera gets there. Returns an
+   * ID that the interest point can be updated or removed with.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  int32 AddInterestPoint(const FCesiumInterestPoint& InterestPoint);
+
+  /**
+   * Replaces the interest point with the given ID, such as to move it. Returns
+   * false if there is no interest point with that ID.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  bool UpdateInterestPoint(
+      int32 InterestPointId,
+      const FCesiumInterestPoint& InterestPoint);
+
+  /**
+   * Removes the interest point with the given ID. Returns false if there is no
+   * interest point with that ID.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  bool RemoveInterestPoint(int32 InterestPointId);
+
+  /**
+   * Removes all of the interest points.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void ClearInterestPoints();
+
+  /**
+   * Gets the interest points by their IDs.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  const TMap<int32, FCesiumInterestPoint>& GetInterestPoints() const;
+
+  /**
+   * Whether to cull tiles that are outside the frustum.
+   *
+   * By default this is true, meaning that tiles that are not visible with the
+   * current camera configuration will be ignored. It can be set to false, so
+   * that these tiles are still considered for loading, refinement and
+   * rendering.
+   *
+   * This will cause more tiles to be loaded, but helps to avoid holes and
+   * provides a more consistent mesh, which may be helpful for physics.
+   *
+   * Note that this will always be disabled if UseLodTransitions is set to true.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Culling",
+      Meta = (EditCondition = "!UseLodTransitions", EditConditionHides))
+  bool EnableFrustumCulling = true;
+
+  /**
+   * Whether to cull tiles that are occluded by fog.
+   *
+   * This does not refer to the atmospheric fog of the Unreal Engine,
+   * but to an internal representation of fog: Depending on the height
+   * of the camera above the ground, tiles that are far away (close to
+   * the horizon) will be culled when this flag is enabled.
+   *
+   * Note that this will always be disabled if UseLodTransitions is set to true.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Culling",
+      Meta = (EditCondition = "!UseLodTransitions", EditConditionHides))
+  bool EnableFogCulling = true;
+
+  /**
+   * Whether to cull tiles that are hidden behind the globe.
+   *
+   * From high above the Earth, tiles on the far side of the globe can be
+   * inside the view frustum even though they can never be seen. With this
+   * enabled, tiles whose bounding volumes are entirely below the horizon of
+   * the WGS84 ellipsoid from every view are skipped by the tile selection, so
+   * neither they nor their descendants are loaded.
+   *
+   * This is only correct for tilesets that are placed on the globe, and has
+   * no effect while a view is below the surface of the ellipsoid.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Culling")
+  bool EnableHorizonCulling = false;
+
+  /**
+   * Whether a specified screen-space error should be enforced for tiles that
+   * are outside the frustum or hidden in fog.
+   *
+   * When "Enable Frustum Culling" and "Enable Fog Culling" are both true, tiles
+   * outside the view frustum or hidden in fog are effectively ignored, and so
+   * their level-of-detail doesn't matter. And in this scenario, this property
+   * is ignored.
+   *
+   * However, when either of those flags are false, these "would-be-culled"
+   * tiles continue to be processed, and the question arises of how to handle
+   * their level-of-detail. When this property is false, refinement terminates
+   * at these tiles, no matter what their current screen-space error. The tiles
+   * are available for physics, shadows, etc., but their level-of-detail may
+   * be very low.
+   *
+   * When set to true, these tiles are refined until they achieve the specified
+   * "Culled Screen Space Error". This allows control over the minimum quality
+   * of these would-be-culled tiles.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Culling")
+  bool EnforceCulledScreenSpaceError = false;
+
+  /**
+   * The screen-space error to be enforced for tiles that are outside the view
+   * frustum or hidden in fog.
+   *
+   * When "Enable Frustum Culling" and "Enable Fog Culling" are both true, tiles
+   * outside the view frustum or hidden in fog are effectively ignored, and so
+   * their level-of-detail doesn't matter. And in this scenario, this property
+   * is ignored.
+   *
+   * However, when either of those flags are false, these "would-be-culled"
+   * tiles continue to be processed, and the question arises of how to handle
+   * their level-of-detail. When "Enforce Culled Screen Space Error" is false,
+   * this property is ignored and refinement terminates at these tiles, no
+   * matter what their current screen-space error. The tiles are available for
+   * physics, shadows, etc., but their level-of-detail may be very low.
+   *
+   * When set to true, these tiles are refined until they achieve the
+   * screen-space error specified by this property.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Culling",
+      meta = (EditCondition = "EnforceCulledScreenSpaceError", ClampMin = 0.0))
+  double CulledScreenSpaceError = 64.0;
+
+  // This mirrors
+  // UCesiumRuntimeSettings::EnableExperimentalOcclusionCullingFeature so that
+  // it can be used as an EditCondition.
+  UPROPERTY(Transient, VisibleDefaultsOnly, Category = "Cesium|Tile Occlusion")
+  bool CanEnableOcclusionCulling = false;
+
+  /**
+   * Whether to cull tiles that are occluded.
+   *
+   * If this option is disabled, check that "Enable Experimental Occlusion
+   * Culling Feature" is enabled in the Plugins -> Cesium section of the Project
+   * Settings.
+   *
+   * When enabled, this feature will use Unreal's occlusion system to determine
+   * if tiles are actually visible on the screen. For tiles found to be
+   * occluded, the tile will not refine to show descendants, but it will still
+   * be rendered to avoid holes. This results in less tile loads and less GPU
+   * resource usage for dense, high-occlusion scenes like ground-level views in
+   * cities.
+   *
+   * This will not work for tilesets with poorly fit bounding volumes and cause
+   * more draw calls with very few extra culled tiles. When there is minimal
+   * occlusion in a scene, such as with terrain tilesets and applications
+   * focused on top-down views, this feature will yield minimal benefit and
+   * potentially cause needless overhead.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetEnableOcclusionCulling,
+      BlueprintSetter = SetEnableOcclusionCulling,
+      Category = "Cesium|Tile Occlusion",
+      meta = (EditCondition = "CanEnableOcclusionCulling"))
+  bool EnableOcclusionCulling = true;
+
+  /**
+   * The number of CesiumBoundingVolumeComponents to use for querying the
+   * occlusion state of traversed tiles.
+   *
+   * Only applicable when EnableOcclusionCulling is enabled and the occlusion
+   * culling method in the Cesium project settings is Occlusion Queries. The
+   * Hierarchical Z Buffer method doesn't need a pool of components.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetOcclusionPoolSize,
+      BlueprintSetter = SetOcclusionPoolSize,
+      Category = "Cesium|Tile Occlusion",
+      meta =
+          (EditCondition =
+               "EnableOcclusionCulling && CanEnableOcclusionCulling",
+           ClampMin = "0",
+           ClampMax = "1000"))
+  int32 OcclusionPoolSize = 500;
 
   /**
    * Whether to wait for valid occlusion results before refining tiles.
    *
-   * Only applicable when EnableOcclusionCulling is enabled. When this option
-   * is enabled, there may be small delays before tiles are refined, but there
-   * may be an overall performance advantage by avoiding loads of descendants
-   * that will be found to be occluded.
+   * Only applicable when EnableOcclusionCulling is enabled. When this option
+   * is enabled, there may be small delays before tiles are refined, but there
+   * may be an overall performance advantage by avoiding loads of descendants
+   * that will be found to be occluded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetDelayRefinementForOcclusion,
+      BlueprintSetter = SetDelayRefinementForOcclusion,
+      Category = "Cesium|Tile Occlusion",
+      meta =
+          (EditCondition =
+               "EnableOcclusionCulling && CanEnableOcclusionCulling"))
+  bool DelayRefinementForOcclusion = true;
+
+  /**
+   * Refreshes this tileset, ensuring that all materials and other settings are
+   * applied. It is not usually necessary to invoke this, but when
+   * behind-the-scenes changes are made and not reflected in the tileset, this
+   * function can help.
+   */
+  UFUNCTION(CallInEditor, BlueprintCallable, Category = "Cesium")
+  void RefreshTileset();
+
+  /**
+   * Applies the property tables of this tileset's CesiumFeaturesMetadata
+   * component to the tiles that are already loaded, by encoding them again
+   * from the metadata that each tile kept when it was loaded. This is much
+   * faster than refreshing the tileset.
+   *
+   * Feature ID sets and property textures are encoded into the vertices of
+   * each tile, so if they have changed, the tileset is refreshed instead. It's
+   * also refreshed if the tiles discard their unencoded property table data.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void UpdateFeaturesMetadata();
+
+  /**
+   * Picks this tileset at a position on a player's screen, from the depth of
+   * what's actually rendered there, rather than by tracing against collision.
+   * This works with tiles that have no physics meshes, and always picks the
+   * level of detail that is displayed.
+   *
+   * The depth is read back from the GPU, so the result is given to OnPicked a
+   * few frames later. It is a hit on the primitive and face of a tile that
+   * was rendered at the position, which may be given to the functions of
+   * UCesiumMetadataPickingBlueprintLibrary to get its features and metadata.
+   * OnPicked is told there was no hit if something else was rendered in front
+   * of the tileset, such as another actor or translucent tiles, or if the
+   * player's view isn't rendered soon after the pick is requested.
+   *
+   * @param PlayerController The player whose view is picked.
+   * @param ScreenPosition The position to pick in viewport pixels, such as
+   * the mouse position of the player controller.
+   * @param OnPicked The callback to call with the result.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata|Picking")
+  void PickFromScreenPosition(
+      APlayerController* PlayerController,
+      const FVector2D& ScreenPosition,
+      const FCesiumPickCallback& OnPicked);
+
+  /**
+   * The region loaded by "Prewarm Cache". Every tile needed to view this
+   * region from the Prewarm View Height or higher, at the Prewarm Maximum
+   * Screen Space Error, is loaded into the request cache.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Cache Prewarming")
+  TSoftObjectPtr<ACesiumCartographicPolygon> PrewarmRegion;
+
+  /**
+   * The lowest height, in meters above the WGS84 ellipsoid, from which the
+   * Prewarm Region will be viewed. Lower heights load more detailed tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Cache Prewarming",
+      meta = (ClampMin = 1.0))
+  double PrewarmViewHeight = 500.0;
+
+  /**
+   * The maximum screen space error used to select the tiles that are loaded
+   * by "Prewarm Cache". Lower values load more detailed tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Cache Prewarming",
+      meta = (ClampMin = 0.0))
+  double PrewarmMaximumScreenSpaceError = 16.0;
+
+  /**
+   * Loads every tile needed to view the Prewarm Region into the request cache,
+   * so that the region can later be viewed with little or no network access.
+   * This blocks until all of the tiles are loaded, which may take a long time
+   * for a large region.
+   *
+   * The tiles are written to the same disk cache that is used for all
+   * requests, so the cache must be large enough to hold them. See "Max Cache
+   * Size In Gigabytes" and "Max Cache Items" in the Cesium project settings.
+   */
+  UFUNCTION(
+      CallInEditor,
+      BlueprintCallable,
+      Category = "Cesium|Cache Prewarming")
+  void PrewarmCache();
+
+  /**
+   * Loads every tile needed to view the given region from the given height or
+   * higher into the request cache. This blocks until all of the tiles are
+   * loaded.
+   *
+   * @param Region The region to load.
+   * @param ViewHeight The lowest height, in meters above the WGS84 ellipsoid,
+   * from which the region will be viewed.
+   * @param PrewarmScreenSpaceError The maximum screen space error used to
+   * select tiles.
+   * @return The number of views from which tiles were selected, or 0 if the
+   * region could not be loaded.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Cache Prewarming")
+  int32 PrewarmCacheForRegion(
+      ACesiumCartographicPolygon* Region,
+      double ViewHeight,
+      double PrewarmScreenSpaceError);
+
+  /**
+   * The region baked by "Bake Tileset Region". Every tile needed to view this
+   * region from the Bake View Height or higher, at the Bake Maximum Screen
+   * Space Error, is baked into a static mesh asset.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Baking")
+  TSoftObjectPtr<ACesiumCartographicPolygon> BakeRegion;
+
+  /**
+   * The lowest height, in meters above the WGS84 ellipsoid, from which the
+   * Bake Region will be viewed. Lower heights bake more detailed tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Baking",
+      meta = (ClampMin = 1.0))
+  double BakeViewHeight = 500.0;
+
+  /**
+   * The maximum screen space error used to select the tiles that are baked by
+   * "Bake Tileset Region". Lower values bake more detailed tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Baking",
+      meta = (ClampMin = 0.0))
+  double BakeMaximumScreenSpaceError = 16.0;
+
+  /**
+   * The content path that "Bake Tileset Region" creates static mesh assets in.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Baking")
+  FString BakeOutputPath = TEXT("/Game/Cesium/Baked");
+
+  /**
+   * The HLOD layer of the actors created by "Bake Tileset Region", or none to
+   * use the world's default HLOD layer.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Baking")
+  TObjectPtr<UHLODLayer> BakeHLODLayer;
+
+  /**
+   * Whether the static meshes created by "Bake Tileset Region" use Nanite.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Baking")
+  bool BakeNaniteMeshes = true;
+
+  /**
+   * Bakes the tiles needed to view the Bake Region into static mesh assets,
+   * with a spatially loaded static mesh actor for each, so that the region
+   * can be streamed by World Partition and its HLODs without loading the
+   * tileset. This blocks until all of the tiles are loaded and baked, and
+   * only works in the editor. The tileset is reloaded before and after.
+   *
+   * The triangles and first texture coordinates of each tile are baked, with
+   * the material assets that the tile's materials are made from. Textures and
+   * raster overlays aren't baked. The new assets and actors aren't saved
+   * until the level is.
+   */
+  UFUNCTION(CallInEditor, BlueprintCallable, Category = "Cesium|Baking")
+  void BakeTilesetRegion();
+
+  /**
+   * Bakes the tiles needed to view the given region from the given height or
+   * higher into static mesh assets. This blocks until all of the tiles are
+   * loaded and baked, and only works in the editor.
+   *
+   * @param Region The region to bake.
+   * @param ViewHeight The lowest height, in meters above the WGS84 ellipsoid,
+   * from which the region will be viewed.
+   * @param BakeScreenSpaceError The maximum screen space error used to select
+   * tiles.
+   * @param OutputPath The content path to create the assets in.
+   * @param HLODLayer The HLOD layer of the created actors, or none.
+   * @param BuildNanite Whether the static meshes use Nanite.
+   * @return The number of static mesh actors that were created.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Baking")
+  int32 BakeRegionToStaticMeshes(
+      ACesiumCartographicPolygon* Region,
+      double ViewHeight,
+      double BakeScreenSpaceError,
+      const FString& OutputPath,
+      UHLODLayer* HLODLayer,
+      bool BuildNanite);
+
+  /**
+   * Pauses level-of-detail and culling updates of this tileset.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Debug")
+  bool SuspendUpdate;
+
+  /**
+   * Keeps rendering the tiles that are shown now, without selecting or
+   * loading any tiles, until UnfreezeSelection is called. This is for
+   * screenshots, benchmarks, and frames where there's no CPU time to spare
+   * for the tileset, such as VR reprojection frames.
+   *
+   * Unlike SuspendUpdate, the tiles that are fading in or out finish doing so
+   * at once, and the tileset's share of the tile loads is left to the other
+   * tilesets. Loads that are already in flight finish in the background and
+   * are used once the selection is unfrozen.
+   *
+   * If TrimCachedTiles is true, first the tileset is updated once more from
+   * the same views, without starting any loads, to unload every cached tile
+   * that isn't shown. Refreshing the tileset unfreezes it.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void FreezeSelection(bool TrimCachedTiles = false);
+
+  /**
+   * Resumes selecting and loading tiles after FreezeSelection. The next update
+   * selects tiles for the current views again.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void UnfreezeSelection();
+
+  /**
+   * Whether FreezeSelection was called without a later UnfreezeSelection.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Tile Loading")
+  bool IsSelectionFrozen() const {
+    return this->_selectionFrozen || this->_freezePending;
+  }
+
+  /**
+   * If true, this tileset is ticked/updated in the editor. If false, is only
+   * ticked while playing (including Play-in-Editor).
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
+  bool UpdateInEditor = true;
+
+  /**
+   * If true, stats about tile selection are printed to the Output Log.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
+  bool LogSelectionStats = false;
+
+  /**
+   * Tints each rendered tile with a color that shows one of its properties,
+   * to see where the level of detail, loading time, or memory of the tileset
+   * goes.
+   *
+   * Unlike a UCesiumDebugColorizeTilesRasterOverlay, this only replaces the
+   * baseColorFactor parameter of each primitive's existing material instance,
+   * so no textures are created and tiles load just as they otherwise would.
+   * This makes it suitable for diagnosing performance in packaged builds.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Debug")
+  ECesiumTileDebugColorMode DebugColorMode = ECesiumTileDebugColorMode::None;
+
+  /**
+   * Define the collision profile for all the 3D tiles created inside this
+   * actor.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadOnly,
+      Category = "Collision",
+      meta = (ShowOnlyInnerProperties, SkipUCSModifiedProperties))
+  FBodyInstance BodyInstance;
+
+  /**
+   * A delegate that will be called whenever the tileset is fully loaded.
+   */
+  UPROPERTY(BlueprintAssignable, Category = "Cesium");
+  FCompletedLoadTrigger OnTilesetLoaded;
+
+  /**
+   * A delegate that is called for each tile whose content is loaded, after
+   * the tileset is updated in the frame that the tile was loaded in. The tile
+   * may not be shown yet.
+   */
+  UPROPERTY(BlueprintAssignable, Category = "Cesium");
+  FCesiumTileLoadTrigger OnTileLoaded;
+
+  /**
+   * A delegate that is called for each tile whose content is unloaded, after
+   * the tileset is updated in the frame that the tile was unloaded in.
+   */
+  UPROPERTY(BlueprintAssignable, Category = "Cesium");
+  FCesiumTileLoadTrigger OnTileUnloaded;
+
+  /**
+   * A delegate that is called once for each region added with WatchRegion,
+   * when the region is loaded.
+   */
+  UPROPERTY(BlueprintAssignable, Category = "Cesium");
+  FCesiumRegionLoadTrigger OnRegionLoaded;
+
+  /**
+   * Starts watching a region for when it's loaded, and returns an ID that
+   * OnRegionLoaded will be called with once it is. The region is then no
+   * longer watched.
+   *
+   * A region is loaded once tiles that intersect it are shown, and each of
+   * them either has a screen-space error no larger than
+   * MaximumScreenSpaceError for the nearest camera, can't be refined any
+   * further, or the whole tileset is loaded. If MaximumScreenSpaceError is 0,
+   * the tileset's own MaximumScreenSpaceError is used.
+   *
+   * This is checked against the tiles that each update of the tileset shows,
+   * without visiting any others, so the region must be seen by a camera or be
+   * near an interest point for its tiles to be loaded at all.
+   *
+   * @param Region The region, in Unreal world coordinates.
+   * @param MaximumScreenSpaceError The largest screen-space error of the tiles
+   * in the region, in pixels.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  int32 WatchRegion(const FBox& Region, float MaximumScreenSpaceError = 0.0f);
+
+  /**
+   * Stops watching the region with the given ID. Returns false if it isn't
+   * watched, because it's already loaded.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  bool UnwatchRegion(int32 RegionID);
+
+  /**
+   * Whether the region with the given ID is still watched, because it isn't
+   * loaded yet.
+   */
+  UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Cesium")
+  bool IsWatchingRegion(int32 RegionID) const;
+
+  /**
+   * Waits until a region is loaded, as defined by WatchRegion, before
+   * continuing.
+   *
+   * @param Region The region, in Unreal world coordinates.
+   * @param MaximumScreenSpaceError The largest screen-space error of the tiles
+   * in the region, in pixels, or 0 to use the tileset's own.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium",
+      meta = (Latent, LatentInfo = "LatentInfo"))
+  void WaitUntilRegionLoaded(
+      const FBox& Region,
+      float MaximumScreenSpaceError,
+      FLatentActionInfo LatentInfo);
+
+  /**
+   * Use a dithering effect when transitioning between tiles of different LODs.
+   *
+   * When this is set to true, Frustrum Culling and Fog Culling are always
+   * disabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseLodTransitions,
+      BlueprintSetter = SetUseLodTransitions,
+      Category = "Cesium|Rendering")
+  bool UseLodTransitions = false;
+
+  /**
+   * How long dithered LOD transitions between different tiles should take, in
+   * seconds.
+   *
+   * Only relevant if UseLodTransitions is true.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "UseLodTransitions", EditConditionHides))
+  float LodTransitionLength = 0.5f;
+
+  /**
+   * Whether to write the LOD transition fade to each tile primitive's custom
+   * primitive data instead of to the parameters of its dynamic material
+   * instance. Custom primitive data can be updated without touching the
+   * material, which is much cheaper when many tiles are fading at once.
+   *
+   * The fade percentage, from 0.0 to 1.0, is written to custom primitive data
+   * index 0, and the fading type, 0.0 when fading in and 1.0 when fading out,
+   * to index 1. The materials used by this tileset must read these with
+   * scalar parameters that have "Use Custom Primitive Data" checked, and
+   * their default values should be 1.0 and 0.0 so that tiles are visible
+   * before they start fading. The default Cesium materials read the fade
+   * from their material parameters, so this should only be enabled with
+   * custom materials.
+   *
+   * Only relevant if UseLodTransitions is true.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "UseLodTransitions", EditConditionHides))
+  bool UseCustomPrimitiveDataForLodTransitions = false;
+
+private:
+  UPROPERTY(BlueprintGetter = GetLoadProgress, Category = "Cesium")
+  float LoadProgress = 0.0f;
+
+  /**
+   * The type of source from which to load this tileset.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetTilesetSource,
+      BlueprintSetter = SetTilesetSource,
+      Category = "Cesium",
+      meta = (DisplayName = "Source"))
+  ETilesetSource TilesetSource = ETilesetSource::FromCesiumIon;
+
+  /**
+   * The URL of this tileset's "tileset.json" file.
+   *
+   * If this property is specified, the ion asset ID and token are ignored.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUrl,
+      BlueprintSetter = SetUrl,
+      Category = "Cesium",
+      meta = (EditCondition = "TilesetSource==ETilesetSource::FromUrl"))
+  FString Url = "";
+
+  /**
+   * The ID of the Cesium ion asset to use.
+   *
+   * This property is ignored if the Url is specified.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetIonAssetID,
+      BlueprintSetter = SetIonAssetID,
+      Category = "Cesium",
+      meta =
+          (EditCondition = "TilesetSource==ETilesetSource::FromCesiumIon",
+           ClampMin = 0))
+  int64 IonAssetID;
+
+  /**
+   * The access token to use to access the Cesium ion resource.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetIonAccessToken,
+      BlueprintSetter = SetIonAccessToken,
+      Category = "Cesium",
+      meta = (EditCondition = "TilesetSource==ETilesetSource::FromCesiumIon"))
+  FString IonAccessToken;
+
+  /**
+   * The URL of the ion asset endpoint. Defaults to Cesium ion but a custom
+   * endpoint can be specified.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetIonAssetEndpointUrl,
+      BlueprintSetter = SetIonAssetEndpointUrl,
+      Category = "Cesium",
+      AdvancedDisplay,
+      meta = (EditCondition = "TilesetSource==ETilesetSource::FromCesiumIon"))
+  FString IonAssetEndpointUrl;
+
+  /**
+   * Check if the Cesium ion token used to access this tileset is working
+   * correctly, and fix it if necessary.
+   */
+  UFUNCTION(CallInEditor, Category = "Cesium")
+  void TroubleshootToken();
+
+  /**
+   * Whether to generate physics meshes for this tileset.
+   *
+   * Disabling this option will improve the performance of tile loading, but it
+   * will no longer be possible to collide with the tileset since the physics
+   * meshes will not be created.
+   *
+   * Physics meshes cannot be generated for primitives containing points.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetDelayRefinementForOcclusion,
-      BlueprintSetter = SetDelayRefinementForOcclusion,
-      Category = "Cesium|Tile Occlusion",
+      BlueprintGetter = GetCreatePhysicsMeshes,
+      BlueprintSetter = SetCreatePhysicsMeshes,
+      Category = "Cesium|Physics")
+  bool CreatePhysicsMeshes = true;
+
+  /**
+   * Whether to cook physics meshes on demand, only for tiles near one of the
+   * Physics Interest Actors, instead of for every tile as it loads.
+   *
+   * When enabled, tiles become renderable without waiting for their physics
+   * meshes. A physics mesh is then cooked in the background for each rendered
+   * tile that comes within the Physics Interest Radius of an interest actor.
+   * Tiles that are never near an interest actor never have a physics mesh at
+   * all, which reduces both tile load time and memory usage when only a small
+   * part of a large tileset needs collision.
+   *
+   * This has no effect unless "Create Physics Meshes" is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCookPhysicsMeshesOnDemand,
+      BlueprintSetter = SetCookPhysicsMeshesOnDemand,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshes"))
+  bool CookPhysicsMeshesOnDemand = false;
+
+  /**
+   * Whether to load tiles only for collision, navigation and height queries,
+   * without textures, materials or render resources.
+   *
+   * Only the positions and indices of each tile are read, so tiles load faster
+   * and take much less memory, but they aren't drawn, and raster overlays
+   * aren't loaded. This is always the case on a dedicated server, which never
+   * draws anything.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCollisionOnly,
+      BlueprintSetter = SetCollisionOnly,
+      Category = "Cesium|Physics")
+  bool CollisionOnly = false;
+
+  /**
+   * Whether a server also selects tiles around each remote player, so that
+   * collision is accurate near every player rather than only near the local
+   * ones.
+   *
+   * A server has no viewport for a remote player, and only knows roughly
+   * where the player's camera is, from the view point replicated by its
+   * client or from its pawn. So tiles are selected for the six faces of a
+   * cube around that view point, each RemotePlayerViewSize pixels across.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Physics")
+  bool IncludeRemotePlayerViews = false;
+
+  /**
+   * The width and height, in pixels, of each of the six views that tiles are
+   * selected for around a remote player. This is each player's share of the
+   * server's level of detail: smaller views select coarser tiles, so that
+   * many players spread across the world don't load too much of it.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
       meta =
-          (EditCondition =
-               "EnableOcclusionCulling && CanEnableOcclusionCulling"))
-  bool DelayRefinementForOcclusion = true;
+          (EditCondition = "IncludeRemotePlayerViews",
+           ClampMin = 1,
+           UIMin = 16,
+           UIMax = 1024))
+  int32 RemotePlayerViewSize = 256;
 
   /**
-   * Refreshes this tileset, ensuring that all materials and other settings are
-   * applied. It is not usually necessary to invoke this, but when
-   * behind-the-scenes changes are made and not reflected in the tileset, this
-   * function can help.
+   * The distance, in Unreal units, from a Physics Interest Actor within which
+   * tiles will have physics meshes cooked for them when "Cook Physics Meshes
+   * On Demand" is enabled. The distance is measured to the bounding sphere of
+   * each tile primitive.
    */
-  UFUNCTION(CallInEditor, BlueprintCallable, Category = "Cesium")
-  void RefreshTileset();
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsInterestRadius,
+      BlueprintSetter = SetPhysicsInterestRadius,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CreatePhysicsMeshes && CookPhysicsMeshesOnDemand",
+           ClampMin = 0.0))
+  double PhysicsInterestRadius = 100000.0;
 
   /**
-   * Pauses level-of-detail and culling updates of this tileset.
+   * The geometric error, in meters, of the tiles that collision comes from
+   * when "Cook Physics Meshes On Demand" is enabled, or 0 to use the rendered
+   * tiles.
+   *
+   * When this is greater than 0, each rendered tile collides using its
+   * coarsest ancestor whose geometric error is no more than this, which keeps
+   * colliding while it is hidden and its descendants are rendered instead.
+   * Rendered tiles that are coarser than this collide themselves. So the
+   * collision near the Physics Interest Actors stays the same as the camera
+   * moves and the rendered level of detail changes, and physics meshes aren't
+   * cooked again for every finer tile that's rendered.
    */
-  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Debug")
-  bool SuspendUpdate;
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CreatePhysicsMeshes && CookPhysicsMeshesOnDemand",
+           ClampMin = 0.0))
+  double PhysicsGeometricError = 0.0;
 
   /**
-   * If true, this tileset is ticked/updated in the editor. If false, is only
-   * ticked while playing (including Play-in-Editor).
+   * The actors, such as pawns and vehicles, that need to collide with this
+   * tileset when "Cook Physics Meshes On Demand" is enabled. Physics meshes
+   * are cooked for tiles within the Physics Interest Radius of any of these
+   * actors.
    */
-  UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
-  bool UpdateInEditor = true;
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsInterestActors,
+      BlueprintSetter = SetPhysicsInterestActors,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CreatePhysicsMeshes && CookPhysicsMeshesOnDemand"))
+  TArray<TSoftObjectPtr<AActor>> PhysicsInterestActors;
 
   /**
-   * If true, stats about tile selection are printed to the Output Log.
+   * Whether to generate navigation collisions for this tileset.
+   *
+   * Enabling this option creates collisions for navigation when a 3D Tiles
+   * tileset is loaded. It is recommended to set "Runtime Generation" to
+   * "Static" in the navigation mesh settings in the project settings, as
+   * collision calculations become very slow.
+   *
+   * The triangles of each tile are gathered for navigation while the tile is
+   * loaded, rather than on the game thread. With "Runtime Generation" set to
+   * "Dynamic", the navigation mesh is rebuilt asynchronously within the
+   * bounds of each tile as it is shown or hidden, and setting "Data Gathering
+   * Mode" to "Lazy" also moves exporting the triangles to the navigation mesh
+   * generator.
    */
-  UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
-  bool LogSelectionStats = false;
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCreateNavCollision,
+      BlueprintSetter = SetCreateNavCollision,
+      Category = "Cesium|Navigation")
+  bool CreateNavCollision = false;
 
   /**
-   * Define the collision profile for all the 3D tiles created inside this
-   * actor.
+   * Whether to build a bounding volume hierarchy over the triangles of each
+   * tile as it loads, so that SampleHeightsOfLoadedTiles can find the height
+   * of the tileset's surface and LineTraceLoadedTiles can trace lines against
+   * it.
+   *
+   * This allows gameplay code to clamp objects to the ground, pick tiles, and
+   * test line of sight without creating physics meshes for the tiles. The
+   * hierarchy is built in a load thread, and takes roughly as much memory as
+   * the tile's vertices and indices.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintReadOnly,
-      Category = "Collision",
-      meta = (ShowOnlyInnerProperties, SkipUCSModifiedProperties))
-  FBodyInstance BodyInstance;
+      BlueprintGetter = GetEnableHeightQueries,
+      BlueprintSetter = SetEnableHeightQueries,
+      Category = "Cesium|Height Queries")
+  bool EnableHeightQueries = false;
 
   /**
-   * A delegate that will be called whenever the tileset is fully loaded.
+   * Whether to always generate a correct tangent space basis for tiles that
+   * don't have them.
+   *
+   * Normally, a per-vertex tangent space basis is only required for glTF models
+   * with a normal map. However, a custom, user-supplied material may need a
+   * tangent space basis for other purposes. When this property is set to true,
+   * tiles lacking an explicit tangent vector will have one computed
+   * automatically using the MikkTSpace algorithm. When this property is false,
+   * load time will be improved by skipping the generation of the tangent
+   * vector, but the tangent space basis will be unreliable.
+   *
+   * Note that a tileset with "Enable Water Mask" set will include tangents
+   * for tiles containing water, regardless of the value of this property.
    */
-  UPROPERTY(BlueprintAssignable, Category = "Cesium");
-  FCompletedLoadTrigger OnTilesetLoaded;
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetAlwaysIncludeTangents,
+      BlueprintSetter = SetAlwaysIncludeTangents,
+      Category = "Cesium|Rendering")
+  bool AlwaysIncludeTangents = false;
 
   /**
-   * Use a dithering effect when transitioning between tiles of different LODs.
+   * Whether to generate missing tangents with a fast method that works on
+   * the shared vertices of the glTF, rather than with MikkTSpace.
    *
-   * When this is set to true, Frustrum Culling and Fog Culling are always
-   * disabled.
+   * MikkTSpace requires the vertices shared by triangles to be duplicated
+   * first, and is often the slowest part of loading tiles that need tangents.
+   * The fast method averages the tangent of each triangle into its vertices
+   * instead. It is much faster and uses less memory, but the tangents may
+   * differ slightly from MikkTSpace's where texture coordinates are mirrored,
+   * so normal maps baked against MikkTSpace tangents may show faint seams.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetUseLodTransitions,
-      BlueprintSetter = SetUseLodTransitions,
+      BlueprintGetter = GetUseFastTangentGeneration,
+      BlueprintSetter = SetUseFastTangentGeneration,
       Category = "Cesium|Rendering")
-  bool UseLodTransitions = false;
+  bool UseFastTangentGeneration = false;
 
   /**
-   * How long dithered LOD transitions between different tiles should take, in
-   * seconds.
+   * Whether to generate smooth normals when normals are missing in the glTF.
    *
-   * Only relevant if UseLodTransitions is true.
+   * According to the Gltf spec: "When normals are not specified, client
+   * implementations should calculate flat normals." However, calculating flat
+   * normals requires duplicating vertices. This option allows the gltfs to be
+   * sent with explicit smooth normals when the original gltf was missing
+   * normals.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetGenerateSmoothNormals,
+      BlueprintSetter = SetGenerateSmoothNormals,
+      Category = "Cesium|Rendering")
+  bool GenerateSmoothNormals = false;
+
+  /**
+   * Whether smooth normals generated by "Generate Smooth Normals" are
+   * averaged across all of the vertices at the same position, rather than
+   * only across the triangles that share a vertex index.
+   *
+   * Some glTFs, such as many photogrammetry models, give the triangles that
+   * meet at a point separate vertices at the same position. Without welding,
+   * those vertices get the normals of their own triangles, so the model looks
+   * faceted even with smooth normals. Welding reads the vertex positions,
+   * so primitives lacking normals can't use "Use Vertex Pulling".
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetWeldVerticesForSmoothNormals,
+      BlueprintSetter = SetWeldVerticesForSmoothNormals,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "GenerateSmoothNormals"))
+  bool WeldVerticesForSmoothNormals = false;
+
+  /**
+   * Whether this tileset's material computes flat normals itself, for tiles
+   * whose glTF is missing normals and when "Generate Smooth Normals" is off.
+   *
+   * Normally, computing flat normals on the CPU requires duplicating every
+   * vertex shared by multiple triangles, which triples vertex memory for many
+   * photogrammetry tilesets. When this property is true, those tiles keep
+   * their shared vertices and are given the surface normal of the ellipsoid
+   * instead. The material is then expected to derive the actual flat normal
+   * per pixel from screen-space derivatives of the world position, for example
+   * by calling CesiumComputeFlatNormal from
+   * "/Plugin/CesiumForUnreal/Private/CesiumFlatNormals.ush" in a Custom node
+   * and connecting the result to a world-space Normal input. The default
+   * Cesium materials don't do this, so this should only be enabled along with
+   * a custom Material.
+   *
+   * Tiles that need a tangent space basis computed with MikkTSpace will still
+   * have their vertices duplicated.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetComputeFlatNormalsInMaterial,
+      BlueprintSetter = SetComputeFlatNormalsInMaterial,
+      Category = "Cesium|Rendering")
+  bool ComputeFlatNormalsInMaterial = false;
+
+  /**
+   * Whether to put the points of point cloud tiles in a progressive order as
+   * they're loaded, so that any number of a tile's first points are spread
+   * evenly over the whole tile.
+   *
+   * A tile that reaches the "Maximum Points Per Frame" point budget only draws
+   * as many of its first points as fit. In the order the points were stored
+   * in, those usually cover only part of the tile, leaving a hole. In the
+   * progressive order, they're a sparser sample of the whole tile instead, so
+   * the budget can be much smaller without any of the tiles in view
+   * disappearing. Ordering the points takes a little more time to load each
+   * tile.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetOrderPointsProgressively,
+      BlueprintSetter = SetOrderPointsProgressively,
+      Category = "Cesium|Rendering")
+  bool OrderPointsProgressively = false;
+
+  /**
+   * Whether this tileset's material computes the texture coordinates of
+   * raster overlays itself, from the position of each pixel.
+   *
+   * Normally, each vertex is given a texture coordinate channel for every
+   * projection used by this tileset's raster overlays, which uses vertex
+   * memory and some of the limited number of texture coordinate channels.
+   * When this property is true, those channels are left out, and the material
+   * is expected to compute the coordinates of each overlay by calling
+   * CesiumComputeOverlayUV from
+   * "/Plugin/CesiumForUnreal/Private/CesiumOverlayUVs.ush" in a Custom node,
+   * with the overlay's Overlay Origin, Overlay Local To Ecef X, Y and Z,
+   * Overlay Ellipsoid and Overlay Projection parameters, instead of reading
+   * the texture coordinates at its Texture Coordinate Index. The default
+   * Cesium materials don't do this, so this should only be enabled along with
+   * a custom Material.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetComputeOverlayTextureCoordinatesInMaterial,
+      BlueprintSetter = SetComputeOverlayTextureCoordinatesInMaterial,
+      Category = "Cesium|Rendering")
+  bool ComputeOverlayTextureCoordinatesInMaterial = false;
+
+  /**
+   * Whether to block compress this tileset's color textures as they're
+   * loaded, if they aren't already compressed.
+   *
+   * Most tilesets store their textures as JPEG or PNG images, which must be
+   * decompressed to 4 bytes per texel before they can be rendered. This
+   * compresses the base color and emissive textures to BC1 (or BC3, if they
+   * contain transparency) in the background, before they're uploaded to the
+   * GPU, using 4 to 8 times less texture memory. Water masks are compressed to
+   * BC4, using half as much memory. Compression takes extra time on the
+   * loading threads and slightly reduces image quality.
+   *
+   * Only platforms that support BC1, BC3, and BC4 textures, which are generally
+   * desktop platforms, compress textures. On other platforms, this property
+   * has no effect.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCompressTextures,
+      BlueprintSetter = SetCompressTextures,
+      Category = "Cesium|Rendering")
+  bool CompressTextures = false;
+
+  /**
+   * Whether tiles with identical textures share a single texture.
+   *
+   * The primitives of a tile that use the same glTF texture always share a
+   * texture. When this is true, each texture's image is also hashed as it's
+   * loaded, and a tile whose image is identical to one already in use by
+   * another tile, such as a shared material atlas, uses that texture instead
+   * of creating another. This saves texture memory and loading time for
+   * tilesets that repeat their textures, at the cost of hashing every image.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetShareIdenticalTextures,
+      BlueprintSetter = SetShareIdenticalTextures,
+      Category = "Cesium|Rendering")
+  bool ShareIdenticalTextures = false;
+
+  /**
+   * Whether to upload only the texture mips that each tile can use.
+   *
+   * A tile that has children is refined before it spans more pixels on the
+   * screen than its geometric error and the Maximum Screen Space Error allow,
+   * so it never needs texture mips more detailed than that. When this is
+   * true, the most detailed mips of such a tile's textures aren't uploaded to
+   * the GPU, which saves a lot of video memory for tilesets with large
+   * textures, such as photogrammetry with 4K textures in every tile. If a tile
+   * ends up needing them, such as when the Maximum Screen Space Error is
+   * lowered, they're uploaded then.
+   *
+   * The textures keep their images in CPU memory, so that the skipped mips can
+   * be uploaded later. Leaf tiles, and textures whose mipmaps are generated on
+   * the GPU, always upload every mip.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetSkipUnneededTextureMips,
+      BlueprintSetter = SetSkipUnneededTextureMips,
+      Category = "Cesium|Rendering")
+  bool SkipUnneededTextureMips = false;
+
+  /**
+   * Whether to keep hidden tiles in the scene, rather than removing their
+   * primitives from it.
+   *
+   * Tiles are shown and hidden often as the camera moves and levels of detail
+   * change. Normally, hiding a tile removes its primitives from the renderer,
+   * and showing it again adds them back, rebuilding their cached mesh draw
+   * commands. When this is enabled, the primitives of hidden tiles stay in the
+   * scene and are culled by distance instead, which makes showing and hiding
+   * them much cheaper on the render thread. Hidden tiles still take up space
+   * in the scene, and still use memory on the GPU until they are unloaded.
+   *
+   * Nanite meshes may not be culled by distance, so this should not be used
+   * with BuildNaniteMeshes.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Rendering")
+  bool KeepHiddenTilesInScene = false;
+
+  /**
+   * The distance, in Unreal units, from a camera beyond which tile primitives
+   * don't cast shadows, or 0 for tiles to cast shadows at any distance.
+   *
+   * Distant tiles add little to the shadows near the camera, but are still
+   * drawn into every shadow map that they overlap. The distance is measured
+   * to the bounding sphere of each tile primitive.
    */
   UPROPERTY(
       EditAnywhere,
       BlueprintReadWrite,
       Category = "Cesium|Rendering",
-      meta = (EditCondition = "UseLodTransitions", EditConditionHides))
-  float LodTransitionLength = 0.5f;
+      meta = (ClampMin = 0.0))
+  double ShadowCastingDistance = 0.0;
 
-private:
-  UPROPERTY(BlueprintGetter = GetLoadProgress, Category = "Cesium")
-  float LoadProgress = 0.0f;
+  /**
+   * How the primitives of this tileset invalidate the cached pages of Virtual
+   * Shadow Maps.
+   *
+   * Every time a tile is shown or hidden as the level of detail changes, the
+   * shadow pages that its primitives overlap are invalidated and rendered
+   * again. "Static" keeps the cached pages when tiles are swapped for their
+   * children or parents, which look nearly the same in shadow, at the cost
+   * of shadows that lag behind until the pages are next rendered for some
+   * other reason.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetTileShadowCacheInvalidationBehavior,
+      BlueprintSetter = SetTileShadowCacheInvalidationBehavior,
+      Category = "Cesium|Rendering")
+  EShadowCacheInvalidationBehavior TileShadowCacheInvalidationBehavior =
+      EShadowCacheInvalidationBehavior::Auto;
 
   /**
-   * The type of source from which to load this tileset.
+   * Whether to build Nanite meshes for this tileset's opaque triangle meshes
+   * as they're loaded, so that dense meshes, such as photogrammetry, are
+   * rendered by Nanite.
+   *
+   * Nanite meshes are built on the loading threads and stored in the
+   * Derived Data Cache, keyed by the mesh's contents, so a mesh that is
+   * loaded again doesn't need to be built again. Building them takes
+   * considerably longer than loading the mesh itself, so tiles appear more
+   * slowly the first time they are loaded.
+   *
+   * Unreal Engine can only build Nanite meshes in the editor, so this has no
+   * effect in packaged games. Translucent meshes and points aren't supported
+   * by Nanite, and are rendered as usual.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetTilesetSource,
-      BlueprintSetter = SetTilesetSource,
-      Category = "Cesium",
-      meta = (DisplayName = "Source"))
-  ETilesetSource TilesetSource = ETilesetSource::FromCesiumIon;
+      BlueprintGetter = GetBuildNaniteMeshes,
+      BlueprintSetter = SetBuildNaniteMeshes,
+      Category = "Cesium|Rendering")
+  bool BuildNaniteMeshes = false;
 
   /**
-   * The URL of this tileset's "tileset.json" file.
+   * (Experimental) Whether to upload the vertex attributes of this tileset's
+   * triangle meshes nearly as they are in their glTF buffers, and decode them
+   * in the vertex shader, instead of converting them to Unreal vertex formats
+   * as they're loaded. This makes loading considerably cheaper, and supports
+   * the quantized attributes of KHR_mesh_quantization without expanding them.
    *
-   * If this property is specified, the ion asset ID and token are ignored.
+   * Only meshes with positions, normals, and up to eight sets of texture
+   * coordinates can be drawn this way. Meshes with vertex colors, normal
+   * maps, tangents, the water mask, instances, features or metadata are
+   * loaded as usual, as are meshes when BuildNaniteMeshes is enabled. Tangents
+   * of pulled vertices are derived from their normals. Collision meshes built
+   * on demand need float positions.
+   *
+   * This needs a platform that supports manual vertex fetch.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetUrl,
-      BlueprintSetter = SetUrl,
-      Category = "Cesium",
-      meta = (EditCondition = "TilesetSource==ETilesetSource::FromUrl"))
-  FString Url = "";
+      BlueprintGetter = GetUseVertexPulling,
+      BlueprintSetter = SetUseVertexPulling,
+      Category = "Cesium|Rendering")
+  bool UseVertexPulling = false;
 
   /**
-   * The ID of the Cesium ion asset to use.
+   * Whether to pack the float vertex attributes of meshes drawn with pulled
+   * vertices into smaller formats on the GPU: 16-bit positions relative to
+   * the bounds of each mesh, 16-bit octahedral normals, and half-precision
+   * texture coordinates. This roughly halves their vertex memory and
+   * bandwidth. Attributes that are already quantized with
+   * KHR_mesh_quantization are kept as they are either way.
    *
-   * This property is ignored if the Url is specified.
+   * This has no effect unless UseVertexPulling is enabled.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetIonAssetID,
-      BlueprintSetter = SetIonAssetID,
-      Category = "Cesium",
-      meta =
-          (EditCondition = "TilesetSource==ETilesetSource::FromCesiumIon",
-           ClampMin = 0))
-  int64 IonAssetID;
+      BlueprintGetter = GetPackVertexAttributes,
+      BlueprintSetter = SetPackVertexAttributes,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "UseVertexPulling"))
+  bool PackVertexAttributes = false;
 
   /**
-   * The access token to use to access the Cesium ion resource.
+   * Whether to draw this tileset's primitives from render data owned by their
+   * components, rather than creating a static mesh object for every glTF
+   * primitive that's loaded. This makes creating and destroying tiles
+   * cheaper on the game thread, and lowers the number of objects the garbage
+   * collector has to visit.
+   *
+   * Primitives drawn this way aren't part of ray tracing scenes, and don't
+   * have distance fields. Instanced primitives, Nanite meshes, and primitives
+   * whose navigation collision needs a static mesh have one as usual.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetIonAccessToken,
-      BlueprintSetter = SetIonAccessToken,
-      Category = "Cesium",
-      meta = (EditCondition = "TilesetSource==ETilesetSource::FromCesiumIon"))
-  FString IonAccessToken;
+      BlueprintGetter = GetUseLightweightPrimitives,
+      BlueprintSetter = SetUseLightweightPrimitives,
+      Category = "Cesium|Rendering")
+  bool UseLightweightPrimitives = false;
 
   /**
-   * The URL of the ion asset endpoint. Defaults to Cesium ion but a custom
-   * endpoint can be specified.
+   * Whether to merge the small primitives of each tile that have the same
+   * material and vertex attributes into fewer primitives, so that tiles made
+   * of many small primitives are drawn with fewer draw calls.
+   *
+   * Only triangle primitives that aren't instanced, skinned, or morphed, and
+   * whose feature IDs are attributes, are merged. Feature IDs and metadata can
+   * still be picked from merged primitives, and the glTF primitive that a hit
+   * came from can be found with Find Source Primitive From Hit.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetIonAssetEndpointUrl,
-      BlueprintSetter = SetIonAssetEndpointUrl,
-      Category = "Cesium",
-      AdvancedDisplay,
-      meta = (EditCondition = "TilesetSource==ETilesetSource::FromCesiumIon"))
-  FString IonAssetEndpointUrl;
+      BlueprintGetter = GetMergePrimitives,
+      BlueprintSetter = SetMergePrimitives,
+      Category = "Cesium|Rendering")
+  bool MergePrimitives = false;
 
   /**
-   * Check if the Cesium ion token used to access this tileset is working
-   * correctly, and fix it if necessary.
+   * Whether to build mesh distance fields for the primitives of tiles near the
+   * camera, so that tiles cast distance field shadows and ambient occlusion,
+   * and occlude Lumen's software ray tracing.
+   *
+   * Distance fields are built from the positions and indices of each
+   * primitive on a low-priority background task, at most a few per frame,
+   * starting with the primitives closest to a camera. "Generate Mesh Distance
+   * Fields" must also be enabled in the project's rendering settings. No Lumen
+   * card representations are built for tiles, so they don't contribute their
+   * own lighting to Lumen. Lightweight primitives and primitives drawn with
+   * vertex pulling never have distance fields.
    */
-  UFUNCTION(CallInEditor, Category = "Cesium")
-  void TroubleshootToken();
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetGenerateMeshDistanceFields,
+      BlueprintSetter = SetGenerateMeshDistanceFields,
+      Category = "Cesium|Rendering")
+  bool GenerateMeshDistanceFields = false;
 
   /**
-   * Whether to generate physics meshes for this tileset.
-   *
-   * Disabling this option will improve the performance of tile loading, but it
-   * will no longer be possible to collide with the tileset since the physics
-   * meshes will not be created.
-   *
-   * Physics meshes cannot be generated for primitives containing points.
+   * The distance, in Unreal units, from a camera within which mesh distance
+   * fields are built for primitives when "Generate Mesh Distance Fields" is
+   * enabled. The distance is measured to the bounding sphere of each tile
+   * primitive. Primitives keep their distance fields until they're unloaded.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetCreatePhysicsMeshes,
-      BlueprintSetter = SetCreatePhysicsMeshes,
-      Category = "Cesium|Physics")
-  bool CreatePhysicsMeshes = true;
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "GenerateMeshDistanceFields", ClampMin = 0.0))
+  double MeshDistanceFieldDistance = 50000.0;
 
   /**
-   * Whether to generate navigation collisions for this tileset.
-   *
-   * Enabling this option creates collisions for navigation when a 3D Tiles
-   * tileset is loaded. It is recommended to set "Runtime Generation" to
-   * "Static" in the navigation mesh settings in the project settings, as
-   * collision calculations become very slow.
+   * The largest number of mesh distance fields that start being built in one
+   * frame when "Generate Mesh Distance Fields" is enabled.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetCreateNavCollision,
-      BlueprintSetter = SetCreateNavCollision,
-      Category = "Cesium|Navigation")
-  bool CreateNavCollision = false;
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "GenerateMeshDistanceFields", ClampMin = 0))
+  int32 MaximumMeshDistanceFieldsPerFrame = 2;
 
   /**
-   * Whether to always generate a correct tangent space basis for tiles that
-   * don't have them.
-   *
-   * Normally, a per-vertex tangent space basis is only required for glTF models
-   * with a normal map. However, a custom, user-supplied material may need a
-   * tangent space basis for other purposes. When this property is set to true,
-   * tiles lacking an explicit tangent vector will have one computed
-   * automatically using the MikkTSpace algorithm. When this property is false,
-   * load time will be improved by skipping the generation of the tangent
-   * vector, but the tangent space basis will be unreliable.
+   * Whether to create ray tracing geometry only for the primitives of tiles
+   * near the camera, and only for a few primitives per frame, rather than for
+   * every primitive as soon as it's loaded.
    *
-   * Note that a tileset with "Enable Water Mask" set will include tangents
-   * for tiles containing water, regardless of the value of this property.
+   * With hardware ray tracing, the bottom-level acceleration structure of
+   * every primitive with ray tracing geometry is built on the GPU, so loading
+   * many tiles at once can cause long frames. With this enabled, tiles
+   * further than Ray Tracing Distance from every camera aren't drawn into ray
+   * tracing scenes at all, for example for reflections, and nearby tiles are
+   * added to them a few at a time, closest first.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetAlwaysIncludeTangents,
-      BlueprintSetter = SetAlwaysIncludeTangents,
+      BlueprintGetter = GetLimitRayTracingGeometryBuilds,
+      BlueprintSetter = SetLimitRayTracingGeometryBuilds,
       Category = "Cesium|Rendering")
-  bool AlwaysIncludeTangents = false;
+  bool LimitRayTracingGeometryBuilds = false;
 
   /**
-   * Whether to generate smooth normals when normals are missing in the glTF.
-   *
-   * According to the Gltf spec: "When normals are not specified, client
-   * implementations should calculate flat normals." However, calculating flat
-   * normals requires duplicating vertices. This option allows the gltfs to be
-   * sent with explicit smooth normals when the original gltf was missing
-   * normals.
+   * The distance, in Unreal units, from a camera within which primitives get
+   * ray tracing geometry when "Limit Ray Tracing Geometry Builds" is enabled.
+   * The distance is measured to the bounding sphere of each tile primitive.
+   * Primitives keep their ray tracing geometry until they're unloaded.
    */
   UPROPERTY(
       EditAnywhere,
-      BlueprintGetter = GetGenerateSmoothNormals,
-      BlueprintSetter = SetGenerateSmoothNormals,
-      Category = "Cesium|Rendering")
-  bool GenerateSmoothNormals = false;
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "LimitRayTracingGeometryBuilds", ClampMin = 0.0))
+  double RayTracingDistance = 100000.0;
+
+  /**
+   * The largest number of primitives whose ray tracing geometry is created,
+   * and whose acceleration structure is built, in one frame when "Limit Ray
+   * Tracing Geometry Builds" is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "LimitRayTracingGeometryBuilds", ClampMin = 0))
+  int32 MaximumRayTracingGeometryBuildsPerFrame = 4;
 
   /**
    * Whether to request and render the water mask.
@@ -872,6 +2422,36 @@ private:
       meta = (ShowOnlyInnerProperties))
   FCustomDepthParameters CustomDepthParameters;
 
+  /**
+   * The Runtime Virtual Textures that this tileset's tiles are drawn into.
+   *
+   * Drawing tiles into a Runtime Virtual Texture lets the expensive parts of
+   * their material, such as blending raster overlays, be evaluated once per
+   * virtual texture page and cached, rather than every frame. The material
+   * should output to the virtual texture with a "Runtime Virtual Texture
+   * Output" node, and can sample it in the main pass with a "Runtime Virtual
+   * Texture Replace" node. A Runtime Virtual Texture Volume covering the
+   * tileset must also be placed in the level.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetRuntimeVirtualTextures,
+      BlueprintSetter = SetRuntimeVirtualTextures,
+      Category = "Cesium|Rendering|Virtual Texture")
+  TArray<URuntimeVirtualTexture*> RuntimeVirtualTextures;
+
+  /**
+   * Controls whether tiles are drawn in the main pass when they are also
+   * drawn into any of the {@link RuntimeVirtualTextures}.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetVirtualTextureRenderPassType,
+      BlueprintSetter = SetVirtualTextureRenderPassType,
+      Category = "Cesium|Rendering|Virtual Texture")
+  ERuntimeVirtualTextureMainPassType VirtualTextureRenderPassType =
+      ERuntimeVirtualTextureMainPassType::Exclusive;
+
   /**
    * If this tileset contains points, their appearance can be configured with
    * these point cloud shading parameters.
@@ -885,6 +2465,24 @@ private:
       Category = "Cesium|Rendering")
   FCesiumPointCloudShading PointCloudShading;
 
+  /**
+   * The style that colors and hides the features of this tileset based on
+   * their metadata.
+   *
+   * The styled property must be encoded by this tileset's
+   * CesiumFeaturesMetadata component, and the tileset's material must use the
+   * material layer generated by it, with the "Style Color" output of the
+   * "Apply Feature Style" node multiplied into the base color and its
+   * "StyleShow" output used as the opacity mask. Changing the style doesn't
+   * reload any tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetFeatureStyle,
+      BlueprintSetter = SetFeatureStyle,
+      Category = "Cesium|Rendering")
+  FCesiumFeatureStyle FeatureStyle;
+
 protected:
   UPROPERTY()
   FString PlatformName;
@@ -904,85 +2502,353 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium")
   void SetUseLodTransitions(bool InUseLodTransitions);
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium")
-  ETilesetSource GetTilesetSource() const { return TilesetSource; }
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  ETilesetSource GetTilesetSource() const { return TilesetSource; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetTilesetSource(ETilesetSource InSource);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  FString GetUrl() const { return Url; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetUrl(const FString& InUrl);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  int64 GetIonAssetID() const { return IonAssetID; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetIonAssetID(int64 InAssetID);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  FString GetIonAccessToken() const { return IonAccessToken; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetIonAccessToken(const FString& InAccessToken);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  FString GetIonAssetEndpointUrl() const { return IonAssetEndpointUrl; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetIonAssetEndpointUrl(const FString& InIonAssetEndpointUrl);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  double GetMaximumScreenSpaceError() { return MaximumScreenSpaceError; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetMaximumScreenSpaceError(double InMaximumScreenSpaceError);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
+  bool GetEnableOcclusionCulling() const;
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
+  void SetEnableOcclusionCulling(bool bEnableOcclusionCulling);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
+  int32 GetOcclusionPoolSize() const { return OcclusionPoolSize; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
+  void SetOcclusionPoolSize(int32 newOcclusionPoolSize);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
+  bool GetDelayRefinementForOcclusion() const {
+    return DelayRefinementForOcclusion;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
+  void SetDelayRefinementForOcclusion(bool bDelayRefinementForOcclusion);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetCreatePhysicsMeshes() const { return CreatePhysicsMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetCookPhysicsMeshesOnDemand() const {
+    return CookPhysicsMeshesOnDemand;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetCookPhysicsMeshesOnDemand(bool bCookPhysicsMeshesOnDemand);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetCollisionOnly() const { return CollisionOnly; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetCollisionOnly(bool bCollisionOnly);
+
+  /**
+   * Whether tiles are loaded only for collision, because CollisionOnly is set
+   * or because this is a dedicated server.
+   */
+  bool IsCollisionOnly() const {
+    return CollisionOnly || IsRunningDedicatedServer();
+  }
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  double GetPhysicsInterestRadius() const { return PhysicsInterestRadius; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetPhysicsInterestRadius(double InPhysicsInterestRadius);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  TArray<TSoftObjectPtr<AActor>> GetPhysicsInterestActors() const {
+    return PhysicsInterestActors;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetPhysicsInterestActors(
+      const TArray<TSoftObjectPtr<AActor>>& InPhysicsInterestActors);
+
+  /**
+   * Adds an actor to the Physics Interest Actors, if it is not already one.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Physics")
+  void AddPhysicsInterestActor(AActor* Actor);
+
+  /**
+   * Removes an actor from the Physics Interest Actors.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Physics")
+  void RemovePhysicsInterestActor(AActor* Actor);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
+  bool GetCreateNavCollision() const { return CreateNavCollision; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Navigation")
+  void SetCreateNavCollision(bool bCreateNavCollision);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Height Queries")
+  bool GetEnableHeightQueries() const { return EnableHeightQueries; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Height Queries")
+  void SetEnableHeightQueries(bool bEnableHeightQueries);
+
+  /**
+   * Samples the height of the tileset's surface below and above many
+   * positions at once, from the tiles that are currently shown. This requires
+   * EnableHeightQueries, but not physics meshes.
+   *
+   * For each position, a line along the ellipsoid's normal is intersected
+   * with the triangles of the tiles, and the highest point where it hits a
+   * triangle is the sampled height. Only the tiles that are shown are
+   * sampled, so the height comes from the tiles loaded for the current views,
+   * which may be coarse far away from them.
+   *
+   * @param LongitudeLatitudeHeights The positions to sample, as longitude in
+   * degrees (X), latitude in degrees (Y), and height in meters (Z). The
+   * height is ignored.
+   * @param OutLongitudeLatitudeHeights The positions with their heights
+   * replaced by the sampled heights, in the same order. The positions that
+   * couldn't be sampled keep their original heights.
+   * @param OutSampleSuccess Whether each position was sampled.
+   * @param OutGeometricErrors The geometric error, in meters, of the tile
+   * that each position was sampled from, which tells how detailed its sampled
+   * height is, or -1 for the positions that couldn't be sampled.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Height Queries")
+  void SampleHeightsOfLoadedTiles(
+      const TArray<FVector>& LongitudeLatitudeHeights,
+      TArray<FVector>& OutLongitudeLatitudeHeights,
+      TArray<bool>& OutSampleSuccess,
+      TArray<double>& OutGeometricErrors);
+
+  /**
+   * Finds the first point where a line hits the triangles of the tiles that
+   * are currently shown. This requires EnableHeightQueries, but not physics
+   * meshes, and doesn't depend on the tiles' collision settings.
+   *
+   * @param Start The start of the line, in Unreal world coordinates.
+   * @param End The end of the line, in Unreal world coordinates.
+   * @param OutHit The hit, if there is one. Its normal faces the start of the
+   * line, and its face index is the index of the triangle in its component's
+   * hierarchy rather than in the glTF.
+   * @return Whether the line hits a tile.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Height Queries")
+  bool LineTraceLoadedTiles(
+      const FVector& Start,
+      const FVector& End,
+      FHitResult& OutHit);
+
+  /**
+   * Traces many lines against the tiles that are currently shown at once,
+   * across threads. This is equivalent to calling LineTraceLoadedTiles for
+   * each line, but is much faster for large numbers of lines.
+   *
+   * @param Starts The start of each line, in Unreal world coordinates.
+   * @param Ends The end of each line, in Unreal world coordinates.
+   * @param OutHits The hit for each line. Lines that don't hit a tile have
+   * hits that aren't blocking hits.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Height Queries")
+  void LineTraceLoadedTilesBatch(
+      const TArray<FVector>& Starts,
+      const TArray<FVector>& Ends,
+      TArray<FHitResult>& OutHits);
+
+  /**
+   * Samples the height of the tileset's surface at many positions from its
+   * most detailed tiles, loading the tiles that are needed wherever the
+   * cameras are. This requires EnableHeightQueries.
+   *
+   * The tileset is refined at each position, as if a tiny camera was there,
+   * until the heights sampled from the tiles that are shown stop changing
+   * once they're all loaded. Only the tiles around the positions are loaded
+   * for this, and they're shown like the tiles of any other view while the
+   * heights are sampled. Positions are sampled a batch at a time, and
+   * queries are answered in the order they're made. Queries wait while the
+   * tileset's updates are suspended or its selection is frozen.
+   *
+   * @param LongitudeLatitudeHeights The positions to sample, as longitude in
+   * degrees (X), latitude in degrees (Y), and height in meters (Z). The
+   * height is only a first guess of the surface's height, which fewer tiles
+   * need to be loaded to sample when it's close.
+   * @param OnHeightsSampled The callback to call with the positions with
+   * their heights replaced by the sampled heights, whether each position was
+   * sampled, and the geometric error of the tile that each was sampled from,
+   * as SampleHeightsOfLoadedTiles gives them. It's called on the game thread,
+   * after a later update of the tileset, or with no positions sampled if the
+   * tileset is destroyed first.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Height Queries")
+  void SampleHeightMostDetailed(
+      const TArray<FVector>& LongitudeLatitudeHeights,
+      const FCesiumSampleHeightMostDetailedCallback& OnHeightsSampled);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetAlwaysIncludeTangents() const { return AlwaysIncludeTangents; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseFastTangentGeneration() const { return UseFastTangentGeneration; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseFastTangentGeneration(bool bUseFastTangentGeneration);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetGenerateSmoothNormals() const { return GenerateSmoothNormals; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetGenerateSmoothNormals(bool bGenerateSmoothNormals);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetWeldVerticesForSmoothNormals() const {
+    return WeldVerticesForSmoothNormals;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetWeldVerticesForSmoothNormals(bool bWeldVerticesForSmoothNormals);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetComputeFlatNormalsInMaterial() const {
+    return ComputeFlatNormalsInMaterial;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetComputeFlatNormalsInMaterial(bool bComputeFlatNormalsInMaterial);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetOrderPointsProgressively() const { return OrderPointsProgressively; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetOrderPointsProgressively(bool bOrderPointsProgressively);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetComputeOverlayTextureCoordinatesInMaterial() const {
+    return ComputeOverlayTextureCoordinatesInMaterial;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetComputeOverlayTextureCoordinatesInMaterial(
+      bool bComputeOverlayTextureCoordinatesInMaterial);
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium")
-  void SetTilesetSource(ETilesetSource InSource);
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetCompressTextures() const { return CompressTextures; }
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium")
-  FString GetUrl() const { return Url; }
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetCompressTextures(bool bCompressTextures);
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium")
-  void SetUrl(const FString& InUrl);
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  EShadowCacheInvalidationBehavior
+  GetTileShadowCacheInvalidationBehavior() const {
+    return TileShadowCacheInvalidationBehavior;
+  }
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium")
-  int64 GetIonAssetID() const { return IonAssetID; }
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetTileShadowCacheInvalidationBehavior(
+      EShadowCacheInvalidationBehavior InBehavior);
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium")
-  void SetIonAssetID(int64 InAssetID);
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetShareIdenticalTextures() const { return ShareIdenticalTextures; }
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium")
-  FString GetIonAccessToken() const { return IonAccessToken; }
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetShareIdenticalTextures(bool bShareIdenticalTextures);
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium")
-  void SetIonAccessToken(const FString& InAccessToken);
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetSkipUnneededTextureMips() const { return SkipUnneededTextureMips; }
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium")
-  FString GetIonAssetEndpointUrl() const { return IonAssetEndpointUrl; }
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetSkipUnneededTextureMips(bool bSkipUnneededTextureMips);
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium")
-  void SetIonAssetEndpointUrl(const FString& InIonAssetEndpointUrl);
+  bool GetKeepHiddenTilesInScene() const { return KeepHiddenTilesInScene; }
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium")
-  double GetMaximumScreenSpaceError() { return MaximumScreenSpaceError; }
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetBuildNaniteMeshes() const { return BuildNaniteMeshes; }
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium")
-  void SetMaximumScreenSpaceError(double InMaximumScreenSpaceError);
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetBuildNaniteMeshes(bool bBuildNaniteMeshes);
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
-  bool GetEnableOcclusionCulling() const;
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseVertexPulling() const { return UseVertexPulling; }
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
-  void SetEnableOcclusionCulling(bool bEnableOcclusionCulling);
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseVertexPulling(bool bUseVertexPulling);
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
-  int32 GetOcclusionPoolSize() const { return OcclusionPoolSize; }
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetPackVertexAttributes() const { return PackVertexAttributes; }
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
-  void SetOcclusionPoolSize(int32 newOcclusionPoolSize);
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetPackVertexAttributes(bool bPackVertexAttributes);
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
-  bool GetDelayRefinementForOcclusion() const {
-    return DelayRefinementForOcclusion;
-  }
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseLightweightPrimitives() const { return UseLightweightPrimitives; }
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
-  void SetDelayRefinementForOcclusion(bool bDelayRefinementForOcclusion);
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseLightweightPrimitives(bool bUseLightweightPrimitives);
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
-  bool GetCreatePhysicsMeshes() const { return CreatePhysicsMeshes; }
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Loading")
+  ECesiumGltfDataRetention GetGltfDataRetention() const {
+    return GltfDataRetention;
+  }
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
-  void SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes);
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Loading")
+  void SetGltfDataRetention(ECesiumGltfDataRetention InGltfDataRetention);
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
-  bool GetCreateNavCollision() const { return CreateNavCollision; }
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetMergePrimitives() const { return MergePrimitives; }
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium|Navigation")
-  void SetCreateNavCollision(bool bCreateNavCollision);
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetMergePrimitives(bool bMergePrimitives);
 
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
-  bool GetAlwaysIncludeTangents() const { return AlwaysIncludeTangents; }
+  bool GetGenerateMeshDistanceFields() const {
+    return GenerateMeshDistanceFields;
+  }
 
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
-  void SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents);
+  void SetGenerateMeshDistanceFields(bool bGenerateMeshDistanceFields);
 
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
-  bool GetGenerateSmoothNormals() const { return GenerateSmoothNormals; }
+  bool GetLimitRayTracingGeometryBuilds() const {
+    return LimitRayTracingGeometryBuilds;
+  }
 
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
-  void SetGenerateSmoothNormals(bool bGenerateSmoothNormals);
+  void SetLimitRayTracingGeometryBuilds(bool bLimitRayTracingGeometryBuilds);
 
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetEnableWaterMask() const { return EnableWaterMask; }
@@ -1023,6 +2889,24 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Rendering")
   void SetCustomDepthParameters(FCustomDepthParameters InCustomDepthParameters);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering|Virtual Texture")
+  TArray<URuntimeVirtualTexture*> GetRuntimeVirtualTextures() const {
+    return RuntimeVirtualTextures;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering|Virtual Texture")
+  void SetRuntimeVirtualTextures(
+      const TArray<URuntimeVirtualTexture*>& InRuntimeVirtualTextures);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering|Virtual Texture")
+  ERuntimeVirtualTextureMainPassType GetVirtualTextureRenderPassType() const {
+    return VirtualTextureRenderPassType;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering|Virtual Texture")
+  void SetVirtualTextureRenderPassType(
+      ERuntimeVirtualTextureMainPassType InVirtualTextureRenderPassType);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   FCesiumPointCloudShading GetPointCloudShading() const {
     return PointCloudShading;
@@ -1031,6 +2915,112 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetPointCloudShading(FCesiumPointCloudShading InPointCloudShading);
 
+  /**
+   * Gets the custom depth parameters of this tileset's points. These are the
+   * CustomDepthParameters, unless the PointCloudShading enables Eye-Dome
+   * Lighting, which draws the points into the CustomDepth pass with its own
+   * stencil value.
+   */
+  FCustomDepthParameters GetPointCustomDepthParameters() const;
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  FCesiumFeatureStyle GetFeatureStyle() const { return FeatureStyle; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetFeatureStyle(const FCesiumFeatureStyle& InFeatureStyle);
+
+  /**
+   * Multiplies the color of features of a property table by the given color,
+   * such as to highlight them.
+   *
+   * The colors and visibility of features are encoded into a texture for each
+   * property table, which is shared by every tile, so they may be changed as
+   * often as needed without any work for each tile. The tileset's material
+   * must use the material layer generated by its CesiumFeaturesMetadata
+   * component, with the "Selection Color" output of the "Apply Feature
+   * Selection" node multiplied into the base color and its "SelectionShow"
+   * output used as the opacity mask.
+   *
+   * @param PropertyTableName The name of the property table, as it's listed
+   * in the CesiumFeaturesMetadata component.
+   * @param FeatureIDs The IDs of the features, which are their indices in the
+   * property table. IDs of 16,777,216 or more are ignored.
+   * @param Color The color to multiply the features by. White leaves them as
+   * they are.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
+  void SetFeatureColor(
+      const FString& PropertyTableName,
+      const TArray<int64>& FeatureIDs,
+      const FLinearColor& Color);
+
+  /**
+   * Shows or hides features of a property table. See SetFeatureColor.
+   *
+   * @param PropertyTableName The name of the property table, as it's listed
+   * in the CesiumFeaturesMetadata component.
+   * @param FeatureIDs The IDs of the features, which are their indices in the
+   * property table.
+   * @param bShow Whether to show the features.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
+  void SetFeatureVisibility(
+      const FString& PropertyTableName,
+      const TArray<int64>& FeatureIDs,
+      bool bShow);
+
+  /**
+   * Shows every feature of a property table in its own color again, undoing
+   * SetFeatureColor and SetFeatureVisibility.
+   *
+   * @param PropertyTableName The name of the property table, as it's listed
+   * in the CesiumFeaturesMetadata component.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
+  void ResetFeatureSelection(const FString& PropertyTableName);
+
+  /**
+   * Finds the features of the tiles that are shown whose value of a numeric or
+   * boolean property is between Minimum and Maximum, inclusive.
+   *
+   * The first query of a property indexes its values in every loaded tile,
+   * which takes about as long as reading them all once. After that, tiles are
+   * indexed as they're loaded and unloaded, and queries only search the
+   * sorted values of each tile, so they're fast enough to run every frame.
+   * Features of tiles that are loaded but not shown, such as the parents of
+   * the tiles that are shown, aren't found, so that the same feature is
+   * rarely found more than once.
+   *
+   * @param PropertyTableName The name of the property table, or its class if
+   * it has no name.
+   * @param PropertyName The name of the property.
+   * @param Minimum The smallest value to find.
+   * @param Maximum The largest value to find.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata")
+  TArray<FCesiumFeatureHandle> FindFeaturesInRange(
+      const FString& PropertyTableName,
+      const FString& PropertyName,
+      double Minimum,
+      double Maximum);
+
+  /**
+   * Finds the features of the tiles that are shown whose value of a property
+   * is equal to the given one. See FindFeaturesInRange.
+   *
+   * @param PropertyTableName The name of the property table, or its class if
+   * it has no name.
+   * @param PropertyName The name of the property.
+   * @param Value The value to find. Strings are compared case-sensitively.
+   * For numeric and boolean properties, the value is parsed as a number, or
+   * as "true" or "false".
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata")
+  TArray<FCesiumFeatureHandle> FindFeaturesWithValue(
+      const FString& PropertyTableName,
+      const FString& PropertyName,
+      const FString& Value);
+
   UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
   void PlayMovieSequencer();
 
@@ -1040,6 +3030,89 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
   void PauseMovieSequencer();
 
+  /**
+   * The number of upcoming frames of the playing level sequence whose camera
+   * views are loaded along with the current frame while a movie is captured,
+   * after PlayMovieSequencer is called.
+   *
+   * The camera of each upcoming frame is evaluated from the sequence's camera
+   * cut track. Upcoming frames are loaded in batches: the views of the next
+   * MovieLookAheadFrames frames are loaded together with the current one, so
+   * that the tiles for all of them are requested at once rather than one
+   * frame after another, and the frames in the batch are then ready as soon
+   * as they're reached. The tiles must fit in MaximumCachedBytes to stay
+   * loaded until they're needed. Zero loads each frame on its own.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (ClampMin = 0))
+  int32 MovieLookAheadFrames = 0;
+
+  /**
+   * Whether each frame blocks until every tile needed for it is loaded while
+   * a movie is captured.
+   *
+   * When this is false, tiles load in the background as usual while a movie
+   * is captured, and IsMovieFrameReady reports whether the current frame has
+   * everything it needs, so that the renderer can wait for it, such as with a
+   * custom Movie Render Queue setting, without blocking the game thread.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Rendering")
+  bool WaitForMovieFrameTiles = true;
+
+  /**
+   * Whether every tile needed for the current frame of a movie being
+   * captured, and for the upcoming frames being loaded with it, is loaded.
+   * This is always true when no movie is being captured.
+   */
+  UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Cesium|Rendering")
+  bool IsMovieFrameReady() const;
+
+  /**
+   * Whether IsMovieFrameReady is true for every tileset in the world.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Rendering",
+      meta = (WorldContext = "WorldContextObject"))
+  static bool AreTilesetsReadyForMovieFrame(const UObject* WorldContextObject);
+
+  /**
+   * Gets how long this tileset's tiles have taken to get through each stage
+   * of the tile loading pipeline, since the tileset was created or since the
+   * statistics were last reset. The 95th percentiles across all tilesets are
+   * also shown by `stat Cesium`.
+   */
+  UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Cesium|Tile Loading")
+  FCesiumTilePipelineStatistics GetTilePipelineStatistics() const;
+
+  /**
+   * Discards the tile loading pipeline statistics collected so far.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  void ResetTilePipelineStatistics();
+
+  /**
+   * Writes the tile loading pipeline statistics, along with the histogram of
+   * each stage, to a CSV file.
+   *
+   * @param Filename The path of the file to write.
+   * @return Whether the file was written.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  bool WriteTilePipelineStatisticsToCsv(const FString& Filename);
+
+  /**
+   * Gets the memory held by the Unreal Engine resources created for this
+   * tileset's loaded tiles, by the kind of resource. The totals across all
+   * tilesets are also shown by `stat Cesium` and as Unreal Insights counters.
+   */
+  UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Cesium|Tile Loading")
+  FCesiumTilesetMemoryUsage GetMemoryUsage() const;
+
   /**
    * This method is not supposed to be called by clients. It is currently
    * only required by the UnrealResourcePreparer.
@@ -1049,6 +3122,46 @@ public:
    */
   const glm::dmat4& GetCesiumTilesetToUnrealRelativeWorldTransform() const;
 
+  /**
+   * This method is not supposed to be called by clients. It is currently
+   * only required when creating the primitive components of loaded tiles.
+   *
+   * Gets the pool of primitive components that this tileset's tiles take
+   * their components from and return them to.
+   */
+  CesiumPrimitiveComponentPool& GetPrimitiveComponentPool();
+
+  /**
+   * This method is not supposed to be called by clients. It is currently
+   * only required when creating the primitive components of loaded tiles.
+   *
+   * Gets the batch that the render data of this tileset's lightweight
+   * primitives is initialized in, once for all of the tiles that are created
+   * in a frame.
+   */
+  CesiumRenderDataBatch& GetRenderDataBatch();
+
+  /**
+   * This method is not supposed to be called by clients. It is currently
+   * only required when creating the materials of loaded tiles.
+   *
+   * Gets the texture that the {@link FeatureStyle} is encoded in, which every
+   * tile material shares. Created on first use.
+   */
+  UTexture2D* GetFeatureStyleTexture();
+
+  /**
+   * This method is not supposed to be called by clients. It is currently
+   * only required when creating the materials of loaded tiles.
+   *
+   * Gets the textures that the colors and visibility of features are encoded
+   * in, by the name of their property table. Only property tables with
+   * features that have been given colors or hidden have a texture.
+   */
+  const TMap<FString, UTexture2D*>& GetFeatureSelectionTextures() const {
+    return this->_featureSelectionTextures;
+  }
+
   Cesium3DTilesSelection::Tileset* GetTileset() {
     return this->_pTileset.Get();
   }
@@ -1060,7 +3173,6 @@ public:
   virtual bool ShouldTickIfViewportsOnly() const override;
   virtual void Tick(float DeltaTime) override;
   virtual void BeginDestroy() override;
-  virtual bool IsReadyForFinishDestroy() override;
   virtual void Destroyed() override;
   virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
   virtual void PostLoad() override;
@@ -1068,6 +3180,11 @@ public:
 
   void UpdateLoadStatus();
 
+  // The file that the URLs for EnableWarmStart are saved in, which is named
+  // by a hash of the tileset's source.
+  FString GetWarmStartFilename() const;
+  void SaveWarmStartUrls();
+
   // UObject overrides
 #if WITH_EDITOR
   virtual void
@@ -1101,7 +3218,14 @@ protected:
 
 private:
   void LoadTileset();
-  void DestroyTileset();
+
+  /**
+   * Destroys the cesium-native Tileset, if there is one. Its loads that are
+   * still in flight finish in the background, without this actor. If the
+   * actor is going away, its glTF components are left to be destroyed with
+   * it, instead of being destroyed one tile at a time.
+   */
+  void DestroyTileset(bool actorIsGoingAway = false);
 
   static Cesium3DTilesSelection::ViewState CreateViewStateFromViewParameters(
       const FCesiumCamera& camera,
@@ -1109,6 +3233,7 @@ private:
 
   std::vector<FCesiumCamera> GetCameras() const;
   std::vector<FCesiumCamera> GetPlayerCameras() const;
+  std::vector<FCesiumCamera> GetRemotePlayerCameras() const;
   std::vector<FCesiumCamera> GetSceneCaptures() const;
 
 public:
@@ -1116,8 +3241,10 @@ public:
    * Update the transforms of the glTF components based on the
    * the transform of the root component.
    *
-   * This is supposed to be called during Tick, if the transform of
-   * the root component has changed since the previous Tick.
+   * This is called when the transform from the tileset's coordinates to
+   * Unreal's changes, such as when the georeference changes. Moving the
+   * tileset actor doesn't call it, because the glTF components are attached
+   * to the root component and move along with it.
    */
   void UpdateTransformFromCesium();
 
@@ -1139,14 +3266,214 @@ private:
   void updateLastViewUpdateResultState(
       const Cesium3DTilesSelection::ViewUpdateResult& result);
 
+  /**
+   * Applies the raster overlay tiles that were attached to or detached from
+   * this tileset's models during the last view update.
+   */
+  void applyPendingRasterTiles();
+
+  /**
+   * Adds a camera to the given list for each moving camera in it, at the
+   * position it is predicted to reach in PrefetchTime seconds.
+   */
+  void
+  addPredictedCameras(std::vector<FCesiumCamera>& cameras, float deltaTime);
+
+  /**
+   * Adds the cameras of the upcoming frames of the playing level sequence to
+   * the given list, for MovieLookAheadFrames, until they are loaded.
+   */
+  void addMovieLookAheadCameras(std::vector<FCesiumCamera>& cameras);
+
+  /**
+   * Lowers the level of detail of the given cameras by their
+   * MaximumScreenSpaceErrorMultiplier, and of those with lower PriorityWeights
+   * than the others while the load slots are all in use.
+   */
+  void
+  applyCameraPriorities(std::vector<FCesiumCamera>& cameras, float deltaTime);
+
+  /**
+   * Adds six cameras to the given list for each interest point, looking in
+   * every direction from it. Their level of detail is relative to that of the
+   * first viewCameraCount cameras in the list.
+   */
+  void addInterestPointCameras(
+      std::vector<FCesiumCamera>& cameras,
+      size_t viewCameraCount,
+      const glm::dmat4& unrealWorldToCesiumTileset) const;
+
+  /**
+   * Lowers the level of detail of the first cameraCount cameras in the given
+   * list to PeripheralDetailFactor, and adds a narrow camera at the full
+   * level of detail for each of them, around the gaze direction.
+   */
+  /**
+   * Feeds the latest frame time and memory usage to the detail governor when
+   * EnableDetailGovernor is set, and logs any change it makes.
+   */
+  void updateDetailGovernor(float deltaTime);
+
+  /**
+   * Whether tiles fade between levels of detail, which UseLodTransitions
+   * enables unless the current scalability tier disables it.
+   */
+  bool shouldUseLodTransitions() const;
+
+  /**
+   * Refreshes the raster overlays when the maximum texture size of the
+   * current Texture Quality's scalability tier changes, so that they create
+   * their textures at the new size.
+   */
+  void updateScalabilityTextureSize();
+
+  void addFoveatedCameras(
+      std::vector<FCesiumCamera>& cameras,
+      size_t cameraCount);
+
+  /**
+   * Determines whether the tile selection from the last view update can be
+   * reused for the given views, because neither the views nor anything else
+   * that affects tile selection has changed, and no tiles are loading or
+   * fading.
+   */
+  bool
+  isViewStatic(const std::vector<Cesium3DTilesSelection::ViewState>& views);
+
+  /**
+   * Records the state from a full view update, which {@link isViewStatic}
+   * compares against and {@link reuseLastView} reuses.
+   */
+  void recordLastView(
+      std::vector<Cesium3DTilesSelection::ViewState>&& views,
+      const Cesium3DTilesSelection::ViewUpdateResult& result);
+
+  /**
+   * Applies the DebugColorMode to the given rendered tiles and their glTF
+   * components, or removes the debug colors of every loaded tile once the
+   * mode is set back to None.
+   */
+  void updateDebugColors(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+      const std::vector<UCesiumGltfComponent*>& gltfs,
+      const std::vector<Cesium3DTilesSelection::ViewState>& views);
+
+  /**
+   * Keeps the tile selection from the last view update in place of a new view
+   * update this frame, adding its credits to the current frame again.
+   */
+  void reuseLastView();
+
+  /**
+   * Freezes the tile selection from the last view update, for
+   * FreezeSelection, finishing the fades of its tiles.
+   */
+  void completeFreeze();
+
+  /**
+   * Finishes the fades of the tiles from the last view update at once, for
+   * when nothing will move them on.
+   */
+  void finishFades();
+
+  /**
+   * Starts or stops drawing this tileset as an impostor, depending on the
+   * distance from the given views. See EnableImpostor.
+   *
+   * @return Whether the tileset is an impostor this frame, in which case it
+   * should reuse the last view instead of updating.
+   */
+  bool updateImpostor(
+      const std::vector<Cesium3DTilesSelection::ViewState>& views);
+
+  /**
+   * Stops drawing this tileset as an impostor, showing the tiles from the
+   * last view update again if the ImpostorMesh had hidden them.
+   */
+  void endImpostor();
+
   /**
    * Creates the visual representations of the given tiles to
    * be rendered in the current frame.
    *
    * @param tiles The tiles
+   * @param gltfs The glTF component of each tile, or nullptr for tiles
+   * without loaded render resources.
    */
-  void
-  showTilesToRender(const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+  void showTilesToRender(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+      const std::vector<UCesiumGltfComponent*>& gltfs);
+
+  /**
+   * Cooks physics meshes, in the background, for the primitives of the given
+   * rendered tiles that are near a Physics Interest Actor and don't have one
+   * yet. Only used when CookPhysicsMeshesOnDemand is enabled.
+   *
+   * @param tiles The tiles
+   */
+  void cookPhysicsMeshesNearInterestActors(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+
+  /**
+   * Finds the tiles that the given rendered tiles collide with, which are
+   * the rendered tiles themselves unless PhysicsGeometricError is set, and
+   * keeps collision enabled for the ones that aren't rendered.
+   *
+   * @param tiles The tiles
+   * @return The loaded glTF component of each distinct collision level tile.
+   */
+  std::vector<UCesiumGltfComponent*> updateCollisionLevelTiles(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+
+  /**
+   * Starts building mesh distance fields, in the background, for the
+   * primitives of the given rendered tiles that are near one of the given
+   * cameras and don't have one yet, closest first. Only used when
+   * GenerateMeshDistanceFields is enabled.
+   *
+   * @param cameras The cameras
+   * @param tiles The tiles
+   */
+  void generateMeshDistanceFieldsNearCameras(
+      const std::vector<FCesiumCamera>& cameras,
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+
+  /**
+   * Creates ray tracing geometry for the primitives of the given rendered
+   * tiles that are near one of the given cameras and don't have it yet,
+   * closest first. Only used when LimitRayTracingGeometryBuilds is enabled.
+   *
+   * @param cameras The cameras
+   * @param tiles The tiles
+   */
+  void createRayTracingGeometryNearCameras(
+      const std::vector<FCesiumCamera>& cameras,
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+
+  /**
+   * Sets whether the primitives of the given rendered tiles cast shadows,
+   * according to their distance from the given cameras and
+   * ShadowCastingDistance.
+   *
+   * @param cameras The cameras
+   * @param tiles The tiles
+   */
+  void updateTileShadowCasting(
+      const std::vector<FCesiumCamera>& cameras,
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+
+  /**
+   * Requests the resolution that the streamed textures of the given rendered
+   * tiles need, according to their size on the screen of the given cameras.
+   * Only used when "Use Texture Streaming" is enabled in the Cesium runtime
+   * settings, or when SkipUnneededTextureMips is enabled.
+   *
+   * @param cameras The cameras
+   * @param tiles The tiles
+   */
+  void requestTextureResolutions(
+      const std::vector<FCesiumCamera>& cameras,
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
 
   /**
    * Will be called after the tileset is loaded or spawned, to register
@@ -1196,6 +3523,14 @@ private:
   uint32_t _lastTilesWaitingForOcclusionResults;
   uint32_t _lastMaxDepthVisited;
 
+  // Game-thread time spent finalizing this tileset's tiles in the current
+  // frame, in milliseconds.
+  double _mainThreadLoadingTimeThisFrame;
+
+  // The MaximumTextureSize of the scalability tier that the raster overlays
+  // were last added with.
+  int32 _scalabilityMaximumTextureSize;
+
   std::chrono::high_resolution_clock::time_point _startTime;
 
   bool _captureMovieMode;
@@ -1204,6 +3539,17 @@ private:
   int32_t _beforeMovieLoadingDescendantLimit;
   bool _beforeMovieUseLodTransitions;
 
+  // Whether primitives keep a copy of their triangles for
+  // BakeRegionToStaticMeshes while they're loaded.
+  bool _keepMeshDataForBaking;
+
+  // The level sequence that a movie is being captured from, and the frames
+  // whose views are being or have been loaded for MovieLookAheadFrames.
+  TWeakObjectPtr<ALevelSequenceActor> _movieSequenceActor;
+  int32 _movieLookAheadFirstFrame;
+  int32 _movieLookAheadEndFrame;
+  std::vector<FCesiumCamera> _movieLookAheadCameras;
+
   bool _scaleUsingDPI;
 
   // This is used as a workaround for cesium-native#186
@@ -1220,7 +3566,223 @@ private:
   // tilesToHideThisFrame may be hidden immediately.
   std::vector<Cesium3DTilesSelection::Tile*> _tilesToHideNextFrame;
 
-  int32 _tilesetsBeingDestroyed;
+  // The models that have had raster overlay tiles attached or detached since
+  // the last view update. Their material parameters are updated together
+  // after each update, so that refining many tiles in one frame updates each
+  // primitive's material only once.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>>
+      _gltfComponentsWithPendingRasterTiles;
+
+  // The state from the last full view update, used to reuse its tile
+  // selection in frames where the tileset isn't updated. The result points
+  // into _pTileset, and its tiles remain valid until the next view update.
+  // _lastViewIsStatic is set when the selection is complete, so it can be
+  // reused for as long as the views stay the same.
+  const Cesium3DTilesSelection::ViewUpdateResult* _pLastViewUpdateResult;
+  bool _lastViewIsStatic;
+  std::vector<Cesium3DTilesSelection::ViewState> _lastViews;
+  Cesium3DTilesSelection::TilesetOptions _lastViewOptions;
+  std::vector<CesiumUtility::Credit> _lastViewCredits;
+
+  // The DebugColorMode that the rendered tiles were last tinted with.
+  ECesiumTileDebugColorMode _appliedDebugColorMode =
+      ECesiumTileDebugColorMode::None;
+
+  // The locations of the cameras in the previous frame, used to estimate their
+  // velocities for PrefetchAlongCameraPath.
+  std::vector<FVector> _lastCameraLocations;
+
+  // The glTF components of the tiles that collide in place of their rendered
+  // descendants, because of PhysicsGeometricError.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> _hiddenCollisionGltfs;
+
+  // Whether some primitives were kept from casting shadows by
+  // ShadowCastingDistance, so they must cast them again when it's cleared.
+  bool _shadowCastingLimited = false;
+
+  // The gaze direction set with SetGazeDirection, or zero if there is none.
+  FVector _gazeDirection = FVector::ZeroVector;
+
+  // How far the cameras with lower PriorityWeights have been filled in toward
+  // their full level of detail, from 0.0 to 1.0.
+  float _lowPriorityCameraDetail = 0.0f;
+
+  // Whether the tile selection is frozen by FreezeSelection, and whether it's
+  // frozen after the next view update, which trims the cached tiles.
+  bool _selectionFrozen = false;
+  bool _freezePending = false;
+
+  // Whether the tileset is drawn as an impostor rather than selecting tiles,
+  // and whether its tiles are hidden behind the ImpostorComponent.
+  bool _impostorActive = false;
+  bool _impostorHidesTiles = false;
+
+  // The interest points added with AddInterestPoint, by their IDs.
+  TMap<int32, FCesiumInterestPoint> _interestPoints;
+  int32 _nextInterestPointId = 0;
+
+  // A region added with WatchRegion.
+  struct WatchedRegion {
+    FBox bounds;
+    float maximumScreenSpaceError;
+  };
+
+  // The regions added with WatchRegion that aren't loaded yet, by their IDs,
+  // and the views of the last update, which their tiles' screen-space errors
+  // are computed for. The views are only kept while regions are watched.
+  TMap<int32, WatchedRegion> _watchedRegions;
+  int32 _nextWatchedRegionId = 0;
+  std::vector<Cesium3DTilesSelection::ViewState> _watchedRegionViews;
+
+  // A query made with SampleHeightMostDetailed. The positions from
+  // batchStart up to batchStart + MaximumHeightSampleCameras are refined
+  // until their heights are stable, and the positions before them are done.
+  struct HeightSampleQuery {
+    TArray<FVector> positions;
+    TArray<bool> sampleSuccess;
+    TArray<double> geometricErrors;
+    FCesiumSampleHeightMostDetailedCallback callback;
+    int32 batchStart = 0;
+    int32 batchUpdates = 0;
+  };
+
+  // The queries made with SampleHeightMostDetailed that aren't answered yet,
+  // in the order they were made. Only the first is being sampled.
+  TArray<HeightSampleQuery> _heightSampleQueries;
+
+  // Adds a tiny camera at each position of the batch of the first height
+  // sample query, which refines the tiles that contain it.
+  void addHeightSampleCameras(std::vector<FCesiumCamera>& cameras);
+
+  // Samples the heights of the batch of the first height sample query from
+  // the tiles shown by the last update, and answers the query once all of
+  // its batches are stable.
+  void updateHeightSampleQueries();
+
+  // Answers every height sample query with no positions sampled.
+  void cancelHeightSampleQueries();
+
+  // A tile loaded or unloaded during an update, which OnTileLoaded or
+  // OnTileUnloaded is called for once the update is complete.
+  struct TileLoadEvent {
+    FBox bounds;
+    float geometricError;
+    bool loaded;
+  };
+  TArray<TileLoadEvent> _pendingTileLoadEvents;
+
+  // Gets the bounds of a tile in Unreal world coordinates.
+  FBox getTileWorldBounds(const Cesium3DTilesSelection::Tile& tile) const;
+
+  // Calls OnTileLoaded and OnTileUnloaded for the tiles loaded and unloaded
+  // by the last update.
+  void broadcastTileLoadEvents();
+
+  // Calls OnRegionLoaded for the watched regions whose tiles are loaded.
+  void
+  updateWatchedRegions(const Cesium3DTilesSelection::ViewUpdateResult& result);
+
+  // The renderer resource preparer of the current cesium-native Tileset,
+  // which is detached from this actor when the Tileset is destroyed.
+  std::shared_ptr<UnrealResourcePreparer> _pResourcePreparer;
+
+  // The request group that the current cesium-native Tileset's requests are
+  // made in.
+  uint64 _requestGroup;
+
+  // The bandwidth stream that the current cesium-native Tileset's requests
+  // are made in.
+  uint64 _bandwidthStream;
+
+  // The accessor that prefetches and records the current cesium-native
+  // Tileset's requests, if EnableWarmStart was set when it was created.
+  std::shared_ptr<CesiumWarmStartAssetAccessor> _pWarmStartAssetAccessor;
+
+  // The excluder that culls tiles behind the globe, which is one of the
+  // current cesium-native Tileset's excluders while EnableHorizonCulling is
+  // set. Created on first use.
+  std::shared_ptr<CesiumHorizonCullingExcluder> _pHorizonCullingExcluder;
+
+  // The primitive components of unloaded tiles, kept to be reused by tiles
+  // loaded later. Created on first use.
+  TUniquePtr<CesiumPrimitiveComponentPool> _pPrimitiveComponentPool;
+
+  // The render data of lightweight primitives created this frame, which is
+  // initialized after the tiles are updated. Created on first use.
+  TUniquePtr<CesiumRenderDataBatch> _pRenderDataBatch;
+
+  // Encodes the FeatureStyle into its texture, if the texture exists.
+  void updateFeatureStyleTexture();
+
+  // Apply the materials and custom depth parameters to the tiles that are
+  // already loaded, rather than loading them again.
+  void updateTileMaterials();
+  void updateTileCustomDepthParameters();
+
+  // Registers the Eye-Dome Lighting settings of the PointCloudShading with the
+  // view extension, or removes them if it's disabled.
+  void updateEyeDomeLighting();
+
+  // The property tables given to UpdateFeaturesMetadata. The description that
+  // tiles are loaded with can't change while they're being loaded in worker
+  // threads, so tiles are given these when they're created instead.
+  std::optional<FCesiumModelMetadataDescription>
+      _updatedModelMetadataDescription;
+
+  // The callbacks of picks requested by PickFromScreenPosition, by the ID of
+  // the pick, whose results haven't been read back yet.
+  TMap<uint64, FCesiumPickCallback> _pendingPicks;
+
+  // Calls the callbacks of the picks whose results have been read back.
+  void resolvePendingPicks();
+
+  UPROPERTY(Transient)
+  UTexture2D* _pFeatureStyleTexture = nullptr;
+
+  // The colors and visibility of the features of a property table, as they're
+  // encoded in its texture.
+  struct FeatureSelection {
+    TArray<FColor> texels;
+    FIntPoint size = FIntPoint::ZeroValue;
+    bool isDirty = false;
+  };
+
+  // The feature selections of property tables, by their names.
+  TMap<FString, FeatureSelection> _featureSelections;
+
+  // The textures of the feature selections, by the names of their property
+  // tables.
+  UPROPERTY(Transient)
+  TMap<FString, UTexture2D*> _featureSelectionTextures;
+
+  // Edits the texels of features of a property table, growing its selection if
+  // needed.
+  void editFeatureSelection(
+      const FString& propertyTableName,
+      const TArray<int64>& featureIDs,
+      TFunctionRef<void(FColor&)> edit);
+
+  // Encodes the feature selections that have changed into their textures.
+  // Loaded tiles are only updated when a texture has to be replaced to grow.
+  void updateFeatureSelectionTextures();
+
+  // The values of the properties queried by FindFeaturesInRange and
+  // FindFeaturesWithValue. Created on first use, from the tiles that are
+  // loaded then, and kept up to date as tiles load and unload after that.
+  CesiumMetadataIndex& getMetadataIndex();
+  TUniquePtr<CesiumMetadataIndex> _pMetadataIndex;
+
+  // How long tiles took to get through each stage of loading. Created on
+  // first use.
+  CesiumTilePipelineHistograms& GetTilePipelineHistograms();
+  TUniquePtr<CesiumTilePipelineHistograms> _pTilePipelineHistograms;
+
+  // Created the first time EnableDetailGovernor is used.
+  TUniquePtr<CesiumDetailGovernor> _pDetailGovernor;
+
+  // The memory held by the Unreal resources of this tileset's loaded tiles,
+  // kept up to date as tiles and raster overlay tiles are loaded and freed.
+  FCesiumTilesetMemoryUsage _memoryUsage;
 
   friend class UnrealResourcePreparer;
   friend class UCesiumGltfPointsComponent;
@@ -0,0 +1,51 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTileExcluder.h"
+#include "CoreMinimal.h"
+#include "CesiumBoxTileExcluder.generated.h"
+
+/**
+ * A tile excluder that excludes the tiles that are entirely outside, or
+ * entirely inside, an oriented box. The test is done in C++ without calling
+ * into Blueprints, so it is cheap even when many tiles are considered.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumBoxTileExcluder : public UCesiumTileExcluder {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The center of the box, in Unreal world coordinates.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FVector Center = FVector(0.0);
+
+  /**
+   * The orientation of the box in the Unreal world.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FRotator Rotation = FRotator(0.0);
+
+  /**
+   * The half-size of the box along each of its axes, in Unreal units.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  FVector Extent = FVector(100000.0);
+
+  /**
+   * Whether to exclude the tiles that are entirely inside the box instead of
+   * the tiles that are entirely outside it.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool ExcludeTilesInside = false;
+
+  virtual void ShouldExcludeTiles(
+      TConstArrayView<FBoxSphereBounds> TileBounds,
+      TBitArray<>& OutExcluded) override;
+};
@@ -56,6 +56,26 @@ public:
   UPROPERTY(BlueprintReadWrite, Category = "Cesium")
   double OverrideAspectRatio = 0.0;
 
+  /**
+   * @brief How much this camera's tiles matter relative to the other cameras'.
+   *
+   * Player cameras have a weight of 1.0. While a tileset has more tiles to
+   * load than it can load at once, cameras with lower weights than the others
+   * load less detail, in proportion to their weights, so that they don't hold
+   * up the tiles of the more important views. They fill in to their full level
+   * of detail once there are load slots to spare.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium", meta = (ClampMin = 0.0))
+  float PriorityWeight = 1.0f;
+
+  /**
+   * @brief Multiplies the Maximum Screen Space Error of the tilesets for this
+   * camera. Values larger than 1.0 load less detail for it, such as for a small
+   * picture-in-picture view, and smaller values load more.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium", meta = (ClampMin = 0.01))
+  double MaximumScreenSpaceErrorMultiplier = 1.0;
+
   /**
    * @brief Construct an uninitialized FCesiumCamera object.
    */
@@ -10,6 +10,7 @@
 #include "CoreMinimal.h"
 #include "Engine/StaticMesh.h"
 #include "GameFramework/Actor.h"
+#include <optional>
 #include <vector>
 
 #include "CesiumCartographicPolygon.generated.h"
@@ -44,6 +45,10 @@ public:
    * Creates and returns a CartographicPolygon object
    * created from the current spline selection.
    *
+   * The polygon is cached, and only created again when the spline's points,
+   * the spline's transform, the given transform, or the georeference have
+   * changed since it was last created.
+   *
    * @param worldToTileset The transformation from Unreal world coordinates to
    * the coordinates of the Cesium3DTileset Actor for which the cartographic
    * polygon is being created.
@@ -51,12 +56,36 @@ public:
   CesiumGeospatial::CartographicPolygon
   CreateCartographicPolygon(const FTransform& worldToTileset) const;
 
+  /**
+   * Gets a number that changes each time CreateCartographicPolygon creates
+   * the polygon again, rather than returning the cached polygon. Overlays
+   * use it to tell which of their polygons have changed since they were last
+   * created.
+   */
+  int64 GetCartographicPolygonRevision() const {
+    return this->_cartographicPolygonRevision;
+  }
+
   // AActor overrides
   virtual void PostLoad() override;
 
+#if WITH_EDITOR
+  virtual void PostEditUndo() override;
+#endif
+
 protected:
   virtual void BeginPlay() override;
 
 private:
   void MakeLinear();
+
+  // The cached polygon, and what it was created from.
+  mutable std::optional<CesiumGeospatial::CartographicPolygon>
+      _cartographicPolygon;
+  mutable uint32 _splineVersion = 0;
+  mutable FTransform _splineTransform;
+  mutable FTransform _worldToTileset;
+  mutable TWeakObjectPtr<const ACesiumGeoreference> _pGeoreference;
+  mutable FMatrix _ecefToUnreal;
+  mutable int64 _cartographicPolygonRevision = 0;
 };
@@ -0,0 +1,119 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include "CesiumClippingVolumeComponent.generated.h"
+
+class ACesiumCartographicPolygon;
+class UMaterialInstanceDynamic;
+class UTexture2D;
+
+/**
+ * An oriented box that clips the tiles of a tileset.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumClippingBox {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The center of the box, in Unreal world coordinates.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FVector Center = FVector(0.0);
+
+  /**
+   * The orientation of the box in the Unreal world.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FRotator Rotation = FRotator(0.0);
+
+  /**
+   * The half-size of the box along each of its axes, in Unreal units.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  FVector Extent = FVector(1000.0);
+};
+
+/**
+ * Clips the tiles of the tileset it is attached to by a set of polygons and
+ * boxes, per pixel on the GPU.
+ *
+ * The volumes are encoded into a small float texture that is given to every
+ * tile material as the `CesiumClippingVolumes` texture parameter. Unlike
+ * clipping with a CesiumPolygonRasterOverlay, this doesn't rasterize anything
+ * per tile or use a raster overlay layer, so the cost of many volumes is only
+ * the shader instructions to test against them.
+ *
+ * The tileset's material must apply the clipping. Add a
+ * `CesiumClippingVolumes` texture parameter whose default is a black texture,
+ * and a Custom node that includes
+ * `/Plugin/CesiumForUnreal/Private/CesiumClippingVolumes.ush` and passes the
+ * result of `CesiumIsClipped` to `clip` or to the opacity mask.
+ *
+ * Polygons clip everything above and below them, and are compared in the
+ * horizontal plane of the Unreal world, so they are meant for areas near the
+ * georeference origin. To also skip loading the tiles that are entirely
+ * clipped, add a CesiumPolygonTileExcluder or CesiumBoxTileExcluder with the
+ * same volumes.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumClippingVolumeComponent
+    : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumClippingVolumeComponent();
+
+  /**
+   * The polygons to clip by.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<ACesiumCartographicPolygon*> Polygons;
+
+  /**
+   * The boxes to clip by.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<FCesiumClippingBox> Boxes;
+
+  /**
+   * Whether to clip everything outside all of the volumes instead of
+   * everything inside any of them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool InvertSelection = false;
+
+  /**
+   * Sets the clipping texture parameter on a tile material.
+   */
+  void ApplyToMaterial(UMaterialInstanceDynamic* pMaterial) const;
+
+  virtual void TickComponent(
+      float DeltaTime,
+      ELevelTick TickType,
+      FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+  virtual void OnRegister() override;
+  virtual void OnUnregister() override;
+
+private:
+  // Encodes the volumes as they are now, and returns whether the encoding
+  // differs from the one in the texture.
+  bool encodeVolumes();
+
+  void updateTexture();
+  void applyToTileset(UTexture2D* pTexture) const;
+
+  TArray<FVector4f> _encodedVolumes;
+  TArray<FVector4f> _encodedVolumesInTexture;
+
+  UPROPERTY(Transient)
+  UTexture2D* _pTexture = nullptr;
+};
@@ -0,0 +1,115 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <gsl/span>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * An asset accessor that asks servers for compressed responses, with the
+ * encodings in "Http Accept Encoding", and decodes the bodies of responses
+ * that arrive compressed on a worker thread.
+ *
+ * Only encodings that can be decoded are requested. gzip is decoded by this
+ * accessor, and other encodings, such as Brotli ("br") and Zstandard
+ * ("zstd"), can be decoded once a project that links a decoder for them
+ * registers it with {@link registerDecoder}.
+ *
+ * The HTTP module decodes the encodings that it supports itself, and fails
+ * responses with ones it doesn't. To receive encodings other than gzip,
+ * disable its decoding with `bAcceptCompressedContent=false` in the
+ * `[HTTP.Curl]` section of Engine.ini, so that their bodies reach this
+ * accessor as they were sent.
+ */
+class CESIUMRUNTIME_API CesiumContentEncodingAssetAccessor
+    : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * A function that decodes the body of a response, returning false if it
+   * isn't validly encoded.
+   */
+  using Decoder = std::function<bool(
+      const gsl::span<const std::byte>& encoded,
+      std::vector<std::byte>& decoded)>;
+
+  /**
+   * @param pAssetAccessor The accessor that performs the requests.
+   * @param acceptEncoding The encodings to ask for, as the value of an
+   * Accept-Encoding header. Encodings that can't be decoded are left out. If
+   * none remain, the Accept-Encoding header is left to the underlying
+   * accessor.
+   */
+  CesiumContentEncodingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::string& acceptEncoding);
+
+  /**
+   * Registers the decoder for a content encoding, replacing any that was
+   * registered before. Encodings are compared case-insensitively. This may
+   * be called from any thread, such as from a project module's
+   * StartupModule.
+   */
+  static void registerDecoder(const std::string& encoding, Decoder&& decoder);
+
+  /**
+   * Determines whether a content encoding can be decoded.
+   */
+  static bool canDecode(const std::string& encoding);
+
+  /**
+   * Removes the encodings that can't be decoded from the value of an
+   * Accept-Encoding header, keeping their quality values.
+   */
+  static std::string filterAcceptEncoding(const std::string& acceptEncoding);
+
+  /**
+   * Decodes a response body with the encodings listed by its
+   * Content-Encoding header, which were applied in the order they're listed.
+   *
+   * @return The decoded body, or std::nullopt if any of the encodings can't
+   * be decoded or the body isn't validly encoded.
+   */
+  static std::optional<std::vector<std::byte>> decode(
+      const std::string& contentEncoding,
+      const gsl::span<const std::byte>& encoded);
+
+  /**
+   * Gets the total number of bytes of encoded response bodies that have been
+   * decoded by every one of these accessors.
+   */
+  static int64_t getTotalEncodedBytes();
+
+  /**
+   * Gets the total number of bytes that the encoded response bodies decoded
+   * by every one of these accessors were decoded to.
+   */
+  static int64_t getTotalDecodedBytes();
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::string _acceptEncoding;
+};
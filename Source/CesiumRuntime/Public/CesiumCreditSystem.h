@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CesiumUtility/CreditSystem.h"
 #include "Components/WidgetComponent.h"
 #include "Engine/Blueprint.h"
 #include "GameFramework/Actor.h"
@@ -10,6 +11,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #if WITH_EDITOR
 #include "IAssetViewport.h"
@@ -18,10 +21,6 @@
 
 #include "CesiumCreditSystem.generated.h"
 
-namespace CesiumUtility {
-class CreditSystem;
-}
-
 /**
  * Manages credits / atttribution for Cesium data sources. These credits
  * are displayed by the corresponding Blueprints class
@@ -86,10 +85,16 @@ private:
   // the underlying cesium-native credit system that is managed by this actor.
   std::shared_ptr<CesiumUtility::CreditSystem> _pCreditSystem;
 
-  size_t _lastCreditsCount;
+  // The credits that were shown last frame and their RTF, in the same order,
+  // so that credits are only rebuilt when the set of credits changes.
+  std::vector<CesiumUtility::Credit> _lastCredits;
+  std::vector<FString> _lastCreditsRtf;
 
-  FString ConvertHtmlToRtf(std::string html);
+  // Converts the HTML of a credit to RTF in a worker thread, then adds it to
+  // _htmlToRtf on the game thread.
+  void ConvertHtmlToRtfAsync(const std::string& html);
   std::unordered_map<std::string, FString> _htmlToRtf;
+  std::unordered_set<std::string> _htmlBeingConverted;
 
 #if WITH_EDITOR
   TWeakPtr<IAssetViewport> _pLastEditorViewport;
@@ -0,0 +1,51 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTileExcluder.h"
+#include "CoreMinimal.h"
+#include "CesiumDistanceTileExcluder.generated.h"
+
+/**
+ * A tile excluder that excludes the tiles that are entirely farther than a
+ * given distance from an actor, or from the first player's camera.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumDistanceTileExcluder
+    : public UCesiumTileExcluder {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The actor to measure distances from. If this is not set, distances are
+   * measured from the camera of the first player controller, and no tiles
+   * are excluded if there is none.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  AActor* Origin = nullptr;
+
+  /**
+   * The distance beyond which tiles are excluded, in Unreal units.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  double MaximumDistance = 1000000.0;
+
+  virtual void ShouldExcludeTiles(
+      TConstArrayView<FBoxSphereBounds> TileBounds,
+      TBitArray<>& OutExcluded) override;
+
+  virtual void PrepareForNewFrame() override;
+
+  /**
+   * Sets the location to measure distances from directly. It is found from
+   * Origin or the player's camera again at the start of the next frame.
+   */
+  void SetOriginLocation(const FVector& Location);
+
+private:
+  TOptional<FVector> _originLocation;
+};
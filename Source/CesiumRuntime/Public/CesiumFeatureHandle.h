@@ -0,0 +1,31 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CesiumFeatureHandle.generated.h"
+
+class USceneComponent;
+
+/**
+ * A feature of a loaded tile, as found by the metadata queries of a
+ * Cesium3DTileset.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumFeatureHandle {
+  GENERATED_BODY()
+
+  /**
+   * The component of the tile that has the feature. The tile's primitives are
+   * attached to it. It's destroyed when the tile is unloaded.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium|Metadata")
+  USceneComponent* Tile = nullptr;
+
+  /**
+   * The ID of the feature, which is its index in the property table.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium|Metadata")
+  int64 FeatureID = -1;
+};
@@ -4,6 +4,8 @@
 
 #include "CesiumGltf/AccessorView.h"
 #include "CesiumGltf/FeatureIdTextureView.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "Containers/UnrealString.h"
 #include "GltfAccessors.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
@@ -30,6 +32,56 @@ enum ECesiumFeatureIdTextureStatus {
   ErrorInvalidTextureAccess,
 };
 
+/**
+ * @brief The feature IDs of every texel of a feature ID texture, decoded from
+ * the channels of its image once, for C++ code that samples many feature IDs
+ * at a time. Sampling it doesn't combine image channels for every sample, the
+ * way the feature ID texture's view does.
+ *
+ * Feature IDs are sampled with nearest filtering, the same way
+ * UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDForUV samples them.
+ * Texture coordinates outside of [0, 1] are sampled from the view, so that
+ * they're wrapped or clamped the same way too.
+ */
+class CESIUMRUNTIME_API FCesiumFeatureIdImage {
+public:
+  /**
+   * @brief Decodes the image of a feature ID texture view. If the view is
+   * invalid, the image is empty and every feature ID is -1.
+   */
+  explicit FCesiumFeatureIdImage(
+      const CesiumGltf::FeatureIdTextureView& FeatureIdTextureView);
+
+  /**
+   * @brief Gets the width of the image, in texels.
+   */
+  int32 GetWidth() const { return this->_width; }
+
+  /**
+   * @brief Gets the height of the image, in texels.
+   */
+  int32 GetHeight() const { return this->_height; }
+
+  /**
+   * @brief Gets the feature ID of the texel at the given texture coordinates.
+   */
+  int64 GetFeatureIDForUV(const FVector2D& UV) const;
+
+  /**
+   * @brief Gets the feature IDs at the given texture coordinates into
+   * OutFeatureIDs, which must have the same number of elements as UVs.
+   */
+  void GetFeatureIDsForUVs(
+      TArrayView<const FVector2D> UVs,
+      TArrayView<int64> OutFeatureIDs) const;
+
+private:
+  CesiumGltf::FeatureIdTextureView _featureIdTextureView;
+  int32 _width;
+  int32 _height;
+  TArray<uint32> _featureIDs;
+};
+
 /**
  * @brief A blueprint-accessible wrapper for a feature ID texture from a glTF
  * primitive. Provides access to per-pixel feature IDs, which can be used with
@@ -81,6 +133,10 @@ private:
   // For backwards compatibility.
   FString _propertyTableName;
 
+  // The image decoded by GetDecodedImage, which copies of this texture share.
+  struct DecodedImage;
+  TSharedPtr<DecodedImage, ESPMode::ThreadSafe> _pDecodedImage;
+
   friend class UCesiumFeatureIdTextureBlueprintLibrary;
 };
 
@@ -193,6 +249,33 @@ public:
       UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture,
       const FVector2D& UV);
 
+  /**
+   * Gets the feature IDs corresponding to the pixels specified by an array of
+   * UV texture coordinates, in the same order. This is much faster than
+   * calling GetFeatureIDForUV for each of them, because the texture's image is
+   * decoded once, when this is first called, and kept for later calls.
+   *
+   * If the feature ID texture is invalid, every feature ID is -1.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Features|FeatureIDTexture")
+  static TArray<int64> GetFeatureIDsForUVs(
+      UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture,
+      const TArray<FVector2D>& UVs);
+
+  /**
+   * Gets the feature IDs of every texel of the feature ID texture, decoded the
+   * first time this is called for the texture or any copy of it, for C++ code
+   * that samples many feature IDs. It may be called from any thread. The
+   * image is freed with the last copy of the texture.
+   *
+   * If the feature ID texture is invalid, this returns nullptr.
+   */
+  static TSharedPtr<const FCesiumFeatureIdImage, ESPMode::ThreadSafe>
+  GetDecodedImage(const FCesiumFeatureIdTexture& FeatureIDTexture);
+
   /**
    * Gets the feature ID associated with the given vertex. The
    * feature ID can be used with a FCesiumPropertyTable to retrieve the
@@ -0,0 +1,95 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Math/Color.h"
+
+#include "CesiumFeatureStyle.generated.h"
+
+/**
+ * A condition of a {@link FCesiumFeatureStyle}. Features whose styled property
+ * value is within the range of the condition are given its color and
+ * visibility.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumFeatureStyleCondition {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The smallest property value that meets this condition.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double Minimum = 0.0;
+
+  /**
+   * The largest property value that meets this condition.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double Maximum = 0.0;
+
+  /**
+   * The color of the features that meet this condition.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FLinearColor Color = FLinearColor::White;
+
+  /**
+   * Whether the features that meet this condition are shown.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool bShow = true;
+};
+
+/**
+ * A style that colors and hides the features of a tileset based on the value
+ * of one of their properties, like the "conditions" of a 3D Tiles style.
+ *
+ * The style is evaluated on the GPU, from the property table properties that
+ * are encoded by the tileset's CesiumFeaturesMetadata component, by the
+ * "Apply Feature Style" nodes that its "Generate Material" button creates. A
+ * style can be changed at any time without encoding the properties again or
+ * reloading any tiles.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumFeatureStyle {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The name of the property table with the styled property, as it's listed in
+   * the CesiumFeaturesMetadata component.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString PropertyTableName;
+
+  /**
+   * The name of the styled property. It must be one of the encoded properties
+   * of the property table. If it is a vector or array, its first component is
+   * styled. Values are compared as they're encoded, before any offset, scale
+   * or normalization is applied.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString PropertyName;
+
+  /**
+   * The conditions of the style. Each feature is given the color of the first
+   * condition that its property value meets.
+   *
+   * Only the first 16 conditions are used.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<FCesiumFeatureStyleCondition> Conditions;
+
+  /**
+   * The color of the features that don't meet any condition.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FLinearColor DefaultColor = FLinearColor::White;
+
+  /**
+   * Whether the features that don't meet any condition are shown.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool bDefaultShow = true;
+};
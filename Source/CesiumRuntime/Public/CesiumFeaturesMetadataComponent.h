@@ -11,6 +11,7 @@
 #include "Misc/Guid.h"
 
 #if WITH_EDITOR
+#include "Containers/Ticker.h"
 #include "Materials/MaterialFunctionMaterialLayer.h"
 #endif
 
@@ -296,6 +297,12 @@ public:
    * extension.
    */
   FCesiumModelMetadataDescription ModelMetadata;
+
+  /**
+   * @brief Whether to free the binary data of the property table properties
+   * that aren't encoded for the material as each glTF loads.
+   */
+  bool DiscardUnencodedPropertyTableData = false;
 };
 
 /**
@@ -320,6 +327,10 @@ public:
    *
    * Warning: Using Auto Fill may populate the description with a large amount
    * of metadata. Make sure to delete the properties that aren't relevant.
+   *
+   * The tiles are scanned a few milliseconds at a time, over as many frames as
+   * it takes, so that the editor stays responsive for large tilesets. The
+   * description is updated once all of them have been scanned.
    */
   UFUNCTION(CallInEditor, Category = "Cesium")
   void AutoFill();
@@ -330,9 +341,19 @@ public:
    * nodes to access the metadata will be added to TargetMaterialLayer if it
    * exists. Otherwise a new material layer will be created in the /Content/
    * folder and TargetMaterialLayer will be set to the new material layer.
+   *
+   * If TargetMaterialLayer already has the nodes that would be generated, it's
+   * left as it is, so that it doesn't need to be compiled again.
    */
   UFUNCTION(CallInEditor, Category = "Cesium")
   void GenerateMaterial();
+
+  /**
+   * Applies changes to the property tables to the tiles of the tileset that
+   * are already loaded. See ACesium3DTileset::UpdateFeaturesMetadata.
+   */
+  virtual void PostEditChangeChainProperty(
+      FPropertyChangedChainEvent& PropertyChangedChainEvent) override;
 #endif
 
 #if WITH_EDITORONLY_DATA
@@ -395,4 +416,30 @@ public:
       Category = "Cesium|Model Metadata",
       Meta = (TitleProperty = "Name"))
   TArray<FCesiumPropertyTextureDescription> PropertyTextures;
+
+  /**
+   * Whether to free the binary data of the property table properties that
+   * aren't encoded for the material, as each tile loads.
+   *
+   * This saves memory for tilesets with a lot of metadata when only some of it
+   * is used for styling. But the discarded properties can't be read from
+   * Blueprints or by picking, and changing which properties are encoded
+   * reloads the tileset instead of updating the loaded tiles.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium|Model Metadata")
+  bool DiscardUnencodedPropertyTableData = false;
+
+private:
+#if WITH_EDITOR
+  // The tiles that AutoFill is scanning, and the description it's filling.
+  struct AutoFillScan;
+
+  // Scans tiles for AutoFill for a few milliseconds, and applies the
+  // description once every tile has been scanned. Returns whether there are
+  // more tiles to scan.
+  bool tickAutoFill(float DeltaTime);
+
+  TSharedPtr<AutoFillScan> _pAutoFillScan;
+  FTSTicker::FDelegateHandle _autoFillTickerHandle;
+#endif
 };
@@ -5,8 +5,10 @@
 #include "CesiumGlobeAnchoredActorComponent.h"
 #include "CesiumFlyToComponent.generated.h"
 
+class ACesiumCameraManager;
 class UCurveFloat;
 class UCesiumGlobeAnchorComponent;
+struct FCesiumCamera;
 
 /**
  * The delegate for when the Actor finishes flying.
@@ -121,6 +123,50 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   ECesiumFlyToRotation RotationToUse = ECesiumFlyToRotation::Actor;
 
+  /**
+   * The number of evenly-timed points to sample the flight path at when a
+   * flight begins, or 0 to evaluate the flight path every frame.
+   *
+   * Evaluating the flight path reads the progress and height curves and
+   * maps a point to the ellipsoid. With sampling, that is only done once
+   * for each sample, and each frame interpolates smoothly between the
+   * nearest samples instead, which is much cheaper when many Actors are
+   * flying at once. Around 64 samples are enough for most flights.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0, ClampMax = 1024))
+  int32 FlightPathSamples = 0;
+
+  /**
+   * Whether to start loading tiles for the destination, and for points along
+   * the way, as soon as a flight begins.
+   *
+   * When this is true, a camera is added to the Camera Manager of every
+   * tileset in the world for the destination view and for each of the
+   * PreloadFlightPathSteps views along the flight, so that their tiles are
+   * requested right away rather than once the Actor gets there. Each camera
+   * is removed once the flight passes it.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool PreloadTilesAlongFlight = false;
+
+  /**
+   * The number of evenly-timed views along the flight, not counting the
+   * destination, to load tiles for when PreloadTilesAlongFlight is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta =
+          (EditCondition = "PreloadTilesAlongFlight",
+           ClampMin = 0,
+           ClampMax = 16))
+  int32 PreloadFlightPathSteps = 2;
+
   /**
    * A delegate that will be called when the Actor finishes flying.
    *
@@ -203,10 +249,31 @@ protected:
       ELevelTick TickType,
       FActorComponentTickFunction* ThisTickFunction) override;
 
+  virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
 private:
   FQuat GetCurrentRotationEastSouthUp();
   void SetCurrentRotationEastSouthUp(const FQuat& EastSouthUpRotation);
 
+  float computeFlyPercentage(float flyTime) const;
+  FVector computePositionEarthCenteredEarthFixed(float flyPercentage) const;
+  void sampleFlightPath();
+  float evaluateSampledFlightPath(float flyTime, FVector& positionEcef) const;
+  bool computePreloadCamera(float flyPercentage, FCesiumCamera& camera);
+  void addPreloadCameras();
+  void updatePreloadCameras(float flyPercentage);
+  void removePreloadCameras();
+
+  struct PreloadCamera {
+    TWeakObjectPtr<ACesiumCameraManager> pCameraManager;
+    int32 cameraId;
+    float flyPercentage;
+  };
+
+  // The cameras added to Camera Managers for PreloadTilesAlongFlight, for
+  // views the flight hasn't reached yet.
+  TArray<PreloadCamera> _preloadCameras;
+
   bool _flightInProgress = false;
   bool _canInterruptByMoving;
   FVector _destinationEcef;
@@ -220,4 +287,10 @@ private:
   FVector _sourceDirection;
   double _maxHeight;
   FVector _previousPositionEcef;
+
+  // The positions and fly percentages of the flight path at FlightPathSamples
+  // evenly-timed points, from the start of the flight to its end, or empty if
+  // the flight path isn't sampled.
+  TArray<FVector> _sampledPositionsEcef;
+  TArray<float> _sampledFlyPercentages;
 };
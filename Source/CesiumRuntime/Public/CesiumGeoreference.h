@@ -10,6 +10,7 @@
 #include "CesiumGeoreference.generated.h"
 
 class APlayerCameraManager;
+class CesiumGlobeAnchorBatch;
 class FLevelCollectionModel;
 class UCesiumSubLevelSwitcherComponent;
 
@@ -461,6 +462,58 @@ public:
   FVector TransformUnrealPositionToEarthCenteredEarthFixed(
       const FVector& UnrealPosition) const;
 
+  /**
+   * Transforms many longitude/latitude/height positions into Unreal
+   * coordinates at once. This is equivalent to calling
+   * TransformLongitudeLatitudeHeightPositionToUnreal for each position, but is
+   * much faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "UnrealPositions"))
+  TArray<FVector> TransformLongitudeLatitudeHeightPositionsToUnreal(
+      const TArray<FVector>& LongitudeLatitudeHeights) const;
+
+  /**
+   * Transforms many positions in Unreal coordinates into
+   * longitude/latitude/height at once. This is equivalent to calling
+   * TransformUnrealPositionToLongitudeLatitudeHeight for each position, but is
+   * faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "LongitudeLatitudeHeights"))
+  TArray<FVector> TransformUnrealPositionsToLongitudeLatitudeHeight(
+      const TArray<FVector>& UnrealPositions) const;
+
+  /**
+   * Transforms many positions in Earth-Centered, Earth-Fixed (ECEF)
+   * coordinates into Unreal coordinates at once. This is equivalent to calling
+   * TransformEarthCenteredEarthFixedPositionToUnreal for each position, but is
+   * much faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "UnrealPositions"))
+  TArray<FVector> TransformEarthCenteredEarthFixedPositionsToUnreal(
+      const TArray<FVector>& EarthCenteredEarthFixedPositions) const;
+
+  /**
+   * Transforms many positions in Unreal coordinates into Earth-Centered,
+   * Earth-Fixed (ECEF) coordinates at once. This is equivalent to calling
+   * TransformUnrealPositionToEarthCenteredEarthFixed for each position, but is
+   * much faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "EarthCenteredEarthFixedPositions"))
+  TArray<FVector> TransformUnrealPositionsToEarthCenteredEarthFixed(
+      const TArray<FVector>& UnrealPositions) const;
+
   /**
    * Transforms a direction vector in Earth-Centered, Earth-Fixed (ECEF)
    * coordinates into Unreal coordinates. The resulting direction vector should
@@ -491,6 +544,32 @@ public:
   FVector TransformUnrealDirectionToEarthCenteredEarthFixed(
       const FVector& UnrealDirection) const;
 
+  /**
+   * Transforms many direction vectors in Earth-Centered, Earth-Fixed (ECEF)
+   * coordinates into Unreal coordinates at once. This is equivalent to calling
+   * TransformEarthCenteredEarthFixedDirectionToUnreal for each direction, but
+   * is much faster for large numbers of directions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "UnrealDirections"))
+  TArray<FVector> TransformEarthCenteredEarthFixedDirectionsToUnreal(
+      const TArray<FVector>& EarthCenteredEarthFixedDirections) const;
+
+  /**
+   * Transforms many direction vectors in Unreal coordinates into
+   * Earth-Centered, Earth-Fixed (ECEF) coordinates at once. This is equivalent
+   * to calling TransformUnrealDirectionToEarthCenteredEarthFixed for each
+   * direction, but is much faster for large numbers of directions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium",
+      meta = (ReturnDisplayName = "EarthCenteredEarthFixedDirections"))
+  TArray<FVector> TransformUnrealDirectionsToEarthCenteredEarthFixed(
+      const TArray<FVector>& UnrealDirections) const;
+
   /**
    * Given a Rotator that transforms an object into the Unreal coordinate
    * system, returns a new Rotator that transforms that object into an
@@ -784,12 +863,22 @@ private:
 
 public:
   ACesiumGeoreference();
+  virtual ~ACesiumGeoreference();
 
   const CesiumGeospatial::LocalHorizontalCoordinateSystem&
   GetCoordinateSystem() const noexcept {
     return this->_coordinateSystem;
   }
 
+  /**
+   * @brief Gets the globe anchors that use this georeference.
+   *
+   * This method is not supposed to be called by clients. Globe anchor
+   * components add and remove themselves here, and are updated together
+   * whenever this georeference is updated.
+   */
+  CesiumGlobeAnchorBatch& GetGlobeAnchorBatch();
+
 private:
   /**
    * Recomputes all world georeference transforms.
@@ -805,6 +894,10 @@ private:
   CesiumGeospatial::LocalHorizontalCoordinateSystem _coordinateSystem{
       glm::dmat4(1.0)};
 
+  // The globe anchors that are updated when the coordinate system changes.
+  // Created when the first anchor is added.
+  TUniquePtr<CesiumGlobeAnchorBatch> _pGlobeAnchorBatch;
+
   /**
    * Updates _geoTransforms based on the current ellipsoid and center, and
    * returns the old transforms.
@@ -581,14 +581,20 @@ private:
       ETeleportType Teleport);
 
   /**
-   * Called when the Component switches to a new Georeference Actor or the
-   * existing Georeference is given a new origin Longitude, Latitude, or
-   * Height. The Actor's position and orientation are recomputed from the
-   * Component's globe (ECEF) position and orientation.
+   * Called when the existing Georeference is given a new origin Longitude,
+   * Latitude, or Height, with the new Actor relative transform that was
+   * computed from the Component's globe (ECEF) position and orientation.
    */
-  UFUNCTION()
-  void _onGeoreferenceChanged();
+  void _applyRelativeTransformFromGeoreference(
+      const FTransform& relativeTransform);
+
+  /**
+   * The index of this Component in the CesiumGlobeAnchorBatch of the resolved
+   * Georeference, or INDEX_NONE if it is not in one.
+   */
+  int32 _globeAnchorBatchIndex = INDEX_NONE;
 
   friend class FCesiumGlobeAnchorCustomization;
+  friend class CesiumGlobeAnchorBatch;
 #pragma endregion
 };
@@ -0,0 +1,73 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "Math/Vector.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "CesiumInterestPoint.generated.h"
+
+/**
+ * @brief A place that a {@link Cesium3DTileset} loads tiles around whether or
+ * not any camera is looking at it, such as around a vehicle, a mission
+ * objective, or where the player is about to be teleported to.
+ *
+ * Tiles around an interest point are selected as if it were surrounded by
+ * cameras looking in every direction, so they're loaded and refined along with
+ * the tiles in view.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumInterestPoint {
+  GENERATED_USTRUCT_BODY()
+
+public:
+  /**
+   * @brief The Unreal world location of the interest point, or its offset from
+   * the location of Actor when there is one.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FVector Location = FVector::ZeroVector;
+
+  /**
+   * @brief An actor that the interest point moves with. When the actor is
+   * destroyed, the interest point no longer loads any tiles.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TWeakObjectPtr<AActor> Actor;
+
+  /**
+   * @brief The distance, in Unreal units, within which tiles are refined to
+   * MaximumGeometricError.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  double Radius = 10000.0;
+
+  /**
+   * @brief The level of detail around the interest point, relative to that of
+   * a player camera at the same place. Larger values load more detail.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  float Weight = 1.0f;
+
+  /**
+   * @brief The largest geometric error, in meters, of the tiles within Radius
+   * of the interest point, so that they're refined to at least this level of
+   * detail whatever the Weight. When this is 0, only the Weight is used.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  double MaximumGeometricError = 0.0;
+};
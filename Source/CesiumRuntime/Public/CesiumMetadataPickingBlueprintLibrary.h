@@ -40,6 +40,48 @@ public:
       int64 GltfTexCoordSetIndex,
       FVector2D& UV);
 
+  /**
+   * Compute the UV coordinates for each of the given line trace hits, as
+   * FindUVFromHit does. This is faster than calling FindUVFromHit for each
+   * hit, especially when many of the hits are on the same primitive.
+   *
+   * If CacheTriangles is true, the positions and texture coordinates of every
+   * face of a primitive are gathered the first time it is hit, and reused for
+   * later hits on it, including in later calls. This takes additional memory
+   * for each primitive that is hit, but makes each hit much cheaper to
+   * compute.
+   *
+   * Returns whether the UV coordinates could be computed for each hit. The UV
+   * coordinates of hits for which they could not be computed are zero.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|Picking")
+  static TArray<bool> FindUVsFromHits(
+      const TArray<FHitResult>& Hits,
+      int64 GltfTexCoordSetIndex,
+      TArray<FVector2D>& UVs,
+      bool CacheTriangles = true);
+
+  /**
+   * Finds the glTF mesh and primitive that a line trace hit, assuming it has
+   * hit a glTF primitive component. The indices are those of the tile's glTF
+   * as it was loaded, so they are found even if the tileset's Merge Primitives
+   * option merged the primitive with others.
+   *
+   * Returns false if the component is not a Cesium glTF primitive component,
+   * or if the hit's face index is out-of-bounds for a merged primitive.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|Picking")
+  static bool FindSourcePrimitiveFromHit(
+      const FHitResult& Hit,
+      int64& MeshIndex,
+      int64& PrimitiveIndex);
+
   /**
    * Gets the property table values from a given line trace hit, assuming
    * that it has hit a feature of a glTF primitive component.
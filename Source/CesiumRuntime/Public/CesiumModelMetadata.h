@@ -28,16 +28,40 @@ struct CESIUMRUNTIME_API FCesiumModelMetadata {
 public:
   FCesiumModelMetadata() {}
 
+  /**
+   * Constructs the model metadata from a glTF's EXT_structural_metadata. The
+   * property tables aren't created until they're first accessed, because
+   * creating a view of every property of every table is costly for tiles with
+   * a lot of metadata, and most tiles' metadata is never queried. The model
+   * must outlive this metadata.
+   */
   FCesiumModelMetadata(
       const CesiumGltf::Model& InModel,
       const CesiumGltf::ExtensionModelExtStructuralMetadata& Metadata);
 
 private:
-  TArray<FCesiumPropertyTable> _propertyTables;
+  /**
+   * Gets the property tables, creating them on first access. This is not
+   * thread-safe, but the metadata is only accessed by one thread at a time:
+   * the load thread while the tile is encoded, and the game thread after.
+   */
+  const TArray<FCesiumPropertyTable>& getPropertyTables() const;
+
+  /**
+   * Points the metadata to where the glTF was moved to, if the property
+   * tables haven't been created from it yet.
+   */
+  void setModel(const CesiumGltf::Model& InModel);
+
+  const CesiumGltf::Model* _pModel = nullptr;
+  const CesiumGltf::ExtensionModelExtStructuralMetadata* _pMetadata = nullptr;
+  mutable TArray<FCesiumPropertyTable> _propertyTables;
+  mutable bool _propertyTablesCreated = true;
   TArray<FCesiumPropertyTexture> _propertyTextures;
   // TODO: property attributes
 
   friend class UCesiumModelMetadataBlueprintLibrary;
+  friend class UCesiumGltfComponent;
 };
 
 UCLASS()
@@ -40,6 +40,28 @@ enum class ECesiumOriginShiftMode : uint8 {
    * objects _will_ be moved when the origin is shifted.
    */
   ChangeCesiumGeoreference,
+
+  /**
+   * The origin of the Unreal world will be changed as the Actor moves in order
+   * to maintain small, precise coordinate values near the Actor. The origin of
+   * the CesiumGeoreference does not change, so the globe's local "up"
+   * direction is not kept aligned with the +Z axis.
+   *
+   * This uses Unreal Engine's world origin rebasing, which translates every
+   * Actor, and the renderer and physics scenes, by the change in origin in a
+   * single pass. This is much cheaper than ChangeCesiumGeoreference with large
+   * tilesets or many globe anchored Actors, because Cesium3DTileset instances
+   * don't need to recompute the transforms of their tiles, and objects that are
+   * not anchored to the globe don't appear to move.
+   *
+   * Unreal world positions are then relative to the world's OriginLocation.
+   * Globe anchored Actors that aren't attached to another Actor account for
+   * this automatically, but other code that converts Unreal world positions
+   * with the CesiumGeoreference needs to add the OriginLocation first.
+   *
+   * This mode only has an effect in game worlds, such as in Play-in-Editor.
+   */
+  ChangeWorldOriginLocation,
 };
 
 /**
@@ -97,6 +119,27 @@ private:
       Category = "Cesium",
       Meta = (AllowPrivateAccess))
   double Distance = 0.0;
+
+  /**
+   * How far ahead, in seconds, to predict the position of the Actor to which
+   * this component is attached from its current velocity. The sub-level that
+   * the predicted position is in, if it isn't the sub-level the Actor is in
+   * now, is loaded in the background so that it can be shown as soon as the
+   * Actor reaches it.
+   *
+   * The georeference's CesiumSubLevelSwitcherComponent must allow more than
+   * one loaded sub-level with its MaximumLoadedSubLevels property for the
+   * predicted sub-level to be loaded while another is active. When the value
+   * of this property is 0.0, no sub-levels are preloaded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      BlueprintGetter = GetSubLevelPreloadTime,
+      BlueprintSetter = SetSubLevelPreloadTime,
+      Category = "Cesium",
+      Meta = (AllowPrivateAccess, ClampMin = 0.0, Units = "s"))
+  double SubLevelPreloadTime = 0.0;
 #pragma endregion
 
 #pragma region Property Accessors
@@ -138,6 +181,22 @@ public:
    */
   UFUNCTION(BlueprintSetter)
   void SetDistance(double NewDistance);
+
+  /**
+   * Gets how far ahead, in seconds, to predict the position of the Actor to
+   * which this component is attached in order to preload the sub-level it's
+   * heading into.
+   */
+  UFUNCTION(BlueprintGetter)
+  double GetSubLevelPreloadTime() const;
+
+  /**
+   * Sets how far ahead, in seconds, to predict the position of the Actor to
+   * which this component is attached in order to preload the sub-level it's
+   * heading into.
+   */
+  UFUNCTION(BlueprintSetter)
+  void SetSubLevelPreloadTime(double NewSubLevelPreloadTime);
 #pragma endregion
 
 public:
@@ -148,4 +207,9 @@ protected:
       float DeltaTime,
       ELevelTick TickType,
       FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+  // The position of the Actor on the previous tick, to estimate its velocity.
+  FVector _previousEcef = FVector::ZeroVector;
+  bool _hasPreviousEcef = false;
 };
@@ -59,12 +59,119 @@ struct CESIUMRUNTIME_API FCesiumPointCloudShading {
       meta = (ClampMin = 0.0))
   float BaseResolution = 0.0f;
 
+  /**
+   * The classifications of the points to hide, such as 2 for ground or 7 for
+   * noise in the ASPRS LAS classes. A point's classification is read from its
+   * _CLASSIFICATION attribute, so points without one are never hidden by
+   * classification.
+   *
+   * Points are filtered on the GPU, so this can be changed at any time without
+   * reloading the tileset. Filtering requires a platform that supports manual
+   * vertex fetch.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<uint8> HiddenClassifications;
+
+  /**
+   * Whether to hide the points whose _INTENSITY attribute is below
+   * MinimumIntensity or above MaximumIntensity. Points without an intensity
+   * are never hidden by it.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool FilterByIntensity = false;
+
+  /**
+   * The smallest intensity of the points to show when FilterByIntensity is
+   * enabled, in the units that the intensities are stored in.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (EditCondition = "FilterByIntensity"))
+  float MinimumIntensity = 0.0f;
+
+  /**
+   * The largest intensity of the points to show when FilterByIntensity is
+   * enabled, in the units that the intensities are stored in.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (EditCondition = "FilterByIntensity"))
+  float MaximumIntensity = 65535.0f;
+
+  /**
+   * Whether to shade the points with Eye-Dome Lighting, a screen-space pass
+   * that darkens each point by how far it lies behind its neighbors on the
+   * screen. This makes the shape of dense point clouds readable with an unlit
+   * material, which is much cheaper to draw per point than a lit one.
+   *
+   * The points are drawn into the CustomDepth pass with the
+   * EyeDomeLightingStencilValue, which the pass uses to find them, so this
+   * requires the "Custom Depth-Stencil Pass" project setting to be "Enabled
+   * with Stencil" (r.CustomDepth 3).
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool EyeDomeLighting = false;
+
+  /**
+   * How strongly Eye-Dome Lighting darkens the points that lie behind their
+   * neighbors.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0, EditCondition = "EyeDomeLighting"))
+  float EyeDomeLightingStrength = 1.0f;
+
+  /**
+   * The distance in pixels to the neighbors that Eye-Dome Lighting compares
+   * each point to. Larger values give thicker outlines.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0, EditCondition = "EyeDomeLighting"))
+  float EyeDomeLightingRadius = 1.0f;
+
+  /**
+   * The value that the points write to the custom stencil buffer when
+   * Eye-Dome Lighting is enabled, in place of the tileset's
+   * CustomDepthStencilValue. Only the pixels with this value are shaded, so it
+   * should not be used by anything else in the level.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta =
+          (ClampMin = 1,
+           ClampMax = 255,
+           EditCondition = "EyeDomeLighting"))
+  int32 EyeDomeLightingStencilValue = 255;
+
   bool
   operator==(const FCesiumPointCloudShading& OtherPointCloudShading) const {
     return Attenuation == OtherPointCloudShading.Attenuation &&
            GeometricErrorScale == OtherPointCloudShading.GeometricErrorScale &&
            MaximumAttenuation == OtherPointCloudShading.MaximumAttenuation &&
-           BaseResolution == OtherPointCloudShading.BaseResolution;
+           BaseResolution == OtherPointCloudShading.BaseResolution &&
+           HiddenClassifications ==
+               OtherPointCloudShading.HiddenClassifications &&
+           FilterByIntensity == OtherPointCloudShading.FilterByIntensity &&
+           MinimumIntensity == OtherPointCloudShading.MinimumIntensity &&
+           MaximumIntensity == OtherPointCloudShading.MaximumIntensity &&
+           EyeDomeLighting == OtherPointCloudShading.EyeDomeLighting &&
+           EyeDomeLightingStrength ==
+               OtherPointCloudShading.EyeDomeLightingStrength &&
+           EyeDomeLightingRadius ==
+               OtherPointCloudShading.EyeDomeLightingRadius &&
+           EyeDomeLightingStencilValue ==
+               OtherPointCloudShading.EyeDomeLightingStencilValue;
   }
 
   bool
@@ -7,15 +7,19 @@
 #include "CesiumPolygonRasterOverlay.generated.h"
 
 class ACesiumCartographicPolygon;
+struct CesiumPreparedPolygon;
 
 namespace Cesium3DTilesSelection {
-class RasterizedPolygonsTileExcluder;
+class ITileExcluder;
 }
 
 /**
  * A raster overlay that rasterizes polygons and drapes them over the tileset.
  * This is useful for clipping out parts of a tileset, for adding a water effect
  * in an area, and for many other purposes.
+ *
+ * When the overlay is refreshed, only the polygons that changed since it was
+ * last created are converted and indexed again.
  */
 UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
 class CESIUMRUNTIME_API UCesiumPolygonRasterOverlay
@@ -66,6 +70,16 @@ protected:
       CesiumRasterOverlays::RasterOverlay* pOverlay) override;
 
 private:
-  std::shared_ptr<Cesium3DTilesSelection::RasterizedPolygonsTileExcluder>
-      _pExcluder;
+  std::shared_ptr<Cesium3DTilesSelection::ITileExcluder> _pExcluder;
+
+  struct PreparedPolygon {
+    int64 revision;
+    std::shared_ptr<const CesiumPreparedPolygon> pPolygon;
+  };
+
+  // The polygons that the overlay was last created with, by the revision of
+  // the actor's cartographic polygon, so that an overlay that is created
+  // again after one polygon changed only indexes that polygon again.
+  TMap<TWeakObjectPtr<const ACesiumCartographicPolygon>, PreparedPolygon>
+      _preparedPolygons;
 };
@@ -0,0 +1,53 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTileExcluder.h"
+#include "CoreMinimal.h"
+#include "CesiumPolygonTileExcluder.generated.h"
+
+class ACesiumCartographicPolygon;
+
+/**
+ * A tile excluder that excludes the tiles whose footprint is entirely inside
+ * any of a set of polygons, or, if the selection is inverted, entirely
+ * outside all of them. Footprints are compared in the horizontal plane of the
+ * Unreal world, so this is meant for polygons near the georeference origin.
+ *
+ * Unlike excluding tiles with a CesiumPolygonRasterOverlay, this doesn't
+ * rasterize the polygons or affect the tiles that are kept.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumPolygonTileExcluder
+    : public UCesiumTileExcluder {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The polygons to exclude tiles by.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<ACesiumCartographicPolygon*> Polygons;
+
+  /**
+   * Whether to exclude the tiles that are entirely outside all of the
+   * polygons instead of the tiles that are entirely inside any of them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool InvertSelection = false;
+
+  virtual void ShouldExcludeTiles(
+      TConstArrayView<FBoxSphereBounds> TileBounds,
+      TBitArray<>& OutExcluded) override;
+
+  virtual void PrepareForNewFrame() override;
+
+  /**
+   * Sets the vertices of the polygons in the Unreal world XY plane directly.
+   * They are read from Polygons again at the start of the next frame.
+   */
+  void SetFootprints(TArray<TArray<FVector2D>>&& Footprints);
+
+private:
+  TArray<TArray<FVector2D>> _footprints;
+};
@@ -0,0 +1,115 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumMetadataValue.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+struct FCesiumPropertyTableProperty;
+struct FHitResult;
+class UCesiumGltfPrimitiveComponent;
+
+/**
+ * Gets the values of a fixed set of property table properties from line trace
+ * hits. This is meant for lookups that happen every frame, such as hover
+ * tooltips, where
+ * UCesiumMetadataPickingBlueprintLibrary::GetPropertyTableValuesFromHit would
+ * resolve the property table and all of its properties and build a new map on
+ * every hit.
+ *
+ * The first time a primitive is hit, its property table and the requested
+ * properties are resolved and cached for as long as the primitive exists.
+ * Properties are then referred to by handle, which is the index of the
+ * property's name in the array given to the constructor.
+ *
+ * A picker must only be used from the game thread. Call Reset if the metadata
+ * of a model that has already been hit changes.
+ */
+class CESIUMRUNTIME_API FCesiumPropertyTablePicker {
+public:
+  /**
+   * Constructs a picker for the given properties.
+   *
+   * @param PropertyNames The names of the properties to get values for.
+   * @param FeatureIDSetIndex The index of the feature ID set in the hit
+   * primitive's CesiumPrimitiveFeatures, as in
+   * GetPropertyTableValuesFromHit.
+   */
+  FCesiumPropertyTablePicker(
+      const TArray<FString>& PropertyNames,
+      int64 FeatureIDSetIndex = 0);
+
+  /**
+   * Gets the number of properties, which is also the number of handles.
+   */
+  int32 Num() const { return this->_propertyNames.Num(); }
+
+  /**
+   * Gets the handle of the property with the given name, or INDEX_NONE if it
+   * was not given to the constructor.
+   */
+  int32 GetPropertyHandle(const FString& PropertyName) const {
+    return this->_propertyNames.Find(PropertyName);
+  }
+
+  /**
+   * Gets the feature ID of the given hit in the picker's feature ID set, or -1
+   * if the hit is not on a feature of a Cesium glTF primitive component.
+   */
+  int64 GetFeatureIDFromHit(const FHitResult& Hit) const;
+
+  /**
+   * Gets the value of a single property for the given hit. Returns an empty
+   * value if the hit is not on a feature with a property table, or if the
+   * property is invalid or does not exist in the table.
+   */
+  FCesiumMetadataValue GetValueFromHit(const FHitResult& Hit, int32 Handle);
+
+  /**
+   * Gets the values of all of the properties for the given hit, indexed by
+   * handle. Values that cannot be found are left empty, as in
+   * GetValueFromHit.
+   *
+   * @param Hit The line trace hit.
+   * @param Values The values, which must have one element per property.
+   * @return Whether the hit is on a feature with a property table.
+   */
+  bool GetValuesFromHit(
+      const FHitResult& Hit,
+      TArrayView<FCesiumMetadataValue> Values);
+
+  /**
+   * Discards the properties resolved for each primitive.
+   */
+  void Reset();
+
+private:
+  struct ResolvedProperty {
+    const FCesiumPropertyTableProperty* pProperty;
+    // Whether the property has no data, only a default value.
+    bool useDefaultValue;
+  };
+
+  struct ResolvedPrimitive {
+    bool hasPropertyTable = false;
+    // The resolved properties, indexed by handle.
+    TArray<ResolvedProperty> properties;
+  };
+
+  const ResolvedPrimitive*
+  findOrResolve(const UCesiumGltfPrimitiveComponent& primitive);
+
+  TArray<FString> _propertyNames;
+  int64 _featureIDSetIndex;
+
+  // The properties resolved for each primitive that has been hit.
+  TMap<TWeakObjectPtr<const UCesiumGltfPrimitiveComponent>, ResolvedPrimitive>
+      _primitives;
+
+  // The number of primitives at which to remove the destroyed ones.
+  int32 _pruneThreshold = 64;
+};
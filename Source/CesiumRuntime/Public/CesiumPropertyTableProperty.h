@@ -7,6 +7,7 @@
 #include "CesiumMetadataValue.h"
 #include "CesiumMetadataValueType.h"
 #include "CesiumPropertyArray.h"
+#include "Containers/ArrayView.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/ObjectMacros.h"
 #include <any>
@@ -108,8 +109,111 @@ private:
   bool _normalized;
 
   friend class UCesiumPropertyTablePropertyBlueprintLibrary;
+  template <typename T> friend class TCesiumPropertyColumn;
 };
 
+/**
+ * A typed accessor for the values of a FCesiumPropertyTableProperty, for C++
+ * code that reads many values at once. The property's type is resolved once
+ * when the column is constructed, so reading values doesn't repeat the type
+ * dispatch that each UCesiumPropertyTablePropertyBlueprintLibrary call does.
+ *
+ * Values are converted to T by the same rules as the corresponding Blueprint
+ * library function; for example, a TCesiumPropertyColumn<int32> returns the
+ * same values as GetInteger. T may be bool, uint8, int32, int64, float, double,
+ * FIntPoint, FVector2D, FIntVector, FVector3f, FVector, FVector4, FMatrix, or
+ * FString.
+ *
+ * The column refers to the property it was constructed from, so the property
+ * must outlive it and must not be moved or modified while it's in use.
+ */
+template <typename T> class CESIUMRUNTIME_API TCesiumPropertyColumn {
+public:
+  /**
+   * Constructs a column for the given property. If the property is invalid
+   * in any way, the column has no values.
+   */
+  explicit TCesiumPropertyColumn(const FCesiumPropertyTableProperty& Property);
+
+  /**
+   * Gets the number of values in the column, which is the number of features
+   * in the property table.
+   */
+  int64 Num() const { return this->_size; }
+
+  /**
+   * Gets the value for the given feature, or the default value if the feature
+   * ID is out of range or the value can't be converted to T.
+   */
+  T Get(int64 FeatureID, const T& DefaultValue) const;
+
+  /**
+   * Gets the values for consecutive features, starting from FirstFeatureID,
+   * into OutValues. Values that are out of range or that can't be converted
+   * to T are set to the default value.
+   */
+  void GetValues(
+      int64 FirstFeatureID,
+      TArrayView<T> OutValues,
+      const T& DefaultValue) const;
+
+  /**
+   * Gets the values for the given features into OutValues, which must have
+   * the same number of elements as FeatureIDs. Values that are out of range or
+   * that can't be converted to T are set to the default value.
+   */
+  void GetValues(
+      TArrayView<const int64> FeatureIDs,
+      TArrayView<T> OutValues,
+      const T& DefaultValue) const;
+
+  /**
+   * Gets the raw values for consecutive features, starting from
+   * FirstFeatureID, into OutValues, without the property's offset, scale or
+   * normalization, like GetRawValue. Values that are out of range or that
+   * can't be converted to T are set to the default value.
+   */
+  void GetRawValues(
+      int64 FirstFeatureID,
+      TArrayView<T> OutValues,
+      const T& DefaultValue) const;
+
+private:
+  using ReadRange = void (*)(
+      const void* pView,
+      int64 FirstFeatureID,
+      TArrayView<T> OutValues,
+      const T& DefaultValue);
+  using ReadIndexed = void (*)(
+      const void* pView,
+      TArrayView<const int64> FeatureIDs,
+      TArrayView<T> OutValues,
+      const T& DefaultValue);
+
+  // The PropertyTablePropertyView in the property, and functions that read
+  // from it as its concrete type.
+  const void* _pView;
+  int64 _size;
+  ReadRange _readRange;
+  ReadIndexed _readIndexed;
+  ReadRange _readRawRange;
+};
+
+extern template class TCesiumPropertyColumn<bool>;
+extern template class TCesiumPropertyColumn<uint8>;
+extern template class TCesiumPropertyColumn<int32>;
+extern template class TCesiumPropertyColumn<int64>;
+extern template class TCesiumPropertyColumn<float>;
+extern template class TCesiumPropertyColumn<double>;
+extern template class TCesiumPropertyColumn<FIntPoint>;
+extern template class TCesiumPropertyColumn<FVector2D>;
+extern template class TCesiumPropertyColumn<FIntVector>;
+extern template class TCesiumPropertyColumn<FVector3f>;
+extern template class TCesiumPropertyColumn<FVector>;
+extern template class TCesiumPropertyColumn<FVector4>;
+extern template class TCesiumPropertyColumn<FMatrix>;
+extern template class TCesiumPropertyColumn<FString>;
+
 UCLASS()
 class CESIUMRUNTIME_API UCesiumPropertyTablePropertyBlueprintLibrary
     : public UBlueprintFunctionLibrary {
@@ -4,6 +4,7 @@
 
 #include "CesiumRasterOverlayLoadFailureDetails.h"
 #include "CesiumRasterOverlays/RasterOverlay.h"
+#include "CesiumRequestPriority.h"
 #include "Components/ActorComponent.h"
 #include "CoreMinimal.h"
 #include "Engine/Texture.h"
@@ -42,6 +43,25 @@ struct FRasterOverlayRendererOptions {
 
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   bool useMipmaps = true;
+
+  /**
+   * Whether to block compress raster tile images to BC1 (or BC3, if they
+   * contain transparency) before they're uploaded to the GPU, on platforms
+   * that support it. This uses 4 to 8 times less texture memory, at the cost
+   * of extra loading time and slightly reduced image quality.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool compressTextures = false;
+
+  /**
+   * Whether to show a low-resolution preview of each large raster tile image
+   * as soon as it's loaded, and replace it with the full image once that has
+   * been prepared. This makes overlays with a large maximum texture size
+   * appear sooner, especially with mipmaps or texture compression, at the
+   * cost of briefly showing blurrier imagery.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool progressiveLoading = false;
 };
 
 /**
@@ -74,6 +94,30 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   FRasterOverlayRendererOptions rendererOptions;
 
+  /**
+   * The priority class of this overlay's requests, which decides whether
+   * they're sent before or after those of tilesets and other overlays when
+   * "Maximum Bandwidth" in the Cesium project settings limits how fast tiles
+   * may be downloaded. An overlay that must stay current, such as one that
+   * shows live weather, can be given a higher priority than a large tileset
+   * that it's draped over. Takes effect when the overlay is next added to
+   * its tileset.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  ECesiumRequestPriority RequestPriority = ECesiumRequestPriority::Normal;
+
+  /**
+   * This overlay's share of the bandwidth of its Request Priority, relative
+   * to the shares of tilesets and other overlays with the same priority.
+   * Takes effect when the overlay is next added to its tileset.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.01))
+  float BandwidthShare = 1.0f;
+
   // Sets default values for this component's properties
   UCesiumRasterOverlay();
 
@@ -221,4 +265,7 @@ protected:
 private:
   CesiumRasterOverlays::RasterOverlay* _pOverlay;
   int32 _overlaysBeingDestroyed;
+
+  // The bandwidth stream that the requests of _pOverlay are made in.
+  uint64 _bandwidthStream;
 };
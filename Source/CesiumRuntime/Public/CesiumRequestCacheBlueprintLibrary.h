@@ -0,0 +1,107 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "UObject/ObjectMacros.h"
+#include "CesiumRequestCacheBlueprintLibrary.generated.h"
+
+/**
+ * Counters describing how well the on-disk request cache is serving tile and
+ * other requests.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumRequestCacheStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The number of requests that were found in the cache.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 Hits = 0;
+
+  /**
+   * The number of requests that were not found in the cache.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 Misses = 0;
+
+  /**
+   * The number of responses that were written to the cache.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 Writes = 0;
+
+  /**
+   * The total size, in bytes, of the responses written to the cache.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 BytesWritten = 0;
+
+  /**
+   * The number of times the least recently used items were evicted from the
+   * cache to keep it within its size limit.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 Prunes = 0;
+
+  /**
+   * The average time, in milliseconds, that looking up a request in the
+   * cache database took.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double AverageReadMilliseconds = 0.0;
+
+  /**
+   * The longest time, in milliseconds, that looking up a request in the
+   * cache database took.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double MaximumReadMilliseconds = 0.0;
+
+  /**
+   * The average time, in milliseconds, that writing a response to the cache
+   * database took.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double AverageWriteMilliseconds = 0.0;
+
+  /**
+   * The longest time, in milliseconds, that writing a response to the cache
+   * database took.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double MaximumWriteMilliseconds = 0.0;
+
+  /**
+   * The average time, in milliseconds, that a prune took.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double AveragePruneMilliseconds = 0.0;
+
+  /**
+   * The longest time, in milliseconds, that a prune took.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double MaximumPruneMilliseconds = 0.0;
+};
+
+UCLASS()
+class CESIUMRUNTIME_API UCesiumRequestCacheBlueprintLibrary
+    : public UBlueprintFunctionLibrary {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Gets the request cache counters accumulated since the application started
+   * or since they were last reset.
+   */
+  UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Cesium|Cache")
+  static FCesiumRequestCacheStatistics GetRequestCacheStatistics();
+
+  /**
+   * Resets all of the request cache counters to zero.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Cache")
+  static void ResetRequestCacheStatistics();
+};
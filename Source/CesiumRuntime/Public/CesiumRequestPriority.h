@@ -0,0 +1,36 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumRequestPriority.generated.h"
+
+/**
+ * The priority class of the requests of a tileset or raster overlay, which
+ * decides which of them are sent first when "Maximum Bandwidth" in the Cesium
+ * project settings limits how fast tiles may be downloaded.
+ */
+UENUM(BlueprintType)
+enum class ECesiumRequestPriority : uint8 {
+  /**
+   * Requests are sent as soon as they're made, without waiting for bandwidth,
+   * although the bandwidth that they use is taken from the other classes.
+   */
+  Critical,
+
+  /**
+   * Requests are sent before those of Normal and Background tilesets and
+   * overlays.
+   */
+  High,
+
+  /**
+   * Requests are sent before those of Background tilesets and overlays.
+   */
+  Normal,
+
+  /**
+   * Requests only use bandwidth that no other tileset or overlay needs.
+   */
+  Background
+};
@@ -16,6 +16,7 @@ class ICacheDatabase;
 } // namespace CesiumAsync
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCesium, Log, All);
+DECLARE_STATS_GROUP(TEXT("Cesium"), STATGROUP_Cesium, STATCAT_Advanced);
 
 class FCesiumRuntimeModule : public IModuleInterface {
 public:
@@ -6,6 +6,92 @@
 #include "Engine/DeveloperSettings.h"
 #include "CesiumRuntimeSettings.generated.h"
 
+/**
+ * The method used to determine whether tiles are occluded, when the
+ * experimental occlusion culling feature is enabled.
+ */
+UENUM()
+enum class ECesiumOcclusionCullingMethod : uint8 {
+  /**
+   * Each tile's bounding volume is tested with Unreal's hardware occlusion
+   * queries, using a pool of invisible primitive components. Only as many
+   * tiles as a tileset's Occlusion Pool Size can be tested at once.
+   */
+  OcclusionQueries,
+
+  /**
+   * Each tile's bounding volume is tested against the hierarchical Z-buffer
+   * (HZB) that Unreal builds for each view, in a compute shader. This doesn't
+   * add any primitives to the scene, so every tile can be tested, and the
+   * results are read back without waiting on the GPU. Views that don't build
+   * an HZB don't contribute occlusion results.
+   */
+  HierarchicalZBuffer
+};
+
+/**
+ * The priority of the threads that run Cesium's background tasks, when
+ * "Use Dedicated Worker Threads" is enabled.
+ */
+UENUM()
+enum class ECesiumWorkerThreadPriority : uint8 {
+  Lowest,
+  BelowNormal,
+  Normal
+};
+
+/**
+ * How Cesium tilesets are adjusted at one level of Unreal's scalability
+ * settings, when "Enable Scalability Tiers" is set in the project settings.
+ */
+USTRUCT()
+struct FCesiumScalabilityTier {
+  GENERATED_BODY()
+
+  /**
+   * The factor that each tileset's Maximum Screen Space Error is multiplied
+   * by, so that fewer and less detailed tiles are loaded at lower quality
+   * levels.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium", meta = (ClampMin = 0.0))
+  float MaximumScreenSpaceErrorScale = 1.0f;
+
+  /**
+   * The factor that each tileset's Maximum Cached Bytes is multiplied by.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium", meta = (ClampMin = 0.0))
+  float MaximumCachedBytesScale = 1.0f;
+
+  /**
+   * The largest texture that raster overlays may create for a tile, in
+   * pixels, in place of a larger Maximum Texture Size of an overlay. Set this
+   * to 0 to use each overlay's own Maximum Texture Size.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium", meta = (ClampMin = 0))
+  int32 MaximumTextureSize = 0;
+
+  /**
+   * The most points that point cloud tilesets may draw per frame, in place
+   * of a larger or unlimited "Maximum Points Per Frame". Set this to 0 to use
+   * "Maximum Points Per Frame" as is.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium", meta = (ClampMin = 0))
+  int32 MaximumPointsPerFrame = 0;
+
+  /**
+   * Whether tilesets that use LOD transitions may fade between levels of
+   * detail. If not, they switch at once.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium")
+  bool EnableLodTransitions = true;
+
+  /**
+   * Whether tilesets that use occlusion culling may cull occluded tiles.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium")
+  bool EnableOcclusionCulling = true;
+};
+
 /**
  * Stores runtime settings for the Cesium plugin.
  */
@@ -53,6 +139,629 @@ public:
   UPROPERTY(Config, EditAnywhere, Category = "Experimental Feature Flags")
   bool EnableExperimentalOcclusionCullingFeature = false;
 
+  /**
+   * How tiles are tested for occlusion when the experimental occlusion
+   * culling feature is enabled. Changes take effect when a tileset is next
+   * reloaded.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Experimental Feature Flags",
+      meta = (EditCondition = "EnableExperimentalOcclusionCullingFeature"))
+  ECesiumOcclusionCullingMethod OcclusionCullingMethod =
+      ECesiumOcclusionCullingMethod::HierarchicalZBuffer;
+
+  /**
+   * The maximum time, in milliseconds, to spend on the game thread each frame
+   * finalizing newly-loaded tiles (creating components, meshes, and
+   * materials). This budget is shared across all of the tilesets in a world,
+   * and tiles that don't fit are deferred to later frames, highest priority
+   * first. Each tileset will still finalize at least one tile per frame, so
+   * loading never stalls entirely. Creating raster overlay textures counts
+   * against this budget too, and other Cesium game thread work, such as
+   * applying credits and mesh distance fields, only runs with what's left of
+   * it. Set this to 0 to disable the limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0.0, Units = "ms"))
+  float MainThreadLoadingTimeBudget = 5.0f;
+
+  /**
+   * The maximum number of tiles that may be loaded simultaneously by all of
+   * the tilesets in a world, combined. Each tileset's own Maximum
+   * Simultaneous Tile Loads still applies, too. Tilesets that need fewer
+   * loads leave the rest for the others. Set this to 0 to let each tileset
+   * use its own limit independently.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumSimultaneousTileLoadsPerWorld = 0;
+
+  /**
+   * The maximum number of bytes of tile data that may be cached by all of the
+   * tilesets in a world, combined. Each tileset's own Maximum Cached Bytes
+   * still applies, too. As with the per-tileset limit, tiles that are needed
+   * for rendering are never unloaded, so memory usage may exceed this value
+   * when too many tiles are visible. Set this to 0 to let each tileset use its
+   * own limit independently.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int64 MaximumCachedBytesPerWorld = 0;
+
+  /**
+   * The maximum number of tilesets in a world whose tile selection is updated
+   * each frame. When a world has more tilesets than this, they take turns,
+   * and the rest keep showing the tiles they selected last. Tilesets that are
+   * loading tiles or are close to a camera get more turns than those that are
+   * idle or far away, and every tileset is updated eventually. Set this to 0
+   * to update every tileset every frame.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumTilesetUpdatesPerFrame = 0;
+
+  /**
+   * The maximum time, in milliseconds, to spend on the game thread each frame
+   * destroying the meshes, materials, and textures of unloaded tiles. Objects
+   * that don't fit are destroyed in later frames, so that unloading many
+   * tiles at once, such as when a camera teleports, doesn't stall a single
+   * frame. Set this to 0 to disable the limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0.0, Units = "ms"))
+  float MainThreadDestructionTimeBudget = 2.0f;
+
+  /**
+   * The number of objects waiting to be destroyed above which a garbage
+   * collection is requested. Objects that are no longer referenced by
+   * anything are freed by the garbage collector without having to wait for
+   * their turn within the destruction time budget. Set this to 0 to never
+   * request a garbage collection.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumPendingDestructions = 10000;
+
+  /**
+   * The maximum time, in milliseconds, to spend on the game thread each frame
+   * creating the physics bodies of tiles whose collision is being enabled.
+   * Tiles that don't fit are given collision in later frames, in the order
+   * they were shown, so that showing many tiles at once doesn't stall a
+   * single frame. Until then, they're drawn but can't be collided with. Set
+   * this to 0 to create physics bodies as soon as tiles are shown.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0.0, Units = "ms"))
+  float MainThreadPhysicsTimeBudget = 2.0f;
+
+  /**
+   * Whether to memory-map local files loaded from file:/// URLs instead of
+   * reading them into memory. Mapped tile content is handed to the loader
+   * without being copied, which substantially reduces load-thread time for
+   * large tilesets stored on fast local disks. Files that can't be mapped are
+   * read normally.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool UseMemoryMappedFileReads = false;
+
+  /**
+   * Whether to generate texture mipmaps on the GPU instead of on the loading
+   * threads. When a tile or raster overlay texture needs mipmaps and doesn't
+   * already have them, only its full-resolution image is uploaded, and the
+   * rest of the mip chain is generated by the render thread. This takes a lot
+   * of work off of the loading threads for large raster overlay tiles.
+   *
+   * Block-compressed textures, including those compressed by a tileset's
+   * "Compress Textures" option, still have their mipmaps generated on the
+   * CPU. Textures whose mipmaps are generated on the GPU are created on the
+   * render thread, even where the RHI supports creating them asynchronously.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool GenerateMipMapsOnGpu = false;
+
+  /**
+   * Whether to stream the mipmaps of tile and raster overlay textures, so
+   * that only the mips that a texture's size on the screen needs are resident
+   * on the GPU. Distant and hidden tiles then keep only their low mips, which
+   * can greatly reduce the video memory used by tile textures in wide views.
+   *
+   * Streamed textures keep their images in CPU memory, so that their mips can
+   * be uploaded again when they're needed. Textures whose mipmaps are
+   * generated on the GPU aren't streamed.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool UseTextureStreaming = false;
+
+  /**
+   * The smallest size, in texels, of the most detailed mip that a streamed
+   * texture keeps resident, even when it's far away or hidden.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 1, EditCondition = "UseTextureStreaming"))
+  int32 TextureStreamingMinimumMipSize = 64;
+
+  /**
+   * Whether to limit the number of tile requests in flight to each host,
+   * queueing the rest. This lets the HTTP module reuse a small pool of
+   * persistent connections to each server instead of opening a new connection
+   * for most requests, which can greatly increase throughput on high-latency
+   * links.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ConfigRestartRequired = true))
+  bool UsePooledHttpRequests = false;
+
+  /**
+   * The maximum number of tile requests to a single host that may be in
+   * flight at once when "Use Pooled Http Requests" is enabled. This should
+   * not exceed HttpMaxConnectionsPerServer in Engine.ini.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta =
+          (ClampMin = 1,
+           EditCondition = "UsePooledHttpRequests",
+           ConfigRestartRequired = true))
+  int32 MaximumConnectionsPerHost = 8;
+
+  /**
+   * Whether to receive the bodies of tile responses as they're downloaded,
+   * into buffers that are handed to the loader without being copied, instead
+   * of having the HTTP module accumulate each body and copy it once the
+   * response completes. The buffer for a body is sized from its
+   * Content-Length up front, and the bytes received by requests that are
+   * still in flight are counted as they arrive.
+   *
+   * This requires Unreal Engine 5.3 or later, and has no effect on earlier
+   * versions.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool UseStreamingHttpResponses = false;
+
+  /**
+   * The content encodings to ask servers to compress responses with, as the
+   * value of an Accept-Encoding header, such as "br, gzip". Compressed
+   * responses are decoded on worker threads. Only encodings that Cesium for
+   * Unreal can decode are requested: gzip, and others such as "br" and "zstd"
+   * only once a project registers a decoder for them with
+   * CesiumContentEncodingAssetAccessor::registerDecoder. When this is empty,
+   * the HTTP module's default Accept-Encoding is sent.
+   *
+   * The HTTP module fails responses with encodings that it can't decode
+   * itself, so encodings other than gzip also require its decoding to be
+   * disabled, with bAcceptCompressedContent=false in the [HTTP.Curl] section
+   * of Engine.ini.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ConfigRestartRequired = true))
+  FString HttpAcceptEncoding;
+
+  /**
+   * The bandwidth, in megabits per second, that tiles may be downloaded with,
+   * or 0 if it isn't limited. When it's limited, it's shared between
+   * tilesets and raster overlays by their Request Priority and Bandwidth
+   * Share, so that one that matters more isn't starved by a larger one.
+   * Responses that are read from the cache don't count toward it.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0.0))
+  float MaximumBandwidth = 0.0f;
+
+  /**
+   * The maximum number of bytes of recently received raster overlay tiles to
+   * keep in memory, shared by all raster overlays. When the same overlay,
+   * such as Bing Maps or Cesium ion imagery, is attached to more than one
+   * tileset, each of its tiles is then downloaded once rather than once for
+   * each tileset. 0 disables this.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int64 SharedRasterOverlayCacheBytes = 16 * 1024 * 1024;
+
+  /**
+   * The maximum number of bytes of recently decoded tile content to keep in
+   * memory, shared by all tilesets. When a tileset loads the same content
+   * again, such as when Play-In-Editor starts or a tileset is refreshed, its
+   * tiles are then copied from memory rather than decoded again.
+   *
+   * This memory is held in addition to the memory used by the tiles that are
+   * loaded, for as long as the process runs, and decoded models are often
+   * several times larger than the tile content they were decoded from. So it
+   * is 0 by default, which disables this, and is best enabled only where
+   * repeated loads are common, such as in the editor.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int64 DecodedTileContentCacheBytes = 0;
+
+  /**
+   * The maximum number of tiles with Draco or meshopt compressed meshes, or
+   * KTX2 images, that may be decoded at once, across all tilesets. Decoding
+   * them takes much longer than other tiles, so without a limit a tileset
+   * full of them can keep every core busy. Tiles beyond the limit wait on
+   * their worker thread, and other tiles are decoded as usual. 0 means no
+   * limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumSimultaneousCompressedDecodes = 0;
+
+  /**
+   * Whether KTX2 images are transcoded to the highest quality compressed
+   * format that the GPU supports, such as BC7 or ASTC, rather than to the
+   * smallest one. Higher quality formats take longer to transcode and use
+   * more GPU memory. Like the other settings, this can be set for each
+   * platform in the platform's Engine.ini. Changes take effect when a
+   * tileset is next reloaded.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool PreserveHighQualityKtx2Transcoding = false;
+
+  /**
+   * Whether to run Cesium's background tasks, such as decoding tiles and
+   * building their meshes, on threads of its own rather than on the engine's
+   * background task threads. This keeps tile loading from competing with the
+   * engine's own background work, such as audio and asset streaming, and
+   * lets it be limited to some of the cores at a lower priority.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ConfigRestartRequired = true))
+  bool UseDedicatedWorkerThreads = false;
+
+  /**
+   * The number of threads to run Cesium's background tasks on, when "Use
+   * Dedicated Worker Threads" is enabled. When this is 0, half of the logical
+   * cores are used.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta =
+          (ClampMin = 0,
+           EditCondition = "UseDedicatedWorkerThreads",
+           ConfigRestartRequired = true))
+  int32 WorkerThreadCount = 0;
+
+  /**
+   * The priority of the threads that run Cesium's background tasks, when
+   * "Use Dedicated Worker Threads" is enabled.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta =
+          (EditCondition = "UseDedicatedWorkerThreads",
+           ConfigRestartRequired = true))
+  ECesiumWorkerThreadPriority WorkerThreadPriority =
+      ECesiumWorkerThreadPriority::BelowNormal;
+
+  /**
+   * The cores that the threads running Cesium's background tasks may run on,
+   * as a bit mask, when "Use Dedicated Worker Threads" is enabled. When this
+   * is 0, they may run on any core.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta =
+          (EditCondition = "UseDedicatedWorkerThreads",
+           ConfigRestartRequired = true))
+  int64 WorkerThreadAffinityMask = 0;
+
+  /**
+   * The maximum number of points to draw each frame, from all of the point
+   * cloud tilesets in view combined. When there are more points in view, the
+   * tiles whose geometric error appears smallest on screen are drawn with
+   * fewer points or not at all, which are usually the most detailed tiles
+   * furthest from the camera. With replacement refinement, this can leave
+   * holes where a tile has been refined but its children are not drawn. Set
+   * this to 0 to draw every point.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Point Clouds",
+      meta = (ClampMin = 0))
+  int32 MaximumPointsPerFrame = 0;
+
+  /**
+   * The amount of available physical memory, in bytes, below which tilesets
+   * respond as if the operating system had warned that memory is low. The
+   * operating system's own memory warnings and trim requests are always
+   * responded to. Set this to 0 to only respond to those.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Memory Pressure",
+      meta = (ClampMin = 0))
+  int64 LowAvailablePhysicalMemoryBytes = 0;
+
+  /**
+   * The factor that each tileset's Maximum Cached Bytes is multiplied by
+   * while memory is low. Tiles beyond the reduced limit are unloaded as soon
+   * as each tileset next updates.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Memory Pressure",
+      meta = (ClampMin = 0.0, ClampMax = 1.0))
+  float MemoryPressureCachedBytesScale = 0.25f;
+
+  /**
+   * The factor that each tileset's Maximum Screen Space Error is multiplied
+   * by while memory is low, so that fewer and less detailed tiles are loaded.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Memory Pressure",
+      meta = (ClampMin = 1.0))
+  float MemoryPressureScreenSpaceErrorScale = 2.0f;
+
+  /**
+   * The time, in seconds, since the last memory warning after which tilesets
+   * go back to their usual limits.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Memory Pressure",
+      meta = (ClampMin = 0.0))
+  float MemoryPressureRecoveryTime = 30.0f;
+
+  /**
+   * Whether to stream tiles more slowly and with less detail while the device
+   * is hot or its battery is low. This keeps phones and tablets from
+   * throttling themselves, and the frame rate with them, over long sessions.
+   *
+   * Tilesets are throttled moderately while the operating system reports
+   * that the device is warm, is in low power mode, or is running on a
+   * battery below "Throttling Low Battery Level", and fully while it reports
+   * that the device is hot. The operating system's reports are only
+   * available on mobile platforms.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Mobile Throttling")
+  bool EnableMobileThrottling = false;
+
+  /**
+   * The battery level, in percent, below which tilesets are throttled while
+   * the device runs on battery. The battery must charge 5 percent above this
+   * level before they stop being throttled.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Mobile Throttling",
+      meta =
+          (ClampMin = 0,
+           ClampMax = 100,
+           EditCondition = "EnableMobileThrottling"))
+  int32 ThrottlingLowBatteryLevel = 20;
+
+  /**
+   * The factor that each tileset's Maximum Screen Space Error is multiplied
+   * by while tilesets are fully throttled, so that fewer and less detailed
+   * tiles are loaded. Half of the increase applies while they're moderately
+   * throttled.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Mobile Throttling",
+      meta = (ClampMin = 1.0, EditCondition = "EnableMobileThrottling"))
+  float ThrottledScreenSpaceErrorScale = 2.0f;
+
+  /**
+   * The factor that each tileset's Maximum Simultaneous Tile Loads is
+   * multiplied by while tilesets are fully throttled. Half of the decrease
+   * applies while they're moderately throttled.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Mobile Throttling",
+      meta =
+          (ClampMin = 0.0,
+           ClampMax = 1.0,
+           EditCondition = "EnableMobileThrottling"))
+  float ThrottledTileLoadScale = 0.25f;
+
+  /**
+   * The fraction of the worker threads that Cesium's background tasks, such
+   * as decoding tiles, may run on at once while tilesets are fully
+   * throttled. Half of the decrease applies while they're moderately
+   * throttled. At least one task always runs.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Mobile Throttling",
+      meta =
+          (ClampMin = 0.0,
+           ClampMax = 1.0,
+           EditCondition = "EnableMobileThrottling"))
+  float ThrottledWorkerThreadScale = 0.5f;
+
+  /**
+   * The time, in seconds, that the device must stay cooler or better charged
+   * before tilesets are throttled less, so that they don't switch back and
+   * forth as the device's state hovers around a threshold.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Mobile Throttling",
+      meta = (ClampMin = 0.0, EditCondition = "EnableMobileThrottling"))
+  float ThrottlingRecoveryTime = 60.0f;
+
+  /**
+   * Whether to adjust every tileset to Unreal's scalability settings, so
+   * that choosing a lower quality in a game's settings menu also loads fewer
+   * and less detailed tiles. The tier for the current View Distance Quality
+   * (`sg.ViewDistanceQuality`) sets the screen-space error, cached bytes,
+   * point budget, LOD transitions, and occlusion culling of tilesets, and the
+   * tier for the current Texture Quality (`sg.TextureQuality`) sets the size
+   * of raster overlay textures. Changes to the scalability settings apply
+   * immediately.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Scalability")
+  bool EnableScalabilityTiers = false;
+
+  /** How tilesets are adjusted at the Low quality level. */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Scalability",
+      meta = (EditCondition = "EnableScalabilityTiers"))
+  FCesiumScalabilityTier LowScalabilityTier;
+
+  /** How tilesets are adjusted at the Medium quality level. */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Scalability",
+      meta = (EditCondition = "EnableScalabilityTiers"))
+  FCesiumScalabilityTier MediumScalabilityTier;
+
+  /** How tilesets are adjusted at the High quality level. */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Scalability",
+      meta = (EditCondition = "EnableScalabilityTiers"))
+  FCesiumScalabilityTier HighScalabilityTier;
+
+  /** How tilesets are adjusted at the Epic quality level. */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Scalability",
+      meta = (EditCondition = "EnableScalabilityTiers"))
+  FCesiumScalabilityTier EpicScalabilityTier;
+
+  /** How tilesets are adjusted at the Cinematic quality level. */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Scalability",
+      meta = (EditCondition = "EnableScalabilityTiers"))
+  FCesiumScalabilityTier CinematicScalabilityTier;
+
+  /**
+   * The time between samples of Cesium's performance counters, in seconds,
+   * which are written to the telemetry sinks configured below and to any
+   * added with CesiumTelemetry::addSink. Set this to 0 to sample nothing.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Telemetry",
+      meta = (ClampMin = 0.0))
+  float TelemetryInterval = 0.0f;
+
+  /**
+   * The CSV file that each sample of the performance counters is appended
+   * to, relative to the project's saved directory. Leave this empty to not
+   * write a CSV file.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Telemetry",
+      meta = (ConfigRestartRequired = true))
+  FString TelemetryCsvFile;
+
+  /**
+   * The StatsD server that each sample of the performance counters is sent
+   * to as gauges, as a host and port such as "localhost:8125". Leave this
+   * empty to not send them to StatsD.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Telemetry",
+      meta = (ConfigRestartRequired = true))
+  FString TelemetryStatsDServer;
+
+  /**
+   * The OpenTelemetry collector endpoint that each sample of the performance
+   * counters is posted to as gauges, with OTLP/HTTP in JSON, such as
+   * "http://localhost:4318/v1/metrics". Leave this empty to not send them to
+   * OpenTelemetry.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Telemetry",
+      meta = (ConfigRestartRequired = true))
+  FString TelemetryOpenTelemetryEndpoint;
+
+  /**
+   * The prefix of the names of the performance counters sent to StatsD and
+   * OpenTelemetry, which also names the service in OpenTelemetry. Installations
+   * can be told apart by giving each its own prefix.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Telemetry",
+      meta = (ConfigRestartRequired = true))
+  FString TelemetryMetricPrefix = TEXT("cesium");
+
   /**
    * The number of requests to handle before each prune of old cached results
    * from the database.
@@ -74,4 +783,95 @@ public:
       Category = "Cache",
       meta = (ConfigRestartRequired = true))
   int MaxCacheItems = 4096;
+
+  /**
+   * The maximum size of the request cache on disk, in gigabytes. When this is
+   * greater than zero, it's used instead of Max Cache Items and Requests Per
+   * Cache Prune: the number of items kept after pruning is derived from this
+   * size and the average size of the items cached in previous sessions, and
+   * the cache is pruned in the background each time about 1% of this size has
+   * been written. The items that were accessed least recently are pruned
+   * first.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ClampMin = 0.0, ConfigRestartRequired = true))
+  float MaxCacheSizeInGigabytes = 0.0f;
+
+  /**
+   * The longest time, in hours, after a cached response has expired for
+   * which it is still used right away, while it's revalidated with the
+   * server in the background. This keeps loads from a warm cache from
+   * waiting for the server, which suits datasets that rarely change. Cached
+   * responses that have been expired for longer than this, and those whose
+   * Cache-Control says they must be revalidated, are revalidated before
+   * they're used. When this is 0, every expired response is revalidated
+   * before it's used.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ClampMin = 0.0, ConfigRestartRequired = true))
+  float MaxCacheStalenessInHours = 0.0f;
+
+  /**
+   * Whether to write responses to the request cache, and prune it, on a
+   * thread of the lowest priority, rather than on the threads that handle
+   * requests. Responses are queued and written in batches, and are found in
+   * the queue by requests made before they're written, so that writes and
+   * prunes don't hold up the cache reads of requests in flight. Queued
+   * responses are written when the application exits.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true))
+  bool UseCacheMaintenanceThread = false;
+
+  /**
+   * The maximum size on disk, in megabytes, of the cache of the vertex and
+   * index buffers that the primitives of tiles are converted to. A tile that
+   * is loaded again, such as on a later visit to the same place, then reads
+   * its buffers from this cache in their final layout, instead of computing
+   * its normals, tangents, and texture coordinates again. The cache is kept
+   * next to the request cache, and the buffers used least recently are
+   * pruned first. 0 disables this.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ClampMin = 0, ConfigRestartRequired = true))
+  int32 PreparedMeshCacheSizeInMegabytes = 0;
+
+  /**
+   * Whether tilesets in the editor stop selecting and loading tiles while the
+   * editor isn't the focused application, so that a level left open doesn't
+   * keep using CPU time and bandwidth. This doesn't affect Play-in-Editor.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Editor")
+  bool PauseTilesetsInBackgroundEditor = false;
+
+  /**
+   * Whether tilesets in the editor only select tiles for the level viewport
+   * that was used last, rather than for every visible realtime viewport.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Editor")
+  bool OnlyUseActiveEditorViewport = false;
+
+  /**
+   * The maximum number of tiles that each tileset in the editor may load at
+   * once while the editor isn't the focused application. Set this to 0 to use
+   * each tileset's own Maximum Simultaneous Tile Loads.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Editor",
+      meta = (ClampMin = 0, EditCondition = "!PauseTilesetsInBackgroundEditor"))
+  int32 BackgroundEditorMaximumSimultaneousTileLoads = 0;
 };
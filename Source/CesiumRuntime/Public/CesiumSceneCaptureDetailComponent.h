@@ -0,0 +1,73 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include "CesiumSceneCaptureDetailComponent.generated.h"
+
+/**
+ * Controls how a Scene Capture 2D Actor that it is attached to affects which
+ * tiles Cesium 3D Tilesets load. By default, every scene capture selects tiles
+ * as if it were a camera with the resolution of its render target. A capture
+ * that is shown small, such as a minimap, can use this component to select
+ * coarser tiles, or none at all, so that it doesn't load tiles that only a
+ * full-screen view would need.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumSceneCaptureDetailComponent
+    : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Whether the scene capture contributes to the tile selection. If false,
+   * the capture only shows the tiles that are selected for other views.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool UseForTileSelection = true;
+
+  /**
+   * Whether to select tiles for the Resolution below rather than for the
+   * size of the capture's render target.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (EditCondition = "UseForTileSelection"))
+  bool OverrideResolution = false;
+
+  /**
+   * The resolution, in pixels, to select tiles for, such as the size that a
+   * minimap is shown at on the screen.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta =
+          (EditCondition = "UseForTileSelection && OverrideResolution",
+           ClampMin = 1))
+  FIntPoint Resolution = FIntPoint(256, 256);
+
+  /**
+   * The factor that the screen-space error of tiles in the capture is
+   * multiplied by, on top of each tileset's Maximum Screen Space Error. A
+   * value of 2.0 makes the capture refine tiles as if it had half the
+   * resolution.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (EditCondition = "UseForTileSelection", ClampMin = 0.01))
+  double ScreenSpaceErrorMultiplier = 1.0;
+
+  /**
+   * Gets the viewport size that tiles are selected for in a scene capture
+   * with a render target of the given size.
+   */
+  FVector2D GetTileSelectionViewportSize(
+      const FVector2D& RenderTargetSize) const;
+};
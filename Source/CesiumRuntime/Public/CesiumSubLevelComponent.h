@@ -397,6 +397,12 @@ private:
    */
   ALevelInstance* _getLevelInstance() const noexcept;
 
+  /**
+   * Tells the sub-level switcher, if there is one, that this sub-level's
+   * origin, load radius, or enabled state has changed.
+   */
+  void _invalidateSwitcherIndex() noexcept;
+
   /**
    * Invalidates the cached resolved georeference, unsubscribing from it and
    * setting it to null. The next time ResolveGeoreference is called, the
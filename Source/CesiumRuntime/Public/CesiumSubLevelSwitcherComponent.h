@@ -7,6 +7,7 @@
 
 class ACesiumGeoreference;
 class ALevelInstance;
+class CesiumSubLevelIndex;
 class ULevelStreaming;
 class UWorld;
 
@@ -22,6 +23,7 @@ class CESIUMRUNTIME_API UCesiumSubLevelSwitcherComponent
 
 public:
   UCesiumSubLevelSwitcherComponent();
+  virtual ~UCesiumSubLevelSwitcherComponent();
 
   /**
    * Gets the list of sub-levels that are currently registered with this
@@ -46,6 +48,22 @@ public:
   UFUNCTION(BlueprintPure, Category = "Cesium|Sub-levels")
   ALevelInstance* GetCurrentSubLevel() const noexcept;
 
+  /**
+   * Finds the enabled registered sub-level whose origin is closest to the
+   * given Earth-Centered, Earth-Fixed position, among those whose LoadRadius
+   * contains it. The sub-levels are found with a spatial index, which is
+   * rebuilt when sub-levels are registered or changed, so this is cheap even
+   * with many sub-levels.
+   *
+   * @param EarthCenteredEarthFixedPosition The position, in meters.
+   * @param Excluded A sub-level to ignore, or nullptr.
+   * @return The sub-level, or nullptr if the position is not within any
+   * enabled sub-level's LoadRadius.
+   */
+  ALevelInstance* FindSubLevelAtEarthCenteredEarthFixedPosition(
+      const FVector& EarthCenteredEarthFixedPosition,
+      const ALevelInstance* Excluded = nullptr);
+
   /**
    * Gets the sub-level that is in the process of becoming active. If nullptr,
    * the target is a state where no sub-levels are active.
@@ -60,6 +78,44 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium|Sub-levels")
   void SetTargetSubLevel(ALevelInstance* LevelInstance) noexcept;
 
+  /**
+   * Gets the sub-level that is expected to become the target next, and is
+   * loaded ahead of time without being shown.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Sub-levels")
+  ALevelInstance* GetPreloadSubLevel() const noexcept;
+
+  /**
+   * Sets the sub-level that is expected to become the target next. In a game,
+   * the switcher loads it in the background without showing it, as long as
+   * no more than MaximumLoadedSubLevels would be loaded, so that it can be
+   * shown as soon as it becomes the target. A previous preload sub-level that
+   * is neither current nor the target is unloaded.
+   *
+   * The CesiumOriginShiftComponent sets this from the camera's motion when its
+   * SubLevelPreloadTime is greater than zero.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Sub-levels")
+  void SetPreloadSubLevel(ALevelInstance* LevelInstance) noexcept;
+
+  /**
+   * The maximum number of sub-levels that may be loaded at once in a game,
+   * including the current one and any that are still unloading.
+   *
+   * When this is 1, a new target sub-level is only loaded once the previous
+   * one has completely unloaded. When it is greater, the new target and the
+   * preload sub-level are loaded in the background, hidden, while the previous
+   * sub-level is still shown, and the new target is shown as soon as the
+   * previous one has been hidden rather than unloaded. This shortens the gap
+   * between sub-levels at the cost of the memory of the extra loaded levels.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Sub-levels",
+      meta = (ClampMin = 1))
+  int32 MaximumLoadedSubLevels = 1;
+
 private:
   // To allow the sub-level to register/unregister itself with the functions
   // below.
@@ -78,12 +134,22 @@ private:
    */
   void UnregisterSubLevel(ALevelInstance* pSubLevel) noexcept;
 
+  /**
+   * Marks the spatial index of the sub-levels out of date, so it's rebuilt
+   * the next time it's needed. Sub-levels call this when their origin, load
+   * radius, or enabled state changes.
+   */
+  void InvalidateSubLevelIndex() noexcept {
+    this->_subLevelIndexIsValid = false;
+  }
+
   virtual void TickComponent(
       float DeltaTime,
       enum ELevelTick TickType,
       FActorComponentTickFunction* ThisTickFunction) override;
 
   void _updateSubLevelStateGame();
+  void _updatePreloadSubLevelGame();
 #if WITH_EDITOR
   void _updateSubLevelStateEditor();
 #endif
@@ -95,6 +161,18 @@ private:
   ULevelStreaming*
   _getLevelStreamingForSubLevel(ALevelInstance* SubLevel) const;
 
+  /**
+   * Counts the registered sub-levels that are loaded, or are loading or
+   * unloading.
+   */
+  int32 _countLoadedSubLevels() const;
+
+  /**
+   * Works toward loading the given sub-level without showing it. It is only
+   * started loading if fewer than MaximumLoadedSubLevels are loaded.
+   */
+  void _loadSubLevelHidden(ALevelInstance* SubLevel);
+
   // Don't save/load or copy this.
   UPROPERTY(Transient, DuplicateTransient, TextExportTransient)
   TArray<TWeakObjectPtr<ALevelInstance>> _sublevels;
@@ -107,6 +185,15 @@ private:
   UPROPERTY(DuplicateTransient, TextExportTransient)
   TWeakObjectPtr<ALevelInstance> _pTarget = nullptr;
 
+  // Don't save/load or copy this.
+  UPROPERTY(Transient, DuplicateTransient, TextExportTransient)
+  TWeakObjectPtr<ALevelInstance> _pPreload = nullptr;
+
   bool _doExtraChecksOnNextTick = false;
   bool _isTransitioningSubLevels = false;
+
+  TUniquePtr<CesiumSubLevelIndex> _pSubLevelIndex;
+  // The sub-level of each sphere in _pSubLevelIndex.
+  TArray<TWeakObjectPtr<ALevelInstance>> _indexedSubLevels;
+  bool _subLevelIndexIsValid = false;
 };
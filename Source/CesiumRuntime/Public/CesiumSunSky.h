@@ -295,6 +295,24 @@ protected:
       Category = "Cesium|Atmosphere")
   double CircumscribedGroundThreshold = 100.0;
 
+  /**
+   * How far, in meters, the player pawn or editor viewport must move before
+   * the atmosphere ground radius is recomputed at runtime. Setting the ground
+   * radius invalidates the sky atmosphere's render state, so for a view that
+   * moves continuously, a distance that is small compared to the
+   * InscribedGroundThreshold avoids doing so every frame without visibly
+   * changing the atmosphere.
+   *
+   * The radius is always recomputed when the CesiumGeoreference or the
+   * thresholds change. When this is zero, it is recomputed every frame.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      meta = (EditCondition = "UpdateAtmosphereAtRuntime", ClampMin = 0.0),
+      Category = "Cesium|Atmosphere")
+  double AtmosphereUpdateDistance = 0.0;
+
   /**
    * The height of the atmosphere layer above the ground, in kilometers. This
    * value is automatically scaled according to the CesiumGeoreference Scale and
@@ -512,4 +530,20 @@ private:
       ETeleportType Teleport);
 
   FDelegateHandle _transformUpdatedSubscription;
+
+  // Whether the view has moved far enough since the atmosphere radius was
+  // last recomputed in Tick, or its inputs have changed, to recompute it.
+  bool _shouldUpdateAtmosphereRadius();
+
+  // The inputs of the last atmosphere radius recomputed in Tick.
+  bool _atmosphereRadiusValid = false;
+  FVector _lastAtmosphereViewLocation = FVector::ZeroVector;
+  double _lastAtmosphereScale = 0.0;
+  double _lastInscribedGroundThreshold = 0.0;
+  double _lastCircumscribedGroundThreshold = 0.0;
+
+  // The ellipsoid radius below the last latitude, which only changes with the
+  // latitude.
+  double _minimumRadiusLatitude = 0.0;
+  double _minimumRadius = 0.0;
 };
@@ -0,0 +1,190 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "HAL/Platform.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+
+/**
+ * The value of one of Cesium's performance counters when it was sampled.
+ */
+struct CesiumTelemetryCounter {
+  /**
+   * The name of the counter, in lowercase words separated by dots and
+   * underscores, such as "tile_pipeline.total.p95_ms".
+   */
+  FString name;
+
+  /**
+   * The value of the counter.
+   */
+  double value = 0.0;
+};
+
+/**
+ * A destination for the performance counters that Cesium samples every
+ * "Telemetry Interval" seconds.
+ *
+ * Sinks are called from a background thread, one sample at a time in the
+ * order the samples were taken, so they may block on file or network I/O
+ * without holding up the game.
+ */
+class CESIUMRUNTIME_API ICesiumTelemetrySink {
+public:
+  virtual ~ICesiumTelemetrySink() = default;
+
+  /**
+   * Writes one sample of the counters.
+   *
+   * @param timestampSeconds The time the sample was taken, in seconds since
+   * the Unix epoch.
+   * @param counters The counters, always in the same order for the same
+   * counter names.
+   */
+  virtual void write(
+      double timestampSeconds,
+      const TArray<CesiumTelemetryCounter>& counters) = 0;
+};
+
+/**
+ * Appends each sample of the counters to a CSV file, as a row with the
+ * timestamp followed by one column per counter. A header row naming the
+ * columns is written first, and again whenever the counters change.
+ */
+class CESIUMRUNTIME_API CesiumCsvTelemetrySink
+    : public ICesiumTelemetrySink {
+public:
+  CesiumCsvTelemetrySink(const FString& filename);
+
+  virtual void write(
+      double timestampSeconds,
+      const TArray<CesiumTelemetryCounter>& counters) override;
+
+private:
+  FString _filename;
+  TArray<FString> _columns;
+};
+
+/**
+ * Sends each sample of the counters to a StatsD server as gauges, in UDP
+ * datagrams.
+ */
+class CESIUMRUNTIME_API CesiumStatsDTelemetrySink
+    : public ICesiumTelemetrySink {
+public:
+  /**
+   * @param server The host name or IP address of the server, followed by a
+   * colon and its port, such as "localhost:8125".
+   * @param prefix The prefix of the gauge names, to which a dot and the
+   * counter names are appended.
+   */
+  CesiumStatsDTelemetrySink(const FString& server, const FString& prefix);
+  virtual ~CesiumStatsDTelemetrySink();
+
+  virtual void write(
+      double timestampSeconds,
+      const TArray<CesiumTelemetryCounter>& counters) override;
+
+  /**
+   * Formats the counters as StatsD gauges, one per line, split into payloads
+   * of at most the given number of bytes so that each fits in a datagram.
+   */
+  static TArray<FString> formatPayloads(
+      const FString& prefix,
+      const TArray<CesiumTelemetryCounter>& counters,
+      int32 maximumPayloadBytes);
+
+private:
+  class Socket;
+
+  FString _server;
+  FString _prefix;
+  TUniquePtr<Socket> _pSocket;
+};
+
+/**
+ * Sends each sample of the counters to an OpenTelemetry collector as gauges,
+ * with the OTLP/HTTP protocol in JSON.
+ */
+class CESIUMRUNTIME_API CesiumOpenTelemetrySink
+    : public ICesiumTelemetrySink {
+public:
+  /**
+   * @param endpoint The URL that metrics are posted to, such as
+   * "http://localhost:4318/v1/metrics".
+   * @param serviceName The service.name resource attribute of the metrics.
+   * @param prefix The prefix of the metric names, to which a dot and the
+   * counter names are appended.
+   */
+  CesiumOpenTelemetrySink(
+      const FString& endpoint,
+      const FString& serviceName,
+      const FString& prefix);
+
+  virtual void write(
+      double timestampSeconds,
+      const TArray<CesiumTelemetryCounter>& counters) override;
+
+  /**
+   * Formats a sample of the counters as an OTLP/HTTP JSON request body.
+   */
+  static FString formatJson(
+      const FString& serviceName,
+      const FString& prefix,
+      double timestampSeconds,
+      const TArray<CesiumTelemetryCounter>& counters);
+
+private:
+  FString _endpoint;
+  FString _serviceName;
+  FString _prefix;
+};
+
+/**
+ * Samples Cesium's performance counters every "Telemetry Interval" seconds
+ * and writes them to every sink that has been added. The sinks configured in
+ * the "Telemetry" section of the Cesium project settings are added at
+ * startup. All functions must be called from the game thread.
+ *
+ * Sampling only copies the counters, which are kept anyway, on the game
+ * thread. Sinks write them on a background thread.
+ *
+ * The counters include the distribution of the time that tiles of every
+ * tileset spent in each stage of the tile loading pipeline, the request cache
+ * hits and misses, the bytes received from the network, the memory held by
+ * the Unreal resources of loaded tiles, and the game-thread time spent on
+ * loading tiles.
+ */
+class CESIUMRUNTIME_API CesiumTelemetry {
+public:
+  /**
+   * Adds a sink that each later sample is written to.
+   */
+  static void addSink(const TSharedRef<ICesiumTelemetrySink>& pSink);
+
+  /**
+   * Removes a sink that was added with addSink. Samples that were already
+   * taken may still be written to it.
+   */
+  static void removeSink(const TSharedRef<ICesiumTelemetrySink>& pSink);
+
+  /**
+   * Samples the counters now, regardless of the interval.
+   */
+  static TArray<CesiumTelemetryCounter> sampleCounters();
+
+  /**
+   * Adds the sinks configured in the project settings. Called when the
+   * module starts up.
+   */
+  static void startup();
+
+  /**
+   * Waits for the samples that were taken to be written, and removes every
+   * sink. Called when the module shuts down.
+   */
+  static void shutdown();
+};
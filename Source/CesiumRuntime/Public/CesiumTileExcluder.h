@@ -71,4 +71,27 @@ public:
    */
   UFUNCTION(BlueprintNativeEvent)
   bool ShouldExclude(const UCesiumTile* TileObject);
+
+  /**
+   * Determines which of the given tiles should be excluded.
+   *
+   * Excluders implemented in C++ can override this to decide without calling
+   * into Blueprints or updating a UCesiumTile for every tile, which is much
+   * faster when many tiles are considered each frame. The default
+   * implementation calls ShouldExclude for each tile.
+   *
+   * @param TileBounds The bounds of each tile, in Unreal world coordinates.
+   * @param OutExcluded Set to one bit for each tile, in the same order, which
+   * is true if the tile should be excluded.
+   */
+  virtual void ShouldExcludeTiles(
+      TConstArrayView<FBoxSphereBounds> TileBounds,
+      TBitArray<>& OutExcluded);
+
+  /**
+   * Called on the game thread once each frame, before any tiles are
+   * considered, so that C++ excluders can gather what they need about the
+   * scene up front instead of for every tile.
+   */
+  virtual void PrepareForNewFrame() {}
 };
@@ -0,0 +1,103 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "UObject/ObjectMacros.h"
+#include "CesiumTilePipelineStatistics.generated.h"
+
+/**
+ * The distribution of the time that tiles have spent in one stage of the tile
+ * loading pipeline. Percentiles are estimated from a histogram, so they are
+ * accurate to within about 20%.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTilePipelineStageStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The number of tiles that were timed in this stage.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 Count = 0;
+
+  /**
+   * The mean time in this stage, in milliseconds.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double AverageMilliseconds = 0.0;
+
+  /**
+   * The median time in this stage, in milliseconds.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double MedianMilliseconds = 0.0;
+
+  /**
+   * The time in this stage that 95% of tiles did not exceed, in milliseconds.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double P95Milliseconds = 0.0;
+
+  /**
+   * The longest time in this stage, in milliseconds.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double MaximumMilliseconds = 0.0;
+};
+
+/**
+ * How long the tiles of a tileset have taken to get through each stage of the
+ * tile loading pipeline, from the request for their content to the first frame
+ * they are rendered in. This shows whether slow loading is bound by the
+ * network, by decoding and mesh creation on worker threads, or by the game
+ * thread.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTilePipelineStatistics {
+  GENERATED_BODY()
+
+  /**
+   * From requesting a tile's content to receiving the response, including
+   * lookups in the request cache.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumTilePipelineStageStatistics Request;
+
+  /**
+   * From receiving a tile's content to starting to create its Unreal meshes,
+   * which includes parsing and decoding the content.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumTilePipelineStageStatistics Parse;
+
+  /**
+   * Preparing a tile's meshes and textures on a worker thread.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumTilePipelineStageStatistics LoadThread;
+
+  /**
+   * Waiting for the game thread once a tile has been prepared on a worker
+   * thread.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumTilePipelineStageStatistics MainThreadQueue;
+
+  /**
+   * Creating a tile's components on the game thread.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumTilePipelineStageStatistics MainThread;
+
+  /**
+   * From creating a tile's components to the first frame it is shown in.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumTilePipelineStageStatistics FirstRender;
+
+  /**
+   * From requesting a tile's content to the first frame it is shown in.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumTilePipelineStageStatistics Total;
+};
@@ -0,0 +1,74 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "UObject/ObjectMacros.h"
+#include "CesiumTilesetMemoryUsage.generated.h"
+
+/**
+ * The memory held by the Unreal Engine resources created for a tileset's
+ * loaded tiles, by the kind of resource and where it resides. This is in
+ * addition to the tile data held by Cesium Native, which is what
+ * MaximumCachedBytes estimates.
+ *
+ * Textures that are shared between tiles, such as identical metadata
+ * textures, are counted once for each tile that uses them.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTilesetMemoryUsage {
+  GENERATED_BODY()
+
+  /**
+   * The vertex and index data of tile meshes kept in CPU memory, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MeshCpuBytes = 0;
+
+  /**
+   * The vertex and index buffers of tile meshes, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MeshGpuBytes = 0;
+
+  /**
+   * The physics meshes of tiles, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 PhysicsCpuBytes = 0;
+
+  /**
+   * The glTF textures of tiles, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 TextureGpuBytes = 0;
+
+  /**
+   * The textures that encode feature IDs and metadata for materials, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MetadataTextureGpuBytes = 0;
+
+  /**
+   * The textures of raster overlay tiles, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 RasterOverlayTextureGpuBytes = 0;
+
+  /**
+   * The dynamic material instances of tiles, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MaterialCpuBytes = 0;
+
+  /**
+   * The sum of all of the CPU memory above, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 TotalCpuBytes = 0;
+
+  /**
+   * The sum of all of the GPU memory above, in bytes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 TotalGpuBytes = 0;
+};
@@ -0,0 +1,65 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumRasterOverlay.h"
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "CesiumVectorRasterOverlay.generated.h"
+
+/**
+ * A raster overlay that draws the lines and polygons of a GeoJSON file over
+ * the tileset, such as road or utility networks.
+ *
+ * The features are kept as vector data, in a spatial index, and each overlay
+ * tile is rasterized from the features near it when it's needed, at the
+ * resolution of the tile. So lines stay sharp at every level of detail, and
+ * millions of segments can be drawn without preparing any images. Points are
+ * ignored.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumVectorRasterOverlay
+    : public UCesiumRasterOverlay {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The GeoJSON file with the features to draw. A relative path is relative
+   * to the project directory.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (FilePathFilter = "GeoJSON files (*.geojson;*.json)|*.geojson;*.json"))
+  FFilePath GeoJsonFile;
+
+  /**
+   * The color of lines.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FLinearColor LineColor = FLinearColor(1.0f, 1.0f, 0.0f, 1.0f);
+
+  /**
+   * The width of lines, in pixels of the overlay's textures. Since the
+   * textures are chosen to match the screen resolution of the tiles, this is
+   * roughly the width of lines on screen.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  float LineWidth = 2.0f;
+
+  /**
+   * The color that polygons are filled with. A transparent color leaves
+   * polygons out.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FLinearColor FillColor = FLinearColor(1.0f, 1.0f, 0.0f, 0.25f);
+
+protected:
+  virtual std::unique_ptr<CesiumRasterOverlays::RasterOverlay> CreateOverlay(
+      const CesiumRasterOverlays::RasterOverlayOptions& options = {}) override;
+};
@@ -75,6 +75,24 @@ public:
       meta = (ClampMin = 0))
   int32 MaximumLevel = 14;
 
+  /**
+   * The number of tiles along each side of the blocks of tiles that are
+   * requested from the server together.
+   *
+   * When this is greater than 1, a block of tiles, such as 2x2 or 4x4, is
+   * fetched with a single GetMap request, and is then divided into tiles in
+   * the background. This reduces the number of requests by up to this number
+   * squared, which helps most with servers that have a high overhead for each
+   * request. The size of the requested images, in pixels, is the tile size
+   * multiplied by this number, which must not exceed the server's limit.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 1, ClampMax = 4))
+  int32 MetatileSize = 1;
+
 protected:
   virtual std::unique_ptr<CesiumRasterOverlays::RasterOverlay> CreateOverlay(
       const CesiumRasterOverlays::RasterOverlayOptions& options = {}) override;
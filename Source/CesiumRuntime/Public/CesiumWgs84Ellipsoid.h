@@ -83,6 +83,56 @@ public:
   static FVector EarthCenteredEarthFixedToLongitudeLatitudeHeight(
       const FVector& EarthCenteredEarthFixedPosition);
 
+  /**
+   * Scales many Earth-Centered, Earth-Fixed positions to the surface of the
+   * ellipsoid at once. This is equivalent to calling ScaleToGeodeticSurface
+   * for each position, but is much faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium|WGS84 Ellipsoid",
+      meta = (ReturnDisplayName = "SurfacePositions"))
+  static TArray<FVector> ScalePositionsToGeodeticSurface(
+      const TArray<FVector>& EarthCenteredEarthFixedPositions);
+
+  /**
+   * Computes the surface normals at many Earth-Centered, Earth-Fixed positions
+   * at once. This is equivalent to calling GeodeticSurfaceNormal for each
+   * position, but is much faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium|WGS84 Ellipsoid",
+      meta = (ReturnDisplayName = "SurfaceNormalVectors"))
+  static TArray<FVector> GeodeticSurfaceNormals(
+      const TArray<FVector>& EarthCenteredEarthFixedPositions);
+
+  /**
+   * Converts many longitude/latitude/height positions to Earth-Centered,
+   * Earth-Fixed (ECEF) coordinates at once. This is equivalent to calling
+   * LongitudeLatitudeHeightToEarthCenteredEarthFixed for each position, but is
+   * much faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium|WGS84 Ellipsoid",
+      meta = (ReturnDisplayName = "EarthCenteredEarthFixedPositions"))
+  static TArray<FVector> LongitudeLatitudeHeightsToEarthCenteredEarthFixed(
+      const TArray<FVector>& LongitudeLatitudeHeights);
+
+  /**
+   * Converts many Earth-Centered, Earth-Fixed (ECEF) positions to
+   * longitude/latitude/height at once. This is equivalent to calling
+   * EarthCenteredEarthFixedToLongitudeLatitudeHeight for each position, but is
+   * faster for large numbers of positions.
+   */
+  UFUNCTION(
+      BlueprintPure,
+      Category = "Cesium|WGS84 Ellipsoid",
+      meta = (ReturnDisplayName = "LongitudeLatitudeHeights"))
+  static TArray<FVector> EarthCenteredEarthFixedToLongitudeLatitudeHeights(
+      const TArray<FVector>& EarthCenteredEarthFixedPositions);
+
   /**
    * Computes the transformation matrix from the local East-North-Up (ENU) frame
    * to Earth-Centered, Earth-Fixed (ECEF) at the specified ECEF location.
@@ -4,6 +4,7 @@
 
 #include "CesiumGeospatial/Ellipsoid.h"
 #include "CesiumGeospatial/LocalHorizontalCoordinateSystem.h"
+#include "Containers/ArrayView.h"
 #include "HAL/Platform.h"
 #include <glm/fwd.hpp>
 #include <glm/vec3.hpp>
@@ -107,6 +108,66 @@ public:
       const glm::dvec3& origin,
       const glm::dvec3& Ue) const noexcept;
 
+  /**
+   * Transforms many longitude/latitude/height positions into Earth-Centered,
+   * Earth-Fixed (ECEF) coordinates at once. This is much faster than
+   * transforming each position separately. `Output` must have the same number
+   * of elements as `LongitudeLatitudeHeight`, and may be the same array.
+   */
+  void TransformLongitudeLatitudeHeightToEcef(
+      TArrayView<const glm::dvec3> LongitudeLatitudeHeight,
+      TArrayView<glm::dvec3> Output) const noexcept;
+
+  /**
+   * Transforms many Earth-Centered, Earth-Fixed (ECEF) positions into
+   * longitude/latitude/height at once. `Output` must have the same number of
+   * elements as `Ecef`, and may be the same array.
+   */
+  void TransformEcefToLongitudeLatitudeHeight(
+      TArrayView<const glm::dvec3> Ecef,
+      TArrayView<glm::dvec3> Output) const noexcept;
+
+  /**
+   * Transforms many longitude/latitude/height positions into Unreal world
+   * coordinates (relative to the floating origin) at once. This is much faster
+   * than transforming each position separately. `Output` must have the same
+   * number of elements as `LongitudeLatitudeHeight`, and may be the same array.
+   */
+  void TransformLongitudeLatitudeHeightToUnreal(
+      const glm::dvec3& origin,
+      TArrayView<const glm::dvec3> LongitudeLatitudeHeight,
+      TArrayView<glm::dvec3> Output) const noexcept;
+
+  /**
+   * Transforms many Unreal world positions (relative to the floating origin)
+   * into longitude/latitude/height at once. `Output` must have the same number
+   * of elements as `Ue`, and may be the same array.
+   */
+  void TransformUnrealToLongitudeLatitudeHeight(
+      const glm::dvec3& origin,
+      TArrayView<const glm::dvec3> Ue,
+      TArrayView<glm::dvec3> Output) const noexcept;
+
+  /**
+   * Transforms many Earth-Centered, Earth-Fixed (ECEF) positions into Unreal
+   * world coordinates (relative to the floating origin) at once. `Output` must
+   * have the same number of elements as `Ecef`, and may be the same array.
+   */
+  void TransformEcefToUnreal(
+      const glm::dvec3& origin,
+      TArrayView<const glm::dvec3> Ecef,
+      TArrayView<glm::dvec3> Output) const noexcept;
+
+  /**
+   * Transforms many Unreal world positions (relative to the floating origin)
+   * into Earth-Centered, Earth-Fixed (ECEF) coordinates at once. `Output` must
+   * have the same number of elements as `Ue`, and may be the same array.
+   */
+  void TransformUnrealToEcef(
+      const glm::dvec3& origin,
+      TArrayView<const glm::dvec3> Ue,
+      TArrayView<glm::dvec3> Output) const noexcept;
+
   /**
    * Transforms a rotator from Unreal world to East-South-Up at the given
    * Unreal relative world location (relative to the floating origin).
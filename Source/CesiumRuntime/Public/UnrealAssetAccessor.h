@@ -29,6 +29,12 @@ public:
 
   virtual void tick() noexcept override;
 
+  /**
+   * Gets the total number of bytes received in HTTP responses by all asset
+   * accessors since startup. Reads from `file:///` URLs are not counted.
+   */
+  static int64 getTotalBytesReceived();
+
 private:
   CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> getFromFile(
       const CesiumAsync::AsyncSystem& asyncSystem,
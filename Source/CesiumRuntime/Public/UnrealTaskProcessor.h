@@ -3,10 +3,72 @@
 #pragma once
 
 #include "CesiumAsync/ITaskProcessor.h"
+#include "HAL/CriticalSection.h"
 #include "HAL/Platform.h"
+#include <atomic>
+#include <deque>
 
+class FQueuedThreadPool;
+
+/**
+ * Runs Cesium Native's background tasks, either on the background workers of
+ * the engine's task scheduler or, when "Use Dedicated Worker Threads" is
+ * enabled in the project settings, on a thread pool of Cesium's own.
+ */
 class CESIUMRUNTIME_API UnrealTaskProcessor
     : public CesiumAsync::ITaskProcessor {
 public:
+  UnrealTaskProcessor();
+  virtual ~UnrealTaskProcessor();
+
   virtual void startTask(std::function<void()> f) override;
+
+  /**
+   * Limits the tasks that run at once, in every task processor, to a fraction
+   * of the worker threads that they run on. Tasks started beyond the limit
+   * wait for running ones to finish. At least one task always runs, and a
+   * scale of 1 removes the limit.
+   */
+  static void setWorkerThreadScale(double scale);
+
+  /**
+   * While an instance of this exists, the tasks started from the same thread,
+   * and the tasks that they start in turn, are speculative: they are run
+   * at a lower priority than other tasks, so that they don't delay work that
+   * is needed for the current view.
+   */
+  class CESIUMRUNTIME_API SpeculativeScope {
+  public:
+    SpeculativeScope();
+    ~SpeculativeScope();
+
+    SpeculativeScope(const SpeculativeScope&) = delete;
+    SpeculativeScope& operator=(const SpeculativeScope&) = delete;
+
+  private:
+    bool _wasSpeculative;
+  };
+
+private:
+  struct PendingTask {
+    std::function<void()> f;
+    bool speculative;
+  };
+
+  // Gets the most tasks that may run at once, or 0 if there's no limit.
+  int32 getMaximumActiveTasks() const;
+
+  // Runs a task that has already been counted as active.
+  void launch(std::function<void()>&& f, bool speculative);
+
+  // Called when an active task finishes, to start the tasks waiting for it.
+  void finishTask();
+
+  FQueuedThreadPool* _pThreadPool;
+  uint64 _affinityMask;
+  int32 _threadCount;
+
+  FCriticalSection _pendingTasksLock;
+  std::deque<PendingTask> _pendingTasks;
+  int32 _activeTasks;
 };